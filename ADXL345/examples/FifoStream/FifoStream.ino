@@ -0,0 +1,66 @@
+#include <Wire.h>
+#include <ADXL345.h>
+
+// INT1 of the ADXL345 is wired to this pin
+#define INT_PIN 2
+
+ADXL345 accel(ADXL345_ALT);
+
+int16_t samples[ADXL345_FIFO_SIZE][3];
+
+void onFifoWatermark() {
+  accel.fifoInterrupt();
+}
+
+void setup() {
+  Serial.begin(115200);
+  Wire.begin();
+  Wire.setClock(400000);
+
+  if (accel.readDeviceID() == 0) {
+    Serial.println("read device id: failed");
+    while(1) {
+      delay(100);
+    }
+  }
+
+  // At 3200 Hz, 400 kHz I2C only just keeps up: each sample is a separate read
+  if (!accel.writeRate(ADXL345_RATE_3200HZ) || !accel.writeRange(ADXL345_RANGE_16G)) {
+    Serial.println("write rate or range: failed");
+    while(1) {
+      delay(100);
+    }
+  }
+
+  // Interrupt on INT1 once 16 samples are stored
+  pinMode(INT_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(INT_PIN), onFifoWatermark, RISING);
+  if (!accel.writeFifoStream(16, ADXL345_INT1) || !accel.start()) {
+    Serial.println("start: failed");
+    while(1) {
+      delay(100);
+    }
+  }
+}
+
+void loop() {
+  if (!accel.fifoReady()) {
+    return;
+  }
+
+  // Empty the FIFO, so that the interrupt pin goes low and can rise again
+  uint32_t timestamp;
+  uint8_t count;
+  while ((count = accel.readFifo(samples, ADXL345_FIFO_SIZE, &timestamp)) > 0) {
+    // Print a summary of the batch, the serial port can't carry every sample
+    int32_t sum = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      sum += samples[i][2];
+    }
+    Serial.print(timestamp);
+    Serial.print(",");
+    Serial.print(count);
+    Serial.print(",");
+    Serial.println(sum / count);
+  }
+}
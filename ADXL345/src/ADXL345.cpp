@@ -42,6 +42,12 @@
 #define REG_FIFO_CTL       0x38    // R/W,   00000000,   FIFO control
 #define REG_FIFO_STATUS    0x39    // R,     00000000,   FIFO status
 
+// Bits
+#define INT_WATERMARK      0x02    // INT_ENABLE, INT_MAP, INT_SOURCE
+#define FIFO_MODE_BYPASS   0x00    // FIFO_CTL D7 - D6
+#define FIFO_MODE_STREAM   0x80
+#define FIFO_ENTRIES_MASK  0x3F    // FIFO_STATUS
+
 ADXL345::ADXL345(uint8_t i2cAddress, TwoWire *wire) {
   _wire = wire;
   _i2cAddress = i2cAddress;
@@ -49,6 +55,12 @@ ADXL345::ADXL345(uint8_t i2cAddress, TwoWire *wire) {
   _xyz[0] = 0; // x
   _xyz[1] = 0; // y
   _xyz[2] = 0; // z
+
+  _fifoWatermark = 0;
+  _fifoLeft = false;
+  _fifoNextMicros = 0;
+  _fifoIrq = false;
+  _fifoIrqMicros = 0;
 }
 
 const float ADXL345::kRatio2g  = (float) (2 * 2) / 1024.0f;
@@ -131,6 +143,116 @@ bool ADXL345::writeRange(uint8_t range) {
   return writeRegister(REG_DATA_FORMAT, _dataFormatBits.toByte());
 }
 
+// Keeps the newest 32 samples in the FIFO and raises the watermark interrupt on INT1 or INT2
+// once `watermark` (1 - 31) samples are stored. The interrupt stays raised until the FIFO
+// is read below the watermark, so attach it RISING and empty the FIFO on each interrupt.
+bool ADXL345::writeFifoStream(uint8_t watermark, uint8_t intPin) {
+  uint8_t intEnable, intMap;
+
+  if (watermark < 1 || watermark >= ADXL345_FIFO_SIZE) {
+    return false;
+  }
+
+  _fifoWatermark = watermark;
+  _fifoLeft = false;
+  _fifoIrq = false;
+
+  if (!readRegister(REG_INT_ENABLE, &intEnable) || !readRegister(REG_INT_MAP, &intMap)) {
+    return false;
+  }
+  if (intPin == ADXL345_INT2) {
+    intMap |= INT_WATERMARK;
+  } else {
+    intMap &= ~INT_WATERMARK;
+  }
+
+  return writeRegister(REG_INT_ENABLE, intEnable & ~INT_WATERMARK)
+      && writeRegister(REG_FIFO_CTL, FIFO_MODE_STREAM | watermark)
+      && writeRegister(REG_INT_MAP, intMap)
+      && writeRegister(REG_INT_ENABLE, intEnable | INT_WATERMARK);
+}
+
+bool ADXL345::writeFifoBypass() {
+  uint8_t intEnable;
+
+  _fifoWatermark = 0;
+  if (!readRegister(REG_INT_ENABLE, &intEnable)) {
+    return false;
+  }
+
+  return writeRegister(REG_INT_ENABLE, intEnable & ~INT_WATERMARK)
+      && writeRegister(REG_FIFO_CTL, FIFO_MODE_BYPASS);
+}
+
+uint8_t ADXL345::readFifoEntries() {
+  uint8_t value = 0;
+  if (readRegister(REG_FIFO_STATUS, &value)) {
+    return value & FIFO_ENTRIES_MASK;
+  } else {
+    return 0;
+  }
+}
+
+// Reads up to maxSamples raw samples from the FIFO, oldest first, and returns how many were
+// read. Each sample is one multiple-byte read of the data registers, which pops it from the
+// FIFO. If timestamp is given, it is set to the micros() time of the first sample, worked out
+// from the time of the watermark interrupt and the data rate.
+uint8_t ADXL345::readFifo(int16_t (*xyz)[3], uint8_t maxSamples, uint32_t *timestamp) {
+  uint32_t now = micros();
+  uint8_t entries = readFifoEntries();
+  uint8_t count = entries < maxSamples ? entries : maxSamples;
+  uint8_t values[6];
+  uint8_t i;
+
+  for (i = 0; i < count; i++) {
+    if (!readRegisters(REG_DATAX0, values, sizeof(values))) {
+      break;
+    }
+    xyz[i][0] = (int16_t) word(values[1], values[0]);
+    xyz[i][1] = (int16_t) word(values[3], values[2]);
+    xyz[i][2] = (int16_t) word(values[5], values[4]);
+  }
+
+  noInterrupts();
+  bool irq = _fifoIrq;
+  uint32_t irqMicros = _fifoIrqMicros;
+  _fifoIrq = false;
+  interrupts();
+
+  uint32_t first;
+  if (_fifoLeft) {
+    first = _fifoNextMicros;
+  } else if (irq && _fifoWatermark) {
+    // the watermark-th sample arrived with the interrupt
+    first = irqMicros - fifoMicros(_fifoWatermark - 1);
+  } else {
+    first = now - fifoMicros(entries ? entries - 1 : 0);
+  }
+  _fifoNextMicros = first + fifoMicros(i);
+  _fifoLeft = i < entries;
+
+  if (timestamp) {
+    *timestamp = first;
+  }
+  return i;
+}
+
+// Call from the interrupt handler of the pin the watermark interrupt is mapped to.
+void ADXL345::fifoInterrupt() {
+  _fifoIrqMicros = micros();
+  _fifoIrq = true;
+}
+
+bool ADXL345::fifoReady() {
+  return _fifoIrq;
+}
+
+// Time taken by the given number of samples at the current data rate.
+uint32_t ADXL345::fifoMicros(uint8_t samples) {
+  // 312.5 us at 3200 Hz, doubling with each lower rate
+  return ((uint32_t) samples * 3125UL << (0x0F - _bwRateBits.rate)) / 10;
+}
+
 float ADXL345::convertToSI(int16_t rawValue) {
   switch (_dataFormatBits.range) {
     case ADXL345_RANGE_2G:
@@ -31,6 +31,11 @@
 #define ADXL345_RANGE_8G      0x02    // +-8 g
 #define ADXL345_RANGE_16G     0x03    // +-16 g
 
+// FIFO
+#define ADXL345_FIFO_SIZE     32      // samples
+#define ADXL345_INT1          0
+#define ADXL345_INT2          1
+
 
 class ADXL345 {
   private:
@@ -83,7 +88,14 @@ class ADXL345 {
     DataFormatBits _dataFormatBits;
     BwRateBits _bwRateBits;
 
+    uint8_t _fifoWatermark;
+    bool _fifoLeft;                   // the last readFifo() did not empty the FIFO
+    uint32_t _fifoNextMicros;         // time of the next sample after the last readFifo()
+    volatile bool _fifoIrq;
+    volatile uint32_t _fifoIrqMicros;
+
     float convertToSI(int16_t rawValue);
+    uint32_t fifoMicros(uint8_t samples);
 
     bool write(uint8_t value);
     bool write(uint8_t *values, size_t size);
@@ -108,6 +120,13 @@ class ADXL345 {
     bool writeRate(uint8_t rate);
     bool writeRateWithLowPower(uint8_t rate);
     bool writeRange(uint8_t range);
+
+    bool writeFifoStream(uint8_t watermark, uint8_t intPin=ADXL345_INT1);
+    bool writeFifoBypass();
+    uint8_t readFifoEntries();
+    uint8_t readFifo(int16_t (*xyz)[3], uint8_t maxSamples, uint32_t *timestamp=NULL);
+    void fifoInterrupt();
+    bool fifoReady();
 };
 
 #endif
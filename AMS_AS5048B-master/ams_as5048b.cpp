@@ -68,6 +68,7 @@ void AMS_AS5048B::begin(void) {
 
 	_clockWise = false;
 	_lastAngleRaw = 0.0;
+	AMS_AS5048B::beginStream(1000, 50);
 	_zeroRegVal = AMS_AS5048B::zeroRegR();
 	_addressRegVal = AMS_AS5048B::addressRegR();
 
@@ -106,6 +107,7 @@ void AMS_AS5048B::setClockWise(boolean cw) {
 
 	_clockWise = cw;
 	_lastAngleRaw = 0.0;
+	_streamStarted = false;
 	AMS_AS5048B::resetMovingAvgExp();
 	return;
 }
@@ -416,6 +418,143 @@ void AMS_AS5048B::resetMovingAvgExp(void) {
 	return;
 }
 
+/**************************************************************************/
+/*!
+    @brief  Starts angle streaming: sets the sample rate and the bandwidth of the
+			tracking loop observer, and resets the multi-turn position.
+			The observer is a critically damped alpha-beta-gamma filter, its gains are
+			computed here once so that streamUpdate() only uses integers.
+			At 400 kHz a streamUpdate() takes about 150 us on the bus, use Wire.setClock()
+			to go faster than about 5 kHz.
+
+    @params[in]
+				uint16_t sampleRate : rate streamUpdate() will be called at (Hz)
+    @params[in]
+				uint16_t bandwidth : observer bandwidth (Hz), a fraction of the sample rate
+    @returns
+				none
+*/
+/**************************************************************************/
+void AMS_AS5048B::beginStream(uint16_t sampleRate, uint16_t bandwidth) {
+
+	double theta = exp(-2.0 * M_PI * bandwidth / sampleRate); //fading memory discount factor
+	double one = (double) (1L << STREAM_GAIN_Q);
+
+	_streamRate = sampleRate;
+	_streamAlpha = (int32_t) ((1.0 - theta * theta * theta) * one);
+	_streamBeta = (int32_t) (1.5 * (1.0 - theta) * (1.0 - theta) * (1.0 + theta) * one);
+	_streamGamma = (int32_t) ((1.0 - theta) * (1.0 - theta) * (1.0 - theta) * one); //2 gamma, as acceleration is updated with 2 gamma r / dt^2
+	_streamStarted = false;
+	_streamPosition = 0;
+	_streamPosEst = 0;
+	_streamVelEst = 0;
+	_streamAccEst = 0;
+	return;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reads diagnostics, magnitude and angle in one I2C transaction, unwraps the
+			angle into a multi-turn position and updates the observer.
+			Uses no floating point. Wire can not be used from an interrupt on most cores,
+			so a timer interrupt should rather set a flag for loop(), or wake a task.
+
+    @params[in]
+				none
+    @returns
+				boolean : false if the read failed or the sensor flagged the angle as invalid, the observer then coasts on its estimates
+*/
+/**************************************************************************/
+boolean AMS_AS5048B::streamUpdate(void) {
+
+	uint8_t regs[5]; //DIAG, MAGN MSB, MAGN LSB, ANGL MSB, ANGL LSB
+	boolean valid = AMS_AS5048B::readRegs(AS5048B_DIAG_REG, regs, sizeof(regs));
+
+	if (valid) {
+		_streamDiag = regs[0];
+		_streamMagnitude = (((uint16_t) regs[1]) << 6) | (regs[2] & 0x3F);
+		valid = (_streamDiag & (AS5048B_DIAG_OCF | AS5048B_DIAG_COF)) == AS5048B_DIAG_OCF;
+	}
+
+	//prediction
+	int64_t posPred = _streamPosEst + _streamVelEst + (_streamAccEst >> 1);
+	int64_t velPred = _streamVelEst + _streamAccEst;
+
+	if (!valid) {
+		_streamPosEst = posPred;
+		_streamVelEst = velPred;
+		return false;
+	}
+
+	uint16_t raw = (((uint16_t) regs[3]) << 6) | (regs[4] & 0x3F);
+	if (_clockWise) {
+		raw = 0b11111111111111 - raw;
+	}
+
+	if (!_streamStarted) {
+		_streamStarted = true;
+		_streamPosition = raw;
+		_streamPosEst = (int64_t) raw << STREAM_Q;
+		_streamLastRaw = raw;
+		return true;
+	}
+
+	//shortest way round from the last angle, the sensor must turn less than half a turn per sample
+	int16_t delta = (int16_t) ((raw - _streamLastRaw) << 2) >> 2;
+	_streamLastRaw = raw;
+	_streamPosition += delta;
+
+	//correction, the residual is bounded to 32 bits so the products fit in 64 bits
+	int64_t residual = (((int64_t) _streamPosition << STREAM_Q) - posPred) >> (STREAM_Q - STREAM_RESIDUAL_Q);
+	if (residual > INT32_MAX) residual = INT32_MAX;
+	if (residual < -INT32_MAX) residual = -INT32_MAX;
+	_streamPosEst = posPred + ((residual * _streamAlpha) >> (STREAM_GAIN_Q + STREAM_RESIDUAL_Q - STREAM_Q));
+	_streamVelEst = velPred + ((residual * _streamBeta) >> (STREAM_GAIN_Q + STREAM_RESIDUAL_Q - STREAM_Q));
+	_streamAccEst += (residual * _streamGamma) >> (STREAM_GAIN_Q + STREAM_RESIDUAL_Q - STREAM_Q);
+
+	return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  multi-turn position as measured by the last streamUpdate()
+
+    @params[in]
+				none
+    @returns
+				int32_t position in raw counts (16384 per turn)
+*/
+/**************************************************************************/
+int32_t AMS_AS5048B::getPosition(void) {
+
+	return _streamPosition;
+}
+
+/**************************************************************************/
+/*!
+    @brief  observer position, velocity and acceleration in the desired unit
+
+    @params[in]
+				int unit : unit of the angle, raw counts as default. Per second and per second squared for velocity and acceleration
+    @returns
+				Double value converted into the desired unit
+*/
+/**************************************************************************/
+double AMS_AS5048B::getPositionEst(int unit) {
+
+	return AMS_AS5048B::convertAngle(unit, ldexp((double) _streamPosEst, -STREAM_Q));
+}
+
+double AMS_AS5048B::getVelocity(int unit) {
+
+	return AMS_AS5048B::convertAngle(unit, ldexp((double) _streamVelEst, -STREAM_Q) * _streamRate);
+}
+
+double AMS_AS5048B::getAcceleration(int unit) {
+
+	return AMS_AS5048B::convertAngle(unit, ldexp((double) _streamAccEst, -STREAM_Q) * _streamRate * _streamRate);
+}
+
 
 /*========================================================================*/
 /*                           PRIVATE FUNCTIONS                            */
@@ -473,6 +612,25 @@ uint16_t AMS_AS5048B::readReg16(uint8_t address) {
 	return readValue;
 }
 
+boolean AMS_AS5048B::readRegs(uint8_t address, uint8_t *values, uint8_t count) {
+	//the register address auto-increments, so consecutive registers come in one transaction
+
+	Wire.beginTransmission(_chipAddress);
+	Wire.write(address);
+	if (Wire.endTransmission(false)) {
+		return false;
+	}
+
+	if (Wire.requestFrom(_chipAddress, count) != count) {
+		return false;
+	}
+	for (uint8_t i = 0; i < count; i++) {
+		values[i] = Wire.read();
+	}
+
+	return true;
+}
+
 void AMS_AS5048B::writeReg(uint8_t address, uint8_t value) {
 
 	Wire.beginTransmission(_chipAddress);
@@ -73,6 +73,8 @@
 #define AS5048B_ANGLMSB_REG 0xFE //bits 0..7
 #define AS5048B_ANGLLSB_REG 0xFF //bits 0..5
 #define AS5048B_RESOLUTION 16384.0 //14 bits
+#define AS5048B_DIAG_OCF 0x01 //offset compensation finished
+#define AS5048B_DIAG_COF 0x02 //CORDIC overflow, angle and magnitude invalid
 
 
 // Moving Exponential Average on angle - beware heavy calculation for some Arduino boards
@@ -81,6 +83,11 @@
 #define EXP_MOVAVG_N 5	//history length impact on moving average impact - keep in mind the moving average will be impacted by the measurement frequency too
 #define EXP_MOVAVG_LOOP 1 //number of measurements before starting mobile Average - starting with a simple average - 1 allows a quick start. Value must be 1 minimum
 
+// Angle streaming - tracking loop observer for velocity and acceleration, in fixed point counts per sample
+#define STREAM_Q 32 //observer state, fine enough for the tiny acceleration corrections at low bandwidth to sample rate ratios
+#define STREAM_RESIDUAL_Q 16 //observer residual
+#define STREAM_GAIN_Q 24 //observer gains
+
 //unit consts - just to make the units more readable
 #define U_RAW 1
 #define U_TRN 2
@@ -124,6 +131,15 @@ class AMS_AS5048B {
 	double		getMovingAvgExp(int unit = U_RAW); //get Exponential Moving Average calculation
 	void		resetMovingAvgExp(void); //reset Exponential Moving Average calculation values
 
+	void		beginStream(uint16_t sampleRate, uint16_t bandwidth); //set the sample rate (Hz) streamUpdate() will be called at and the observer bandwidth (Hz), and reset the position
+	boolean		streamUpdate(void); //burst read diagnostics, magnitude and angle, unwrap the multi-turn position and update the observer - integer only, call at the sample rate
+	int32_t		getPosition(void); //multi-turn position in raw counts, as measured
+	double		getPositionEst(int unit = U_RAW); //observer position, multi-turn, with unit conversion
+	double		getVelocity(int unit = U_RAW); //observer velocity per second, with unit conversion
+	double		getAcceleration(int unit = U_RAW); //observer acceleration per second squared, with unit conversion
+	uint16_t	getStreamMagnitude(void) { return _streamMagnitude; } //magnitude of the last streamUpdate()
+	uint8_t		getStreamDiag(void) { return _streamDiag; } //diagnostic register of the last streamUpdate()
+
  private:
 	//variables
 	boolean		_debugFlag;
@@ -137,10 +153,23 @@ class AMS_AS5048B {
 	double		_movingAvgExpCos;
 	double		_movingAvgExpAlpha;
 	int		_movingAvgCountLoop;
+	uint16_t	_streamRate;
+	int32_t		_streamAlpha; //observer gains, Q24
+	int32_t		_streamBeta;
+	int32_t		_streamGamma;
+	boolean		_streamStarted;
+	uint16_t	_streamLastRaw;
+	int32_t		_streamPosition; //measured multi-turn position, counts
+	int64_t		_streamPosEst; //estimated position, Q32 counts
+	int64_t		_streamVelEst; //estimated velocity, Q32 counts per sample
+	int64_t		_streamAccEst; //estimated acceleration, Q32 counts per sample squared
+	uint16_t	_streamMagnitude;
+	uint8_t		_streamDiag;
 
 	//methods
 	uint8_t		readReg8(uint8_t address);
 	uint16_t	readReg16(uint8_t address); //16 bit value got from 2x8bits registers (7..0 MSB + 5..0 LSB) => 14 bits value
+	boolean		readRegs(uint8_t address, uint8_t *values, uint8_t count); //burst read of consecutive registers in one transaction
 	void		writeReg(uint8_t address, uint8_t value);
 	double		convertAngle(int unit, double angle); //RAW, TRN, DEG, RAD, GRAD, MOA, SOA, MILNATO, MILSE, MILRU
 	double		getExpAvgRawAngle(void);
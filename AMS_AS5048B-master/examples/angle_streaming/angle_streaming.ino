@@ -0,0 +1,61 @@
+/**************************************************************************/
+/*!
+    @file     angle_streaming.ino
+    @author   SOSAndroid (E. Ha.)
+    @license  BSD (see license.txt)
+
+	streams the angle at a fixed rate and estimates the multi-turn position,
+	velocity and acceleration of the shaft
+
+    @section  HISTORY
+
+    v1.0 - First release
+*/
+/**************************************************************************/
+
+
+#include <ams_as5048b.h>
+#include <Wire.h>
+
+#define SAMPLE_RATE 2000 //Hz
+#define BANDWIDTH 20 //Hz
+
+AMS_AS5048B mysensor;
+
+unsigned long nextSample;
+unsigned long lastPrint;
+
+void setup() {
+
+	//Start serial
+	Serial.begin(115200);
+	while (!Serial) ; //wait until Serial ready
+
+	//init AMS_AS5048B object
+	mysensor.begin();
+
+	//a burst read takes about 150 us at 400 kHz
+	Wire.setClock(400000);
+
+	mysensor.beginStream(SAMPLE_RATE, BANDWIDTH);
+	nextSample = micros();
+}
+
+void loop() {
+
+	//samples at a fixed rate - a timer interrupt could set a flag instead, Wire can not be used inside it
+	if ((long) (micros() - nextSample) >= 0) {
+		nextSample += 1000000UL / SAMPLE_RATE;
+		mysensor.streamUpdate();
+	}
+
+	if (millis() - lastPrint >= 500) {
+		lastPrint = millis();
+		Serial.print("Turns : ");
+		Serial.print(mysensor.getPositionEst(U_TRN), 3);
+		Serial.print(" Velocity deg/s : ");
+		Serial.print(mysensor.getVelocity(U_DEG), 1);
+		Serial.print(" Acceleration deg/s2 : ");
+		Serial.println(mysensor.getAcceleration(U_DEG), 1);
+	}
+}
@@ -185,6 +185,173 @@ bool Adafruit_ADXL343::getXYZ(int16_t &x, int16_t &y, int16_t &z) {
   return true;
 }
 
+/**************************************************************************/
+/*!
+    @brief  Puts the FIFO in stream mode, where it keeps the newest 32
+            samples, and raises the watermark interrupt on the given pin
+            once 'watermark' samples are stored. The interrupt stays
+            raised until the FIFO is read below the watermark, so attach
+            it RISING and empty the FIFO after each interrupt. Call this
+            after setDataRate(), the rate is used for the timestamps.
+
+    @param watermark Number of samples that raises the interrupt, 1 - 31
+    @param pin The pin the watermark interrupt is mapped to
+
+    @return True if the operation was successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_ADXL343::setFIFOStream(uint8_t watermark, adxl3xx_int_pin pin) {
+  if (watermark < 1 || watermark >= ADXL3XX_FIFO_SIZE)
+    return false;
+
+  _fifoDataRate = getDataRate();
+  _fifoWatermark = watermark;
+  _fifoLeft = false;
+  _fifoIrq = false;
+
+  Adafruit_BusIO_Register int_enable_reg =
+      Adafruit_BusIO_Register(i2c_dev, spi_dev, AD8_HIGH_TOREAD_AD7_HIGH_TOINC,
+                              ADXL3XX_REG_INT_ENABLE, 1);
+  Adafruit_BusIO_Register int_map_reg =
+      Adafruit_BusIO_Register(i2c_dev, spi_dev, AD8_HIGH_TOREAD_AD7_HIGH_TOINC,
+                              ADXL3XX_REG_INT_MAP, 1);
+  Adafruit_BusIO_Register fifo_ctl_reg =
+      Adafruit_BusIO_Register(i2c_dev, spi_dev, AD8_HIGH_TOREAD_AD7_HIGH_TOINC,
+                              ADXL3XX_REG_FIFO_CTL, 1);
+  Adafruit_BusIO_RegisterBits watermark_enable =
+      Adafruit_BusIO_RegisterBits(&int_enable_reg, 1, 1);
+  Adafruit_BusIO_RegisterBits watermark_map =
+      Adafruit_BusIO_RegisterBits(&int_map_reg, 1, 1);
+
+  /* Stream mode (0b10 in D7-D6), the trigger bit is unused */
+  return watermark_enable.write(false) && fifo_ctl_reg.write(0x80 | watermark) &&
+         watermark_map.write(pin == ADXL3XX_INT2) &&
+         watermark_enable.write(true);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Puts the FIFO in bypass mode and disables the watermark interrupt
+
+    @return True if the operation was successful, otherwise false.
+*/
+/**************************************************************************/
+bool Adafruit_ADXL343::disableFIFO(void) {
+  Adafruit_BusIO_Register int_enable_reg =
+      Adafruit_BusIO_Register(i2c_dev, spi_dev, AD8_HIGH_TOREAD_AD7_HIGH_TOINC,
+                              ADXL3XX_REG_INT_ENABLE, 1);
+  Adafruit_BusIO_Register fifo_ctl_reg =
+      Adafruit_BusIO_Register(i2c_dev, spi_dev, AD8_HIGH_TOREAD_AD7_HIGH_TOINC,
+                              ADXL3XX_REG_FIFO_CTL, 1);
+  Adafruit_BusIO_RegisterBits watermark_enable =
+      Adafruit_BusIO_RegisterBits(&int_enable_reg, 1, 1);
+
+  _fifoWatermark = 0;
+  return watermark_enable.write(false) && fifo_ctl_reg.write(0);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets the number of samples stored in the FIFO
+
+    @return The number of samples, 0 - 32
+*/
+/**************************************************************************/
+uint8_t Adafruit_ADXL343::getFIFOEntries(void) {
+  return readRegister(ADXL3XX_REG_FIFO_STATUS) & 0x3F;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reads samples from the FIFO, oldest first. Each sample is one
+            multiple-byte read of the data registers, which pops it from
+            the FIFO.
+
+    @param xyz Array receiving the raw x, y and z values of each sample
+    @param maxSamples Size of the array
+    @param timestamp If not NULL, set to the micros() time of the first
+           sample, worked out from the time of the watermark interrupt
+           (or of this call, without one) and the data rate
+
+    @return The number of samples read
+*/
+/**************************************************************************/
+uint8_t Adafruit_ADXL343::readFIFO(int16_t (*xyz)[3], uint8_t maxSamples,
+                                   uint32_t *timestamp) {
+  uint32_t now = micros();
+  uint8_t entries = getFIFOEntries();
+  uint8_t count = entries < maxSamples ? entries : maxSamples;
+  uint8_t i;
+
+  Adafruit_BusIO_Register data_reg = Adafruit_BusIO_Register(
+      i2c_dev, spi_dev, AD8_HIGH_TOREAD_AD7_HIGH_TOINC, ADXL3XX_REG_DATAX0, 6);
+  for (i = 0; i < count; i++) {
+    if (!data_reg.read((uint8_t *)xyz[i], 6))
+      break;
+    /* The FIFO needs 5us to pop, longer than an I2C address phase but not
+     * than a fast SPI one */
+    if (spi_dev)
+      delayMicroseconds(5);
+  }
+
+  noInterrupts();
+  bool irq = _fifoIrq;
+  uint32_t irqMicros = _fifoIrqMicros;
+  _fifoIrq = false;
+  interrupts();
+
+  uint32_t first;
+  if (_fifoLeft) {
+    first = _fifoNextMicros;
+  } else if (irq && _fifoWatermark) {
+    /* The watermark-th sample arrived with the interrupt */
+    first = irqMicros - fifoMicros(_fifoWatermark - 1);
+  } else {
+    first = now - fifoMicros(entries ? entries - 1 : 0);
+  }
+  _fifoNextMicros = first + fifoMicros(i);
+  _fifoLeft = i < entries;
+
+  if (timestamp)
+    *timestamp = first;
+  return i;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Records the time of a watermark interrupt. Call from the
+            interrupt handler of the pin the watermark interrupt is
+            mapped to.
+*/
+/**************************************************************************/
+void Adafruit_ADXL343::handleFIFOInterrupt(void) {
+  _fifoIrqMicros = micros();
+  _fifoIrq = true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Checks for a watermark interrupt since the last readFIFO()
+
+    @return True if handleFIFOInterrupt() was called since then
+*/
+/**************************************************************************/
+bool Adafruit_ADXL343::FIFOReady(void) { return _fifoIrq; }
+
+/**************************************************************************/
+/*!
+    @brief  Time taken by a number of samples at the FIFO data rate
+
+    @param samples The number of samples
+
+    @return The time in microseconds
+*/
+/**************************************************************************/
+uint32_t Adafruit_ADXL343::fifoMicros(uint8_t samples) {
+  /* 312.5us at 3200Hz, doubling with each lower rate */
+  return ((uint32_t)samples * 3125UL << (0x0F - _fifoDataRate)) / 10;
+}
+
 /**************************************************************************/
 /*!
  *   @brief  Instantiates a new ADXL343 class
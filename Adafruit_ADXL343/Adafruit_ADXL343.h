@@ -76,6 +76,7 @@
     REGISTERS
     -----------------------------------------------------------------------*/
 #define ADXL343_MG2G_MULTIPLIER (0.004) /**< 4mg per lsb */
+#define ADXL3XX_FIFO_SIZE (32)          /**< Samples held by the FIFO */
 /*=========================================================================*/
 
 /** Used with register 0x2C (ADXL3XX_REG_BW_RATE) to set bandwidth */
@@ -187,6 +188,14 @@ public:
   int16_t getZ(void);
   bool getXYZ(int16_t &x, int16_t &y, int16_t &z);
 
+  bool setFIFOStream(uint8_t watermark, adxl3xx_int_pin pin = ADXL3XX_INT1);
+  bool disableFIFO(void);
+  uint8_t getFIFOEntries(void);
+  uint8_t readFIFO(int16_t (*xyz)[3], uint8_t maxSamples,
+                   uint32_t *timestamp = NULL);
+  void handleFIFOInterrupt(void);
+  bool FIFOReady(void);
+
 protected:
   Adafruit_SPIDevice *spi_dev = NULL; ///< BusIO SPI device
   Adafruit_I2CDevice *i2c_dev = NULL; ///< BusIO I2C device
@@ -199,6 +208,16 @@ protected:
       _do,                ///< SPI software data out
       _di,                ///< SPI software data in
       _cs;                ///< SPI software chip select
+
+  uint8_t _fifoWatermark = 0;            ///< FIFO watermark in stream mode
+  adxl3xx_dataRate_t _fifoDataRate =
+      ADXL3XX_DATARATE_100_HZ;           ///< Data rate, for FIFO timestamps
+  bool _fifoLeft = false;                ///< Last read did not empty the FIFO
+  uint32_t _fifoNextMicros = 0;          ///< Time of the next FIFO sample
+  volatile bool _fifoIrq = false;        ///< Watermark interrupt pending
+  volatile uint32_t _fifoIrqMicros = 0;  ///< Time of the watermark interrupt
+
+  uint32_t fifoMicros(uint8_t samples);
 };
 
 #endif
@@ -96,6 +96,8 @@ Adafruit_BusIO_Register::Adafruit_BusIO_Register(
  * uncheckable)
  */
 bool Adafruit_BusIO_Register::write(uint8_t *buffer, uint8_t len) {
+  // the shadow only follows whole register values written with write(value)
+  _cache_valid = false;
 
   uint8_t addrbuffer[2] = {(uint8_t)(_address & 0xFF),
                            (uint8_t)(_address >> 8)};
@@ -158,7 +160,11 @@ bool Adafruit_BusIO_Register::write(uint32_t value, uint8_t numbytes) {
     }
     value >>= 8;
   }
-  return write(_buffer, numbytes);
+  if (!write(_buffer, numbytes)) {
+    return false;
+  }
+  _cache_valid = _cache_enabled && (numbytes == _width);
+  return true;
 }
 
 /*!
@@ -182,9 +188,42 @@ uint32_t Adafruit_BusIO_Register::read(void) {
     }
   }
 
+  if (_cache_enabled) {
+    _cached = value;
+    _cache_valid = true;
+  }
   return value;
 }
 
+/*!
+ *    @brief  Read the register through the shadow cache: with the cache
+ * enabled and valid this costs no bus transaction, otherwise it is read()
+ *    @return Returns 0xFFFFFFFF on failure, value otherwise
+ */
+uint32_t Adafruit_BusIO_Register::readShadow(void) {
+  if (_cache_valid) {
+    return _cached;
+  }
+  return read();
+}
+
+/*!
+ *    @brief  Keep a write-through shadow of the register value, so that
+ * Adafruit_BusIO_RegisterBits read-modify-write sequences only read the bus
+ * once. Only for registers that the device itself does not change, call
+ * invalidateCache() whenever it may have (e.g. after a reset).
+ *    @param  enable True to use the shadow, false to always read the bus
+ */
+void Adafruit_BusIO_Register::enableCache(bool enable) {
+  _cache_enabled = enable;
+  _cache_valid = false;
+}
+
+/*!
+ *    @brief  Forget the shadow value, the next readShadow() reads the bus
+ */
+void Adafruit_BusIO_Register::invalidateCache(void) { _cache_valid = false; }
+
 /*!
  *    @brief  Read cached data from last time we wrote to this register
  *    @return Returns 0xFFFFFFFF on failure, value otherwise
@@ -233,6 +272,72 @@ bool Adafruit_BusIO_Register::read(uint8_t *buffer, uint8_t len) {
   return false;
 }
 
+/*!
+ *    @brief  Queue a read of the register location and return without
+ *    waiting for it. I2C only.
+ *    @param  queue The queue of the bus the device is on
+ *    @param  txn Caller owned transaction, must stay valid until completed
+ *    @param  buffer Pointer to data to read into, filled once completed
+ *    @param  len Number of bytes to read
+ *    @param  callback Called once completed, check txn->ok for the result
+ *    @param  user Stored in txn->user for the callback
+ *    @return True if queued
+ */
+bool Adafruit_BusIO_Register::read_async(Adafruit_I2CQueue *queue,
+                                         Adafruit_I2CTransaction *txn,
+                                         uint8_t *buffer, uint8_t len,
+                                         Adafruit_I2CCallback callback,
+                                         void *user) {
+  return submit(queue, txn, nullptr, 0, buffer, len, callback, user);
+}
+
+/*!
+ *    @brief  Queue a write to the register location and return without
+ *    waiting for it. I2C only.
+ *    @param  queue The queue of the bus the device is on
+ *    @param  txn Caller owned transaction, must stay valid until completed
+ *    @param  buffer Pointer to data to write, must stay valid until completed
+ *    @param  len Number of bytes to write
+ *    @param  callback Called once completed, check txn->ok for the result
+ *    @param  user Stored in txn->user for the callback
+ *    @return True if queued
+ */
+bool Adafruit_BusIO_Register::write_async(Adafruit_I2CQueue *queue,
+                                          Adafruit_I2CTransaction *txn,
+                                          const uint8_t *buffer, uint8_t len,
+                                          Adafruit_I2CCallback callback,
+                                          void *user) {
+  return submit(queue, txn, buffer, len, nullptr, 0, callback, user);
+}
+
+bool Adafruit_BusIO_Register::submit(Adafruit_I2CQueue *queue,
+                                     Adafruit_I2CTransaction *txn,
+                                     const uint8_t *write_buffer,
+                                     uint8_t write_len, uint8_t *read_buffer,
+                                     uint8_t read_len,
+                                     Adafruit_I2CCallback callback,
+                                     void *user) {
+  if (!_i2cdevice || txn->pending()) {
+    return false;
+  }
+  txn->device = _i2cdevice;
+  txn->write_buffer = write_buffer;
+  txn->write_len = write_len;
+  txn->read_buffer = read_buffer;
+  txn->read_len = read_len;
+  txn->stop = false;
+  // the address travels in the transaction, as read() keeps it on the stack
+  txn->prefix[0] = (uint8_t)(_address & 0xFF);
+  txn->prefix[1] = (uint8_t)(_address >> 8);
+  txn->prefix_len = _addrwidth;
+  if (write_len) {
+    _cache_valid = false;
+  }
+  txn->callback = callback;
+  txn->user = user;
+  return queue->submit(txn);
+}
+
 /*!
  *    @brief  Read 2 bytes of data from the register location
  *    @param  value Pointer to uint16_t variable to read into
@@ -309,7 +414,7 @@ Adafruit_BusIO_RegisterBits::Adafruit_BusIO_RegisterBits(
  *    @return  data The 4 bytes to read
  */
 uint32_t Adafruit_BusIO_RegisterBits::read(void) {
-  uint32_t val = _register->read();
+  uint32_t val = _register->readShadow();
   val >>= _shift;
   return val & ((1 << (_bits)) - 1);
 }
@@ -321,7 +426,7 @@ uint32_t Adafruit_BusIO_RegisterBits::read(void) {
  * uncheckable)
  */
 bool Adafruit_BusIO_RegisterBits::write(uint32_t data) {
-  uint32_t val = _register->read();
+  uint32_t val = _register->readShadow();
 
   // mask off the data before writing
   uint32_t mask = (1 << (_bits)) - 1;
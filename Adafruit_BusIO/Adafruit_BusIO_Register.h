@@ -7,6 +7,7 @@
     (defined(SPI_INTERFACES_COUNT) && (SPI_INTERFACES_COUNT > 0))
 
 #include <Adafruit_I2CDevice.h>
+#include <Adafruit_I2CQueue.h>
 #include <Adafruit_SPIDevice.h>
 
 typedef enum _Adafruit_BusIO_SPIRegType {
@@ -62,15 +63,28 @@ public:
   bool read(uint16_t *value);
   uint32_t read(void);
   uint32_t readCached(void);
+  uint32_t readShadow(void);
   bool write(uint8_t *buffer, uint8_t len);
   bool write(uint32_t value, uint8_t numbytes = 0);
 
+  bool read_async(Adafruit_I2CQueue *queue, Adafruit_I2CTransaction *txn,
+                  uint8_t *buffer, uint8_t len,
+                  Adafruit_I2CCallback callback = nullptr,
+                  void *user = nullptr);
+  bool write_async(Adafruit_I2CQueue *queue, Adafruit_I2CTransaction *txn,
+                   const uint8_t *buffer, uint8_t len,
+                   Adafruit_I2CCallback callback = nullptr,
+                   void *user = nullptr);
+
   uint8_t width(void);
 
   void setWidth(uint8_t width);
   void setAddress(uint16_t address);
   void setAddressWidth(uint16_t address_width);
 
+  void enableCache(bool enable = true);
+  void invalidateCache(void);
+
   void print(Stream *s = &Serial);
   void println(Stream *s = &Serial);
 
@@ -83,6 +97,12 @@ private:
   uint8_t _buffer[4]; // we won't support anything larger than uint32 for
                       // non-buffered read
   uint32_t _cached = 0;
+  bool _cache_enabled = false;
+  bool _cache_valid = false;
+  bool submit(Adafruit_I2CQueue *queue, Adafruit_I2CTransaction *txn,
+              const uint8_t *write_buffer, uint8_t write_len,
+              uint8_t *read_buffer, uint8_t read_len,
+              Adafruit_I2CCallback callback, void *user);
 };
 
 /*!
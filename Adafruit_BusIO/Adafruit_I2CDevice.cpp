@@ -1,4 +1,5 @@
 #include "Adafruit_I2CDevice.h"
+#include "Adafruit_I2CQueue.h"
 
 //#define DEBUG_SERIAL Serial
 
@@ -254,6 +255,42 @@ bool Adafruit_I2CDevice::write_then_read(const uint8_t *write_buffer,
   return read(read_buffer, read_len);
 }
 
+/*!
+ *    @brief  Queue a write_then_read() and return without waiting for it.
+ *    Either length may be 0 for a plain read or write. The transfer happens
+ *    when the queue is run, with the same maxBufferSize() limits.
+ *    @param  queue The queue of the bus this device is on
+ *    @param  txn Caller owned transaction, must stay valid until completed
+ *    @param  write_buffer Pointer to buffer of data to write from, must stay
+ *    valid until completed
+ *    @param  write_len Number of bytes from buffer to write.
+ *    @param  read_buffer Pointer to buffer of data to read into.
+ *    @param  read_len Number of bytes from buffer to read.
+ *    @param  callback Called once completed, check txn->ok for the result
+ *    @param  user Stored in txn->user for the callback
+ *    @param  stop Whether to send an I2C STOP signal between the write and read
+ *    @return True if queued, false if txn is still pending
+ */
+bool Adafruit_I2CDevice::write_then_read_async(
+    Adafruit_I2CQueue *queue, Adafruit_I2CTransaction *txn,
+    const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+    size_t read_len, void (*callback)(Adafruit_I2CTransaction *), void *user,
+    bool stop) {
+  if (txn->pending()) {
+    return false;
+  }
+  txn->device = this;
+  txn->write_buffer = write_buffer;
+  txn->write_len = write_len;
+  txn->read_buffer = read_buffer;
+  txn->read_len = read_len;
+  txn->stop = stop;
+  txn->prefix_len = 0;
+  txn->callback = callback;
+  txn->user = user;
+  return queue->submit(txn);
+}
+
 /*!
  *    @brief  Returns the 7-bit address of this device
  *    @return The 7-bit address of this device
@@ -4,6 +4,9 @@
 #include <Arduino.h>
 #include <Wire.h>
 
+class Adafruit_I2CQueue;
+class Adafruit_I2CTransaction;
+
 ///< The class which defines how we will talk to this device over I2C
 class Adafruit_I2CDevice {
 public:
@@ -19,6 +22,13 @@ public:
   bool write_then_read(const uint8_t *write_buffer, size_t write_len,
                        uint8_t *read_buffer, size_t read_len,
                        bool stop = false);
+  bool write_then_read_async(Adafruit_I2CQueue *queue,
+                             Adafruit_I2CTransaction *txn,
+                             const uint8_t *write_buffer, size_t write_len,
+                             uint8_t *read_buffer, size_t read_len,
+                             void (*callback)(Adafruit_I2CTransaction *) =
+                                 nullptr,
+                             void *user = nullptr, bool stop = false);
   bool setSpeed(uint32_t desiredclk);
 
   /*!   @brief  How many bytes we can read in a transaction
@@ -0,0 +1,162 @@
+#include "Adafruit_I2CQueue.h"
+
+#ifdef BUSIO_QUEUE_HAS_TASK
+#define BUSIO_QUEUE_LOCK() portENTER_CRITICAL(&_mux)
+#define BUSIO_QUEUE_UNLOCK() portEXIT_CRITICAL(&_mux)
+#else
+#define BUSIO_QUEUE_LOCK() noInterrupts()
+#define BUSIO_QUEUE_UNLOCK() interrupts()
+#endif
+
+/*!
+ *    @brief  Create an empty transaction
+ */
+Adafruit_I2CTransaction::Adafruit_I2CTransaction(void) {
+  device = nullptr;
+  write_buffer = nullptr;
+  write_len = 0;
+  read_buffer = nullptr;
+  read_len = 0;
+  stop = false;
+  prefix_len = 0;
+  callback = nullptr;
+  user = nullptr;
+  ok = false;
+  _pending = false;
+  _next = nullptr;
+}
+
+/*!
+ *    @brief  Create an empty queue. Without beginTask() it only moves when
+ *    run() is called.
+ */
+Adafruit_I2CQueue::Adafruit_I2CQueue(void) {
+  _head = nullptr;
+  _tail = nullptr;
+  _busy = false;
+#ifdef BUSIO_QUEUE_HAS_TASK
+  _task = nullptr;
+#endif
+}
+
+/*!
+ *    @brief  Append a transaction to the queue. Do not call from an
+ *    interrupt.
+ *    @param  txn The transaction, which must not already be pending
+ *    @return True if queued, false if txn is already pending or has no device
+ */
+bool Adafruit_I2CQueue::submit(Adafruit_I2CTransaction *txn) {
+  if (txn->_pending || !txn->device) {
+    return false;
+  }
+  txn->ok = false;
+  txn->_next = nullptr;
+  txn->_pending = true;
+
+  BUSIO_QUEUE_LOCK();
+  if (_tail) {
+    _tail->_next = txn;
+  } else {
+    _head = txn;
+  }
+  _tail = txn;
+  BUSIO_QUEUE_UNLOCK();
+
+#ifdef BUSIO_QUEUE_HAS_TASK
+  if (_task) {
+    xTaskNotifyGive(_task);
+  }
+#endif
+  return true;
+}
+
+/*!
+ *    @brief  Perform every transaction queued so far, in order, and call
+ *    their callbacks. Transactions submitted meanwhile (e.g. by a callback)
+ *    wait for the next call. Do not call when beginTask() is in use.
+ *    @return The number of transactions completed
+ */
+size_t Adafruit_I2CQueue::run(void) {
+  BUSIO_QUEUE_LOCK();
+  Adafruit_I2CTransaction *batch = _head;
+  _head = nullptr;
+  _tail = nullptr;
+  _busy = (batch != nullptr);
+  BUSIO_QUEUE_UNLOCK();
+
+  size_t count = 0;
+  while (batch) {
+    Adafruit_I2CTransaction *txn = batch;
+    batch = txn->_next;
+    txn->ok = execute(txn);
+    txn->_pending = false;
+    count++;
+    if (txn->callback) {
+      // may resubmit txn, which reuses _next, so we already moved on
+      txn->callback(txn);
+    }
+  }
+  _busy = false;
+  return count;
+}
+
+/*!
+ *    @brief  Whether the queue is empty and no transaction is in progress
+ *    @return True if there is nothing left to do
+ */
+bool Adafruit_I2CQueue::idle(void) { return !_head && !_busy; }
+
+bool Adafruit_I2CQueue::execute(Adafruit_I2CTransaction *txn) {
+  Adafruit_I2CDevice *dev = txn->device;
+  bool stop = txn->read_len ? txn->stop : true;
+
+  if (txn->write_len) {
+    if (!dev->write(txn->write_buffer, txn->write_len, stop, txn->prefix,
+                    txn->prefix_len)) {
+      return false;
+    }
+  } else if (txn->prefix_len) {
+    if (!dev->write(txn->prefix, txn->prefix_len, stop)) {
+      return false;
+    }
+  }
+
+  if (txn->read_len) {
+    return dev->read(txn->read_buffer, txn->read_len);
+  }
+  return true;
+}
+
+#ifdef BUSIO_QUEUE_HAS_TASK
+/*!
+ *    @brief  Drain the queue from a FreeRTOS task of its own, woken by
+ *    submit(). Callbacks then run in that task.
+ *    @param  stack_size Stack of the task in bytes, callbacks run on it
+ *    @param  priority FreeRTOS priority of the task
+ *    @param  core The core to pin the task to, or tskNO_AFFINITY
+ *    @return True if the task is running
+ */
+bool Adafruit_I2CQueue::beginTask(uint32_t stack_size, UBaseType_t priority,
+                                  BaseType_t core) {
+  if (_task) {
+    return true;
+  }
+  if (xTaskCreatePinnedToCore(task, "busio_i2c", stack_size, this, priority,
+                              &_task, core) != pdPASS) {
+    _task = nullptr;
+    return false;
+  }
+  // pick up anything submitted before the task existed
+  xTaskNotifyGive(_task);
+  return true;
+}
+
+void Adafruit_I2CQueue::task(void *arg) {
+  Adafruit_I2CQueue *queue = (Adafruit_I2CQueue *)arg;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (queue->run()) {
+    }
+  }
+}
+#endif
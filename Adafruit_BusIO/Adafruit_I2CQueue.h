@@ -0,0 +1,81 @@
+#ifndef Adafruit_I2CQueue_h
+#define Adafruit_I2CQueue_h
+
+#include <Adafruit_I2CDevice.h>
+#include <Arduino.h>
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#define BUSIO_QUEUE_HAS_TASK
+#endif
+
+class Adafruit_I2CTransaction;
+
+/*!   @brief  Called when a queued transaction has completed. Runs in the
+ *    context that drained the queue: loop() via run(), or the queue task. */
+typedef void (*Adafruit_I2CCallback)(Adafruit_I2CTransaction *txn);
+
+/*!
+ * @brief One queued write and/or read. The storage belongs to the caller
+ * and must stay valid, together with the buffers it points to, until the
+ * callback has run or pending() returns false.
+ */
+class Adafruit_I2CTransaction {
+public:
+  Adafruit_I2CTransaction(void);
+
+  /*!   @brief  Whether the transaction is queued or in progress
+   *    @return True until the transaction has completed */
+  bool pending(void) { return _pending; }
+
+  Adafruit_I2CDevice *device;  ///< The device to talk to
+  const uint8_t *write_buffer; ///< Data to write, may be nullptr
+  size_t write_len;            ///< Number of bytes to write
+  uint8_t *read_buffer;        ///< Where to read into, may be nullptr
+  size_t read_len;             ///< Number of bytes to read
+  bool stop; ///< Whether to send a STOP between the write and the read
+  uint8_t prefix[2];  ///< Register address written before write_buffer
+  uint8_t prefix_len; ///< Number of bytes of prefix in use
+  Adafruit_I2CCallback callback; ///< Called on completion, may be nullptr
+  void *user;                    ///< Free for the caller, e.g. a driver
+  bool ok; ///< True if the transaction succeeded, valid once completed
+
+private:
+  friend class Adafruit_I2CQueue;
+  volatile bool _pending;
+  Adafruit_I2CTransaction *_next;
+};
+
+/*!
+ * @brief A FIFO of I2C transactions for one bus. Drivers submit and return
+ * immediately; the queue is drained in batches by run(), or on ESP32 by a
+ * task of its own so the transfers overlap with the rest of the sketch.
+ */
+class Adafruit_I2CQueue {
+public:
+  Adafruit_I2CQueue(void);
+
+  bool submit(Adafruit_I2CTransaction *txn);
+  size_t run(void);
+  bool idle(void);
+
+#ifdef BUSIO_QUEUE_HAS_TASK
+  bool beginTask(uint32_t stack_size = 3072, UBaseType_t priority = 1,
+                 BaseType_t core = tskNO_AFFINITY);
+#endif
+
+private:
+  Adafruit_I2CTransaction *_head;
+  Adafruit_I2CTransaction *_tail;
+  volatile bool _busy;
+  bool execute(Adafruit_I2CTransaction *txn);
+
+#ifdef BUSIO_QUEUE_HAS_TASK
+  portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+  TaskHandle_t _task;
+  static void task(void *arg);
+#endif
+};
+
+#endif // Adafruit_I2CQueue_h
@@ -0,0 +1,61 @@
+#include <Adafruit_I2CDevice.h>
+#include <Adafruit_I2CQueue.h>
+#include <Adafruit_BusIO_Register.h>
+
+// Two devices read through one queue, without waiting on the bus
+Adafruit_I2CDevice dev_a = Adafruit_I2CDevice(0x60);
+Adafruit_I2CDevice dev_b = Adafruit_I2CDevice(0x77);
+
+Adafruit_I2CQueue queue;
+
+Adafruit_BusIO_Register id_reg = Adafruit_BusIO_Register(&dev_a, 0x0C, 2, LSBFIRST);
+Adafruit_I2CTransaction id_txn;
+uint8_t id_buffer[2];
+
+Adafruit_I2CTransaction data_txn;
+const uint8_t data_cmd[1] = {0xF7};
+uint8_t data_buffer[6];
+
+void done(Adafruit_I2CTransaction *txn) {
+  Serial.print((const char *)txn->user);
+  if (!txn->ok) {
+    Serial.println(" failed");
+    return;
+  }
+  for (size_t i = 0; i < txn->read_len; i++) {
+    Serial.print(" 0x"); Serial.print(txn->read_buffer[i], HEX);
+  }
+  Serial.println();
+}
+
+void setup() {
+  while (!Serial) { delay(10); }
+  Serial.begin(115200);
+  Serial.println("I2C queue test");
+
+  dev_a.begin();
+  dev_b.begin();
+
+#ifdef BUSIO_QUEUE_HAS_TASK
+  // ESP32: a task drains the queue, run() is not needed
+  queue.beginTask();
+#endif
+}
+
+void loop() {
+  // both reads go out as one batch
+  if (!id_txn.pending()) {
+    id_reg.read_async(&queue, &id_txn, id_buffer, 2, done, (void *)"id");
+  }
+  if (!data_txn.pending()) {
+    dev_b.write_then_read_async(&queue, &data_txn, data_cmd, 1, data_buffer, 6,
+                                done, (void *)"data");
+  }
+
+#ifndef BUSIO_QUEUE_HAS_TASK
+  queue.run();
+#endif
+
+  // other work goes here
+  delay(500);
+}
@@ -8,6 +8,8 @@
 
 #if defined(ARDUINO_ARCH_SAMD)
 
+#include <malloc.h> // memalign() for the DMA descriptors
+
 #define SAMPLERATE_HZ 22000
 #define DECIMATION    64
 
@@ -22,6 +24,22 @@ uint16_t sincfilter[DECIMATION] = {0, 2, 9, 21, 39, 63, 94, 132, 179, 236, 302,
 
 static bool pdmConfigured = false;
 
+// Convolve one 16-bit PDM read into runningsum, advancing sinc_ptr.
+static inline void sincAccumulate(uint16_t &runningsum, uint16_t *&sinc_ptr,
+  uint16_t sample) {
+  ADAPDM_REPEAT_LOOP_16(      // manually unroll loop: for (int8_t b=0; b<16; b++) 
+    {
+      // start at the LSB which is the 'first' bit to come down the line, chronologically 
+      // (Note we had to set I2S_SERCTRL_BITREV to get this to work, but saves us time!)
+      if (sample & 0x1) {
+        runningsum += *sinc_ptr;     // do the convolution
+      }
+      sinc_ptr++;
+      sample >>= 1;
+    }
+  )
+}
+
 #elif defined(ARDUINO_NRF52840_CIRCUITPLAY)
 
 #include <PDM.h>
@@ -50,6 +68,166 @@ static bool pdmConfigured = false;
 #define DC_OFFSET       (1023 / 3)
 #define NOISE_THRESHOLD 3
 
+#ifdef __AVR__
+  #define SPL_GAIN 1.3
+#elif defined(ARDUINO_ARCH_SAMD)
+  #define SPL_GAIN 9
+#else
+  #define SPL_GAIN 2
+#endif
+
+// Sign-convert an AVR ADC reading: FFT requires signed inputs; ADC output
+// is unsigned.  DC offset is NOT 512 on Circuit Playground because it uses
+// a 1.1V OpAmp input as the midpoint, and may swing asymmetrically on the
+// high side.  Sign-convert and then clip range to +/- DC_OFFSET.
+static inline int16_t adcToSample(int16_t adc) {
+  if(adc <= (DC_OFFSET - NOISE_THRESHOLD)) {
+    adc  -= DC_OFFSET;
+  } else if(adc >= (DC_OFFSET + NOISE_THRESHOLD)) {
+    adc  -= DC_OFFSET;
+    if(adc > (DC_OFFSET * 2)) adc = DC_OFFSET * 2;
+  } else {
+    adc   = 0; // Below noise threshold
+  }
+  return adc;
+}
+
+// Converts a peak deviation (0-1023 scale) to a somewhat-calibrated SPL.
+static float peakToSPL(int16_t maxVal) {
+  double pref = 0.00002;
+  double conv = ((float)maxVal)/1023 * SPL_GAIN;
+  conv = 20 * log10(conv/pref);
+
+  if(isfinite(conv)) return conv;
+  else return 52;
+}
+
+#if defined(__AVR__) || defined(ARDUINO_ARCH_SAMD)
+#define MIC_CONTINUOUS
+
+// Continuous capture state.  On AVR the ADC runs free with its conversion
+// interrupt pushing every sample; on SAMD the PDM data is DMA'd into a raw
+// ring and decimated whenever the sketch asks for data (micService()).
+// Either way nothing blocks waiting for audio: window() returns the most
+// recent samples, so successive FFT windows overlap, and SPL comes from
+// per-block min/max/sum kept as the samples arrive.
+typedef struct {
+  int16_t lo, hi;  // Sample range within the block
+  int32_t sum;     // For the DC offset
+} micBlock_t;
+
+static int16_t           *micRing   = NULL; // CPLAY_MIC_RING_SIZE samples
+static micBlock_t        *micBlocks = NULL; // CPLAY_MIC_BLOCKS finished blocks
+static volatile uint16_t  micHead   = 0;    // Samples written, wraps
+static volatile uint16_t  micFill   = 0;    // Valid samples in micRing
+static volatile uint16_t  micHops   = 0;    // Blocks finished, wraps
+static volatile uint8_t   micBlockIdx;      // Next block to write
+static micBlock_t         micAcc;           // Block being accumulated
+static uint8_t            micAccCount;
+static uint16_t           micHopsSeen;      // micHops at last window()
+static volatile bool      micRunning = false;
+
+static inline void micPush(int16_t s) {
+  micRing[micHead & (CPLAY_MIC_RING_SIZE - 1)] = s;
+  micHead++;
+  if(micFill < CPLAY_MIC_RING_SIZE) micFill++;
+  if(s < micAcc.lo) micAcc.lo = s;
+  if(s > micAcc.hi) micAcc.hi = s;
+  micAcc.sum += s;
+  if(++micAccCount >= CPLAY_MIC_HOP) {
+    micBlocks[micBlockIdx] = micAcc;
+    micBlockIdx = (micBlockIdx + 1) & (CPLAY_MIC_BLOCKS - 1);
+    micHops++;
+    micAcc.lo    = 32767;
+    micAcc.hi    = -32768;
+    micAcc.sum   = 0;
+    micAccCount  = 0;
+  }
+}
+
+#ifdef __AVR__
+
+static uint8_t micAdmux, micAdcsra, micAdcsrb; // ADC config to restore
+
+#ifndef CPLAY_MIC_NO_ADC_ISR // Define if the sketch needs ADC_vect itself
+ISR(ADC_vect) {
+  micPush(adcToSample(ADC));
+}
+#endif
+
+static inline void micService(void) { }
+
+#else // SAMD
+
+static volatile uint32_t *micPdm  = NULL; // CPLAY_MIC_PDM_WORDS raw words
+static uint16_t           micPdmPos;      // Next raw word to decimate
+static DmacDescriptor    *micDmaDesc = NULL, *micDmaWb = NULL;
+
+// Decimate whatever the DMA has written since the last call.  The channel
+// reloads its own descriptor, so the write position is simply how far it
+// got through the current block (the write-back BTCNT, updated per beat).
+static void micService(void) {
+  if(!micRunning) return;
+  DmacDescriptor *wb = (DmacDescriptor *)DMAC->WRBADDR.reg + CPLAY_MIC_DMA_CHANNEL;
+  uint16_t pos = CPLAY_MIC_PDM_WORDS - wb->BTCNT.reg;
+  if(pos >= CPLAY_MIC_PDM_WORDS) pos = 0;
+  pos &= ~(DECIMATION/16 - 1);           // Whole samples only
+  while(micPdmPos != pos) {
+    uint16_t runningsum = 0;
+    uint16_t *sinc_ptr = sincfilter;
+    for (uint8_t samplenum=0; samplenum < (DECIMATION/16) ; samplenum++) {
+      sincAccumulate(runningsum, sinc_ptr, micPdm[micPdmPos++] & 0xFFFF);
+    }
+    if(micPdmPos >= CPLAY_MIC_PDM_WORDS) micPdmPos = 0;
+    runningsum /= 64 ; // convert 16 bit -> 10 bit
+    runningsum -= 512;  // make it close to 0-offset signed
+    micPush(runningsum);
+  }
+}
+
+#endif
+
+// SPL over the most recent 'n' finished blocks.
+static float micBlocksSPL(uint8_t n) {
+  int32_t sum = 0;
+  int16_t lo  = 32767, hi = -32768;
+  noInterrupts();
+  if(n > micHops) n = micHops;
+  for(uint8_t i=0; i<n; i++) {
+    micBlock_t *b = &micBlocks[(micBlockIdx - 1 - i) & (CPLAY_MIC_BLOCKS - 1)];
+    if(b->lo < lo) lo = b->lo;
+    if(b->hi > hi) hi = b->hi;
+    sum += b->sum;
+  }
+  interrupts();
+  if(!n) return 52;
+  int16_t avg = sum / ((int32_t)n * CPLAY_MIC_HOP);
+  return peakToSPL(max(hi - avg, avg - lo));
+}
+
+// Copy the next nSamples arriving after this call (what capture() does
+// when the hardware is already busy streaming).
+static void micRead(int16_t *buf, uint16_t nSamples) {
+  noInterrupts();
+  uint16_t next = micHead;
+  interrupts();
+  while(nSamples) {
+    micService();
+    noInterrupts();
+    uint16_t head = micHead;
+    interrupts();
+    uint16_t n = head - next;
+    if(n > nSamples) n = nSamples;
+    for(uint16_t i=0; i<n; i++) {
+      *buf++ = micRing[next++ & (CPLAY_MIC_RING_SIZE - 1)];
+    }
+    nSamples -= n;
+    if(nSamples) yield();
+  }
+}
+
+#endif // MIC_CONTINUOUS
+
 /**************************************************************************/
 /*! 
     @brief  Reads ADC for given interval (in milliseconds, 1-65535). Uses ADC free-run mode w/polling on AVR.
@@ -81,9 +259,17 @@ int Adafruit_CPlay_Mic::peak(uint16_t ms) {
       will be temporarily disabled while this runs.  No other interrupts are
       disabled; as long as interrupt handlers are minor (e.g. Timer/Counter 0
       handling of millis() and micros()), this isn't likely to lose readings.
+    @note While continuous capture is running (beginContinuous()) the next
+      nSamples are taken from the stream instead.
 */
 /**************************************************************************/
 void Adafruit_CPlay_Mic::capture(int16_t *buf, uint16_t nSamples) {
+#ifdef MIC_CONTINUOUS
+  if(micRunning) {
+    micRead(buf, nSamples);
+    return;
+  }
+#endif
 #ifdef __AVR__
   uint8_t admux_save, adcsra_save, adcsrb_save, timsk0_save, channel;
   int16_t adc;
@@ -112,19 +298,7 @@ void Adafruit_CPlay_Mic::capture(int16_t *buf, uint16_t nSamples) {
     while(!(ADCSRA & _BV(ADIF)));      // Wait for ADC result
     adc     = ADC;
     ADCSRA |= _BV(ADIF);               // Clear bit
-    // FFT requires signed inputs; ADC output is unsigned.  DC offset is
-    // NOT 512 on Circuit Playground because it uses a 1.1V OpAmp input
-    // as the midpoint, and may swing asymmetrically on the high side.
-    // Sign-convert and then clip range to +/- DC_OFFSET.
-    if(adc <= (DC_OFFSET - NOISE_THRESHOLD)) {
-      adc  -= DC_OFFSET;
-    } else if(adc >= (DC_OFFSET + NOISE_THRESHOLD)) {
-      adc  -= DC_OFFSET;
-      if(adc > (DC_OFFSET * 2)) adc = DC_OFFSET * 2;
-    } else {
-      adc   = 0; // Below noise threshold
-    }
-    buf[i]  = adc;
+    buf[i]  = adcToSample(adc);
   }
 
   ADMUX  = admux_save;                 // Restore ADC config
@@ -146,17 +320,7 @@ void Adafruit_CPlay_Mic::capture(int16_t *buf, uint16_t nSamples) {
     for (uint8_t samplenum=0; samplenum < (DECIMATION/16) ; samplenum++) {
        uint16_t sample = pdm.read() & 0xFFFF;    // we read 16 bits at a time, by default the low half
 
-       ADAPDM_REPEAT_LOOP_16(      // manually unroll loop: for (int8_t b=0; b<16; b++) 
-         {
-           // start at the LSB which is the 'first' bit to come down the line, chronologically 
-           // (Note we had to set I2S_SERCTRL_BITREV to get this to work, but saves us time!)
-           if (sample & 0x1) {
-             runningsum += *sinc_ptr;     // do the convolution
-           }
-           sinc_ptr++;
-           sample >>= 1;
-        }
-      )
+       sincAccumulate(runningsum, sinc_ptr, sample);
     }
 
     // since we wait for the samples from I2S peripheral, we dont need to delay, we will 'naturally'
@@ -198,30 +362,33 @@ void Adafruit_CPlay_Mic::capture(int16_t *buf, uint16_t nSamples) {
     @brief Returns somewhat-calibrated sound pressure level.
     @param ms Milliseconds to continuously sample microphone over, 10ms is a good start.
     @returns Floating point Sound Pressure Level, tends to range from 40-120 db SPL
+    @note While continuous capture is running this returns immediately,
+      using the most recent ms of audio (up to CPLAY_MIC_BLOCKS - 1 blocks).
 */
 /**************************************************************************/
 float Adafruit_CPlay_Mic::soundPressureLevel(uint16_t ms){
-  double gain;
   int16_t *ptr;
   uint16_t len;
-  int16_t minVal = 52;
 #ifdef __AVR__
-  gain = 1.3;
   len = 9.615 * ms;
 #elif defined(ARDUINO_ARCH_SAMD)
-  gain = 9;
   len = (float)(SAMPLERATE_HZ/1000) * ms;
 #elif defined(ARDUINO_NRF52840_CIRCUITPLAY)
-  gain = 2;
   len = (float)(SAMPLERATE_HZ/1000) * ms;
 #else
   #error "no compatible architecture defined."
+#endif
+#ifdef MIC_CONTINUOUS
+  if(micRunning) {
+    micService();
+    uint16_t blocks = (len + CPLAY_MIC_HOP - 1) / CPLAY_MIC_HOP;
+    return micBlocksSPL(min(blocks, (uint16_t)(CPLAY_MIC_BLOCKS - 1)));
+  }
 #endif
   int16_t data[len];
   capture(data, len);
 
   int16_t *end = data + len;
-  double pref = 0.00002;
 
   /*******************************
    *   REMOVE DC OFFSET
@@ -244,16 +411,225 @@ float Adafruit_CPlay_Mic::soundPressureLevel(uint16_t ms){
      int32_t v = abs(*ptr++);
      if(v > maxVal) maxVal = v;
    }
-   
-   double conv = ((float)maxVal)/1023 * gain;
 
    /*******************************
    *   CALCULATE SPL
    ******************************/
-   conv = 20 * log10(conv/pref);
+   return peakToSPL(maxVal);
+}
+
+/**************************************************************************/
+/*! 
+    @brief  Start capturing microphone audio continuously in the background
+      into a ring buffer, so window(), fft() and soundPressureLevel() return
+      at once with the latest audio instead of sampling for the whole window.
+      AVR: ADC free-run mode with its conversion interrupt (9615 Hz); the ADC
+      belongs to the mic until endContinuous(), so analogRead() based sensors
+      (light, temperature, sound) must not be used meanwhile.  SAMD: the PDM
+      mic is read by DMA (channel CPLAY_MIC_DMA_CHANNEL) at 22000 Hz and
+      decimated whenever data is requested; start any other DMA user first.
+    @return true on success, false if there is no RAM for the buffers or the
+      board isn't supported (nRF52840).
+*/
+/**************************************************************************/
+bool Adafruit_CPlay_Mic::beginContinuous(void) {
+#ifdef MIC_CONTINUOUS
+  if(micRunning) return true;
+#if defined(__AVR__) && defined(CPLAY_MIC_NO_ADC_ISR)
+  return false;
+#endif
+
+  if(!micRing) {
+    micRing   = (int16_t *)malloc(CPLAY_MIC_RING_SIZE * sizeof(int16_t));
+    micBlocks = (micBlock_t *)malloc(CPLAY_MIC_BLOCKS * sizeof(micBlock_t));
+    if(!micRing || !micBlocks) {
+      endContinuous();
+      return false;
+    }
+  }
+  micHead     = micFill = micHops = micHopsSeen = 0;
+  micBlockIdx = 0;
+  micAcc.lo   = 32767;
+  micAcc.hi   = -32768;
+  micAcc.sum  = 0;
+  micAccCount = 0;
+
+#ifdef __AVR__
+  micAdmux  = ADMUX;                   // Save ADC config registers
+  micAdcsra = ADCSRA;
+  micAdcsrb = ADCSRB;
+  micRunning = true;
+
+  // Same free-run setup as capture(), but with the conversion interrupt
+  ADCSRA = 0;
+  ADMUX  = _BV(REFS0) | analogPinToChannel(4);
+  ADCSRB = 0;
+  ADCSRA = _BV(ADEN)  | _BV(ADSC) | _BV(ADATE) | _BV(ADIF) | _BV(ADIE) |
+           _BV(ADPS2) | _BV(ADPS1);    // 64:1 / 13 = 9615 Hz
+#else
+  if(!micPdm && !(micPdm = (uint32_t *)malloc(CPLAY_MIC_PDM_WORDS * sizeof(uint32_t)))) {
+    endContinuous();
+    return false;
+  }
+  if(!pdmConfigured){
+    pdm.begin();
+    pdm.configure(SAMPLERATE_HZ * DECIMATION / 16, true);
+    pdmConfigured = true;
+  }
 
-   if(isfinite(conv)) return conv;
-   else return minVal;
+  PM->AHBMASK.bit.DMAC_  = 1;
+  PM->APBBMASK.bit.DMAC_ = 1;
+  if(!DMAC->CTRL.bit.DMAENABLE) { // Nobody else uses DMA (yet), set it up
+    if(!micDmaDesc) {
+      micDmaDesc = (DmacDescriptor *)memalign(16, DMAC_CH_NUM * sizeof(DmacDescriptor));
+      micDmaWb   = (DmacDescriptor *)memalign(16, DMAC_CH_NUM * sizeof(DmacDescriptor));
+    }
+    if(!micDmaDesc || !micDmaWb) {
+      endContinuous();
+      return false;
+    }
+    memset(micDmaDesc, 0, DMAC_CH_NUM * sizeof(DmacDescriptor));
+    memset(micDmaWb, 0, DMAC_CH_NUM * sizeof(DmacDescriptor));
+    DMAC->BASEADDR.reg = (uint32_t)micDmaDesc;
+    DMAC->WRBADDR.reg  = (uint32_t)micDmaWb;
+    DMAC->CTRL.reg     = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN(0xF);
+  }
+
+  // One descriptor pointing back at itself: an endless circular transfer
+  DmacDescriptor *desc = (DmacDescriptor *)DMAC->BASEADDR.reg + CPLAY_MIC_DMA_CHANNEL;
+  desc->BTCTRL.reg   = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BLOCKACT_NOACT |
+                       DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_DSTINC;
+  desc->BTCNT.reg    = CPLAY_MIC_PDM_WORDS;
+  desc->SRCADDR.reg  = (uint32_t)&I2S->DATA[pdm.getSerializer()].reg;
+  desc->DSTADDR.reg  = (uint32_t)(micPdm + CPLAY_MIC_PDM_WORDS); // End address
+  desc->DESCADDR.reg = (uint32_t)desc;
+  micPdmPos = 0;
+
+  noInterrupts();
+  DMAC->CHID.reg    = DMAC_CHID_ID(CPLAY_MIC_DMA_CHANNEL);
+  DMAC->CHCTRLA.reg = 0;
+  while(DMAC->CHCTRLA.bit.ENABLE);
+  DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+  while(DMAC->CHCTRLA.bit.SWRST);
+  DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) | DMAC_CHCTRLB_TRIGACT_BEAT |
+    DMAC_CHCTRLB_TRIGSRC(I2S_DMAC_ID_RX_0 + pdm.getSerializer());
+  DMAC->CHCTRLA.reg = DMAC_CHCTRLA_ENABLE;
+  interrupts();
+  micRunning = true;
+#endif
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**************************************************************************/
+/*! 
+    @brief  Stop continuous capture, restore the ADC (AVR) and free the
+      ring buffers.
+*/
+/**************************************************************************/
+void Adafruit_CPlay_Mic::endContinuous(void) {
+#ifdef MIC_CONTINUOUS
+  if(micRunning) {
+#ifdef __AVR__
+    ADCSRA = 0;                        // Stop ADC interrupt
+    micRunning = false;
+    ADMUX  = micAdmux;                 // Restore ADC config
+    ADCSRB = micAdcsrb;
+    ADCSRA = micAdcsra;
+    (void)analogRead(A4);              // Purge residue from ADC register
+#else
+    noInterrupts();
+    DMAC->CHID.reg    = DMAC_CHID_ID(CPLAY_MIC_DMA_CHANNEL);
+    DMAC->CHCTRLA.reg = 0;
+    while(DMAC->CHCTRLA.bit.ENABLE);
+    interrupts();
+    micRunning = false;
+#endif
+  }
+#ifndef __AVR__
+  free((void *)micPdm);
+  micPdm = NULL;
+  // micDmaDesc/micDmaWb stay allocated, the DMAC may still point at them
+#endif
+  free(micRing);
+  free(micBlocks);
+  micRing   = NULL;
+  micBlocks = NULL;
+#endif
+}
+
+/**************************************************************************/
+/*! 
+    @brief  Check whether continuous capture is running.
+    @return true between beginContinuous() and endContinuous()
+*/
+/**************************************************************************/
+bool Adafruit_CPlay_Mic::continuous(void) {
+#ifdef MIC_CONTINUOUS
+  return micRunning;
+#else
+  return false;
+#endif
+}
+
+/**************************************************************************/
+/*! 
+    @brief  Continuous capture: check whether another CPLAY_MIC_HOP samples
+      have arrived since the last window() or fft(), i.e. whether a new
+      (overlapping) analysis window is ready.
+    @return true if new audio is available
+*/
+/**************************************************************************/
+bool Adafruit_CPlay_Mic::available(void) {
+#ifdef MIC_CONTINUOUS
+  if(!micRunning) return false;
+  micService();
+  noInterrupts();
+  uint16_t hops = micHops;
+  interrupts();
+  return hops != micHopsSeen;
+#else
+  return false;
+#endif
+}
+
+/**************************************************************************/
+/*! 
+    @brief  Continuous capture: copy the most recent samples, oldest first,
+      without waiting.  Calling this every CPLAY_MIC_HOP samples gives
+      overlapping windows for an FFT (e.g. ZeroFFT on the Express).
+    @param buf the buffer to store the samples in
+    @param nSamples the number of samples wanted, at most
+      CPLAY_MIC_RING_SIZE - CPLAY_MIC_HOP
+    @return the number of samples copied, fewer than nSamples right after
+      beginContinuous() and 0 when continuous capture isn't running
+*/
+/**************************************************************************/
+uint16_t Adafruit_CPlay_Mic::window(int16_t *buf, uint16_t nSamples) {
+#ifdef MIC_CONTINUOUS
+  if(!micRunning) return 0;
+  micService();
+  // Keep a hop of slack so the writer can't lap us while copying
+  if(nSamples > CPLAY_MIC_RING_SIZE - CPLAY_MIC_HOP) {
+    nSamples = CPLAY_MIC_RING_SIZE - CPLAY_MIC_HOP;
+  }
+  noInterrupts();
+  uint16_t head = micHead, fill = micFill;
+  micHopsSeen   = micHops;
+  interrupts();
+  if(nSamples > fill) nSamples = fill;
+  uint16_t i = head - nSamples;
+  for(uint16_t n=0; n<nSamples; n++) {
+    buf[n] = micRing[i++ & (CPLAY_MIC_RING_SIZE - 1)];
+  }
+  return nSamples;
+#else
+  (void)buf;
+  (void)nSamples;
+  return 0;
+#endif
 }
 
 /**************************************************************************/
@@ -279,6 +655,9 @@ extern "C" { // In ffft.S
       frequencies from 0 to 4800 Hz (i.e. 0-150 Hz, 150-300 Hz, 300-450, etc).
       Needs about 450 bytes free RAM to operate.
     @param spectrum the buffer to store the results in. Must be 32 bytes in length.
+    @note While continuous capture is running the latest 64 samples are
+      used without waiting, so calling this whenever available() is true
+      gives a new spectrum every CPLAY_MIC_HOP samples (50% overlap).
 
     @note THIS FUNCTION IS DEPRECATED AND WILL BE REMOVED IN A FUTURE RELEASE.
 */
@@ -289,7 +668,8 @@ void Adafruit_CPlay_Mic::fft(
     int16_t   capBuf[64];            // Audio capture buffer
     complex_t butterfly[64];         // FFT "butterfly" buffer
 
-    capture(capBuf, 64);             // Collect mic data into capBuf
+    if(window(capBuf, 64) < 64)      // Latest audio if streaming, else
+      capture(capBuf, 64);           // collect mic data into capBuf
     fft_input(capBuf, butterfly);    // Samples -> complex #s
     fft_execute(butterfly);          // Process complex data
     fft_output(butterfly, spectrum); // Complex -> spectrum (32 bins)
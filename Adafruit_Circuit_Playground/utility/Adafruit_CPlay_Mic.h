@@ -17,6 +17,28 @@
 
 #include "Adafruit_ZeroPDM.h"
 
+// Continuous capture (beginContinuous()) settings. Ring size, hop and
+// block count must be powers of 2.
+#ifndef CPLAY_MIC_RING_SIZE
+  #ifdef __AVR__
+    #define CPLAY_MIC_RING_SIZE 128  ///< Most recent samples kept for window()
+  #else
+    #define CPLAY_MIC_RING_SIZE 512  ///< Most recent samples kept for window()
+  #endif
+#endif
+#ifndef CPLAY_MIC_HOP
+  #define CPLAY_MIC_HOP       32     ///< Samples per SPL block / available() step
+#endif
+#ifndef CPLAY_MIC_BLOCKS
+  #define CPLAY_MIC_BLOCKS    16     ///< SPL blocks kept (~50 ms AVR, ~23 ms SAMD)
+#endif
+#ifndef CPLAY_MIC_PDM_WORDS
+  #define CPLAY_MIC_PDM_WORDS 2048   ///< SAMD: raw PDM DMA ring, ~23 ms of audio
+#endif
+#ifndef CPLAY_MIC_DMA_CHANNEL
+  #define CPLAY_MIC_DMA_CHANNEL (DMAC_CH_NUM - 1) ///< SAMD: DMA channel used
+#endif
+
 
 /**************************************************************************/
 /*! 
@@ -32,6 +54,12 @@ class Adafruit_CPlay_Mic {
 
   float soundPressureLevel(uint16_t ms);
 
+  bool     beginContinuous(void);
+  void     endContinuous(void);
+  bool     continuous(void),
+           available(void);
+  uint16_t window(int16_t *buf, uint16_t nSamples);
+
 private:
 #if defined(ARDUINO_ARCH_SAMD)
   static Adafruit_ZeroPDM pdm;
@@ -90,6 +90,10 @@ inline uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
 
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
 #ifndef _swap_int16_t
 #define _swap_int16_t(a, b)                                                    \
   {                                                                            \
@@ -1186,53 +1190,79 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
     int8_t xo = pgm_read_byte(&glyph->xOffset),
            yo = pgm_read_byte(&glyph->yOffset);
-    uint8_t xx, yy, bits = 0, bit = 0;
-    int16_t xo16 = 0, yo16 = 0;
-
-    if (size_x > 1 || size_y > 1) {
-      xo16 = xo;
-      yo16 = yo;
-    }
 
     // Todo: Add character clipping here
 
-    // NOTE: THERE IS NO 'BACKGROUND' COLOR OPTION ON CUSTOM FONTS.
-    // THIS IS ON PURPOSE AND BY DESIGN.  The background color feature
-    // has typically been used with the 'classic' font to overwrite old
-    // screen contents with new data.  This ONLY works because the
-    // characters are a uniform size; it's not a sensible thing to do with
-    // proportionally-spaced fonts with glyphs of varying sizes (and that
-    // may overlap).  To replace previously-drawn text when using a custom
-    // font, use the getTextBounds() function to determine the smallest
-    // rectangle encompassing a string, erase the area with fillRect(),
-    // then draw new text.  This WILL infortunately 'blink' the text, but
-    // is unavoidable.  Drawing 'background' pixels will NOT fix this,
-    // only creates a new set of problems.  Have an idea to work around
-    // this (a canvas object type for MCUs that can afford the RAM and
-    // displays supporting setAddrWindow() and pushColors()), but haven't
-    // implemented this yet.
+    // NOTE: the 'background' color of custom fonts fills the glyph's
+    // bounding box only, not the advance width. Characters of
+    // proportionally-spaced fonts vary in size (and may overlap), so this
+    // does not erase all of the previous text by itself. To replace
+    // previously-drawn text, use the getTextBounds() function to determine
+    // the smallest rectangle encompassing a string, erase the area with
+    // fillRect(), then draw new text, or draw to a canvas first. For the
+    // old transparent behavior, use the same color for text and background.
 
     startWrite();
-    for (yy = 0; yy < h; yy++) {
-      for (xx = 0; xx < w; xx++) {
+    writeGlyph(x + xo * size_x, y + yo * size_y, bitmap, bo, w, h, color, bg,
+               size_x, size_y);
+    endWrite();
+
+  } // End classic vs custom font
+}
+/**************************************************************************/
+/*!
+   @brief   Draw a GFXfont glyph bitmap. Each glyph row is split into runs
+            of equal pixels, drawn with writeFastHLine() (or writeFillRect()
+            when magnified), so a run costs one window instead of one per
+            pixel. Not self-contained; should follow startWrite().
+    @param    x       Left edge of the (magnified) glyph box
+    @param    y       Top edge of the (magnified) glyph box
+    @param    bitmap  Font bitmap, in PROGMEM
+    @param    bo      Offset of the glyph in bitmap
+    @param    w       Glyph width, in font pixels
+    @param    h       Glyph height, in font pixels
+    @param    color   16-bit 5-6-5 Color of set bits
+    @param    bg      16-bit 5-6-5 Color of clear bits (if same as color,
+   these are not drawn)
+    @param    size_x  Font magnification level in X-axis
+    @param    size_y  Font magnification level in Y-axis
+*/
+/**************************************************************************/
+void Adafruit_GFX::writeGlyph(int16_t x, int16_t y, const uint8_t *bitmap,
+                              uint16_t bo, uint8_t w, uint8_t h,
+                              uint16_t color, uint16_t bg, uint8_t size_x,
+                              uint8_t size_y) {
+  uint8_t bits = 0, bit = 0;
+  for (uint8_t yy = 0; yy < h; yy++, y += size_y) {
+    uint8_t start = 0;
+    bool on = false;
+    for (uint8_t xx = 0;; xx++) {
+      bool set = on;
+      if (xx < w) {
         if (!(bit++ & 7)) {
           bits = pgm_read_byte(&bitmap[bo++]);
         }
-        if (bits & 0x80) {
-          if (size_x == 1 && size_y == 1) {
-            writePixel(x + xo + xx, y + yo + yy, color);
-          } else {
-            writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
-                          size_x, size_y, color);
-          }
-        }
+        set = bits & 0x80;
         bits <<= 1;
       }
+      if ((xx == w) || (set != on)) { // End of a run
+        if ((xx > start) && (on || (bg != color))) {
+          uint16_t c = on ? color : bg;
+          if (size_x == 1 && size_y == 1)
+            writeFastHLine(x + start, y, xx - start, c);
+          else
+            writeFillRect(x + start * size_x, y, (xx - start) * size_x,
+                          size_y, c);
+        }
+        if (xx == w)
+          break;
+        start = xx;
+        on = set;
+      }
     }
-    endWrite();
-
-  } // End classic vs custom font
+  }
 }
+
 /**************************************************************************/
 /*!
     @brief  Print one byte/character of data, used to support print()
@@ -2667,3 +2697,310 @@ void GFXcanvas16::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
     buffer[i] = color;
   }
 }
+
+/**************************************************************************/
+/*!
+   @brief  Add a changed area. The area is given in canvas coordinates
+           with rotation, clipped and stored in raw (rotation 0) coordinates.
+   @param  x          Left edge of the area
+   @param  y          Top edge of the area
+   @param  w          Width of the area
+   @param  h          Height of the area
+   @param  rotation   Rotation of the canvas, 0 thru 3
+   @param  rawWidth   Width of the canvas without rotation
+   @param  rawHeight  Height of the canvas without rotation
+*/
+/**************************************************************************/
+void GFXdirtyRects::add(int16_t x, int16_t y, int16_t w, int16_t h,
+                        uint8_t rotation, int16_t rawWidth,
+                        int16_t rawHeight) {
+  if ((w <= 0) || (h <= 0))
+    return;
+  int16_t rx, ry, rw = w, rh = h;
+  switch (rotation) {
+  case 1:
+    rx = rawWidth - y - h;
+    ry = x;
+    rw = h;
+    rh = w;
+    break;
+  case 2:
+    rx = rawWidth - x - w;
+    ry = rawHeight - y - h;
+    break;
+  case 3:
+    rx = y;
+    ry = rawHeight - x - w;
+    rw = h;
+    rh = w;
+    break;
+  default:
+    rx = x;
+    ry = y;
+    break;
+  }
+  int16_t x1 = rx + rw - 1, y1 = ry + rh - 1;
+  if (rx < 0)
+    rx = 0;
+  if (ry < 0)
+    ry = 0;
+  if (x1 >= rawWidth)
+    x1 = rawWidth - 1;
+  if (y1 >= rawHeight)
+    y1 = rawHeight - 1;
+  if ((rx > x1) || (ry > y1))
+    return; // Off canvas
+  merge(rx, ry, x1, y1);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Add an inclusive raw rectangle, merging it with the rectangles
+           it overlaps or touches
+   @param  x0  Left edge
+   @param  y0  Top edge
+   @param  x1  Right edge (inclusive)
+   @param  y1  Bottom edge (inclusive)
+*/
+/**************************************************************************/
+void GFXdirtyRects::merge(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  uint8_t i = 0;
+  while (i < count) {
+    if ((x0 >= rect[i].x0) && (x1 <= rect[i].x1) && (y0 >= rect[i].y0) &&
+        (y1 <= rect[i].y1))
+      return; // Already dirty, the common case for text and lines
+    if ((x0 <= rect[i].x1 + 1) && (x1 + 1 >= rect[i].x0) &&
+        (y0 <= rect[i].y1 + 1) && (y1 + 1 >= rect[i].y0)) {
+      // Overlaps or touches: take the union out of the list, try again
+      x0 = min(x0, rect[i].x0);
+      y0 = min(y0, rect[i].y0);
+      x1 = max(x1, rect[i].x1);
+      y1 = max(y1, rect[i].y1);
+      rect[i] = rect[--count];
+      i = 0;
+      continue;
+    }
+    i++;
+  }
+  if (count < GFX_DIRTY_RECTS) {
+    rect[count].x0 = x0;
+    rect[count].y0 = y0;
+    rect[count].x1 = x1;
+    rect[count].y1 = y1;
+    count++;
+    return;
+  }
+  // List full: merge into the rectangle with the smallest growth
+  uint8_t best = 0;
+  int32_t bestGrowth = 0x7FFFFFFF;
+  for (i = 0; i < count; i++) {
+    int32_t area = (int32_t)(rect[i].x1 - rect[i].x0 + 1) *
+                   (rect[i].y1 - rect[i].y0 + 1);
+    int32_t merged =
+        (int32_t)(max(x1, rect[i].x1) - min(x0, rect[i].x0) + 1) *
+        (max(y1, rect[i].y1) - min(y0, rect[i].y0) + 1);
+    if (merged - area < bestGrowth) {
+      bestGrowth = merged - area;
+      best = i;
+    }
+  }
+  x0 = min(x0, rect[best].x0);
+  y0 = min(y0, rect[best].y0);
+  x1 = max(x1, rect[best].x1);
+  y1 = max(y1, rect[best].y1);
+  rect[best] = rect[--count];
+  merge(x0, y0, x1, y1); // The union may now touch others
+}
+
+/**************************************************************************/
+/*!
+   @brief  Get one dirty rectangle, in raw (rotation 0) coordinates
+   @param  i  Index, 0 thru getCount() - 1
+   @param  x  Returns the left edge
+   @param  y  Returns the top edge
+   @param  w  Returns the width
+   @param  h  Returns the height
+*/
+/**************************************************************************/
+void GFXdirtyRects::getRect(uint8_t i, int16_t *x, int16_t *y, int16_t *w,
+                            int16_t *h) const {
+  *x = rect[i].x0;
+  *y = rect[i].y0;
+  *w = rect[i].x1 - rect[i].x0 + 1;
+  *h = rect[i].y1 - rect[i].y0 + 1;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a 16-bit canvas with dirty rectangle tracking,
+             initially the whole canvas is dirty
+   @param    w   Display width, in pixels
+   @param    h   Display height, in pixels
+*/
+/**************************************************************************/
+GFXcanvas16Dirty::GFXcanvas16Dirty(uint16_t w, uint16_t h)
+    : GFXcanvas16(w, h) {
+  dirty.add(0, 0, WIDTH, HEIGHT, 0, WIDTH, HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a pixel to the canvas framebuffer and mark it dirty
+    @param  x      x coordinate
+    @param  y      y coordinate
+    @param  color  16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16Dirty::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  GFXcanvas16::drawPixel(x, y, color);
+  dirty.add(x, y, 1, 1, rotation, WIDTH, HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill the framebuffer completely with one color, all dirty
+    @param  color  16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16Dirty::fillScreen(uint16_t color) {
+  GFXcanvas16::fillScreen(color);
+  dirty.add(0, 0, WIDTH, HEIGHT, 0, WIDTH, HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Speed optimized vertical line drawing, marks the line dirty
+   @param  x      Line horizontal start point
+   @param  y      Line vertical start point
+   @param  h      Length of vertical line to be drawn, including first point
+   @param  color  Color 16-bit 5-6-5 Color to draw line with
+*/
+/**************************************************************************/
+void GFXcanvas16Dirty::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                     uint16_t color) {
+  GFXcanvas16::drawFastVLine(x, y, h, color);
+  if (h < 0) { // Convert negative heights to positive equivalent
+    h *= -1;
+    y -= h - 1;
+  }
+  dirty.add(x, y, 1, h, rotation, WIDTH, HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Speed optimized horizontal line drawing, marks the line dirty
+   @param  x      Line horizontal start point
+   @param  y      Line vertical start point
+   @param  w      Length of horizontal line to be drawn, including 1st point
+   @param  color  Color 16-bit 5-6-5 Color to draw line with
+*/
+/**************************************************************************/
+void GFXcanvas16Dirty::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                     uint16_t color) {
+  GFXcanvas16::drawFastHLine(x, y, w, color);
+  if (w < 0) { // Convert negative widths to positive equivalent
+    w *= -1;
+    x -= w - 1;
+  }
+  dirty.add(x, y, w, 1, rotation, WIDTH, HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Mark an area as dirty, e.g. after writing to getBuffer() directly
+   @param  x  Left edge, in coordinates with the current rotation
+   @param  y  Top edge
+   @param  w  Width
+   @param  h  Height
+*/
+/**************************************************************************/
+void GFXcanvas16Dirty::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+  dirty.add(x, y, w, h, rotation, WIDTH, HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a 1-bit canvas with dirty rectangle tracking,
+             initially the whole canvas is dirty
+   @param    w   Display width, in pixels
+   @param    h   Display height, in pixels
+*/
+/**************************************************************************/
+GFXcanvas1Dirty::GFXcanvas1Dirty(uint16_t w, uint16_t h) : GFXcanvas1(w, h) {
+  dirty.add(0, 0, WIDTH, HEIGHT, 0, WIDTH, HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a pixel to the canvas framebuffer and mark it dirty
+    @param  x      x coordinate
+    @param  y      y coordinate
+    @param  color  Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1Dirty::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  GFXcanvas1::drawPixel(x, y, color);
+  dirty.add(x, y, 1, 1, rotation, WIDTH, HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill the framebuffer completely with one color, all dirty
+    @param  color  Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1Dirty::fillScreen(uint16_t color) {
+  GFXcanvas1::fillScreen(color);
+  dirty.add(0, 0, WIDTH, HEIGHT, 0, WIDTH, HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Speed optimized vertical line drawing, marks the line dirty
+   @param  x      Line horizontal start point
+   @param  y      Line vertical start point
+   @param  h      Length of vertical line to be drawn, including first point
+   @param  color  Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1Dirty::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                    uint16_t color) {
+  GFXcanvas1::drawFastVLine(x, y, h, color);
+  if (h < 0) { // Convert negative heights to positive equivalent
+    h *= -1;
+    y -= h - 1;
+  }
+  dirty.add(x, y, 1, h, rotation, WIDTH, HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Speed optimized horizontal line drawing, marks the line dirty
+   @param  x      Line horizontal start point
+   @param  y      Line vertical start point
+   @param  w      Length of horizontal line to be drawn, including 1st point
+   @param  color  Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1Dirty::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                    uint16_t color) {
+  GFXcanvas1::drawFastHLine(x, y, w, color);
+  if (w < 0) { // Convert negative widths to positive equivalent
+    w *= -1;
+    x -= w - 1;
+  }
+  dirty.add(x, y, w, 1, rotation, WIDTH, HEIGHT);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Mark an area as dirty, e.g. after writing to getBuffer() directly
+   @param  x  Left edge, in coordinates with the current rotation
+   @param  y  Top edge
+   @param  w  Width
+   @param  h  Height
+*/
+/**************************************************************************/
+void GFXcanvas1Dirty::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+  dirty.add(x, y, w, h, rotation, WIDTH, HEIGHT);
+}
@@ -232,6 +232,11 @@ public:
 protected:
   void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx,
                   int16_t *miny, int16_t *maxx, int16_t *maxy);
+  // Draw a GFXfont glyph bitmap as horizontal runs, optionally opaque;
+  // subclasses with an address window may send the box in one go
+  virtual void writeGlyph(int16_t x, int16_t y, const uint8_t *bitmap,
+                          uint16_t bo, uint8_t w, uint8_t h, uint16_t color,
+                          uint16_t bg, uint8_t size_x, uint8_t size_y);
   int16_t WIDTH;        ///< This is the 'raw' display width - never changes
   int16_t HEIGHT;       ///< This is the 'raw' display height - never changes
   int16_t _width;       ///< Display width as modified by current rotation
@@ -388,4 +393,96 @@ protected:
   uint16_t *buffer; ///< Raster data: no longer private, allow subclass access
 };
 
+#ifndef GFX_DIRTY_RECTS
+#define GFX_DIRTY_RECTS 8 ///< Max dirty rectangles per tracking canvas
+#endif
+
+/// A list of dirty rectangles in raw (rotation 0) canvas coordinates.
+/// Rectangles that overlap or touch are merged; when the list is full, the
+/// new rectangle is merged into the one that grows least.
+class GFXdirtyRects {
+public:
+  GFXdirtyRects(void) : count(0) {}
+  void add(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t rotation,
+           int16_t rawWidth, int16_t rawHeight);
+  /**********************************************************************/
+  /*!
+    @brief  Forget all dirty rectangles, e.g. after the canvas was sent
+  */
+  /**********************************************************************/
+  void clear(void) { count = 0; }
+  /**********************************************************************/
+  /*!
+    @brief   Get the number of dirty rectangles
+    @returns Number of rectangles, 0 if nothing changed
+  */
+  /**********************************************************************/
+  uint8_t getCount(void) const { return count; }
+  void getRect(uint8_t i, int16_t *x, int16_t *y, int16_t *w,
+               int16_t *h) const;
+
+private:
+  void merge(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+  struct {
+    int16_t x0, y0, x1, y1; // Inclusive corners
+  } rect[GFX_DIRTY_RECTS];
+  uint8_t count;
+};
+
+/// A GFX 16-bit canvas that records the areas changed by its draw
+/// primitives, see Adafruit_SPITFT::pushDirty()
+class GFXcanvas16Dirty : public GFXcanvas16 {
+public:
+  GFXcanvas16Dirty(uint16_t w, uint16_t h);
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void fillScreen(uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+  /**********************************************************************/
+  /*!
+    @brief    Get the dirty rectangles, in raw (rotation 0) coordinates
+    @returns  The dirty rectangle list
+  */
+  /**********************************************************************/
+  GFXdirtyRects &getDirty(void) { return dirty; }
+  /**********************************************************************/
+  /*!
+    @brief  Forget all changes, e.g. after the canvas was sent
+  */
+  /**********************************************************************/
+  void clearDirty(void) { dirty.clear(); }
+
+protected:
+  GFXdirtyRects dirty; ///< Changed areas since the last clearDirty()
+};
+
+/// A GFX 1-bit canvas that records the areas changed by its draw
+/// primitives, see Adafruit_SPITFT::pushDirty()
+class GFXcanvas1Dirty : public GFXcanvas1 {
+public:
+  GFXcanvas1Dirty(uint16_t w, uint16_t h);
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void fillScreen(uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+  /**********************************************************************/
+  /*!
+    @brief    Get the dirty rectangles, in raw (rotation 0) coordinates
+    @returns  The dirty rectangle list
+  */
+  /**********************************************************************/
+  GFXdirtyRects &getDirty(void) { return dirty; }
+  /**********************************************************************/
+  /*!
+    @brief  Forget all changes, e.g. after the canvas was sent
+  */
+  /**********************************************************************/
+  void clearDirty(void) { dirty.clear(); }
+
+protected:
+  GFXdirtyRects dirty; ///< Changed areas since the last clearDirty()
+};
+
 #endif // _ADAFRUIT_GFX_H
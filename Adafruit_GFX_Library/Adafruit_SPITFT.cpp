@@ -1194,6 +1194,267 @@ bool Adafruit_SPITFT::dmaBusy(void) const {
 #endif
 }
 
+/*!
+    @brief  Allocate two band canvases for banded drawing with startBand()
+            and pushBand(). While one band is sent to the display (by DMA
+            where available), the next one can be drawn into the other
+            canvas, e.g. for a full-screen UI drawn band by band.
+    @param  w           Width of each band in pixels, usually the display
+                        width.
+    @param  bandHeight  Height of each band in pixels. Two bands need
+                        4 * w * bandHeight bytes of RAM.
+    @return true on success, false if the canvases could not be allocated.
+*/
+bool Adafruit_SPITFT::initBands(uint16_t w, uint16_t bandHeight) {
+  freeBands();
+  for (uint8_t i = 0; i < 2; i++) {
+    band[i] = new GFXcanvas16(w, bandHeight);
+    if (!band[i] || !band[i]->getBuffer()) {
+      freeBands();
+      return false;
+    }
+  }
+  bandIdx = 0;
+  return true;
+}
+
+/*!
+    @brief  Finish banded drawing (if started) and release the band
+            canvases allocated by initBands().
+*/
+void Adafruit_SPITFT::freeBands(void) {
+  endBands();
+  for (uint8_t i = 0; i < 2; i++) {
+    delete band[i];
+    band[i] = NULL;
+  }
+}
+
+/*!
+    @brief  Get the band canvas to draw next. The canvas is not being sent
+            anymore, but its content is undefined (after DMA it is in the
+            display's byte order), so the band should be drawn completely,
+            e.g. starting with fillScreen(). Coordinates are relative to the
+            band, pushBand() gives the band's position on the display.
+    @return Pointer to the canvas, or NULL if initBands() was not called.
+*/
+GFXcanvas16 *Adafruit_SPITFT::startBand(void) { return band[bandIdx]; }
+
+/*!
+    @brief  Send the band from the last startBand() call to the display,
+            and switch to the other band. With DMA this returns as soon as
+            the transfer is started; the previous band transfer is waited
+            for first. The display stays selected until endBands().
+    @param  x  Left edge of the band on the display.
+    @param  y  Top edge of the band on the display.
+    @param  h  Number of band rows to send (default -1: the full band, use
+               less for the last band of a screen).
+*/
+void Adafruit_SPITFT::pushBand(int16_t x, int16_t y, int16_t h) {
+  GFXcanvas16 *canvas = band[bandIdx];
+  if (!canvas)
+    return;
+  int16_t w = canvas->width();
+  if ((h < 0) || (h > canvas->height()))
+    h = canvas->height();
+  dmaWait(); // Prior band must be complete before the address is changed
+  if (!bandWriting) {
+    startWrite();
+    bandWriting = true;
+  }
+  setAddrWindow(x, y, w, h);
+#if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+  if ((connection == TFT_HARD_SPI) || (connection == TFT_PARALLEL)) {
+    // Big-endian pixels are sent as one chained DMA job, so the swap is
+    // done here (much faster than the transfer) and writePixels() returns
+    // immediately, while the other band is drawn.
+    swapBytes(canvas->getBuffer(), (uint32_t)w * h);
+    writePixels(canvas->getBuffer(), (uint32_t)w * h, false, true);
+  } else
+#endif
+    writePixels(canvas->getBuffer(), (uint32_t)w * h);
+  bandIdx = 1 - bandIdx;
+}
+
+/*!
+    @brief  Wait for the last band transfer of pushBand() to complete and
+            end the display write, so the bus can be used again.
+*/
+void Adafruit_SPITFT::endBands(void) {
+  if (bandWriting) {
+    dmaWait();
+    endWrite();
+    bandWriting = false;
+  }
+}
+
+/*!
+    @brief  Clip a dirty rectangle of a canvas at x, y to the display.
+    @param  dispW    Display width with the current rotation.
+    @param  dispH    Display height with the current rotation.
+    @param  canvasX  Canvas position on the display.
+    @param  canvasY  Canvas position on the display.
+    @param  rx       Rectangle in canvas, shifted to the clipped edge.
+    @param  ry       Rectangle in canvas, shifted to the clipped edge.
+    @param  rw       Rectangle width, clipped.
+    @param  rh       Rectangle height, clipped.
+    @return true if anything of the rectangle is on the display.
+*/
+static bool clipDirtyRect(int16_t dispW, int16_t dispH, int16_t canvasX,
+                          int16_t canvasY, int16_t *rx, int16_t *ry,
+                          int16_t *rw, int16_t *rh) {
+  int16_t x = canvasX + *rx, y = canvasY + *ry;
+  if (x < 0) {
+    *rw += x;
+    *rx -= x;
+    x = 0;
+  }
+  if (y < 0) {
+    *rh += y;
+    *ry -= y;
+    y = 0;
+  }
+  if (x + *rw > dispW)
+    *rw = dispW - x;
+  if (y + *rh > dispH)
+    *rh = dispH - y;
+  return (*rw > 0) && (*rh > 0);
+}
+
+/*!
+    @brief  Send the areas of a 16-bit canvas that changed since the last
+            push, with one setAddrWindow() per dirty rectangle, and clear
+            the canvas' dirty list. The canvas buffer is sent as it is
+            stored (unrotated), like drawRGBBitmap() of getBuffer() would.
+    @param  canvas  Canvas with dirty rectangle tracking.
+    @param  x       Left edge of the canvas on the display.
+    @param  y       Top edge of the canvas on the display.
+*/
+void Adafruit_SPITFT::pushDirty(GFXcanvas16Dirty *canvas, int16_t x,
+                                int16_t y) {
+  GFXdirtyRects &dirty = canvas->getDirty();
+  if (!dirty.getCount())
+    return;
+  uint16_t *buffer = canvas->getBuffer();
+  int16_t rawW =
+      (canvas->getRotation() & 1) ? canvas->height() : canvas->width();
+  startWrite();
+  for (uint8_t i = 0; i < dirty.getCount(); i++) {
+    int16_t rx, ry, rw, rh;
+    dirty.getRect(i, &rx, &ry, &rw, &rh);
+    if (!clipDirtyRect(_width, _height, x, y, &rx, &ry, &rw, &rh))
+      continue;
+    setAddrWindow(x + rx, y + ry, rw, rh);
+    uint16_t *row = &buffer[(int32_t)ry * rawW + rx];
+    if (rw == rawW) { // Full rows are contiguous in the canvas
+      writePixels(row, (uint32_t)rw * rh);
+    } else {
+      for (int16_t j = 0; j < rh; j++, row += rawW)
+        writePixels(row, rw);
+    }
+  }
+  endWrite();
+  dirty.clear();
+}
+
+/*!
+    @brief  Send the areas of a 1-bit canvas that changed since the last
+            push, with one setAddrWindow() per dirty rectangle, and clear
+            the canvas' dirty list. The canvas buffer is sent as it is
+            stored (unrotated), like drawBitmap() of getBuffer() would.
+    @param  canvas  Canvas with dirty rectangle tracking.
+    @param  color   16-bit 5-6-5 color for set bits.
+    @param  bg      16-bit 5-6-5 color for clear bits.
+    @param  x       Left edge of the canvas on the display.
+    @param  y       Top edge of the canvas on the display.
+*/
+void Adafruit_SPITFT::pushDirty(GFXcanvas1Dirty *canvas, uint16_t color,
+                                uint16_t bg, int16_t x, int16_t y) {
+  GFXdirtyRects &dirty = canvas->getDirty();
+  if (!dirty.getCount())
+    return;
+  uint8_t *buffer = canvas->getBuffer();
+  int16_t rawW =
+      (canvas->getRotation() & 1) ? canvas->height() : canvas->width();
+  int16_t byteWidth = (rawW + 7) / 8;
+  uint16_t line[32]; // Bits are expanded in chunks of this many pixels
+  startWrite();
+  for (uint8_t i = 0; i < dirty.getCount(); i++) {
+    int16_t rx, ry, rw, rh;
+    dirty.getRect(i, &rx, &ry, &rw, &rh);
+    if (!clipDirtyRect(_width, _height, x, y, &rx, &ry, &rw, &rh))
+      continue;
+    setAddrWindow(x + rx, y + ry, rw, rh);
+    for (int16_t j = 0; j < rh; j++) {
+      const uint8_t *row = &buffer[(int32_t)(ry + j) * byteWidth];
+      for (int16_t k = 0; k < rw;) {
+        uint8_t n = 0;
+        for (; (n < 32) && (k < rw); n++, k++) {
+          int16_t bx = rx + k;
+          line[n] = (row[bx >> 3] & (0x80 >> (bx & 7))) ? color : bg;
+        }
+        writePixels(line, n);
+      }
+    }
+  }
+  endWrite();
+  dirty.clear();
+}
+
+/*!
+    @brief  Draw a GFXfont glyph bitmap. With a background color and the
+            glyph box fully on screen, the whole box is sent in one address
+            window as runs of writeColor(); otherwise the glyph is drawn as
+            horizontal runs by Adafruit_GFX. Not self-contained; should
+            follow startWrite().
+    @param  x       Left edge of the (magnified) glyph box.
+    @param  y       Top edge of the (magnified) glyph box.
+    @param  bitmap  Font bitmap, in PROGMEM.
+    @param  bo      Offset of the glyph in bitmap.
+    @param  w       Glyph width, in font pixels.
+    @param  h       Glyph height, in font pixels.
+    @param  color   16-bit 5-6-5 color of set bits.
+    @param  bg      16-bit 5-6-5 color of clear bits (if same as color,
+                    these are not drawn).
+    @param  size_x  Font magnification level in X-axis.
+    @param  size_y  Font magnification level in Y-axis.
+*/
+void Adafruit_SPITFT::writeGlyph(int16_t x, int16_t y, const uint8_t *bitmap,
+                                 uint16_t bo, uint8_t w, uint8_t h,
+                                 uint16_t color, uint16_t bg, uint8_t size_x,
+                                 uint8_t size_y) {
+  int16_t bw = w * size_x, bh = h * size_y;
+  if ((bg == color) || !bw || !bh || (x < 0) || (y < 0) ||
+      (x + bw > _width) || (y + bh > _height)) {
+    Adafruit_GFX::writeGlyph(x, y, bitmap, bo, w, h, color, bg, size_x,
+                             size_y);
+    return;
+  }
+  setAddrWindow(x, y, bw, bh);
+  uint32_t rowBit = (uint32_t)bo * 8; // First bit of the current glyph row
+  for (uint8_t yy = 0; yy < h; yy++, rowBit += w) {
+    for (uint8_t sy = 0; sy < size_y; sy++) { // Rows repeat when magnified
+      uint8_t start = 0;
+      bool on = false;
+      for (uint8_t xx = 0;; xx++) {
+        bool set = on;
+        if (xx < w) {
+          uint32_t b = rowBit + xx;
+          set = pgm_read_byte(&bitmap[b >> 3]) & (0x80 >> (b & 7));
+        }
+        if ((xx == w) || (set != on)) { // End of a run
+          if (xx > start)
+            writeColor(on ? color : bg, (uint32_t)(xx - start) * size_x);
+          if (xx == w)
+            break;
+          start = xx;
+          on = set;
+        }
+      }
+    }
+  }
+}
+
 /*!
     @brief  Issue a series of pixels, all the same color. Not self-
             contained; should follow startWrite() and setAddrWindow() calls.
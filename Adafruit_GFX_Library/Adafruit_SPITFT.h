@@ -158,7 +158,7 @@ public:
 
   // DESTRUCTOR ----------------------------------------------------------
 
-  ~Adafruit_SPITFT(){};
+  ~Adafruit_SPITFT() { freeBands(); };
 
   // CLASS MEMBER FUNCTIONS ----------------------------------------------
 
@@ -238,6 +238,21 @@ public:
   bool dmaBusy(void) const; // true if DMA is used and busy, false otherwise
   void swapBytes(uint16_t *src, uint32_t len, uint16_t *dest = NULL);
 
+  // Banded drawing: two GFXcanvas16 of one band each, so the next band can
+  // be drawn while the previous one is still being sent (with DMA where
+  // available, otherwise pushBand() blocks).
+  bool initBands(uint16_t w, uint16_t bandHeight);
+  void freeBands(void);
+  GFXcanvas16 *startBand(void);
+  void pushBand(int16_t x, int16_t y, int16_t h = -1);
+  void endBands(void);
+
+  // Send only the areas of a dirty-tracking canvas that changed since the
+  // last push, one address window each; the canvas is placed at x, y.
+  void pushDirty(GFXcanvas16Dirty *canvas, int16_t x = 0, int16_t y = 0);
+  void pushDirty(GFXcanvas1Dirty *canvas, uint16_t color, uint16_t bg,
+                 int16_t x = 0, int16_t y = 0);
+
   // These functions are similar to the 'write' functions above, but with
   // a chip-select and/or SPI transaction built-in. They're typically used
   // solo -- that is, as graphics primitives in themselves, not invoked by
@@ -366,6 +381,11 @@ public:
   }
 
 protected:
+  // Opaque GFXfont glyphs are sent in one address window
+  void writeGlyph(int16_t x, int16_t y, const uint8_t *bitmap, uint16_t bo,
+                  uint8_t w, uint8_t h, uint16_t color, uint16_t bg,
+                  uint8_t size_x, uint8_t size_y);
+
   // A few more low-level member functions -- some may have previously
   // been macros. Shouldn't have a need to access these externally, so
   // they've been moved to the protected section. Additionally, they're
@@ -501,6 +521,9 @@ protected:
   uint32_t lastFillLen = 0;          ///< # of pixels w/last fill
   uint8_t onePixelBuf;               ///< For hi==lo fill
 #endif
+  GFXcanvas16 *band[2] = {NULL, NULL}; ///< Band canvases for pushBand()
+  uint8_t bandIdx = 0;                 ///< Band returned by startBand()
+  bool bandWriting = false;            ///< True if pushBand() started a write
 #if defined(USE_FAST_PINIO)
 #if defined(HAS_PORT_SET_CLR)
 #if !defined(KINETISK)
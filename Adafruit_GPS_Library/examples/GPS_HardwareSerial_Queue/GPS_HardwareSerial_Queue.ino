@@ -0,0 +1,82 @@
+// Test code for Ultimate GPS Using Hardware Serial, without a timer interrupt
+//
+// This code shows how to queue whole sentences with feed() and parse them
+// with update() when the main loop gets round to it. On ESP32 the UART
+// receive timeout (an idle line after a burst of characters) calls feed()
+// with everything received, elsewhere drain() empties the serial buffer
+// that the UART receive interrupt has already filled. Only the sentences
+// passed to parseOnly() are parsed, the rest are dropped unchecked.
+//
+// Tested and works great with the Adafruit GPS FeatherWing
+// ------> https://www.adafruit.com/products/3133
+//
+// Pick one up today at the Adafruit electronics shop
+// and help support open source hardware & software! -ada
+
+#include <Adafruit_GPS.h>
+
+// what's the name of the hardware serial port?
+#define GPSSerial Serial1
+
+// Connect to the GPS on the hardware port
+Adafruit_GPS GPS(&GPSSerial);
+
+// The sentences we want, the list must end with "ZZ"
+const char *wanted[] = {"GGA", "RMC", "ZZ"};
+
+uint32_t timer = millis();
+
+#if defined(ARDUINO_ARCH_ESP32)
+void onGPSReceive() {
+  char buf[64];
+  size_t n;
+  while ((n = GPSSerial.read((uint8_t *)buf, sizeof(buf))) > 0)
+    GPS.feed(buf, n);
+}
+#endif
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println("Adafruit GPS library sentence queue test!");
+
+  GPS.begin(9600);
+  GPS.sendCommand(PMTK_SET_NMEA_OUTPUT_RMCGGA);
+  GPS.sendCommand(PMTK_SET_NMEA_UPDATE_1HZ);
+  GPS.parseOnly(wanted);
+#if defined(ARDUINO_ARCH_ESP32)
+  GPSSerial.onReceive(onGPSReceive, true); // only on the receive timeout
+#endif
+}
+
+void loop() // run over and over again
+{
+#if !defined(ARDUINO_ARCH_ESP32)
+  // the serial buffer holds 64 characters or more, so this only has to run
+  // every few tens of milliseconds at 9600 baud
+  GPS.drain();
+#endif
+  GPS.update();
+
+  // approximately every 2 seconds or so, print out the current stats
+  if (millis() - timer > 2000) {
+    timer = millis(); // reset the timer
+    Serial.print("\nTime: ");
+    if (GPS.hour < 10) { Serial.print('0'); }
+    Serial.print(GPS.hour, DEC); Serial.print(':');
+    if (GPS.minute < 10) { Serial.print('0'); }
+    Serial.print(GPS.minute, DEC); Serial.print(':');
+    if (GPS.seconds < 10) { Serial.print('0'); }
+    Serial.println(GPS.seconds, DEC);
+    Serial.print("Fix: "); Serial.print((int)GPS.fix);
+    Serial.print(" quality: "); Serial.println((int)GPS.fixquality);
+    if (GPS.fix) {
+      Serial.print("Location: ");
+      Serial.print(GPS.latitude, 4); Serial.print(GPS.lat);
+      Serial.print(", ");
+      Serial.print(GPS.longitude, 4); Serial.println(GPS.lon);
+      Serial.print("Satellites: "); Serial.println((int)GPS.satellites);
+    }
+    Serial.print("Dropped sentences: "); Serial.println(GPS.sentenceOverruns());
+  }
+}
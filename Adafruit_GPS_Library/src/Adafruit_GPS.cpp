@@ -419,6 +419,124 @@ char *Adafruit_GPS::lastNMEA(void) {
   return (char *)lastline;
 }
 
+/**************************************************************************/
+/*!
+    @brief Add a received character to the sentence queue.
+
+    Unlike read(), this does not touch the transport, so it can be called
+    from a UART receive interrupt, or from the completion or idle line
+    callback of a DMA transfer (e.g. HardwareSerial::onReceive() on ESP32)
+    with everything received so far. Complete sentences are then parsed by
+    update() in the main loop, with no need for a timer interrupt calling
+    read() every millisecond. If the queue is full the sentence is dropped
+    and counted by sentenceOverruns().
+    @param c The character received
+*/
+/**************************************************************************/
+void Adafruit_GPS::feed(char c) {
+  uint8_t head = queueHead;
+  char *line = queue[head % GPS_SENTENCE_QUEUE];
+
+  if (c == '$' || c == '!')
+    queueIdx = 0; // a new sentence, even if the last one was cut short
+  if (queueIdx < MAXLINELENGTH - 1)
+    line[queueIdx++] = c;
+
+  if (c == '\n') {
+    line[queueIdx] = 0;
+    queueIdx = 0;
+    if ((uint8_t)(head - queueTail) < GPS_SENTENCE_QUEUE) {
+      queueTime[head % GPS_SENTENCE_QUEUE] = millis();
+      queueHead = head + 1;
+    } else
+      queueOverruns++; // overwrite it with the next sentence
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief Add a block of received characters to the sentence queue.
+    @param data Pointer to the characters received
+    @param len Number of characters
+*/
+/**************************************************************************/
+void Adafruit_GPS::feed(const char *data, size_t len) {
+  while (len--)
+    feed(*data++);
+}
+
+/**************************************************************************/
+/*!
+    @brief Move everything the transport has received into the sentence
+    queue. Serial ports are already buffered by their receive interrupt, so
+    calling this every few tens of milliseconds from loop() is enough, where
+    read() would need a timer interrupt. I2C and SPI transfer at most one
+    block per call. The sentences also go through read(), so lastNMEA() keeps
+    working.
+    @return Number of characters moved
+*/
+/**************************************************************************/
+size_t Adafruit_GPS::drain(void) {
+  size_t n = 0;
+  while (available()) {
+    char c = read();
+    if (!c)
+      break; // nothing after all, or an I2C/SPI block was just fetched
+    feed(c);
+    n++;
+  }
+  return n;
+}
+
+/**************************************************************************/
+/*!
+    @brief Parse the sentences queued by feed(). Only the sentences on the
+    parseOnly() list are parsed, the others are dropped without even
+    checking their checksum.
+    @return True if at least one sentence was parsed
+*/
+/**************************************************************************/
+bool Adafruit_GPS::update(void) {
+  bool parsed = false;
+  uint8_t tail = queueTail;
+
+  while (tail != queueHead) {
+    char *nmea = queue[tail % GPS_SENTENCE_QUEUE];
+    bool wanted = true;
+    if (parseList) {
+      const char *src = tokenOnList(nmea + 1, sources);
+      wanted = src && tokenOnList(nmea + 1 + strlen(src), parseList);
+    }
+    if (wanted) {
+      sentTime = recvdTime = queueTime[tail % GPS_SENTENCE_QUEUE];
+      if (parse(nmea))
+        parsed = true;
+    }
+    queueTail = ++tail; // only now can feed() reuse the slot
+  }
+  return parsed;
+}
+
+/**************************************************************************/
+/*!
+    @brief Choose the sentences that update() parses
+    @param list A list of sentence ids, e.g. {"GGA", "RMC", "ZZ"}, with the
+    final entry starting "ZZ", or NULL to parse every sentence. The list is
+    not copied.
+*/
+/**************************************************************************/
+void Adafruit_GPS::parseOnly(const char **list) { parseList = list; }
+
+/**************************************************************************/
+/*!
+    @brief How many complete sentences are waiting for update()
+    @return Number of sentences queued
+*/
+/**************************************************************************/
+uint8_t Adafruit_GPS::sentencesQueued(void) {
+  return (uint8_t)(queueHead - queueTail);
+}
+
 /**************************************************************************/
 /*!
     @brief Wait for a specified sentence from the device
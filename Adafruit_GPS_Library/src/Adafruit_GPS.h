@@ -51,6 +51,15 @@
 #define GPS_MAX_SPI_TRANSFER                                                   \
   100                     ///< The max number of bytes we'll try to read at once
 #define MAXLINELENGTH 120 ///< how long are max NMEA lines to parse?
+#ifndef GPS_SENTENCE_QUEUE
+#if defined(__AVR__)
+#define GPS_SENTENCE_QUEUE                                                     \
+  2 ///< complete sentences held by feed() for update(), a power of 2
+#else
+#define GPS_SENTENCE_QUEUE                                                     \
+  8 ///< complete sentences held by feed() for update(), a power of 2
+#endif
+#endif
 #define NMEA_MAX_SENTENCE_ID                                                   \
   20 ///< maximum length of a sentence ID name, including terminating 0
 #define NMEA_MAX_SOURCE_ID                                                     \
@@ -106,6 +115,13 @@ public:
   char *lastNMEA(void);
   bool waitForSentence(const char *wait, uint8_t max = MAXWAITSENTENCE,
                        bool usingInterrupts = false);
+  void feed(char c);
+  void feed(const char *data, size_t len);
+  size_t drain(void);
+  bool update(void);
+  void parseOnly(const char **list);
+  uint8_t sentencesQueued(void);
+  uint16_t sentenceOverruns(void) { return queueOverruns; }
   bool LOCUS_StartLogger(void);
   bool LOCUS_StopLogger(void);
   bool LOCUS_ReadStatus(void);
@@ -311,6 +327,14 @@ private:
   volatile char *lastline;      ///< Pointer to previous line buffer
   volatile bool recvdflag;      ///< Received flag
   volatile bool inStandbyMode;  ///< In standby flag
+
+  char queue[GPS_SENTENCE_QUEUE][MAXLINELENGTH]; ///< Sentences from feed()
+  uint32_t queueTime[GPS_SENTENCE_QUEUE]; ///< millis() when each was completed
+  volatile uint8_t queueHead = 0;  ///< Sentences completed by feed()
+  volatile uint8_t queueTail = 0;  ///< Sentences consumed by update()
+  volatile uint8_t queueIdx = 0;   ///< Index into the sentence being fed
+  volatile uint16_t queueOverruns = 0; ///< Sentences dropped on a full queue
+  const char **parseList = NULL; ///< Sentences update() parses, NULL for all
 };
 /**************************************************************************/
 
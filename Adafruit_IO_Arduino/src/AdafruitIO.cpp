@@ -338,6 +338,9 @@ aio_status_t AdafruitIO::run(uint16_t busywait_ms, bool fail_fast) {
 
   _mqtt->processPackets(_packetread_timeout);
 
+  // publish queued feed values the rate limit allows
+  _sendQueued();
+
   // ping to keep connection alive if needed
   if (millis() > (_last_ping + AIO_PING_INTERVAL)) {
     _mqtt->ping();
@@ -346,6 +349,177 @@ aio_status_t AdafruitIO::run(uint16_t busywait_ms, bool fail_fast) {
   return status();
 }
 
+/**************************************************************************/
+/*!
+    @brief    Paces feed saves to the account's rate limit. Once set,
+              AdafruitIO_Feed::save() queues the value instead of publishing
+              it, and run() publishes queued values as a token bucket
+              allows. A feed saved again before it was sent only has its
+              latest value sent.
+    @param    per_minute
+              Values per minute to publish, 0 to publish right away again.
+    @param    burst
+              Values that may be published at once after a quiet spell.
+*/
+/**************************************************************************/
+void AdafruitIO::setRateLimit(uint16_t per_minute, uint8_t burst) {
+  _rate_limit = per_minute;
+  _rate_burst = burst ? burst : 1;
+  _tokens = (uint32_t)_rate_burst * AIO_TOKEN;
+  _last_refill = millis();
+
+  // nothing can hold the queued values back anymore
+  if (!_rate_limit) {
+    while (_send_queue_len) {
+      AdafruitIO_Feed *feed = _send_queue[0];
+      _unqueue(feed);
+      feed->_pub->publish(feed->data->toCSV());
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Sets a group to publish queued feed values through, so that
+              values of several feeds go out in a single MQTT message. Only
+              the user's own feeds in that group, without location metadata,
+              are batched; other feeds are published on their own.
+    @param    group
+              Group the queued feeds belong to, or NULL to stop batching.
+*/
+/**************************************************************************/
+void AdafruitIO::setBatchGroup(AdafruitIO_Group *group) {
+  _batch_group = group;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Number of feeds with a value waiting to be published.
+    @return   Queued feed count.
+*/
+/**************************************************************************/
+uint8_t AdafruitIO::queued() { return _send_queue_len; }
+
+/**************************************************************************/
+/*!
+    @brief    Queues a feed's current value for the send scheduler.
+    @param    feed
+              Feed to publish.
+    @return   True if queued, False if the queue is full.
+*/
+/**************************************************************************/
+bool AdafruitIO::_queue(AdafruitIO_Feed *feed) {
+  // already waiting, the latest value goes out when it's sent
+  for (uint8_t i = 0; i < _send_queue_len; i++) {
+    if (_send_queue[i] == feed)
+      return true;
+  }
+
+  if (_send_queue_len >= AIO_SEND_QUEUE_SIZE) {
+    AIO_ERROR_PRINTLN("send queue full");
+    return false;
+  }
+
+  _send_queue[_send_queue_len++] = feed;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Removes a feed from the send queue.
+    @param    feed
+              Feed to remove.
+*/
+/**************************************************************************/
+void AdafruitIO::_unqueue(AdafruitIO_Feed *feed) {
+  for (uint8_t i = 0; i < _send_queue_len; i++) {
+    if (_send_queue[i] == feed) {
+      _send_queue_len--;
+      memmove(&_send_queue[i], &_send_queue[i + 1],
+              (_send_queue_len - i) * sizeof(AdafruitIO_Feed *));
+      return;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Checks whether a queued feed value can go in a group publish.
+    @param    feed
+              Queued feed.
+    @return   True if it can be batched, False otherwise.
+*/
+/**************************************************************************/
+bool AdafruitIO::_batchable(AdafruitIO_Feed *feed) {
+  AdafruitIO_Data *d = feed->data;
+
+  // group CSV has no room for location metadata or quoting
+  return _batch_group && strcmp(feed->owner, _batch_group->owner) == 0 &&
+         d->lat() == 0 && d->lon() == 0 && d->ele() == 0 &&
+         strpbrk(d->toChar(), ",\n\"") == NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Publishes queued feed values, as many as the token bucket
+              allows. Each value costs one token, whether it is published on
+              its own or batched with others in a group publish.
+*/
+/**************************************************************************/
+void AdafruitIO::_sendQueued() {
+  if (!_rate_limit || !_send_queue_len)
+    return;
+
+  // refill the bucket, _rate_limit tokens per minute
+  uint32_t now = millis();
+  uint32_t elapsed = now - _last_refill;
+  uint32_t max_tokens = (uint32_t)_rate_burst * AIO_TOKEN;
+  if (elapsed > 60000)
+    elapsed = 60000;
+  _tokens += elapsed * _rate_limit;
+  if (_tokens > max_tokens)
+    _tokens = max_tokens;
+  _last_refill = now;
+
+  if (_batch_group) {
+    char csv[AIO_BATCH_LENGTH];
+    size_t csv_len = 0;
+    uint8_t i = 0;
+
+    csv[0] = 0;
+    while (i < _send_queue_len && _tokens >= AIO_TOKEN) {
+      AdafruitIO_Feed *feed = _send_queue[i];
+      const char *value = feed->data->toChar();
+      size_t len = strlen(feed->name) + strlen(value) + 2;
+
+      if (!_batchable(feed) || csv_len + len >= AIO_BATCH_LENGTH) {
+        i++;
+        continue;
+      }
+
+      strcat(csv, feed->name);
+      strcat(csv, ",");
+      strcat(csv, value);
+      strcat(csv, "\n");
+      csv_len += len;
+      _tokens -= AIO_TOKEN;
+      _unqueue(feed);
+    }
+
+    if (csv_len && !_batch_group->_pub->publish(csv))
+      AIO_ERROR_PRINTLN("batched group publish failed");
+  }
+
+  // whatever couldn't be batched goes out on its own
+  while (_send_queue_len && _tokens >= AIO_TOKEN) {
+    AdafruitIO_Feed *feed = _send_queue[0];
+    _unqueue(feed);
+    _tokens -= AIO_TOKEN;
+    if (!feed->_pub->publish(feed->data->toCSV()))
+      AIO_ERROR_PRINTLN("queued feed publish failed");
+  }
+}
+
 /**************************************************************************/
 /*!
     @brief    Status check.
@@ -81,6 +81,11 @@ public:
   void wifi_disconnect();
   aio_status_t run(uint16_t busywait_ms = 0, bool fail_fast = false);
 
+  void setRateLimit(uint16_t per_minute,
+                    uint8_t burst = AIO_RATE_LIMIT_BURST);
+  void setBatchGroup(AdafruitIO_Group *group);
+  uint8_t queued();
+
   AdafruitIO_Feed *feed(const char *name);
   AdafruitIO_Feed *feed(const char *name, const char *owner);
   AdafruitIO_Group *group(const char *name);
@@ -167,6 +172,23 @@ protected:
   Adafruit_MQTT_Subscribe
       *_throttle_sub; /*!< Subscription to Adafruit IO Throttle topic. */
 
+  bool _queue(AdafruitIO_Feed *feed);
+  void _unqueue(AdafruitIO_Feed *feed);
+  void _sendQueued();
+  bool _batchable(AdafruitIO_Feed *feed);
+
+  AdafruitIO_Feed *_send_queue[AIO_SEND_QUEUE_SIZE]; /*!< Feeds with a value
+                                                        waiting to be sent. */
+  uint8_t _send_queue_len = 0; /*!< Number of feeds in _send_queue. */
+  uint16_t _rate_limit = 0;    /*!< Values per minute the send scheduler may
+                                  publish, 0 to publish right away. */
+  uint8_t _rate_burst = AIO_RATE_LIMIT_BURST; /*!< Token bucket size. */
+  uint32_t _tokens = 0; /*!< Tokens in the bucket, in AIO_TOKEN units. */
+  uint32_t _last_refill = 0; /*!< Last time tokens were added, in
+                                milliseconds. */
+  AdafruitIO_Group *_batch_group = 0; /*!< Group used to publish several
+                                         feed values at once. */
+
 private:
   void _init();
 };
@@ -70,9 +70,8 @@ AdafruitIO_Data::AdafruitIO_Data(AdafruitIO_Feed *f, char *csv) {
   strcpy(_feed, f->name);
   memset(_value, 0, AIO_DATA_LENGTH);
   memset(_csv, 0, AIO_CSV_LENGTH);
-  strcpy(_csv, csv);
 
-  _parseCSV();
+  _parseCSV(csv);
 }
 
 /**************************************************************************/
@@ -94,9 +93,8 @@ AdafruitIO_Data::AdafruitIO_Data(AdafruitIO_Feed *f, const char *csv) {
   strcpy(_feed, f->name);
   memset(_value, 0, AIO_DATA_LENGTH);
   memset(_csv, 0, AIO_CSV_LENGTH);
-  strcpy(_csv, csv);
 
-  _parseCSV();
+  _parseCSV(csv);
 }
 
 /**************************************************************************/
@@ -136,9 +134,8 @@ AdafruitIO_Data::AdafruitIO_Data(const char *f, char *csv) {
   strcpy(_feed, f);
   memset(_value, 0, AIO_DATA_LENGTH);
   memset(_csv, 0, AIO_CSV_LENGTH);
-  strcpy(_csv, csv);
 
-  _parseCSV();
+  _parseCSV(csv);
 }
 
 /**************************************************************************/
@@ -159,12 +156,7 @@ bool AdafruitIO_Data::setCSV(char *csv) { return setCSV((const char *)(csv)); }
     @return   True if the CSV was parsed successfully, False if not
 */
 /**************************************************************************/
-bool AdafruitIO_Data::setCSV(const char *csv) {
-
-  memset(_csv, 0, AIO_CSV_LENGTH);
-  strcpy(_csv, csv);
-  return _parseCSV();
-}
+bool AdafruitIO_Data::setCSV(const char *csv) { return _parseCSV(csv); }
 
 /**************************************************************************/
 /*!
@@ -202,7 +194,8 @@ void AdafruitIO_Data::setLocation(double lat, double lon, double ele) {
 /**************************************************************************/
 void AdafruitIO_Data::setValue(const char *value, double lat, double lon,
                                double ele) {
-  strcpy(_value, value);
+  strncpy(_value, value, AIO_DATA_LENGTH - 1);
+  _value[AIO_DATA_LENGTH - 1] = '\0';
   setLocation(lat, lon, ele);
 }
 
@@ -221,8 +214,7 @@ void AdafruitIO_Data::setValue(const char *value, double lat, double lon,
 /**************************************************************************/
 void AdafruitIO_Data::setValue(char *value, double lat, double lon,
                                double ele) {
-  strcpy(_value, value);
-  setLocation(lat, lon, ele);
+  setValue((const char *)value, lat, lon, ele);
 }
 
 /**************************************************************************/
@@ -260,9 +252,9 @@ void AdafruitIO_Data::setValue(bool value, double lat, double lon, double ele) {
               Data record's elevation field.
 */
 /**************************************************************************/
-void AdafruitIO_Data::setValue(String value, double lat, double lon,
+void AdafruitIO_Data::setValue(const String &value, double lat, double lon,
                                double ele) {
-  value.toCharArray(_value, value.length() + 1);
+  value.toCharArray(_value, AIO_DATA_LENGTH);
   setLocation(lat, lon, ele);
 }
 
@@ -632,18 +624,45 @@ long AdafruitIO_Data::toNeoPixel() {
 */
 /**************************************************************************/
 char *AdafruitIO_Data::toCSV() {
-  memset(_csv, 0, AIO_CSV_LENGTH);
-  strcpy(_csv, "\"");
-  strcat(_csv, _value);
-  strcat(_csv, "\",");
-  strcat(_csv, charFromDouble(_lat));
-  strcat(_csv, ",");
-  strcat(_csv, charFromDouble(_lon));
-  strcat(_csv, ",");
-  strcat(_csv, charFromDouble(_ele, 2));
+  char *ptr = _csv;
+  char *end = _csv + AIO_CSV_LENGTH - 1;
+
+  // quoted value, with any quotes in it doubled
+  *ptr++ = '\"';
+  for (const char *v = _value; *v && ptr < end - 2; v++) {
+    if (*v == '\"')
+      *ptr++ = '\"';
+    *ptr++ = *v;
+  }
+  *ptr++ = '\"';
+
+  ptr = _appendCSV(ptr, end, charFromDouble(_lat));
+  ptr = _appendCSV(ptr, end, charFromDouble(_lon));
+  ptr = _appendCSV(ptr, end, charFromDouble(_ele, 2));
+  *ptr = '\0';
   return _csv;
 }
 
+/**************************************************************************/
+/*!
+    @brief    Appends a comma and an unquoted field to the CSV being built.
+    @param    ptr
+              Where to write.
+    @param    end
+              End of the CSV buffer, leaving room for the terminator.
+    @param    field
+              Field to append.
+    @return   Position after the field.
+*/
+/**************************************************************************/
+char *AdafruitIO_Data::_appendCSV(char *ptr, char *end, const char *field) {
+  if (ptr < end)
+    *ptr++ = ',';
+  while (*field && ptr < end)
+    *ptr++ = *field++;
+  return ptr;
+}
+
 /**************************************************************************/
 /*!
     @brief    Returns a data record's latitude value
@@ -698,218 +717,90 @@ char *AdafruitIO_Data::charFromDouble(double d, int precision) {
   return _double_buffer;
 }
 
-/*
- * From the csv_parser project by semitrivial
- * https://github.com/semitrivial/csv_parser/blob/93246cac509f85da12c6bb8c641fa75cd863c34f/csv.c
- * - retrieved 2017-11-09
- *
- * MIT License
- *
- * Copyright 2016 Samuel Alexander
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy
- * of this software and associated documentation files (the "Software"), to
- * deal in the Software without restriction, including without limitation the
- * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
- * sell copies of the Software, and to permit persons to whom the Software is
- * furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in
- * all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
- * IN THE SOFTWARE.
- *
- */
-
-static int count_fields(const char *line) {
-  const char *ptr;
-  int cnt, fQuote;
-
-  for (cnt = 1, fQuote = 0, ptr = line; *ptr; ptr++) {
-    if (fQuote) {
-      if (*ptr == '\"') {
-        if (ptr[1] == '\"') {
-          ptr++;
-          continue;
-        }
-        fQuote = 0;
-      }
-      continue;
-    }
-
-    switch (*ptr) {
-    case '\"':
-      fQuote = 1;
-      continue;
-    case ',':
-      cnt++;
-      continue;
-    default:
-      continue;
-    }
-  }
-
-  if (fQuote) {
-    return -1;
-  }
-
-  return cnt;
-}
-
 /**************************************************************************/
 /*!
-    @brief    Extracts a NULL-terminated array of strings, one for every
-              cell in the row.
-    @param    line
-              String containing linebreaks or no linebreaks, escaped by
-              "double quotes".
-    @return   CSV buffer, buf, NULL otherwise.
+    @brief    Copies one CSV field into a buffer, dropping the quotes around
+              it and unescaping doubled quotes. Characters past the size of
+              the buffer are skipped.
+    @param    ptr
+              Start of the field.
+    @param    dst
+              Buffer to copy the field into.
+    @param    len
+              Size of the buffer.
+    @return   The comma or terminator that ended the field, NULL if a quote
+              was left open.
 */
 /**************************************************************************/
-char **parse_csv(const char *line) {
-  char **buf, **bptr, *tmp, *tptr;
-  const char *ptr;
-  int fieldcnt, fQuote, fEnd;
-
-  fieldcnt = count_fields(line);
-
-  if (fieldcnt == -1) {
-    return NULL;
-  }
-
-  buf = (char **)malloc(sizeof(char *) * (fieldcnt + 1));
-
-  if (!buf) {
-    return NULL;
-  }
-
-  tmp = (char *)malloc(strlen(line) + 1);
+static const char *next_csv_field(const char *ptr, char *dst, size_t len) {
+  bool quoted = false;
+  size_t n = 0;
 
-  if (!tmp) {
-    free(buf);
-    return NULL;
-  }
+  for (;; ptr++) {
+    char c = *ptr;
 
-  bptr = buf;
-
-  for (ptr = line, fQuote = 0, *tmp = '\0', tptr = tmp, fEnd = 0;; ptr++) {
-    if (fQuote) {
-      if (!*ptr) {
-        break;
-      }
+    if (c == '\0') {
+      if (quoted)
+        return NULL;
+      break;
+    }
 
-      if (*ptr == '\"') {
-        if (ptr[1] == '\"') {
-          *tptr++ = '\"';
-          ptr++;
+    if (quoted) {
+      if (c == '\"') {
+        if (ptr[1] != '\"') {
+          quoted = false;
           continue;
         }
-        fQuote = 0;
-      } else {
-        *tptr++ = *ptr;
+        ptr++;
       }
-
+    } else if (c == '\"') {
+      quoted = true;
       continue;
-    }
-
-    switch (*ptr) {
-    case '\"':
-      fQuote = 1;
-      continue;
-    case '\0':
-      fEnd = 1;
+    } else if (c == ',') {
       break;
-    case ',':
-      *tptr = '\0';
-      *bptr = strdup(tmp);
-
-      if (!*bptr) {
-        for (bptr--; bptr >= buf; bptr--) {
-          free(*bptr);
-        }
-        free(buf);
-        free(tmp);
-
-        return NULL;
-      }
-
-      bptr++;
-      tptr = tmp;
-
-      if (fEnd) {
-        break;
-      } else {
-        continue;
-      }
-
-    default:
-      *tptr++ = *ptr;
-      continue;
     }
 
-    if (fEnd) {
-      break;
-    }
+    if (n + 1 < len)
+      dst[n++] = c;
   }
 
-  *bptr = NULL;
-  free(tmp);
-  return buf;
+  dst[n] = '\0';
+  return ptr;
 }
 
-//// END simple_csv SECTION
-
 /**************************************************************************/
 /*!
-    @brief    Checks if command-separated-value (CSV) is parsable
+    @brief    Parses an Adafruit IO data record in `value,lat,lon,ele`
+              format, straight from the given buffer and without allocating
+              memory.
+    @param    csv
+              Comma-separated-value record.
     @return   True if CSV is parsable, False if not.
 */
 /**************************************************************************/
-bool AdafruitIO_Data::_parseCSV() {
-
-  int field_count = count_fields(_csv);
-
-  if (field_count > 0) {
-    // this is normal IO data in `value,lat,lon,ele` format
-    char **fields = parse_csv(_csv);
+bool AdafruitIO_Data::_parseCSV(const char *csv) {
+  char value[AIO_DATA_LENGTH];
+  char number[24];
+  double location[3] = {0, 0, 0};
 
-    // first field is handled as string
-    strcpy(_value, fields[0]);
-    field_count--;
-
-    // locations fields are handled with char * to float conversion
-    if (field_count > 0) {
-      _lat = atof(fields[1]);
-      field_count--;
-    }
-
-    if (field_count > 0) {
-      _lon = atof(fields[1]);
-      field_count--;
-    }
-
-    if (field_count > 0) {
-      _ele = atof(fields[1]);
-      field_count--;
-    }
-
-    // cleanup to avoid leaks
-    int i = 0;
-    while (fields[i] != NULL) {
-      free(fields[i++]);
-    }
-    free(fields);
-
-    return field_count == 0;
-  } else {
+  // first field is handled as string
+  const char *ptr = next_csv_field(csv, value, sizeof(value));
+  if (!ptr)
     return false;
+
+  // locations fields are handled with char * to float conversion
+  for (int i = 0; i < 3 && *ptr == ','; i++) {
+    ptr = next_csv_field(ptr + 1, number, sizeof(number));
+    if (!ptr)
+      return false;
+    location[i] = atof(number);
   }
 
-  return true;
+  strcpy(_value, value);
+  _lat = location[0];
+  _lon = location[1];
+  _ele = location[2];
+
+  // anything after the elevation isn't IO data
+  return *ptr == '\0';
 }
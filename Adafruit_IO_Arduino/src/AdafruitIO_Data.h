@@ -46,7 +46,8 @@ public:
                 double ele = 0);
   void setValue(char *value, double lat = 0, double lon = 0, double ele = 0);
   void setValue(bool value, double lat = 0, double lon = 0, double ele = 0);
-  void setValue(String value, double lat = 0, double lon = 0, double ele = 0);
+  void setValue(const String &value, double lat = 0, double lon = 0,
+                double ele = 0);
   void setValue(int value, double lat = 0, double lon = 0, double ele = 0);
   void setValue(unsigned int value, double lat = 0, double lon = 0,
                 double ele = 0);
@@ -100,7 +101,8 @@ private:
 
   double _lat, _lon, _ele;
 
-  bool _parseCSV();
+  bool _parseCSV(const char *csv);
+  char *_appendCSV(char *ptr, char *end, const char *field);
 };
 
 #endif // ADAFRUITIO_DATA_H
@@ -112,6 +112,21 @@ public:
 #define AIO_NET_DISCONNECT_WAIT                                                \
   300 ///< Time to wait for a net disconnect to take effect
 
+#ifndef AIO_SEND_QUEUE_SIZE
+#define AIO_SEND_QUEUE_SIZE                                                    \
+  8 ///< Maximum number of feeds waiting for the send scheduler
+#endif
+#ifndef AIO_RATE_LIMIT_BURST
+#define AIO_RATE_LIMIT_BURST                                                   \
+  5 ///< Values the send scheduler may send at once after a quiet spell
+#endif
+#define AIO_TOKEN                                                              \
+  60000UL ///< One send scheduler token. The bucket gains _rate_limit units
+          ///< a millisecond, which is _rate_limit tokens a minute
+#define AIO_BATCH_LENGTH                                                       \
+  150 ///< Maximum length of a batched group publish, as in
+      ///< AdafruitIO_Group::save()
+
 #define AIO_ERROR_TOPIC "/errors"      ///< Adafruit IO Error MQTT Topic
 #define AIO_THROTTLE_TOPIC "/throttle" ///< Adafruit IO Throttle MQTT Topic
 
@@ -60,6 +60,9 @@ AdafruitIO_Feed::AdafruitIO_Feed(AdafruitIO *io, const char *n, const char *un)
 */
 /**************************************************************************/
 AdafruitIO_Feed::~AdafruitIO_Feed() {
+  // don't leave a dangling pointer in the send queue
+  _io->_unqueue(this);
+
   if (_sub)
     delete _sub;
 
@@ -96,6 +99,20 @@ void AdafruitIO_Feed::onMessage(AdafruitIODataCallbackType cb) {
   _dataCallback = cb;
 }
 
+/**************************************************************************/
+/*!
+    @brief    Publishes the feed's current data, or queues it when a rate
+              limit is set on the AdafruitIO instance.
+    @return   True if data was published or queued, False otherwise.
+*/
+/**************************************************************************/
+bool AdafruitIO_Feed::_save() {
+  if (_io->_rate_limit)
+    return _io->_queue(this);
+
+  return _pub->publish(data->toCSV());
+}
+
 /**************************************************************************/
 /*!
     @brief    Updates Adafruit IO Feed.
@@ -112,7 +129,7 @@ void AdafruitIO_Feed::onMessage(AdafruitIODataCallbackType cb) {
 /**************************************************************************/
 bool AdafruitIO_Feed::save(char *value, double lat, double lon, double ele) {
   data->setValue(value, lat, lon, ele);
-  return _pub->publish(data->toCSV());
+  return _save();
 }
 
 /**************************************************************************/
@@ -131,7 +148,7 @@ bool AdafruitIO_Feed::save(char *value, double lat, double lon, double ele) {
 /**************************************************************************/
 bool AdafruitIO_Feed::save(bool value, double lat, double lon, double ele) {
   data->setValue(value, lat, lon, ele);
-  return _pub->publish(data->toCSV());
+  return _save();
 }
 
 /**************************************************************************/
@@ -150,7 +167,7 @@ bool AdafruitIO_Feed::save(bool value, double lat, double lon, double ele) {
 /**************************************************************************/
 bool AdafruitIO_Feed::save(String value, double lat, double lon, double ele) {
   data->setValue(value, lat, lon, ele);
-  return _pub->publish(data->toCSV());
+  return _save();
 }
 
 /**************************************************************************/
@@ -169,7 +186,7 @@ bool AdafruitIO_Feed::save(String value, double lat, double lon, double ele) {
 /**************************************************************************/
 bool AdafruitIO_Feed::save(int value, double lat, double lon, double ele) {
   data->setValue(value, lat, lon, ele);
-  return _pub->publish(data->toCSV());
+  return _save();
 }
 
 /**************************************************************************/
@@ -189,7 +206,7 @@ bool AdafruitIO_Feed::save(int value, double lat, double lon, double ele) {
 bool AdafruitIO_Feed::save(unsigned int value, double lat, double lon,
                            double ele) {
   data->setValue(value, lat, lon, ele);
-  return _pub->publish(data->toCSV());
+  return _save();
 }
 
 /**************************************************************************/
@@ -208,7 +225,7 @@ bool AdafruitIO_Feed::save(unsigned int value, double lat, double lon,
 /**************************************************************************/
 bool AdafruitIO_Feed::save(long value, double lat, double lon, double ele) {
   data->setValue(value, lat, lon, ele);
-  return _pub->publish(data->toCSV());
+  return _save();
 }
 
 /**************************************************************************/
@@ -228,7 +245,7 @@ bool AdafruitIO_Feed::save(long value, double lat, double lon, double ele) {
 bool AdafruitIO_Feed::save(unsigned long value, double lat, double lon,
                            double ele) {
   data->setValue(value, lat, lon, ele);
-  return _pub->publish(data->toCSV());
+  return _save();
 }
 
 /**************************************************************************/
@@ -250,7 +267,7 @@ bool AdafruitIO_Feed::save(unsigned long value, double lat, double lon,
 bool AdafruitIO_Feed::save(float value, double lat, double lon, double ele,
                            int precision) {
   data->setValue(value, lat, lon, ele, precision);
-  return _pub->publish(data->toCSV());
+  return _save();
 }
 
 /**************************************************************************/
@@ -272,7 +289,7 @@ bool AdafruitIO_Feed::save(float value, double lat, double lon, double ele,
 bool AdafruitIO_Feed::save(double value, double lat, double lon, double ele,
                            int precision) {
   data->setValue(value, lat, lon, ele, precision);
-  return _pub->publish(data->toCSV());
+  return _save();
 }
 
 /****************************************************************************/
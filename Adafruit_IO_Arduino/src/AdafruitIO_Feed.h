@@ -32,6 +32,11 @@ class AdafruitIO;
 */
 /**************************************************************************/
 class AdafruitIO_Feed : public AdafruitIO_MQTT {
+  /**
+   * @brief AdafruitIO addition, which publishes queued values.
+   * @relates AdafruitIO
+   */
+  friend class AdafruitIO;
 
 public:
   AdafruitIO_Feed(AdafruitIO *io, const char *name);
@@ -73,6 +78,7 @@ private:
       _dataCallback; /*!< Callback from onMessage containing data. */
 
   void _init();
+  bool _save();
 
   char *_topic;      /*!< MQTT Topic URL */
   char *_get_topic;  /*!< /get topic string */
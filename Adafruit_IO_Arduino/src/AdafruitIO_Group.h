@@ -28,6 +28,11 @@ class AdafruitIO;
 */
 /**************************************************************************/
 class AdafruitIO_Group : public AdafruitIO_MQTT {
+  /**
+   * @brief AdafruitIO addition, which publishes batches of feed values.
+   * @relates AdafruitIO
+   */
+  friend class AdafruitIO;
 
 public:
   AdafruitIO_Group(AdafruitIO *io, const char *name);
@@ -50,15 +50,20 @@ void Adafruit_MCP23017::begin(uint8_t addr) {
 
   
   // set defaults!
-  Wire.beginTransmission(MCP23017_ADDRESS | i2caddr);
-  wiresend(MCP23017_IODIRA);
-  wiresend(0xFF);  // all inputs on port A
-  Wire.endTransmission();
-
-  Wire.beginTransmission(MCP23017_ADDRESS | i2caddr);
-  wiresend(MCP23017_IODIRB);
-  wiresend(0xFF);  // all inputs on port B
-  Wire.endTransmission();
+  _iodir = 0xFFFF;  // all inputs on port A and B
+  writeRegister16(MCP23017_IODIRA, _iodir);
+
+  // the output latches and pullups may survive a reset of the MCU
+  _olat = readRegister16(MCP23017_OLATA);
+  _gppu = readRegister16(MCP23017_GPPUA);
+  _gpinten = 0;
+  _intcon = 0;
+  _defval = 0;
+  _intcap = 0;
+  writeRegister16(MCP23017_GPINTENA, 0);
+
+  for (uint8_t i = 0; i < 16; i++)
+    callbacks[i] = 0;
 }
 
 
@@ -66,50 +71,32 @@ void Adafruit_MCP23017::begin(void) {
   begin(0);
 }
 
-void Adafruit_MCP23017::pinMode(uint8_t p, uint8_t d) {
-  uint8_t iodir;
-  uint8_t iodiraddr;
-
-  // only 16 bits!
-  if (p > 15)
-    return;
+// low level register access
+// with IOCON.BANK = 0 the A and B registers of a pair are adjacent,
+// and sequential addressing reads or writes both in one transaction
 
-  if (p < 8)
-    iodiraddr = MCP23017_IODIRA;
-  else {
-    iodiraddr = MCP23017_IODIRB;
-    p -= 8;
-  }
-
-  // read the current IODIR
+uint8_t Adafruit_MCP23017::readRegister(uint8_t addr) {
   Wire.beginTransmission(MCP23017_ADDRESS | i2caddr);
-  wiresend(iodiraddr);	
+  wiresend(addr);	
   Wire.endTransmission();
   
   Wire.requestFrom(MCP23017_ADDRESS | i2caddr, 1);
-  iodir = wirerecv();
-
-  // set the pin and direction
-  if (d == INPUT) {
-    iodir |= 1 << p; 
-  } else {
-    iodir &= ~(1 << p);
-  }
+  return wirerecv();
+}
 
-  // write the new IODIR
+void Adafruit_MCP23017::writeRegister(uint8_t addr, uint8_t value) {
   Wire.beginTransmission(MCP23017_ADDRESS | i2caddr);
-  wiresend(iodiraddr);
-  wiresend(iodir);	
+  wiresend(addr);
+  wiresend(value);	
   Wire.endTransmission();
 }
 
-uint16_t Adafruit_MCP23017::readGPIOAB() {
+uint16_t Adafruit_MCP23017::readRegister16(uint8_t addr) {
   uint16_t ba = 0;
   uint8_t a;
 
-  // read the current GPIO output latches
   Wire.beginTransmission(MCP23017_ADDRESS | i2caddr);
-  wiresend(MCP23017_GPIOA);	
+  wiresend(addr);	
   Wire.endTransmission();
   
   Wire.requestFrom(MCP23017_ADDRESS | i2caddr, 2);
@@ -121,110 +108,181 @@ uint16_t Adafruit_MCP23017::readGPIOAB() {
   return ba;
 }
 
-void Adafruit_MCP23017::writeGPIOAB(uint16_t ba) {
+void Adafruit_MCP23017::writeRegister16(uint8_t addr, uint16_t ba) {
   Wire.beginTransmission(MCP23017_ADDRESS | i2caddr);
-  wiresend(MCP23017_GPIOA);	
+  wiresend(addr);	
   wiresend(ba & 0xFF);
   wiresend(ba >> 8);
   Wire.endTransmission();
 }
 
-void Adafruit_MCP23017::digitalWrite(uint8_t p, uint8_t d) {
-  uint8_t gpio;
-  uint8_t gpioaddr, olataddr;
+// set or clear bit p of a cached register pair and write back the port it is in
+void Adafruit_MCP23017::updateRegisterBit(uint16_t *shadow, uint8_t addrA,
+                                          uint8_t p, uint8_t set) {
+  if (set)
+    *shadow |= 1 << p;
+  else
+    *shadow &= ~(1 << p);
+
+  if (p < 8)
+    writeRegister(addrA, *shadow & 0xFF);
+  else
+    writeRegister(addrA + 1, *shadow >> 8);
+}
 
+void Adafruit_MCP23017::pinMode(uint8_t p, uint8_t d) {
   // only 16 bits!
   if (p > 15)
     return;
 
-  if (p < 8) {
-    olataddr = MCP23017_OLATA;
-    gpioaddr = MCP23017_GPIOA;
-  } else {
-    olataddr = MCP23017_OLATB;
-    gpioaddr = MCP23017_GPIOB;
-    p -= 8;
-  }
+  updateRegisterBit(&_iodir, MCP23017_IODIRA, p, d == INPUT);
+}
 
-  // read the current GPIO output latches
-  Wire.beginTransmission(MCP23017_ADDRESS | i2caddr);
-  wiresend(olataddr);	
-  Wire.endTransmission();
-  
-  Wire.requestFrom(MCP23017_ADDRESS | i2caddr, 1);
-   gpio = wirerecv();
+uint16_t Adafruit_MCP23017::readGPIOAB() {
+  // read the current GPIO inputs
+  return readRegister16(MCP23017_GPIOA);
+}
+
+void Adafruit_MCP23017::writeGPIOAB(uint16_t ba) {
+  _olat = ba;
+  writeRegister16(MCP23017_GPIOA, ba);
+}
+
+// read one port, 0 = A, 1 = B
+uint8_t Adafruit_MCP23017::readGPIO(uint8_t b) {
+  return readRegister(b ? MCP23017_GPIOB : MCP23017_GPIOA);
+}
 
-  // set the pin and direction
-  if (d == HIGH) {
-    gpio |= 1 << p; 
+// write one port, 0 = A, 1 = B
+void Adafruit_MCP23017::writeGPIO(uint8_t b, uint8_t value) {
+  if (b) {
+    _olat = (_olat & 0x00FF) | ((uint16_t)value << 8);
+    writeRegister(MCP23017_GPIOB, value);
   } else {
-    gpio &= ~(1 << p);
+    _olat = (_olat & 0xFF00) | value;
+    writeRegister(MCP23017_GPIOA, value);
   }
+}
 
-  // write the new GPIO
-  Wire.beginTransmission(MCP23017_ADDRESS | i2caddr);
-  wiresend(gpioaddr);
-  wiresend(gpio);	
-  Wire.endTransmission();
+// the direction of all 16 pins, a 1 bit is an input
+void Adafruit_MCP23017::pinModeAB(uint16_t inputs) {
+  _iodir = inputs;
+  writeRegister16(MCP23017_IODIRA, inputs);
 }
 
-void Adafruit_MCP23017::pullUp(uint8_t p, uint8_t d) {
-  uint8_t gppu;
-  uint8_t gppuaddr;
+// the pullups of all 16 pins, a 1 bit is enabled
+void Adafruit_MCP23017::pullUpAB(uint16_t enabled) {
+  _gppu = enabled;
+  writeRegister16(MCP23017_GPPUA, enabled);
+}
+
+// the output latches as last written
+uint16_t Adafruit_MCP23017::readOLATAB() {
+  return _olat;
+}
 
+void Adafruit_MCP23017::digitalWrite(uint8_t p, uint8_t d) {
   // only 16 bits!
   if (p > 15)
     return;
 
-  if (p < 8)
-    gppuaddr = MCP23017_GPPUA;
-  else {
-    gppuaddr = MCP23017_GPPUB;
-    p -= 8;
-  }
-
-
-  // read the current pullup resistor set
-  Wire.beginTransmission(MCP23017_ADDRESS | i2caddr);
-  wiresend(gppuaddr);	
-  Wire.endTransmission();
-  
-  Wire.requestFrom(MCP23017_ADDRESS | i2caddr, 1);
-  gppu = wirerecv();
+  // writing the port changes the output latch, kept in _olat
+  updateRegisterBit(&_olat, MCP23017_GPIOA, p, d == HIGH);
+}
 
-  // set the pin and direction
-  if (d == HIGH) {
-    gppu |= 1 << p; 
-  } else {
-    gppu &= ~(1 << p);
-  }
+void Adafruit_MCP23017::pullUp(uint8_t p, uint8_t d) {
+  // only 16 bits!
+  if (p > 15)
+    return;
 
-  // write the new GPIO
-  Wire.beginTransmission(MCP23017_ADDRESS | i2caddr);
-  wiresend(gppuaddr);
-  wiresend(gppu);	
-  Wire.endTransmission();
+  updateRegisterBit(&_gppu, MCP23017_GPPUA, p, d == HIGH);
 }
 
 uint8_t Adafruit_MCP23017::digitalRead(uint8_t p) {
-  uint8_t gpioaddr;
-
   // only 16 bits!
   if (p > 15)
     return 0;
 
+  // read the current GPIO
   if (p < 8)
-    gpioaddr = MCP23017_GPIOA;
-  else {
-    gpioaddr = MCP23017_GPIOB;
-    p -= 8;
-  }
+    return (readGPIO(0) >> p) & 0x1;
+  return (readGPIO(1) >> (p - 8)) & 0x1;
+}
 
-  // read the current GPIO
+// configure the INTA/INTB outputs
+// mirroring: 1 to OR both ports onto each pin
+// openDrain: 1 for open drain, otherwise push-pull with the given polarity
+// polarity: HIGH or LOW when active
+void Adafruit_MCP23017::setupInterrupts(uint8_t mirroring, uint8_t openDrain,
+                                        uint8_t polarity) {
+  uint8_t iocon = readRegister(MCP23017_IOCONA);
+  iocon &= ~((1 << 6) | (1 << 2) | (1 << 1));
+  if (mirroring)
+    iocon |= 1 << 6;
+  if (openDrain)
+    iocon |= 1 << 2;
+  if (polarity == HIGH)
+    iocon |= 1 << 1;
+  writeRegister(MCP23017_IOCONA, iocon);
+}
+
+// enable interrupt on change for pin p
+// mode is CHANGE, FALLING or RISING. FALLING and RISING compare against the
+// idle level, so the interrupt stays active for as long as the pin is at the
+// other level. The callback, if any, is called from handleInterrupt()
+void Adafruit_MCP23017::setupInterruptPin(uint8_t p, uint8_t mode,
+                                          MCP23017Callback callback) {
+  // only 16 bits!
+  if (p > 15)
+    return;
+
+  callbacks[p] = callback;
+
+  // DEFVAL holds the idle level, INTCON selects comparing against it
+  updateRegisterBit(&_intcon, MCP23017_INTCONA, p, mode != CHANGE);
+  updateRegisterBit(&_defval, MCP23017_DEFVALA, p, mode == FALLING);
+  updateRegisterBit(&_gpinten, MCP23017_GPINTENA, p, 1);
+}
+
+// disable interrupt on change for pin p
+void Adafruit_MCP23017::disableInterruptPin(uint8_t p) {
+  // only 16 bits!
+  if (p > 15)
+    return;
+
+  updateRegisterBit(&_gpinten, MCP23017_GPINTENA, p, 0);
+  callbacks[p] = 0;
+}
+
+// call from loop() after INTA/INTB went active, never from the interrupt
+// itself as it uses Wire. One transaction reads INTF and INTCAP of both
+// ports, which also releases INTA/INTB. The callback of every flagged pin
+// gets the level captured when the interrupt occurred.
+// returns the flagged pins, 0 if none
+uint16_t Adafruit_MCP23017::handleInterrupt() {
+  uint8_t buf[4];
+
+  // INTFA, INTFB, INTCAPA, INTCAPB
   Wire.beginTransmission(MCP23017_ADDRESS | i2caddr);
-  wiresend(gpioaddr);	
+  wiresend(MCP23017_INTFA);	
   Wire.endTransmission();
   
-  Wire.requestFrom(MCP23017_ADDRESS | i2caddr, 1);
-  return (wirerecv() >> p) & 0x1;
+  Wire.requestFrom(MCP23017_ADDRESS | i2caddr, 4);
+  for (uint8_t i = 0; i < 4; i++)
+    buf[i] = wirerecv();
+
+  uint16_t flags = buf[0] | ((uint16_t)buf[1] << 8);
+  uint16_t captured = buf[2] | ((uint16_t)buf[3] << 8);
+  _intcap = captured;
+
+  for (uint8_t p = 0; p < 16; p++) {
+    if ((flags & (1 << p)) && callbacks[p])
+      callbacks[p](p, (captured >> p) & 0x1);
+  }
+  return flags;
+}
+
+// the port levels captured by the last handleInterrupt()
+uint16_t Adafruit_MCP23017::readINTCAPAB() {
+  return _intcap;
 }
@@ -14,6 +14,9 @@
 #ifndef _Adafruit_MCP23017_H_
 #define _Adafruit_MCP23017_H_
 
+// called by handleInterrupt() with the pin and its captured level
+typedef void (*MCP23017Callback)(uint8_t pin, uint8_t value);
+
 // Don't forget the Wire library
 class Adafruit_MCP23017 {
 public:
@@ -28,8 +31,39 @@ public:
   void writeGPIOAB(uint16_t);
   uint16_t readGPIOAB();
 
+  // whole port access, one transaction each
+  uint8_t readGPIO(uint8_t b);
+  void writeGPIO(uint8_t b, uint8_t value);
+  void pinModeAB(uint16_t inputs);
+  void pullUpAB(uint16_t enabled);
+  uint16_t readOLATAB();
+
+  // interrupt on change
+  void setupInterrupts(uint8_t mirroring, uint8_t openDrain, uint8_t polarity);
+  void setupInterruptPin(uint8_t p, uint8_t mode, MCP23017Callback callback = 0);
+  void disableInterruptPin(uint8_t p);
+  uint16_t handleInterrupt();
+  uint16_t readINTCAPAB();
+
  private:
   uint8_t i2caddr;
+
+  // shadows of the configuration registers, A in the low byte, so pin
+  // writes are a single transaction instead of a read-modify-write
+  uint16_t _iodir;
+  uint16_t _olat;
+  uint16_t _gppu;
+  uint16_t _gpinten;
+  uint16_t _intcon;
+  uint16_t _defval;
+  uint16_t _intcap;
+  MCP23017Callback callbacks[16];
+
+  uint8_t readRegister(uint8_t addr);
+  void writeRegister(uint8_t addr, uint8_t value);
+  uint16_t readRegister16(uint8_t addr);
+  void writeRegister16(uint8_t addr, uint16_t value);
+  void updateRegisterBit(uint16_t *shadow, uint8_t addrA, uint8_t p, uint8_t set);
 };
 
 #define MCP23017_ADDRESS 0x20
@@ -87,3 +87,203 @@ bool Adafruit_MCP4725::setVoltage(uint16_t output, bool writeEEPROM,
   i2c_dev->setSpeed(100000); // reset to arduino default
   return true;
 }
+
+/**************************************************************************/
+/*!
+    @brief  Sets the output to several values in a row with fast-mode
+            writes, two bytes per sample and as many samples per I2C
+            transaction as the Wire buffer holds. The outputs change at
+            the I2C clock already set, 18 clocks per sample.
+
+    @param[in]  samples
+                The 12-bit values (0..4095)
+    @param[in]  count
+                Number of values
+    @returns True if able to write all values over I2C
+*/
+/**************************************************************************/
+bool Adafruit_MCP4725::writeFast(const uint16_t *samples, size_t count) {
+  uint8_t packet[MCP4725_STREAM_BLOCK_BYTES];
+  size_t max = min((size_t)MCP4725_STREAM_BLOCK_BYTES, i2c_dev->maxBufferSize());
+  max /= 2;
+
+  while (count) {
+    size_t n = min(count, max);
+    for (size_t i = 0; i < n; i++) {
+      // fast mode: C2 = C1 = 0 and power down bits 0, then D11..D0
+      packet[2 * i] = (samples[i] >> 8) & 0x0F;
+      packet[2 * i + 1] = samples[i] & 0xFF;
+    }
+    if (!i2c_dev->write(packet, 2 * n)) {
+      return false;
+    }
+    samples += n;
+    count -= n;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Starts streaming a buffer of samples at a fixed rate. Keep
+            calling updateStream() until it returns false.
+
+    Above about 5.5 kHz the samples are packed into fast-mode
+    transactions and the I2C clock is set so that the bus itself paces
+    them, up to about 22 kHz at 400 kHz. Below that every sample is one
+    transaction, paced by micros(). A timer interrupt can not be used as
+    Wire does not work inside interrupts.
+
+    @param  sample_rate Samples per second
+    @param  samples The 12-bit values, must stay valid while streaming
+    @param  count Number of values
+    @param  repeat Start over at the end of the buffer instead of stopping
+    @returns True if the rate can be reached and the stream started
+*/
+/**************************************************************************/
+bool Adafruit_MCP4725::beginStream(uint32_t sample_rate,
+                                   const uint16_t *samples, size_t count,
+                                   bool repeat) {
+  if (!samples || !count) {
+    return false;
+  }
+  _samples = samples;
+  _count = count;
+  _pos = 0;
+  _repeat = repeat;
+  _generator = NULL;
+  return startStream(sample_rate);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Starts streaming samples from a generator at a fixed rate, see
+            the buffer version for the timing. The stream runs until
+            endStream() is called.
+    @param  sample_rate Samples per second
+    @param  generator Called once per sample
+    @param  context Passed to the generator
+    @returns True if the rate can be reached and the stream started
+*/
+/**************************************************************************/
+bool Adafruit_MCP4725::beginStream(uint32_t sample_rate,
+                                   Adafruit_MCP4725_Generator generator,
+                                   void *context) {
+  if (!generator) {
+    return false;
+  }
+  _samples = NULL;
+  _generator = generator;
+  _context = context;
+  return startStream(sample_rate);
+}
+
+bool Adafruit_MCP4725::startStream(uint32_t sample_rate) {
+  _rate = 0;
+  if (!i2c_dev || !sample_rate) {
+    return false;
+  }
+
+  size_t max = min((size_t)MCP4725_STREAM_BLOCK_BYTES, i2c_dev->maxBufferSize());
+  uint8_t block = max / 2;
+
+  // a block of n samples takes 18 * n clocks, plus about 11 for the start,
+  // the address byte and the stop. Running the bus 3% fast leaves time for
+  // the code between blocks, updateStream() holds back blocks that are early
+  uint32_t clock = (uint64_t)sample_rate * (18 * block + 11) / block;
+  if (clock > MCP4725_STREAM_MAX_CLOCK) {
+    return false;
+  }
+  clock = min(clock + clock / 32, (uint32_t)MCP4725_STREAM_MAX_CLOCK);
+  if (clock < MCP4725_STREAM_MIN_PACKED_CLOCK) {
+    // too slow to pace with the bus, one sample per transaction
+    block = 1;
+    clock = MCP4725_STREAM_MAX_CLOCK;
+  }
+  if (!i2c_dev->setSpeed(clock) && block > 1) {
+    return false; // the bus can not pace the samples on this platform
+  }
+
+  _rate = sample_rate;
+  _block = block;
+  _sent = 0;
+  _underruns = 0;
+  _started = micros();
+  return true;
+}
+
+bool Adafruit_MCP4725::nextSample(uint16_t *sample) {
+  if (_generator) {
+    *sample = _generator(_context);
+    return true;
+  }
+  if (_pos >= _count) {
+    if (!_repeat) {
+      return false;
+    }
+    _pos = 0;
+  }
+  *sample = _samples[_pos++];
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Writes the next samples when they are due. Call as often as
+            possible while streaming; with packed blocks it blocks for
+            the length of one block.
+    @returns False once the stream has ended or failed
+*/
+/**************************************************************************/
+bool Adafruit_MCP4725::updateStream(void) {
+  if (!_rate) {
+    return false;
+  }
+
+  // when the next sample is due, relative to the start of the stream
+  uint32_t due = (uint64_t)_sent * 1000000 / _rate;
+  uint32_t now = micros() - _started;
+  if ((int32_t)(now - due) < 0) {
+    return true;
+  }
+  if (now - due > (uint32_t)_block * 1000000 / _rate) {
+    // more than a block late, drop the backlog instead of rushing it out
+    _underruns++;
+    _started = micros() - due;
+  }
+
+  uint16_t samples[MCP4725_STREAM_BLOCK_BYTES / 2];
+  uint8_t n = 0;
+  while (n < _block && nextSample(&samples[n])) {
+    n++;
+  }
+  if (!n || !writeFast(samples, n)) {
+    endStream();
+    return false;
+  }
+  _sent += n;
+  if (_sent >= _rate) {
+    // move the reference up by a second so the arithmetic never overflows
+    _sent -= _rate;
+    _started += 1000000;
+  }
+  if (n < _block) {
+    endStream();
+    return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Stops the stream and puts the I2C clock back to 100 kHz, the
+            output keeps the last sample
+*/
+/**************************************************************************/
+void Adafruit_MCP4725::endStream(void) {
+  if (!_rate) {
+    return;
+  }
+  _rate = 0;
+  i2c_dev->setSpeed(100000); // reset to arduino default
+}
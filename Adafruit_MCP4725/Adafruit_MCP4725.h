@@ -17,6 +17,18 @@
   (0x60) ///< Writes data to the DAC and the EEPROM (persisting the assigned
          ///< value after reset)
 
+#define MCP4725_STREAM_BLOCK_BYTES                                             \
+  (64) ///< Most bytes of fast-mode samples sent in one transaction
+#define MCP4725_STREAM_MIN_PACKED_CLOCK                                        \
+  (100000) ///< Below this I2C clock samples are paced one by one
+#define MCP4725_STREAM_MAX_CLOCK (400000) ///< Fastest I2C clock used
+
+/*!
+    @brief  Produces the next sample (0..4095) of a stream
+    @param  context The pointer given to beginStream()
+*/
+typedef uint16_t (*Adafruit_MCP4725_Generator)(void *context);
+
 /**************************************************************************/
 /*!
     @brief  Class for communicating with an MCP4725 DAC
@@ -29,9 +41,39 @@ public:
              TwoWire *wire = &Wire);
   bool setVoltage(uint16_t output, bool writeEEPROM,
                   uint32_t dac_frequency = 400000);
+  bool writeFast(const uint16_t *samples, size_t count);
+
+  bool beginStream(uint32_t sample_rate, const uint16_t *samples,
+                   size_t count, bool repeat = true);
+  bool beginStream(uint32_t sample_rate, Adafruit_MCP4725_Generator generator,
+                   void *context = NULL);
+  bool updateStream(void);
+  void endStream(void);
+  /*!   @brief  Whether a stream is running
+   *    @return True between beginStream() and the end of the stream */
+  bool streaming(void) { return _rate != 0; }
+  /*!   @brief  How often updateStream() was called too late to keep the
+   *    sample rate
+   *    @return The number of late calls since beginStream() */
+  uint32_t streamUnderruns(void) { return _underruns; }
 
 private:
   Adafruit_I2CDevice *i2c_dev = NULL;
+
+  uint32_t _rate = 0;
+  uint8_t _block = 0;
+  uint32_t _started = 0;
+  uint32_t _sent = 0;
+  uint32_t _underruns = 0;
+  const uint16_t *_samples = NULL;
+  size_t _count = 0;
+  size_t _pos = 0;
+  bool _repeat = false;
+  Adafruit_MCP4725_Generator _generator = NULL;
+  void *_context = NULL;
+
+  bool startStream(uint32_t sample_rate);
+  bool nextSample(uint16_t *sample);
 };
 
 #endif
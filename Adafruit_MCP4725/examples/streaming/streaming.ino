@@ -0,0 +1,52 @@
+/**************************************************************************/
+/*!
+    @file     streaming.ino
+    @license  BSD (see license.txt)
+
+    This example streams a 100 Hz triangle wave at 20000 samples per
+    second with the MCP4725 DAC. The samples go out as fast-mode writes,
+    16 or more per I2C transaction, and the I2C clock is set so that the
+    bus paces them.
+
+    This is an example sketch for the Adafruit MCP4725 breakout board
+    ----> http://www.adafruit.com/products/935
+*/
+/**************************************************************************/
+#include <Wire.h>
+#include <Adafruit_MCP4725.h>
+
+Adafruit_MCP4725 dac;
+
+#define SAMPLE_RATE 20000
+#define WAVE_FREQUENCY 100
+
+uint16_t triangle(void *context) {
+  uint32_t *phase = (uint32_t *)context;
+  const uint32_t period = SAMPLE_RATE / WAVE_FREQUENCY;
+
+  uint32_t p = *phase;
+  *phase = (p + 1) % period;
+  if (p < period / 2) {
+    return p * 4095 / (period / 2);
+  }
+  return (period - p) * 4095 / (period / 2);
+}
+
+uint32_t phase = 0;
+
+void setup(void) {
+  Serial.begin(9600);
+  Serial.println("MCP4725 streaming test");
+
+  // For Adafruit MCP4725A1 the address is 0x62 (default) or 0x63 (ADDR pin tied to VCC)
+  dac.begin(0x62);
+
+  if (!dac.beginStream(SAMPLE_RATE, triangle, &phase)) {
+    Serial.println("This sample rate is not possible");
+  }
+}
+
+void loop(void) {
+  // keep the loop short, every late call shows up as an underrun
+  dac.updateStream();
+}
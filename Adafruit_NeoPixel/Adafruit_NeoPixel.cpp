@@ -117,6 +117,15 @@ Adafruit_NeoPixel::Adafruit_NeoPixel()
   @brief   Deallocate Adafruit_NeoPixel object, set data pin back to INPUT.
 */
 Adafruit_NeoPixel::~Adafruit_NeoPixel() {
+#if defined(NEO_ASYNC_SHOW)
+  txWait();
+#endif
+  free(txPixels);
+  free(lut);
+#if defined(ARDUINO_ARCH_RP2040)
+  if (txDma >= 0)
+    dma_channel_unclaim(txDma);
+#endif
   free(pixels);
   if (pin >= 0)
     pinMode(pin, INPUT);
@@ -144,6 +153,11 @@ void Adafruit_NeoPixel::begin(void) {
            type).
 */
 void Adafruit_NeoPixel::updateLength(uint16_t n) {
+#if defined(NEO_ASYNC_SHOW)
+  txWait(); // Don't free a buffer the hardware is still reading
+#endif
+  free(txPixels);
+  txPixels = NULL;
   free(pixels); // Free existing data (if any)
 
   // Allocate new data -- note: ALL PIXELS ARE CLEARED
@@ -389,6 +403,9 @@ extern "C" IRAM_ATTR void espShow(uint16_t pin, uint8_t *pixels,
 #elif defined(ESP32)
 extern "C" void espShow(uint16_t pin, uint8_t *pixels, uint32_t numBytes,
                         uint8_t type);
+extern "C" void *espShowAsync(uint16_t pin, uint8_t *pixels, uint32_t numBytes,
+                              uint8_t type);
+extern "C" bool espShowDone(void *handle);
 #endif // ESP8266
 
 #if defined(K210)
@@ -423,6 +440,11 @@ void Adafruit_NeoPixel::show(void) {
   // rather than stalling for the latch.
   while (!canShow())
     ;
+
+  // With setOutputLUT() the architecture code below sends the translated
+  // copy: this local deliberately hides the 'pixels' member.
+  uint8_t *pixels = lut ? encodePixels() : this->pixels;
+
     // endTime is a private member (rather than global var) so that multiple
     // instances on different pins can be quickly issued in succession (each
     // instance doesn't delay the next).
@@ -3278,6 +3300,101 @@ if(is800KHz) {
   endTime = micros(); // Save EOD time for latch on next call
 }
 
+/*!
+  @brief   Transmit pixel data in RAM to NeoPixels without waiting for the
+           transfer to complete.
+  @note    On RP2040 (PIO fed by DMA) and ESP32 (RMT) the data is copied
+           to a second buffer and sent in the background with interrupts
+           left enabled, so setPixelColor() can prepare the next frame
+           right away without tearing the one being sent. canShow()
+           returns false until the transfer and the latch time are over,
+           and a following show() or showAsync() waits for them. Other
+           devices fall back to the blocking show().
+*/
+void Adafruit_NeoPixel::showAsync(void) {
+#if defined(NEO_ASYNC_SHOW)
+  if (!pixels)
+    return;
+
+  while (!canShow())
+    ;
+
+  if (lut) {
+    if (encodePixels() != txPixels) {
+      show(); // No RAM for the second buffer
+      return;
+    }
+  } else {
+    if (!txPixels && !(txPixels = (uint8_t *)malloc(numBytes))) {
+      show(); // No RAM for the second buffer
+      return;
+    }
+    memcpy(txPixels, pixels, numBytes);
+  }
+
+#if defined(ARDUINO_ARCH_RP2040)
+  if (this->init) {
+    rp2040Init(pin, is800KHz);
+    this->init = false;
+  }
+  if (txDma < 0) {
+    if ((txDma = dma_claim_unused_channel(false)) < 0) {
+      show();
+      return;
+    }
+  }
+  dma_channel_config c = dma_channel_get_default_config(txDma);
+  // 8-bit writes are replicated over the 32-bit bus, which puts each byte
+  // in the top 8 bits of the FIFO word as rp2040Show() does
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+  txBusy = true;
+  dma_channel_configure(txDma, &c, &pio->txf[sm], txPixels, numBytes, true);
+#elif defined(ESP32)
+  if (!(txHandle = espShowAsync(pin, txPixels, numBytes, is800KHz))) {
+    show(); // No free RMT channel or memory
+    return;
+  }
+  txBusy = true;
+#endif
+#else
+  show();
+#endif
+}
+
+#if defined(NEO_ASYNC_SHOW)
+/*!
+  @brief   Check for the end of a showAsync() transfer, release it and
+           start the latch time once it's over. Not a user API.
+  @return  true if no transfer is running anymore.
+*/
+bool Adafruit_NeoPixel::txComplete(void) {
+  if (!txBusy)
+    return true;
+#if defined(ARDUINO_ARCH_RP2040)
+  if (dma_channel_is_busy(txDma) || !pio_sm_is_tx_fifo_empty(pio, sm))
+    return false;
+#elif defined(ESP32)
+  if (!espShowDone(txHandle))
+    return false;
+  txHandle = NULL;
+#endif
+  txBusy = false;
+  endTime = micros(); // The last byte was sent about now
+  return true;
+}
+
+/*!
+  @brief   Wait for a showAsync() transfer to complete. Not a user API.
+*/
+void Adafruit_NeoPixel::txWait(void) {
+  while (!txComplete())
+    ;
+}
+#endif
+
 /*!
   @brief   Set/change the NeoPixel output pin number. Previous pin,
            if any, is set to INPUT and the new pin is set to OUTPUT.
@@ -3322,7 +3439,7 @@ void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint8_t r, uint8_t g,
                                       uint8_t b) {
 
   if (n < numLEDs) {
-    if (brightness) { // See notes in setBrightness()
+    if (brightness && !lut) { // See notes in setBrightness()
       r = (r * brightness) >> 8;
       g = (g * brightness) >> 8;
       b = (b * brightness) >> 8;
@@ -3354,7 +3471,7 @@ void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint8_t r, uint8_t g,
                                       uint8_t b, uint8_t w) {
 
   if (n < numLEDs) {
-    if (brightness) { // See notes in setBrightness()
+    if (brightness && !lut) { // See notes in setBrightness()
       r = (r * brightness) >> 8;
       g = (g * brightness) >> 8;
       b = (b * brightness) >> 8;
@@ -3383,7 +3500,7 @@ void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint8_t r, uint8_t g,
 void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint32_t c) {
   if (n < numLEDs) {
     uint8_t *p, r = (uint8_t)(c >> 16), g = (uint8_t)(c >> 8), b = (uint8_t)c;
-    if (brightness) { // See notes in setBrightness()
+    if (brightness && !lut) { // See notes in setBrightness()
       r = (r * brightness) >> 8;
       g = (g * brightness) >> 8;
       b = (b * brightness) >> 8;
@@ -3393,7 +3510,7 @@ void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint32_t c) {
     } else {
       p = &pixels[n * 4];
       uint8_t w = (uint8_t)(c >> 24);
-      p[wOffset] = brightness ? ((w * brightness) >> 8) : w;
+      p[wOffset] = (brightness && !lut) ? ((w * brightness) >> 8) : w;
     }
     p[rOffset] = r;
     p[gOffset] = g;
@@ -3553,7 +3670,7 @@ uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t n) const {
 
   if (wOffset == rOffset) { // Is RGB-type device
     p = &pixels[n * 3];
-    if (brightness) {
+    if (brightness && !lut) {
       // Stored color was decimated by setBrightness(). Returned value
       // attempts to scale back to an approximation of the original 24-bit
       // value used when setting the pixel color, but there will always be
@@ -3569,7 +3686,7 @@ uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t n) const {
     }
   } else { // Is RGBW-type device
     p = &pixels[n * 4];
-    if (brightness) { // Return scaled color
+    if (brightness && !lut) { // Return scaled color
       return (((uint32_t)(p[wOffset] << 8) / brightness) << 24) |
              (((uint32_t)(p[rOffset] << 8) / brightness) << 16) |
              (((uint32_t)(p[gOffset] << 8) / brightness) << 8) |
@@ -3604,6 +3721,11 @@ void Adafruit_NeoPixel::setBrightness(uint8_t b) {
   // (color values are interpreted literally; no scaling), 1 = min
   // brightness (off), 255 = just below max brightness.
   uint8_t newBrightness = b + 1;
+  if (lut) { // Pixels are kept at full scale, only the LUT changes
+    brightness = newBrightness;
+    updateLUT();
+    return;
+  }
   if (newBrightness != brightness) { // Compare against prior value
     // Brightness has changed -- re-scale existing data in RAM,
     // This process is potentially "lossy," especially when increasing
@@ -3638,6 +3760,56 @@ void Adafruit_NeoPixel::setBrightness(uint8_t b) {
 */
 uint8_t Adafruit_NeoPixel::getBrightness(void) const { return brightness - 1; }
 
+/*!
+  @brief   Apply brightness (and optionally gamma) when the pixels are sent
+           instead of scaling the pixel data in RAM.
+  @param   enable   true to keep the pixels at full scale; brightness and
+                    gamma then go through a combined 256-entry table while
+                    show() copies the data to the output buffer.
+  @param   gammify  true to also apply gamma8() to every color component.
+  @note    setBrightness() becomes lossless and only rebuilds the table, so
+           brightness fades cost nothing more per frame and getPixelColor()
+           returns exactly what was set. The output copy needs a second
+           pixel buffer (shared with showAsync()) plus 256 bytes.
+           Pixel data already in RAM is taken as is, so call this before
+           drawing or while the brightness is still at its default.
+*/
+void Adafruit_NeoPixel::setOutputLUT(bool enable, bool gammify) {
+  if (!enable) {
+    free(lut);
+    lut = NULL;
+    return;
+  }
+  if (!lut && !(lut = (uint8_t *)malloc(256)))
+    return;
+  lutGamma = gammify;
+  updateLUT();
+}
+
+/*!
+  @brief   Rebuild the combined brightness and gamma table. Not a user API.
+*/
+void Adafruit_NeoPixel::updateLUT(void) {
+  for (uint16_t i = 0; i < 256; i++) {
+    uint8_t c = lutGamma ? gamma8(i) : i;
+    lut[i] = brightness ? ((c * brightness) >> 8) : c;
+  }
+}
+
+/*!
+  @brief   Translate the pixels through the brightness/gamma table into
+           the output buffer. Not a user API.
+  @return  Buffer to send: the translated copy, or the raw pixels if the
+           copy can't be allocated.
+*/
+uint8_t *Adafruit_NeoPixel::encodePixels(void) {
+  if (!txPixels && !(txPixels = (uint8_t *)malloc(numBytes)))
+    return pixels;
+  for (uint16_t i = 0; i < numBytes; i++)
+    txPixels[i] = lut[pixels[i]];
+  return txPixels;
+}
+
 /*!
   @brief   Fill the whole NeoPixel strip with 0 / black / off.
 */
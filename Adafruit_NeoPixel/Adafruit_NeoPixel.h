@@ -59,6 +59,11 @@
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
 #include "rp2040_pio.h"
+#include "hardware/dma.h"
+#endif
+
+#if defined(ARDUINO_ARCH_RP2040) || defined(ESP32)
+#define NEO_ASYNC_SHOW ///< showAsync() sends in the background on this device
 #endif
 
 // The order of primary colors in the NeoPixel data stream can vary among
@@ -223,12 +228,14 @@ public:
 
   void begin(void);
   void show(void);
+  void showAsync(void);
   void setPin(int16_t p);
   void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
   void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b, uint8_t w);
   void setPixelColor(uint16_t n, uint32_t c);
   void fill(uint32_t c = 0, uint16_t first = 0, uint16_t count = 0);
   void setBrightness(uint8_t);
+  void setOutputLUT(bool enable, bool gammify = false);
   void clear(void);
   void updateLength(uint16_t n);
   void updateType(neoPixelType t);
@@ -242,10 +249,16 @@ public:
              finishes very quickly, this function could be used to see if
              there's some idle time available for some low-priority
              concurrent task.
+             After showAsync(), this also returns false until the DMA
+             (RP2040) or RMT (ESP32) transfer has completed.
     @return  1 or true if show() will start sending immediately, 0 or false
              if show() would block (meaning some idle time is available).
   */
   bool canShow(void) {
+#if defined(NEO_ASYNC_SHOW)
+    if (txBusy && !txComplete())
+      return false;
+#endif
     // It's normal and possible for endTime to exceed micros() if the
     // 32-bit clock counter has rolled over (about every 70 minutes).
     // Since both are uint32_t, a negative delta correctly maps back to
@@ -378,6 +391,12 @@ private:
   void  rp2040Init(uint8_t pin, bool is800KHz);
   void  rp2040Show(uint8_t pin, uint8_t *pixels, uint32_t numBytes, bool is800KHz);
 #endif
+  void updateLUT(void);
+  uint8_t *encodePixels(void);
+#if defined(NEO_ASYNC_SHOW)
+  bool txComplete(void);
+  void txWait(void);
+#endif
 
 protected:
 #ifdef NEO_KHZ400 // If 400 KHz NeoPixel support enabled...
@@ -406,6 +425,16 @@ protected:
   PIO pio = pio0;
   int sm = 0;
   bool init = true;
+  int txDma = -1;         ///< DMA channel feeding the PIO for showAsync()
+#endif
+#if defined(ESP32)
+  void *txHandle = NULL;  ///< RMT transfer started by showAsync()
+#endif
+  uint8_t *txPixels = NULL; ///< Output copy for showAsync() / setOutputLUT()
+  uint8_t *lut = NULL;      ///< Brightness+gamma table, NULL if not in use
+  bool lutGamma = false;    ///< lut includes gamma8()
+#if defined(NEO_ASYNC_SHOW)
+  volatile bool txBusy = false; ///< showAsync() transfer in progress
 #endif
 };
 
@@ -34,14 +34,13 @@
 
 #ifdef HAS_ESP_IDF_5
 
-void espShow(uint8_t pin, uint8_t *pixels, uint32_t numBytes, boolean is800KHz) {
-  rmt_data_t led_data[numBytes * 8];
-
-  if (!rmtInit(pin, RMT_TX_MODE, RMT_MEM_NUM_BLOCKS_1, 10000000)) {
-    log_e("Failed to init RMT TX mode on pin %d", pin);
-    return;
-  }
+// Transfer started by espShowAsync()
+typedef struct {
+  uint8_t pin;
+  rmt_data_t *led_data;
+} esp_show_async_t;
 
+static void espEncode(rmt_data_t *led_data, uint8_t *pixels, uint32_t numBytes) {
   int i=0;
   for (int b=0; b < numBytes; b++) {
     for (int bit=0; bit<8; bit++){
@@ -59,11 +58,64 @@ void espShow(uint8_t pin, uint8_t *pixels, uint32_t numBytes, boolean is800KHz)
       i++;
     }
   }
+}
+
+void espShow(uint8_t pin, uint8_t *pixels, uint32_t numBytes, boolean is800KHz) {
+  rmt_data_t led_data[numBytes * 8];
+
+  if (!rmtInit(pin, RMT_TX_MODE, RMT_MEM_NUM_BLOCKS_1, 10000000)) {
+    log_e("Failed to init RMT TX mode on pin %d", pin);
+    return;
+  }
+
+  espEncode(led_data, pixels, numBytes);
 
   //pinMode(pin, OUTPUT);  // don't do this, will cause the rmt to disable!
   rmtWrite(pin, led_data, numBytes * 8, RMT_WAIT_FOR_EVER);
 }
 
+// Start sending without waiting, returns NULL if the transfer couldn't start
+void *espShowAsync(uint8_t pin, uint8_t *pixels, uint32_t numBytes, boolean is800KHz) {
+  esp_show_async_t *handle = (esp_show_async_t *)malloc(sizeof(esp_show_async_t));
+  if (!handle) {
+    return NULL;
+  }
+  // RMT symbols must stay valid for the whole transfer
+  handle->led_data = (rmt_data_t *)malloc(numBytes * 8 * sizeof(rmt_data_t));
+  if (!handle->led_data) {
+    free(handle);
+    return NULL;
+  }
+  handle->pin = pin;
+
+  if (!rmtInit(pin, RMT_TX_MODE, RMT_MEM_NUM_BLOCKS_1, 10000000)) {
+    log_e("Failed to init RMT TX mode on pin %d", pin);
+    free(handle->led_data);
+    free(handle);
+    return NULL;
+  }
+
+  espEncode(handle->led_data, pixels, numBytes);
+
+  if (!rmtWriteAsync(pin, handle->led_data, numBytes * 8)) {
+    free(handle->led_data);
+    free(handle);
+    return NULL;
+  }
+  return handle;
+}
+
+// True once the transfer is over, the handle is released then
+bool espShowDone(void *h) {
+  esp_show_async_t *handle = (esp_show_async_t *)h;
+  if (!rmtTransmitCompleted(handle->pin)) {
+    return false;
+  }
+  free(handle->led_data);
+  free(handle);
+  return true;
+}
+
 
 
 #else
@@ -131,7 +183,16 @@ static void IRAM_ATTR ws2812_rmt_adapter(const void *src, rmt_item32_t *dest, si
     *item_num = num;
 }
 
-void espShow(uint8_t pin, uint8_t *pixels, uint32_t numBytes, boolean is800KHz) {
+// Transfer started by espShowAsync()
+typedef struct {
+    uint8_t pin;
+    rmt_channel_t channel;
+} esp_show_async_t;
+
+// Reserve a channel and start sending, returns ADAFRUIT_RMT_CHANNEL_MAX if no
+// channel is free. The pixels are translated from the RMT interrupt, they must
+// stay valid until the transfer is over.
+static rmt_channel_t espStart(uint8_t pin, uint8_t *pixels, uint32_t numBytes, boolean is800KHz) {
     // Reserve channel
     rmt_channel_t channel = ADAFRUIT_RMT_CHANNEL_MAX;
     for (size_t i = 0; i < ADAFRUIT_RMT_CHANNEL_MAX; i++) {
@@ -143,7 +204,7 @@ void espShow(uint8_t pin, uint8_t *pixels, uint32_t numBytes, boolean is800KHz)
     }
     if (channel == ADAFRUIT_RMT_CHANNEL_MAX) {
         // Ran out of channels!
-        return;
+        return channel;
     }
 
 #if defined(HAS_ESP_IDF_4)
@@ -205,19 +266,62 @@ void espShow(uint8_t pin, uint8_t *pixels, uint32_t numBytes, boolean is800KHz)
     }
 
     // Initialize automatic timing translator
+    // (the tick values are shared, async strips running at the same time
+    // must use the same speed)
     rmt_translator_init(config.channel, ws2812_rmt_adapter);
 
-    // Write and wait to finish
-    rmt_write_sample(config.channel, pixels, (size_t)numBytes, true);
-    rmt_wait_tx_done(config.channel, pdMS_TO_TICKS(100));
+    // Write without waiting
+    rmt_write_sample(config.channel, pixels, (size_t)numBytes, false);
+
+    return channel;
+}
 
+static void espRelease(uint8_t pin, rmt_channel_t channel) {
     // Free channel again
-    rmt_driver_uninstall(config.channel);
+    rmt_driver_uninstall(channel);
     rmt_reserved_channels[channel] = false;
 
     gpio_set_direction(pin, GPIO_MODE_OUTPUT);
 }
 
+void espShow(uint8_t pin, uint8_t *pixels, uint32_t numBytes, boolean is800KHz) {
+    rmt_channel_t channel = espStart(pin, pixels, numBytes, is800KHz);
+    if (channel == ADAFRUIT_RMT_CHANNEL_MAX) {
+        return;
+    }
+
+    // Wait to finish
+    rmt_wait_tx_done(channel, pdMS_TO_TICKS(100));
+
+    espRelease(pin, channel);
+}
+
+// Start sending without waiting, returns NULL if the transfer couldn't start
+void *espShowAsync(uint8_t pin, uint8_t *pixels, uint32_t numBytes, boolean is800KHz) {
+    esp_show_async_t *handle = (esp_show_async_t *)malloc(sizeof(esp_show_async_t));
+    if (!handle) {
+        return NULL;
+    }
+    handle->pin = pin;
+    handle->channel = espStart(pin, pixels, numBytes, is800KHz);
+    if (handle->channel == ADAFRUIT_RMT_CHANNEL_MAX) {
+        free(handle);
+        return NULL;
+    }
+    return handle;
+}
+
+// True once the transfer is over, the channel is released then
+bool espShowDone(void *h) {
+    esp_show_async_t *handle = (esp_show_async_t *)h;
+    if (rmt_wait_tx_done(handle->channel, 0) != ESP_OK) {
+        return false;
+    }
+    espRelease(handle->pin, handle->channel);
+    free(handle);
+    return true;
+}
+
 #endif // ifndef IDF5
  
 
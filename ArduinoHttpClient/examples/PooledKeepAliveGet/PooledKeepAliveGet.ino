@@ -0,0 +1,75 @@
+/*
+  Pooled keep-alive GET client for ArduinoHttpClient library
+  Polls two paths on the same server once a second.  The requests share
+  one kept-alive connection from a pool and are pipelined, so the server
+  is only connected to once rather than for every request.
+
+  this example is in the public domain
+ */
+#include <ArduinoHttpClient.h>
+#include <WiFi101.h>
+
+#include "arduino_secrets.h"
+
+///////please enter your sensitive data in the Secret tab/arduino_secrets.h
+/////// WiFi Settings ///////
+char ssid[] = SECRET_SSID;
+char pass[] = SECRET_PASS;
+
+char serverAddress[] = "192.168.0.3";  // server address
+int port = 8080;
+
+WiFiClient wifi;
+HttpConnectionPool pool;
+int status = WL_IDLE_STATUS;
+
+void setup() {
+  Serial.begin(9600);
+  while ( status != WL_CONNECTED) {
+    Serial.print("Attempting to connect to Network named: ");
+    Serial.println(ssid);                   // print the network name (SSID);
+
+    // Connect to WPA/WPA2 network:
+    status = WiFi.begin(ssid, pass);
+  }
+
+  // print the SSID of the network you're attached to:
+  Serial.print("SSID: ");
+  Serial.println(WiFi.SSID());
+
+  // give the pool the client it can use
+  pool.addClient(wifi);
+}
+
+void printResponse(HttpClient& client) {
+  int statusCode = client.responseStatusCode();
+  String response = client.responseBody();
+
+  Serial.print("Status code: ");
+  Serial.println(statusCode);
+  Serial.print("Response: ");
+  Serial.println(response);
+}
+
+void loop() {
+  // close the connection if it has been idle for too long
+  pool.poll();
+
+  {
+    // the connection goes back to the pool when client goes out of scope
+    HttpClient client(pool, serverAddress, port);
+
+    Serial.println("making pipelined GET requests");
+    client.pipelineGet("/");
+    client.pipelineGet("/status");
+
+    // responses arrive in the order the requests were sent
+    printResponse(client);
+    if (client.nextResponse() == HTTP_SUCCESS) {
+      printResponse(client);
+    }
+  }
+
+  Serial.println("Wait one second");
+  delay(1000);
+}
@@ -6,6 +6,7 @@
 #define ArduinoHttpClient_h
 
 #include "HttpClient.h"
+#include "HttpConnectionPool.h"
 #include "WebSocketClient.h"
 #include "URLEncoder.h"
 
@@ -11,7 +11,7 @@ const char* HttpClient::kContentLengthPrefix = HTTP_HEADER_CONTENT_LENGTH ": ";
 const char* HttpClient::kTransferEncodingChunked = HTTP_HEADER_TRANSFER_ENCODING ": " HTTP_HEADER_VALUE_CHUNKED;
 
 HttpClient::HttpClient(Client& aClient, const char* aServerName, uint16_t aServerPort)
- : iClient(&aClient), iServerName(aServerName), iServerAddress(), iServerPort(aServerPort),
+ : iClient(&aClient), iPool(NULL), iServerName(aServerName), iServerAddress(), iServerPort(aServerPort),
    iConnectionClose(true), iSendDefaultRequestHeaders(true)
 {
   resetState();
@@ -23,15 +23,54 @@ HttpClient::HttpClient(Client& aClient, const String& aServerName, uint16_t aSer
 }
 
 HttpClient::HttpClient(Client& aClient, const IPAddress& aServerAddress, uint16_t aServerPort)
- : iClient(&aClient), iServerName(NULL), iServerAddress(aServerAddress), iServerPort(aServerPort),
+ : iClient(&aClient), iPool(NULL), iServerName(NULL), iServerAddress(aServerAddress), iServerPort(aServerPort),
    iConnectionClose(true), iSendDefaultRequestHeaders(true)
 {
   resetState();
 }
 
+HttpClient::HttpClient(HttpConnectionPool& aPool, const char* aServerName, uint16_t aServerPort)
+ : iClient(NULL), iPool(&aPool), iServerName(aServerName), iServerAddress(), iServerPort(aServerPort),
+   iConnectionClose(false), iSendDefaultRequestHeaders(true)
+{
+  resetState();
+}
+
+HttpClient::HttpClient(HttpConnectionPool& aPool, const String& aServerName, uint16_t aServerPort)
+ : HttpClient(aPool, aServerName.c_str(), aServerPort)
+{
+}
+
+HttpClient::HttpClient(HttpConnectionPool& aPool, const IPAddress& aServerAddress, uint16_t aServerPort)
+ : iClient(NULL), iPool(&aPool), iServerName(NULL), iServerAddress(aServerAddress), iServerPort(aServerPort),
+   iConnectionClose(false), iSendDefaultRequestHeaders(true)
+{
+  resetState();
+}
+
+HttpClient::~HttpClient()
+{
+  if (iPool && iClient)
+  {
+    // Only hand back a connection that is between responses, anything else
+    // would leave data for the next user to trip over
+    bool reusable = !iConnectionClose && (iPendingResponses == 0) &&
+                    ((iState == eIdle) || (endOfHeadersReached() && endOfBodyReached()));
+    iPool->release(iClient, reusable);
+  }
+}
+
 void HttpClient::resetState()
 {
   iState = eIdle;
+  iPendingResponses = 0;
+  resetResponseState();
+  iHttpResponseTimeout = kHttpResponseTimeout;
+  iHttpWaitForDataDelay = kHttpWaitForDataDelay;
+}
+
+void HttpClient::resetResponseState()
+{
   iStatusCode = 0;
   iContentLength = kNoContentLengthHeader;
   iBodyLengthConsumed = 0;
@@ -39,13 +78,15 @@ void HttpClient::resetState()
   iTransferEncodingChunkedPtr = kTransferEncodingChunked;
   iIsChunked = false;
   iChunkLength = 0;
-  iHttpResponseTimeout = kHttpResponseTimeout;
-  iHttpWaitForDataDelay = kHttpWaitForDataDelay;
+  iChunkLengthDigits = false;
 }
 
 void HttpClient::stop()
 {
-  iClient->stop();
+  if (iClient)
+  {
+    iClient->stop();
+  }
   resetState();
 }
 
@@ -67,7 +108,13 @@ void HttpClient::beginRequest()
 int HttpClient::startRequest(const char* aURLPath, const char* aHttpMethod, 
                                 const char* aContentType, int aContentLength, const byte aBody[])
 {
-    if (iState == eReadingBody || iState == eReadingChunkLength || iState == eReadingBodyChunk)
+    if (iPendingResponses > 0)
+    {
+        // Flushing would throw away the responses to the pipelined requests
+        return HTTP_ERROR_API;
+    }
+
+    if (endOfHeadersReached())
     {
         flushClientRx();
 
@@ -81,6 +128,19 @@ int HttpClient::startRequest(const char* aURLPath, const char* aHttpMethod,
         return HTTP_ERROR_API;
     }
 
+    if (!iClient)
+    {
+        iClient = iServerName ? iPool->acquire(iServerName, iServerPort)
+                              : iPool->acquire(iServerAddress, iServerPort);
+        if (!iClient)
+        {
+#ifdef LOGGING
+            Serial.println("No free connection in pool");
+#endif
+            return HTTP_ERROR_CONNECTION_FAILED;
+        }
+    }
+
     if (iConnectionClose || !iClient->connected())
     {
         if (iServerName)
@@ -292,6 +352,122 @@ int HttpClient::get(const String& aURLPath)
     return get(aURLPath.c_str());
 }
 
+int HttpClient::pipelineGet(const char* aURLPath)
+{
+    if (iConnectionClose)
+    {
+        // The server would close the connection after the first response
+        return HTTP_ERROR_API;
+    }
+
+    if (eIdle == iState)
+    {
+        // Nothing in flight yet, so this is just a normal request
+        return startRequest(aURLPath, HTTP_METHOD_GET);
+    }
+
+    if (iState < eRequestSent)
+    {
+        // We're part way through building another request
+        return HTTP_ERROR_API;
+    }
+
+    if (!iClient->connected())
+    {
+        return HTTP_ERROR_CONNECTION_FAILED;
+    }
+
+    // Send the whole request, but leave the parsing state alone as we're
+    // still reading the response to an earlier one
+    tHttpState state = iState;
+    sendInitialHeaders(aURLPath, HTTP_METHOD_GET);
+    finishHeaders();
+    iState = state;
+    iPendingResponses++;
+    return HTTP_SUCCESS;
+}
+
+int HttpClient::pipelineGet(const String& aURLPath)
+{
+    return pipelineGet(aURLPath.c_str());
+}
+
+int HttpClient::nextResponse()
+{
+    if (iPendingResponses == 0)
+    {
+        return HTTP_ERROR_API;
+    }
+
+    int ret = skipResponse();
+    if (HTTP_SUCCESS != ret)
+    {
+        // We can't tell where the next response starts any more, so the
+        // rest of the pipeline is lost
+        stop();
+        return ret;
+    }
+
+    resetResponseState();
+    iState = eRequestSent;
+    iPendingResponses--;
+    return HTTP_SUCCESS;
+}
+
+int HttpClient::skipResponse()
+{
+    int ret;
+
+    if (eRequestSent == iState)
+    {
+        ret = responseStatusCode();
+        if (ret < 0)
+        {
+            return ret;
+        }
+    }
+
+    if (!endOfHeadersReached())
+    {
+        ret = skipResponseHeaders();
+        if (HTTP_SUCCESS != ret)
+        {
+            return ret;
+        }
+    }
+
+    if (!iIsChunked && (iContentLength == kNoContentLengthHeader))
+    {
+        if (iStatusCode == 204 || iStatusCode == 304)
+        {
+            // These never have a body
+            return HTTP_SUCCESS;
+        }
+        // The body runs until the server closes the connection
+        return HTTP_ERROR_INVALID_RESPONSE;
+    }
+
+    unsigned long timeoutStart = millis();
+    while (!endOfBodyReached() &&
+           ( (millis() - timeoutStart) < iHttpResponseTimeout ))
+    {
+        if (iClient->available())
+        {
+            // available() also works through the chunk-size lines
+            if (available())
+            {
+                (void)HttpClient::read();
+            }
+            timeoutStart = millis();
+        }
+        else
+        {
+            delay(iHttpWaitForDataDelay);
+        }
+    }
+    return endOfBodyReached() ? HTTP_SUCCESS : HTTP_ERROR_TIMED_OUT;
+}
+
 int HttpClient::post(const char* aURLPath)
 {
     return startRequest(aURLPath, HTTP_METHOD_POST);
@@ -540,7 +716,8 @@ int HttpClient::skipResponseHeaders()
 
 bool HttpClient::endOfHeadersReached()
 {
-    return (iState == eReadingBody || iState == eReadingChunkLength || iState == eReadingBodyChunk);
+    return (iState == eReadingBody || iState == eReadingChunkLength || iState == eReadingBodyChunk ||
+            iState == eReadingChunkTrailer || iState == eChunkedBodyRead);
 };
 
 long HttpClient::contentLength()
@@ -568,23 +745,33 @@ String HttpClient::responseBody()
         }
     }
 
-    // keep on timedRead'ing, until:
+    // keep on reading blocks, until:
     //  - we have a content length: body length equals consumed or no bytes
-    //                              available
-    //  - no content length:        no bytes are available
-    while (iBodyLengthConsumed != bodyLength)
+    //                              available within the timeout
+    //  - chunked:                  the last chunk has been read
+    //  - no content length:        no bytes are available within the timeout
+    uint8_t buf[64];
+    unsigned long timeoutStart = millis();
+    while ((iBodyLengthConsumed != bodyLength) && !endOfBodyReached())
     {
-        int c = timedRead();
+        int n = read(buf, sizeof(buf));
 
-        if (c == -1) {
-            // read timed out, done
-            break;
+        if (n <= 0) {
+            if ((millis() - timeoutStart) >= _timeout) {
+                // read timed out, done
+                break;
+            }
+            yield();
+            continue;
         }
 
-        if (!response.concat((char)c)) {
-            // adding char failed
-            return String((const char*)NULL);
+        for (int i = 0; i < n; i++) {
+            if (!response.concat((char)buf[i])) {
+                // adding char failed
+                return String((const char*)NULL);
+            }
         }
+        timeoutStart = millis();
     }
 
     if (bodyLength > 0 && (unsigned int)bodyLength != response.length()) {
@@ -597,6 +784,11 @@ String HttpClient::responseBody()
 
 bool HttpClient::endOfBodyReached()
 {
+    if (iState == eChunkedBodyRead)
+    {
+        // We've seen the last chunk and the trailer after it
+        return true;
+    }
     if (endOfHeadersReached() && (contentLength() != kNoContentLengthHeader))
     {
         // We've got to the body and we know how long it will be
@@ -615,7 +807,16 @@ int HttpClient::available()
 
             if (c == '\n')
             {
-                iState = eReadingBodyChunk;
+                if (iChunkLengthDigits && iChunkLength == 0)
+                {
+                    // A chunk-size of 0 marks the last chunk
+                    iState = eReadingChunkTrailer;
+                }
+                else
+                {
+                    iState = eReadingBodyChunk;
+                }
+                iChunkLengthDigits = false;
                 break;
             }
             else if (c == '\r')
@@ -627,6 +828,31 @@ int HttpClient::available()
                 char digit[2] = {c, '\0'};
 
                 iChunkLength = (iChunkLength * 16) + strtol(digit, NULL, 16);
+                iChunkLengthDigits = true;
+            }
+        }
+    }
+
+    if (iState == eReadingChunkTrailer)
+    {
+        // Skip any trailer headers, up to the empty line that ends the body.
+        // iChunkLength counts the characters on the current line
+        while (iClient->available())
+        {
+            char c = iClient->read();
+
+            if (c == '\n')
+            {
+                if (iChunkLength == 0)
+                {
+                    iState = eChunkedBodyRead;
+                    break;
+                }
+                iChunkLength = 0;
+            }
+            else if (c != '\r')
+            {
+                iChunkLength++;
             }
         }
     }
@@ -636,7 +862,7 @@ int HttpClient::available()
         iState = eReadingChunkLength;
     }
     
-    if (iState == eReadingChunkLength)
+    if (iState == eReadingChunkLength || iState == eReadingChunkTrailer || iState == eChunkedBodyRead)
     {
         return 0;
     }
@@ -748,8 +974,64 @@ String HttpClient::readHeaderValue()
 
 int HttpClient::read(uint8_t *buf, size_t size)
 {
-    int ret =iClient->read(buf, size);
-    if (endOfHeadersReached() && iContentLength > 0)
+    if (!endOfHeadersReached())
+    {
+        // Not in the body yet, so just hand over whatever is there
+        return iClient->read(buf, size);
+    }
+
+    if (iIsChunked)
+    {
+        // Copy whole runs of chunk data at a time, only dropping back to
+        // byte by byte parsing for the chunk-size lines in between
+        size_t total = 0;
+        while (total < size)
+        {
+            int chunkAvailable = available();
+            if (chunkAvailable <= 0)
+            {
+                if ((iState == eReadingChunkLength) && iClient->available())
+                {
+                    // available() only got through the CRLF after a chunk,
+                    // the next chunk-size line is still waiting
+                    continue;
+                }
+                break;
+            }
+
+            size_t toRead = min((size_t)chunkAvailable, size - total);
+            int ret = iClient->read(buf + total, toRead);
+            if (ret <= 0)
+            {
+                break;
+            }
+            total += ret;
+            iChunkLength -= ret;
+            if (iChunkLength == 0)
+            {
+                iState = eReadingChunkLength;
+            }
+        }
+        return (total > 0) ? (int)total : -1;
+    }
+
+    if (iContentLength > 0)
+    {
+        // Don't read past the end of the body, anything after it belongs to
+        // the next response on this connection
+        long remaining = iContentLength - iBodyLengthConsumed;
+        if (remaining <= 0)
+        {
+            return -1;
+        }
+        if ((long)size > remaining)
+        {
+            size = remaining;
+        }
+    }
+
+    int ret = iClient->read(buf, size);
+    if (iContentLength > 0)
     {
         // We're outputting the body now and we've seen a Content-Length header
         // So keep track of how many bytes are left
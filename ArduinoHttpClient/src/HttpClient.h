@@ -8,6 +8,7 @@
 #include <Arduino.h>
 #include <IPAddress.h>
 #include "Client.h"
+#include "HttpConnectionPool.h"
 
 static const int HTTP_SUCCESS =0;
 // The end of the headers has been reached.  This consumes the '\n'
@@ -53,6 +54,16 @@ public:
     HttpClient(Client& aClient, const String& aServerName, uint16_t aServerPort = kHttpPort);
     HttpClient(Client& aClient, const IPAddress& aServerAddress, uint16_t aServerPort = kHttpPort);
 
+    /** Use a connection from a shared pool rather than a dedicated client.
+        The connection is taken from the pool at the first request, kept
+        alive, and handed back when this object is destroyed.  Short-lived
+        HttpClient objects for the same server then reuse one connection.
+    */
+    HttpClient(HttpConnectionPool& aPool, const char* aServerName, uint16_t aServerPort = kHttpPort);
+    HttpClient(HttpConnectionPool& aPool, const String& aServerName, uint16_t aServerPort = kHttpPort);
+    HttpClient(HttpConnectionPool& aPool, const IPAddress& aServerAddress, uint16_t aServerPort = kHttpPort);
+    virtual ~HttpClient();
+
     /** Start a more complex request.
         Use this when you need to send additional headers in the request,
         but you will also need to call endRequest() when you are finished.
@@ -79,6 +90,27 @@ public:
     int get(const char* aURLPath);
     int get(const String& aURLPath);
 
+    /** Send a GET request without waiting for the responses to the earlier
+      ones (HTTP pipelining).  Needs connectionKeepAlive().
+      Responses come back in the order the requests were sent; read the first
+      one as usual, then call nextResponse() to move on to the next one.
+      @param aURLPath     Url to request
+      @return 0 if successful, else error
+    */
+    int pipelineGet(const char* aURLPath);
+    int pipelineGet(const String& aURLPath);
+
+    /** Skip whatever is left of the current response and start reading the
+      response to the next pipelined request.  Call responseStatusCode() next.
+      @return 0 if successful, else error
+    */
+    int nextResponse();
+
+    /** Return the number of pipelined requests whose responses come after
+      the one currently being read
+    */
+    int pendingResponses() { return iPendingResponses; }
+
     /** Connect to the server and start to send a POST request.
       @param aURLPath     Url to request
       @return 0 if successful, else error
@@ -306,6 +338,11 @@ public:
       @return Byte read or -1 if there are no bytes available.
     */
     virtual int read();
+    /** Read up to size bytes from the server.
+      In the body this copies straight from the Client in blocks, decoding
+      chunked bodies as it goes and stopping at the end of the body.
+      @return Number of bytes read, or -1 if there are no bytes available.
+    */
     virtual int read(uint8_t *buf, size_t size);
     virtual int peek() { return iClient->peek(); };
     virtual void flush() { iClient->flush(); };
@@ -314,8 +351,8 @@ public:
     virtual int connect(IPAddress ip, uint16_t port) { return iClient->connect(ip, port); };
     virtual int connect(const char *host, uint16_t port) { return iClient->connect(host, port); };
     virtual void stop();
-    virtual uint8_t connected() { return iClient->connected(); };
-    virtual operator bool() { return bool(iClient); };
+    virtual uint8_t connected() { return iClient ? iClient->connected() : 0; };
+    virtual operator bool() { return iClient ? bool(*iClient) : false; };
     virtual uint32_t httpResponseTimeout() { return iHttpResponseTimeout; };
     virtual void setHttpResponseTimeout(uint32_t timeout) { iHttpResponseTimeout = timeout; };
     virtual uint32_t httpWaitForDataDelay() { return iHttpWaitForDataDelay; };
@@ -325,6 +362,15 @@ protected:
     */
     void resetState();
 
+    /** Reset the response parsing state, ready for the next response
+    */
+    void resetResponseState();
+
+    /** Read and discard the rest of the current response
+      @return HTTP_SUCCESS if successful, else an error code
+    */
+    int skipResponse();
+
     /** Send the first part of the request and the initial headers.
       @param aURLPath	Url to request
       @param aHttpMethod  Type of HTTP request to make, e.g. "GET", "POST", etc.
@@ -361,10 +407,14 @@ protected:
         eLineStartingCRFound,
         eReadingBody,
         eReadingChunkLength,
-        eReadingBodyChunk
+        eReadingBodyChunk,
+        eReadingChunkTrailer,
+        eChunkedBodyRead
     } tHttpState;
     // Client we're using
     Client* iClient;
+    // Pool iClient was taken from, if any
+    HttpConnectionPool* iPool;
     // Server we are connecting to
     const char* iServerName;
     IPAddress iServerAddress;
@@ -386,6 +436,10 @@ protected:
     bool iIsChunked;
     // Stores the value of the current chunk length, if present
     int iChunkLength;
+    // Stores if the current chunk-size line had any digits
+    bool iChunkLengthDigits;
+    // Number of pipelined requests sent after the one being read
+    int iPendingResponses;
     uint32_t iHttpResponseTimeout;
     uint32_t iHttpWaitForDataDelay;
     bool iConnectionClose;
@@ -0,0 +1,148 @@
+// Pool of keep-alive connections shared between HttpClient objects
+// (c) Copyright Arduino. 2016
+// Released under Apache License, version 2.0
+
+#include "HttpConnectionPool.h"
+
+HttpConnectionPool::HttpConnectionPool(uint32_t aIdleTimeout)
+ : iEntryCount(0), iIdleTimeout(aIdleTimeout)
+{
+}
+
+bool HttpConnectionPool::addClient(Client& aClient)
+{
+    if (iEntryCount >= HTTP_CONNECTION_POOL_SIZE)
+    {
+        return false;
+    }
+
+    tPoolEntry& entry = iEntries[iEntryCount++];
+    entry.client = &aClient;
+    entry.serverName = "";
+    entry.serverAddress = IPAddress();
+    entry.serverPort = 0;
+    entry.lastUsed = 0;
+    entry.inUse = false;
+    return true;
+}
+
+Client* HttpConnectionPool::acquire(const char* aServerName, uint16_t aServerPort)
+{
+    return acquire(aServerName, IPAddress(), aServerPort);
+}
+
+Client* HttpConnectionPool::acquire(const IPAddress& aServerAddress, uint16_t aServerPort)
+{
+    return acquire(NULL, aServerAddress, aServerPort);
+}
+
+bool HttpConnectionPool::matches(const tPoolEntry& aEntry, const char* aServerName, const IPAddress& aServerAddress, uint16_t aServerPort)
+{
+    if (aEntry.serverPort != aServerPort)
+    {
+        return false;
+    }
+    if (aServerName)
+    {
+        return aEntry.serverName.equalsIgnoreCase(aServerName);
+    }
+    return (aEntry.serverName.length() == 0) && (aEntry.serverAddress == aServerAddress);
+}
+
+Client* HttpConnectionPool::acquire(const char* aServerName, const IPAddress& aServerAddress, uint16_t aServerPort)
+{
+    tPoolEntry* freeEntry = NULL;
+    unsigned long now = millis();
+
+    for (uint8_t i = 0; i < iEntryCount; i++)
+    {
+        tPoolEntry& entry = iEntries[i];
+        if (entry.inUse)
+        {
+            continue;
+        }
+        if (matches(entry, aServerName, aServerAddress, aServerPort) && entry.client->connected())
+        {
+            // Idle connection to the same server, hand it out as it is
+#ifdef LOGGING
+            Serial.println("Reusing pooled connection");
+#endif
+            entry.inUse = true;
+            return entry.client;
+        }
+        // Otherwise prefer a client that isn't connected, then the one that
+        // has been idle for the longest
+        if (!freeEntry)
+        {
+            freeEntry = &entry;
+        }
+        else if (freeEntry->client->connected())
+        {
+            if (!entry.client->connected() ||
+                ((now - entry.lastUsed) > (now - freeEntry->lastUsed)))
+            {
+                freeEntry = &entry;
+            }
+        }
+    }
+
+    if (!freeEntry)
+    {
+        return NULL;
+    }
+
+    if (freeEntry->client->connected())
+    {
+        // Connected to some other server, close it to make room
+        freeEntry->client->stop();
+    }
+    freeEntry->serverName = aServerName ? aServerName : "";
+    freeEntry->serverAddress = aServerAddress;
+    freeEntry->serverPort = aServerPort;
+    freeEntry->inUse = true;
+    return freeEntry->client;
+}
+
+void HttpConnectionPool::release(Client* aClient, bool aReusable)
+{
+    for (uint8_t i = 0; i < iEntryCount; i++)
+    {
+        tPoolEntry& entry = iEntries[i];
+        if (entry.client == aClient)
+        {
+            if (!aReusable)
+            {
+                entry.client->stop();
+            }
+            entry.lastUsed = millis();
+            entry.inUse = false;
+            return;
+        }
+    }
+}
+
+void HttpConnectionPool::poll()
+{
+    unsigned long now = millis();
+
+    for (uint8_t i = 0; i < iEntryCount; i++)
+    {
+        tPoolEntry& entry = iEntries[i];
+        if (!entry.inUse && ((now - entry.lastUsed) >= iIdleTimeout) && entry.client->connected())
+        {
+            entry.client->stop();
+        }
+    }
+}
+
+void HttpConnectionPool::closeIdle()
+{
+    for (uint8_t i = 0; i < iEntryCount; i++)
+    {
+        tPoolEntry& entry = iEntries[i];
+        if (!entry.inUse)
+        {
+            entry.client->stop();
+        }
+    }
+}
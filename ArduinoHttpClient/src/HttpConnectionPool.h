@@ -0,0 +1,84 @@
+// Pool of keep-alive connections shared between HttpClient objects
+// (c) Copyright Arduino. 2016
+// Released under Apache License, version 2.0
+
+#ifndef HttpConnectionPool_h
+#define HttpConnectionPool_h
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include "Client.h"
+
+// Maximum number of transport clients a pool can hold
+#ifndef HTTP_CONNECTION_POOL_SIZE
+#define HTTP_CONNECTION_POOL_SIZE 4
+#endif
+
+class HttpConnectionPool
+{
+public:
+    // Close idle connections that have not been used for this long, in ms
+    static const uint32_t kDefaultIdleTimeout = 30*1000;
+
+    HttpConnectionPool(uint32_t aIdleTimeout = kDefaultIdleTimeout);
+
+    /** Give the pool a transport client it may hand out.
+      The client must outlive the pool.  For TLS pass a secure client, so that
+      a reused connection also saves the handshake.
+      @param aClient  Client to add
+      @return true if successful, false if the pool is full
+    */
+    bool addClient(Client& aClient);
+
+    /** Take a client for the given server.
+      An idle client that is still connected to the same server is preferred.
+      Otherwise a free client is handed out unconnected (closing its previous
+      connection if needed), and the caller connects it.
+      @param aServerName  Name of the server
+      @param aServerPort  Port of the server
+      @return Client to use, or NULL if all clients are in use
+    */
+    Client* acquire(const char* aServerName, uint16_t aServerPort);
+    Client* acquire(const IPAddress& aServerAddress, uint16_t aServerPort);
+
+    /** Hand a client back to the pool.
+      @param aClient  Client returned by acquire()
+      @param aReusable  true if the connection is idle and can take another
+                        request, false to close it
+    */
+    void release(Client* aClient, bool aReusable);
+
+    /** Close idle connections that have passed the idle timeout.
+      Call this from loop(); servers drop idle keep-alive connections on their
+      own timeout, so it's better to close them here first.
+    */
+    void poll();
+
+    /** Close all connections that aren't in use
+    */
+    void closeIdle();
+
+    uint32_t idleTimeout() { return iIdleTimeout; };
+    void setIdleTimeout(uint32_t aIdleTimeout) { iIdleTimeout = aIdleTimeout; };
+
+protected:
+    typedef struct {
+        Client* client;
+        // Server the client is (or was last) connected to
+        String serverName;
+        IPAddress serverAddress;
+        uint16_t serverPort;
+        // millis() when the client was last handed back
+        unsigned long lastUsed;
+        bool inUse;
+    } tPoolEntry;
+
+    Client* acquire(const char* aServerName, const IPAddress& aServerAddress, uint16_t aServerPort);
+    bool matches(const tPoolEntry& aEntry, const char* aServerName, const IPAddress& aServerAddress, uint16_t aServerPort);
+
+    tPoolEntry iEntries[HTTP_CONNECTION_POOL_SIZE];
+    uint8_t iEntryCount;
+    uint32_t iIdleTimeout;
+};
+
+#endif
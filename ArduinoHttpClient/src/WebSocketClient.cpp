@@ -8,6 +8,8 @@
 WebSocketClient::WebSocketClient(Client& aClient, const char* aServerName, uint16_t aServerPort)
  : HttpClient(aClient, aServerName, aServerPort),
    iTxStarted(false),
+   iTxBatching(false),
+   iTxBatchLength(0),
    iRxSize(0)
 {
 }
@@ -15,6 +17,8 @@ WebSocketClient::WebSocketClient(Client& aClient, const char* aServerName, uint1
 WebSocketClient::WebSocketClient(Client& aClient, const String& aServerName, uint16_t aServerPort) 
  : HttpClient(aClient, aServerName, aServerPort),
    iTxStarted(false),
+   iTxBatching(false),
+   iTxBatchLength(0),
    iRxSize(0)
 {
 }
@@ -22,6 +26,8 @@ WebSocketClient::WebSocketClient(Client& aClient, const String& aServerName, uin
 WebSocketClient::WebSocketClient(Client& aClient, const IPAddress& aServerAddress, uint16_t aServerPort)
  : HttpClient(aClient, aServerAddress, aServerPort),
    iTxStarted(false),
+   iTxBatching(false),
+   iTxBatchLength(0),
    iRxSize(0)
 {
 }
@@ -95,54 +101,148 @@ int WebSocketClient::endMessage()
         return 1;
     }
 
+    uint8_t header[kMaxFrameHeaderSize];
+    int headerSize = 0;
+
     // send FIN + the message type (opcode)
-    HttpClient::write(0x80 | iTxMessageType);
+    header[headerSize++] = 0x80 | iTxMessageType;
 
     // the message is masked (0x80)
     // send the length
     if (iTxSize < 126)
     {
-        HttpClient::write(0x80 | (uint8_t)iTxSize);
+        header[headerSize++] = 0x80 | (uint8_t)iTxSize;
     }
     else if (iTxSize < 0xffff)
     {
-        HttpClient::write(0x80 | 126);
-        HttpClient::write((iTxSize >> 8) & 0xff);
-        HttpClient::write((iTxSize >> 0) & 0xff);
+        header[headerSize++] = 0x80 | 126;
+        header[headerSize++] = (iTxSize >> 8) & 0xff;
+        header[headerSize++] = (iTxSize >> 0) & 0xff;
     }
     else
     {
-        HttpClient::write(0x80 | 127);
-        HttpClient::write((iTxSize >> 56) & 0xff);
-        HttpClient::write((iTxSize >> 48) & 0xff);
-        HttpClient::write((iTxSize >> 40) & 0xff);
-        HttpClient::write((iTxSize >> 32) & 0xff);
-        HttpClient::write((iTxSize >> 24) & 0xff);
-        HttpClient::write((iTxSize >> 16) & 0xff);
-        HttpClient::write((iTxSize >> 8) & 0xff);
-        HttpClient::write((iTxSize >> 0) & 0xff);
+        header[headerSize++] = 0x80 | 127;
+        for (int shift = 56; shift >= 0; shift -= 8)
+        {
+            header[headerSize++] = (iTxSize >> shift) & 0xff;
+        }
     }
 
-    uint8_t maskKey[4];
-
     // create a random mask for the data and send
-    for (int i = 0; i < (int)sizeof(maskKey); i++)
+    uint8_t* maskKey = header + headerSize;
+    for (int i = 0; i < 4; i++)
     {
         maskKey[i] = random(0xff);
     }
-    HttpClient::write(maskKey, sizeof(maskKey));
-
-    // mask the data and send
-    for (int i = 0; i < (int)iTxSize; i++) {
-        iTxBuffer[i] ^= maskKey[i % sizeof(maskKey)];
-    }
+    headerSize += 4;
 
+    // mask the data
+    uint8_t* payload = iTxBuffer + iTxBatchLength + kMaxFrameHeaderSize;
     size_t txSize = iTxSize;
+    mask(payload, txSize, maskKey, 0);
 
     iTxStarted = false;
     iTxSize = 0;
 
-    return (HttpClient::write(iTxBuffer, txSize) == txSize) ? 0 : 1;
+    if (iTxBatching)
+    {
+        // close the gap left for the header and queue the frame
+        uint8_t* frame = iTxBuffer + iTxBatchLength;
+        memmove(frame + headerSize, payload, txSize);
+        memcpy(frame, header, headerSize);
+        iTxBatchLength += headerSize + txSize;
+        return 0;
+    }
+
+    // the header goes in the room left in front of the payload, so the
+    // whole frame is sent in one write
+    uint8_t* frame = payload - headerSize;
+    memcpy(frame, header, headerSize);
+    txSize += headerSize;
+
+    return (HttpClient::write(frame, txSize) == txSize) ? 0 : 1;
+}
+
+int WebSocketClient::beginBatch()
+{
+    if (iTxBatching)
+    {
+        // fail batch already started
+        return 1;
+    }
+
+    iTxBatching = true;
+    return 0;
+}
+
+int WebSocketClient::endBatch()
+{
+    if (!iTxBatching)
+    {
+        // fail batch not started
+        return 1;
+    }
+
+    iTxBatching = false;
+    return flushBatch();
+}
+
+int WebSocketClient::flushBatch()
+{
+    if (iTxBatchLength == 0)
+    {
+        return 0;
+    }
+
+    size_t batchLength = iTxBatchLength;
+    int ret = (HttpClient::write(iTxBuffer, batchLength) == batchLength) ? 0 : 1;
+
+    // move the message being written (if any) back to the front
+    if (iTxStarted && iTxSize > 0)
+    {
+        memmove(iTxBuffer + kMaxFrameHeaderSize, iTxBuffer + batchLength + kMaxFrameHeaderSize, iTxSize);
+    }
+    iTxBatchLength = 0;
+
+    return ret;
+}
+
+void WebSocketClient::mask(uint8_t* aBuffer, size_t aSize, const uint8_t aMaskKey[4], int aMaskIndex)
+{
+    size_t i = 0;
+
+    // a byte at a time up to a word boundary
+    while ((i < aSize) && ((uintptr_t)(aBuffer + i) & 3))
+    {
+        aBuffer[i++] ^= aMaskKey[aMaskIndex++ & 3];
+    }
+
+    if ((aSize - i) >= 4)
+    {
+        // the key, rotated to line up with the words
+        uint8_t rotatedKey[4];
+        uint32_t maskWord;
+        for (int k = 0; k < 4; k++)
+        {
+            rotatedKey[k] = aMaskKey[(aMaskIndex + k) & 3];
+        }
+        memcpy(&maskWord, rotatedKey, sizeof(maskWord));
+
+        uint32_t* words = (uint32_t*)(aBuffer + i);
+        size_t wordCount = (aSize - i) / 4;
+        for (size_t w = 0; w < wordCount; w++)
+        {
+            words[w] ^= maskWord;
+        }
+        // whole words leave the key position where it was
+        i += wordCount * 4;
+    }
+
+    // and the bytes left over
+    while (i < aSize)
+    {
+        aBuffer[i++] ^= aMaskKey[aMaskIndex++ & 3];
+    }
 }
 
 size_t WebSocketClient::write(uint8_t aByte)
@@ -164,14 +264,27 @@ size_t WebSocketClient::write(const uint8_t *aBuffer, size_t aSize)
         return 0;
     }
 
+    // the payload starts after any queued frames and the room for its header
+    size_t payloadOffset = iTxBatchLength + kMaxFrameHeaderSize;
+
+    if (((payloadOffset + iTxSize + aSize) > sizeof(iTxBuffer)) && (iTxBatchLength > 0))
+    {
+        // make room by sending the queued frames
+        if (flushBatch() != 0)
+        {
+            return 0;
+        }
+        payloadOffset = kMaxFrameHeaderSize;
+    }
+
     // check if the write size, fits in the buffer
-    if ((iTxSize + aSize) > sizeof(iTxBuffer))
+    if ((payloadOffset + iTxSize + aSize) > sizeof(iTxBuffer))
     {
-        aSize = sizeof(iTxSize) - iTxSize;
+        aSize = sizeof(iTxBuffer) - payloadOffset - iTxSize;
     }
 
     // copy data into the buffer
-    memcpy(iTxBuffer + iTxSize, aBuffer, aSize);
+    memcpy(iTxBuffer + payloadOffset + iTxSize, aBuffer, aSize);
 
     iTxSize += aSize;
     
@@ -340,10 +453,8 @@ int WebSocketClient::read(uint8_t *aBuffer, size_t aSize)
         // unmask the RX data if needed
         if (iRxMasked)
         {
-            for (int i = 0; i < (int)aSize; i++, iRxMaskIndex++)
-            {
-                aBuffer[i] ^= iRxMaskKey[iRxMaskIndex % sizeof(iRxMaskKey)];
-            }
+            mask(aBuffer, readCount, iRxMaskKey, iRxMaskIndex);
+            iRxMaskIndex += readCount;
         }
     }
 
@@ -46,6 +46,18 @@ public:
     */
     int endMessage();
 
+    /** Queue the messages sent from now on rather than sending each one
+        on its own.  They all go out in as few writes as the TX buffer
+        allows, when it fills up or at endBatch().
+      @return 0 if successful, else error
+    */
+    int beginBatch();
+
+    /** Send the messages queued since beginBatch()
+      @return 0 if successful, else error
+    */
+    int endBatch();
+
     /** Try to parse an incoming messages
       @return 0 if no message available, else size of parsed message
     */
@@ -87,11 +99,30 @@ public:
 private:
     void flushRx();
 
+    /** Send the frames queued so far, moving the message being written
+        (if any) to the front of the TX buffer
+      @return 0 if successful, else error
+    */
+    int flushBatch();
+
+    /** XOR aBuffer with the mask key, starting aMaskIndex bytes into it.
+        Works a word at a time over the aligned part of the buffer
+    */
+    static void mask(uint8_t* aBuffer, size_t aSize, const uint8_t aMaskKey[4], int aMaskIndex);
+
+    // Most bytes a frame header can take, room for it is kept in front of
+    // the payload so that header and payload go out in one write
+    static const int kMaxFrameHeaderSize = 14;
+
 private:
     bool iTxStarted;
     uint8_t iTxMessageType;
-    uint8_t iTxBuffer[WS_TX_BUFFER_SIZE];
+    uint8_t iTxBuffer[kMaxFrameHeaderSize + WS_TX_BUFFER_SIZE];
     uint64_t iTxSize;
+    // Between beginBatch() and endBatch()
+    bool iTxBatching;
+    // Bytes of finished frames waiting at the start of iTxBuffer
+    size_t iTxBatchLength;
 
     uint8_t iRxOpCode;
     uint64_t iRxSize;
@@ -0,0 +1,264 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+//
+// The benchmark shared by JsonBenchmark.ino and extras/benchmark.
+// It runs a fixed corpus through deserializeJson(), serializeJson(), the
+// filters, and MessagePack, and measures the throughput and the memory.
+// The caller provides micros() and prints the results.
+
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>  // malloc, free, realloc
+#include <string.h>  // memcpy, strlen
+
+struct BenchmarkResult {
+  const char* corpus;
+  const char* operation;
+  size_t inputSize;           // bytes processed by one iteration
+  unsigned long iterations;
+  unsigned long elapsed;      // microseconds
+  unsigned long allocations;  // calls to allocate() and reallocate(), per run
+  size_t peakBytes;           // highest memory allocated by the document
+  size_t resourcesSize;       // ResourceManager::size() after the last run
+
+  // Returns the throughput in bytes per second
+  double bytesPerSecond() const {
+    if (!elapsed)
+      return 0;
+    return double(inputSize) * double(iterations) * 1e6 / double(elapsed);
+  }
+};
+
+// Counts the allocations of a JsonDocument and records the peak memory
+class BenchmarkAllocator : public ArduinoJson::Allocator {
+ public:
+  BenchmarkAllocator() : allocations_(0), bytes_(0), peakBytes_(0) {}
+  virtual ~BenchmarkAllocator() {}
+
+  void* allocate(size_t size) override {
+    auto header = static_cast<Header*>(malloc(sizeof(Header) + size));
+    if (!header)
+      return nullptr;
+    allocations_++;
+    header->size = size;
+    add(size);
+    return header + 1;
+  }
+
+  void deallocate(void* ptr) override {
+    if (!ptr)
+      return;
+    auto header = static_cast<Header*>(ptr) - 1;
+    bytes_ -= header->size;
+    free(header);
+  }
+
+  void* reallocate(void* ptr, size_t newSize) override {
+    if (!ptr)
+      return allocate(newSize);
+    auto header = static_cast<Header*>(ptr) - 1;
+    size_t oldSize = header->size;
+    header = static_cast<Header*>(realloc(header, sizeof(Header) + newSize));
+    if (!header)
+      return nullptr;
+    allocations_++;
+    header->size = newSize;
+    bytes_ -= oldSize;
+    add(newSize);
+    return header + 1;
+  }
+
+  void resetCounters() {
+    allocations_ = 0;
+    peakBytes_ = bytes_;
+  }
+
+  unsigned long allocations() const {
+    return allocations_;
+  }
+
+  size_t peakBytes() const {
+    return peakBytes_;
+  }
+
+ private:
+  // Keeps the payload aligned for the doubles of the extensions
+  union Header {
+    size_t size;
+    double alignment;
+    void* pointer;
+  };
+
+  void add(size_t size) {
+    bytes_ += size;
+    if (bytes_ > peakBytes_)
+      peakBytes_ = bytes_;
+  }
+
+  unsigned long allocations_;
+  size_t bytes_;
+  size_t peakBytes_;
+};
+
+// A configuration file: nested objects, numbers, and short strings
+static const char benchmarkConfig[] =
+    "{\"device\":{\"name\":\"greenhouse-07\",\"model\":\"GH-2\",\"serial\":"
+    "\"A1B2C3D4E5\",\"firmware\":\"3.4.1\",\"location\":{\"lat\":48.85661,"
+    "\"lon\":2.351499,\"alt\":35.5}},\"wifi\":{\"ssid\":\"farm-network\","
+    "\"password\":\"correct horse battery staple\",\"dhcp\":false,\"ip\":"
+    "\"192.168.1.77\",\"gateway\":\"192.168.1.1\",\"dns\":[\"1.1.1.1\","
+    "\"8.8.8.8\"]},\"mqtt\":{\"host\":\"broker.example.com\",\"port\":8883,"
+    "\"tls\":true,\"keepalive\":60,\"topics\":{\"state\":\"gh/07/state\","
+    "\"command\":\"gh/07/cmd\",\"alert\":\"gh/07/alert\"}},\"sensors\":[{"
+    "\"id\":1,\"type\":\"temperature\",\"unit\":\"C\",\"min\":-10,\"max\":"
+    "50,\"offset\":-0.25},{\"id\":2,\"type\":\"humidity\",\"unit\":\"%\","
+    "\"min\":0,\"max\":100,\"offset\":1.5},{\"id\":3,\"type\":\"light\","
+    "\"unit\":\"lx\",\"min\":0,\"max\":100000,\"offset\":0}],\"schedule\":{"
+    "\"interval\":300,\"sleep\":true,\"windows\":[[6,30,20,0],[21,0,21,30]]}"
+    "}";
+
+static const char benchmarkConfigFilter[] =
+    "{\"wifi\":{\"ssid\":true},\"mqtt\":{\"host\":true,\"port\":true},"
+    "\"sensors\":[{\"type\":true}]}";
+
+// Text with escape sequences and non-ASCII characters
+static const char benchmarkMessages[] =
+    "{\"channel\":\"general\",\"messages\":[{\"from\":\"Ana\",\"at\":"
+    "1718000000,\"text\":\"Pump #2 restarted\\nPressure back to "
+    "normal\"},{\"from\":\"Bj\\u00f6rn\",\"at\":1718000360,\"text\":"
+    "\"The \\\"night\\\" profile is active: 18\\u00b0C, fans at 30%\"},{"
+    "\"from\":\"Chlo\\u00e9\",\"at\":1718001200,\"text\":\"Path: "
+    "C:\\\\logs\\\\gh07\\\\2024-06-10.txt\\tsize: 14 kB\"},{\"from\":"
+    "\"Dmitri\",\"at\":1718002500,\"text\":\"\\u041f\\u0440\\u0438\\u0432"
+    "\\u0435\\u0442! Valve 3 is stuck, please check \\ud83d\\udd27\"}],"
+    "\"unread\":4}";
+
+static const char benchmarkMessagesFilter[] =
+    "{\"messages\":[{\"text\":true}]}";
+
+static const char benchmarkTelemetryFilter[] = "{\"samples\":[{\"t\":true}]}";
+
+// Builds a batch of sensor readings: many small objects with floats
+inline void buildBenchmarkTelemetry(JsonDocument& doc) {
+  doc["device"] = "greenhouse-07";
+  JsonArray samples = doc["samples"].to<JsonArray>();
+  for (int i = 0; i < 32; i++) {
+    JsonObject sample = samples.add<JsonObject>();
+    sample["ts"] = 1718000000L + 60L * i;
+    sample["t"] = 19.5 + (i % 7) * 0.25;
+    sample["h"] = 55.0 + (i % 5) * 1.5;
+    sample["lux"] = 12000 + 375 * i;
+    sample["ok"] = i % 11 != 0;
+  }
+}
+
+template <typename TReport>
+class Benchmark {
+ public:
+  // Each operation is repeated for at least minDuration microseconds
+  Benchmark(unsigned long minDuration, TReport report)
+      : minDuration_(minDuration), report_(report), doc_(&allocator_) {}
+
+  void run() {
+    runCorpus("config", benchmarkConfig, benchmarkConfigFilter);
+    runCorpus("messages", benchmarkMessages, benchmarkMessagesFilter);
+
+    JsonDocument telemetry;
+    buildBenchmarkTelemetry(telemetry);
+    size_t size = measureJson(telemetry);
+    char* json = static_cast<char*>(malloc(size + 1));
+    if (!json)
+      return;
+    serializeJson(telemetry, json, size + 1);
+    telemetry.clear();
+    runCorpus("telemetry", json, benchmarkTelemetryFilter);
+    free(json);
+  }
+
+ private:
+  template <typename TOperation>
+  void measure(const char* corpus, const char* operation, size_t inputSize,
+               TOperation op) {
+    op();  // warm up, so that the document reaches its final size
+    allocator_.resetCounters();
+
+    BenchmarkResult result;
+    result.corpus = corpus;
+    result.operation = operation;
+    result.inputSize = inputSize;
+    result.iterations = 0;
+    unsigned long start = micros();
+    do {
+      op();
+      result.iterations++;
+      result.elapsed = micros() - start;
+    } while (result.elapsed < minDuration_);
+    result.allocations = allocator_.allocations() / result.iterations;
+    result.peakBytes = allocator_.peakBytes();
+    result.resourcesSize =
+        ArduinoJson::detail::VariantAttorney::getResourceManager(doc_)
+            ->size();
+    report_(result);
+  }
+
+  void runCorpus(const char* corpus, const char* json, const char* filterJson) {
+    size_t jsonSize = strlen(json);
+    JsonDocument& doc = doc_;
+
+    JsonDocument filterDoc;
+    deserializeJson(filterDoc, filterJson);
+    DeserializationOption::Filter filter(filterDoc);
+    DeserializationOption::CompiledFilter compiledFilter(filterDoc);
+
+    measure(corpus, "deserializeJson", jsonSize,
+            [&]() { deserializeJson(doc, json); });
+
+    measure(corpus, "deserializeJson+Filter", jsonSize,
+            [&]() { deserializeJson(doc, json, filter); });
+
+    measure(corpus, "deserializeJson+CompiledFilter", jsonSize,
+            [&]() { deserializeJson(doc, json, compiledFilter); });
+
+    deserializeJson(doc, json);
+    size_t msgPackSize = measureMsgPack(doc);
+    char* buffer = static_cast<char*>(malloc(jsonSize + 1 + 2 * msgPackSize));
+    if (!buffer)
+      return;
+    char* msgPack = buffer + jsonSize + 1;
+    char* mutableMsgPack = msgPack + msgPackSize;
+
+    measure(corpus, "serializeJson", jsonSize,
+            [&]() { serializeJson(doc, buffer, jsonSize + 1); });
+
+    measure(corpus, "serializeMsgPack", msgPackSize,
+            [&]() { serializeMsgPack(doc, msgPack, msgPackSize); });
+
+    measure(corpus, "deserializeMsgPack", msgPackSize,
+            [&]() { deserializeMsgPack(doc, msgPack, msgPackSize); });
+
+    // The zero-copy mode modifies its input, so each iteration parses a fresh
+    // copy; the memcpy() is included in the measure.
+    measure(corpus, "deserializeMsgPackZeroCopy", msgPackSize, [&]() {
+      memcpy(mutableMsgPack, msgPack, msgPackSize);
+      deserializeMsgPackZeroCopy(doc, mutableMsgPack, msgPackSize);
+    });
+
+    free(buffer);
+    doc.clear();
+  }
+
+  unsigned long minDuration_;
+  TReport report_;
+  BenchmarkAllocator allocator_;
+  JsonDocument doc_;
+};
+
+// Runs the benchmark and calls report(const BenchmarkResult&) for each
+// operation.
+template <typename TReport>
+void runBenchmark(unsigned long minDuration, TReport report) {
+  Benchmark<TReport>(minDuration, report).run();
+}
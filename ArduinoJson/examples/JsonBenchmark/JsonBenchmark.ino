@@ -0,0 +1,65 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+//
+// This example measures the speed and the memory consumption of
+// ArduinoJson on your board.
+//
+// It runs a fixed corpus through deserializeJson(), serializeJson(), the
+// filters, and MessagePack, and prints one line per operation:
+// - the throughput in bytes per second,
+// - the number of allocations per run,
+// - the peak memory allocated by the JsonDocument,
+// - the size of the document after the last run.
+//
+// The same benchmark runs on the computer with extras/benchmark, so you can
+// compare the results between boards and between versions of the library.
+//
+// The benchmark needs about 8 KB of RAM, so it doesn't fit on an Arduino UNO.
+
+#include <ArduinoJson.h>
+
+#include "Benchmark.h"
+
+// Each operation is repeated for at least this duration
+const unsigned long minDuration = 1000000;  // microseconds
+
+void printResult(const BenchmarkResult& result) {
+  Serial.print(result.corpus);
+  Serial.print('\t');
+  Serial.print(result.operation);
+  Serial.print('\t');
+  Serial.print(result.bytesPerSecond(), 0);
+  Serial.print(F(" B/s\t"));
+  Serial.print(result.allocations);
+  Serial.print(F(" allocs\t"));
+  Serial.print(result.peakBytes);
+  Serial.print(F(" B peak\t"));
+  Serial.print(result.resourcesSize);
+  Serial.println(F(" B used"));
+}
+
+void setup() {
+  // Initialize serial port
+  Serial.begin(115200);
+  while (!Serial)
+    continue;
+
+  Serial.print(F("ArduinoJson "));
+  Serial.println(ARDUINOJSON_VERSION);
+
+  runBenchmark(minDuration, printResult);
+
+  Serial.println(F("Done"));
+}
+
+void loop() {
+  // not used in this example
+}
+
+// See also
+// --------
+//
+// https://arduinojson.org/ contains the documentation for all the functions
+// used above. It also includes an FAQ that will help you optimize the
+// performance of your program.
@@ -0,0 +1,38 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+//
+// Runs the benchmark of examples/JsonBenchmark on the computer.
+//
+// Usage: json_benchmark [min-duration-in-ms]
+// The output is tab-separated, so you can diff it or paste it in a
+// spreadsheet.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+static unsigned long micros() {
+  using namespace std::chrono;
+  static auto start = steady_clock::now();
+  return static_cast<unsigned long>(
+      duration_cast<microseconds>(steady_clock::now() - start).count());
+}
+
+#include "Benchmark.h"
+
+static void printResult(const BenchmarkResult& result) {
+  std::printf("%s\t%s\t%.0f\t%lu\t%zu\t%zu\n", result.corpus, result.operation,
+              result.bytesPerSecond(), result.allocations, result.peakBytes,
+              result.resourcesSize);
+}
+
+int main(int argc, const char* argv[]) {
+  unsigned long minDuration = 500;  // milliseconds
+  if (argc > 1)
+    minDuration = std::strtoul(argv[1], nullptr, 10);
+
+  std::printf("corpus\toperation\tbytes/s\tallocs\tpeak\tused\n");
+  runBenchmark(minDuration * 1000, printResult);
+  return 0;
+}
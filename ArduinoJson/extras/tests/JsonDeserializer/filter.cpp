@@ -712,7 +712,89 @@ TEST_CASE("Filtering") {
 
       doc.shrinkToFit();
       CHECK(spy.allocatedBytes() == tc.memoryUsage);
+
+      DeserializationOption::CompiledFilter compiled(filter);
+      REQUIRE(compiled.overflowed() == false);
+      JsonDocument doc2(&spy);
+
+      CHECK(deserializeJson(
+                doc2, tc.input, compiled,
+                DeserializationOption::NestingLimit(tc.nestingLimit)) ==
+            tc.error);
+
+      CHECK(doc2.as<std::string>() == tc.output);
+    }
+  }
+}
+
+TEST_CASE("CompiledFilter") {
+  SpyingAllocator spy;
+  JsonDocument filter;
+  filter["items"][0]["id"] = true;
+  filter["items"][0]["tags"] = true;
+  filter["meta"]["*"]["ok"] = true;
+  filter["meta"]["skip"] = false;
+
+  DeserializationOption::CompiledFilter compiled(filter, &spy);
+  REQUIRE(compiled.overflowed() == false);
+  REQUIRE(spy.allocatedBytes() > 0);
+  filter.clear();  // the compiled filter doesn't refer to the document
+
+  const char* input =
+      "{\"items\":[{\"id\":1,\"name\":\"a\",\"tags\":[\"x\"]},{\"id\":2}],"
+      "\"meta\":{\"a\":{\"ok\":true,\"no\":1},\"skip\":{\"ok\":1}},"
+      "\"other\":[1,2,3]}";
+
+  SECTION("can be reused") {
+    for (int i = 0; i < 3; i++) {
+      JsonDocument doc;
+      REQUIRE(deserializeJson(doc, input, compiled) ==
+              DeserializationError::Ok);
+      REQUIRE(doc.as<std::string>() ==
+              "{\"items\":[{\"id\":1,\"tags\":[\"x\"]},{\"id\":2}],"
+              "\"meta\":{\"a\":{\"ok\":true}}}");
+    }
+  }
+
+  SECTION("works with deserializeMsgPack()") {
+    JsonDocument src;
+    deserializeJson(src, input);
+    std::string msgpack;
+    serializeMsgPack(src, msgpack);
+
+    JsonDocument doc;
+    REQUIRE(deserializeMsgPack(doc, msgpack, compiled) ==
+            DeserializationError::Ok);
+    REQUIRE(doc["items"][0].as<std::string>() == "{\"id\":1,\"tags\":[\"x\"]}");
+    REQUIRE(doc["meta"].as<std::string>() == "{\"a\":{\"ok\":true}}");
+  }
+
+  SECTION("handles many keys with the same prefix") {
+    JsonDocument wide;
+    std::string json = "{";
+    for (int i = 0; i < 100; i++) {
+      wide["key" + std::to_string(i)] = (i % 3 == 0);
+      json += "\"key" + std::to_string(i) + "\":" + std::to_string(i) + ",";
     }
+    json += "\"end\":0}";
+    DeserializationOption::CompiledFilter compiledWide(wide);
+
+    JsonDocument doc;
+    REQUIRE(deserializeJson(doc, json, compiledWide) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.size() == 34);
+    REQUIRE(doc["key99"] == 99);
+    REQUIRE(doc["key98"].isNull());
+  }
+
+  SECTION("rejects everything when out of memory") {
+    DeserializationOption::CompiledFilter failed(filter.to<JsonObject>(),
+                                                 FailingAllocator::instance());
+    REQUIRE(failed.overflowed() == true);
+
+    JsonDocument doc;
+    REQUIRE(deserializeJson(doc, input, failed) == DeserializationError::Ok);
+    REQUIRE(doc.isNull());
   }
 }
 
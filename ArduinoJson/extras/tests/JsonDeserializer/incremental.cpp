@@ -0,0 +1,163 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_COMMENTS 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+
+// Feeds the input in chunks of the specified size
+static DeserializationError feedInChunks(JsonDocument& doc,
+                                         const std::string& input,
+                                         size_t chunkSize) {
+  JsonIncrementalDeserializer parser(doc);
+  for (size_t i = 0; i < input.size(); i += chunkSize) {
+    auto err = parser.feed(input.c_str() + i,
+                           std::min(chunkSize, input.size() - i));
+    if (err)
+      return err;
+  }
+  return parser.finish();
+}
+
+TEST_CASE("JsonIncrementalDeserializer matches deserializeJson()") {
+  const char* inputs[] = {
+      "{\"a\":[1,-2,3.5,true,false,null],\"b\":{\"c\":\"d\"}}",
+      "[\"x\\u00e9\\ud83d\\udda4\",\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"]",
+      "{ hello : 'world', \"a\" : 1, \"a\" : 2 }",
+      " /* comment */ [ 1 , // line\n 2 ]",
+      "123",
+      "-1.5e3",
+      "\"hello\"",
+      "true",
+      "null",
+      "{\"deep\":[[[[1]]]]}",
+      "[1,2] trailing",
+      "",
+      "   ",
+      "[1,2",
+      "{\"a\":",
+      "[1,]",
+      "{\"a\" 1}",
+      "{\"a\":1,}",
+      "\"\\u00zz\"",
+      "\"\\q\"",
+      "[tru]",
+      "[1.5x]",
+      "/x",
+  };
+
+  for (auto input : inputs) {
+    JsonDocument expected;
+    auto expectedError = deserializeJson(expected, input);
+
+    for (size_t chunkSize = 1; chunkSize <= strlen(input) + 1; chunkSize++) {
+      CAPTURE(input);
+      CAPTURE(chunkSize);
+      JsonDocument doc;
+      auto err = feedInChunks(doc, input, chunkSize);
+      CHECK(err == expectedError);
+      if (!err)
+        CHECK(doc == expected);
+    }
+  }
+}
+
+TEST_CASE("JsonIncrementalDeserializer") {
+  SECTION("done() after the first complete value") {
+    JsonDocument doc;
+    JsonIncrementalDeserializer parser(doc);
+
+    REQUIRE(parser.feed("{\"a\":", 5) == DeserializationError::Ok);
+    REQUIRE(parser.done() == false);
+    REQUIRE(parser.feed("[1,2]}", 6) == DeserializationError::Ok);
+    REQUIRE(parser.done() == true);
+    REQUIRE(parser.finish() == DeserializationError::Ok);
+    REQUIRE(doc["a"][1] == 2);
+  }
+
+  SECTION("a string split across chunks") {
+    JsonDocument doc;
+    JsonIncrementalDeserializer parser(doc);
+    std::string value(1000, 'x');
+    std::string json = "[\"" + value + "\"]";
+
+    for (size_t i = 0; i < json.size(); i += 7)
+      parser.feed(json.c_str() + i, std::min<size_t>(7, json.size() - i));
+
+    REQUIRE(parser.finish() == DeserializationError::Ok);
+    REQUIRE(doc[0] == value);
+  }
+
+  SECTION("accepts uint8_t chunks") {
+    JsonDocument doc;
+    JsonIncrementalDeserializer parser(doc);
+    const uint8_t data[] = {'[', '4', '2', ']'};
+
+    REQUIRE(parser.feed(data, sizeof(data)) == DeserializationError::Ok);
+    REQUIRE(parser.done() == true);
+    REQUIRE(doc[0] == 42);
+  }
+
+  SECTION("a NUL ends the input") {
+    JsonDocument doc;
+    JsonIncrementalDeserializer parser(doc);
+
+    REQUIRE(parser.feed("12\0 34", 6) == DeserializationError::Ok);
+    REQUIRE(doc == 12);
+  }
+
+  SECTION("errors are sticky") {
+    JsonDocument doc;
+    JsonIncrementalDeserializer parser(doc);
+
+    REQUIRE(parser.feed("[}", 2) == DeserializationError::InvalidInput);
+    REQUIRE(parser.feed("]", 1) == DeserializationError::InvalidInput);
+    REQUIRE(parser.finish() == DeserializationError::InvalidInput);
+  }
+
+  SECTION("nesting limit") {
+    JsonDocument doc;
+    JsonIncrementalDeserializer parser(doc,
+                                       DeserializationOption::NestingLimit(2));
+
+    REQUIRE(parser.feed("[[", 2) == DeserializationError::Ok);
+    REQUIRE(parser.feed("[", 1) == DeserializationError::TooDeep);
+  }
+
+  SECTION("into a JsonVariant") {
+    JsonDocument doc;
+    JsonVariant variant = doc["data"].to<JsonVariant>();
+    JsonIncrementalDeserializer parser(variant);
+
+    parser.feed("{\"x\":1}", 7);
+    REQUIRE(parser.done() == true);
+    REQUIRE(doc.as<std::string>() == "{\"data\":{\"x\":1}}");
+  }
+
+  SECTION("out of memory") {
+    KillswitchAllocator killswitch;
+    JsonDocument doc(&killswitch);
+    JsonIncrementalDeserializer parser(doc);
+
+    REQUIRE(parser.feed("[\"a", 3) == DeserializationError::Ok);
+    killswitch.on();
+    REQUIRE(parser.feed(std::string(100, 'b').c_str(), 100) ==
+            DeserializationError::Ok);
+    REQUIRE(parser.feed("\"]", 2) == DeserializationError::NoMemory);
+  }
+
+  SECTION("doesn't leak the partial string") {
+    SpyingAllocator spy;
+    {
+      JsonDocument doc(&spy);
+      JsonIncrementalDeserializer parser(doc);
+      parser.feed("[\"abc", 5);
+    }
+    REQUIRE(spy.allocatedBytes() == 0);
+  }
+}
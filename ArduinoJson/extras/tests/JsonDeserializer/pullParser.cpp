@@ -0,0 +1,190 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+#include "Allocators.hpp"
+#include "CustomReader.hpp"
+
+TEST_CASE("JsonPullParser") {
+  SECTION("emits events in document order") {
+    auto parser = makeJsonPullParser(
+        "{\"a\":[1,-2,3.5],\"b\":{\"c\":true,\"d\":null},\"e\":\"x\\u00e9\"}");
+
+    REQUIRE(parser.next() == JsonPullEvent::StartObject);
+    REQUIRE(parser.depth() == 1);
+    REQUIRE(parser.next() == JsonPullEvent::Key);
+    REQUIRE(parser.string() == "a");
+    REQUIRE(parser.next() == JsonPullEvent::StartArray);
+    REQUIRE(parser.next() == JsonPullEvent::Number);
+    REQUIRE(parser.isInteger() == true);
+    REQUIRE(parser.as<int>() == 1);
+    REQUIRE(parser.next() == JsonPullEvent::Number);
+    REQUIRE(parser.as<long>() == -2);
+    REQUIRE(parser.next() == JsonPullEvent::Number);
+    REQUIRE(parser.isInteger() == false);
+    REQUIRE(parser.as<float>() == 3.5f);
+    REQUIRE(parser.next() == JsonPullEvent::EndArray);
+    REQUIRE(parser.next() == JsonPullEvent::Key);
+    REQUIRE(parser.string() == "b");
+    REQUIRE(parser.next() == JsonPullEvent::StartObject);
+    REQUIRE(parser.depth() == 2);
+    REQUIRE(parser.next() == JsonPullEvent::Key);
+    REQUIRE(parser.string() == "c");
+    REQUIRE(parser.next() == JsonPullEvent::Boolean);
+    REQUIRE(parser.asBoolean() == true);
+    REQUIRE(parser.next() == JsonPullEvent::Key);
+    REQUIRE(parser.next() == JsonPullEvent::Null);
+    REQUIRE(parser.next() == JsonPullEvent::EndObject);
+    REQUIRE(parser.next() == JsonPullEvent::Key);
+    REQUIRE(parser.next() == JsonPullEvent::String);
+    REQUIRE(parser.string() == "x\xc3\xa9");
+    REQUIRE(parser.next() == JsonPullEvent::EndObject);
+    REQUIRE(parser.depth() == 0);
+    REQUIRE(parser.next() == JsonPullEvent::End);
+    REQUIRE(parser.next() == JsonPullEvent::End);
+    REQUIRE(parser.error() == DeserializationError::Ok);
+  }
+
+  SECTION("reads a stream without allocating") {
+    SpyingAllocator spy;
+    std::istringstream json("[{\"id\":1},{\"id\":2},{\"id\":3}]");
+    auto parser = makeJsonPullParser(json);
+
+    int sum = 0;
+    while (parser.next() != JsonPullEvent::End) {
+      REQUIRE(parser.event() != JsonPullEvent::Error);
+      if (parser.event() == JsonPullEvent::Number)
+        sum += parser.as<int>();
+    }
+
+    REQUIRE(sum == 6);
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("reads from a custom reader") {
+    CustomReader reader("[true,false]");
+    auto parser = makeJsonPullParser(reader);
+
+    REQUIRE(parser.next() == JsonPullEvent::StartArray);
+    REQUIRE(parser.next() == JsonPullEvent::Boolean);
+    REQUIRE(parser.next() == JsonPullEvent::Boolean);
+    REQUIRE(parser.asBoolean() == false);
+    REQUIRE(parser.next() == JsonPullEvent::EndArray);
+  }
+
+  SECTION("bounded input") {
+    const char* input = "[1,2]garbage";
+    auto parser = makeJsonPullParser(input, 5);
+
+    while (parser.next() != JsonPullEvent::End) {
+      REQUIRE(parser.event() != JsonPullEvent::Error);
+    }
+  }
+
+  SECTION("skip() jumps over a value") {
+    auto parser = makeJsonPullParser(
+        "{\"big\":{\"x\":[1,{\"y\":\"z\"}],\"w\":2},\"small\":42}");
+
+    REQUIRE(parser.next() == JsonPullEvent::StartObject);
+    REQUIRE(parser.next() == JsonPullEvent::Key);
+    REQUIRE(parser.skip() == DeserializationError::Ok);
+    REQUIRE(parser.event() == JsonPullEvent::EndObject);
+    REQUIRE(parser.depth() == 1);
+    REQUIRE(parser.next() == JsonPullEvent::Key);
+    REQUIRE(parser.string() == "small");
+    REQUIRE(parser.next() == JsonPullEvent::Number);
+    REQUIRE(parser.as<int>() == 42);
+  }
+
+  SECTION("skip() accepts strings longer than the buffer") {
+    std::string json = "[\"" +
+                       std::string(ARDUINOJSON_PULL_PARSER_BUFFER_SIZE, 'a') +
+                       "\",\"ok\"]";
+    auto parser = makeJsonPullParser(json);
+
+    REQUIRE(parser.next() == JsonPullEvent::StartArray);
+    REQUIRE(parser.skip() == DeserializationError::Ok);
+    REQUIRE(parser.event() == JsonPullEvent::EndArray);
+
+    auto parser2 = makeJsonPullParser(json);
+    REQUIRE(parser2.next() == JsonPullEvent::StartArray);
+    REQUIRE(parser2.next() == JsonPullEvent::Error);
+    REQUIRE(parser2.error() == DeserializationError::NoMemory);
+  }
+
+  SECTION("read() builds one element at a time") {
+    JsonDocument doc;
+    auto parser = makeJsonPullParser(
+        "{\"items\":[{\"id\":1,\"tags\":[\"a\"]},{\"id\":2,\"v\":1.5}]}");
+
+    REQUIRE(parser.next() == JsonPullEvent::StartObject);
+    REQUIRE(parser.next() == JsonPullEvent::Key);
+    REQUIRE(parser.next() == JsonPullEvent::StartArray);
+
+    REQUIRE(parser.next() == JsonPullEvent::StartObject);
+    REQUIRE(parser.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"id\":1,\"tags\":[\"a\"]}");
+    REQUIRE(parser.event() == JsonPullEvent::EndObject);
+
+    REQUIRE(parser.next() == JsonPullEvent::StartObject);
+    REQUIRE(parser.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"id\":2,\"v\":1.5}");
+
+    REQUIRE(parser.next() == JsonPullEvent::EndArray);
+    REQUIRE(parser.next() == JsonPullEvent::EndObject);
+    REQUIRE(parser.next() == JsonPullEvent::End);
+  }
+
+  SECTION("read() after a key") {
+    JsonDocument doc;
+    auto parser = makeJsonPullParser("{\"a\":\"hello\",\"b\":[1,2]}");
+
+    parser.next();
+    REQUIRE(parser.next() == JsonPullEvent::Key);
+    REQUIRE(parser.read(doc["a"].to<JsonVariant>()) ==
+            DeserializationError::Ok);
+    REQUIRE(parser.next() == JsonPullEvent::Key);
+    REQUIRE(parser.read(doc["b"].to<JsonVariant>()) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":\"hello\",\"b\":[1,2]}");
+  }
+
+  SECTION("errors") {
+    SECTION("empty input") {
+      auto parser = makeJsonPullParser("  ");
+      REQUIRE(parser.next() == JsonPullEvent::Error);
+      REQUIRE(parser.error() == DeserializationError::EmptyInput);
+    }
+
+    SECTION("incomplete input") {
+      auto parser = makeJsonPullParser("[1,");
+      while (parser.next() != JsonPullEvent::Error) {
+      }
+      REQUIRE(parser.error() == DeserializationError::IncompleteInput);
+      REQUIRE(parser.next() == JsonPullEvent::Error);
+    }
+
+    SECTION("missing colon") {
+      auto parser = makeJsonPullParser("{\"a\" 1}");
+      parser.next();
+      parser.next();
+      REQUIRE(parser.next() == JsonPullEvent::Error);
+      REQUIRE(parser.error() == DeserializationError::InvalidInput);
+    }
+
+    SECTION("nesting limit") {
+      auto parser = makeJsonPullParser("[[[1]]]",
+                                       DeserializationOption::NestingLimit(2));
+      REQUIRE(parser.next() == JsonPullEvent::StartArray);
+      REQUIRE(parser.next() == JsonPullEvent::StartArray);
+      REQUIRE(parser.next() == JsonPullEvent::Error);
+      REQUIRE(parser.error() == DeserializationError::TooDeep);
+    }
+  }
+}
@@ -0,0 +1,119 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+#include "Allocators.hpp"
+
+static std::string key(int i) {
+  return "key" + std::to_string(i);
+}
+
+static void fill(JsonObject obj, int n, int offset = 0) {
+  for (int i = 0; i < n; i++)
+    obj[key(i)] = i + offset;
+}
+
+static bool allFound(JsonObject obj, int n, int offset = 0) {
+  for (int i = 0; i < n; i++) {
+    if (obj[key(i)] != i + offset)
+      return false;
+  }
+  return true;
+}
+
+TEST_CASE("JsonObject member index") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  JsonObject obj = doc.to<JsonObject>();
+  const int n = 3 * ARDUINOJSON_OBJECT_INDEX_THRESHOLD;
+  fill(obj, n);
+
+  SECTION("finds every member") {
+    REQUIRE(allFound(obj, n));
+    REQUIRE(obj["missing"].isNull());
+    REQUIRE(obj["key"].isNull());
+  }
+
+  SECTION("sees members added afterwards") {
+    REQUIRE(allFound(obj, n));
+    for (int i = n; i < 4 * n; i++)
+      obj[key(i)] = i;
+    REQUIRE(allFound(obj, 4 * n));
+    REQUIRE(obj.size() == 4 * n);
+  }
+
+  SECTION("forgets removed members") {
+    REQUIRE(allFound(obj, n));
+    obj.remove(key(5));
+    REQUIRE(obj[key(5)].isNull());
+    REQUIRE(obj[key(4)] == 4);
+    REQUIRE(obj[key(n - 1)] == n - 1);
+  }
+
+  SECTION("forgets a cleared object") {
+    JsonObject big = doc["big"].to<JsonObject>();
+    fill(big, n);
+    REQUIRE(allFound(big, n));
+    big = doc["big"].to<JsonObject>();  // same slot, new members
+    fill(big, n, 100);
+    REQUIRE(allFound(big, n, 100));
+  }
+
+  SECTION("survives shrinkToFit()") {
+    REQUIRE(allFound(obj, n));
+    doc.shrinkToFit();
+    REQUIRE(allFound(doc.as<JsonObject>(), n));
+  }
+
+  SECTION("survives a move") {
+    REQUIRE(allFound(obj, n));
+    JsonDocument doc2 = std::move(doc);
+    REQUIRE(allFound(doc2.as<JsonObject>(), n));
+  }
+
+  SECTION("first duplicate key wins") {
+    auto data = ArduinoJson::detail::VariantAttorney::getData(doc);
+    auto resources = ArduinoJson::detail::VariantAttorney::getResourceManager(doc);
+    auto value = data->asObject()->addMember(
+        ArduinoJson::detail::adaptString("key0"), resources);
+    value->setInteger(666, resources);
+    REQUIRE(obj.size() == n + 1);
+    REQUIRE(allFound(obj, n));
+  }
+
+  SECTION("is built while the object grows and freed with it") {
+    spy.clearLog();
+    REQUIRE(allFound(obj, n));
+    REQUIRE(spy.log() == AllocatorLog{});
+    doc.clear();
+    REQUIRE(spy.allocatedBytes() == 0);
+  }
+
+  SECTION("is optional when memory is short") {
+    KillswitchAllocator killswitch;
+    JsonDocument doc2(&killswitch);
+    JsonObject obj2 = doc2.to<JsonObject>();
+    fill(obj2, n);
+    killswitch.on();
+    REQUIRE(allFound(obj2, n));
+    REQUIRE(doc2.overflowed() == false);
+  }
+}
+
+TEST_CASE("deserializeJson() of a large object with duplicate keys") {
+  std::string json = "{";
+  for (int i = 0; i < 2 * ARDUINOJSON_OBJECT_INDEX_THRESHOLD; i++)
+    json += "\"" + key(i) + "\":" + std::to_string(i) + ",";
+  json += "\"key3\":33}";
+
+  JsonDocument doc;
+  REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+  JsonObject obj = doc.as<JsonObject>();
+  REQUIRE(obj.size() == 2 * ARDUINOJSON_OBJECT_INDEX_THRESHOLD);
+  REQUIRE(obj["key3"] == 33);
+  REQUIRE(obj["key2"] == 2);
+}
@@ -0,0 +1,94 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+static std::string serializeInChunks(JsonVariantConst source,
+                                     size_t chunkSize) {
+  JsonChunkedSerializer serializer(source);
+  std::string result;
+  char buffer[64];
+  REQUIRE(chunkSize <= sizeof(buffer));
+  for (;;) {
+    size_t n = serializer.fill(buffer, chunkSize);
+    result.append(buffer, n);
+    if (n < chunkSize)
+      break;
+    REQUIRE(n == chunkSize);
+  }
+  REQUIRE(serializer.done());
+  REQUIRE(serializer.fill(buffer, chunkSize) == 0);
+  return result;
+}
+
+TEST_CASE("JsonChunkedSerializer") {
+  JsonDocument doc;
+
+  SECTION("matches serializeJson() for every chunk size") {
+    doc["name"] = "hello \"world\"\n\t\\";
+    doc["values"].add(1);
+    doc["values"].add(-2);
+    doc["values"].add(3.14);
+    doc["values"].add(true);
+    doc["values"].add(nullptr);
+    doc["values"].add(JsonObject());
+    doc["values"].add(JsonArray());
+    doc["nested"]["a"]["b"][0] = "c";
+    doc["raw"] = serialized("[1,2]");
+    doc["empty"] = "";
+    doc["big"] = 4294967295U;
+    doc["nul"] = std::string("a\0b", 3);
+    doc["control"] = "\x01";
+    doc["emptyObject"].to<JsonObject>();
+    doc["emptyArray"].to<JsonArray>();
+
+    std::string expected;
+    serializeJson(doc, expected);
+
+    for (size_t chunkSize = 1; chunkSize <= 64; chunkSize++) {
+      CAPTURE(chunkSize);
+      REQUIRE(serializeInChunks(doc, chunkSize) == expected);
+    }
+  }
+
+  SECTION("scalar roots") {
+    doc.set(42);
+    REQUIRE(serializeInChunks(doc, 1) == "42");
+    doc.set("x");
+    REQUIRE(serializeInChunks(doc, 1) == "\"x\"");
+    doc.clear();
+    REQUIRE(serializeInChunks(doc, 3) == "null");
+  }
+
+  SECTION("unbound variant") {
+    REQUIRE(serializeInChunks(JsonVariant(), 8) == "null");
+  }
+
+  SECTION("a buffer that matches exactly") {
+    doc.add(1);
+    JsonChunkedSerializer serializer(doc);
+    char buffer[3];
+
+    REQUIRE(serializer.fill(buffer, 3) == 3);
+    REQUIRE(serializer.done() == true);
+    REQUIRE(serializer.fill(buffer, 3) == 0);
+  }
+
+  SECTION("too deep") {
+    JsonVariant v = doc.to<JsonVariant>();
+    for (int i = 0; i <= JsonChunkedSerializer::maxDepth; i++)
+      v = v.add<JsonArray>();
+
+    JsonChunkedSerializer serializer(doc);
+    char buffer[128];
+    size_t n = serializer.fill(buffer, sizeof(buffer));
+    REQUIRE(serializer.overflowed() == true);
+    REQUIRE(std::string(buffer, n) ==
+            std::string(JsonChunkedSerializer::maxDepth, '[') + "null" +
+                std::string(JsonChunkedSerializer::maxDepth, ']'));
+  }
+}
@@ -0,0 +1,179 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+namespace binding_test {
+struct Position {
+  int x;
+  int y;
+};
+ARDUINOJSON_BIND(Position, x, y)
+
+struct Telemetry {
+  char name[8];
+  float temperature;
+  long uptime;
+  bool online;
+  std::string label;
+  Position position;
+  int history[3];
+};
+ARDUINOJSON_BIND(Telemetry, name, temperature, uptime, online, label,
+                 position, history)
+}  // namespace binding_test
+
+using namespace binding_test;
+
+TEST_CASE("ARDUINOJSON_BIND") {
+  Telemetry telemetry = {"probe", 21.5f, 4000, true, "lab", {1, -2}, {7, 8, 9}};
+
+  SECTION("constStringHash() matches stringHash()") {
+    using namespace ArduinoJson::detail;
+    REQUIRE(constStringHash("temperature") ==
+            stringHash(adaptString("temperature")));
+    REQUIRE(constStringHash("") == stringHash(adaptString("")));
+  }
+
+  SECTION("serializeJson()") {
+    std::string output;
+    size_t n = serializeJson(telemetry, output);
+
+    REQUIRE(output ==
+            "{\"name\":\"probe\",\"temperature\":21.5,\"uptime\":4000,"
+            "\"online\":true,\"label\":\"lab\",\"position\":{\"x\":1,\"y\":-2},"
+            "\"history\":[7,8,9]}");
+    REQUIRE(n == output.size());
+    REQUIRE(measureJson(telemetry) == n);
+  }
+
+  SECTION("serializeJson() matches the JsonDocument") {
+    JsonDocument doc;
+    doc.set(telemetry);
+
+    std::string expected, actual;
+    serializeJson(doc, expected);
+    serializeJson(telemetry, actual);
+    REQUIRE(actual == expected);
+  }
+
+  SECTION("serializeJson() to a buffer") {
+    Position position = {3, 4};
+    char buffer[32];
+
+    size_t n = serializeJson(position, buffer, sizeof(buffer));
+
+    REQUIRE(n == 13);
+    REQUIRE(std::string(buffer) == "{\"x\":3,\"y\":4}");
+  }
+
+  SECTION("serializeJson() escapes strings") {
+    strcpy(telemetry.name, "a\"b");
+    std::string output;
+    serializeJson(telemetry, output);
+    REQUIRE(output.find("\"name\":\"a\\\"b\"") != std::string::npos);
+  }
+
+  SECTION("deserializeJson()") {
+    Telemetry result = {};
+    auto err = deserializeJson(
+        result,
+        "{\"name\":\"sensor\",\"temperature\":-3.25,\"uptime\":123456,"
+        "\"online\":true,\"label\":\"roof\",\"position\":{\"y\":5,\"x\":6},"
+        "\"history\":[1,2,3]}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(std::string(result.name) == "sensor");
+    REQUIRE(result.temperature == -3.25f);
+    REQUIRE(result.uptime == 123456);
+    REQUIRE(result.online == true);
+    REQUIRE(result.label == "roof");
+    REQUIRE(result.position.x == 6);
+    REQUIRE(result.position.y == 5);
+    REQUIRE(result.history[0] == 1);
+    REQUIRE(result.history[2] == 3);
+  }
+
+  SECTION("deserializeJson() round-trips serializeJson()") {
+    std::string json;
+    serializeJson(telemetry, json);
+    Telemetry result = {};
+
+    REQUIRE(deserializeJson(result, json) == DeserializationError::Ok);
+
+    std::string json2;
+    serializeJson(result, json2);
+    REQUIRE(json2 == json);
+  }
+
+  SECTION("deserializeJson() skips unknown keys") {
+    Position result = {0, 0};
+    auto err = deserializeJson(
+        result, "{\"z\":{\"x\":9,\"a\":[1,{}]},\"x\":1,\"w\":\"x\",\"y\":2}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(result.x == 1);
+    REQUIRE(result.y == 2);
+  }
+
+  SECTION("deserializeJson() keeps missing and mismatching members") {
+    Position result = {8, 9};
+    auto err = deserializeJson(result, "{\"x\":\"one\",\"z\":1}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(result.x == 8);
+    REQUIRE(result.y == 9);
+  }
+
+  SECTION("deserializeJson() truncates strings and arrays") {
+    Telemetry result = {};
+    auto err = deserializeJson(
+        result, "{\"name\":\"much too long\",\"history\":[1,2,3,4,[5]]}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(std::string(result.name) == "much to");
+    REQUIRE(result.history[2] == 3);
+  }
+
+  SECTION("deserializeJson() with a size") {
+    Position result = {0, 0};
+    auto err = deserializeJson(result, "{\"x\":1,\"y\":2}garbage", 13);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(result.y == 2);
+  }
+
+  SECTION("deserializeJson() reports errors") {
+    Position result = {0, 0};
+
+    REQUIRE(deserializeJson(result, "") == DeserializationError::EmptyInput);
+    REQUIRE(deserializeJson(result, "{\"x\":1") ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(deserializeJson(result, "{\"x\":1]") ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("JsonVariant::as<T>()") {
+    JsonDocument doc;
+    doc["x"] = 10;
+    doc["y"] = 20;
+
+    REQUIRE(doc.is<Position>() == true);
+    Position result = doc.as<Position>();
+    REQUIRE(result.x == 10);
+    REQUIRE(result.y == 20);
+  }
+
+  SECTION("JsonVariant::set()") {
+    JsonDocument doc;
+    doc["telemetry"] = telemetry;
+
+    REQUIRE(doc["telemetry"]["position"]["y"] == -2);
+    REQUIRE(doc["telemetry"]["history"][1] == 8);
+    REQUIRE(doc["telemetry"]["name"] == "probe");
+  }
+}
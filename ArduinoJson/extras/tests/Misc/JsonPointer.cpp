@@ -0,0 +1,177 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include "Allocators.hpp"
+
+static const char* input =
+    "{\"a\":{\"b\":[10,{\"c\":\"deep\"},[1,2],{\"c\":true}]},"
+    "\"m~n\":1,\"x/y\":2,\"\":3,\"42\":4,\"list\":[[0],[1],[2]]}";
+
+TEST_CASE("JsonPointer::resolve()") {
+  JsonDocument doc;
+  deserializeJson(doc, input);
+
+  SECTION("whole document") {
+    JsonPointer pointer("");
+    REQUIRE(pointer.isValid());
+    REQUIRE(pointer.size() == 0);
+    REQUIRE(pointer.resolve(doc) == doc.as<JsonVariant>());
+  }
+
+  SECTION("keys and indexes") {
+    REQUIRE(JsonPointer("/a/b/0").resolve(doc) == 10);
+    REQUIRE(JsonPointer("/a/b/1/c").resolve(doc) == "deep");
+    REQUIRE(JsonPointer("/a/b/2/1").resolve(doc) == 2);
+    REQUIRE(JsonPointer("/list/2/0").resolve(doc) == 2);
+  }
+
+  SECTION("escaped keys") {
+    REQUIRE(JsonPointer("/m~0n").resolve(doc) == 1);
+    REQUIRE(JsonPointer("/x~1y").resolve(doc) == 2);
+    REQUIRE(JsonPointer("/").resolve(doc) == 3);
+  }
+
+  SECTION("numeric key in an object") {
+    REQUIRE(JsonPointer("/42").resolve(doc) == 4);
+  }
+
+  SECTION("missing values") {
+    REQUIRE(JsonPointer("/z").resolve(doc).isNull());
+    REQUIRE(JsonPointer("/a/b/9").resolve(doc).isNull());
+    REQUIRE(JsonPointer("/a/b/01").resolve(doc).isNull());
+    REQUIRE(JsonPointer("/a/b/-").resolve(doc).isNull());
+    REQUIRE(JsonPointer("/a/b/0/c").resolve(doc).isNull());
+  }
+
+  SECTION("const document") {
+    const JsonDocument& constDoc = doc;
+    JsonVariantConst value = JsonPointer("/a/b/3/c").resolve(constDoc);
+    REQUIRE(value == true);
+  }
+
+  SECTION("modifies the value") {
+    JsonPointer("/a/b/0").resolve(doc).set(11);
+    REQUIRE(doc["a"]["b"][0] == 11);
+  }
+
+  SECTION("invalid pointers") {
+    REQUIRE_FALSE(JsonPointer("a/b").isValid());
+    REQUIRE_FALSE(JsonPointer("/a~2").isValid());
+    REQUIRE_FALSE(JsonPointer("/a~").isValid());
+    REQUIRE_FALSE(JsonPointer(nullptr).isValid());
+    REQUIRE(JsonPointer("a").resolve(doc).isNull());
+  }
+
+  SECTION("large object") {
+    JsonDocument big;
+    for (int i = 0; i < 100; i++)
+      big[std::to_string(i)] = i;
+
+    JsonPointer pointer("/73");
+    for (int i = 0; i < 3; i++)  // the second lookup uses the object index
+      REQUIRE(pointer.resolve(big) == 73);
+  }
+}
+
+TEST_CASE("JsonPointer allocation") {
+  SpyingAllocator spy;
+
+  SECTION("one block for the tokens and the keys") {
+    using ArduinoJson::detail::JsonPointerToken;
+    JsonPointer pointer("/abc/de", &spy);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(2 * sizeof(JsonPointerToken) + 7),
+                         });
+  }
+
+  SECTION("nothing for the whole document") {
+    JsonPointer pointer("", &spy);
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("allocation failure") {
+    JsonPointer pointer("/a", FailingAllocator::instance());
+    REQUIRE_FALSE(pointer.isValid());
+  }
+}
+
+TEST_CASE("extractJson()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("object") {
+    auto err = extractJson(doc, input, JsonPointer("/a/b/1"));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"c\":\"deep\"}");
+  }
+
+  SECTION("scalar") {
+    auto err = extractJson(doc, input, JsonPointer("/x~1y"));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 2);
+  }
+
+  SECTION("skips the other values") {
+    auto err = extractJson(doc, input, JsonPointer("/list/2"));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[2]");
+  }
+
+  SECTION("stops after the value") {
+    std::istringstream stream("[1,{\"a\":2},3]trailing");
+
+    auto err = extractJson(doc, stream, JsonPointer("/1"));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":2}");
+    REQUIRE(stream.get() == ',');
+  }
+
+  SECTION("with a size") {
+    auto err = extractJson(doc, "[1,2,3]", 7, JsonPointer("/2"));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 3);
+  }
+
+  SECTION("not found") {
+    doc.set(42);
+
+    REQUIRE(extractJson(doc, input, JsonPointer("/a/z")) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.isNull());
+    REQUIRE(extractJson(doc, input, JsonPointer("/a/b/4")) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.isNull());
+    REQUIRE(extractJson(doc, input, JsonPointer("/m~0n/0")) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.isNull());
+  }
+
+  SECTION("invalid input") {
+    REQUIRE(extractJson(doc, "{\"a\":[1,}", JsonPointer("/a/1")) ==
+            DeserializationError::InvalidInput);
+    REQUIRE(extractJson(doc, "{\"b\":1", JsonPointer("/a")) ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("variant destination") {
+    doc["result"] = 0;
+
+    auto err = extractJson(doc["result"].as<JsonVariant>(), input,
+                           JsonPointer("/a/b/3/c"));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["result"] == true);
+  }
+}
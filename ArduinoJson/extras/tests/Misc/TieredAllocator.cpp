@@ -0,0 +1,117 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+
+TEST_CASE("TieredAllocator") {
+  SpyingAllocator fast, large;
+  TieredAllocator allocator(&fast, &large, 100);
+
+  SECTION("small blocks go to the fast tier") {
+    void* p = allocator.allocate(42);
+    REQUIRE(p != nullptr);
+    REQUIRE(fast.allocatedBytes() > 0);
+    REQUIRE(large.allocatedBytes() == 0);
+    REQUIRE(allocator.stats().fastBytes >= 42);
+    allocator.deallocate(p);
+  }
+
+  SECTION("large blocks go to the large tier") {
+    void* p = allocator.allocate(1000);
+    REQUIRE(fast.allocatedBytes() == 0);
+    REQUIRE(large.allocatedBytes() > 1000);
+    REQUIRE(allocator.stats().largeBytes == 1000);
+    allocator.deallocate(p);
+    REQUIRE(large.allocatedBytes() == 0);
+    REQUIRE(allocator.stats().largeBytes == 0);
+    REQUIRE(allocator.stats().peakLargeBytes == 1000);
+  }
+
+  SECTION("slot pools stay in the fast tier") {
+    void* p = allocator.allocate(sizeofPool());
+    REQUIRE(large.allocatedBytes() == 0);
+    allocator.deallocate(p);
+  }
+
+  SECTION("a growing string moves to the large tier") {
+    char* p = static_cast<char*>(allocator.allocate(50));
+    strcpy(p, "hello");
+    p = static_cast<char*>(allocator.reallocate(p, 500));
+    REQUIRE(p != nullptr);
+    REQUIRE(std::string(p) == "hello");
+    REQUIRE(large.allocatedBytes() > 500);
+    REQUIRE(allocator.stats().fastBytes == allocator.stats().cachedBytes);
+
+    p = static_cast<char*>(allocator.reallocate(p, 200));  // stays large
+    REQUIRE(std::string(p) == "hello");
+    REQUIRE(allocator.stats().largeBytes == 200);
+    allocator.deallocate(p);
+  }
+
+  SECTION("recycles freed blocks of the same class") {
+    void* p = allocator.allocate(60);
+    allocator.deallocate(p);
+    REQUIRE(allocator.stats().cachedBlocks == 1);
+    fast.clearLog();
+
+    void* q = allocator.allocate(58);  // rounded to the same class
+    REQUIRE(q == p);
+    REQUIRE(fast.log() == AllocatorLog{});
+    REQUIRE(allocator.stats().recycled == 1);
+    REQUIRE(allocator.stats().cachedBlocks == 0);
+    allocator.deallocate(q);
+  }
+
+  SECTION("limits the number of cached blocks") {
+    void* blocks[TieredAllocator::maxBlocksPerClass + 1];
+    for (auto& block : blocks)
+      block = allocator.allocate(32);
+    for (auto& block : blocks)
+      allocator.deallocate(block);
+    REQUIRE(allocator.stats().cachedBlocks ==
+            TieredAllocator::maxBlocksPerClass);
+
+    allocator.releaseCache();
+    REQUIRE(allocator.stats().cachedBlocks == 0);
+    REQUIRE(fast.allocatedBytes() == 0);
+    REQUIRE(allocator.stats().fastBytes == 0);
+  }
+
+  SECTION("counts failures") {
+    TieredAllocator failing(FailingAllocator::instance(),
+                            FailingAllocator::instance());
+    REQUIRE(failing.allocate(10) == nullptr);
+    REQUIRE(failing.stats().failures == 1);
+    REQUIRE(failing.stats().allocations == 0);
+  }
+
+  SECTION("reuses the pools of a destroyed document") {
+    {
+      JsonDocument doc(&allocator);
+      doc["key"] = std::string(300, 'x');
+      REQUIRE(doc["key"].as<std::string>().size() == 300);
+      REQUIRE(large.allocatedBytes() > 300);
+    }
+    REQUIRE(large.allocatedBytes() == 0);
+    auto cached = allocator.stats().cachedBlocks;
+    REQUIRE(cached > 0);
+    fast.clearLog();
+
+    {
+      JsonDocument doc(&allocator);
+      doc["key"] = "value";
+    }
+    REQUIRE(fast.log() == AllocatorLog{});
+    REQUIRE(allocator.stats().cachedBlocks == cached);
+  }
+
+  allocator.releaseCache();
+  REQUIRE(fast.allocatedBytes() == 0);
+  REQUIRE(large.allocatedBytes() == 0);
+}
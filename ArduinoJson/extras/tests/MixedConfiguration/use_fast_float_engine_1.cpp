@@ -0,0 +1,83 @@
+#define ARDUINOJSON_VERSION_NAMESPACE FastFloatEngine
+#define ARDUINOJSON_USE_FAST_FLOAT_ENGINE 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+#include <limits>
+
+static std::string serialize(JsonVariantConst value) {
+  std::string json;
+  serializeJson(value, json);
+  return json;
+}
+
+static double parse(const char* input) {
+  JsonDocument doc;
+  REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+  return doc.as<double>();
+}
+
+TEST_CASE("ARDUINOJSON_USE_FAST_FLOAT_ENGINE == 1") {
+  JsonDocument doc;
+
+  SECTION("serializeJson() writes the shortest digits") {
+    doc.set(0.1 + 0.2);
+    REQUIRE(serialize(doc) == "0.30000000000000004");
+
+    doc.set(3.141592653589793);
+    REQUIRE(serialize(doc) == "3.141592653589793");
+
+    doc.set(3.14f);
+    REQUIRE(serialize(doc) == "3.14");
+
+    doc.set(-123.456);
+    REQUIRE(serialize(doc) == "-123.456");
+  }
+
+  SECTION("serializeJson() keeps the exponentiation thresholds") {
+    doc.set(1e7);
+    REQUIRE(serialize(doc) == "1e7");
+
+    doc.set(9999999.0);
+    REQUIRE(serialize(doc) == "9999999");
+
+    doc.set(1.5e-5);
+    REQUIRE(serialize(doc) == "0.000015");
+
+    doc.set(1e-5);
+    REQUIRE(serialize(doc) == "1e-5");
+
+    doc.set(std::numeric_limits<double>::max());
+    REQUIRE(serialize(doc) == "1.7976931348623157e308");
+
+    doc.set(0.0);
+    REQUIRE(serialize(doc) == "0");
+  }
+
+  SECTION("deserializeJson() rounds correctly") {
+    REQUIRE(parse("2.2250738585072011e-308") == 2.2250738585072011e-308);
+    REQUIRE(parse("1.7976931348623157e308") ==
+            std::numeric_limits<double>::max());
+    REQUIRE(parse("4.9e-324") == std::numeric_limits<double>::denorm_min());
+    REQUIRE(parse("0.30000000000000004") == 0.30000000000000004);
+    REQUIRE(parse("123456789012345678901234567890") ==
+            123456789012345678901234567890.0);
+    REQUIRE(parse("18446744073709551616") == 18446744073709551616.0);
+    REQUIRE(parse("0e999") == 0.0);
+    REQUIRE(parse("1e-400") == 0.0);
+    REQUIRE(parse("1e400") == std::numeric_limits<double>::infinity());
+  }
+
+  SECTION("round trip") {
+    const double values[] = {
+        1.0 / 3, 2.0 / 3, 1e23, 5e-324, 6.02214076e23, 299792458.0,
+    };
+    for (double value : values) {
+      doc.set(value);
+      std::string json = serialize(doc);
+      CAPTURE(json);
+      REQUIRE(parse(json.c_str()) == value);
+    }
+  }
+}
@@ -0,0 +1,61 @@
+#define ARDUINOJSON_VERSION_NAMESPACE FastFloatEngineSingle
+#define ARDUINOJSON_USE_FAST_FLOAT_ENGINE 1
+#define ARDUINOJSON_USE_DOUBLE 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+#include <limits>
+
+static std::string serialize(JsonVariantConst value) {
+  std::string json;
+  serializeJson(value, json);
+  return json;
+}
+
+static float parse(const char* input) {
+  JsonDocument doc;
+  REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+  return doc.as<float>();
+}
+
+TEST_CASE("ARDUINOJSON_USE_FAST_FLOAT_ENGINE == 1 && USE_DOUBLE == 0") {
+  JsonDocument doc;
+
+  SECTION("serializeJson() writes the shortest digits") {
+    doc.set(3.14f);
+    REQUIRE(serialize(doc) == "3.14");
+
+    doc.set(0.1f + 0.2f);
+    REQUIRE(serialize(doc) == "0.3");
+
+    doc.set(16777216.0f);
+    REQUIRE(serialize(doc) == "1.6777216e7");
+
+    doc.set(std::numeric_limits<float>::max());
+    REQUIRE(serialize(doc) == "3.4028235e38");
+  }
+
+  SECTION("deserializeJson() rounds correctly") {
+    REQUIRE(parse("66151.8046875") == 66151.8046875f);
+    REQUIRE(parse("16777217") == 16777216.0f);
+    REQUIRE(parse("3.4028235e38") == std::numeric_limits<float>::max());
+    REQUIRE(parse("1.17549435e-38") == std::numeric_limits<float>::min());
+    REQUIRE(parse("1e-45") == std::numeric_limits<float>::denorm_min());
+    REQUIRE(parse("0.340282346638528861111111111111") == 0.34028234663852886f);
+    REQUIRE(parse("1e-300") == 0.0f);
+    REQUIRE(parse("1e300") == std::numeric_limits<float>::infinity());
+  }
+
+  SECTION("round trip") {
+    const float values[] = {
+        0.1f, 1.0f / 3, 2.0f / 3, 1e-45f, 6.02214076e23f, 299792458.0f,
+    };
+    for (float value : values) {
+      doc.set(value);
+      std::string json = serialize(doc);
+      CAPTURE(json);
+      REQUIRE(parse(json.c_str()) == value);
+    }
+  }
+}
@@ -0,0 +1,149 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+using ArduinoJson::detail::sizeofArray;
+using ArduinoJson::detail::sizeofObject;
+
+TEST_CASE("deserializeMsgPackZeroCopy()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("links strings and keys in a mutable buffer") {
+    char input[] = "\x82\xA5hello\xA5world\xA2pi\xA3" "3.5";
+
+    auto err = deserializeMsgPackZeroCopy(doc, input, sizeof(input) - 1);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(doc["pi"].as<float>() == 3.5f);
+    const char* world = doc["hello"];
+    REQUIRE(world > input);
+    REQUIRE(world < input + sizeof(input));
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Reallocate(sizeofPool(), sizeofObject(2)),
+                         });
+  }
+
+  SECTION("empty string") {
+    char input[] = "\x91\xA0";
+
+    auto err = deserializeMsgPackZeroCopy(doc, input, sizeof(input) - 1);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "");
+  }
+
+  SECTION("str 8") {
+    char input[] = "\xd9\x05hello";
+
+    auto err = deserializeMsgPackZeroCopy(doc, input, sizeof(input) - 1);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "hello");
+  }
+
+  SECTION("copies strings from a const buffer") {
+    const char* input = "\x91\xA5hello";
+
+    auto err = deserializeMsgPackZeroCopy(doc, input, 7);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "hello");
+    REQUIRE(doc[0].as<const char*>() != input + 2);
+  }
+
+  SECTION("links binaries from a const buffer") {
+    const uint8_t input[] = {0x91, 0xc4, 0x03, 0x01, 0x02, 0x03};
+
+    auto err = deserializeMsgPackZeroCopy(doc, input, sizeof(input));
+
+    REQUIRE(err == DeserializationError::Ok);
+    auto binary = doc[0].as<MsgPackBinary>();
+    REQUIRE(binary.data() == input + 3);
+    REQUIRE(binary.size() == 3);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Reallocate(sizeofPool(), sizeofArray(1)),
+                         });
+  }
+
+  SECTION("bin 16") {
+    std::string input = "\xc5\x01\x00"_s + std::string(256, '?');
+
+    auto err = deserializeMsgPackZeroCopy(doc, input.data(), input.size());
+
+    REQUIRE(err == DeserializationError::Ok);
+    auto binary = doc.as<MsgPackBinary>();
+    REQUIRE(binary.data() == input.data() + 3);
+    REQUIRE(binary.size() == 256);
+  }
+
+  SECTION("links extensions") {
+    const uint8_t input[] = {0xd5, 0x01, 0x02, 0x03};
+
+    auto err = deserializeMsgPackZeroCopy(doc, input, sizeof(input));
+
+    REQUIRE(err == DeserializationError::Ok);
+    auto extension = doc.as<MsgPackExtension>();
+    REQUIRE(extension.type() == 1);
+    REQUIRE(extension.data() == input + 2);
+    REQUIRE(extension.size() == 2);
+  }
+
+  SECTION("serializes the linked binaries") {
+    const uint8_t input[] = {0x92, 0xc4, 0x01, 0x2A, 0xc7, 0x01, 0x05, 0x2A};
+
+    auto err = deserializeMsgPackZeroCopy(doc, input, sizeof(input));
+
+    REQUIRE(err == DeserializationError::Ok);
+    std::string output;
+    serializeMsgPack(doc, output);
+    REQUIRE(output == std::string(reinterpret_cast<const char*>(input),
+                                  sizeof(input)));
+  }
+
+  SECTION("copying the document copies the binaries") {
+    uint8_t input[] = {0xc4, 0x01, 0x2A};
+    REQUIRE(deserializeMsgPackZeroCopy(doc, input, sizeof(input)) ==
+            DeserializationError::Ok);
+
+    JsonDocument copy(doc);
+    input[2] = 0;
+
+    REQUIRE(copy.as<MsgPackBinary>().data() != input + 2);
+    REQUIRE(*reinterpret_cast<const uint8_t*>(
+                copy.as<MsgPackBinary>().data()) == 0x2A);
+  }
+
+  SECTION("filter") {
+    char input[] = "\x82\xA1" "a\x01\xA1" "b\x02";
+    JsonDocument filter;
+    filter["b"] = true;
+
+    auto err = deserializeMsgPackZeroCopy(
+        doc, input, sizeof(input) - 1, DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"b\":2}");
+  }
+
+  SECTION("incomplete input") {
+    char string[] = "\xA5hel";
+    const uint8_t binary[] = {0xc4, 0x03, 0x01};
+
+    REQUIRE(deserializeMsgPackZeroCopy(doc, string, 4) ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(deserializeMsgPackZeroCopy(doc, binary, sizeof(binary)) ==
+            DeserializationError::IncompleteInput);
+  }
+}
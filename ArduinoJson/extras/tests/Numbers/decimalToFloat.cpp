@@ -0,0 +1,85 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson/Numbers/decimalToFloat.hpp>
+#include <catch.hpp>
+
+#include <limits>
+
+using namespace ArduinoJson::detail;
+
+template <typename T>
+static T convert(uint64_t mantissa, int exponent) {
+  T result = 42;
+  REQUIRE(decimalToFloat(mantissa, exponent, result));
+  return result;
+}
+
+TEST_CASE("decimalToFloat<double>()") {
+  SECTION("Exact values") {
+    REQUIRE(convert<double>(0, 0) == 0.0);
+    REQUIRE(convert<double>(1, 0) == 1.0);
+    REQUIRE(convert<double>(314, -2) == 3.14);
+    REQUIRE(convert<double>(1, 22) == 1e22);
+    REQUIRE(convert<double>(9007199254740992, 0) == 9007199254740992.0);
+  }
+
+  SECTION("Correctly rounded") {
+    REQUIRE(convert<double>(1, -1) == 0.1);
+    REQUIRE(convert<double>(1, 23) == 1e23);
+    REQUIRE(convert<double>(17976931348623157, 292) ==
+            std::numeric_limits<double>::max());
+    REQUIRE(convert<double>(22250738585072014, -324) ==
+            std::numeric_limits<double>::min());
+    REQUIRE(convert<double>(9007199254740993, 0) == 9007199254740992.0);
+    REQUIRE(convert<double>(9007199254740995, 0) == 9007199254740996.0);
+    REQUIRE(convert<double>(30000000000000004, -17) == 0.30000000000000004);
+  }
+
+  SECTION("Subnormals") {
+    REQUIRE(convert<double>(5, -324) ==
+            std::numeric_limits<double>::denorm_min());
+    REQUIRE(convert<double>(2, -324) == 0.0);
+    REQUIRE(convert<double>(22250738585072009, -324) ==
+            22250738585072009e-324);
+  }
+
+  SECTION("Out of range") {
+    REQUIRE(convert<double>(1, -400) == 0.0);
+    REQUIRE(convert<double>(1, 309) == std::numeric_limits<double>::infinity());
+    REQUIRE(convert<double>(18, 308) ==
+            std::numeric_limits<double>::infinity());
+  }
+}
+
+TEST_CASE("decimalToFloat<float>()") {
+  SECTION("Exact values") {
+    REQUIRE(convert<float>(0, 0) == 0.0f);
+    REQUIRE(convert<float>(15, -1) == 1.5f);
+    REQUIRE(convert<float>(16777216, 0) == 16777216.0f);
+    REQUIRE(convert<float>(661518046875, -7) == 66151.8046875f);
+  }
+
+  SECTION("Correctly rounded") {
+    REQUIRE(convert<float>(1, -1) == 0.1f);
+    REQUIRE(convert<float>(314, -2) == 3.14f);
+    REQUIRE(convert<float>(16777217, 0) == 16777216.0f);
+    REQUIRE(convert<float>(16777219, 0) == 16777220.0f);
+    REQUIRE(convert<float>(34028235, 31) == std::numeric_limits<float>::max());
+    REQUIRE(convert<float>(11754944, -45) == std::numeric_limits<float>::min());
+  }
+
+  SECTION("Subnormals") {
+    REQUIRE(convert<float>(14, -46) ==
+            std::numeric_limits<float>::denorm_min());
+    REQUIRE(convert<float>(7, -46) == 0.0f);
+  }
+
+  SECTION("Out of range") {
+    REQUIRE(convert<float>(1, -66) == 0.0f);
+    REQUIRE(convert<float>(1, 39) == std::numeric_limits<float>::infinity());
+    REQUIRE(convert<float>(34028236, 31) ==
+            std::numeric_limits<float>::infinity());
+  }
+}
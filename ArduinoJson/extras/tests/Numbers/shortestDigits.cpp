@@ -0,0 +1,42 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson/Numbers/shortestDigits.hpp>
+#include <catch.hpp>
+
+#include <limits>
+#include <string>
+
+using namespace ArduinoJson::detail;
+
+template <typename T>
+static void check(T value, const char* digits, int exponent) {
+  CAPTURE(digits);
+  auto result = shortestDigits(value);
+  REQUIRE(std::string(result.digits, result.count) == digits);
+  REQUIRE(result.exponent == exponent);
+}
+
+TEST_CASE("shortestDigits(double)") {
+  check(1.0, "1", 1);
+  check(3.14, "314", 1);
+  check(0.1, "1", 0);
+  check(0.30000000000000004, "30000000000000004", 0);
+  check(123456.0, "123456", 6);
+  check(1e22, "1", 23);
+  check(9007199254740993.0, "9007199254740992", 16);
+  check(std::numeric_limits<double>::max(), "17976931348623157", 309);
+  check(std::numeric_limits<double>::min(), "22250738585072014", -307);
+  check(std::numeric_limits<double>::denorm_min(), "5", -323);
+}
+
+TEST_CASE("shortestDigits(float)") {
+  check(1.0f, "1", 1);
+  check(3.14f, "314", 1);
+  check(0.1f, "1", 0);
+  check(16777216.0f, "16777216", 8);
+  check(std::numeric_limits<float>::max(), "34028235", 39);
+  check(std::numeric_limits<float>::min(), "11754944", -37);
+  check(std::numeric_limits<float>::denorm_min(), "1", -44);
+}
@@ -5,6 +5,7 @@
 #include <ArduinoJson/Memory/ResourceManager.hpp>
 #include <ArduinoJson/Strings/StringAdapters.hpp>
 #include <catch.hpp>
+#include <string>
 
 #include "Allocators.hpp"
 
@@ -67,4 +68,46 @@ TEST_CASE("ResourceManager::saveString()") {
     ResourceManager pool2(FailingAllocator::instance());
     REQUIRE(saveString(pool2, "a") == nullptr);
   }
+
+  SECTION("Deduplicates many strings") {
+    const int n = 10 * ARDUINOJSON_STRING_POOL_HASH_THRESHOLD;
+    std::string strings[n];
+    StringNode* nodes[n];
+    size_t expectedSize = 0;
+    for (int i = 0; i < n; i++) {
+      strings[i] = "string" + std::to_string(i);
+      nodes[i] = saveString(resources, strings[i].c_str());
+      expectedSize += sizeofString(strings[i].size());
+    }
+    for (int i = 0; i < n; i++) {
+      REQUIRE(saveString(resources, strings[i].c_str()) == nodes[i]);
+      REQUIRE(nodes[i]->references == 2);
+    }
+    REQUIRE(resources.size() == expectedSize);
+
+    for (int i = 0; i < n; i += 2) {
+      resources.dereferenceString(nodes[i]);
+      resources.dereferenceString(nodes[i]);
+    }
+    for (int i = 0; i < n; i++) {
+      auto node = resources.getString(adaptString(strings[i].c_str()));
+      REQUIRE(node == (i % 2 ? nodes[i] : nullptr));
+    }
+  }
+
+  SECTION("Keeps working when the bucket table can't be allocated") {
+    TimebombAllocator timebomb(ARDUINOJSON_STRING_POOL_HASH_THRESHOLD + 1);
+    ResourceManager pool2(&timebomb);
+    const int n = ARDUINOJSON_STRING_POOL_HASH_THRESHOLD + 1;
+    std::string strings[n];
+    StringNode* nodes[n];
+    for (int i = 0; i < n; i++) {
+      strings[i] = "string" + std::to_string(i);
+      nodes[i] = saveString(pool2, strings[i].c_str());
+    }
+    for (int i = 0; i < n; i++)
+      REQUIRE(nodes[i] != nullptr);  // but the table couldn't be allocated
+    for (int i = 0; i < n; i++)
+      REQUIRE(saveString(pool2, strings[i].c_str()) == nodes[i]);
+  }
 }
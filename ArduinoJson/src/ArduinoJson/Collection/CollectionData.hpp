@@ -97,6 +97,9 @@ class CollectionData {
   }
 
  protected:
+  iterator createIterator(SlotId slotId,
+                          const ResourceManager* resources) const;
+
   void appendOne(Slot<VariantData> slot, const ResourceManager* resources);
   void appendPair(Slot<VariantData> key, Slot<VariantData> value,
                   const ResourceManager* resources);
@@ -30,6 +30,11 @@ inline CollectionData::iterator CollectionData::createIterator(
   return iterator(resources->getVariant(head_), head_);
 }
 
+inline CollectionData::iterator CollectionData::createIterator(
+    SlotId slotId, const ResourceManager* resources) const {
+  return iterator(resources->getVariant(slotId), slotId);
+}
+
 inline void CollectionData::appendOne(Slot<VariantData> slot,
                                       const ResourceManager* resources) {
   if (tail_ != NULL_SLOT) {
@@ -58,6 +63,9 @@ inline void CollectionData::appendPair(Slot<VariantData> key,
 }
 
 inline void CollectionData::clear(ResourceManager* resources) {
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  resources->invalidateIndex(this);
+#endif
   auto next = head_;
   while (next != NULL_SLOT) {
     auto currId = next;
@@ -104,6 +112,10 @@ inline void CollectionData::removePair(ObjectData::iterator it,
   if (it.done())
     return;
 
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  resources->invalidateIndex(this);
+#endif
+
   auto keySlot = it.slot_;
 
   auto valueId = it.nextId_;
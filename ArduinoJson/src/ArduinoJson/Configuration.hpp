@@ -124,6 +124,21 @@
 #  define ARDUINOJSON_INITIAL_POOL_COUNT 4
 #endif
 
+// Strings of this size or larger go to the large tier of TieredAllocator
+#ifndef ARDUINOJSON_TIERED_ALLOCATOR_THRESHOLD
+#  define ARDUINOJSON_TIERED_ALLOCATOR_THRESHOLD 256
+#endif
+
+// Use the internal RAM and the PSRAM of the ESP32 as the tiers of
+// TieredAllocator
+#ifndef ARDUINOJSON_ENABLE_PSRAM
+#  if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+#    define ARDUINOJSON_ENABLE_PSRAM 1
+#  else
+#    define ARDUINOJSON_ENABLE_PSRAM 0
+#  endif
+#endif
+
 // Automatically call shrinkToFit() from deserializeXxx()
 // Disabled by default on 8-bit platforms because it's not worth the increase in
 // code size
@@ -135,6 +150,26 @@
 #  endif
 #endif
 
+// Index the keys of large objects in a hash table to speed up lookups
+#ifndef ARDUINOJSON_ENABLE_OBJECT_INDEX
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_ENABLE_OBJECT_INDEX 0
+#  else
+#    define ARDUINOJSON_ENABLE_OBJECT_INDEX 1
+#  endif
+#endif
+
+// Number of members a lookup must walk through before the object is indexed
+#ifndef ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+#  define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 16
+#endif
+
+// Number of strings in a document after which the string pool finds
+// duplicates through a hash table instead of a linear search
+#ifndef ARDUINOJSON_STRING_POOL_HASH_THRESHOLD
+#  define ARDUINOJSON_STRING_POOL_HASH_THRESHOLD 16
+#endif
+
 // Number of bytes to store the length of a string
 // https://arduinojson.org/v7/config/string_length_size/
 #ifndef ARDUINOJSON_STRING_LENGTH_SIZE
@@ -238,6 +273,15 @@
 #  define ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD 1e-5
 #endif
 
+// Convert floating-point values with integer-only algorithms (1): the
+// shortest digits that round-trip when serializing (Grisu2), and correctly
+// rounded values when deserializing (Eisel-Lemire).
+// They are faster on MCUs without a double-precision FPU but need ~2KB (float)
+// or ~11KB (double) of tables in flash.
+#ifndef ARDUINOJSON_USE_FAST_FLOAT_ENGINE
+#  define ARDUINOJSON_USE_FAST_FLOAT_ENGINE 0
+#endif
+
 #ifndef ARDUINOJSON_LITTLE_ENDIAN
 #  if defined(_MSC_VER) ||                           \
       (defined(__BYTE_ORDER__) &&                    \
@@ -265,6 +309,16 @@
 #  define ARDUINOJSON_STRING_BUFFER_SIZE 32
 #endif
 
+// Size of the buffer that holds keys, strings, and numbers in JsonPullParser
+// (longer strings cause a NoMemory error unless they are skipped)
+#ifndef ARDUINOJSON_PULL_PARSER_BUFFER_SIZE
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_PULL_PARSER_BUFFER_SIZE 64
+#  else
+#    define ARDUINOJSON_PULL_PARSER_BUFFER_SIZE 256
+#  endif
+#endif
+
 #ifndef ARDUINOJSON_DEBUG
 #  ifdef __PLATFORMIO_BUILD_DEBUG__
 #    define ARDUINOJSON_DEBUG 1
@@ -0,0 +1,321 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Object/JsonObjectConst.hpp>
+#include <ArduinoJson/Polyfills/integer.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+using FilterNodeId = uint16_t;
+
+struct FilterEdge {
+  uint32_t hash;
+  uint16_t keyOffset;
+  uint16_t keyLength;
+  FilterNodeId child;
+};
+
+struct FilterNode {
+  enum {
+    Allow = 1,
+    AllowArray = 2,
+    AllowObject = 4,
+    AllowValue = 8,
+  };
+
+  uint8_t flags;
+  FilterNodeId element;   // the filter for array elements
+  FilterNodeId wildcard;  // the filter for the keys that have no edge
+  uint16_t firstEdge;
+  uint16_t edgeCount;  // the edges are sorted by hash
+};
+
+class FilterState;
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+
+// A Filter compiled into a table of states, with the hashes of the keys
+// computed in advance.
+// Compile it once and pass it to as many deserializeJson() or
+// deserializeMsgPack() calls as needed; the filter document can be
+// destroyed afterward.
+class CompiledFilter {
+  friend class detail::FilterState;
+
+  enum : detail::FilterNodeId {
+    rejectNode = 0,
+    allowAllNode = 1,
+  };
+
+ public:
+  explicit CompiledFilter(
+      JsonVariantConst filter,
+      Allocator* allocator = detail::DefaultAllocator::instance())
+      : allocator_(allocator),
+        buffer_(nullptr),
+        nodes_(builtinNodes()),
+        edges_(nullptr),
+        keys_(nullptr),
+        nodeCount_(2),
+        edgeCount_(0),
+        keyLength_(0),
+        root_(rejectNode),
+        overflowed_(false) {
+    size_t nodes = 2, edges = 0, keys = 0;
+    measure(filter, nodes, edges, keys);
+    if (!allocate(nodes, edges, keys))
+      return;
+    root_ = compile(filter);
+  }
+
+  CompiledFilter(const CompiledFilter&) = delete;
+  CompiledFilter& operator=(const CompiledFilter&) = delete;
+
+  ~CompiledFilter() {
+    if (buffer_)
+      allocator_->deallocate(buffer_);
+  }
+
+  // Returns true if the filter was too large or the allocation failed.
+  // In that case, the filter rejects everything.
+  bool overflowed() const {
+    return overflowed_;
+  }
+
+ private:
+  static const detail::FilterNode* builtinNodes() {
+    using detail::FilterNode;
+    static const FilterNode nodes[] = {
+        {0, rejectNode, rejectNode, 0, 0},
+        {FilterNode::Allow | FilterNode::AllowArray | FilterNode::AllowObject |
+             FilterNode::AllowValue,
+         allowAllNode, allowAllNode, 0, 0},
+    };
+    return nodes;
+  }
+
+  // Same semantics as Filter::operator[]: a null member falls back to "*"
+  static bool hasOwnEdge(JsonPairConst member) {
+    return !member.value().isNull() && member.key() != "*";
+  }
+
+  static void measure(JsonVariantConst filter, size_t& nodes, size_t& edges,
+                      size_t& keys) {
+    if (filter.isNull() || filter == true)
+      return;
+    nodes++;
+    if (filter.is<JsonObjectConst>()) {
+      for (JsonPairConst member : filter.as<JsonObjectConst>()) {
+        if (hasOwnEdge(member)) {
+          edges++;
+          keys += member.key().size();
+        }
+        measure(member.value(), nodes, edges, keys);
+      }
+    } else if (filter.is<JsonArrayConst>()) {
+      measure(filter[0], nodes, edges, keys);
+    }
+  }
+
+  bool allocate(size_t nodes, size_t edges, size_t keys) {
+    const size_t limit = detail::FilterNodeId(-1);
+    if (nodes > limit || edges > limit || keys > limit) {
+      overflowed_ = true;
+      return false;
+    }
+    // edges first, because they have the strictest alignment
+    size_t size = edges * sizeof(detail::FilterEdge) +
+                  nodes * sizeof(detail::FilterNode) + keys;
+    buffer_ = allocator_->allocate(size);
+    if (!buffer_) {
+      overflowed_ = true;
+      return false;
+    }
+    auto p = reinterpret_cast<char*>(buffer_);
+    edges_ = reinterpret_cast<detail::FilterEdge*>(p);
+    p += edges * sizeof(detail::FilterEdge);
+    auto nodeArray = reinterpret_cast<detail::FilterNode*>(p);
+    nodeArray[rejectNode] = builtinNodes()[rejectNode];
+    nodeArray[allowAllNode] = builtinNodes()[allowAllNode];
+    nodes_ = nodeArray;
+    keys_ = p + nodes * sizeof(detail::FilterNode);
+    return true;
+  }
+
+  detail::FilterNodeId compile(JsonVariantConst filter) {
+    using detail::FilterNode;
+
+    if (filter == true)
+      return allowAllNode;
+    if (filter.isNull())
+      return rejectNode;
+
+    Filter reference(filter);
+    detail::FilterNodeId id = nodeCount_++;
+    FilterNode node;
+    node.flags = 0;
+    if (reference.allow())
+      node.flags |= FilterNode::Allow;
+    if (reference.allowArray())
+      node.flags |= FilterNode::AllowArray;
+    if (reference.allowObject())
+      node.flags |= FilterNode::AllowObject;
+    if (reference.allowValue())
+      node.flags |= FilterNode::AllowValue;
+    node.element = rejectNode;
+    node.wildcard = rejectNode;
+    node.firstEdge = edgeCount_;
+    node.edgeCount = 0;
+
+    if (filter.is<JsonObjectConst>()) {
+      JsonObjectConst object = filter.as<JsonObjectConst>();
+      // reserve the edges of this node before the children take theirs
+      for (JsonPairConst member : object) {
+        if (hasOwnEdge(member))
+          edgeCount_++;
+      }
+      for (JsonPairConst member : object) {
+        if (hasOwnEdge(member) && !findEdge(node, member.key()))
+          addEdge(node, member.key(), compile(member.value()));
+      }
+      // an object filter looks up "*" for array elements too
+      node.wildcard = compile(filter["*"]);
+      node.element = node.wildcard;
+    } else if (filter.is<JsonArrayConst>()) {
+      node.element = compile(filter[0]);
+    }
+
+    const_cast<FilterNode*>(nodes_)[id] = node;
+    return id;
+  }
+
+  bool findEdge(const detail::FilterNode& node, JsonString key) const {
+    auto adapted = detail::adaptString(key.c_str(), key.size());
+    return findEdge(node, adapted, detail::stringHash(adapted)) != nullptr;
+  }
+
+  template <typename TAdaptedString>
+  const detail::FilterEdge* findEdge(const detail::FilterNode& node,
+                                     TAdaptedString key, uint32_t hash) const {
+    // binary search for the first edge with this hash
+    size_t lo = node.firstEdge, hi = lo + node.edgeCount;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (edges_[mid].hash < hash)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    for (size_t i = lo; i < size_t(node.firstEdge + node.edgeCount); i++) {
+      const detail::FilterEdge& edge = edges_[i];
+      if (edge.hash != hash)
+        break;
+      if (detail::stringEquals(
+              key, detail::adaptString(keys_ + edge.keyOffset, edge.keyLength)))
+        return &edge;
+    }
+    return nullptr;
+  }
+
+  void addEdge(detail::FilterNode& node, JsonString key,
+               detail::FilterNodeId child) {
+    detail::FilterEdge edge;
+    auto adapted = detail::adaptString(key.c_str(), key.size());
+    edge.hash = detail::stringHash(adapted);
+    edge.keyOffset = keyLength_;
+    edge.keyLength = uint16_t(key.size());
+    for (size_t i = 0; i < key.size(); i++)
+      keys_[keyLength_++] = key.c_str()[i];
+    edge.child = child;
+
+    // insertion sort, filters are small
+    size_t i = size_t(node.firstEdge + node.edgeCount);
+    while (i > node.firstEdge && edges_[i - 1].hash > edge.hash) {
+      edges_[i] = edges_[i - 1];
+      i--;
+    }
+    edges_[i] = edge;
+    node.edgeCount++;
+  }
+
+  Allocator* allocator_;
+  void* buffer_;
+  const detail::FilterNode* nodes_;
+  detail::FilterEdge* edges_;
+  char* keys_;
+  detail::FilterNodeId nodeCount_;
+  uint16_t edgeCount_;
+  uint16_t keyLength_;
+  detail::FilterNodeId root_;
+  bool overflowed_;
+};
+
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The position of the parser in a CompiledFilter.
+// It's what deserializeJson() passes down the recursion, in place of a Filter.
+class FilterState {
+ public:
+  FilterState(const DeserializationOption::CompiledFilter& filter)
+      : filter_(&filter), id_(filter.root_) {}
+
+  bool allow() const {
+    return (node().flags & FilterNode::Allow) != 0;
+  }
+
+  bool allowArray() const {
+    return (node().flags & FilterNode::AllowArray) != 0;
+  }
+
+  bool allowObject() const {
+    return (node().flags & FilterNode::AllowObject) != 0;
+  }
+
+  bool allowValue() const {
+    return (node().flags & FilterNode::AllowValue) != 0;
+  }
+
+  template <typename TIndex>
+  enable_if_t<is_integral<TIndex>::value, FilterState> operator[](
+      TIndex) const {
+    return FilterState(filter_, node().element);
+  }
+
+  FilterState operator[](const char* key) const {
+    const FilterNode& n = node();
+    if (n.edgeCount == 0)
+      return FilterState(filter_, n.wildcard);
+    auto adapted = adaptString(key);
+    auto edge = filter_->findEdge(n, adapted, stringHash(adapted));
+    return FilterState(filter_, edge ? edge->child : n.wildcard);
+  }
+
+ private:
+  FilterState(const DeserializationOption::CompiledFilter* filter,
+              FilterNodeId id)
+      : filter_(filter), id_(id) {}
+
+  const FilterNode& node() const {
+    return filter_->nodes_[id_];
+  }
+
+  const DeserializationOption::CompiledFilter* filter_;
+  FilterNodeId id_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
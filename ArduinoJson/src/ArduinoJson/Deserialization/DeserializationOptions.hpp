@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/CompiledFilter.hpp>
 #include <ArduinoJson/Deserialization/Filter.hpp>
 #include <ArduinoJson/Deserialization/NestingLimit.hpp>
 
@@ -17,16 +18,30 @@ struct DeserializationOptions {
 
 template <typename TFilter>
 inline DeserializationOptions<TFilter> makeDeserializationOptions(
-    TFilter filter, DeserializationOption::NestingLimit nestingLimit = {}) {
+    const TFilter& filter,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
   return {filter, nestingLimit};
 }
 
 template <typename TFilter>
 inline DeserializationOptions<TFilter> makeDeserializationOptions(
-    DeserializationOption::NestingLimit nestingLimit, TFilter filter) {
+    DeserializationOption::NestingLimit nestingLimit, const TFilter& filter) {
   return {filter, nestingLimit};
 }
 
+// A CompiledFilter is passed by reference, the parser only gets its state
+inline DeserializationOptions<FilterState> makeDeserializationOptions(
+    const DeserializationOption::CompiledFilter& filter,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  return {FilterState(filter), nestingLimit};
+}
+
+inline DeserializationOptions<FilterState> makeDeserializationOptions(
+    DeserializationOption::NestingLimit nestingLimit,
+    const DeserializationOption::CompiledFilter& filter) {
+  return {FilterState(filter), nestingLimit};
+}
+
 inline DeserializationOptions<AllowAllFilter> makeDeserializationOptions(
     DeserializationOption::NestingLimit nestingLimit = {}) {
   return {{}, nestingLimit};
@@ -60,7 +60,7 @@ template <template <typename> class TDeserializer, typename TDestination,
           typename = enable_if_t<  // issue #1897
               !is_integral<typename first_or_void<Args...>::type>::value>>
 DeserializationError deserialize(TDestination&& dst, TStream&& input,
-                                 Args... args) {
+                                 const Args&... args) {
   return doDeserialize<TDeserializer>(
       dst, makeReader(detail::forward<TStream>(input)),
       makeDeserializationOptions(args...));
@@ -70,7 +70,7 @@ template <template <typename> class TDeserializer, typename TDestination,
           typename TChar, typename Size, typename... Args,
           typename = enable_if_t<is_integral<Size>::value>>
 DeserializationError deserialize(TDestination&& dst, TChar* input,
-                                 Size inputSize, Args... args) {
+                                 Size inputSize, const Args&... args) {
   return doDeserialize<TDeserializer>(dst, makeReader(input, size_t(inputSize)),
                                       makeDeserializationOptions(args...));
 }
@@ -0,0 +1,513 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonPullParser.hpp>
+#include <ArduinoJson/Json/TextFormatter.hpp>
+#include <ArduinoJson/Object/JsonObject.hpp>
+#include <ArduinoJson/Polyfills/preprocessor.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
+#include <ArduinoJson/Serialization/Writers/DummyWriter.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+#include <string.h>  // memcpy
+
+// Binds the members of a struct to the keys of a JSON object, so that
+// serializeJson(), deserializeJson() and measureJson() convert the struct
+// directly, without a JsonDocument.
+// It also defines the functions of a custom converter, so that the struct
+// can be used with JsonVariant::set() and as<T>().
+// Use it in the namespace of the struct; up to 16 members.
+//
+//   struct Telemetry { float temperature; int rssi; char name[16]; };
+//   ARDUINOJSON_BIND(Telemetry, temperature, rssi, name)
+#define ARDUINOJSON_BIND(T, ...)                                              \
+  template <typename TVisitor>                                                \
+  inline bool arduinoJsonVisitFields(T& obj, TVisitor& visitor) {             \
+    return ARDUINOJSON_BIND_FOR_EACH(ARDUINOJSON_BIND_FIELD,                 \
+                                     __VA_ARGS__) true;                       \
+  }                                                                           \
+  template <typename TVisitor>                                                \
+  inline bool arduinoJsonVisitFields(const T& obj, TVisitor& visitor) {       \
+    return ARDUINOJSON_BIND_FOR_EACH(ARDUINOJSON_BIND_FIELD,                 \
+                                     __VA_ARGS__) true;                       \
+  }                                                                           \
+  inline void convertToJson(const T& src, ArduinoJson::JsonVariant dst) {     \
+    ArduinoJson::detail::bindingToJson(src, dst);                             \
+  }                                                                           \
+  inline void convertFromJson(ArduinoJson::JsonVariantConst src, T& dst) {    \
+    ArduinoJson::detail::bindingFromJson(src, dst);                           \
+  }                                                                           \
+  inline bool canConvertFromJson(ArduinoJson::JsonVariantConst src,           \
+                                 const T&) {                                  \
+    return src.is<ArduinoJson::JsonObjectConst>();                            \
+  }
+
+// The hash is a template argument, so it's computed at compile time
+#define ARDUINOJSON_BIND_FIELD(field)                                    \
+  visitor(ArduinoJson::detail::BindingKey{                               \
+              #field, ArduinoJson::detail::integral_constant<            \
+                          uint32_t, ArduinoJson::detail::constStringHash( \
+                                        #field)>::value},                \
+          obj.field) &&
+
+#define ARDUINOJSON_BIND_EXPAND(x) x
+#define ARDUINOJSON_BIND_COUNT(...)                                          \
+  ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_COUNT_(                           \
+      __VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+#define ARDUINOJSON_BIND_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, \
+                                _12, _13, _14, _15, _16, N, ...)              \
+  N
+#define ARDUINOJSON_BIND_FOR_EACH(m, ...)                                 \
+  ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_CONCAT2(                            \
+      ARDUINOJSON_BIND_FOR_EACH_, ARDUINOJSON_BIND_COUNT(__VA_ARGS__))(m, \
+                                                                 __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_1(m, a) m(a)
+#define ARDUINOJSON_BIND_FOR_EACH_2(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_1(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_3(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_2(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_4(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_3(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_5(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_4(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_6(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_5(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_7(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_6(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_8(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_7(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_9(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_8(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_10(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_9(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_11(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_10(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_12(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_11(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_13(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_12(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_14(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_13(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_15(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_14(m, __VA_ARGS__))
+#define ARDUINOJSON_BIND_FOR_EACH_16(m, a, ...) \
+  m(a) ARDUINOJSON_BIND_EXPAND(ARDUINOJSON_BIND_FOR_EACH_15(m, __VA_ARGS__))
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Same as stringHash(), but usable in constant expressions
+constexpr uint32_t constStringHash(const char* s,
+                                   uint32_t hash = 2166136261u) {
+  return *s ? constStringHash(s + 1, (hash ^ uint8_t(*s)) * 16777619u) : hash;
+}
+
+struct BindingKey {
+  const char* name;
+  uint32_t hash;
+};
+
+struct BindingProbe {
+  template <typename T>
+  bool operator()(BindingKey, T&) {
+    return true;
+  }
+};
+
+// True for the types declared with ARDUINOJSON_BIND()
+template <typename T, typename = void>
+struct IsBound : false_type {};
+
+template <typename T>
+struct IsBound<T, void_t<decltype(arduinoJsonVisitFields(
+                      declval<T&>(), declval<BindingProbe&>()))>>
+    : true_type {};
+
+// Writes a bound struct as a minified JSON object
+template <typename TWriter>
+class BindingSerializer {
+ public:
+  explicit BindingSerializer(TWriter writer) : formatter_(writer) {}
+
+  template <typename T>
+  enable_if_t<IsBound<T>::value> write(const T& object) {
+    formatter_.writeRaw('{');
+    MemberWriter writer(this);
+    arduinoJsonVisitFields(object, writer);
+    formatter_.writeRaw('}');
+  }
+
+  template <typename T, size_t N>
+  void write(const T (&array)[N]) {
+    formatter_.writeRaw('[');
+    for (size_t i = 0; i < N; i++) {
+      if (i)
+        formatter_.writeRaw(',');
+      write(array[i]);
+    }
+    formatter_.writeRaw(']');
+  }
+
+  template <size_t N>
+  void write(const char (&value)[N]) {
+    size_t n = 0;
+    while (n < N && value[n])
+      n++;
+    formatter_.writeString(value, n);
+  }
+
+  template <typename T>
+  enable_if_t<IsString<T>::value && !is_array<T>::value> write(
+      const T& value) {
+    auto s = adaptString(value);
+    if (s.isNull())
+      formatter_.writeRaw("null");
+    else
+      formatter_.writeString(s.data(), s.size());
+  }
+
+  void write(bool value) {
+    formatter_.writeBoolean(value);
+  }
+
+  template <typename T>
+  enable_if_t<is_integral<T>::value && !is_same<T, bool>::value> write(
+      T value) {
+    formatter_.writeInteger(value);
+  }
+
+  template <typename T>
+  enable_if_t<is_floating_point<T>::value> write(T value) {
+    formatter_.writeFloat(value);
+  }
+
+  size_t bytesWritten() const {
+    return formatter_.bytesWritten();
+  }
+
+ private:
+  class MemberWriter {
+   public:
+    MemberWriter(BindingSerializer* serializer)
+        : serializer_(serializer), first_(true) {}
+
+    template <typename T>
+    bool operator()(BindingKey key, const T& value) {
+      auto& formatter = serializer_->formatter_;
+      if (!first_)
+        formatter.writeRaw(',');
+      first_ = false;
+      formatter.writeString(key.name);  // member names need no escaping
+      formatter.writeRaw(':');
+      serializer_->write(value);
+      return true;
+    }
+
+   private:
+    BindingSerializer* serializer_;
+    bool first_;
+  };
+
+  TextFormatter<TWriter> formatter_;
+};
+
+// Reads a JSON object into a bound struct, from a JsonPullParser.
+// Unknown keys are skipped, missing keys and values of the wrong type leave
+// the member unchanged.
+template <typename TParser>
+class BindingDeserializer {
+ public:
+  explicit BindingDeserializer(TParser& parser) : parser_(parser) {}
+
+  // Reads the value that the parser just started
+  template <typename T>
+  enable_if_t<IsBound<T>::value, DeserializationError> read(T& object) {
+    if (parser_.event() != JsonPullEvent::StartObject)
+      return skip();
+    for (;;) {
+      auto event = parser_.next();
+      if (event == JsonPullEvent::EndObject)
+        return DeserializationError::Ok;
+      if (event != JsonPullEvent::Key)
+        return parser_.error();
+      JsonString key = parser_.string();
+      SizedRamString adaptedKey(key.c_str(), key.size());
+      MemberReader reader(this, adaptedKey, stringHash(adaptedKey));
+      arduinoJsonVisitFields(object, reader);
+      auto err = reader.found() ? reader.error() : parser_.skip();
+      if (err)
+        return err;
+    }
+  }
+
+  template <typename T, size_t N>
+  DeserializationError read(T (&array)[N]) {
+    if (parser_.event() != JsonPullEvent::StartArray)
+      return skip();
+    for (size_t i = 0;; i++) {
+      auto event = parser_.next();
+      if (event == JsonPullEvent::EndArray)
+        return DeserializationError::Ok;
+      auto err = i < N ? read(array[i]) : skip();
+      if (err)
+        return err;
+    }
+  }
+
+  template <size_t N>
+  DeserializationError read(char (&value)[N]) {
+    if (parser_.event() != JsonPullEvent::String)
+      return skip();
+    JsonString s = parser_.string();
+    size_t n = s.size() < N - 1 ? s.size() : N - 1;
+    memcpy(value, s.c_str(), n);
+    value[n] = 0;
+    return DeserializationError::Ok;
+  }
+
+#if ARDUINOJSON_ENABLE_STD_STRING
+  DeserializationError read(std::string& value) {
+    if (parser_.event() != JsonPullEvent::String)
+      return skip();
+    JsonString s = parser_.string();
+    value.assign(s.c_str(), s.size());
+    return DeserializationError::Ok;
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_ARDUINO_STRING
+  DeserializationError read(::String& value) {
+    if (parser_.event() != JsonPullEvent::String)
+      return skip();
+    value = parser_.string().c_str();
+    return DeserializationError::Ok;
+  }
+#endif
+
+  DeserializationError read(bool& value) {
+    if (parser_.event() != JsonPullEvent::Boolean)
+      return skip();
+    value = parser_.asBoolean();
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  enable_if_t<is_integral<T>::value || is_floating_point<T>::value,
+              DeserializationError>
+  read(T& value) {
+    if (parser_.event() != JsonPullEvent::Number)
+      return skip();
+    value = parser_.template as<T>();
+    return DeserializationError::Ok;
+  }
+
+ private:
+  class MemberReader {
+   public:
+    MemberReader(BindingDeserializer* deserializer, SizedRamString key,
+                 uint32_t hash)
+        : deserializer_(deserializer),
+          key_(key),
+          hash_(hash),
+          found_(false),
+          error_(DeserializationError::Ok) {}
+
+    template <typename T>
+    bool operator()(BindingKey key, T& value) {
+      if (key.hash != hash_ || !stringEquals(key_, adaptString(key.name)))
+        return true;
+      found_ = true;
+      deserializer_->parser_.next();
+      error_ = deserializer_->read(value);
+      return false;  // stop looking
+    }
+
+    bool found() const {
+      return found_;
+    }
+
+    DeserializationError error() const {
+      return error_;
+    }
+
+   private:
+    BindingDeserializer* deserializer_;
+    SizedRamString key_;
+    uint32_t hash_;
+    bool found_;
+    DeserializationError error_;
+  };
+
+  // Skips the value that the parser just started
+  DeserializationError skip() {
+    if (parser_.event() == JsonPullEvent::Error)
+      return parser_.error();
+    if (parser_.event() == JsonPullEvent::StartObject ||
+        parser_.event() == JsonPullEvent::StartArray)
+      return parser_.skip();
+    return DeserializationError::Ok;
+  }
+
+  TParser& parser_;
+};
+
+template <typename T, typename TParser>
+DeserializationError deserializeBinding(T& object, TParser parser) {
+  parser.next();
+  BindingDeserializer<TParser> deserializer(parser);
+  auto err = deserializer.read(object);
+  if (err)
+    return err;
+  if (parser.next() != JsonPullEvent::End)
+    return parser.error() ? parser.error() : DeserializationError::InvalidInput;
+  return DeserializationError::Ok;
+}
+
+template <typename T, typename TWriter>
+size_t serializeBinding(const T& object, TWriter writer) {
+  BindingSerializer<TWriter> serializer(writer);
+  serializer.write(object);
+  return serializer.bytesWritten();
+}
+
+class BindingVariantWriter {
+ public:
+  BindingVariantWriter(JsonObject object) : object_(object) {}
+
+  template <typename T>
+  bool operator()(BindingKey key, const T& value) {
+    set(object_[JsonString(key.name)], value);
+    return true;
+  }
+
+ private:
+  // TDestination is a MemberProxy or a JsonVariant
+  template <typename TDestination, typename T>
+  static void set(TDestination dst, const T& value) {
+    dst.set(value);
+  }
+
+  template <typename TDestination, typename T, size_t N>
+  static enable_if_t<!is_same<T, char>::value> set(TDestination dst,
+                                                   const T (&array)[N]) {
+    JsonArray elements = dst.template to<JsonArray>();
+    for (size_t i = 0; i < N; i++)
+      set(elements.add<JsonVariant>(), array[i]);
+  }
+
+  JsonObject object_;
+};
+
+class BindingVariantReader {
+ public:
+  BindingVariantReader(JsonObjectConst object) : object_(object) {}
+
+  template <typename T>
+  bool operator()(BindingKey key, T& value) {
+    JsonVariantConst src = object_[JsonString(key.name)];
+    if (!src.isNull())
+      get(src, value);
+    return true;
+  }
+
+ private:
+  template <typename T>
+  static void get(JsonVariantConst src, T& value) {
+    value = src.as<T>();
+  }
+
+  template <size_t N>
+  static void get(JsonVariantConst src, char (&value)[N]) {
+    JsonString s = src.as<JsonString>();
+    size_t n = s.size() < N - 1 ? s.size() : N - 1;
+    if (n)
+      memcpy(value, s.c_str(), n);
+    value[n] = 0;
+  }
+
+  template <typename T, size_t N>
+  static enable_if_t<!is_same<T, char>::value> get(JsonVariantConst src,
+                                                   T (&array)[N]) {
+    JsonArrayConst elements = src.as<JsonArrayConst>();
+    for (size_t i = 0; i < N && i < elements.size(); i++)
+      get(elements[i], array[i]);
+  }
+
+  JsonObjectConst object_;
+};
+
+template <typename T>
+void bindingToJson(const T& src, JsonVariant dst) {
+  BindingVariantWriter writer(dst.to<JsonObject>());
+  arduinoJsonVisitFields(src, writer);
+}
+
+template <typename T>
+void bindingFromJson(JsonVariantConst src, T& dst) {
+  BindingVariantReader reader(src.as<JsonObjectConst>());
+  arduinoJsonVisitFields(dst, reader);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Writes a struct declared with ARDUINOJSON_BIND() as a minified JSON object.
+template <typename T, typename TDestination>
+detail::enable_if_t<detail::IsBound<T>::value &&
+                        !detail::is_pointer<TDestination>::value,
+                    size_t>
+serializeJson(const T& source, TDestination& destination) {
+  using namespace detail;
+  return serializeBinding(source, Writer<TDestination>(destination));
+}
+
+// Writes a struct declared with ARDUINOJSON_BIND() as a minified JSON object.
+template <typename T>
+detail::enable_if_t<detail::IsBound<T>::value, size_t> serializeJson(
+    const T& source, void* buffer, size_t bufferSize) {
+  using namespace detail;
+  StaticStringWriter writer(reinterpret_cast<char*>(buffer), bufferSize);
+  size_t n = serializeBinding(source, writer);
+  if (n < bufferSize)
+    reinterpret_cast<char*>(buffer)[n] = 0;
+  return n;
+}
+
+// Computes the length of the JSON object that serializeJson() produces.
+template <typename T>
+detail::enable_if_t<detail::IsBound<T>::value, size_t> measureJson(
+    const T& source) {
+  using namespace detail;
+  return serializeBinding(source, DummyWriter());
+}
+
+// Reads a JSON object into a struct declared with ARDUINOJSON_BIND().
+// The members are written as the input is parsed; unknown keys are skipped.
+// Strings must fit in ARDUINOJSON_PULL_PARSER_BUFFER_SIZE.
+template <typename T, typename TInput>
+detail::enable_if_t<detail::IsBound<T>::value, DeserializationError>
+deserializeJson(T& destination, TInput&& input) {
+  using namespace detail;
+  return deserializeBinding(destination,
+                            makeJsonPullParser(detail::forward<TInput>(input)));
+}
+
+template <typename T, typename TChar>
+detail::enable_if_t<detail::IsBound<T>::value, DeserializationError>
+deserializeJson(T& destination, TChar* input) {
+  using namespace detail;
+  return deserializeBinding(destination, makeJsonPullParser(input));
+}
+
+template <typename T, typename TChar>
+detail::enable_if_t<detail::IsBound<T>::value, DeserializationError>
+deserializeJson(T& destination, TChar* input, size_t inputSize) {
+  using namespace detail;
+  return deserializeBinding(destination, makeJsonPullParser(input, inputSize));
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,267 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/TextFormatter.hpp>
+#include <ArduinoJson/Serialization/Writers/StaticStringWriter.hpp>
+#include <ArduinoJson/Variant/JsonVariantConst.hpp>
+#include <ArduinoJson/Variant/VariantDataVisitor.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Produces the same minified JSON as serializeJson(), one buffer at a time.
+// Each call to fill() resumes where the previous one stopped, so you can
+// hand out the document in fixed-size network buffers, without measuring it
+// first or building a String.
+// The document must not be modified until done() returns true.
+class JsonChunkedSerializer {
+ public:
+  // Maximum nesting; deeper arrays and objects are written as null, and
+  // overflowed() returns true.
+  static constexpr uint8_t maxDepth = 32;
+
+  explicit JsonChunkedSerializer(JsonVariantConst source)
+      : resources_(detail::VariantAttorney::getResourceManager(source)),
+        value_(detail::VariantAttorney::getData(source)),
+        string_(nullptr),
+        stringSize_(0),
+        state_(State::Value),
+        depth_(0),
+        pendingSize_(0),
+        pendingPos_(0),
+        overflowed_(false) {}
+
+  // Writes the next part of the document in the buffer.
+  // Returns the number of bytes written, which is only less than capacity
+  // at the end of the document.
+  size_t fill(void* buffer, size_t capacity) {
+    char* p = reinterpret_cast<char*>(buffer);
+    char* end = p + capacity;
+    while (p < end) {
+      if (pendingPos_ < pendingSize_) {
+        *p++ = pending_[pendingPos_++];
+        continue;
+      }
+      if (state_ == State::String || state_ == State::RawString) {
+        p = copyString(p, end);
+        continue;
+      }
+      if (!step())
+        break;
+    }
+    return size_t(p - reinterpret_cast<char*>(buffer));
+  }
+
+  // Returns true when the whole document was written.
+  bool done() const {
+    return state_ == State::Done && pendingPos_ == pendingSize_;
+  }
+
+  bool overflowed() const {
+    return overflowed_;
+  }
+
+ private:
+  enum class State : uint8_t {
+    Value,      // value_ must be written
+    Next,       // after a value in an array or an object
+    String,     // in the characters of string_
+    RawString,  // same without escaping
+    Done,
+  };
+
+  struct Frame {
+    detail::SlotId next;
+    bool isObject;
+    bool isKey;  // the next slot is a key
+    bool first;
+  };
+
+  class ValueVisitor : public detail::VariantDataVisitor<bool> {
+   public:
+    ValueVisitor(JsonChunkedSerializer* serializer) : self_(serializer) {}
+
+    bool visit(const detail::ArrayData& array) {
+      return self_->startCollection(array, false);
+    }
+
+    bool visit(const detail::ObjectData& object) {
+      return self_->startCollection(object, true);
+    }
+
+    bool visit(JsonString value) {
+      self_->startString(value.c_str(), value.size(), true);
+      return true;
+    }
+
+    bool visit(RawString value) {
+      self_->startString(value.data(), value.size(), false);
+      return true;
+    }
+
+    template <typename T>
+    detail::enable_if_t<detail::is_floating_point<T>::value, bool> visit(
+        T value) {
+      auto formatter = self_->startPending();
+      formatter.writeFloat(value);
+      return self_->endScalar(formatter);
+    }
+
+    bool visit(JsonInteger value) {
+      auto formatter = self_->startPending();
+      formatter.writeInteger(value);
+      return self_->endScalar(formatter);
+    }
+
+    bool visit(JsonUInt value) {
+      auto formatter = self_->startPending();
+      formatter.writeInteger(value);
+      return self_->endScalar(formatter);
+    }
+
+    bool visit(bool value) {
+      auto formatter = self_->startPending();
+      formatter.writeBoolean(value);
+      return self_->endScalar(formatter);
+    }
+
+    bool visit(detail::nullptr_t) {
+      auto formatter = self_->startPending();
+      formatter.writeRaw("null");
+      return self_->endScalar(formatter);
+    }
+
+   private:
+    JsonChunkedSerializer* self_;
+  };
+
+  using Formatter = detail::TextFormatter<detail::StaticStringWriter>;
+
+  // Formats a token in the pending buffer
+  Formatter startPending() {
+    return Formatter(detail::StaticStringWriter(pending_, sizeof(pending_)));
+  }
+
+  bool endPending(const Formatter& formatter) {
+    pendingSize_ = uint8_t(formatter.bytesWritten());
+    pendingPos_ = 0;
+    return true;
+  }
+
+  void setPending(char c) {
+    pending_[0] = c;
+    pendingSize_ = 1;
+    pendingPos_ = 0;
+  }
+
+  // Produces the next token, returns false at the end of the document.
+  bool step() {
+    switch (state_) {
+      case State::Value: {
+        ValueVisitor visitor(this);
+        return detail::VariantData::accept(value_, resources_, visitor);
+      }
+
+      case State::Next: {
+        Frame& frame = stack_[depth_ - 1];
+        if (frame.next == detail::NULL_SLOT) {
+          setPending(frame.isObject ? '}' : ']');
+          depth_--;
+          endValue();
+          return true;
+        }
+        value_ = resources_->getVariant(frame.next);
+        frame.next = value_->next();
+        state_ = State::Value;
+        bool first = frame.first;
+        bool isKey = frame.isKey;
+        frame.first = false;
+        if (frame.isObject)
+          frame.isKey = !frame.isKey;
+        if (!first)
+          setPending(frame.isObject && !isKey ? ':' : ',');
+        return true;
+      }
+
+      default:
+        return false;
+    }
+  }
+
+  template <typename TCollection>
+  bool startCollection(const TCollection& collection, bool isObject) {
+    if (depth_ >= maxDepth) {
+      overflowed_ = true;
+      auto formatter = startPending();
+      formatter.writeRaw("null");
+      return endScalar(formatter);
+    }
+    Frame& frame = stack_[depth_++];
+    frame.next = collection.head();
+    frame.isObject = isObject;
+    frame.isKey = true;
+    frame.first = true;
+    setPending(isObject ? '{' : '[');
+    state_ = State::Next;
+    return true;
+  }
+
+  void startString(const char* s, size_t n, bool escape) {
+    string_ = s;
+    stringSize_ = n;
+    state_ = escape ? State::String : State::RawString;
+    if (escape)
+      setPending('\"');
+  }
+
+  // Copies the characters that need no escaping straight to the output
+  char* copyString(char* p, char* end) {
+    bool escape = state_ == State::String;
+    while (p < end && stringSize_) {
+      char c = *string_;
+      if (escape && (c == 0 || detail::EscapeSequence::escapeChar(c))) {
+        auto formatter = startPending();
+        formatter.writeChar(c);
+        endPending(formatter);
+        string_++;
+        stringSize_--;
+        return p;
+      }
+      *p++ = c;
+      string_++;
+      stringSize_--;
+    }
+    if (!stringSize_) {
+      endValue();
+      if (escape)
+        setPending('\"');
+    }
+    return p;
+  }
+
+  bool endScalar(const Formatter& formatter) {
+    endValue();
+    return endPending(formatter);
+  }
+
+  void endValue() {
+    state_ = depth_ ? State::Next : State::Done;
+  }
+
+  const detail::ResourceManager* resources_;
+  const detail::VariantData* value_;
+  const char* string_;
+  size_t stringSize_;
+  Frame stack_[maxDepth];
+  State state_;
+  uint8_t depth_;
+  uint8_t pendingSize_;
+  uint8_t pendingPos_;
+  bool overflowed_;
+  char pending_[32];  // the part of the last token that didn't fit
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
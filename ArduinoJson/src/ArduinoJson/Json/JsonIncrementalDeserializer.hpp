@@ -0,0 +1,541 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/Utf16.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Memory/StringBuilder.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A JSON deserializer that receives its input in chunks.
+// Unlike deserializeJson(), it doesn't need the whole input in one buffer:
+// call feed() for each piece as it arrives (for example, from a TCP
+// callback), then finish() at the end of the input.
+// The document is built as the chunks come, so the input is never copied.
+class JsonIncrementalDeserializer {
+ public:
+  // Maximum nesting, whatever the NestingLimit says
+  static constexpr uint8_t maxDepth = 32;
+
+  template <typename TDestination,
+            typename = detail::enable_if_t<
+                detail::is_deserialize_destination<TDestination>::value>>
+  explicit JsonIncrementalDeserializer(
+      TDestination&& dst, DeserializationOption::NestingLimit nestingLimit = {})
+      : resources_(detail::VariantAttorney::getResourceManager(dst)),
+        root_(detail::VariantAttorney::getOrCreateData(dst)),
+        stringBuilder_(resources_),
+        error_(DeserializationError::Ok),
+        state_(State::Value),
+        comment_(Comment::None),
+        depth_(0),
+        maxDepth_(0),
+        tokenSize_(0),
+        stopChar_(0),
+        isKey_(false),
+        foundSomething_(false),
+        shrinkWhenDone_(isDocument<TDestination>()) {
+    if (!root_) {
+      fail(DeserializationError::NoMemory);
+      return;
+    }
+    dst.clear();
+    while (!nestingLimit.reached() && maxDepth_ < maxDepth) {
+      nestingLimit = nestingLimit.decrement();
+      maxDepth_++;
+    }
+  }
+
+  JsonIncrementalDeserializer(const JsonIncrementalDeserializer&) = delete;
+  JsonIncrementalDeserializer& operator=(const JsonIncrementalDeserializer&) =
+      delete;
+
+  // Parses the next piece of the input.
+  // Returns DeserializationError::Ok, even if the value isn't complete yet,
+  // unless the input is invalid.
+  // Like with deserializeJson(), a '\0' marks the end of the input.
+  DeserializationError feed(const char* data, size_t length) {
+    for (size_t i = 0; i < length && state_ != State::Error; i++) {
+      if (data[i] == '\0')
+        return finish();
+      auto err = consume(data[i]);
+      if (err)
+        fail(err);
+    }
+    return error_;
+  }
+
+  DeserializationError feed(const uint8_t* data, size_t length) {
+    return feed(reinterpret_cast<const char*>(data), length);
+  }
+
+  // Signals the end of the input.
+  // Returns the same error as deserializeJson() would have returned with the
+  // whole input.
+  DeserializationError finish() {
+    if (state_ == State::Error || state_ == State::Done)
+      return error_;
+    if (state_ == State::Number && depth_ == 0) {
+      auto err = endNumber();
+      if (err)
+        fail(err);
+      return error_;
+    }
+    fail(foundSomething_ ? DeserializationError::IncompleteInput
+                         : DeserializationError::EmptyInput);
+    return error_;
+  }
+
+  // Returns true once a complete value was parsed.
+  bool done() const {
+    return state_ == State::Done;
+  }
+
+  DeserializationError error() const {
+    return error_;
+  }
+
+ private:
+  enum class State : uint8_t {
+    Value,        // before a value
+    ObjectFirst,  // after '{'
+    ArrayFirst,   // after '['
+    Key,          // after ',' in an object
+    AfterKey,     // before ':'
+    Next,         // after a value in an object or an array
+    QuotedString,
+    Escape,   // after a '\' in a string
+    Unicode,  // in the hex digits of a "\u" escape
+    NonQuotedKey,
+    Keyword,
+    Number,
+    Done,
+    Error,
+  };
+
+  enum class Comment : uint8_t {
+    None,
+    Slash,      // after a '/'
+    Block,      // in a /* comment
+    BlockStar,  // after a '*' in a /* comment
+    Line,       // in a // comment
+  };
+
+  template <typename TDestination>
+  static constexpr bool isDocument() {
+    using namespace detail;
+    return is_base_of<JsonDocument,
+                      remove_cv_t<remove_reference_t<TDestination>>>::value;
+  }
+
+  void fail(DeserializationError::Code err) {
+    error_ = err;
+    state_ = State::Error;
+  }
+
+  detail::VariantData* container() const {
+    ARDUINOJSON_ASSERT(depth_ > 0);
+    return stack_[depth_ - 1];
+  }
+
+  bool inObject() const {
+    return container()->asObject() != nullptr;
+  }
+
+  DeserializationError::Code consume(char c) {
+    DeserializationError::Code err;
+
+    // These tokens end with the first character that isn't theirs
+    if (state_ == State::Number) {
+      if (canBeInNumber(c) && tokenSize_ < sizeof(token_) - 1) {
+        token_[tokenSize_++] = c;
+        return DeserializationError::Ok;
+      }
+      err = endNumber();
+      if (err)
+        return err;
+      // We don't detect trailing characters earlier, so we need to check now
+      if (depth_ == 0 && value_->isFloat())
+        return DeserializationError::InvalidInput;
+    } else if (state_ == State::NonQuotedKey) {
+      if (canBeInNonQuotedString(c)) {
+        stringBuilder_.append(c);
+        return DeserializationError::Ok;
+      }
+      err = endKey();
+      if (err)
+        return err;
+    }
+
+    switch (state_) {
+      case State::QuotedString:
+        if (c == stopChar_)
+          return isKey_ ? endKey() : endString();
+        if (c == '\\')
+          state_ = State::Escape;
+        else
+          stringBuilder_.append(c);
+        return DeserializationError::Ok;
+
+      case State::Escape:
+        state_ = State::QuotedString;
+        if (c == 'u') {
+#if ARDUINOJSON_DECODE_UNICODE
+          state_ = State::Unicode;
+          tokenSize_ = 0;
+          codeunit_ = 0;
+#else
+          stringBuilder_.append('\\');
+          stringBuilder_.append(c);
+#endif
+          return DeserializationError::Ok;
+        }
+        c = detail::EscapeSequence::unescapeChar(c);
+        if (c == '\0')
+          return DeserializationError::InvalidInput;
+        stringBuilder_.append(c);
+        return DeserializationError::Ok;
+
+#if ARDUINOJSON_DECODE_UNICODE
+      case State::Unicode: {
+        uint8_t digit = decodeHex(c);
+        if (digit > 0x0F)
+          return DeserializationError::InvalidInput;
+        codeunit_ = uint16_t((codeunit_ << 4) | digit);
+        if (++tokenSize_ < 4)
+          return DeserializationError::Ok;
+        if (codepoint_.append(codeunit_))
+          detail::Utf8::encodeCodepoint(codepoint_.value(), stringBuilder_);
+        state_ = State::QuotedString;
+        return DeserializationError::Ok;
+      }
+#endif
+
+      case State::Keyword:
+        if (c != keyword_[tokenSize_])
+          return DeserializationError::InvalidInput;
+        if (keyword_[++tokenSize_] == '\0')
+          return endKeyword();
+        return DeserializationError::Ok;
+
+      case State::Done:
+        return DeserializationError::Ok;  // ignore trailing characters
+
+      default:
+        break;
+    }
+
+    // Between tokens, skip spaces and comments
+    if (comment_ != Comment::None)
+      return consumeComment(c);
+    switch (c) {
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+        return DeserializationError::Ok;
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+      case '/':
+        comment_ = Comment::Slash;
+        return DeserializationError::Ok;
+#endif
+
+      default:
+        foundSomething_ = true;
+        break;
+    }
+
+    switch (state_) {
+      case State::ObjectFirst:
+        if (c == '}')
+          return endContainer();
+        return startKey(c);
+
+      case State::Key:
+        return startKey(c);
+
+      case State::AfterKey:
+        if (c != ':')
+          return DeserializationError::InvalidInput;
+        state_ = State::Value;
+        return DeserializationError::Ok;
+
+      case State::ArrayFirst:
+        if (c == ']')
+          return endContainer();
+        return startValue(c);
+
+      case State::Next:
+        if (inObject()) {
+          if (c == '}')
+            return endContainer();
+          if (c != ',')
+            return DeserializationError::InvalidInput;
+          state_ = State::Key;
+        } else {
+          if (c == ']')
+            return endContainer();
+          if (c != ',')
+            return DeserializationError::InvalidInput;
+          state_ = State::Value;
+        }
+        return DeserializationError::Ok;
+
+      default:
+        ARDUINOJSON_ASSERT(state_ == State::Value);
+        return startValue(c);
+    }
+  }
+
+  DeserializationError::Code consumeComment(char c) {
+    switch (comment_) {
+      case Comment::Slash:
+        if (c == '*')
+          comment_ = Comment::Block;
+        else if (c == '/')
+          comment_ = Comment::Line;
+        else
+          return DeserializationError::InvalidInput;
+        break;
+
+      case Comment::Block:
+        if (c == '*')
+          comment_ = Comment::BlockStar;
+        break;
+
+      case Comment::BlockStar:
+        if (c == '/')
+          comment_ = Comment::None;
+        else if (c != '*')
+          comment_ = Comment::Block;
+        break;
+
+      default:
+        ARDUINOJSON_ASSERT(comment_ == Comment::Line);
+        if (c == '\n')
+          comment_ = Comment::None;
+        break;
+    }
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code startKey(char c) {
+    stringBuilder_.startString();
+    isKey_ = true;
+    if (isQuote(c)) {
+      stopChar_ = c;
+      state_ = State::QuotedString;
+      return DeserializationError::Ok;
+    }
+    if (!canBeInNonQuotedString(c))
+      return DeserializationError::InvalidInput;
+    stringBuilder_.append(c);
+    state_ = State::NonQuotedKey;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endKey() {
+    if (!stringBuilder_.isValid())
+      return DeserializationError::NoMemory;
+
+    auto& object = *container()->asObject();
+    JsonString key = stringBuilder_.str();
+    value_ = object.getMember(detail::adaptString(key.c_str()), resources_);
+    if (!value_) {
+      value_ = object.addMember(stringBuilder_.save(), resources_);
+      if (!value_)
+        return DeserializationError::NoMemory;
+    } else {
+      // the same key was used twice, as in {"a":1,"a":2}
+      value_->clear(resources_);
+    }
+    state_ = State::AfterKey;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code startValue(char c) {
+    if (depth_ == 0) {
+      value_ = root_;
+    } else if (!inObject()) {
+      value_ = container()->asArray()->addElement(resources_);
+      if (!value_)
+        return DeserializationError::NoMemory;
+    }
+    // in an object, value_ was set by endKey()
+
+    switch (c) {
+      case '{':
+      case '[':
+        if (depth_ >= maxDepth_)
+          return DeserializationError::TooDeep;
+        if (c == '{')
+          value_->toObject();
+        else
+          value_->toArray();
+        stack_[depth_++] = value_;
+        state_ = c == '{' ? State::ObjectFirst : State::ArrayFirst;
+        return DeserializationError::Ok;
+
+      case '\"':
+      case '\'':
+        stringBuilder_.startString();
+        isKey_ = false;
+        stopChar_ = c;
+        state_ = State::QuotedString;
+        return DeserializationError::Ok;
+
+      case 't':
+        return startKeyword("true");
+
+      case 'f':
+        return startKeyword("false");
+
+      case 'n':
+        return startKeyword("null");
+
+      default:
+        if (!canBeInNumber(c))
+          return DeserializationError::InvalidInput;
+        token_[0] = c;
+        tokenSize_ = 1;
+        state_ = State::Number;
+        return DeserializationError::Ok;
+    }
+  }
+
+  DeserializationError::Code startKeyword(const char* keyword) {
+    keyword_ = keyword;
+    tokenSize_ = 1;
+    state_ = State::Keyword;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endKeyword() {
+    // "null" needs nothing: the variant is already null
+    if (keyword_[0] == 't')
+      value_->setBoolean(true);
+    else if (keyword_[0] == 'f')
+      value_->setBoolean(false);
+    return endValue();
+  }
+
+  DeserializationError::Code endString() {
+    if (!stringBuilder_.isValid())
+      return DeserializationError::NoMemory;
+    value_->setOwnedString(stringBuilder_.save());
+    return endValue();
+  }
+
+  DeserializationError::Code endNumber() {
+    using namespace detail;
+
+    token_[tokenSize_] = 0;
+    auto number = parseNumber(token_);
+    bool ok;
+    switch (number.type()) {
+      case NumberType::UnsignedInteger:
+        ok = value_->setInteger(number.asUnsignedInteger(), resources_);
+        break;
+
+      case NumberType::SignedInteger:
+        ok = value_->setInteger(number.asSignedInteger(), resources_);
+        break;
+
+      case NumberType::Float:
+        ok = value_->setFloat(number.asFloat(), resources_);
+        break;
+
+#if ARDUINOJSON_USE_DOUBLE
+      case NumberType::Double:
+        ok = value_->setFloat(number.asDouble(), resources_);
+        break;
+#endif
+
+      default:
+        return DeserializationError::InvalidInput;
+    }
+    if (!ok)
+      return DeserializationError::NoMemory;
+    return endValue();
+  }
+
+  DeserializationError::Code endContainer() {
+    depth_--;
+    return endValue();
+  }
+
+  DeserializationError::Code endValue() {
+    if (depth_) {
+      state_ = State::Next;
+      return DeserializationError::Ok;
+    }
+    state_ = State::Done;
+    if (ARDUINOJSON_AUTO_SHRINK && shrinkWhenDone_)
+      resources_->shrinkToFit();
+    return DeserializationError::Ok;
+  }
+
+  static inline bool isBetween(char c, char min, char max) {
+    return min <= c && c <= max;
+  }
+
+  static inline bool canBeInNumber(char c) {
+    return isBetween(c, '0', '9') || c == '+' || c == '-' || c == '.' ||
+#if ARDUINOJSON_ENABLE_NAN || ARDUINOJSON_ENABLE_INFINITY
+           isBetween(c, 'A', 'Z') || isBetween(c, 'a', 'z');
+#else
+           c == 'e' || c == 'E';
+#endif
+  }
+
+  static inline bool canBeInNonQuotedString(char c) {
+    return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
+           isBetween(c, 'A', 'Z');
+  }
+
+  static inline bool isQuote(char c) {
+    return c == '\'' || c == '\"';
+  }
+
+  static inline uint8_t decodeHex(char c) {
+    if (c < 'A')
+      return uint8_t(c - '0');
+    c = char(c & ~0x20);  // uppercase
+    return uint8_t(c - 'A' + 10);
+  }
+
+  detail::ResourceManager* resources_;
+  detail::VariantData* root_;
+  detail::VariantData* value_ = nullptr;  // the value being parsed
+  detail::VariantData* stack_[maxDepth];  // the open objects and arrays
+  detail::StringBuilder stringBuilder_;
+#if ARDUINOJSON_DECODE_UNICODE
+  detail::Utf16::Codepoint codepoint_;
+  uint16_t codeunit_ = 0;
+#endif
+  const char* keyword_ = nullptr;
+  char token_[64];  // the number being parsed
+  DeserializationError error_;
+  State state_;
+  Comment comment_;
+  uint8_t depth_;
+  uint8_t maxDepth_;
+  uint8_t tokenSize_;
+  char stopChar_;
+  bool isKey_;
+  bool foundSomething_;
+  bool shrinkWhenDone_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
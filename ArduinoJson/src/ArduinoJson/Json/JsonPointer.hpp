@@ -0,0 +1,290 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/JsonPullParser.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+class JsonPointer;
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A key whose hash was computed in advance.
+// stringHash() returns the stored value, so the object index doesn't hash
+// the key again.
+class HashedRamString : public SizedRamString {
+ public:
+  HashedRamString(const char* str, size_t sz, uint32_t hash)
+      : SizedRamString(str, sz), hash_(hash) {}
+
+  uint32_t hash() const {
+    return hash_;
+  }
+
+ private:
+  uint32_t hash_;
+};
+
+inline uint32_t stringHash(const HashedRamString& s) {
+  return s.hash();
+}
+
+struct JsonPointerToken {
+  uint32_t hash;
+  uint16_t keyOffset;
+  uint16_t keyLength;
+  size_t index;  // notAnIndex if the token isn't an array index
+};
+
+template <typename TParser>
+DeserializationError extractJson(TParser& parser, const JsonPointer& pointer,
+                                 JsonVariant dst);
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A JSON Pointer (RFC 6901), like "/sensors/3/value", parsed once.
+// The keys are unescaped and hashed in advance, so resolve() walks the
+// document without adapting strings, and extractJson() picks one value from
+// a JSON input without deserializing the rest.
+class JsonPointer {
+  template <typename TParser>
+  friend DeserializationError detail::extractJson(TParser&, const JsonPointer&,
+                                                  JsonVariant);
+
+ public:
+  enum : size_t { notAnIndex = size_t(-1) };
+
+  explicit JsonPointer(
+      const char* pointer,
+      Allocator* allocator = detail::DefaultAllocator::instance())
+      : allocator_(allocator),
+        tokens_(nullptr),
+        keys_(nullptr),
+        size_(0),
+        valid_(false) {
+    valid_ = parse(pointer);
+  }
+
+  JsonPointer(const JsonPointer&) = delete;
+  JsonPointer& operator=(const JsonPointer&) = delete;
+
+  ~JsonPointer() {
+    if (tokens_)
+      allocator_->deallocate(tokens_);
+  }
+
+  // Returns false if the syntax is invalid, the pointer is too long, or the
+  // allocation failed. In that case, the pointer matches nothing.
+  bool isValid() const {
+    return valid_;
+  }
+
+  // Returns the number of reference tokens, 0 for the whole document
+  size_t size() const {
+    return size_;
+  }
+
+  // Returns the value at this location, or null if there is none.
+  JsonVariantConst resolve(JsonVariantConst root) const {
+    using namespace detail;
+    auto resources = VariantAttorney::getResourceManager(root);
+    return JsonVariantConst(resolve(VariantAttorney::getData(root), resources),
+                            resources);
+  }
+
+  JsonVariant resolve(JsonVariant root) const {
+    using namespace detail;
+    auto resources = VariantAttorney::getResourceManager(root);
+    return JsonVariant(resolve(VariantAttorney::getData(root), resources),
+                       resources);
+  }
+
+  JsonVariant resolve(JsonDocument& root) const {
+    return resolve(root.as<JsonVariant>());
+  }
+
+ private:
+  detail::HashedRamString key(const detail::JsonPointerToken& token) const {
+    return detail::HashedRamString(keys_ + token.keyOffset, token.keyLength,
+                                   token.hash);
+  }
+
+  detail::VariantData* resolve(
+      const detail::VariantData* data,
+      const detail::ResourceManager* resources) const {
+    if (!valid_)
+      return nullptr;
+    for (size_t i = 0; i < size_ && data; i++) {
+      const detail::JsonPointerToken& token = tokens_[i];
+      if (data->isObject())
+        data = data->getMember(key(token), resources);
+      else if (data->isArray() && token.index != notAnIndex)
+        data = data->getElement(token.index, resources);
+      else
+        data = nullptr;
+    }
+    return const_cast<detail::VariantData*>(data);
+  }
+
+  bool parse(const char* pointer) {
+    if (!pointer || (*pointer && *pointer != '/'))
+      return false;
+
+    // the keys are never longer than the pointer
+    size_t length = 0, count = 0;
+    for (const char* p = pointer; *p; p++) {
+      if (*p == '/')
+        count++;
+      length++;
+    }
+    if (count == 0)
+      return true;
+    if (length > uint16_t(-1))
+      return false;
+
+    tokens_ = reinterpret_cast<detail::JsonPointerToken*>(allocator_->allocate(
+        count * sizeof(detail::JsonPointerToken) + length));
+    if (!tokens_)
+      return false;
+    keys_ = reinterpret_cast<char*>(tokens_ + count);
+
+    uint16_t keyLength = 0;
+    const char* p = pointer;
+    while (*p == '/') {
+      p++;
+      detail::JsonPointerToken& token = tokens_[size_++];
+      token.keyOffset = keyLength;
+      for (; *p && *p != '/'; p++) {
+        char c = *p;
+        if (c == '~') {
+          p++;
+          if (*p == '0')
+            c = '~';
+          else if (*p == '1')
+            c = '/';
+          else
+            return false;
+        }
+        keys_[keyLength++] = c;
+      }
+      token.keyLength = uint16_t(keyLength - token.keyOffset);
+      token.hash = detail::stringHash(
+          detail::SizedRamString(keys_ + token.keyOffset, token.keyLength));
+      token.index = parseIndex(keys_ + token.keyOffset, token.keyLength);
+    }
+    return true;
+  }
+
+  // Array indexes are decimal numbers without leading zeros
+  static size_t parseIndex(const char* s, size_t n) {
+    if (n == 0 || (n > 1 && s[0] == '0'))
+      return notAnIndex;
+    size_t index = 0;
+    for (size_t i = 0; i < n; i++) {
+      if (s[i] < '0' || s[i] > '9')
+        return notAnIndex;
+      size_t digit = size_t(s[i] - '0');
+      if (index > (notAnIndex - 1 - digit) / 10)
+        return notAnIndex;
+      index = index * 10 + digit;
+    }
+    return index;
+  }
+
+  Allocator* allocator_;
+  detail::JsonPointerToken* tokens_;
+  char* keys_;
+  size_t size_;
+  bool valid_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Walks the input with the pull parser, skipping everything outside the
+// pointer, then copies the matched value.
+template <typename TParser>
+DeserializationError extractJson(TParser& parser, const JsonPointer& pointer,
+                                 JsonVariant dst) {
+  if (!pointer.isValid())
+    return DeserializationError::Ok;
+
+  parser.next();
+  for (size_t i = 0; i < pointer.size(); i++) {
+    const JsonPointerToken& token = pointer.tokens_[i];
+    if (parser.event() == JsonPullEvent::StartObject) {
+      auto key = pointer.key(token);
+      for (;;) {
+        auto event = parser.next();
+        if (event == JsonPullEvent::EndObject)
+          return DeserializationError::Ok;  // not found
+        if (event != JsonPullEvent::Key)
+          return parser.error();
+        JsonString s = parser.string();
+        if (stringHash(adaptString(s)) == token.hash &&
+            stringEquals(key, adaptString(s)))
+          break;
+        auto err = parser.skip();
+        if (err)
+          return err;
+      }
+      parser.next();  // the value
+    } else if (parser.event() == JsonPullEvent::StartArray &&
+               token.index != JsonPointer::notAnIndex) {
+      for (size_t index = 0;; index++) {
+        auto event = parser.next();
+        if (event == JsonPullEvent::EndArray)
+          return DeserializationError::Ok;  // not found
+        if (event == JsonPullEvent::Error)
+          return parser.error();
+        if (index == token.index)
+          break;
+        auto err = parser.skip();
+        if (err)
+          return err;
+      }
+    } else {
+      return parser.error();  // Ok, unless the input was invalid
+    }
+  }
+  return parser.read(dst);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Copies the value at the pointer in a JSON input into dst.
+// Only the matched value is deserialized, the rest of the input is skipped,
+// and the input isn't read past the end of the value.
+// dst is left null if the input has no value at this location.
+template <typename TDestination, typename TInput>
+detail::enable_if_t<detail::is_deserialize_destination<TDestination>::value,
+                    DeserializationError>
+extractJson(TDestination&& dst, TInput&& input, const JsonPointer& pointer) {
+  dst.clear();
+  auto parser = makeJsonPullParser(detail::forward<TInput>(input));
+  return detail::extractJson(parser, pointer, dst);
+}
+
+template <typename TDestination, typename TChar>
+detail::enable_if_t<detail::is_deserialize_destination<TDestination>::value,
+                    DeserializationError>
+extractJson(TDestination&& dst, TChar* input, size_t inputSize,
+            const JsonPointer& pointer) {
+  dst.clear();
+  auto parser = makeJsonPullParser(input, inputSize);
+  return detail::extractJson(parser, pointer, dst);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
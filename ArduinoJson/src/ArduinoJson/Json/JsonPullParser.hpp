@@ -0,0 +1,731 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/Latch.hpp>
+#include <ArduinoJson/Json/Utf16.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// The events returned by JsonPullParser::next()
+enum class JsonPullEvent : uint8_t {
+  None,
+  StartObject,
+  EndObject,
+  StartArray,
+  EndArray,
+  Key,
+  String,
+  Number,
+  Boolean,
+  Null,
+  End,
+  Error,
+};
+
+// A pull parser that reads a JSON input one token at a time.
+// Unlike deserializeJson(), it doesn't build a tree, so it uses a constant
+// amount of memory regardless of the size of the input.
+// Use makeJsonPullParser() to create one.
+template <typename TReader>
+class JsonPullParser {
+ public:
+  // Maximum nesting, whatever the NestingLimit says
+  static constexpr uint8_t maxDepth = 64;
+
+  JsonPullParser(TReader reader, DeserializationOption::NestingLimit
+                                     nestingLimit = {})
+      : latch_(reader),
+        error_(DeserializationError::Ok),
+        event_(JsonPullEvent::None),
+        state_(State::Start),
+        depth_(0),
+        maxDepth_(0),
+        boolean_(false),
+        foundSomething_(false) {
+    while (!nestingLimit.reached() && maxDepth_ < maxDepth) {
+      nestingLimit = nestingLimit.decrement();
+      maxDepth_++;
+    }
+  }
+
+  // Reads the next token.
+  // Returns JsonPullEvent::End after the first complete value, and
+  // JsonPullEvent::Error if the input is invalid (see error()).
+  JsonPullEvent next() {
+    if (event_ == JsonPullEvent::End || event_ == JsonPullEvent::Error)
+      return event_;
+    auto err = advance();
+    if (err) {
+      error_ = err;
+      event_ = JsonPullEvent::Error;
+    }
+    return event_;
+  }
+
+  // Returns the last event returned by next().
+  JsonPullEvent event() const {
+    return event_;
+  }
+
+  DeserializationError error() const {
+    return error_;
+  }
+
+  // Returns the number of objects and arrays currently open.
+  uint8_t depth() const {
+    return depth_;
+  }
+
+  // Returns the key or the string value, after JsonPullEvent::Key and
+  // JsonPullEvent::String.
+  // The characters are overwritten by the next call to next().
+  JsonString string() const {
+    if (event_ != JsonPullEvent::Key && event_ != JsonPullEvent::String)
+      return JsonString();
+    return JsonString(buffer_.data, buffer_.size, JsonString::Copied);
+  }
+
+  // Returns the value after JsonPullEvent::Boolean.
+  bool asBoolean() const {
+    return event_ == JsonPullEvent::Boolean && boolean_;
+  }
+
+  // Returns the value after JsonPullEvent::Number, converted to T.
+  template <typename T>
+  T as() const {
+    if (event_ != JsonPullEvent::Number)
+      return T();
+    return number_.template convertTo<T>();
+  }
+
+  // Returns true if the number has no fractional part nor exponent.
+  bool isInteger() const {
+    return event_ == JsonPullEvent::Number &&
+           (number_.type() == detail::NumberType::SignedInteger ||
+            number_.type() == detail::NumberType::UnsignedInteger);
+  }
+
+  // Skips the value of the key that was just read, or the content of the
+  // object or array that was just opened.
+  // Skipped strings don't need to fit in the buffer.
+  DeserializationError skip() {
+    buffer_.discard = true;
+    if (event_ == JsonPullEvent::Key)
+      next();
+    if (event_ == JsonPullEvent::StartObject ||
+        event_ == JsonPullEvent::StartArray) {
+      uint8_t depth = uint8_t(depth_ - 1);
+      while (depth_ > depth && next() != JsonPullEvent::Error) {
+      }
+    }
+    buffer_.discard = false;
+    buffer_.size = 0;
+    return error_;
+  }
+
+  // Copies the value that was just started (or the value of the key that was
+  // just read) into a JsonDocument or a JsonVariant.
+  // This lets you parse a huge array one element at a time.
+  template <typename TDestination>
+  detail::enable_if_t<detail::is_deserialize_destination<TDestination>::value,
+                      DeserializationError>
+  read(TDestination&& dst) {
+    using namespace detail;
+    if (event_ == JsonPullEvent::Key)
+      next();
+    if (event_ == JsonPullEvent::Error)
+      return error_;
+    auto data = VariantAttorney::getOrCreateData(dst);
+    if (!data)
+      return DeserializationError::NoMemory;
+    auto resources = VariantAttorney::getResourceManager(dst);
+    dst.clear();
+    auto err = readValue(*data, resources);
+    if (err) {
+      error_ = err;
+      event_ = JsonPullEvent::Error;
+    }
+    return err;
+  }
+
+ private:
+  enum class State : uint8_t {
+    Start,
+    ObjectFirst,  // after '{'
+    ArrayFirst,   // after '['
+    AfterKey,     // before ':'
+    Next,         // after a value in an object or an array
+    Done,
+  };
+
+  struct Buffer {
+    Buffer() : size(0), discard(false) {
+      data[0] = 0;
+    }
+
+    void append(char c) {
+      if (discard)
+        return;
+      if (size < sizeof(data) - 1)
+        data[size] = c;
+      size++;
+    }
+
+    bool isValid() {
+      if (discard)
+        return true;
+      if (size >= sizeof(data))
+        return false;
+      data[size] = 0;
+      return true;
+    }
+
+    char data[ARDUINOJSON_PULL_PARSER_BUFFER_SIZE];
+    size_t size;
+    bool discard;
+  };
+
+  char current() {
+    return latch_.current();
+  }
+
+  void move() {
+    latch_.clear();
+  }
+
+  bool eat(char charToSkip) {
+    if (current() != charToSkip)
+      return false;
+    move();
+    return true;
+  }
+
+  bool inObject() const {
+    uint8_t level = uint8_t(depth_ - 1);
+    return (containers_[level / 8] >> (level % 8)) & 1;
+  }
+
+  DeserializationError::Code advance() {
+    DeserializationError::Code err;
+
+    switch (state_) {
+      case State::Done:
+        event_ = JsonPullEvent::End;
+        return DeserializationError::Ok;
+
+      case State::ObjectFirst:
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+        if (eat('}'))
+          return endContainer(JsonPullEvent::EndObject);
+        return parseKey();
+
+      case State::ArrayFirst:
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+        if (eat(']'))
+          return endContainer(JsonPullEvent::EndArray);
+        return parseValue();
+
+      case State::AfterKey:
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+        if (!eat(':'))
+          return DeserializationError::InvalidInput;
+        return parseValue();
+
+      case State::Next:
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+        if (inObject()) {
+          if (eat('}'))
+            return endContainer(JsonPullEvent::EndObject);
+          if (!eat(','))
+            return DeserializationError::InvalidInput;
+          err = skipSpacesAndComments();
+          if (err)
+            return err;
+          return parseKey();
+        } else {
+          if (eat(']'))
+            return endContainer(JsonPullEvent::EndArray);
+          if (!eat(','))
+            return DeserializationError::InvalidInput;
+          return parseValue();
+        }
+
+      default:
+        return parseValue();
+    }
+  }
+
+  DeserializationError::Code startContainer(bool isObject) {
+    if (depth_ >= maxDepth_)
+      return DeserializationError::TooDeep;
+    uint8_t mask = uint8_t(1 << (depth_ % 8));
+    if (isObject)
+      containers_[depth_ / 8] |= mask;
+    else
+      containers_[depth_ / 8] &= uint8_t(~mask);
+    depth_++;
+    move();
+    state_ = isObject ? State::ObjectFirst : State::ArrayFirst;
+    event_ = isObject ? JsonPullEvent::StartObject : JsonPullEvent::StartArray;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endContainer(JsonPullEvent event) {
+    depth_--;
+    return endValue(event);
+  }
+
+  DeserializationError::Code endValue(JsonPullEvent event) {
+    event_ = event;
+    state_ = depth_ ? State::Next : State::Done;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseKey() {
+    DeserializationError::Code err;
+    buffer_.size = 0;
+    if (isQuote(current()))
+      err = parseQuotedString();
+    else
+      err = parseNonQuotedString();
+    if (err)
+      return err;
+    event_ = JsonPullEvent::Key;
+    state_ = State::AfterKey;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseValue() {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (current()) {
+      case '[':
+        return startContainer(false);
+
+      case '{':
+        return startContainer(true);
+
+      case '\"':
+      case '\'':
+        buffer_.size = 0;
+        err = parseQuotedString();
+        if (err)
+          return err;
+        return endValue(JsonPullEvent::String);
+
+      case 't':
+        boolean_ = true;
+        err = skipKeyword("true");
+        if (err)
+          return err;
+        return endValue(JsonPullEvent::Boolean);
+
+      case 'f':
+        boolean_ = false;
+        err = skipKeyword("false");
+        if (err)
+          return err;
+        return endValue(JsonPullEvent::Boolean);
+
+      case 'n':
+        err = skipKeyword("null");
+        if (err)
+          return err;
+        return endValue(JsonPullEvent::Null);
+
+      default:
+        err = parseNumericValue();
+        if (err)
+          return err;
+        return endValue(JsonPullEvent::Number);
+    }
+  }
+
+  DeserializationError::Code parseQuotedString() {
+#if ARDUINOJSON_DECODE_UNICODE
+    detail::Utf16::Codepoint codepoint;
+    DeserializationError::Code err;
+#endif
+    const char stopChar = current();
+
+    move();
+    for (;;) {
+      char c = current();
+      move();
+      if (c == stopChar)
+        break;
+
+      if (c == '\0')
+        return DeserializationError::IncompleteInput;
+
+      if (c == '\\') {
+        c = current();
+
+        if (c == '\0')
+          return DeserializationError::IncompleteInput;
+
+        if (c == 'u') {
+#if ARDUINOJSON_DECODE_UNICODE
+          move();
+          uint16_t codeunit;
+          err = parseHex4(codeunit);
+          if (err)
+            return err;
+          if (codepoint.append(codeunit))
+            detail::Utf8::encodeCodepoint(codepoint.value(), buffer_);
+#else
+          buffer_.append('\\');
+#endif
+          continue;
+        }
+
+        // replace char
+        c = detail::EscapeSequence::unescapeChar(c);
+        if (c == '\0')
+          return DeserializationError::InvalidInput;
+        move();
+      }
+
+      buffer_.append(c);
+    }
+
+    if (!buffer_.isValid())
+      return DeserializationError::NoMemory;
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseNonQuotedString() {
+    char c = current();
+    ARDUINOJSON_ASSERT(c);
+
+    if (!canBeInNonQuotedString(c))
+      return DeserializationError::InvalidInput;
+
+    do {
+      move();
+      buffer_.append(c);
+      c = current();
+    } while (canBeInNonQuotedString(c));
+
+    if (!buffer_.isValid())
+      return DeserializationError::NoMemory;
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseNumericValue() {
+    size_t n = 0;
+
+    char c = current();
+    while (canBeInNumber(c) && n < sizeof(buffer_.data) - 1) {
+      move();
+      buffer_.data[n++] = c;
+      c = current();
+    }
+    buffer_.data[n] = 0;
+    buffer_.size = 0;
+
+    if (buffer_.discard) {
+      number_ = detail::Number();
+      return n ? DeserializationError::Ok : DeserializationError::InvalidInput;
+    }
+
+    number_ = detail::parseNumber(buffer_.data);
+    if (number_.type() == detail::NumberType::Invalid)
+      return DeserializationError::InvalidInput;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseHex4(uint16_t& result) {
+    result = 0;
+    for (uint8_t i = 0; i < 4; ++i) {
+      char digit = current();
+      if (!digit)
+        return DeserializationError::IncompleteInput;
+      uint8_t value = decodeHex(digit);
+      if (value > 0x0F)
+        return DeserializationError::InvalidInput;
+      result = uint16_t((result << 4) | value);
+      move();
+    }
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readValue(detail::VariantData& variant,
+                                       detail::ResourceManager* resources) {
+    using namespace detail;
+
+    switch (event_) {
+      case JsonPullEvent::StartObject: {
+        auto& object = variant.toObject();
+        for (;;) {
+          next();
+          if (event_ == JsonPullEvent::EndObject)
+            return DeserializationError::Ok;
+          if (event_ == JsonPullEvent::Error)
+            return error_.code();
+          ARDUINOJSON_ASSERT(event_ == JsonPullEvent::Key);
+
+          auto key = adaptString(buffer_.data, buffer_.size);
+          auto member = object.getMember(key, resources);
+          if (!member) {
+            member = object.addMember(key, resources);
+            if (!member)
+              return DeserializationError::NoMemory;
+          } else {
+            member->clear(resources);
+          }
+
+          if (next() == JsonPullEvent::Error)
+            return error_.code();
+          auto err = readValue(*member, resources);
+          if (err)
+            return err;
+        }
+      }
+
+      case JsonPullEvent::StartArray: {
+        auto& array = variant.toArray();
+        for (;;) {
+          next();
+          if (event_ == JsonPullEvent::EndArray)
+            return DeserializationError::Ok;
+          if (event_ == JsonPullEvent::Error)
+            return error_.code();
+
+          auto element = array.addElement(resources);
+          if (!element)
+            return DeserializationError::NoMemory;
+          auto err = readValue(*element, resources);
+          if (err)
+            return err;
+        }
+      }
+
+      case JsonPullEvent::String:
+        if (!variant.setString(adaptString(buffer_.data, buffer_.size),
+                               resources))
+          return DeserializationError::NoMemory;
+        return DeserializationError::Ok;
+
+      case JsonPullEvent::Boolean:
+        variant.setBoolean(boolean_);
+        return DeserializationError::Ok;
+
+      case JsonPullEvent::Null:
+        return DeserializationError::Ok;
+
+      case JsonPullEvent::Number:
+        return readNumber(variant, resources);
+
+      default:
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  DeserializationError::Code readNumber(detail::VariantData& variant,
+                                        detail::ResourceManager* resources) {
+    using namespace detail;
+
+    bool ok = false;
+    switch (number_.type()) {
+      case NumberType::UnsignedInteger:
+        ok = variant.setInteger(number_.asUnsignedInteger(), resources);
+        break;
+
+      case NumberType::SignedInteger:
+        ok = variant.setInteger(number_.asSignedInteger(), resources);
+        break;
+
+      case NumberType::Float:
+        ok = variant.setFloat(number_.asFloat(), resources);
+        break;
+
+#if ARDUINOJSON_USE_DOUBLE
+      case NumberType::Double:
+        ok = variant.setFloat(number_.asDouble(), resources);
+        break;
+#endif
+
+      default:
+        return DeserializationError::InvalidInput;
+    }
+    return ok ? DeserializationError::Ok : DeserializationError::NoMemory;
+  }
+
+  static inline bool isBetween(char c, char min, char max) {
+    return min <= c && c <= max;
+  }
+
+  static inline bool canBeInNumber(char c) {
+    return isBetween(c, '0', '9') || c == '+' || c == '-' || c == '.' ||
+#if ARDUINOJSON_ENABLE_NAN || ARDUINOJSON_ENABLE_INFINITY
+           isBetween(c, 'A', 'Z') || isBetween(c, 'a', 'z');
+#else
+           c == 'e' || c == 'E';
+#endif
+  }
+
+  static inline bool canBeInNonQuotedString(char c) {
+    return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
+           isBetween(c, 'A', 'Z');
+  }
+
+  static inline bool isQuote(char c) {
+    return c == '\'' || c == '\"';
+  }
+
+  static inline uint8_t decodeHex(char c) {
+    if (c < 'A')
+      return uint8_t(c - '0');
+    c = char(c & ~0x20);  // uppercase
+    return uint8_t(c - 'A' + 10);
+  }
+
+  DeserializationError::Code skipSpacesAndComments() {
+    for (;;) {
+      switch (current()) {
+        // end of string
+        case '\0':
+          return foundSomething_ ? DeserializationError::IncompleteInput
+                                 : DeserializationError::EmptyInput;
+
+        // spaces
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+          move();
+          continue;
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+        // comments
+        case '/':
+          move();  // skip '/'
+          switch (current()) {
+            // block comment
+            case '*': {
+              move();  // skip '*'
+              bool wasStar = false;
+              for (;;) {
+                char c = current();
+                if (c == '\0')
+                  return DeserializationError::IncompleteInput;
+                if (c == '/' && wasStar) {
+                  move();
+                  break;
+                }
+                wasStar = c == '*';
+                move();
+              }
+              break;
+            }
+
+            // trailing comment
+            case '/':
+              // no need to skip "//"
+              for (;;) {
+                move();
+                char c = current();
+                if (c == '\0')
+                  return DeserializationError::IncompleteInput;
+                if (c == '\n')
+                  break;
+              }
+              break;
+
+            // not a comment, just a '/'
+            default:
+              return DeserializationError::InvalidInput;
+          }
+          break;
+#endif
+
+        default:
+          foundSomething_ = true;
+          return DeserializationError::Ok;
+      }
+    }
+  }
+
+  DeserializationError::Code skipKeyword(const char* s) {
+    while (*s) {
+      char c = current();
+      if (c == '\0')
+        return DeserializationError::IncompleteInput;
+      if (*s != c)
+        return DeserializationError::InvalidInput;
+      ++s;
+      move();
+    }
+    return DeserializationError::Ok;
+  }
+
+  detail::Latch<TReader> latch_;
+  Buffer buffer_;
+  detail::Number number_;
+  DeserializationError error_;
+  JsonPullEvent event_;
+  State state_;
+  uint8_t depth_;
+  uint8_t maxDepth_;
+  uint8_t containers_[maxDepth / 8];  // one bit per level, 1 = object
+  bool boolean_;
+  bool foundSomething_;
+};
+
+// Creates a JsonPullParser that reads from a stream, a string, or any input
+// supported by deserializeJson().
+// https://arduinojson.org/v7/api/json/deserializejson/
+template <typename TInput>
+JsonPullParser<detail::Reader<detail::remove_reference_t<TInput>>>
+makeJsonPullParser(TInput&& input,
+                   DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return JsonPullParser<Reader<remove_reference_t<TInput>>>(
+      makeReader(detail::forward<TInput>(input)), nestingLimit);
+}
+
+template <typename TChar>
+JsonPullParser<detail::Reader<TChar*>> makeJsonPullParser(
+    TChar* input, DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return JsonPullParser<Reader<TChar*>>(makeReader(input), nestingLimit);
+}
+
+template <typename TChar>
+JsonPullParser<detail::BoundedReader<TChar*>> makeJsonPullParser(
+    TChar* input, size_t inputSize,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return JsonPullParser<BoundedReader<TChar*>>(makeReader(input, inputSize),
+                                               nestingLimit);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -10,6 +10,7 @@
 #include <ArduinoJson/Json/EscapeSequence.hpp>
 #include <ArduinoJson/Numbers/FloatParts.hpp>
 #include <ArduinoJson/Numbers/JsonInteger.hpp>
+#include <ArduinoJson/Numbers/shortestDigits.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/attributes.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
@@ -66,30 +67,25 @@ class TextFormatter {
 
   template <typename T>
   void writeFloat(T value) {
-    writeFloat(JsonFloat(value), sizeof(T) >= 8 ? 9 : 6);
-  }
+#if ARDUINOJSON_USE_FAST_FLOAT_ENGINE
+    if (writeSpecialFloat(value))
+      return;
 
-  void writeFloat(JsonFloat value, int8_t decimalPlaces) {
-    if (isnan(value))
-      return writeRaw(ARDUINOJSON_ENABLE_NAN ? "NaN" : "null");
+    if (value == 0)
+      return writeRaw('0');
 
-#if ARDUINOJSON_ENABLE_INFINITY
-    if (value < 0.0) {
-      writeRaw('-');
-      value = -value;
-    }
-
-    if (isinf(value))
-      return writeRaw("Infinity");
+    bool scientific =
+        value >= T(ARDUINOJSON_POSITIVE_EXPONENTIATION_THRESHOLD) ||
+        value <= T(ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD);
+    writeDigits(shortestDigits(value), scientific);
 #else
-    if (isinf(value))
-      return writeRaw("null");
-
-    if (value < 0.0) {
-      writeRaw('-');
-      value = -value;
-    }
+    writeFloat(JsonFloat(value), sizeof(T) >= 8 ? 9 : 6);
 #endif
+  }
+
+  void writeFloat(JsonFloat value, int8_t decimalPlaces) {
+    if (writeSpecialFloat(value))
+      return;
 
     auto parts = decomposeFloat(value, decimalPlaces);
 
@@ -132,6 +128,69 @@ class TextFormatter {
     writeRaw(begin, end);
   }
 
+  // Writes NaN and Infinity, or the sign of the number, which then becomes
+  // positive.
+  // Returns true if nothing else needs to be written.
+  template <typename T>
+  bool writeSpecialFloat(T& value) {
+    if (isnan(value)) {
+      writeRaw(ARDUINOJSON_ENABLE_NAN ? "NaN" : "null");
+      return true;
+    }
+
+#if ARDUINOJSON_ENABLE_INFINITY
+    if (value < 0) {
+      writeRaw('-');
+      value = -value;
+    }
+
+    if (isinf(value)) {
+      writeRaw("Infinity");
+      return true;
+    }
+#else
+    if (isinf(value)) {
+      writeRaw("null");
+      return true;
+    }
+
+    if (value < 0) {
+      writeRaw('-');
+      value = -value;
+    }
+#endif
+    return false;
+  }
+
+  void writeDigits(const ShortestDigits& parts, bool scientific) {
+    const char* digits = parts.digits;
+    int count = parts.count;
+    int point = parts.exponent;
+
+    if (scientific) {
+      writeRaw(digits[0]);
+      if (count > 1) {
+        writeRaw('.');
+        writeRaw(digits + 1, digits + count);
+      }
+      writeRaw('e');
+      writeInteger(int16_t(point - 1));
+    } else if (point <= 0) {
+      writeRaw("0.");
+      for (int i = point; i < 0; i++)
+        writeRaw('0');
+      writeRaw(digits, digits + count);
+    } else if (point < count) {
+      writeRaw(digits, digits + point);
+      writeRaw('.');
+      writeRaw(digits + point, digits + count);
+    } else {
+      writeRaw(digits, digits + count);
+      for (int i = count; i < point; i++)
+        writeRaw('0');
+    }
+  }
+
   void writeDecimals(uint32_t value, int8_t width) {
     // buffer should be big enough for all digits and the dot
     char buffer[16];
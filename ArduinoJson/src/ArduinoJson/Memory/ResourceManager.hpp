@@ -7,6 +7,7 @@
 #include <ArduinoJson/Memory/Allocator.hpp>
 #include <ArduinoJson/Memory/MemoryPoolList.hpp>
 #include <ArduinoJson/Memory/StringPool.hpp>
+#include <ArduinoJson/Object/ObjectIndex.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 #include <ArduinoJson/Strings/StringAdapters.hpp>
@@ -34,6 +35,9 @@ class ResourceManager {
   ~ResourceManager() {
     stringPool_.clear(allocator_);
     variantPools_.clear(allocator_);
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    objectIndex_.clear(allocator_);
+#endif
   }
 
   ResourceManager(const ResourceManager&) = delete;
@@ -44,6 +48,12 @@ class ResourceManager {
     swap(a.variantPools_, b.variantPools_);
     swap_(a.allocator_, b.allocator_);
     swap_(a.overflowed_, b.overflowed_);
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    // the buffers follow their allocator, the owners don't
+    swap(a.objectIndex_, b.objectIndex_);
+    a.objectIndex_.invalidate();
+    b.objectIndex_.invalidate();
+#endif
   }
 
   Allocator* allocator() const {
@@ -81,7 +91,7 @@ class ResourceManager {
   }
 
   void saveString(StringNode* node) {
-    stringPool_.add(node);
+    stringPool_.add(node, allocator_);
   }
 
   template <typename TAdaptedString>
@@ -107,25 +117,55 @@ class ResourceManager {
     StringNode::destroy(node, allocator_);
   }
 
-  void dereferenceString(const char* s) {
-    stringPool_.dereference(s, allocator_);
+  void dereferenceString(StringNode* node) {
+    stringPool_.dereference(node, allocator_);
   }
 
   void clear() {
     variantPools_.clear(allocator_);
     overflowed_ = false;
     stringPool_.clear(allocator_);
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    objectIndex_.clear(allocator_);
+#endif
   }
 
   void shrinkToFit() {
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    // the slots are about to move
+    objectIndex_.clear(allocator_);
+#endif
     variantPools_.shrinkToFit(allocator_);
   }
 
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  template <typename TAdaptedString>
+  bool findIndexedKey(const ObjectData* object, TAdaptedString key,
+                      SlotId& keyId) const {
+    return objectIndex_.find(object, key, this, keyId);
+  }
+
+  void indexObject(const ObjectData* object) const {
+    objectIndex_.build(object, this, allocator_);
+  }
+
+  void memberAdded(const ObjectData* object, SlotId keyId) {
+    objectIndex_.add(object, keyId, this, allocator_);
+  }
+
+  void invalidateIndex(const CollectionData* collection) {
+    objectIndex_.invalidate(collection);
+  }
+#endif
+
  private:
   Allocator* allocator_;
   bool overflowed_;
   StringPool stringPool_;
   MemoryPoolList<SlotData> variantPools_;
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  mutable ObjectIndex objectIndex_;  // a cache, so lookups stay const
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
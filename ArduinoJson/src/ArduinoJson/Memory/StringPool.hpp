@@ -12,6 +12,11 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+// The strings owned by a document, shared by reference counting.
+// The nodes are chained through StringNode::next. While there are only a few,
+// they form a single list; past ARDUINOJSON_STRING_POOL_HASH_THRESHOLD
+// strings, the pool switches to a table of buckets, so that looking for a
+// duplicate doesn't walk every string.
 class StringPool {
  public:
   StringPool() = default;
@@ -20,24 +25,38 @@ class StringPool {
 
   ~StringPool() {
     ARDUINOJSON_ASSERT(strings_ == nullptr);
+    ARDUINOJSON_ASSERT(buckets_ == nullptr);
   }
 
   friend void swap(StringPool& a, StringPool& b) {
     swap_(a.strings_, b.strings_);
+    swap_(a.buckets_, b.buckets_);
+    swap_(a.bucketCount_, b.bucketCount_);
+    swap_(a.count_, b.count_);
   }
 
   void clear(Allocator* allocator) {
-    while (strings_) {
-      auto node = strings_;
-      strings_ = node->next;
-      StringNode::destroy(node, allocator);
+    for (size_t i = 0; i < chainCount(); i++) {
+      auto& head = chain(i);
+      while (head) {
+        auto node = head;
+        head = node->next;
+        StringNode::destroy(node, allocator);
+      }
     }
+    if (buckets_)
+      allocator->deallocate(buckets_);
+    buckets_ = nullptr;
+    bucketCount_ = 0;
+    count_ = 0;
   }
 
   size_t size() const {
     size_t total = 0;
-    for (auto node = strings_; node; node = node->next)
-      total += sizeofString(node->length);
+    for (size_t i = 0; i < chainCount(); i++) {
+      for (auto node = chain(i); node; node = node->next)
+        total += sizeofString(node->length);
+    }
     return total;
   }
 
@@ -59,44 +78,115 @@ class StringPool {
 
     stringGetChars(str, node->data, n);
     node->data[n] = 0;  // force NUL terminator
-    add(node);
+    add(node, allocator);
     return node;
   }
 
-  void add(StringNode* node) {
+  void add(StringNode* node, Allocator* allocator) {
     ARDUINOJSON_ASSERT(node != nullptr);
-    node->next = strings_;
-    strings_ = node;
+    count_++;
+    if (needsMoreBuckets())
+      rehash(allocator);  // keeps the old chains if it fails
+    link(node);
   }
 
   template <typename TAdaptedString>
   StringNode* get(const TAdaptedString& str) const {
-    for (auto node = strings_; node; node = node->next) {
+    for (auto node = chainFor(str); node; node = node->next) {
       if (stringEquals(str, adaptString(node->data, node->length)))
         return node;
     }
     return nullptr;
   }
 
-  void dereference(const char* s, Allocator* allocator) {
-    StringNode* prev = nullptr;
-    for (auto node = strings_; node; node = node->next) {
-      if (node->data == s) {
-        if (--node->references == 0) {
-          if (prev)
-            prev->next = node->next;
-          else
-            strings_ = node->next;
-          StringNode::destroy(node, allocator);
-        }
-        return;
+  void dereference(StringNode* target, Allocator* allocator) {
+    ARDUINOJSON_ASSERT(target != nullptr);
+    if (--target->references != 0)
+      return;
+    StringNode** link = &chainFor(adaptString(target->data, target->length));
+    while (*link && *link != target)
+      link = &(*link)->next;
+    ARDUINOJSON_ASSERT(*link == target);
+    *link = target->next;
+    count_--;
+    StringNode::destroy(target, allocator);
+  }
+
+ private:
+  size_t chainCount() const {
+    return buckets_ ? bucketCount_ : 1;
+  }
+
+  StringNode*& chain(size_t i) {
+    return buckets_ ? buckets_[i] : strings_;
+  }
+
+  StringNode* chain(size_t i) const {
+    return buckets_ ? buckets_[i] : strings_;
+  }
+
+  template <typename TAdaptedString>
+  StringNode*& chainFor(TAdaptedString str) {
+    if (!buckets_)
+      return strings_;
+    return buckets_[stringHash(str) & (bucketCount_ - 1)];
+  }
+
+  template <typename TAdaptedString>
+  StringNode* chainFor(TAdaptedString str) const {
+    return const_cast<StringPool*>(this)->chainFor(str);
+  }
+
+  void link(StringNode* node) {
+    auto& head = chainFor(adaptString(node->data, node->length));
+    node->next = head;
+    head = node;
+  }
+
+  // Allows two strings per bucket on average
+  bool needsMoreBuckets() const {
+    if (count_ <= ARDUINOJSON_STRING_POOL_HASH_THRESHOLD)
+      return false;
+    return count_ > 2 * bucketCount_;
+  }
+
+  void rehash(Allocator* allocator) {
+    size_t newCount = bucketCount_ ? 2 * bucketCount_ : 32;
+    while (count_ > 2 * newCount)
+      newCount *= 2;
+    auto newBuckets = reinterpret_cast<StringNode**>(
+        allocator->allocate(newCount * sizeof(StringNode*)));
+    if (!newBuckets)
+      return;
+    for (size_t i = 0; i < newCount; i++)
+      newBuckets[i] = nullptr;
+
+    // unlink every node, then move to the new table
+    StringNode* all = nullptr;
+    for (size_t i = 0; i < chainCount(); i++) {
+      auto& head = chain(i);
+      while (head) {
+        auto node = head;
+        head = node->next;
+        node->next = all;
+        all = node;
       }
-      prev = node;
+    }
+    if (buckets_)
+      allocator->deallocate(buckets_);
+    buckets_ = newBuckets;
+    bucketCount_ = newCount;
+    while (all) {
+      auto node = all;
+      all = node->next;
+      link(node);
     }
   }
 
- private:
-  StringNode* strings_ = nullptr;
+  StringNode* strings_ = nullptr;    // the only chain, until buckets_ is set
+  StringNode** buckets_ = nullptr;
+  size_t bucketCount_ = 0;  // a power of two
+  size_t count_ = 0;
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,312 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+#include <string.h>  // memcpy
+
+#if ARDUINOJSON_ENABLE_PSRAM
+#  include <esp_heap_caps.h>
+#endif
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+#if ARDUINOJSON_ENABLE_PSRAM
+namespace detail {
+// Allocates from the heap that has the requested capabilities
+template <uint32_t caps>
+class HeapCapsAllocator : public Allocator {
+ public:
+  void* allocate(size_t size) override {
+    return heap_caps_malloc(size, caps);
+  }
+
+  void deallocate(void* ptr) override {
+    heap_caps_free(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t new_size) override {
+    return heap_caps_realloc(ptr, new_size, caps);
+  }
+
+  static Allocator* instance() {
+    static HeapCapsAllocator allocator;
+    return &allocator;
+  }
+};
+
+using InternalRamAllocator =
+    HeapCapsAllocator<MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT>;
+using PsramAllocator = HeapCapsAllocator<MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT>;
+}  // namespace detail
+#endif
+
+struct TieredAllocatorStats {
+  size_t allocations;     // successful calls to allocate() and reallocate()
+  size_t failures;        // failed calls to allocate() and reallocate()
+  size_t recycled;        // allocations served by a cached block
+  size_t fastBytes;       // currently allocated from the fast tier
+  size_t largeBytes;      // currently allocated from the large tier
+  size_t peakFastBytes;   // highest value of fastBytes
+  size_t peakLargeBytes;  // highest value of largeBytes
+  size_t cachedBlocks;    // freed blocks kept for reuse
+  size_t cachedBytes;     // size of the cached blocks, part of fastBytes
+};
+
+// An allocator for JsonDocument that splits the memory in two tiers:
+// - the slot pools and the small strings come from the fast tier (internal
+//   RAM), rounded to a few size classes;
+// - the strings of ARDUINOJSON_TIERED_ALLOCATOR_THRESHOLD bytes or more come
+//   from the large tier (PSRAM).
+// Freed fast blocks are kept, one list per size class, and handed over to the
+// next document, which avoids fragmenting the heap when documents are
+// created and destroyed repeatedly.
+// Share one instance between documents; it isn't thread-safe.
+class TieredAllocator : public Allocator {
+ public:
+  enum : uint8_t {
+    maxClasses = 8,
+    maxBlocksPerClass = 4,
+  };
+
+  TieredAllocator(Allocator* fast = defaultFastAllocator(),
+                  Allocator* large = defaultLargeAllocator(),
+                  size_t threshold = ARDUINOJSON_TIERED_ALLOCATOR_THRESHOLD)
+      : fast_(fast), large_(large), threshold_(threshold), stats_() {}
+
+  TieredAllocator(const TieredAllocator&) = delete;
+  TieredAllocator& operator=(const TieredAllocator&) = delete;
+
+  ~TieredAllocator() {
+    releaseCache();
+  }
+
+  void* allocate(size_t size) override {
+    Tier tier = tierFor(size);
+    size_t capacity = tier == Tier::Fast ? roundToClass(size) : size;
+
+    Block* block = nullptr;
+    if (tier == Tier::Fast)
+      block = takeFromCache(capacity);
+    if (!block)
+      block = static_cast<Block*>(upstream(tier)->allocate(
+          sizeof(Block) + capacity));
+    if (!block) {
+      stats_.failures++;
+      return nullptr;
+    }
+
+    block->capacity = capacity;
+    block->tier = tier;
+    stats_.allocations++;
+    track(tier, capacity, true);
+    return block->payload();
+  }
+
+  void deallocate(void* ptr) override {
+    if (!ptr)
+      return;
+    Block* block = Block::fromPayload(ptr);
+    if (block->tier == Tier::Fast && putInCache(block))
+      return;
+    track(block->tier, block->capacity, false);
+    upstream(block->tier)->deallocate(block);
+  }
+
+  void* reallocate(void* ptr, size_t newSize) override {
+    if (!ptr)
+      return allocate(newSize);
+
+    Block* block = Block::fromPayload(ptr);
+    Tier tier = block->tier;
+    // Growing strings move to the large tier, shrinking blocks stay put
+    if (newSize > block->capacity)
+      tier = tierFor(newSize);
+    size_t capacity = tier == Tier::Fast ? roundToClass(newSize) : newSize;
+
+    if (tier == block->tier) {
+      if (capacity == block->capacity)
+        return ptr;
+      size_t oldCapacity = block->capacity;
+      auto newBlock = static_cast<Block*>(
+          upstream(tier)->reallocate(block, sizeof(Block) + capacity));
+      if (!newBlock) {
+        stats_.failures++;
+        return nullptr;
+      }
+      track(tier, oldCapacity, false);
+      newBlock->capacity = capacity;
+      stats_.allocations++;
+      track(tier, capacity, true);
+      return newBlock->payload();
+    }
+
+    // Move to the other tier
+    void* newPtr = allocate(newSize);
+    if (!newPtr)
+      return nullptr;
+    memcpy(newPtr, ptr, block->capacity < newSize ? block->capacity : newSize);
+    deallocate(ptr);
+    return newPtr;
+  }
+
+  // Frees the cached blocks
+  void releaseCache() {
+    for (uint8_t i = 0; i < maxClasses; i++) {
+      SizeClass& sizeClass = classes_[i];
+      while (sizeClass.head) {
+        Block* block = sizeClass.head;
+        sizeClass.head = block->next();
+        track(Tier::Fast, block->capacity, false);
+        fast_->deallocate(block);
+      }
+      sizeClass = SizeClass();
+    }
+    stats_.cachedBlocks = 0;
+    stats_.cachedBytes = 0;
+  }
+
+  const TieredAllocatorStats& stats() const {
+    return stats_;
+  }
+
+  static Allocator* defaultFastAllocator() {
+#if ARDUINOJSON_ENABLE_PSRAM
+    return detail::InternalRamAllocator::instance();
+#else
+    return detail::DefaultAllocator::instance();
+#endif
+  }
+
+  static Allocator* defaultLargeAllocator() {
+#if ARDUINOJSON_ENABLE_PSRAM
+    return detail::PsramAllocator::instance();
+#else
+    return detail::DefaultAllocator::instance();
+#endif
+  }
+
+ private:
+  enum class Tier : uint8_t { Fast, Large };
+
+  // Placed in front of each block; the size keeps the payload aligned
+  struct Block {
+    size_t capacity;
+    Tier tier;
+
+    void* payload() {
+      return reinterpret_cast<char*>(this) + sizeof(Block);
+    }
+
+    static Block* fromPayload(void* p) {
+      return reinterpret_cast<Block*>(reinterpret_cast<char*>(p) -
+                                      sizeof(Block));
+    }
+
+    // cached blocks are chained through their payload
+    Block*& next() {
+      return *reinterpret_cast<Block**>(payload());
+    }
+  };
+
+  struct SizeClass {
+    SizeClass() : capacity(0), count(0), head(nullptr) {}
+
+    size_t capacity;  // 0 if the class isn't used yet
+    uint8_t count;
+    Block* head;
+  };
+
+  static size_t poolSize(detail::SlotCount n) {
+    return detail::MemoryPool<detail::VariantData>::slotsToBytes(n);
+  }
+
+  Tier tierFor(size_t size) const {
+    // slot pools always stay in the fast tier
+    // (the last pool of a document has one less slot)
+    if (size == poolSize(ARDUINOJSON_POOL_CAPACITY) ||
+        size == poolSize(ARDUINOJSON_POOL_CAPACITY - 1))
+      return Tier::Fast;
+    return size < threshold_ ? Tier::Fast : Tier::Large;
+  }
+
+  // Rounds up to 1/8 of the next power of two, so that similar sizes share
+  // a class, while wasting less than 12.5%
+  static size_t roundToClass(size_t size) {
+    if (size < sizeof(Block*))
+      return sizeof(Block*);
+    size_t step = 1;
+    while ((step << 4) <= size)
+      step <<= 1;
+    return (size + step - 1) & ~(step - 1);
+  }
+
+  Block* takeFromCache(size_t capacity) {
+    for (uint8_t i = 0; i < maxClasses; i++) {
+      SizeClass& sizeClass = classes_[i];
+      if (sizeClass.capacity != capacity || !sizeClass.head)
+        continue;
+      Block* block = sizeClass.head;
+      sizeClass.head = block->next();
+      sizeClass.count--;
+      stats_.cachedBlocks--;
+      stats_.cachedBytes -= capacity;
+      stats_.recycled++;
+      track(Tier::Fast, capacity, false);  // counted again by allocate()
+      return block;
+    }
+    return nullptr;
+  }
+
+  bool putInCache(Block* block) {
+    SizeClass* sizeClass = nullptr;
+    for (uint8_t i = 0; i < maxClasses && !sizeClass; i++) {
+      if (classes_[i].capacity == block->capacity)
+        sizeClass = &classes_[i];
+    }
+    for (uint8_t i = 0; i < maxClasses && !sizeClass; i++) {
+      if (classes_[i].capacity == 0 || !classes_[i].head) {
+        sizeClass = &classes_[i];
+        sizeClass->capacity = block->capacity;
+      }
+    }
+    if (!sizeClass || sizeClass->count >= maxBlocksPerClass)
+      return false;
+    block->next() = sizeClass->head;
+    sizeClass->head = block;
+    sizeClass->count++;
+    stats_.cachedBlocks++;
+    stats_.cachedBytes += block->capacity;
+    return true;
+  }
+
+  Allocator* upstream(Tier tier) const {
+    return tier == Tier::Fast ? fast_ : large_;
+  }
+
+  void track(Tier tier, size_t size, bool allocated) {
+    size_t& bytes = tier == Tier::Fast ? stats_.fastBytes : stats_.largeBytes;
+    size_t& peak =
+        tier == Tier::Fast ? stats_.peakFastBytes : stats_.peakLargeBytes;
+    if (allocated) {
+      bytes += size;
+      if (bytes > peak)
+        peak = bytes;
+    } else {
+      bytes -= size;
+    }
+  }
+
+  Allocator* fast_;
+  Allocator* large_;
+  size_t threshold_;
+  SizeClass classes_[maxClasses];
+  TieredAllocatorStats stats_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -14,6 +14,57 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+// Reads a buffer that outlives the document, so the deserializer can link
+// the values instead of copying them.
+// TChar is char if the buffer can be modified, const char otherwise.
+template <typename TChar>
+class ZeroCopyReader {
+ public:
+  ZeroCopyReader(TChar* begin, size_t size) : ptr_(begin), end_(begin + size) {}
+
+  int read() {
+    if (ptr_ < end_)
+      return static_cast<unsigned char>(*ptr_++);
+    else
+      return -1;
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t i = 0;
+    while (i < length && ptr_ < end_)
+      buffer[i++] = *ptr_++;
+    return i;
+  }
+
+  // Skips the next n bytes and returns a pointer to the first one, minus
+  // `back` bytes to include the header that was just read.
+  // Returns null if the input is too short.
+  TChar* link(size_t back, size_t n) {
+    if (size_t(end_ - ptr_) < n)
+      return nullptr;
+    TChar* p = ptr_ - back;
+    ptr_ += n;
+    return p;
+  }
+
+ private:
+  TChar* ptr_;
+  TChar* end_;
+};
+
+template <typename TReader>
+struct CanLinkRawStrings : false_type {};
+
+template <typename TChar>
+struct CanLinkRawStrings<ZeroCopyReader<TChar>> : true_type {};
+
+// Strings need a terminator, which can only be written in a mutable buffer
+template <typename TReader>
+struct CanLinkStrings : false_type {};
+
+template <>
+struct CanLinkStrings<ZeroCopyReader<char>> : true_type {};
+
 template <typename TReader>
 class MsgPackDeserializer {
  public:
@@ -175,7 +226,8 @@ class MsgPackDeserializer {
       size++;  // to include the type
 
     if (allowValue)
-      return readRawString(variant, header, uint8_t(1 + sizeBytes), size);
+      return readRawString(variant, header, uint8_t(1 + sizeBytes), size,
+                           CanLinkRawStrings<TReader>());
     else
       return skipBytes(size);
   }
@@ -300,26 +352,61 @@ class MsgPackDeserializer {
 
   DeserializationError::Code readString(VariantData* variant, size_t n) {
     DeserializationError::Code err;
+    JsonString s;
 
-    err = readString(n);
+    err = readString(n, s, CanLinkStrings<TReader>());
     if (err)
       return err;
 
-    variant->setOwnedString(stringBuffer_.save());
+    if (s.isLinked())
+      variant->setLinkedString(s.c_str());
+    else
+      variant->setOwnedString(stringBuffer_.save());
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code readString(size_t n) {
+  DeserializationError::Code readString(size_t n, JsonString& result,
+                                        false_type) {
     char* p = stringBuffer_.reserve(n);
     if (!p)
       return DeserializationError::NoMemory;
 
-    return readBytes(p, n);
+    auto err = readBytes(p, n);
+    if (err)
+      return err;
+
+    result = stringBuffer_.str();
+    return DeserializationError::Ok;
+  }
+
+  // Moves the string over the last byte of its header and terminates it
+  DeserializationError::Code readString(size_t n, JsonString& result,
+                                        true_type) {
+    char* p = reader_.link(0, n);
+    if (!p)
+      return DeserializationError::IncompleteInput;
+
+    memmove(p - 1, p, n);
+    p[n - 1] = 0;
+    result = JsonString(p - 1, n, JsonString::Linked);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readRawString(VariantData* variant,
+                                           const void*, uint8_t headerSize,
+                                           size_t n, true_type) {
+    const char* p = reader_.link(headerSize, n);
+    if (!p)
+      return DeserializationError::IncompleteInput;
+
+    variant->setLinkedRawString(p);
+    return DeserializationError::Ok;
   }
 
   DeserializationError::Code readRawString(VariantData* variant,
                                            const void* header,
-                                           uint8_t headerSize, size_t n) {
+                                           uint8_t headerSize, size_t n,
+                                           false_type) {
     auto totalSize = size_t(headerSize + n);
     if (totalSize < n)                        // integer overflow
       return DeserializationError::NoMemory;  // (not testable on 64-bit)
@@ -397,21 +484,24 @@ class MsgPackDeserializer {
     }
 
     for (; n; --n) {
-      err = readKey();
+      JsonString key;
+      err = readKey(key);
       if (err)
         return err;
 
-      JsonString key = stringBuffer_.str();
       TFilter memberFilter = filter[key.c_str()];
       VariantData* member;
 
       if (memberFilter.allow()) {
         ARDUINOJSON_ASSERT(object != 0);
 
-        // Save key in memory pool.
-        auto savedKey = stringBuffer_.save();
-
-        member = object->addMember(savedKey, resources_);
+        if (key.isLinked()) {
+          member = object->addMember(adaptString(key), resources_);
+        } else {
+          // Save key in memory pool.
+          auto savedKey = stringBuffer_.save();
+          member = object->addMember(savedKey, resources_);
+        }
         if (!member)
           return DeserializationError::NoMemory;
       } else {
@@ -426,7 +516,7 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code readKey() {
+  DeserializationError::Code readKey(JsonString& key) {
     DeserializationError::Code err;
     uint8_t code;
 
@@ -435,7 +525,7 @@ class MsgPackDeserializer {
       return err;
 
     if ((code & 0xe0) == 0xa0)
-      return readString(code & 0x1f);
+      return readString(code & 0x1f, key, CanLinkStrings<TReader>());
 
     if (code >= 0xd9 && code <= 0xdb) {
       uint8_t sizeBytes = uint8_t(1U << (code - 0xd9));
@@ -446,7 +536,7 @@ class MsgPackDeserializer {
           return err;
         size = (size << 8) | code;
       }
-      return readString(size);
+      return readString(size, key, CanLinkStrings<TReader>());
     }
 
     return DeserializationError::InvalidInput;
@@ -485,4 +575,21 @@ deserializeMsgPack(TDestination&& dst, TChar* input, Args&&... args) {
                                           detail::forward<Args>(args)...);
 }
 
+// Parses a MessagePack buffer without copying the strings, the binaries, and
+// the extensions: the document points into the buffer, which must outlive it.
+// If the buffer is mutable, the strings and the keys are terminated in place,
+// so the buffer can't be parsed again. If it's const, they are copied.
+template <typename TDestination, typename TChar, typename... Args>
+detail::enable_if_t<detail::is_deserialize_destination<TDestination>::value &&
+                        detail::IsCharOrVoid<TChar>::value,
+                    DeserializationError>
+deserializeMsgPackZeroCopy(TDestination&& dst, TChar* input, size_t inputSize,
+                           const Args&... args) {
+  using namespace detail;
+  using Char = conditional_t<is_const<TChar>::value, const char, char>;
+  return doDeserialize<MsgPackDeserializer>(
+      dst, ZeroCopyReader<Char>(reinterpret_cast<Char*>(input), inputSize),
+      makeDeserializationOptions(args...));
+}
+
 ARDUINOJSON_END_PUBLIC_NAMESPACE
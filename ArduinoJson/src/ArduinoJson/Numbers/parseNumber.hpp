@@ -7,6 +7,7 @@
 #include <ArduinoJson/Numbers/FloatTraits.hpp>
 #include <ArduinoJson/Numbers/JsonFloat.hpp>
 #include <ArduinoJson/Numbers/convertNumber.hpp>
+#include <ArduinoJson/Numbers/decimalToFloat.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/ctype.hpp>
 #include <ArduinoJson/Polyfills/math.hpp>
@@ -102,10 +103,25 @@ class Number {
 #endif
 };
 
+#if ARDUINOJSON_USE_FAST_FLOAT_ENGINE
+template <typename T>
+inline T parseFloat(uint64_t mantissa, int exponent) {
+  T result;
+  if (decimalToFloat(mantissa, exponent, result))
+    return result;
+  return make_float(T(mantissa), exponent);  // very rare, slow and approximate
+}
+#endif
+
 inline Number parseNumber(const char* s) {
   using traits = FloatTraits<JsonFloat>;
+#if ARDUINOJSON_USE_FAST_FLOAT_ENGINE
+  using mantissa_t = largest_type<uint64_t, JsonUInt>;
+  using exponent_t = int;
+#else
   using mantissa_t = largest_type<traits::mantissa_type, JsonUInt>;
   using exponent_t = traits::exponent_type;
+#endif
 
   ARDUINOJSON_ASSERT(s != 0);
 
@@ -143,10 +159,9 @@ inline Number parseNumber(const char* s) {
     uint8_t digit = uint8_t(*s - '0');
     if (mantissa > maxUint / 10)
       break;
-    mantissa *= 10;
-    if (mantissa > maxUint - digit)
+    if (mantissa * 10 > maxUint - digit)
       break;
-    mantissa += digit;
+    mantissa = mantissa * 10 + digit;
     s++;
   }
 
@@ -162,6 +177,45 @@ inline Number parseNumber(const char* s) {
     }
   }
 
+#if ARDUINOJSON_USE_FAST_FLOAT_ENGINE
+  // keep 19 significant digits, and round to the nearest.
+  // The result is correctly rounded, unless the dropped digits are very close
+  // to the middle of two floats, in which case it can be one ULP off.
+  const mantissa_t maxMantissa = 1000000000000000000;  // 1e18
+  int8_t firstDroppedDigit = -1;
+
+  while (isdigit(*s)) {
+    if (mantissa < maxMantissa) {
+      mantissa = mantissa * 10 + uint8_t(*s - '0');
+    } else {
+      exponent_offset++;
+      if (firstDroppedDigit < 0)
+        firstDroppedDigit = int8_t(*s - '0');
+    }
+    s++;
+  }
+
+  if (*s == '.') {
+    s++;
+    while (isdigit(*s)) {
+      if (mantissa < maxMantissa) {
+        mantissa = mantissa * 10 + uint8_t(*s - '0');
+        exponent_offset--;
+      } else if (firstDroppedDigit < 0) {
+        firstDroppedDigit = int8_t(*s - '0');
+      }
+      s++;
+    }
+  }
+
+  if (firstDroppedDigit >= 5)
+    mantissa++;
+
+  // only prevents overflows, decimalToFloat() knows the actual range
+  const int exponent_max = 10000;
+#else
+  const int exponent_max = traits::exponent_max;
+
   // avoid mantissa overflow
   while (mantissa > traits::mantissa_max) {
     mantissa /= 10;
@@ -184,6 +238,7 @@ inline Number parseNumber(const char* s) {
       s++;
     }
   }
+#endif
 
   int exponent = 0;
   if (*s == 'e' || *s == 'E') {
@@ -198,7 +253,7 @@ inline Number parseNumber(const char* s) {
 
     while (isdigit(*s)) {
       exponent = exponent * 10 + (*s - '0');
-      if (exponent + exponent_offset > traits::exponent_max) {
+      if (exponent + exponent_offset > exponent_max) {
         if (negative_exponent)
           return Number(is_negative ? -0.0f : 0.0f);
         else
@@ -215,7 +270,22 @@ inline Number parseNumber(const char* s) {
   if (*s != '\0')
     return Number();
 
-#if ARDUINOJSON_USE_DOUBLE
+#if ARDUINOJSON_USE_FAST_FLOAT_ENGINE
+#  if ARDUINOJSON_USE_DOUBLE
+  bool isDouble = exponent < -FloatTraits<float>::exponent_max ||
+                  exponent > FloatTraits<float>::exponent_max ||
+                  mantissa > FloatTraits<float>::mantissa_max;
+  if (isDouble) {
+    auto final_result = parseFloat<double>(mantissa, exponent);
+    return Number(is_negative ? -final_result : final_result);
+  } else
+#  endif
+  {
+    auto final_result = parseFloat<float>(mantissa, exponent);
+    return Number(is_negative ? -final_result : final_result);
+  }
+#else
+#  if ARDUINOJSON_USE_DOUBLE
   bool isDouble = exponent < -FloatTraits<float>::exponent_max ||
                   exponent > FloatTraits<float>::exponent_max ||
                   mantissa > FloatTraits<float>::mantissa_max;
@@ -223,11 +293,12 @@ inline Number parseNumber(const char* s) {
     auto final_result = make_float(double(mantissa), exponent);
     return Number(is_negative ? -final_result : final_result);
   } else
-#endif
+#  endif
   {
     auto final_result = make_float(float(mantissa), exponent);
     return Number(is_negative ? -final_result : final_result);
   }
+#endif
 }
 
 template <typename T>
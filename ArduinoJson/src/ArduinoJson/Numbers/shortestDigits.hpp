@@ -0,0 +1,256 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/decimalToFloat.hpp>
+#include <ArduinoJson/Polyfills/alias_cast.hpp>
+#include <ArduinoJson/Polyfills/integer.hpp>
+#include <ArduinoJson/Polyfills/pgmspace_generic.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The value is 0.digits * 10^exponent, with the digits in ASCII
+struct ShortestDigits {
+  char digits[18];
+  uint8_t count;
+  int16_t exponent;  // the position of the decimal point
+};
+
+// A floating point number f * 2^e, for the computations of Grisu
+struct DiyFp {
+  uint64_t f;
+  int e;
+
+  DiyFp operator-(const DiyFp& other) const {
+    return {f - other.f, e};
+  }
+
+  // Rounded product, keeping the upper 64 bits
+  DiyFp operator*(const DiyFp& other) const {
+    uint128 product = multiply128(f, other.f);
+    return {product.high + (product.low >> 63), e + other.e + 64};
+  }
+
+  DiyFp normalized() const {
+    int shift = countLeadingZeros(f);
+    return {f << shift, e - shift};
+  }
+
+  DiyFp normalizedTo(int exponent) const {
+    return {f << (e - exponent), exponent};
+  }
+};
+
+struct CachedPower {
+  uint64_t f;
+  int e;
+  int k;
+};
+
+// Returns c = 10^k normalized, so that e + c.e is in [-60, -32]
+inline CachedPower cachedPowerFor(int e) {
+  // 10^k for k in [-300, 324] by steps of 8
+  ARDUINOJSON_DEFINE_PROGMEM_ARRAY(  //
+      uint64_t, powers,
+      {
+          0xAB70FE17C79AC6CA,  // 1e-300
+          0xFF77B1FCBEBCDC4F,  // 1e-292
+          0xBE5691EF416BD60C,  // 1e-284
+          0x8DD01FAD907FFC3C,  // 1e-276
+          0xD3515C2831559A83,  // 1e-268
+          0x9D71AC8FADA6C9B5,  // 1e-260
+          0xEA9C227723EE8BCB,  // 1e-252
+          0xAECC49914078536D,  // 1e-244
+          0x823C12795DB6CE57,  // 1e-236
+          0xC21094364DFB5637,  // 1e-228
+          0x9096EA6F3848984F,  // 1e-220
+          0xD77485CB25823AC7,  // 1e-212
+          0xA086CFCD97BF97F4,  // 1e-204
+          0xEF340A98172AACE5,  // 1e-196
+          0xB23867FB2A35B28E,  // 1e-188
+          0x84C8D4DFD2C63F3B,  // 1e-180
+          0xC5DD44271AD3CDBA,  // 1e-172
+          0x936B9FCEBB25C996,  // 1e-164
+          0xDBAC6C247D62A584,  // 1e-156
+          0xA3AB66580D5FDAF6,  // 1e-148
+          0xF3E2F893DEC3F126,  // 1e-140
+          0xB5B5ADA8AAFF80B8,  // 1e-132
+          0x87625F056C7C4A8B,  // 1e-124
+          0xC9BCFF6034C13053,  // 1e-116
+          0x964E858C91BA2655,  // 1e-108
+          0xDFF9772470297EBD,  // 1e-100
+          0xA6DFBD9FB8E5B88F,  // 1e-92
+          0xF8A95FCF88747D94,  // 1e-84
+          0xB94470938FA89BCF,  // 1e-76
+          0x8A08F0F8BF0F156B,  // 1e-68
+          0xCDB02555653131B6,  // 1e-60
+          0x993FE2C6D07B7FAC,  // 1e-52
+          0xE45C10C42A2B3B06,  // 1e-44
+          0xAA242499697392D3,  // 1e-36
+          0xFD87B5F28300CA0E,  // 1e-28
+          0xBCE5086492111AEB,  // 1e-20
+          0x8CBCCC096F5088CC,  // 1e-12
+          0xD1B71758E219652C,  // 1e-4
+          0x9C40000000000000,  // 1e4
+          0xE8D4A51000000000,  // 1e12
+          0xAD78EBC5AC620000,  // 1e20
+          0x813F3978F8940984,  // 1e28
+          0xC097CE7BC90715B3,  // 1e36
+          0x8F7E32CE7BEA5C70,  // 1e44
+          0xD5D238A4ABE98068,  // 1e52
+          0x9F4F2726179A2245,  // 1e60
+          0xED63A231D4C4FB27,  // 1e68
+          0xB0DE65388CC8ADA8,  // 1e76
+          0x83C7088E1AAB65DB,  // 1e84
+          0xC45D1DF942711D9A,  // 1e92
+          0x924D692CA61BE758,  // 1e100
+          0xDA01EE641A708DEA,  // 1e108
+          0xA26DA3999AEF774A,  // 1e116
+          0xF209787BB47D6B85,  // 1e124
+          0xB454E4A179DD1877,  // 1e132
+          0x865B86925B9BC5C2,  // 1e140
+          0xC83553C5C8965D3D,  // 1e148
+          0x952AB45CFA97A0B3,  // 1e156
+          0xDE469FBD99A05FE3,  // 1e164
+          0xA59BC234DB398C25,  // 1e172
+          0xF6C69A72A3989F5C,  // 1e180
+          0xB7DCBF5354E9BECE,  // 1e188
+          0x88FCF317F22241E2,  // 1e196
+          0xCC20CE9BD35C78A5,  // 1e204
+          0x98165AF37B2153DF,  // 1e212
+          0xE2A0B5DC971F303A,  // 1e220
+          0xA8D9D1535CE3B396,  // 1e228
+          0xFB9B7CD9A4A7443C,  // 1e236
+          0xBB764C4CA7A44410,  // 1e244
+          0x8BAB8EEFB6409C1A,  // 1e252
+          0xD01FEF10A657842C,  // 1e260
+          0x9B10A4E5E9913129,  // 1e268
+          0xE7109BFBA19C0C9D,  // 1e276
+          0xAC2820D9623BF429,  // 1e284
+          0x80444B5E7AA7CF85,  // 1e292
+          0xBF21E44003ACDD2D,  // 1e300
+          0x8E679C2F5E44FF8F,  // 1e308
+          0xD433179D9C8CB841,  // 1e316
+          0x9E19DB92B4E31BA9   // 1e324
+      });
+  int f = -60 - e - 1;
+  int k = (f * 78913) / (1 << 18) + (f > 0);  // ceil(f * log10(2))
+  int index = (300 + k + 7) / 8;
+  k = index * 8 - 300;
+  // binary exponent: floor(k * log2(10)) - 63
+  return {pgm_read(powers + index), ((k * 217706) >> 16) - 63, k};
+}
+
+// Computes the upper bound w+ and the lower bound w- of the interval of
+// numbers that round to the value; w+ is normalized, w- has the same
+// exponent.
+template <typename T>
+inline void computeBoundaries(T value, DiyFp& v, DiyFp& minus, DiyFp& plus) {
+  using format = BinaryFormat<T>;
+  using bits_type = typename format::bits_type;
+  const int bias = -format::minimumExponent + format::mantissaBits;
+  const uint64_t hiddenBit = uint64_t(1) << format::mantissaBits;
+
+  bits_type bits = alias_cast<bits_type>(value);
+  uint64_t fraction = bits & (hiddenBit - 1);
+  int exponent = int(bits >> format::mantissaBits);
+
+  if (exponent == 0)  // subnormal
+    v = {fraction, 1 - bias};
+  else
+    v = {fraction + hiddenBit, exponent - bias};
+
+  // the gap below the value is smaller at powers of two
+  bool lowerIsCloser = fraction == 0 && exponent > 1;
+  plus = DiyFp{2 * v.f + 1, v.e - 1}.normalized();
+  minus = lowerIsCloser ? DiyFp{4 * v.f - 1, v.e - 2}
+                        : DiyFp{2 * v.f - 1, v.e - 1};
+  minus = minus.normalizedTo(plus.e);
+}
+
+// Moves the last digit closer to w, while staying in the interval
+inline void roundLastDigit(ShortestDigits& result, uint64_t distance,
+                           uint64_t delta, uint64_t rest, uint64_t tenK) {
+  while (rest < distance && delta - rest >= tenK &&
+         (rest + tenK < distance || distance - rest > rest + tenK - distance)) {
+    result.digits[result.count - 1]--;
+    rest += tenK;
+  }
+}
+
+// Generates the shortest digits of a number in [minus, plus], as close as
+// possible to w
+inline void generateDigits(ShortestDigits& result, int& decimalExponent,
+                           DiyFp minus, DiyFp w, DiyFp plus) {
+  uint64_t delta = (plus - minus).f;
+  uint64_t distance = (plus - w).f;
+
+  const int shift = -plus.e;
+  const uint64_t one = uint64_t(1) << shift;
+  uint32_t integral = uint32_t(plus.f >> shift);
+  uint64_t fractional = plus.f & (one - 1);
+
+  uint32_t divisor = 1000000000;
+  int digits = 10;
+  while (digits > 1 && divisor > integral) {
+    divisor /= 10;
+    digits--;
+  }
+
+  while (digits > 0) {
+    result.digits[result.count++] = char('0' + integral / divisor);
+    integral %= divisor;
+    digits--;
+    uint64_t rest = (uint64_t(integral) << shift) + fractional;
+    if (rest <= delta) {
+      decimalExponent += digits;
+      roundLastDigit(result, distance, delta, rest, uint64_t(divisor) << shift);
+      return;
+    }
+    divisor /= 10;
+  }
+
+  for (;;) {
+    fractional *= 10;
+    result.digits[result.count++] = char('0' + (fractional >> shift));
+    fractional &= one - 1;
+    decimalExponent--;
+    delta *= 10;
+    distance *= 10;
+    if (fractional <= delta)
+      break;
+  }
+  roundLastDigit(result, distance, delta, fractional, one);
+}
+
+// Computes the shortest digits that parse back to the same value, using
+// Florian Loitsch's Grisu2 algorithm, which finds the shortest
+// representation in more than 99% of the cases, and a close one otherwise.
+// It works on integers only, so it doesn't need double-precision hardware.
+// The value must be finite and strictly positive.
+template <typename T>
+inline ShortestDigits shortestDigits(T value) {
+  DiyFp v, minus, plus;
+  computeBoundaries(value, v, minus, plus);
+
+  CachedPower power = cachedPowerFor(plus.e);
+  DiyFp c = {power.f, power.e};
+  DiyFp w = v.normalized() * c;
+  DiyFp wMinus = minus * c;
+  DiyFp wPlus = plus * c;
+
+  // the products may be off by one, stay on the safe side
+  wMinus.f++;
+  wPlus.f--;
+
+  ShortestDigits result;
+  result.count = 0;
+  int decimalExponent = -power.k;
+  generateDigits(result, decimalExponent, wMinus, w, wPlus);
+  result.exponent = int16_t(decimalExponent + result.count);
+  return result;
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
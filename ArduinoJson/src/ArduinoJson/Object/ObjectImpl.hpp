@@ -34,13 +34,28 @@ inline ObjectData::iterator ObjectData::findKey(
     TAdaptedString key, const ResourceManager* resources) const {
   if (key.isNull())
     return iterator();
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  SlotId keyId;
+  if (resources->findIndexedKey(this, key, keyId))
+    return keyId != NULL_SLOT ? createIterator(keyId, resources) : iterator();
+  size_t scanned = 0;
+#endif
   bool isKey = true;
-  for (auto it = createIterator(resources); !it.done(); it.next(resources)) {
+  auto it = createIterator(resources);
+  for (; !it.done(); it.next(resources)) {
     if (isKey && stringEquals(key, adaptString(it->asString())))
-      return it;
+      break;
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    scanned++;
+#endif
     isKey = !isKey;
   }
-  return iterator();
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  // that was a long walk, index the object for the next lookups
+  if (scanned >= 2 * ARDUINOJSON_OBJECT_INDEX_THRESHOLD)
+    resources->indexObject(this);
+#endif
+  return it;
 }
 
 template <typename TAdaptedString>
@@ -65,6 +80,10 @@ inline VariantData* ObjectData::addMember(TAdaptedString key,
 
   CollectionData::appendPair(keySlot, valueSlot, resources);
 
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  resources->memberAdded(this, keySlot.id());
+#endif
+
   return valueSlot.ptr();
 }
 
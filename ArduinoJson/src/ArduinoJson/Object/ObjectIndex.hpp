@@ -0,0 +1,88 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+
+#include <stddef.h>  // size_t
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+class CollectionData;
+class ObjectData;
+class ResourceManager;
+
+// A hash table of the keys of one large object, so that looking up a member
+// doesn't require walking the whole slot list.
+// It's only a cache: it's built after a lookup walked past
+// ARDUINOJSON_OBJECT_INDEX_THRESHOLD members, kept up to date when members
+// are appended, and dropped when a member is removed or the object cleared.
+// Only the last indexed object is covered.
+class ObjectIndex {
+ public:
+  ObjectIndex() : owner_(nullptr), table_(nullptr), capacity_(0), count_(0) {}
+
+  friend void swap(ObjectIndex& a, ObjectIndex& b) {
+    swap_(a.owner_, b.owner_);
+    swap_(a.table_, b.table_);
+    swap_(a.capacity_, b.capacity_);
+    swap_(a.count_, b.count_);
+  }
+
+  void clear(Allocator* allocator) {
+    if (table_)
+      allocator->deallocate(table_);
+    owner_ = nullptr;
+    table_ = nullptr;
+    capacity_ = 0;
+    count_ = 0;
+  }
+
+  void invalidate() {
+    owner_ = nullptr;
+  }
+
+  void invalidate(const CollectionData* collection) {
+    if (owner_ == collection)
+      owner_ = nullptr;
+  }
+
+  // Returns false if the object isn't indexed, in which case the caller must
+  // walk the slot list.
+  // Otherwise, stores the id of the key slot, or NULL_SLOT, in keyId.
+  template <typename TAdaptedString>
+  bool find(const ObjectData* object, TAdaptedString key,
+            const ResourceManager* resources, SlotId& keyId) const;
+
+  // Indexes all the keys of the object, fails silently if out of memory.
+  void build(const ObjectData* object, const ResourceManager* resources,
+             Allocator* allocator);
+
+  // Must be called after a member was appended to the object.
+  void add(const ObjectData* object, SlotId keyId,
+           const ResourceManager* resources, Allocator* allocator);
+
+ private:
+  bool reserve(size_t count, Allocator* allocator);
+  void insert(SlotId keyId, const ResourceManager* resources);
+
+  size_t mask() const {
+    return capacity_ - 1;
+  }
+
+  // Keeps the load factor at or below 3/4
+  static bool fits(size_t count, size_t capacity) {
+    return count * 4 <= capacity * 3;
+  }
+
+  const CollectionData* owner_;
+  SlotId* table_;    // key slot ids, NULL_SLOT for empty buckets
+  size_t capacity_;  // a power of two
+  size_t count_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,99 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Object/ObjectData.hpp>
+#include <ArduinoJson/Object/ObjectIndex.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename TAdaptedString>
+inline bool ObjectIndex::find(const ObjectData* object, TAdaptedString key,
+                              const ResourceManager* resources,
+                              SlotId& keyId) const {
+  if (owner_ != object)
+    return false;
+  for (size_t i = stringHash(key) & mask();; i = (i + 1) & mask()) {
+    keyId = table_[i];
+    if (keyId == NULL_SLOT)
+      return true;
+    auto slot = resources->getVariant(keyId);
+    if (stringEquals(key, adaptString(slot->asString())))
+      return true;
+  }
+}
+
+inline void ObjectIndex::build(const ObjectData* object,
+                               const ResourceManager* resources,
+                               Allocator* allocator) {
+  owner_ = nullptr;
+  if (!reserve(object->size(resources), allocator))
+    return;
+  for (size_t i = 0; i < capacity_; i++)
+    table_[i] = NULL_SLOT;
+  count_ = 0;
+  bool isKey = true;
+  auto id = object->head();
+  for (auto it = object->createIterator(resources); !it.done();
+       it.next(resources)) {
+    if (isKey)
+      insert(id, resources);
+    id = it->next();
+    isKey = !isKey;
+  }
+  owner_ = object;
+}
+
+inline void ObjectIndex::add(const ObjectData* object, SlotId keyId,
+                             const ResourceManager* resources,
+                             Allocator* allocator) {
+  if (owner_ != object)
+    return;
+  if (fits(count_ + 1, capacity_))
+    insert(keyId, resources);
+  else
+    build(object, resources, allocator);  // the new key is already linked
+}
+
+inline bool ObjectIndex::reserve(size_t count, Allocator* allocator) {
+  size_t capacity = capacity_ ? capacity_ : 16;
+  while (!fits(count + 1, capacity))
+    capacity *= 2;
+  if (capacity == capacity_)
+    return true;
+  auto size = capacity * sizeof(SlotId);
+  auto table = reinterpret_cast<SlotId*>(
+      table_ ? allocator->reallocate(table_, size) : allocator->allocate(size));
+  if (!table)
+    return false;  // keep the old buffer, it's freed with the rest
+  table_ = table;
+  capacity_ = capacity;
+  return true;
+}
+
+inline void ObjectIndex::insert(SlotId keyId,
+                                const ResourceManager* resources) {
+  auto key = adaptString(resources->getVariant(keyId)->asString());
+  for (size_t i = stringHash(key) & mask();; i = (i + 1) & mask()) {
+    SlotId other = table_[i];
+    if (other == NULL_SLOT) {
+      table_[i] = keyId;
+      count_++;
+      return;
+    }
+    // duplicate keys: the first one wins, like in the linear search
+    if (stringEquals(key, adaptString(resources->getVariant(other)->asString())))
+      return;
+  }
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+#endif
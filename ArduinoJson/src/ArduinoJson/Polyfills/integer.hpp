@@ -31,4 +31,38 @@ struct uint_<32> {
 template <int Bits>
 using uint_t = typename uint_<Bits>::type;
 
+struct uint128 {
+  uint64_t high;
+  uint64_t low;
+};
+
+// Full product of two 64-bit integers
+inline uint128 multiply128(uint64_t a, uint64_t b) {
+  uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+  uint64_t bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+  uint64_t ll = aLow * bLow, lh = aLow * bHigh;
+  uint64_t hl = aHigh * bLow, hh = aHigh * bHigh;
+  uint64_t middle = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+  return {hh + (lh >> 32) + (hl >> 32) + (middle >> 32),
+          (middle << 32) | (ll & 0xFFFFFFFF)};
+}
+
+// Requires a non-zero value
+inline int countLeadingZeros(uint64_t value) {
+#if defined(__GNUC__)
+  return __builtin_clzll(value);
+#else
+  int count = 0;
+  if (!(value >> 32)) {
+    count += 32;
+    value <<= 32;
+  }
+  while (!(value >> 63)) {
+    count++;
+    value <<= 1;
+  }
+  return count;
+#endif
+}
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -62,6 +62,19 @@ stringEquals(TAdaptedString1 s1, TAdaptedString2 s2) {
   return stringEquals(s2, s1);
 }
 
+// FNV-1a
+template <typename TAdaptedString>
+uint32_t stringHash(TAdaptedString s) {
+  ARDUINOJSON_ASSERT(!s.isNull());
+  uint32_t hash = 2166136261u;
+  size_t n = s.size();
+  for (size_t i = 0; i < n; i++) {
+    hash ^= uint8_t(s[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
 template <typename TAdaptedString>
 static void stringGetChars(TAdaptedString s, char* p, size_t n) {
   ARDUINOJSON_ASSERT(s.size() <= n);
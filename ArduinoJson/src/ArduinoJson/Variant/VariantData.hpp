@@ -75,6 +75,10 @@ class VariantData {
         return visit.visit(RawString(content_.asOwnedString->data,
                                      content_.asOwnedString->length));
 
+      case VariantType::LinkedRawString:
+        return visit.visit(RawString(content_.asLinkedString,
+                                     linkedRawSize(content_.asLinkedString)));
+
       case VariantType::Int32:
         return visit.visit(static_cast<JsonInteger>(content_.asInt32));
 
@@ -201,6 +205,7 @@ class VariantData {
         return static_cast<T>(extension->asInt64);
 #endif
       case VariantType::LinkedString:
+        return parseNumber<T>(content_.asLinkedString);
       case VariantType::OwnedString:
         return parseNumber<T>(content_.asOwnedString->data);
       case VariantType::Float:
@@ -263,6 +268,10 @@ class VariantData {
       case VariantType::RawString:
         return JsonString(content_.asOwnedString->data,
                           content_.asOwnedString->length, JsonString::Copied);
+      case VariantType::LinkedRawString:
+        return JsonString(content_.asLinkedString,
+                          linkedRawSize(content_.asLinkedString),
+                          JsonString::Linked);
       default:
         return JsonString();
     }
@@ -462,6 +471,14 @@ class VariantData {
     content_.asOwnedString = s;
   }
 
+  // Links a MessagePack bin or ext that stays in the input buffer
+  void setLinkedRawString(const char* s) {
+    ARDUINOJSON_ASSERT(type_ == VariantType::Null);  // must call clear() first
+    ARDUINOJSON_ASSERT(s);
+    type_ = VariantType::LinkedRawString;
+    content_.asLinkedString = s;
+  }
+
   template <typename T>
   void setRawString(SerializedValue<T> value, ResourceManager* resources);
 
@@ -559,6 +576,35 @@ class VariantData {
       return;
     var->clear(resources);
   }
+
+ private:
+  // A linked raw string starts with the header of a MessagePack bin or ext,
+  // which gives its size.
+  static size_t linkedRawSize(const char* s) {
+    auto p = reinterpret_cast<const uint8_t*>(s);
+    switch (p[0]) {
+      case 0xc4:  // bin 8
+        return size_t(2 + p[1]);
+      case 0xc5:  // bin 16
+        return size_t(3 + (p[1] << 8 | p[2]));
+      case 0xc6:  // bin 32
+        return 5 + readSize32(p + 1);
+      case 0xc7:  // ext 8
+        return size_t(3 + p[1]);
+      case 0xc8:  // ext 16
+        return size_t(4 + (p[1] << 8 | p[2]));
+      case 0xc9:  // ext 32
+        return 6 + readSize32(p + 1);
+      default:  // fixext
+        ARDUINOJSON_ASSERT(p[0] >= 0xd4 && p[0] <= 0xd8);
+        return 2 + (size_t(1) << (p[0] - 0xd4));
+    }
+  }
+
+  static size_t readSize32(const uint8_t* p) {
+    return size_t(uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 |
+                  uint32_t(p[2]) << 8 | p[3]);
+  }
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -42,7 +42,7 @@ inline bool VariantData::setString(TAdaptedString value,
 
 inline void VariantData::clear(ResourceManager* resources) {
   if (type_ & VariantTypeBits::OwnedStringBit)
-    resources->dereferenceString(content_.asOwnedString->data);
+    resources->dereferenceString(content_.asOwnedString);
 
 #if ARDUINOJSON_USE_EXTENSIONS
   if (type_ & VariantTypeBits::ExtensionBit)
@@ -74,28 +74,57 @@ void AsyncElegantOtaClass::begin(AsyncWebServer *server, const char* username, c
             }
 
             #if defined(ESP8266)
+                if (filename == "delta") {
+                    return request->send(400, "text/plain", "Delta updates need an ESP32");
+                }
                 int cmd = (filename == "filesystem") ? U_FS : U_FLASH;
                 Update.runAsync(true);
                 size_t fsSize = ((size_t) &_FS_end - (size_t) &_FS_start);
                 uint32_t maxSketchSpace = (ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000;
                 if (!Update.begin((cmd == U_FS)?fsSize:maxSketchSpace, cmd)){ // Start with max available size
             #elif defined(ESP32)
+                // an earlier upload that never finished still has the writer
+                abortWriter();
+                _delta = (filename == "delta");
+                if (_delta) {
+                    _deltaDecoder.begin(ESP.getSketchSize());
+                }
                 int cmd = (filename == "filesystem") ? U_SPIFFS : U_FLASH;
                 if (!Update.begin(UPDATE_SIZE_UNKNOWN, cmd)) { // Start with max available size
             #endif
                 Update.printError(Serial);
                 return request->send(400, "text/plain", "OTA could not begin");
             }
+            #if defined(ESP32)
+                if (!startWriter()) {
+                    Update.abort();
+                    return request->send(400, "text/plain", "OTA could not begin");
+                }
+            #endif
         }
 
         // Write chunked data to the free sketch space
         if(len){
-            if (Update.write(data, len) != len) {
+            #if defined(ESP8266)
+                if (Update.write(data, len) != len) {
+            #elif defined(ESP32)
+                if (!feedWriter(data, len)) {
+            #endif
                 return request->send(400, "text/plain", "OTA could not begin");
             }
         }
             
         if (final) { // if the final flag is set then this is the last frame of data
+            #if defined(ESP32)
+                if (!finishWriter()) {
+                    Update.printError(Serial);
+                    return request->send(400, "text/plain", "Could not end OTA");
+                }
+                if (_delta && !_deltaDecoder.done()) {
+                    Update.abort();
+                    return request->send(400, "text/plain", "Incomplete delta");
+                }
+            #endif
             if (!Update.end(true)) { //true to set the size to the current progress
                 Update.printError(Serial);
                 return request->send(400, "text/plain", "Could not end OTA");
@@ -106,6 +135,104 @@ void AsyncElegantOtaClass::begin(AsyncWebServer *server, const char* username, c
     });
 }
 
+#if defined(ESP32)
+bool AsyncElegantOtaClass::startWriter(){
+    _ring = xStreamBufferCreate(ELEGANT_OTA_RING_SIZE, 1);
+    _writerDone = xSemaphoreCreateBinary();
+    _inputDone = false;
+    _writeFailed = false;
+    if (_ring == NULL || _writerDone == NULL ||
+        xTaskCreate(writerTask, "ota_writer", 4096, this, 1, NULL) != pdPASS) {
+        if (_ring != NULL) {
+            vStreamBufferDelete(_ring);
+        }
+        if (_writerDone != NULL) {
+            vSemaphoreDelete(_writerDone);
+        }
+        _ring = NULL;
+        _writerDone = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool AsyncElegantOtaClass::feedWriter(const uint8_t *data, size_t len){
+    if (_ring == NULL || _writeFailed) {
+        return false;
+    }
+    // blocks only while the writer is a full ring behind, which holds the
+    // TCP window closed instead of dropping data
+    while (len > 0) {
+        size_t sent = xStreamBufferSend(_ring, data, len, pdMS_TO_TICKS(ELEGANT_OTA_RING_TIMEOUT));
+        if (sent == 0 || _writeFailed) {
+            return false;
+        }
+        data += sent;
+        len -= sent;
+    }
+    return true;
+}
+
+bool AsyncElegantOtaClass::finishWriter(){
+    if (_ring == NULL) {
+        return false;
+    }
+    _inputDone = true;
+    // wait for the writer to drain the ring
+    xSemaphoreTake(_writerDone, portMAX_DELAY);
+    bool ok = !_writeFailed;
+    vStreamBufferDelete(_ring);
+    vSemaphoreDelete(_writerDone);
+    _ring = NULL;
+    _writerDone = NULL;
+    return ok;
+}
+
+void AsyncElegantOtaClass::abortWriter(){
+    if (_ring == NULL) {
+        return;
+    }
+    // the writer discards what is left and exits
+    _writeFailed = true;
+    finishWriter();
+    Update.abort();
+}
+
+void AsyncElegantOtaClass::writerTask(void *arg){
+    AsyncElegantOtaClass *ota = (AsyncElegantOtaClass *)arg;
+    static uint8_t buf[1024];
+    uint32_t idle = 0;
+
+    for (;;) {
+        size_t n = xStreamBufferReceive(ota->_ring, buf, sizeof(buf), pdMS_TO_TICKS(100));
+        if (n > 0) {
+            idle = 0;
+            // Update erases each sector ahead of writing it and keeps the
+            // MD5 of the image up to date as the data goes by
+            if (!ota->_writeFailed) {
+                bool ok = ota->_delta ? ota->_deltaDecoder.write(buf, n)
+                                      : (Update.write(buf, n) == n);
+                if (!ok) {
+                    ota->_writeFailed = true;
+                }
+            }
+            continue;
+        }
+        if (ota->_inputDone) {
+            break;
+        }
+        idle += 100;
+        if (idle >= ELEGANT_OTA_IDLE_TIMEOUT) {
+            // the upload was abandoned, free the ring for the next one
+            ota->_writeFailed = true;
+            ota->_inputDone = true;
+        }
+    }
+    xSemaphoreGive(ota->_writerDone);
+    vTaskDelete(NULL);
+}
+#endif
+
 // deprecated, keeping for backward compatibility
 void AsyncElegantOtaClass::loop() {
 }
@@ -17,6 +17,22 @@
     #include "Update.h"
     #include "esp_int_wdt.h"
     #include "esp_task_wdt.h"
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/stream_buffer.h"
+    #include "freertos/semphr.h"
+
+    // Bytes buffered between the upload handler and the flash writer task
+    #ifndef ELEGANT_OTA_RING_SIZE
+        #define ELEGANT_OTA_RING_SIZE 16384
+    #endif
+    // How long the upload handler waits for room in the ring buffer, in ms
+    #ifndef ELEGANT_OTA_RING_TIMEOUT
+        #define ELEGANT_OTA_RING_TIMEOUT 5000
+    #endif
+    // The writer gives up on an upload that sends nothing for this long, in ms
+    #ifndef ELEGANT_OTA_IDLE_TIMEOUT
+        #define ELEGANT_OTA_IDLE_TIMEOUT 30000
+    #endif
 #endif
 
 #include "Hash.h"
@@ -24,6 +40,7 @@
 #include "FS.h"
 
 #include "elegantWebpage.h"
+#include "OtaDelta.h"
 
 
 class AsyncElegantOtaClass{
@@ -45,6 +62,26 @@ class AsyncElegantOtaClass{
         String _password = "";
         bool _authRequired = false;
 
+        #if defined(ESP32)
+            // Pipelined writer: the upload handler only copies into _ring,
+            // and a task drains it through Update.write(), so flash erase
+            // and write stalls stay off the network receive path
+            StreamBufferHandle_t _ring = NULL;
+            SemaphoreHandle_t _writerDone = NULL;
+            volatile bool _inputDone = false;
+            volatile bool _writeFailed = false;
+
+            // Set when the upload is a delta, see OtaDelta.h
+            bool _delta = false;
+            OtaDeltaDecoder _deltaDecoder;
+
+            bool startWriter();
+            bool feedWriter(const uint8_t *data, size_t len);
+            bool finishWriter();
+            void abortWriter();
+            static void writerTask(void *arg);
+        #endif
+
 };
 
 extern AsyncElegantOtaClass AsyncElegantOTA;
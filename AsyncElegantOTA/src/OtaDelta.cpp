@@ -0,0 +1,145 @@
+#include "OtaDelta.h"
+
+#if defined(ESP32)
+
+#include "Update.h"
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+
+void OtaDeltaDecoder::begin(uint32_t sourceSize){
+    _sourceSize = sourceSize;
+    _written = 0;
+    _targetSize = 0;
+    _remaining = 0;
+    expect(STATE_HEADER, 12);
+}
+
+bool OtaDeltaDecoder::write(const uint8_t *data, size_t len){
+    while (len > 0 && _state != STATE_ERROR) {
+        if (_state == STATE_DONE) {
+            // nothing may follow END
+            _state = STATE_ERROR;
+            break;
+        }
+        if (_state == STATE_DATA) {
+            size_t n = (len < _remaining) ? len : _remaining;
+            if (!emit(data, n)) {
+                break;
+            }
+            data += n;
+            len -= n;
+            _remaining -= n;
+            if (_remaining == 0) {
+                expect(STATE_OPCODE, 1);
+            }
+            continue;
+        }
+
+        // gather the fixed size fields, which may be split across chunks
+        size_t n = _fieldNeed - _fieldLen;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(_field + _fieldLen, data, n);
+        _fieldLen += n;
+        data += n;
+        len -= n;
+        if (_fieldLen == _fieldNeed && !handleField()) {
+            _state = STATE_ERROR;
+        }
+    }
+    return _state != STATE_ERROR;
+}
+
+void OtaDeltaDecoder::expect(uint8_t state, uint8_t len){
+    _state = (decltype(_state))state;
+    _fieldLen = 0;
+    _fieldNeed = len;
+}
+
+bool OtaDeltaDecoder::handleField(){
+    switch (_state) {
+        case STATE_HEADER:
+            if (memcmp(_field, OTA_DELTA_MAGIC, 4) != 0 || _field[4] != OTA_DELTA_VERSION) {
+                return false;
+            }
+            _targetSize = le32(_field + 8);
+            expect(STATE_OPCODE, 1);
+            return true;
+
+        case STATE_OPCODE:
+            _op = _field[0];
+            if (_op == 0x00) {
+                if (_written != _targetSize) {
+                    return false;
+                }
+                expect(STATE_DONE, 0);
+                return true;
+            }
+            if (_op == 0x01) {
+                expect(STATE_ARGS, 8);
+                return true;
+            }
+            if (_op == 0x02) {
+                expect(STATE_ARGS, 4);
+                return true;
+            }
+            return false;
+
+        case STATE_ARGS:
+            if (_op == 0x01) {
+                if (!copy(le32(_field), le32(_field + 4))) {
+                    return false;
+                }
+                expect(STATE_OPCODE, 1);
+                return true;
+            }
+            _remaining = le32(_field);
+            if (_remaining == 0) {
+                expect(STATE_OPCODE, 1);
+            } else {
+                expect(STATE_DATA, 0);
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool OtaDeltaDecoder::emit(const uint8_t *data, size_t len){
+    if (_written + len > _targetSize || Update.write((uint8_t *)data, len) != len) {
+        _state = STATE_ERROR;
+        return false;
+    }
+    _written += len;
+    return true;
+}
+
+bool OtaDeltaDecoder::copy(uint32_t offset, uint32_t len){
+    uint8_t buf[256];
+
+    if (offset > _sourceSize || len > _sourceSize - offset) {
+        return false;
+    }
+    while (len > 0) {
+        size_t n = (len < sizeof(buf)) ? len : sizeof(buf);
+        if (!readSource(offset, buf, n) || !emit(buf, n)) {
+            return false;
+        }
+        offset += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool OtaDeltaDecoder::readSource(uint32_t offset, uint8_t *buf, size_t len){
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    return running != NULL && esp_partition_read(running, offset, buf, len) == ESP_OK;
+}
+
+uint32_t OtaDeltaDecoder::le32(const uint8_t *p){
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef OtaDelta_h
+#define OtaDelta_h
+
+#include "Arduino.h"
+
+/*
+    Delta (binary diff) firmware updates.
+
+    A delta describes the new image as pieces copied from the running one
+    and bytes sent as they are. It is made by tools/ota_delta.py and
+    uploaded with the filename "delta". All numbers are little endian.
+
+    ESP32 only: copying from the running image can take a while, which is
+    fine on the writer task but not in the ESP8266 network callbacks.
+
+    Header (12 bytes):
+        "EOTD"          magic
+        uint8           version, 1
+        uint8[3]        reserved, 0
+        uint32          size of the new image
+    ...followed by operations, each starting with an opcode byte:
+        0x01 COPY       uint32 offset, uint32 length: bytes of the running image
+        0x02 DATA       uint32 length, then that many bytes of new data
+        0x00 END        the new image is complete
+
+    The MD5 sent with the upload is the one of the new image, so the usual
+    MD5 check verifies the rebuilt result.
+*/
+
+#if defined(ESP32)
+
+#define OTA_DELTA_MAGIC "EOTD"
+#define OTA_DELTA_VERSION 1
+
+class OtaDeltaDecoder{
+
+    public:
+        void begin(uint32_t sourceSize);
+        // Feeds bytes of the delta, writing the rebuilt image through Update
+        // Returns false once the delta is invalid or a write failed
+        bool write(const uint8_t *data, size_t len);
+        // True after the END operation of a complete image
+        bool done() const { return _state == STATE_DONE; }
+
+    private:
+        enum {
+            STATE_HEADER,
+            STATE_OPCODE,
+            STATE_ARGS,
+            STATE_DATA,
+            STATE_DONE,
+            STATE_ERROR
+        } _state = STATE_ERROR;
+
+        uint8_t _field[12];
+        uint8_t _fieldLen = 0;
+        uint8_t _fieldNeed = 0;
+        uint8_t _op = 0;
+
+        uint32_t _remaining = 0;
+        uint32_t _written = 0;
+        uint32_t _targetSize = 0;
+        uint32_t _sourceSize = 0;
+
+        void expect(uint8_t state, uint8_t len);
+        bool handleField();
+        bool emit(const uint8_t *data, size_t len);
+        bool copy(uint32_t offset, uint32_t len);
+        bool readSource(uint32_t offset, uint8_t *buf, size_t len);
+        static uint32_t le32(const uint8_t *p);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,90 @@
+# Makes a delta (binary diff) update for AsyncElegantOTA, see src/OtaDelta.h
+#
+# To use:
+#   python ota_delta.py <running firmware.bin> <new firmware.bin> <output.delta>
+#   python ota_delta.py <running firmware.bin> <new firmware.bin> <output.delta> --upload http://192.168.1.123/update
+#
+# The running image must be the exact .bin the device is running now, or
+# the MD5 check of the rebuilt image will fail and the update is rejected.
+
+import argparse
+import hashlib
+import struct
+
+MAGIC = b'EOTD'
+VERSION = 1
+BLOCK = 32      # shortest piece worth copying from the running image
+
+
+def make_delta(old, new):
+    # index every BLOCK-aligned block of the running image
+    index = {}
+    for pos in range(0, len(old) - BLOCK + 1, BLOCK):
+        index.setdefault(old[pos:pos + BLOCK], pos)
+
+    ops = []
+    literal_start = 0
+    i = 0
+    while i + BLOCK <= len(new):
+        src = index.get(new[i:i + BLOCK])
+        if src is None:
+            i += 1
+            continue
+        # grow the match both ways
+        start, length = i, BLOCK
+        while src > 0 and start > literal_start and old[src - 1] == new[start - 1]:
+            src -= 1
+            start -= 1
+            length += 1
+        while src + length < len(old) and start + length < len(new) and old[src + length] == new[start + length]:
+            length += 1
+        if start > literal_start:
+            ops.append((2, new[literal_start:start]))
+        ops.append((1, src, length))
+        i = start + length
+        literal_start = i
+    if literal_start < len(new):
+        ops.append((2, new[literal_start:]))
+
+    out = bytearray(MAGIC + struct.pack('<B3xI', VERSION, len(new)))
+    for op in ops:
+        if op[0] == 1:
+            out += struct.pack('<BII', 1, op[1], op[2])
+        else:
+            out += struct.pack('<BI', 2, len(op[1])) + op[1]
+    out += b'\x00'
+    return bytes(out)
+
+
+def upload(url, delta, md5):
+    import requests
+    response = requests.post(url, data={'MD5': md5},
+                             files={'firmware': ('delta', delta, 'application/octet-stream')})
+    print(response, response.text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Make a delta update for AsyncElegantOTA')
+    parser.add_argument('old', help='firmware the device is running')
+    parser.add_argument('new', help='firmware to update to')
+    parser.add_argument('output', help='delta file to write')
+    parser.add_argument('--upload', metavar='URL', help='upload the delta, e.g. http://192.168.1.123/update')
+    args = parser.parse_args()
+
+    with open(args.old, 'rb') as f:
+        old = f.read()
+    with open(args.new, 'rb') as f:
+        new = f.read()
+
+    delta = make_delta(old, new)
+    md5 = hashlib.md5(new).hexdigest()
+    with open(args.output, 'wb') as f:
+        f.write(delta)
+
+    print('%s: %d bytes for a %d byte image, MD5 %s' % (args.output, len(delta), len(new), md5))
+    if args.upload:
+        upload(args.upload, delta, md5)
+
+
+if __name__ == '__main__':
+    main()
@@ -78,6 +78,64 @@ typedef struct {
 
 static xQueueHandle _async_queue;
 static TaskHandle_t _async_service_task_handle = NULL;
+static uint16_t _async_queue_size = CONFIG_ASYNC_TCP_QUEUE_SIZE;
+static int _async_task_core = CONFIG_ASYNC_TCP_RUNNING_CORE;
+static uint8_t _async_task_priority = CONFIG_ASYNC_TCP_PRIORITY;
+static AsyncTaskStats _async_stats;
+
+/*
+ * Event Pool
+ * events are taken from a free list, filled once with _async_queue_size entries,
+ * and only fall back to malloc when it is empty
+ * */
+
+typedef union _async_pool_entry {
+        lwip_event_packet_t packet;
+        union _async_pool_entry * next;
+} async_pool_entry_t;
+
+static async_pool_entry_t * _async_pool = NULL;
+static async_pool_entry_t * _async_pool_free = NULL;
+static portMUX_TYPE _async_pool_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static bool _init_async_event_pool(){
+    _async_pool = (async_pool_entry_t *)malloc(sizeof(async_pool_entry_t) * _async_queue_size);
+    if(!_async_pool){
+        return false;
+    }
+    for (uint16_t i = 0; i < _async_queue_size; ++ i) {
+        _async_pool[i].next = (i + 1 < _async_queue_size) ? &_async_pool[i + 1] : NULL;
+    }
+    _async_pool_free = _async_pool;
+    return true;
+}
+
+static lwip_event_packet_t * _alloc_async_event(){
+    async_pool_entry_t * entry;
+    portENTER_CRITICAL(&_async_pool_mux);
+    entry = _async_pool_free;
+    if(entry){
+        _async_pool_free = entry->next;
+    }
+    portEXIT_CRITICAL(&_async_pool_mux);
+    if(!entry){
+        _async_stats.pool_misses++;
+        return (lwip_event_packet_t *)malloc(sizeof(lwip_event_packet_t));
+    }
+    return &entry->packet;
+}
+
+static void _free_async_event(lwip_event_packet_t * e){
+    async_pool_entry_t * entry = (async_pool_entry_t *)e;
+    if(!_async_pool || entry < _async_pool || entry >= _async_pool + _async_queue_size){
+        free((void*)(e));
+        return;
+    }
+    portENTER_CRITICAL(&_async_pool_mux);
+    entry->next = _async_pool_free;
+    _async_pool_free = entry;
+    portEXIT_CRITICAL(&_async_pool_mux);
+}
 
 
 SemaphoreHandle_t _slots_lock;
@@ -95,20 +153,40 @@ static uint32_t _closed_index = []() {
 
 static inline bool _init_async_event_queue(){
     if(!_async_queue){
-        _async_queue = xQueueCreate(32, sizeof(lwip_event_packet_t *));
+        if(!_init_async_event_pool()){
+            return false;
+        }
+        _async_queue = xQueueCreate(_async_queue_size, sizeof(lwip_event_packet_t *));
         if(!_async_queue){
+            free(_async_pool);
+            _async_pool = _async_pool_free = NULL;
             return false;
         }
     }
     return true;
 }
 
+static inline void _update_queue_high_water(){
+    UBaseType_t waiting = uxQueueMessagesWaiting(_async_queue);
+    if(waiting > _async_stats.queue_high_water){
+        _async_stats.queue_high_water = waiting;
+    }
+}
+
 static inline bool _send_async_event(lwip_event_packet_t ** e){
-    return _async_queue && xQueueSend(_async_queue, e, portMAX_DELAY) == pdPASS;
+    if(!_async_queue || xQueueSend(_async_queue, e, portMAX_DELAY) != pdPASS){
+        return false;
+    }
+    _update_queue_high_water();
+    return true;
 }
 
 static inline bool _prepend_async_event(lwip_event_packet_t ** e){
-    return _async_queue && xQueueSendToFront(_async_queue, e, portMAX_DELAY) == pdPASS;
+    if(!_async_queue || xQueueSendToFront(_async_queue, e, portMAX_DELAY) != pdPASS){
+        return false;
+    }
+    _update_queue_high_water();
+    return true;
 }
 
 static inline bool _get_async_event(lwip_event_packet_t ** e){
@@ -129,7 +207,7 @@ static bool _remove_events_with_arg(void * arg){
         }
         //discard packet if matching
         if((int)first_packet->arg == (int)arg){
-            free(first_packet);
+            _free_async_event(first_packet);
             first_packet = NULL;
         //return first packet to the back of the queue
         } else if(xQueueSend(_async_queue, &first_packet, portMAX_DELAY) != pdPASS){
@@ -142,7 +220,7 @@ static bool _remove_events_with_arg(void * arg){
             return false;
         }
         if((int)packet->arg == (int)arg){
-            free(packet);
+            _free_async_event(packet);
             packet = NULL;
         } else if(xQueueSend(_async_queue, &packet, portMAX_DELAY) != pdPASS){
             return false;
@@ -182,7 +260,7 @@ static void _handle_async_event(lwip_event_packet_t * e){
         //ets_printf("D: 0x%08x %s = %s\n", e->arg, e->dns.name, ipaddr_ntoa(&e->dns.addr));
         AsyncClient::_s_dns_found(e->dns.name, &e->dns.addr, e->arg);
     }
-    free((void*)(e));
+    _free_async_event(e);
 }
 
 static void _async_service_task(void *pvParameters){
@@ -194,7 +272,25 @@ static void _async_service_task(void *pvParameters){
                 log_e("Failed to add async task to WDT");
             }
 #endif
-            _handle_async_event(packet);
+            //handle what is already queued before blocking again
+            uint16_t count = 0;
+            do {
+                uint8_t event = packet->event;
+                void * arg = packet->arg;
+                uint32_t started = micros();
+                _handle_async_event(packet);
+                uint32_t took = micros() - started;
+                _async_stats.events++;
+                _async_stats.callback_us += took;
+                if(took > _async_stats.slowest_us){
+                    _async_stats.slowest_us = took;
+                    _async_stats.slowest_event = event;
+                    _async_stats.slowest_arg = arg;
+                }
+#if CONFIG_ASYNC_TCP_USE_WDT
+                esp_task_wdt_reset();
+#endif
+            } while(++count < CONFIG_ASYNC_TCP_BATCH_SIZE && xQueueReceive(_async_queue, &packet, 0) == pdPASS);
 #if CONFIG_ASYNC_TCP_USE_WDT
             if(esp_task_wdt_delete(NULL) != ESP_OK){
                 log_e("Failed to remove loop task from WDT");
@@ -218,7 +314,7 @@ static bool _start_async_task(){
         return false;
     }
     if(!_async_service_task_handle){
-        xTaskCreateUniversal(_async_service_task, "async_tcp", 8192 * 2, NULL, 3, &_async_service_task_handle, CONFIG_ASYNC_TCP_RUNNING_CORE);
+        xTaskCreateUniversal(_async_service_task, "async_tcp", CONFIG_ASYNC_TCP_STACK_SIZE, NULL, _async_task_priority, &_async_service_task_handle, _async_task_core);
         if(!_async_service_task_handle){
             return false;
         }
@@ -226,47 +322,65 @@ static bool _start_async_task(){
     return true;
 }
 
+bool async_tcp_config(uint16_t queue_size, int core, uint8_t priority){
+    if(_async_queue || _async_service_task_handle || !queue_size){
+        return false;
+    }
+    _async_queue_size = queue_size;
+    _async_task_core = core;
+    _async_task_priority = priority;
+    return true;
+}
+
+const AsyncTaskStats & async_tcp_stats(){
+    return _async_stats;
+}
+
+void async_tcp_reset_stats(){
+    memset(&_async_stats, 0, sizeof(_async_stats));
+}
+
 /*
  * LwIP Callbacks
  * */
 
 static int8_t _tcp_clear_events(void * arg) {
-    lwip_event_packet_t * e = (lwip_event_packet_t *)malloc(sizeof(lwip_event_packet_t));
+    lwip_event_packet_t * e = _alloc_async_event();
     e->event = LWIP_TCP_CLEAR;
     e->arg = arg;
     if (!_prepend_async_event(&e)) {
-        free((void*)(e));
+        _free_async_event(e);
     }
     return ERR_OK;
 }
 
 static int8_t _tcp_connected(void * arg, tcp_pcb * pcb, int8_t err) {
     //ets_printf("+C: 0x%08x\n", pcb);
-    lwip_event_packet_t * e = (lwip_event_packet_t *)malloc(sizeof(lwip_event_packet_t));
+    lwip_event_packet_t * e = _alloc_async_event();
     e->event = LWIP_TCP_CONNECTED;
     e->arg = arg;
     e->connected.pcb = pcb;
     e->connected.err = err;
     if (!_prepend_async_event(&e)) {
-        free((void*)(e));
+        _free_async_event(e);
     }
     return ERR_OK;
 }
 
 static int8_t _tcp_poll(void * arg, struct tcp_pcb * pcb) {
     //ets_printf("+P: 0x%08x\n", pcb);
-    lwip_event_packet_t * e = (lwip_event_packet_t *)malloc(sizeof(lwip_event_packet_t));
+    lwip_event_packet_t * e = _alloc_async_event();
     e->event = LWIP_TCP_POLL;
     e->arg = arg;
     e->poll.pcb = pcb;
     if (!_send_async_event(&e)) {
-        free((void*)(e));
+        _free_async_event(e);
     }
     return ERR_OK;
 }
 
 static int8_t _tcp_recv(void * arg, struct tcp_pcb * pcb, struct pbuf *pb, int8_t err) {
-    lwip_event_packet_t * e = (lwip_event_packet_t *)malloc(sizeof(lwip_event_packet_t));
+    lwip_event_packet_t * e = _alloc_async_event();
     e->arg = arg;
     if(pb){
         //ets_printf("+R: 0x%08x\n", pcb);
@@ -283,37 +397,37 @@ static int8_t _tcp_recv(void * arg, struct tcp_pcb * pcb, struct pbuf *pb, int8_
         AsyncClient::_s_lwip_fin(e->arg, e->fin.pcb, e->fin.err);
     }
     if (!_send_async_event(&e)) {
-        free((void*)(e));
+        _free_async_event(e);
     }
     return ERR_OK;
 }
 
 static int8_t _tcp_sent(void * arg, struct tcp_pcb * pcb, uint16_t len) {
     //ets_printf("+S: 0x%08x\n", pcb);
-    lwip_event_packet_t * e = (lwip_event_packet_t *)malloc(sizeof(lwip_event_packet_t));
+    lwip_event_packet_t * e = _alloc_async_event();
     e->event = LWIP_TCP_SENT;
     e->arg = arg;
     e->sent.pcb = pcb;
     e->sent.len = len;
     if (!_send_async_event(&e)) {
-        free((void*)(e));
+        _free_async_event(e);
     }
     return ERR_OK;
 }
 
 static void _tcp_error(void * arg, int8_t err) {
     //ets_printf("+E: 0x%08x\n", arg);
-    lwip_event_packet_t * e = (lwip_event_packet_t *)malloc(sizeof(lwip_event_packet_t));
+    lwip_event_packet_t * e = _alloc_async_event();
     e->event = LWIP_TCP_ERROR;
     e->arg = arg;
     e->error.err = err;
     if (!_send_async_event(&e)) {
-        free((void*)(e));
+        _free_async_event(e);
     }
 }
 
 static void _tcp_dns_found(const char * name, struct ip_addr * ipaddr, void * arg) {
-    lwip_event_packet_t * e = (lwip_event_packet_t *)malloc(sizeof(lwip_event_packet_t));
+    lwip_event_packet_t * e = _alloc_async_event();
     //ets_printf("+DNS: name=%s ipaddr=0x%08x arg=%x\n", name, ipaddr, arg);
     e->event = LWIP_TCP_DNS;
     e->arg = arg;
@@ -324,18 +438,18 @@ static void _tcp_dns_found(const char * name, struct ip_addr * ipaddr, void * ar
         memset(&e->dns.addr, 0, sizeof(e->dns.addr));
     }
     if (!_send_async_event(&e)) {
-        free((void*)(e));
+        _free_async_event(e);
     }
 }
 
 //Used to switch out from LwIP thread
 static int8_t _tcp_accept(void * arg, AsyncClient * client) {
-    lwip_event_packet_t * e = (lwip_event_packet_t *)malloc(sizeof(lwip_event_packet_t));
+    lwip_event_packet_t * e = _alloc_async_event();
     e->event = LWIP_TCP_ACCEPT;
     e->arg = arg;
     e->accept.client = client;
     if (!_prepend_async_event(&e)) {
-        free((void*)(e));
+        _free_async_event(e);
     }
     return ERR_OK;
 }
@@ -553,6 +667,8 @@ AsyncClient::AsyncClient(tcp_pcb* pcb)
 , _recv_cb_arg(0)
 , _pb_cb(0)
 , _pb_cb_arg(0)
+, _chain_cb(0)
+, _chain_cb_arg(0)
 , _timeout_cb(0)
 , _timeout_cb_arg(0)
 , _pcb_busy(false)
@@ -562,11 +678,17 @@ AsyncClient::AsyncClient(tcp_pcb* pcb)
 , _rx_since_timeout(0)
 , _ack_timeout(ASYNC_MAX_ACK_TIME)
 , _connect_port(0)
+, _send_queue(NULL)
+, _send_queue_size(0)
+, _send_queue_head(0)
+, _send_queue_count(0)
+, _send_lock(NULL)
 , prev(NULL)
 , next(NULL)
 {
     _pcb = pcb;
     _closed_slot = -1;
+    resetStats();
     if(_pcb){
         _allocate_closed_slot();
         _rx_last_packet = millis();
@@ -583,6 +705,10 @@ AsyncClient::~AsyncClient(){
         _close();
     }
     _free_closed_slot();
+    if(_send_lock) {
+        setSendQueue(0);
+        vSemaphoreDelete(_send_lock);
+    }
 }
 
 /*
@@ -660,6 +786,11 @@ void AsyncClient::onPacket(AcPacketHandler cb, void* arg){
   _pb_cb_arg = arg;
 }
 
+void AsyncClient::onPacketChain(AcPacketHandler cb, void* arg){
+  _chain_cb = cb;
+  _chain_cb_arg = arg;
+}
+
 void AsyncClient::onTimeout(AcTimeoutHandler cb, void* arg){
     _timeout_cb = cb;
     _timeout_cb_arg = arg;
@@ -759,9 +890,119 @@ size_t AsyncClient::add(const char* data, size_t size, uint8_t apiflags) {
     if(err != ERR_OK) {
         return 0;
     }
+    _stats.tx_bytes += will_send;
     return will_send;
 }
 
+/*
+ * Send Queue
+ * */
+
+struct async_send_entry {
+        const char * data;
+        size_t len;
+        size_t added;
+        uint8_t apiflags;
+};
+
+bool AsyncClient::setSendQueue(uint8_t depth){
+    if(!_send_lock) {
+        _send_lock = xSemaphoreCreateMutex();
+        if(!_send_lock) {
+            return false;
+        }
+    }
+    xSemaphoreTake(_send_lock, portMAX_DELAY);
+    _clear_send_queue();
+    ::free(_send_queue);
+    _send_queue = NULL;
+    _send_queue_size = 0;
+    if(depth) {
+        _send_queue = (async_send_entry *)malloc(sizeof(async_send_entry) * depth);
+        if(_send_queue) {
+            _send_queue_size = depth;
+        }
+    }
+    xSemaphoreGive(_send_lock);
+    return _send_queue_size == depth;
+}
+
+size_t AsyncClient::queue(const char* data, size_t size, uint8_t apiflags){
+    if(!_send_queue || !_pcb || size == 0 || data == NULL) {
+        return 0;
+    }
+    xSemaphoreTake(_send_lock, portMAX_DELAY);
+    if(_send_queue_count == _send_queue_size) {
+        xSemaphoreGive(_send_lock);
+        return 0;
+    }
+    async_send_entry * e = &_send_queue[(_send_queue_head + _send_queue_count) % _send_queue_size];
+    if(apiflags & ASYNC_WRITE_FLAG_COPY) {
+        //keep our own copy, lwIP copies again from it as the window allows
+        char * copy = (char *)malloc(size);
+        if(!copy) {
+            xSemaphoreGive(_send_lock);
+            return 0;
+        }
+        memcpy(copy, data, size);
+        data = copy;
+    }
+    e->data = data;
+    e->len = size;
+    e->added = 0;
+    e->apiflags = apiflags;
+    _send_queue_count++;
+    xSemaphoreGive(_send_lock);
+    _send_queued();
+    return size;
+}
+
+uint8_t AsyncClient::queued(){
+    return _send_queue_count;
+}
+
+//hand as much of the queue to lwIP as the window takes
+void AsyncClient::_send_queued(){
+    if(!_send_queue_count || !_pcb) {
+        return;
+    }
+    bool added = false;
+    xSemaphoreTake(_send_lock, portMAX_DELAY);
+    while(_send_queue_count) {
+        async_send_entry * e = &_send_queue[_send_queue_head];
+        size_t will_send = add(e->data + e->added, e->len - e->added, e->apiflags);
+        if(!will_send) {
+            break;
+        }
+        added = true;
+        e->added += will_send;
+        if(e->added < e->len) {
+            break;
+        }
+        if(e->apiflags & ASYNC_WRITE_FLAG_COPY) {
+            ::free((void*)e->data);
+        }
+        _send_queue_head = (_send_queue_head + 1) % _send_queue_size;
+        _send_queue_count--;
+    }
+    xSemaphoreGive(_send_lock);
+    if(added) {
+        send();
+    }
+}
+
+//called with _send_lock taken
+void AsyncClient::_clear_send_queue(){
+    for(; _send_queue_count; _send_queue_count--) {
+        async_send_entry * e = &_send_queue[_send_queue_head];
+        if(e->apiflags & ASYNC_WRITE_FLAG_COPY) {
+            ::free((void*)e->data);
+        }
+        _send_queue_head = (_send_queue_head + 1) % _send_queue_size;
+    }
+    _send_queue_head = 0;
+}
+
 bool AsyncClient::send(){
     int8_t err = ERR_OK;
     err = _tcp_output(_pcb, _closed_slot);
@@ -791,6 +1032,14 @@ void AsyncClient::ackPacket(struct pbuf * pb){
   pbuf_free(pb);
 }
 
+void AsyncClient::ackPacketChain(struct pbuf * pb){
+  if(!pb){
+    return;
+  }
+  _tcp_recved(_pcb, _closed_slot, pb->tot_len);
+  pbuf_free(pb);
+}
+
 /*
  * Main Private Methods
  * */
@@ -913,6 +1162,14 @@ int8_t AsyncClient::_sent(tcp_pcb* pcb, uint16_t len) {
     _rx_last_packet = millis();
     //log_i("%u", len);
     _pcb_busy = false;
+    _stats.acked_bytes += len;
+    uint32_t latency = millis() - _pcb_sent_at;
+    uint8_t bin = 0;
+    while(bin < ASYNC_ACK_HISTOGRAM_SIZE - 1 && latency >= (1UL << bin)) {
+        bin++;
+    }
+    _stats.ack_histogram[bin]++;
+    _send_queued();
     if(_sent_cb) {
         _sent_cb(_sent_cb_arg, this, len, (millis() - _pcb_sent_at));
     }
@@ -920,6 +1177,15 @@ int8_t AsyncClient::_sent(tcp_pcb* pcb, uint16_t len) {
 }
 
 int8_t AsyncClient::_recv(tcp_pcb* pcb, pbuf* pb, int8_t err) {
+    if(pb != NULL) {
+        _stats.rx_bytes += pb->tot_len;
+    }
+    if(_chain_cb && pb != NULL) {
+        //the handler owns the chain until ackPacketChain
+        _rx_last_packet = millis();
+        _chain_cb(_chain_cb_arg, this, pb);
+        return ERR_OK;
+    }
     while(pb != NULL) {
         _rx_last_packet = millis();
         //we should not ack before we assimilate the data
@@ -971,6 +1237,7 @@ int8_t AsyncClient::_poll(tcp_pcb* pcb){
         return ERR_OK;
     }
     // Everything is fine
+    _send_queued();
     if(_poll_cb) {
         _poll_cb(_poll_cb_arg, this);
     }
@@ -1154,6 +1421,10 @@ bool AsyncClient::canSend(){
     return space() > 0;
 }
 
+void AsyncClient::resetStats(){
+    memset(&_stats, 0, sizeof(_stats));
+}
+
 const char * AsyncClient::errorToString(int8_t error){
     switch(error){
         case ERR_OK: return "OK";
@@ -1241,7 +1512,9 @@ AsyncServer::AsyncServer(IPAddress addr, uint16_t port)
 , _pcb(0)
 , _connect_cb(0)
 , _connect_cb_arg(0)
-{}
+{
+    resetStats();
+}
 
 AsyncServer::AsyncServer(uint16_t port)
 : _port(port)
@@ -1250,7 +1523,9 @@ AsyncServer::AsyncServer(uint16_t port)
 , _pcb(0)
 , _connect_cb(0)
 , _connect_cb_arg(0)
-{}
+{
+    resetStats();
+}
 
 AsyncServer::~AsyncServer(){
     end();
@@ -1316,9 +1591,11 @@ int8_t AsyncServer::_accept(tcp_pcb* pcb, int8_t err){
         AsyncClient *c = new AsyncClient(pcb);
         if(c){
             c->setNoDelay(_noDelay);
+            _stats.accepted++;
             return _tcp_accept(this, c);
         }
     }
+    _stats.refused++;
     if(tcp_close(pcb) != ERR_OK){
         tcp_abort(pcb);
     }
@@ -1341,6 +1618,10 @@ bool AsyncServer::getNoDelay(){
     return _noDelay;
 }
 
+void AsyncServer::resetStats(){
+    memset(&_stats, 0, sizeof(_stats));
+}
+
 uint8_t AsyncServer::status(){
     if (!_pcb) {
         return 0;
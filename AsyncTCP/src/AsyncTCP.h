@@ -33,9 +33,58 @@ extern "C" {
 //If core is not defined, then we are running in Arduino or PIO
 #ifndef CONFIG_ASYNC_TCP_RUNNING_CORE
 #define CONFIG_ASYNC_TCP_RUNNING_CORE -1 //any available core
-#define CONFIG_ASYNC_TCP_USE_WDT 1 //if enabled, adds between 33us and 200us per event
+#define CONFIG_ASYNC_TCP_USE_WDT 1 //if enabled, adds between 33us and 200us per batch of events
 #endif
 
+//Defaults of the async_tcp task and its event queue, see async_tcp_config()
+#ifndef CONFIG_ASYNC_TCP_QUEUE_SIZE
+#define CONFIG_ASYNC_TCP_QUEUE_SIZE 32
+#endif
+#ifndef CONFIG_ASYNC_TCP_PRIORITY
+#define CONFIG_ASYNC_TCP_PRIORITY 3
+#endif
+#ifndef CONFIG_ASYNC_TCP_STACK_SIZE
+#define CONFIG_ASYNC_TCP_STACK_SIZE 8192 * 2
+#endif
+#ifndef CONFIG_ASYNC_TCP_BATCH_SIZE
+#define CONFIG_ASYNC_TCP_BATCH_SIZE 16 //events handled at once, before the task blocks again
+#endif
+
+/*
+ * Set the depth of the event queue (also the number of pooled events), and the
+ * core and priority of the async_tcp task. Must be called before the first
+ * client or server is started, returns false once the task is running.
+ * */
+bool async_tcp_config(uint16_t queue_size, int core, uint8_t priority);
+
+#define ASYNC_ACK_HISTOGRAM_SIZE 8 //ack latency bins: <1ms, <2ms, <4ms ... <64ms, 64ms and more
+
+//counters of the async_tcp task, see async_tcp_stats()
+typedef struct {
+    uint32_t events;            //events handled
+    uint32_t pool_misses;       //events that had to be malloced, the pool was empty
+    uint16_t queue_high_water;  //most events waiting in the queue at once
+    uint64_t callback_us;       //time spent handling events, including user callbacks
+    uint32_t slowest_us;        //longest single event
+    uint8_t slowest_event;      //its type, as in lwip_event_t of AsyncTCP.cpp
+    void * slowest_arg;         //and its AsyncClient (AsyncServer for accept), to find the culprit
+} AsyncTaskStats;
+
+typedef struct {
+    uint32_t rx_bytes;
+    uint32_t tx_bytes;          //handed to lwIP
+    uint32_t acked_bytes;
+    uint32_t ack_histogram[ASYNC_ACK_HISTOGRAM_SIZE];
+} AsyncClientStats;
+
+typedef struct {
+    uint32_t accepted;
+    uint32_t refused;           //no onClient handler or out of memory
+} AsyncServerStats;
+
+const AsyncTaskStats & async_tcp_stats();
+void async_tcp_reset_stats();
+
 class AsyncClient;
 
 #define ASYNC_MAX_ACK_TIME 5000
@@ -51,6 +100,21 @@ typedef std::function<void(void*, AsyncClient*, uint32_t time)> AcTimeoutHandler
 
 struct tcp_pcb;
 struct ip_addr;
+struct async_send_entry;
+
+//Walks the payloads of a pbuf chain from onPacketChain, in place
+//for random access use pbuf_get_at(), pbuf_memfind() or pbuf_copy_partial() from lwIP
+class AsyncPbufIterator {
+  public:
+    AsyncPbufIterator(struct pbuf * pb): _pb(pb) {}
+    operator bool() const { return _pb != NULL; }
+    const uint8_t * data() const { return (const uint8_t *)_pb->payload; }
+    size_t length() const { return _pb->len; }
+    void next(){ _pb = (_pb->len == _pb->tot_len) ? NULL : _pb->next; }
+
+  private:
+    struct pbuf * _pb;
+};
 
 class AsyncClient {
   public:
@@ -77,6 +141,11 @@ class AsyncClient {
     size_t add(const char* data, size_t size, uint8_t apiflags=ASYNC_WRITE_FLAG_COPY);//add for sending
     bool send();//send all data added with the method above
 
+    //optional bounded send queue, drained as the TCP window opens (on ack and poll)
+    bool setSendQueue(uint8_t depth);//number of queued buffers, 0 removes the queue
+    size_t queue(const char* data, size_t size, uint8_t apiflags=ASYNC_WRITE_FLAG_COPY);//all or nothing, 0 if the queue is full. Without the copy flag data must stay valid until acked
+    uint8_t queued();//buffers waiting in the queue
+
     //write equals add()+send()
     size_t write(const char* data);
     size_t write(const char* data, size_t size, uint8_t apiflags=ASYNC_WRITE_FLAG_COPY); //only when canSend() == true
@@ -116,16 +185,21 @@ class AsyncClient {
     void onError(AcErrorHandler cb, void* arg = 0);         //unsuccessful connect or error
     void onData(AcDataHandler cb, void* arg = 0);           //data received (called if onPacket is not used)
     void onPacket(AcPacketHandler cb, void* arg = 0);       //data received
+    void onPacketChain(AcPacketHandler cb, void* arg = 0);  //whole pbuf chain received, kept until ackPacketChain (used before onPacket and onData)
     void onTimeout(AcTimeoutHandler cb, void* arg = 0);     //ack timeout
     void onPoll(AcConnectHandler cb, void* arg = 0);        //every 125ms when connected
 
     void ackPacket(struct pbuf * pb);//ack pbuf from onPacket
+    void ackPacketChain(struct pbuf * pb);//ack and free the pbuf chain from onPacketChain, may be called later
     size_t ack(size_t len); //ack data that you have not acked using the method below
     void ackLater(){ _ack_pcb = false; } //will not ack the current packet. Call from onData
 
     const char * errorToString(int8_t error);
     const char * stateToString();
 
+    const AsyncClientStats & getStats(){ return _stats; }
+    void resetStats();
+
     //Do not use any of the functions below!
     static int8_t _s_poll(void *arg, struct tcp_pcb *tpcb);
     static int8_t _s_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *pb, int8_t err);
@@ -155,6 +229,8 @@ class AsyncClient {
     void* _recv_cb_arg;
     AcPacketHandler _pb_cb;
     void* _pb_cb_arg;
+    AcPacketHandler _chain_cb;
+    void* _chain_cb_arg;
     AcTimeoutHandler _timeout_cb;
     void* _timeout_cb_arg;
     AcConnectHandler _poll_cb;
@@ -168,6 +244,12 @@ class AsyncClient {
     uint32_t _rx_since_timeout;
     uint32_t _ack_timeout;
     uint16_t _connect_port;
+    async_send_entry* _send_queue;
+    uint8_t _send_queue_size;
+    uint8_t _send_queue_head;
+    uint8_t _send_queue_count;
+    SemaphoreHandle_t _send_lock;
+    AsyncClientStats _stats;
 
     int8_t _close();
     void _free_closed_slot();
@@ -179,6 +261,8 @@ class AsyncClient {
     int8_t _fin(tcp_pcb* pcb, int8_t err);
     int8_t _lwip_fin(tcp_pcb* pcb, int8_t err);
     void _dns_found(struct ip_addr *ipaddr);
+    void _send_queued();
+    void _clear_send_queue();
 
   public:
     AsyncClient* prev;
@@ -197,6 +281,9 @@ class AsyncServer {
     bool getNoDelay();
     uint8_t status();
 
+    const AsyncServerStats & getStats(){ return _stats; }
+    void resetStats();
+
     //Do not use any of the functions below!
     static int8_t _s_accept(void *arg, tcp_pcb* newpcb, int8_t err);
     static int8_t _s_accepted(void *arg, AsyncClient* client);
@@ -208,6 +295,7 @@ class AsyncServer {
     tcp_pcb* _pcb;
     AcConnectHandler _connect_cb;
     void* _connect_cb_arg;
+    AsyncServerStats _stats;
 
     int8_t _accept(tcp_pcb* newpcb, int8_t err);
     int8_t _accepted(AsyncClient* client);
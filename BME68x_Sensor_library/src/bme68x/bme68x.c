@@ -93,8 +93,9 @@ static uint8_t calc_res_heat(uint16_t temp, const struct bme68x_dev *dev);
 /* This internal API is used to read a single data of the sensor */
 static int8_t read_field_data(uint8_t index, struct bme68x_data *data, struct bme68x_dev *dev);
 
-/* This internal API is used to read all data fields of the sensor */
-static int8_t read_all_field_data(struct bme68x_data * const data[], struct bme68x_dev *dev);
+/* This internal API is used to read all data fields of the sensor, compensating
+ * only the fields with new data if new_only is set */
+static int8_t read_all_field_data(struct bme68x_data * const data[], uint8_t new_only, struct bme68x_dev *dev);
 
 /* This internal API is used to switch between SPI memory pages */
 static int8_t set_mem_page(uint8_t reg_addr, struct bme68x_dev *dev);
@@ -571,7 +572,7 @@ int8_t bme68x_get_data(uint8_t op_mode, struct bme68x_data *data, uint8_t *n_dat
         else if ((op_mode == BME68X_PARALLEL_MODE) || (op_mode == BME68X_SEQUENTIAL_MODE))
         {
             /* Read the 3 fields and count the number of new data fields */
-            rslt = read_all_field_data(field_ptr, dev);
+            rslt = read_all_field_data(field_ptr, 0, dev);
 
             new_fields = 0;
             for (i = 0; (i < 3) && (rslt == BME68X_OK); i++)
@@ -624,6 +625,58 @@ int8_t bme68x_get_data(uint8_t op_mode, struct bme68x_data *data, uint8_t *n_dat
     return rslt;
 }
 
+/*
+ * @brief This API reads the 3 data fields in one burst and compensates and
+ * stores only the ones with new data, oldest first.
+ */
+int8_t bme68x_get_new_fields(struct bme68x_data *data, uint8_t *n_data, struct bme68x_dev *dev)
+{
+    int8_t rslt;
+    uint8_t i = 0, j = 0, new_fields = 0;
+    struct bme68x_data *field_ptr[3] = { 0 };
+    struct bme68x_data field_data[3] = { { 0 } };
+
+    field_ptr[0] = &field_data[0];
+    field_ptr[1] = &field_data[1];
+    field_ptr[2] = &field_data[2];
+
+    rslt = null_ptr_check(dev);
+    if ((rslt == BME68X_OK) && (data != NULL) && (n_data != NULL))
+    {
+        rslt = read_all_field_data(field_ptr, 1, dev);
+
+        /* Fields with new data are sorted to the front, oldest first */
+        for (i = 0; (i < 2) && (rslt == BME68X_OK); i++)
+        {
+            for (j = i + 1; j < 3; j++)
+            {
+                sort_sensor_data(i, j, field_ptr);
+            }
+        }
+
+        for (i = 0; (i < 3) && (rslt == BME68X_OK); i++)
+        {
+            if (field_ptr[i]->status & BME68X_NEW_DATA_MSK)
+            {
+                data[new_fields++] = *field_ptr[i];
+            }
+        }
+
+        if ((rslt == BME68X_OK) && (new_fields == 0))
+        {
+            rslt = BME68X_W_NO_NEW_DATA;
+        }
+
+        *n_data = new_fields;
+    }
+    else
+    {
+        rslt = BME68X_E_NULL_PTR;
+    }
+
+    return rslt;
+}
+
 /*
  * @brief This API is used to set the gas configuration of the sensor.
  */
@@ -1286,7 +1339,7 @@ static int8_t read_field_data(uint8_t index, struct bme68x_data *data, struct bm
 }
 
 /* This internal API is used to read all data fields of the sensor */
-static int8_t read_all_field_data(struct bme68x_data * const data[], struct bme68x_dev *dev)
+static int8_t read_all_field_data(struct bme68x_data * const data[], uint8_t new_only, struct bme68x_dev *dev)
 {
     int8_t rslt = BME68X_OK;
     uint8_t buff[BME68X_LEN_FIELD * 3] = { 0 };
@@ -1309,6 +1362,18 @@ static int8_t read_all_field_data(struct bme68x_data * const data[], struct bme6
         rslt = bme68x_get_regs(BME68X_REG_FIELD0, buff, (uint32_t) BME68X_LEN_FIELD * 3, dev);
     }
 
+    /* The heater settings are only needed to report new data */
+    if ((rslt == BME68X_OK) && new_only &&
+        !((buff[0] | buff[BME68X_LEN_FIELD] | buff[BME68X_LEN_FIELD * 2]) & BME68X_NEW_DATA_MSK))
+    {
+        for (i = 0; i < 3; i++)
+        {
+            data[i]->status = 0;
+        }
+
+        return rslt;
+    }
+
     if (rslt == BME68X_OK)
     {
         rslt = bme68x_get_regs(BME68X_REG_IDAC_HEAT0, set_val, 30, dev);
@@ -1320,6 +1385,10 @@ static int8_t read_all_field_data(struct bme68x_data * const data[], struct bme6
         data[i]->status = buff[off] & BME68X_NEW_DATA_MSK;
         data[i]->gas_index = buff[off] & BME68X_GAS_INDEX_MSK;
         data[i]->meas_index = buff[off + 1];
+        if (new_only && !(data[i]->status & BME68X_NEW_DATA_MSK))
+        {
+            continue;
+        }
 
         /* read the raw data from the sensor */
         adc_pres =
@@ -225,6 +225,28 @@ uint32_t bme68x_get_meas_dur(const uint8_t op_mode, struct bme68x_conf *conf, st
  */
 int8_t bme68x_get_data(uint8_t op_mode, struct bme68x_data *data, uint8_t *n_data, struct bme68x_dev *dev);
 
+/*!
+ * \ingroup bme68xApiData
+ * \page bme68x_api_bme68x_get_new_fields bme68x_get_new_fields
+ * \code
+ * int8_t bme68x_get_new_fields(struct bme68x_data *data, uint8_t *n_data, struct bme68x_dev *dev);
+ * \endcode
+ * @details This API reads the 3 data fields of the sensor in one burst, in
+ * parallel or sequential mode, and compensates only the fields with new data.
+ * The heater settings are only read when there is new data. The new fields are
+ * stored oldest first at the start of data.
+ *
+ * @param[out] data    : Array of 3 structure instances to hold the data.
+ * @param[out] n_data  : Number of new fields stored.
+ * @param[in,out] dev  : Structure instance of bme68x_dev
+ *
+ * @return Result of API execution status
+ * @retval 0 -> Success
+ * @retval > 0 -> Warning, BME68X_W_NO_NEW_DATA if no field has new data
+ * @retval < 0 -> Fail
+ */
+int8_t bme68x_get_new_fields(struct bme68x_data *data, uint8_t *n_data, struct bme68x_dev *dev);
+
 /**
  * \ingroup bme68x
  * \defgroup bme68xApiConfig Configuration
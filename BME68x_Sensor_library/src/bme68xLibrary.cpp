@@ -114,6 +114,13 @@ Bme68x::Bme68x(void)
 	nFields = 0;
 	iFields = 0;
 	lastOpMode = BME68X_SLEEP_MODE;
+	fifo = NULL;
+	fifoSize = 0;
+	fifoHead = 0;
+	fifoCount = 0;
+	fifoOverruns = 0;
+	lastMeasIndex = 0;
+	fifoPrimed = false;
 }
 
 /**
@@ -242,6 +249,9 @@ void Bme68x::setOpMode(uint8_t opMode)
 	status = bme68x_set_op_mode(opMode, &bme6);
 	if ((status == BME68X_OK) && (opMode != BME68X_SLEEP_MODE))
 		lastOpMode = opMode;
+
+	/* The sub-measurement index restarts with the mode */
+	fifoPrimed = false;
 }
 
 /**
@@ -429,6 +439,94 @@ bme68xData* Bme68x::getAllData(void)
 	return sensorData;
 }
 
+/**
+ * @brief Function to set the buffer for the FIFO of new data fields
+ */
+void Bme68x::setFifo(bme68xSample *buffer, uint8_t size)
+{
+	fifo = buffer;
+	fifoSize = buffer ? size : 0;
+	fifoHead = 0;
+	fifoCount = 0;
+	fifoOverruns = 0;
+	fifoPrimed = false;
+}
+
+/**
+ * @brief Function to read the 3 data fields in one burst and add the new ones to the FIFO
+ */
+uint8_t Bme68x::fetchFifo(void)
+{
+	bme68xData fields[3];
+	uint8_t nNew = 0, added = 0;
+	uint32_t now;
+
+	if (!fifoSize)
+	{
+		status = BME68X_E_NULL_PTR;
+		return 0;
+	}
+
+	status = bme68x_get_new_fields(fields, &nNew, &bme6);
+	now = millis();
+
+	for (uint8_t i = 0; i < nNew; i++)
+	{
+		/* Skip sub-measurements that are already queued, in case a field
+		 * still has its new data flag set at the next read */
+		if (fifoPrimed && ((int8_t)(fields[i].meas_index - lastMeasIndex) <= 0))
+			continue;
+		lastMeasIndex = fields[i].meas_index;
+		fifoPrimed = true;
+
+		if (fifoCount == fifoSize)
+		{
+			fifoHead = (fifoHead + 1) % fifoSize;
+			fifoCount--;
+			fifoOverruns++;
+		}
+
+		bme68xSample &slot = fifo[(fifoHead + fifoCount) % fifoSize];
+		slot.data = fields[i];
+		slot.timestamp = now;
+		fifoCount++;
+		added++;
+	}
+
+	return added;
+}
+
+/**
+ * @brief Function to get the number of fields in the FIFO
+ */
+uint8_t Bme68x::fifoAvailable(void)
+{
+	return fifoCount;
+}
+
+/**
+ * @brief Function to take the oldest field from the FIFO
+ */
+bool Bme68x::readFifo(bme68xSample &sample)
+{
+	if (!fifoCount)
+		return false;
+
+	sample = fifo[fifoHead];
+	fifoHead = (fifoHead + 1) % fifoSize;
+	fifoCount--;
+
+	return true;
+}
+
+/**
+ * @brief Function to get the number of fields dropped because the FIFO was full
+ */
+uint16_t Bme68x::getFifoOverruns(void)
+{
+	return fifoOverruns;
+}
+
 /**
  * @brief Function to get the BME68x heater configuration
  */
@@ -73,6 +73,16 @@ typedef enum   bme68x_intf          bme68xIntf;
 typedef struct bme68x_conf          bme68xConf;
 typedef struct bme68x_heatr_conf    bme68xHeatrConf;
 
+/**
+ * Datatype for a data field in the FIFO, with the time it was read out
+ */
+typedef struct
+{
+    bme68xData data;
+    /** millis() when the field was read from the sensor */
+    uint32_t timestamp;
+} bme68xSample;
+
 /**
  * @brief Function that implements the default microsecond delay callback
  * @param periodUs : Duration of the delay in microseconds
@@ -302,6 +312,41 @@ public:
      */
     bme68xData* getAllData(void);
 
+    /**
+     * @brief Function to set the buffer for the FIFO of new data fields
+     * @param buffer : Storage for the FIFO, or NULL to disable it
+     * @param size   : Number of fields the buffer holds
+     */
+    void setFifo(bme68xSample *buffer, uint8_t size);
+
+    /**
+     * @brief Function to read the 3 data fields in one burst, in Parallel or
+     *        Sequential mode, and add the new ones to the FIFO. Only the new
+     *        fields are compensated. When the FIFO is full the oldest field
+     *        is dropped
+     * @return Number of fields added
+     */
+    uint8_t fetchFifo(void);
+
+    /**
+     * @brief Function to get the number of fields in the FIFO
+     * @return Number of fields available
+     */
+    uint8_t fifoAvailable(void);
+
+    /**
+     * @brief Function to take the oldest field from the FIFO
+     * @param sample : Structure where the field is to be stored
+     * @return true if a field was available
+     */
+    bool readFifo(bme68xSample &sample);
+
+    /**
+     * @brief Function to get the number of fields dropped because the FIFO was full
+     * @return Number of fields dropped
+     */
+    uint16_t getFifoOverruns(void);
+
     /**
 	 * @brief Function to get the BME68x heater configuration
 	 */
@@ -342,6 +387,11 @@ private:
     bme68xData sensorData[3];
     uint8_t nFields, iFields;
     uint8_t lastOpMode;
+    bme68xSample *fifo;
+    uint8_t fifoSize, fifoHead, fifoCount;
+    uint16_t fifoOverruns;
+    uint8_t lastMeasIndex;
+    bool fifoPrimed;
 };
 
 #endif /* BME68X_CLASS_H */
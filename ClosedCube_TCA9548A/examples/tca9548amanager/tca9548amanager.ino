@@ -0,0 +1,62 @@
+/*
+
+Example: tca9548amanager
+
+Arduino library for Arduino library for Texas Instruments TCA9548A 8-Channel I2C Switch/Multiplexer
+
+Polls one sensor at the same address (0x40) behind each of the first four channels.
+Every pass queues the reads in any order; run() selects each channel only once,
+and a channel that is already selected is not written again.
+
+*/
+
+#include <Wire.h>
+#include "ClosedCube_TCA9548A.h"
+
+
+#define UART_BAUD 9600
+#define TCA9548A_I2C_ADDRESS	0x70
+#define SENSOR_I2C_ADDRESS	0x40
+#define SENSOR_CHANNELS	4
+
+ClosedCube::Wired::TCA9548A tca9548a(TCA9548A_I2C_ADDRESS);
+ClosedCube::Wired::TCA9548AManager manager(tca9548a);
+
+uint16_t readings[SENSOR_CHANNELS];
+
+void readSensor(void *context) {
+	uint16_t *reading = (uint16_t *)context;
+
+	Wire.requestFrom(SENSOR_I2C_ADDRESS, 2);
+	if (Wire.available() == 2) {
+		*reading = Wire.read() << 8;
+		*reading |= Wire.read();
+	}
+}
+
+void setup()
+{
+    Wire.begin();
+    Serial.begin(UART_BAUD);
+    
+    Serial.println("ClosedCube TCA9548A Manager Demo");
+}
+
+void loop()
+{
+	for (uint8_t channel = 0; channel < SENSOR_CHANNELS; channel++) {
+		manager.queue(channel, readSensor, &readings[channel]);
+	}
+	manager.run();
+
+	for (uint8_t channel = 0; channel < SENSOR_CHANNELS; channel++) {
+		Serial.print(readings[channel]);
+		Serial.print(" ");
+	}
+	Serial.print("switches ");
+	Serial.print(tca9548a.getSwitchCount());
+	Serial.print(" elided ");
+	Serial.println(tca9548a.getElidedCount());
+
+	delay(1000);
+}
@@ -40,14 +40,15 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ClosedCube_TCA9548A.h"
 
-ClosedCube::Wired::TCA9548A::TCA9548A() {
+ClosedCube::Wired::TCA9548A::TCA9548A():_currentChannel(0),_mask(0),_maskValid(false),_switches(0),_elided(0) {
 }
 
-ClosedCube::Wired::TCA9548A::TCA9548A(uint8_t address):_address(address) {    
+ClosedCube::Wired::TCA9548A::TCA9548A(uint8_t address):_address(address),_currentChannel(0),_mask(0),_maskValid(false),_switches(0),_elided(0) {    
 }
 
 void ClosedCube::Wired::TCA9548A::address(uint8_t address) {    
 	_address = address;
+	_maskValid = false;
 }
 
 uint8_t ClosedCube::Wired::TCA9548A::getChannel() {
@@ -56,16 +57,52 @@ uint8_t ClosedCube::Wired::TCA9548A::getChannel() {
 
 uint8_t ClosedCube::Wired::TCA9548A::selectChannel(uint8_t channel) {
 	uint8_t result = 0xff;
-	if (channel >= 0 && channel < TCA9548A_MAX_CHANNELS) {
-		Wire.beginTransmission(_address);
-		Wire.write( ((uint8_t)1) << (channel+1));
-		
-		_currentChannel = channel;
-		result = Wire.endTransmission();
+	if (channel < TCA9548A_MAX_CHANNELS) {
+		result = selectChannels(((uint8_t)1) << channel);
+		if (result == 0) {
+			_currentChannel = channel;
+		}
 	} 
 	return result;
 }
 
+// Enables every channel set in mask, 0 disconnects all of them.
+// The control register is only written when the mask changes.
+uint8_t ClosedCube::Wired::TCA9548A::selectChannels(uint8_t mask) {
+	if (_maskValid && mask == _mask) {
+		_elided++;
+		return 0;
+	}
+
+	Wire.beginTransmission(_address);
+	Wire.write(mask);
+	uint8_t result = Wire.endTransmission();
+	_switches++;
+
+	// after a failed write the switch state is unknown
+	_mask = mask;
+	_maskValid = (result == 0);
+	return result;
+}
+
+uint8_t ClosedCube::Wired::TCA9548A::getChannelMask() {
+	return _mask;
+}
+
+// Forget the selected channels, so the next select writes the control register.
+// Call this after the TCA9548A was reset or another master may have switched it.
+void ClosedCube::Wired::TCA9548A::invalidate() {
+	_maskValid = false;
+}
+
+uint32_t ClosedCube::Wired::TCA9548A::getSwitchCount() {
+	return _switches;
+}
+
+uint32_t ClosedCube::Wired::TCA9548A::getElidedCount() {
+	return _elided;
+}
+
 uint8_t ClosedCube::Wired::TCA9548A::nextChannel() {
 	uint8_t nextChannel = _currentChannel + 1;
 	if (nextChannel > (TCA9548A_MAX_CHANNELS-1)) {
@@ -75,3 +112,61 @@ uint8_t ClosedCube::Wired::TCA9548A::nextChannel() {
 	return selectChannel(nextChannel);
 }
  
+
+ClosedCube::Wired::TCA9548AManager::TCA9548AManager(TCA9548A &mux):_mux(mux),_count(0) {
+}
+
+// Adds a task to the current polling pass, it runs once with its channel selected
+bool ClosedCube::Wired::TCA9548AManager::queue(uint8_t channel, TCA9548ATask task, void *context) {
+	if (channel >= TCA9548A_MAX_CHANNELS || task == NULL || _count >= TCA9548A_MAX_QUEUED) {
+		return false;
+	}
+
+	_queue[_count].channel = channel;
+	_queue[_count].task = task;
+	_queue[_count].context = context;
+	_count++;
+	return true;
+}
+
+uint8_t ClosedCube::Wired::TCA9548AManager::queued() {
+	return _count;
+}
+
+// Runs the polling pass grouped by channel, so each channel is selected once.
+// The channel that is already selected goes first, then the following channels,
+// wrapping around. Tasks on the same channel keep the order they were queued in.
+// Tasks of a channel that can not be selected are dropped, tasks queued by a
+// running task wait for the next pass.
+// Returns the number of tasks that ran.
+uint8_t ClosedCube::Wired::TCA9548AManager::run() {
+	uint8_t count = _count;
+	uint8_t pending = 0;
+	for (uint8_t i = 0; i < count; i++) {
+		pending |= ((uint8_t)1) << _queue[i].channel;
+	}
+
+	uint8_t ran = 0;
+	uint8_t first = _mux.getChannelMask() & pending ? _mux.getChannel() : 0;
+	for (uint8_t n = 0; n < TCA9548A_MAX_CHANNELS; n++) {
+		uint8_t channel = (first + n) % TCA9548A_MAX_CHANNELS;
+		if (!(pending & (((uint8_t)1) << channel))) {
+			continue;
+		}
+		if (_mux.selectChannel(channel) != 0) {
+			continue;
+		}
+		for (uint8_t i = 0; i < count; i++) {
+			if (_queue[i].channel == channel) {
+				_queue[i].task(_queue[i].context);
+				ran++;
+			}
+		}
+	}
+
+	for (uint8_t i = count; i < _count; i++) {
+		_queue[i - count] = _queue[i];
+	}
+	_count -= count;
+	return ran;
+}
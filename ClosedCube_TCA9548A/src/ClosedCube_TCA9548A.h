@@ -43,6 +43,10 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define TCA9548A_MAX_CHANNELS 8
 
+#ifndef TCA9548A_MAX_QUEUED
+#define TCA9548A_MAX_QUEUED 32
+#endif
+
 namespace ClosedCube 
 {
 
@@ -61,11 +65,47 @@ namespace ClosedCube
                 uint8_t getChannel();
 
                 uint8_t selectChannel(uint8_t channel);
+                uint8_t selectChannels(uint8_t mask);
                 uint8_t nextChannel();
 
+                uint8_t getChannelMask();
+                void invalidate();
+
+                uint32_t getSwitchCount();
+                uint32_t getElidedCount();
+
             private:
                 uint8_t _address;
                 uint8_t _currentChannel;
+                uint8_t _mask;
+                bool _maskValid;
+                uint32_t _switches;
+                uint32_t _elided;
+
+        };
+
+        typedef void (*TCA9548ATask)(void *context);
+
+        class TCA9548AManager
+        {
+
+            public:
+                TCA9548AManager(TCA9548A &mux);
+
+                bool queue(uint8_t channel, TCA9548ATask task, void *context = NULL);
+                uint8_t queued();
+                uint8_t run();
+
+            private:
+                struct Entry {
+                    uint8_t channel;
+                    TCA9548ATask task;
+                    void *context;
+                };
+
+                TCA9548A &_mux;
+                Entry _queue[TCA9548A_MAX_QUEUED];
+                uint8_t _count;
 
         };
         
@@ -98,6 +98,10 @@ void DallasTemperature::setOneWire(OneWire* _oneWire) {
 	waitForConversion = true;
 	checkForConversion = true;
   autoSaveScratchPad = true;
+	converting = false;
+#if DALLASTEMP_ADDRESS_CACHE > 0
+	cachedAddresses = 0;
+#endif
 
 }
 
@@ -109,9 +113,18 @@ void DallasTemperature::begin(void) {
 	_wire->reset_search();
 	devices = 0; // Reset the number of devices when we enumerate wire devices
 	ds18Count = 0; // Reset number of DS18xxx Family devices
+#if DALLASTEMP_ADDRESS_CACHE > 0
+	cachedAddresses = 0;
+#endif
 
 	while (_wire->search(deviceAddress)) {
 
+#if DALLASTEMP_ADDRESS_CACHE > 0
+		// keep every address, so the cache has the same indexes as a search
+		if (cachedAddresses < DALLASTEMP_ADDRESS_CACHE)
+			memcpy(addressCache[cachedAddresses++], deviceAddress, sizeof(DeviceAddress));
+#endif
+
 		if (validAddress(deviceAddress)) {
 			devices++;
 
@@ -144,8 +157,17 @@ bool DallasTemperature::validAddress(const uint8_t* deviceAddress) {
 
 // finds an address at a given index on the bus
 // returns true if the device was found
+// the addresses found by begin() are returned without searching the bus,
+// so call begin() again after adding or removing devices
 bool DallasTemperature::getAddress(uint8_t* deviceAddress, uint8_t index) {
 
+#if DALLASTEMP_ADDRESS_CACHE > 0
+	if (index < cachedAddresses) {
+		memcpy(deviceAddress, addressCache[index], sizeof(DeviceAddress));
+		return validAddress(deviceAddress);
+	}
+#endif
+
 	uint8_t depth = 0;
 
 	_wire->reset_search();
@@ -412,6 +434,61 @@ void DallasTemperature::requestTemperatures() {
 
 }
 
+// sends command for all devices on the bus to perform a temperature conversion
+// without waiting for it, see conversionDone()
+void DallasTemperature::startConversion() {
+
+	_wire->reset();
+	_wire->skip();
+	_wire->write(STARTCONVO, parasite);
+
+	conversionStart = millis();
+	converting = true;
+	// same as blockTillConversionComplete(), the strong pull-up stays on while waiting
+	if (!checkForConversion || parasite)
+		activateExternalPullup();
+
+}
+
+// returns true once the conversion started by startConversion() is complete
+bool DallasTemperature::conversionDone() {
+
+	if (!converting)
+		return true;
+
+	unsigned long elapsed = millis() - conversionStart;
+	bool done;
+	if (checkForConversion && !parasite)
+		done = isConversionComplete() || elapsed >= MAX_CONVERSION_TIMEOUT;
+	else
+		done = elapsed >= (unsigned long) millisToWaitForConversion(bitResolution);
+
+	if (done) {
+		converting = false;
+		deactivateExternalPullup();
+	}
+	return done;
+
+}
+
+// reads the raw temperature of each device found by begin(), in index order
+// returns the number of entries written to temperatures
+uint8_t DallasTemperature::readTemperatures(int16_t* temperatures, uint8_t count) {
+
+	if (count > devices)
+		count = devices;
+
+	DeviceAddress deviceAddress;
+	for (uint8_t i = 0; i < count; i++) {
+		if (getAddress(deviceAddress, i) && validFamily(deviceAddress))
+			temperatures[i] = getTemp(deviceAddress);
+		else
+			temperatures[i] = DEVICE_DISCONNECTED_RAW;
+	}
+	return count;
+
+}
+
 // sends command for one device to perform a temperature by address
 // returns FALSE if device is disconnected
 // returns TRUE  otherwise
@@ -1031,3 +1108,58 @@ void DallasTemperature::operator delete(void* p) {
 }
 
 #endif
+
+DallasTemperatureScheduler::DallasTemperatureScheduler(DallasTemperature* _buses,
+		uint8_t _busCount, int16_t* _snapshot, uint8_t _snapshotSize) {
+	buses = _buses;
+	busCount = _busCount;
+	snapshot = _snapshot;
+	snapshotSize = _snapshotSize;
+	count = 0;
+	interval = 0;
+	lastStart = 0;
+	started = false;
+	converting = false;
+}
+
+void DallasTemperatureScheduler::setInterval(unsigned long _interval) {
+	interval = _interval;
+}
+
+// starts a conversion on every bus at once, then polls them, and once all
+// are done reads every bus in turn into the snapshot
+bool DallasTemperatureScheduler::update() {
+
+	if (!converting) {
+		if (started && millis() - lastStart < interval)
+			return false;
+		for (uint8_t i = 0; i < busCount; i++)
+			buses[i].startConversion();
+		lastStart = millis();
+		started = true;
+		converting = true;
+		return false;
+	}
+
+	for (uint8_t i = 0; i < busCount; i++)
+		if (!buses[i].conversionDone())
+			return false;
+
+	count = 0;
+	for (uint8_t i = 0; i < busCount; i++)
+		count += buses[i].readTemperatures(snapshot + count, snapshotSize - count);
+	converting = false;
+	return true;
+
+}
+
+uint8_t DallasTemperatureScheduler::getCount() {
+	return count;
+}
+
+uint8_t DallasTemperatureScheduler::getOffset(uint8_t bus) {
+	uint16_t offset = 0;
+	for (uint8_t i = 0; i < bus && i < busCount; i++)
+		offset += buses[i].getDeviceCount();
+	return offset < snapshotSize ? offset : snapshotSize;
+}
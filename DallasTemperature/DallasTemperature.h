@@ -25,6 +25,18 @@
 #include <OneWire.h>
 #endif
 
+// number of device addresses begin() keeps, so that getAddress() and the
+// ...ByIndex() functions don't search the bus. Set to 0 to always search.
+#ifndef DALLASTEMP_ADDRESS_CACHE
+#if defined(RAMEND) && RAMEND < 0x1000
+#define DALLASTEMP_ADDRESS_CACHE 8
+#elif defined(__AVR__)
+#define DALLASTEMP_ADDRESS_CACHE 16
+#else
+#define DALLASTEMP_ADDRESS_CACHE 64
+#endif
+#endif
+
 // Model IDs
 #define DS18S20MODEL 0x10  // also DS1820
 #define DS18B20MODEL 0x28  // also MAX31820
@@ -158,6 +170,19 @@ public:
 	// Is a conversion complete on the wire? Only applies to the first sensor on the wire.
 	bool isConversionComplete(void);
 
+	// sends command for all devices on the bus to perform a temperature conversion
+	// and returns immediately, whatever the waitForConversion flag
+	void startConversion(void);
+
+	// returns true once the conversion started by startConversion() is complete,
+	// without blocking. Call it repeatedly until it does.
+	bool conversionDone(void);
+
+	// reads the raw temperatures of the devices found by begin(), in index order,
+	// without searching the bus. Entries for devices that can't be read are set
+	// to DEVICE_DISCONNECTED_RAW. Returns the number of entries written.
+	uint8_t readTemperatures(int16_t*, uint8_t);
+
   int16_t millisToWaitForConversion(uint8_t);
   
   // Sends command to one device to save values from scratchpad to EEPROM by index
@@ -283,6 +308,16 @@ private:
 	// count of devices on the bus
 	uint8_t devices;
 
+#if DALLASTEMP_ADDRESS_CACHE > 0
+	// addresses found by begin(), in search order
+	DeviceAddress addressCache[DALLASTEMP_ADDRESS_CACHE];
+	uint8_t cachedAddresses;
+#endif
+
+	// used by startConversion() and conversionDone()
+	bool converting;
+	unsigned long conversionStart;
+
 	// count of DS18xxx Family devices on bus
 	uint8_t ds18Count;
 
@@ -313,5 +348,42 @@ private:
 
 #endif
 
+};
+
+// Converts on several buses at once without blocking, and keeps the raw
+// temperatures of all their devices in a snapshot array: the devices of the
+// first bus in index order, then those of the second bus, and so on.
+// Call begin() on each DallasTemperature first, and update() from loop().
+class DallasTemperatureScheduler {
+public:
+
+	DallasTemperatureScheduler(DallasTemperature*, uint8_t, int16_t*, uint8_t);
+
+	// sets the time in milliseconds from the start of one conversion to the
+	// start of the next. With 0, a conversion starts as soon as the last is read.
+	void setInterval(unsigned long);
+
+	// starts conversions, polls them and reads the temperatures when all buses
+	// are done. Returns true when a new snapshot has been written.
+	bool update(void);
+
+	// returns the number of temperatures in the snapshot
+	uint8_t getCount(void);
+
+	// returns the position of the first temperature of a bus in the snapshot
+	uint8_t getOffset(uint8_t);
+
+private:
+	DallasTemperature* buses;
+	uint8_t busCount;
+	int16_t* snapshot;
+	uint8_t snapshotSize;
+	uint8_t count;
+
+	unsigned long interval;
+	unsigned long lastStart;
+	bool started;
+	bool converting;
+
 };
 #endif
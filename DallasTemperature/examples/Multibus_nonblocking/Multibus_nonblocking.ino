@@ -0,0 +1,48 @@
+#include <OneWire.h>
+#include <DallasTemperature.h>
+
+// Converts on all buses at once without blocking loop(), and keeps the
+// temperatures of every sensor in one array
+
+OneWire ds18x20[] = { 3, 7 };
+const int oneWireCount = sizeof(ds18x20)/sizeof(OneWire);
+DallasTemperature sensor[oneWireCount];
+
+#define MAX_SENSORS 32
+int16_t temperatures[MAX_SENSORS];
+DallasTemperatureScheduler scheduler(sensor, oneWireCount, temperatures, MAX_SENSORS);
+
+void setup(void) {
+  // start serial port
+  Serial.begin(9600);
+  Serial.println("Dallas Temperature Multiple Bus Non-blocking Demo");
+
+  // Start up the library on all defined bus-wires
+  for (int i = 0; i < oneWireCount; i++) {
+    sensor[i].setOneWire(&ds18x20[i]);
+    sensor[i].begin();
+    sensor[i].setResolution(12);
+  }
+
+  // start a conversion every 2 seconds
+  scheduler.setInterval(2000);
+}
+
+void loop(void) {
+  if (scheduler.update()) {
+    for (int i = 0; i < oneWireCount; i++) {
+      uint8_t first = scheduler.getOffset(i);
+      uint8_t last = scheduler.getOffset(i + 1);
+      for (uint8_t j = first; j < last; j++) {
+        Serial.print("Bus ");
+        Serial.print(i);
+        Serial.print(" sensor ");
+        Serial.print(j - first);
+        Serial.print(": ");
+        Serial.println(DallasTemperature::rawToCelsius(temperatures[j]));
+      }
+    }
+  }
+
+  // the rest of loop() keeps running while the sensors convert
+}
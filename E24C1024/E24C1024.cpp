@@ -59,26 +59,89 @@ E24C1024::E24C1024(void)
    Wire.begin();
 }
 
-void E24C1024::write(unsigned long dataAddress, uint8_t data)
+uint8_t E24C1024::device(unsigned long dataAddress)
 {
-   Wire.beginTransmission((uint8_t)((0x500000 | dataAddress) >> 16)); // B1010xxx
+   return (uint8_t)((0x500000 | dataAddress) >> 16); // B1010xxx
+}
+
+// Starts a transmission and sends the word address
+void E24C1024::setAddress(unsigned long dataAddress)
+{
+   Wire.beginTransmission(device(dataAddress));
    Wire.write((uint8_t)((dataAddress & WORD_MASK) >> 8)); // MSB
    Wire.write((uint8_t)(dataAddress & 0xFF)); // LSB
+}
+
+// The device does not acknowledge its address until the write cycle is done
+void E24C1024::waitReady(uint8_t deviceAddress)
+{
+   unsigned long start = millis();
+   do
+   {
+      Wire.beginTransmission(deviceAddress);
+      if (Wire.endTransmission() == 0) return;
+   } while (millis() - start < E24C1024_WRITE_TIMEOUT);
+}
+
+void E24C1024::write(unsigned long dataAddress, uint8_t data)
+{
+   setAddress(dataAddress);
    Wire.write(data);
    Wire.endTransmission();
-   delay(5);
+   waitReady(device(dataAddress));
 }
 
 uint8_t E24C1024::read(unsigned long dataAddress)
 {
    uint8_t data = 0x00;
-   Wire.beginTransmission((uint8_t)((0x500000 | dataAddress) >> 16)); // B1010xxx
-   Wire.write((uint8_t)((dataAddress & WORD_MASK) >> 8)); // MSB
-   Wire.write((uint8_t)(dataAddress & 0xFF)); // LSB
+   setAddress(dataAddress);
    Wire.endTransmission();
-   Wire.requestFrom(0x50,1);
+   Wire.requestFrom(device(dataAddress), (uint8_t)1);
    if (Wire.available()) data = Wire.read();
    return data;
 }
 
+void E24C1024::write(unsigned long dataAddress, const uint8_t* data, unsigned int length)
+{
+   while (length > 0)
+   {
+      // Stay within the page, and leave room for the word address in the Wire buffer
+      unsigned int n = E24C1024_PAGE_SIZE - (dataAddress % E24C1024_PAGE_SIZE);
+      if (n > E24C1024_TRANSFER_SIZE - 2) n = E24C1024_TRANSFER_SIZE - 2;
+      if (n > length) n = length;
+      setAddress(dataAddress);
+      Wire.write(data, n);
+      Wire.endTransmission();
+      waitReady(device(dataAddress));
+      dataAddress += n;
+      data += n;
+      length -= n;
+   }
+}
+
+void E24C1024::read(unsigned long dataAddress, uint8_t* data, unsigned int length)
+{
+   bool addressSet = false;
+   while (length > 0)
+   {
+      // A sequential read wraps around within the 64K block of one device address
+      unsigned int n = E24C1024_TRANSFER_SIZE;
+      if (n > length) n = length;
+      if (n > 0x10000 - (dataAddress & WORD_MASK)) n = 0x10000 - (dataAddress & WORD_MASK);
+      if (!addressSet || (dataAddress & WORD_MASK) == 0)
+      {
+         setAddress(dataAddress);
+         Wire.endTransmission();
+         addressSet = true;
+      }
+      // Later reads carry on from the address the device is at
+      Wire.requestFrom(device(dataAddress), (uint8_t)n);
+      for (unsigned int i = 0; i < n; i++)
+         data[i] = Wire.available() ? Wire.read() : 0x00;
+      dataAddress += n;
+      data += n;
+      length -= n;
+   }
+}
+
 E24C1024 EEPROM1024;
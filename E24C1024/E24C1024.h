@@ -55,12 +55,30 @@
 #define FULL_MASK 0x7FFFF
 #define DEVICE_MASK 0x7F0000
 #define WORD_MASK 0xFFFF
+#define E24C1024_PAGE_SIZE 128 // 24LC1024 page, the AT24C1024B has 256 byte pages made of two of these
+#define E24C1024_WRITE_TIMEOUT 10 // ms, the write cycle takes up to 5 ms
+
+// Bytes of data in one I2C transaction, limited by the Wire buffer
+#ifdef BUFFER_LENGTH
+#define E24C1024_TRANSFER_SIZE BUFFER_LENGTH
+#else
+#define E24C1024_TRANSFER_SIZE 32
+#endif
+
 class E24C1024
 {
   public:
     E24C1024();
     static void write(unsigned long, uint8_t);
     static uint8_t read(unsigned long);
+    // Writes length bytes, a page at a time
+    static void write(unsigned long, const uint8_t*, unsigned int);
+    // Reads length bytes with sequential reads
+    static void read(unsigned long, uint8_t*, unsigned int);
+  private:
+    static uint8_t device(unsigned long);
+    static void setAddress(unsigned long);
+    static void waitReady(uint8_t);
 };
 
 extern E24C1024 EEPROM1024;
@@ -214,6 +214,14 @@ void AviMjpegEncoder::addJpegFrame(const uint8_t *jpegData, int len)
 }
 
 
+// add empty "00dc" chunk, the frame duration is kept but nothing is decoded
+void AviMjpegEncoder::addNullFrame()
+{
+  writeJpegFrameHeader( 0 );
+  writeJpegFrameFinish();
+}
+
+
 // add AVI header for jpeg frame
 void AviMjpegEncoder::writeJpegFrameHeader(int len)
 {
@@ -262,7 +270,7 @@ void AviMjpegEncoder::writeJpegIdxItem( fs::AviFile* dst, avi_idx_item_t item )
 {
   assert( dst );
   dst->writeWordStr("00dc");
-  dst->writeDword(0x10);     // flags: select AVIIF_KEYFRAME
+  dst->writeDword(item.len>0 ? 0x10 : 0); // flags: select AVIIF_KEYFRAME, null frames aren't keyframes
   dst->writeDword(item.pos); // offset to the chunk, offset can be relative to file start or 'movi'
   dst->writeDword(item.len); // length of the chunk
 }
@@ -15,10 +15,12 @@ class AviMjpegEncoder
     void writeJpegFrameHeader(int len=0);
     void writeJpegFrameData(const uint8_t *jpegData, int len);
     void writeJpegFrameFinish();
+    // add a zero-length frame, players repeat the previous frame
+    void addNullFrame();
 
     void finalize();
 
-    size_t framesCount() { return imgIndex.size(); }
+    size_t framesCount() { return params->use_index_file ? idx_items_count : imgIndex.size(); }
 
     fs::AviFile aviFile;
     fs::AviFile idxFile;
@@ -0,0 +1,225 @@
+#include "AviRecorder.hpp"
+
+#if defined HAS_JPEGENC
+
+
+static void* recorderAlloc( size_t size )
+{
+  void* ptr = psramInit() ? ps_malloc( size ) : nullptr;
+  return ptr ? ptr : malloc( size );
+}
+
+
+bool AviRecorder::begin( AVI_Params_t* params, int32_t x, int32_t y, uint32_t w, uint32_t h, uint8_t quality )
+{
+  assert( params );
+  assert( params->fs );
+  assert( _src );
+  if( _task ) return true;
+
+  _x = x; _y = y;
+  _w = w ? w : _src->width()  - x;
+  _h = h ? h : _src->height() - y;
+  _bpp = _src->getColorDepth() >= 24 ? 3 : 2;
+  _quality = quality;
+  params->size.w = _w;
+  params->size.h = _h;
+  _params = params;
+  _stats = AviRecorderStats_t();
+  _stats.tiles = ((_w+AVI_RECORDER_TILE_SIZE-1)/AVI_RECORDER_TILE_SIZE) * ((_h+AVI_RECORDER_TILE_SIZE-1)/AVI_RECORDER_TILE_SIZE);
+  _cur = 0; _ref = 1;
+  _hasRef = false;
+  _encoding = false;
+
+  _frame[0]   = (uint8_t*)recorderAlloc( _w*_h*_bpp );
+  _frame[1]   = (uint8_t*)recorderAlloc( _w*_h*_bpp );
+  _jpgBufSize = _w*_h*.5; // estimated max jpeg bytes = (w*h)/2, i.e. max 4bits per pixel
+  _jpgBuf     = (uint8_t*)recorderAlloc( _jpgBufSize );
+  if( !_frame[0] || !_frame[1] || !_jpgBuf ) {
+    log_e("Can't allocate %dx%d@%dbpp frame buffers", _w, _h, _bpp*8 );
+    freeBuffers();
+    return false;
+  }
+
+  _encoder = new AviMjpegEncoder( params );
+  if( !params->ready ) {
+    log_e("Unable to create AVIEncoder instance");
+    delete _encoder;
+    _encoder = nullptr;
+    freeBuffers();
+    return false;
+  }
+
+  _queue = xQueueCreate( AVI_RECORDER_QUEUE_SIZE, sizeof(cmd_t) );
+  _done  = xSemaphoreCreateBinary();
+  #if portNUM_PROCESSORS > 1
+    const BaseType_t core = xPortGetCoreID() == 0 ? 1 : 0; // encode and write on the other core
+  #else
+    const BaseType_t core = tskNO_AFFINITY;
+  #endif
+  if( !_queue || !_done || xTaskCreatePinnedToCore( writerTask, "AviRecorder", AVI_RECORDER_STACK_SIZE, this, AVI_RECORDER_PRIORITY, &_task, core ) != pdPASS ) {
+    log_e("Can't create writer task");
+    _task = nullptr;
+    if( _queue ) vQueueDelete( _queue );
+    if( _done ) vSemaphoreDelete( _done );
+    _queue = nullptr;
+    _done  = nullptr;
+    delete _encoder;
+    _encoder = nullptr;
+    freeBuffers();
+    params->ready = false;
+    return false;
+  }
+
+  log_d("Recording %s[%dx%d]@%dbpp to %s", _is_sprite?"sprite":"display", _w, _h, _bpp*8, params->path.c_str() );
+  return true;
+}
+
+
+bool AviRecorder::addFrame()
+{
+  if( !_task ) return false;
+
+  capture( _frame[_cur] );
+  uint32_t dirty = _hasRef ? diff( _frame[_cur], _frame[_ref] ) : _stats.tiles;
+  _stats.dirtyTiles = dirty;
+
+  cmd_t cmd = { CMD_REPEAT, 0 };
+  if( dirty > 0 && !_encoding ) {
+    // the captured frame becomes the new reference, the writer reads it while we only compare against it
+    std::swap( _cur, _ref );
+    _hasRef   = true;
+    _encoding = true;
+    cmd = { CMD_ENCODE, _ref };
+  }
+  xQueueSend( _queue, &cmd, portMAX_DELAY );
+  _stats.frames++;
+  return true;
+}
+
+
+bool AviRecorder::end()
+{
+  if( !_task ) return false;
+  cmd_t cmd = { CMD_FINALIZE, 0 };
+  xQueueSend( _queue, &cmd, portMAX_DELAY );
+  xSemaphoreTake( _done, portMAX_DELAY ); // writer task deletes itself after finalizing
+  _task = nullptr;
+  vQueueDelete( _queue );
+  vSemaphoreDelete( _done );
+  _queue = nullptr;
+  _done  = nullptr;
+  delete _encoder;
+  _encoder = nullptr;
+  freeBuffers();
+  _params->ready = false;
+  log_d("Recorded %d frames (%d encoded, %d repeated)", _stats.frames, _stats.encoded, _stats.repeated );
+  return true;
+}
+
+
+void AviRecorder::freeBuffers()
+{
+  for( auto& frame : _frame ) {
+    if( frame ) free( frame );
+    frame = nullptr;
+  }
+  if( _jpgBuf ) free( _jpgBuf );
+  _jpgBuf = nullptr;
+}
+
+
+void AviRecorder::capture( uint8_t* dst )
+{
+  // one bulk read, much faster than the per-MCU reads of snapAVI
+  if( _bpp == 3 ) _src->readRectRGB( _x, _y, _w, _h, dst );
+  else _src->readRect( _x, _y, _w, _h, (lgfx::rgb565_t*)dst );
+}
+
+
+uint32_t AviRecorder::diff( const uint8_t* a, const uint8_t* b )
+{
+  const uint32_t pitch = _w*_bpp;
+  uint32_t dirty = 0;
+  for( uint32_t ty=0; ty<_h; ty+=AVI_RECORDER_TILE_SIZE ) {
+    const uint32_t th = std::min<uint32_t>( AVI_RECORDER_TILE_SIZE, _h-ty );
+    for( uint32_t tx=0; tx<_w; tx+=AVI_RECORDER_TILE_SIZE ) {
+      const uint32_t len = std::min<uint32_t>( AVI_RECORDER_TILE_SIZE, _w-tx ) * _bpp;
+      uint32_t offset = ty*pitch + tx*_bpp;
+      for( uint32_t y=0; y<th; y++, offset+=pitch ) {
+        if( memcmp( a+offset, b+offset, len ) != 0 ) {
+          dirty++;
+          break;
+        }
+      }
+    }
+  }
+  return dirty;
+}
+
+
+size_t AviRecorder::encode( const uint8_t* frame )
+{
+  JPEG jpg;
+  JPEGENCODE jpe;
+  uint8_t ucMCU[64*3];
+  const uint32_t pitch = _w*_bpp;
+
+  int rc = jpg.open( _jpgBuf, _jpgBufSize );
+  if (rc != JPEG_SUCCESS) {
+    log_e("Failed to create jpeg object");
+    return 0;
+  }
+  rc = jpg.encodeBegin( &jpe, _w, _h, _bpp == 3 ? JPEG_PIXEL_RGB888 : JPEG_PIXEL_RGB565, JPEG_SUBSAMPLE_444, _quality );
+  if (rc != JPEG_SUCCESS) {
+    log_e("Failed to initiate jpeg encoding");
+    return 0;
+  }
+
+  int iMCUCount = ((_w + jpe.cx-1)/ jpe.cx) * ((_h + jpe.cy-1) / jpe.cy);
+  for( int i=0; i<iMCUCount && rc == JPEG_SUCCESS; i++ ) {
+    const uint8_t* mcu = frame + jpe.y*pitch + jpe.x*_bpp;
+    if( jpe.x + jpe.cx <= _w && jpe.y + jpe.cy <= _h ) {
+      rc = jpg.addMCU( &jpe, (uint8_t*)mcu, pitch ); // MCUs are read in place from the frame buffer
+    } else { // right/bottom edge, pad the MCU by repeating the last column/row
+      const uint32_t cw = _w - jpe.x, ch = _h - jpe.y;
+      for( uint32_t y=0; y<8; y++ ) {
+        const uint8_t* line = mcu + std::min<uint32_t>( y, ch-1 )*pitch;
+        for( uint32_t x=0; x<8; x++ ) {
+          memcpy( &ucMCU[(y*8+x)*_bpp], line + std::min<uint32_t>( x, cw-1 )*_bpp, _bpp );
+        }
+      }
+      rc = jpg.addMCU( &jpe, ucMCU, 8*_bpp );
+    }
+  }
+  return jpg.close();
+}
+
+
+void AviRecorder::writerTask( void* param )
+{
+  auto self = (AviRecorder*)param;
+  cmd_t cmd;
+  while( xQueueReceive( self->_queue, &cmd, portMAX_DELAY ) == pdTRUE ) {
+    if( cmd.type == CMD_FINALIZE ) {
+      self->_encoder->finalize();
+      break;
+    }
+    size_t len = 0;
+    if( cmd.type == CMD_ENCODE ) {
+      len = self->encode( self->_frame[cmd.frame] );
+      self->_encoding = false;
+    }
+    if( len > 0 ) {
+      self->_encoder->addJpegFrame( self->_jpgBuf, len );
+      self->_stats.encoded++;
+    } else {
+      self->_encoder->addNullFrame();
+      self->_stats.repeated++;
+    }
+  }
+  xSemaphoreGive( self->_done );
+  vTaskDelete( NULL );
+}
+
+#endif
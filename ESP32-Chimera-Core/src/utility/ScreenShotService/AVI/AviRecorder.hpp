@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../ScreenShot.hpp"
+
+#if defined HAS_JPEGENC
+
+#ifndef AVI_RECORDER_TILE_SIZE
+  #define AVI_RECORDER_TILE_SIZE 16 // frame diff granularity (pixels)
+#endif
+#ifndef AVI_RECORDER_QUEUE_SIZE
+  #define AVI_RECORDER_QUEUE_SIZE 8 // frames waiting for the writer task
+#endif
+#ifndef AVI_RECORDER_STACK_SIZE
+  #define AVI_RECORDER_STACK_SIZE 8192
+#endif
+#ifndef AVI_RECORDER_PRIORITY
+  #define AVI_RECORDER_PRIORITY 1
+#endif
+
+
+struct AviRecorderStats_t
+{
+  uint32_t frames{0};     // frames added to the stream
+  uint32_t encoded{0};    // frames jpeg-encoded
+  uint32_t repeated{0};   // frames stored as zero-length chunks (unchanged, or encoder still busy)
+  uint32_t dirtyTiles{0}; // changed tiles in the last captured frame
+  uint32_t tiles{0};      // tiles per frame
+};
+
+
+/*\
+ *  Screen recorder producing a MJPEG AVI:
+ *    - each frame is read in one readRect into a PSRAM buffer and diffed tile by tile against the last encoded frame
+ *    - unchanged frames are stored as zero-length "00dc" chunks (players repeat the previous frame), no encoding at all
+ *    - changed frames are jpeg-encoded from the RAM copy and written to the filesystem by a writer task on the other core
+ *    - if the writer is still busy with the previous frame, the new frame is stored as a repeat and picked up by the next diff
+ *  Frame timing is kept: each addFrame() call adds exactly one frame to the stream, call it at params->fps rate.
+ *  Note: the filesystem must be safe to use from another task (e.g. SD sharing the TFT SPI bus needs bus_shared=true)
+ *
+ *  AviRecorder rec( &M5.Lcd );
+ *  rec.begin( new AVI_Params_t( &SD, "/session.avi", 10 ) );
+ *  while( recording ) { ...; rec.addFrame(); }
+ *  rec.end();
+\*/
+class AviRecorder
+{
+
+  public:
+
+    AviRecorder( LGFX* src, bool is_sprite = false ) : _src(src), _is_sprite(is_sprite) { };
+    AviRecorder( LGFX_Sprite* sprite ) : _src((LGFX*)sprite), _is_sprite(true) { };
+    ~AviRecorder() { end(); }
+
+    // w=0 or h=0 means full source size
+    bool begin( AVI_Params_t* params, int32_t x = 0, int32_t y = 0, uint32_t w = 0, uint32_t h = 0, uint8_t quality = JPEG_Q_HIGH );
+    bool addFrame();
+    bool end(); // flush pending frames and finalize the AVI file
+    bool recording() { return _task != nullptr; }
+    const AviRecorderStats_t& stats() { return _stats; }
+
+  private:
+
+    enum : uint8_t { CMD_ENCODE, CMD_REPEAT, CMD_FINALIZE };
+    struct cmd_t
+    {
+      uint8_t type;
+      uint8_t frame; // index in _frame[]
+    };
+
+    LGFX*            _src;
+    bool             _is_sprite;
+    AVI_Params_t*    _params  = nullptr;
+    AviMjpegEncoder* _encoder = nullptr;
+
+    int32_t  _x = 0, _y = 0;
+    uint32_t _w = 0, _h = 0;
+    uint8_t  _bpp = 2;
+    uint8_t  _quality = JPEG_Q_HIGH;
+
+    uint8_t* _frame[2] = { nullptr, nullptr }; // capture and reference buffers
+    uint8_t  _cur = 0;                         // capture buffer
+    uint8_t  _ref = 1;                         // last encoded frame (read by both the diff and the encoder)
+    bool     _hasRef = false;
+    volatile bool _encoding = false;
+
+    uint8_t* _jpgBuf = nullptr;
+    uint32_t _jpgBufSize = 0;
+
+    QueueHandle_t     _queue = nullptr;
+    SemaphoreHandle_t _done  = nullptr;
+    TaskHandle_t      _task  = nullptr;
+
+    AviRecorderStats_t _stats;
+
+    void     capture( uint8_t* dst );
+    uint32_t diff( const uint8_t* a, const uint8_t* b );
+    size_t   encode( const uint8_t* frame );
+    void     freeBuffers();
+    static void writerTask( void* param );
+
+};
+
+#endif
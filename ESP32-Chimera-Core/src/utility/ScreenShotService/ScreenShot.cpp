@@ -32,6 +32,10 @@
 
 ScreenShotService::~ScreenShotService()
 {
+  while( _asyncBusy ) delay(10); // the encoder task uses this instance
+  #if defined HAS_JPEGENC
+    if( _aviRecorder ) delete _aviRecorder; // finalizes the file
+  #endif
   if( _begun ) {
     if( screenShotBuffer) free( screenShotBuffer );
     _begun = false;
@@ -128,45 +132,38 @@ void ScreenShotService::snap( const char* name, bool displayAfter )
   fs::FS* JPGENC_IMG_Proxy_t::fs = nullptr;
 
 
-  void ScreenShotService::snapJPG( const char* name, bool displayAfter )
+  size_t ScreenShotService::encodeJPG( LGFX* src, fs::FS* fileSystem, const char* path, int32_t x, int32_t y, uint32_t w, uint32_t h, bool usePsram )
   {
-    if( !_begun || !_inited ) return;
-    assert( name );
-    assert( _fileSystem );
-
     JPEG jpg;
     JPEGENCODE jpe;
-    JPGENC_IMG_Proxy_t::fs = _fileSystem;
+    JPGENC_IMG_Proxy_t::fs = fileSystem;
     JPGENC_IMG_Proxy_t IMG_Proxy = JPGENC_IMG_Proxy_t();
     bool use_buffer = true;
-    auto color_depth = _src->getColorDepth();
+    auto color_depth = src->getColorDepth();
     const int bytes_per_pixel = color_depth/8;
     uint8_t jpeg_pixel_format = color_depth >= 24 ? JPEG_PIXEL_RGB888 : JPEG_PIXEL_RGB565;
     uint8_t ucMCU[64*bytes_per_pixel];
     int iMCUCount, rc, i;
-    size_t iDataSize;
-    [[maybe_unused]] uint32_t time_start = millis();
+    size_t iDataSize = 0;
+    uint8_t* jpgBuffer = NULL;
+    uint32_t jpgBufSize = w*h*.5; // will use buffered writes (faster), estimated max jpeg bytes = (w*h)/2, i.e. max 4bits per pixel
 
-    genFileName( name, "jpg" ); // store computed file name in 'fileName' (char[255])
-    screenShotBufSize = _w*_h*.5; // will use buffered writes (faster), estimated max jpeg bytes = (w*h)/2, i.e. max 4bits per pixel
-
-    if( _psram && psramInit() ) {
-      screenShotBuffer = (uint8_t*)ps_calloc( screenShotBufSize, sizeof( uint8_t ) );
+    if( usePsram && psramInit() ) {
+      jpgBuffer = (uint8_t*)ps_calloc( jpgBufSize, sizeof( uint8_t ) );
     } else {
-      screenShotBuffer = (uint8_t*)calloc( screenShotBufSize, sizeof( uint8_t ) );
-      _psram = false;
+      jpgBuffer = (uint8_t*)calloc( jpgBufSize, sizeof( uint8_t ) );
     }
-    if( screenShotBuffer ) {
+    if( jpgBuffer ) {
       log_v( "ScreenShot Service can use JPG capture" );
     } else {
       log_i( "Not enough ram to use jpeg screenshot" );
       use_buffer = false;
     }
 
-    if( use_buffer && screenShotBufSize > 0 ) {
-      rc = jpg.open(screenShotBuffer, screenShotBufSize);
+    if( use_buffer && jpgBufSize > 0 ) {
+      rc = jpg.open(jpgBuffer, jpgBufSize);
     } else {
-      rc = jpg.open(fileName, IMG_Proxy.open, IMG_Proxy.close, IMG_Proxy.read, IMG_Proxy.write, IMG_Proxy.seek);
+      rc = jpg.open(path, IMG_Proxy.open, IMG_Proxy.close, IMG_Proxy.read, IMG_Proxy.write, IMG_Proxy.seek);
     }
 
     if (rc != JPEG_SUCCESS) {
@@ -174,7 +171,7 @@ void ScreenShotService::snap( const char* name, bool displayAfter )
       goto _end;
     }
 
-    rc = jpg.encodeBegin(&jpe, _w, _h, jpeg_pixel_format, JPEG_SUBSAMPLE_444, JPEG_Q_HIGH);
+    rc = jpg.encodeBegin(&jpe, w, h, jpeg_pixel_format, JPEG_SUBSAMPLE_444, JPEG_Q_HIGH);
 
     if (rc != JPEG_SUCCESS) {
       log_e("Failed to initiate jpeg encoding");
@@ -182,26 +179,48 @@ void ScreenShotService::snap( const char* name, bool displayAfter )
     }
 
     memset(ucMCU, 0, sizeof(ucMCU)); // zerofill MCU, not really required as we'll fill it soon with readRect()
-    iMCUCount = ((_w + jpe.cx-1)/ jpe.cx) * ((_h + jpe.cy-1) / jpe.cy);
+    iMCUCount = ((w + jpe.cx-1)/ jpe.cx) * ((h + jpe.cy-1) / jpe.cy);
 
     for (i=0; i<iMCUCount && rc == JPEG_SUCCESS; i++) {
-      if( color_depth >= 24 ) _src->readRectRGB( _x+jpe.x, _y+jpe.y, jpe.cx, jpe.cy, ucMCU );
-      else _src->readRect( _x+jpe.x, _y+jpe.y, jpe.cx, jpe.cy, (lgfx::rgb565_t*)ucMCU );
+      if( color_depth >= 24 ) src->readRectRGB( x+jpe.x, y+jpe.y, jpe.cx, jpe.cy, ucMCU );
+      else src->readRect( x+jpe.x, y+jpe.y, jpe.cx, jpe.cy, (lgfx::rgb565_t*)ucMCU );
       rc = jpg.addMCU(&jpe, ucMCU, 8*bytes_per_pixel);
     }
 
     iDataSize = jpg.close();
 
     if( use_buffer ) {
-      auto file = _fileSystem->open(fileName, "w" );
+      auto file = fileSystem->open(path, "w" );
       if( ! file ) {
-        log_e("Can't open %d for writing", fileName );
+        log_e("Can't open %s for writing", path );
+        iDataSize = 0;
         goto _end;
       }
-      file.write( screenShotBuffer, iDataSize );
+      file.write( jpgBuffer, iDataSize );
       file.close();
     }
 
+    _end:
+
+    if( jpgBuffer ) free( jpgBuffer );
+    return iDataSize;
+  }
+
+
+  void ScreenShotService::snapJPG( const char* name, bool displayAfter )
+  {
+    if( !_begun || !_inited ) return;
+    assert( name );
+    assert( _fileSystem );
+
+    [[maybe_unused]] uint32_t time_start = millis();
+
+    genFileName( name, "jpg" ); // store computed file name in 'fileName' (char[255])
+    _psram = _psram && psramInit();
+
+    size_t iDataSize = encodeJPG( _src, _fileSystem, fileName, _x, _y, _w, _h, _psram );
+    if( iDataSize == 0 ) return;
+
     log_i( "[SUCCESS] Screenshot saved as %s (%d bytes) in %u ms", fileName, iDataSize, millis()-time_start);
 
     if( displayAfter ) {
@@ -209,10 +228,6 @@ void ScreenShotService::snap( const char* name, bool displayAfter )
       _src->drawJpgFile( *_fileSystem, fileName, _x, _y );
       delay(5000);
     }
-
-    _end:
-
-    if( screenShotBuffer ) free( screenShotBuffer );
   }
 
 
@@ -344,6 +359,42 @@ void ScreenShotService::snap( const char* name, bool displayAfter )
     }
   }
 
+
+  bool ScreenShotService::recordAVI( AVI_Params_t *params, bool finalize )
+  {
+    assert( params );
+    assert( _fileSystem || params->fs );
+    assert( _src ); // source display/sprite
+
+    if( params->fs ) _fileSystem = params->fs;
+    else params->fs = _fileSystem;
+
+    if( !_begun || !_inited ) return false;
+
+    if( _aviRecorder == nullptr ) {
+      if( finalize ) return false;
+      if( params->path == "" ) {
+        genFileName( "out", "avi" );
+        params->path = String( fileName );
+      }
+      _aviRecorder = new AviRecorder( _src, _is_sprite );
+      if( !_aviRecorder->begin( params, _x, _y, params->size.w>0 ? params->size.w : _w, params->size.h>0 ? params->size.h : _h ) ) {
+        delete _aviRecorder;
+        _aviRecorder = nullptr;
+        return false;
+      }
+    }
+
+    if( finalize ) {
+      bool ret = _aviRecorder->end();
+      delete _aviRecorder;
+      _aviRecorder = nullptr;
+      return ret;
+    }
+
+    return _aviRecorder->addFrame();
+  }
+
 #endif
 
 
@@ -449,6 +500,142 @@ size_t ScreenShotService::snapQOI( const char* name, bool displayAfter )
 }
 
 
+size_t ScreenShotService::encodeToFile( ScreenShotFormat_t format, LGFX* src, bool is_sprite, fs::FS* fileSystem, const char* path, int32_t x, int32_t y, uint32_t w, uint32_t h, bool usePsram )
+{
+  size_t fileSize = 0;
+  bool success = false;
+  switch( format ) {
+    case SCREENSHOT_BMP: {
+      BMP_Encoder BMPEncoder( src, fileSystem );
+      success = BMPEncoder.encodeToFile( path, x, y, w, h );
+    } break;
+    case SCREENSHOT_PNG: {
+      PNG_Encoder PNGEncoder( src, fileSystem );
+      PNGEncoder.init();
+      success = PNGEncoder.encodeToFile( path, x, y, w, h );
+    } break;
+    case SCREENSHOT_GIF: {
+      GIF_Encoder* GIFEncoder = new GIF_Encoder( src, fileSystem ); // big object, keep it off the stack
+      success = GIFEncoder->encodeToFile( path, x, y, w, h );
+      delete GIFEncoder;
+    } break;
+    case SCREENSHOT_QOI: {
+      QOI_Encoder QOIEncoder( src, is_sprite );
+      QOIEncoder.setFileSystem( fileSystem );
+      return QOIEncoder.encodeToFile( path, x, y, w, h );
+    }
+    case SCREENSHOT_JPG:
+      #if defined HAS_JPEGENC
+        return encodeJPG( src, fileSystem, path, x, y, w, h, usePsram );
+      #else
+        log_e( TinyJPEG_DEPRECATE_MSG );
+        return 0;
+      #endif
+  }
+  if( success ) {
+    fs::File outFile = fileSystem->open( path );
+    fileSize = outFile.size();
+    outFile.close();
+  }
+  return fileSize;
+}
+
+
+struct ScreenShotAsyncJob_t
+{
+  ScreenShotService*   service;
+  ScreenShotFormat_t   format;
+  LGFX_Sprite*         frame; // PSRAM copy of the capture window
+  fs::FS*              fileSystem;
+  ScreenShotCallback_t cb;
+  void*                cbArg;
+  bool                 usePsram;
+  char                 fileName[255];
+};
+
+
+void ScreenShotService::asyncTask( void* param )
+{
+  auto job = (ScreenShotAsyncJob_t*)param;
+  [[maybe_unused]] uint32_t time_start = millis();
+  auto frame = job->frame;
+  size_t fileSize = encodeToFile( job->format, (LGFX*)frame, true, job->fileSystem, job->fileName, 0, 0, frame->width(), frame->height(), job->usePsram );
+  if( fileSize == 0 ) {
+    log_e( "[ERROR] Could not write async capture to: %s", job->fileName );
+  } else {
+    log_i( "[SUCCESS] Screenshot saved as %s (%d bytes). Encoding time %u ms", job->fileName, fileSize, millis()-time_start);
+  }
+  frame->deleteSprite();
+  delete frame;
+  if( job->cb ) job->cb( fileSize > 0, job->fileName, fileSize, job->cbArg );
+  job->service->_asyncBusy = false;
+  delete job;
+  vTaskDelete( NULL );
+}
+
+
+bool ScreenShotService::snapAsync( ScreenShotFormat_t format, const char* name, ScreenShotCallback_t cb, void* cbArg )
+{
+  if( !_begun || !_inited ) return false;
+  assert( name );
+  assert( _fileSystem );
+  if( _asyncBusy ) {
+    log_w( "Previous async capture still pending" );
+    return false;
+  }
+  #if !defined HAS_JPEGENC
+    if( format == SCREENSHOT_JPG ) {
+      log_e( TinyJPEG_DEPRECATE_MSG );
+      return false;
+    }
+  #endif
+  [[maybe_unused]] uint32_t time_start = millis();
+
+  // copy the capture window in one transfer, this is the only part blocking the caller
+  auto frame = new LGFX_Sprite();
+  frame->setPsram( true );
+  frame->setColorDepth( _src->getColorDepth() >= 24 ? 24 : 16 );
+  if( !frame->createSprite( _w, _h ) ) {
+    log_e( "Can't allocate %dx%d framebuffer copy", _w, _h );
+    delete frame;
+    return false;
+  }
+  if( frame->getColorDepth() >= 24 ) _src->readRect( _x, _y, _w, _h, (lgfx::bgr888_t*)frame->getBuffer() );
+  else _src->readRect( _x, _y, _w, _h, (lgfx::swap565_t*)frame->getBuffer() );
+
+  static constexpr const char* extensions[] = { "bmp", "png", "gif", "qoi", "jpg" };
+  genFileName( name, extensions[format] );
+
+  auto job = new ScreenShotAsyncJob_t();
+  job->service    = this;
+  job->format     = format;
+  job->frame      = frame;
+  job->fileSystem = _fileSystem;
+  job->cb         = cb;
+  job->cbArg      = cbArg;
+  job->usePsram   = _psram && psramInit();
+  snprintf( job->fileName, sizeof(job->fileName), "%s", fileName );
+
+  log_v( "Framebuffer copied in %u ms", millis()-time_start );
+
+  _asyncBusy = true;
+  #if portNUM_PROCESSORS > 1
+    const BaseType_t core = xPortGetCoreID() == 0 ? 1 : 0; // encode on the other core
+  #else
+    const BaseType_t core = tskNO_AFFINITY;
+  #endif
+  if( xTaskCreatePinnedToCore( asyncTask, "ScreenShot", SCREENSHOT_ASYNC_STACK_SIZE, job, SCREENSHOT_ASYNC_PRIORITY, NULL, core ) != pdPASS ) {
+    log_e( "Can't create encoder task" );
+    _asyncBusy = false;
+    frame->deleteSprite();
+    delete frame;
+    delete job;
+    return false;
+  }
+  return true;
+}
+
+
 void ScreenShotService::checkFolder( const char* path )
 {
   assert(path);
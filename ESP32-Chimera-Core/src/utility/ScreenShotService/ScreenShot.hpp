@@ -38,6 +38,13 @@
 
 #include "./AVI/AviMjpegEncoder.hpp"
 
+#ifndef SCREENSHOT_ASYNC_STACK_SIZE
+  #define SCREENSHOT_ASYNC_STACK_SIZE 8192 // encoder task stack size (GIF/JPG encoders are stack hungry)
+#endif
+#ifndef SCREENSHOT_ASYNC_PRIORITY
+  #define SCREENSHOT_ASYNC_PRIORITY 1 // keep it low, the encoding should never preempt the UI
+#endif
+
 
 template <typename GFX> // GFX can be either LGFX_Sprite or LGFX_Device
 static void defaultReadRect( void* src, int32_t x, int32_t y, uint32_t w, uint32_t h, uint8_t* buf )
@@ -51,6 +58,22 @@ static void defaultReadRect( void* src, int32_t x, int32_t y, uint32_t w, uint32
 
 
 
+enum ScreenShotFormat_t
+{
+  SCREENSHOT_BMP,
+  SCREENSHOT_PNG,
+  SCREENSHOT_GIF,
+  SCREENSHOT_QOI,
+  SCREENSHOT_JPG // needs <JPEGENC.h>
+};
+
+
+// called from the encoder task when an async snapshot is complete
+typedef void (*ScreenShotCallback_t)( bool success, const char* fileName, size_t fileSize, void* arg );
+
+
+class AviRecorder;
+
 class ScreenShotService
 {
 
@@ -74,6 +97,19 @@ class ScreenShotService
     size_t snapQOI( const char* name = "screenshot", bool displayAfter = false );
     size_t snapQOI( Stream* stream );
 
+    /*\
+     *  Non blocking capture, the caller only waits for the framebuffer copy:
+     *    1) the capture window is copied into a PSRAM sprite using a single readRect (DMA readback when available)
+     *    2) the encoding + filesystem write happen in a task pinned to the other core
+     *    3) the callback is invoked from that task when the file is written
+     *  Only one async snapshot can be pending, snapAsync() returns false while busy.
+     *  Note: the filesystem must be safe to use from another task (e.g. SD sharing the TFT SPI bus needs bus_shared=true)
+     *
+     *  M5.ScreenShot->snapAsync( SCREENSHOT_PNG, "monitor", [](bool ok, const char* path, size_t len, void*) { ... } );
+    \*/
+    bool snapAsync( ScreenShotFormat_t format, const char* name = "screenshot", ScreenShotCallback_t cb = nullptr, void* cbArg = nullptr );
+    bool snapAsyncBusy() { return _asyncBusy; }
+
     #if defined HAS_JPEGENC
       /*\
        *  AVI_Params_t aviparams = new AVI_Params_t( &SD, "/out.avi", fps, use_buffer, use_index_file );
@@ -84,12 +120,20 @@ class ScreenShotService
        *  if( params->ready ) M5.ScreenShot.snapAVI( aviparams, true );  // finalize
       \*/
       void snapAVI( AVI_Params_t *params, bool finalize=false );
+      /*\
+       *  Same usage as snapAVI(), but frames are diffed against the previous one: unchanged frames are
+       *  stored as zero-length chunks, changed frames are encoded and written by a task on the other core.
+       *  See AVI/AviRecorder.hpp.
+      \*/
+      bool recordAVI( AVI_Params_t *params, bool finalize=false );
       void snapJPG( const char* name = "screenshot", bool displayAfter = false );
     #else
       #define TinyJPEG_DEPRECATE_MSG "AVI/JPG capture is disabled, include @bitbanks2's <JPEGENC.h> to enable it"
       [[deprecated(TinyJPEG_DEPRECATE_MSG)]]
       inline void snapAVI( void *params, bool finalize=false ) { log_n(TinyJPEG_DEPRECATE_MSG); };
       [[deprecated(TinyJPEG_DEPRECATE_MSG)]]
+      inline bool recordAVI( void *params, bool finalize=false ) { log_n(TinyJPEG_DEPRECATE_MSG); return false; };
+      [[deprecated(TinyJPEG_DEPRECATE_MSG)]]
       void snapJPG( const char* name = "screenshot", bool displayAfter = false ) { log_n(TinyJPEG_DEPRECATE_MSG); };
     #endif
 
@@ -127,6 +171,17 @@ class ScreenShotService
     void        snapAnimation();
     bool        displayCanReadPixels();
 
+    // encodes a [x,y,w,h] area of the source to a file, returns the file size (0 on failure)
+    static size_t encodeToFile( ScreenShotFormat_t format, LGFX* src, bool is_sprite, fs::FS* fileSystem, const char* path, int32_t x, int32_t y, uint32_t w, uint32_t h, bool usePsram );
+    #if defined HAS_JPEGENC
+      static size_t encodeJPG( LGFX* src, fs::FS* fileSystem, const char* path, int32_t x, int32_t y, uint32_t w, uint32_t h, bool usePsram );
+    #endif
+
+    static void asyncTask( void* param );
+    volatile bool _asyncBusy = false;
+
+    AviRecorder* _aviRecorder = nullptr;
+
     uint8_t*    screenShotBuffer = NULL; // used by AVI and JPG encoders
     uint32_t    screenShotBufSize = 0;
 
@@ -137,4 +192,5 @@ class ScreenShotService
 #include "./PNG/FatPNGEncoder.hpp"
 #include "./GIF/TinyGIFEncoder.hpp"
 #include "./QOI/QOIEncoder.hpp"
+#include "./AVI/AviRecorder.hpp"
 
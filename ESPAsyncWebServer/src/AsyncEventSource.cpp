@@ -152,7 +152,7 @@ size_t AsyncEventSourceMessage::send(AsyncClient *client) {
 // Client
 
 AsyncEventSourceClient::AsyncEventSourceClient(AsyncWebServerRequest *request, AsyncEventSource *server)
-: _messageQueue(LinkedList<AsyncEventSourceMessage *>([](AsyncEventSourceMessage *m){ delete  m; }))
+: _congested(false)
 {
   _client = request->client();
   _server = server;
@@ -184,11 +184,12 @@ void AsyncEventSourceClient::_queueMessage(AsyncEventSourceMessage *dataMessage)
     delete dataMessage;
     return;
   }
-  if(_messageQueue.length() >= SSE_MAX_QUEUED_MESSAGES){
+  if(!_messageQueue.add(dataMessage)){
       ets_printf("ERROR: Too many messages queued\n");
       delete dataMessage;
-  } else {
-      _messageQueue.add(dataMessage);
+      _setCongested(true);
+  } else if(_messageQueue.isFull()){
+      _setCongested(true);
   }
   if(_client->canSend())
     _runQueue();
@@ -198,7 +199,7 @@ void AsyncEventSourceClient::_onAck(size_t len, uint32_t time){
   while(len && !_messageQueue.isEmpty()){
     len = _messageQueue.front()->ack(len, time);
     if(_messageQueue.front()->finished())
-      _messageQueue.remove(_messageQueue.front());
+      _messageQueue.removeFront();
   }
 
   _runQueue();
@@ -226,33 +227,45 @@ void AsyncEventSourceClient::close(){
 }
 
 void AsyncEventSourceClient::write(const char * message, size_t len){
-  _queueMessage(new AsyncEventSourceMessage(message, len));
+  _queueMessage(new (_server->_pool()) AsyncEventSourceMessage(message, len));
 }
 
 void AsyncEventSourceClient::send(const char *message, const char *event, uint32_t id, uint32_t reconnect){
   String ev = generateEventMessage(message, event, id, reconnect);
-  _queueMessage(new AsyncEventSourceMessage(ev.c_str(), ev.length()));
+  _queueMessage(new (_server->_pool()) AsyncEventSourceMessage(ev.c_str(), ev.length()));
 }
 
 void AsyncEventSourceClient::_runQueue(){
   while(!_messageQueue.isEmpty() && _messageQueue.front()->finished()){
-    _messageQueue.remove(_messageQueue.front());
+    _messageQueue.removeFront();
   }
+  if(_congested && _messageQueue.length() <= SSE_MAX_QUEUED_MESSAGES / 2)
+    _setCongested(false);
 
-  for(auto i = _messageQueue.begin(); i != _messageQueue.end(); ++i)
+  for(size_t i = 0; i < _messageQueue.length(); ++i)
   {
-    if(!(*i)->sent())
-      (*i)->send(_client);
+    if(!_messageQueue[i]->sent())
+      _messageQueue[i]->send(_client);
   }
 }
 
+void AsyncEventSourceClient::_setCongested(bool congested){
+  //every fill or drop is reported, the recovery once
+  if(!congested && !_congested)
+    return;
+  _congested = congested;
+  _server->_handleBackpressure(this, congested);
+}
+
 
 // Handler
 
 AsyncEventSource::AsyncEventSource(const String& url)
   : _url(url)
+  , _messagePool(sizeof(AsyncEventSourceMessage), SSE_MESSAGE_POOL_SIZE)
   , _clients(LinkedList<AsyncEventSourceClient *>([](AsyncEventSourceClient *c){ delete c; }))
   , _connectcb(NULL)
+  , _backpressurecb(NULL)
 {}
 
 AsyncEventSource::~AsyncEventSource(){
@@ -263,6 +276,10 @@ void AsyncEventSource::onConnect(ArEventHandlerFunction cb){
   _connectcb = cb;
 }
 
+void AsyncEventSource::onBackpressure(ArBackpressureHandlerFunction cb){
+  _backpressurecb = cb;
+}
+
 void AsyncEventSource::_addClient(AsyncEventSourceClient * client){
   /*char * temp = (char *)malloc(2054);
   if(temp != NULL){
@@ -31,6 +31,7 @@
 #include <ESPAsyncWebServer.h>
 
 #include "AsyncWebSynchronization.h"
+#include "AsyncMessageQueue.h"
 
 #ifdef ESP8266
 #include <Hash.h>
@@ -45,12 +46,17 @@
 #define DEFAULT_MAX_SSE_CLIENTS 4
 #endif
 
+#ifndef SSE_MESSAGE_POOL_SIZE
+#define SSE_MESSAGE_POOL_SIZE (SSE_MAX_QUEUED_MESSAGES * 2)
+#endif
+
 class AsyncEventSource;
 class AsyncEventSourceResponse;
 class AsyncEventSourceClient;
 typedef std::function<void(AsyncEventSourceClient *client)> ArEventHandlerFunction;
+typedef std::function<void(AsyncEventSourceClient *client, bool congested)> ArBackpressureHandlerFunction;
 
-class AsyncEventSourceMessage {
+class AsyncEventSourceMessage: public AsyncPooledObject {
   private:
     uint8_t * _data; 
     size_t _len;
@@ -71,9 +77,11 @@ class AsyncEventSourceClient {
     AsyncClient *_client;
     AsyncEventSource *_server;
     uint32_t _lastId;
-    LinkedList<AsyncEventSourceMessage *> _messageQueue;
+    AsyncRingQueue<AsyncEventSourceMessage *, SSE_MAX_QUEUED_MESSAGES> _messageQueue;
+    bool _congested;
     void _queueMessage(AsyncEventSourceMessage *dataMessage);
     void _runQueue();
+    void _setCongested(bool congested);
 
   public:
 
@@ -98,8 +106,10 @@ class AsyncEventSourceClient {
 class AsyncEventSource: public AsyncWebHandler {
   private:
     String _url;
+    AsyncMessagePool _messagePool; //before _clients, the queued messages go back to it
     LinkedList<AsyncEventSourceClient *> _clients;
     ArEventHandlerFunction _connectcb;
+    ArBackpressureHandlerFunction _backpressurecb;
   public:
     AsyncEventSource(const String& url);
     ~AsyncEventSource();
@@ -107,6 +117,8 @@ class AsyncEventSource: public AsyncWebHandler {
     const char * url() const { return _url.c_str(); }
     void close();
     void onConnect(ArEventHandlerFunction cb);
+    //called with true when a client queue fills up or drops a message, with false once it has drained to half
+    void onBackpressure(ArBackpressureHandlerFunction cb);
     void send(const char *message, const char *event=NULL, uint32_t id=0, uint32_t reconnect=0);
     size_t count() const; //number clinets connected
     size_t  avgPacketsWaiting() const;
@@ -114,7 +126,15 @@ class AsyncEventSource: public AsyncWebHandler {
     //system callbacks (do not call)
     void _addClient(AsyncEventSourceClient * client);
     void _handleDisconnect(AsyncEventSourceClient * client);
+    void _handleBackpressure(AsyncEventSourceClient * client, bool congested){ if(_backpressurecb) _backpressurecb(client, congested); }
+    AsyncMessagePool * _pool(){ return &_messagePool; }
     virtual bool canHandle(AsyncWebServerRequest *request) override final;
+    virtual bool route(String& path, WebRouteType& type, WebRequestMethodComposite& method) const override final {
+      path = _url;
+      type = ROUTE_EXACT;
+      method = HTTP_GET;
+      return true;
+    }
     virtual void handleRequest(AsyncWebServerRequest *request) override final;
 };
 
@@ -77,6 +77,266 @@ class ChunkPrint : public Print {
     }
 };
 
+#ifndef ARDUINOJSON_5_COMPATIBILITY
+#ifndef ASYNC_JSON_SERIALIZER_DEPTH
+  #define ASYNC_JSON_SERIALIZER_DEPTH ARDUINOJSON_DEFAULT_NESTING_LIMIT
+#endif
+
+/*
+ * Resumable serializer, every write() continues where the previous one stopped.
+ * Writes the same bytes as serializeJson() / serializeJsonPretty(); values nested
+ * deeper than ASYNC_JSON_SERIALIZER_DEPTH are written compact, as one token
+ * */
+
+class AsyncJsonSerializer {
+  private:
+    enum { TOKEN_NONE, TOKEN_TEXT, TOKEN_INDENT, TOKEN_STRING, TOKEN_VALUE };
+    enum { NEXT_VALUE, NEXT_ITEM, NEXT_KEY, NEXT_COLON, NEXT_SEPARATOR, NEXT_CLOSE_INDENT, NEXT_CLOSE, NEXT_DONE };
+
+    struct Frame {
+      JsonVariantConst container;
+      JsonArrayConstIterator item;
+      JsonObjectConstIterator member;
+    };
+
+    JsonVariantConst _root;
+    bool _pretty;
+    Frame _stack[ASYNC_JSON_SERIALIZER_DEPTH];
+    uint8_t _depth;
+    uint8_t _next;
+    JsonVariantConst _value;  //what NEXT_VALUE writes, then the current value token
+    uint8_t _token;
+    const char * _text;
+    JsonString _string;
+    size_t _length;           //text, indent and value tokens
+    size_t _offset;           //bytes of the token written, characters for strings
+    uint8_t _escaped;         //bytes of the current escape sequence written
+
+    void _setText(const char * text){
+      _token = TOKEN_TEXT;
+      _text = text;
+      _length = strlen(text);
+    }
+
+    void _setIndent(uint8_t depth){
+      if(!_pretty || !depth)
+        return;
+      _token = TOKEN_INDENT;
+      _length = depth * strlen(ARDUINOJSON_TAB);
+    }
+
+    void _setString(JsonString string){
+      _token = TOKEN_STRING;
+      _string = string;
+      _escaped = 0;
+    }
+
+    bool _isEnd(const Frame& f) const {
+      if(f.container.is<JsonObjectConst>())
+        return f.member == f.container.as<JsonObjectConst>().end();
+      return f.item == f.container.as<JsonArrayConst>().end();
+    }
+
+    void _step(){
+      if(_next == NEXT_VALUE){
+        _next = NEXT_SEPARATOR;
+        if(_depth < ASYNC_JSON_SERIALIZER_DEPTH && _value.is<JsonObjectConst>()){
+          JsonObjectConst object = _value.as<JsonObjectConst>();
+          if(object.begin() == object.end())
+            return _setText("{}");
+          _stack[_depth].container = _value;
+          _stack[_depth].member = object.begin();
+          _depth++;
+          _next = NEXT_ITEM;
+          return _setText(_pretty ? "{\r\n" : "{");
+        }
+        if(_depth < ASYNC_JSON_SERIALIZER_DEPTH && _value.is<JsonArrayConst>()){
+          JsonArrayConst array = _value.as<JsonArrayConst>();
+          if(array.begin() == array.end())
+            return _setText("[]");
+          _stack[_depth].container = _value;
+          _stack[_depth].item = array.begin();
+          _depth++;
+          _next = NEXT_ITEM;
+          return _setText(_pretty ? "[\r\n" : "[");
+        }
+        if(_value.is<JsonString>())
+          return _setString(_value.as<JsonString>());
+        _token = TOKEN_VALUE;
+        _length = measureJson(_value);
+        return;
+      }
+      if(!_depth){
+        _next = NEXT_DONE;
+        return;
+      }
+      Frame& f = _stack[_depth - 1];
+      if(_next == NEXT_ITEM){
+        if(f.container.is<JsonObjectConst>()){
+          _next = NEXT_KEY;
+        } else {
+          _value = *f.item;
+          _next = NEXT_VALUE;
+        }
+        return _setIndent(_depth);
+      }
+      if(_next == NEXT_KEY){
+        _next = NEXT_COLON;
+        return _setString((*f.member).key());
+      }
+      if(_next == NEXT_COLON){
+        _value = (*f.member).value();
+        _next = NEXT_VALUE;
+        return _setText(_pretty ? ": " : ":");
+      }
+      if(_next == NEXT_SEPARATOR){
+        if(f.container.is<JsonObjectConst>())
+          ++f.member;
+        else
+          ++f.item;
+        if(!_isEnd(f)){
+          _next = NEXT_ITEM;
+          return _setText(_pretty ? ",\r\n" : ",");
+        }
+        _next = NEXT_CLOSE_INDENT;
+        if(_pretty)
+          _setText("\r\n");
+        return;
+      }
+      if(_next == NEXT_CLOSE_INDENT){
+        _next = NEXT_CLOSE;
+        return _setIndent(_depth - 1);
+      }
+      //NEXT_CLOSE
+      _setText(f.container.is<JsonObjectConst>() ? "}" : "]");
+      _depth--;
+      _next = NEXT_SEPARATOR;
+    }
+
+    static uint8_t _escape(char c, char * seq){
+      char e = 0;
+      switch(c){
+        case '"':  e = '"'; break;
+        case '\\': e = '\\'; break;
+        case '\b': e = 'b'; break;
+        case '\f': e = 'f'; break;
+        case '\n': e = 'n'; break;
+        case '\r': e = 'r'; break;
+        case '\t': e = 't'; break;
+        case 0:
+          memcpy(seq, "\\u0000", 6);
+          return 6;
+        default:
+          seq[0] = c;
+          return 1;
+      }
+      seq[0] = '\\';
+      seq[1] = e;
+      return 2;
+    }
+
+    size_t _writeString(uint8_t * data, size_t len){
+      //_offset 0 is the opening quote, then the characters, then the closing quote
+      size_t n = 0;
+      const char * s = _string.c_str();
+      while(n < len){
+        if(_offset == 0){
+          data[n++] = '"';
+          _offset++;
+          continue;
+        }
+        size_t i = _offset - 1;
+        if(i == _string.size()){
+          data[n++] = '"';
+          _token = TOKEN_NONE;
+          break;
+        }
+        char seq[6];
+        uint8_t l = _escape(s[i], seq);
+        while(_escaped < l && n < len)
+          data[n++] = seq[_escaped++];
+        if(_escaped == l){
+          _escaped = 0;
+          _offset++;
+        }
+      }
+      return n;
+    }
+
+    size_t _writeToken(uint8_t * data, size_t len){
+      if(_token == TOKEN_STRING){
+        size_t n = _writeString(data, len);
+        if(_token == TOKEN_NONE)
+          _offset = 0;
+        return n;
+      }
+      size_t n = _length - _offset;
+      if(n > len)
+        n = len;
+      if(_token == TOKEN_TEXT){
+        memcpy(data, _text + _offset, n);
+      } else if(_token == TOKEN_INDENT){
+        const size_t tab = strlen(ARDUINOJSON_TAB);
+        for(size_t i = 0; i < n; i++)
+          data[i] = ARDUINOJSON_TAB[(_offset + i) % tab];
+      } else {
+        //numbers, booleans, null and raw values are short, write them skipping what was sent
+        ChunkPrint dest(data, _offset, n);
+        serializeJson(_value, dest);
+      }
+      _offset += n;
+      if(_offset == _length){
+        _token = TOKEN_NONE;
+        _offset = 0;
+      }
+      return n;
+    }
+
+  public:
+    AsyncJsonSerializer() : _pretty(false), _depth(0), _next(NEXT_DONE), _token(TOKEN_NONE), _text(NULL), _length(0), _offset(0), _escaped(0) {}
+
+    void begin(JsonVariantConst root, bool pretty = false){
+      _root = root;
+      _pretty = pretty;
+      _depth = 0;
+      _value = root;
+      _next = NEXT_VALUE;
+      _token = TOKEN_NONE;
+      _offset = 0;
+      _escaped = 0;
+    }
+
+    bool done(){
+      while(_token == TOKEN_NONE){
+        if(_next == NEXT_DONE)
+          return true;
+        _step();
+      }
+      return false;
+    }
+
+    //fills up to len bytes, less only at the end of the document
+    size_t write(uint8_t * data, size_t len){
+      size_t n = 0;
+      while(n < len && !done())
+        n += _writeToken(data + n, len - n);
+      return n;
+    }
+
+    //total length of the document, starts over afterwards
+    size_t measure(){
+      uint8_t scratch[64];
+      size_t total = 0;
+      size_t n;
+      begin(_root, _pretty);
+      while((n = write(scratch, sizeof(scratch))) > 0)
+        total += n;
+      begin(_root, _pretty);
+      return total;
+    }
+};
+#endif
+
 class AsyncJsonResponse: public AsyncAbstractResponse {
   protected:
 
@@ -88,6 +348,10 @@ class AsyncJsonResponse: public AsyncAbstractResponse {
 
     JsonVariant _root;
     bool _isValid;
+#ifndef ARDUINOJSON_5_COMPATIBILITY
+    bool _pretty;
+    AsyncJsonSerializer _serializer;
+#endif
 
   public:    
 
@@ -101,7 +365,7 @@ class AsyncJsonResponse: public AsyncAbstractResponse {
         _root = _jsonBuffer.createObject();
     }
 #else
-    AsyncJsonResponse(bool isArray=false, size_t maxJsonBufferSize = DYNAMIC_JSON_DOCUMENT_SIZE) : _jsonBuffer(maxJsonBufferSize), _isValid{false} {
+    AsyncJsonResponse(bool isArray=false, size_t maxJsonBufferSize = DYNAMIC_JSON_DOCUMENT_SIZE) : _jsonBuffer(maxJsonBufferSize), _isValid{false}, _pretty{false} {
       _code = 200;
       _contentType = JSON_MIMETYPE;
       if(isArray)
@@ -119,7 +383,8 @@ class AsyncJsonResponse: public AsyncAbstractResponse {
 #ifdef ARDUINOJSON_5_COMPATIBILITY      
       _contentLength = _root.measureLength();
 #else
-      _contentLength = measureJson(_root);
+      _serializer.begin(_root, _pretty);
+      _contentLength = _serializer.measure();
 #endif
 
       if (_contentLength) { _isValid = true; }
@@ -129,14 +394,13 @@ class AsyncJsonResponse: public AsyncAbstractResponse {
    size_t getSize() { return _jsonBuffer.size(); }
 
     size_t _fillBuffer(uint8_t *data, size_t len){
-      ChunkPrint dest(data, _sentLength, len);
-
 #ifdef ARDUINOJSON_5_COMPATIBILITY      
+      ChunkPrint dest(data, _sentLength, len);
       _root.printTo( dest ) ;
+      return len;
 #else
-      serializeJson(_root, dest);
+      return _serializer.write(data, len);
 #endif
-      return len;
     }
 };
 
@@ -144,27 +408,19 @@ class PrettyAsyncJsonResponse: public AsyncJsonResponse {
 public:
 #ifdef ARDUINOJSON_5_COMPATIBILITY
 	PrettyAsyncJsonResponse (bool isArray=false) : AsyncJsonResponse{isArray} {}
-#else
-	PrettyAsyncJsonResponse (bool isArray=false, size_t maxJsonBufferSize = DYNAMIC_JSON_DOCUMENT_SIZE) : AsyncJsonResponse{isArray, maxJsonBufferSize} {}
-#endif
 	size_t setLength () {
-#ifdef ARDUINOJSON_5_COMPATIBILITY
 		_contentLength = _root.measurePrettyLength ();
-#else
-		_contentLength = measureJsonPretty(_root);
-#endif
 		if (_contentLength) {_isValid = true;}
 		return _contentLength;
 	}
 	size_t _fillBuffer (uint8_t *data, size_t len) {
 		ChunkPrint dest (data, _sentLength, len);
-#ifdef ARDUINOJSON_5_COMPATIBILITY
 		_root.prettyPrintTo (dest);
-#else
-		serializeJsonPretty(_root, dest);
-#endif
 		return len;
 	}
+#else
+	PrettyAsyncJsonResponse (bool isArray=false, size_t maxJsonBufferSize = DYNAMIC_JSON_DOCUMENT_SIZE) : AsyncJsonResponse{isArray, maxJsonBufferSize} { _pretty = true; }
+#endif
 };
 
 typedef std::function<void(AsyncWebServerRequest *request, JsonVariant &json)> ArJsonRequestHandlerFunction;
@@ -210,6 +466,13 @@ public:
     return true;
   }
 
+  virtual bool route(String& path, WebRouteType& type, WebRequestMethodComposite& method) const override final {
+    path = _uri;
+    type = _uri.length() ? ROUTE_SEGMENT : ROUTE_PREFIX;
+    method = _method;
+    return true;
+  }
+
   virtual void handleRequest(AsyncWebServerRequest *request) override final {
     if(_onRequest) {
       if (request->_tempObject != NULL) {
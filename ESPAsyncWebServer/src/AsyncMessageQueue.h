@@ -0,0 +1,167 @@
+/*
+  Asynchronous WebServer library for Espressif MCUs
+
+  Copyright (c) 2016 Hristo Gochkov. All rights reserved.
+  This file is part of the esp8266 core for Arduino environment.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#ifndef ASYNCMESSAGEQUEUE_H_
+#define ASYNCMESSAGEQUEUE_H_
+
+#include <stdlib.h>
+#include "AsyncWebSynchronization.h"
+
+/*
+ * Fixed capacity FIFO of message pointers, the messages are deleted when removed
+ */
+template <typename T, size_t N>
+class AsyncRingQueue {
+  private:
+    T _items[N];
+    size_t _head;
+    size_t _count;
+
+  public:
+    AsyncRingQueue() : _head(0), _count(0) {}
+    ~AsyncRingQueue(){ free(); }
+
+    static size_t capacity(){ return N; }
+    size_t length() const { return _count; }
+    bool isEmpty() const { return _count == 0; }
+    bool isFull() const { return _count == N; }
+
+    T& front(){ return _items[_head]; }
+    //i-th item from the front
+    T& operator[](size_t i){ return _items[(_head + i) % N]; }
+
+    bool add(const T& t){
+      if(_count == N)
+        return false;
+      _items[(_head + _count) % N] = t;
+      _count++;
+      return true;
+    }
+    void removeFront(){
+      if(!_count)
+        return;
+      delete _items[_head];
+      _head = (_head + 1) % N;
+      _count--;
+    }
+    void free(){
+      while(_count)
+        removeFront();
+      _head = 0;
+    }
+};
+
+/*
+ * Fixed size slots for the message objects of one server, taken with new (&pool) Message(...).
+ * Objects that don't fit, or come when the pool is empty, are malloced instead; either
+ * way a plain delete returns them where they came from (see AsyncPooledObject)
+ */
+class AsyncMessagePool {
+  private:
+    struct Header {
+      AsyncMessagePool * pool;  //NULL when malloced
+      Header * next;            //free list, while the slot is unused
+    };
+    static size_t _align(size_t size){ return (size + 7) & ~(size_t)7; }
+    static size_t _headerSize(){ return _align(sizeof(Header)); }
+
+    size_t _slotSize;
+    size_t _slots;
+    size_t _used;
+    uint8_t * _block;
+    Header * _free;
+    AsyncWebLock _lock;
+
+    bool _begin(){
+      size_t stride = _headerSize() + _slotSize;
+      _block = (uint8_t *)malloc(stride * _slots);
+      if(!_block)
+        return false;
+      _free = NULL;
+      for(size_t i = _slots; i > 0; i--){
+        Header * h = (Header *)(_block + (i - 1) * stride);
+        h->pool = this;
+        h->next = _free;
+        _free = h;
+      }
+      return true;
+    }
+
+  public:
+    AsyncMessagePool(size_t slotSize, size_t slots)
+      : _slotSize(_align(slotSize)), _slots(slots), _used(0), _block(NULL), _free(NULL) {}
+    ~AsyncMessagePool(){
+      //objects still out would come back to freed memory, keep the block then
+      if(!_used)
+        ::free(_block);
+    }
+
+    void * allocate(size_t size){
+      if(size <= _slotSize){
+        AsyncWebLockGuard l(_lock);
+        if(_block || _begin()){
+          Header * h = _free;
+          if(h){
+            _free = h->next;
+            _used++;
+            return (uint8_t *)h + _headerSize();
+          }
+        }
+      }
+      return allocateHeap(size);
+    }
+
+    static void * allocateHeap(size_t size){
+      Header * h = (Header *)malloc(_headerSize() + size);
+      if(!h)
+        return NULL;
+      h->pool = NULL;
+      return (uint8_t *)h + _headerSize();
+    }
+
+    static void release(void * p){
+      if(!p)
+        return;
+      Header * h = (Header *)((uint8_t *)p - _headerSize());
+      AsyncMessagePool * pool = h->pool;
+      if(!pool){
+        ::free(h);
+        return;
+      }
+      AsyncWebLockGuard l(pool->_lock);
+      h->next = pool->_free;
+      pool->_free = h;
+      pool->_used--;
+    }
+
+    size_t used() const { return _used; }
+};
+
+/*
+ * Base of the message classes, new and delete go through AsyncMessagePool
+ */
+struct AsyncPooledObject {
+  static void * operator new(size_t size) noexcept { return AsyncMessagePool::allocateHeap(size); }
+  static void * operator new(size_t size, AsyncMessagePool * pool) noexcept { return pool ? pool->allocate(size) : AsyncMessagePool::allocateHeap(size); }
+  static void operator delete(void * p){ AsyncMessagePool::release(p); }
+  static void operator delete(void * p, AsyncMessagePool * pool){ (void)pool; AsyncMessagePool::release(p); }
+};
+
+#endif /* ASYNCMESSAGEQUEUE_H_ */
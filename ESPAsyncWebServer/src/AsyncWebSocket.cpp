@@ -241,7 +241,7 @@ bool AsyncWebSocketMessageBuffer::reserve(size_t size)
  * Control Frame
  */
 
-class AsyncWebSocketControl {
+class AsyncWebSocketControl: public AsyncPooledObject {
   private:
     uint8_t _opcode;
     uint8_t *_data;
@@ -468,6 +468,59 @@ AsyncWebSocketMultiMessage::~AsyncWebSocketMultiMessage() {
 }
 
 
+/*
+ * AsyncWebSocketFramedMessage Message
+ */
+
+
+AsyncWebSocketFramedMessage::AsyncWebSocketFramedMessage(AsyncWebSocketMessageBuffer * frame)
+  :_data(nullptr)
+  ,_len(0)
+  ,_sent(0)
+  ,_acked(0)
+  ,_WSbuffer(nullptr)
+{
+  if (frame) {
+    _WSbuffer = frame;
+    (*_WSbuffer)++;
+    _data = frame->get();
+    _len = frame->length();
+    _status = WS_MSG_SENDING;
+  } else {
+    _status = WS_MSG_ERROR;
+  }
+}
+
+AsyncWebSocketFramedMessage::~AsyncWebSocketFramedMessage() {
+  if (_WSbuffer) {
+    (*_WSbuffer)--; // decreases the counter.
+  }
+}
+
+void AsyncWebSocketFramedMessage::ack(size_t len, uint32_t time)  {
+  (void)time;
+  _acked += len;
+  if(_sent >= _len && _acked >= _len){
+    _status = WS_MSG_SENT;
+  }
+}
+
+size_t AsyncWebSocketFramedMessage::send(AsyncClient *client)  {
+  if(_status != WS_MSG_SENDING || _sent >= _len)
+    return 0;
+  size_t toSend = _len - _sent;
+  size_t space = client->space();
+  if(space < toSend)
+    toSend = space;
+  //the frame is complete already, it is passed on by reference in as many pieces as the window takes
+  size_t sent = client->add((const char *)(_data + _sent), toSend, 0);
+  if(!sent || !client->send())
+    return 0;
+  _sent += sent;
+  return sent;
+}
+
+
 /*
  * Async WebSocket Client
  */
@@ -475,8 +528,7 @@ AsyncWebSocketMultiMessage::~AsyncWebSocketMultiMessage() {
  const size_t AWSC_PING_PAYLOAD_LEN = 22;
 
 AsyncWebSocketClient::AsyncWebSocketClient(AsyncWebServerRequest *request, AsyncWebSocket *server)
-  : _controlQueue(LinkedList<AsyncWebSocketControl *>([](AsyncWebSocketControl *c){ delete  c; }))
-  , _messageQueue(LinkedList<AsyncWebSocketMessage *>([](AsyncWebSocketMessage *m){ delete  m; }))
+  : _congested(false)
   , _tempObject(NULL)
 {
   _client = request->client();
@@ -511,12 +563,12 @@ void AsyncWebSocketClient::_onAck(size_t len, uint32_t time){
     if(head->finished()){
       len -= head->len();
       if(_status == WS_DISCONNECTING && head->opcode() == WS_DISCONNECT){
-        _controlQueue.remove(head);
+        _controlQueue.removeFront();
         _status = WS_DISCONNECTED;
         _client->close(true);
         return;
       }
-      _controlQueue.remove(head);
+      _controlQueue.removeFront();
     }
   }
   if(len && !_messageQueue.isEmpty()){
@@ -536,10 +588,12 @@ void AsyncWebSocketClient::_onPoll(){
 
 void AsyncWebSocketClient::_runQueue(){
   while(!_messageQueue.isEmpty() && _messageQueue.front()->finished()){
-    _messageQueue.remove(_messageQueue.front());
+    _messageQueue.removeFront();
   }
+  if(_congested && _messageQueue.length() <= WS_MAX_QUEUED_MESSAGES / 2)
+    _setCongested(false);
 
-  if(!_controlQueue.isEmpty() && (_messageQueue.isEmpty() || _messageQueue.front()->betweenFrames()) && webSocketSendFrameWindow(_client) > (size_t)(_controlQueue.front()->len() - 1)){
+  if(!_controlQueue.isEmpty() && (_messageQueue.isEmpty() || (_messageQueue.front()->betweenFrames() && !_messageQueue.front()->inFrame())) && webSocketSendFrameWindow(_client) > (size_t)(_controlQueue.front()->len() - 1)){
     _controlQueue.front()->send(_client);
   } else if(!_messageQueue.isEmpty() && _messageQueue.front()->betweenFrames() && webSocketSendFrameWindow(_client)){
     _messageQueue.front()->send(_client);
@@ -558,11 +612,12 @@ void AsyncWebSocketClient::_queueMessage(AsyncWebSocketMessage *dataMessage){
     delete dataMessage;
     return;
   }
-  if(_messageQueue.length() >= WS_MAX_QUEUED_MESSAGES){
+  if(!_messageQueue.add(dataMessage)){
       ets_printf("ERROR: Too many messages queued\n");
       delete dataMessage;
-  } else {
-      _messageQueue.add(dataMessage);
+      _setCongested(true);
+  } else if(_messageQueue.isFull()){
+      _setCongested(true);
   }
   if(_client->canSend())
     _runQueue();
@@ -571,11 +626,26 @@ void AsyncWebSocketClient::_queueMessage(AsyncWebSocketMessage *dataMessage){
 void AsyncWebSocketClient::_queueControl(AsyncWebSocketControl *controlMessage){
   if(controlMessage == NULL)
     return;
-  _controlQueue.add(controlMessage);
+  if(!_controlQueue.add(controlMessage)){
+    ets_printf("ERROR: Too many control messages queued\n");
+    bool closing = controlMessage->opcode() == WS_DISCONNECT;
+    delete controlMessage;
+    if(closing)
+      _client->close(true);
+    return;
+  }
   if(_client->canSend())
     _runQueue();
 }
 
+void AsyncWebSocketClient::_setCongested(bool congested){
+  //every fill or drop is reported, the recovery once
+  if(!congested && !_congested)
+    return;
+  _congested = congested;
+  _server->_handleBackpressure(this, congested);
+}
+
 void AsyncWebSocketClient::close(uint16_t code, const char * message){
   if(_status != WS_CONNECTED)
     return;
@@ -593,17 +663,17 @@ void AsyncWebSocketClient::close(uint16_t code, const char * message){
       if(message != NULL){
         memcpy(buf+2, message, packetLen -2);
       }
-      _queueControl(new AsyncWebSocketControl(WS_DISCONNECT,(uint8_t*)buf,packetLen));
+      _queueControl(new (_server->_pool()) AsyncWebSocketControl(WS_DISCONNECT,(uint8_t*)buf,packetLen));
       free(buf);
       return;
     }
   }
-  _queueControl(new AsyncWebSocketControl(WS_DISCONNECT));
+  _queueControl(new (_server->_pool()) AsyncWebSocketControl(WS_DISCONNECT));
 }
 
 void AsyncWebSocketClient::ping(uint8_t *data, size_t len){
   if(_status == WS_CONNECTED)
-    _queueControl(new AsyncWebSocketControl(WS_PING, data, len));
+    _queueControl(new (_server->_pool()) AsyncWebSocketControl(WS_PING, data, len));
 }
 
 void AsyncWebSocketClient::_onError(int8_t){}
@@ -684,10 +754,10 @@ void AsyncWebSocketClient::_onData(void *pbuf, size_t plen){
         } else {
           _status = WS_DISCONNECTING;
           _client->ackLater();
-          _queueControl(new AsyncWebSocketControl(WS_DISCONNECT, data, datalen));
+          _queueControl(new (_server->_pool()) AsyncWebSocketControl(WS_DISCONNECT, data, datalen));
         }
       } else if(_pinfo.opcode == WS_PING){
-        _queueControl(new AsyncWebSocketControl(WS_PONG, data, datalen));
+        _queueControl(new (_server->_pool()) AsyncWebSocketControl(WS_PONG, data, datalen));
       } else if(_pinfo.opcode == WS_PONG){
         if(datalen != AWSC_PING_PAYLOAD_LEN || memcmp(AWSC_PING_PAYLOAD, data, AWSC_PING_PAYLOAD_LEN) != 0)
           _server->_handleEvent(this, WS_EVT_PONG, NULL, data, datalen);
@@ -772,7 +842,7 @@ size_t AsyncWebSocketClient::printf_P(PGM_P formatP, ...) {
 #endif
 
 void AsyncWebSocketClient::text(const char * message, size_t len){
-  _queueMessage(new AsyncWebSocketBasicMessage(message, len));
+  _queueMessage(new (_server->_pool()) AsyncWebSocketBasicMessage(message, len));
 }
 void AsyncWebSocketClient::text(const char * message){
   text(message, strlen(message));
@@ -804,11 +874,11 @@ void AsyncWebSocketClient::text(const __FlashStringHelper *data){
 }
 void AsyncWebSocketClient::text(AsyncWebSocketMessageBuffer * buffer)
 {
-  _queueMessage(new AsyncWebSocketMultiMessage(buffer));
+  _queueMessage(new (_server->_pool()) AsyncWebSocketMultiMessage(buffer));
 }
 
 void AsyncWebSocketClient::binary(const char * message, size_t len){
-  _queueMessage(new AsyncWebSocketBasicMessage(message, len, WS_BINARY));
+  _queueMessage(new (_server->_pool()) AsyncWebSocketBasicMessage(message, len, WS_BINARY));
 }
 void AsyncWebSocketClient::binary(const char * message){
   binary(message, strlen(message));
@@ -835,7 +905,7 @@ void AsyncWebSocketClient::binary(const __FlashStringHelper *data, size_t len){
 }
 void AsyncWebSocketClient::binary(AsyncWebSocketMessageBuffer * buffer)
 {
-  _queueMessage(new AsyncWebSocketMultiMessage(buffer, WS_BINARY));
+  _queueMessage(new (_server->_pool()) AsyncWebSocketMultiMessage(buffer, WS_BINARY));
 }
 
 IPAddress AsyncWebSocketClient::remoteIP() {
@@ -858,14 +928,20 @@ uint16_t AsyncWebSocketClient::remotePort() {
  * Async Web Socket - Each separate socket location
  */
 
+//one slot fits any of the message classes queued by the server
+template <typename A, typename B> struct _wsMaxSize { static const size_t value = sizeof(A) > sizeof(B) ? sizeof(A) : sizeof(B); };
+static const size_t WS_MESSAGE_SLOT_SIZE = _wsMaxSize<_wsMaxSize<AsyncWebSocketBasicMessage, AsyncWebSocketMultiMessage>, _wsMaxSize<AsyncWebSocketFramedMessage, AsyncWebSocketControl> >::value;
+
 AsyncWebSocket::AsyncWebSocket(const String& url)
   :_url(url)
+  ,_messagePool(WS_MESSAGE_SLOT_SIZE, WS_MESSAGE_POOL_SIZE)
   ,_clients(LinkedList<AsyncWebSocketClient *>([](AsyncWebSocketClient *c){ delete c; }))
   ,_cNextId(1)
   ,_enabled(true)
   ,_buffers(LinkedList<AsyncWebSocketMessageBuffer *>([](AsyncWebSocketMessageBuffer *b){ delete b; }))
 {
   _eventHandler = NULL;
+  _backpressureHandler = NULL;
 }
 
 AsyncWebSocket::~AsyncWebSocket(){}
@@ -1011,6 +1087,38 @@ void AsyncWebSocket::messageAll(AsyncWebSocketMultiMessage *message){
   _cleanBuffers(); 
 }
 
+void AsyncWebSocket::broadcast(const char * message, size_t len, uint8_t opcode){
+  //server frames are not masked
+  uint8_t headLen = (len < 126) ? 2 : (len < 0x10000) ? 4 : 10;
+  AsyncWebSocketMessageBuffer * frame = makeBuffer(headLen + len);
+  if (!frame || !frame->get()) return;
+  uint8_t * buf = frame->get();
+  buf[0] = 0x80 | (opcode & 0x0F);
+  if(len < 126){
+    buf[1] = len;
+  } else if(len < 0x10000){
+    buf[1] = 126;
+    buf[2] = (uint8_t)((len >> 8) & 0xFF);
+    buf[3] = (uint8_t)(len & 0xFF);
+  } else {
+    buf[1] = 127;
+    for(uint8_t i = 0; i < 8; i++)
+      buf[9 - i] = (uint8_t)(((uint64_t)len >> (8 * i)) & 0xFF);
+  }
+  memcpy(buf + headLen, message, len);
+  frame->lock();
+  for(const auto& c: _clients){
+    if(c->status() == WS_CONNECTED)
+      c->message(new (&_messagePool) AsyncWebSocketFramedMessage(frame));
+  }
+  frame->unlock();
+  _cleanBuffers();
+}
+
+void AsyncWebSocket::broadcast(const String &message, uint8_t opcode){
+  broadcast(message.c_str(), message.length(), opcode);
+}
+
 size_t AsyncWebSocket::printf(uint32_t id, const char *format, ...){
   AsyncWebSocketClient * c = client(id);
   if(c){
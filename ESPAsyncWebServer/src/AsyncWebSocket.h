@@ -25,13 +25,20 @@
 #ifdef ESP32
 #include <AsyncTCP.h>
 #define WS_MAX_QUEUED_MESSAGES 32
+#define WS_MAX_QUEUED_CONTROLS 8
 #else
 #include <ESPAsyncTCP.h>
 #define WS_MAX_QUEUED_MESSAGES 8
+#define WS_MAX_QUEUED_CONTROLS 4
 #endif
 #include <ESPAsyncWebServer.h>
 
 #include "AsyncWebSynchronization.h"
+#include "AsyncMessageQueue.h"
+
+#ifndef WS_MESSAGE_POOL_SIZE
+#define WS_MESSAGE_POOL_SIZE (WS_MAX_QUEUED_MESSAGES * 2)
+#endif
 
 #ifdef ESP8266
 #include <Hash.h>
@@ -108,7 +115,7 @@ class AsyncWebSocketMessageBuffer {
 
 };
 
-class AsyncWebSocketMessage {
+class AsyncWebSocketMessage: public AsyncPooledObject {
   protected:
     uint8_t _opcode;
     bool _mask;
@@ -120,6 +127,7 @@ class AsyncWebSocketMessage {
     virtual size_t send(AsyncClient *client __attribute__((unused))){ return 0; }
     virtual bool finished(){ return _status != WS_MSG_SENDING; }
     virtual bool betweenFrames() const { return false; }
+    virtual bool inFrame() const { return false; } // part of a frame is sent, no control frame may go in between
 };
 
 class AsyncWebSocketBasicMessage: public AsyncWebSocketMessage {
@@ -154,6 +162,24 @@ public:
     virtual size_t send(AsyncClient *client) override ;
 };
 
+// One complete, unmasked server frame in a shared buffer, made once by AsyncWebSocket::broadcast()
+// and passed to the TCP client by reference, the buffer is held until the frame is acked
+class AsyncWebSocketFramedMessage: public AsyncWebSocketMessage {
+  private:
+    uint8_t * _data;
+    size_t _len;
+    size_t _sent;
+    size_t _acked;
+    AsyncWebSocketMessageBuffer * _WSbuffer;
+public:
+    AsyncWebSocketFramedMessage(AsyncWebSocketMessageBuffer * frame);
+    virtual ~AsyncWebSocketFramedMessage() override;
+    virtual bool betweenFrames() const override { return true; }
+    virtual bool inFrame() const override { return _sent > 0 && _sent < _len; }
+    virtual void ack(size_t len, uint32_t time) override ;
+    virtual size_t send(AsyncClient *client) override ;
+};
+
 class AsyncWebSocketClient {
   private:
     AsyncClient *_client;
@@ -161,8 +187,9 @@ class AsyncWebSocketClient {
     uint32_t _clientId;
     AwsClientStatus _status;
 
-    LinkedList<AsyncWebSocketControl *> _controlQueue;
-    LinkedList<AsyncWebSocketMessage *> _messageQueue;
+    AsyncRingQueue<AsyncWebSocketControl *, WS_MAX_QUEUED_CONTROLS> _controlQueue;
+    AsyncRingQueue<AsyncWebSocketMessage *, WS_MAX_QUEUED_MESSAGES> _messageQueue;
+    bool _congested;
 
     uint8_t _pstate;
     AwsFrameInfo _pinfo;
@@ -173,6 +200,7 @@ class AsyncWebSocketClient {
     void _queueMessage(AsyncWebSocketMessage *dataMessage);
     void _queueControl(AsyncWebSocketControl *controlMessage);
     void _runQueue();
+    void _setCongested(bool congested);
 
   public:
     void *_tempObject;
@@ -238,6 +266,7 @@ class AsyncWebSocketClient {
 };
 
 typedef std::function<void(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)> AwsEventHandler;
+typedef std::function<void(AsyncWebSocketClient * client, bool congested)> AwsBackpressureHandler;
 
 //WebServer Handler implementation that plays the role of a socket server
 class AsyncWebSocket: public AsyncWebHandler {
@@ -245,9 +274,11 @@ class AsyncWebSocket: public AsyncWebHandler {
     typedef LinkedList<AsyncWebSocketClient *> AsyncWebSocketClientLinkedList;
   private:
     String _url;
+    AsyncMessagePool _messagePool; //before _clients, the queued messages go back to it
     AsyncWebSocketClientLinkedList _clients;
     uint32_t _cNextId;
     AwsEventHandler _eventHandler;
+    AwsBackpressureHandler _backpressureHandler;
     bool _enabled;
     AsyncWebLock _lock;
 
@@ -304,6 +335,10 @@ class AsyncWebSocket: public AsyncWebHandler {
     void message(uint32_t id, AsyncWebSocketMessage *message);
     void messageAll(AsyncWebSocketMultiMessage *message);
 
+    //frame once and send the same buffer to every client, without per client copies
+    void broadcast(const char * message, size_t len, uint8_t opcode=WS_TEXT);
+    void broadcast(const String &message, uint8_t opcode=WS_TEXT);
+
     size_t printf(uint32_t id, const char *format, ...)  __attribute__ ((format (printf, 3, 4)));
     size_t printfAll(const char *format, ...)  __attribute__ ((format (printf, 2, 3)));
 #ifndef ESP32
@@ -315,13 +350,25 @@ class AsyncWebSocket: public AsyncWebHandler {
     void onEvent(AwsEventHandler handler){
       _eventHandler = handler;
     }
+    //called with true when a client queue fills up or drops a message, with false once it has drained to half
+    void onBackpressure(AwsBackpressureHandler handler){
+      _backpressureHandler = handler;
+    }
 
     //system callbacks (do not call)
     uint32_t _getNextId(){ return _cNextId++; }
     void _addClient(AsyncWebSocketClient * client);
     void _handleDisconnect(AsyncWebSocketClient * client);
     void _handleEvent(AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len);
+    void _handleBackpressure(AsyncWebSocketClient * client, bool congested){ if(_backpressureHandler) _backpressureHandler(client, congested); }
+    AsyncMessagePool * _pool(){ return &_messagePool; }
     virtual bool canHandle(AsyncWebServerRequest *request) override final;
+    virtual bool route(String& path, WebRouteType& type, WebRequestMethodComposite& method) const override final {
+      path = _url;
+      type = ROUTE_EXACT;
+      method = HTTP_GET;
+      return true;
+    }
     virtual void handleRequest(AsyncWebServerRequest *request) override final;
 
 
@@ -27,6 +27,7 @@
 #include "FS.h"
 
 #include "StringArray.h"
+#include "WebRequestArena.h"
 
 #ifdef ESP32
 #include <WiFi.h>
@@ -56,6 +57,7 @@ class AsyncWebHandler;
 class AsyncStaticWebHandler;
 class AsyncCallbackWebHandler;
 class AsyncResponseStream;
+class AsyncWebRouter;
 
 #ifndef WEBSERVER_H
 typedef enum {
@@ -74,6 +76,7 @@ typedef enum {
 #define RESPONSE_TRY_AGAIN 0xFFFFFFFF
 
 typedef uint8_t WebRequestMethodComposite;
+typedef enum { ROUTE_EXACT, ROUTE_SEGMENT, ROUTE_PREFIX } WebRouteType; //url is path; url is path or below path/; url starts with path
 typedef std::function<void(void)> ArDisconnectHandler;
 
 /*
@@ -163,8 +166,13 @@ class AsyncWebServerRequest {
     size_t _contentLength;
     size_t _parsedLength;
 
-    LinkedList<AsyncWebHeader *> _headers;
-    LinkedList<AsyncWebParameter *> _params;
+    AsyncWebRequestArena _arena; //request line and header lines, headers are made from it when asked for
+    size_t _lineStart;
+    size_t _headersStart;
+    size_t _headersEnd;
+    size_t _queryOffset;
+    mutable size_t _queryLength; //query still to be parsed into _params
+    mutable LinkedList<AsyncWebParameter *> _params;
     LinkedList<String *> _pathParams;
 
     uint8_t _multiParseState;
@@ -188,9 +196,15 @@ class AsyncWebServerRequest {
 
     void _addParam(AsyncWebParameter*);
     void _addPathParam(const char *param);
+    void _parseQuery() const;
+    void _addGetParams(const char *params, size_t len) const;
+    String _urlDecode(const char *text, size_t len) const;
+
+    size_t _nextHeader(size_t offset) const;
+    AsyncWebHeader* _headerAt(size_t offset) const;
 
-    bool _parseReqHead();
-    bool _parseReqHeader();
+    bool _parseReqHead(size_t offset, size_t len);
+    bool _parseReqHeader(size_t offset, size_t start, size_t len);
     void _parseLine();
     void _parsePlainPostChar(uint8_t data);
     void _parseMultipartPostByte(uint8_t data, bool last);
@@ -345,6 +359,8 @@ class AsyncWebHandler {
     virtual void handleUpload(AsyncWebServerRequest *request  __attribute__((unused)), const String& filename __attribute__((unused)), size_t index __attribute__((unused)), uint8_t *data __attribute__((unused)), size_t len __attribute__((unused)), bool final  __attribute__((unused))){}
     virtual void handleBody(AsyncWebServerRequest *request __attribute__((unused)), uint8_t *data __attribute__((unused)), size_t len __attribute__((unused)), size_t index __attribute__((unused)), size_t total __attribute__((unused))){}
     virtual bool isRequestHandlerTrivial(){return true;}
+    //what the handler can match, for the router; false if it has to be asked for every request
+    virtual bool route(String& path __attribute__((unused)), WebRouteType& type __attribute__((unused)), WebRequestMethodComposite& method __attribute__((unused))) const { return false; }
 };
 
 /*
@@ -363,6 +379,7 @@ class AsyncWebServerResponse {
     size_t _contentLength;
     bool _sendContentLength;
     bool _chunked;
+    bool _acceptRanges;
     size_t _headLength;
     size_t _sentLength;
     size_t _ackedLength;
@@ -400,6 +417,7 @@ class AsyncWebServer {
     LinkedList<AsyncWebRewrite*> _rewrites;
     LinkedList<AsyncWebHandler*> _handlers;
     AsyncCallbackWebHandler* _catchAllHandler;
+    AsyncWebRouter* _router;
 
   public:
     AsyncWebServer(uint16_t port);
@@ -419,6 +437,8 @@ class AsyncWebServer {
 
     AsyncWebHandler& addHandler(AsyncWebHandler* handler);
     bool removeHandler(AsyncWebHandler* handler);
+    //find handlers through a trie of their routes instead of asking each one in turn
+    void enableRouter(bool enable = true);
   
     AsyncCallbackWebHandler& on(const char* uri, ArRequestHandlerFunction onRequest);
     AsyncCallbackWebHandler& on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest);
@@ -29,6 +29,47 @@
 #include "stddef.h"
 #include <time.h>
 
+#ifndef ASYNCWEBSERVER_FILE_CACHE_SIZE
+#define ASYNCWEBSERVER_FILE_CACHE_SIZE 4
+#endif
+
+//variants of a file in the index of AsyncStaticWebHandler
+#define STATIC_FILE_PLAIN 0
+#define STATIC_FILE_GZIP  1
+#define STATIC_FILE_BR    2
+
+struct AsyncStaticFileInfo {
+  String path; //without .gz or .br
+  uint8_t variants; //bit per STATIC_FILE_*
+  uint32_t size[3];
+  uint32_t hash[3];
+};
+
+/*
+ * Open files of finished responses, handed to the next response for the same path.
+ * Shared by the handler and its responses, freed with the last of them
+ * */
+class AsyncStaticFileCache {
+   using File = fs::File;
+   using FS = fs::FS;
+  private:
+    struct Slot {
+      String path;
+      File file;
+    };
+    Slot* _slots;
+    uint8_t _size;
+    uint8_t _next;
+    uint16_t _refs;
+    ~AsyncStaticFileCache();
+  public:
+    AsyncStaticFileCache(uint8_t size);
+    void ref(){ _refs++; }
+    void unref(){ if(--_refs == 0) delete this; }
+    File take(FS& fs, const String& path);
+    void give(const String& path, File file);
+};
+
 class AsyncStaticWebHandler: public AsyncWebHandler {
    using File = fs::File;
    using FS = fs::FS;
@@ -36,6 +77,12 @@ class AsyncStaticWebHandler: public AsyncWebHandler {
     bool _getFile(AsyncWebServerRequest *request);
     bool _fileExists(AsyncWebServerRequest *request, const String& path);
     uint8_t _countBits(const uint8_t value) const;
+    void _indexDir(const String& dir, LinkedList<AsyncStaticFileInfo *>& files);
+    void _indexFile(File& file, const String& path, LinkedList<AsyncStaticFileInfo *>& files);
+    void _freeIndex();
+    const AsyncStaticFileInfo * _findIndexed(const String& path) const;
+    bool _indexedExists(AsyncWebServerRequest *request, const String& path);
+    void _sendIndexed(AsyncWebServerRequest *request, const String& path);
   protected:
     FS _fs;
     String _uri;
@@ -47,10 +94,20 @@ class AsyncStaticWebHandler: public AsyncWebHandler {
     bool _isDir;
     bool _gzipFirst;
     uint8_t _gzipStats;
+    AsyncStaticFileInfo ** _index; //sorted by path
+    size_t _indexSize;
+    AsyncStaticFileCache * _fileCache;
   public:
     AsyncStaticWebHandler(const char* uri, FS& fs, const char* path, const char* cache_control);
+    ~AsyncStaticWebHandler();
     virtual bool canHandle(AsyncWebServerRequest *request) override final;
     virtual void handleRequest(AsyncWebServerRequest *request) override final;
+    virtual bool route(String& path, WebRouteType& type, WebRequestMethodComposite& method) const override final {
+      path = _uri;
+      type = ROUTE_PREFIX;
+      method = HTTP_GET;
+      return true;
+    }
     AsyncStaticWebHandler& setIsDir(bool isDir);
     AsyncStaticWebHandler& setDefaultFile(const char* filename);
     AsyncStaticWebHandler& setCacheControl(const char* cache_control);
@@ -61,6 +118,11 @@ class AsyncStaticWebHandler: public AsyncWebHandler {
     AsyncStaticWebHandler& setLastModified(); //sets to current time. Make sure sntp is runing and time is updated
   #endif
     AsyncStaticWebHandler& setTemplateProcessor(AwsTemplateProcessor newCallback) {_callback = newCallback; return *this;}
+    //list the files below path once, requests are then looked up there instead of in the file system;
+    //adds .br variants, content hash ETags and 304 answers. Call again after the files changed
+    AsyncStaticWebHandler& buildIndex();
+    //keep up to handles files open for the next request of the same file, 0 to disable
+    AsyncStaticWebHandler& setFileCache(uint8_t handles = ASYNCWEBSERVER_FILE_CACHE_SIZE);
 };
 
 class AsyncCallbackWebHandler: public AsyncWebHandler {
@@ -133,6 +195,7 @@ class AsyncCallbackWebHandler: public AsyncWebHandler {
         _onBody(request, data, len, index, total);
     }
     virtual bool isRequestHandlerTrivial() override final {return _onRequest ? false : true;}
+    virtual bool route(String& path, WebRouteType& type, WebRequestMethodComposite& method) const override final;
 };
 
 #endif /* ASYNCWEBSERVERHANDLERIMPL_H_ */
@@ -40,6 +40,16 @@ AsyncStaticWebHandler::AsyncStaticWebHandler(const char* uri, FS& fs, const char
   // Reset stats
   _gzipFirst = false;
   _gzipStats = 0xF8;
+
+  _index = NULL;
+  _indexSize = 0;
+  _fileCache = NULL;
+}
+
+AsyncStaticWebHandler::~AsyncStaticWebHandler(){
+  _freeIndex();
+  if(_fileCache)
+    _fileCache->unref();
 }
 
 AsyncStaticWebHandler& AsyncStaticWebHandler::setIsDir(bool isDir){
@@ -92,9 +102,15 @@ bool AsyncStaticWebHandler::canHandle(AsyncWebServerRequest *request){
     if (_last_modified.length())
       request->addInterestingHeader("If-Modified-Since");
 
-    if(_cache_control.length())
+    if(_cache_control.length() || _index)
       request->addInterestingHeader("If-None-Match");
 
+    if(_index)
+      request->addInterestingHeader("Accept-Encoding");
+
+    request->addInterestingHeader("Range");
+    request->addInterestingHeader("If-Range");
+
     DEBUGF("[AsyncStaticWebHandler::canHandle] TRUE\n");
     return true;
   }
@@ -113,7 +129,7 @@ bool AsyncStaticWebHandler::_getFile(AsyncWebServerRequest *request)
   path = _path + path;
 
   // Do we have a file or .gz file
-  if (!canSkipFileCheck && _fileExists(request, path))
+  if (!canSkipFileCheck && (_index ? _indexedExists(request, path) : _fileExists(request, path)))
     return true;
 
   // Can't handle if not default file
@@ -125,7 +141,7 @@ bool AsyncStaticWebHandler::_getFile(AsyncWebServerRequest *request)
     path += "/";
   path += _default_file;
 
-  return _fileExists(request, path);
+  return _index ? _indexedExists(request, path) : _fileExists(request, path);
 }
 
 #ifdef ESP32
@@ -193,7 +209,9 @@ void AsyncStaticWebHandler::handleRequest(AsyncWebServerRequest *request)
   if((_username != "" && _password != "") && !request->authenticate(_username.c_str(), _password.c_str()))
       return request->requestAuthentication();
 
-  if (request->_tempFile == true) {
+  if (_index) {
+    _sendIndexed(request, filename);
+  } else if (request->_tempFile == true) {
     String etag = String(request->_tempFile.size());
     if (_last_modified.length() && _last_modified == request->header("If-Modified-Since")) {
       request->_tempFile.close();
@@ -218,3 +236,304 @@ void AsyncStaticWebHandler::handleRequest(AsyncWebServerRequest *request)
     request->send(404);
   }
 }
+
+/*
+ * Static file index
+ * */
+
+static const char * STATIC_FILE_SUFFIX[3] = { "", ".gz", ".br" };
+
+AsyncStaticWebHandler& AsyncStaticWebHandler::buildIndex(){
+  _freeIndex();
+  LinkedList<AsyncStaticFileInfo *> files([](AsyncStaticFileInfo *f){ (void)f; });
+  _indexDir(_path, files);
+
+  _index = (AsyncStaticFileInfo **)malloc(sizeof(AsyncStaticFileInfo *) * (files.length() ? files.length() : 1));
+  if(_index == NULL){
+    for(const auto& f: files)
+      delete f;
+    return *this;
+  }
+  // insertion sort, the directory listings are mostly in order already
+  for(const auto& f: files){
+    size_t i = _indexSize++;
+    while(i && _index[i - 1]->path > f->path){
+      _index[i] = _index[i - 1];
+      i--;
+    }
+    _index[i] = f;
+  }
+  DEBUGF("[AsyncStaticWebHandler::buildIndex] %u files\n", (unsigned)_indexSize);
+  return *this;
+}
+
+AsyncStaticWebHandler& AsyncStaticWebHandler::setFileCache(uint8_t handles){
+  if(_fileCache)
+    _fileCache->unref();
+  _fileCache = handles ? new AsyncStaticFileCache(handles) : NULL;
+  return *this;
+}
+
+void AsyncStaticWebHandler::_freeIndex(){
+  for(size_t i = 0; i < _indexSize; i++)
+    delete _index[i];
+  free(_index);
+  _index = NULL;
+  _indexSize = 0;
+}
+
+void AsyncStaticWebHandler::_indexDir(const String& dir, LinkedList<AsyncStaticFileInfo *>& files){
+#ifdef ESP32
+  File root = _fs.open(dir.length() ? dir : String("/"));
+  if(!root || !root.isDirectory())
+    return;
+  File entry = root.openNextFile();
+  while(entry){
+    String name = entry.name();
+    // older cores give the full path
+    String path = name.startsWith("/") ? name : dir + "/" + name;
+    if(entry.isDirectory())
+      _indexDir(path, files);
+    else
+      _indexFile(entry, path, files);
+    entry.close();
+    entry = root.openNextFile();
+  }
+  root.close();
+#else
+  Dir root = _fs.openDir(dir.length() ? dir : String("/"));
+  while(root.next()){
+    String name = root.fileName();
+    String path = name.startsWith("/") ? name : dir + "/" + name;
+    if(root.isDirectory()){
+      _indexDir(path, files);
+    } else {
+      File entry = root.openFile("r");
+      if(entry){
+        _indexFile(entry, path, files);
+        entry.close();
+      }
+    }
+  }
+#endif
+}
+
+void AsyncStaticWebHandler::_indexFile(File& file, const String& path, LinkedList<AsyncStaticFileInfo *>& files){
+  uint8_t variant = STATIC_FILE_PLAIN;
+  String base = path;
+  if(path.endsWith(".gz")){
+    variant = STATIC_FILE_GZIP;
+    base = path.substring(0, path.length() - 3);
+  } else if(path.endsWith(".br")){
+    variant = STATIC_FILE_BR;
+    base = path.substring(0, path.length() - 3);
+  }
+
+  // FNV-1a of the content, for a strong ETag that changes with the file
+  uint32_t hash = 2166136261UL;
+  uint8_t buf[256];
+  size_t len;
+  while((len = file.read(buf, sizeof(buf))) > 0){
+    for(size_t i = 0; i < len; i++)
+      hash = (hash ^ buf[i]) * 16777619UL;
+  }
+
+  AsyncStaticFileInfo * info = NULL;
+  for(const auto& f: files){
+    if(f->path == base){
+      info = f;
+      break;
+    }
+  }
+  if(info == NULL){
+    info = new AsyncStaticFileInfo();
+    if(info == NULL)
+      return;
+    info->path = base;
+    info->variants = 0;
+    files.add(info);
+  }
+  info->variants |= 1 << variant;
+  info->size[variant] = file.size();
+  info->hash[variant] = hash;
+}
+
+const AsyncStaticFileInfo * AsyncStaticWebHandler::_findIndexed(const String& path) const {
+  size_t lo = 0, hi = _indexSize;
+  while(lo < hi){
+    size_t mid = (lo + hi) / 2;
+    int c = strcmp(_index[mid]->path.c_str(), path.c_str());
+    if(c == 0)
+      return _index[mid];
+    if(c < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return NULL;
+}
+
+bool AsyncStaticWebHandler::_indexedExists(AsyncWebServerRequest *request, const String& path){
+  if(!_findIndexed(path))
+    return false;
+  size_t pathLen = path.length();
+  char * _tempPath = (char*)malloc(pathLen+1);
+  snprintf(_tempPath, pathLen+1, "%s", path.c_str());
+  request->_tempObject = (void*)_tempPath;
+  return true;
+}
+
+void AsyncStaticWebHandler::_sendIndexed(AsyncWebServerRequest *request, const String& path){
+  const AsyncStaticFileInfo * info = _findIndexed(path);
+  if(info == NULL){
+    request->send(404);
+    return;
+  }
+
+  // smallest encoding the client takes, an encoded file without plain variant is sent as it is
+  String accept = request->header("Accept-Encoding");
+  uint8_t variant;
+  if((info->variants & (1 << STATIC_FILE_BR)) && (accept.indexOf("br") >= 0 || info->variants == (1 << STATIC_FILE_BR)))
+    variant = STATIC_FILE_BR;
+  else if((info->variants & (1 << STATIC_FILE_GZIP)) && (accept.indexOf("gzip") >= 0 || !(info->variants & (1 << STATIC_FILE_PLAIN))))
+    variant = STATIC_FILE_GZIP;
+  else
+    variant = STATIC_FILE_PLAIN;
+
+  char etag[24];
+  snprintf(etag, sizeof(etag), "\"%x-%08x\"", (unsigned)info->size[variant], (unsigned)info->hash[variant]);
+  bool vary = (info->variants & (info->variants - 1)) != 0;
+
+  String match = request->header("If-None-Match");
+  if ((_last_modified.length() && _last_modified == request->header("If-Modified-Since"))
+    || (match.length() && (match == "*" || match.indexOf(etag) >= 0))) {
+    AsyncWebServerResponse * response = new AsyncBasicResponse(304); // Not modified
+    if(_cache_control.length())
+      response->addHeader("Cache-Control", _cache_control);
+    response->addHeader("ETag", etag);
+    if(vary)
+      response->addHeader("Vary", "Accept-Encoding");
+    request->send(response);
+    return;
+  }
+
+  String filePath = path + STATIC_FILE_SUFFIX[variant];
+  File file = _fileCache ? _fileCache->take(_fs, filePath) : _fs.open(filePath, "r");
+  if(!file){
+    request->send(404);
+    return;
+  }
+  AsyncFileResponse * response = new AsyncFileResponse(file, path, String(), false, _callback);
+  if(_fileCache)
+    response->_setFileCache(_fileCache, filePath);
+  if (_last_modified.length())
+    response->addHeader("Last-Modified", _last_modified);
+  if (_cache_control.length())
+    response->addHeader("Cache-Control", _cache_control);
+  response->addHeader("ETag", etag);
+  if(vary)
+    response->addHeader("Vary", "Accept-Encoding");
+  request->send(response);
+}
+
+/*
+ * Open file cache
+ * */
+
+AsyncStaticFileCache::AsyncStaticFileCache(uint8_t size)
+  : _size(size), _next(0), _refs(1)
+{
+  _slots = new Slot[size];
+  if(_slots == NULL)
+    _size = 0;
+}
+
+AsyncStaticFileCache::~AsyncStaticFileCache(){
+  for(uint8_t i = 0; i < _size; i++){
+    if(_slots[i].file)
+      _slots[i].file.close();
+  }
+  delete[] _slots;
+}
+
+fs::File AsyncStaticFileCache::take(FS& fs, const String& path){
+  for(uint8_t i = 0; i < _size; i++){
+    if(_slots[i].file && _slots[i].path == path){
+      File file = _slots[i].file;
+      _slots[i].file = File();
+      _slots[i].path = String();
+      file.seek(0);
+      return file;
+    }
+  }
+  return fs.open(path, "r");
+}
+
+void AsyncStaticFileCache::give(const String& path, File file){
+  uint8_t slot = _size;
+  for(uint8_t i = 0; i < _size; i++){
+    if(!_slots[i].file){
+      slot = i;
+      break;
+    }
+  }
+  if(slot == _size){
+    if(_size == 0){
+      file.close();
+      return;
+    }
+    // full, drop the slot filled longest ago
+    slot = _next;
+    _next = (_next + 1) % _size;
+    _slots[slot].file.close();
+  }
+  _slots[slot].path = path;
+  _slots[slot].file = file;
+}
+
+#ifdef ASYNCWEBSERVER_REGEX
+// Literal start of an anchored pattern, every url it matches begins with it
+static String _regexPrefix(const String& pattern){
+  String prefix;
+  if(pattern.indexOf('|') >= 0)
+    return prefix;
+  size_t end = pattern.length() - 1; // skip the closing '$'
+  for(size_t i = 1; i < end; i++){
+    char c = pattern[i];
+    if(c == '\\'){
+      if(i + 1 >= end || isalnum(pattern[i + 1]))
+        break; // character class like \d
+      c = pattern[++i];
+    } else if(strchr(".[](){}*+?^$", c)){
+      break;
+    }
+    char q = (i + 1 < end) ? pattern[i + 1] : 0;
+    if(q == '*' || q == '?' || q == '{')
+      break; // the character is optional
+    prefix += c;
+  }
+  return prefix;
+}
+#endif
+
+bool AsyncCallbackWebHandler::route(String& path, WebRouteType& type, WebRequestMethodComposite& method) const {
+  method = _method;
+#ifdef ASYNCWEBSERVER_REGEX
+  if(_isRegex){
+    path = _regexPrefix(_uri);
+    type = ROUTE_PREFIX;
+    return true;
+  }
+#endif
+  if(_uri.length() && _uri.endsWith("*")){
+    path = _uri.substring(0, _uri.length() - 1);
+    type = ROUTE_PREFIX;
+  } else if(_uri.length()){
+    path = _uri;
+    type = ROUTE_SEGMENT;
+  } else {
+    path = String();
+    type = ROUTE_PREFIX;
+  }
+  return true;
+}
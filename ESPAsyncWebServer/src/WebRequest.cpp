@@ -32,6 +32,36 @@ static const String SharedEmptyString = String();
 
 enum { PARSE_REQ_START, PARSE_REQ_HEADERS, PARSE_REQ_BODY, PARSE_REQ_END, PARSE_REQ_FAIL };
 
+#define ARENA_NO_LINE ((size_t)-1)
+
+// A header line in the arena: this view, then the trimmed line with its ':' and end
+// replaced by '\0'. The AsyncWebHeader is only made if someone asks for it
+struct AsyncWebHeaderView {
+  uint16_t size;        // of the whole record, view included
+  uint16_t nameOffset;  // from the end of the view
+  uint16_t valueOffset;
+  bool dropped;         // not interesting to the handler
+  AsyncWebHeader *header;
+};
+
+static AsyncWebHeaderView _headerView(const AsyncWebRequestArena& arena, size_t offset){
+  AsyncWebHeaderView v;
+  memcpy(&v, arena.at(offset), sizeof(v));
+  return v;
+}
+
+static void _setHeaderView(const AsyncWebRequestArena& arena, size_t offset, const AsyncWebHeaderView& v){
+  memcpy(arena.at(offset), &v, sizeof(v));
+}
+
+static const char * _headerName(const AsyncWebRequestArena& arena, size_t offset, const AsyncWebHeaderView& v){
+  return (const char *)arena.at(offset + sizeof(AsyncWebHeaderView) + v.nameOffset);
+}
+
+static const char * _headerValue(const AsyncWebRequestArena& arena, size_t offset, const AsyncWebHeaderView& v){
+  return (const char *)arena.at(offset + sizeof(AsyncWebHeaderView) + v.valueOffset);
+}
+
 AsyncWebServerRequest::AsyncWebServerRequest(AsyncWebServer* s, AsyncClient* c)
   : _client(c)
   , _server(s)
@@ -53,7 +83,12 @@ AsyncWebServerRequest::AsyncWebServerRequest(AsyncWebServer* s, AsyncClient* c)
   , _expectingContinue(false)
   , _contentLength(0)
   , _parsedLength(0)
-  , _headers(LinkedList<AsyncWebHeader *>([](AsyncWebHeader *h){ delete h; }))
+  , _arena()
+  , _lineStart(ARENA_NO_LINE)
+  , _headersStart(0)
+  , _headersEnd(0)
+  , _queryOffset(0)
+  , _queryLength(0)
   , _params(LinkedList<AsyncWebParameter *>([](AsyncWebParameter *p){ delete p; }))
   , _pathParams(LinkedList<String *>([](String *p){ delete p; }))
   , _multiParseState(0)
@@ -78,7 +113,11 @@ AsyncWebServerRequest::AsyncWebServerRequest(AsyncWebServer* s, AsyncClient* c)
 }
 
 AsyncWebServerRequest::~AsyncWebServerRequest(){
-  _headers.free();
+  for(size_t o = _headersStart; o < _headersEnd;){
+    AsyncWebHeaderView v = _headerView(_arena, o);
+    delete v.header;
+    o += v.size;
+  }
 
   _params.free();
   _pathParams.free();
@@ -110,16 +149,21 @@ void AsyncWebServerRequest::_onData(void *buf, size_t len){
         break;
       }
     }
-    if (i == len) { // No new line, just add the buffer in _temp
-      char ch = str[len-1];
-      str[len-1] = 0;
-      _temp.reserve(_temp.length()+len);
-      _temp.concat(str);
-      _temp.concat(ch);
-    } else { // Found new line - extract it and parse
-      str[i] = 0; // Terminate the string at the end of the line.
-      _temp.concat(str);
-      _temp.trim();
+    // Collect the line in the arena, header lines after room for their view
+    if (_lineStart == ARENA_NO_LINE) {
+      if (_parseState == PARSE_REQ_HEADERS && !_arena.append(NULL, sizeof(AsyncWebHeaderView))) {
+        _parseState = PARSE_REQ_FAIL;
+        _client->close();
+        break;
+      }
+      _lineStart = _arena.length();
+    }
+    if (!_arena.append(str, i)) {
+      _parseState = PARSE_REQ_FAIL;
+      _client->close();
+      break;
+    }
+    if (i < len) { // Found new line - parse it
       _parseLine();
       if (++i < len) {
         // Still have more buffer to process
@@ -180,13 +224,45 @@ void AsyncWebServerRequest::_onData(void *buf, size_t len){
 
 void AsyncWebServerRequest::_removeNotInterestingHeaders(){
   if (_interestingHeaders.containsIgnoreCase("ANY")) return; // nothing to do
-  for(const auto& header: _headers){
-      if(!_interestingHeaders.containsIgnoreCase(header->name().c_str())){
-        _headers.remove(header);
+  for(size_t o = _headersStart; o < _headersEnd;){
+    AsyncWebHeaderView v = _headerView(_arena, o);
+    const char * name = _headerName(_arena, o, v);
+    bool interesting = false;
+    for(const auto& h: _interestingHeaders){
+      if(!strcasecmp(h.c_str(), name)){
+        interesting = true;
+        break;
       }
+    }
+    if(!interesting){
+      delete v.header;
+      v.header = NULL;
+      v.dropped = true;
+      _setHeaderView(_arena, o, v);
+    }
+    o += v.size;
   }
 }
 
+size_t AsyncWebServerRequest::_nextHeader(size_t offset) const {
+  while(offset < _headersEnd){
+    AsyncWebHeaderView v = _headerView(_arena, offset);
+    if(!v.dropped)
+      return offset;
+    offset += v.size;
+  }
+  return _headersEnd;
+}
+
+AsyncWebHeader* AsyncWebServerRequest::_headerAt(size_t offset) const {
+  AsyncWebHeaderView v = _headerView(_arena, offset);
+  if(v.header == NULL){
+    v.header = new AsyncWebHeader(String(_headerName(_arena, offset, v)), String(_headerValue(_arena, offset, v)));
+    _setHeaderView(_arena, offset, v);
+  }
+  return v.header;
+}
+
 void AsyncWebServerRequest::_onPoll(){
   //os_printf("p\n");
   if(_response != NULL && _client != NULL && _client->canSend() && !_response->_finished()){
@@ -230,64 +306,81 @@ void AsyncWebServerRequest::_onDisconnect(){
 }
 
 void AsyncWebServerRequest::_addParam(AsyncWebParameter *p){
+  _parseQuery();
   _params.add(p);
 }
 
+void AsyncWebServerRequest::_parseQuery() const {
+  if(_queryLength){
+    size_t len = _queryLength;
+    _queryLength = 0;
+    _addGetParams((const char *)_arena.at(_queryOffset), len);
+  }
+}
+
 void AsyncWebServerRequest::_addPathParam(const char *p){
   _pathParams.add(new String(p));
 }
 
 void AsyncWebServerRequest::_addGetParams(const String& params){
+  _parseQuery();
+  _addGetParams(params.c_str(), params.length());
+}
+
+void AsyncWebServerRequest::_addGetParams(const char *params, size_t len) const {
   size_t start = 0;
-  while (start < params.length()){
-    int end = params.indexOf('&', start);
-    if (end < 0) end = params.length();
-    int equal = params.indexOf('=', start);
-    if (equal < 0 || equal > end) equal = end;
-    String name = params.substring(start, equal);
-    String value = equal + 1 < end ? params.substring(equal + 1, end) : String();
-    _addParam(new AsyncWebParameter(urlDecode(name), urlDecode(value)));
+  while (start < len){
+    const char *amp = (const char *)memchr(params + start, '&', len - start);
+    size_t end = amp ? amp - params : len;
+    const char *eq = (const char *)memchr(params + start, '=', end - start);
+    size_t equal = eq ? eq - params : end;
+    String name = _urlDecode(params + start, equal - start);
+    String value = equal + 1 < end ? _urlDecode(params + equal + 1, end - equal - 1) : String();
+    _params.add(new AsyncWebParameter(name, value));
     start = end + 1;
   }
 }
 
-bool AsyncWebServerRequest::_parseReqHead(){
+bool AsyncWebServerRequest::_parseReqHead(size_t offset, size_t len){
   // Split the head into method, url and version
-  int index = _temp.indexOf(' ');
-  String m = _temp.substring(0, index);
-  index = _temp.indexOf(' ', index+1);
-  String u = _temp.substring(m.length()+1, index);
-  _temp = _temp.substring(index+1);
-
-  if(m == "GET"){
+  char *line = (char *)_arena.at(offset);
+  char *end = line + len;
+  char *u = (char *)memchr(line, ' ', len);
+  if(u == NULL) u = end;
+  size_t m = u - line;
+  if(u < end) u++;
+  char *v = (char *)memchr(u, ' ', end - u);
+  if(v == NULL) v = end;
+
+  if(m == 3 && !memcmp(line, "GET", 3)){
     _method = HTTP_GET;
-  } else if(m == "POST"){
+  } else if(m == 4 && !memcmp(line, "POST", 4)){
     _method = HTTP_POST;
-  } else if(m == "DELETE"){
+  } else if(m == 6 && !memcmp(line, "DELETE", 6)){
     _method = HTTP_DELETE;
-  } else if(m == "PUT"){
+  } else if(m == 3 && !memcmp(line, "PUT", 3)){
     _method = HTTP_PUT;
-  } else if(m == "PATCH"){
+  } else if(m == 5 && !memcmp(line, "PATCH", 5)){
     _method = HTTP_PATCH;
-  } else if(m == "HEAD"){
+  } else if(m == 4 && !memcmp(line, "HEAD", 4)){
     _method = HTTP_HEAD;
-  } else if(m == "OPTIONS"){
+  } else if(m == 7 && !memcmp(line, "OPTIONS", 7)){
     _method = HTTP_OPTIONS;
   }
 
-  String g = String();
-  index = u.indexOf('?');
-  if(index > 0){
-    g = u.substring(index +1);
-    u = u.substring(0, index);
+  // the query stays in the arena until a param is asked for
+  char *q = (char *)memchr(u, '?', v - u);
+  if(q != NULL && q > u){
+    _queryOffset = offset + (q + 1 - line);
+    _queryLength = v - (q + 1);
+  } else {
+    q = v;
   }
-  _url = urlDecode(u);
-  _addGetParams(g);
+  _url = _urlDecode(u, q - u);
 
-  if(!_temp.startsWith("HTTP/1.0"))
+  if(end - v <= 8 || memcmp(v + 1, "HTTP/1.0", 8))
     _version = 1;
 
-  _temp = String();
   return true;
 }
 
@@ -309,45 +402,70 @@ bool strContains(String src, String find, bool mindcase = true) {
   return false;
 }
 
-bool AsyncWebServerRequest::_parseReqHeader(){
-  int index = _temp.indexOf(':');
-  if(index){
-    String name = _temp.substring(0, index);
-    String value = _temp.substring(index + 2);
-    if(name.equalsIgnoreCase("Host")){
-      _host = value;
-    } else if(name.equalsIgnoreCase("Content-Type")){
-	  _contentType = value.substring(0, value.indexOf(';'));
-      if (value.startsWith("multipart/")){
-        _boundary = value.substring(value.indexOf('=')+1);
-        _boundary.replace("\"","");
-        _isMultipart = true;
-      }
-    } else if(name.equalsIgnoreCase("Content-Length")){
-      _contentLength = atoi(value.c_str());
-    } else if(name.equalsIgnoreCase("Expect") && value == "100-continue"){
-      _expectingContinue = true;
-    } else if(name.equalsIgnoreCase("Authorization")){
-      if(value.length() > 5 && value.substring(0,5).equalsIgnoreCase("Basic")){
-        _authorization = value.substring(6);
-      } else if(value.length() > 6 && value.substring(0,6).equalsIgnoreCase("Digest")){
-        _isDigest = true;
-        _authorization = value.substring(7);
-      }
+bool AsyncWebServerRequest::_parseReqHeader(size_t offset, size_t start, size_t len){
+  // offset is the view, the line starts at start after it and has len bytes left after trimming
+  size_t lineOffset = offset + sizeof(AsyncWebHeaderView) + start;
+  char *line = (char *)_arena.at(lineOffset);
+  char *colon = (char *)memchr(line, ':', len);
+  if(colon == NULL || colon == line || sizeof(AsyncWebHeaderView) + start + len + 1 > 0xFFFF){
+    _arena.truncate(offset);
+    return true;
+  }
+  size_t index = colon - line;
+  *colon = 0;
+  // terminate the value, in place of the '\r' if there was one
+  if(lineOffset + len < _arena.length()){
+    *_arena.at(lineOffset + len) = 0;
+    _arena.truncate(lineOffset + len + 1);
+  } else if(!_arena.append("", 1)){
+    _arena.truncate(offset);
+    return false;
+  }
+  line = (char *)_arena.at(lineOffset);
+  const char *name = line;
+  const char *value = line + (index + 2 < len ? index + 2 : len);
+
+  if(!strcasecmp(name, "Host")){
+    _host = value;
+  } else if(!strcasecmp(name, "Content-Type")){
+    String v(value);
+	  _contentType = v.substring(0, v.indexOf(';'));
+    if (v.startsWith("multipart/")){
+      _boundary = v.substring(v.indexOf('=')+1);
+      _boundary.replace("\"","");
+      _isMultipart = true;
+    }
+  } else if(!strcasecmp(name, "Content-Length")){
+    _contentLength = atoi(value);
+  } else if(!strcasecmp(name, "Expect") && !strcmp(value, "100-continue")){
+    _expectingContinue = true;
+  } else if(!strcasecmp(name, "Authorization")){
+    size_t l = strlen(value);
+    if(l > 5 && !strncasecmp(value, "Basic", 5)){
+      _authorization = value + 6;
+    } else if(l > 6 && !strncasecmp(value, "Digest", 6)){
+      _isDigest = true;
+      _authorization = value + 7;
+    }
+  } else {
+    if(!strcasecmp(name, "Upgrade") && !strcasecmp(value, "websocket")){
+      // WebSocket request can be uniquely identified by header: [Upgrade: websocket]
+      _reqconntype = RCT_WS;
     } else {
-      if(name.equalsIgnoreCase("Upgrade") && value.equalsIgnoreCase("websocket")){
-        // WebSocket request can be uniquely identified by header: [Upgrade: websocket]
-        _reqconntype = RCT_WS;
-      } else {
-        if(name.equalsIgnoreCase("Accept") && strContains(value, "text/event-stream", false)){
-          // WebEvent request can be uniquely identified by header:  [Accept: text/event-stream]
-          _reqconntype = RCT_EVENT;
-        }
+      if(!strcasecmp(name, "Accept") && strContains(String(value), "text/event-stream", false)){
+        // WebEvent request can be uniquely identified by header:  [Accept: text/event-stream]
+        _reqconntype = RCT_EVENT;
       }
     }
-    _headers.add(new AsyncWebHeader(name, value));
   }
-  _temp = String();
+
+  AsyncWebHeaderView v;
+  v.size = _arena.length() - offset;
+  v.nameOffset = start;
+  v.valueOffset = value - line + start;
+  v.dropped = false;
+  v.header = NULL;
+  _setHeaderView(_arena, offset, v);
   return true;
 }
 
@@ -552,20 +670,33 @@ void AsyncWebServerRequest::_parseMultipartPostByte(uint8_t data, bool last){
 }
 
 void AsyncWebServerRequest::_parseLine(){
+  // trim the line like String::trim()
+  size_t lineStart = _lineStart;
+  const char *line = (const char *)_arena.at(lineStart);
+  size_t len = _arena.length() - lineStart;
+  size_t start = 0;
+  while(start < len && isspace(line[start])) start++;
+  while(len > start && isspace(line[len - 1])) len--;
+  len -= start;
+  _lineStart = ARENA_NO_LINE;
+
   if(_parseState == PARSE_REQ_START){
-    if(!_temp.length()){
+    if(!len){
       _parseState = PARSE_REQ_FAIL;
       _client->close();
     } else {
-      _parseReqHead();
+      _parseReqHead(lineStart + start, len);
       _parseState = PARSE_REQ_HEADERS;
+      _headersStart = _headersEnd = _arena.length();
     }
     return;
   }
 
   if(_parseState == PARSE_REQ_HEADERS){
-    if(!_temp.length()){
+    if(!len){
       //end of headers
+      _arena.truncate(lineStart - sizeof(AsyncWebHeaderView));
+      _headersEnd = _arena.length();
       _server->_rewriteRequest(this);
       _server->_attachHandler(this);
       _removeNotInterestingHeaders();
@@ -581,17 +712,23 @@ void AsyncWebServerRequest::_parseLine(){
         if(_handler) _handler->handleRequest(this);
         else send(501);
       }
-    } else _parseReqHeader();
+    } else if(!_parseReqHeader(lineStart - sizeof(AsyncWebHeaderView), start, len)){
+      _parseState = PARSE_REQ_FAIL;
+      _client->close();
+    }
   }
 }
 
 size_t AsyncWebServerRequest::headers() const{
-  return _headers.length();
+  size_t count = 0;
+  for(size_t o = _nextHeader(_headersStart); o < _headersEnd; o = _nextHeader(o + _headerView(_arena, o).size))
+    count++;
+  return count;
 }
 
 bool AsyncWebServerRequest::hasHeader(const String& name) const {
-  for(const auto& h: _headers){
-    if(h->name().equalsIgnoreCase(name)){
+  for(size_t o = _nextHeader(_headersStart); o < _headersEnd; o = _nextHeader(o + _headerView(_arena, o).size)){
+    if(!strcasecmp(_headerName(_arena, o, _headerView(_arena, o)), name.c_str())){
       return true;
     }
   }
@@ -619,9 +756,9 @@ bool AsyncWebServerRequest::hasHeader(const __FlashStringHelper * data) const {
 }
 
 AsyncWebHeader* AsyncWebServerRequest::getHeader(const String& name) const {
-  for(const auto& h: _headers){
-    if(h->name().equalsIgnoreCase(name)){
-      return h;
+  for(size_t o = _nextHeader(_headersStart); o < _headersEnd; o = _nextHeader(o + _headerView(_arena, o).size)){
+    if(!strcasecmp(_headerName(_arena, o, _headerView(_arena, o)), name.c_str())){
+      return _headerAt(o);
     }
   }
   return nullptr;
@@ -642,15 +779,20 @@ AsyncWebHeader* AsyncWebServerRequest::getHeader(const __FlashStringHelper * dat
 }
 
 AsyncWebHeader* AsyncWebServerRequest::getHeader(size_t num) const {
-  auto header = _headers.nth(num);
-  return header ? *header : nullptr;
+  for(size_t o = _nextHeader(_headersStart); o < _headersEnd; o = _nextHeader(o + _headerView(_arena, o).size)){
+    if(!num--)
+      return _headerAt(o);
+  }
+  return nullptr;
 }
 
 size_t AsyncWebServerRequest::params() const {
+  _parseQuery();
   return _params.length();
 }
 
 bool AsyncWebServerRequest::hasParam(const String& name, bool post, bool file) const {
+  _parseQuery();
   for(const auto& p: _params){
     if(p->name() == name && p->isPost() == post && p->isFile() == file){
       return true;
@@ -676,6 +818,7 @@ bool AsyncWebServerRequest::hasParam(const __FlashStringHelper * data, bool post
 }
 
 AsyncWebParameter* AsyncWebServerRequest::getParam(const String& name, bool post, bool file) const {
+  _parseQuery();
   for(const auto& p: _params){
     if(p->name() == name && p->isPost() == post && p->isFile() == file){
       return p;
@@ -699,6 +842,7 @@ AsyncWebParameter* AsyncWebServerRequest::getParam(const __FlashStringHelper * d
 }
 
 AsyncWebParameter* AsyncWebServerRequest::getParam(size_t num) const {
+  _parseQuery();
   auto param = _params.nth(num);
   return param ? *param : nullptr;
 }
@@ -862,6 +1006,7 @@ void AsyncWebServerRequest::requestAuthentication(const char * realm, bool isDig
 }
 
 bool AsyncWebServerRequest::hasArg(const char* name) const {
+  _parseQuery();
   for(const auto& arg: _params){
     if(arg->name() == name){
       return true;
@@ -886,6 +1031,7 @@ bool AsyncWebServerRequest::hasArg(const __FlashStringHelper * data) const {
 
 
 const String& AsyncWebServerRequest::arg(const String& name) const {
+  _parseQuery();
   for(const auto& arg: _params){
     if(arg->name() == name){
       return arg->value();
@@ -953,17 +1099,20 @@ const String& AsyncWebServerRequest::headerName(size_t i) const {
 }
 
 String AsyncWebServerRequest::urlDecode(const String& text) const {
+  return _urlDecode(text.c_str(), text.length());
+}
+
+String AsyncWebServerRequest::_urlDecode(const char *text, size_t len) const {
   char temp[] = "0x00";
-  unsigned int len = text.length();
   unsigned int i = 0;
   String decoded = String();
   decoded.reserve(len); // Allocate the string internal buffer - never longer from source text
   while (i < len){
     char decodedChar;
-    char encodedChar = text.charAt(i++);
+    char encodedChar = text[i++];
     if ((encodedChar == '%') && (i + 1 < len)){
-      temp[2] = text.charAt(i++);
-      temp[3] = text.charAt(i++);
+      temp[2] = text[i++];
+      temp[3] = text[i++];
       decodedChar = strtol(temp, NULL, 16);
     } else if (encodedChar == '+') {
       decodedChar = ' ';
@@ -0,0 +1,80 @@
+/*
+  Asynchronous WebServer library for Espressif MCUs
+
+  Copyright (c) 2016 Hristo Gochkov. All rights reserved.
+  This file is part of the esp8266 core for Arduino environment.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#ifndef ASYNCWEBREQUESTARENA_H_
+#define ASYNCWEBREQUESTARENA_H_
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ASYNCWEBSERVER_ARENA_SIZE
+#ifdef ESP32
+#define ASYNCWEBSERVER_ARENA_SIZE 1024
+#else
+#define ASYNCWEBSERVER_ARENA_SIZE 512
+#endif
+#endif
+
+/*
+ * ARENA :: The bytes of one request head, appended as they come and freed at once.
+ * Users keep offsets, the block may move when it grows
+ * */
+
+class AsyncWebRequestArena {
+  private:
+    uint8_t *_data;
+    size_t _length;
+    size_t _capacity;
+
+    bool _grow(size_t length){
+      size_t capacity = _capacity ? _capacity : ASYNCWEBSERVER_ARENA_SIZE;
+      while(capacity < length)
+        capacity *= 2;
+      uint8_t *data = (uint8_t *)realloc(_data, capacity);
+      if(data == NULL)
+        return false;
+      _data = data;
+      _capacity = capacity;
+      return true;
+    }
+
+  public:
+    AsyncWebRequestArena(): _data(NULL), _length(0), _capacity(0) {}
+    ~AsyncWebRequestArena(){ free(_data); }
+
+    //offset of len new bytes (uninitialized when data is NULL), false when out of memory
+    bool append(const void *data, size_t len, size_t *offset = NULL){
+      if(_length + len > _capacity && !_grow(_length + len))
+        return false;
+      if(data)
+        memcpy(_data + _length, data, len);
+      if(offset)
+        *offset = _length;
+      _length += len;
+      return true;
+    }
+    void truncate(size_t length){ if(length < _length) _length = length; }
+    void clear(){ free(_data); _data = NULL; _length = _capacity = 0; }
+
+    uint8_t * at(size_t offset) const { return _data + offset; }
+    size_t length() const { return _length; }
+};
+
+#endif /* ASYNCWEBREQUESTARENA_H_ */
@@ -64,18 +64,50 @@ class AsyncAbstractResponse: public AsyncWebServerResponse {
 #endif
 
 #define TEMPLATE_PARAM_NAME_LENGTH 32
+class AsyncStaticFileCache;
+
+#ifndef ASYNCWEBSERVER_MAX_RANGES
+#define ASYNCWEBSERVER_MAX_RANGES 8   //more ranges in one request get the whole file
+#endif
+
+#ifndef ASYNCWEBSERVER_FILE_ALIGN
+#define ASYNCWEBSERVER_FILE_ALIGN 512 //reads bigger than this end on a multiple of it
+#endif
+
 class AsyncFileResponse: public AsyncAbstractResponse {
   using File = fs::File;
   using FS = fs::FS;
   private:
+    struct Range {
+      size_t start;
+      size_t end; //inclusive
+    };
     File _content;
     String _path;
+    AsyncStaticFileCache *_fileCache;
+    String _cachePath;
+    size_t _position;
+    Range _ranges[ASYNCWEBSERVER_MAX_RANGES];
+    uint8_t _rangeCount;
+    uint8_t _range;
+    size_t _partSent;
+    size_t _fileSize;
+    String _boundary;
+    String _partType;
     void _setContentType(const String& path);
+    bool _ifRangeMatches(AsyncWebServerRequest *request);
+    bool _parseRanges(const String& value);
+    void _setRanges();
+    String _partHead(uint8_t range) const;
+    size_t _read(uint8_t *data, size_t len);
   public:
     AsyncFileResponse(FS &fs, const String& path, const String& contentType=String(), bool download=false, AwsTemplateProcessor callback=nullptr);
     AsyncFileResponse(File content, const String& path, const String& contentType=String(), bool download=false, AwsTemplateProcessor callback=nullptr);
     ~AsyncFileResponse();
+    //hand the file back to cache under cachePath when done, instead of closing it
+    void _setFileCache(AsyncStaticFileCache *cache, const String& cachePath);
     bool _sourceValid() const { return !!(_content); }
+    void _respond(AsyncWebServerRequest *request) override;
     virtual size_t _fillBuffer(uint8_t *buf, size_t maxLen) override;
 };
 
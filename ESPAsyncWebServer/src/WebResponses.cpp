@@ -89,6 +89,7 @@ AsyncWebServerResponse::AsyncWebServerResponse()
   , _contentLength(0)
   , _sendContentLength(true)
   , _chunked(false)
+  , _acceptRanges(false)
   , _headLength(0)
   , _sentLength(0)
   , _ackedLength(0)
@@ -125,7 +126,7 @@ void AsyncWebServerResponse::addHeader(const String& name, const String& value){
 
 String AsyncWebServerResponse::_assembleHead(uint8_t version){
   if(version){
-    addHeader("Accept-Ranges","none");
+    addHeader("Accept-Ranges", _acceptRanges ? "bytes" : "none");
     if(_chunked)
       addHeader("Transfer-Encoding","chunked");
   }
@@ -478,10 +479,23 @@ size_t AsyncAbstractResponse::_fillBufferAndProcessTemplates(uint8_t* data, size
  * */
 
 AsyncFileResponse::~AsyncFileResponse(){
-  if(_content)
+  if(_fileCache){
+    if(_content)
+      _fileCache->give(_cachePath, _content);
+    _fileCache->unref();
+  } else if(_content)
     _content.close();
 }
 
+void AsyncFileResponse::_setFileCache(AsyncStaticFileCache *cache, const String& cachePath){
+  if(_fileCache)
+    _fileCache->unref();
+  _fileCache = cache;
+  _cachePath = cachePath;
+  if(_fileCache)
+    _fileCache->ref();
+}
+
 void AsyncFileResponse::_setContentType(const String& path){
   if (path.endsWith(".html")) _contentType = "text/html";
   else if (path.endsWith(".htm")) _contentType = "text/html";
@@ -504,7 +518,7 @@ void AsyncFileResponse::_setContentType(const String& path){
   else _contentType = "text/plain";
 }
 
-AsyncFileResponse::AsyncFileResponse(FS &fs, const String& path, const String& contentType, bool download, AwsTemplateProcessor callback): AsyncAbstractResponse(callback){
+AsyncFileResponse::AsyncFileResponse(FS &fs, const String& path, const String& contentType, bool download, AwsTemplateProcessor callback): AsyncAbstractResponse(callback), _fileCache(NULL), _position(0), _rangeCount(0), _range(0), _partSent(0), _fileSize(0){
   _code = 200;
   _path = path;
 
@@ -538,7 +552,7 @@ AsyncFileResponse::AsyncFileResponse(FS &fs, const String& path, const String& c
   addHeader("Content-Disposition", buf);
 }
 
-AsyncFileResponse::AsyncFileResponse(File content, const String& path, const String& contentType, bool download, AwsTemplateProcessor callback): AsyncAbstractResponse(callback){
+AsyncFileResponse::AsyncFileResponse(File content, const String& path, const String& contentType, bool download, AwsTemplateProcessor callback): AsyncAbstractResponse(callback), _fileCache(NULL), _position(0), _rangeCount(0), _range(0), _partSent(0), _fileSize(0){
   _code = 200;
   _path = path;
 
@@ -547,6 +561,11 @@ AsyncFileResponse::AsyncFileResponse(File content, const String& path, const Str
     _callback = nullptr; // Unable to process gzipped templates
     _sendContentLength = true;
     _chunked = false;
+  } else if(!download && String(content.name()).endsWith(".br") && !path.endsWith(".br")){
+    addHeader("Content-Encoding", "br");
+    _callback = nullptr;
+    _sendContentLength = true;
+    _chunked = false;
   }
 
   _content = content;
@@ -569,8 +588,169 @@ AsyncFileResponse::AsyncFileResponse(File content, const String& path, const Str
   addHeader("Content-Disposition", buf);
 }
 
+static bool _rangeNumber(const String& value, size_t& number){
+  if(!value.length())
+    return false;
+  char *end;
+  number = strtoul(value.c_str(), &end, 10);
+  return *end == '\0' && isdigit(value[0]);
+}
+
+bool AsyncFileResponse::_ifRangeMatches(AsyncWebServerRequest *request){
+  if(!request->hasHeader("If-Range"))
+    return true;
+  //the validator has to be the current ETag or Last-Modified, or the whole file is sent
+  const String& validator = request->header("If-Range");
+  for(const auto& h: _headers){
+    if((h->name().equalsIgnoreCase("ETag") || h->name().equalsIgnoreCase("Last-Modified")) && h->value() == validator)
+      return true;
+  }
+  return false;
+}
+
+bool AsyncFileResponse::_parseRanges(const String& value){
+  //bytes=first-last, first- and -suffix; false when the header is not understood
+  if(!value.startsWith("bytes="))
+    return false;
+  _rangeCount = 0;
+  int pos = 6;
+  while(pos < (int)value.length()){
+    int comma = value.indexOf(',', pos);
+    if(comma < 0)
+      comma = value.length();
+    String spec = value.substring(pos, comma);
+    pos = comma + 1;
+    spec.trim();
+    if(!spec.length())
+      continue;
+    int dash = spec.indexOf('-');
+    if(dash < 0)
+      return false;
+    String first = spec.substring(0, dash);
+    String last = spec.substring(dash + 1);
+    first.trim();
+    last.trim();
+    size_t start, end;
+    if(!first.length()){
+      if(!_rangeNumber(last, end))
+        return false;
+      if(!end || !_fileSize)
+        continue;
+      start = end < _fileSize ? _fileSize - end : 0;
+      end = _fileSize - 1;
+    } else {
+      if(!_rangeNumber(first, start))
+        return false;
+      if(!last.length())
+        end = SIZE_MAX;
+      else if(!_rangeNumber(last, end))
+        return false;
+      if(end < start)
+        return false;
+      if(start >= _fileSize)
+        continue;
+      if(end >= _fileSize)
+        end = _fileSize - 1;
+    }
+    if(_rangeCount == ASYNCWEBSERVER_MAX_RANGES)
+      return false;
+    _ranges[_rangeCount].start = start;
+    _ranges[_rangeCount].end = end;
+    _rangeCount++;
+  }
+  return true;
+}
+
+String AsyncFileResponse::_partHead(uint8_t range) const {
+  if(range == _rangeCount)
+    return "\r\n--" + _boundary + "--\r\n";
+  char buf[64];
+  snprintf(buf, sizeof(buf), "bytes %u-%u/%u", (unsigned)_ranges[range].start, (unsigned)_ranges[range].end, (unsigned)_fileSize);
+  return "\r\n--" + _boundary + "\r\nContent-Type: " + _partType + "\r\nContent-Range: " + String(buf) + "\r\n\r\n";
+}
+
+void AsyncFileResponse::_setRanges(){
+  char buf[64];
+  if(!_rangeCount){
+    _code = 416;
+    _contentLength = 0;
+    snprintf(buf, sizeof(buf), "bytes */%u", (unsigned)_fileSize);
+    addHeader("Content-Range", buf);
+    return;
+  }
+  _code = 206;
+  if(_rangeCount == 1){
+    _contentLength = _ranges[0].end - _ranges[0].start + 1;
+    snprintf(buf, sizeof(buf), "bytes %u-%u/%u", (unsigned)_ranges[0].start, (unsigned)_ranges[0].end, (unsigned)_fileSize);
+    addHeader("Content-Range", buf);
+  } else {
+    _boundary = "BYTERANGES" + String((uint32_t)random(0x7FFFFFFF), HEX) + String((uint32_t)millis(), HEX);
+    _partType = _contentType;
+    _contentType = "multipart/byteranges; boundary=" + _boundary;
+    _contentLength = 0;
+    for(uint8_t i = 0; i < _rangeCount; i++)
+      _contentLength += _partHead(i).length() + _ranges[i].end - _ranges[i].start + 1;
+    _contentLength += _partHead(_rangeCount).length();
+  }
+  _content.seek(_ranges[0].start);
+  _position = _ranges[0].start;
+}
+
+void AsyncFileResponse::_respond(AsyncWebServerRequest *request){
+  //only plain file bodies can be cut, templates change the length
+  if(_code == 200 && _content && !_callback && _sendContentLength){
+    _acceptRanges = true;
+    _fileSize = _contentLength;
+    if(request->method() == HTTP_GET && request->hasHeader("Range") && _ifRangeMatches(request) && _parseRanges(request->header("Range")))
+      _setRanges();
+    else
+      _rangeCount = 0;
+  }
+  AsyncAbstractResponse::_respond(request);
+}
+
+size_t AsyncFileResponse::_read(uint8_t *data, size_t len){
+  //end big reads on a block boundary, so the following ones start on one
+  if(len > ASYNCWEBSERVER_FILE_ALIGN)
+    len -= (_position + len) % ASYNCWEBSERVER_FILE_ALIGN;
+  size_t read = _content.read(data, len);
+  _position += read;
+  return read;
+}
+
 size_t AsyncFileResponse::_fillBuffer(uint8_t *data, size_t len){
-  return _content.read(data, len);
+  if(_rangeCount < 2)
+    return _read(data, len);
+  //multipart/byteranges: the head of each part, its bytes, and the closing boundary after the last
+  size_t filled = 0;
+  while(filled < len && _range <= _rangeCount){
+    String head = _partHead(_range);
+    if(_partSent < head.length()){
+      size_t l = std::min((size_t)(head.length() - _partSent), len - filled);
+      memcpy(data + filled, head.c_str() + _partSent, l);
+      filled += l;
+      _partSent += l;
+      continue;
+    }
+    if(_range == _rangeCount)
+      break;
+    size_t left = _ranges[_range].end - _ranges[_range].start + 1 - (_partSent - head.length());
+    if(!left){
+      _range++;
+      _partSent = 0;
+      if(_range < _rangeCount && _ranges[_range].start != _position){
+        _content.seek(_ranges[_range].start);
+        _position = _ranges[_range].start;
+      }
+      continue;
+    }
+    size_t read = _read(data + filled, std::min(left, len - filled));
+    if(!read)
+      break;
+    filled += read;
+    _partSent += read;
+  }
+  return filled;
 }
 
 /*
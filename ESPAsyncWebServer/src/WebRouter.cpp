@@ -0,0 +1,201 @@
+/*
+  Asynchronous WebServer library for Espressif MCUs
+
+  Copyright (c) 2016 Hristo Gochkov. All rights reserved.
+  This file is part of the esp8266 core for Arduino environment.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include "WebRouter.h"
+
+AsyncWebRouter::AsyncWebRouter()
+  : _root(NULL)
+  , _any(NULL)
+  , _anyLast(NULL)
+  , _valid(false)
+{}
+
+AsyncWebRouter::~AsyncWebRouter(){
+  clear();
+}
+
+AsyncWebRouter::Node* AsyncWebRouter::_newNode(const String& label){
+  Node* n = new Node();
+  if(n == NULL)
+    return NULL;
+  n->label = label;
+  n->child = NULL;
+  n->next = NULL;
+  n->entries = NULL;
+  n->last = NULL;
+  return n;
+}
+
+void AsyncWebRouter::_append(Entry*& first, Entry*& last, Entry* e){
+  e->next = NULL;
+  if(last)
+    last->next = e;
+  else
+    first = e;
+  last = e;
+}
+
+void AsyncWebRouter::_freeNode(Node* n){
+  while(n){
+    Node* next = n->next;
+    _freeNode(n->child);
+    _freeEntries(n->entries);
+    delete n;
+    n = next;
+  }
+}
+
+void AsyncWebRouter::_freeEntries(Entry* e){
+  while(e){
+    Entry* next = e->next;
+    delete e;
+    e = next;
+  }
+}
+
+void AsyncWebRouter::clear(){
+  _freeNode(_root);
+  _freeEntries(_any);
+  _root = NULL;
+  _any = _anyLast = NULL;
+  _valid = false;
+}
+
+bool AsyncWebRouter::_insert(const String& path, Entry* e){
+  Node* n = _root;
+  size_t pos = 0;
+  while(pos < path.length()){
+    Node* c = n->child;
+    while(c && c->label[0] != path[pos])
+      c = c->next;
+    if(c == NULL){
+      //nothing shares this character, the rest of the path is a new leaf
+      c = _newNode(path.substring(pos));
+      if(c == NULL)
+        return false;
+      c->next = n->child;
+      n->child = c;
+      n = c;
+      break;
+    }
+    size_t common = 1;
+    while(common < c->label.length() && pos + common < path.length() && c->label[common] == path[pos + common])
+      common++;
+    if(common < c->label.length()){
+      //split the edge where the paths part
+      Node* tail = _newNode(c->label.substring(common));
+      if(tail == NULL)
+        return false;
+      tail->child = c->child;
+      tail->entries = c->entries;
+      tail->last = c->last;
+      c->label = c->label.substring(0, common);
+      c->child = tail;
+      c->entries = c->last = NULL;
+    }
+    n = c;
+    pos += common;
+  }
+  _append(n->entries, n->last, e);
+  return true;
+}
+
+bool AsyncWebRouter::build(const LinkedList<AsyncWebHandler*>& handlers){
+  clear();
+  _root = _newNode(String());
+  if(_root == NULL)
+    return false;
+  size_t order = 0;
+  String path;
+  for(const auto& h: handlers){
+    Entry* e = new Entry();
+    if(e == NULL){
+      clear();
+      return false;
+    }
+    e->handler = h;
+    e->order = order++;
+    e->method = HTTP_ANY;
+    //without a route, or out of memory for its nodes, the handler is asked for every request
+    if(!h->route(path, e->type, e->method) || !_insert(path, e))
+      _append(_any, _anyLast, e);
+  }
+  _valid = true;
+  return true;
+}
+
+bool AsyncWebRouter::find(AsyncWebServerRequest *request, AsyncWebHandler*& handler){
+  Entry* found[ASYNCWEBSERVER_ROUTER_CANDIDATES];
+  size_t count = 0;
+  const char * url = request->url().c_str();
+  size_t length = request->url().length();
+  WebRequestMethodComposite method = request->method();
+
+  //every node on the way holds routes that are a prefix of the url
+  Node* n = _root;
+  size_t pos = 0;
+  while(n){
+    for(Entry* e = n->entries; e; e = e->next){
+      if(!(e->method & method))
+        continue;
+      if(e->type == ROUTE_EXACT && pos != length)
+        continue;
+      if(e->type == ROUTE_SEGMENT && pos != length && url[pos] != '/')
+        continue;
+      if(count == ASYNCWEBSERVER_ROUTER_CANDIDATES)
+        return false;
+      //keep them in the order the handlers were added
+      size_t i = count++;
+      while(i && found[i - 1]->order > e->order){
+        found[i] = found[i - 1];
+        i--;
+      }
+      found[i] = e;
+    }
+    if(pos == length)
+      break;
+    Node* c = n->child;
+    while(c && c->label[0] != url[pos])
+      c = c->next;
+    if(c == NULL || strncmp(c->label.c_str(), url + pos, c->label.length()) != 0)
+      break;
+    pos += c->label.length();
+    n = c;
+  }
+
+  //merge with the handlers that have no route
+  Entry* any = _any;
+  size_t i = 0;
+  while(i < count || any){
+    Entry* e;
+    if(any && (i == count || any->order < found[i]->order)){
+      e = any;
+      any = any->next;
+    } else {
+      e = found[i++];
+    }
+    if(e->handler->filter(request) && e->handler->canHandle(request)){
+      handler = e->handler;
+      return true;
+    }
+  }
+  handler = NULL;
+  return true;
+}
@@ -0,0 +1,77 @@
+/*
+  Asynchronous WebServer library for Espressif MCUs
+
+  Copyright (c) 2016 Hristo Gochkov. All rights reserved.
+  This file is part of the esp8266 core for Arduino environment.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#ifndef ASYNCWEBSERVERROUTER_H_
+#define ASYNCWEBSERVERROUTER_H_
+
+#include "ESPAsyncWebServer.h"
+
+//handlers a request can match on its path, beyond that the server asks every handler in turn
+#ifndef ASYNCWEBSERVER_ROUTER_CANDIDATES
+#define ASYNCWEBSERVER_ROUTER_CANDIDATES 16
+#endif
+
+/*
+ * ROUTER :: Radix trie of the handler routes, built from the handler list when it changes.
+ * The handlers found on the path of a request are still asked with filter() and canHandle(),
+ * in the order they were added, so the result is the same as with the plain list
+ * */
+
+class AsyncWebRouter {
+  private:
+    struct Entry {
+      AsyncWebHandler* handler;
+      size_t order;
+      WebRouteType type;
+      WebRequestMethodComposite method;
+      Entry* next;
+    };
+    struct Node {
+      String label;
+      Node* child;
+      Node* next;
+      Entry* entries;
+      Entry* last;
+    };
+
+    Node* _root;
+    Entry* _any; //handlers without a route
+    Entry* _anyLast;
+    bool _valid;
+
+    static Node* _newNode(const String& label);
+    static void _append(Entry*& first, Entry*& last, Entry* e);
+    static void _freeNode(Node* n);
+    static void _freeEntries(Entry* e);
+    bool _insert(const String& path, Entry* e);
+
+  public:
+    AsyncWebRouter();
+    ~AsyncWebRouter();
+
+    void invalidate(){ _valid = false; }
+    bool valid() const { return _valid; }
+    void clear();
+    bool build(const LinkedList<AsyncWebHandler*>& handlers);
+    //false when the handler has to be found on the plain list
+    bool find(AsyncWebServerRequest *request, AsyncWebHandler*& handler);
+};
+
+#endif /* ASYNCWEBSERVERROUTER_H_ */
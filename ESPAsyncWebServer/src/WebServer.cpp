@@ -20,6 +20,7 @@
 */
 #include "ESPAsyncWebServer.h"
 #include "WebHandlerImpl.h"
+#include "WebRouter.h"
 
 bool ON_STA_FILTER(AsyncWebServerRequest *request) {
   return WiFi.localIP() == request->client()->localIP();
@@ -34,6 +35,7 @@ AsyncWebServer::AsyncWebServer(uint16_t port)
   : _server(port)
   , _rewrites(LinkedList<AsyncWebRewrite*>([](AsyncWebRewrite* r){ delete r; }))
   , _handlers(LinkedList<AsyncWebHandler*>([](AsyncWebHandler* h){ delete h; }))
+  , _router(NULL)
 {
   _catchAllHandler = new AsyncCallbackWebHandler();
   if(_catchAllHandler == NULL)
@@ -55,6 +57,7 @@ AsyncWebServer::~AsyncWebServer(){
   reset();  
   end();
   if(_catchAllHandler) delete _catchAllHandler;
+  if(_router) delete _router;
 }
 
 AsyncWebRewrite& AsyncWebServer::addRewrite(AsyncWebRewrite* rewrite){
@@ -72,13 +75,24 @@ AsyncWebRewrite& AsyncWebServer::rewrite(const char* from, const char* to){
 
 AsyncWebHandler& AsyncWebServer::addHandler(AsyncWebHandler* handler){
   _handlers.add(handler);
+  if(_router) _router->invalidate();
   return *handler;
 }
 
 bool AsyncWebServer::removeHandler(AsyncWebHandler *handler){
+  if(_router) _router->invalidate();
   return _handlers.remove(handler);
 }
 
+void AsyncWebServer::enableRouter(bool enable){
+  if(enable && _router == NULL){
+    _router = new AsyncWebRouter();
+  } else if(!enable && _router != NULL){
+    delete _router;
+    _router = NULL;
+  }
+}
+
 void AsyncWebServer::begin(){
   _server.setNoDelay(true);
   _server.begin();
@@ -112,6 +126,18 @@ void AsyncWebServer::_rewriteRequest(AsyncWebServerRequest *request){
 }
 
 void AsyncWebServer::_attachHandler(AsyncWebServerRequest *request){
+  if(_router && (_router->valid() || _router->build(_handlers))){
+    AsyncWebHandler* handler;
+    if(_router->find(request, handler)){
+      if(handler){
+        request->setHandler(handler);
+        return;
+      }
+      request->addInterestingHeader("ANY");
+      request->setHandler(_catchAllHandler);
+      return;
+    }
+  }
   for(const auto& h: _handlers){
     if (h->filter(request) && h->canHandle(request)){
       request->setHandler(h);
@@ -183,6 +209,7 @@ void AsyncWebServer::onRequestBody(ArBodyHandlerFunction fn){
 void AsyncWebServer::reset(){
   _rewrites.free();
   _handlers.free();
+  if(_router) _router->clear();
   
   if (_catchAllHandler != NULL){
     _catchAllHandler->onRequest(NULL);
@@ -13,6 +13,7 @@ int DhcpClass::beginWithDHCP(uint8_t *mac, unsigned long timeout, unsigned long
 	_dhcpT2=0;
 	_timeout = timeout;
 	_responseTimeout = responseTimeout;
+	_pendingCheck = 0;
 
 	// zero out _dhcpMacAddr
 	memset(_dhcpMacAddr, 0, 6);
@@ -23,6 +24,27 @@ int DhcpClass::beginWithDHCP(uint8_t *mac, unsigned long timeout, unsigned long
 	return request_DHCP_lease();
 }
 
+int DhcpClass::startWithDHCP(uint8_t *mac, unsigned long timeout, unsigned long responseTimeout)
+{
+	_dhcpLeaseTime=0;
+	_dhcpT1=0;
+	_dhcpT2=0;
+	_timeout = timeout;
+	_responseTimeout = responseTimeout;
+	_pendingCheck = 0;
+
+	// zero out _dhcpMacAddr
+	memset(_dhcpMacAddr, 0, 6);
+	reset_DHCP_lease();
+
+	memcpy((void*)_dhcpMacAddr, (void*)mac, 6);
+	_dhcp_state = STATE_DHCP_START;
+	if (start_DHCP_check(DHCP_CHECK_BEGIN_FAIL) == DHCP_CHECK_BEGIN_FAIL) {
+		return 0;
+	}
+	return 1;
+}
+
 void DhcpClass::reset_DHCP_lease()
 {
 	// zero out _dhcpSubnetMask, _dhcpGatewayIp, _dhcpLocalIp, _dhcpDhcpServerIp, _dhcpDnsServerIp
@@ -32,8 +54,21 @@ void DhcpClass::reset_DHCP_lease()
 	//return:0 on error, 1 if request is sent and response is received
 int DhcpClass::request_DHCP_lease()
 {
-	uint8_t messageType = 0;
+	int result;
+
+	if (!start_DHCP_lease()) {
+		// Couldn't get a socket
+		return 0;
+	}
+	while ((result = poll_DHCP_lease()) < 0) {
+		delay(50);
+	}
+	return result;
+}
 
+	//return:0 on error, 1 if the socket is open and the request can start
+int DhcpClass::start_DHCP_lease()
+{
 	// Pick an initial transaction ID
 	_dhcpTransactionId = random(1UL, 2000UL);
 	_dhcpInitialTransactionId = _dhcpTransactionId;
@@ -46,72 +81,107 @@ int DhcpClass::request_DHCP_lease()
 
 	presend_DHCP();
 
-	int result = 0;
-
-	unsigned long startTime = millis();
+	_requestStartMillis = millis();
+	return 1;
+}
 
-	while (_dhcp_state != STATE_DHCP_LEASED) {
-		if (_dhcp_state == STATE_DHCP_START) {
-			_dhcpTransactionId++;
-			send_DHCP_MESSAGE(DHCP_DISCOVER, ((millis() - startTime) / 1000));
-			_dhcp_state = STATE_DHCP_DISCOVER;
-		} else if (_dhcp_state == STATE_DHCP_REREQUEST) {
-			_dhcpTransactionId++;
-			send_DHCP_MESSAGE(DHCP_REQUEST, ((millis() - startTime)/1000));
+	//return:-1 while waiting, 0 on error, 1 if request is sent and response is received
+	//Sends or reads at most one message, so it never waits for the network
+int DhcpClass::poll_DHCP_lease()
+{
+	uint8_t messageType = 0;
+	int result = -1;
+	unsigned long elapsed = millis() - _requestStartMillis;
+
+	if (_dhcp_state == STATE_DHCP_START) {
+		_dhcpTransactionId++;
+		send_DHCP_MESSAGE(DHCP_DISCOVER, (elapsed / 1000));
+		_dhcp_state = STATE_DHCP_DISCOVER;
+	} else if (_dhcp_state == STATE_DHCP_REREQUEST) {
+		_dhcpTransactionId++;
+		send_DHCP_MESSAGE(DHCP_REQUEST, (elapsed / 1000));
+		_dhcp_state = STATE_DHCP_REQUEST;
+	} else if (_dhcp_state == STATE_DHCP_DISCOVER) {
+		uint32_t respId;
+		messageType = readDHCPResponse(respId);
+		if (messageType == DHCP_OFFER) {
+			// We'll use the transaction ID that the offer came with,
+			// rather than the one we were up to
+			_dhcpTransactionId = respId;
+			send_DHCP_MESSAGE(DHCP_REQUEST, (elapsed / 1000));
 			_dhcp_state = STATE_DHCP_REQUEST;
-		} else if (_dhcp_state == STATE_DHCP_DISCOVER) {
-			uint32_t respId;
-			messageType = parseDHCPResponse(_responseTimeout, respId);
-			if (messageType == DHCP_OFFER) {
-				// We'll use the transaction ID that the offer came with,
-				// rather than the one we were up to
-				_dhcpTransactionId = respId;
-				send_DHCP_MESSAGE(DHCP_REQUEST, ((millis() - startTime) / 1000));
-				_dhcp_state = STATE_DHCP_REQUEST;
+		}
+	} else if (_dhcp_state == STATE_DHCP_REQUEST) {
+		uint32_t respId;
+		messageType = readDHCPResponse(respId);
+		if (messageType == DHCP_ACK) {
+			_dhcp_state = STATE_DHCP_LEASED;
+			result = 1;
+			//use default lease time if we didn't get it
+			if (_dhcpLeaseTime == 0) {
+				_dhcpLeaseTime = DEFAULT_LEASE;
 			}
-		} else if (_dhcp_state == STATE_DHCP_REQUEST) {
-			uint32_t respId;
-			messageType = parseDHCPResponse(_responseTimeout, respId);
-			if (messageType == DHCP_ACK) {
-				_dhcp_state = STATE_DHCP_LEASED;
-				result = 1;
-				//use default lease time if we didn't get it
-				if (_dhcpLeaseTime == 0) {
-					_dhcpLeaseTime = DEFAULT_LEASE;
-				}
-				// Calculate T1 & T2 if we didn't get it
-				if (_dhcpT1 == 0) {
-					// T1 should be 50% of _dhcpLeaseTime
-					_dhcpT1 = _dhcpLeaseTime >> 1;
-				}
-				if (_dhcpT2 == 0) {
-					// T2 should be 87.5% (7/8ths) of _dhcpLeaseTime
-					_dhcpT2 = _dhcpLeaseTime - (_dhcpLeaseTime >> 3);
-				}
-				_renewInSec = _dhcpT1;
-				_rebindInSec = _dhcpT2;
-			} else if (messageType == DHCP_NAK) {
-				_dhcp_state = STATE_DHCP_START;
+			// Calculate T1 & T2 if we didn't get it
+			if (_dhcpT1 == 0) {
+				// T1 should be 50% of _dhcpLeaseTime
+				_dhcpT1 = _dhcpLeaseTime >> 1;
 			}
-		}
-
-		if (messageType == 255) {
-			messageType = 0;
+			if (_dhcpT2 == 0) {
+				// T2 should be 87.5% (7/8ths) of _dhcpLeaseTime
+				_dhcpT2 = _dhcpLeaseTime - (_dhcpLeaseTime >> 3);
+			}
+			_renewInSec = _dhcpT1;
+			_rebindInSec = _dhcpT2;
+		} else if (messageType == DHCP_NAK) {
 			_dhcp_state = STATE_DHCP_START;
 		}
+	}
 
-		if (result != 1 && ((millis() - startTime) > _timeout))
-			break;
+	if (messageType == 255) {
+		messageType = 0;
+		_dhcp_state = STATE_DHCP_START;
 	}
 
-	// We're done with the socket now
-	_dhcpUdpSocket.stop();
-	_dhcpTransactionId++;
+	if (result != 1 && ((millis() - _requestStartMillis) > _timeout))
+		result = 0;
 
-	_lastCheckLeaseMillis = millis();
+	if (result >= 0) {
+		// We're done with the socket now
+		_dhcpUdpSocket.stop();
+		_dhcpTransactionId++;
+
+		_lastCheckLeaseMillis = millis();
+	}
 	return result;
 }
 
+	//return:failCode if the request couldn't be started, else what poll_DHCP_check returns
+int DhcpClass::start_DHCP_check(uint8_t failCode)
+{
+	if (!start_DHCP_lease()) {
+		return failCode;
+	}
+	_pendingCheck = failCode;
+	return poll_DHCP_check();
+}
+
+	//return:DHCP_CHECK_NONE while the request is in progress, then
+	//the fail code it was started with, or the matching OK code
+int DhcpClass::poll_DHCP_check()
+{
+	int result = poll_DHCP_lease();
+	if (result < 0) return DHCP_CHECK_NONE;
+
+	int rc = _pendingCheck + result;
+	if (result == 0 && _pendingCheck == DHCP_CHECK_RENEW_FAIL) {
+		// The lease is still good until it's time to rebind,
+		// so carry on using it and try renewing again
+		_dhcp_state = STATE_DHCP_LEASED;
+	}
+	_pendingCheck = 0;
+	return rc;
+}
+
 void DhcpClass::presend_DHCP()
 {
 }
@@ -231,21 +301,27 @@ void DhcpClass::send_DHCP_MESSAGE(uint8_t messageType, uint16_t secondsElapsed)
 	_dhcpUdpSocket.write(buffer, 9);
 
 	_dhcpUdpSocket.endPacket();
+	_lastSendMillis = millis();
 }
 
-uint8_t DhcpClass::parseDHCPResponse(unsigned long responseTimeout, uint32_t& transactionId)
+	//return:0 if nothing has arrived yet, 255 if the response timed out,
+	//else the type of the message received
+uint8_t DhcpClass::readDHCPResponse(uint32_t& transactionId)
 {
-	uint8_t type = 0;
-	uint8_t opt_len = 0;
-
-	unsigned long startTime = millis();
-
-	while (_dhcpUdpSocket.parsePacket() <= 0) {
-		if ((millis() - startTime) > responseTimeout) {
+	if (_dhcpUdpSocket.parsePacket() <= 0) {
+		if ((millis() - _lastSendMillis) > _responseTimeout) {
 			return 255;
 		}
-		delay(50);
+		return 0;
 	}
+	return parseDHCPResponse(transactionId);
+}
+
+uint8_t DhcpClass::parseDHCPResponse(uint32_t& transactionId)
+{
+	uint8_t type = 0;
+	uint8_t opt_len = 0;
+
 	// start reading in the packet
 	RIP_MSG_FIXED fixedMsg;
 	_dhcpUdpSocket.read((uint8_t*)&fixedMsg, sizeof(RIP_MSG_FIXED));
@@ -348,6 +424,10 @@ uint8_t DhcpClass::parseDHCPResponse(unsigned long responseTimeout, uint32_t& tr
     2/DHCP_CHECK_RENEW_OK: renew success
     3/DHCP_CHECK_REBIND_FAIL: rebind fail
     4/DHCP_CHECK_REBIND_OK: rebind success
+    5/DHCP_CHECK_BEGIN_FAIL: startWithDHCP failed
+    6/DHCP_CHECK_BEGIN_OK: startWithDHCP success
+    Renewing and rebinding are carried on over several calls, none of which
+    waits for the network; the result comes from the call that finishes.
 */
 int DhcpClass::checkLease()
 {
@@ -378,10 +458,9 @@ int DhcpClass::checkLease()
 		}
 	}
 
-	// if we have a lease but should renew, do it
-	if (_renewInSec == 0 &&_dhcp_state == STATE_DHCP_LEASED) {
-		_dhcp_state = STATE_DHCP_REREQUEST;
-		rc = 1 + request_DHCP_lease();
+	// carry on with a request that is already in progress
+	if (_pendingCheck) {
+		return poll_DHCP_check();
 	}
 
 	// if we have a lease or is renewing but should bind, do it
@@ -390,7 +469,11 @@ int DhcpClass::checkLease()
 		// this should basically restart completely
 		_dhcp_state = STATE_DHCP_START;
 		reset_DHCP_lease();
-		rc = 3 + request_DHCP_lease();
+		rc = start_DHCP_check(DHCP_CHECK_REBIND_FAIL);
+	// if we have a lease but should renew, do it
+	} else if (_renewInSec == 0 &&_dhcp_state == STATE_DHCP_LEASED) {
+		_dhcp_state = STATE_DHCP_REREQUEST;
+		rc = start_DHCP_check(DHCP_CHECK_RENEW_FAIL);
 	}
 	return rc;
 }
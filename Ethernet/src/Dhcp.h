@@ -50,6 +50,8 @@
 #define DHCP_CHECK_RENEW_OK     (2)
 #define DHCP_CHECK_REBIND_FAIL  (3)
 #define DHCP_CHECK_REBIND_OK    (4)
+#define DHCP_CHECK_BEGIN_FAIL   (5)
+#define DHCP_CHECK_BEGIN_OK     (6)
 
 enum
 {
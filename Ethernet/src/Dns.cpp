@@ -44,10 +44,89 @@
 #define TRUNCATED        -3
 #define INVALID_RESPONSE -4
 
+// States of a resolution started with beginResolve
+#define RESOLVE_IDLE     0
+#define RESOLVE_WAITING  1
+#define RESOLVE_DONE     2
+
+#if DNS_CACHE_SIZE > 0
+typedef struct {
+	char name[DNS_CACHE_NAME_SIZE];
+	uint8_t address[4];
+	uint32_t stored; // millis() when the answer arrived
+	uint32_t ttl;    // how long it may be used for, in ms
+} dnscache_t;
+
+static dnscache_t cache[DNS_CACHE_SIZE];
+#endif
+
 void DNSClient::begin(const IPAddress& aDNSServer)
 {
 	iDNSServer = aDNSServer;
 	iRequestId = 0;
+	iResolveState = RESOLVE_IDLE;
+}
+
+void DNSClient::clearCache()
+{
+#if DNS_CACHE_SIZE > 0
+	for (uint8_t i=0; i < DNS_CACHE_SIZE; i++) {
+		cache[i].name[0] = 0;
+	}
+#endif
+}
+
+bool DNSClient::cacheLookup(const char* aName, IPAddress& aAddress)
+{
+#if DNS_CACHE_SIZE > 0
+	uint32_t now = millis();
+	for (uint8_t i=0; i < DNS_CACHE_SIZE; i++) {
+		if (cache[i].name[0] == 0) continue;
+		if ((now - cache[i].stored) >= cache[i].ttl) {
+			// Expired
+			cache[i].name[0] = 0;
+			continue;
+		}
+		if (strcasecmp(cache[i].name, aName) == 0) {
+			aAddress = IPAddress(cache[i].address[0], cache[i].address[1],
+			  cache[i].address[2], cache[i].address[3]);
+			return true;
+		}
+	}
+#endif
+	return false;
+}
+
+void DNSClient::cacheStore(const char* aName, const IPAddress& aAddress, uint32_t aTTL)
+{
+#if DNS_CACHE_SIZE > 0
+	if (aTTL == 0 || strlen(aName) >= DNS_CACHE_NAME_SIZE) return;
+	if (aTTL > DNS_CACHE_MAX_TTL) aTTL = DNS_CACHE_MAX_TTL;
+
+	// Use the entry for this name if there is one, else an empty one,
+	// else the one closest to expiring
+	uint32_t now = millis();
+	uint8_t slot = 0;
+	uint32_t slotleft = 0xFFFFFFFF;
+	for (uint8_t i=0; i < DNS_CACHE_SIZE; i++) {
+		uint32_t age = now - cache[i].stored;
+		uint32_t left = (cache[i].name[0] == 0 || age >= cache[i].ttl) ? 0 : cache[i].ttl - age;
+		if (left > 0 && strcasecmp(cache[i].name, aName) == 0) {
+			slot = i;
+			break;
+		}
+		if (left < slotleft) {
+			slot = i;
+			slotleft = left;
+		}
+	}
+	strcpy(cache[slot].name, aName);
+	for (uint8_t i=0; i < 4; i++) {
+		cache[slot].address[i] = aAddress[i];
+	}
+	cache[slot].stored = now;
+	cache[slot].ttl = aTTL * 1000;
+#endif
 }
 
 
@@ -95,6 +174,11 @@ int DNSClient::getHostByName(const char* aHostname, IPAddress& aResult, uint16_t
 		return 1;
 	}
 
+	// See if we've looked it up recently
+	if (cacheLookup(aHostname, aResult)) {
+		return 1;
+	}
+
 	// Check we've got a valid DNS server to use
 	if (iDNSServer == INADDR_NONE) {
 		return INVALID_SERVER;
@@ -106,22 +190,18 @@ int DNSClient::getHostByName(const char* aHostname, IPAddress& aResult, uint16_t
 		int retries = 0;
 		// while ((retries < 3) && (ret <= 0)) {
 		// Send DNS request
-		ret = iUdp.beginPacket(iDNSServer, DNS_PORT);
+		ret = SendRequest(aHostname);
 		if (ret != 0) {
-			// Now output the request data
-			ret = BuildRequest(aHostname);
-			if (ret != 0) {
-				// And finally send the request
-				ret = iUdp.endPacket();
-				if (ret != 0) {
-					// Now wait for a response
-					int wait_retries = 0;
-					ret = TIMED_OUT;
-					while ((wait_retries < 3) && (ret == TIMED_OUT)) {
-						ret = ProcessResponse(timeout, aResult);
-						wait_retries++;
-					}
-				}
+			// Now wait for a response
+			int wait_retries = 0;
+			uint32_t ttl;
+			ret = TIMED_OUT;
+			while ((wait_retries < 3) && (ret == TIMED_OUT)) {
+				ret = ProcessResponse(timeout, aResult, ttl);
+				wait_retries++;
+			}
+			if (ret == SUCCESS) {
+				cacheStore(aHostname, aResult, ttl);
 			}
 		}
 		retries++;
@@ -134,6 +214,92 @@ int DNSClient::getHostByName(const char* aHostname, IPAddress& aResult, uint16_t
 	return ret;
 }
 
+int DNSClient::beginResolve(const char* aHostname, uint16_t timeout)
+{
+	if (iResolveState == RESOLVE_WAITING) {
+		// Give up on the previous one
+		iUdp.stop();
+	}
+	iResolveState = RESOLVE_IDLE;
+	iResolveName = aHostname;
+	iResolveTimeout = timeout;
+
+	// Numeric addresses and cached names are answered straight away
+	if (inet_aton(aHostname, iResolveResult) || cacheLookup(aHostname, iResolveResult)) {
+		iResolveState = RESOLVE_DONE;
+		return SUCCESS;
+	}
+
+	// Check we've got a valid DNS server to use
+	if (iDNSServer == INADDR_NONE) {
+		return INVALID_SERVER;
+	}
+
+	// Find a socket to use
+	if (iUdp.begin(1024+(millis() & 0xF)) != 1) {
+		return 0;
+	}
+	int ret = SendRequest(aHostname);
+	if (ret != 1) {
+		iUdp.stop();
+		return ret;
+	}
+	iResolveTries = 1;
+	iResolveStart = millis();
+	iResolveState = RESOLVE_WAITING;
+	return SUCCESS;
+}
+
+int DNSClient::checkResolve(IPAddress& aResult)
+{
+	if (iResolveState == RESOLVE_DONE) {
+		aResult = iResolveResult;
+		iResolveState = RESOLVE_IDLE;
+		return SUCCESS;
+	}
+	if (iResolveState != RESOLVE_WAITING) {
+		// Nothing is being resolved
+		return INVALID_RESPONSE;
+	}
+
+	if (iUdp.parsePacket() > 0) {
+		uint32_t ttl;
+		int ret = ParseResponse(iResolveResult, ttl);
+		if (ret == INVALID_SERVER || ret == INVALID_RESPONSE) {
+			// Not the answer to our request, keep waiting
+			return 0;
+		}
+		iUdp.stop();
+		iResolveState = RESOLVE_IDLE;
+		if (ret == SUCCESS) {
+			cacheStore(iResolveName, iResolveResult, ttl);
+			aResult = iResolveResult;
+		}
+		return ret;
+	}
+
+	if ((millis() - iResolveStart) > iResolveTimeout) {
+		if (iResolveTries >= 3 || SendRequest(iResolveName) != 1) {
+			iUdp.stop();
+			iResolveState = RESOLVE_IDLE;
+			return TIMED_OUT;
+		}
+		// Asked again, answers to the earlier requests are now ignored
+		iResolveTries++;
+		iResolveStart = millis();
+	}
+	return 0;
+}
+
+int DNSClient::SendRequest(const char* aName)
+{
+	if (iUdp.beginPacket(iDNSServer, DNS_PORT) == 0) return 0;
+	// Now output the request data
+	if (BuildRequest(aName) == 0) return 0;
+	// And finally send the request
+	return iUdp.endPacket();
+}
+
 uint16_t DNSClient::BuildRequest(const char* aName)
 {
 	// Build header
@@ -211,7 +377,7 @@ uint16_t DNSClient::BuildRequest(const char* aName)
 }
 
 
-uint16_t DNSClient::ProcessResponse(uint16_t aTimeout, IPAddress& aAddress)
+int DNSClient::ProcessResponse(uint16_t aTimeout, IPAddress& aAddress, uint32_t& aTTL)
 {
 	uint32_t startTime = millis();
 
@@ -223,6 +389,11 @@ uint16_t DNSClient::ProcessResponse(uint16_t aTimeout, IPAddress& aAddress)
 		delay(50);
 	}
 
+	return ParseResponse(aAddress, aTTL);
+}
+
+int DNSClient::ParseResponse(IPAddress& aAddress, uint32_t& aTTL)
+{
 	// We've had a reply!
 	// Read the UDP header
 	//uint8_t header[DNS_HEADER_SIZE]; // Enough space to reuse for the DNS header
@@ -322,8 +493,11 @@ uint16_t DNSClient::ProcessResponse(uint16_t aTimeout, IPAddress& aAddress)
 		iUdp.read((uint8_t*)&answerType, sizeof(answerType));
 		iUdp.read((uint8_t*)&answerClass, sizeof(answerClass));
 
-		// Ignore the Time-To-Live as we don't do any caching
-		iUdp.read((uint8_t *)NULL, TTL_SIZE); // don't care about the returned bytes
+		// Read the Time-To-Live, for the cache
+		uint8_t ttl[TTL_SIZE];
+		iUdp.read(ttl, TTL_SIZE);
+		aTTL = ((uint32_t)ttl[0] << 24) | ((uint32_t)ttl[1] << 16) |
+		  ((uint32_t)ttl[2] << 8) | ttl[3];
 
 		// And read out the length of this answer
 		// Don't need header_flags anymore, so we can reuse it here
@@ -7,6 +7,26 @@
 
 #include "Ethernet.h"
 
+// Number of answers kept, shared by all DNSClient objects.  Each entry takes
+// DNS_CACHE_NAME_SIZE + 12 bytes of RAM.  0 turns the cache off.
+#ifndef DNS_CACHE_SIZE
+#if defined(RAMEND) && defined(RAMSTART) && ((RAMEND - RAMSTART) <= 2048)
+#define DNS_CACHE_SIZE 1
+#else
+#define DNS_CACHE_SIZE 4
+#endif
+#endif
+
+// Longest host name (including the terminating 0) that gets cached
+#ifndef DNS_CACHE_NAME_SIZE
+#define DNS_CACHE_NAME_SIZE 40
+#endif
+
+// Answers are kept for their TTL, but never longer than this (in seconds)
+#ifndef DNS_CACHE_MAX_TTL
+#define DNS_CACHE_MAX_TTL 3600
+#endif
+
 class DNSClient
 {
 public:
@@ -28,13 +48,47 @@ public:
 	*/
 	int getHostByName(const char* aHostname, IPAddress& aResult, uint16_t timeout=5000);
 
+	/** Start resolving the given hostname without waiting for the answer.
+	    Call checkResolve() from loop() to find out when it has arrived.
+	    aHostname must stay valid until then.
+	    @param aHostname Name to be resolved
+	    @param timeout How long to wait for each of up to 3 attempts, in ms
+	    @result 1 if the request was started (or already answered from
+	            the cache), else error code
+	*/
+	int beginResolve(const char* aHostname, uint16_t timeout=5000);
+
+	/** Check on a name resolution started with beginResolve().
+	    @param aResult IPAddress structure to store the returned IP address
+	    @result 1 if aResult now holds the address, 0 if still waiting,
+	            else error code
+	*/
+	int checkResolve(IPAddress& aResult);
+
+	/** Forget all cached answers
+	*/
+	static void clearCache();
+
 protected:
 	uint16_t BuildRequest(const char* aName);
-	uint16_t ProcessResponse(uint16_t aTimeout, IPAddress& aAddress);
+	int SendRequest(const char* aName);
+	int ProcessResponse(uint16_t aTimeout, IPAddress& aAddress, uint32_t& aTTL);
+	int ParseResponse(IPAddress& aAddress, uint32_t& aTTL);
+
+	static bool cacheLookup(const char* aName, IPAddress& aAddress);
+	static void cacheStore(const char* aName, const IPAddress& aAddress, uint32_t aTTL);
 
 	IPAddress iDNSServer;
 	uint16_t iRequestId;
 	EthernetUDP iUdp;
+
+	// State of a resolution started with beginResolve()
+	const char* iResolveName;
+	IPAddress iResolveResult;
+	uint32_t iResolveStart;
+	uint16_t iResolveTimeout;
+	uint8_t iResolveTries;
+	uint8_t iResolveState;
 };
 
 #endif
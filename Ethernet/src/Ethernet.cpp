@@ -25,10 +25,11 @@
 
 IPAddress EthernetClass::_dnsServerAddress;
 DhcpClass* EthernetClass::_dhcp = NULL;
+// shared by begin() and startDHCP()
+static DhcpClass s_dhcp;
 
 int EthernetClass::begin(uint8_t *mac, unsigned long timeout, unsigned long responseTimeout)
 {
-	static DhcpClass s_dhcp;
 	_dhcp = &s_dhcp;
 
 	// Initialise the basic info
@@ -54,6 +55,21 @@ int EthernetClass::begin(uint8_t *mac, unsigned long timeout, unsigned long resp
 	return ret;
 }
 
+int EthernetClass::startDHCP(uint8_t *mac, unsigned long timeout, unsigned long responseTimeout)
+{
+	_dhcp = &s_dhcp;
+
+	// Initialise the basic info
+	if (W5100.init() == 0) return 0;
+	SPI.beginTransaction(SPI_ETHERNET_SETTINGS);
+	W5100.setMACAddress(mac);
+	W5100.setIPAddress(IPAddress(0,0,0,0).raw_address());
+	SPI.endTransaction();
+
+	// Send the first DHCP message, maintain() takes care of the rest
+	return _dhcp->startWithDHCP(mac, timeout, responseTimeout);
+}
+
 void EthernetClass::begin(uint8_t *mac, IPAddress ip)
 {
 	// Assume the DNS server will be the machine on the same network as the local IP
@@ -127,6 +143,7 @@ int EthernetClass::maintain()
 			break;
 		case DHCP_CHECK_RENEW_OK:
 		case DHCP_CHECK_REBIND_OK:
+		case DHCP_CHECK_BEGIN_OK:
 			//we might have got a new IP.
 			SPI.beginTransaction(SPI_ETHERNET_SETTINGS);
 			W5100.setIPAddress(_dhcp->getLocalIp().raw_address());
@@ -134,6 +151,7 @@ int EthernetClass::maintain()
 			W5100.setSubnetMask(_dhcp->getSubnetMask().raw_address());
 			SPI.endTransaction();
 			_dnsServerAddress = _dhcp->getDnsServerIp();
+			if (rc == DHCP_CHECK_BEGIN_OK) socketPortRand(micros());
 			break;
 		default:
 			//this is actually an error, it will retry though
@@ -224,6 +242,14 @@ void EthernetClass::setRetransmissionCount(uint8_t num)
 	SPI.endTransaction();
 }
 
+int EthernetClass::setBufferSizes(const uint8_t *txKB, const uint8_t *rxKB)
+{
+	SPI.beginTransaction(SPI_ETHERNET_SETTINGS);
+	int ret = W5100.setBufferSizes(txKB, rxKB);
+	SPI.endTransaction();
+	return ret;
+}
+
 
 
 
@@ -80,6 +80,11 @@ public:
 	// gain the rest of the configuration through DHCP.
 	// Returns 0 if the DHCP configuration failed, and 1 if it succeeded
 	static int begin(uint8_t *mac, unsigned long timeout = 60000, unsigned long responseTimeout = 4000);
+	// Same as begin(), but returns straight away.  The DHCP exchange is
+	// carried on by maintain(), which returns DHCP_CHECK_BEGIN_OK once the
+	// configuration is in place (or DHCP_CHECK_BEGIN_FAIL).
+	// Returns 0 if it couldn't be started, and 1 if it was
+	static int startDHCP(uint8_t *mac, unsigned long timeout = 60000, unsigned long responseTimeout = 4000);
 	static int maintain();
 	static EthernetLinkStatus linkStatus();
 	static EthernetHardwareStatus hardwareStatus();
@@ -104,6 +109,11 @@ public:
 	void setDnsServerIP(const IPAddress dns_server) { _dnsServerAddress = dns_server; }
 	void setRetransmissionTimeout(uint16_t milliseconds);
 	void setRetransmissionCount(uint8_t num);
+	// Give each socket its own share of the chip's buffer memory, in KB.
+	// Sockets are handed out lowest number first, so the first connection
+	// opened after this gets socket 0.  Returns 0 if the chip can't take
+	// these sizes.  Call after begin() and before opening any connection.
+	int setBufferSizes(const uint8_t *txKB, const uint8_t *rxKB);
 
 	friend class EthernetClient;
 	friend class EthernetServer;
@@ -295,16 +305,25 @@ private:
 	unsigned long _timeout;
 	unsigned long _responseTimeout;
 	unsigned long _lastCheckLeaseMillis;
+	unsigned long _requestStartMillis;
+	unsigned long _lastSendMillis;
 	uint8_t _dhcp_state;
+	// DHCP_CHECK_*_FAIL code of the request in progress, 0 if none
+	uint8_t _pendingCheck;
 	EthernetUDP _dhcpUdpSocket;
 
 	int request_DHCP_lease();
+	int start_DHCP_lease();
+	int poll_DHCP_lease();
+	int start_DHCP_check(uint8_t failCode);
+	int poll_DHCP_check();
 	void reset_DHCP_lease();
 	void presend_DHCP();
 	void send_DHCP_MESSAGE(uint8_t, uint16_t);
 	void printByte(char *, uint8_t);
 
-	uint8_t parseDHCPResponse(unsigned long responseTimeout, uint32_t& transactionId);
+	uint8_t readDHCPResponse(uint32_t& transactionId);
+	uint8_t parseDHCPResponse(uint32_t& transactionId);
 public:
 	IPAddress getLocalIp();
 	IPAddress getSubnetMask();
@@ -313,6 +332,7 @@ public:
 	IPAddress getDnsServerIp();
 
 	int beginWithDHCP(uint8_t *, unsigned long timeout = 60000, unsigned long responseTimeout = 4000);
+	int startWithDHCP(uint8_t *, unsigned long timeout = 60000, unsigned long responseTimeout = 4000);
 	int checkLease();
 };
 
@@ -35,7 +35,7 @@ int EthernetClient::connect(const char * host, uint16_t port)
 		_sockindex = MAX_SOCK_NUM;
 	}
 	dns.begin(Ethernet.dnsServerIP());
-	if (!dns.getHostByName(host, remote_addr)) return 0; // TODO: use _timeout
+	if (dns.getHostByName(host, remote_addr) != 1) return 0; // TODO: use _timeout
 	return connect(remote_addr, port);
 }
 
@@ -125,7 +125,7 @@ void EthernetClient::flush()
 	while (_sockindex < MAX_SOCK_NUM) {
 		uint8_t stat = Ethernet.socketStatus(_sockindex);
 		if (stat != SnSR::ESTABLISHED && stat != SnSR::CLOSE_WAIT) return;
-		if (Ethernet.socketSendAvailable(_sockindex) >= W5100.SSIZE) return;
+		if (Ethernet.socketSendAvailable(_sockindex) >= W5100.SSIZE(_sockindex)) return;
 	}
 }
 
@@ -75,6 +75,8 @@ uint8_t EthernetClass::socketBegin(uint8_t protocol, uint16_t port)
 	// look at all the hardware sockets, use any that are closed (unused)
 	for (s=0; s < maxindex; s++) {
 		status[s] = W5100.readSnSR(s);
+		// sockets without buffer memory can't be used
+		if (!W5100.SSIZE(s) || !W5100.RSIZE(s)) continue;
 		if (status[s] == SnSR::CLOSED) goto makesocket;
 	}
 	//Serial.printf("W5000socket step2\n");
@@ -139,6 +141,8 @@ uint8_t EthernetClass::socketBeginMulticast(uint8_t protocol, IPAddress ip, uint
 	// look at all the hardware sockets, use any that are closed (unused)
 	for (s=0; s < maxindex; s++) {
 		status[s] = W5100.readSnSR(s);
+		// sockets without buffer memory can't be used
+		if (!W5100.SSIZE(s) || !W5100.RSIZE(s)) continue;
 		if (status[s] == SnSR::CLOSED) goto makesocket;
 	}
 	//Serial.printf("W5000socket step2\n");
@@ -281,22 +285,8 @@ static uint16_t getSnRX_RSR(uint8_t s)
 
 static void read_data(uint8_t s, uint16_t src, uint8_t *dst, uint16_t len)
 {
-	uint16_t size;
-	uint16_t src_mask;
-	uint16_t src_ptr;
-
 	//Serial.printf("read_data, len=%d, at:%d\n", len, src);
-	src_mask = (uint16_t)src & W5100.SMASK;
-	src_ptr = W5100.RBASE(s) + src_mask;
-
-	if (W5100.hasOffsetAddressMapping() || src_mask + len <= W5100.SSIZE) {
-		W5100.read(src_ptr, dst, len);
-	} else {
-		size = W5100.SSIZE - src_mask;
-		W5100.read(src_ptr, dst, size);
-		dst += size;
-		W5100.read(W5100.RBASE(s), dst, len - size);
-	}
+	W5100.readSnRX(s, src, dst, len);
 }
 
 // Receive data.  Returns size, or -1 for no data, or 0 if connection closed
@@ -368,7 +358,7 @@ uint8_t EthernetClass::socketPeek(uint8_t s)
 	uint8_t b;
 	SPI.beginTransaction(SPI_ETHERNET_SETTINGS);
 	uint16_t ptr = state[s].RX_RD;
-	W5100.read((ptr & W5100.SMASK) + W5100.RBASE(s), &b, 1);
+	W5100.readSnRX(s, ptr, &b, 1);
 	SPI.endTransaction();
 	return b;
 }
@@ -399,17 +389,7 @@ static void write_data(uint8_t s, uint16_t data_offset, const uint8_t *data, uin
 {
 	uint16_t ptr = W5100.readSnTX_WR(s);
 	ptr += data_offset;
-	uint16_t offset = ptr & W5100.SMASK;
-	uint16_t dstAddr = offset + W5100.SBASE(s);
-
-	if (W5100.hasOffsetAddressMapping() || offset + len <= W5100.SSIZE) {
-		W5100.write(dstAddr, data, len);
-	} else {
-		// Wrap around circular buffer
-		uint16_t size = W5100.SSIZE - offset;
-		W5100.write(dstAddr, data, size);
-		W5100.write(W5100.SBASE(s), data + size, len - size);
-	}
+	W5100.writeSnTX(s, ptr, data, len);
 	ptr += len;
 	W5100.writeSnTX_WR(s, ptr);
 }
@@ -425,8 +405,8 @@ uint16_t EthernetClass::socketSend(uint8_t s, const uint8_t * buf, uint16_t len)
 	uint16_t ret=0;
 	uint16_t freesize=0;
 
-	if (len > W5100.SSIZE) {
-		ret = W5100.SSIZE; // check size not to exceed MAX size.
+	if (len > W5100.SSIZE(s)) {
+		ret = W5100.SSIZE(s); // check size not to exceed MAX size.
 	} else {
 		ret = len;
 	}
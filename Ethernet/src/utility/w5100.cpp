@@ -53,10 +53,8 @@
 uint8_t  W5100Class::chip = 0;
 uint8_t  W5100Class::CH_BASE_MSB;
 uint8_t  W5100Class::ss_pin = SS_PIN_DEFAULT;
-#ifdef ETHERNET_LARGE_BUFFERS
-uint16_t W5100Class::SSIZE = 2048;
-uint16_t W5100Class::SMASK = 0x07FF;
-#endif
+uint8_t  W5100Class::tx_kb[MAX_SOCK_NUM];
+uint8_t  W5100Class::rx_kb[MAX_SOCK_NUM];
 W5100Class W5100;
 
 // pointers and bitmasks for optimized SS pin
@@ -112,51 +110,11 @@ uint8_t W5100Class::init(void)
 	// where it won't recover, unless given a reset pulse.
 	if (isW5200()) {
 		CH_BASE_MSB = 0x40;
-#ifdef ETHERNET_LARGE_BUFFERS
-#if MAX_SOCK_NUM <= 1
-		SSIZE = 16384;
-#elif MAX_SOCK_NUM <= 2
-		SSIZE = 8192;
-#elif MAX_SOCK_NUM <= 4
-		SSIZE = 4096;
-#else
-		SSIZE = 2048;
-#endif
-		SMASK = SSIZE - 1;
-#endif
-		for (i=0; i<MAX_SOCK_NUM; i++) {
-			writeSnRX_SIZE(i, SSIZE >> 10);
-			writeSnTX_SIZE(i, SSIZE >> 10);
-		}
-		for (; i<8; i++) {
-			writeSnRX_SIZE(i, 0);
-			writeSnTX_SIZE(i, 0);
-		}
 	// Try W5500 next.  WIZnet finally seems to have implemented
 	// SPI well with this chip.  It appears to be very resilient,
 	// so try it after the fragile W5200
 	} else if (isW5500()) {
 		CH_BASE_MSB = 0x10;
-#ifdef ETHERNET_LARGE_BUFFERS
-#if MAX_SOCK_NUM <= 1
-		SSIZE = 16384;
-#elif MAX_SOCK_NUM <= 2
-		SSIZE = 8192;
-#elif MAX_SOCK_NUM <= 4
-		SSIZE = 4096;
-#else
-		SSIZE = 2048;
-#endif
-		SMASK = SSIZE - 1;
-		for (i=0; i<MAX_SOCK_NUM; i++) {
-			writeSnRX_SIZE(i, SSIZE >> 10);
-			writeSnTX_SIZE(i, SSIZE >> 10);
-		}
-		for (; i<8; i++) {
-			writeSnRX_SIZE(i, 0);
-			writeSnTX_SIZE(i, 0);
-		}
-#endif
 	// Try W5100 last.  This simple chip uses fixed 4 byte frames
 	// for every 8 bit access.  Terribly inefficient, but so simple
 	// it recovers from "hearing" unsuccessful W5100 or W5200
@@ -164,25 +122,6 @@ uint8_t W5100Class::init(void)
 	// register for identification, so we check this last.
 	} else if (isW5100()) {
 		CH_BASE_MSB = 0x04;
-#ifdef ETHERNET_LARGE_BUFFERS
-#if MAX_SOCK_NUM <= 1
-		SSIZE = 8192;
-		writeTMSR(0x03);
-		writeRMSR(0x03);
-#elif MAX_SOCK_NUM <= 2
-		SSIZE = 4096;
-		writeTMSR(0x0A);
-		writeRMSR(0x0A);
-#else
-		SSIZE = 2048;
-		writeTMSR(0x55);
-		writeRMSR(0x55);
-#endif
-		SMASK = SSIZE - 1;
-#else
-		writeTMSR(0x55);
-		writeRMSR(0x55);
-#endif
 	// No hardware seems to be present.  Or it could be a W5200
 	// that's heard other SPI communication if its chip select
 	// pin wasn't high when a SD card or other SPI chip was used.
@@ -192,11 +131,78 @@ uint8_t W5100Class::init(void)
 		SPI.endTransaction();
 		return 0; // no known chip is responding :-(
 	}
+
+	// Share the buffer memory evenly between the sockets.  By default
+	// each socket gets 2K.  With ETHERNET_LARGE_BUFFERS, fewer sockets
+	// get larger buffers.
+	uint8_t kb = 2;
+#ifdef ETHERNET_LARGE_BUFFERS
+	uint8_t total = (chip == 51) ? 8 : 16;
+	uint8_t nsock = (chip == 51 && MAX_SOCK_NUM > 4) ? 4 : MAX_SOCK_NUM;
+	for (kb = total; kb * nsock > total; kb >>= 1) ;
+#endif
+	uint8_t sizes[MAX_SOCK_NUM];
+	for (i=0; i<MAX_SOCK_NUM; i++) {
+		sizes[i] = kb;
+	}
+	setBufferSizes(sizes, sizes);
 	SPI.endTransaction();
 	initialized = true;
 	return 1; // successful init
 }
 
+uint8_t W5100Class::setBufferSizes(const uint8_t *tx, const uint8_t *rx)
+{
+	uint8_t i, nsock, maxkb, txsum=0, rxsum=0;
+
+	if (chip == 51) {
+		nsock = (MAX_SOCK_NUM > 4) ? 4 : MAX_SOCK_NUM;
+		maxkb = 8;
+	} else if (chip == 52 || chip == 55) {
+		nsock = MAX_SOCK_NUM;
+		maxkb = 16;
+	} else {
+		return 0;
+	}
+	for (i=0; i < nsock; i++) {
+		if (tx[i] > maxkb || (tx[i] & (tx[i] - 1))) return 0;
+		if (rx[i] > maxkb || (rx[i] & (rx[i] - 1))) return 0;
+		txsum += tx[i];
+		rxsum += rx[i];
+	}
+	if (txsum > maxkb || rxsum > maxkb) return 0;
+
+	if (chip == 51) {
+		// TMSR and RMSR hold 2 bits per socket: 1, 2, 4 or 8 KB.
+		// Memory is handed out in socket order, so a socket that
+		// comes after all of it is used ends up with none.
+		uint8_t tmsr=0, rmsr=0;
+		for (i=0; i < nsock; i++) {
+			uint8_t t=0, r=0;
+			while ((2 << t) <= tx[i]) t++;
+			while ((2 << r) <= rx[i]) r++;
+			tmsr |= t << (i * 2);
+			rmsr |= r << (i * 2);
+		}
+		writeTMSR(tmsr);
+		writeRMSR(rmsr);
+	} else {
+		for (i=0; i < nsock; i++) {
+			writeSnTX_SIZE(i, tx[i]);
+			writeSnRX_SIZE(i, rx[i]);
+		}
+		for (; i<8; i++) {
+			writeSnTX_SIZE(i, 0);
+			writeSnRX_SIZE(i, 0);
+		}
+	}
+	for (i=0; i < MAX_SOCK_NUM; i++) {
+		tx_kb[i] = (i < nsock) ? tx[i] : 0;
+		rx_kb[i] = (i < nsock) ? rx[i] : 0;
+	}
+	return 1;
+}
+
 // Soft reset the WIZnet chip, by writing to its MR register reset bit
 uint8_t W5100Class::softReset(void)
 {
@@ -292,6 +298,27 @@ W5100Linkstatus W5100Class::getLinkStatus()
 	}
 }
 
+// Send a block of data in one go, ignoring what comes back
+static void spi_write_burst(const uint8_t *buf, uint16_t len)
+{
+#if defined(SPI_HAS_TRANSFER_BUF)
+	SPI.transfer(buf, NULL, len);
+#elif defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+	SPI.writeBytes(buf, len);
+#else
+	// SPI.transfer(buf, n) overwrites buf with the received bytes,
+	// so copy the data through a small buffer
+	uint8_t tmp[32];
+	while (len > 0) {
+		uint16_t n = (len < sizeof(tmp)) ? len : sizeof(tmp);
+		memcpy(tmp, buf, n);
+		SPI.transfer(tmp, n);
+		buf += n;
+		len -= n;
+	}
+#endif
+}
+
 uint16_t W5100Class::write(uint16_t addr, const uint8_t *buf, uint16_t len)
 {
 	uint8_t cmd[8];
@@ -313,14 +340,7 @@ uint16_t W5100Class::write(uint16_t addr, const uint8_t *buf, uint16_t len)
 		cmd[2] = ((len >> 8) & 0x7F) | 0x80;
 		cmd[3] = len & 0xFF;
 		SPI.transfer(cmd, 4);
-#ifdef SPI_HAS_TRANSFER_BUF
-		SPI.transfer(buf, NULL, len);
-#else
-		// TODO: copy 8 bytes at a time to cmd[] and block transfer
-		for (uint16_t i=0; i < len; i++) {
-			SPI.transfer(buf[i]);
-		}
-#endif
+		spi_write_burst(buf, len);
 		resetSS();
 	} else { // chip == 55
 		setSS();
@@ -369,14 +389,7 @@ uint16_t W5100Class::write(uint16_t addr, const uint8_t *buf, uint16_t len)
 			SPI.transfer(cmd, len + 3);
 		} else {
 			SPI.transfer(cmd, 3);
-#ifdef SPI_HAS_TRANSFER_BUF
-			SPI.transfer(buf, NULL, len);
-#else
-			// TODO: copy 8 bytes at a time to cmd[] and block transfer
-			for (uint16_t i=0; i < len; i++) {
-				SPI.transfer(buf[i]);
-			}
-#endif
+			spi_write_burst(buf, len);
 		}
 		resetSS();
 	}
@@ -465,6 +478,61 @@ uint16_t W5100Class::read(uint16_t addr, uint8_t *buf, uint16_t len)
 	return len;
 }
 
+uint16_t W5100Class::readSnRX(SOCKET s, uint16_t ptr, uint8_t *buf, uint16_t len)
+{
+	if (chip == 55) {
+		// W5500 has a block per socket buffer, and wraps the offset itself
+		uint8_t cmd[3];
+		cmd[0] = ptr >> 8;
+		cmd[1] = ptr & 0xFF;
+		cmd[2] = (s << 5) | 0x18;
+		setSS();
+		SPI.transfer(cmd, 3);
+		memset(buf, 0, len);
+		SPI.transfer(buf, len);
+		resetSS();
+		return len;
+	}
+	uint16_t size = RSIZE(s);
+	uint16_t offset = ptr & (size - 1);
+	uint16_t base = RBASE(s);
+	if (offset + len <= size) {
+		read(base + offset, buf, len);
+	} else {
+		uint16_t n = size - offset;
+		read(base + offset, buf, n);
+		read(base, buf + n, len - n);
+	}
+	return len;
+}
+
+uint16_t W5100Class::writeSnTX(SOCKET s, uint16_t ptr, const uint8_t *buf, uint16_t len)
+{
+	if (chip == 55) {
+		uint8_t cmd[3];
+		cmd[0] = ptr >> 8;
+		cmd[1] = ptr & 0xFF;
+		cmd[2] = (s << 5) | 0x14;
+		setSS();
+		SPI.transfer(cmd, 3);
+		spi_write_burst(buf, len);
+		resetSS();
+		return len;
+	}
+	uint16_t size = SSIZE(s);
+	uint16_t offset = ptr & (size - 1);
+	uint16_t base = SBASE(s);
+	if (offset + len <= size) {
+		write(base + offset, buf, len);
+	} else {
+		// Wrap around circular buffer
+		uint16_t n = size - offset;
+		write(base + offset, buf, n);
+		write(base, buf + n, len - n);
+	}
+	return len;
+}
+
 void W5100Class::execCmdSn(SOCKET s, SockCMD _cmd)
 {
 	// Send command to socket
@@ -303,30 +303,40 @@ private:
   static uint8_t isW5200(void);
   static uint8_t isW5500(void);
 
+  // Size in KB of each socket's TX and RX buffer inside the chip
+  static uint8_t tx_kb[MAX_SOCK_NUM];
+  static uint8_t rx_kb[MAX_SOCK_NUM];
+
 public:
   static uint8_t getChip(void) { return chip; }
-#ifdef ETHERNET_LARGE_BUFFERS
-  static uint16_t SSIZE;
-  static uint16_t SMASK;
-#else
-  static const uint16_t SSIZE = 2048;
-  static const uint16_t SMASK = 0x07FF;
-#endif
+
+  // Assign the chip's buffer memory to the sockets.  Sizes are in KB and
+  // must be powers of 2: 1 to 8 on W5100, which has 8 KB each for TX and
+  // RX, and 0 to 16 on W5200 and W5500, which have 16 KB each.  A socket
+  // given 0 KB is never used.  Returns 0 if the chip can't take the sizes.
+  // Must be called inside an SPI transaction, before any socket is opened.
+  static uint8_t setBufferSizes(const uint8_t *tx, const uint8_t *rx);
+
+  static uint16_t SSIZE(uint8_t socknum) { return (uint16_t)tx_kb[socknum] << 10; }
+  static uint16_t RSIZE(uint8_t socknum) { return (uint16_t)rx_kb[socknum] << 10; }
+  // On W5100 and W5200 the buffers are laid out back to back
   static uint16_t SBASE(uint8_t socknum) {
-    if (chip == 51) {
-      return socknum * SSIZE + 0x4000;
-    } else {
-      return socknum * SSIZE + 0x8000;
-    }
+    uint16_t base = (chip == 51) ? 0x4000 : 0x8000;
+    for (uint8_t i=0; i < socknum; i++) base += SSIZE(i);
+    return base;
   }
   static uint16_t RBASE(uint8_t socknum) {
-    if (chip == 51) {
-      return socknum * SSIZE + 0x6000;
-    } else {
-      return socknum * SSIZE + 0xC000;
-    }
+    uint16_t base = (chip == 51) ? 0x6000 : 0xC000;
+    for (uint8_t i=0; i < socknum; i++) base += RSIZE(i);
+    return base;
   }
 
+  // Read from socket s's RX buffer or write to its TX buffer, starting at
+  // ptr as used in the Sn_RX_RD and Sn_TX_WR registers.  These take care of
+  // wrapping around the end of the buffer.
+  static uint16_t readSnRX(SOCKET s, uint16_t ptr, uint8_t *buf, uint16_t len);
+  static uint16_t writeSnTX(SOCKET s, uint16_t ptr, const uint8_t *buf, uint16_t len);
+
   static bool hasOffsetAddressMapping(void) {
     if (chip == 55) return true;
     return false;
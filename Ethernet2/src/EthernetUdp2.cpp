@@ -37,7 +37,7 @@
 #include "Dns.h"
 
 /* Constructor */
-EthernetUDP::EthernetUDP() : _sock(MAX_SOCK_NUM) {}
+EthernetUDP::EthernetUDP() : _sock(MAX_SOCK_NUM), _remaining(0), _dropped(0) {}
 
 /* Start EthernetUDP socket, listening at local port PORT */
 uint8_t EthernetUDP::begin(uint16_t port) {
@@ -148,6 +148,34 @@ int EthernetUDP::parsePacket()
   return 0;
 }
 
+int EthernetUDP::receivePacket(uint8_t* buffer, size_t size)
+{
+  // discard any remaining bytes in the last packet
+  flush();
+
+  if (_sock == MAX_SOCK_NUM || w5500.getRXReceivedSize(_sock) < 8)
+  {
+    // There aren't any packets available
+    return 0;
+  }
+
+  uint8_t head[8];
+  uint16_t len = (size > 0xFFFF) ? 0xFFFF : size;
+  uint16_t got = w5500.recv_datagram(_sock, head, buffer, len);
+
+  _remoteIP = head;
+  _remotePort = head[4];
+  _remotePort = (_remotePort << 8) + head[5];
+
+  if (got > len)
+  {
+    // Too big for the buffer, it has been skipped
+    _dropped++;
+    return -1;
+  }
+  return got;
+}
+
 int EthernetUDP::read()
 {
   uint8_t byte;
@@ -210,13 +238,11 @@ int EthernetUDP::peek()
 
 void EthernetUDP::flush()
 {
-  // could this fail (loop endlessly) if _remaining > 0 and recv in read fails?
-  // should only occur if recv fails after telling us the data is there, lets
-  // hope the w5500 always behaves :)
-
-  while (_remaining)
+  if (_remaining)
   {
-    read();
+    // Move the read pointer past the rest of the packet rather than reading it
+    w5500.recv_data_skip(_sock, _remaining);
+    _remaining = 0;
   }
 }
 
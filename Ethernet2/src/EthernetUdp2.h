@@ -55,6 +55,7 @@ private:
   uint16_t _remotePort; // remote port for the incoming packet whilst it's being processed
   uint16_t _offset; // offset into the packet being sent
   uint16_t _remaining; // remaining bytes of incoming packet yet to be processed
+  uint32_t _dropped; // packets discarded by receivePacket() for being too large
 
 public:
   EthernetUDP();  // Constructor
@@ -96,6 +97,15 @@ public:
   virtual int peek();
   virtual void flush();	// Finish reading the current packet
 
+  // Read the next available packet into buffer, header and data in a single
+  // SPI transaction, instead of parsePacket() followed by read()
+  // remoteIP() and remotePort() then return its sender
+  // Returns the size of the packet in bytes, 0 if no packets are available,
+  // or -1 if it was larger than size, in which case it is discarded
+  int receivePacket(uint8_t* buffer, size_t size);
+  // Number of packets receivePacket() discarded for not fitting in the buffer
+  uint32_t droppedPackets() { return _dropped; };
+
   // Return the IP address of the host who sent the current incoming packet
   virtual IPAddress remoteIP() { return _remoteIP; };
   // Return the port of the host who sent the current incoming packet
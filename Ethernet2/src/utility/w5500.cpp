@@ -94,6 +94,44 @@ void W5500Class::recv_data_processing(SOCKET s, uint8_t *data, uint16_t len, uin
     }
 }
 
+uint16_t W5500Class::recv_datagram(SOCKET s, uint8_t *head, uint8_t *data, uint16_t len)
+{
+    uint16_t ptr = readSnRX_RD(s);
+    uint8_t cntl_byte = (0x18+(s<<5));
+    uint16_t size;
+
+    // The chip wraps the offset around the socket's Rx buffer itself, so the
+    // header and the data can be clocked out one after the other
+    SPI.beginTransaction(wiznet_SPI_settings);
+    setSS();
+    SPI.transfer(ptr >> 8);
+    SPI.transfer(ptr & 0xFF);
+    SPI.transfer(cntl_byte);
+    memset(head, 0, 8);
+    SPI.transfer(head, 8);
+    size = head[6];
+    size = (size << 8) + head[7];
+    if (size > 0 && size <= len) {
+        memset(data, 0, size);
+        SPI.transfer(data, size);
+    }
+    resetSS();
+    SPI.endTransaction();
+
+    ptr += 8 + size;
+    writeSnRX_RD(s, ptr);
+    execCmdSn(s, Sock_RECV);
+    return size;
+}
+
+void W5500Class::recv_data_skip(SOCKET s, uint16_t len)
+{
+    uint16_t ptr = readSnRX_RD(s);
+    ptr += len;
+    writeSnRX_RD(s, ptr);
+    execCmdSn(s, Sock_RECV);
+}
+
 void W5500Class::read_data(SOCKET s, volatile uint16_t src, volatile uint8_t *dst, uint16_t len)
 {
     uint8_t cntl_byte = (0x18+(s<<5));
@@ -151,9 +189,8 @@ uint16_t W5500Class::read(uint16_t _addr, uint8_t _cb, uint8_t *_buf, uint16_t _
     SPI.transfer(_addr >> 8);
     SPI.transfer(_addr & 0xFF);
     SPI.transfer(_cb);
-    for (uint16_t i=0; i<_len; i++){
-        _buf[i] = SPI.transfer(0);
-    }
+    memset(_buf, 0, _len);
+    SPI.transfer(_buf, _len);
     resetSS();
     SPI.endTransaction();
 
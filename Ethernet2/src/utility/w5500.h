@@ -171,6 +171,21 @@ public:
    */
   void recv_data_processing(SOCKET s, uint8_t *data, uint16_t len, uint8_t peek = 0);
 
+  /**
+   * @brief	Read the next UDP datagram of a socket in a single SPI transaction.
+   *
+   * The 8 byte header (peer IP, port and length) goes into head, and the data
+   * straight into data if it fits in len bytes.  A datagram that doesn't fit is
+   * skipped without being read.  Either way it is removed from the Rx buffer.
+   * @return Size of the datagram's data
+   */
+  uint16_t recv_datagram(SOCKET s, uint8_t *head, uint8_t *data, uint16_t len);
+
+  /**
+   * @brief	Remove len bytes from the Rx buffer without reading them.
+   */
+  void recv_data_skip(SOCKET s, uint16_t len);
+
   inline void setGatewayIp(uint8_t *_addr);
   inline void getGatewayIp(uint8_t *_addr);
 
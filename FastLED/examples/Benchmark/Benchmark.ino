@@ -0,0 +1,141 @@
+/// @file    Benchmark.ino
+/// @brief   Times show() per chipset, lib8tion kernels and the fx effects.
+/// @example Benchmark.ino
+///
+/// Prints one BENCH line per measurement on the serial port, see
+/// fl/benchmark.h for the format. Capture the output of two FastLED versions
+/// on the same board and compare the lines by name to catch regressions.
+///
+/// show() really clocks the data out, so the numbers include the wire time
+/// of the chipset. Nothing needs to be connected to the pins.
+
+#include <FastLED.h>
+#include "fl/benchmark.h"
+#include "fx/1d/fire2012.hpp"
+#include "fx/1d/pacifica.hpp"
+#include "fx/2d/noisepalette.h"
+#if !defined(__AVR__)
+#include "fx/2d/animartrix.hpp"
+#endif
+
+using namespace fl;
+
+#define CLOCKLESS_PIN 2
+#define SPI_DATA_PIN 3
+#define SPI_CLOCK_PIN 4
+
+#if defined(__AVR__)
+#define MAX_LEDS 128
+#define MATRIX_SIZE 8
+#define ITERATIONS 8
+#else
+#define MAX_LEDS 1024
+#define MATRIX_SIZE 16
+#define ITERATIONS 32
+#endif
+
+CRGB leds[MAX_LEDS];
+CRGB other[MAX_LEDS];
+uint8_t bytes[MAX_LEDS];
+
+static const int kLengths[] = {16, 64, 256, MAX_LEDS};
+
+CLEDController *clockless = nullptr;
+CLEDController *apa102 = nullptr;
+CLEDController *apa102hd = nullptr;
+
+XYMap xyMap = XYMap::constructRectangularGrid(MATRIX_SIZE, MATRIX_SIZE);
+
+static void printLine(const char *line) { Serial.println(line); }
+
+static void fillTestPattern(int n) {
+    for (int i = 0; i < n; ++i) {
+        leds[i] = CHSV(i * 7, 255, 255);
+        other[i] = CHSV(i * 3 + 128, 200, 180);
+    }
+}
+
+// Each run name is "group/what/length", built in a scratch buffer.
+static char gName[48];
+static const char *name(const char *group, const char *what, int n) {
+    snprintf(gName, sizeof(gName), "%s/%s/%d", group, what, n);
+    return gName;
+}
+
+static void benchShow(Benchmark &bench, CLEDController *controller,
+                      const char *chipset) {
+    for (int n : kLengths) {
+        fillTestPattern(n);
+        controller->setLeds(leds, n);
+        bench.run(name("show", chipset, n), n, ITERATIONS,
+                  [&]() { controller->showLeds(255); });
+    }
+    controller->setLeds(leds, 0);  // Keep it out of the other runs.
+}
+
+static void benchKernels(Benchmark &bench) {
+    const int n = MAX_LEDS;
+    fillTestPattern(n);
+    bench.run(name("lib8", "nscale8_video", n), n, ITERATIONS,
+              [&]() { nscale8_video(leds, n, 200); });
+    bench.run(name("lib8", "fadeToBlackBy", n), n, ITERATIONS,
+              [&]() { fadeToBlackBy(leds, n, 10); });
+    bench.run(name("lib8", "nblend", n), n, ITERATIONS,
+              [&]() { nblend(leds, other, n, 96); });
+    bench.run(name("lib8", "fill_rainbow", n), n, ITERATIONS,
+              [&]() { fill_rainbow(leds, n, 0, 7); });
+    bench.run(name("lib8", "fill_solid", n), n, ITERATIONS,
+              [&]() { fill_solid(leds, n, CRGB::Purple); });
+    bench.run(name("lib8", "blur1d", n), n, ITERATIONS,
+              [&]() { blur1d(leds, n, 64); });
+    bench.run(name("lib8", "inoise8", n), n, ITERATIONS, [&]() {
+        for (int i = 0; i < n; ++i) {
+            bytes[i] = inoise8(i * 30, 1000, 4242);
+        }
+    });
+    bench.run(name("lib8", "fill_raw_noise_grid8", n), n, ITERATIONS,
+              [&]() { fill_raw_noise_grid8(bytes, n, 1, 0, 30, 1000, 0, 4242); });
+}
+
+template <typename FxT>
+static void benchFx(Benchmark &bench, const char *what, FxT &fx) {
+    const int n = fx.getNumLeds();
+    uint32_t now = 0;
+    bench.run(name("fx", what, n), n, ITERATIONS, [&]() {
+        now += 16;
+        fx.draw(Fx::DrawContext(now, leds));
+    });
+}
+
+static void benchEffects(Benchmark &bench) {
+    Pacifica pacifica(MAX_LEDS);
+    benchFx(bench, "Pacifica", pacifica);
+    Fire2012 fire(MAX_LEDS);
+    benchFx(bench, "Fire2012", fire);
+    NoisePalette noise(xyMap);
+    benchFx(bench, "NoisePalette", noise);
+#if !defined(__AVR__)
+    Animartrix animartrix(xyMap, POLAR_WAVES);
+    benchFx(bench, "Animartrix", animartrix);
+#endif
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);  // Give the serial monitor time to attach.
+    clockless = &FastLED.addLeds<WS2812, CLOCKLESS_PIN, GRB>(leds, 0);
+    apa102 = &FastLED.addLeds<APA102, SPI_DATA_PIN, SPI_CLOCK_PIN, BGR>(leds, 0);
+    apa102hd = &FastLED.addLeds<APA102HD, SPI_DATA_PIN, SPI_CLOCK_PIN, BGR>(leds, 0);
+}
+
+void loop() {
+    {
+        Benchmark bench(printLine);
+        benchShow(bench, clockless, "WS2812");
+        benchShow(bench, apa102, "APA102");
+        benchShow(bench, apa102hd, "APA102HD");
+        benchKernels(bench);
+        benchEffects(bench);
+    }
+    delay(10000);
+}
@@ -19,6 +19,14 @@
 #endif  // __AVR__
 #endif  // MAX_CLED_CONTROLLERS
 
+#ifndef FASTLED_HAS_SHOW_TIMING
+#ifdef __AVR__
+#define FASTLED_HAS_SHOW_TIMING 0
+#else
+#define FASTLED_HAS_SHOW_TIMING 1
+#endif
+#endif  // FASTLED_HAS_SHOW_TIMING
+
 #if defined(__SAM3X8E__)
 volatile uint32_t fuckit;
 #endif
@@ -46,6 +54,7 @@ CFastLED FastLED;
 
 CLEDController *CLEDController::m_pHead = NULL;
 CLEDController *CLEDController::m_pTail = NULL;
+bool CLEDController::m_asyncShow = false;
 static uint32_t lastshow = 0;
 
 /// Global frame counter, used for debugging ESP implementations
@@ -66,6 +75,7 @@ CFastLED::CFastLED() {
 	m_pPowerFunc = NULL;
 	m_nPowerData = 0xFFFFFFFF;
 	m_nMinMicros = 0;
+	m_bShowPending = false;
 }
 
 int CFastLED::size() {
@@ -91,6 +101,41 @@ CLEDController &CFastLED::addLeds(CLEDController *pLed,
 
 static void* gControllersData[MAX_CLED_CONTROLLERS];
 
+#if FASTLED_HAS_SHOW_TIMING
+// Show scheduler bookkeeping: when the current frame was started and how long
+// each channel took to finish it, indexed like FastLED[i].
+static uint32_t gShowStartMicros = 0;
+static uint32_t gChannelShowMicros[MAX_CLED_CONTROLLERS];
+static bool gChannelShowDone[MAX_CLED_CONTROLLERS];
+
+static void startShowTiming() {
+	gShowStartMicros = micros();
+	for (int i = 0; i < MAX_CLED_CONTROLLERS; ++i) {
+		gChannelShowDone[i] = false;
+	}
+}
+#else
+static void startShowTiming() {}
+#endif
+
+// Second half of the show scheduler. By now every controller has been loaded,
+// so kick off all hardware channels back to back and only then let the
+// drivers that must finish inside show() block. The frame time is therefore
+// set by the slowest channel instead of the sum of all of them.
+static void startAndWaitChannels() {
+	int length = 0;
+	CLEDController *pCur = CLEDController::head();
+	while(pCur && length < MAX_CLED_CONTROLLERS) {
+		pCur->endShowLeds(gControllersData[length++]);
+		pCur = pCur->next();
+	}
+	pCur = CLEDController::head();
+	while(pCur) {
+		pCur->waitShowLeds();
+		pCur = pCur->next();
+	}
+}
+
 void CFastLED::show(uint8_t scale) {
 	fl::EngineEvents::onBeginFrame();
 	while(m_nMinMicros && ((micros()-lastshow) < m_nMinMicros));
@@ -101,6 +146,12 @@ void CFastLED::show(uint8_t scale) {
 		scale = (*m_pPowerFunc)(scale, m_nPowerData);
 	}
 
+	// Async controllers block in beginShowLeds() until their previous frame is out,
+	// so make sure the completion event for that frame has been raised first.
+	waitShowComplete();
+
+	startShowTiming();
+
 	// static uninitialized gControllersData produces the smallest binary on attiny85.
 	int length = 0;
 	CLEDController *pCur = CLEDController::head();
@@ -112,17 +163,83 @@ void CFastLED::show(uint8_t scale) {
 		pCur = pCur->next();
 	}
 
-	length = 0;  // Reset length to 0 and iterate again.
-	pCur = CLEDController::head();
-	while(pCur && length < MAX_CLED_CONTROLLERS) {
-		pCur->endShowLeds(gControllersData[length++]);
-		pCur = pCur->next();
-	}
+	startAndWaitChannels();
+	m_bShowPending = true;
 	countFPS();
 	fl::EngineEvents::onEndShowLeds();
+	isShowComplete();  // Synchronous controllers complete right here.
 	fl::EngineEvents::onEndFrame();
 }
 
+void CFastLED::setAsyncShow(bool async) {
+	CLEDController::setAsyncShow(async);
+}
+
+bool CFastLED::isShowComplete() {
+	if (!m_bShowPending) {
+		return true;
+	}
+	bool complete = true;
+	int index = 0;
+	CLEDController *pCur = CLEDController::head();
+	while(pCur) {
+#if FASTLED_HAS_SHOW_TIMING
+		// Keep polling channels that are already done so the ones that
+		// finish later still get their own timestamp.
+		if (index < MAX_CLED_CONTROLLERS && gChannelShowDone[index]) {
+			++index;
+			pCur = pCur->next();
+			continue;
+		}
+		if (pCur->isShowComplete()) {
+			if (index < MAX_CLED_CONTROLLERS) {
+				gChannelShowDone[index] = true;
+				gChannelShowMicros[index] = micros() - gShowStartMicros;
+			}
+		} else {
+			complete = false;
+		}
+#else
+		if (!pCur->isShowComplete()) {
+			return false;
+		}
+#endif
+		++index;
+		pCur = pCur->next();
+	}
+	if (!complete) {
+		return false;
+	}
+	m_bShowPending = false;
+	fl::EngineEvents::onShowComplete();
+	return true;
+}
+
+uint32_t CFastLED::getShowMicros(int channel) {
+#if FASTLED_HAS_SHOW_TIMING
+	if (channel >= 0) {
+		return (channel < MAX_CLED_CONTROLLERS) ? gChannelShowMicros[channel] : 0;
+	}
+	uint32_t longest = 0;
+	const int n = count();
+	for (int i = 0; i < n && i < MAX_CLED_CONTROLLERS; ++i) {
+		if (gChannelShowMicros[i] > longest) {
+			longest = gChannelShowMicros[i];
+		}
+	}
+	return longest;
+#else
+	(void)channel;
+	return 0;
+#endif
+}
+
+void CFastLED::waitShowComplete() {
+	while (!isShowComplete()) {
+		yield();
+	}
+}
+
 int CFastLED::count() {
     int x = 0;
 	CLEDController *pCur = CLEDController::head();
@@ -154,6 +271,9 @@ void CFastLED::showColor(const struct CRGB & color, uint8_t scale) {
 		scale = (*m_pPowerFunc)(scale, m_nPowerData);
 	}
 
+	waitShowComplete();
+	startShowTiming();
+
 	int length = 0;
 	CLEDController *pCur = CLEDController::head();
 	while(pCur && length < MAX_CLED_CONTROLLERS) {
@@ -163,13 +283,10 @@ void CFastLED::showColor(const struct CRGB & color, uint8_t scale) {
 		pCur = pCur->next();
 	}
 
-	pCur = CLEDController::head();
-	length = 0;  // Reset length to 0 and iterate again.
-	while(pCur && length < MAX_CLED_CONTROLLERS) {
-		pCur->endShowLeds(gControllersData[length++]);
-		pCur = pCur->next();
-	}
+	startAndWaitChannels();
+	m_bShowPending = true;
 	countFPS();
+	isShowComplete();
 }
 
 void CFastLED::clear(bool writeData) {
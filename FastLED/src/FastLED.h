@@ -358,6 +358,7 @@ class CFastLED {
 	uint32_t m_nMinMicros;    ///< minimum µs between frames, used for capping frame rates
 	uint32_t m_nPowerData;    ///< max power use parameter
 	power_func m_pPowerFunc;  ///< function for overriding brightness when using FastLED.show();
+	bool m_bShowPending;      ///< a frame was handed to the controllers and onShowComplete() has not fired yet
 
 public:
 	CFastLED();
@@ -742,6 +743,29 @@ public:
 	/// Update all our controllers with the current led colors
 	void show() { show(m_Scale); }
 
+	/// Let show() return as soon as every controller has taken a snapshot of its
+	/// led data, instead of waiting for the data to be clocked out. Controllers that
+	/// can't transmit in the background (most bit-banged and SPI ones) are unaffected.
+	/// @param async true to enable background transmission
+	void setAsyncShow(bool async);
+
+	/// Non-blocking check whether the last frame sent by show() has finished
+	/// transmitting on every controller. The first call that observes completion
+	/// raises EngineEvents::onShowComplete().
+	/// @returns true if no frame is in flight
+	bool isShowComplete();
+
+	/// Block until the last frame sent by show() has been fully transmitted.
+	void waitShowComplete();
+
+	/// Time a channel needed for the last frame, from the start of show() until
+	/// its transfer was seen to complete. Completion is observed by show(),
+	/// isShowComplete() and waitShowComplete(), so for strips that keep sending
+	/// after show() returns, poll to get a tight number.
+	/// @param channel index of the controller as in operator[], or -1 for the slowest one
+	/// @returns the frame time in microseconds, 0 if not measured (always 0 on AVR)
+	uint32_t getShowMicros(int channel = -1);
+
 	/// Clear the leds, wiping the local array of data. Optionally you can also
 	/// send the cleared data to the LEDs.
 	/// @param writeData whether or not to write out to the leds as well
@@ -44,6 +44,7 @@ protected:
     int m_nLeds;               ///< the number of LEDs in the LED data array
     static CLEDController *m_pHead;  ///< pointer to the first LED controller in the linked list
     static CLEDController *m_pTail;  ///< pointer to the last LED controller in the linked list
+    static bool m_asyncShow;         ///< when set, endShowLeds() may return before the frame is on the wire
 
 
     /// Set all the LEDs to a given color. 
@@ -70,6 +71,14 @@ public:
 
     void setEnabled(bool enabled) { m_enabled = enabled; }
 
+    /// Allow controllers to return from show() while the frame is still being
+    /// clocked out. Controllers that support this snapshot the led data before
+    /// returning, so the CRGB array can be redrawn right away. This is global
+    /// to keep the size of every controller unchanged.
+    /// @see isShowComplete()
+    static void setAsyncShow(bool async) { m_asyncShow = async; }
+    static bool getAsyncShow() { return m_asyncShow; }
+
     CLEDController();
     #if defined(FASTLED_TESTING)
     // Silences the warning about the destructor not being virtual during testing.
@@ -107,6 +116,7 @@ public:
         void* data = beginShowLeds();
         showLedsInternal(brightness);
         endShowLeds(data);
+        waitShowLeds();
     }
 
     ColorAdjustment getAdjustmentData(uint8_t brightness);
@@ -244,6 +254,16 @@ public:
         setDither(static_cast<uint8_t>(d));
     }
 
+    /// Called by CFastLED once every controller has had endShowLeds() called, so all
+    /// hardware channels are already running. Drivers that read the caller's led
+    /// data during the transfer and so must not let show() return early (unless
+    /// async show is enabled) block here instead of inside showPixels().
+    virtual void waitShowLeds() {}
+
+    /// Non-blocking check whether the last frame handed over in endShowLeds()
+    /// has finished transmitting. Synchronous controllers are always complete.
+    virtual bool isShowComplete() { return true; }
+
     /// The color corrction to use for this controller, expressed as a CRGB object
     /// @param correction the color correction to set
     /// @returns a reference to the controller
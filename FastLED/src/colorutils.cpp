@@ -10,6 +10,7 @@
 
 #include "FastLED.h"
 #include "fl/xymap.h"
+#include "lib8tion/bulk8.h"
 
 using namespace fl;
 
@@ -219,9 +220,7 @@ void fill_gradient_RGB( CRGB* leds, uint16_t numLeds, const CRGB& c1, const CRGB
 
 void nscale8_video( CRGB* leds, uint16_t num_leds, uint8_t scale)
 {
-    for( uint16_t i = 0; i < num_leds; ++i) {
-        leds[i].nscale8_video( scale);
-    }
+    nscale8_video_bulk( (uint8_t*)leds, (uint32_t)num_leds * 3, scale);
 }
 
 void fade_video(CRGB* leds, uint16_t num_leds, uint8_t fadeBy)
@@ -248,9 +247,7 @@ void fade_raw( CRGB* leds, uint16_t num_leds, uint8_t fadeBy)
 
 void nscale8( CRGB* leds, uint16_t num_leds, uint8_t scale)
 {
-    for( uint16_t i = 0; i < num_leds; ++i) {
-        leds[i].nscale8( scale);
-    }
+    nscale8_bulk( (uint8_t*)leds, (uint32_t)num_leds * 3, scale);
 }
 
 void fadeUsingColor( CRGB* leds, uint16_t numLeds, const CRGB& colormask)
@@ -305,11 +302,15 @@ CRGB& nblend( CRGB& existing, const CRGB& overlay, fract8 amountOfOverlay )
 
 void nblend( CRGB* existing, CRGB* overlay, uint16_t count, fract8 amountOfOverlay)
 {
-    for( uint16_t i = count; i; --i) {
-        nblend( *existing, *overlay, amountOfOverlay);
-        ++existing;
-        ++overlay;
+    if( amountOfOverlay == 0) {
+        return;
+    }
+    if( amountOfOverlay == 255) {
+        memmove( (void*)existing, overlay, sizeof(CRGB) * count);
+        return;
     }
+    blend8_bulk( (const uint8_t*)existing, (const uint8_t*)overlay,
+                 (uint8_t*)existing, (uint32_t)count * 3, amountOfOverlay);
 }
 
 CRGB blend( const CRGB& p1, const CRGB& p2, fract8 amountOfP2 )
@@ -321,9 +322,14 @@ CRGB blend( const CRGB& p1, const CRGB& p2, fract8 amountOfP2 )
 
 CRGB* blend( const CRGB* src1, const CRGB* src2, CRGB* dest, uint16_t count, fract8 amountOfsrc2 )
 {
-    for( uint16_t i = 0; i < count; ++i) {
-        dest[i] = blend(src1[i], src2[i], amountOfsrc2);
+    // Same early outs as nblend(), which keeps the results identical.
+    const CRGB* from = (amountOfsrc2 == 0) ? src1 : (amountOfsrc2 == 255) ? src2 : NULL;
+    if( from) {
+        memmove( (void*)dest, from, sizeof(CRGB) * count);
+        return dest;
     }
+    blend8_bulk( (const uint8_t*)src1, (const uint8_t*)src2,
+                 (uint8_t*)dest, (uint32_t)count * 3, amountOfsrc2);
     return dest;
 }
 
@@ -32,6 +32,11 @@ void DefaultFree(void *ptr) { free(ptr); }
 
 void *(*Alloc)(size_t) = DefaultAlloc;
 void (*Free)(void *) = DefaultFree;
+
+BlockPool gPool;
+// Set when the pool buffer was allocated here rather than passed in.
+void *gPoolBuffer = nullptr;
+void (*gPoolBufferFree)(void *) = nullptr;
 } // namespace
 
 void SetLargeBlockAllocator(void *(*alloc)(size_t), void (*free)(void *)) {
@@ -40,16 +45,65 @@ void SetLargeBlockAllocator(void *(*alloc)(size_t), void (*free)(void *)) {
 }
 
 void* LargeBlockAllocate(size_t size, bool zero) {
-    void* ptr = Alloc(size);
-    if (zero) {
+    void* ptr = gPool.allocate(size);
+    if (!ptr) {
+        ptr = Alloc(size);
+    }
+    if (zero && ptr) {
         memset(ptr, 0, size);
     }
     return ptr;
 }
 
 void LargeBlockDeallocate(void* ptr) {
+    if (gPool.owns(ptr)) {
+        gPool.deallocate(ptr);
+        return;
+    }
     Free(ptr);
 }
 
+bool LargeBlockPoolReserve(size_t blockSize, size_t blockCount) {
+    if (!LargeBlockPoolRelease()) {
+        return false;
+    }
+    const size_t bytes = BlockPool::bytesNeeded(blockSize, blockCount);
+    // Over allocate so the blocks can be aligned whatever the allocator returns.
+    void *buffer = Alloc(bytes + BlockPool::kAlign);
+    if (!buffer) {
+        return false;
+    }
+    if (!gPool.init(buffer, bytes + BlockPool::kAlign, blockSize)) {
+        Free(buffer);
+        return false;
+    }
+    gPoolBuffer = buffer;
+    gPoolBufferFree = Free;
+    return true;
+}
+
+bool LargeBlockPoolReserve(void* buffer, size_t bufferSize, size_t blockSize) {
+    if (!LargeBlockPoolRelease()) {
+        return false;
+    }
+    return gPool.init(buffer, bufferSize, blockSize);
+}
+
+bool LargeBlockPoolRelease() {
+    if (!gPool.reset()) {
+        return false;
+    }
+    if (gPoolBuffer && gPoolBufferFree) {
+        gPoolBufferFree(gPoolBuffer);
+    }
+    gPoolBuffer = nullptr;
+    gPoolBufferFree = nullptr;
+    return true;
+}
+
+BlockPoolStats LargeBlockPoolGetStats() { return gPool.stats(); }
+
+void LargeBlockPoolResetHighWater() { gPool.resetHighWater(); }
+
 }  // namespace fl
 
@@ -4,6 +4,7 @@
 #include <stddef.h>
 #include <string.h>
 
+#include "fl/block_pool.h"
 
 
 namespace fl {
@@ -12,6 +13,23 @@ void SetLargeBlockAllocator(void *(*alloc)(size_t), void (*free)(void *));
 void* LargeBlockAllocate(size_t size, bool zero = true);
 void LargeBlockDeallocate(void* ptr);
 
+// Frame pool. Reserve it once at startup with blocks the size of your largest
+// frame and LargeBlockAllocate() will hand out those blocks before it goes to
+// the heap, which keeps frames, video buffers and layers from fragmenting the
+// heap over hours of churn. Requests that do not fit a block, or that arrive
+// while every block is in use, still come from the heap and are counted in the
+// stats. Pick the block count from the stats' highWater after a test run.
+//
+// Reserves blockCount blocks of blockSize bytes with the large block allocator
+// (PSRAM first on ESP32).
+bool LargeBlockPoolReserve(size_t blockSize, size_t blockCount);
+// Same, in caller owned memory, e.g. a static array in internal RAM.
+bool LargeBlockPoolReserve(void* buffer, size_t bufferSize, size_t blockSize);
+// Gives the pool memory back. Fails while any block is still in use.
+bool LargeBlockPoolRelease();
+BlockPoolStats LargeBlockPoolGetStats();
+void LargeBlockPoolResetHighWater();
+
 template<typename T>
 class LargeBlockAllocator {
 public:
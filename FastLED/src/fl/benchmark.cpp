@@ -0,0 +1,60 @@
+#include "FastLED.h"
+
+#include "fl/benchmark.h"
+#include "fl/namespace.h"
+
+namespace fl {
+
+namespace {
+// Str::append(int) would print large cycle counts as negative.
+void appendU32(Str *out, uint32_t value) {
+    char buf[11];
+    int i = sizeof(buf);
+    buf[--i] = '\0';
+    do {
+        buf[--i] = char('0' + value % 10);
+        value /= 10;
+    } while (value);
+    out->append(buf + i);
+}
+
+void appendField(Str *out, const char *key, uint32_t value) {
+    out->append(' ');
+    out->append(key);
+    out->append('=');
+    appendU32(out, value);
+}
+}  // namespace
+
+Benchmark::Benchmark(LineSink sink) : mSink(sink) {
+    cycleCounterBegin();
+    Str line("BENCH_BEGIN");
+    appendField(&line, "fastled", FASTLED_VERSION);
+    appendField(&line, "hz", cycleCounterHz());
+    mSink(line.c_str());
+}
+
+Benchmark::~Benchmark() {
+    Str line("BENCH_END");
+    appendField(&line, "runs", mRuns);
+    mSink(line.c_str());
+}
+
+void Benchmark::report(const BenchmarkResult &result) {
+    ++mRuns;
+    mSink(format(result).c_str());
+}
+
+Str Benchmark::format(const BenchmarkResult &result) {
+    Str line("BENCH name=");
+    line.append(result.name);
+    appendField(&line, "iters", result.iterations);
+    appendField(&line, "units", result.units);
+    appendField(&line, "min", result.minCycles);
+    appendField(&line, "mean", result.meanCycles);
+    appendField(&line, "max", result.maxCycles);
+    appendField(&line, "per_unit", result.cyclesPerUnit());
+    return line;
+}
+
+}  // namespace fl
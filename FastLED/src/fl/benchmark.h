@@ -0,0 +1,83 @@
+#pragma once
+
+/*
+Small on target benchmark harness.
+
+Every run prints one line a machine can parse, key=value pairs separated by
+spaces, so results from two FastLED versions can be diffed or graphed:
+
+    BENCH_BEGIN fastled=3009007 hz=240000000
+    BENCH name=show/WS2812/256 iters=16 units=256 min=1884270 mean=1884301 max=1884920 per_unit=7360
+    BENCH_END runs=1
+
+Cycles come from fl::cycleCount(), see cycle_counter.h for what they mean on
+each platform. per_unit is mean / units, units being whatever the run
+processes per call (LEDs, bytes, pixels).
+*/
+
+#include <stdint.h>
+
+#include "fl/cycle_counter.h"
+#include "fl/namespace.h"
+#include "fl/str.h"
+
+namespace fl {
+
+struct BenchmarkResult {
+    const char *name = "";
+    uint32_t iterations = 0;
+    uint32_t units = 1;
+    uint32_t minCycles = 0;
+    uint32_t meanCycles = 0;
+    uint32_t maxCycles = 0;
+    uint32_t cyclesPerUnit() const { return units ? meanCycles / units : meanCycles; }
+};
+
+class Benchmark {
+  public:
+    // Receives each finished line, without a line ending. Serial.println works.
+    typedef void (*LineSink)(const char *line);
+
+    explicit Benchmark(LineSink sink);
+    // Prints BENCH_END.
+    ~Benchmark();
+
+    // Calls fn once to warm caches, then times iterations calls one by one.
+    template <typename Fn>
+    BenchmarkResult run(const char *name, uint32_t units, uint32_t iterations,
+                        Fn fn) {
+        BenchmarkResult result;
+        result.name = name;
+        result.units = units;
+        result.iterations = iterations ? iterations : 1;
+        result.minCycles = 0xffffffff;
+        fn();
+        uint64_t total = 0;
+        for (uint32_t i = 0; i < result.iterations; ++i) {
+            const uint32_t start = cycleCount();
+            fn();
+            const uint32_t cycles = cycleCount() - start;
+            total += cycles;
+            if (cycles < result.minCycles) {
+                result.minCycles = cycles;
+            }
+            if (cycles > result.maxCycles) {
+                result.maxCycles = cycles;
+            }
+        }
+        result.meanCycles = uint32_t(total / result.iterations);
+        report(result);
+        return result;
+    }
+
+    void report(const BenchmarkResult &result);
+    uint32_t runs() const { return mRuns; }
+
+    static Str format(const BenchmarkResult &result);
+
+  private:
+    LineSink mSink;
+    uint32_t mRuns = 0;
+};
+
+}  // namespace fl
@@ -0,0 +1,79 @@
+#include "fl/block_pool.h"
+
+#include "fl/namespace.h"
+
+namespace fl {
+
+bool BlockPool::init(void *buffer, size_t bufferSize, size_t blockSize) {
+    if (mStats.inUse) {
+        return false;
+    }
+    reset();
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(buffer);
+    const uintptr_t aligned = (addr + kAlign - 1) & ~uintptr_t(kAlign - 1);
+    const size_t skipped = aligned - addr;
+    if (!buffer || blockSize == 0 || bufferSize <= skipped) {
+        return false;
+    }
+    const size_t stride = alignUp(blockSize);
+    const size_t count = (bufferSize - skipped) / stride;
+    if (count == 0) {
+        return false;
+    }
+    mBase = reinterpret_cast<uint8_t *>(aligned);
+    mEnd = mBase + stride * count;
+    // Thread the free list in address order, so the first frames allocated
+    // are next to each other.
+    for (size_t i = count; i-- > 0;) {
+        FreeBlock *block = reinterpret_cast<FreeBlock *>(mBase + i * stride);
+        block->next = mFree;
+        mFree = block;
+    }
+    mStats = BlockPoolStats();
+    mStats.blockSize = stride;
+    mStats.blockCount = count;
+    return true;
+}
+
+bool BlockPool::reset() {
+    if (mStats.inUse) {
+        return false;
+    }
+    mBase = nullptr;
+    mEnd = nullptr;
+    mFree = nullptr;
+    mStats = BlockPoolStats();
+    return true;
+}
+
+void *BlockPool::allocate(size_t size) {
+    if (!mBase) {
+        return nullptr;
+    }
+    if (size > mStats.blockSize) {
+        ++mStats.oversized;
+        return nullptr;
+    }
+    if (!mFree) {
+        ++mStats.exhausted;
+        return nullptr;
+    }
+    FreeBlock *block = mFree;
+    mFree = block->next;
+    if (++mStats.inUse > mStats.highWater) {
+        mStats.highWater = mStats.inUse;
+    }
+    return block;
+}
+
+void BlockPool::deallocate(void *ptr) {
+    if (!owns(ptr)) {
+        return;
+    }
+    FreeBlock *block = static_cast<FreeBlock *>(ptr);
+    block->next = mFree;
+    mFree = block;
+    --mStats.inUse;
+}
+
+}  // namespace fl
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fl/namespace.h"
+
+namespace fl {
+
+struct BlockPoolStats {
+    size_t blockSize = 0;   // bytes per block, after alignment
+    size_t blockCount = 0;
+    size_t inUse = 0;       // blocks handed out right now
+    size_t highWater = 0;   // most blocks ever in use at once
+    size_t exhausted = 0;   // requests that found every block in use
+    size_t oversized = 0;   // requests larger than a block
+};
+
+// A fixed number of equally sized blocks carved out of one buffer that is
+// reserved once. Blocks are recycled through an intrusive free list, so a
+// long running sketch that keeps allocating and freeing frames of the same
+// size never touches the heap again and cannot fragment it.
+//
+// Not thread safe. Allocate and free from the same task.
+class BlockPool {
+  public:
+    static const size_t kAlign = sizeof(void *) > 4 ? sizeof(void *) : 4;
+
+    BlockPool() = default;
+    ~BlockPool() = default;
+    BlockPool(const BlockPool &) = delete;
+    BlockPool &operator=(const BlockPool &) = delete;
+
+    // Bytes of buffer needed for blockCount blocks of blockSize bytes.
+    static size_t bytesNeeded(size_t blockSize, size_t blockCount) {
+        return alignUp(blockSize) * blockCount;
+    }
+
+    // Splits buffer into as many blocks of blockSize as fit. The buffer is
+    // not owned and must outlive the pool. Fails if blocks are in use.
+    bool init(void *buffer, size_t bufferSize, size_t blockSize);
+    // Forgets the buffer. Fails, and keeps the buffer, if blocks are in use.
+    bool reset();
+
+    // nullptr when the request is larger than a block or the pool is empty,
+    // the caller falls back to the heap.
+    void *allocate(size_t size);
+    void deallocate(void *ptr);
+    bool owns(const void *ptr) const {
+        const uint8_t *p = static_cast<const uint8_t *>(ptr);
+        return mBase && p >= mBase && p < mEnd;
+    }
+
+    bool initialized() const { return mBase != nullptr; }
+    void *buffer() const { return mBase; }
+    const BlockPoolStats &stats() const { return mStats; }
+    void resetHighWater() { mStats.highWater = mStats.inUse; }
+
+  private:
+    static size_t alignUp(size_t n) { return (n + kAlign - 1) & ~(kAlign - 1); }
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    uint8_t *mBase = nullptr;
+    uint8_t *mEnd = nullptr;
+    FreeBlock *mFree = nullptr;
+    BlockPoolStats mStats;
+};
+
+}  // namespace fl
@@ -0,0 +1,79 @@
+#pragma once
+
+/*
+Free running CPU cycle counter for timing code on the target.
+
+ESP32 reads CCOUNT (clock_cycles.h), Cortex-M3/M4/M7 read the DWT cycle
+counter. Everything else falls back to micros(), in which case
+cycleCounterHz() is 1000000 and a "cycle" is a microsecond. The counter is
+32 bit and wraps, take differences with unsigned math:
+
+    uint32_t start = fl::cycleCount();
+    work();
+    uint32_t cycles = fl::cycleCount() - start;
+*/
+
+#include <stdint.h>
+
+#include "led_sysdefs.h"
+#include "fl/force_inline.h"
+#include "fl/namespace.h"
+
+#if defined(ESP32)
+#include "platforms/esp/32/clock_cycles.h"
+#define FASTLED_CYCLE_COUNTER_ESP32 1
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define FASTLED_CYCLE_COUNTER_DWT 1
+#endif
+
+#ifndef FASTLED_HAS_CYCLE_COUNTER
+#if defined(FASTLED_CYCLE_COUNTER_ESP32) || defined(FASTLED_CYCLE_COUNTER_DWT)
+#define FASTLED_HAS_CYCLE_COUNTER 1
+#else
+#define FASTLED_HAS_CYCLE_COUNTER 0
+#endif
+#endif
+
+namespace fl {
+
+#if defined(FASTLED_CYCLE_COUNTER_DWT)
+namespace cycle_counter_detail {
+// Architectural addresses, the same on every Cortex-M with a DWT unit.
+static volatile uint32_t *const kDemcr = (volatile uint32_t *)0xE000EDFC;
+static volatile uint32_t *const kDwtCtrl = (volatile uint32_t *)0xE0001000;
+static volatile uint32_t *const kDwtCyccnt = (volatile uint32_t *)0xE0001004;
+static const uint32_t kDemcrTrcena = 1ul << 24;
+static const uint32_t kDwtCtrlCyccntena = 1ul << 0;
+}  // namespace cycle_counter_detail
+#endif
+
+// Starts the counter where it has to be enabled first (DWT). Cheap, and
+// safe to call more than once.
+inline void cycleCounterBegin() {
+#if defined(FASTLED_CYCLE_COUNTER_DWT)
+    using namespace cycle_counter_detail;
+    *kDemcr |= kDemcrTrcena;
+    *kDwtCtrl |= kDwtCtrlCyccntena;
+#endif
+}
+
+FASTLED_FORCE_INLINE uint32_t cycleCount() {
+#if defined(FASTLED_CYCLE_COUNTER_ESP32)
+    return __clock_cycles();
+#elif defined(FASTLED_CYCLE_COUNTER_DWT)
+    return *cycle_counter_detail::kDwtCyccnt;
+#else
+    return micros();
+#endif
+}
+
+// Counts per second of cycleCount().
+inline uint32_t cycleCounterHz() {
+#if FASTLED_HAS_CYCLE_COUNTER && defined(F_CPU)
+    return F_CPU;
+#else
+    return 1000000;
+#endif
+}
+
+}  // namespace fl
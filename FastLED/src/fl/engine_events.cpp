@@ -98,6 +98,15 @@ void EngineEvents::_onEndShowLeds() {
     }
 }
 
+void EngineEvents::_onShowComplete() {
+    // Make the copy of the listener list to avoid issues with listeners being added or removed during the loop.
+    ListenerList copy = mListeners;
+    for (auto& item : copy) {
+        auto listener = item.listener;
+        listener->onShowComplete();
+    }
+}
+
 void EngineEvents::_onEndFrame() {
     // Make the copy of the listener list to avoid issues with listeners being added or removed during the loop.
     ListenerList copy = mListeners;
@@ -37,6 +37,10 @@ class EngineEvents {
         virtual ~Listener();
         virtual void onBeginFrame() {}
         virtual void onEndShowLeds() {}
+        // Called once per frame after every controller has finished clocking
+        // out the data handed to it by show(). For async controllers this can
+        // happen well after show() has already returned.
+        virtual void onShowComplete() {}
         virtual void onEndFrame() {}
         virtual void onStripAdded(CLEDController *strip, uint32_t num_leds) {
             (void)strip;
@@ -90,6 +94,12 @@ class EngineEvents {
         #endif
     }
     
+    static void onShowComplete() {
+        #if FASTLED_HAS_ENGINE_EVENTS
+        EngineEvents::getInstance()->_onShowComplete();
+        #endif
+    }
+
     static void onEndFrame() {
         #if FASTLED_HAS_ENGINE_EVENTS
         EngineEvents::getInstance()->_onEndFrame();
@@ -128,6 +138,7 @@ class EngineEvents {
     void _removeListener(Listener *listener);
     void _onBeginFrame();
     void _onEndShowLeds();
+    void _onShowComplete();
     void _onEndFrame();
     void _onStripAdded(CLEDController *strip, uint32_t num_leds);
     void _onCanvasUiSet(CLEDController *strip, const ScreenMap& xymap);
@@ -2,6 +2,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "FastLED.h"
+#include "fastled_progmem.h"
 #include "fl/force_inline.h"
 #include "fl/namespace.h"
 #include "fl/xymap.h"
@@ -60,6 +62,16 @@ XYMap XYMap::constructWithLookUpTable(uint16_t width, uint16_t height,
 
 
 
+XYMap XYMap::constructWithFlashLookUpTable(uint16_t width, uint16_t height,
+                                           const uint16_t *flashTable, uint16_t offset) {
+    XYMap out(width, height, kFlashLookUpTable);
+    out.mFlashTable = flashTable;
+    out.mOffset = offset;
+    return out;
+}
+
+
+
 XYMap::XYMap(uint16_t width, uint16_t height, bool is_serpentine, uint16_t offset)
     : type(is_serpentine ? kSerpentine : kLineByLine),
       width(width), height(height), mOffset(offset) {}
@@ -91,6 +103,7 @@ void XYMap::convertToLookUpTable() {
     }
     type = kLookUpTable;
     xyFunction = nullptr;
+    mFlashTable = nullptr;
 }
 
 
@@ -99,6 +112,7 @@ void XYMap::setRectangularGrid() {
     type = kLineByLine;
     xyFunction = nullptr;
     mLookUpTable.reset();
+    mFlashTable = nullptr;
 }
 
 
@@ -122,6 +136,9 @@ uint16_t XYMap::mapToIndex(uint16_t x, uint16_t y) const {
     case kLookUpTable:
         index = mLookUpTable->getData()[y * width + x];
         break;
+    case kFlashLookUpTable:
+        index = FL_PGM_READ_WORD_NEAR(mFlashTable + y * width + x);
+        break;
     default:
         return 0;
     }
@@ -37,7 +37,7 @@ typedef uint16_t (*XYFunction)(uint16_t x, uint16_t y, uint16_t width,
 // 1D index.
 class XYMap {
   public:
-    enum XyMapType { kSerpentine = 0, kLineByLine, kFunction, kLookUpTable };
+    enum XyMapType { kSerpentine = 0, kLineByLine, kFunction, kLookUpTable, kFlashLookUpTable };
 
     static XYMap constructWithUserFunction(uint16_t width, uint16_t height,
                                            XYFunction xyFunction,
@@ -50,6 +50,13 @@ class XYMap {
                                           const uint16_t *lookUpTable,
                                           uint16_t offset = 0);
 
+    // The table is not copied, it must stay valid for the lifetime of the map.
+    // It's read with FL_PGM_READ_WORD_NEAR, so it can live in PROGMEM. See
+    // fl/xymap_layout.h for generating one at compile time.
+    static XYMap constructWithFlashLookUpTable(uint16_t width, uint16_t height,
+                                               const uint16_t *flashTable,
+                                               uint16_t offset = 0);
+
     // is_serpentine is true by default. You probably want this unless you are
     // using a different layout
     XYMap(uint16_t width, uint16_t height, bool is_serpentine = true,
@@ -84,6 +91,7 @@ class XYMap {
     uint16_t height;
     XYFunction xyFunction = nullptr;
     fl::LUT16Ptr mLookUpTable; // optional refptr to look up table.
+    const uint16_t *mFlashTable = nullptr; // optional table in flash, not owned.
     uint16_t mOffset = 0;      // offset to be added to the output
 };
 
@@ -0,0 +1,126 @@
+#pragma once
+
+/*
+Compile time XY layouts.
+
+A layout is a struct with kWidth, kHeight and a constexpr map(x, y). Using a
+layout through StaticXYMap inlines the index math at the call site, and
+XYLayoutTable<> generates the full look up table at compile time and places it
+in flash (PROGMEM on AVR), so it costs no RAM.
+
+    typedef fl::TiledLayout<4, 2, fl::SerpentineLayout<8, 8>> Wall;
+    fl::StaticXYMap<Wall> xy;
+    leds[xy(x, y)] = CRGB::Red;             // no call, no table
+    MyFx2d fx(fl::StaticXYMap<Wall>::toXYMap());  // table read from flash
+
+Everything here is plain C++11 constexpr, so it works with the AVR toolchain.
+*/
+
+#include <stdint.h>
+
+#include "fastled_progmem.h"
+#include "fl/force_inline.h"
+#include "fl/xymap.h"
+#include "fl/namespace.h"
+
+namespace fl {
+
+// Rows run left to right.
+template <uint16_t W, uint16_t H> struct LineByLineLayout {
+    static constexpr uint16_t kWidth = W;
+    static constexpr uint16_t kHeight = H;
+    static constexpr uint16_t map(uint16_t x, uint16_t y) {
+        return y * W + x;
+    }
+};
+
+// Every second row runs right to left, same as xy_serpentine().
+template <uint16_t W, uint16_t H> struct SerpentineLayout {
+    static constexpr uint16_t kWidth = W;
+    static constexpr uint16_t kHeight = H;
+    static constexpr uint16_t map(uint16_t x, uint16_t y) {
+        return (y & 1) ? (y + 1) * W - 1 - x : y * W + x;
+    }
+};
+
+// TilesX by TilesY identical panels, each wired as Panel. The data line goes
+// through the panels row by row, reversing direction on every second row of
+// panels when SerpentineTiles is true. All panels are mounted the same way up.
+template <uint16_t TilesX, uint16_t TilesY, typename Panel,
+          bool SerpentineTiles = true>
+struct TiledLayout {
+    static constexpr uint16_t kWidth = TilesX * Panel::kWidth;
+    static constexpr uint16_t kHeight = TilesY * Panel::kHeight;
+    static constexpr uint16_t kPanelSize = Panel::kWidth * Panel::kHeight;
+    static constexpr uint16_t tile(uint16_t tx, uint16_t ty) {
+        return (SerpentineTiles && (ty & 1)) ? (ty + 1) * TilesX - 1 - tx
+                                             : ty * TilesX + tx;
+    }
+    static constexpr uint16_t map(uint16_t x, uint16_t y) {
+        return tile(x / Panel::kWidth, y / Panel::kHeight) * kPanelSize +
+               Panel::map(x % Panel::kWidth, y % Panel::kHeight);
+    }
+};
+
+namespace xymap_layout_detail {
+// C++11 stand in for std::index_sequence. Built by halving so a 64x64 table
+// stays well inside the template recursion limit.
+template <uint16_t... I> struct IndexSeq {
+    typedef IndexSeq type;
+};
+template <typename A, typename B> struct ConcatSeq;
+template <uint16_t... A, uint16_t... B>
+struct ConcatSeq<IndexSeq<A...>, IndexSeq<B...>>
+    : IndexSeq<A..., uint16_t(sizeof...(A) + B)...> {};
+template <uint32_t N>
+struct MakeSeq : ConcatSeq<typename MakeSeq<N / 2>::type,
+                           typename MakeSeq<N - N / 2>::type> {};
+template <> struct MakeSeq<0> : IndexSeq<> {};
+template <> struct MakeSeq<1> : IndexSeq<0> {};
+} // namespace xymap_layout_detail
+
+// The look up table of a layout, generated at compile time and stored in flash.
+// Read entries with FL_PGM_READ_WORD_NEAR().
+template <typename Layout,
+          typename Seq = typename xymap_layout_detail::MakeSeq<
+              uint32_t(Layout::kWidth) * Layout::kHeight>::type>
+struct XYLayoutTable;
+
+template <typename Layout, uint16_t... I>
+struct XYLayoutTable<Layout, xymap_layout_detail::IndexSeq<I...>> {
+    static const uint16_t kData[sizeof...(I)];
+};
+
+template <typename Layout, uint16_t... I>
+const uint16_t XYLayoutTable<Layout, xymap_layout_detail::IndexSeq<I...>>::kData
+    [sizeof...(I)] FL_PROGMEM = {
+        Layout::map(I % Layout::kWidth, I / Layout::kWidth)...};
+
+// XYMap counterpart for a compile time layout. Out of range coordinates are
+// not wrapped, callers are expected to stay inside the grid.
+template <typename Layout> class StaticXYMap {
+  public:
+    static constexpr uint16_t kWidth = Layout::kWidth;
+    static constexpr uint16_t kHeight = Layout::kHeight;
+    static constexpr uint16_t kTotal = Layout::kWidth * Layout::kHeight;
+
+    FASTLED_FORCE_INLINE static constexpr uint16_t mapToIndex(uint16_t x,
+                                                              uint16_t y) {
+        return Layout::map(x, y);
+    }
+    FASTLED_FORCE_INLINE constexpr uint16_t operator()(uint16_t x,
+                                                       uint16_t y) const {
+        return Layout::map(x, y);
+    }
+
+    // The flash look up table for this layout.
+    static const uint16_t *table() { return XYLayoutTable<Layout>::kData; }
+
+    // A runtime XYMap that reads the flash table, for the 2D effects.
+    static XYMap toXYMap(uint16_t offset = 0) {
+        return XYMap::constructWithFlashLookUpTable(kWidth, kHeight, table(),
+                                                    offset);
+    }
+};
+
+} // namespace fl
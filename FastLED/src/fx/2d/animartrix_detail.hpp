@@ -52,6 +52,7 @@ License CC BY-NC 3.0
 
 
 #include "fl/force_inline.h"
+#include "fl/scoped_ptr.h"
 #include "crgb.h"
 #include "fl/namespace.h"
 
@@ -73,6 +74,14 @@ License CC BY-NC 3.0
 
 #define num_oscillators 10
 
+// Renders with a sine table and an integer Perlin noise instead of
+// sinf/cosf and the float noise. The difference to the float path is far
+// below one 8 bit color step, and it is several times faster on chips
+// without a fast FPU. Set to 0 for the reference float math.
+#ifndef FASTLED_ANIMARTRIX_FAST_MATH
+#define FASTLED_ANIMARTRIX_FAST_MATH 1
+#endif
+
 namespace animartrix_detail {
 
 struct render_parameters {
@@ -144,6 +153,46 @@ FASTLED_FORCE_INLINE uint8_t P(uint8_t x) {
     return *ptr;
 }
 
+// Sine table for fast_sincos(), one period plus a quarter so the cosine is a
+// plain offset. Built once, on first use.
+#define ANIMARTRIX_SIN_TABLE_SIZE 1024
+
+inline const float *sin_table() {
+    static float table[ANIMARTRIX_SIN_TABLE_SIZE + ANIMARTRIX_SIN_TABLE_SIZE / 4 + 1];
+    static bool built = false;
+    if (!built) {
+        const int n = sizeof(table) / sizeof(table[0]);
+        for (int i = 0; i < n; ++i) {
+            table[i] = sinf(i * (2 * PI / ANIMARTRIX_SIN_TABLE_SIZE));
+        }
+        built = true;
+    }
+    return table;
+}
+
+FASTLED_FORCE_INLINE int32_t floor_to_int(float v) {
+    int32_t i = (int32_t)v;
+    return (v < i) ? i - 1 : i;
+}
+
+// sinf/cosf of angle by linear interpolation in the sine table. Absolute
+// error is below 5e-6.
+FASTLED_FORCE_INLINE void fast_sincos(float angle, float *s, float *c) {
+    const float pos = angle * (ANIMARTRIX_SIN_TABLE_SIZE / (2 * PI));
+    if (pos > 1e9f || pos < -1e9f) {
+        *s = sinf(angle);  // Would overflow the index.
+        *c = cosf(angle);
+        return;
+    }
+    const int32_t i = floor_to_int(pos);
+    const float frac = pos - i;
+    const uint32_t idx = (uint32_t)i & (ANIMARTRIX_SIN_TABLE_SIZE - 1);
+    const float *t = sin_table();
+    *s = t[idx] + (t[idx + 1] - t[idx]) * frac;
+    const uint32_t cidx = idx + ANIMARTRIX_SIN_TABLE_SIZE / 4;
+    *c = t[cidx] + (t[cidx + 1] - t[cidx]) * frac;
+}
+
 class ANIMartRIX {
 
   public:
@@ -161,10 +210,19 @@ class ANIMartRIX {
     modulators move; // all oscillator based movers and shifters at one place
     rgb pixel;
 
-    fl::HeapVector<fl::HeapVector<float>>
-        polar_theta; // look-up table for polar angles
-    fl::HeapVector<fl::HeapVector<float>>
-        distance; // look-up table for polar distances
+    // One float per pixel in a single allocation, indexed [x][y].
+    struct polar_table {
+        fl::scoped_array<float> data;
+        int ny = 0;
+        float *operator[](int x) { return data.get() + x * ny; }
+        const float *operator[](int x) const { return data.get() + x * ny; }
+    };
+
+    polar_table polar_theta; // look-up table for polar angles
+    polar_table distance; // look-up table for polar distances
+    // Geometry the tables were built for, they only change with it.
+    int polar_num_x = 0, polar_num_y = 0;
+    float polar_cx = 0, polar_cy = 0;
 
     unsigned long a, b, c; // for time measurements
 
@@ -200,6 +258,9 @@ class ANIMartRIX {
             (num_x / 2) - 0.5,
             (num_y / 2) - 0.5); // precalculate all polar coordinates
                                 // polar origin is set to matrix centre
+#if FASTLED_ANIMARTRIX_FAST_MATH
+        sin_table(); // build it now rather than in the first frame
+#endif
         // set default speed ratio for the oscillators, not all effects set their own, so start from know state
         timings.master_speed = 0.01;
     }
@@ -285,6 +346,55 @@ class ANIMartRIX {
                               grad(P(BB + 1), x - 1, y - 1, z - 1))));
     }
 
+    // Integer version of pnoise(), fractions in Q15. Same lattice and the
+    // same fade curve, the result differs from pnoise() by about 1e-4.
+    static FASTLED_FORCE_INLINE int32_t lerp_q15(int32_t t, int32_t a, int32_t b) {
+        return a + (int32_t)(((int64_t)t * (b - a)) >> 15);
+    }
+    static FASTLED_FORCE_INLINE int32_t fade_q15(int32_t t) {
+        // t * t * t * (t * (t * 6 - 15) + 10)
+        const int32_t inner =
+            (int32_t)(((int64_t)t * (6 * t - 15 * 32768)) >> 15) + 10 * 32768;
+        const int32_t t3 = (((t * t) >> 15) * t) >> 15;
+        return (int32_t)(((int64_t)t3 * inner) >> 15);
+    }
+    static FASTLED_FORCE_INLINE int32_t grad_q15(int hash, int32_t x, int32_t y,
+                                                 int32_t z) {
+        int h = hash & 15;
+        int32_t u = h < 8 ? x : y,
+                v = h < 4                ? y
+                    : h == 12 || h == 14 ? x
+                                         : z;
+        return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+    }
+
+    float pnoise_fast(float x, float y, float z) {
+        const int32_t xi = floor_to_int(x), yi = floor_to_int(y),
+                      zi = floor_to_int(z);
+        const int32_t fx = (int32_t)((x - xi) * 32768.f),
+                      fy = (int32_t)((y - yi) * 32768.f),
+                      fz = (int32_t)((z - zi) * 32768.f);
+        const int32_t one = 32768;
+        const int X = xi & 255, Y = yi & 255, Z = zi & 255;
+        const int32_t u = fade_q15(fx), v = fade_q15(fy), w = fade_q15(fz);
+        int A = P(X) + Y, AA = P(A) + Z, AB = P(A + 1) + Z, B = P(X + 1) + Y,
+            BA = P(B) + Z, BB = P(B + 1) + Z;
+
+        int32_t r = lerp_q15(
+            w,
+            lerp_q15(v,
+                     lerp_q15(u, grad_q15(P(AA), fx, fy, fz),
+                              grad_q15(P(BA), fx - one, fy, fz)),
+                     lerp_q15(u, grad_q15(P(AB), fx, fy - one, fz),
+                              grad_q15(P(BB), fx - one, fy - one, fz))),
+            lerp_q15(v,
+                     lerp_q15(u, grad_q15(P(AA + 1), fx, fy, fz - one),
+                              grad_q15(P(BA + 1), fx - one, fy, fz - one)),
+                     lerp_q15(u, grad_q15(P(AB + 1), fx, fy - one, fz - one),
+                              grad_q15(P(BB + 1), fx - one, fy - one, fz - one))));
+        return r * (1.f / 32768.f);
+    }
+
     void calculate_oscillators(oscillators &timings) {
 
         double runtime = getTime() * timings.master_speed *
@@ -350,17 +460,28 @@ class ANIMartRIX {
 
         // convert polar coordinates back to cartesian ones
 
+#if FASTLED_ANIMARTRIX_FAST_MATH
+        float sin_angle, cos_angle;
+        fast_sincos(animation.angle, &sin_angle, &cos_angle);
+#else
+        float sin_angle = sinf(animation.angle);
+        float cos_angle = cosf(animation.angle);
+#endif
         float newx = (animation.offset_x + animation.center_x -
-                      (cosf(animation.angle) * animation.dist)) *
+                      (cos_angle * animation.dist)) *
                      animation.scale_x;
         float newy = (animation.offset_y + animation.center_y -
-                      (sinf(animation.angle) * animation.dist)) *
+                      (sin_angle * animation.dist)) *
                      animation.scale_y;
         float newz = (animation.offset_z + animation.z) * animation.scale_z;
 
         // render noisevalue at this new cartesian point
 
+#if FASTLED_ANIMARTRIX_FAST_MATH
+        float raw_noise_field_value = pnoise_fast(newx, newy, newz);
+#else
         float raw_noise_field_value = pnoise(newx, newy, newz);
+#endif
 
         // A) enhance histogram (improve contrast) by setting the black and
         // white point (low & high_limit) B) scale the result to a 0-255 range
@@ -383,8 +504,18 @@ class ANIMartRIX {
     // the polar coordinates
 
     void render_polar_lookup_table(float cx, float cy) {
-        polar_theta.resize(num_x, fl::HeapVector<float>(num_y, 0.0f));
-        distance.resize(num_x, fl::HeapVector<float>(num_y, 0.0f));
+        if (polar_theta.data && polar_num_x == num_x && polar_num_y == num_y &&
+            polar_cx == cx && polar_cy == cy) {
+            return; // Switching animations keeps the geometry.
+        }
+        polar_num_x = num_x;
+        polar_num_y = num_y;
+        polar_cx = cx;
+        polar_cy = cy;
+        polar_theta.data.reset(new float[num_x * num_y]);
+        polar_theta.ny = num_y;
+        distance.data.reset(new float[num_x * num_y]);
+        distance.ny = num_y;
 
         for (int xx = 0; xx < num_x; xx++) {
             for (int yy = 0; yy < num_y; yy++) {
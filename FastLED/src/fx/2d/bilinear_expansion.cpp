@@ -270,4 +270,112 @@ void bilinearExpandFloat(const CRGB *input, CRGB *output,
     }
 }
 
-}  // namespace fl
\ No newline at end of file
+void BilinearExpandPlan::plan(uint16_t inputWidth, uint16_t inputHeight,
+                              uint16_t outputWidth, uint16_t outputHeight) {
+    if (matches(inputWidth, inputHeight, outputWidth, outputHeight) && mColIndex) {
+        return;
+    }
+    mInW = inputWidth;
+    mInH = inputHeight;
+    mOutW = outputWidth;
+    mOutH = outputHeight;
+    mColIndex.reset(new uint16_t[2 * outputWidth]);
+    mColFrac.reset(new uint8_t[outputWidth]);
+    mRowIndex.reset(new uint16_t[2 * outputHeight]);
+    mRowFrac.reset(new uint8_t[outputHeight]);
+    mRowCache.reset(new uint16_t[2 * 3 * outputWidth]);
+    mCachedRow[0] = mCachedRow[1] = -1;
+    mNextSlot = 0;
+
+    // Same source positions as bilinearExpandArbitrary().
+    const uint32_t scale_factor = 256;
+    for (uint16_t x = 0; x < outputWidth; x++) {
+        uint32_t fx = outputWidth > 1 ? ((uint32_t)x * (inputWidth - 1) * scale_factor) /
+                                            (outputWidth - 1)
+                                      : 0;
+        uint16_t ix = fx / scale_factor;
+        mColIndex[2 * x] = ix;
+        mColIndex[2 * x + 1] = (ix + 1 < inputWidth) ? ix + 1 : ix;
+        mColFrac[x] = fx % scale_factor;
+    }
+    for (uint16_t y = 0; y < outputHeight; y++) {
+        uint32_t fy = outputHeight > 1 ? ((uint32_t)y * (inputHeight - 1) * scale_factor) /
+                                             (outputHeight - 1)
+                                       : 0;
+        uint16_t iy = fy / scale_factor;
+        mRowIndex[2 * y] = iy;
+        mRowIndex[2 * y + 1] = (iy + 1 < inputHeight) ? iy + 1 : iy;
+        mRowFrac[y] = fy % scale_factor;
+    }
+}
+
+const uint16_t *BilinearExpandPlan::horizontalRow(const CRGB *input, uint16_t iy) {
+    for (int slot = 0; slot < 2; ++slot) {
+        if (mCachedRow[slot] == iy) {
+            return mRowCache.get() + slot * 3 * mOutW;
+        }
+    }
+    // Rows are visited top to bottom, replace the older one.
+    const uint8_t slot = mNextSlot;
+    mNextSlot ^= 1;
+    mCachedRow[slot] = iy;
+    uint16_t *out = mRowCache.get() + slot * 3 * mOutW;
+    const uint8_t *row = reinterpret_cast<const uint8_t *>(input + iy * mInW);
+    for (uint16_t x = 0; x < mOutW; x++) {
+        const uint8_t *c0 = row + 3 * mColIndex[2 * x];
+        const uint8_t *c1 = row + 3 * mColIndex[2 * x + 1];
+        const uint16_t dx = mColFrac[x];
+        const uint16_t dx_inv = 256 - dx;
+        // At most 255 * 256, fits.
+        out[3 * x + 0] = c0[0] * dx_inv + c1[0] * dx;
+        out[3 * x + 1] = c0[1] * dx_inv + c1[1] * dx;
+        out[3 * x + 2] = c0[2] * dx_inv + c1[2] * dx;
+    }
+    return out;
+}
+
+void BilinearExpandPlan::expand(const CRGB *input, CRGB *output,
+                                uint16_t inputWidth, uint16_t inputHeight,
+                                const XYMap &xyMap) {
+    const uint16_t outputWidth = xyMap.getWidth();
+    const uint16_t outputHeight = xyMap.getHeight();
+    if (!inputWidth || !inputHeight || !outputWidth || !outputHeight) {
+        return;
+    }
+    plan(inputWidth, inputHeight, outputWidth, outputHeight);
+    // The input changes every frame, the cached rows do not survive it.
+    mCachedRow[0] = mCachedRow[1] = -1;
+    mNextSlot = 0;
+
+    const uint16_t n = xyMap.getTotal();
+    // Line by line rows are contiguous in the output, blend them in one go.
+    const bool rectangular = xyMap.getType() == XYMap::kLineByLine;
+    for (uint16_t y = 0; y < outputHeight; y++) {
+        // w00 = dx_inv * dy_inv etc. factor into the horizontal rows, so
+        // this is the same sum bilinearInterpolate() computes.
+        const uint16_t *top = horizontalRow(input, mRowIndex[2 * y]);
+        const uint16_t *bottom = horizontalRow(input, mRowIndex[2 * y + 1]);
+        const uint32_t dy = mRowFrac[y];
+        const uint32_t dy_inv = 256 - dy;
+        if (rectangular && xyMap.mapToIndex(outputWidth - 1, y) < n) {
+            uint8_t *out =
+                reinterpret_cast<uint8_t *>(output + xyMap.mapToIndex(0, y));
+            for (uint32_t i = 0; i < 3u * outputWidth; i++) {
+                out[i] = (top[i] * dy_inv + bottom[i] * dy + 32768) >> 16;
+            }
+            continue;
+        }
+        for (uint16_t x = 0; x < outputWidth; x++) {
+            const uint16_t *t = top + 3 * x;
+            const uint16_t *b = bottom + 3 * x;
+            uint16_t idx = xyMap.mapToIndex(x, y);
+            if (idx < n) {
+                output[idx] = CRGB((t[0] * dy_inv + b[0] * dy + 32768) >> 16,
+                                   (t[1] * dy_inv + b[1] * dy + 32768) >> 16,
+                                   (t[2] * dy_inv + b[2] * dy + 32768) >> 16);
+            }
+        }
+    }
+}
+
+}  // namespace fl
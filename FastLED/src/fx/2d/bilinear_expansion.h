@@ -8,6 +8,7 @@
 
 #include "crgb.h"
 #include "fl/namespace.h"
+#include "fl/scoped_ptr.h"
 #include "fl/xymap.h"
 
 
@@ -59,4 +60,44 @@ void bilinearExpandArbitraryFloat(const CRGB *input, CRGB *output,
 uint8_t bilinearInterpolateFloat(uint8_t v00, uint8_t v10, uint8_t v01,
                                  uint8_t v11, float dx, float dy);
 
+/// @brief Bilinear upscaler with the coordinate math done once.
+/// Produces exactly the output of bilinearExpandArbitrary(), but the source
+/// indices and weights of every output row and column are computed when the
+/// sizes change instead of for every pixel of every frame. The weights are
+/// separable, so each source row is blended horizontally once into a cached
+/// row and every output row between two source rows only needs the vertical
+/// blend of two cached rows.
+class BilinearExpandPlan {
+  public:
+    BilinearExpandPlan() = default;
+    BilinearExpandPlan(const BilinearExpandPlan &) = delete;
+    BilinearExpandPlan &operator=(const BilinearExpandPlan &) = delete;
+
+    /// Rebuilds the tables, only if the sizes differ from the last plan.
+    void plan(uint16_t inputWidth, uint16_t inputHeight, uint16_t outputWidth,
+              uint16_t outputHeight);
+    bool matches(uint16_t inputWidth, uint16_t inputHeight,
+                 uint16_t outputWidth, uint16_t outputHeight) const {
+        return mInW == inputWidth && mInH == inputHeight &&
+               mOutW == outputWidth && mOutH == outputHeight;
+    }
+
+    /// Same arguments as bilinearExpandArbitrary(), replans when needed.
+    void expand(const CRGB *input, CRGB *output, uint16_t inputWidth,
+                uint16_t inputHeight, const fl::XYMap &xyMap);
+
+  private:
+    // Horizontal pass of input row iy into cache slot, 3 channels per pixel.
+    const uint16_t *horizontalRow(const CRGB *input, uint16_t iy);
+
+    uint16_t mInW = 0, mInH = 0, mOutW = 0, mOutH = 0;
+    fl::scoped_array<uint16_t> mColIndex; // ix, ix1 per output column
+    fl::scoped_array<uint8_t> mColFrac;   // dx per output column
+    fl::scoped_array<uint16_t> mRowIndex; // iy, iy1 per output row
+    fl::scoped_array<uint8_t> mRowFrac;   // dy per output row
+    fl::scoped_array<uint16_t> mRowCache; // two horizontally blended rows
+    int32_t mCachedRow[2] = {-1, -1};
+    uint8_t mNextSlot = 0;
+};
+
 } // namespace fl
@@ -32,6 +32,7 @@ NoisePalette::NoisePalette(XYMap xyMap, float fps)
 
     // Allocate memory for the noise array using scoped_ptr
     noise = scoped_ptr<uint8_t>(new uint8_t[width * height]);
+    mNoiseRow.reset(new uint8_t[width]);
 }
 
 void NoisePalette::setPalettePreset(int paletteIndex) {
@@ -145,12 +146,15 @@ void NoisePalette::fillnoise8() {
         dataSmoothing = 200 - (speed * 4);
     }
 
-    for (uint16_t i = 0; i < width; i++) {
-        int ioffset = scale * i;
-        for (uint16_t j = 0; j < height; j++) {
-            int joffset = scale * j;
-
-            uint8_t data = inoise8(mX + ioffset, mY + joffset, mZ);
+    // The noise is generated a row at a time so the lattice hashes are
+    // shared along the row, then stored column by column as before.
+    uint8_t *row = mNoiseRow.get();
+    uint8_t *data_out = noise.get();
+    for (uint16_t j = 0; j < height; j++) {
+        int joffset = scale * j;
+        fill_raw_noise_grid8(row, width, 1, mX, scale, mY + joffset, scale, mZ);
+        for (uint16_t i = 0; i < width; i++) {
+            uint8_t data = row[i];
 
             // The range of the inoise8 function is roughly 16-238.
             // These two operations expand those values out to roughly
@@ -160,13 +164,13 @@ void NoisePalette::fillnoise8() {
             data = qadd8(data, scale8(data, 39));
 
             if (dataSmoothing) {
-                uint8_t olddata = noise.get()[i * height + j];
+                uint8_t olddata = data_out[i * height + j];
                 uint8_t newdata = scale8(olddata, dataSmoothing) +
                                   scale8(data, 256 - dataSmoothing);
                 data = newdata;
             }
 
-            noise.get()[i * height + j] = data;
+            data_out[i * height + j] = data;
         }
     }
 
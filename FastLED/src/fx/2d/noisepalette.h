@@ -11,6 +11,7 @@
 #include "lib8tion/random8.h"
 #include "noise.h"
 #include "fl/ptr.h"
+#include "fl/scoped_ptr.h"
 #include "fl/xymap.h"
 #include "fx/time.h"
 
@@ -61,6 +62,7 @@ class NoisePalette : public Fx2d {
     uint16_t speed = 0;
     uint16_t scale = 0;
     fl::scoped_ptr<uint8_t> noise;
+    fl::scoped_array<uint8_t> mNoiseRow;  // one row of fresh noise
     CRGBPalette16 currentPalette;
     bool colorLoop = 0;
     int currentPaletteIndex = 0;
@@ -20,9 +20,10 @@
 // arbitrary grid sizes.
 #define FASTLED_SCALE_UP_HIGH_PRECISION 1 // 1 for always choose high precision.
 // Uses the most executable memory because both low and high precision versions
-// are compiled in. If the grid size is a power of 2 then the faster version is
-// used. Note that the floating point version has to be directly specified
-// because in testing it offered no benefits over the integer versions.
+// are compiled in. Note that the floating point version has to be directly
+// specified because in testing it offered no benefits over the integer
+// versions. Both this and FASTLED_SCALE_UP_HIGH_PRECISION upscale through a
+// BilinearExpandPlan, which is faster than the power of 2 version.
 #define FASTLED_SCALE_UP_DECIDE_AT_RUNTIME 2 // 2 for runtime decision.
 
 #define FASTLED_SCALE_UP_FORCE_FLOATING_POINT 3 // Warning, this is slow.
@@ -64,10 +65,9 @@ void ScaleUp::expand(const CRGB *input, CRGB *output, uint16_t width,
                      uint16_t height, XYMap mXyMap) {
 #if FASTLED_SCALE_UP == FASTLED_SCALE_UP_ALWAYS_POWER_OF_2
     bilinearExpandPowerOf2(input, output, width, height, mXyMap);
-#elif FASTLED_SCALE_UP == FASTLED_SCALE_UP_HIGH_PRECISION
-    bilinearExpandArbitrary(input, output, width, height, mXyMap);
-#elif FASTLED_SCALE_UP == FASTLED_SCALE_UP_DECIDE_AT_RUNTIME
-    bilinearExpand(input, output, width, height, mXyMap);
+#elif FASTLED_SCALE_UP == FASTLED_SCALE_UP_HIGH_PRECISION || \
+    FASTLED_SCALE_UP == FASTLED_SCALE_UP_DECIDE_AT_RUNTIME
+    mPlan.expand(input, output, width, height, mXyMap);
 #elif FASTLED_SCALE_UP == FASTLED_SCALE_UP_FORCE_FLOATING_POINT
     bilinearExpandFloat(input, output, width, height, mXyMap);
 #else
@@ -0,0 +1,40 @@
+#include "FastLED.h"
+#include "fx/detail/fx_compositor.h"
+#include "lib8tion/bulk8.h"
+#include "fl/namespace.h"
+
+namespace fl {
+
+bool FxCompositor::draw(uint32_t now, uint32_t warpedTime, CRGB *finalBuffer) {
+    if (!mLayers[0]->getFx()) {
+        return false;
+    }
+    // Clean layers keep their surface from the last frame.
+    bool changed = mLayers[0]->draw(warpedTime);
+    uint8_t progress = mTransition.getProgress(now);
+    changed = changed || (progress != mLastProgress);
+    mLastProgress = progress;
+    // The output is always written, finalBuffer belongs to the caller and may
+    // have been changed since the last frame.
+    if (!progress) {
+        memcpy(finalBuffer, mLayers[0]->getSurface(), sizeof(CRGB) * mNumLeds);
+        return changed;
+    }
+    // Only blend while the transition is running, the weight changes every
+    // frame so there is nothing to reuse.
+    changed = mLayers[1]->draw(warpedTime) || changed;
+    const CRGB* surface0 = mLayers[0]->getSurface();
+    const CRGB* surface1 = mLayers[1]->getSurface();
+    // Same result as CRGB::blend() per pixel.
+    blend8_bulk(reinterpret_cast<const uint8_t*>(surface0),
+                reinterpret_cast<const uint8_t*>(surface1),
+                reinterpret_cast<uint8_t*>(finalBuffer), mNumLeds * 3,
+                progress);
+    if (progress == 255) {
+        completeTransition();
+        mLastProgress = 0;
+    }
+    return changed;
+}
+
+}  // namespace fl
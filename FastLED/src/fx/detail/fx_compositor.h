@@ -44,7 +44,8 @@ public:
         mTransition.end();
     }
 
-    void draw(uint32_t now, uint32_t warpedTime, CRGB *finalBuffer);
+    // Returns true if the composited pixels differ from the last draw.
+    bool draw(uint32_t now, uint32_t warpedTime, CRGB *finalBuffer);
 
 private:
     void swapLayers() {
@@ -56,31 +57,7 @@ private:
     FxLayerPtr mLayers[2];
     const uint32_t mNumLeds;
     Transition mTransition;
+    uint8_t mLastProgress = 0;
 };
 
-inline void FxCompositor::draw(uint32_t now, uint32_t warpedTime, CRGB *finalBuffer) {
-    if (!mLayers[0]->getFx()) {
-        return;
-    }
-    mLayers[0]->draw(warpedTime);
-    uint8_t progress = mTransition.getProgress(now);
-    if (!progress) {
-        memcpy(finalBuffer, mLayers[0]->getSurface(), sizeof(CRGB) * mNumLeds);
-        return;
-    }
-    mLayers[1]->draw(warpedTime);
-    const CRGB* surface0 = mLayers[0]->getSurface();
-    const CRGB* surface1 = mLayers[1]->getSurface();
-
-    for (uint32_t i = 0; i < mNumLeds; i++) {
-        const CRGB& p0 = surface0[i];
-        const CRGB& p1 = surface1[i];
-        CRGB out = CRGB::blend(p0, p1, progress);
-        finalBuffer[i] = out;
-    }
-    if (progress == 255) {
-        completeTransition();
-    }
-}
-
 }  // namespace fl
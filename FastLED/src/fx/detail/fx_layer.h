@@ -25,7 +25,8 @@ class FxLayer : public fl::Referent {
         }
     }
 
-    void draw(uint32_t now) {
+    // Returns false if the fx was clean and the surface was left as it was.
+    bool draw(uint32_t now) {
         //assert(fx);
         if (!frame) {
             frame = FramePtr::New(fx->getNumLeds());
@@ -36,9 +37,12 @@ class FxLayer : public fl::Referent {
             memset(frame->rgb(), 0, frame->size() * sizeof(CRGB));
             fx->resume(now);
             running = true;
+        } else if (!fx->isDirty(now)) {
+            return false;
         }
         Fx::DrawContext context = {now, frame->rgb()};
         fx->draw(context);
+        return true;
     }
 
     void pause(uint32_t now) {
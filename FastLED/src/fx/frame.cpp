@@ -1,12 +1,14 @@
 
 #include <string.h>
 
+#include "FastLED.h"
 #include "frame.h"
 #include "crgb.h"
 #include "fl/namespace.h"
 #include "fl/ptr.h"
 #include "fl/dbg.h"
 #include "fl/allocator.h"
+#include "lib8tion/bulk8.h"
 
 
 namespace fl {
@@ -44,9 +46,11 @@ void Frame::interpolate(const Frame& frame1, const Frame& frame2, uint8_t amount
         return;
     }
 
-    for (size_t i = 0; i < frame2.size(); ++i) {
-        pixels[i] = CRGB::blend(rgbFirst[i], rgbSecond[i], amountofFrame2);
-    }
+    // Same result as CRGB::blend() per pixel, but word at a time.
+    blend8_bulk(reinterpret_cast<const uint8_t*>(rgbFirst),
+                reinterpret_cast<const uint8_t*>(rgbSecond),
+                reinterpret_cast<uint8_t*>(pixels),
+                frame2.size() * 3, amountofFrame2);
     // We will eventually do something with alpha.
 }
 
@@ -35,6 +35,15 @@ class Fx : public fl::Referent {
       return false;
     }
 
+    // Return false if draw() at this time would leave the pixels exactly as the
+    // last call did. The pixels from the last draw are then reused, and so are
+    // any blends made from them. Effects that change every frame can keep the
+    // default.
+    virtual bool isDirty(uint32_t now) {
+      FASTLED_UNUSED(now);
+      return true;
+    }
+
     // Get the name of the current fx.
     virtual fl::Str fxName() const = 0;
 
@@ -99,7 +99,7 @@ bool FxEngine::draw(uint32_t now, CRGB *finalBuffer) {
         mDurationSet = false;
     }
     if (!mEffects.empty()) {
-        mCompositor.draw(now, warpedTime, finalBuffer);
+        mLastDrawChanged = mCompositor.draw(now, warpedTime, finalBuffer);
     }
     return true;
 }
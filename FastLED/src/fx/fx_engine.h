@@ -91,6 +91,13 @@ class FxEngine {
      */
     bool draw(uint32_t now, CRGB *outputBuffer);
 
+    /**
+     * @brief Whether the last draw() produced different pixels than the one
+     *        before. Clean effects (see Fx::isDirty()) are not redrawn, so a
+     *        static scene can skip FastLED.show() as well.
+     */
+    bool lastDrawChanged() const { return mLastDrawChanged; }
+
     /**
      * @brief Transitions to the next effect in the sequence.
      * @param duration The duration of the transition in milliseconds.
@@ -124,6 +131,7 @@ class FxEngine {
     uint16_t mDuration = 0; ///< Duration of the current transition
     bool mDurationSet = false; ///< Flag indicating if a new transition has been set
     bool mInterpolate = true;
+    bool mLastDrawChanged = false;
 };
 
 }  // namespace fl
@@ -9,6 +9,7 @@
 #include "fl/warn.h"
 #include "fl/math_macros.h"
 #include "fx/video/video_impl.h"
+#include "fx/video/frame_prefetcher.h"
 #include "fx/video/pixel_stream.h"
 #include "fl/bytestreammemory.h"
 
@@ -145,6 +146,21 @@ size_t Video::pixelsPerFrame() const {
     return mImpl->pixelsPerFrame();
 }
 
+void Video::setPrefetch(size_t nFrames) {
+    if (!mImpl) {
+        return;
+    }
+    mImpl->setPrefetch(nFrames);
+}
+
+bool Video::prefetchStats(FramePrefetchStats *stats) const {
+    if (!mImpl || !mImpl->prefetcher()) {
+        return false;
+    }
+    *stats = mImpl->prefetcher()->stats();
+    return true;
+}
+
 bool Video::finished() {
     if (!mImpl) {
         return true;
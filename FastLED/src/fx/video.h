@@ -22,6 +22,7 @@ FASTLED_SMART_PTR(Frame);
 FASTLED_SMART_PTR(VideoImpl);
 FASTLED_SMART_PTR(VideoFxWrapper);
 FASTLED_SMART_PTR(ByteStreamMemory);
+struct FramePrefetchStats;
 
 
 // Video represents a video file that can be played back on a LED strip.
@@ -64,6 +65,11 @@ public:
     Str error() const;
     void setError(const Str& error) { mError = error; }
     size_t pixelsPerFrame() const;
+    // Read nFrames ahead of playback into a ring buffer so slow file reads
+    // don't stall the draw. Only applies to file handles, call before begin().
+    void setPrefetch(size_t nFrames);
+    // Returns false if no prefetching file is playing.
+    bool prefetchStats(FramePrefetchStats *stats) const;
     void pause(uint32_t now) override;
     void resume(uint32_t now) override;
 
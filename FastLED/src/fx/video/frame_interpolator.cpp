@@ -38,8 +38,8 @@ bool FrameInterpolator::draw(uint32_t now, CRGB* leds) {
         return false;
     }
 
-    if (has(frameNumber) && !has(nextFrameNumber)) {
-        // just paint the current frame
+    if (!has(nextFrameNumber) || amountOfNextFrame == 0) {
+        // just paint the current frame, blending by 0 would give the same.
         Frame* frame = get(frameNumber).get();
         frame->draw(leds);
         return true;
@@ -0,0 +1,163 @@
+#include "fx/video/frame_prefetcher.h"
+
+#include "fl/dbg.h"
+#include "fl/namespace.h"
+
+#if FASTLED_VIDEO_PREFETCH_HAS_TASK
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
+#define DBG FASTLED_DBG
+
+namespace fl {
+
+FramePrefetcher::FramePrefetcher(PixelStreamPtr stream, size_t pixelsPerFrame,
+                                 size_t nFrames, bool useTask)
+    : mStream(stream), mCapacity(nFrames ? nFrames : 1) {
+    mFrames.reset(new FramePtr[mCapacity]);
+    mFrameNumbers.reset(new uint32_t[mCapacity]);
+    for (size_t i = 0; i < mCapacity; ++i) {
+        mFrames[i] = FramePtr::New(pixelsPerFrame);
+        mFrameNumbers[i] = 0;
+    }
+    // Only file streams can be read ahead, byte streams have no known length.
+    int32_t total = mStream ? mStream->framesTotal() : -1;
+    mTotalFrames = total > 0 ? uint32_t(total) : 0;
+    if (useTask && startTask()) {
+        return;
+    }
+    EngineEvents::addListener(this);
+}
+
+FramePrefetcher::~FramePrefetcher() {
+    stopTask();
+    EngineEvents::removeListener(this);
+}
+
+size_t FramePrefetcher::fill(size_t maxFrames) {
+    if (!mStream || mTotalFrames == 0) {
+        return 0;
+    }
+    size_t count = 0;
+    while (count < maxFrames) {
+        int32_t seek_to = mSeekTo;
+        if (seek_to >= 0) {
+            mSeekTo = -1;
+            mNextFrame = seek_to;
+        }
+        if (mHead - mTail >= mCapacity) {
+            break;
+        }
+        if (mNextFrame >= mTotalFrames) {
+            mNextFrame = 0;  // Loop, like VideoImpl does at the end of the file.
+        }
+        const uint32_t slot = mHead % mCapacity;
+        if (!mStream->readFrameAt(mNextFrame, mFrames[slot].get())) {
+            DBG("prefetch of frame " << mNextFrame << " failed");
+            ++mStats.readErrors;
+            break;
+        }
+        mFrameNumbers[slot] = mNextFrame;
+        ++mNextFrame;
+        // Publish the frame only after its pixels are written.
+        __sync_synchronize();
+        mHead = mHead + 1;
+        ++count;
+    }
+    return count;
+}
+
+bool FramePrefetcher::read(uint32_t frameNumber, Frame *dst) {
+    if (pastEnd(frameNumber)) {
+        return false;  // Not a miss, the caller loops back to frame 0.
+    }
+    const uint32_t head = mHead;
+    __sync_synchronize();
+    const uint32_t ready = head - mTail;
+    if (ready < mStats.minBuffered) {
+        mStats.minBuffered = ready;
+    }
+    for (uint32_t i = 0; i < ready; ++i) {
+        const uint32_t slot = (mTail + i) % mCapacity;
+        if (mFrameNumbers[slot] == frameNumber) {
+            dst->copy(*mFrames[slot]);
+            mTail = mTail + i + 1;
+            ++mStats.hits;
+            return true;
+        }
+    }
+    ++mStats.underruns;
+    dropAll();
+    if (mTaskRunning) {
+        // The stream belongs to the task now, let it catch up.
+        mSeekTo = frameNumber;
+        return false;
+    }
+    mNextFrame = frameNumber + 1;
+    if (!mStream || !mStream->readFrameAt(frameNumber, dst)) {
+        ++mStats.readErrors;
+        return false;
+    }
+    return true;
+}
+
+void FramePrefetcher::seek(uint32_t frameNumber) {
+    dropAll();
+    if (mTaskRunning) {
+        mSeekTo = frameNumber;
+    } else {
+        mNextFrame = frameNumber;
+    }
+}
+
+void FramePrefetcher::onEndShowLeds() {
+    // The drivers are busy clocking out the frame, use the time to read ahead.
+    fill(kMaxFillPerShow);
+}
+
+#if FASTLED_VIDEO_PREFETCH_HAS_TASK
+
+bool FramePrefetcher::startTask() {
+    mStopTask = false;
+    mTaskRunning = true;
+    BaseType_t ok = xTaskCreatePinnedToCore(
+        &FramePrefetcher::taskMain, "fl_prefetch",
+        FASTLED_VIDEO_PREFETCH_TASK_STACK, this,
+        FASTLED_VIDEO_PREFETCH_TASK_PRIORITY, nullptr,
+        FASTLED_VIDEO_PREFETCH_CORE);
+    if (ok != pdPASS) {
+        DBG("could not start the prefetch task, filling after show() instead");
+        mTaskRunning = false;
+        return false;
+    }
+    return true;
+}
+
+void FramePrefetcher::stopTask() {
+    mStopTask = true;
+    while (mTaskRunning) {
+        vTaskDelay(1);
+    }
+}
+
+void FramePrefetcher::taskMain(void *arg) {
+    FramePrefetcher *self = static_cast<FramePrefetcher *>(arg);
+    while (!self->mStopTask) {
+        if (self->fill(1) == 0) {
+            vTaskDelay(1);  // Ring is full, or the stream failed.
+        }
+    }
+    self->mTaskRunning = false;
+    vTaskDelete(nullptr);
+}
+
+#else
+
+bool FramePrefetcher::startTask() { return false; }
+void FramePrefetcher::stopTask() {}
+void FramePrefetcher::taskMain(void *arg) { (void)arg; }
+
+#endif  // FASTLED_VIDEO_PREFETCH_HAS_TASK
+
+}  // namespace fl
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "fl/namespace.h"
+#include "fl/ptr.h"
+#include "fl/scoped_ptr.h"
+#include "fl/engine_events.h"
+#include "fx/frame.h"
+#include "fx/video/pixel_stream.h"
+
+// Background prefetch task, only where there is an RTOS to run it on.
+#ifndef FASTLED_VIDEO_PREFETCH_HAS_TASK
+#if defined(ESP32)
+#define FASTLED_VIDEO_PREFETCH_HAS_TASK 1
+#else
+#define FASTLED_VIDEO_PREFETCH_HAS_TASK 0
+#endif
+#endif
+
+// Core the prefetch task is pinned to. The Arduino loop runs on core 1.
+#ifndef FASTLED_VIDEO_PREFETCH_CORE
+#define FASTLED_VIDEO_PREFETCH_CORE 0
+#endif
+
+#ifndef FASTLED_VIDEO_PREFETCH_TASK_PRIORITY
+#define FASTLED_VIDEO_PREFETCH_TASK_PRIORITY 1
+#endif
+
+#ifndef FASTLED_VIDEO_PREFETCH_TASK_STACK
+#define FASTLED_VIDEO_PREFETCH_TASK_STACK 4096
+#endif
+
+namespace fl {
+
+FASTLED_SMART_PTR(FramePrefetcher);
+
+// Counters to size the prefetch ring with. A non zero underrun count means
+// the ring ran dry, add frames until it stays at zero.
+struct FramePrefetchStats {
+    uint32_t hits = 0;        // frames served from the ring
+    uint32_t underruns = 0;   // frames that were not ready when drawn
+    uint32_t readErrors = 0;  // failed reads from the stream
+    uint32_t minBuffered = 0xffffffff;  // fewest ready frames seen by read()
+};
+
+// Reads frames from a file backed PixelStream ahead of playback into a ring
+// of frames, so that a slow read (an SD card missing a sector, a flash erase on
+// the same bus) no longer stalls the draw. Frames are allocated with
+// LargeBlockAllocate(), so on ESP32 the ring lands in PSRAM when there is one.
+//
+// The ring is filled from a background task when one is available, otherwise
+// cooperatively right after FastLED.show() has handed the data to the
+// drivers, while the wire is busy. Playback loops at the end of the file like
+// VideoImpl does, so the ring keeps filling across the wrap.
+//
+// There is exactly one reader (the draw) and one writer (the fill), the ring
+// indices are only ever advanced by their owner.
+class FramePrefetcher : public fl::Referent, public EngineEvents::Listener {
+  public:
+    typedef FramePrefetchStats Stats;
+
+    // Frames are read at most this many at a time when filling after show().
+    static const size_t kMaxFillPerShow = 2;
+
+    FramePrefetcher(PixelStreamPtr stream, size_t pixelsPerFrame,
+                    size_t nFrames, bool useTask = FASTLED_VIDEO_PREFETCH_HAS_TASK);
+    ~FramePrefetcher();
+
+    // Copies frameNumber into dst. Frames older than frameNumber are dropped
+    // from the ring. On a miss without a task the frame is read directly, with
+    // a task the task is sent to frameNumber and false returned.
+    bool read(uint32_t frameNumber, Frame *dst);
+    // Reads up to maxFrames frames into the ring. Returns the number read.
+    size_t fill(size_t maxFrames);
+    // Drop everything buffered and continue prefetching from frameNumber.
+    void seek(uint32_t frameNumber);
+
+    bool pastEnd(uint32_t frameNumber) const { return frameNumber >= mTotalFrames; }
+    size_t buffered() const { return mHead - mTail; }
+    size_t capacity() const { return mCapacity; }
+    uint32_t totalFrames() const { return mTotalFrames; }
+    bool usingTask() const { return mTaskRunning; }
+
+    const Stats &stats() const { return mStats; }
+    void resetStats() { mStats = Stats(); }
+
+    // EngineEvents::Listener
+    void onEndShowLeds() override;
+
+  private:
+    bool startTask();
+    void stopTask();
+    static void taskMain(void *arg);
+    void dropAll() { mTail = mHead; }
+
+    PixelStreamPtr mStream;
+    const size_t mCapacity;
+    uint32_t mTotalFrames = 0;
+    fl::scoped_array<FramePtr> mFrames;
+    fl::scoped_array<uint32_t> mFrameNumbers;
+    volatile uint32_t mHead = 0;      // written by the fill side only
+    volatile uint32_t mTail = 0;      // written by the read side only
+    volatile int32_t mSeekTo = -1;    // read side asks the task to seek
+    uint32_t mNextFrame = 0;          // next frame the fill side reads
+    volatile bool mTaskRunning = false;
+    volatile bool mStopTask = false;
+    Stats mStats;
+};
+
+}  // namespace fl
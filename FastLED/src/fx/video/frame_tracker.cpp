@@ -2,21 +2,36 @@
 
 namespace fl {
 
-namespace { // anonymous namespace
-long map(long x, long in_min, long in_max, long out_min, long out_max) {
-    const long run = in_max - in_min;
-    if (run == 0) {
-        return 0; // AVR returns -1, SAM returns 0
-    }
-    const long rise = out_max - out_min;
-    const long delta = x - in_min;
-    return (delta * rise) / run + out_min;
-}
-} // anonymous namespace
-
 FrameTracker::FrameTracker(float fps) {
     // Convert fps to microseconds per frame interval
     mMicrosSecondsPerInterval = static_cast<uint32_t>(1000000.0f / fps + .5f);
+    if (mMicrosSecondsPerInterval == 0) {
+        mMicrosSecondsPerInterval = 1;
+    }
+    mAmountPerMicroQ24 = static_cast<uint32_t>((255ULL << 24) / mMicrosSecondsPerInterval);
+}
+
+void FrameTracker::frameAt(uint64_t microseconds, uint32_t *frameNumber,
+                           uint32_t *frameStart) const {
+    const uint32_t interval = mMicrosSecondsPerInterval;
+    if (microseconds >= mCachedFrameStart) {
+        uint64_t delta = microseconds - mCachedFrameStart;
+        if (delta < interval) {
+            // Same frame as last time.
+        } else if (delta < 2ULL * interval) {
+            ++mCachedFrame;
+            mCachedFrameStart += interval;
+        } else {
+            mCachedFrame = static_cast<uint32_t>(microseconds / interval);
+            mCachedFrameStart = static_cast<uint64_t>(mCachedFrame) * interval;
+        }
+    } else {
+        // Time went backwards, e.g. after a rewind.
+        mCachedFrame = static_cast<uint32_t>(microseconds / interval);
+        mCachedFrameStart = static_cast<uint64_t>(mCachedFrame) * interval;
+    }
+    *frameNumber = mCachedFrame;
+    *frameStart = static_cast<uint32_t>(microseconds - mCachedFrameStart);
 }
 
 void FrameTracker::get_interval_frames(uint32_t now, uint32_t *frameNumber,
@@ -29,17 +44,21 @@ void FrameTracker::get_interval_frames(uint32_t now, uint32_t *frameNumber,
     uint64_t microseconds = static_cast<uint64_t>(effectiveTime) * 1000ULL;
 
     // Calculate frame number with proper rounding
-    *frameNumber = microseconds / mMicrosSecondsPerInterval;
+    uint32_t rel_time = 0;
+    frameAt(microseconds, frameNumber, &rel_time);
     *nextFrameNumber = *frameNumber + 1;
 
     // Calculate interpolation amount if requested
     if (amountOfNextFrame != nullptr) {
-        uint64_t frame1_start = (*frameNumber * mMicrosSecondsPerInterval);
-        uint64_t frame2_start = (*nextFrameNumber * mMicrosSecondsPerInterval);
-        uint32_t rel_time = microseconds - frame1_start;
-        uint32_t frame_duration = frame2_start - frame1_start;
-        uint8_t progress = uint8_t(map(rel_time, 0, frame_duration, 0, 255));
-        *amountOfNextFrame = progress;
+        // rel_time * 255 / interval, the reciprocal can come out one short
+        // so fix that up with a multiply instead of dividing.
+        const uint32_t interval = mMicrosSecondsPerInterval;
+        const uint64_t target = static_cast<uint64_t>(rel_time) * 255;
+        uint32_t progress = static_cast<uint32_t>((static_cast<uint64_t>(rel_time) * mAmountPerMicroQ24) >> 24);
+        if (static_cast<uint64_t>(progress + 1) * interval <= target) {
+            ++progress;
+        }
+        *amountOfNextFrame = uint8_t(progress);
     }
 }
 
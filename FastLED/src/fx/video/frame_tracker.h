@@ -22,8 +22,17 @@ class FrameTracker {
     uint32_t get_exact_timestamp_ms(uint32_t frameNumber) const;
 
   private:
+    void frameAt(uint64_t microseconds, uint32_t* frameNumber, uint32_t* frameStart) const;
+
     uint32_t mMicrosSecondsPerInterval;
     uint32_t mStartTime = 0;
+    // 255 / interval in Q24, so the blend weight needs no division.
+    uint32_t mAmountPerMicroQ24 = 0;
+    // Last frame handed out. Playback moves forward a little per draw, so the
+    // next call is usually in the same or the following frame and is found
+    // with an add instead of a 64 bit division.
+    mutable uint32_t mCachedFrame = 0;
+    mutable uint64_t mCachedFrameStart = 0;
 };
 
 
@@ -0,0 +1,263 @@
+#include "fx/video/net_frame_source.h"
+
+#include <string.h>
+
+#include "fl/dbg.h"
+#include "fl/namespace.h"
+
+#define DBG FASTLED_DBG
+
+namespace fl {
+
+namespace {
+
+// E1.31 (ANSI E1.31-2018) offsets, all fields are big endian.
+const uint8_t kAcnPacketId[12] = {'A', 'S', 'C', '-', 'E', '1', '.',
+                                  '1', '7', 0,   0,   0};
+const uint32_t kVectorRootData = 0x00000004;
+const uint32_t kVectorRootExtended = 0x00000008;
+const uint32_t kVectorFramingData = 0x00000002;
+const uint32_t kVectorFramingSync = 0x00000001;
+const size_t kE131SyncSize = 49;
+const size_t kE131DataHeader = 126;  // channel data starts here
+const uint8_t kE131OptionPreview = 0x80;
+const uint8_t kE131OptionTerminated = 0x40;
+
+// Art-Net 4, the op code is little endian, the rest big endian.
+const uint8_t kArtNetId[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0};
+const uint16_t kOpDmx = 0x5000;
+const uint16_t kOpSync = 0x5200;
+const size_t kArtDmxHeader = 18;
+
+// Packets up to this far behind the last one are taken as reordered and
+// dropped, anything further back as the sender restarting.
+const uint16_t kLateWindow = 20;
+
+inline uint16_t be16(const uint8_t *p) { return uint16_t(p[0]) << 8 | p[1]; }
+inline uint32_t be32(const uint8_t *p) {
+    return uint32_t(be16(p)) << 16 | be16(p + 2);
+}
+
+}  // namespace
+
+NetFrameSource::NetFrameSource() {}
+
+bool NetFrameSource::mapUniverse(uint16_t universe, fl::Slice<CRGB> leds,
+                                 uint16_t firstChannel) {
+    if (mUniverses.size() >= mUniverses.capacity()) {
+        DBG("NetFrameSource: no room for universe " << universe);
+        return false;
+    }
+    Universe u;
+    u.universe = universe;
+    u.firstChannel = firstChannel;
+    u.leds = leds;
+    mUniverses.push_back(u);
+    ++mPending;
+    return true;
+}
+
+size_t NetFrameSource::mapUniverses(uint16_t firstUniverse, fl::Slice<CRGB> leds,
+                                    uint16_t pixelsPerUniverse) {
+    if (pixelsPerUniverse == 0 || pixelsPerUniverse > kPixelsPerUniverse) {
+        pixelsPerUniverse = kPixelsPerUniverse;
+    }
+    size_t mapped = 0;
+    for (size_t start = 0; start < leds.size(); start += pixelsPerUniverse) {
+        size_t end = start + pixelsPerUniverse;
+        if (end > leds.size()) {
+            end = leds.size();
+        }
+        if (!mapUniverse(uint16_t(firstUniverse + mapped), leds.slice(start, end))) {
+            break;
+        }
+        ++mapped;
+    }
+    return mapped;
+}
+
+void NetFrameSource::clearMappings() {
+    mUniverses.clear();
+    mPending = 0;
+    mFrameReady = false;
+}
+
+bool NetFrameSource::takeFrame() {
+    bool ready = mFrameReady;
+    mFrameReady = false;
+    return ready;
+}
+
+const NetUniverseStats *NetFrameSource::stats(uint16_t universe) const {
+    for (size_t i = 0; i < mUniverses.size(); ++i) {
+        if (mUniverses[i].universe == universe) {
+            return &mUniverses[i].stats;
+        }
+    }
+    return nullptr;
+}
+
+void NetFrameSource::resetStats() {
+    for (size_t i = 0; i < mUniverses.size(); ++i) {
+        mUniverses[i].stats = NetUniverseStats();
+    }
+    mFrames = 0;
+    mInvalid = 0;
+}
+
+NetFrameSource::PacketType NetFrameSource::handlePacket(const uint8_t *data,
+                                                        size_t len) {
+    PacketType type = kInvalid;
+    if (data && len >= sizeof(kArtNetId) &&
+        memcmp(data, kArtNetId, sizeof(kArtNetId)) == 0) {
+        type = handleArtNet(data, len);
+    } else if (data && len >= 16 && memcmp(data + 4, kAcnPacketId,
+                                           sizeof(kAcnPacketId)) == 0) {
+        type = handleE131(data, len);
+    }
+    if (type == kInvalid) {
+        ++mInvalid;
+    }
+    return type;
+}
+
+NetFrameSource::PacketType NetFrameSource::handleE131(const uint8_t *data,
+                                                      size_t len) {
+    if (len < kE131SyncSize || be16(data) != 0x0010 || be16(data + 2) != 0) {
+        return kInvalid;
+    }
+    const uint32_t rootVector = be32(data + 18);
+    const uint32_t framingVector = be32(data + 40);
+    if (rootVector == kVectorRootExtended && framingVector == kVectorFramingSync) {
+        const uint16_t syncUniverse = be16(data + 45);
+        if (mSyncUniverse && syncUniverse != mSyncUniverse) {
+            return kIgnored;
+        }
+        markFrameReady();
+        return kSync;
+    }
+    if (rootVector != kVectorRootData || framingVector != kVectorFramingData) {
+        return kIgnored;  // discovery and other extended packets
+    }
+    if (len < kE131DataHeader || data[117] != 0x02 || data[118] != 0xa1) {
+        return kInvalid;
+    }
+    const uint8_t options = data[112];
+    const uint16_t universe = be16(data + 113);
+    if (options & kE131OptionPreview) {
+        return kIgnored;
+    }
+    if (options & kE131OptionTerminated) {
+        // The source is going away, start its sequence afresh next time.
+        for (size_t i = 0; i < mUniverses.size(); ++i) {
+            if (mUniverses[i].universe == universe) {
+                mUniverses[i].lastSequence = -1;
+            }
+        }
+        return kIgnored;
+    }
+    if (data[125] != 0) {
+        return kIgnored;  // alternate start codes carry no dimmer data
+    }
+    if (be16(data + 109) != 0) {
+        mSyncMode = true;  // the sender will follow up with a sync packet
+    }
+    size_t count = be16(data + 123);
+    count = count > 0 ? count - 1 : 0;  // the start code is counted too
+    if (count > len - kE131DataHeader) {
+        count = len - kE131DataHeader;
+    }
+    return handleDmx(universe, data[111], 256, data + kE131DataHeader, count);
+}
+
+NetFrameSource::PacketType NetFrameSource::handleArtNet(const uint8_t *data,
+                                                        size_t len) {
+    if (len < 12) {
+        return kInvalid;
+    }
+    const uint16_t opCode = uint16_t(data[9]) << 8 | data[8];
+    if (opCode == kOpSync) {
+        mSyncMode = true;
+        markFrameReady();
+        return kSync;
+    }
+    if (opCode != kOpDmx) {
+        return kIgnored;  // ArtPoll and friends are the caller's business
+    }
+    if (len < kArtDmxHeader) {
+        return kInvalid;
+    }
+    // The 15 bit port address, Net in the high byte.
+    const uint16_t universe = uint16_t(data[15] & 0x7f) << 8 | data[14];
+    size_t count = be16(data + 16);
+    if (count > len - kArtDmxHeader) {
+        count = len - kArtDmxHeader;
+    }
+    // Sequence 0 means the sender does not number its packets, otherwise it
+    // runs 1 to 255 and wraps back to 1.
+    const int16_t sequence = data[12] ? int16_t(data[12] - 1) : int16_t(-1);
+    return handleDmx(universe, sequence, 255, data + kArtDmxHeader, count);
+}
+
+NetFrameSource::PacketType NetFrameSource::handleDmx(uint16_t universe,
+                                                     int16_t sequence,
+                                                     uint16_t seqModulo,
+                                                     const uint8_t *channels,
+                                                     size_t count) {
+    bool mapped = false;
+    bool completed = false;
+    for (size_t i = 0; i < mUniverses.size(); ++i) {
+        Universe &u = mUniverses[i];
+        if (u.universe != universe) {
+            continue;
+        }
+        if (sequence >= 0 && u.lastSequence >= 0) {
+            const uint16_t ahead =
+                uint16_t(sequence - u.lastSequence + seqModulo) % seqModulo;
+            if (ahead == 0 || ahead > seqModulo - kLateWindow) {
+                ++u.stats.late;
+                continue;
+            }
+            u.stats.lost += ahead - 1;
+        }
+        u.lastSequence = sequence;
+        mapped = true;
+
+        // The only copy, from the packet into the buffer the controller sends.
+        uint8_t *dst = reinterpret_cast<uint8_t *>(u.leds.data());
+        const size_t want = u.leds.size() * 3;
+        size_t have = count > u.firstChannel ? count - u.firstChannel : 0;
+        if (have < want) {
+            ++u.stats.truncated;
+        } else {
+            have = want;
+        }
+        if (have) {
+            memcpy(dst, channels + u.firstChannel, have);
+        }
+        ++u.stats.packets;
+
+        if (!u.received) {
+            u.received = true;
+            if (mPending > 0 && --mPending == 0) {
+                completed = true;
+            }
+        }
+    }
+    if (completed && !mSyncMode) {
+        markFrameReady();
+    }
+    return mapped ? kData : kIgnored;
+}
+
+void NetFrameSource::markFrameReady() {
+    for (size_t i = 0; i < mUniverses.size(); ++i) {
+        mUniverses[i].received = false;
+    }
+    mPending = uint16_t(mUniverses.size());
+    mFrameReady = true;
+    ++mFrames;
+    mOnFrame();
+}
+
+}  // namespace fl
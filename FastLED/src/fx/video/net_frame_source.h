@@ -0,0 +1,129 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "crgb.h"
+#include "fl/callback.h"
+#include "fl/namespace.h"
+#include "fl/ptr.h"
+#include "fl/slice.h"
+#include "fl/vector.h"
+
+// Most universes one NetFrameSource can map. Each costs about 24 bytes.
+#ifndef FASTLED_NET_FRAME_MAX_UNIVERSES
+#define FASTLED_NET_FRAME_MAX_UNIVERSES 16
+#endif
+
+namespace fl {
+
+FASTLED_SMART_PTR(NetFrameSource);
+
+// Counters for one mapped universe. A climbing lost count means the network
+// (usually WiFi) is dropping packets, a climbing late count means they arrive
+// out of order and were discarded.
+struct NetUniverseStats {
+    uint32_t packets = 0;    // data packets written into the leds
+    uint32_t lost = 0;       // packets skipped over, from the sequence numbers
+    uint32_t late = 0;       // packets older than the last one, discarded
+    uint32_t truncated = 0;  // packets shorter than the mapped slice
+};
+
+// Receives E1.31 (sACN) and Art-Net DMX packets and writes the channel data
+// straight into the CRGB buffers the controllers send from, so no frame buffer
+// sits between the network and the wire. This class does not own a socket:
+// hand it every UDP payload from port 5568 (E1.31) or 6454 (Art-Net).
+//
+//     fl::NetFrameSource net;
+//     net.mapUniverses(1, fl::Slice<CRGB>(leds, NUM_LEDS));
+//     ...
+//     int n = udp.parsePacket();
+//     if (n > 0) net.handlePacket(buf, udp.read(buf, sizeof(buf)));
+//     if (net.takeFrame()) FastLED.show();
+//
+// Once the sender emits sync packets (E1.31 universe sync, ArtSync) a frame
+// is ready on each sync, otherwise when every mapped universe has arrived.
+// Pixels are taken as RGB channel triplets, the controller applies its own
+// color order.
+class NetFrameSource : public fl::Referent {
+  public:
+    enum PacketType {
+        kInvalid,  // not E1.31 or Art-Net, or malformed
+        kIgnored,  // valid, but an unmapped universe, preview data or a late packet
+        kData,     // DMX data written into a mapped slice
+        kSync,     // a sync packet, the frame is ready
+    };
+
+    static const uint16_t kE131Port = 5568;
+    static const uint16_t kArtNetPort = 6454;
+    static const uint16_t kChannelsPerUniverse = 512;
+    static const uint16_t kPixelsPerUniverse = 170;  // 510 of 512 channels
+
+    NetFrameSource();
+
+    // Maps universe to leds. firstChannel is the zero based DMX channel of
+    // the first pixel. Returns false when the table is full.
+    bool mapUniverse(uint16_t universe, fl::Slice<CRGB> leds,
+                     uint16_t firstChannel = 0);
+    // Maps a strip longer than one universe onto consecutive universes
+    // starting at firstUniverse, pixelsPerUniverse pixels each. Returns the
+    // number of universes mapped.
+    size_t mapUniverses(uint16_t firstUniverse, fl::Slice<CRGB> leds,
+                        uint16_t pixelsPerUniverse = kPixelsPerUniverse);
+    void clearMappings();
+    size_t universeCount() const { return mUniverses.size(); }
+
+    // Only accept E1.31 sync packets for this synchronization address. Zero,
+    // the default, accepts any.
+    void setSyncUniverse(uint16_t universe) { mSyncUniverse = universe; }
+
+    // Parses one UDP payload.
+    PacketType handlePacket(const uint8_t *data, size_t len);
+    PacketType handlePacket(fl::Slice<const uint8_t> packet) {
+        return handlePacket(packet.data(), packet.size());
+    }
+
+    // True when a complete frame has landed in the leds. takeFrame() also
+    // clears it, call FastLED.show() when it returns true.
+    bool frameReady() const { return mFrameReady; }
+    bool takeFrame();
+    // Called from handlePacket() as soon as a frame is ready, for sketches
+    // that would rather show() from there.
+    void onFrame(fl::Callback<> callback) { mOnFrame = callback; }
+    // True once the sender has been seen using sync packets.
+    bool syncMode() const { return mSyncMode; }
+
+    // Counters for a mapped universe, nullptr when it is not mapped.
+    const NetUniverseStats *stats(uint16_t universe) const;
+    uint32_t framesReady() const { return mFrames; }
+    uint32_t invalidPackets() const { return mInvalid; }
+    void resetStats();
+
+  private:
+    struct Universe {
+        uint16_t universe = 0;
+        uint16_t firstChannel = 0;
+        fl::Slice<CRGB> leds;
+        int16_t lastSequence = -1;  // -1 until the first packet
+        bool received = false;      // since the last frame
+        NetUniverseStats stats;
+    };
+
+    PacketType handleE131(const uint8_t *data, size_t len);
+    PacketType handleArtNet(const uint8_t *data, size_t len);
+    // seqModulo is 256 for E1.31 and 255 for Art-Net, which skips 0.
+    PacketType handleDmx(uint16_t universe, int16_t sequence, uint16_t seqModulo,
+                         const uint8_t *channels, size_t count);
+    void markFrameReady();
+
+    fl::FixedVector<Universe, FASTLED_NET_FRAME_MAX_UNIVERSES> mUniverses;
+    fl::Callback<> mOnFrame;
+    uint16_t mSyncUniverse = 0;
+    uint16_t mPending = 0;  // mapped universes not yet received this frame
+    bool mSyncMode = false;
+    bool mFrameReady = false;
+    uint32_t mFrames = 0;
+    uint32_t mInvalid = 0;
+};
+
+}  // namespace fl
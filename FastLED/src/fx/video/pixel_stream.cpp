@@ -141,6 +141,13 @@ int32_t PixelStream::framesDisplayed() const {
     }
 }
 
+int32_t PixelStream::framesTotal() const {
+    if (mUsingByteStream || mbytesPerFrame == 0) {
+        return -1;
+    }
+    return mFileHandle->size() / mbytesPerFrame;
+}
+
 int32_t PixelStream::bytesRemaining() const {
     if (mUsingByteStream) {
         return INT32_MAX;
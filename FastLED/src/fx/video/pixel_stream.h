@@ -41,6 +41,7 @@ class PixelStream: public fl::Referent {
   bool hasFrame(uint32_t frameNumber);
   int32_t framesRemaining() const;
   int32_t framesDisplayed() const;
+  int32_t framesTotal() const;  // -1 for streams, which have no known length.
   bool available() const;
   bool atEnd() const;
 
@@ -53,6 +53,9 @@ void VideoImpl::begin(FileHandlePtr h) {
     // Removed setStartTime call
     mStream = PixelStreamPtr::New(mPixelsPerFrame * kSizeRGB8);
     mStream->begin(h);
+    if (mPrefetchFrames) {
+        mPrefetcher = FramePrefetcherPtr::New(mStream, mPixelsPerFrame, mPrefetchFrames);
+    }
     mPrevNow = 0;
 }
 
@@ -67,6 +70,7 @@ void VideoImpl::beginStream(ByteStreamPtr bs) {
 void VideoImpl::end() {
     mFrameInterpolator->clear();
     // Removed resetFrameCounter and setStartTime calls
+    mPrefetcher.reset();  // Stops the prefetch task before the stream goes away.
     mStream.reset();
 }
 
@@ -215,8 +219,9 @@ bool VideoImpl::updateBufferFromFile(uint32_t now, bool forward) {
 
     for (size_t i = 0; i < frame_numbers.size(); ++i) {
         FramePtr recycled_frame;
+        uint32_t frame_to_erase = 0;
+        bool erased = false;
         if (mFrameInterpolator->full()) {
-            uint32_t frame_to_erase = 0;
             bool ok = false;
             if (forward) {
                 ok = mFrameInterpolator->get_oldest_frame_number(&frame_to_erase);
@@ -236,6 +241,7 @@ bool VideoImpl::updateBufferFromFile(uint32_t now, bool forward) {
                 DBG("erase failed for frame: " << frame_to_erase);
                 return false;
             }
+            erased = true;
         }
         uint32_t frame_to_fetch = frame_numbers[i];
         if (!recycled_frame) {
@@ -244,19 +250,29 @@ bool VideoImpl::updateBufferFromFile(uint32_t now, bool forward) {
         }
 
        do {  // only to use break
-            if (!mStream->readFrameAt(frame_to_fetch, recycled_frame.get())) {
+            if (!readFrameAt(frame_to_fetch, recycled_frame.get())) {
+                if (mPrefetcher && mPrefetcher->usingTask() && !streamAtEnd(frame_to_fetch)) {
+                    // Underrun, the prefetch task is still catching up. Keep
+                    // the frames we have and try again on the next draw. A
+                    // missed read leaves the recycled frame untouched.
+                    if (erased) {
+                        mFrameInterpolator->insert(frame_to_erase, recycled_frame);
+                    }
+                    return true;
+                }
                 if (!forward) {
                     // nothing more we can do, we can't go negative.
                     return false;
                 }
-                if (mStream->atEnd()) {
-                    if (!mStream->rewind()) {  // Is this still 
+                if (streamAtEnd(frame_to_fetch)) {
+                    // The prefetcher loops on its own.
+                    if (!mPrefetcher && !mStream->rewind()) {  // Is this still 
                         DBG("rewind failed");
                         return false;
                     }
                     mTimeScale->reset(now);
                     frame_to_fetch = 0;
-                    if (!mStream->readFrameAt(frame_to_fetch, recycled_frame.get())) {
+                    if (!readFrameAt(frame_to_fetch, recycled_frame.get())) {
                         DBG("readFrameAt failed");
                         return false;
                     }
@@ -277,6 +293,21 @@ bool VideoImpl::updateBufferFromFile(uint32_t now, bool forward) {
     return true;
 }
 
+bool VideoImpl::readFrameAt(uint32_t frameNumber, Frame *frame) {
+    if (mPrefetcher) {
+        return mPrefetcher->read(frameNumber, frame);
+    }
+    return mStream->readFrameAt(frameNumber, frame);
+}
+
+bool VideoImpl::streamAtEnd(uint32_t frameNumber) const {
+    if (mPrefetcher) {
+        // The stream is owned by the prefetcher, which may be on another task.
+        return mPrefetcher->pastEnd(frameNumber);
+    }
+    return mStream->atEnd();
+}
+
 bool VideoImpl::updateBufferIfNecessary(uint32_t prev, uint32_t now) {
     const bool forward = now >= prev;
 
@@ -293,7 +324,12 @@ bool VideoImpl::updateBufferIfNecessary(uint32_t prev, uint32_t now) {
 }
 
 bool VideoImpl::rewind() {
-    if (!mStream || !mStream->rewind()) {
+    if (!mStream) {
+        return false;
+    }
+    if (mPrefetcher) {
+        mPrefetcher->seek(0);
+    } else if (!mStream->rewind()) {
         return false;
     }
     mFrameInterpolator->clear();
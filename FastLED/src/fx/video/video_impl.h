@@ -4,6 +4,7 @@
 #include "fl/bytestream.h"
 #include "fx/video/pixel_stream.h"
 #include "fx/video/frame_interpolator.h"
+#include "fx/video/frame_prefetcher.h"
 #include "fl/file_system.h"
 
 #include "fl/namespace.h"
@@ -18,6 +19,7 @@ namespace fl {
 FASTLED_SMART_PTR(VideoImpl);
 FASTLED_SMART_PTR(FrameInterpolator);
 FASTLED_SMART_PTR(PixelStream)
+FASTLED_SMART_PTR(FramePrefetcher);
 
 class VideoImpl : public fl::Referent {
   public:
@@ -45,13 +47,22 @@ class VideoImpl : public fl::Referent {
     void pause(uint32_t now);
     void resume(uint32_t now);
     bool needsFrame(uint32_t now) const;
+    // Read nFrames ahead of playback for file backed videos, 0 turns it off.
+    // Takes effect on the next begin().
+    void setPrefetch(size_t nFrames) { mPrefetchFrames = nFrames; }
+    // Null unless a file is playing with prefetch enabled.
+    FramePrefetcherPtr prefetcher() const { return mPrefetcher; }
 
   private:
     bool updateBufferIfNecessary(uint32_t prev, uint32_t now);
     bool updateBufferFromFile(uint32_t now, bool forward);
     bool updateBufferFromStream(uint32_t now);
+    bool readFrameAt(uint32_t frameNumber, Frame *frame);
+    bool streamAtEnd(uint32_t frameNumber) const;
     uint32_t mPixelsPerFrame = 0;
     PixelStreamPtr mStream;
+    FramePrefetcherPtr mPrefetcher;
+    size_t mPrefetchFrames = 0;
     uint32_t mPrevNow = 0;
     FrameInterpolatorPtr mFrameInterpolator;
     TimeScalePtr mTimeScale;
@@ -0,0 +1,220 @@
+#pragma once
+
+/// @file bulk8.h
+/// Array versions of the scale8 / nscale8_video / blend8 functions.
+///
+/// The kernels treat a run of channel bytes (e.g. a CRGB array) as 32 bit
+/// words and split each word into two pairs of 16 bit lanes, so one multiply
+/// scales two channels at once and an unrolled loop step covers 16 channels.
+/// A lane never exceeds 255 * 256, so no carry can leak into its neighbour and
+/// the results are bit identical to the per byte functions, including the
+/// FASTLED_SCALE8_FIXED variants. On AVR the assembly per byte versions are
+/// faster than 32 bit multiplies, so the bulk path is disabled there.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "lib8tion.h"
+#include "platforms/bulk8.h"
+#include "fl/namespace.h"
+
+#ifndef FASTLED_HAS_BULK8
+#if (SCALE8_C == 1) && (BLEND8_C == 1) && !defined(__AVR__)
+#define FASTLED_HAS_BULK8 1
+#else
+#define FASTLED_HAS_BULK8 0
+#endif
+#endif  // FASTLED_HAS_BULK8
+
+FASTLED_NAMESPACE_BEGIN
+
+/// @addtogroup lib8tion
+/// @{
+
+/// @defgroup Bulk8 Bulk Array Functions
+/// Scale, fade and blend whole arrays of channel bytes at once.
+/// @{
+
+#if !defined(FASTLED_BULK8_HAS_LANES)
+/// Bytes 0 and 2 of a word, zero extended into two 16 bit lanes.
+LIB8STATIC_ALWAYS_INLINE uint32_t bulk8_even_lanes(uint32_t word) {
+    return word & 0x00FF00FF;
+}
+/// Bytes 1 and 3 of a word, zero extended into two 16 bit lanes.
+LIB8STATIC_ALWAYS_INLINE uint32_t bulk8_odd_lanes(uint32_t word) {
+    return (word >> 8) & 0x00FF00FF;
+}
+#endif
+
+/// Recombine the high bytes of the even and odd 16 bit lanes.
+LIB8STATIC_ALWAYS_INLINE uint32_t bulk8_pack_lanes(uint32_t even, uint32_t odd) {
+    return ((even >> 8) & 0x00FF00FF) | (odd & 0xFF00FF00);
+}
+
+/// 0x01 in every byte of the word that is not zero.
+LIB8STATIC_ALWAYS_INLINE uint32_t bulk8_nonzero_bytes(uint32_t word) {
+    return ((((word & 0x7F7F7F7F) + 0x7F7F7F7F) | word) >> 7) & 0x01010101;
+}
+
+LIB8STATIC_ALWAYS_INLINE uint32_t bulk8_load(const uint8_t *p) {
+    uint32_t word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+LIB8STATIC_ALWAYS_INLINE void bulk8_store(uint8_t *p, uint32_t word) {
+    memcpy(p, &word, sizeof(word));
+}
+
+/// Four scale8() in one go. @p factor is the already adjusted multiplier
+/// (scale, or scale + 1 with FASTLED_SCALE8_FIXED), at most 256.
+LIB8STATIC_ALWAYS_INLINE uint32_t bulk8_scale_word(uint32_t word, uint32_t factor) {
+    return bulk8_pack_lanes(bulk8_even_lanes(word) * factor,
+                            bulk8_odd_lanes(word) * factor);
+}
+
+/// Four blend8() in one go. The weights are the already adjusted multipliers,
+/// their sum is at most 257 so a lane stays below 65536.
+LIB8STATIC_ALWAYS_INLINE uint32_t bulk8_blend_word(uint32_t a, uint32_t b,
+                                                   uint32_t weight_a,
+                                                   uint32_t weight_b) {
+    uint32_t even = bulk8_even_lanes(a) * weight_a + bulk8_even_lanes(b) * weight_b;
+    uint32_t odd = bulk8_odd_lanes(a) * weight_a + bulk8_odd_lanes(b) * weight_b;
+    return bulk8_pack_lanes(even, odd);
+}
+
+/// Scale every byte of an array with scale8().
+/// @param data channel bytes, e.g. `(uint8_t*)leds`
+/// @param count number of bytes (3 per CRGB)
+/// @param scale scale factor, in n/256 units
+LIB8STATIC void nscale8_bulk(uint8_t *data, uint32_t count, fract8 scale) {
+#if (FASTLED_SCALE8_FIXED == 1)
+    const uint32_t factor = (uint32_t)scale + 1;
+#else
+    const uint32_t factor = scale;
+#endif
+    uint32_t i = 0;
+#if FASTLED_HAS_BULK8
+    for (; i + 16 <= count; i += 16) {
+        bulk8_store(data + i + 0, bulk8_scale_word(bulk8_load(data + i + 0), factor));
+        bulk8_store(data + i + 4, bulk8_scale_word(bulk8_load(data + i + 4), factor));
+        bulk8_store(data + i + 8, bulk8_scale_word(bulk8_load(data + i + 8), factor));
+        bulk8_store(data + i + 12, bulk8_scale_word(bulk8_load(data + i + 12), factor));
+    }
+    for (; i + 4 <= count; i += 4) {
+        bulk8_store(data + i, bulk8_scale_word(bulk8_load(data + i), factor));
+    }
+#endif
+    for (; i < count; ++i) {
+        data[i] = scale8(data[i], scale);
+    }
+}
+
+/// Scale every byte of an array with scale8_video(): non zero values never
+/// scale down to zero unless @p scale is zero.
+/// @param data channel bytes, e.g. `(uint8_t*)leds`
+/// @param count number of bytes (3 per CRGB)
+/// @param scale scale factor, in n/256 units
+LIB8STATIC void nscale8_video_bulk(uint8_t *data, uint32_t count, fract8 scale) {
+    uint32_t i = 0;
+#if FASTLED_HAS_BULK8
+    // Each nonzero byte gets +1 on top of the plain scale, like scale8_video().
+    // The scaled value is at most 254, so the add can't carry.
+    const uint32_t bump = scale ? 0xFFFFFFFF : 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32_t word = bulk8_load(data + i);
+        uint32_t scaled = bulk8_scale_word(word, scale);
+        bulk8_store(data + i, scaled + (bulk8_nonzero_bytes(word) & bump));
+    }
+#endif
+    for (; i < count; ++i) {
+        data[i] = scale8_video(data[i], scale);
+    }
+}
+
+/// Blend two arrays of bytes with blend8() into a third one.
+/// @p out may alias @p a or @p b.
+/// @param a first source
+/// @param b second source
+/// @param out destination
+/// @param count number of bytes (3 per CRGB)
+/// @param amountOfB how much of @p b to keep, the rest comes from @p a
+LIB8STATIC void blend8_bulk(const uint8_t *a, const uint8_t *b, uint8_t *out,
+                            uint32_t count, fract8 amountOfB) {
+    uint32_t i = 0;
+#if FASTLED_HAS_BULK8
+#if (FASTLED_SCALE8_FIXED == 1)
+    // a * 256 + b + (b - a) * amount == a * (256 - amount) + b * (amount + 1)
+    const uint32_t weight_a = 256 - (uint32_t)amountOfB;
+    const uint32_t weight_b = (uint32_t)amountOfB + 1;
+#else
+    const uint32_t weight_a = 255 - (uint32_t)amountOfB;
+    const uint32_t weight_b = amountOfB;
+#endif
+    for (; i + 16 <= count; i += 16) {
+        for (uint32_t j = 0; j < 16; j += 4) {
+            uint32_t word = bulk8_blend_word(bulk8_load(a + i + j), bulk8_load(b + i + j),
+                                             weight_a, weight_b);
+            bulk8_store(out + i + j, word);
+        }
+    }
+    for (; i + 4 <= count; i += 4) {
+        bulk8_store(out + i, bulk8_blend_word(bulk8_load(a + i), bulk8_load(b + i),
+                                              weight_a, weight_b));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = blend8(a[i], b[i], amountOfB);
+    }
+}
+
+/// Sum the three channels of an array of 3 byte pixels (CRGB) separately.
+/// Four pixels are three words, each byte lands in a 16 bit lane of one of
+/// six accumulators, which are folded into @p sums before a lane can carry.
+/// @param data pixels, 3 bytes each
+/// @param pixels number of pixels
+/// @param sums receives the sums of bytes 0, 1 and 2 of every pixel
+LIB8STATIC void channel_sums8_bulk(const uint8_t *data, uint32_t pixels,
+                                   uint32_t sums[3]) {
+    uint32_t s0 = 0, s1 = 0, s2 = 0;
+#if FASTLED_HAS_BULK8 && defined(__BYTE_ORDER__) && \
+    (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    while (pixels >= 4) {
+        // 256 groups keep every lane at or below 256 * 255.
+        uint32_t groups = pixels / 4;
+        if (groups > 256) {
+            groups = 256;
+        }
+        pixels -= groups * 4;
+        uint32_t e0 = 0, o0 = 0, e1 = 0, o1 = 0, e2 = 0, o2 = 0;
+        for (; groups; --groups, data += 12) {
+            const uint32_t w0 = bulk8_load(data);
+            const uint32_t w1 = bulk8_load(data + 4);
+            const uint32_t w2 = bulk8_load(data + 8);
+            e0 += bulk8_even_lanes(w0);
+            o0 += bulk8_odd_lanes(w0);
+            e1 += bulk8_even_lanes(w1);
+            o1 += bulk8_odd_lanes(w1);
+            e2 += bulk8_even_lanes(w2);
+            o2 += bulk8_odd_lanes(w2);
+        }
+        // Bytes 0..11 of the group are channels 0 1 2 0 | 1 2 0 1 | 2 0 1 2.
+        s0 += (e0 & 0xFFFF) + (o0 >> 16) + (e1 >> 16) + (o2 & 0xFFFF);
+        s1 += (o0 & 0xFFFF) + (e1 & 0xFFFF) + (o1 >> 16) + (e2 >> 16);
+        s2 += (e0 >> 16) + (o1 & 0xFFFF) + (e2 & 0xFFFF) + (o2 >> 16);
+    }
+#endif
+    for (; pixels; --pixels, data += 3) {
+        s0 += data[0];
+        s1 += data[1];
+        s2 += data[2];
+    }
+    sums[0] = s0;
+    sums[1] = s1;
+    sums[2] = s2;
+}
+
+/// @} Bulk8
+/// @} lib8tion
+
+FASTLED_NAMESPACE_END
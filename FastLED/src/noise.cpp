@@ -764,6 +764,116 @@ void fill_raw_2dnoise16into8(uint8_t *pData, int width, int height, uint8_t octa
   fill_raw_2dnoise16into8(pData, width, height, octaves, q44(2,0), 171, 1, x, scalex, y, scaley, time);
 }
 
+// The grid fills walk a z slice of the 3D noise row by row. Z is fixed for the
+// whole grid and Y for the whole row, so the only thing left to hash is the
+// lattice cell along x. Its eight corner hashes are looked up once when the
+// row enters the cell and shared by every pixel in it, which for the usual
+// small scales is most of the PROGMEM reads of inoise8()/inoise16(). The
+// results are identical to calling those per pixel.
+
+void fill_raw_noise_grid8(uint8_t *pData, int width, int height, uint16_t x, int16_t scalex, uint16_t y, int16_t scaley, uint16_t z) {
+    const uint8_t N = 0x80;
+    const uint8_t Z = z>>8;
+    const uint8_t w = EASE8((uint8_t)z);
+    const int8_t zz = ((uint8_t)(z)>>1) & 0x7F;
+
+    uint16_t yj = y;
+    for(int j = 0; j < height; ++j, yj += scaley) {
+        const uint8_t Y = yj>>8;
+        const uint8_t v = EASE8((uint8_t)yj);
+        const int8_t yy = ((uint8_t)(yj)>>1) & 0x7F;
+        uint8_t *row = pData + j * width;
+
+        // Corner hashes of the current cell, in inoise8_raw() order.
+        uint8_t hAA = 0, hBA = 0, hAB = 0, hBB = 0;
+        uint8_t hAA1 = 0, hBA1 = 0, hAB1 = 0, hBB1 = 0;
+        int cell = -1;
+
+        uint16_t xi = x;
+        for(int i = 0; i < width; ++i, xi += scalex) {
+            const uint8_t X = xi>>8;
+            if(X != cell) {
+                cell = X;
+                uint8_t A = P(X)+Y;
+                uint8_t AA = P(A)+Z;
+                uint8_t AB = P(A+1)+Z;
+                uint8_t B = P(X+1)+Y;
+                uint8_t BA = P(B)+Z;
+                uint8_t BB = P(B+1)+Z;
+                hAA = P(AA); hBA = P(BA); hAB = P(AB); hBB = P(BB);
+                hAA1 = P(AA+1); hBA1 = P(BA+1); hAB1 = P(AB+1); hBB1 = P(BB+1);
+            }
+            const uint8_t u = EASE8((uint8_t)xi);
+            const int8_t xx = ((uint8_t)(xi)>>1) & 0x7F;
+
+            int8_t X1 = lerp7by8(grad8(hAA, xx, yy, zz), grad8(hBA, xx - N, yy, zz), u);
+            int8_t X2 = lerp7by8(grad8(hAB, xx, yy-N, zz), grad8(hBB, xx - N, yy - N, zz), u);
+            int8_t X3 = lerp7by8(grad8(hAA1, xx, yy, zz-N), grad8(hBA1, xx - N, yy, zz-N), u);
+            int8_t X4 = lerp7by8(grad8(hAB1, xx, yy-N, zz-N), grad8(hBB1, xx - N, yy - N, zz - N), u);
+
+            int8_t Y1 = lerp7by8(X1,X2,v);
+            int8_t Y2 = lerp7by8(X3,X4,v);
+
+            int8_t n = lerp7by8(Y1,Y2,w);  // -64..+64, same scaling as inoise8()
+            n += 64;
+            row[i] = qadd8(n, n);
+        }
+    }
+}
+
+void fill_raw_noise_grid16(uint16_t *pData, int width, int height, uint32_t x, int32_t scalex, uint32_t y, int32_t scaley, uint32_t z) {
+    const uint16_t N = 0x8000L;
+    const uint8_t Z = (z>>16)&0xFF;
+    const uint16_t w = EASE16((uint16_t)(z & 0xFFFF));
+    const int16_t zz = ((z & 0xFFFF) >> 1) & 0x7FFF;
+
+    uint32_t yj = y;
+    for(int j = 0; j < height; ++j, yj += scaley) {
+        const uint8_t Y = (yj>>16)&0xFF;
+        const uint16_t v = EASE16((uint16_t)(yj & 0xFFFF));
+        const int16_t yy = ((yj & 0xFFFF) >> 1) & 0x7FFF;
+        uint16_t *row = pData + j * width;
+
+        // Corner hashes of the current cell, in inoise16_raw() order.
+        uint8_t hAA = 0, hBA = 0, hAB = 0, hBB = 0;
+        uint8_t hAA1 = 0, hBA1 = 0, hAB1 = 0, hBB1 = 0;
+        int cell = -1;
+
+        uint32_t xi = x;
+        for(int i = 0; i < width; ++i, xi += scalex) {
+            const uint8_t X = (xi>>16)&0xFF;
+            if(X != cell) {
+                cell = X;
+                uint8_t A = P(X)+Y;
+                uint8_t AA = P(A)+Z;
+                uint8_t AB = P(A+1)+Z;
+                uint8_t B = P(X+1)+Y;
+                uint8_t BA = P(B)+Z;
+                uint8_t BB = P(B+1)+Z;
+                hAA = P(AA); hBA = P(BA); hAB = P(AB); hBB = P(BB);
+                hAA1 = P(AA+1); hBA1 = P(BA+1); hAB1 = P(AB+1); hBB1 = P(BB+1);
+            }
+            const uint16_t u = EASE16((uint16_t)(xi & 0xFFFF));
+            const int16_t xx = ((xi & 0xFFFF) >> 1) & 0x7FFF;
+
+            int16_t X1 = LERP(grad16(hAA, xx, yy, zz), grad16(hBA, xx - N, yy, zz), u);
+            int16_t X2 = LERP(grad16(hAB, xx, yy-N, zz), grad16(hBB, xx - N, yy - N, zz), u);
+            int16_t X3 = LERP(grad16(hAA1, xx, yy, zz-N), grad16(hBA1, xx - N, yy, zz-N), u);
+            int16_t X4 = LERP(grad16(hAB1, xx, yy-N, zz-N), grad16(hBB1, xx - N, yy - N, zz - N), u);
+
+            int16_t Y1 = LERP(X1,X2,v);
+            int16_t Y2 = LERP(X3,X4,v);
+
+            // Same scaling as inoise16(x, y, z).
+            int32_t ans = LERP(Y1,Y2,w);
+            ans = ans + 19052L;
+            uint32_t pan = ans;
+            pan *= 440L;
+            row[i] = pan>>8;
+        }
+    }
+}
+
 void fill_noise8(CRGB *leds, int num_leds,
             uint8_t octaves, uint16_t x, int scale,
             uint8_t hue_octaves, uint16_t hue_x, int hue_scale,
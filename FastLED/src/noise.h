@@ -188,6 +188,25 @@ void fill_raw_2dnoise16(uint16_t *pData, int width, int height, uint8_t octaves,
 /// @param skip how many noise maps to skip over, incremented recursively per octave
 void fill_raw_2dnoise16into8(uint8_t *pData, int width, int height, uint8_t octaves, q44 freq44, fract8 amplitude, int skip, uint32_t x, int32_t scalex, uint32_t y, int32_t scaley, uint32_t time);
 
+/// Fill a 2D 8-bit buffer with a slice of 3D noise, using inoise8().
+/// The result is the same as calling inoise8(x + i * scalex, y + j * scaley, z)
+/// for every pixel, but the lattice hashes are computed once per noise cell
+/// and shared by all pixels of a row that fall into it, so this is much
+/// cheaper than the per pixel calls for small scales.
+/// @param pData the array of data to fill with noise values, width * height, row by row
+/// @param width the width of the 2D buffer
+/// @param height the height of the 2D buffer
+/// @param x x-axis coordinate of the first pixel
+/// @param scalex the scale (distance) between x points
+/// @param y y-axis coordinate of the first row
+/// @param scaley the scale (distance) between y points
+/// @param z the z coordinate (usually time) of the slice
+void fill_raw_noise_grid8(uint8_t *pData, int width, int height, uint16_t x, int16_t scalex, uint16_t y, int16_t scaley, uint16_t z);
+
+/// Fill a 2D 16-bit buffer with a slice of 3D noise, using inoise16().
+/// @copydetails fill_raw_noise_grid8()
+void fill_raw_noise_grid16(uint16_t *pData, int width, int height, uint32_t x, int32_t scalex, uint32_t y, int32_t scaley, uint32_t z);
+
 /// @} Raw Fill Functions
 
 
@@ -0,0 +1,107 @@
+/// @file output_lut.cpp
+/// Builds the fused per-channel output tables.
+
+#define FASTLED_INTERNAL 1
+#include "output_lut.h"
+
+#if FASTLED_HAS_OUTPUT_LUT
+
+#include <string.h>
+
+#include "FastLED.h"
+#include "five_bit_hd_gamma.h"
+#include "lib8tion/scale8.h"
+#include "lib8tion/math8.h"
+#include "fl/namespace.h"
+
+FASTLED_NAMESPACE_BEGIN
+
+OutputLut::Rgb *OutputLut::sRgb = nullptr;
+OutputLut::HdGamma *OutputLut::sHd = nullptr;
+uint32_t OutputLut::sRgbSerial = OutputLut::kInvalidSerial;
+uint32_t OutputLut::sHdSerial = OutputLut::kInvalidSerial;
+
+namespace {
+
+uint32_t gNextSerial = OutputLut::kInvalidSerial;
+
+uint32_t nextSerial() {
+    if (++gNextSerial == OutputLut::kInvalidSerial) {
+        ++gNextSerial;
+    }
+    return gNextSerial;
+}
+
+// What the current tables were built from.
+uint8_t gRgbKey[9];
+CRGB gHdKey;
+
+// Same math as PixelController::loadAndScale<SLOT>().
+void fillRgbChannel(uint8_t *table, uint8_t scale, uint8_t d) {
+    table[0] = 0;
+    for (int v = 1; v < 256; ++v) {
+        table[v] = scale8(qadd8(v, d), scale);
+    }
+}
+
+} // namespace
+
+uint32_t OutputLut::buildRgb(const CRGB &scale, const uint8_t d[3], const uint8_t e[3]) {
+    uint8_t key[9];
+    for (int i = 0; i < 3; ++i) {
+        key[i] = scale.raw[i];
+        key[3 + i] = d[i];
+        key[6 + i] = e[i] - d[i];
+    }
+    if (sRgbSerial != kInvalidSerial && memcmp(key, gRgbKey, sizeof(key)) == 0) {
+        return sRgbSerial;
+    }
+    if (!sRgb) {
+        sRgb = new Rgb;
+        if (!sRgb) {
+            return kInvalidSerial;
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        fillRgbChannel(sRgb->table[0][i], key[i], key[3 + i]);
+        if (key[6 + i] == key[3 + i]) {
+            memcpy(sRgb->table[1][i], sRgb->table[0][i], 256);
+        } else {
+            fillRgbChannel(sRgb->table[1][i], key[i], key[6 + i]);
+        }
+    }
+    memcpy(gRgbKey, key, sizeof(key));
+    sRgbSerial = nextSerial();
+    return sRgbSerial;
+}
+
+uint32_t OutputLut::buildHdGamma(const CRGB &color_scale) {
+    if (sHdSerial != kInvalidSerial && gHdKey == color_scale) {
+        return sHdSerial;
+    }
+    if (!sHd) {
+        sHd = new HdGamma;
+        if (!sHd) {
+            return kInvalidSerial;
+        }
+    }
+    for (int v = 0; v < 256; ++v) {
+        // Goes through five_bit_hd_gamma_function() so a user supplied
+        // gamma curve ends up in the table too.
+        uint16_t rgb16[3];
+        five_bit_hd_gamma_function(CRGB(v, v, v), &rgb16[0], &rgb16[1], &rgb16[2]);
+        for (int i = 0; i < 3; ++i) {
+            if (color_scale.raw[i] != 0xff) {
+                rgb16[i] = scale16by8(rgb16[i], color_scale.raw[i]);
+            }
+            sHd->table[i][v] = rgb16[i];
+        }
+    }
+    gHdKey = color_scale;
+    sHdSerial = nextSerial();
+    return sHdSerial;
+}
+
+FASTLED_NAMESPACE_END
+
+#endif  // FASTLED_HAS_OUTPUT_LUT
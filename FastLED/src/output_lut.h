@@ -0,0 +1,93 @@
+#pragma once
+
+/// @file output_lut.h
+/// Precomputed per-channel output tables used by PixelController.
+///
+/// Feeding a pixel to the wire normally costs a dither add, a scale8 and a
+/// branch per channel (or a gamma curve plus a color correction scale for the
+/// APA102 HD path). All of those only depend on the channel value and on
+/// settings that are fixed for the whole frame, so for long strips it is
+/// cheaper to fold them into one table per channel and do a single lookup.
+///
+/// The tables are shared by all controllers and are only rebuilt when the
+/// brightness, color correction, color temperature or dither signal changes.
+
+#include <stdint.h>
+
+#include "fl/namespace.h"
+#include "fl/force_inline.h"
+#include "crgb.h"
+
+#ifndef FASTLED_HAS_OUTPUT_LUT
+#ifdef __AVR__
+// Not enough memory on AVR to spend 1.5k on a table.
+#define FASTLED_HAS_OUTPUT_LUT 0
+#else
+#define FASTLED_HAS_OUTPUT_LUT 1
+#endif
+#endif
+
+/// Strips shorter than this keep the per pixel math. Building the table
+/// costs about as much as pushing this many pixels through the math, and
+/// with dithering enabled the dither signal changes every frame.
+#ifndef FASTLED_OUTPUT_LUT_MIN_LEDS
+#define FASTLED_OUTPUT_LUT_MIN_LEDS 256
+#endif
+
+#if FASTLED_HAS_OUTPUT_LUT
+
+FASTLED_NAMESPACE_BEGIN
+
+/// Fused output tables. Channels are indexed in memory order (r, g, b), not
+/// in output order, so one table serves every EOrder.
+class OutputLut {
+  public:
+    /// Tables for the 8 bit path: dither, then scale by the premixed
+    /// brightness and color correction. One table per dither phase, the
+    /// phase flips on every PixelController::stepDithering().
+    struct Rgb {
+        uint8_t table[2][3][256];
+    };
+
+    /// Tables for the APA102 HD path: gamma corrected 16 bit values scaled by
+    /// the color correction, exactly as __builtin_five_bit_hd_gamma_bitshift()
+    /// computes them before the brightness bitshift.
+    struct HdGamma {
+        uint16_t table[3][256];
+    };
+
+    /// Handle returned when no table could be built.
+    static const uint32_t kInvalidSerial = 0;
+
+    /// Rebuild the 8 bit tables if the inputs changed.
+    /// @param scale premixed brightness and color correction
+    /// @param d current dither values, used for phase 0
+    /// @param e dither range, phase 1 uses e - d like stepDithering()
+    /// @returns a handle for rgb(), or kInvalidSerial if out of memory
+    static uint32_t buildRgb(const CRGB &scale, const uint8_t d[3], const uint8_t e[3]);
+
+    /// Rebuild the HD gamma tables if the color correction changed.
+    /// @returns a handle for hdGamma(), or kInvalidSerial if out of memory
+    static uint32_t buildHdGamma(const CRGB &color_scale);
+
+    /// @returns the tables for a handle, or nullptr once another set of
+    /// inputs has replaced them.
+    FASTLED_FORCE_INLINE static const Rgb *rgb(uint32_t serial) {
+        return (serial == sRgbSerial) ? sRgb : nullptr;
+    }
+
+    /// @copydoc rgb()
+    FASTLED_FORCE_INLINE static const HdGamma *hdGamma(uint32_t serial) {
+        return (serial == sHdSerial) ? sHd : nullptr;
+    }
+
+  private:
+    static Rgb *sRgb;
+    static HdGamma *sHd;
+    static uint32_t sRgbSerial;
+    static uint32_t sHdSerial;
+};
+
+FASTLED_NAMESPACE_END
+
+#endif  // FASTLED_HAS_OUTPUT_LUT
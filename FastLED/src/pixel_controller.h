@@ -14,6 +14,7 @@
 #include "FastLED.h"
 #include "rgbw.h"
 #include "five_bit_hd_gamma.h"
+#include "output_lut.h"
 #include "fl/force_inline.h"
 #include "fl/namespace.h"
 #include "eorder.h"
@@ -77,6 +78,12 @@ struct PixelController {
     int8_t mAdvance;         ///< how many bytes to advance the pointer by each time. For CRGB this is 3.
     int mOffsets[LANES];     ///< the number of bytes to offset each lane from the starting pointer @see initOffsets()
     ColorAdjustment mColorAdjustment;
+#if FASTLED_HAS_OUTPUT_LUT
+    uint32_t mRgbLutSerial;  ///< handle of the fused 8 bit output tables @see OutputLut
+    uint32_t mHdLutSerial;   ///< handle of the fused HD gamma tables @see OutputLut
+    uint8_t mLutPhase;       ///< dither phase of the 8 bit tables, flipped by stepDithering()
+    bool mLutAttached;       ///< true once mRgbLutSerial has been requested for this frame
+#endif
 
     enum {
         kLanes = LANES,
@@ -120,6 +127,22 @@ struct PixelController {
         mAdvance = other.mAdvance;
         mLenRemaining = mLen = other.mLen;
         for(int i = 0; i < LANES; ++i) { mOffsets[i] = other.mOffsets[i]; }
+#if FASTLED_HAS_OUTPUT_LUT
+        mRgbLutSerial = other.mRgbLutSerial;
+        mHdLutSerial = other.mHdLutSerial;
+        mLutPhase = other.mLutPhase;
+        mLutAttached = other.mLutAttached;
+#endif
+    }
+
+    /// Forget any fused output tables, so they get looked up again on first use.
+    void resetOutputLut() {
+#if FASTLED_HAS_OUTPUT_LUT
+        mRgbLutSerial = OutputLut::kInvalidSerial;
+        mHdLutSerial = OutputLut::kInvalidSerial;
+        mLutPhase = 0;
+        mLutAttached = (mLen < FASTLED_OUTPUT_LUT_MIN_LEDS);  // Short strips never use them.
+#endif
     }
 
     /// Initialize the PixelController::mOffsets array based on the length of the strip
@@ -147,6 +170,7 @@ struct PixelController {
         mData += skip;
         mAdvance = (advance) ? 3+skip : 0;
         initOffsets(len);
+        resetOutputLut();
     }
 
     /// Constructor
@@ -161,6 +185,7 @@ struct PixelController {
         enable_dithering(dither);
         mAdvance = 3;
         initOffsets(len);
+        resetOutputLut();
     }
 
     /// Constructor
@@ -174,6 +199,7 @@ struct PixelController {
         enable_dithering(dither);
         mAdvance = 0;
         initOffsets(len);
+        resetOutputLut();
     }
 
     #if FASTLED_HD_COLOR_MIXING
@@ -318,6 +344,9 @@ struct PixelController {
             d[0] = e[0] - d[0];
             d[1] = e[1] - d[1];
             d[2] = e[2] - d[2];
+#if FASTLED_HAS_OUTPUT_LUT
+            mLutPhase ^= 1;
+#endif
     }
 
     /// Some chipsets pre-cycle the first byte, which means we want to cycle byte 0's dithering separately
@@ -493,6 +522,19 @@ struct PixelController {
             brightness = 255;
             CRGB scale = mColorAdjustment.premixed;
             #endif
+            #if FASTLED_HAS_OUTPUT_LUT && !defined(FASTLED_FIVE_BIT_HD_BITSHIFT_FUNCTION_OVERRIDE)
+            const OutputLut::HdGamma *lut = hdGammaLut(scale);
+            if (lut) {
+                // Same result as five_bit_hd_gamma_bitshift(), with the gamma
+                // curve and color correction taken from the table.
+                if (brightness == 0) {
+                    rgb = CRGB(0, 0, 0);
+                } else {
+                    five_bit_bitshift(lut->table[0][rgb.r], lut->table[1][rgb.g],
+                                      lut->table[2][rgb.b], brightness, &rgb, &brightness);
+                }
+            } else
+            #endif
             five_bit_hd_gamma_bitshift(
                 rgb,
                 scale,
@@ -511,11 +553,49 @@ struct PixelController {
 
     FASTLED_FORCE_INLINE void loadAndScaleRGB(uint8_t *b0_out, uint8_t *b1_out,
                                               uint8_t *b2_out) {
+#if FASTLED_HAS_OUTPUT_LUT
+        const OutputLut::Rgb *lut = rgbLut();
+        if (lut) {
+            // One lookup per channel does the dither and the scale.
+            *b0_out = lut->table[mLutPhase][RO(0)][mData[RO(0)]];
+            *b1_out = lut->table[mLutPhase][RO(1)][mData[RO(1)]];
+            *b2_out = lut->table[mLutPhase][RO(2)][mData[RO(2)]];
+            return;
+        }
+#endif
         *b0_out = loadAndScale0();
         *b1_out = loadAndScale1();
         *b2_out = loadAndScale2();
     }
 
+#if FASTLED_HAS_OUTPUT_LUT
+    /// Get the fused 8 bit output tables for this frame, building them on
+    /// first use from the current scale and dither values.
+    /// @returns nullptr if the strip is too short or no table is available.
+    FASTLED_FORCE_INLINE const OutputLut::Rgb *rgbLut() {
+        if (!mLutAttached) {
+            mLutAttached = true;
+            mLutPhase = 0;
+            mRgbLutSerial = OutputLut::buildRgb(mColorAdjustment.premixed, d, e);
+        }
+        // Returns nullptr if another controller has rebuilt the tables
+        // since, in which case the per pixel math is used.
+        return OutputLut::rgb(mRgbLutSerial);
+    }
+
+    /// Get the fused HD gamma tables for the given color correction.
+    /// @returns nullptr if the strip is too short or no table is available.
+    FASTLED_FORCE_INLINE const OutputLut::HdGamma *hdGammaLut(const CRGB &scale) {
+        if (mLen < FASTLED_OUTPUT_LUT_MIN_LEDS) {
+            return nullptr;
+        }
+        if (mHdLutSerial == OutputLut::kInvalidSerial) {
+            mHdLutSerial = OutputLut::buildHdGamma(scale);
+        }
+        return OutputLut::hdGamma(mHdLutSerial);
+    }
+#endif
+
     FASTLED_FORCE_INLINE void loadAndScaleRGBW(Rgbw rgbw, uint8_t *b0_out, uint8_t *b1_out,
                                                uint8_t *b2_out, uint8_t *b3_out) {
 #ifdef __AVR__
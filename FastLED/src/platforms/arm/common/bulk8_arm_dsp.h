@@ -0,0 +1,23 @@
+#pragma once
+
+/// @file bulk8_arm_dsp.h
+/// Byte lane helpers for the bulk lib8tion kernels on cores with the
+/// ARMv7E-M DSP extension (Cortex-M4, M7, M33).
+
+#include <stdint.h>
+
+#define FASTLED_BULK8_HAS_LANES 1
+
+// UXTB16 zero extends bytes 0 and 2 into two 16 bit lanes in one cycle,
+// replacing the mask (and shift) of the generic version.
+__attribute__((always_inline)) static inline uint32_t bulk8_even_lanes(uint32_t word) {
+    uint32_t out;
+    asm("uxtb16 %0, %1" : "=r"(out) : "r"(word));
+    return out;
+}
+
+__attribute__((always_inline)) static inline uint32_t bulk8_odd_lanes(uint32_t word) {
+    uint32_t out;
+    asm("uxtb16 %0, %1, ror #8" : "=r"(out) : "r"(word));
+    return out;
+}
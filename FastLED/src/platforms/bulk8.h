@@ -0,0 +1,9 @@
+#pragma once
+
+/// @file bulk8.h
+/// Picks the platform specific byte lane helpers used by lib8tion/bulk8.h.
+/// Platforms without a specialization fall back to plain mask and shift.
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "platforms/arm/common/bulk8_arm_dsp.h"
+#endif
@@ -139,6 +139,8 @@ FASTLED_NAMESPACE_BEGIN
 static CLEDController *gControllers[FASTLED_I2S_MAX_CONTROLLERS];
 static int gNumControllers = 0;
 static int gNumStarted = 0;
+// -- A frame was started and nobody has waited for it yet
+static bool gAsyncPending = false;
 
 
 
@@ -161,7 +163,15 @@ class ClocklessController : public CPixelLEDController<RGB_ORDER> {
     PixelController<RGB_ORDER> *mPixels;
 
     // -- Make sure we can't call show() too quickly
-    CMinWait<50> mWait;
+    static CMinWait<50> &minWait() {
+        static CMinWait<50> sWait;
+        return sWait;
+    }
+
+    // -- Private copy of the led data used while an async frame is in
+    //    flight, so the caller may redraw its CRGB array right away.
+    uint8_t *mSnapshot = nullptr;
+    int mSnapshotSize = 0;
 
   public:
     void init() {
@@ -193,7 +203,57 @@ class ClocklessController : public CPixelLEDController<RGB_ORDER> {
 
     virtual uint16_t getMaxRefreshRate() const { return 400; }
 
+    virtual bool isShowComplete() override {
+        if (gAsyncPending && i2s_is_done()) {
+            finishAsyncShow();
+        }
+        return !gAsyncPending;
+    }
+
   protected:
+    // -- Wait for an async frame from the previous show() to go out
+    //    before the pixel data is touched again.
+    virtual void *beginShowLeds() override {
+        void *data = CPixelLEDController<RGB_ORDER>::beginShowLeds();
+        if (gAsyncPending) {
+            i2s_wait();
+            finishAsyncShow();
+        }
+        return data;
+    }
+
+    // -- Every other strip (RMT, SPI...) has been started by now, so the
+    //    I2S transfer overlaps with theirs instead of running before them.
+    virtual void waitShowLeds() override {
+        if (gAsyncPending && !CLEDController::getAsyncShow()) {
+            i2s_wait();
+            finishAsyncShow();
+        }
+    }
+
+    static void finishAsyncShow() {
+        i2s_stop();
+        minWait().mark();
+        gAsyncPending = false;
+    }
+
+    // -- Copy the led data the pixel controller points at, the interrupt
+    //    handler reads it long after show() has returned.
+    void snapshotPixels() {
+        const int stride = mPixels->mAdvance ? mPixels->mAdvance : 3;
+        const int count = mPixels->mAdvance ? mPixels->mLen : 1;
+        const int size = stride * count;
+        if (size > mSnapshotSize) {
+            free(mSnapshot);
+            mSnapshot = (uint8_t *)malloc(size);
+            mSnapshotSize = mSnapshot ? size : 0;
+        }
+        if (mSnapshot) {
+            memcpy(mSnapshot, mPixels->mData, size);
+            mPixels->mData = mSnapshot;
+        }
+    }
+
     /** Clear DMA buffer
      *
      *  Yves' clever trick: initialize the bits that we know must be 0
@@ -263,6 +323,9 @@ class ClocklessController : public CPixelLEDController<RGB_ORDER> {
         //    variable in the calling function, and this data structure
         //    needs to outlive this call to showPixels.
         (*mPixels) = pixels;
+        if (CLEDController::getAsyncShow()) {
+            snapshotPixels();
+        }
 
         // -- Keep track of the number of strips we've seen
         ++gNumStarted;
@@ -287,18 +350,16 @@ class ClocklessController : public CPixelLEDController<RGB_ORDER> {
             for (int i = 0; i < NUM_DMA_BUFFERS; i++)
                 fillBuffer();
             // -- Make sure it's been at least 50us since last show
-            mWait.wait();
+            minWait().wait();
             i2s_start();
-            // -- Wait here while the rest of the data is sent. The interrupt
-            // handler
-            //    will keep refilling the DMA buffers until it is all sent; then
-            //    it gives the semaphore back.
-            i2s_wait();
-            i2s_stop();
-            mWait.mark();
-
             // -- Reset the counters
             gNumStarted = 0;
+            // -- Return right away. The interrupt handler keeps refilling
+            //    the DMA buffers until it is all sent; then it gives the
+            //    semaphore back. waitShowLeds() waits for that once the
+            //    other controllers have been started, or in async mode the
+            //    next beginShowLeds() / isShowComplete() picks it up.
+            gAsyncPending = true;
         }
     }
 
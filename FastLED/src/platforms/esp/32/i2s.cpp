@@ -502,6 +502,12 @@ void i2s_wait() {
     xSemaphoreGive(gTX_sem);
 }
 
+bool i2s_is_done() {
+    // -- The interrupt handler gives the semaphore back once the last buffer
+    //    is out; a non-zero count means nothing is in flight.
+    return uxSemaphoreGetCount(gTX_sem) > 0;
+}
+
 void i2s_setup_pin(int _pin, int offset) {
     gpio_num_t pin = (gpio_num_t)_pin;
     PIN_FUNC_SELECT(GPIO_PIN_MUX_REG[pin], PIN_FUNC_GPIO);
@@ -106,6 +106,7 @@ void i2s_reset_fifo();
 void i2s_stop();
 void i2s_begin();
 void i2s_wait();
+bool i2s_is_done();  // non-blocking version of i2s_wait()
 void i2s_setup_pin(int pin, int offset);
 void i2s_transpose_and_encode(int channel, uint32_t has_data_mask, volatile uint32_t *buf);
 
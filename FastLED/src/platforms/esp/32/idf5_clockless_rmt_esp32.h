@@ -48,4 +48,10 @@ protected:
         CPixelLEDController<RGB_ORDER>::endShowLeds(data);
         mRMTController.showPixels();
     }
+
+    // The pixel data was already encoded into the RMT buffer, so the
+    // transmission always runs in the background.
+    virtual bool isShowComplete() override {
+        return mRMTController.isDrawComplete();
+    }
 };
\ No newline at end of file
@@ -64,6 +64,10 @@ void RmtController5::waitForDrawComplete() {
     }
 }
 
+bool RmtController5::isDrawComplete() const {
+    return !mLedStrip || mLedStrip->is_draw_complete();
+}
+
 void RmtController5::loadPixelData(PixelIterator &pixels) {
     const bool is_rgbw = pixels.get_rgbw().active();
     if (!mLedStrip) {
@@ -35,6 +35,7 @@ public:
     void loadPixelData(PixelIterator &pixels);
     void showPixels();
     void waitForDrawComplete();
+    bool isDrawComplete() const;
 
 private:
     int mPin;
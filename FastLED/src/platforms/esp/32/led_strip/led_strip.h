@@ -28,6 +28,7 @@ typedef struct {
     uint32_t strip_len;
     uint8_t bytes_per_pixel;
     uint8_t* pixel_buf;
+    volatile bool refresh_in_progress;  // cleared from the RMT tx-done interrupt
 } led_strip_rmt_obj;
 
 /**
@@ -113,6 +114,17 @@ esp_err_t led_strip_refresh_async(led_strip_handle_t strip);
  */
 esp_err_t led_strip_wait_refresh_done(led_strip_handle_t strip, int32_t timeout_ms);
 
+/**
+ * @brief Check whether an asynchronous refresh operation has completed, without blocking
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - true: No refresh is in progress
+ *      - false: The RMT peripheral is still transmitting
+ */
+bool led_strip_is_refresh_done(led_strip_handle_t strip);
+
 /**
  * @brief Clear LED strip (turn off all LEDs)
  *
@@ -48,6 +48,13 @@ esp_err_t led_strip_wait_refresh_done(led_strip_handle_t strip, int32_t timeout_
     return strip->wait_refresh_done(strip, timeout_ms);
 }
 
+bool led_strip_is_refresh_done(led_strip_handle_t strip) {
+    if (!strip) {
+        return true;
+    }
+    return strip->is_refresh_done(strip);
+}
+
 esp_err_t led_strip_set_pixel_rgbw(led_strip_handle_t strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue, uint32_t white)
 {
     ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
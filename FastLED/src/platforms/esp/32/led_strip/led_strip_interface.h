@@ -93,6 +93,17 @@ struct led_strip_t {
      */
     esp_err_t (*wait_refresh_done)(led_strip_t *strip, int32_t timeout_ms);
 
+    /**
+     * @brief Poll an asynchronous refresh operation
+     *
+     * @param strip: LED strip
+     *
+     * @return
+     *      - true: The last refresh has completed
+     *      - false: The refresh is still in progress
+     */
+    bool (*is_refresh_done)(led_strip_t *strip);
+
     /**
      * @brief Clear LED strip (turn off all LEDs)
      *
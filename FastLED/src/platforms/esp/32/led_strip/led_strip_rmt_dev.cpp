@@ -73,6 +73,7 @@ static esp_err_t led_strip_rmt_refresh_async(led_strip_t *strip)
         .loop_count = 0,
     };
     ESP_RETURN_ON_ERROR(rmt_enable(rmt_strip->rmt_chan), TAG, "enable RMT channel failed");
+    rmt_strip->refresh_in_progress = true;
     ESP_RETURN_ON_ERROR(rmt_transmit(rmt_strip->rmt_chan, rmt_strip->strip_encoder, rmt_strip->pixel_buf,
                                      rmt_strip->strip_len * rmt_strip->bytes_per_pixel, &tx_conf), TAG, "transmit pixels by RMT failed");
     return ESP_OK;
@@ -86,6 +87,22 @@ static esp_err_t led_strip_rmt_wait_refresh_done(led_strip_t *strip, int32_t tim
     return ESP_OK;
 } 
 
+static bool led_strip_rmt_is_refresh_done(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    return !rmt_strip->refresh_in_progress;
+}
+
+// Runs in the RMT interrupt once the whole pixel buffer has been clocked out.
+static IRAM_ATTR bool led_strip_rmt_on_trans_done(rmt_channel_handle_t tx_chan, const rmt_tx_done_event_data_t *edata, void *user_ctx)
+{
+    (void)tx_chan;
+    (void)edata;
+    led_strip_rmt_obj *rmt_strip = static_cast<led_strip_rmt_obj*>(user_ctx);
+    rmt_strip->refresh_in_progress = false;
+    return false;  // No high priority task was woken.
+}
+
 static esp_err_t led_strip_rmt_refresh(led_strip_t *strip)
 {
     ESP_RETURN_ON_ERROR(led_strip_rmt_refresh_async(strip), TAG, "refresh LED strip failed");
@@ -269,6 +286,10 @@ esp_err_t led_strip_new_rmt_device_with_buffer(
         .reset_code = led_config->reset_code,
     };
     ESP_RETURN_ON_ERROR(rmt_new_led_strip_encoder(&strip_encoder_conf, &rmt_strip->strip_encoder), err, TAG, "create LED strip encoder failed");
+    rmt_tx_event_callbacks_t tx_callbacks = {
+        .on_trans_done = led_strip_rmt_on_trans_done,
+    };
+    ESP_RETURN_ON_ERROR(rmt_tx_register_event_callbacks(rmt_strip->rmt_chan, &tx_callbacks, rmt_strip), err, TAG, "register RMT tx callbacks failed");
 
     rmt_strip->bytes_per_pixel = bytes_per_pixel;
     rmt_strip->strip_len = led_config->max_leds;
@@ -279,6 +300,7 @@ esp_err_t led_strip_new_rmt_device_with_buffer(
     rmt_strip->base.del = led_strip_rmt_del2;
     rmt_strip->base.refresh_async = led_strip_rmt_refresh_async;
     rmt_strip->base.wait_refresh_done = led_strip_rmt_wait_refresh_done;
+    rmt_strip->base.is_refresh_done = led_strip_rmt_is_refresh_done;
 
     *ret_strip = &rmt_strip->base;
     cleanup_if_failure.release();
@@ -171,6 +171,10 @@ public:
         release_rmt();
     }
 
+    virtual bool is_draw_complete() override {
+        return led_strip_is_refresh_done(mLedStrip);
+    }
+
     virtual uint32_t num_pixels() const {
         return mMaxLeds;
     }
@@ -304,6 +308,10 @@ public:
         release_rmt();
     }
 
+    virtual bool is_draw_complete() override {
+        return led_strip_is_refresh_done(mLedStrip);
+    }
+
     virtual uint32_t num_pixels() const {
         return mMaxLeds;
     }
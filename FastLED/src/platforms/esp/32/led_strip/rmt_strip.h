@@ -14,6 +14,8 @@ public:
     // Non-blocking draw if and only if the number of strips is less than the number of channels.
     virtual void draw() = 0;
     virtual void wait_for_draw_complete() = 0;
+    // Non-blocking, true when no draw is in flight.
+    virtual bool is_draw_complete() = 0;
     virtual uint32_t num_pixels() const = 0;
 };
 
@@ -6,6 +6,7 @@
 #include "FastLED.h"
 #include "power_mgt.h"
 #include "fl/namespace.h"
+#include "lib8tion/bulk8.h"
 
 FASTLED_NAMESPACE_BEGIN
 
@@ -60,33 +61,26 @@ static uint8_t  gMaxPowerIndicatorLEDPinNumber = 0; // default = Arduino onboard
 
 uint32_t calculate_unscaled_power_mW( const CRGB* ledbuffer, uint16_t numLeds ) //25354
 {
-    uint32_t red32 = 0, green32 = 0, blue32 = 0;
-    const CRGB* firstled = &(ledbuffer[0]);
-    uint8_t* p = (uint8_t*)(firstled);
-
-    uint16_t count = numLeds;
-
-    // This loop might benefit from an AVR assembly version -MEK
-    while( count) {
-        red32   += *p++;
-        green32 += *p++;
-        blue32  += *p++;
-        --count;
-    }
-
-    red32   *= gRed_mW;
-    green32 *= gGreen_mW;
-    blue32  *= gBlue_mW;
+    uint32_t sums[3];
+    channel_sums8_bulk((const uint8_t*)ledbuffer, numLeds, sums);
 
-    red32   >>= 8;
-    green32 >>= 8;
-    blue32  >>= 8;
+    uint32_t red32   = (sums[0] * gRed_mW)   >> 8;
+    uint32_t green32 = (sums[1] * gGreen_mW) >> 8;
+    uint32_t blue32  = (sums[2] * gBlue_mW)  >> 8;
 
     uint32_t total = red32 + green32 + blue32 + (gDark_mW * numLeds);
 
     return total;
 }
 
+// What calculate_unscaled_power_mW() returns for numLeds white LEDs, the most
+// any content can draw.
+static uint32_t max_unscaled_power_mW( uint16_t numLeds )
+{
+    uint32_t full = 255UL * numLeds;
+    return ((full * gRed_mW) >> 8) + ((full * gGreen_mW) >> 8) +
+           ((full * gBlue_mW) >> 8) + (gDark_mW * numLeds);
+}
 
 uint8_t calculate_max_brightness_for_power_vmA(const CRGB* ledbuffer, uint16_t numLeds, uint8_t target_brightness, uint32_t max_power_V, uint32_t max_power_mA) {
 	return calculate_max_brightness_for_power_mW(ledbuffer, numLeds, target_brightness, max_power_V * max_power_mA);
@@ -110,6 +104,21 @@ uint8_t calculate_max_brightness_for_power_mW(const CRGB* ledbuffer, uint16_t nu
 //  - no more than max_mW milliwatts
 uint8_t calculate_max_brightness_for_power_mW( uint8_t target_brightness, uint32_t max_power_mW)
 {
+    // If every LED at full white still fits the budget there is nothing to
+    // limit, and no need to look at the pixels.
+    uint32_t bound_mW = gMCU_mW;
+    for(CLEDController *pCur = CLEDController::head(); pCur; pCur = pCur->next()) {
+        bound_mW += max_unscaled_power_mW( pCur->size());
+    }
+    if( ((uint64_t)bound_mW * target_brightness) / 256 < max_power_mW) {
+#if POWER_LED > 0
+        if( gMaxPowerIndicatorLEDPinNumber ) {
+            Pin(gMaxPowerIndicatorLEDPinNumber).lo(); // turn the LED off
+        }
+#endif
+        return target_brightness;
+    }
+
     uint32_t total_mW = gMCU_mW;
 
     CLEDController *pCur = CLEDController::head();
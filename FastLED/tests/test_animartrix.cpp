@@ -0,0 +1,59 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include <math.h>
+
+#include "FastLED.h"
+#include "fx/2d/animartrix.hpp"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+using namespace animartrix_detail;
+
+namespace {
+class TestANIMartRIX : public ANIMartRIX {
+  public:
+    TestANIMartRIX(int w, int h) : ANIMartRIX(w, h) {}
+    uint16_t xyMap(uint16_t x, uint16_t y) override { return y * num_x + x; }
+    void setPixelColorInternal(int, int, rgb) override {}
+};
+}  // namespace
+
+TEST_CASE("fast_sincos follows sinf and cosf") {
+    float worst = 0;
+    for (float a = -20.f; a < 20.f; a += 0.0137f) {
+        float s, c;
+        fast_sincos(a, &s, &c);
+        worst = fmaxf(worst, fabsf(s - sinf(a)));
+        worst = fmaxf(worst, fabsf(c - cosf(a)));
+    }
+    CHECK(worst < 2e-5f);
+}
+
+TEST_CASE("pnoise_fast follows pnoise") {
+    TestANIMartRIX anim(8, 8);
+    float worst = 0;
+    uint32_t seed = 1;
+    for (int i = 0; i < 20000; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        float x = ((seed >> 8) & 0xffff) / 97.f - 300.f;
+        float y = ((seed >> 4) & 0xfff) / 13.f;
+        float z = (seed & 0x3ff) / 7.f - 50.f;
+        worst = fmaxf(worst, fabsf(anim.pnoise_fast(x, y, z) - anim.pnoise(x, y, z)));
+    }
+    // Well under one step once the noise is mapped to 0..255.
+    CHECK(worst < 1e-3f);
+}
+
+TEST_CASE("polar tables are kept across animation switches") {
+    TestANIMartRIX anim(12, 10);
+    const float *theta = anim.polar_theta[0];
+    CHECK(anim.distance[11][9] == doctest::Approx(hypotf(11 - 5.5f, 9 - 4.5f)));
+    CHECK(anim.polar_theta[0][9] == doctest::Approx(atan2f(9 - 4.5f, -5.5f)));
+    anim.init(12, 10);
+    CHECK(anim.polar_theta[0] == theta);
+    anim.init(16, 16);
+    CHECK(anim.distance[15][15] == doctest::Approx(hypotf(7.5f, 7.5f)));
+}
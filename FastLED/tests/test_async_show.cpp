@@ -0,0 +1,87 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "cled_controller.h"
+#include "fl/engine_events.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+#define NUM_LEDS 16
+
+// Pretends to clock data out in the background. The transfer finishes after
+// it has been polled a few times, or when the test says so.
+class FakeAsyncController : public CLEDController {
+  public:
+    bool mTransferring = false;
+    int mPollsUntilDone = -1;  // -1 never finishes on its own.
+    int mShowCount = 0;
+    virtual void showColor(const CRGB &data, int nLeds,
+                           uint8_t brightness) override {
+        (void)data;
+        (void)nLeds;
+        (void)brightness;
+        mTransferring = true;
+    }
+    virtual void show(const struct CRGB *data, int nLeds,
+                      uint8_t brightness) override {
+        (void)data;
+        (void)nLeds;
+        (void)brightness;
+        ++mShowCount;
+        mTransferring = true;
+    }
+    virtual bool isShowComplete() override {
+        if (mTransferring && mPollsUntilDone > 0 && --mPollsUntilDone == 0) {
+            mTransferring = false;
+        }
+        return !mTransferring;
+    }
+    virtual void init() override {}
+};
+
+struct ShowCompleteCounter : public fl::EngineEvents::Listener {
+    ShowCompleteCounter() { fl::EngineEvents::addListener(this); }
+    ~ShowCompleteCounter() { fl::EngineEvents::removeListener(this); }
+    void onShowComplete() override { ++count; }
+    int count = 0;
+};
+
+static FakeAsyncController gController;
+static CRGB gLeds[NUM_LEDS];
+
+TEST_CASE("async show raises onShowComplete once the transfer finishes") {
+    FastLED.addLeds(&gController, gLeds, NUM_LEDS);
+    FastLED.setAsyncShow(true);
+    CHECK(CLEDController::getAsyncShow());
+
+    ShowCompleteCounter counter;
+    CHECK(FastLED.isShowComplete());
+    CHECK(counter.count == 0);
+
+    FastLED.show();
+    CHECK(gController.mShowCount == 1);
+    CHECK_FALSE(FastLED.isShowComplete());
+    CHECK(counter.count == 0);
+
+    // The "DMA" finishes, polling now raises the event exactly once.
+    gController.mTransferring = false;
+    CHECK(FastLED.isShowComplete());
+    CHECK(counter.count == 1);
+    CHECK(FastLED.isShowComplete());
+    CHECK(counter.count == 1);
+
+    // A second show while the first is still in flight waits for the
+    // previous frame before starting the next one.
+    FastLED.show();
+    gController.mPollsUntilDone = 3;
+    FastLED.show();
+    CHECK(gController.mShowCount == 3);
+    CHECK(counter.count == 2);
+    CHECK_FALSE(FastLED.isShowComplete());
+    gController.mPollsUntilDone = 3;
+    FastLED.waitShowComplete();
+    CHECK(counter.count == 3);
+}
@@ -0,0 +1,53 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "fl/benchmark.h"
+#include "fl/str.h"
+#include "fl/vector.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+using namespace fl;
+
+static fl::HeapVector<Str> gLines;
+static void collect(const char *line) { gLines.push_back(Str(line)); }
+
+TEST_CASE("benchmark runs warm up plus iterations and prints one line each") {
+    gLines.clear();
+    int calls = 0;
+    {
+        Benchmark bench(collect);
+        BenchmarkResult r = bench.run("test/loop/10", 10, 5, [&]() {
+            ++calls;
+            volatile uint32_t sink = 0;
+            for (int i = 0; i < 1000; ++i) {
+                sink = sink + i;
+            }
+        });
+        CHECK(calls == 6);
+        CHECK(r.iterations == 5);
+        CHECK(r.minCycles <= r.meanCycles);
+        CHECK(r.meanCycles <= r.maxCycles);
+        CHECK(bench.runs() == 1);
+    }
+    REQUIRE(gLines.size() == 3);
+    CHECK(strncmp(gLines[0].c_str(), "BENCH_BEGIN fastled=", 20) == 0);
+    CHECK(strncmp(gLines[1].c_str(), "BENCH name=test/loop/10 iters=5 units=10 min=", 45) == 0);
+    CHECK(gLines[2] == Str("BENCH_END runs=1"));
+}
+
+TEST_CASE("benchmark line format") {
+    BenchmarkResult r;
+    r.name = "show/WS2812/256";
+    r.iterations = 16;
+    r.units = 256;
+    r.minCycles = 100;
+    r.meanCycles = 4000000000u;  // Larger than INT32_MAX.
+    r.maxCycles = 4000001000u;
+    Str line = Benchmark::format(r);
+    CHECK(line == Str("BENCH name=show/WS2812/256 iters=16 units=256 min=100 "
+                      "mean=4000000000 max=4000001000 per_unit=15625000"));
+}
@@ -0,0 +1,63 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "fx/2d/bilinear_expansion.h"
+#include "fl/xymap.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+using namespace fl;
+
+static void fillInput(CRGB *input, int n, uint8_t seed) {
+    for (int i = 0; i < n; ++i) {
+        input[i] = CRGB(uint8_t(i * 37 + seed), uint8_t(i * 11 + 255 - seed),
+                        uint8_t(i * i + seed * 3));
+    }
+}
+
+static void checkSame(uint16_t inW, uint16_t inH, const XYMap &xyMap) {
+    CRGB input[16 * 16];
+    CRGB expected[40 * 40];
+    CRGB actual[40 * 40];
+    BilinearExpandPlan plan;
+    // Two frames with different content through the same plan.
+    for (uint8_t frame = 0; frame < 2; ++frame) {
+        fillInput(input, inW * inH, frame * 91);
+        for (int i = 0; i < 40 * 40; ++i) {
+            expected[i] = actual[i] = CRGB(1, 2, 3);
+        }
+        bilinearExpandArbitrary(input, expected, inW, inH, xyMap);
+        plan.expand(input, actual, inW, inH, xyMap);
+        for (uint16_t i = 0; i < xyMap.getTotal(); ++i) {
+            REQUIRE(actual[i] == expected[i]);
+        }
+    }
+}
+
+TEST_CASE("BilinearExpandPlan matches bilinearExpandArbitrary") {
+    checkSame(4, 4, XYMap::constructRectangularGrid(16, 16));
+    checkSame(8, 8, XYMap::constructRectangularGrid(32, 32));
+    checkSame(5, 3, XYMap::constructRectangularGrid(37, 11));
+    checkSame(16, 16, XYMap::constructRectangularGrid(16, 16));
+    checkSame(7, 9, XYMap(23, 29, true));
+    checkSame(6, 6, XYMap::constructRectangularGrid(20, 20, 7));  // Clipped by the offset.
+}
+
+TEST_CASE("BilinearExpandPlan replans when the sizes change") {
+    BilinearExpandPlan plan;
+    CRGB input[8 * 8];
+    CRGB out[24 * 24];
+    fillInput(input, 64, 5);
+    plan.expand(input, out, 4, 4, XYMap::constructRectangularGrid(12, 12));
+    CHECK(plan.matches(4, 4, 12, 12));
+    plan.expand(input, out, 8, 8, XYMap::constructRectangularGrid(24, 24));
+    CHECK(plan.matches(8, 8, 24, 24));
+    CRGB expected[24 * 24];
+    bilinearExpandArbitrary(input, expected, 8, 8, XYMap::constructRectangularGrid(24, 24));
+    for (int i = 0; i < 24 * 24; ++i) {
+        REQUIRE(out[i] == expected[i]);
+    }
+}
@@ -0,0 +1,78 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "fl/allocator.h"
+#include "fl/block_pool.h"
+#include "fx/frame.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+using namespace fl;
+
+TEST_CASE("BlockPool hands out and recycles fixed blocks") {
+    static uint8_t buffer[3 * 64 + 8];
+    BlockPool pool;
+    REQUIRE(pool.init(buffer + 1, sizeof(buffer) - 1, 61));  // misaligned on purpose
+    CHECK(pool.stats().blockSize == 64);
+    CHECK(pool.stats().blockCount == 3);
+
+    void *a = pool.allocate(61);
+    void *b = pool.allocate(10);
+    void *c = pool.allocate(64);
+    CHECK(a);
+    CHECK(b);
+    CHECK(c);
+    CHECK(reinterpret_cast<uintptr_t>(a) % BlockPool::kAlign == 0);
+    CHECK(pool.allocate(1) == nullptr);
+    CHECK(pool.allocate(65) == nullptr);
+    CHECK(pool.stats().exhausted == 1);
+    CHECK(pool.stats().oversized == 1);
+    CHECK(pool.stats().highWater == 3);
+    CHECK_FALSE(pool.reset());  // Still in use.
+
+    pool.deallocate(b);
+    CHECK(pool.allocate(8) == b);
+    pool.deallocate(a);
+    pool.deallocate(b);
+    pool.deallocate(c);
+    CHECK(pool.stats().inUse == 0);
+    CHECK(pool.stats().highWater == 3);
+    pool.resetHighWater();
+    CHECK(pool.stats().highWater == 0);
+    CHECK(pool.owns(c));
+    uint8_t not_pooled = 0;
+    CHECK_FALSE(pool.owns(&not_pooled));
+    CHECK(pool.reset());
+}
+
+TEST_CASE("frames come from the large block pool") {
+    const int kPixels = 100;
+    REQUIRE(LargeBlockPoolReserve(kPixels * sizeof(CRGB), 2));
+    {
+        FramePtr f1 = FramePtr::New(kPixels);
+        FramePtr f2 = FramePtr::New(kPixels);
+        CHECK(LargeBlockPoolGetStats().inUse == 2);
+        // Pool memory is zeroed like heap frames.
+        CHECK(f1->rgb()[kPixels - 1] == CRGB(0, 0, 0));
+        f1->rgb()[0] = CRGB::Red;
+        // A third frame falls back to the heap.
+        FramePtr f3 = FramePtr::New(kPixels);
+        CHECK(f3->rgb() != nullptr);
+        CHECK(LargeBlockPoolGetStats().exhausted == 1);
+        CHECK(LargeBlockPoolGetStats().inUse == 2);
+        CHECK_FALSE(LargeBlockPoolRelease());
+    }
+    for (int i = 0; i < 10; ++i) {
+        FramePtr f = FramePtr::New(kPixels);
+        CHECK(f->rgb()[0] == CRGB(0, 0, 0));
+    }
+    BlockPoolStats stats = LargeBlockPoolGetStats();
+    CHECK(stats.inUse == 0);
+    CHECK(stats.highWater == 2);
+    CHECK(stats.blockCount == 2);
+    CHECK(LargeBlockPoolRelease());
+    CHECK(LargeBlockPoolGetStats().blockCount == 0);
+}
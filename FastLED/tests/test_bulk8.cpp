@@ -0,0 +1,85 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "lib8tion/bulk8.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+#define NUM_LEDS 37  // Not a multiple of the word or unroll size.
+
+static void fillPattern(CRGB *leds, int n, uint8_t seed) {
+    uint8_t *bytes = (uint8_t *)leds;
+    for (int i = 0; i < n * 3; ++i) {
+        // Hit 0, 1, 254 and 255 regularly, they are the carry corner cases.
+        switch ((i + seed) % 7) {
+        case 0: bytes[i] = 0; break;
+        case 1: bytes[i] = 255; break;
+        case 2: bytes[i] = 1; break;
+        case 3: bytes[i] = 254; break;
+        default: bytes[i] = (uint8_t)(i * 37 + seed * 11); break;
+        }
+    }
+}
+
+TEST_CASE("nscale8 over an array matches CRGB::nscale8") {
+    CRGB leds[NUM_LEDS];
+    CRGB expected[NUM_LEDS];
+    for (int scale = 0; scale < 256; ++scale) {
+        fillPattern(leds, NUM_LEDS, scale);
+        fillPattern(expected, NUM_LEDS, scale);
+        nscale8(leds, NUM_LEDS, scale);
+        for (int i = 0; i < NUM_LEDS; ++i) {
+            expected[i].nscale8(scale);
+        }
+        for (int i = 0; i < NUM_LEDS; ++i) {
+            REQUIRE(leds[i] == expected[i]);
+        }
+    }
+}
+
+TEST_CASE("nscale8_video over an array matches CRGB::nscale8_video") {
+    CRGB leds[NUM_LEDS];
+    CRGB expected[NUM_LEDS];
+    for (int scale = 0; scale < 256; ++scale) {
+        fillPattern(leds, NUM_LEDS, scale);
+        fillPattern(expected, NUM_LEDS, scale);
+        nscale8_video(leds, NUM_LEDS, scale);
+        for (int i = 0; i < NUM_LEDS; ++i) {
+            expected[i].nscale8_video(scale);
+        }
+        for (int i = 0; i < NUM_LEDS; ++i) {
+            REQUIRE(leds[i] == expected[i]);
+        }
+    }
+}
+
+TEST_CASE("blend over arrays matches the single pixel blend") {
+    CRGB a[NUM_LEDS];
+    CRGB b[NUM_LEDS];
+    CRGB out[NUM_LEDS];
+    for (int amount = 0; amount < 256; ++amount) {
+        fillPattern(a, NUM_LEDS, amount);
+        fillPattern(b, NUM_LEDS, amount + 3);
+        blend(a, b, out, NUM_LEDS, amount);
+        for (int i = 0; i < NUM_LEDS; ++i) {
+            REQUIRE(out[i] == blend(a[i], b[i], amount));
+        }
+        // In place variant.
+        nblend(a, b, NUM_LEDS, amount);
+        for (int i = 0; i < NUM_LEDS; ++i) {
+            REQUIRE(a[i] == out[i]);
+        }
+    }
+}
+
+TEST_CASE("fadeToBlackBy uses the bulk kernel") {
+    CRGB leds[NUM_LEDS];
+    fill_solid(leds, NUM_LEDS, CRGB(200, 100, 1));
+    fadeToBlackBy(leds, NUM_LEDS, 128);
+    for (int i = 0; i < NUM_LEDS; ++i) {
+        CHECK(leds[i] == CRGB(scale8(200, 127), scale8(100, 127), scale8(1, 127)));
+    }
+}
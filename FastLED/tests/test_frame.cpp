@@ -37,3 +37,20 @@ TEST_CASE("test frame custom allocator") {
     CHECK(allocation_count == 0);
 }
 
+
+TEST_CASE("frame interpolation matches CRGB::blend") {
+    const int kPixels = 21;  // Not a multiple of the word size.
+    Frame a(kPixels);
+    Frame b(kPixels);
+    for (int i = 0; i < kPixels; ++i) {
+        a.rgb()[i] = CRGB(i * 12, 255 - i, i & 1 ? 255 : 0);
+        b.rgb()[i] = CRGB(255 - i * 12, i * 3, i & 2 ? 0 : 255);
+    }
+    CRGB out[kPixels];
+    for (int amount = 0; amount < 256; ++amount) {
+        Frame::interpolate(a, b, amount, out);
+        for (int i = 0; i < kPixels; ++i) {
+            REQUIRE(out[i] == CRGB::blend(a.rgb()[i], b.rgb()[i], amount));
+        }
+    }
+}
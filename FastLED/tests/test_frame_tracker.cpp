@@ -25,3 +25,32 @@ TEST_CASE("FrameTracker basic frame advancement") {
     CHECK(nextFrame == 1);
     CHECK(amountOfNextFrame == 127);
 }
+
+// The blend weight and frame number the tracker used to compute with divisions.
+static void referenceInterval(uint32_t now, uint32_t interval, uint32_t *frame, uint8_t *amount) {
+    uint64_t micros = uint64_t(now) * 1000ULL;
+    *frame = uint32_t(micros / interval);
+    uint32_t rel_time = uint32_t(micros - uint64_t(*frame) * interval);
+    *amount = uint8_t((uint64_t(rel_time) * 255) / interval);
+}
+
+TEST_CASE("FrameTracker matches the division based math") {
+    const float fps_values[] = {1.0f, 24.0f, 29.97f, 30.0f, 60.0f, 120.0f};
+    for (float fps : fps_values) {
+        FrameTracker tracker(fps);
+        const uint32_t interval = uint32_t(1000000.0f / fps + .5f);
+        // Forward in small steps, then a few jumps and a step back in time.
+        const uint32_t jumps[] = {100000, 5, 7, 0, 12345, 3};
+        uint32_t now = 0;
+        for (int step = 0; step < 3000; ++step) {
+            now = (step < 2500) ? now + 3 : jumps[step % 6];
+            uint32_t frame, next, ref_frame;
+            uint8_t amount, ref_amount;
+            tracker.get_interval_frames(now, &frame, &next, &amount);
+            referenceInterval(now, interval, &ref_frame, &ref_amount);
+            REQUIRE(frame == ref_frame);
+            REQUIRE(next == ref_frame + 1);
+            REQUIRE(amount == ref_amount);
+        }
+    }
+}
@@ -208,3 +208,76 @@ TEST_CASE("test_fixed_fps") {
     CHECK_EQ(2, fake.mFrameCounter);
     CHECK_EQ(leds[0], CRGB(127, 0, 0));
 }
+
+// Draws a solid color and only reports itself dirty when the color changes.
+class StaticFx : public Fx {
+  public:
+    StaticFx(uint16_t numLeds, CRGB color) : Fx(numLeds), mColor(color) {}
+
+    void draw(DrawContext ctx) override {
+        ++mDrawCount;
+        mDirty = false;
+        for (uint16_t i = 0; i < mNumLeds; ++i) {
+            ctx.leds[i] = mColor;
+        }
+    }
+
+    bool isDirty(uint32_t now) override {
+        (void)now;
+        return mDirty;
+    }
+
+    void setColor(CRGB color) {
+        mColor = color;
+        mDirty = true;
+    }
+
+    Str fxName() const override { return "StaticFx"; }
+    int mDrawCount = 0;
+
+  private:
+    CRGB mColor;
+    bool mDirty = true;
+};
+
+TEST_CASE("test_fx_engine_skips_clean_fx") {
+    constexpr uint16_t NUM_LEDS = 10;
+    FxEngine engine(NUM_LEDS, false);
+    CRGB leds[NUM_LEDS];
+    StaticFx red(NUM_LEDS, CRGB::Red);
+    StaticFx blue(NUM_LEDS, CRGB::Blue);
+    engine.addFx(red);
+    engine.addFx(blue);
+
+    engine.draw(0, leds);
+    CHECK(engine.lastDrawChanged());
+    CHECK_EQ(1, red.mDrawCount);
+
+    // Nothing changed, the last surface is reused but still written out.
+    leds[0] = CRGB::Black;
+    engine.draw(10, leds);
+    CHECK_FALSE(engine.lastDrawChanged());
+    CHECK_EQ(1, red.mDrawCount);
+    CHECK_EQ(leds[0], CRGB(CRGB::Red));
+
+    red.setColor(CRGB::Green);
+    engine.draw(20, leds);
+    CHECK(engine.lastDrawChanged());
+    CHECK_EQ(2, red.mDrawCount);
+    CHECK_EQ(leds[NUM_LEDS - 1], CRGB(CRGB::Green));
+
+    // The transition recomputes while it runs, even with both fx clean.
+    engine.nextFx(100);
+    engine.draw(100, leds);  // Starts the transition, nothing to blend yet.
+    CHECK_EQ(0, blue.mDrawCount);
+    engine.draw(150, leds);
+    CHECK(engine.lastDrawChanged());
+    CHECK_EQ(leds[0], CRGB::blend(CRGB::Green, CRGB::Blue, 127));
+    CHECK_EQ(2, red.mDrawCount);
+    CHECK_EQ(1, blue.mDrawCount);
+    engine.draw(200, leds);  // Transition is done.
+    CHECK_EQ(leds[0], CRGB(CRGB::Blue));
+    engine.draw(250, leds);
+    CHECK_FALSE(engine.lastDrawChanged());
+    CHECK_EQ(1, blue.mDrawCount);
+}
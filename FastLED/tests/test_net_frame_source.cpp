@@ -0,0 +1,184 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include <string.h>
+
+#include "FastLED.h"
+#include "fx/video/net_frame_source.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+static void put16(uint8_t *p, uint16_t v) {
+    p[0] = uint8_t(v >> 8);
+    p[1] = uint8_t(v);
+}
+
+static void put32(uint8_t *p, uint32_t v) {
+    put16(p, uint16_t(v >> 16));
+    put16(p + 2, uint16_t(v));
+}
+
+static size_t makeE131Data(uint8_t *buf, uint16_t universe, uint8_t sequence,
+                           const uint8_t *channels, uint16_t count,
+                           uint16_t syncAddress = 0, uint8_t options = 0) {
+    memset(buf, 0, 126 + count);
+    put16(buf, 0x0010);
+    memcpy(buf + 4, "ASC-E1.17\0\0\0", 12);
+    put32(buf + 18, 0x00000004);
+    put32(buf + 40, 0x00000002);
+    put16(buf + 109, syncAddress);
+    buf[111] = sequence;
+    buf[112] = options;
+    put16(buf + 113, universe);
+    buf[117] = 0x02;
+    buf[118] = 0xa1;
+    put16(buf + 121, 1);
+    put16(buf + 123, uint16_t(count + 1));
+    memcpy(buf + 126, channels, count);
+    return 126 + count;
+}
+
+static size_t makeE131Sync(uint8_t *buf, uint16_t syncAddress) {
+    memset(buf, 0, 49);
+    put16(buf, 0x0010);
+    memcpy(buf + 4, "ASC-E1.17\0\0\0", 12);
+    put32(buf + 18, 0x00000008);
+    put32(buf + 40, 0x00000001);
+    put16(buf + 45, syncAddress);
+    return 49;
+}
+
+static size_t makeArtDmx(uint8_t *buf, uint16_t universe, uint8_t sequence,
+                         const uint8_t *channels, uint16_t count) {
+    memset(buf, 0, 18 + count);
+    memcpy(buf, "Art-Net\0", 8);
+    buf[8] = 0x00;
+    buf[9] = 0x50;
+    buf[11] = 14;
+    buf[12] = sequence;
+    buf[14] = uint8_t(universe);
+    buf[15] = uint8_t(universe >> 8);
+    put16(buf + 16, count);
+    memcpy(buf + 18, channels, count);
+    return 18 + count;
+}
+
+static size_t makeArtSync(uint8_t *buf) {
+    memset(buf, 0, 14);
+    memcpy(buf, "Art-Net\0", 8);
+    buf[9] = 0x52;
+    buf[11] = 14;
+    return 14;
+}
+
+static void onFrame(void *self) { ++*static_cast<int *>(self); }
+
+TEST_CASE("E1.31 data lands directly in the mapped leds") {
+    CRGB leds[200];
+    memset(leds, 0, sizeof(leds));
+    NetFrameSource net;
+    CHECK(net.mapUniverses(1, Slice<CRGB>(leds, 200)) == 2);
+
+    uint8_t channels[510];
+    for (int i = 0; i < 510; ++i) {
+        channels[i] = uint8_t(i * 3 + 1);
+    }
+    uint8_t buf[700];
+    size_t n = makeE131Data(buf, 1, 0, channels, 510);
+    CHECK(net.handlePacket(buf, n) == NetFrameSource::kData);
+    CHECK(leds[0] == CRGB(channels[0], channels[1], channels[2]));
+    CHECK(leds[169] == CRGB(channels[507], channels[508], channels[509]));
+    CHECK(leds[170] == CRGB(0, 0, 0));
+    CHECK_FALSE(net.frameReady());
+
+    // The second universe carries the last 30 pixels and completes the frame.
+    n = makeE131Data(buf, 2, 0, channels, 90);
+    CHECK(net.handlePacket(buf, n) == NetFrameSource::kData);
+    CHECK(leds[170] == CRGB(channels[0], channels[1], channels[2]));
+    CHECK(leds[199] == CRGB(channels[87], channels[88], channels[89]));
+    CHECK(net.takeFrame());
+    CHECK_FALSE(net.takeFrame());
+    CHECK(net.framesReady() == 1);
+
+    n = makeE131Data(buf, 7, 0, channels, 90);
+    CHECK(net.handlePacket(buf, n) == NetFrameSource::kIgnored);
+    n = makeE131Data(buf, 1, 1, channels, 30, 0, 0x80);  // preview data
+    CHECK(net.handlePacket(buf, n) == NetFrameSource::kIgnored);
+    CHECK(net.handlePacket(channels, 40) == NetFrameSource::kInvalid);
+    CHECK(net.invalidPackets() == 1);
+}
+
+TEST_CASE("sequence numbers give per universe loss counts") {
+    CRGB leds[4];
+    NetFrameSource net;
+    net.mapUniverse(3, Slice<CRGB>(leds, 4));
+    uint8_t channels[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    uint8_t buf[200];
+
+    const uint8_t sequence[] = {250, 251, 254, 255, 0, 3, 1, 4};
+    for (uint8_t s : sequence) {
+        net.handlePacket(buf, makeE131Data(buf, 3, s, channels, 12));
+    }
+    const NetUniverseStats *stats = net.stats(3);
+    REQUIRE(stats != nullptr);
+    CHECK(stats->packets == 7);
+    CHECK(stats->lost == 2 + 2);  // 252, 253 and 1, 2
+    CHECK(stats->late == 1);      // 1 after 3
+    CHECK(net.stats(4) == nullptr);
+
+    // A packet shorter than the slice only fills what it carries.
+    net.handlePacket(buf, makeE131Data(buf, 3, 5, channels, 6));
+    CHECK(stats->truncated == 1);
+    net.resetStats();
+    CHECK(stats->packets == 0);
+}
+
+TEST_CASE("sync packets trigger the frame") {
+    CRGB leds[2];
+    NetFrameSource net;
+    int frames = 0;
+    net.onFrame(Callback<>(&frames, &onFrame));
+    net.mapUniverse(1, Slice<CRGB>(leds, 2));
+    net.setSyncUniverse(9);
+    uint8_t channels[6] = {10, 20, 30, 40, 50, 60};
+    uint8_t buf[200];
+
+    // Data that names a sync address waits for the sync packet.
+    net.handlePacket(buf, makeE131Data(buf, 1, 0, channels, 6, 9));
+    CHECK(net.syncMode());
+    CHECK_FALSE(net.frameReady());
+    CHECK(net.handlePacket(buf, makeE131Sync(buf, 8)) == NetFrameSource::kIgnored);
+    CHECK_FALSE(net.frameReady());
+    CHECK(net.handlePacket(buf, makeE131Sync(buf, 9)) == NetFrameSource::kSync);
+    CHECK(net.takeFrame());
+    CHECK(frames == 1);
+    CHECK(leds[1] == CRGB(40, 50, 60));
+}
+
+TEST_CASE("Art-Net data and ArtSync") {
+    CRGB leds[3];
+    memset(leds, 0, sizeof(leds));
+    NetFrameSource net;
+    net.mapUniverse(0x0102, Slice<CRGB>(leds, 3), 3);  // skips one pixel
+    uint8_t channels[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    uint8_t buf[200];
+
+    CHECK(net.handlePacket(buf, makeArtDmx(buf, 0x0102, 255, channels, 12)) ==
+          NetFrameSource::kData);
+    CHECK(leds[0] == CRGB(4, 5, 6));
+    CHECK(leds[2] == CRGB(10, 11, 12));
+    CHECK(net.takeFrame());  // no sync seen yet, the universe completes it
+
+    // Art-Net sequences wrap from 255 to 1, 0 turns numbering off.
+    net.handlePacket(buf, makeArtDmx(buf, 0x0102, 1, channels, 12));
+    net.handlePacket(buf, makeArtDmx(buf, 0x0102, 0, channels, 12));
+    CHECK(net.stats(0x0102)->lost == 0);
+
+    CHECK(net.handlePacket(buf, makeArtSync(buf)) == NetFrameSource::kSync);
+    CHECK(net.syncMode());
+    CHECK(net.takeFrame());
+    net.handlePacket(buf, makeArtDmx(buf, 0x0102, 2, channels, 12));
+    CHECK_FALSE(net.frameReady());
+}
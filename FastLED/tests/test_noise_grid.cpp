@@ -0,0 +1,50 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "noise.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+#define GRID_W 19
+#define GRID_H 7
+
+TEST_CASE("fill_raw_noise_grid8 matches inoise8") {
+    const int16_t scales[] = {1, 30, 120, 255, 256, 1000, -45};
+    const uint16_t starts[] = {0, 0x00f0, 0xfff0, 12345};
+    uint8_t grid[GRID_W * GRID_H];
+    for (int16_t scale : scales) {
+        for (uint16_t start : starts) {
+            uint16_t z = start * 3 + 77;
+            fill_raw_noise_grid8(grid, GRID_W, GRID_H, start, scale, start + 500, -scale, z);
+            for (int j = 0; j < GRID_H; ++j) {
+                for (int i = 0; i < GRID_W; ++i) {
+                    uint16_t x = start + i * scale;
+                    uint16_t y = start + 500 - j * scale;
+                    REQUIRE(grid[j * GRID_W + i] == inoise8(x, y, z));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("fill_raw_noise_grid16 matches inoise16") {
+    const int32_t scales[] = {1, 500, 0x10000, 0x12345, -7000};
+    const uint32_t starts[] = {0, 0xffff00, 0xfffff000, 0x00abcdef};
+    uint16_t grid[GRID_W * GRID_H];
+    for (int32_t scale : scales) {
+        for (uint32_t start : starts) {
+            uint32_t z = start ^ 0x5a5a5a;
+            fill_raw_noise_grid16(grid, GRID_W, GRID_H, start, scale, start * 3, scale * 2, z);
+            for (int j = 0; j < GRID_H; ++j) {
+                for (int i = 0; i < GRID_W; ++i) {
+                    uint32_t x = start + i * scale;
+                    uint32_t y = start * 3 + j * scale * 2;
+                    REQUIRE(grid[j * GRID_W + i] == inoise16(x, y, z));
+                }
+            }
+        }
+    }
+}
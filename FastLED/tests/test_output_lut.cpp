@@ -0,0 +1,112 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "pixel_controller.h"
+#include "output_lut.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+#define NUM_LEDS (FASTLED_OUTPUT_LUT_MIN_LEDS + 3)
+
+static CRGB gLeds[NUM_LEDS];
+
+static void fillLeds() {
+    uint8_t *bytes = (uint8_t *)gLeds;
+    for (int i = 0; i < NUM_LEDS * 3; ++i) {
+        bytes[i] = (uint8_t)(i * 7);  // Covers every value, including 0.
+    }
+}
+
+static ColorAdjustment makeAdjustment(CRGB premixed, CRGB color, uint8_t brightness) {
+    ColorAdjustment adj;
+    adj.premixed = premixed;
+    #if FASTLED_HD_COLOR_MIXING
+    adj.color = color;
+    adj.brightness = brightness;
+    #else
+    (void)color;
+    (void)brightness;
+    #endif
+    return adj;
+}
+
+TEST_CASE("fused output table matches the per pixel dither and scale") {
+    CHECK(FASTLED_HAS_OUTPUT_LUT);
+    fillLeds();
+    ColorAdjustment adj = makeAdjustment(CRGB(200, 97, 31), CRGB(255, 176, 240), 200);
+    for (int frame = 0; frame < 4; ++frame) {
+        PixelController<GRB> pixels(gLeds, NUM_LEDS, adj, BINARY_DITHER);
+        PixelController<GRB> reference(pixels);
+        for (int i = 0; pixels.has(1); ++i) {
+            uint8_t b0, b1, b2;
+            pixels.loadAndScaleRGB(&b0, &b1, &b2);
+            REQUIRE(b0 == reference.loadAndScale0());
+            REQUIRE(b1 == reference.loadAndScale1());
+            REQUIRE(b2 == reference.loadAndScale2());
+            pixels.stepDithering();
+            pixels.advanceData();
+            reference.stepDithering();
+            reference.advanceData();
+        }
+        CHECK(pixels.rgbLut() != nullptr);
+    }
+}
+
+TEST_CASE("stale output table falls back to the per pixel math") {
+    fillLeds();
+    ColorAdjustment a = makeAdjustment(CRGB(255, 128, 64), CRGB(255, 255, 255), 255);
+    ColorAdjustment b = makeAdjustment(CRGB(10, 20, 30), CRGB(255, 255, 255), 255);
+    PixelController<RGB> first(gLeds, NUM_LEDS, a, DISABLE_DITHER);
+    PixelController<RGB> second(gLeds, NUM_LEDS, b, DISABLE_DITHER);
+    CHECK(first.rgbLut() != nullptr);
+    CHECK(second.rgbLut() != nullptr);
+    // The second controller replaced the tables the first one built.
+    CHECK(first.rgbLut() == nullptr);
+    uint8_t r, g, bl;
+    first.advanceData();
+    first.loadAndScaleRGB(&r, &g, &bl);
+    CHECK(r == scale8(gLeds[1].r, 255));
+    CHECK(g == scale8(gLeds[1].g, 128));
+    CHECK(bl == scale8(gLeds[1].b, 64));
+}
+
+TEST_CASE("short strips do not use the output table") {
+    ColorAdjustment adj = makeAdjustment(CRGB(255, 255, 255), CRGB(255, 255, 255), 255);
+    PixelController<RGB> pixels(gLeds, 8, adj, DISABLE_DITHER);
+    CHECK(pixels.rgbLut() == nullptr);
+    CHECK(pixels.hdGammaLut(CRGB(255, 255, 255)) == nullptr);
+}
+
+TEST_CASE("fused HD gamma table matches five_bit_hd_gamma_bitshift") {
+    fillLeds();
+    const uint8_t brightness_values[] = {0, 1, 31, 128, 255};
+    for (uint8_t brightness : brightness_values) {
+        ColorAdjustment adj = makeAdjustment(CRGB(brightness, brightness, brightness),
+                                             CRGB(255, 200, 150), brightness);
+        PixelController<BGR> pixels(gLeds, NUM_LEDS, adj, DISABLE_DITHER);
+        for (int i = 0; pixels.has(1); ++i) {
+            uint8_t b0, b1, b2, power;
+            pixels.loadAndScale_APA102_HD(&b0, &b1, &b2, &power);
+
+            CRGB expected(0, 0, 0);
+            uint8_t expected_power = 0;
+            if (gLeds[i]) {
+                #if FASTLED_HD_COLOR_MIXING
+                five_bit_hd_gamma_bitshift(gLeds[i], adj.color, adj.brightness,
+                                           &expected, &expected_power);
+                #else
+                five_bit_hd_gamma_bitshift(gLeds[i], adj.premixed, 255,
+                                           &expected, &expected_power);
+                #endif
+            }
+            REQUIRE(b0 == expected.b);
+            REQUIRE(b1 == expected.g);
+            REQUIRE(b2 == expected.r);
+            REQUIRE(power == expected_power);
+            pixels.advanceData();
+        }
+    }
+}
@@ -0,0 +1,77 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "power_mgt.h"
+#include "lib8tion/bulk8.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+#define NUM_LEDS 3001
+
+static CRGB gLeds[NUM_LEDS];
+
+// The loop calculate_unscaled_power_mW() used to run.
+static uint32_t referencePower(const CRGB *leds, uint16_t n) {
+    uint32_t r = 0, g = 0, b = 0;
+    for (uint16_t i = 0; i < n; ++i) {
+        r += leds[i].r;
+        g += leds[i].g;
+        b += leds[i].b;
+    }
+    return ((r * 16 * 5) >> 8) + ((g * 11 * 5) >> 8) + ((b * 15 * 5) >> 8) + 5 * n;
+}
+
+TEST_CASE("channel_sums8_bulk matches a per pixel sum") {
+    for (int i = 0; i < NUM_LEDS; ++i) {
+        gLeds[i] = CRGB(uint8_t(i * 7), uint8_t(255 - i), uint8_t(i * i));
+    }
+    const uint32_t counts[] = {0, 1, 3, 4, 5, 1023, 1024, 1025, NUM_LEDS};
+    for (uint32_t n : counts) {
+        // Odd start, the kernel must not assume alignment.
+        const CRGB *start = gLeds + (n < NUM_LEDS ? 1 : 0);
+        uint32_t sums[3];
+        channel_sums8_bulk((const uint8_t *)start, n, sums);
+        uint32_t r = 0, g = 0, b = 0;
+        for (uint32_t i = 0; i < n; ++i) {
+            r += start[i].r;
+            g += start[i].g;
+            b += start[i].b;
+        }
+        CHECK(sums[0] == r);
+        CHECK(sums[1] == g);
+        CHECK(sums[2] == b);
+    }
+}
+
+TEST_CASE("channel_sums8_bulk does not overflow on full white") {
+    for (int i = 0; i < NUM_LEDS; ++i) {
+        gLeds[i] = CRGB(255, 255, 255);
+    }
+    uint32_t sums[3];
+    channel_sums8_bulk((const uint8_t *)gLeds, NUM_LEDS, sums);
+    CHECK(sums[0] == 255u * NUM_LEDS);
+    CHECK(sums[1] == 255u * NUM_LEDS);
+    CHECK(sums[2] == 255u * NUM_LEDS);
+}
+
+TEST_CASE("calculate_unscaled_power_mW is unchanged") {
+    for (int i = 0; i < NUM_LEDS; ++i) {
+        gLeds[i] = CRGB(uint8_t(i * 13), uint8_t(i >> 3), uint8_t(200 - i));
+    }
+    CHECK(calculate_unscaled_power_mW(gLeds, NUM_LEDS) == referencePower(gLeds, NUM_LEDS));
+    CHECK(calculate_unscaled_power_mW(gLeds, 17) == referencePower(gLeds, 17));
+}
+
+TEST_CASE("brightness limit with and without the full white shortcut") {
+    // No controllers registered: only the MCU draws power.
+    CHECK(calculate_max_brightness_for_power_mW(200, 1000000) == 200);
+    for (int i = 0; i < 100; ++i) {
+        gLeds[i] = CRGB(255, 255, 255);
+    }
+    const uint32_t full = calculate_unscaled_power_mW(gLeds, 100);
+    CHECK(calculate_max_brightness_for_power_mW(gLeds, 100, 255, full) == 255);
+    CHECK(calculate_max_brightness_for_power_mW(gLeds, 100, 255, full / 2) < 130);
+}
@@ -0,0 +1,86 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "cled_controller.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+#define NUM_LEDS 8
+
+// Shared log of the calls the scheduler makes, in order.
+enum Call { kEnd, kWait };
+static int gLog[16];
+static int gLogLen = 0;
+static void logCall(int call, int channel) {
+    if (gLogLen < 16) {
+        gLog[gLogLen++] = call * 10 + channel;
+    }
+}
+
+class FakeChannel : public CLEDController {
+  public:
+    explicit FakeChannel(int channel) : mChannel(channel) {}
+    int mChannel;
+    int mPollsUntilDone = 0;
+    virtual void showColor(const CRGB &data, int nLeds,
+                           uint8_t brightness) override {
+        (void)data;
+        (void)nLeds;
+        (void)brightness;
+    }
+    virtual void show(const struct CRGB *data, int nLeds,
+                      uint8_t brightness) override {
+        (void)data;
+        (void)nLeds;
+        (void)brightness;
+    }
+    virtual void endShowLeds(void *data) override {
+        CLEDController::endShowLeds(data);
+        logCall(kEnd, mChannel);
+    }
+    virtual void waitShowLeds() override { logCall(kWait, mChannel); }
+    virtual bool isShowComplete() override {
+        if (mPollsUntilDone > 0) {
+            --mPollsUntilDone;
+            return false;
+        }
+        return true;
+    }
+    virtual void init() override {}
+};
+
+static FakeChannel gChannel0(0);
+static FakeChannel gChannel1(1);
+static CRGB gLeds0[NUM_LEDS];
+static CRGB gLeds1[NUM_LEDS];
+
+TEST_CASE("show starts every channel before waiting on any of them") {
+    FastLED.addLeds(&gChannel0, gLeds0, NUM_LEDS);
+    FastLED.addLeds(&gChannel1, gLeds1, NUM_LEDS);
+    gLogLen = 0;
+    FastLED.show();
+    REQUIRE(gLogLen == 4);
+    CHECK(gLog[0] == kEnd * 10 + 0);
+    CHECK(gLog[1] == kEnd * 10 + 1);
+    CHECK(gLog[2] == kWait * 10 + 0);
+    CHECK(gLog[3] == kWait * 10 + 1);
+}
+
+TEST_CASE("show reports the frame time of each channel") {
+    gChannel0.mPollsUntilDone = 0;
+    gChannel1.mPollsUntilDone = 0;
+    FastLED.show();
+    CHECK(FastLED.isShowComplete());
+
+    // Channel 1 keeps running for a while after show() returns.
+    gChannel1.mPollsUntilDone = 1000;
+    FastLED.show();
+    CHECK_FALSE(FastLED.isShowComplete());
+    FastLED.waitShowComplete();
+    CHECK(FastLED.getShowMicros(1) >= FastLED.getShowMicros(0));
+    CHECK(FastLED.getShowMicros() == FastLED.getShowMicros(1));
+    CHECK(FastLED.getShowMicros(64) == 0);
+}
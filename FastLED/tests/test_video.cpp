@@ -10,6 +10,8 @@
 #include "fx/video/pixel_stream.h"
 #include "fl/bytestreammemory.h"
 #include "fx/video.h"
+#include "fx/video/frame_prefetcher.h"
+#include "fl/engine_events.h"
 #include "fl/ptr.h"
 #include "crgb.h"
 
@@ -155,3 +157,64 @@ TEST_CASE("video with file handle") {
         CHECK_EQ(leds[i], led_frame[i]);
     }
 }
+
+TEST_CASE("video with file handle and prefetch") {
+    Video video(LEDS_PER_FRAME, FPS);
+    video.setPrefetch(4);
+    FakeFileHandlePtr fileHandle = FakeFileHandlePtr::New();
+    // Six frames, each filled with its own frame number.
+    for (uint8_t f = 0; f < 6; f++) {
+        CRGB led_frame[LEDS_PER_FRAME];
+        for (uint32_t i = 0; i < LEDS_PER_FRAME; i++) {
+            led_frame[i] = CRGB(f, f, f);
+        }
+        fileHandle->writeCRGB(led_frame, LEDS_PER_FRAME);
+    }
+    video.begin(fileHandle);
+    FramePrefetchStats stats;
+    REQUIRE(video.prefetchStats(&stats));
+    CRGB leds[LEDS_PER_FRAME];
+    // Nothing was read ahead yet, the first two frames are underruns.
+    REQUIRE(video.draw(0, leds));
+    CHECK_EQ(leds[0], CRGB(0, 0, 0));
+    video.prefetchStats(&stats);
+    CHECK_EQ(stats.underruns, 2);
+    CHECK_EQ(stats.hits, 0);
+    // The fill after show() reads ahead, later frames come from the ring.
+    fl::EngineEvents::onEndShowLeds();
+    fl::EngineEvents::onEndShowLeds();
+    REQUIRE(video.draw(3 * FRAME_TIME + 1, leds));
+    CHECK_EQ(leds[0], CRGB(3, 3, 3));
+    video.prefetchStats(&stats);
+    CHECK_EQ(stats.underruns, 2);
+    CHECK_EQ(stats.readErrors, 0);
+    CHECK_EQ(stats.hits, 2);
+}
+
+TEST_CASE("frame prefetcher loops and drops stale frames") {
+    FakeFileHandlePtr fileHandle = FakeFileHandlePtr::New();
+    for (uint8_t f = 0; f < 3; f++) {
+        CRGB led_frame[LEDS_PER_FRAME];
+        for (uint32_t i = 0; i < LEDS_PER_FRAME; i++) {
+            led_frame[i] = CRGB(f, 0, 0);
+        }
+        fileHandle->writeCRGB(led_frame, LEDS_PER_FRAME);
+    }
+    PixelStreamPtr stream = PixelStreamPtr::New(LEDS_PER_FRAME * 3);
+    stream->begin(fileHandle);
+    FramePrefetcherPtr prefetcher = FramePrefetcherPtr::New(stream, LEDS_PER_FRAME, 4, false);
+    CHECK_FALSE(prefetcher->usingTask());
+    CHECK_EQ(prefetcher->totalFrames(), 3);
+    CHECK_EQ(prefetcher->fill(10), 4);  // 0, 1, 2, then loops back to 0.
+    CHECK_EQ(prefetcher->buffered(), 4);
+    FramePtr frame = FramePtr::New(LEDS_PER_FRAME);
+    REQUIRE(prefetcher->read(2, frame.get()));  // Skips frames 0 and 1.
+    CHECK_EQ(frame->rgb()[0].r, 2);
+    CHECK_EQ(prefetcher->buffered(), 1);
+    REQUIRE(prefetcher->read(0, frame.get()));
+    CHECK_EQ(frame->rgb()[0].r, 0);
+    CHECK_FALSE(prefetcher->read(3, frame.get()));  // Past the end.
+    CHECK_EQ(prefetcher->stats().hits, 2);
+    CHECK_EQ(prefetcher->stats().underruns, 0);
+    CHECK_EQ(prefetcher->stats().minBuffered, 1);
+}
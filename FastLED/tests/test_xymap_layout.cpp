@@ -0,0 +1,76 @@
+// g++ --std=c++11 test.cpp
+
+#include "test.h"
+
+#include "FastLED.h"
+#include "fl/xymap.h"
+#include "fl/xymap_layout.h"
+
+#include "fl/namespace.h"
+FASTLED_USING_NAMESPACE
+
+using namespace fl;
+
+// The index math is usable in constant expressions.
+static_assert(StaticXYMap<SerpentineLayout<4, 3>>::mapToIndex(0, 1) == 7,
+              "serpentine rows reverse");
+static_assert(StaticXYMap<TiledLayout<2, 2, LineByLineLayout<2, 2>>>::kTotal == 16,
+              "tiled size");
+
+TEST_CASE("compile time layouts match the runtime XYMap") {
+    typedef SerpentineLayout<7, 5> Serp;
+    typedef LineByLineLayout<7, 5> Rect;
+    XYMap serp(7, 5, true);
+    XYMap rect(7, 5, false);
+    StaticXYMap<Serp> static_serp;
+    for (uint16_t y = 0; y < 5; ++y) {
+        for (uint16_t x = 0; x < 7; ++x) {
+            CHECK(static_serp(x, y) == serp.mapToIndex(x, y));
+            CHECK(StaticXYMap<Rect>::mapToIndex(x, y) == rect.mapToIndex(x, y));
+        }
+    }
+}
+
+TEST_CASE("tiled layout chains panels") {
+    // Two by two panels of 3x2, panel rows chained in a serpentine.
+    typedef TiledLayout<2, 2, LineByLineLayout<3, 2>> Wall;
+    StaticXYMap<Wall> xy;
+    CHECK(xy.kWidth == 6);
+    CHECK(xy.kHeight == 4);
+    CHECK(xy(0, 0) == 0);
+    CHECK(xy(2, 1) == 5);    // Last pixel of the first panel.
+    CHECK(xy(3, 0) == 6);    // First pixel of the second panel.
+    CHECK(xy(3, 2) == 12);   // Second panel row starts on the right.
+    CHECK(xy(0, 2) == 18);
+    CHECK(xy(5, 3) == 17);
+    // Every index is used exactly once.
+    bool seen[24] = {};
+    for (uint16_t y = 0; y < 4; ++y) {
+        for (uint16_t x = 0; x < 6; ++x) {
+            uint16_t i = xy(x, y);
+            REQUIRE(i < 24);
+            CHECK_FALSE(seen[i]);
+            seen[i] = true;
+        }
+    }
+}
+
+TEST_CASE("flash table backed XYMap") {
+    typedef TiledLayout<3, 2, SerpentineLayout<4, 4>, false> Wall;
+    XYMap map = StaticXYMap<Wall>::toXYMap(10);
+    CHECK(map.getType() == XYMap::kFlashLookUpTable);
+    CHECK(map.getWidth() == 12);
+    CHECK(map.getHeight() == 8);
+    const uint16_t *table = StaticXYMap<Wall>::table();
+    for (uint16_t y = 0; y < 8; ++y) {
+        for (uint16_t x = 0; x < 12; ++x) {
+            CHECK(table[y * 12 + x] == Wall::map(x, y));
+            CHECK(map(x, y) == Wall::map(x, y) + 10);
+        }
+    }
+    // Converting copies the flash table into RAM.
+    XYMap ram = StaticXYMap<Wall>::toXYMap();
+    ram.convertToLookUpTable();
+    CHECK(ram.getType() == XYMap::kLookUpTable);
+    CHECK(ram(11, 7) == Wall::map(11, 7));
+}
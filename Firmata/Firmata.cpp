@@ -266,6 +266,17 @@ void FirmataClass::parse(byte inputData)
     parser.parse(inputData);
 }
 
+/**
+ * Parse a block of data from the input stream. Sysex messages wholly within the block are
+ * handled in place, without copying them to the parser's buffer.
+ * @param buffer The data to be parsed. It may be modified by the parser.
+ * @param length The number of bytes of data.
+ */
+void FirmataClass::parse(byte * buffer, size_t length)
+{
+    parser.parse(buffer, length);
+}
+
 /**
  * @return Returns true if the parser is actively parsing data.
  */
@@ -291,6 +302,42 @@ void FirmataClass::sendAnalog(byte pin, int value)
   marshaller.sendAnalog(pin, value);
 }
 
+/**
+ * Send the values of several analog pins in one ANALOG_BATCH message, once the Firmata host
+ * application has enabled batching with an ANALOG_BATCH_ENABLE request.
+ * @param pinMask The analog pins to send the values of, bit n for pin n (pins 0 - 15).
+ * @param resolution The number of bits of each value (1 - 14).
+ * @param values The values of analog pins 0 - 15, indexed by pin.
+ */
+void FirmataClass::sendAnalogBatch(uint16_t pinMask, byte resolution, const uint16_t * values)
+{
+  marshaller.sendAnalogBatch(pinMask, resolution, values);
+}
+
+/**
+ * Reply to an ANALOG_BATCH request from the Firmata host application.
+ * @param enabled True if analog values will be sent with sendAnalogBatch().
+ */
+void FirmataClass::sendAnalogBatchState(boolean enabled)
+{
+  marshaller.sendAnalogBatchState(enabled);
+}
+
+/**
+ * Send a block of buffered samples in one SAMPLE_STREAM message (see SampleStreamFirmata).
+ * @param sequence The block sequence number (14 bits, wraps around).
+ * @param dropped The number of frames dropped since the previous block.
+ * @param resolution The number of bits of each sample (1 - 14).
+ * @param samplec The number of samples in samplev.
+ * @param samplev A pointer to the first part of the samples.
+ * @param wrapc The number of samples in wrapv, for ring buffers that wrap around.
+ * @param wrapv A pointer to the rest of the samples.
+ */
+void FirmataClass::sendSampleBlock(uint16_t sequence, uint16_t dropped, byte resolution, size_t samplec, const uint16_t * samplev, size_t wrapc, const uint16_t * wrapv)
+{
+  marshaller.sendSampleBlock(sequence, dropped, resolution, samplec, samplev, wrapc, wrapv);
+}
+
 /* (intentionally left out asterix here)
  * STUB - NOT IMPLEMENTED
  * Send a single digital pin value to the Firmata host application.
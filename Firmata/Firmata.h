@@ -79,10 +79,14 @@ class FirmataClass
     int available(void);
     void processInput(void);
     void parse(unsigned char value);
+    void parse(byte * buffer, size_t length);
     boolean isParsingMessage(void);
 
     /* serial send handling */
     void sendAnalog(byte pin, int value);
+    void sendAnalogBatch(uint16_t pinMask, byte resolution, const uint16_t * values);
+    void sendAnalogBatchState(boolean enabled);
+    void sendSampleBlock(uint16_t sequence, uint16_t dropped, byte resolution, size_t samplec, const uint16_t * samplev, size_t wrapc = 0, const uint16_t * wrapv = NULL);
     void sendDigital(byte pin, int value); // TODO implement this
     void sendDigitalPort(byte portNumber, int portData);
     void sendString(const char *string);
@@ -64,6 +64,8 @@ static const int I2C_REPLY =               0x77; // a reply to an I2C read reque
 static const int I2C_CONFIG =              0x78; // config I2C settings such as delay times and power pins
 static const int REPORT_FIRMWARE =         0x79; // report name and version of the firmware
 static const int EXTENDED_ANALOG =         0x6F; // analog write (PWM, Servo, etc) to any pin
+static const int ANALOG_BATCH =            0x66; // report all enabled analog pins in one message
+static const int SAMPLE_STREAM =           0x67; // timer driven sampling of analog pins, streamed in blocks
 static const int PIN_STATE_QUERY =         0x6D; // ask for a pin's current mode and value
 static const int PIN_STATE_RESPONSE =      0x6E; // reply with pin's current mode and value
 static const int CAPABILITY_QUERY =        0x6B; // ask for supported modes and resolution of all pins
@@ -75,6 +77,17 @@ static const int SCHEDULER_DATA =          0x7B; // send a createtask/deletetask
 static const int SYSEX_NON_REALTIME =      0x7E; // MIDI Reserved for non-realtime messages
 static const int SYSEX_REALTIME =          0x7F; // MIDI Reserved for realtime messages
 
+// ANALOG_BATCH subcommands
+static const int ANALOG_BATCH_DISABLE =    0x00; // back to one ANALOG_MESSAGE per pin (reply: batching disabled)
+static const int ANALOG_BATCH_ENABLE =     0x01; // request batched analog reports (reply: batching enabled)
+static const int ANALOG_BATCH_REPORT =     0x02; // pin mask, resolution and packed values of the reported pins
+
+// SAMPLE_STREAM subcommands
+static const int SAMPLE_STREAM_CONFIG =    0x00; // set (reply: actual) pins, rate and frames per block
+static const int SAMPLE_STREAM_START =     0x01; // start sampling, from block sequence number 0
+static const int SAMPLE_STREAM_STOP =      0x02; // stop sampling
+static const int SAMPLE_STREAM_DATA =      0x03; // sequence number, dropped frames, resolution and packed samples
+
 // pin modes
 static const int PIN_MODE_INPUT =          0x00; // same as INPUT defined in Arduino.h
 static const int PIN_MODE_OUTPUT =         0x01; // same as OUTPUT defined in Arduino.h
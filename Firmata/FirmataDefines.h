@@ -158,6 +158,16 @@
 #endif
 #define EXTENDED_ANALOG         firmata::EXTENDED_ANALOG // analog write (PWM, Servo, etc) to any pin
 
+#ifdef ANALOG_BATCH
+#undef ANALOG_BATCH
+#endif
+#define ANALOG_BATCH            firmata::ANALOG_BATCH // report all enabled analog pins in one message
+
+#ifdef SAMPLE_STREAM
+#undef SAMPLE_STREAM
+#endif
+#define SAMPLE_STREAM           firmata::SAMPLE_STREAM // timer driven sampling of analog pins, streamed in blocks
+
 #ifdef PIN_STATE_QUERY
 #undef PIN_STATE_QUERY
 #endif
@@ -275,6 +285,45 @@
 #endif
 #define PIN_MODE_IGNORE         firmata::PIN_MODE_IGNORE // pin configured to be ignored by digitalWrite and capabilityResponse
 
+// ANALOG_BATCH subcommands
+
+#ifdef ANALOG_BATCH_DISABLE
+#undef ANALOG_BATCH_DISABLE
+#endif
+#define ANALOG_BATCH_DISABLE    firmata::ANALOG_BATCH_DISABLE // back to one ANALOG_MESSAGE per pin
+
+#ifdef ANALOG_BATCH_ENABLE
+#undef ANALOG_BATCH_ENABLE
+#endif
+#define ANALOG_BATCH_ENABLE     firmata::ANALOG_BATCH_ENABLE // request batched analog reports
+
+#ifdef ANALOG_BATCH_REPORT
+#undef ANALOG_BATCH_REPORT
+#endif
+#define ANALOG_BATCH_REPORT     firmata::ANALOG_BATCH_REPORT // pin mask, resolution and packed values
+
+// SAMPLE_STREAM subcommands
+
+#ifdef SAMPLE_STREAM_CONFIG
+#undef SAMPLE_STREAM_CONFIG
+#endif
+#define SAMPLE_STREAM_CONFIG    firmata::SAMPLE_STREAM_CONFIG // set (reply: actual) pins, rate and frames per block
+
+#ifdef SAMPLE_STREAM_START
+#undef SAMPLE_STREAM_START
+#endif
+#define SAMPLE_STREAM_START     firmata::SAMPLE_STREAM_START // start sampling, from block sequence number 0
+
+#ifdef SAMPLE_STREAM_STOP
+#undef SAMPLE_STREAM_STOP
+#endif
+#define SAMPLE_STREAM_STOP      firmata::SAMPLE_STREAM_STOP // stop sampling
+
+#ifdef SAMPLE_STREAM_DATA
+#undef SAMPLE_STREAM_DATA
+#endif
+#define SAMPLE_STREAM_DATA      firmata::SAMPLE_STREAM_DATA // sequence number, dropped frames, resolution and packed samples
+
 #ifdef TOTAL_PIN_MODES
 #undef TOTAL_PIN_MODES
 #endif
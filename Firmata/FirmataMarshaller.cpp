@@ -31,6 +31,53 @@ using namespace firmata;
 //* Support Functions
 //******************************************************************************
 
+namespace {
+
+/**
+ * Collects the bytes of a message, so they reach the stream in a few block writes
+ * (one packet for buffered transports such as WiFi, Ethernet and BLE streams), and packs
+ * values of any number of bits into 7-bit data bytes, least significant bits first.
+ */
+class PackedStreamWriter
+{
+  public:
+    PackedStreamWriter(Stream * stream) : stream(stream), count(0), bit_cache(0), cached_bits(0) {}
+
+    void write(uint8_t byte) {
+      buffer[count++] = byte;
+      if ( sizeof(buffer) == count ) { flush(); }
+    }
+
+    void pack(uint16_t value, uint8_t bits) {
+      bit_cache |= ((uint32_t)(value & ((1 << bits) - 1)) << cached_bits);
+      cached_bits += bits;
+      for ( ; cached_bits >= 7 ; cached_bits -= 7 ) {
+        write(bit_cache & 0x7F);
+        bit_cache >>= 7;
+      }
+    }
+
+    void endPacking(void) {
+      if ( cached_bits ) { write(bit_cache & 0x7F); }
+      bit_cache = 0;
+      cached_bits = 0;
+    }
+
+    void flush(void) {
+      if ( count ) { stream->write(buffer, count); }
+      count = 0;
+    }
+
+  private:
+    Stream * stream;
+    uint8_t buffer[32];
+    size_t count;
+    uint32_t bit_cache;
+    uint8_t cached_bits;
+};
+
+} // namespace
+
 /**
  * Request or halt a stream of analog readings from the Firmata host application. The range of pins is
  * limited to [0..15] when using the REPORT_ANALOG. The maximum result of the REPORT_ANALOG is limited to 14 bits
@@ -49,6 +96,22 @@ const
   FirmataStream->write(stream_enable);
 }
 
+/**
+ * Request or halt batched analog reports from the Firmata host application. A board that
+ * supports them replies with ANALOG_BATCH_ENABLE or ANALOG_BATCH_DISABLE (see sendAnalogBatchState);
+ * one that does not ignores the request and keeps sending ANALOG_MESSAGE reports.
+ * @param batch_enable A zero value will disable batching, a non-zero will enable it
+ */
+void FirmataMarshaller::reportAnalogBatch(bool batch_enable)
+const
+{
+  if ( (Stream *)NULL == FirmataStream ) { return; }
+  FirmataStream->write(START_SYSEX);
+  FirmataStream->write(ANALOG_BATCH);
+  FirmataStream->write(batch_enable ? ANALOG_BATCH_ENABLE : ANALOG_BATCH_DISABLE);
+  FirmataStream->write(END_SYSEX);
+}
+
 /**
  * Request or halt an 8-bit port stream from the Firmata host application (protocol v2 and later).
  * Send 14-bits in a single digital message (protocol v1).
@@ -181,6 +244,26 @@ const
   FirmataStream->write(REPORT_VERSION);
 }
 
+/**
+ * Ask the target to go back to sending one ANALOG_MESSAGE per pin per sampling interval.
+ */
+void FirmataMarshaller::reportAnalogBatchDisable(void)
+const
+{
+  reportAnalogBatch(false);
+}
+
+/**
+ * Ask the target to send the values of all reported analog pins in one ANALOG_BATCH_REPORT
+ * message per sampling interval, instead of one ANALOG_MESSAGE per pin. Batching is only in
+ * effect once the target has replied with ANALOG_BATCH_ENABLE.
+ */
+void FirmataMarshaller::reportAnalogBatchEnable(void)
+const
+{
+  reportAnalogBatch(true);
+}
+
 /**
  * Halt the stream of analog readings from the Firmata host application. The range of pins is
  * limited to [0..15] when using the REPORT_ANALOG. The maximum result of the REPORT_ANALOG is limited to 14 bits
@@ -254,6 +337,94 @@ const
   }
 }
 
+/**
+ * Send the values of several analog pins to the Firmata host application in one ANALOG_BATCH
+ * sysex message: ANALOG_BATCH_REPORT, the pin mask as three 7-bit bytes (pins 0-6, 7-13 and 14-15),
+ * the resolution, then the value of each pin in the mask in ascending pin order, packed at
+ * resolution bits per value into 7-bit bytes, least significant bits first. For 6 pins at
+ * 10-bit resolution this is 17 bytes instead of 18 for separate ANALOG_MESSAGEs, and for 16 pins
+ * 31 instead of 48.
+ * @param pinMask The analog pins to send the values of, bit n for pin n.
+ * @param resolution The number of bits of each value (1 - 14).
+ * @param values The values of analog pins 0 - 15, indexed by pin. Only the pins in pinMask are read.
+ * @note Only send this after the host has enabled batching (see reportAnalogBatchEnable).
+ */
+void FirmataMarshaller::sendAnalogBatch(uint16_t pinMask, uint8_t resolution, const uint16_t * values)
+const
+{
+  if ( (Stream *)NULL == FirmataStream ) { return; }
+  if ( resolution > 14 ) { resolution = 14; }
+  PackedStreamWriter writer(FirmataStream);
+
+  writer.write(START_SYSEX);
+  writer.write(ANALOG_BATCH);
+  writer.write(ANALOG_BATCH_REPORT);
+  writer.write(pinMask & 0x7F);
+  writer.write((pinMask >> 7) & 0x7F);
+  writer.write((pinMask >> 14) & 0x03);
+  writer.write(resolution);
+  for (uint8_t pin = 0 ; pin < 16 ; ++pin) {
+    if ( pinMask & (1 << pin) ) { writer.pack(values[pin], resolution); }
+  }
+  writer.endPacking();
+  writer.write(END_SYSEX);
+  writer.flush();
+}
+
+/**
+ * Reply to an ANALOG_BATCH request from the Firmata host application, confirming whether
+ * analog values will be sent with sendAnalogBatch or as separate ANALOG_MESSAGEs.
+ * @param enabled True if batched reports will be sent.
+ */
+void FirmataMarshaller::sendAnalogBatchState(bool enabled)
+const
+{
+  reportAnalogBatch(enabled);
+}
+
+/**
+ * Send a block of buffered samples to the Firmata host application in one SAMPLE_STREAM sysex
+ * message: SAMPLE_STREAM_DATA, the block sequence number and the number of frames dropped since
+ * the previous block (each as two 7-bit bytes, LSB first), the resolution, then the samples packed
+ * at resolution bits per sample into 7-bit bytes, least significant bits first. The samples are
+ * written frame by frame, with one sample per streamed pin in ascending pin order in each frame.
+ * The samples may come from a ring buffer in two parts: samplev, then wrapv.
+ * @param sequence The block sequence number (14 bits, wraps around).
+ * @param dropped The number of frames dropped since the previous block (saturates at 16383).
+ * @param resolution The number of bits of each sample (1 - 14).
+ * @param samplec The number of samples in samplev.
+ * @param samplev A pointer to the first part of the samples.
+ * @param wrapc The number of samples in wrapv.
+ * @param wrapv A pointer to the rest of the samples.
+ */
+void FirmataMarshaller::sendSampleBlock(uint16_t sequence, uint16_t dropped, uint8_t resolution, size_t samplec, const uint16_t * samplev, size_t wrapc, const uint16_t * wrapv)
+const
+{
+  if ( (Stream *)NULL == FirmataStream ) { return; }
+  if ( resolution > 14 ) { resolution = 14; }
+  if ( dropped > 0x3FFF ) { dropped = 0x3FFF; }
+  PackedStreamWriter writer(FirmataStream);
+  size_t i;
+
+  writer.write(START_SYSEX);
+  writer.write(SAMPLE_STREAM);
+  writer.write(SAMPLE_STREAM_DATA);
+  writer.write(sequence & 0x7F);
+  writer.write((sequence >> 7) & 0x7F);
+  writer.write(dropped & 0x7F);
+  writer.write((dropped >> 7) & 0x7F);
+  writer.write(resolution);
+  for (i = 0 ; i < samplec ; ++i) {
+    writer.pack(samplev[i], resolution);
+  }
+  for (i = 0 ; i < wrapc ; ++i) {
+    writer.pack(wrapv[i], resolution);
+  }
+  writer.endPacking();
+  writer.write(END_SYSEX);
+  writer.flush();
+}
+
 /**
  * Send an analog mapping query to the Firmata host application. The resulting sysex message will
  * have an ANALOG_MAPPING_RESPONSE command byte, followed by a list of pins [0-n]; where each
@@ -41,11 +41,15 @@ class FirmataMarshaller
     /* serial send handling */
     void queryFirmwareVersion(void) const;
     void queryVersion(void) const;
+    void reportAnalogBatchDisable(void) const;
+    void reportAnalogBatchEnable(void) const;
     void reportAnalogDisable(uint8_t pin) const;
     void reportAnalogEnable(uint8_t pin) const;
     void reportDigitalPortDisable(uint8_t portNumber) const;
     void reportDigitalPortEnable(uint8_t portNumber) const;
     void sendAnalog(uint8_t pin, uint16_t value) const;
+    void sendAnalogBatch(uint16_t pinMask, uint8_t resolution, const uint16_t * values) const;
+    void sendAnalogBatchState(bool enabled) const;
     void sendAnalogMappingQuery(void) const;
     void sendCapabilityQuery(void) const;
     void sendDigital(uint8_t pin, uint8_t value) const;
@@ -54,6 +58,7 @@ class FirmataMarshaller
     void sendVersion(uint8_t major, uint8_t minor) const;
     void sendPinMode(uint8_t pin, uint8_t config) const;
     void sendPinStateQuery(uint8_t pin) const;
+    void sendSampleBlock(uint16_t sequence, uint16_t dropped, uint8_t resolution, size_t samplec, const uint16_t * samplev, size_t wrapc = 0, const uint16_t * wrapv = (const uint16_t *)NULL) const;
     void sendString(const char *string) const;
     void sendSysex(uint8_t command, size_t bytec, uint8_t *bytev) const;
     void setSamplingInterval(uint16_t interval_ms) const;
@@ -62,6 +67,7 @@ class FirmataMarshaller
   private:
     /* utility methods */
     void reportAnalog(uint8_t pin, bool stream_enable) const;
+    void reportAnalogBatch(bool batch_enable) const;
     void reportDigitalPort(uint8_t portNumber, bool stream_enable) const;
     void sendExtendedAnalog(uint8_t pin, size_t bytec, uint8_t * bytev) const;
     void encodeByteStream (size_t bytec, uint8_t * bytev, size_t max_bytes = 0) const;
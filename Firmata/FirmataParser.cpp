@@ -17,6 +17,12 @@
 
 #include "FirmataParser.h"
 
+#if defined(__cplusplus) && !defined(ARDUINO)
+  #include <cstring>
+#else
+  #include <string.h>
+#endif
+
 #include "FirmataConstants.h"
 
 using namespace firmata;
@@ -87,7 +93,7 @@ void FirmataParser::parse(uint8_t inputData)
       //stop sysex byte
       parsingSysex = false;
       //fire off handler function
-      processSysexMessage();
+      processSysexMessage(dataBuffer, sysexBytesRead);
     } else {
       //normal data byte - add to buffer
       bufferDataAtPosition(inputData, sysexBytesRead);
@@ -170,6 +176,37 @@ void FirmataParser::parse(uint8_t inputData)
   }
 }
 
+/**
+ * Parse a block of data from the input stream, such as the bytes available from a serial port
+ * or a BLE packet. Sysex messages that are wholly contained in the block are passed to their
+ * callbacks in place, without being copied to the data buffer, so they are also not limited to
+ * its size. Everything else is parsed a byte at a time, as by parse(uint8_t).
+ * @param buffer The data to be parsed.
+ * @param length The number of bytes of data.
+ * @note The buffer may be modified: STRING_DATA and REPORT_FIRMWARE are decoded in place, and
+ *       sysex callbacks are given a pointer into the buffer.
+ */
+void FirmataParser::parse(uint8_t * buffer, size_t length)
+{
+  size_t i = 0;
+
+  while (i < length) {
+    if (!parsingSysex && (START_SYSEX == buffer[i])) {
+      uint8_t * end = (uint8_t *)memchr(&buffer[i + 1], END_SYSEX, (length - i - 1));
+      if (end) {
+        uint8_t * sysexData = &buffer[i + 1];
+        const size_t sysexBytes = (end - sysexData);
+        if (sysexBytes) {
+          processSysexMessage(sysexData, sysexBytes);
+        }
+        i = (end - buffer) + 1;
+        continue;
+      }
+    }
+    parse(buffer[i++]);
+  }
+}
+
 /**
  * @return Returns true if the parser is actively parsing data.
  */
@@ -422,37 +459,45 @@ size_t FirmataParser::decodeByteStream(size_t bytec, uint8_t * bytev) {
 /**
  * Process incoming sysex messages. Handles REPORT_FIRMWARE and STRING_DATA internally.
  * Calls callback function for STRING_DATA and all other sysex messages.
+ * @param sysexData The sysex message, starting with the command byte. Either the data buffer or,
+ *        for a message parsed in place, a buffer with room for a terminating byte (END_SYSEX)
+ *        after the message.
+ * @param sysexBytes The length of the message, including the command byte.
  * @private
  */
-void FirmataParser::processSysexMessage(void)
+void FirmataParser::processSysexMessage(uint8_t * sysexData, size_t sysexBytes)
 {
-  switch (dataBuffer[0]) { //first byte in buffer is command
+  const bool inPlace = (sysexData != dataBuffer);
+
+  switch (sysexData[0]) { //first byte in buffer is command
     case REPORT_FIRMWARE:
       if (currentReportFirmwareCallback) {
         const size_t major_version_offset = 1;
         const size_t minor_version_offset = 2;
         const size_t string_offset = 3;
         // Test for malformed REPORT_FIRMWARE message (used to query firmware prior to Firmata v3.0.0)
-        if ( 3 > sysexBytesRead ) {
+        if ( 3 > sysexBytes ) {
           (*currentReportFirmwareCallback)(currentReportFirmwareCallbackContext, 0, 0, (const char *)NULL);
         } else {
-          const size_t end_of_string = (string_offset + decodeByteStream((sysexBytesRead - string_offset), &dataBuffer[string_offset]));
-          bufferDataAtPosition('\0', end_of_string); // NULL terminate the string
-          (*currentReportFirmwareCallback)(currentReportFirmwareCallbackContext, (size_t)dataBuffer[major_version_offset], (size_t)dataBuffer[minor_version_offset], (const char *)&dataBuffer[string_offset]);
+          const size_t end_of_string = (string_offset + decodeByteStream((sysexBytes - string_offset), &sysexData[string_offset]));
+          // NULL terminate the string
+          if ( inPlace ) { sysexData[end_of_string] = '\0'; } else { bufferDataAtPosition('\0', end_of_string); }
+          (*currentReportFirmwareCallback)(currentReportFirmwareCallbackContext, (size_t)sysexData[major_version_offset], (size_t)sysexData[minor_version_offset], (const char *)&sysexData[string_offset]);
         }
       }
       break;
     case STRING_DATA:
       if (currentStringCallback) {
         const size_t string_offset = 1;
-        const size_t end_of_string = (string_offset + decodeByteStream((sysexBytesRead - string_offset), &dataBuffer[string_offset]));
-        bufferDataAtPosition('\0', end_of_string); // NULL terminate the string
-        (*currentStringCallback)(currentStringCallbackContext, (const char *)&dataBuffer[string_offset]);
+        const size_t end_of_string = (string_offset + decodeByteStream((sysexBytes - string_offset), &sysexData[string_offset]));
+        // NULL terminate the string
+        if ( inPlace ) { sysexData[end_of_string] = '\0'; } else { bufferDataAtPosition('\0', end_of_string); }
+        (*currentStringCallback)(currentStringCallbackContext, (const char *)&sysexData[string_offset]);
       }
       break;
     default:
       if (currentSysexCallback)
-        (*currentSysexCallback)(currentSysexCallbackContext, dataBuffer[0], sysexBytesRead - 1, dataBuffer + 1);
+        (*currentSysexCallback)(currentSysexCallbackContext, sysexData[0], sysexBytes - 1, sysexData + 1);
   }
 }
 
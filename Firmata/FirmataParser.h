@@ -39,6 +39,7 @@ class FirmataParser
 
     /* serial receive handling */
     void parse(uint8_t value);
+    void parse(uint8_t * buffer, size_t length);
     bool isParsingMessage(void) const;
     int setDataBufferOfSize(uint8_t * dataBuffer, size_t dataBufferSize);
 
@@ -96,7 +97,7 @@ class FirmataParser
     /* private methods ------------------------------ */
     bool bufferDataAtPosition(const uint8_t data, const size_t pos);
     size_t decodeByteStream(size_t bytec, uint8_t * bytev);
-    void processSysexMessage(void);
+    void processSysexMessage(uint8_t * sysexData, size_t sysexBytes);
     void systemReset(void);
 };
 
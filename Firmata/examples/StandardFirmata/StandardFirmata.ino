@@ -27,6 +27,13 @@
 #include <Wire.h>
 #include <Firmata.h>
 
+/*
+ * Uncomment the following include to enable timer driven, high rate sampling of analog pins,
+ * streamed in blocks (SAMPLE_STREAM). On AVR boards it uses Timer2, so PWM on the Timer2 pins
+ * and tone() do not work while a stream is running.
+ */
+//#include "utility/SampleStreamFirmata.h"
+
 #define I2C_WRITE                   B00000000
 #define I2C_READ                    B00001000
 #define I2C_READ_CONTINUOUSLY       B00010000
@@ -51,8 +58,14 @@
 SerialFirmata serialFeature;
 #endif
 
+#ifdef FIRMATA_SAMPLE_STREAM_FEATURE
+SampleStreamFirmata sampleStreamFeature;
+#endif
+
 /* analog inputs */
 int analogInputsToReport = 0; // bitwise array to store pin reporting
+boolean analogBatch = false;  // send all analog values in one message, if the host asked for it
+uint16_t analogValues[16];    // values for the batched message, indexed by analog pin
 
 /* digital input ports */
 byte reportPINs[TOTAL_PORTS];       // 1 = report this port, 0 = silence
@@ -622,6 +635,17 @@ void sysexCallback(byte command, byte argc, byte *argv)
         //Firmata.sendString("Not enough data");
       }
       break;
+    case ANALOG_BATCH:
+      if (argc > 0 && (argv[0] == ANALOG_BATCH_ENABLE || argv[0] == ANALOG_BATCH_DISABLE)) {
+        analogBatch = (argv[0] == ANALOG_BATCH_ENABLE);
+        Firmata.sendAnalogBatchState(analogBatch);
+      }
+      break;
+    case SAMPLE_STREAM:
+#ifdef FIRMATA_SAMPLE_STREAM_FEATURE
+      sampleStreamFeature.handleSysex(command, argc, argv);
+#endif
+      break;
     case EXTENDED_ANALOG:
       if (argc > 1) {
         int val = argv[1];
@@ -712,6 +736,10 @@ void systemResetCallback()
   serialFeature.reset();
 #endif
 
+#ifdef FIRMATA_SAMPLE_STREAM_FEATURE
+  sampleStreamFeature.reset();
+#endif
+
   if (isI2CEnabled) {
     disableI2CPins();
   }
@@ -737,6 +765,7 @@ void systemResetCallback()
   }
   // by default, do not report any analog inputs
   analogInputsToReport = 0;
+  analogBatch = false;
 
   detachedServoCount = 0;
   servoCount = 0;
@@ -786,6 +815,7 @@ void setup()
 void loop()
 {
   byte pin, analogPin;
+  uint16_t analogBatchPins = 0;
 
   /* DIGITALREAD - as fast as possible, check for changes and output them to the
    * FTDI buffer using Serial.print()  */
@@ -803,13 +833,25 @@ void loop()
     previousMillis += samplingInterval;
     /* ANALOGREAD - do all analogReads() at the configured sampling interval */
     for (pin = 0; pin < TOTAL_PINS; pin++) {
+#ifdef FIRMATA_SAMPLE_STREAM_FEATURE
+      // the stream owns the ADC while it runs
+      if (sampleStreamFeature.isRunning()) break;
+#endif
       if (IS_PIN_ANALOG(pin) && Firmata.getPinMode(pin) == PIN_MODE_ANALOG) {
         analogPin = PIN_TO_ANALOG(pin);
         if (analogInputsToReport & (1 << analogPin)) {
-          Firmata.sendAnalog(analogPin, analogRead(analogPin));
+          if (analogBatch && analogPin < 16) {
+            analogValues[analogPin] = analogRead(analogPin);
+            analogBatchPins |= (1 << analogPin);
+          } else {
+            Firmata.sendAnalog(analogPin, analogRead(analogPin));
+          }
         }
       }
     }
+    if (analogBatchPins) {
+      Firmata.sendAnalogBatch(analogBatchPins, 10, analogValues); // 10 = 10-bit resolution
+    }
     // report i2c data for all device with read continuous mode enabled
     if (queryIndex > -1) {
       for (byte i = 0; i < queryIndex + 1; i++) {
@@ -821,4 +863,8 @@ void loop()
 #ifdef FIRMATA_SERIAL_FEATURE
   serialFeature.update();
 #endif
+
+#ifdef FIRMATA_SAMPLE_STREAM_FEATURE
+  sampleStreamFeature.update();
+#endif
 }
@@ -66,6 +66,8 @@ SerialFirmata serialFeature;
 
 /* analog inputs */
 int analogInputsToReport = 0; // bitwise array to store pin reporting
+boolean analogBatch = false;  // send all analog values in one message, if the host asked for it
+uint16_t analogValues[16];    // values for the batched message, indexed by analog pin
 
 /* digital input ports */
 byte reportPINs[TOTAL_PORTS];       // 1 = report this port, 0 = silence
@@ -635,6 +637,12 @@ void sysexCallback(byte command, byte argc, byte *argv)
         //Firmata.sendString("Not enough data");
       }
       break;
+    case ANALOG_BATCH:
+      if (argc > 0 && (argv[0] == ANALOG_BATCH_ENABLE || argv[0] == ANALOG_BATCH_DISABLE)) {
+        analogBatch = (argv[0] == ANALOG_BATCH_ENABLE);
+        Firmata.sendAnalogBatchState(analogBatch);
+      }
+      break;
     case EXTENDED_ANALOG:
       if (argc > 1) {
         int val = argv[1];
@@ -747,6 +755,7 @@ void systemResetCallback()
   }
   // by default, do not report any analog inputs
   analogInputsToReport = 0;
+  analogBatch = false;
 
   detachedServoCount = 0;
   servoCount = 0;
@@ -800,6 +809,7 @@ void setup()
 void loop()
 {
   byte pin, analogPin;
+  uint16_t analogBatchPins = 0;
 
   // do not process data if no BLE connection is established
   // poll will send the TX buffer at the specified flush interval or when the buffer is full
@@ -822,10 +832,18 @@ void loop()
       if (IS_PIN_ANALOG(pin) && Firmata.getPinMode(pin) == PIN_MODE_ANALOG) {
         analogPin = PIN_TO_ANALOG(pin);
         if (analogInputsToReport & (1 << analogPin)) {
-          Firmata.sendAnalog(analogPin, analogRead(analogPin));
+          if (analogBatch && analogPin < 16) {
+            analogValues[analogPin] = analogRead(analogPin);
+            analogBatchPins |= (1 << analogPin);
+          } else {
+            Firmata.sendAnalog(analogPin, analogRead(analogPin));
+          }
         }
       }
     }
+    if (analogBatchPins) {
+      Firmata.sendAnalogBatch(analogBatchPins, 10, analogValues); // 10 = 10-bit resolution
+    }
     // report i2c data for all device with read continuous mode enabled
     if (queryIndex > -1) {
       for (byte i = 0; i < queryIndex + 1; i++) {
@@ -45,6 +45,7 @@ class EthernetClientStream : public Stream
     int peek();
     void flush();
     size_t write(uint8_t);
+    size_t write(const uint8_t *buffer, size_t size);
     void maintain(IPAddress localip);
     void attach(hostConnectionCallbackFunction newFunction);
 
@@ -108,6 +109,13 @@ EthernetClientStream::write(uint8_t c)
   return maintain() ? client.write(c) : 0;
 }
 
+size_t
+EthernetClientStream::write(const uint8_t *buffer, size_t size)
+{
+  // pass blocks through, so a sysex message goes out in one packet instead of one per byte
+  return maintain() ? client.write(buffer, size) : 0;
+}
+
 void
 EthernetClientStream::maintain(IPAddress localip)
 {
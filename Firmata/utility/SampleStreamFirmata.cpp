@@ -0,0 +1,257 @@
+/*
+  SampleStreamFirmata.cpp
+  Copyright (C) 2026 Firmata Developers.  All rights reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  See file LICENSE.txt for further informations on licensing terms.
+
+  Last updated October 15th, 2026
+*/
+
+// the interrupt handler is only defined in the sketch that includes SampleStreamFirmata.h
+#define SAMPLE_STREAM_NO_ISR
+#include "SampleStreamFirmata.h"
+
+#if (SAMPLE_STREAM_BUFFER_SIZE & (SAMPLE_STREAM_BUFFER_SIZE - 1)) != 0
+#error "SAMPLE_STREAM_BUFFER_SIZE must be a power of 2"
+#endif
+
+#ifdef SAMPLE_STREAM_TIMER2
+// Timer2 prescalers, indexed by clock select bits - 1
+static const uint16_t timer2Prescalers[] = { 1, 8, 32, 64, 128, 256, 1024 };
+#endif
+
+SampleStreamFirmata *SampleStreamFirmata::instance = NULL;
+
+SampleStreamFirmata::SampleStreamFirmata()
+{
+  instance = this;
+  head = 0;
+  tail = 0;
+  dropped = 0;
+  pinMask = 0;
+  pinCount = 0;
+  blockFrames = 0;
+  rate = 0;
+  sequence = 0;
+  running = false;
+}
+
+boolean SampleStreamFirmata::handlePinMode(byte pin, int mode)
+{
+  // streamed pins use PIN_MODE_ANALOG
+  return false;
+}
+
+void SampleStreamFirmata::handleCapability(byte pin)
+{
+}
+
+boolean SampleStreamFirmata::handleSysex(byte command, byte argc, byte *argv)
+{
+  if (command != SAMPLE_STREAM || argc < 1) {
+    return false;
+  }
+  byte reply;
+  switch (argv[0]) {
+    case SAMPLE_STREAM_CONFIG:
+      if (argc < 8) {
+        configure(0, 0, 0);
+      } else {
+        configure(argv[1] | (argv[2] << 7) | ((uint16_t)(argv[3] & 0x03) << 14),
+                  argv[4] | ((uint32_t)argv[5] << 7) | ((uint32_t)argv[6] << 14),
+                  argv[7]);
+      }
+      sendConfig();
+      break;
+    case SAMPLE_STREAM_START:
+      if (pinMask) {
+        start();
+      }
+      reply = running ? SAMPLE_STREAM_START : SAMPLE_STREAM_STOP;
+      Firmata.sendSysex(SAMPLE_STREAM, 1, &reply);
+      break;
+    case SAMPLE_STREAM_STOP:
+      stop();
+      reply = SAMPLE_STREAM_STOP;
+      Firmata.sendSysex(SAMPLE_STREAM, 1, &reply);
+      break;
+  }
+  return true;
+}
+
+void SampleStreamFirmata::reset()
+{
+  stop();
+  pinMask = 0;
+  pinCount = 0;
+  blockFrames = 0;
+  rate = 0;
+}
+
+void SampleStreamFirmata::configure(uint16_t mask, uint32_t requestedRate, byte frames)
+{
+  stop();
+  pinMask = 0;
+  pinCount = 0;
+  for (byte pin = 0; pin < 16; pin++) {
+    if (mask & (1 << pin)) {
+      if (pin >= TOTAL_ANALOG_PINS) {
+        return;
+      }
+      pinCount++;
+    }
+  }
+  // at least two blocks fit in the ring buffer, so one can be sent while the next is sampled
+  byte maxFrames = (SAMPLE_STREAM_BUFFER_SIZE / 2) / (pinCount ? pinCount : 1);
+  if (pinCount == 0 || maxFrames == 0 || requestedRate == 0) {
+    pinCount = 0;
+    return;
+  }
+  if (requestedRate > SAMPLE_STREAM_MAX_RATE) requestedRate = SAMPLE_STREAM_MAX_RATE;
+  if (frames == 0) frames = 1;
+  if (frames > maxFrames) frames = maxFrames;
+  pinMask = mask;
+  blockFrames = frames;
+
+#ifdef SAMPLE_STREAM_TIMER2
+  // the smallest prescaler that gets the compare value into 8 bits gives the closest rate
+  byte cs;
+  uint32_t ticks = 256;
+  for (cs = 1; cs <= 7; cs++) {
+    ticks = (F_CPU / timer2Prescalers[cs - 1] + requestedRate / 2) / requestedRate;
+    if (ticks <= 256) break;
+  }
+  if (cs > 7) {
+    cs = 7;
+    ticks = 256;
+  }
+  if (ticks == 0) ticks = 1;
+  timerClockSelect = cs;
+  timerCompare = ticks - 1;
+  rate = F_CPU / ((uint32_t)timer2Prescalers[cs - 1] * ticks);
+#else
+  period = 1000000UL / requestedRate;
+  rate = 1000000UL / period;
+#endif
+}
+
+void SampleStreamFirmata::sendConfig()
+{
+  byte bytes[9];
+  bytes[0] = SAMPLE_STREAM_CONFIG;
+  bytes[1] = pinMask & 0x7F;
+  bytes[2] = (pinMask >> 7) & 0x7F;
+  bytes[3] = (pinMask >> 14) & 0x03;
+  bytes[4] = rate & 0x7F;
+  bytes[5] = (rate >> 7) & 0x7F;
+  bytes[6] = (rate >> 14) & 0x7F;
+  bytes[7] = blockFrames;
+  bytes[8] = SAMPLE_STREAM_RESOLUTION;
+  Firmata.sendSysex(SAMPLE_STREAM, 9, bytes);
+}
+
+void SampleStreamFirmata::start()
+{
+  stop();
+  head = 0;
+  tail = 0;
+  dropped = 0;
+  sequence = 0;
+  running = true;
+#ifdef SAMPLE_STREAM_TIMER2
+  noInterrupts();
+  TIMSK2 &= ~_BV(OCIE2A);
+  TCCR2A = _BV(WGM21); // CTC mode, TOP = OCR2A
+  TCCR2B = timerClockSelect;
+  OCR2A = timerCompare;
+  TCNT2 = 0;
+  TIFR2 = _BV(OCF2A);
+  TIMSK2 |= _BV(OCIE2A);
+  interrupts();
+#else
+  nextSample = micros();
+#endif
+}
+
+void SampleStreamFirmata::stop()
+{
+#ifdef SAMPLE_STREAM_TIMER2
+  if (running) {
+    // restore the Arduino defaults, for PWM on the Timer2 pins
+    noInterrupts();
+    TIMSK2 &= ~_BV(OCIE2A);
+    TCCR2A = _BV(WGM20);
+    TCCR2B = _BV(CS22);
+    interrupts();
+  }
+#endif
+  running = false;
+}
+
+void SampleStreamFirmata::sample()
+{
+  sample_index_t h = head;
+  if ((sample_index_t)(h - tail) > SAMPLE_STREAM_BUFFER_SIZE - pinCount) {
+    // the host is not keeping up, drop the whole frame
+    if (dropped != 0xFFFF) dropped++;
+    return;
+  }
+  for (byte pin = 0; pin < 16; pin++) {
+    if (pinMask & (1 << pin)) {
+      samples[h++ & (SAMPLE_STREAM_BUFFER_SIZE - 1)] = analogRead(pin);
+    }
+  }
+  head = h;
+}
+
+SampleStreamFirmata::sample_index_t SampleStreamFirmata::buffered()
+{
+  noInterrupts();
+  sample_index_t count = head - tail;
+  interrupts();
+  return count;
+}
+
+void SampleStreamFirmata::update()
+{
+  if (!running) {
+    return;
+  }
+
+#ifndef SAMPLE_STREAM_TIMER2
+  unsigned long late = micros() - nextSample;
+  if ((long)late >= 0) {
+    // if the loop was held up for a long time, count the missed frames instead of catching up
+    unsigned long missed = late / period;
+    if (missed > 4) {
+      dropped = (dropped + missed > 0xFFFF) ? 0xFFFF : dropped + missed;
+      nextSample += missed * period;
+    }
+    while ((long)(micros() - nextSample) >= 0) {
+      sample();
+      nextSample += period;
+    }
+  }
+#endif
+
+  const sample_index_t blockSamples = blockFrames * pinCount;
+  while (buffered() >= blockSamples) {
+    noInterrupts();
+    uint16_t lost = dropped;
+    dropped = 0;
+    interrupts();
+
+    sample_index_t first = tail & (SAMPLE_STREAM_BUFFER_SIZE - 1);
+    size_t firstCount = SAMPLE_STREAM_BUFFER_SIZE - first;
+    if (firstCount > blockSamples) firstCount = blockSamples;
+    Firmata.sendSampleBlock(sequence, lost, SAMPLE_STREAM_RESOLUTION, firstCount, &samples[first],
+                            blockSamples - firstCount, samples);
+    sequence = (sequence + 1) & 0x3FFF;
+    tail += blockSamples;
+  }
+}
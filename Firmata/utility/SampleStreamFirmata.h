@@ -0,0 +1,114 @@
+/*
+  SampleStreamFirmata.h
+  Copyright (C) 2026 Firmata Developers.  All rights reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  See file LICENSE.txt for further informations on licensing terms.
+
+  High rate sampling of analog pins into a ring buffer, streamed to the host in
+  SAMPLE_STREAM_DATA blocks with sequence numbers and a count of dropped frames.
+
+  The host sends SAMPLE_STREAM_CONFIG with the analog pin mask, the sample rate in Hz
+  and the number of frames (one sample of each pin) per block, then SAMPLE_STREAM_START
+  and SAMPLE_STREAM_STOP. The board replies to SAMPLE_STREAM_CONFIG with the rate it
+  can actually run at, or a pin mask of 0 if the configuration is not usable.
+
+  - On AVR boards the samples are taken in the Timer2 compare interrupt, so the sample
+    interval does not depend on the main loop. While streaming, PWM on the Timer2 pins
+    (3 and 11 on an Uno) and tone() do not work.
+  - On other boards the samples are taken in update(), paced by micros(), so the main
+    loop has to run at least as fast as the sample rate to avoid dropped frames.
+
+  The achievable rate is limited by the transport: at 57600 baud, about 5000 10-bit
+  samples per second.
+
+  Last updated October 15th, 2026
+*/
+
+#ifndef SampleStreamFirmata_h
+#define SampleStreamFirmata_h
+
+#include <Firmata.h>
+#include "FirmataFeature.h"
+
+#define FIRMATA_SAMPLE_STREAM_FEATURE
+
+#if defined(__AVR__) && defined(OCR2A) && defined(TIMER2_COMPA_vect)
+#define SAMPLE_STREAM_TIMER2
+#endif
+
+// number of samples in the ring buffer, must be a power of 2
+#ifndef SAMPLE_STREAM_BUFFER_SIZE
+#if defined(__AVR__)
+#define SAMPLE_STREAM_BUFFER_SIZE   64
+#else
+#define SAMPLE_STREAM_BUFFER_SIZE   512
+#endif
+#endif
+
+#define SAMPLE_STREAM_MAX_RATE      10000 // [Hz]
+#define SAMPLE_STREAM_RESOLUTION    10    // bits per sample
+
+class SampleStreamFirmata: public FirmataFeature
+{
+  public:
+    SampleStreamFirmata();
+    boolean handlePinMode(byte pin, int mode);
+    void handleCapability(byte pin);
+    boolean handleSysex(byte command, byte argc, byte* argv);
+    void update();
+    void reset();
+    boolean isRunning() { return running; }
+
+    // take one frame, called from the timer interrupt
+    void sample();
+
+    static SampleStreamFirmata *instance;
+
+  private:
+    // the indexes are free running, and the ring buffer size divides their range
+#if SAMPLE_STREAM_BUFFER_SIZE <= 128
+    typedef uint8_t sample_index_t;
+#else
+    typedef uint16_t sample_index_t;
+#endif
+
+    uint16_t samples[SAMPLE_STREAM_BUFFER_SIZE];
+    volatile sample_index_t head; // written by sample()
+    volatile sample_index_t tail; // written by update()
+    volatile uint16_t dropped;
+
+    uint16_t pinMask;
+    byte pinCount;
+    byte blockFrames;
+    uint32_t rate;
+    uint16_t sequence;
+    boolean running;
+#ifdef SAMPLE_STREAM_TIMER2
+    byte timerClockSelect;
+    byte timerCompare;
+#else
+    unsigned long period;
+    unsigned long nextSample;
+#endif
+
+    void configure(uint16_t mask, uint32_t requestedRate, byte frames);
+    void start();
+    void stop();
+    void sendConfig();
+    sample_index_t buffered();
+};
+
+#if defined(SAMPLE_STREAM_TIMER2) && !defined(SAMPLE_STREAM_NO_ISR)
+// defined here, so the vector is only taken when a sketch includes this file
+ISR(TIMER2_COMPA_vect)
+{
+  SampleStreamFirmata::instance->sample();
+}
+#endif
+
+#endif /* SampleStreamFirmata_h */
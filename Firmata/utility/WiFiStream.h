@@ -221,6 +221,12 @@ public:
     return connect_client() ? _client.write( byte ) : 0;
   }
 
+  // pass blocks through, so a sysex message goes out in one packet instead of one per byte
+  inline size_t write(const uint8_t *buffer, size_t size)
+  {
+    return connect_client() ? _client.write( buffer, size ) : 0;
+  }
+
 };
 
 #endif //WIFI_STREAM_H
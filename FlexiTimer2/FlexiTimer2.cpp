@@ -32,6 +32,9 @@ void (*FlexiTimer2::func)();
 volatile unsigned long FlexiTimer2::count;
 volatile char FlexiTimer2::overflowing;
 volatile unsigned int FlexiTimer2::tcnt2;
+FlexiTimer2::Task *FlexiTimer2::tasks;
+FlexiTimer2::Task *FlexiTimer2::ready;
+volatile char FlexiTimer2::dispatching;
 
 void FlexiTimer2::set(unsigned long ms, void (*f)()) {
     FlexiTimer2::set(ms, 0.001, f);
@@ -179,6 +182,132 @@ void FlexiTimer2::stop() {
 #endif
 }
 
+/**
+ * Tick scheduler
+ *
+ * Tasks are kept in a delta list sorted by due time: each task stores the
+ * ticks between its predecessor's due time and its own, so a tick only
+ * decrements the head and costs the same however many tasks are registered.
+ * Walking the list is only needed to re-insert a task once it is due.
+ *
+ * A due task is re-inserted one period later on the very tick it becomes
+ * due and moved to the ready queue, so its phase does not drift with run
+ * time or with other tasks. Ready tasks run in order with interrupts
+ * enabled so that ticks keep being counted meanwhile; if a task becomes due
+ * again before its previous run has finished, that run is skipped and
+ * counted in its overruns.
+ */
+static void insertTask(FlexiTimer2::Task *task, unsigned long ticks) {
+	FlexiTimer2::Task **p = &FlexiTimer2::tasks;
+	while (*p && (*p)->delta <= ticks) {	// after tasks due at the same tick
+		ticks -= (*p)->delta;
+		p = &(*p)->next;
+	}
+	task->delta = ticks;
+	task->next = *p;
+	if (*p)
+		(*p)->delta -= ticks;
+	*p = task;
+}
+
+static void unlinkTask(FlexiTimer2::Task *task) {
+	for (FlexiTimer2::Task **p = &FlexiTimer2::tasks; *p; p = &(*p)->next) {
+		if (*p == task) {
+			*p = task->next;
+			if (task->next)
+				task->next->delta += task->delta;
+			return;
+		}
+	}
+}
+
+/**
+ * @param period
+ *   ticks between runs, in units of the resolution given to set().
+ * @param phase
+ *   ticks until the first run (0 means one full period), which sets the
+ *   task's offset against the other tasks.
+ * @return
+ *   false if the task is already registered or still running.
+ */
+bool FlexiTimer2::addTask(Task &task, unsigned long period, unsigned long phase, void (*f)()) {
+	uint8_t oldSREG = SREG;
+	cli();
+	bool added = !task.running && !task.pending;
+	for (Task *t = tasks; t && added; t = t->next)
+		added = t != &task;
+	if (added) {
+		task.func = f;
+		task.period = period ? period : 1;
+		task.overruns = 0;
+		insertTask(&task, phase ? phase : task.period);
+	}
+	SREG = oldSREG;
+	return added;
+}
+
+void FlexiTimer2::removeTask(Task &task) {
+	uint8_t oldSREG = SREG;
+	cli();
+	unlinkTask(&task);
+	if (task.pending) {
+		for (Task **p = &ready; *p; p = &(*p)->ready) {
+			if (*p == &task) {
+				*p = task.ready;
+				break;
+			}
+		}
+		task.pending = 0;
+	}
+	SREG = oldSREG;	// a run in progress still completes
+}
+
+unsigned int FlexiTimer2::overruns(Task &task) {
+	uint8_t oldSREG = SREG;
+	cli();
+	unsigned int n = task.overruns;
+	SREG = oldSREG;
+	return n;
+}
+
+static void dispatchTasks() {
+	using FlexiTimer2::Task;
+	using FlexiTimer2::tasks;
+	using FlexiTimer2::ready;
+
+	tasks->delta--;
+	while (tasks && !tasks->delta) {
+		Task *t = tasks;
+		tasks = t->next;
+		insertTask(t, t->period);
+		if (t->pending || t->running) {
+			t->overruns++;
+		} else {
+			Task **p = &ready;
+			while (*p)
+				p = &(*p)->ready;
+			t->ready = 0;
+			t->pending = 1;
+			*p = t;
+		}
+	}
+	if (FlexiTimer2::dispatching)
+		return;	// the interrupted dispatch loop below picks up ready tasks
+
+	FlexiTimer2::dispatching = 1;
+	while (ready) {
+		Task *t = ready;
+		ready = t->ready;
+		t->pending = 0;
+		t->running = 1;
+		sei();
+		(*t->func)();
+		cli();
+		t->running = 0;
+	}
+	FlexiTimer2::dispatching = 0;
+}
+
 void FlexiTimer2::_overflow() {
 	count += 1;
 	
@@ -186,9 +315,13 @@ void FlexiTimer2::_overflow() {
 		overflowing = 1;
 		count = count - time_units; // subtract time_uints to catch missed overflows
 					// set to 0 if you don't want this.
-		(*func)();
+		if (func)
+			(*func)();
 		overflowing = 0;
 	}
+
+	if (tasks)
+		dispatchTasks();
 }
 #if defined (__AVR_ATmega32U4__)
 ISR(TIMER4_OVF_vect) {
@@ -9,16 +9,36 @@
 
 
 namespace FlexiTimer2 {
+	// A periodic job for the tick scheduler, allocated by the sketch
+	// (usually as a global) and registered with addTask(). Periods are in
+	// timer ticks, i.e. units of the resolution given to set().
+	struct Task {
+		void (*func)();
+		unsigned long period;		// ticks between runs
+		unsigned long delta;		// ticks after the previous task in the list
+		volatile unsigned int overruns;	// runs skipped because the previous one had not finished
+		volatile char pending;		// due and waiting in the ready queue
+		volatile char running;
+		Task *next;
+		Task *ready;
+	};
+
 	extern unsigned long time_units;
 	extern void (*func)();
 	extern volatile unsigned long count;
 	extern volatile char overflowing;
 	extern volatile unsigned int tcnt2;
+	extern Task *tasks;
+	extern Task *ready;
+	extern volatile char dispatching;
 	
 	void set(unsigned long ms, void (*f)());
 	void set(unsigned long units, double resolution, void (*f)());
 	void start();
 	void stop();
+	bool addTask(Task &task, unsigned long period, unsigned long phase, void (*f)());
+	void removeTask(Task &task);
+	unsigned int overruns(Task &task);
 	void _overflow();
 }
 
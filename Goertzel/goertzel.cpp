@@ -134,3 +134,287 @@ int Goertzdetector::detecttone(){
   return(filteredstate);
 
  }
+
+
+
+Goertzbank::Goertzbank(){
+
+  tones = 0;
+  realstate = 0;
+  realstatebefore = 0;
+  filteredstate = 0;
+  laststarttime = 0;
+
+}
+
+
+void Goertzbank::init(int _audioInPin, float _sampling_freq){
+
+  audioInPin = _audioInPin;
+  sampling_freq = _sampling_freq;
+  cleartones();
+
+}
+
+
+void Goertzbank::cleartones(){
+
+  tones = 0;
+  realstate = 0;
+  realstatebefore = 0;
+  filteredstate = 0;
+
+}
+
+
+int Goertzbank::addtone(float target_freq){
+
+  if (tones >= GOERTZ_BANK_MAX_TONES){
+    return -1;
+  }
+
+  float omega = (2.0 * PI * target_freq) / sampling_freq;
+  float cosine = cos(omega);
+
+  // cos(omega) = 1.0 doesn't fit in Q15, only a DC "tone" would need it
+  if (cosine > 0.99997){
+    cosine = 0.99997;
+  }
+  coeff[tones] = (int) (cosine * 32768.0 + (cosine < 0 ? -0.5 : 0.5));
+  magnitude[tones] = 0;
+  magnitudelimit[tones] = GOERTZ_MAGNITUDE_LIMIT_LOW;
+
+  return(tones++);
+
+}
+
+
+void Goertzbank::process(const int *data, int count){
+
+  long Q1[GOERTZ_BANK_MAX_TONES];
+  long Q2[GOERTZ_BANK_MAX_TONES];
+  long sum = 0;
+
+  for (int index = 0; index < count; index++){
+    sum += data[index];
+  }
+  int mean = sum / count;
+
+  for (int tone = 0; tone < tones; tone++){
+    Q1[tone] = 0;
+    Q2[tone] = 0;
+  }
+
+  // one pass over the samples, every filter is updated with the same sample
+  for (int index = 0; index < count; index++){
+    long sample = (data[index] - mean) >> GOERTZ_BANK_SAMPLE_SHIFT;
+    for (int tone = 0; tone < tones; tone++){
+      // Q0 = 2 * cos(omega) * Q1 - Q2 + sample, the Q15 product is shifted by 14 for the 2 *
+      long Q0 = ((Q1[tone] * coeff[tone]) >> 14) - Q2[tone] + sample;
+      Q2[tone] = Q1[tone];
+      Q1[tone] = Q0;
+    }
+  }
+
+  // the magnitudes are only computed once per block, float keeps the squares from overflowing
+  for (int tone = 0; tone < tones; tone++){
+    float q1 = Q1[tone];
+    float q2 = Q2[tone];
+    float magnitudeSquared = (q1*q1)+(q2*q2)-q1*q2*((float) coeff[tone] / 16384.0);
+    magnitude[tone] = sqrt(magnitudeSquared) * (float) (1 << GOERTZ_BANK_SAMPLE_SHIFT);
+  }
+
+}
+
+
+unsigned int Goertzbank::detecttones(){
+
+  for (int index = 0; index < GOERTZ_SAMPLES; index++){
+    testData[index] = analogRead(audioInPin);
+  }
+
+  process(testData, GOERTZ_SAMPLES);
+
+  ///////////////////////////////////////////////////////////////////////
+  // same automatic magnitude limit as Goertzdetector, once per tone  //
+  ///////////////////////////////////////////////////////////////////////
+
+  realstate = 0;
+
+  for (int tone = 0; tone < tones; tone++){
+    if (magnitude[tone] > GOERTZ_MAGNITUDE_LIMIT_LOW){
+      magnitudelimit[tone] = (magnitudelimit[tone] + ((magnitude[tone] - magnitudelimit[tone]) / GOERTZ_MOVING_AVERAGE_FILTER));  /// moving average filter
+    } else {
+      magnitudelimit[tone] = GOERTZ_MAGNITUDE_LIMIT_LOW;
+    }
+    if (magnitude[tone] > ((float) magnitudelimit[tone] * (float) GOERTZ_MAGNITUDE_THRESHOLD)){
+      realstate |= (1 << tone);
+    }
+  }
+
+  /////////////////////////////////////////////////////
+  // here we clean up the state with a noise blanker //
+  /////////////////////////////////////////////////////
+
+  if (realstate != realstatebefore){
+    laststarttime = millis();
+  }
+
+  if ((millis()-laststarttime) > nbtime){
+    filteredstate = realstate;
+  }
+
+  realstatebefore = realstate;
+
+  return(filteredstate);
+
+}
+
+
+
+static Goertzslider *isrslider = 0;
+
+
+Goertzslider::Goertzslider(){
+
+  re = 0;
+  im = 0;
+  head = 0;
+  magnitude = 0;
+  magnitudelimit = GOERTZ_MAGNITUDE_LIMIT_LOW;
+  realstate = LOW;
+  realstatebefore = LOW;
+  filteredstate = LOW;
+  laststarttime = 0;
+
+}
+
+
+void Goertzslider::init(int _audioInPin, float target_freq, float sampling_freq){
+
+  int k = (int) (0.5 + (((float)GOERTZ_SAMPLES * target_freq) / sampling_freq));
+  float omega = (2.0 * PI * k) / (float) GOERTZ_SAMPLES;
+
+  cosr = (int) (GOERTZ_SLIDING_DAMPING * cos(omega) * 32767.0);
+  sinr = (int) (GOERTZ_SLIDING_DAMPING * sin(omega) * 32767.0);
+  rn = (int) (pow(GOERTZ_SLIDING_DAMPING, GOERTZ_SAMPLES) * 32767.0);
+
+  for (int index = 0; index < GOERTZ_SAMPLES; index++){
+    history[index] = 0;
+  }
+  re = 0;
+  im = 0;
+  head = 0;
+
+  audioInPin = _audioInPin;
+
+}
+
+
+void Goertzslider::start(){
+
+  isrslider = this;
+
+#if defined(__AVR__) && GOERTZ_ADC_ISR
+  uint8_t channel = audioInPin >= A0 ? audioInPin - A0 : audioInPin;
+#if defined(analogPinToChannel)
+  channel = analogPinToChannel(channel);
+#endif
+  noInterrupts();
+  ADMUX = (1 << REFS0) | (channel & 0x07);   // AVcc reference
+#if defined(MUX5)
+  ADCSRB = (channel & 0x08) ? (1 << MUX5) : 0;   // free running trigger
+#else
+  ADCSRB = 0;   // free running trigger
+#endif
+  ADCSRA = (1 << ADEN) | (1 << ADSC) | (1 << ADATE) | (1 << ADIE) | 0x07;   // prescaler 128
+  interrupts();
+#endif
+
+}
+
+
+void Goertzslider::stop(){
+
+#if defined(__AVR__) && GOERTZ_ADC_ISR
+  ADCSRA = (1 << ADEN) | 0x07;   // back to the analogRead() setup
+#endif
+
+  isrslider = 0;
+
+}
+
+
+void Goertzslider::addsample(int sample){
+
+  // S(n) = r * W * (S(n-1) + x(n) - r^N * x(n-N))
+
+  int x = (sample - GOERTZ_ADC_MIDPOINT) >> GOERTZ_SLIDING_SAMPLE_SHIFT;
+  long a = re + x - (((long) history[head] * rn) >> 15);
+  long b = im;
+
+  history[head] = x;
+  if (++head >= GOERTZ_SAMPLES){
+    head = 0;
+  }
+
+  re = (a * cosr - b * sinr) >> 15;
+  im = (a * sinr + b * cosr) >> 15;
+
+}
+
+
+float Goertzslider::getmagnitude(){
+
+  noInterrupts();
+  float q1 = re;
+  float q2 = im;
+  interrupts();
+
+  magnitude = sqrt((q1*q1)+(q2*q2)) * (float) (1 << GOERTZ_SLIDING_SAMPLE_SHIFT);
+
+  return(magnitude);
+
+}
+
+
+int Goertzslider::detecttone(){
+
+  getmagnitude();
+
+  if (magnitude > GOERTZ_MAGNITUDE_LIMIT_LOW){
+    magnitudelimit = (magnitudelimit + ((magnitude - magnitudelimit) / GOERTZ_MOVING_AVERAGE_FILTER));  /// moving average filter
+  } else {
+	  magnitudelimit = GOERTZ_MAGNITUDE_LIMIT_LOW;
+  }
+
+  if (magnitude > ((float) magnitudelimit * (float) GOERTZ_MAGNITUDE_THRESHOLD)){
+    realstate = HIGH;
+  } else {
+    realstate = LOW;
+  }
+
+  if (realstate != realstatebefore){
+    laststarttime = millis();
+  }
+
+  if ((millis()-laststarttime) > nbtime){
+    filteredstate = realstate;
+  }
+
+  realstatebefore = realstate;
+
+  return(filteredstate);
+
+}
+
+
+#if defined(__AVR__) && GOERTZ_ADC_ISR
+ISR(ADC_vect){
+
+  if (isrslider){
+    isrslider->addsample(ADC);
+  }
+
+}
+#endif
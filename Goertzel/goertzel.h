@@ -77,4 +77,125 @@ class Goertzdetector {
 
 };
 
+
+/*
+
+	Goertzbank: several Goertzel filters run in a single pass over the same samples
+
+	The coefficients are cos(omega) in Q15 and the filter states are 32 bit integers, so each
+	tone costs one 32x16 multiply and two adds per sample instead of a float Goertzel.
+	The block mean is removed and the samples are shifted right by GOERTZ_BANK_SAMPLE_SHIFT
+	(10 bit ADC -> signed 8 bit) which keeps the states and products within 32 bits.
+
+	The tones don't have to sit in the center of a bin (omega = 2 * PI * freq / sampling freq),
+	so close tones such as the DTMF rows can be watched with the same GOERTZ_SAMPLES.
+
+	magnitude[] is scaled back to ADC units, so the GOERTZ_MAGNITUDE_* settings apply as for
+	Goertzdetector. detecttones() returns a bit mask of the tones present, bit n for tone n.
+
+*/
+
+#define GOERTZ_BANK_MAX_TONES 8
+
+#if defined(_VARIANT_ARDUINO_DUE_X_)
+  #define GOERTZ_BANK_SAMPLE_SHIFT 4   // ~4 times more samples, 2 more bits of headroom
+#else
+  #define GOERTZ_BANK_SAMPLE_SHIFT 2
+#endif
+
+
+class Goertzbank {
+
+  public:
+    Goertzbank();
+    void init(int _audioInPin, float _sampling_freq = GOERTZ_SAMPLING_FREQ);
+    int addtone(float target_freq);   // returns the tone index, -1 when the bank is full
+    void cleartones();
+    void process(const int *data, int count);   // run the bank on samples already collected
+    unsigned int detecttones();
+    int testData[GOERTZ_SAMPLES];
+    int tones;
+    float magnitude[GOERTZ_BANK_MAX_TONES];
+    int magnitudelimit[GOERTZ_BANK_MAX_TONES];
+
+  private:
+
+	int coeff[GOERTZ_BANK_MAX_TONES];   // cos(omega), Q15
+	float sampling_freq;
+	int audioInPin;
+	unsigned int realstate;
+	unsigned int realstatebefore;
+	unsigned int filteredstate;
+	unsigned long laststarttime;
+
+};
+
+
+/*
+
+	Goertzslider: sliding DFT tone detector fed by the ADC interrupt
+
+	On AVR start() puts the ADC in free-running mode (prescaler 128, GOERTZ_ISR_SAMPLING_FREQ)
+	and every conversion updates the DFT bin over the last GOERTZ_SAMPLES samples, so
+	getmagnitude() and detecttone() never block and the sample timing doesn't jitter.
+	analogRead() can't be used between start() and stop(). On other boards call addsample()
+	from a timer interrupt running at the sampling frequency given to init().
+
+	The bin is rounded to the nearest center as in Goertzdetector. The rotation factor has a
+	magnitude slightly below 1 (GOERTZ_SLIDING_DAMPING) which keeps the Q15 arithmetic stable.
+
+	Set GOERTZ_ADC_ISR to 0 if the sketch needs its own ADC_vect interrupt.
+
+*/
+
+#ifndef GOERTZ_ADC_ISR
+  #define GOERTZ_ADC_ISR 1
+#endif
+
+#if defined(__AVR__)
+  #define GOERTZ_ISR_SAMPLING_FREQ (F_CPU / 128.0 / 13.0)   // 9615 Hz at 16 Mhz
+#else
+  #define GOERTZ_ISR_SAMPLING_FREQ GOERTZ_SAMPLING_FREQ
+#endif
+
+#if defined(_VARIANT_ARDUINO_DUE_X_)
+  #define GOERTZ_SLIDING_SAMPLE_SHIFT 3
+#else
+  #define GOERTZ_SLIDING_SAMPLE_SHIFT 1
+#endif
+
+#define GOERTZ_SLIDING_DAMPING 0.999
+#define GOERTZ_ADC_MIDPOINT 512
+
+
+class Goertzslider {
+
+  public:
+    Goertzslider();
+    void init(int _audioInPin, float target_freq = GOERTZ_TARGET_FREQ, float sampling_freq = GOERTZ_ISR_SAMPLING_FREQ);
+    void start();
+    void stop();
+    void addsample(int sample);   // interrupt context
+    float getmagnitude();
+    int detecttone();   // non blocking, same magnitude limit and noise blanker as Goertzdetector
+    float magnitude;
+    int magnitudelimit;
+
+  private:
+
+	int history[GOERTZ_SAMPLES];
+	volatile long re;
+	volatile long im;
+	int cosr;   // r * cos(omega), Q15
+	int sinr;   // r * sin(omega), Q15
+	int rn;     // r ^ GOERTZ_SAMPLES, Q15
+	unsigned char head;
+	int audioInPin;
+	int realstate;
+	int realstatebefore;
+	int filteredstate;
+	unsigned long laststarttime;
+
+};
+
 #endif //GOERTZEL_H
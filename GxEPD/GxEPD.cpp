@@ -81,4 +81,51 @@ void  GxEPD::drawBitmapBM(const uint8_t *bitmap, uint16_t x, uint16_t y, uint16_
   }
 }
 
+void GxEPD::drawPagedDirty(void (*drawCallback)(void))
+{
+  _drawPagedDirty(PagedCallback(drawCallback));
+}
+
+void GxEPD::drawPagedDirty(void (*drawCallback)(uint32_t), uint32_t p)
+{
+  _drawPagedDirty(PagedCallback(drawCallback, p));
+}
+
+void GxEPD::drawPagedDirty(void (*drawCallback)(const void*), const void* p)
+{
+  _drawPagedDirty(PagedCallback(drawCallback, p));
+}
+
+void GxEPD::drawPagedDirty(void (*drawCallback)(const void*, const void*), const void* p1, const void* p2)
+{
+  _drawPagedDirty(PagedCallback(drawCallback, p1, p2));
+}
 
+bool GxEPD::_pageChanged(uint16_t page, uint16_t pages, const uint8_t* buffer, uint16_t size, const uint8_t* buffer2)
+{
+  if (_signature_pages != pages)
+  {
+    free(_page_signatures);
+    _page_signatures = (uint32_t*)malloc(pages * sizeof(uint32_t));
+    _signature_pages = _page_signatures ? pages : 0;
+    _dirty_all = true;
+  }
+  if (!_page_signatures) return true;
+  // FNV-1a
+  uint32_t signature = 2166136261UL;
+  for (uint16_t i = 0; i < size; i++)
+  {
+    signature = (signature ^ buffer[i]) * 16777619UL;
+  }
+  if (buffer2)
+  {
+    for (uint16_t i = 0; i < size; i++)
+    {
+      signature = (signature ^ buffer2[i]) * 16777619UL;
+    }
+  }
+  bool changed = _dirty_all || (signature != _page_signatures[page]);
+  _page_signatures[page] = signature;
+  if (page == pages - 1) _dirty_all = false;
+  return changed;
+}
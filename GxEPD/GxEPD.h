@@ -48,7 +48,7 @@ class GxEPD : public GxFont_GFX
     };
   public:
     //GxEPD(int16_t w, int16_t h) : Adafruit_GFX(w, h) {};
-    GxEPD(int16_t w, int16_t h) : GxFont_GFX(w, h) {};
+    GxEPD(int16_t w, int16_t h) : GxFont_GFX(w, h), _page_signatures(0), _signature_pages(0), _dirty_all(true) {};
     virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
     virtual void init(uint32_t serial_diag_bitrate = 0) = 0; // = 0 : disabled
     virtual void fillScreen(uint16_t color) = 0; // to buffer
@@ -82,10 +82,55 @@ class GxEPD : public GxFont_GFX
     virtual void updateToWindow(uint16_t xs, uint16_t ys, uint16_t xd, uint16_t yd, uint16_t w, uint16_t h, bool using_rotation = true) {};
     // terminate cleanly updateWindow or updateToWindow before removing power or long delays
     virtual void powerDown() = 0;
+    // paged drawing with page-aware dirty tracking, e.g. for text fields updated with GxFont_GFX
+    // each drawCallback() should draw the whole screen; the pages are compared with the previous call (a signature per page),
+    // only the rows of the pages changed are written and refreshed, using partial update where the class supports it
+    // the first call, and the first call after full update, update all pages
+    void drawPagedDirty(void (*drawCallback)(void));
+    void drawPagedDirty(void (*drawCallback)(uint32_t), uint32_t);
+    void drawPagedDirty(void (*drawCallback)(const void*), const void*);
+    void drawPagedDirty(void (*drawCallback)(const void*, const void*), const void*, const void*);
+    // the next drawPagedDirty() updates all pages, e.g. after drawing to the screen with other methods
+    void resetDirtyTracking() {_dirty_all = true;};
   protected:
+    // the callback of the paged drawing methods, of any of the four kinds
+    class PagedCallback
+    {
+      public:
+        PagedCallback(void (*f)(void)) : _f0(f), _f1(0), _f2(0), _f3(0), _p(0), _p1(0), _p2(0) {};
+        PagedCallback(void (*f)(uint32_t), uint32_t p) : _f0(0), _f1(f), _f2(0), _f3(0), _p(p), _p1(0), _p2(0) {};
+        PagedCallback(void (*f)(const void*), const void* p) : _f0(0), _f1(0), _f2(f), _f3(0), _p(0), _p1(p), _p2(0) {};
+        PagedCallback(void (*f)(const void*, const void*), const void* p1, const void* p2) : _f0(0), _f1(0), _f2(0), _f3(f), _p(0), _p1(p1), _p2(p2) {};
+        void operator()() const
+        {
+          if (_f0) _f0();
+          else if (_f1) _f1(_p);
+          else if (_f2) _f2(_p1);
+          else if (_f3) _f3(_p1, _p2);
+        };
+      private:
+        void (*_f0)(void);
+        void (*_f1)(uint32_t);
+        void (*_f2)(const void*);
+        void (*_f3)(const void*, const void*);
+        uint32_t _p;
+        const void* _p1;
+        const void* _p2;
+    };
+    // implemented by the display classes: draws the pages, updates the screen rows of the pages changed
+    virtual void _drawPagedDirty(const PagedCallback& drawCallback) {};
+    // for drawPaged(_callPaged, &callback)
+    static void _callPaged(const void* callback) {(*(const PagedCallback*)callback)();};
+    // compares the page content with its signature of the previous call, and keeps the new one; pages must be checked in sequence
+    // true if changed, or after resetDirtyTracking(), or if the signatures could not be allocated
+    bool _pageChanged(uint16_t page, uint16_t pages, const uint8_t* buffer, uint16_t size, const uint8_t* buffer2 = 0);
     void drawBitmapBM(const uint8_t *bitmap, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color, int16_t m);
     static inline uint16_t gx_uint16_min(uint16_t a, uint16_t b) {return (a < b ? a : b);};
     static inline uint16_t gx_uint16_max(uint16_t a, uint16_t b) {return (a > b ? a : b);};
+  private:
+    uint32_t* _page_signatures;
+    uint16_t _signature_pages;
+    bool _dirty_all;
 };
 
 #endif
@@ -859,6 +859,72 @@ void GxGDE0213B1::drawPagedToWindow(void (*drawCallback)(const void*, const void
   _PowerOff();
 }
 
+void GxGDE0213B1::_drawPagedDirty(const PagedCallback& drawCallback)
+{
+  if (_current_page != -1) return;
+  if (!_using_partial_mode) resetDirtyTracking(); // screen is erased for partial update
+  // the pages changed since the last call, as one window of full rows
+  int16_t first = -1, last = -1;
+  for (_current_page = 0; _current_page < GxGDE0213B1_PAGES; _current_page++)
+  {
+    fillScreen(GxEPD_WHITE);
+    drawCallback();
+    if (_pageChanged(_current_page, GxGDE0213B1_PAGES, _buffer, GxGDE0213B1_PAGE_SIZE))
+    {
+      if (first < 0) first = _current_page;
+      last = _current_page;
+    }
+  }
+  _current_page = -1;
+  if (first < 0) return; // nothing changed
+  uint16_t x = 0;
+  uint16_t y = (GxGDE0213B1_PAGES - 1 - last) * GxGDE0213B1_PAGE_HEIGHT; // y-decrement mode
+  uint16_t w = GxGDE0213B1_WIDTH;
+  uint16_t h = gx_uint16_min((last - first + 1) * GxGDE0213B1_PAGE_HEIGHT, GxGDE0213B1_HEIGHT - y);
+  if (!_using_partial_mode)
+  {
+    eraseDisplay(false);
+    eraseDisplay(true);
+  }
+  _using_partial_mode = true;
+  _Init_Part(0x01);
+  for (_current_page = GxGDE0213B1_PAGES - 1; _current_page >= 0; _current_page--)
+  {
+    // flip y for y-decrement mode
+    uint16_t yds = (GxGDE0213B1_PAGES - _current_page - 1) * GxGDE0213B1_PAGE_HEIGHT;
+    uint16_t yde = yds + GxGDE0213B1_PAGE_HEIGHT;
+    yds = gx_uint16_max(y, yds);
+    yde = gx_uint16_min(y + h, yde);
+    if (yde > yds)
+    {
+      fillScreen(GxEPD_WHITE);
+      drawCallback();
+      uint16_t ys = (GxGDE0213B1_PAGES - 1) * GxGDE0213B1_PAGE_HEIGHT + (yds % GxGDE0213B1_PAGE_HEIGHT);
+      _writeToWindow(x, ys, x, yds, w, yde - yds);
+    }
+  }
+  _Update_Part();
+  delay(GxGDE0213B1_PU_DELAY);
+  // update erase buffer
+  for (_current_page = GxGDE0213B1_PAGES - 1; _current_page >= 0; _current_page--)
+  {
+    // flip y for y-decrement mode
+    uint16_t yds = (GxGDE0213B1_PAGES - _current_page - 1) * GxGDE0213B1_PAGE_HEIGHT;
+    uint16_t yde = yds + GxGDE0213B1_PAGE_HEIGHT;
+    yds = gx_uint16_max(y, yds);
+    yde = gx_uint16_min(y + h, yde);
+    if (yde > yds)
+    {
+      fillScreen(GxEPD_WHITE);
+      drawCallback();
+      uint16_t ys = (GxGDE0213B1_PAGES - 1) * GxGDE0213B1_PAGE_HEIGHT + (yds % GxGDE0213B1_PAGE_HEIGHT);
+      _writeToWindow(x, ys, x, yds, w, yde - yds);
+    }
+  }
+  _current_page = -1;
+  _PowerOff();
+}
+
 void GxGDE0213B1::drawCornerTest(uint8_t em)
 {
   if (_current_page != -1) return;
@@ -96,6 +96,7 @@ class GxGDE0213B1 : public GxEPD
     void _Update_Full(void);
     void _Update_Part(void);
     void _rotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h);
+    void _drawPagedDirty(const PagedCallback& drawCallback);
   protected:
 #if defined(__AVR)
     uint8_t _buffer[GxGDE0213B1_PAGE_SIZE];
@@ -832,6 +832,55 @@ void GxGDEH0213B72::drawPagedToWindow(void (*drawCallback)(const void*, const vo
   }
 }
 
+void GxGDEH0213B72::_drawPagedDirty(const PagedCallback& drawCallback)
+{
+  if (_current_page != -1) return;
+  if (!_using_partial_mode) resetDirtyTracking(); // screen is erased for partial update
+  // the pages changed since the last call, as one window of full rows
+  int16_t first = -1, last = -1;
+  for (_current_page = 0; _current_page < GxGDEH0213B72_PAGES; _current_page++)
+  {
+    fillScreen(GxEPD_WHITE);
+    drawCallback();
+    if (_pageChanged(_current_page, GxGDEH0213B72_PAGES, _buffer, GxGDEH0213B72_PAGE_SIZE))
+    {
+      if (first < 0) first = _current_page;
+      last = _current_page;
+    }
+  }
+  _current_page = -1;
+  if (first < 0) return; // nothing changed
+  uint16_t x = 0;
+  uint16_t y = first * GxGDEH0213B72_PAGE_HEIGHT;
+  uint16_t w = GxGDEH0213B72_WIDTH;
+  uint16_t h = gx_uint16_min((last - first + 1) * GxGDEH0213B72_PAGE_HEIGHT, GxGDEH0213B72_HEIGHT - y);
+  if (!_using_partial_mode)
+  {
+    eraseDisplay(false);
+    eraseDisplay(true);
+  }
+  _using_partial_mode = true;
+  _Init_Part(0x03);
+  for (uint8_t command = 0x24; true; command = 0x26)
+  { // leave both controller buffers equal
+    for (_current_page = 0; _current_page < GxGDEH0213B72_PAGES; _current_page++)
+    {
+      uint16_t yds = gx_uint16_max(y, _current_page * GxGDEH0213B72_PAGE_HEIGHT);
+      uint16_t yde = gx_uint16_min(y + h, (_current_page + 1) * GxGDEH0213B72_PAGE_HEIGHT);
+      if (yde > yds)
+      {
+        fillScreen(GxEPD_WHITE);
+        drawCallback();
+        uint16_t ys = yds % GxGDEH0213B72_PAGE_HEIGHT;
+        _writeToWindow(command, x, ys, x, yds, w, yde - yds);
+      }
+    }
+    _current_page = -1;
+    if (command == 0x26) break;
+    _Update_Part();
+  }
+}
+
 void GxGDEH0213B72::drawCornerTest(uint8_t em)
 {
   if (_current_page != -1) return;
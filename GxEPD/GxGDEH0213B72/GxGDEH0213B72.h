@@ -97,6 +97,7 @@ class GxGDEH0213B72 : public GxEPD
     void _Update_Full(void);
     void _Update_Part(void);
     void _rotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h);
+    void _drawPagedDirty(const PagedCallback& drawCallback);
   protected:
 #if defined(__AVR)
     uint8_t _buffer[GxGDEH0213B72_PAGE_SIZE];
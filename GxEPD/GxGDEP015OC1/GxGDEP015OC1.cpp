@@ -836,6 +836,67 @@ void GxGDEP015OC1::drawPagedToWindow(void (*drawCallback)(const void*, const voi
   _PowerOff();
 }
 
+void GxGDEP015OC1::_drawPagedDirty(const PagedCallback& drawCallback)
+{
+  if (_current_page != -1) return;
+  if (!_using_partial_mode) resetDirtyTracking(); // screen is erased for partial update
+  // the pages changed since the last call, as one window of full rows
+  int16_t first = -1, last = -1;
+  for (_current_page = 0; _current_page < GxGDEP015OC1_PAGES; _current_page++)
+  {
+    fillScreen(GxEPD_WHITE);
+    drawCallback();
+    if (_pageChanged(_current_page, GxGDEP015OC1_PAGES, _buffer, GxGDEP015OC1_PAGE_SIZE))
+    {
+      if (first < 0) first = _current_page;
+      last = _current_page;
+    }
+  }
+  _current_page = -1;
+  if (first < 0) return; // nothing changed
+  uint16_t x = 0;
+  uint16_t y = first * GxGDEP015OC1_PAGE_HEIGHT;
+  uint16_t w = GxGDEP015OC1_WIDTH;
+  uint16_t h = gx_uint16_min((last - first + 1) * GxGDEP015OC1_PAGE_HEIGHT, GxGDEP015OC1_HEIGHT - y);
+  if (!_using_partial_mode)
+  {
+    eraseDisplay(false);
+    eraseDisplay(true);
+  }
+  _using_partial_mode = true;
+  _Init_Part(0x03);
+  for (_current_page = 0; _current_page < GxGDEP015OC1_PAGES; _current_page++)
+  {
+    uint16_t yds = gx_uint16_max(y, _current_page * GxGDEP015OC1_PAGE_HEIGHT);
+    uint16_t yde = gx_uint16_min(y + h, (_current_page + 1) * GxGDEP015OC1_PAGE_HEIGHT);
+    if (yde > yds)
+    {
+      fillScreen(GxEPD_WHITE);
+      drawCallback();
+      uint16_t ys = yds % GxGDEP015OC1_PAGE_HEIGHT;
+      _writeToWindow(x, ys, x, yds, w, yde - yds);
+    }
+  }
+  _Update_Part();
+  delay(GxGDEP015OC1_PU_DELAY);
+  // update erase buffer
+  for (_current_page = 0; _current_page < GxGDEP015OC1_PAGES; _current_page++)
+  {
+    uint16_t yds = gx_uint16_max(y, _current_page * GxGDEP015OC1_PAGE_HEIGHT);
+    uint16_t yde = gx_uint16_min(y + h, (_current_page + 1) * GxGDEP015OC1_PAGE_HEIGHT);
+    if (yde > yds)
+    {
+      fillScreen(GxEPD_WHITE);
+      drawCallback();
+      uint16_t ys = yds % GxGDEP015OC1_PAGE_HEIGHT;
+      _writeToWindow(x, ys, x, yds, w, yde - yds);
+    }
+  }
+  delay(GxGDEP015OC1_PU_DELAY);
+  _current_page = -1;
+  _PowerOff();
+}
+
 void GxGDEP015OC1::drawCornerTest(uint8_t em)
 {
   if (_current_page != -1) return;
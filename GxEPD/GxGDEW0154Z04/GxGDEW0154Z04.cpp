@@ -642,6 +642,24 @@ void GxGDEW0154Z04::drawPaged(void (*drawCallback)(const void*, const void*), co
   _sleep();
 }
 
+void GxGDEW0154Z04::_drawPagedDirty(const PagedCallback& drawCallback)
+{
+  if (_current_page != -1) return;
+  // no partial update: the screen is updated if any page changed
+  bool changed = false;
+  for (_current_page = 0; _current_page < GxGDEW0154Z04_PAGES; _current_page++)
+  {
+    fillScreen(GxEPD_WHITE);
+    drawCallback();
+    if (_pageChanged(_current_page, GxGDEW0154Z04_PAGES, _black_buffer, GxGDEW0154Z04_PAGE_SIZE, _red_buffer))
+    {
+      changed = true;
+    }
+  }
+  _current_page = -1;
+  if (changed) drawPaged(_callPaged, &drawCallback);
+}
+
 void GxGDEW0154Z04::drawCornerTest(uint8_t em)
 {
   if (_current_page != -1) return;
@@ -72,6 +72,7 @@ class GxGDEW0154Z04 : public GxEPD
     void _wakeUp();
     void _sleep();
     void _waitWhileBusy(const char* comment = 0);
+    void _drawPagedDirty(const PagedCallback& drawCallback);
   private:
 #if defined(__AVR)
     uint8_t _black_buffer[GxGDEW0154Z04_PAGE_SIZE];
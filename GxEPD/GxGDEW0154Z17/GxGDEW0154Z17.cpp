@@ -826,6 +826,52 @@ void GxGDEW0154Z17::drawPagedToWindow(void (*drawCallback)(const void*, const vo
   delay(GxGDEW0154Z17_PU_DELAY); // don't stress this display
 }
 
+void GxGDEW0154Z17::_drawPagedDirty(const PagedCallback& drawCallback)
+{
+  if (_current_page != -1) return;
+  if (!_using_partial_mode) resetDirtyTracking(); // screen is erased for partial update
+  // the pages changed since the last call, as one window of full rows
+  int16_t first = -1, last = -1;
+  for (_current_page = 0; _current_page < GxGDEW0154Z17_PAGES; _current_page++)
+  {
+    fillScreen(GxEPD_WHITE);
+    drawCallback();
+    if (_pageChanged(_current_page, GxGDEW0154Z17_PAGES, _black_buffer, GxGDEW0154Z17_PAGE_SIZE, _red_buffer))
+    {
+      if (first < 0) first = _current_page;
+      last = _current_page;
+    }
+  }
+  _current_page = -1;
+  if (first < 0) return; // nothing changed
+  uint16_t x = 0;
+  uint16_t y = first * GxGDEW0154Z17_PAGE_HEIGHT;
+  uint16_t w = GxGDEW0154Z17_WIDTH;
+  uint16_t h = gx_uint16_min((last - first + 1) * GxGDEW0154Z17_PAGE_HEIGHT, GxGDEW0154Z17_HEIGHT - y);
+  if (!_using_partial_mode)
+  {
+    eraseDisplay(false);
+    eraseDisplay(true);
+  }
+  _using_partial_mode = true;
+  for (_current_page = 0; _current_page < GxGDEW0154Z17_PAGES; _current_page++)
+  {
+    uint16_t yds = gx_uint16_max(y, _current_page * GxGDEW0154Z17_PAGE_HEIGHT);
+    uint16_t yde = gx_uint16_min(y + h, (_current_page + 1) * GxGDEW0154Z17_PAGE_HEIGHT);
+    if (yde > yds)
+    {
+      fillScreen(GxEPD_WHITE);
+      drawCallback();
+      uint16_t ys = yds % GxGDEW0154Z17_PAGE_HEIGHT;
+      _writeToWindow(x, ys, x, yds, w, yde - yds, false);
+    }
+  }
+  _current_page = -1;
+  IO.writeCommandTransaction(0x12);      //display refresh
+  _waitWhileBusy("drawPagedToWindow");
+  delay(GxGDEW0154Z17_PU_DELAY); // don't stress this display
+}
+
 void GxGDEW0154Z17::drawCornerTest(uint8_t em)
 {
   if (_current_page != -1) return;
@@ -970,6 +970,70 @@ void GxGDEW0213I5F::drawPagedToWindow(void (*drawCallback)(const void*, const vo
   delay(GxGDEW0213I5F_PU_DELAY); // don't stress this display
 }
 
+void GxGDEW0213I5F::_drawPagedDirty(const PagedCallback& drawCallback)
+{
+  if (_current_page != -1) return;
+  if (!_using_partial_mode) resetDirtyTracking(); // screen is erased for partial update
+  // the pages changed since the last call, as one window of full rows
+  int16_t first = -1, last = -1;
+  for (_current_page = 0; _current_page < GxGDEW0213I5F_PAGES; _current_page++)
+  {
+    fillScreen(GxEPD_WHITE);
+    drawCallback();
+    if (_pageChanged(_current_page, GxGDEW0213I5F_PAGES, _buffer, GxGDEW0213I5F_PAGE_SIZE))
+    {
+      if (first < 0) first = _current_page;
+      last = _current_page;
+    }
+  }
+  _current_page = -1;
+  if (first < 0) return; // nothing changed
+  uint16_t x = 0;
+  uint16_t y = first * GxGDEW0213I5F_PAGE_HEIGHT;
+  uint16_t w = GxGDEW0213I5F_WIDTH;
+  uint16_t h = gx_uint16_min((last - first + 1) * GxGDEW0213I5F_PAGE_HEIGHT, GxGDEW0213I5F_HEIGHT - y);
+  if (x >= GxGDEW0213I5F_WIDTH) return;
+  if (y >= GxGDEW0213I5F_HEIGHT) return;
+  uint16_t xe = gx_uint16_min(GxGDEW0213I5F_WIDTH, x + w) - 1;
+  uint16_t ye = gx_uint16_min(GxGDEW0213I5F_HEIGHT, y + h) - 1;
+  uint16_t xs_bx = x / 8;
+  uint16_t xe_bx = (xe + 7) / 8;
+  if (!_using_partial_mode) eraseDisplay(true);
+  _using_partial_mode = true;
+  _Init_PartialUpdate();
+  for (uint16_t twice = 0; twice < 2; twice++)
+  { // leave both controller buffers equal
+    IO.writeCommandTransaction(0x91); // partial in
+    _setPartialRamArea(x, y, xe, ye);
+    IO.writeCommandTransaction(0x13);
+    for (_current_page = 0; _current_page < GxGDEW0213I5F_PAGES; _current_page++)
+    {
+      uint16_t yds = gx_uint16_max(y, _current_page * GxGDEW0213I5F_PAGE_HEIGHT);
+      uint16_t yde = gx_uint16_min(y + h, (_current_page + 1) * GxGDEW0213I5F_PAGE_HEIGHT) - 1;
+      if (yde > yds)
+      {
+        fillScreen(GxEPD_WHITE);
+        drawCallback();
+        uint16_t ys = yds % GxGDEW0213I5F_PAGE_HEIGHT;
+        for (int16_t y1 = yds; y1 <= yde; ys++, y1++)
+        {
+          for (int16_t x1 = xs_bx; x1 < xe_bx; x1++)
+          {
+            uint16_t idx = ys * (GxGDEW0213I5F_WIDTH / 8) + x1;
+            uint8_t data = (idx < sizeof(_buffer)) ? _buffer[idx] : 0x00; // white is 0x00 in buffer
+            IO.writeDataTransaction(~data); // white is 0xFF on device
+          }
+        }
+      }
+    }
+    _current_page = -1;
+    IO.writeCommandTransaction(0x12);      //display refresh
+    _waitWhileBusy("drawPagedToWindow");
+    IO.writeCommandTransaction(0x92); // partial out
+  } // leave both controller buffers equal
+  delay(GxGDEW0213I5F_PU_DELAY); // don't stress this display
+}
+
 void GxGDEW0213I5F::drawCornerTest(uint8_t em)
 {
   if (_current_page != -1) return;
@@ -81,6 +81,7 @@ class GxGDEW0213I5F : public GxEPD
     void _Init_PartialUpdate();
     void _waitWhileBusy(const char* comment = 0);
     void _rotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h);
+    void _drawPagedDirty(const PagedCallback& drawCallback);
   private:
 #if defined(__AVR)
     uint8_t _buffer[GxGDEW0213I5F_PAGE_SIZE];
@@ -84,6 +84,7 @@ class GxGDEW0213Z16 : public GxEPD
     void _sleep();
     void _waitWhileBusy(const char* comment = 0);
     void _rotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h);
+    void _drawPagedDirty(const PagedCallback& drawCallback);
   private:
 #if defined(__AVR)
     uint8_t _black_buffer[GxGDEW0213Z16_PAGE_SIZE];
@@ -960,6 +960,51 @@ void GxGDEW027C44::drawPagedToWindow(void (*drawCallback)(const void*, const voi
   _current_page = -1;
 }
 
+void GxGDEW027C44::_drawPagedDirty(const PagedCallback& drawCallback)
+{
+  if (_current_page != -1) return;
+  if (!_using_partial_mode) resetDirtyTracking(); // screen is erased for partial update
+  // the pages changed since the last call, as one window of full rows
+  int16_t first = -1, last = -1;
+  for (_current_page = 0; _current_page < GxGDEW027C44_PAGES; _current_page++)
+  {
+    fillScreen(GxEPD_WHITE);
+    drawCallback();
+    if (_pageChanged(_current_page, GxGDEW027C44_PAGES, _black_buffer, GxGDEW027C44_PAGE_SIZE, _red_buffer))
+    {
+      if (first < 0) first = _current_page;
+      last = _current_page;
+    }
+  }
+  _current_page = -1;
+  if (first < 0) return; // nothing changed
+  uint16_t x = 0;
+  uint16_t y = first * GxGDEW027C44_PAGE_HEIGHT;
+  uint16_t w = GxGDEW027C44_WIDTH;
+  uint16_t h = gx_uint16_min((last - first + 1) * GxGDEW027C44_PAGE_HEIGHT, GxGDEW027C44_HEIGHT - y);
+  if (!_using_partial_mode)
+  {
+    eraseDisplay(false);
+    eraseDisplay(true);
+  }
+  _using_partial_mode = true;
+  for (_current_page = 0; _current_page < GxGDEW027C44_PAGES; _current_page++)
+  {
+    uint16_t yds = gx_uint16_max(y, _current_page * GxGDEW027C44_PAGE_HEIGHT);
+    uint16_t yde = gx_uint16_min(y + h, (_current_page + 1) * GxGDEW027C44_PAGE_HEIGHT);
+    if (yde > yds)
+    {
+      fillScreen(GxEPD_WHITE);
+      drawCallback();
+      uint16_t ys = yds % GxGDEW027C44_PAGE_HEIGHT;
+      _writeToWindow(x, ys, x, yds, w, yde - yds);
+    }
+  }
+  _refreshWindow(x, y, w, h);
+  _waitWhileBusy("updateToWindow");
+  _current_page = -1;
+}
+
 void GxGDEW027C44::drawCornerTest(uint8_t em)
 {
   if (_current_page != -1) return;
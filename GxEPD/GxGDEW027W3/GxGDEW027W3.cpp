@@ -956,6 +956,52 @@ void GxGDEW027W3::drawPagedToWindow(void (*drawCallback)(const void*, const void
   }
 }
 
+void GxGDEW027W3::_drawPagedDirty(const PagedCallback& drawCallback)
+{
+  if (_current_page != -1) return;
+  if (!_using_partial_mode) resetDirtyTracking(); // screen is erased for partial update
+  // the pages changed since the last call, as one window of full rows
+  int16_t first = -1, last = -1;
+  for (_current_page = 0; _current_page < GxGDEW027W3_PAGES; _current_page++)
+  {
+    fillScreen(GxEPD_WHITE);
+    drawCallback();
+    if (_pageChanged(_current_page, GxGDEW027W3_PAGES, _buffer, GxGDEW027W3_PAGE_SIZE))
+    {
+      if (first < 0) first = _current_page;
+      last = _current_page;
+    }
+  }
+  _current_page = -1;
+  if (first < 0) return; // nothing changed
+  uint16_t x = 0;
+  uint16_t y = first * GxGDEW027W3_PAGE_HEIGHT;
+  uint16_t w = GxGDEW027W3_WIDTH;
+  uint16_t h = gx_uint16_min((last - first + 1) * GxGDEW027W3_PAGE_HEIGHT, GxGDEW027W3_HEIGHT - y);
+  if (!_using_partial_mode) eraseDisplay(true);
+  _using_partial_mode = true;
+  _Init_PartialUpdate();
+  for (uint8_t command = 0x15; true; command = 0x14)
+  { // leave both controller buffers equal
+    for (_current_page = 0; _current_page < GxGDEW027W3_PAGES; _current_page++)
+    {
+      uint16_t yds = gx_uint16_max(y, _current_page * GxGDEW027W3_PAGE_HEIGHT);
+      uint16_t yde = gx_uint16_min(y + h, (_current_page + 1) * GxGDEW027W3_PAGE_HEIGHT);
+      if (yde > yds)
+      {
+        fillScreen(GxEPD_WHITE);
+        drawCallback();
+        uint16_t ys = yds % GxGDEW027W3_PAGE_HEIGHT;
+        _writeToWindow(command, x, ys, x, yds, w, yde - yds);
+      }
+    }
+    _current_page = -1;
+    if (command == 0x14) break;
+    _refreshWindow(x, y, w, h);
+    _waitWhileBusy("updateToWindow");
+  }
+}
+
 void GxGDEW027W3::drawCornerTest(uint8_t em)
 {
   if (_current_page != -1) return;
@@ -82,6 +82,7 @@ class GxGDEW027W3 : public GxEPD
     void _Init_PartialUpdate();
     void _waitWhileBusy(const char* comment = 0);
     void _rotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h);
+    void _drawPagedDirty(const PagedCallback& drawCallback);
   private:
 #if defined(__AVR)
     uint8_t _buffer[GxGDEW027W3_PAGE_SIZE];
@@ -808,6 +808,67 @@ void GxGDEW042T2::drawPagedToWindow(void (*drawCallback)(const void*, const void
   _current_page = -1;
 }
 
+void GxGDEW042T2::_drawPagedDirty(const PagedCallback& drawCallback)
+{
+  if (_current_page != -1) return;
+  if (!_using_partial_mode) resetDirtyTracking(); // screen is erased for partial update
+  // the pages changed since the last call, as one window of full rows
+  int16_t first = -1, last = -1;
+  for (_current_page = 0; _current_page < GxGDEW042T2_PAGES; _current_page++)
+  {
+    fillScreen(GxEPD_WHITE);
+    drawCallback();
+    if (_pageChanged(_current_page, GxGDEW042T2_PAGES, _buffer, GxGDEW042T2_PAGE_SIZE))
+    {
+      if (first < 0) first = _current_page;
+      last = _current_page;
+    }
+  }
+  _current_page = -1;
+  if (first < 0) return; // nothing changed
+  uint16_t x = 0;
+  uint16_t y = first * GxGDEW042T2_PAGE_HEIGHT;
+  uint16_t w = GxGDEW042T2_WIDTH;
+  uint16_t h = gx_uint16_min((last - first + 1) * GxGDEW042T2_PAGE_HEIGHT, GxGDEW042T2_HEIGHT - y);
+  if (!_using_partial_mode)
+  {
+    eraseDisplay(false);
+    eraseDisplay(true);
+  }
+  _using_partial_mode = true;
+  for (_current_page = 0; _current_page < GxGDEW042T2_PAGES; _current_page++)
+  {
+    uint16_t yds = gx_uint16_max(y, _current_page * GxGDEW042T2_PAGE_HEIGHT);
+    uint16_t yde = gx_uint16_min(y + h, (_current_page + 1) * GxGDEW042T2_PAGE_HEIGHT);
+    if (yde > yds)
+    {
+      fillScreen(GxEPD_WHITE);
+      drawCallback();
+      uint16_t ys = yds % GxGDEW042T2_PAGE_HEIGHT;
+      _writeToWindow(x, ys, x, yds, w, yde - yds);
+    }
+  }
+  IO.writeCommandTransaction(0x12); //display refresh
+  delay(2);
+  _waitWhileBusy("updateToWindow");
+  // update erase buffer
+  for (_current_page = 0; _current_page < GxGDEW042T2_PAGES; _current_page++)
+  {
+    uint16_t yds = gx_uint16_max(y, _current_page * GxGDEW042T2_PAGE_HEIGHT);
+    uint16_t yde = gx_uint16_min(y + h, (_current_page + 1) * GxGDEW042T2_PAGE_HEIGHT);
+    if (yde > yds)
+    {
+      fillScreen(GxEPD_WHITE);
+      drawCallback();
+      uint16_t ys = yds % GxGDEW042T2_PAGE_HEIGHT;
+      _writeToWindow(x, ys, x, yds, w, yde - yds);
+    }
+  }
+  delay(2);
+  _waitWhileBusy("updateToWindow");
+  _current_page = -1;
+}
+
 void GxGDEW042T2::drawCornerTest(uint8_t em)
 {
   if (_current_page != -1) return;
@@ -80,6 +80,7 @@ class GxGDEW042T2 : public GxEPD
     void _Init_FullUpdate();
     void _Init_PartialUpdate();
     void _rotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h);
+    void _drawPagedDirty(const PagedCallback& drawCallback);
   private:
 #if defined(__AVR)
     uint8_t _buffer[GxGDEW042T2_PAGE_SIZE];
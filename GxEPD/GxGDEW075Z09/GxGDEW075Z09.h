@@ -96,6 +96,7 @@ class GxGDEW075Z09 : public GxEPD
     void _waitWhileBusy(const char* comment = 0);
     void _send8pixel(uint8_t black_data, uint8_t red_data);
     void _rotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h);
+    void _drawPagedDirty(const PagedCallback& drawCallback);
   private:
     uint8_t _black_buffer[GxGDEW075Z09_BUFFER_SIZE];
     uint8_t _red_buffer[GxGDEW075Z09_BUFFER_SIZE];
@@ -30,6 +30,8 @@
 #endif
 
 #include "GxEPD2_EPD.h"
+#include "GxEPD2_PageWriter.h"
+#include "GxEPD2_BitmapStream.h"
 
 // for __has_include see https://en.cppreference.com/w/cpp/preprocessor/include
 // see also https://gcc.gnu.org/onlinedocs/cpp/_005f_005fhas_005finclude.html
@@ -137,9 +139,16 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       _mirror = false;
       _using_partial_mode = false;
       _current_page = 0;
+      _page_copy = 0;
       setFullWindow();
     }
 
+    ~GxEPD2_3C()
+    {
+      _page_writer.end();
+      free(_page_copy);
+    }
+
     uint16_t pages()
     {
       return _pages;
@@ -246,6 +255,25 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       }
     }
 
+    // overlapped paged drawing, for paged buffer (page_height < HEIGHT), on ESP32 with two cores
+    // firstPage()/nextPage() and drawPaged() then write each page to controller memory with a task on the other core,
+    // while the next page is drawn; the page is copied to a second pair of page buffers (allocated here) for the write
+    // nextPageBW() is not overlapped
+    // the drawing code must not use the SPI bus of the display while overlapped paging is active
+    // returns true if overlapped paging is active
+    bool overlappedPaging(bool enable)
+    {
+      _page_writer.end();
+      free(_page_copy);
+      _page_copy = 0;
+      if (!enable || (_pages == 1)) return false;
+      _page_copy = (uint8_t*)malloc(sizeof(_black_buffer) + sizeof(_color_buffer));
+      if (_page_copy && _page_writer.begin(_writePageCopy, this)) return true;
+      free(_page_copy);
+      _page_copy = 0;
+      return false;
+    }
+
     // display buffer content to screen, useful for full screen buffer
     void display(bool partial_update_mode = false)
     {
@@ -314,6 +342,7 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
 
     void firstPage()
     {
+      _page_writer.wait();
       fillScreen(GxEPD_WHITE);
       _current_page = 0;
       _second_phase = false;
@@ -334,7 +363,7 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
         {
           //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
           //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.println(")");
-          epd2.writeImage(_black_buffer, _color_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+          _writePage(_pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
         }
         else
         {
@@ -346,6 +375,7 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
         if (_current_page == int16_t(_pages))
         {
           _current_page = 0;
+          _page_writer.wait();
           if (!_second_phase)
           {
             epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
@@ -362,11 +392,12 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       }
       else // full update
       {
-        epd2.writeImage(_black_buffer, _color_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        _writePage(0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
         _current_page++;
         if (_current_page == int16_t(_pages))
         {
           _current_page = 0;
+          _page_writer.wait();
           if ((epd2.panel == GxEPD2::GDEW0154Z04) && (_pages > 1))
           {
             if (!_second_phase)
@@ -480,9 +511,10 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
           {
             fillScreen(GxEPD_WHITE);
             drawCallback(pv);
-            epd2.writeImage(_black_buffer, _color_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+            _writePage(_pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
           }
         }
+        _page_writer.wait();
         epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
       }
       else // full update
@@ -493,7 +525,7 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
           uint16_t page_ys = _current_page * _page_height;
           fillScreen(GxEPD_WHITE);
           drawCallback(pv);
-          epd2.writeImage(_black_buffer, _color_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+          _writePage(0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
         }
         if (epd2.panel == GxEPD2::GDEW0154Z04)
         { // GxEPD2_154c paged workaround: write color part
@@ -502,9 +534,10 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
             uint16_t page_ys = _current_page * _page_height;
             fillScreen(GxEPD_WHITE);
             drawCallback(pv);
-            epd2.writeImage(_black_buffer, _color_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+            _writePage(0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
           }
         }
+        _page_writer.wait();
         epd2.refresh(false); // full update
         epd2.powerOff();
       }
@@ -579,6 +612,31 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
     {
       epd2.writeNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
     }
+    // write a BMP, PBM, PGM or PPM image from a stream (e.g. SD file or network client) to controller memory, without screen refresh
+    // the stream is read once, front to back; each row is converted and written directly, no frame buffer or seek is needed
+    // x should be multiple of 8; in controller orientation, like writeImage(); returns false if the format is not handled
+    bool writeImageStream(Stream& stream, int16_t x, int16_t y, bool with_color = true)
+    {
+      GxEPD2_BitmapStream bitmap(stream);
+      if (!bitmap.begin(x, y, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT)) return false;
+      uint8_t black_row[GxEPD2_Type::WIDTH / 8], color_row[GxEPD2_Type::WIDTH / 8];
+      uint8_t red, green, blue;
+      int16_t y_row;
+      while (bitmap.nextRow(y_row))
+      {
+        memset(black_row, 0xFF, sizeof(black_row)); // white
+        memset(color_row, 0xFF, sizeof(color_row));
+        for (uint16_t i = 0; i < bitmap.rowWidth(); i++)
+        {
+          bitmap.readPixel(red, green, blue);
+          if (GxEPD2_BitmapStream::whitish(red, green, blue, with_color)) continue;
+          if (with_color && GxEPD2_BitmapStream::colored(red, green, blue)) color_row[i / 8] &= ~(0x80 >> i % 8);
+          else black_row[i / 8] &= ~(0x80 >> i % 8);
+        }
+        epd2.writeImage(black_row, color_row, x, y_row, bitmap.writeWidth(), 1);
+      }
+      return bitmap.complete();
+    }
     // write to controller memory, with screen refresh; x and w should be multiple of 8
     void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
@@ -632,6 +690,30 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       epd2.hibernate();
     }
   private:
+    // writes the page buffers to controller memory, with the page writer task if overlapped paging is active
+    void _writePage(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      if (!_page_copy)
+      {
+        epd2.writeImage(_black_buffer, _color_buffer, x, y, w, h);
+        return;
+      }
+      _page_writer.wait(); // previous page written, _page_copy free
+      memcpy(_page_copy, _black_buffer, sizeof(_black_buffer));
+      memcpy(_page_copy + sizeof(_black_buffer), _color_buffer, sizeof(_color_buffer));
+      _pc_x = x;
+      _pc_y = y;
+      _pc_w = w;
+      _pc_h = h;
+      _page_writer.start();
+    }
+    // runs in the page writer task
+    static void _writePageCopy(void* pv)
+    {
+      GxEPD2_3C* display = (GxEPD2_3C*)pv;
+      const uint8_t* black = display->_page_copy;
+      display->epd2.writeImage(black, black + sizeof(display->_black_buffer), display->_pc_x, display->_pc_y, display->_pc_w, display->_pc_h);
+    }
     template <typename T> static inline void
     _swap_(T & a, T & b)
     {
@@ -670,6 +752,9 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
   private:
     uint8_t _black_buffer[(GxEPD2_Type::WIDTH / 8) * page_height];
     uint8_t _color_buffer[(GxEPD2_Type::WIDTH / 8) * page_height];
+    uint8_t* _page_copy; // black and color page written by _page_writer, for overlappedPaging()
+    GxEPD2_PageWriter _page_writer;
+    uint16_t _pc_x, _pc_y, _pc_w, _pc_h;
     bool _using_partial_mode, _second_phase, _mirror;
     uint16_t _width_bytes, _pixel_bytes;
     int16_t _current_page;
@@ -30,6 +30,8 @@
 #endif
 
 #include "GxEPD2_EPD.h"
+#include "GxEPD2_BitmapStream.h"
+#include "GxEPD2_Dither.h"
 
 // for __has_include see https://en.cppreference.com/w/cpp/preprocessor/include
 // see also https://gcc.gnu.org/onlinedocs/cpp/_005f_005fhas_005finclude.html
@@ -79,9 +81,11 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
   public:
     GxEPD2_Type epd2;
 #if ENABLE_GxEPD2_GFX
-    GxEPD2_4C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_4C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance),
+      _dither(GxEPD2_Dither::palette4c, 4)
 #else
-    GxEPD2_4C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_4C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance),
+      _dither(GxEPD2_Dither::palette4c, 4)
 #endif
     {
       _page_height = page_height;
@@ -89,6 +93,7 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
       _mirror = false;
       _using_partial_mode = false;
       _current_page = 0;
+      _dither_mode = GxEPD2_Dither::none;
       setFullWindow();
     }
 
@@ -138,7 +143,7 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
       // check if in current page
       if ((y < 0) || (y >= int16_t(_page_height))) return;
       uint32_t i = x / 4 + uint32_t(y) * (_pw_w / 4);
-      uint8_t pv = color4(color);
+      uint8_t pv = (_dither_mode != GxEPD2_Dither::none) ? _ditherColor(x + _pw_x, y + _current_page * _page_height + _pw_y, color) : color4(color);
       switch(x % 4)
       {
         case 0: _pixel_buffer[i] = (_pixel_buffer[i] & 0x3F) | (pv << 6); break;
@@ -187,6 +192,18 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
       epd2.end();
     }
 
+    // dithering of colors other than the 4 native colors, for drawing and for writeImageStream(); allocates a 2048 byte color table
+    // drawing uses ordered dithering also for mode diffusion, as pixels are drawn in any order;
+    // writeImageStream() uses error diffusion for mode diffusion, with one line of error memory
+    // returns true if dithering is active
+    bool setDither(GxEPD2_Dither::Mode mode)
+    {
+      _dither_mode = GxEPD2_Dither::none;
+      if (mode == GxEPD2_Dither::none) _dither.end();
+      else if (_dither.begin()) _dither_mode = mode;
+      return (_dither_mode != GxEPD2_Dither::none);
+    }
+
     void fillScreen(uint16_t color)
     {
       uint8_t pv = color4(color) * 0x55; // 0b01010101
@@ -428,6 +445,33 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
     {
       epd2.writeNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
     }
+    // write a BMP, PBM, PGM or PPM image from a stream (e.g. SD file or network client) to controller memory, without screen refresh
+    // the stream is read once, front to back; each row is converted and written directly, no frame buffer or seek is needed
+    // x should be multiple of 8; in controller orientation, like writeImage(); returns false if the format is not handled
+    bool writeImageStream(Stream& stream, int16_t x, int16_t y)
+    {
+      GxEPD2_BitmapStream bitmap(stream);
+      if (!bitmap.begin(x, y, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT)) return false;
+      uint8_t row[GxEPD2_Type::WIDTH / 4];
+      uint8_t red, green, blue;
+      int16_t y_row;
+      bool diffusion = (_dither_mode == GxEPD2_Dither::diffusion) && _dither.beginDiffusion(bitmap.rowWidth());
+      while (bitmap.nextRow(y_row))
+      {
+        if (diffusion) _dither.nextRow();
+        memset(row, 0x55, sizeof(row)); // white
+        for (uint16_t i = 0; i < bitmap.rowWidth(); i++)
+        {
+          bitmap.readPixel(red, green, blue);
+          uint8_t pv = diffusion ? _dither.diffusedPixel(i, red, green, blue) : _streamColor(x + i, y_row, red, green, blue);
+          uint8_t shift = 6 - 2 * (i % 4);
+          row[i / 4] = (row[i / 4] & ~(0x03 << shift)) | (pv << shift);
+        }
+        epd2.writeNative(row, 0, x, y_row, bitmap.writeWidth(), 1);
+      }
+      if (diffusion) _dither.endDiffusion();
+      return bitmap.complete();
+    }
     // write to controller memory, with screen refresh; x and w should be multiple of 8
     void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
@@ -481,6 +525,26 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
       epd2.hibernate();
     }
   private:
+    uint8_t _ditherColor(uint16_t x, uint16_t y, uint16_t color)
+    {
+      switch (color)
+      {
+        case GxEPD_BLACK:
+        case GxEPD_WHITE:
+        case GxEPD_YELLOW:
+        case GxEPD_RED:
+          return color4(color); // native color
+      }
+      uint8_t red = ((color >> 8) & 0xF8) | (color >> 13);
+      uint8_t green = ((color >> 3) & 0xFC) | ((color >> 9) & 0x03);
+      uint8_t blue = ((color << 3) & 0xF8) | ((color >> 2) & 0x07);
+      return _dither.orderedPixel(x, y, red, green, blue);
+    }
+    uint8_t _streamColor(uint16_t x, uint16_t y, uint8_t red, uint8_t green, uint8_t blue)
+    {
+      if (_dither_mode != GxEPD2_Dither::none) return _dither.orderedPixel(x, y, red, green, blue);
+      return color4(GxEPD2_BitmapStream::color565(red, green, blue));
+    }
     template <typename T> static inline void
     _swap_(T & a, T & b)
     {
@@ -553,6 +617,8 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
     }
   private:
     uint8_t _pixel_buffer[(GxEPD2_Type::WIDTH / 4) * page_height];
+    GxEPD2_Dither _dither;
+    GxEPD2_Dither::Mode _dither_mode;
     bool _using_partial_mode, _second_phase, _mirror;
     uint16_t _width_bytes, _pixel_bytes;
     int16_t _current_page;
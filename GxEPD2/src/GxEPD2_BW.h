@@ -31,6 +31,8 @@
 #endif
 
 #include "GxEPD2_EPD.h"
+#include "GxEPD2_PageWriter.h"
+#include "GxEPD2_BitmapStream.h"
 
 // for __has_include see https://en.cppreference.com/w/cpp/preprocessor/include
 // see also https://gcc.gnu.org/onlinedocs/cpp/_005f_005fhas_005finclude.html
@@ -241,9 +243,20 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       _mirror = false;
       _using_partial_mode = false;
       _current_page = 0;
+      _previous = 0;
+      _previous_valid = false;
+      _diff_gap = 16;
+      _page_copy = 0;
       setFullWindow();
     }
 
+    ~GxEPD2_BW()
+    {
+      _page_writer.end();
+      free(_page_copy);
+      free(_previous);
+    }
+
     uint16_t pages()
     {
       return _pages;
@@ -302,6 +315,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       epd2.init(serial_diag_bitrate);
       _using_partial_mode = false;
       _current_page = 0;
+      _previous_valid = false;
       setFullWindow();
     }
 
@@ -316,6 +330,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       epd2.init(serial_diag_bitrate, initial, reset_duration, pulldown_rst_mode);
       _using_partial_mode = false;
       _current_page = 0;
+      _previous_valid = false;
       setFullWindow();
     }
 
@@ -328,6 +343,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       epd2.init(serial_diag_bitrate, initial, reset_duration, pulldown_rst_mode);
       _using_partial_mode = false;
       _current_page = 0;
+      _previous_valid = false;
       setFullWindow();
     }
 
@@ -346,9 +362,52 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       }
     }
 
+    // differential update, for full screen buffer (page_height == HEIGHT) and panels with partial update
+    // keeps a copy of the buffer last shown (allocated here), display(true) then refreshes only the changed areas:
+    // the bands of changed lines (in controller orientation), with x aligned to 8, each with its own partial refresh,
+    // a band ends at gap or more unchanged lines; each refresh takes the waveform time, a larger gap gives fewer refreshes
+    // the first display(true) after enabling (or after any other screen update) is a partial refresh of the full screen
+    // returns true if differential update is active
+    bool differentialUpdate(bool enable, uint16_t gap = 16)
+    {
+      _previous_valid = false;
+      _diff_gap = gap > 0 ? gap : 1;
+      if (!enable || (_pages != 1) || !epd2.hasPartialUpdate)
+      {
+        free(_previous);
+        _previous = 0;
+        return false;
+      }
+      if (!_previous) _previous = (uint8_t*)malloc(sizeof(_buffer));
+      return (_previous != 0);
+    }
+
+    // overlapped paged drawing, for paged buffer (page_height < HEIGHT), on ESP32 with two cores
+    // firstPage()/nextPage() and drawPaged() then write each page to controller memory with a task on the other core,
+    // while the next page is drawn; the page is copied to a second page buffer (allocated here) for the write
+    // the drawing code must not use the SPI bus of the display while overlapped paging is active
+    // returns true if overlapped paging is active
+    bool overlappedPaging(bool enable)
+    {
+      _page_writer.end();
+      free(_page_copy);
+      _page_copy = 0;
+      if (!enable || (_pages == 1)) return false;
+      _page_copy = (uint8_t*)malloc(sizeof(_buffer));
+      if (_page_copy && _page_writer.begin(_writePageCopy, this)) return true;
+      free(_page_copy);
+      _page_copy = 0;
+      return false;
+    }
+
     // display buffer content to screen, useful for full screen buffer
     void display(bool partial_update_mode = false)
     {
+      if (partial_update_mode && _previous_valid && !_using_partial_mode)
+      {
+        _displayChanges();
+        return;
+      }
       if (partial_update_mode) epd2.writeImage(_buffer, 0, 0, GxEPD2_Type::WIDTH, _page_height);
       else epd2.writeImageForFullRefresh(_buffer, 0, 0, GxEPD2_Type::WIDTH, _page_height);
       epd2.refresh(partial_update_mode);
@@ -357,6 +416,11 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
         epd2.writeImageAgain(_buffer, 0, 0, GxEPD2_Type::WIDTH, _page_height);
       }
       if (!partial_update_mode) epd2.powerOff();
+      if (_previous)
+      {
+        memcpy(_previous, _buffer, sizeof(_buffer));
+        _previous_valid = !_using_partial_mode;
+      }
     }
 
     // display part of buffer content to screen, useful for full screen buffer
@@ -379,6 +443,15 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       {
         epd2.writeImagePartAgain(_buffer, x, y_part, GxEPD2_Type::WIDTH, _page_height, x, y_part, w, h);
       }
+      if (_previous_valid && !_using_partial_mode)
+      {
+        for (uint16_t i = y_part; i < y_part + h; i++)
+        {
+          uint16_t offset = i * (GxEPD2_Type::WIDTH / 8) + x / 8;
+          memcpy(_previous + offset, _buffer + offset, (x + w + 7) / 8 - x / 8);
+        }
+      }
+      else _previous_valid = false;
     }
 
     void setFullWindow()
@@ -412,6 +485,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
 
     void firstPage()
     {
+      _page_writer.wait();
       fillScreen(GxEPD_WHITE);
       _current_page = 0;
       _second_phase = false;
@@ -419,6 +493,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
 
     bool nextPage()
     {
+      _previous_valid = false;
       if (1 == _pages)
       {
         if (_using_partial_mode)
@@ -456,8 +531,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
         {
           //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
           //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.println(")");
-          if (!_second_phase) epd2.writeImage(_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
-          else epd2.writeImageAgain(_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+          _writePage(_second_phase ? _write_again : _write_image, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
         }
         else
         {
@@ -469,6 +543,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
         if (_current_page == int16_t(_pages))
         {
           _current_page = 0;
+          _page_writer.wait();
           if (!_second_phase)
           {
             epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
@@ -486,12 +561,12 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       }
       else // full update
       {
-        if (!_second_phase) epd2.writeImageForFullRefresh(_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
-        else epd2.writeImageAgain(_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        _writePage(_second_phase ? _write_again : _write_full, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
         _current_page++;
         if (_current_page == int16_t(_pages))
         {
           _current_page = 0;
+          _page_writer.wait();
           if (epd2.hasFastPartialUpdate)
           {
             if (!_second_phase)
@@ -514,6 +589,7 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
     // GxEPD style paged drawing; drawCallback() is called as many times as needed
     void drawPaged(void (*drawCallback)(const void*), const void* pv)
     {
+      _previous_valid = false;
       if (1 == _pages)
       {
         fillScreen(GxEPD_WHITE);
@@ -555,10 +631,10 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
             {
               fillScreen(GxEPD_WHITE);
               drawCallback(pv);
-              if (phase == 1) epd2.writeImage(_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
-              else epd2.writeImageAgain(_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+              _writePage(phase == 1 ? _write_image : _write_again, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
             }
           }
+          _page_writer.wait();
           epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
           if (!epd2.hasFastPartialUpdate) break;
           // else make both controller buffers have equal content
@@ -571,8 +647,9 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
           uint16_t page_ys = _current_page * _page_height;
           fillScreen(GxEPD_WHITE);
           drawCallback(pv);
-          epd2.writeImageForFullRefresh(_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+          _writePage(_write_full, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
         }
+        _page_writer.wait();
         epd2.refresh(false); // full update after first phase
         if (epd2.hasFastPartialUpdate)
         {
@@ -582,8 +659,9 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
             uint16_t page_ys = _current_page * _page_height;
             fillScreen(GxEPD_WHITE);
             drawCallback(pv);
-            epd2.writeImageAgain(_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+            _writePage(_write_again, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
           }
+          _page_writer.wait();
           //epd2.refresh(true); // partial update after second phase // not needed
         }
         epd2.powerOff();
@@ -620,85 +698,126 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
     //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
     void clearScreen(uint8_t value = 0xFF) // init controller memory and screen (default white)
     {
+      _previous_valid = false;
       epd2.clearScreen(value);
     }
     void writeScreenBuffer(uint8_t value = 0xFF) // init controller memory (default white)
     {
+      _previous_valid = false;
       epd2.writeScreenBuffer(value);
     }
     // write to controller memory, without screen refresh; x and w should be multiple of 8
     void writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _previous_valid = false;
       epd2.writeImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _previous_valid = false;
       epd2.writeImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _previous_valid = false;
       epd2.writeImage(black, color, x, y, w, h, invert, mirror_y, pgm);
     }
     void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _previous_valid = false;
       epd2.writeImage(black, color, x, y, w, h, false, false, false);
     }
     void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _previous_valid = false;
       epd2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _previous_valid = false;
       epd2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, false, false, false);
     }
     // write sprite of native data to controller memory, without screen refresh; x and w should be multiple of 8
     void writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _previous_valid = false;
       epd2.writeNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
     }
+    // write a BMP, PBM, PGM or PPM image from a stream (e.g. SD file or network client) to controller memory, without screen refresh
+    // the stream is read once, front to back; each row is converted and written directly, no frame buffer or seek is needed
+    // x should be multiple of 8; in controller orientation, like writeImage(); returns false if the format is not handled
+    bool writeImageStream(Stream& stream, int16_t x, int16_t y)
+    {
+      _previous_valid = false;
+      GxEPD2_BitmapStream bitmap(stream);
+      if (!bitmap.begin(x, y, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT)) return false;
+      uint8_t row[GxEPD2_Type::WIDTH / 8];
+      uint8_t red, green, blue;
+      int16_t y_row;
+      while (bitmap.nextRow(y_row))
+      {
+        memset(row, 0xFF, sizeof(row)); // white
+        for (uint16_t i = 0; i < bitmap.rowWidth(); i++)
+        {
+          bitmap.readPixel(red, green, blue);
+          if (!GxEPD2_BitmapStream::whitish(red, green, blue, false)) row[i / 8] &= ~(0x80 >> i % 8);
+        }
+        epd2.writeImage(row, x, y_row, bitmap.writeWidth(), 1);
+      }
+      return bitmap.complete();
+    }
     // write to controller memory, with screen refresh; x and w should be multiple of 8
     void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _previous_valid = false;
       epd2.drawImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
     {
+      _previous_valid = false;
       epd2.drawImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _previous_valid = false;
       epd2.drawImage(black, color, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _previous_valid = false;
       epd2.drawImage(black, color, x, y, w, h, false, false, false);
     }
     void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _previous_valid = false;
       epd2.drawImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
     }
     void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                        int16_t x, int16_t y, int16_t w, int16_t h)
     {
+      _previous_valid = false;
       epd2.drawImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, false, false, false);
     }
     // write sprite of native data to controller memory, with screen refresh; x and w should be multiple of 8
     void drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
     {
+      _previous_valid = false;
       epd2.drawNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
     }
     void refresh(bool partial_update_mode = false) // screen refresh from controller memory to full screen
     {
+      _previous_valid = false;
       epd2.refresh(partial_update_mode);
       if (!partial_update_mode) epd2.powerOff();
     }
     void refresh(int16_t x, int16_t y, int16_t w, int16_t h) // screen refresh from controller memory, partial screen
     {
+      _previous_valid = false;
       epd2.refresh(x, y, w, h);
     }
     // turns off generation of panel driving voltages, avoids screen fading over time
@@ -712,6 +831,86 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
       epd2.hibernate();
     }
   private:
+    enum {_write_image, _write_full, _write_again}; // page write methods, for _writePage()
+    // writes the page buffer to controller memory, with the page writer task if overlapped paging is active
+    void _writePage(uint8_t method, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      if (!_page_copy)
+      {
+        _writePageBuffer(_buffer, method, x, y, w, h);
+        return;
+      }
+      _page_writer.wait(); // previous page written, _page_copy free
+      memcpy(_page_copy, _buffer, sizeof(_buffer));
+      _pc_method = method;
+      _pc_x = x;
+      _pc_y = y;
+      _pc_w = w;
+      _pc_h = h;
+      _page_writer.start();
+    }
+    void _writePageBuffer(const uint8_t* buffer, uint8_t method, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      switch (method)
+      {
+        case _write_image:
+          epd2.writeImage(buffer, x, y, w, h);
+          break;
+        case _write_full:
+          epd2.writeImageForFullRefresh(buffer, x, y, w, h);
+          break;
+        case _write_again:
+          epd2.writeImageAgain(buffer, x, y, w, h);
+          break;
+      }
+    }
+    // runs in the page writer task
+    static void _writePageCopy(void* pv)
+    {
+      GxEPD2_BW* display = (GxEPD2_BW*)pv;
+      display->_writePageBuffer(display->_page_copy, display->_pc_method, display->_pc_x, display->_pc_y, display->_pc_w, display->_pc_h);
+    }
+    void _displayChanges()
+    {
+      const uint16_t wb = GxEPD2_Type::WIDTH / 8;
+      uint16_t y = 0;
+      while (y < HEIGHT)
+      {
+        // next band of changed lines, with the changed bytes in xs .. xe
+        uint16_t ys = HEIGHT, ye = 0, xs = wb, xe = 0;
+        for (uint16_t unchanged = 0; (y < HEIGHT) && (unchanged < _diff_gap); y++)
+        {
+          const uint8_t* b = _buffer + y * wb;
+          const uint8_t* p = _previous + y * wb;
+          uint16_t i = 0;
+          while ((i < wb) && (b[i] == p[i])) i++;
+          if (i == wb)
+          {
+            if (ys < HEIGHT) unchanged++;
+            continue;
+          }
+          uint16_t j = wb - 1;
+          while (b[j] == p[j]) j--;
+          if (ys == HEIGHT) ys = y;
+          ye = y;
+          xs = gx_uint16_min(xs, i);
+          xe = gx_uint16_max(xe, j);
+          unchanged = 0;
+        }
+        if (ys == HEIGHT) break; // no more changes
+        uint16_t x = xs * 8, w = (xe - xs + 1) * 8, h = ye - ys + 1;
+        epd2.writeImagePart(_buffer, x, ys, GxEPD2_Type::WIDTH, _page_height, x, ys, w, h);
+        epd2.refresh(x, ys, w, h);
+        if (epd2.hasFastPartialUpdate)
+        {
+          epd2.writeImagePartAgain(_buffer, x, ys, GxEPD2_Type::WIDTH, _page_height, x, ys, w, h);
+        }
+        for (uint16_t i = ys; i <= ye; i++)
+        {
+          memcpy(_previous + i * wb + xs, _buffer + i * wb + xs, xe - xs + 1);
+        }
+      }
+    }
     template <typename T> static inline void
     _swap_(T & a, T & b)
     {
@@ -749,7 +948,14 @@ class GxEPD2_BW : public GxEPD2_GFX_BASE_CLASS
     }
   private:
     uint8_t _buffer[(GxEPD2_Type::WIDTH / 8) * page_height];
+    uint8_t* _previous; // buffer content on screen, for differentialUpdate()
     bool _using_partial_mode, _second_phase, _mirror, _reverse;
+    bool _previous_valid; // false after screen updates not from the buffer
+    uint16_t _diff_gap;
+    uint8_t* _page_copy; // page written by _page_writer, for overlappedPaging()
+    GxEPD2_PageWriter _page_writer;
+    uint8_t _pc_method;
+    uint16_t _pc_x, _pc_y, _pc_w, _pc_h;
     uint16_t _width_bytes, _pixel_bytes;
     int16_t _current_page;
     uint16_t _pages, _page_height;
@@ -0,0 +1,306 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// GxEPD2_BitmapStream : reads BMP, PBM, PGM or PPM images from a Stream, row by row, front to back
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_BitmapStream.h"
+
+GxEPD2_BitmapStream::GxEPD2_BitmapStream(Stream& stream) : _stream(stream)
+{
+  _format = _bmp;
+  _depth = 0;
+  _bottom_up = false;
+  _rgb565 = false;
+  _error = false;
+  _width = 0;
+  _height = 0;
+  _max_value = 255;
+  _x = 0;
+  _y = 0;
+  _screen_h = 0;
+  _row_width = 0;
+  _write_width = 0;
+  _row = 0;
+  _row_size = 0;
+  _row_left = 0;
+  _position = 0;
+  _in_byte = 0;
+  _in_bits = 0;
+  _buffer_index = 0;
+  _buffer_fill = 0;
+  _data_left = 0;
+}
+
+bool GxEPD2_BitmapStream::begin(int16_t x, int16_t y, uint16_t screen_w, uint16_t screen_h)
+{
+  if ((x < 0) || (x % 8) || (x >= int16_t(screen_w)) || (y >= int16_t(screen_h))) return false;
+  uint8_t c1 = _read();
+  uint8_t c2 = _read();
+  bool valid = false;
+  if ((c1 == 'B') && (c2 == 'M')) valid = _readBMPHeader();
+  else if ((c1 == 'P') && (c2 >= '4') && (c2 <= '6')) valid = _readPNMHeader(c2);
+  if (!valid || _error || (_width == 0) || (_height == 0)) return false;
+  if (int32_t(y) + _height <= 0) return false;
+  _x = x;
+  _y = y;
+  _screen_h = screen_h;
+  _row_width = gx_uint16_min(_width, screen_w - x);
+  _write_width = gx_uint16_min((_row_width + 7) & ~7, screen_w - x);
+  _data_left = _row_size * _height; // from here on _read() reads ahead in pixel data only
+  return true;
+}
+
+bool GxEPD2_BitmapStream::nextRow(int16_t& y)
+{
+  while (true)
+  {
+    _skip(_row_left); // rest of the previous row, with padding
+    _row_left = 0;
+    if ((_row >= _height) || _error) return false;
+    uint16_t row = _row++;
+    _row_left = _row_size;
+    _in_bits = 0;
+    int32_t ys = int32_t(_y) + (_bottom_up ? _height - row - 1 : row);
+    if ((ys >= 0) && (ys < int32_t(_screen_h)))
+    {
+      y = ys;
+      return true;
+    }
+  }
+}
+
+void GxEPD2_BitmapStream::readPixel(uint8_t& red, uint8_t& green, uint8_t& blue)
+{
+  if ((_in_bits == 0) && (_row_left < uint32_t(_depth + 7) / 8))
+  {
+    red = green = blue = 0xFF; // beyond the row
+    return;
+  }
+  switch (_depth)
+  {
+    case 32:
+      blue = _read();
+      green = _read();
+      red = _read();
+      _read(); // skip alpha
+      _row_left -= 4;
+      break;
+    case 24:
+      if (_format == _bmp)
+      {
+        blue = _read();
+        green = _read();
+        red = _read();
+      }
+      else
+      {
+        red = _read();
+        green = _read();
+        blue = _read();
+        if (_max_value != 255)
+        {
+          red = uint16_t(red) * 255 / _max_value;
+          green = uint16_t(green) * 255 / _max_value;
+          blue = uint16_t(blue) * 255 / _max_value;
+        }
+      }
+      _row_left -= 3;
+      break;
+    case 16:
+      {
+        uint8_t lsb = _read();
+        uint8_t msb = _read();
+        if (!_rgb565) // 555
+        {
+          blue  = (lsb & 0x1F) << 3;
+          green = ((msb & 0x03) << 6) | ((lsb & 0xE0) >> 2);
+          red   = (msb & 0x7C) << 1;
+        }
+        else // 565
+        {
+          blue  = (lsb & 0x1F) << 3;
+          green = ((msb & 0x07) << 5) | ((lsb & 0xE0) >> 3);
+          red   = (msb & 0xF8);
+        }
+        _row_left -= 2;
+      }
+      break;
+    default: // 1, 2, 4, 8
+      {
+        if (0 == _in_bits)
+        {
+          _in_byte = _read();
+          _in_bits = 8;
+          _row_left--;
+        }
+        uint8_t pn = _in_byte >> (8 - _depth);
+        _in_byte <<= _depth;
+        _in_bits -= _depth;
+        if (_format == _pbm)
+        {
+          red = green = blue = pn ? 0x00 : 0xFF; // 1 is black
+        }
+        else if (_format == _pgm)
+        {
+          red = green = blue = (_max_value != 255) ? uint16_t(pn) * 255 / _max_value : pn;
+        }
+        else
+        {
+          red = _palette[pn][0];
+          green = _palette[pn][1];
+          blue = _palette[pn][2];
+        }
+      }
+      break;
+  }
+}
+
+bool GxEPD2_BitmapStream::_readBMPHeader()
+{
+  _format = _bmp;
+  _position = 2;
+  _read32(); // file size
+  _read32(); // creator bytes
+  uint32_t image_offset = _read32(); // start of image data
+  uint32_t header_size = _read32();
+  if (header_size < 40) return false; // OS/2 headers not handled
+  uint32_t width = _read32();
+  int32_t height = (int32_t)_read32();
+  uint16_t planes = _read16();
+  _depth = _read16(); // bits per pixel
+  uint32_t format = _read32();
+  _read32(); // image size
+  _read32(); // x pixels per meter
+  _read32(); // y pixels per meter
+  uint32_t colors = _read32();
+  if ((planes != 1) || ((format != 0) && (format != 3))) return false; // uncompressed is handled, 565 also
+  if ((_depth != 1) && (_depth != 2) && (_depth != 4) && (_depth != 8) && (_depth != 16) && (_depth != 24) && (_depth != 32)) return false;
+  if ((width > 0xFFFF) || (height > 0xFFFF) || (height < -0xFFFF)) return false;
+  _rgb565 = (format == 3);
+  _bottom_up = (height > 0);
+  _width = width;
+  _height = _bottom_up ? height : -height;
+  _row_size = ((uint32_t(_width) * _depth + 31) / 32) * 4; // BMP rows are padded to 4-byte boundary
+  _skip(14 + header_size + ((format == 3) && (header_size == 40) ? 12 : 0) - _position); // color masks
+  if (_depth <= 8)
+  {
+    uint16_t entries = 1 << _depth;
+    if ((colors == 0) || (colors > entries)) colors = entries;
+    if (entries > GxEPD2_BITMAP_STREAM_PALETTE) return false;
+    memset(_palette, 0, entries * 3);
+    for (uint16_t pn = 0; pn < colors; pn++)
+    {
+      _expect(4);
+      _palette[pn][2] = _read(); // blue
+      _palette[pn][1] = _read(); // green
+      _palette[pn][0] = _read(); // red
+      _read();
+      _position += 4;
+    }
+  }
+  if (image_offset < _position) return false;
+  _skip(image_offset - _position);
+  return !_error;
+}
+
+bool GxEPD2_BitmapStream::_readPNMHeader(uint8_t type)
+{
+  uint32_t width, height, max_value = 1;
+  if (!_readNumber(width) || !_readNumber(height)) return false;
+  if ((type != '4') && !_readNumber(max_value)) return false; // the single whitespace after it is read also
+  if ((width > 0xFFFF) || (height > 0xFFFF) || (max_value < 1) || (max_value > 255)) return false;
+  _format = (type == '4') ? _pbm : (type == '5') ? _pgm : _ppm;
+  _depth = (type == '4') ? 1 : (type == '5') ? 8 : 24;
+  _bottom_up = false;
+  _width = width;
+  _height = height;
+  _max_value = max_value;
+  _row_size = (uint32_t(_width) * _depth + 7) / 8;
+  return !_error;
+}
+
+bool GxEPD2_BitmapStream::_readNumber(uint32_t& value)
+{
+  uint8_t c = _read();
+  while (!_error && ((c == '#') || (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n')))
+  {
+    if (c == '#') while (!_error && (c != '\n')) c = _read(); // comment
+    c = _read();
+  }
+  if ((c < '0') || (c > '9')) return false;
+  value = 0;
+  while (!_error && (c >= '0') && (c <= '9') && (value < 0x10000))
+  {
+    value = value * 10 + (c - '0');
+    c = _read();
+  }
+  return !_error;
+}
+
+// in the header: the next n bytes are read at once, if _buffer is empty
+void GxEPD2_BitmapStream::_expect(uint8_t n)
+{
+  if (_buffer_index >= _buffer_fill) _data_left = n;
+}
+
+// reads from _buffer, refilled with up to _data_left bytes; in the header _data_left is 0 and single bytes are read
+uint8_t GxEPD2_BitmapStream::_read()
+{
+  if (_error) return 0xFF;
+  if (_buffer_index >= _buffer_fill)
+  {
+    uint8_t n = (_data_left > sizeof(_buffer)) ? sizeof(_buffer) : (_data_left > 0) ? _data_left : 1;
+    _buffer_fill = _stream.readBytes((char*)_buffer, n);
+    _buffer_index = 0;
+    if (_buffer_fill == 0)
+    {
+      _error = true; // end of stream or timeout
+      return 0xFF;
+    }
+    if (_data_left > 0) _data_left -= _buffer_fill;
+  }
+  return _buffer[_buffer_index++];
+}
+
+uint32_t GxEPD2_BitmapStream::_read16()
+{
+  // BMP data is stored little-endian
+  _expect(2);
+  uint32_t result = _read(); // LSB
+  result |= uint32_t(_read()) << 8; // MSB
+  _position += 2;
+  return result;
+}
+
+uint32_t GxEPD2_BitmapStream::_read32()
+{
+  // BMP data is stored little-endian
+  _expect(4);
+  uint32_t result = _read16();
+  result |= _read16() << 16;
+  return result;
+}
+
+void GxEPD2_BitmapStream::_skip(uint32_t n)
+{
+  _position += n;
+  while ((n > 0) && !_error)
+  {
+    uint8_t available = _buffer_fill - _buffer_index;
+    if (available == 0)
+    {
+      _read();
+      n--;
+      continue;
+    }
+    uint8_t skipped = (n < available) ? n : available;
+    _buffer_index += skipped;
+    n -= skipped;
+  }
+}
@@ -0,0 +1,97 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// GxEPD2_BitmapStream : reads BMP, PBM, PGM or PPM images from a Stream (e.g. SD file or network client),
+// row by row, front to back, without seek and with constant memory use; used by writeImageStream()
+// handled: BMP uncompressed with depth 1, 2, 4, 8 (with palette), 16 (555 or 565), 24, 32; PBM P4, PGM P5, PPM P6 (maxval < 256)
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#ifndef _GxEPD2_BitmapStream_H_
+#define _GxEPD2_BitmapStream_H_
+
+#include <Arduino.h>
+
+#ifndef GxEPD2_BITMAP_STREAM_PALETTE
+#if defined(__AVR)
+#define GxEPD2_BITMAP_STREAM_PALETTE 16 // palette entries, for depth <= 4
+#else
+#define GxEPD2_BITMAP_STREAM_PALETTE 256 // palette entries, for depth <= 8
+#endif
+#endif
+
+class GxEPD2_BitmapStream
+{
+  public:
+    GxEPD2_BitmapStream(Stream& stream);
+    // reads the header up to the pixel data, for the image at x, y on a screen_w x screen_h screen
+    // returns false if the format is not handled, or the image is not on screen; x must be multiple of 8
+    bool begin(int16_t x, int16_t y, uint16_t screen_w, uint16_t screen_h);
+    // skips to the next row on screen and returns its screen y, in the order of the stream, returns false after the last row
+    bool nextRow(int16_t& y);
+    // next pixel of the current row, for rowWidth() pixels
+    void readPixel(uint8_t& red, uint8_t& green, uint8_t& blue);
+    // pixels to read for each row: the image width, clipped to the screen
+    uint16_t rowWidth()
+    {
+      return _row_width;
+    };
+    // width to write for each row: rowWidth() rounded up to multiple of 8, pad with white
+    uint16_t writeWidth()
+    {
+      return _write_width;
+    };
+    // false if the stream ended before the end of the image
+    bool complete()
+    {
+      return !_error;
+    };
+    // thresholds as in the examples: whitish for black/white, colored for red or yellow on 3-color panels
+    static bool whitish(uint8_t red, uint8_t green, uint8_t blue, bool with_color)
+    {
+      return with_color ? ((red > 0x80) && (green > 0x80) && (blue > 0x80)) : ((red + green + blue) > 3 * 0x80);
+    };
+    static bool colored(uint8_t red, uint8_t green, uint8_t blue)
+    {
+      return (red > 0xF0) || ((green > 0xF0) && (blue > 0xF0));
+    };
+    static uint16_t color565(uint8_t red, uint8_t green, uint8_t blue)
+    {
+      return ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3);
+    };
+  private:
+    enum {_bmp, _pbm, _pgm, _ppm};
+    bool _readBMPHeader();
+    bool _readPNMHeader(uint8_t type);
+    bool _readNumber(uint32_t& value);
+    void _expect(uint8_t n);
+    uint8_t _read();
+    uint32_t _read16();
+    uint32_t _read32();
+    void _skip(uint32_t n);
+    static inline uint16_t gx_uint16_min(uint16_t a, uint16_t b)
+    {
+      return (a < b ? a : b);
+    };
+  private:
+    Stream& _stream;
+    uint8_t _format, _depth;
+    bool _bottom_up, _rgb565, _error;
+    uint16_t _width, _height, _max_value;
+    int16_t _x, _y;
+    uint16_t _screen_h, _row_width, _write_width;
+    uint16_t _row; // rows started
+    uint32_t _row_size, _row_left; // bytes per row, bytes left in the current row
+    uint32_t _position; // bytes read, for the BMP header
+    uint8_t _in_byte, _in_bits; // for depth < 8
+    uint8_t _buffer[64];
+    uint8_t _buffer_index, _buffer_fill;
+    uint32_t _data_left; // bytes of pixel data not yet in _buffer
+    uint8_t _palette[GxEPD2_BITMAP_STREAM_PALETTE][3];
+};
+
+#endif
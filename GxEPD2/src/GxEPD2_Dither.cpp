@@ -0,0 +1,133 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// GxEPD2_Dither : maps RGB colors to the colors of 4-color or 7-color panels, with ordered dithering or error diffusion
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_Dither.h"
+
+const uint8_t GxEPD2_Dither::palette4c[4][3] = {{0, 0, 0}, {255, 255, 255}, {255, 255, 0}, {255, 0, 0}};
+const uint8_t GxEPD2_Dither::palette7c[7][3] = {{0, 0, 0}, {255, 255, 255}, {0, 255, 0}, {0, 0, 255}, {255, 0, 0}, {255, 255, 0}, {255, 128, 0}};
+
+// 8x8 Bayer threshold map, values 0..63
+static const uint8_t bayer8[8][8] =
+{
+  {0, 32, 8, 40, 2, 34, 10, 42},
+  {48, 16, 56, 24, 50, 18, 58, 26},
+  {12, 44, 4, 36, 14, 46, 6, 38},
+  {60, 28, 52, 20, 62, 30, 54, 22},
+  {3, 35, 11, 43, 1, 33, 9, 41},
+  {51, 19, 59, 27, 49, 17, 57, 25},
+  {15, 47, 7, 39, 13, 45, 5, 37},
+  {63, 31, 55, 23, 61, 29, 53, 21}
+};
+
+GxEPD2_Dither::GxEPD2_Dither(const uint8_t (*palette)[3], uint8_t colors) :
+  _palette(palette), _colors(colors > 16 ? 16 : colors), _nearest(0), _error_line(0), _width(0)
+{
+}
+
+GxEPD2_Dither::~GxEPD2_Dither()
+{
+  end();
+}
+
+bool GxEPD2_Dither::begin()
+{
+  if (_nearest) return true;
+  _nearest = (uint8_t*)malloc(4096 / 2);
+  if (!_nearest) return false;
+  for (uint16_t i = 0; i < 4096; i++)
+  {
+    // center of the cell, weighted distance for the eye (more for green, less for blue)
+    int16_t red = ((i >> 8) << 4) + 8, green = (i & 0xF0) + 8, blue = ((i & 0x0F) << 4) + 8;
+    uint32_t min_distance = 0xFFFFFFFF;
+    uint8_t best = 0;
+    for (uint8_t c = 0; c < _colors; c++)
+    {
+      int32_t dr = red - _palette[c][0], dg = green - _palette[c][1], db = blue - _palette[c][2];
+      uint32_t distance = 3 * dr * dr + 4 * dg * dg + 2 * db * db;
+      if (distance < min_distance)
+      {
+        min_distance = distance;
+        best = c;
+      }
+    }
+    if (i & 1) _nearest[i / 2] = (_nearest[i / 2] & 0xF0) | best;
+    else _nearest[i / 2] = best << 4;
+  }
+  return true;
+}
+
+void GxEPD2_Dither::end()
+{
+  endDiffusion();
+  free(_nearest);
+  _nearest = 0;
+}
+
+uint8_t GxEPD2_Dither::orderedPixel(uint16_t x, uint16_t y, uint8_t red, uint8_t green, uint8_t blue)
+{
+  uint8_t c = nearest(red, green, blue);
+  if ((_palette[c][0] == red) && (_palette[c][1] == green) && (_palette[c][2] == blue)) return c; // keep palette colors
+  // offset -126..126, less than half the distance between 0 and 255
+  int16_t offset = (int16_t(bayer8[y & 7][x & 7]) * 2 - 63) * 2;
+  return nearest(_clip(red + offset), _clip(green + offset), _clip(blue + offset));
+}
+
+bool GxEPD2_Dither::beginDiffusion(uint16_t width)
+{
+  endDiffusion();
+  if (!begin()) return false;
+  _error_line = (int16_t*)malloc(3 * sizeof(int16_t) * width);
+  if (!_error_line) return false;
+  memset(_error_line, 0, 3 * sizeof(int16_t) * width);
+  nextRow();
+  _width = width;
+  return true;
+}
+
+void GxEPD2_Dither::endDiffusion()
+{
+  free(_error_line);
+  _error_line = 0;
+  _width = 0;
+}
+
+void GxEPD2_Dither::nextRow()
+{
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    // the sum for the last pixel of the previous row is complete
+    if (_width > 0) _error_line[3 * (_width - 1) + i] = _below_left[i] / 16;
+    _error_right[i] = 0;
+    _below_left[i] = 0;
+    _below[i] = 0;
+  }
+}
+
+uint8_t GxEPD2_Dither::diffusedPixel(uint16_t x, uint8_t red, uint8_t green, uint8_t blue)
+{
+  if (x >= _width) return nearest(red, green, blue);
+  int16_t* error = _error_line + 3 * x;
+  uint8_t v[3];
+  v[0] = _clip(red + error[0] + _error_right[0]);
+  v[1] = _clip(green + error[1] + _error_right[1]);
+  v[2] = _clip(blue + error[2] + _error_right[2]);
+  uint8_t c = nearest(v[0], v[1], v[2]);
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    // 7/16 to the right, 3/16 below left, 5/16 below, 1/16 below right
+    int16_t e = int16_t(v[i]) - _palette[c][i];
+    _error_right[i] = e * 7 / 16;
+    if (x > 0) error[i - 3] = (_below_left[i] + e * 3) / 16; // the pixel below left is done in this row
+    _below_left[i] = _below[i] + e * 5;
+    _below[i] = e;
+  }
+  return c;
+}
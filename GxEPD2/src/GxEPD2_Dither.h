@@ -0,0 +1,63 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// GxEPD2_Dither : maps RGB colors to the colors of 4-color or 7-color panels, with ordered dithering or error diffusion
+// the nearest palette color is taken from a table with 4 bits per channel (2048 bytes, allocated in begin())
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#ifndef _GxEPD2_Dither_H_
+#define _GxEPD2_Dither_H_
+
+#include <Arduino.h>
+
+class GxEPD2_Dither
+{
+  public:
+    enum Mode {none, ordered, diffusion};
+    // palettes in order of the native color values
+    static const uint8_t palette4c[4][3]; // black, white, yellow, red
+    static const uint8_t palette7c[7][3]; // black, white, green, blue, red, yellow, orange
+    GxEPD2_Dither(const uint8_t (*palette)[3], uint8_t colors); // up to 16 colors
+    ~GxEPD2_Dither();
+    // allocates and fills the nearest color table; returns false if allocation failed
+    bool begin();
+    void end();
+    bool active()
+    {
+      return (_nearest != 0);
+    };
+    // nearest palette color, without dithering
+    uint8_t nearest(uint8_t red, uint8_t green, uint8_t blue)
+    {
+      uint16_t i = ((red >> 4) << 8) | (green & 0xF0) | (blue >> 4);
+      return (_nearest[i / 2] >> (i & 1 ? 0 : 4)) & 0x0F;
+    };
+    // ordered dithering (8x8 Bayer), for pixels in any order; palette colors are kept
+    uint8_t orderedPixel(uint16_t x, uint16_t y, uint8_t red, uint8_t green, uint8_t blue);
+    // error diffusion (Floyd-Steinberg) for rows of width pixels, with one line of error memory (allocated here)
+    // the pixels of each row must be given left to right, the rows in sequence; returns false if allocation failed
+    bool beginDiffusion(uint16_t width);
+    void endDiffusion();
+    void nextRow(); // before each row
+    uint8_t diffusedPixel(uint16_t x, uint8_t red, uint8_t green, uint8_t blue);
+  private:
+    static uint8_t _clip(int16_t v)
+    {
+      return (v < 0) ? 0 : (v > 255) ? 255 : v;
+    };
+  private:
+    const uint8_t (*_palette)[3];
+    uint8_t _colors;
+    uint8_t* _nearest; // 4 bits per entry, index from 4 bits per channel
+    int16_t* _error_line; // error for the next row, 3 per pixel
+    uint16_t _width;
+    int16_t _error_right[3]; // error for the next pixel
+    int16_t _below_left[3], _below[3]; // error for the next row, being summed
+};
+
+#endif
@@ -196,10 +196,7 @@ void GxEPD2_EPD::_writeData(const uint8_t* data, uint16_t n)
 {
   _pSPIx->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
-  for (uint16_t i = 0; i < n; i++)
-  {
-    _pSPIx->transfer(*data++);
-  }
+  _transferBytes(*_pSPIx, data, n);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   _pSPIx->endTransaction();
 }
@@ -208,15 +205,8 @@ void GxEPD2_EPD::_writeDataPGM(const uint8_t* data, uint16_t n, int16_t fill_wit
 {
   _pSPIx->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
-  for (uint16_t i = 0; i < n; i++)
-  {
-    _pSPIx->transfer(pgm_read_byte(&*data++));
-  }
-  while (fill_with_zeroes > 0)
-  {
-    _pSPIx->transfer(0x00);
-    fill_with_zeroes--;
-  }
+  _transferBytes(*_pSPIx, data, n, false, true);
+  if (fill_with_zeroes > 0) _transferRepeat(*_pSPIx, 0x00, fill_with_zeroes);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   _pSPIx->endTransaction();
 }
@@ -286,3 +276,64 @@ void GxEPD2_EPD::_endTransfer()
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   _pSPIx->endTransaction();
 }
+
+// size of the buffer on stack for bulk transfers of data that needs conversion
+#define GxEPD2_TRANSFER_BUFFER_SIZE 64
+
+static void _transferBuffer(SPIClass& spi, uint8_t* buffer, uint16_t n)
+{
+#if defined(ESP8266) || defined(ESP32)
+  spi.writeBytes(buffer, n); // no read back
+#else
+  spi.transfer(buffer, n); // overwrites buffer with received data
+#endif
+}
+
+void GxEPD2_EPD::_transferBytes(SPIClass& spi, const uint8_t* data, uint16_t n, bool invert, bool pgm)
+{
+#if defined(ESP32)
+  // flash is mapped to data address space, pgm data can be sent directly
+  if (!invert)
+  {
+    spi.writeBytes(data, n);
+    return;
+  }
+#elif defined(ESP8266)
+  if (!invert && !pgm)
+  {
+    spi.writeBytes(data, n);
+    return;
+  }
+#endif
+  uint8_t buffer[GxEPD2_TRANSFER_BUFFER_SIZE];
+  while (n > 0)
+  {
+    uint16_t len = n < GxEPD2_TRANSFER_BUFFER_SIZE ? n : GxEPD2_TRANSFER_BUFFER_SIZE;
+    for (uint16_t i = 0; i < len; i++)
+    {
+      uint8_t d;
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+      if (pgm) d = pgm_read_byte(&data[i]);
+      else d = data[i];
+#else
+      d = data[i];
+#endif
+      buffer[i] = invert ? ~d : d;
+    }
+    _transferBuffer(spi, buffer, len);
+    data += len;
+    n -= len;
+  }
+}
+
+void GxEPD2_EPD::_transferRepeat(SPIClass& spi, uint8_t value, uint32_t n)
+{
+  uint8_t buffer[GxEPD2_TRANSFER_BUFFER_SIZE];
+  while (n > 0)
+  {
+    uint16_t len = n < GxEPD2_TRANSFER_BUFFER_SIZE ? n : GxEPD2_TRANSFER_BUFFER_SIZE;
+    memset(buffer, value, len); // each time, as transfer() may overwrite it
+    _transferBuffer(spi, buffer, len);
+    n -= len;
+  }
+}
@@ -112,6 +112,17 @@ class GxEPD2_EPD
     void _writeCommandDataPGM(const uint8_t* pCommandData, uint8_t datalen);
     void _startTransfer();
     void _transfer(uint8_t value);
+    // bulk transfers between _startTransfer() and _endTransfer(), with CS kept active
+    void _transfer(const uint8_t* data, uint16_t n, bool invert = false, bool pgm = false)
+    {
+      _transferBytes(*_pSPIx, data, n, invert, pgm);
+    }
+    void _transferRepeat(uint8_t value, uint32_t n)
+    {
+      _transferRepeat(*_pSPIx, value, n);
+    }
+    static void _transferBytes(SPIClass& spi, const uint8_t* data, uint16_t n, bool invert = false, bool pgm = false);
+    static void _transferRepeat(SPIClass& spi, uint8_t value, uint32_t n);
     void _endTransfer();
   protected:
     int16_t _cs, _dc, _rst, _busy, _busy_level;
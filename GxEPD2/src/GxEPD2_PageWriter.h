@@ -0,0 +1,123 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// GxEPD2_PageWriter : writes pages to controller memory with a task on the other core,
+// for overlapped paged drawing: the next page is drawn while the previous page is written.
+// Available on ESP32 with two cores; elsewhere begin() returns false and pages are written directly.
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#ifndef _GxEPD2_PageWriter_H_
+#define _GxEPD2_PageWriter_H_
+
+#include <Arduino.h>
+
+#if defined(ESP32) && !defined(CONFIG_FREERTOS_UNICORE)
+#define GxEPD2_HAS_PAGE_WRITER 1
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#else
+#define GxEPD2_HAS_PAGE_WRITER 0
+#endif
+
+class GxEPD2_PageWriter
+{
+  public:
+    GxEPD2_PageWriter() : _write(0), _owner(0), _pending(false)
+#if GxEPD2_HAS_PAGE_WRITER
+      , _task(0), _start(0), _done(0)
+#endif
+    {
+    }
+    ~GxEPD2_PageWriter()
+    {
+      end();
+    }
+    // write(owner) is called in the task for each start()
+    bool begin(void (*write)(void*), void* owner)
+    {
+      end();
+      _write = write;
+      _owner = owner;
+#if GxEPD2_HAS_PAGE_WRITER
+      _start = xSemaphoreCreateBinary();
+      _done = xSemaphoreCreateBinary();
+      if (_start && _done)
+      {
+        // on the other core than the drawing code, same priority
+        xTaskCreatePinnedToCore(_run, "GxEPD2_PageWriter", 4096, this, uxTaskPriorityGet(0), &_task, 1 - xPortGetCoreID());
+      }
+      if (!_task) end();
+#endif
+      return active();
+    }
+    void end()
+    {
+#if GxEPD2_HAS_PAGE_WRITER
+      wait();
+      if (_task) vTaskDelete(_task);
+      if (_start) vSemaphoreDelete(_start);
+      if (_done) vSemaphoreDelete(_done);
+      _task = 0;
+      _start = 0;
+      _done = 0;
+#endif
+    }
+    bool active()
+    {
+#if GxEPD2_HAS_PAGE_WRITER
+      return (_task != 0);
+#else
+      return false;
+#endif
+    }
+    // starts the write of a page, after the previous one is done; the caller must wait() before it changes what is written
+    void start()
+    {
+      wait();
+#if GxEPD2_HAS_PAGE_WRITER
+      if (_task)
+      {
+        _pending = true;
+        xSemaphoreGive(_start);
+        return;
+      }
+#endif
+      _write(_owner);
+    }
+    // waits until the page write started last is done
+    void wait()
+    {
+#if GxEPD2_HAS_PAGE_WRITER
+      if (_pending) xSemaphoreTake(_done, portMAX_DELAY);
+#endif
+      _pending = false;
+    }
+  private:
+#if GxEPD2_HAS_PAGE_WRITER
+    static void _run(void* pv)
+    {
+      GxEPD2_PageWriter* writer = (GxEPD2_PageWriter*)pv;
+      for (;;)
+      {
+        xSemaphoreTake(writer->_start, portMAX_DELAY);
+        writer->_write(writer->_owner);
+        xSemaphoreGive(writer->_done);
+      }
+    }
+#endif
+    void (*_write)(void*);
+    void* _owner;
+    volatile bool _pending;
+#if GxEPD2_HAS_PAGE_WRITER
+    TaskHandle_t _task;
+    SemaphoreHandle_t _start, _done;
+#endif
+};
+
+#endif
@@ -45,10 +45,7 @@ void GxEPD2_1160_T91::_writeScreenBuffer(uint8_t command, uint8_t value)
   _setPartialRamArea(0, 0, WIDTH, HEIGHT);
   _writeCommand(command);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(value);
-  }
+  _transferRepeat(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
   _endTransfer();
 }
 
@@ -92,26 +89,9 @@ void GxEPD2_1160_T91::_writeImage(uint8_t command, const uint8_t bitmap[], int16
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb, h of bitmap for index!
-      int32_t idx = mirror_y ? j + dx / 8 + ((h - 1 - (i + dy))) * wb : j + dx / 8 + (i + dy) * wb;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wb, h of bitmap for index!
+    int32_t idx = mirror_y ? dx / 8 + ((h - 1 - (i + dy))) * wb : dx / 8 + (i + dy) * wb;
+    _transfer(bitmap + idx, w1 / 8, invert, pgm);
   }
   _endTransfer();
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
@@ -159,26 +139,9 @@ void GxEPD2_1160_T91::_writeImagePart(uint8_t command, const uint8_t bitmap[], i
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb_bitmap, h_bitmap of bitmap for index!
-      int32_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wb_bitmap, h_bitmap of bitmap for index!
+    int32_t idx = mirror_y ? x_part / 8 + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + dx / 8 + (y_part + i + dy) * wb_bitmap;
+    _transfer(bitmap + idx, w1 / 8, invert, pgm);
   }
   _endTransfer();
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
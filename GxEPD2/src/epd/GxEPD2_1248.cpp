@@ -711,10 +711,9 @@ GxEPD2_1248::ScreenPart::ScreenPart(uint16_t width, uint16_t height, bool rev_sc
 void GxEPD2_1248::ScreenPart::writeScreenBuffer(uint8_t command, uint8_t value)
 {
   writeCommand(command); // set current or previous
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    writeData(value);
-  }
+  _startTransfer();
+  _transferRepeat(SPI, value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
+  _endTransfer();
 }
 
 void GxEPD2_1248::ScreenPart::writeImagePart(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
@@ -748,26 +747,9 @@ void GxEPD2_1248::ScreenPart::writeImagePart(uint8_t command, const uint8_t bitm
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb_bitmap, h_bitmap of bitmap for index!
-      int32_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wb_bitmap, h_bitmap of bitmap for index!
+    int32_t idx = mirror_y ? x_part / 8 + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + dx / 8 + (y_part + i + dy) * wb_bitmap;
+    _transfer(bitmap + idx, w1 / 8, invert, pgm);
   }
   _endTransfer();
   writeCommand(0x92); // partial out
@@ -823,6 +805,11 @@ void GxEPD2_1248::ScreenPart::_transfer(uint8_t value)
   SPI.transfer(value);
 }
 
+void GxEPD2_1248::ScreenPart::_transfer(const uint8_t* data, uint16_t n, bool invert, bool pgm)
+{
+  _transferBytes(SPI, data, n, invert, pgm);
+}
+
 void GxEPD2_1248::ScreenPart::_endTransfer()
 {
   if (_cs >= 0) digitalWrite(_cs, HIGH);
@@ -124,6 +124,7 @@ class GxEPD2_1248 : public GxEPD2_EPD
         void _setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
         void _startTransfer();
         void _transfer(uint8_t value);
+        void _transfer(const uint8_t* data, uint16_t n, bool invert, bool pgm);
         void _endTransfer();
       public:
         const uint16_t WIDTH, HEIGHT;
@@ -30,10 +30,7 @@ void GxEPD2_750::writeScreenBuffer(uint8_t value)
   if (value == 0xFF) value = 0x33; // white value for this controller
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 2; i++)
-  {
-    _transfer(value);
-  }
+  _transferRepeat(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 2);
   _endTransfer();
 }
 
@@ -184,26 +181,9 @@ void GxEPD2_750::writeNative(const uint8_t* data1, const uint8_t* data2, int16_t
     _startTransfer();
     for (int16_t i = 0; i < h1; i++)
     {
-      for (int16_t j = 0; j < w1 / 2; j++)
-      {
-        uint8_t data;
-        // use wb, h of bitmap for index!
-        uint16_t idx = mirror_y ? j + dx / 2 + uint16_t((h - 1 - (i + dy))) * wb : j + dx / 2 + uint16_t(i + dy) * wb;
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&data1[idx]);
-#else
-          data = data1[idx];
-#endif
-        }
-        else
-        {
-          data = data1[idx];
-        }
-        if (invert) data = ~data;
-        _transfer(data);
-      }
+      // use wb, h of bitmap for index!
+      uint16_t idx = mirror_y ? dx / 2 + uint16_t((h - 1 - (i + dy))) * wb : dx / 2 + uint16_t(i + dy) * wb;
+      _transfer(data1 + idx, w1 / 2, invert, pgm);
     }
     _endTransfer();
     _writeCommand(0x92); // partial out
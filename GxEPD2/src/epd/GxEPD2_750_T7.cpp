@@ -31,19 +31,13 @@ void GxEPD2_750_T7::writeScreenBuffer(uint8_t value)
   if (!_using_partial_mode) _Init_Part();
   _writeCommand(0x13); // set current
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(value);
-  }
+  _transferRepeat(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
   _endTransfer();
   if (_initial_refresh)
   {
     _writeCommand(0x10); // preset previous
     _startTransfer();
-    for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-    {
-      _transfer(0xFF); // 0xFF is white
-    }
+    _transferRepeat(0xFF, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8); // 0xFF is white
     _endTransfer();
   }
 }
@@ -71,26 +65,9 @@ void GxEPD2_750_T7::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb, h of bitmap for index!
-      uint16_t idx = mirror_y ? j + dx / 8 + uint16_t((h - 1 - (i + dy))) * wb : j + dx / 8 + uint16_t(i + dy) * wb;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wb, h of bitmap for index!
+    uint16_t idx = mirror_y ? dx / 8 + uint16_t((h - 1 - (i + dy))) * wb : dx / 8 + uint16_t(i + dy) * wb;
+    _transfer(bitmap + idx, w1 / 8, invert, pgm);
   }
   _endTransfer();
   _writeCommand(0x92); // partial out
@@ -127,26 +104,9 @@ void GxEPD2_750_T7::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb_bitmap, h_bitmap of bitmap for index!
-      uint16_t idx = mirror_y ? x_part / 8 + j + dx / 8 + uint16_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + uint16_t(y_part + i + dy) * wb_bitmap;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wb_bitmap, h_bitmap of bitmap for index!
+    uint16_t idx = mirror_y ? x_part / 8 + dx / 8 + uint16_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + dx / 8 + uint16_t(y_part + i + dy) * wb_bitmap;
+    _transfer(bitmap + idx, w1 / 8, invert, pgm);
   }
   _endTransfer();
   _writeCommand(0x92); // partial out
@@ -58,10 +58,31 @@
 GxEPD2_it60::GxEPD2_it60(int16_t cs, int16_t dc, int16_t rst, int16_t busy) :
   GxEPD2_EPD(cs, dc, rst, busy, LOW, 10000000, WIDTH, HEIGHT, panel, hasColor, hasPartialUpdate, hasFastPartialUpdate),
   _spi_settings(24000000, MSBFIRST, SPI_MODE0),
-  _spi_settings_for_read(1000000, MSBFIRST, SPI_MODE0)
+  _spi_settings_for_read(1000000, MSBFIRST, SPI_MODE0),
+  _packed_bpp(8), _band_buffer(0), _band_index(0), _band_fill(0), _pack_byte(0), _pack_bits(0), _burst_data(0), _burst_size(0)
 {
 }
 
+GxEPD2_it60::~GxEPD2_it60()
+{
+  _band_writer.end();
+  free(_band_buffer);
+}
+
+bool GxEPD2_it60::setPackedTransfer(uint8_t bpp)
+{
+  _band_writer.end();
+  free(_band_buffer);
+  _band_buffer = 0;
+  _packed_bpp = 8;
+  if ((bpp != 2) && (bpp != 4)) return (bpp == 8);
+  _band_buffer = (uint8_t*)malloc(2 * packed_band_size);
+  if (!_band_buffer) return false;
+  _band_writer.begin(_writeBand, this); // bands are sent directly where not available
+  _packed_bpp = bpp;
+  return true;
+}
+
 void GxEPD2_it60::init(uint32_t serial_diag_bitrate)
 {
   init(serial_diag_bitrate, true, 20, false);
@@ -112,20 +133,7 @@ void GxEPD2_it60::clearScreen(uint8_t value)
   if (_initial_refresh) _Init_Full();
   else _Init_Part();
   _initial_refresh = false;
-  _setPartialRamArea(0, 0, WIDTH, HEIGHT);
-  SPI.beginTransaction(_spi_settings);
-  if (_cs >= 0) digitalWrite(_cs, LOW);
-  _transfer16(0x0000); // preamble for write data
-  _waitWhileBusy2("clearScreen preamble", default_wait_time);
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT); i++)
-  {
-    SPI.transfer(value);
-#if defined(ESP8266) || defined(ESP32)
-    if (0 == i % 10000) yield();
-#endif
-  }
-  if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _writeScreenData(value);
   _writeCommand16(IT8951_TCON_LD_IMG_END);
   _waitWhileBusy2("clearScreen load end", default_wait_time);
   _refresh(0, 0, WIDTH, HEIGHT, false);
@@ -137,10 +145,24 @@ void GxEPD2_it60::writeScreenBuffer(uint8_t value)
   else _writeScreenBuffer(value);
 }
 
-void GxEPD2_it60::_writeScreenBuffer(uint8_t value)
+void GxEPD2_it60::_writeScreenData(uint8_t value)
 {
-  _initial_write = false; // initial full screen buffer clean done
-  if (!_using_partial_mode) _Init_Part();
+  if (_packed_bpp < 8)
+  {
+    // 4bpp keeps the gray level of value, the controller uses the upper 4 bits
+    _setPartialRamArea(0, 0, WIDTH, HEIGHT, 4);
+    memset(_band_buffer, (value >> 4) * 0x11, packed_band_size);
+    for (uint32_t n = uint32_t(WIDTH) * uint32_t(HEIGHT) / 2; n > 0; )
+    {
+      uint16_t burst = n < packed_band_size ? n : packed_band_size;
+      _writeBurst(_band_buffer, burst);
+      n -= burst;
+#if defined(ESP8266) || defined(ESP32)
+      yield();
+#endif
+    }
+    return;
+  }
   _setPartialRamArea(0, 0, WIDTH, HEIGHT);
   SPI.beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
@@ -155,6 +177,13 @@ void GxEPD2_it60::_writeScreenBuffer(uint8_t value)
   }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   SPI.endTransaction();
+}
+
+void GxEPD2_it60::_writeScreenBuffer(uint8_t value)
+{
+  _initial_write = false; // initial full screen buffer clean done
+  if (!_using_partial_mode) _Init_Part();
+  _writeScreenData(value);
   _writeCommand16(IT8951_TCON_LD_IMG_END);
   _waitWhileBusy2("_writeScreenBuffer load end", default_wait_time);
 }
@@ -176,11 +205,15 @@ void GxEPD2_it60::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16
   h1 -= dy;
   if ((w1 <= 0) || (h1 <= 0)) return;
   if (!_using_partial_mode) _Init_Part();
-  _setPartialRamArea(x1, y1, w1, h1);
-  SPI.beginTransaction(_spi_settings);
-  if (_cs >= 0) digitalWrite(_cs, LOW);
-  _transfer16(0x0000); // preamble for write data
-  _waitWhileBusy2("writeImage preamble", default_wait_time);
+  bool packed = _startPacked(x1, w1);
+  _setPartialRamArea(x1, y1, w1, h1, packed ? _packed_bpp : 8);
+  if (!packed)
+  {
+    SPI.beginTransaction(_spi_settings);
+    if (_cs >= 0) digitalWrite(_cs, LOW);
+    _transfer16(0x0000); // preamble for write data
+    _waitWhileBusy2("writeImage preamble", default_wait_time);
+  }
   for (int16_t i = 0; i < h1; i++)
   {
     for (int16_t j = 0; j < w1 / 8; j++)
@@ -201,14 +234,19 @@ void GxEPD2_it60::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16
         data = bitmap[idx];
       }
       if (invert) data = ~data;
-      _send8pixel(~data);
+      if (packed) _pack8pixel(~data);
+      else _send8pixel(~data);
     }
 #if defined(ESP8266) || defined(ESP32)
     yield();
 #endif
   }
-  if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  if (packed) _endPacked();
+  else
+  {
+    if (_cs >= 0) digitalWrite(_cs, HIGH);
+    SPI.endTransaction();
+  }
   _writeCommand16(IT8951_TCON_LD_IMG_END);
   _waitWhileBusy2("writeImage load end", default_wait_time);
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
@@ -238,11 +276,15 @@ void GxEPD2_it60::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t
   h1 -= dy;
   if ((w1 <= 0) || (h1 <= 0)) return;
   if (!_using_partial_mode) _Init_Part();
-  _setPartialRamArea(x1, y1, w1, h1);
-  SPI.beginTransaction(_spi_settings);
-  if (_cs >= 0) digitalWrite(_cs, LOW);
-  _transfer16(0x0000); // preamble for write data
-  _waitWhileBusy2("writeImage preamble", default_wait_time);
+  bool packed = _startPacked(x1, w1);
+  _setPartialRamArea(x1, y1, w1, h1, packed ? _packed_bpp : 8);
+  if (!packed)
+  {
+    SPI.beginTransaction(_spi_settings);
+    if (_cs >= 0) digitalWrite(_cs, LOW);
+    _transfer16(0x0000); // preamble for write data
+    _waitWhileBusy2("writeImage preamble", default_wait_time);
+  }
   for (int16_t i = 0; i < h1; i++)
   {
     for (int16_t j = 0; j < w1 / 8; j++)
@@ -263,11 +305,16 @@ void GxEPD2_it60::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t
         data = bitmap[idx];
       }
       if (invert) data = ~data;
-      _send8pixel(~data);
+      if (packed) _pack8pixel(~data);
+      else _send8pixel(~data);
     }
   }
-  if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  if (packed) _endPacked();
+  else
+  {
+    if (_cs >= 0) digitalWrite(_cs, HIGH);
+    SPI.endTransaction();
+  }
   _writeCommand16(IT8951_TCON_LD_IMG_END);
   _waitWhileBusy2("writeImage load end", default_wait_time);
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
@@ -306,11 +353,15 @@ void GxEPD2_it60::writeNative(const uint8_t* data1, const uint8_t* data2, int16_
     h1 -= dy;
     if ((w1 <= 0) || (h1 <= 0)) return;
     if (!_using_partial_mode) _Init_Part();
-    _setPartialRamArea(x1, y1, w1, h1);
-    SPI.beginTransaction(_spi_settings);
-    if (_cs >= 0) digitalWrite(_cs, LOW);
-    _transfer16(0x0000); // preamble for write data
-    _waitWhileBusy2("writeNative preamble", default_wait_time);
+    bool packed = _startPacked(x1, w1);
+    _setPartialRamArea(x1, y1, w1, h1, packed ? _packed_bpp : 8);
+    if (!packed)
+    {
+      SPI.beginTransaction(_spi_settings);
+      if (_cs >= 0) digitalWrite(_cs, LOW);
+      _transfer16(0x0000); // preamble for write data
+      _waitWhileBusy2("writeNative preamble", default_wait_time);
+    }
     for (int16_t i = 0; i < h1; i++)
     {
       for (int16_t j = 0; j < w1; j++)
@@ -331,14 +382,19 @@ void GxEPD2_it60::writeNative(const uint8_t* data1, const uint8_t* data2, int16_
           data = data1[idx];
         }
         if (invert) data = ~data;
-        SPI.transfer(data);
+        if (packed) _packNative(data);
+        else SPI.transfer(data);
       }
 #if defined(ESP8266) || defined(ESP32)
       yield();
 #endif
     }
-    if (_cs >= 0) digitalWrite(_cs, HIGH);
-    SPI.endTransaction();
+    if (packed) _endPacked();
+    else
+    {
+      if (_cs >= 0) digitalWrite(_cs, HIGH);
+      SPI.endTransaction();
+    }
     _writeCommand16(IT8951_TCON_LD_IMG_END);
     _waitWhileBusy2("writeNative load end", default_wait_time);
     delay(1); // yield() to avoid WDT on ESP8266 and ESP32
@@ -440,13 +496,89 @@ void GxEPD2_it60::_send8pixel(uint8_t data)
   }
 }
 
-void GxEPD2_it60::_setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+bool GxEPD2_it60::_startPacked(int16_t x, int16_t w)
+{
+  // 16 bit words of packed pixels, on byte boundary
+  if ((_packed_bpp == 8) || (x % 8) || (w % 8)) return false;
+  _band_index = 0;
+  _band_fill = 0;
+  _pack_byte = 0;
+  _pack_bits = 0;
+  return true;
+}
+
+// bitmap data, set bits are black; packed pixels are sent with the first pixel in the low bits of each byte
+void GxEPD2_it60::_pack8pixel(uint8_t data)
+{
+  uint8_t white = _packed_bpp == 4 ? 0x0F : 0x03;
+  for (uint8_t j = 0; j < 8; j += 8 / _packed_bpp)
+  {
+    uint8_t value = 0;
+    for (uint8_t k = 0; k < 8; k += _packed_bpp)
+    {
+      if (!(data & 0x80)) value |= white << k;
+      data <<= 1;
+    }
+    _packByte(value);
+  }
+}
+
+// native data, 8 bit gray per pixel, the upper bits are kept
+void GxEPD2_it60::_packNative(uint8_t value)
+{
+  _pack_byte |= (value >> (8 - _packed_bpp)) << _pack_bits;
+  _pack_bits += _packed_bpp;
+  if (_pack_bits >= 8)
+  {
+    _packByte(_pack_byte);
+    _pack_byte = 0;
+    _pack_bits = 0;
+  }
+}
+
+// starts sending the filled band, the next band is packed into the other one
+void GxEPD2_it60::_sendBand()
+{
+  if (0 == _band_fill) return;
+  _band_writer.wait();
+  _burst_data = _band_buffer + _band_index * packed_band_size;
+  _burst_size = _band_fill;
+  _band_writer.start();
+  _band_index = 1 - _band_index;
+  _band_fill = 0;
+}
+
+void GxEPD2_it60::_endPacked()
+{
+  _sendBand();
+  _band_writer.wait();
+}
+
+void GxEPD2_it60::_writeBurst(const uint8_t* data, uint16_t n)
+{
+  SPI.beginTransaction(_spi_settings);
+  if (_cs >= 0) digitalWrite(_cs, LOW);
+  _transfer16(0x0000); // preamble for write data
+  _waitWhileBusy2(0, default_wait_time); // HRDY once per burst
+  _transferBytes(SPI, data, n);
+  if (_cs >= 0) digitalWrite(_cs, HIGH);
+  SPI.endTransaction();
+}
+
+void GxEPD2_it60::_writeBand(void* pv)
+{
+  GxEPD2_it60* display = (GxEPD2_it60*)pv;
+  display->_writeBurst(display->_burst_data, display->_burst_size);
+}
+
+void GxEPD2_it60::_setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t bpp)
 {
   //_IT8951WriteReg(LISAR + 2 , IT8951DevInfo.usImgBufAddrH);
   //_IT8951WriteReg(LISAR , IT8951DevInfo.usImgBufAddrL);
   uint16_t usArg[5];
   //usArg[0] = (IT8951_LDIMG_L_ENDIAN << 8 ) | (IT8951_8BPP << 4) | (IT8951_ROTATE_0);
-  usArg[0] = (IT8951_LDIMG_B_ENDIAN << 8 ) | (IT8951_8BPP << 4) | (IT8951_ROTATE_0);
+  uint16_t mode = bpp == 2 ? IT8951_2BPP : bpp == 4 ? IT8951_4BPP : IT8951_8BPP;
+  usArg[0] = (IT8951_LDIMG_B_ENDIAN << 8 ) | (mode << 4) | (IT8951_ROTATE_0);
   usArg[1] = x;
   usArg[2] = y;
   usArg[3] = w;
@@ -18,6 +18,7 @@
 #define _GxEPD2_it78_1872x1404_H_
 
 #include "../GxEPD2_EPD.h"
+#include "../GxEPD2_PageWriter.h"
 
 class GxEPD2_it78_1872x1404 : public GxEPD2_EPD
 {
@@ -40,8 +41,10 @@ class GxEPD2_it78_1872x1404 : public GxEPD2_EPD
     static const uint16_t default_wait_time = 1; // ms, default busy check, needed?
     static const uint16_t diag_min_time = 3; // ms, e.g. > refresh_par_time
     static const uint16_t set_vcom_time = 500; // ms, e.g. 454967us
+    static const uint16_t packed_band_size = 2048; // bytes per burst for packed transfer, two bands are allocated
     // constructor
     GxEPD2_it78_1872x1404(int16_t cs, int16_t dc, int16_t rst, int16_t busy);
+    ~GxEPD2_it78_1872x1404();
     // methods (virtual)
     void init(uint32_t serial_diag_bitrate = 0); // serial_diag_bitrate = 0 : disabled
     void init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset_duration = 20, bool pulldown_rst_mode = false);
@@ -70,6 +73,10 @@ class GxEPD2_it78_1872x1404 : public GxEPD2_EPD
     void refresh(int16_t x, int16_t y, int16_t w, int16_t h); // screen refresh from controller memory, partial screen
     void powerOff(); // turns off generation of panel driving voltages, avoids screen fading over time
     void hibernate(); // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
+    // packed transfer: pixels are packed on the host to bpp 4 (16 gray levels) or 2 (for the fast waveform of partial refresh),
+    // and sent in bursts of packed_band_size bytes, with HRDY checked once per burst; bpp 8 (default) sends one byte per pixel
+    // on ESP32 with two cores the next band is packed while the current one is sent; returns false if allocation failed
+    bool setPackedTransfer(uint8_t bpp);
   private:
     struct IT8951DevInfoStruct
     {
@@ -83,11 +90,33 @@ class GxEPD2_it78_1872x1404 : public GxEPD2_EPD
     IT8951DevInfoStruct IT8951DevInfo;
     SPISettings _spi_settings;
     SPISettings _spi_settings_for_read;
+    uint8_t _packed_bpp;
+    uint8_t* _band_buffer; // two bands, one is packed while the other is sent
+    uint8_t _band_index;
+    uint16_t _band_fill;
+    uint8_t _pack_byte, _pack_bits;
+    const uint8_t* _burst_data;
+    uint16_t _burst_size;
+    GxEPD2_PageWriter _band_writer;
   private:
     void _writeScreenBuffer(uint8_t value);
     void _refresh(int16_t x, int16_t y, int16_t w, int16_t h, bool partial_update_mode);
     void _send8pixel(uint8_t data);
-    void _setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void _setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t bpp = 8);
+    void _writeScreenData(uint8_t value);
+    // packed transfer
+    bool _startPacked(int16_t x, int16_t w);
+    void _pack8pixel(uint8_t data);
+    void _packNative(uint8_t value);
+    void _packByte(uint8_t value)
+    {
+      _band_buffer[_band_index * packed_band_size + _band_fill++] = value;
+      if (_band_fill >= packed_band_size) _sendBand();
+    };
+    void _sendBand();
+    void _endPacked();
+    void _writeBurst(const uint8_t* data, uint16_t n);
+    static void _writeBand(void* pv);
     void _PowerOn();
     void _PowerOff();
     void _InitDisplay();
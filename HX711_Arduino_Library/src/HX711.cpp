@@ -33,6 +33,29 @@
 #include <util/atomic.h>
 #endif
 
+// Functions that run in interrupt handlers have to be in IRAM on the ESP8266 and ESP32.
+#if ARCH_ESPRESSIF
+#define HX711_ISR_ATTR IRAM_ATTR
+#else
+#define HX711_ISR_ATTR
+#endif
+
+// Disable interrupts around the clock pulses, see read().
+#if HAS_ATOMIC_BLOCK
+#define CRITICAL_SECTION_BEGIN ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+#define CRITICAL_SECTION_END }
+#elif IS_FREE_RTOS
+// Critical sections are used as a valid protection method
+// against simultaneous access in vanilla FreeRTOS.
+// Disable the scheduler and call portDISABLE_INTERRUPTS. This prevents
+// context switches and servicing of ISRs during a critical section.
+#define CRITICAL_SECTION_BEGIN { portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED; portENTER_CRITICAL(&mux);
+#define CRITICAL_SECTION_END portEXIT_CRITICAL(&mux); }
+#else
+#define CRITICAL_SECTION_BEGIN noInterrupts();
+#define CRITICAL_SECTION_END interrupts();
+#endif
+
 #if FAST_CPU
 // Make shiftIn() be aware of clockspeed for
 // faster CPUs like ESP32, Teensy 3.x and friends.
@@ -40,7 +63,7 @@
 // - https://github.com/bogde/HX711/issues/75
 // - https://github.com/arduino/Arduino/issues/6561
 // - https://community.hiveeyes.org/t/using-bogdans-canonical-hx711-library-on-the-esp32/539
-uint8_t shiftInSlow(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder) {
+uint8_t HX711_ISR_ATTR shiftInSlow(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder) {
     uint8_t value = 0;
     uint8_t i;
 
@@ -109,10 +132,7 @@ long HX711::read() {
 	// Wait for the chip to become ready.
 	wait_ready();
 
-	// Define structures for reading data into.
-	unsigned long value = 0;
-	uint8_t data[3] = { 0 };
-	uint8_t filler = 0x00;
+	long value;
 
 	// Protect the read sequence from system interrupts.  If an interrupt occurs during
 	// the time the PD_SCK signal is high it will stretch the length of the clock pulse.
@@ -127,22 +147,19 @@ long HX711::read() {
 	// state after the sequence completes, insuring that the entire read-and-gain-set
 	// sequence is not interrupted.  The macro has a few minor advantages over bracketing
 	// the sequence between `noInterrupts()` and `interrupts()` calls.
-	#if HAS_ATOMIC_BLOCK
-	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-
-	#elif IS_FREE_RTOS
-	// Begin of critical section.
-	// Critical sections are used as a valid protection method
-	// against simultaneous access in vanilla FreeRTOS.
-	// Disable the scheduler and call portDISABLE_INTERRUPTS. This prevents
-	// context switches and servicing of ISRs during a critical section.
-	portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
-	portENTER_CRITICAL(&mux);
-
-	#else
-	// Disable interrupts.
-	noInterrupts();
-	#endif
+	CRITICAL_SECTION_BEGIN
+	value = shift_in();
+	CRITICAL_SECTION_END
+
+	return value;
+}
+
+long HX711_ISR_ATTR HX711::shift_in() {
+
+	// Define structures for reading data into.
+	unsigned long value = 0;
+	uint8_t data[3] = { 0 };
+	uint8_t filler = 0x00;
 
 	// Pulse the clock pin 24 times to read the data.
 	data[2] = SHIFTIN_WITH_SPEED_SUPPORT(DOUT, PD_SCK, MSBFIRST);
@@ -161,18 +178,6 @@ long HX711::read() {
 		#endif
 	}
 
-	#if IS_FREE_RTOS
-	// End of critical section.
-	portEXIT_CRITICAL(&mux);
-
-	#elif HAS_ATOMIC_BLOCK
-	}
-
-	#else
-	// Enable interrupts again.
-	interrupts();
-	#endif
-
 	// Replicate the most significant bit to pad out a 32-bit signed integer
 	if (data[2] & 0x80) {
 		filler = 0xFF;
@@ -276,3 +281,241 @@ void HX711::power_down() {
 void HX711::power_up() {
 	digitalWrite(PD_SCK, LOW);
 }
+
+// Interrupt handlers, one for each DOUT pin being watched.
+// attachInterrupt() takes a plain function, so each slot has its own.
+static struct {
+	void (*handler)(void*);
+	void* object;
+	byte pin;
+} interrupt_slots[HX711_MAX_INTERRUPTS];
+
+static void HX711_ISR_ATTR run_slot(byte slot) {
+	if (interrupt_slots[slot].handler) {
+		interrupt_slots[slot].handler(interrupt_slots[slot].object);
+	}
+}
+
+static void HX711_ISR_ATTR isr0() { run_slot(0); }
+static void HX711_ISR_ATTR isr1() { run_slot(1); }
+static void HX711_ISR_ATTR isr2() { run_slot(2); }
+static void HX711_ISR_ATTR isr3() { run_slot(3); }
+static void HX711_ISR_ATTR isr4() { run_slot(4); }
+static void HX711_ISR_ATTR isr5() { run_slot(5); }
+static void HX711_ISR_ATTR isr6() { run_slot(6); }
+static void HX711_ISR_ATTR isr7() { run_slot(7); }
+
+static void (* const slot_isr[HX711_MAX_INTERRUPTS])() = {
+	isr0, isr1, isr2, isr3, isr4, isr5, isr6, isr7
+};
+
+static bool attach_slot(byte pin, void (*handler)(void*), void* object) {
+	#ifdef NOT_AN_INTERRUPT
+	if (digitalPinToInterrupt(pin) == NOT_AN_INTERRUPT) {
+		return false;
+	}
+	#endif
+	for (byte i = 0; i < HX711_MAX_INTERRUPTS; i++) {
+		if (interrupt_slots[i].handler == NULL) {
+			interrupt_slots[i].object = object;
+			interrupt_slots[i].pin = pin;
+			interrupt_slots[i].handler = handler;
+			// DOUT falls when a reading is ready.
+			attachInterrupt(digitalPinToInterrupt(pin), slot_isr[i], FALLING);
+			return true;
+		}
+	}
+	return false;
+}
+
+static void detach_slots(void* object) {
+	for (byte i = 0; i < HX711_MAX_INTERRUPTS; i++) {
+		if (interrupt_slots[i].handler != NULL && interrupt_slots[i].object == object) {
+			detachInterrupt(digitalPinToInterrupt(interrupt_slots[i].pin));
+			interrupt_slots[i].handler = NULL;
+		}
+	}
+}
+
+void HX711::set_buffer(HX711Sample* samples, byte size) {
+	end_interrupt();
+	buffer = samples;
+	buffer_size = size;
+	head = 0;
+	tail = 0;
+	overruns = 0;
+}
+
+void HX711_ISR_ATTR HX711::push_sample(long value, unsigned long time) {
+	byte next = head + 1;
+	if (next == buffer_size) {
+		next = 0;
+	}
+	// Keep the older readings, the reader may be taking the oldest right now.
+	if (next == tail) {
+		overruns++;
+		return;
+	}
+	buffer[head].value = value;
+	buffer[head].time = time;
+	head = next;
+}
+
+void HX711_ISR_ATTR HX711::on_interrupt(void* object) {
+	HX711* chip = static_cast<HX711*>(object);
+	// Clocking the data out makes DOUT fall again, leaving one more interrupt to ignore.
+	if (!chip->is_ready()) {
+		return;
+	}
+	chip->push_sample(chip->shift_in(), millis());
+}
+
+bool HX711::begin_interrupt() {
+	end_interrupt();
+	if (buffer == NULL || buffer_size < 2) {
+		return false;
+	}
+	if (!attach_slot(DOUT, on_interrupt, this)) {
+		return false;
+	}
+	// A reading that was ready before the interrupt was attached has already had its falling edge.
+	CRITICAL_SECTION_BEGIN
+	on_interrupt(this);
+	CRITICAL_SECTION_END
+	return true;
+}
+
+void HX711::end_interrupt() {
+	detach_slots(this);
+}
+
+byte HX711::available() {
+	byte h = head;
+	return h >= tail ? h - tail : h + buffer_size - tail;
+}
+
+bool HX711::read_sample(HX711Sample& sample) {
+	byte t = tail;
+	if (t == head) {
+		return false;
+	}
+	sample.value = buffer[t].value;
+	sample.time = buffer[t].time;
+	if (++t == buffer_size) {
+		t = 0;
+	}
+	tail = t;
+	return true;
+}
+
+unsigned int HX711::get_overruns() {
+	unsigned int count;
+	CRITICAL_SECTION_BEGIN
+	count = overruns;
+	CRITICAL_SECTION_END
+	return count;
+}
+
+HX711Group::HX711Group(HX711* chips, byte count) : chips(chips), count(count) {
+}
+
+bool HX711Group::is_ready() {
+	for (byte i = 0; i < count; i++) {
+		if (!chips[i].is_ready()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void HX711_ISR_ATTR HX711Group::shift_in(long* values) {
+	byte pd_sck = chips[0].PD_SCK;
+
+	for (byte i = 0; i < count; i++) {
+		values[i] = 0;
+	}
+
+	// Pulse the clock pin 24 times, reading a bit from every chip each time.
+	for (byte bit = 0; bit < 24; bit++) {
+		digitalWrite(pd_sck, HIGH);
+		#if FAST_CPU
+		delayMicroseconds(1);
+		#endif
+		for (byte i = 0; i < count; i++) {
+			values[i] = (values[i] << 1) | digitalRead(chips[i].DOUT);
+		}
+		digitalWrite(pd_sck, LOW);
+		#if FAST_CPU
+		delayMicroseconds(1);
+		#endif
+	}
+
+	// Set the channel and the gain factor for the next reading using the clock pin.
+	for (unsigned int i = 0; i < chips[0].GAIN; i++) {
+		digitalWrite(pd_sck, HIGH);
+		#if ARCH_ESPRESSIF
+		delayMicroseconds(1);
+		#endif
+		digitalWrite(pd_sck, LOW);
+		#if ARCH_ESPRESSIF
+		delayMicroseconds(1);
+		#endif
+	}
+
+	// Sign extend the 24 bit readings
+	for (byte i = 0; i < count; i++) {
+		if (values[i] & 0x800000L) {
+			values[i] -= 0x1000000L;
+		}
+	}
+}
+
+void HX711Group::read(long* values) {
+	// Wait for all the chips to become ready.
+	while (!is_ready()) {
+		delay(0);
+	}
+
+	// See HX711::read() about the critical section.
+	CRITICAL_SECTION_BEGIN
+	shift_in(values);
+	CRITICAL_SECTION_END
+}
+
+void HX711_ISR_ATTR HX711Group::on_interrupt(void* object) {
+	HX711Group* group = static_cast<HX711Group*>(object);
+	long values[HX711_MAX_INTERRUPTS];
+
+	// Wait for the DOUT of the last chip to fall.
+	if (!group->is_ready()) {
+		return;
+	}
+	group->shift_in(values);
+	unsigned long time = millis();
+	for (byte i = 0; i < group->count; i++) {
+		group->chips[i].push_sample(values[i], time);
+	}
+}
+
+bool HX711Group::begin_interrupt() {
+	end_interrupt();
+	if (count > HX711_MAX_INTERRUPTS) {
+		return false;
+	}
+	for (byte i = 0; i < count; i++) {
+		if (chips[i].buffer == NULL || chips[i].buffer_size < 2 ||
+				!attach_slot(chips[i].DOUT, on_interrupt, this)) {
+			end_interrupt();
+			return false;
+		}
+	}
+	// Readings that were ready before the interrupts were attached have already had their falling edges.
+	CRITICAL_SECTION_BEGIN
+	on_interrupt(this);
+	CRITICAL_SECTION_END
+	return true;
+}
+
+void HX711Group::end_interrupt() {
+	detach_slots(this);
+}
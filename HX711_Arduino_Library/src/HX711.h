@@ -16,8 +16,20 @@
 #include "WProgram.h"
 #endif
 
+// Number of DOUT pins that can be watched by interrupts at the same time
+#define HX711_MAX_INTERRUPTS 8
+
+// A reading taken in interrupt mode, with the millis() it was taken at
+struct HX711Sample
+{
+	long value;
+	unsigned long time;
+};
+
 class HX711
 {
+	friend class HX711Group;
+
 	private:
 		byte PD_SCK;	// Power Down and Serial Clock Input Pin
 		byte DOUT;		// Serial Data Output Pin
@@ -25,6 +37,18 @@ class HX711
 		long OFFSET = 0;	// used for tare weight
 		float SCALE = 1;	// used to return weight in grams, kg, ounces, whatever
 
+		// ring buffer filled in interrupt mode
+		HX711Sample* buffer = NULL;
+		byte buffer_size = 0;
+		volatile byte head = 0;
+		volatile byte tail = 0;
+		volatile unsigned int overruns = 0;
+
+		// clocks out a reading, the chip must be ready
+		long shift_in();
+		void push_sample(long value, unsigned long time);
+		static void on_interrupt(void* chip);
+
 	public:
 
 		HX711();
@@ -86,6 +110,55 @@ class HX711
 
 		// wakes up the chip after power down mode
 		void power_up();
+
+		// set the ring buffer that readings go to in interrupt mode
+		void set_buffer(HX711Sample* samples, byte size);
+
+		// read the chip from a DOUT falling edge interrupt, into the buffer set by set_buffer()
+		// returns false if DOUT is not an interrupt pin, or all interrupts are in use
+		bool begin_interrupt();
+
+		// stop reading from the interrupt
+		void end_interrupt();
+
+		// number of readings waiting in the buffer
+		byte available();
+
+		// take the oldest reading from the buffer; returns false if it is empty
+		bool read_sample(HX711Sample& sample);
+
+		// number of readings lost because the buffer was full
+		unsigned int get_overruns();
+};
+
+// Several HX711 that share one PD_SCK pin, read at the same time.
+// Call begin() on each chip first, with the common PD_SCK pin. All the chips are
+// set to the gain of the first one, since they all see the same clock pulses.
+class HX711Group
+{
+	private:
+		HX711* chips;
+		byte count;
+
+		void shift_in(long* values);
+		static void on_interrupt(void* group);
+
+	public:
+
+		HX711Group(HX711* chips, byte count);
+
+		// Check if all the chips are ready
+		bool is_ready();
+
+		// waits for all the chips to be ready and reads them, clocking them all at once
+		void read(long* values);
+
+		// read all the chips when the last DOUT falls, into the buffer of each chip
+		// (see HX711::set_buffer()), with the same timestamp. Each DOUT must be an interrupt pin.
+		bool begin_interrupt();
+
+		// stop reading from the interrupts
+		void end_interrupt();
 };
 
 #endif /* HX711_h */
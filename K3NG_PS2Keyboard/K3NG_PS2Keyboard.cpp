@@ -58,11 +58,15 @@
 #endif
 #include "K3NG_PS2Keyboard.h"
 
-#define BUFFER_SIZE 45
-static volatile uint8_t buffer[BUFFER_SIZE];
+#if (PS2_EVENT_BUFFER_SIZE & (PS2_EVENT_BUFFER_SIZE - 1)) || PS2_EVENT_BUFFER_SIZE > 256
+  #error "PS2_EVENT_BUFFER_SIZE must be a power of two, at most 256"
+#endif
+static volatile PS2KeyEvent events[PS2_EVENT_BUFFER_SIZE];
 static volatile uint8_t head, tail;
+static volatile uint16_t dropped;
 static uint8_t ps2Keyboard_DataPin;
-static char ps2Keyboard_CharBuffer=0;
+
+static char decode_scan_code(uint8_t s, uint8_t *modifiers);
 
 // The ISR for the external interrupt
 void k3ng_ps2interrupt(void)
@@ -86,30 +90,24 @@ void k3ng_ps2interrupt(void)
 	}
 	bitcount++;
 	if (bitcount == 11) {
-		uint8_t i = head + 1;
-		if (i >= BUFFER_SIZE) i = 0;
-		if (i != tail) {
-			buffer[i] = incoming;
-			head = i;
+		uint8_t modifiers;
+		char c = decode_scan_code(incoming, &modifiers);
+		if (c) {
+			uint8_t i = (head + 1) & (PS2_EVENT_BUFFER_SIZE - 1);
+			if (i != tail) {
+				events[i].key = c;
+				events[i].modifiers = modifiers;
+				events[i].time_us = micros();
+				head = i;
+			} else {
+				dropped++;
+			}
 		}
 		bitcount = 0;
 		incoming = 0;
 	}
 }
 
-static inline uint8_t get_scan_code(void)
-{
-	uint8_t c, i;
-
-	i = tail;
-	if (i == head) return 0;
-	i++;
-	if (i >= BUFFER_SIZE) i = 0;
-	c = buffer[i];
-	tail = i;
-	return c;
-}
-
 // http://www.quadibloc.com/comp/scan.htm
 // http://www.computer-engineering.org/ps2keyboard/scancodes2.html
 
@@ -365,106 +363,129 @@ const PROGMEM unsigned char scan2ascii_alt[] =
 
 //--------------------------------------------------
 
-static char get_ascii_code(void)
+// Runs in the clock interrupt for every received scan code. Returns the
+// character completed by it, or 0, and the modifiers held down.
+static char decode_scan_code(uint8_t s, uint8_t *modifiers)
 {
 	static uint8_t state=0;
-	uint8_t s;
 	char c;
 
-	while (1) {
-		s = get_scan_code();
-		if (!s) return 0;
-		if (s == 0xF0) {
-			state |= BREAK;
-		} else if (s == 0xE0) {
-			state |= MODIFIER;
-		} else {
-			if (state & BREAK) {
-				if (s == 0x12) {
-					state &= ~SHIFT_L;
-				} else if (s == 0x59) {
-					state &= ~SHIFT_R;
+	if (s == 0xF0) {
+		state |= BREAK;
+	} else if (s == 0xE0) {
+		state |= MODIFIER;
+	} else {
+		if (state & BREAK) {
+			if (s == 0x12) {
+				state &= ~SHIFT_L;
+			} else if (s == 0x59) {
+				state &= ~SHIFT_R;
                                 //start K3NG modification
-				} else if (s == 0x14) {
+			} else if (s == 0x14) {
                                         state &= ~CTRL;
                                 } else if (s == 0x11) {
                                         state &= ~ALT;
                                 }
                                 // end K3NG modification
-				state &= ~(BREAK | MODIFIER);
-				continue;
-			}
-			if (s == 0x12) {
-				state |= SHIFT_L;
-				continue;
-			} else if (s == 0x59) {
-				state |= SHIFT_R;
-				continue;
-			} else if (s == 0x14) {
+			state &= ~(BREAK | MODIFIER);
+			return 0;
+		}
+		if (s == 0x12) {
+			state |= SHIFT_L;
+			return 0;
+		} else if (s == 0x59) {
+			state |= SHIFT_R;
+			return 0;
+		} else if (s == 0x14) {
                                 state |= CTRL;
-                                continue;
-			} else if (s == 0x11) {
+                                return 0;
+		} else if (s == 0x11) {
                                 state |= ALT;
-                                continue;
+                                return 0;
                         }
-			c = 0;
-			if (state & MODIFIER) {
-				switch (s) {
-				  case 0x70: c = PS2_INSERT;      break;
-				  case 0x6C: c = PS2_HOME;        break;
-				  case 0x7D: c = PS2_PAGEUP;      break;
-				  case 0x71: c = PS2_DELETE;      break;
-				  case 0x69: c = PS2_END;         break;
-				  case 0x7A: c = PS2_PAGEDOWN;    break;
-				  case 0x75: c = PS2_UPARROW;     break;
-				  case 0x6B: c = PS2_LEFTARROW;   break;
-				  case 0x72: c = PS2_DOWNARROW;   break;
-				  case 0x74: c = PS2_RIGHTARROW;  break;
-				  case 0x4A: c = '/';             break;
-				  case 0x5A: c = PS2_ENTER;       break;
-				  default: break;
-				}
-			} else if (state & (SHIFT_L | SHIFT_R)) {
-				if (s < sizeof(scan2ascii_shift))
-					c = pgm_read_byte(scan2ascii_shift + s);
+		c = 0;
+		if (state & MODIFIER) {
+			switch (s) {
+			  case 0x70: c = PS2_INSERT;      break;
+			  case 0x6C: c = PS2_HOME;        break;
+			  case 0x7D: c = PS2_PAGEUP;      break;
+			  case 0x71: c = PS2_DELETE;      break;
+			  case 0x69: c = PS2_END;         break;
+			  case 0x7A: c = PS2_PAGEDOWN;    break;
+			  case 0x75: c = PS2_UPARROW;     break;
+			  case 0x6B: c = PS2_LEFTARROW;   break;
+			  case 0x72: c = PS2_DOWNARROW;   break;
+			  case 0x74: c = PS2_RIGHTARROW;  break;
+			  case 0x4A: c = '/';             break;
+			  case 0x5A: c = PS2_ENTER;       break;
+			  default: break;
+			}
+		} else if (state & (SHIFT_L | SHIFT_R)) {
+			if (s < sizeof(scan2ascii_shift))
+				c = pgm_read_byte(scan2ascii_shift + s);
                         //start K3NG modification
                         } else if ((state & CTRL)) {
-				if (s < sizeof(scan2ascii_ctrl))
-					c = pgm_read_byte(scan2ascii_ctrl + s);
+			if (s < sizeof(scan2ascii_ctrl))
+				c = pgm_read_byte(scan2ascii_ctrl + s);
                         } else if ((state & ALT)) {
-				if (s < sizeof(scan2ascii_alt))
-					c = pgm_read_byte(scan2ascii_alt + s);
+			if (s < sizeof(scan2ascii_alt))
+				c = pgm_read_byte(scan2ascii_alt + s);
                         //end K3NG modification
-			} else {
-				if (s < sizeof(scan2ascii_noshift))
-					c = pgm_read_byte(scan2ascii_noshift + s);
-			}
-			state &= ~(BREAK | MODIFIER);
-			if (c) return c;
+		} else {
+			if (s < sizeof(scan2ascii_noshift))
+				c = pgm_read_byte(scan2ascii_noshift + s);
 		}
+		state &= ~(BREAK | MODIFIER);
+		*modifiers = state & (SHIFT_L | SHIFT_R | CTRL | ALT);
+		return c;
 	}
+	return 0;
 }
 
 bool K3NG_PS2Keyboard::available() {
-	if (ps2Keyboard_CharBuffer) return true;
-	ps2Keyboard_CharBuffer = get_ascii_code();
-	if (ps2Keyboard_CharBuffer) return true;
-	return false;
+	return head != tail;
 }
 
 int K3NG_PS2Keyboard::read() {
-	char result;
+	uint8_t i = tail;
 
-	result = ps2Keyboard_CharBuffer;
-	if (result) {
-		ps2Keyboard_CharBuffer = 0;
-	} else {
-		result = get_ascii_code();
-	}
-	if (!result) return -1;
+	if (i == head) return -1;
+	i = (i + 1) & (PS2_EVENT_BUFFER_SIZE - 1);
+	char result = events[i].key;
+	tail = i;
 	return result;
 }
 
+uint8_t K3NG_PS2Keyboard::readEvents(PS2KeyEvent *buf, uint8_t n) {
+	uint8_t i = tail;
+	uint8_t count = 0;
+
+	// only the interrupt moves head, and it never writes past tail
+	while (count < n && i != head) {
+		i = (i + 1) & (PS2_EVENT_BUFFER_SIZE - 1);
+		buf[count].key = events[i].key;
+		buf[count].modifiers = events[i].modifiers;
+		buf[count].time_us = events[i].time_us;
+		tail = i;
+		count++;
+	}
+	return count;
+}
+
+uint16_t K3NG_PS2Keyboard::droppedEvents() {
+#if !defined(ARDUINO_SAM_DUE)
+	uint8_t oldSREG = SREG;
+	cli();
+	uint16_t n = dropped;
+	SREG = oldSREG;
+#else
+	noInterrupts();
+	uint16_t n = dropped;
+	interrupts();
+#endif
+	return n;
+}
+
 K3NG_PS2Keyboard::K3NG_PS2Keyboard() {
   // nothing to do here, begin() does it all
 }
@@ -532,6 +553,7 @@ void K3NG_PS2Keyboard::begin(uint8_t dataPin, uint8_t irq_pin) {
   }
   head = 0;
   tail = 0;
+  dropped = 0;
   attachInterrupt(irq_num, k3ng_ps2interrupt, FALLING);
 }
 
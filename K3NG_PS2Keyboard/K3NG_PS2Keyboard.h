@@ -485,6 +485,25 @@ K3NG Updates
 //#define PS2_KC_BKSP   0x66
 
 
+// Key events are decoded in the clock interrupt into a ring of this many
+// entries (power of two), so keystrokes are kept while loop() is busy.
+#ifndef PS2_EVENT_BUFFER_SIZE
+#define PS2_EVENT_BUFFER_SIZE 32
+#endif
+
+// Modifier bits of PS2KeyEvent::modifiers
+#define PS2_MODIFIER_SHIFT_L  0x04
+#define PS2_MODIFIER_SHIFT_R  0x08
+#define PS2_MODIFIER_CTRL     0x10
+#define PS2_MODIFIER_ALT      0x20
+
+struct PS2KeyEvent {
+  uint8_t key;        // the byte read() returns for this keystroke
+  uint8_t modifiers;  // PS2_MODIFIER_* keys held down
+  uint32_t time_us;   // micros() when the key's scan code was received
+};
+
+
 /**
  * Purpose: Provides an easy access to PS2 keyboards
  * Author:  Christian Weichel
@@ -514,6 +533,17 @@ class K3NG_PS2Keyboard {
      * If there is no char availble, -1 is returned.
      */
     static int read();
+
+    /**
+     * Copies up to n key events, oldest first, into buf and removes them.
+     * Returns the number of events copied.
+     */
+    static uint8_t readEvents(PS2KeyEvent *buf, uint8_t n);
+
+    /**
+     * Returns the number of key events lost because the buffer was full.
+     */
+    static uint16_t droppedEvents();
 };
 
 // interrupt pins for known boards
@@ -66,6 +66,7 @@ Keyboard_::Keyboard_(void)
 	static HIDSubDescriptor node(_hidReportDescriptor, sizeof(_hidReportDescriptor));
 	HID().AppendDescriptor(&node);
 	_asciimap = KeyboardLayout_en_US;
+	_fastTyping = false;
 }
 
 void Keyboard_::begin(const uint8_t *layout)
@@ -84,6 +85,29 @@ void Keyboard_::sendReport(KeyReport* keys)
 
 uint8_t USBPutChar(uint8_t c);
 
+// asciiKey() translates a printing character to its key code through the
+// current layout and returns the modifiers it needs, or 0 if the layout has
+// no key for it.
+uint8_t Keyboard_::asciiKey(uint8_t c, uint8_t *modifiers)
+{
+	uint8_t k = pgm_read_byte(_asciimap + c);
+	*modifiers = 0;
+	if (!k) {
+		return 0;
+	}
+	if ((k & ALT_GR) == ALT_GR) {
+		*modifiers = 0x40;	// AltGr = right Alt
+		k &= 0x3F;
+	} else if ((k & SHIFT) == SHIFT) {
+		*modifiers = 0x02;	// the left shift modifier
+		k &= 0x7F;
+	}
+	if (k == ISO_REPLACEMENT) {
+		k = ISO_KEY;
+	}
+	return k;
+}
+
 // press() adds the specified key (printing, non-printing, or modifier)
 // to the persistent key report and sends the report.  Because of the way
 // USB HID works, the host acts like the key remains pressed until we
@@ -97,21 +121,13 @@ size_t Keyboard_::press(uint8_t k)
 		_keyReport.modifiers |= (1<<(k-128));
 		k = 0;
 	} else {				// it's a printing key
-		k = pgm_read_byte(_asciimap + k);
+		uint8_t modifiers;
+		k = asciiKey(k, &modifiers);
 		if (!k) {
 			setWriteError();
 			return 0;
 		}
-		if ((k & ALT_GR) == ALT_GR) {
-			_keyReport.modifiers |= 0x40;   // AltGr = right Alt
-			k &= 0x3F;
-		} else if ((k & SHIFT) == SHIFT) {
-			_keyReport.modifiers |= 0x02;	// the left shift modifier
-			k &= 0x7F;
-		}
-		if (k == ISO_REPLACEMENT) {
-			k = ISO_KEY;
-		}
+		_keyReport.modifiers |= modifiers;
 	}
 
 	// Add k to the key report only if it's not already present
@@ -147,20 +163,12 @@ size_t Keyboard_::release(uint8_t k)
 		_keyReport.modifiers &= ~(1<<(k-128));
 		k = 0;
 	} else {				// it's a printing key
-		k = pgm_read_byte(_asciimap + k);
+		uint8_t modifiers;
+		k = asciiKey(k, &modifiers);
 		if (!k) {
 			return 0;
 		}
-		if ((k & ALT_GR) == ALT_GR) {
-			_keyReport.modifiers &= ~(0x40);   // AltGr = right Alt
-			k &= 0x3F;
-		} else if ((k & SHIFT) == SHIFT) {
-			_keyReport.modifiers &= ~(0x02);	// the left shift modifier
-			k &= 0x7F;
-		}
-		if (k == ISO_REPLACEMENT) {
-			k = ISO_KEY;
-		}
+		_keyReport.modifiers &= ~modifiers;
 	}
 
 	// Test the key report to see if k is present.  Clear it if it exists.
@@ -194,8 +202,70 @@ size_t Keyboard_::write(uint8_t c)
 	return p;		// just return the result of press() since release() almost always returns 1
 }
 
+// setFastTyping() makes write(buffer, size), and so print(), pack runs of
+// printing characters into a single report: up to six distinct keys that
+// need the same modifiers are pressed together and released together, so a
+// string takes two reports per run instead of two per character. Hosts
+// report keys pressed in one report in slot order, which is the order of
+// the string. A repeated character starts a new run, since it must be
+// released before it can be pressed again.
+void Keyboard_::setFastTyping(bool enable)
+{
+	_fastTyping = enable;
+}
+
 size_t Keyboard_::write(const uint8_t *buffer, size_t size) {
 	size_t n = 0;
+	while (_fastTyping && size) {
+		KeyReport report = _keyReport;	// keys held with press() stay down
+		uint8_t runModifiers = 0;
+		uint8_t count = 0;
+		while (size) {
+			if (*buffer == '\r') {
+				buffer++;
+				size--;
+				continue;
+			}
+			if (*buffer >= 128) {
+				break;		// modifiers and non-printing keys go through write()
+			}
+			uint8_t modifiers;
+			uint8_t k = asciiKey(*buffer, &modifiers);
+			if (!k || (count && modifiers != runModifiers)) {
+				break;
+			}
+			uint8_t i, slot = 6;
+			for (i=0; i<6; i++) {
+				if (report.keys[i] == k) {
+					break;
+				}
+				if (report.keys[i] == 0x00 && slot == 6) {
+					slot = i;
+				}
+			}
+			if (i < 6 || slot == 6) {
+				break;		// repeated key, or no free slot left
+			}
+			report.keys[slot] = k;
+			runModifiers = modifiers;
+			count++;
+			buffer++;
+			size--;
+		}
+		if (count) {
+			report.modifiers |= runModifiers;
+			sendReport(&report);		// Keydown for the whole run
+			sendReport(&_keyReport);	// Keyup
+			n += count;
+		} else if (size) {
+			if (!write(*buffer)) {
+				return n;
+			}
+			n++;
+			buffer++;
+			size--;
+		}
+	}
 	while (size--) {
 		if (*buffer != '\r') {
 			if (write(*buffer)) {
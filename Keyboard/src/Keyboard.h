@@ -134,7 +134,9 @@ class Keyboard_ : public Print
 private:
   KeyReport _keyReport;
   const uint8_t *_asciimap;
+  bool _fastTyping;
   void sendReport(KeyReport* keys);
+  uint8_t asciiKey(uint8_t c, uint8_t *modifiers);
 public:
   Keyboard_(void);
   void begin(const uint8_t *layout = KeyboardLayout_en_US);
@@ -144,6 +146,7 @@ public:
   size_t press(uint8_t k);
   size_t release(uint8_t k);
   void releaseAll(void);
+  void setFastTyping(bool enable);
 };
 extern Keyboard_ Keyboard;
 
@@ -2,22 +2,36 @@
 
 #include "LiquidCrystal_I2C.h"
 #include <inttypes.h>
+#include <string.h>
 #if defined(ARDUINO) && ARDUINO >= 100
 
 #include "Arduino.h"
 
 #define printIIC(args)	Wire.write(args)
-inline size_t LiquidCrystal_I2C::write(uint8_t value) {
-	send(value, Rs);
-	return 1;
+size_t LiquidCrystal_I2C::write(uint8_t value) {
+	return write(&value, 1);
+}
+
+// a run of characters goes out in as few transmissions as the Wire buffer allows
+size_t LiquidCrystal_I2C::write(const uint8_t *buffer, size_t size) {
+	bool burst = beginBurst();
+	for (size_t i = 0; i < size; i++) {
+		writeCached(buffer[i]);
+	}
+	syncVisibleCursor();
+	if (burst) endBurst();
+	return size;
 }
 
 #else
 #include "WProgram.h"
 
 #define printIIC(args)	Wire.send(args)
-inline void LiquidCrystal_I2C::write(uint8_t value) {
-	send(value, Rs);
+void LiquidCrystal_I2C::write(uint8_t value) {
+	bool burst = beginBurst();
+	writeCached(value);
+	syncVisibleCursor();
+	if (burst) endBurst();
 }
 
 #endif
@@ -50,6 +64,16 @@ LiquidCrystal_I2C::LiquidCrystal_I2C(uint8_t lcd_Addr,uint8_t lcd_cols,uint8_t l
   _cols = lcd_cols;
   _rows = lcd_rows;
   _backlightval = LCD_NOBACKLIGHT;
+  _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+  _displaymode = LCD_ENTRYLEFT | LCD_ENTRYSHIFTDECREMENT;
+  _displaycontrol = 0;
+  _cursorAddr = 0;
+  _lcdAddr = 0;
+  _shadowValid = false;
+  _lcdAddrValid = false;
+  _cgram = false;
+  _burst = false;
+  _burstLen = 0;
 }
 
 void LiquidCrystal_I2C::init(){
@@ -139,7 +163,11 @@ void LiquidCrystal_I2C::setCursor(uint8_t col, uint8_t row){
 	if ( row > _numlines ) {
 		row = _numlines-1;    // we count rows starting w/0
 	}
-	command(LCD_SETDDRAMADDR | (col + row_offsets[row]));
+	// the address is sent with the next character that differs from the
+	// display, or now if the cursor is shown
+	_cursorAddr = (col + row_offsets[row]) & 0x7f;
+	_cgram = false;
+	syncVisibleCursor();
 }
 
 // Turn the display on/off (quickly)
@@ -229,8 +257,112 @@ void LiquidCrystal_I2C::backlight(void) {
 
 /*********** mid level commands, for sending data/cmds */
 
-inline void LiquidCrystal_I2C::command(uint8_t value) {
+void LiquidCrystal_I2C::command(uint8_t value) {
+	if (value & LCD_SETDDRAMADDR) {
+		_cursorAddr = value & 0x7f;
+		_lcdAddr = _cursorAddr;
+		_lcdAddrValid = true;
+		_cgram = false;
+	} else if (value & LCD_SETCGRAMADDR) {
+		_cgram = true;
+		_lcdAddrValid = false;
+	} else if (value & LCD_FUNCTIONSET) {
+		// no effect on the address
+	} else if (value & LCD_CURSORSHIFT) {
+		if (!(value & LCD_DISPLAYMOVE)) {
+			// moves the address counter of the controller, from where it is now
+			syncCursor();
+			_cursorAddr = nextAddr(_cursorAddr, value & LCD_MOVERIGHT);
+			_lcdAddr = _cursorAddr;
+		}
+	} else if (value & LCD_DISPLAYCONTROL) {
+		if (value & (LCD_CURSORON | LCD_BLINKON)) syncCursor();
+	} else if (value & LCD_ENTRYMODESET) {
+		_displaymode = value & (LCD_ENTRYLEFT | LCD_ENTRYSHIFTINCREMENT);
+	} else if (value & LCD_RETURNHOME) {
+		_cursorAddr = 0;
+		_lcdAddr = 0;
+		_lcdAddrValid = true;
+		_cgram = false;
+	} else if (value & LCD_CLEARDISPLAY) {
+		memset(_ddram, ' ', sizeof(_ddram));
+		_shadowValid = true;
+		_displaymode |= LCD_ENTRYLEFT; // clear also sets increment mode
+		_cursorAddr = 0;
+		_lcdAddr = 0;
+		_lcdAddrValid = true;
+		_cgram = false;
+	}
+	bool burst = beginBurst();
 	send(value, 0);
+	if (burst) endBurst();
+}
+
+
+/*********** display data RAM shadow */
+
+// index of a DDRAM address in _ddram, -1 if there is no such address
+int LiquidCrystal_I2C::ddramIndex(uint8_t addr) {
+	if (!(_displayfunction & LCD_2LINE)) {
+		return (addr < LCD_DDRAM_SIZE) ? addr : -1;
+	}
+	// two lines of 40, at 0x00 and 0x40
+	if (addr < LCD_DDRAM_SIZE / 2) return addr;
+	if ((addr >= 0x40) && (addr < 0x40 + LCD_DDRAM_SIZE / 2)) return addr - 0x40 + LCD_DDRAM_SIZE / 2;
+	return -1;
+}
+
+// the address after a character, as the controller counts
+uint8_t LiquidCrystal_I2C::nextAddr(uint8_t addr, bool increment) {
+	if (!(_displayfunction & LCD_2LINE)) {
+		if (increment) return (addr + 1 >= LCD_DDRAM_SIZE) ? 0 : addr + 1;
+		return (addr == 0) ? LCD_DDRAM_SIZE - 1 : addr - 1;
+	}
+	if (increment) {
+		if (addr == LCD_DDRAM_SIZE / 2 - 1) return 0x40;
+		if (addr == 0x40 + LCD_DDRAM_SIZE / 2 - 1) return 0x00;
+		return addr + 1;
+	}
+	if (addr == 0x00) return 0x40 + LCD_DDRAM_SIZE / 2 - 1;
+	if (addr == 0x40) return LCD_DDRAM_SIZE / 2 - 1;
+	return addr - 1;
+}
+
+// move the address counter of the controller to the cursor, if it is elsewhere
+void LiquidCrystal_I2C::syncCursor() {
+	if (!_cgram && (!_lcdAddrValid || (_lcdAddr != _cursorAddr))) {
+		command(LCD_SETDDRAMADDR | _cursorAddr);
+	}
+}
+
+// the cursor on the display must follow skipped characters, if it is shown
+void LiquidCrystal_I2C::syncVisibleCursor() {
+	if (_displaycontrol & (LCD_CURSORON | LCD_BLINKON)) syncCursor();
+}
+
+void LiquidCrystal_I2C::writeCached(uint8_t value) {
+	if (_cgram) {
+		send(value, Rs); // custom character rows, the controller counts
+		return;
+	}
+	bool increment = _displaymode & LCD_ENTRYLEFT;
+	int index = ddramIndex(_cursorAddr);
+	// with autoscroll every character also shifts the display, so none is skipped
+	if (_shadowValid && (index >= 0) && (_ddram[index] == value) &&
+	    !(_displaymode & LCD_ENTRYSHIFTINCREMENT)) {
+		_cursorAddr = nextAddr(_cursorAddr, increment);
+		return;
+	}
+	syncCursor();
+	send(value, Rs);
+	if (index >= 0) {
+		_ddram[index] = value;
+	} else {
+		_shadowValid = false; // where the controller puts it is unknown
+		_lcdAddrValid = false;
+	}
+	_cursorAddr = nextAddr(_cursorAddr, increment);
+	_lcdAddr = _cursorAddr;
 }
 
 
@@ -238,6 +370,13 @@ inline void LiquidCrystal_I2C::command(uint8_t value) {
 
 // write either command or data
 void LiquidCrystal_I2C::send(uint8_t value, uint8_t mode) {
+	if (_burst && (_burstLen + 6 > LCD_I2C_BURST_BYTES)) {
+		// Wire buffer full, continue in the next transmission
+		Wire.endTransmission();
+		delayMicroseconds(50);
+		Wire.beginTransmission(_Addr);
+		_burstLen = 0;
+	}
 	uint8_t highnib=value&0xf0;
 	uint8_t lownib=(value<<4)&0xf0;
        write4bits((highnib)|mode);
@@ -249,7 +388,28 @@ void LiquidCrystal_I2C::write4bits(uint8_t value) {
 	pulseEnable(value);
 }
 
+// in a burst the expander writes are collected in one transmission; the I2C
+// bus is slow enough to give the enable pulse and settle times by itself
+bool LiquidCrystal_I2C::beginBurst() {
+	if (_burst) return false;
+	Wire.beginTransmission(_Addr);
+	_burst = true;
+	_burstLen = 0;
+	return true;
+}
+
+void LiquidCrystal_I2C::endBurst() {
+	Wire.endTransmission();
+	_burst = false;
+	delayMicroseconds(50);		// commands need > 37us to settle
+}
+
 void LiquidCrystal_I2C::expanderWrite(uint8_t _data){                                        
+	if (_burst) {
+		printIIC((int)(_data) | _backlightval);
+		_burstLen++;
+		return;
+	}
 	Wire.beginTransmission(_Addr);
 	printIIC((int)(_data) | _backlightval);
 	Wire.endTransmission();   
@@ -257,10 +417,10 @@ void LiquidCrystal_I2C::expanderWrite(uint8_t _data){
 
 void LiquidCrystal_I2C::pulseEnable(uint8_t _data){
 	expanderWrite(_data | En);	// En high
-	delayMicroseconds(1);		// enable pulse must be >450ns
+	if (!_burst) delayMicroseconds(1);		// enable pulse must be >450ns
 	
 	expanderWrite(_data & ~En);	// En low
-	delayMicroseconds(50);		// commands need > 37us to settle
+	if (!_burst) delayMicroseconds(50);		// commands need > 37us to settle
 } 
 
 
@@ -48,6 +48,21 @@
 #define LCD_BACKLIGHT 0x08
 #define LCD_NOBACKLIGHT 0x00
 
+// size of the controller's display data RAM, for the shadow copy
+#define LCD_DDRAM_SIZE 80
+
+// bytes per I2C transmission for bursts of nibble strobes (6 per character),
+// at most the Wire buffer size
+#ifndef LCD_I2C_BURST_BYTES
+#if defined(BUFFER_LENGTH)
+#define LCD_I2C_BURST_BYTES BUFFER_LENGTH
+#elif defined(I2C_BUFFER_LENGTH)
+#define LCD_I2C_BURST_BYTES I2C_BUFFER_LENGTH
+#else
+#define LCD_I2C_BURST_BYTES 32
+#endif
+#endif
+
 #define En B00000100  // Enable bit
 #define Rw B00000010  // Read/Write bit
 #define Rs B00000001  // Register select bit
@@ -80,6 +95,7 @@ public:
   void setCursor(uint8_t, uint8_t); 
 #if defined(ARDUINO) && ARDUINO >= 100
   virtual size_t write(uint8_t);
+  virtual size_t write(const uint8_t *buffer, size_t size);
 #else
   virtual void write(uint8_t);
 #endif
@@ -113,6 +129,13 @@ private:
   void write4bits(uint8_t);
   void expanderWrite(uint8_t);
   void pulseEnable(uint8_t);
+  bool beginBurst();
+  void endBurst();
+  void writeCached(uint8_t);
+  void syncCursor();
+  void syncVisibleCursor();
+  int ddramIndex(uint8_t);
+  uint8_t nextAddr(uint8_t, bool);
   uint8_t _Addr;
   uint8_t _displayfunction;
   uint8_t _displaycontrol;
@@ -121,6 +144,16 @@ private:
   uint8_t _cols;
   uint8_t _rows;
   uint8_t _backlightval;
+  // shadow of the display data RAM and of the address counter, so that
+  // characters already on the display are not sent again
+  uint8_t _ddram[LCD_DDRAM_SIZE];
+  uint8_t _cursorAddr;		// where the next character goes
+  uint8_t _lcdAddr;		// address counter of the controller
+  bool _shadowValid;		// _ddram matches the display (after clear())
+  bool _lcdAddrValid;		// _lcdAddr is known
+  bool _cgram;			// data goes to CGRAM (createChar())
+  bool _burst;			// expander writes are collected in one transmission
+  uint8_t _burstLen;		// bytes in the current transmission
 };
 
 #endif
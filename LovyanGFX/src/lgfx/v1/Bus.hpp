@@ -21,6 +21,14 @@ Contributors:
 
 #include "misc/enum.hpp"
 
+/// Define LGFX_PERF_COUNTERS to update the performance counters of Bus_Counter and of the panels.
+/// Without it, the counters stay at zero and cost nothing.
+#if defined (LGFX_PERF_COUNTERS)
+ #define LGFX_PERF_COUNT(expr) do { expr; } while (0)
+#else
+ #define LGFX_PERF_COUNT(expr) do {} while (0)
+#endif
+
 namespace lgfx
 {
  inline namespace v1
@@ -150,6 +158,11 @@ namespace lgfx
   {
     bus_type_t busType(void) const override { return bus_type_t::bus_image_push; }
     virtual void setImageBuffer(void* buffer, color_depth_t depth) { (void)buffer; (void)depth; }
+
+    /// For double buffering : buffer is shown from the start of the next refresh,
+    /// until then isImageBufferPending() is true and the previous buffer is still in use.
+    virtual void setNextImageBuffer(void* buffer, color_depth_t depth) { setImageBuffer(buffer, depth); }
+    virtual bool isImageBufferPending(void) const { return false; }
     virtual void setBrightness(uint8_t brightness) { (void)brightness; }
     virtual void setInvert(uint8_t invert) { (void)invert; }
   };
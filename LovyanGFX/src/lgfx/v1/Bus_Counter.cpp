@@ -0,0 +1,112 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+
+#include "Bus_Counter.hpp"
+
+#include "misc/pixelcopy.hpp"
+#include "platforms/common.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  void Bus_Counter::beginTransaction(void)
+  {
+    LGFX_PERF_COUNT(++_counter.transactions);
+    _bus->beginTransaction();
+  }
+
+  void Bus_Counter::wait(void)
+  {
+#if defined (LGFX_PERF_COUNTERS)
+    if (_bus->busy())
+    {
+      auto us = micros();
+      _bus->wait();
+      _counter.wait_us += micros() - us;
+      return;
+    }
+#endif
+    _bus->wait();
+  }
+
+  void Bus_Counter::addDMAQueue(const uint8_t* data, uint32_t length)
+  {
+    LGFX_PERF_COUNT(_counter.write_bytes += length; ++_counter.dma_transfers);
+    _bus->addDMAQueue(data, length);
+  }
+
+  bool Bus_Counter::writeCommand(uint32_t data, uint_fast8_t bit_length)
+  {
+    LGFX_PERF_COUNT(_counter.write_bytes += bit_length >> 3; ++_counter.commands);
+    return _bus->writeCommand(data, bit_length);
+  }
+
+  void Bus_Counter::writeData(uint32_t data, uint_fast8_t bit_length)
+  {
+    LGFX_PERF_COUNT(_counter.write_bytes += bit_length >> 3);
+    _bus->writeData(data, bit_length);
+  }
+
+  void Bus_Counter::writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count)
+  {
+    LGFX_PERF_COUNT(_counter.write_bytes += (bit_length >> 3) * count);
+    _bus->writeDataRepeat(data, bit_length, count);
+  }
+
+  void Bus_Counter::writePixels(pixelcopy_t* pc, uint32_t length)
+  {
+    LGFX_PERF_COUNT(_counter.write_bytes += (pc->dst_bits >> 3) * length);
+    _bus->writePixels(pc, length);
+  }
+
+  void Bus_Counter::writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma)
+  {
+    LGFX_PERF_COUNT(_counter.write_bytes += length; if (use_dma) { ++_counter.dma_transfers; });
+    _bus->writeBytes(data, length, dc, use_dma);
+  }
+
+  uint32_t Bus_Counter::readData(uint_fast8_t bit_length)
+  {
+    LGFX_PERF_COUNT(_counter.read_bytes += bit_length >> 3);
+    return _bus->readData(bit_length);
+  }
+
+  bool Bus_Counter::readBytes(uint8_t* dst, uint32_t length, bool use_dma)
+  {
+    LGFX_PERF_COUNT(_counter.read_bytes += length);
+    return _bus->readBytes(dst, length, use_dma);
+  }
+
+  bool Bus_Counter::readBytes(uint8_t* dst, uint32_t length, bool use_dma, bool last_nack)
+  {
+    LGFX_PERF_COUNT(_counter.read_bytes += length);
+    return _bus->readBytes(dst, length, use_dma, last_nack);
+  }
+
+  void Bus_Counter::readPixels(void* dst, pixelcopy_t* pc, uint32_t length)
+  {
+    LGFX_PERF_COUNT(_counter.read_bytes += (pc->src_bits >> 3) * length);
+    _bus->readPixels(dst, pc, length);
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
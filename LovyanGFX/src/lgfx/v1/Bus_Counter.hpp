@@ -0,0 +1,93 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "Bus.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// @brief Counts the traffic of another bus, which it forwards everything to.
+  /// Set it between the panel and the real bus : panel.setBus(&counter), counter.setBus(&bus_spi).
+  /// For the command buses (SPI, I2C, parallel). The panels that need their own bus type (RGB, HUB75) can not use it.
+  /// The counters are updated only when LGFX_PERF_COUNTERS is defined.
+  struct Bus_Counter : public IBus
+  {
+    struct counter_t
+    {
+      uint32_t write_bytes = 0;   // commands, data and pixels sent
+      uint32_t read_bytes = 0;
+      uint32_t commands = 0;      // writeCommand calls
+      uint32_t transactions = 0;  // beginTransaction calls
+      uint32_t dma_transfers = 0; // writes or queues done by DMA
+      uint32_t wait_us = 0;       // time spent in wait()
+    };
+
+    void setBus(IBus* bus) { _bus = bus; }
+    IBus* getBus(void) const { return _bus; }
+
+    const counter_t& getCounter(void) const { return _counter; }
+    void resetCounter(void) { _counter = counter_t(); }
+
+    /// @brief Returns the counters and restarts them, e.g. once per frame.
+    counter_t takeCounter(void) { auto res = _counter; _counter = counter_t(); return res; }
+
+    bus_type_t busType(void) const override { return _bus->busType(); }
+    bool init(void) override { return _bus->init(); }
+    void release(void) override { _bus->release(); }
+    uint32_t getClock(void) const override { return _bus->getClock(); }
+    uint32_t getReadClock(void) const override { return _bus->getReadClock(); }
+    void setClock(uint32_t freq) override { _bus->setClock(freq); }
+    void setReadClock(uint32_t freq) override { _bus->setReadClock(freq); }
+
+    void beginTransaction(void) override;
+    void endTransaction(void) override { _bus->endTransaction(); }
+    void wait(void) override;
+    bool busy(void) const override { return _bus->busy(); }
+
+    void initDMA(void) override { _bus->initDMA(); }
+    void addDMAQueue(const uint8_t* data, uint32_t length) override;
+    void execDMAQueue(void) override { _bus->execDMAQueue(); }
+    uint8_t* getDMABuffer(uint32_t length) override { return _bus->getDMABuffer(length); }
+
+    void flush(void) override { _bus->flush(); }
+    bool writeCommand(uint32_t data, uint_fast8_t bit_length) override;
+    void writeData(uint32_t data, uint_fast8_t bit_length) override;
+    void writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count) override;
+    void writePixels(pixelcopy_t* pc, uint32_t length) override;
+    void writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma) override;
+
+    void beginRead(uint_fast8_t dummy_bits) override { _bus->beginRead(dummy_bits); }
+    void beginRead(void) override { _bus->beginRead(); }
+    void endRead(void) override { _bus->endRead(); }
+    uint32_t readData(uint_fast8_t bit_length) override;
+    bool readBytes(uint8_t* dst, uint32_t length, bool use_dma = false) override;
+    bool readBytes(uint8_t* dst, uint32_t length, bool use_dma, bool last_nack) override;
+    void readPixels(void* dst, pixelcopy_t* pc, uint32_t length) override;
+
+  protected:
+    IBus* _bus = nullptr;
+    counter_t _counter;
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -1646,6 +1646,18 @@ namespace lgfx
 
     int32_t y = min_y - max_y;
 
+    // Vertical enlargement without rotation : consecutive lines read the same source row,
+    // so the row is converted once into line_buf and sent again for the following lines.
+    uint8_t* line_buf = nullptr;
+    pixelcopy_t pc_line;
+    int32_t line_src_y = -1;
+    if (iA[1] == 0 && iA[3] == 0 && abs(iA[4]) < (1 << FP_SCALE)
+     && pc->transp == pixelcopy_t::NON_TRANSP && _write_conv.bits >= 8)
+    {
+      line_buf = (uint8_t*)alloca((cr - cl) * _write_conv.bytes);
+      pc_line = pixelcopy_t(line_buf, _write_conv.depth, _write_conv.depth);
+    }
+
     startWrite();
     do
     {
@@ -1663,7 +1675,30 @@ namespace lgfx
           {
             pc->src_x32_add = iA[0];
             pc->src_y32_add = iA[3];
-            _panel->writeImage(left, y + max_y, right - left, 1, pc, true);
+            if (line_buf == nullptr)
+            {
+              _panel->writeImage(left, y + max_y, right - left, 1, pc, true);
+            }
+            else
+            { // left and right are the same on every line, since iA[1] and iA[3] are 0.
+              int32_t len = right - left;
+              if (line_src_y != pc->src_y)
+              {
+                line_src_y = (pc->fp_copy(line_buf, 0, len, pc) == (uint32_t)len) ? pc->src_y : -1;
+              }
+              if (line_src_y < 0)
+              {
+                pc->src_x32 = iA[2] + left * iA[0];
+                pc->src_y32 = iA[5];
+                _panel->writeImage(left, y + max_y, len, 1, pc, true);
+              }
+              else
+              { // line_buf is written again on the next lines, so it is sent without DMA.
+                pc_line.src_x32 = 0;
+                pc_line.src_y32 = 0;
+                _panel->writeImage(left, y + max_y, len, 1, &pc_line, false);
+              }
+            }
           }
         }
       }
@@ -2506,6 +2541,9 @@ namespace lgfx
 
     if (this->_runtime_font->loadFont(data)) {
       result = true;
+      if (this->_runtime_font->getType() == IFont::font_type_t::ft_vlw) {
+        static_cast<VLWfont*>(this->_runtime_font.get())->setCacheSize(_font_cache_size);
+      }
       this->_font = this->_runtime_font.get();
       this->_font->getDefaultMetric(&this->_font_metrics);
     } else {
@@ -2519,6 +2557,14 @@ namespace lgfx
     if (_runtime_font.get() != nullptr) { setFont(&fonts::Font0); }
   }
 
+  void LGFXBase::setFontCacheSize(size_t bytes)
+  {
+    _font_cache_size = bytes;
+    if (_runtime_font.get() != nullptr && _runtime_font->getType() == IFont::font_type_t::ft_vlw) {
+      static_cast<VLWfont*>(_runtime_font.get())->setCacheSize(bytes);
+    }
+  }
+
   void LGFXBase::showFont(uint32_t td)
   {
     int_fast16_t x = 0;
@@ -2881,8 +2927,77 @@ namespace lgfx
   struct draw_jpg_info_t : public image_decoder_t
   {
     pixelcopy_t *pc;
+
+    /// Double-buffered line band holding one MCU row in the color format of the destination.
+    /// A finished row is sent by DMA while the next one is decoded into the other buffer.
+    uint8_t* band[2];
+    pixelcopy_t *band_pc;
+    uint32_t band_width;
+    uint32_t band_bytes;
+    uint32_t band_top;
+    uint32_t band_bottom;
+    uint8_t band_index;
+    bool band_used;
   };
 
+  static void jpg_flush_band(draw_jpg_info_t *jpeg)
+  {
+    if (!jpeg->band_used) { return; }
+    jpeg->band_used = false;
+    jpeg->band_pc->src_data = jpeg->band[jpeg->band_index];
+    jpeg->band_pc->src_x32_add = 1 << FP_SCALE;
+    jpeg->band_pc->src_y32_add = 0;
+    jpeg->gfx->pushImage( jpeg->x
+                        , jpeg->y + jpeg->band_top
+                        , jpeg->band_width
+                        , jpeg->band_bottom - jpeg->band_top + 1
+                        , jpeg->band_pc
+                        , true);
+    /// The bus waits for this DMA before starting the next one, so the other buffer can be reused now.
+    jpeg->band_index ^= 1;
+  }
+
+  static uint32_t jpg_push_image_band(void *device, void *bitmap, JRECT *rect)
+  {
+    draw_jpg_info_t *jpeg = static_cast<draw_jpg_info_t*>(device);
+    auto data = static_cast<DataWrapper*>(jpeg->data);
+    data->postRead();
+
+    if (jpeg->band_used && rect->top != jpeg->band_top)
+    {
+      jpg_flush_band(jpeg);
+    }
+    if (!jpeg->band_used)
+    {
+      jpeg->band_used = true;
+      jpeg->band_top = rect->top;
+      jpeg->band_bottom = rect->bottom;
+    }
+    else if (jpeg->band_bottom < rect->bottom)
+    {
+      jpeg->band_bottom = rect->bottom;
+    }
+
+    auto pc = jpeg->pc;
+    uint32_t w = rect->right - rect->left + 1;
+    uint32_t h = rect->bottom - rect->top + 1;
+    pc->src_data = bitmap;
+    pc->src_bitwidth = w;
+    pc->src_x32_add = 1 << FP_SCALE;
+    pc->src_y32_add = 0;
+    auto dst = jpeg->band[jpeg->band_index];
+    for (uint32_t i = 0; i < h; ++i)
+    {
+      pc->src_x32 = 0;
+      pc->src_y32 = i << FP_SCALE;
+      int32_t pos = rect->left + i * jpeg->band_width;
+      int32_t end = pos + w;
+      while (end != (pos = pc->fp_copy(dst, pos, end, pc))
+         &&  end != (pos = pc->fp_skip(     pos, end, pc)));
+    }
+    return 1;
+  }
+
   static uint32_t jpg_push_image(void *device, void *bitmap, JRECT *rect)
   {
     draw_jpg_info_t *jpeg = static_cast<draw_jpg_info_t*>(device);
@@ -2982,9 +3097,47 @@ namespace lgfx
       drawinfo.zoom_y *= 1 << div;
     }
 
+    bool no_zoom = drawinfo.zoom_x == 1.0f && drawinfo.zoom_y == 1.0f;
+    drawinfo.band[0] = drawinfo.band[1] = nullptr;
+    pixelcopy_t band_pc(nullptr, this->getColorDepth(), this->getColorDepth(), this->hasPalette());
+    if (no_zoom && _write_conv.bits >= 8 && !this->hasPalette())
+    { /// Same arithmetic as mcu_output, to find the width of an MCU row after descaling.
+      uint32_t mx = jpegdec.msx << 3;
+      uint32_t width = 0;
+      for (uint32_t mcu_x = 0; mcu_x < jpegdec.width; mcu_x += mx)
+      {
+        uint32_t rx = std::min<uint32_t>(mx, jpegdec.width - mcu_x) >> div;
+        if (rx) { width = (mcu_x >> div) + rx; }
+      }
+      uint32_t height = std::max(1, (jpegdec.msy << 3) >> div);
+      drawinfo.band_width = width;
+      drawinfo.band_bytes = width * height * (_write_conv.bits >> 3);
+      drawinfo.band[0] = (uint8_t*)heap_alloc_dma(drawinfo.band_bytes);
+      drawinfo.band[1] = (uint8_t*)heap_alloc_dma(drawinfo.band_bytes);
+      if (!drawinfo.band[0] || !drawinfo.band[1])
+      { /// not enough DMA memory, fall back to sending each MCU.
+        if (drawinfo.band[0]) { heap_free(drawinfo.band[0]); }
+        if (drawinfo.band[1]) { heap_free(drawinfo.band[1]); }
+        drawinfo.band[0] = drawinfo.band[1] = nullptr;
+      }
+      drawinfo.band_pc = &band_pc;
+      drawinfo.band_index = 0;
+      drawinfo.band_used = false;
+    }
+
     this->startWrite(!data->hasParent());
 
-    jres = lgfx_jd_decomp(&jpegdec, drawinfo.zoom_x == 1.0f && drawinfo.zoom_y == 1.0f ? jpg_push_image : jpg_push_image_affine, div);
+    jres = lgfx_jd_decomp(&jpegdec, drawinfo.band[0] ? jpg_push_image_band
+                                  : no_zoom ? jpg_push_image
+                                  : jpg_push_image_affine, div);
+
+    if (drawinfo.band[0])
+    {
+      if (jres == JDR_OK) { jpg_flush_band(&drawinfo); }
+      this->waitDMA();
+      heap_free(drawinfo.band[0]);
+      heap_free(drawinfo.band[1]);
+    }
 
     drawinfo.end();
     this->endWrite();
@@ -3003,8 +3156,131 @@ namespace lgfx
   {
     bgra8888_t* lineBuffer;
     pixelcopy_t *pc;
+
+    /// Read-ahead buffer, so that the small reads of the decoder do not each access the file.
+    uint8_t* readBuffer;
+    uint32_t readPos;
+    uint32_t readLen;
+
+    /// Double-buffered band of opaque lines in the color format of the destination.
+    /// A full band is sent by DMA while the next lines are converted into the other buffer.
+    uint8_t* band[2];
+    pixelcopy_t *band_pc;
+    uint32_t band_bytes;
+    int32_t band_x;
+    int32_t band_y;
+    uint32_t band_w;
+    uint32_t band_h;
+    uint32_t band_max_h;
+    uint8_t band_index;
   };
 
+  static constexpr uint32_t PNG_READ_AHEAD_LEN = 2048;
+  static constexpr uint32_t PNG_BAND_BYTES = 4096;
+
+  static uint32_t png_read_data(void* self, uint8_t* buf, uint32_t len)
+  {
+    auto p = (png_file_decoder_t*)self;
+    if (p->readBuffer == nullptr) { return image_decoder_t::read_data(self, buf, len); }
+
+    uint32_t res = 0;
+    while (len)
+    {
+      if (p->readPos == p->readLen)
+      {
+        if (buf == nullptr || len >= PNG_READ_AHEAD_LEN)
+        { /// large reads and skips do not go through the buffer.
+          res += image_decoder_t::read_data(self, buf, len);
+          break;
+        }
+        p->data->preRead();
+        int l = p->data->read(p->readBuffer, PNG_READ_AHEAD_LEN, len);
+        if (l <= 0) { break; }
+        p->readPos = 0;
+        p->readLen = l;
+      }
+      uint32_t l = std::min(len, p->readLen - p->readPos);
+      if (buf)
+      {
+        memcpy(buf, &p->readBuffer[p->readPos], l);
+        buf += l;
+      }
+      p->readPos += l;
+      res += l;
+      len -= l;
+    }
+    return res;
+  }
+
+  static void png_flush_band(png_file_decoder_t *p)
+  {
+    if (!p->band_h) { return; }
+    p->band_pc->src_data = p->band[p->band_index];
+    p->band_pc->src_x32_add = 1 << FP_SCALE;
+    p->band_pc->src_y32_add = 0;
+    p->gfx->pushImage(p->x + p->band_x, p->y + p->band_y, p->band_w, p->band_h, p->band_pc, true);
+    p->band_h = 0;
+    /// The bus waits for this DMA before starting the next one, so the other buffer can be reused now.
+    p->band_index ^= 1;
+  }
+
+  /// Converts an opaque line into the band, and sends the band when it is full.
+  static void png_push_band(png_file_decoder_t *p, int32_t x, int32_t y, uint32_t len, const uint8_t* argb)
+  {
+    if ((int32_t)len > p->maxWidth - x) { len = p->maxWidth - x; }
+    if (p->band_h && (p->band_x != x || p->band_w != len || p->band_y + (int32_t)p->band_h != y))
+    {
+      png_flush_band(p);
+    }
+    if (!p->band_h)
+    {
+      p->band_x = x;
+      p->band_y = y;
+      p->band_w = len;
+      p->band_max_h = std::max<uint32_t>(1, p->band_bytes / (len * p->band_pc->src_bits >> 3));
+    }
+    auto pc = p->pc;
+    pc->src_data = argb;
+    pc->src_x32 = 0;
+    pc->src_y32 = 0;
+    pc->src_x32_add = 1 << FP_SCALE;
+    pc->src_y32_add = 0;
+    pc->fp_copy(&p->band[p->band_index][p->band_h * len * p->band_pc->src_bits >> 3], 0, len, pc);
+    if (++p->band_h == p->band_max_h)
+    {
+      png_flush_band(p);
+    }
+  }
+
+  /// Allocates the bands when the lines can be sent as they are (no zoom, no palette).
+  static void png_begin_band(png_file_decoder_t *p, pixelcopy_t* band_pc, uint32_t bytes, bool no_zoom)
+  {
+    p->band[0] = p->band[1] = nullptr;
+    if (!no_zoom || !bytes || band_pc->src_bits < 8) { return; }
+    p->band_bytes = std::max<uint32_t>(PNG_BAND_BYTES, p->maxWidth * bytes);
+    p->band[0] = (uint8_t*)heap_alloc_dma(p->band_bytes);
+    p->band[1] = (uint8_t*)heap_alloc_dma(p->band_bytes);
+    if (!p->band[0] || !p->band[1])
+    { /// not enough DMA memory, fall back to sending each line.
+      if (p->band[0]) { heap_free(p->band[0]); }
+      if (p->band[1]) { heap_free(p->band[1]); }
+      p->band[0] = p->band[1] = nullptr;
+    }
+    p->band_pc = band_pc;
+    p->band_index = 0;
+    p->band_h = 0;
+  }
+
+  static void png_end_band(png_file_decoder_t *p, bool flush)
+  {
+    if (p->band[0] == nullptr) { return; }
+    if (flush) { png_flush_band(p); }
+    p->gfx->waitDMA();
+    heap_free(p->band[0]);
+    heap_free(p->band[1]);
+    p->band[0] = p->band[1] = nullptr;
+  }
+
 //-----
 
 
@@ -3055,6 +3331,15 @@ namespace lgfx
     p->data->postRead();
 
     bool hasAlpha = (idx != len);
+    if (p->band[0])
+    {
+      if (!hasAlpha && div_x == 1)
+      {
+        png_push_band(p, x, y0, len, argb);
+        return;
+      }
+      png_flush_band(p);
+    }
     if (hasAlpha)
     {
       if (p->gfx->isReadable())
@@ -3318,9 +3603,13 @@ namespace lgfx
     png_file_decoder_t png;
     png.lineBuffer = nullptr;
     png.data = data;
+    png.band[0] = png.band[1] = nullptr;
+    png.readPos = png.readLen = 0;
+    png.readBuffer = (uint8_t*)heap_alloc(PNG_READ_AHEAD_LEN);
 
-    if (lgfx_pngle_prepare(pngle, image_decoder_t::read_data, &png) < 0)
+    if (lgfx_pngle_prepare(pngle, png_read_data, &png) < 0)
     {
+      if (png.readBuffer) { heap_free(png.readBuffer); }
       return false;
     }
 
@@ -3336,6 +3625,7 @@ namespace lgfx
                   , datum
                   , lgfx_pngle_get_width(pngle), lgfx_pngle_get_height(pngle)))
     {
+      if (png.readBuffer) { heap_free(png.readBuffer); }
       return true;
     }
 
@@ -3354,15 +3644,21 @@ namespace lgfx
 
     png.pc = &pc;
 
+    bool no_zoom = png.zoom_x == 1.0f && png.zoom_y == 1.0f;
+    pixelcopy_t band_pc(nullptr, this->getColorDepth(), this->getColorDepth(), this->hasPalette());
+    png_begin_band(&png, &band_pc, this->hasPalette() ? 0 : _write_conv.bits >> 3, no_zoom);
+
     this->startWrite(!data->hasParent());
 
-    auto res = lgfx_pngle_decomp(pngle, png.zoom_x == 1.0f && png.zoom_y == 1.0f ? png_draw_alpha_callback : png_draw_alpha_scale_callback);
+    auto res = lgfx_pngle_decomp(pngle, no_zoom ? png_draw_alpha_callback : png_draw_alpha_scale_callback);
 
+    png_end_band(&png, res >= 0);
     this->endWrite();
     if (png.lineBuffer) {
       this->waitDMA();
       heap_free(png.lineBuffer);
     }
+    if (png.readBuffer) { heap_free(png.readBuffer); }
     png.end();
 
     return res < 0 ? false : true;
@@ -3378,9 +3674,13 @@ namespace lgfx
     png_file_decoder_t png;
     png.lineBuffer = nullptr;
     png.data = data;
+    png.band[0] = png.band[1] = nullptr;
+    png.readPos = png.readLen = 0;
+    png.readBuffer = (uint8_t*)heap_alloc(PNG_READ_AHEAD_LEN);
 
-    if (lgfx_qoi_prepare(qoi, image_decoder_t::read_data, &png) < 0)
+    if (lgfx_qoi_prepare(qoi, png_read_data, &png) < 0)
     {
+      if (png.readBuffer) { heap_free(png.readBuffer); }
       lgfx_qoi_destroy(qoi);
       return false;
     }
@@ -3397,6 +3697,7 @@ namespace lgfx
                   , datum
                   , lgfx_qoi_get_width(qoi), lgfx_qoi_get_height(qoi)))
     {
+      if (png.readBuffer) { heap_free(png.readBuffer); }
       lgfx_qoi_destroy(qoi);
       return true;
     }
@@ -3416,15 +3717,21 @@ namespace lgfx
 
     png.pc = &pc;
 
+    bool no_zoom = png.zoom_x == 1.0f && png.zoom_y == 1.0f;
+    pixelcopy_t band_pc(nullptr, this->getColorDepth(), this->getColorDepth(), this->hasPalette());
+    png_begin_band(&png, &band_pc, this->hasPalette() ? 0 : _write_conv.bits >> 3, no_zoom);
+
     this->startWrite(!data->hasParent());
 
-    auto res = lgfx_qoi_decomp(qoi, png.zoom_x == 1.0f && png.zoom_y == 1.0f ? png_draw_alpha_callback : png_draw_alpha_scale_callback);
+    auto res = lgfx_qoi_decomp(qoi, no_zoom ? png_draw_alpha_callback : png_draw_alpha_scale_callback);
 
+    png_end_band(&png, res >= 0);
     this->endWrite();
     if (png.lineBuffer) {
       this->waitDMA();
       heap_free(png.lineBuffer);
     }
+    if (png.readBuffer) { heap_free(png.readBuffer); }
     png.end();
     lgfx_qoi_destroy(qoi);
 
@@ -3468,6 +3775,40 @@ namespace lgfx
     return res;
   }
 
+  static uint8_t *qoi_encoder_get_row( uint8_t *pImage, int flip, int w, int h, int y, void *target )
+  {
+    auto enc = static_cast<png_encoder_t*>(target);
+    uint32_t ypos = (flip ? (h - 1 - y) : y);
+    enc->gfx->readRectRGB( enc->x, enc->y + ypos, w, 1, pImage );
+    return pImage;
+  }
+
+  void* LGFXBase::createQoi(size_t* datalen, int32_t x, int32_t y, int32_t w, int32_t h)
+  {
+    if (_adjust_abs(x, w)||_adjust_abs(y, h)) return nullptr;
+    if (x < 0) { w += x; x = 0; }
+    if (w > width() - x)  w = width()  - x;
+    if (w < 1) return nullptr;
+    if (y < 0) { h += y; y = 0; }
+    if (h > height() - y) h = height() - y;
+    if (h < 1) return nullptr;
+
+    void* rgbBuffer = heap_alloc_dma(w * 3);
+    if (rgbBuffer == nullptr) return nullptr;
+
+    png_encoder_t enc = { this, x, y };
+
+    /// the encoder allocates its output for the worst case, the unused part is given back.
+    auto res = lgfx_qoi_encoder_write_fb(rgbBuffer, w, h, 3, datalen, 0, qoi_encoder_get_row, &enc);
+
+    heap_free(rgbBuffer);
+
+    if (*datalen == 0) return nullptr;
+
+    auto shrink = realloc(res, *datalen);
+    return shrink ? shrink : res;
+  }
+
 //----------------------------------------------------------------------------
 
   void LGFXBase::prepareTmpTransaction(DataWrapper* data)
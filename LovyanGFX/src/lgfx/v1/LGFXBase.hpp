@@ -823,6 +823,10 @@ namespace lgfx
     /// unload VLW font
     void unloadFont(void);
 
+    /// RAM used to cache the glyphs of the VLW fonts loaded after this call, and of the current one. (0 = no cache)
+    void setFontCacheSize(size_t bytes);
+    size_t getFontCacheSize(void) const { return _font_cache_size; }
+
     /// show VLW font
     void showFont(uint32_t td = 2000);
 
@@ -975,6 +979,8 @@ namespace lgfx
 
     void* createPng( size_t* datalen, int32_t x = 0, int32_t y = 0, int32_t width = 0, int32_t height = 0);
 
+    void* createQoi( size_t* datalen, int32_t x = 0, int32_t y = 0, int32_t width = 0, int32_t height = 0);
+
     void releasePngMemory(void);
 
     template<typename T>
@@ -1036,6 +1042,7 @@ namespace lgfx
 
     std::shared_ptr<RunTimeFont> _runtime_font;  // run-time generated font
     std::shared_ptr<DataWrapper> _font_file;  // run-time font file
+    size_t _font_cache_size = 0;  // glyph cache of the run-time VLW font
     PointerWrapper _font_data;
 
     std::shared_ptr<DataWrapperFactory> _data_wrapper_factory;
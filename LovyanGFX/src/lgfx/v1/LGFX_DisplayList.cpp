@@ -0,0 +1,360 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+
+#include "LGFX_DisplayList.hpp"
+
+#include "misc/pixelcopy.hpp"
+#include "platforms/common.hpp"
+
+#include <string.h>
+
+#ifdef min
+#undef min
+#endif
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  color_depth_t Panel_DisplayList::setColorDepth(color_depth_t depth)
+  {
+    clearList();
+    _write_depth = depth;
+    _read_depth = depth;
+    return depth;
+  }
+
+  void Panel_DisplayList::setRotation(uint_fast8_t)
+  { // the commands are recorded in the coordinates of the destination, without rotation.
+    _width  = _list_width;
+    _height = _list_height;
+    _xs = 0;
+    _ys = 0;
+    _xe = _list_width - 1;
+    _ye = _list_height - 1;
+  }
+
+  void Panel_DisplayList::setSize(uint_fast16_t w, uint_fast16_t h)
+  {
+    clearList();
+    _list_width = w;
+    _list_height = h;
+    setRotation(0);
+  }
+
+  void Panel_DisplayList::clearList(void)
+  {
+    _list_size = 0;
+    _recent_count = 0;
+    _command_count = 0;
+    _merged_count = 0;
+    _dropped_count = 0;
+  }
+
+  void Panel_DisplayList::deleteList(void)
+  {
+    clearList();
+    if (_list) { heap_free(_list); }
+    _list = nullptr;
+    _list_capacity = 0;
+  }
+
+  bool Panel_DisplayList::_reserve(size_t len)
+  {
+    size_t need = _list_size + len;
+    if (need <= _list_capacity) { return true; }
+    size_t capacity = _list_capacity ? _list_capacity : 256;
+    while (capacity < need) { capacity <<= 1; }
+    auto list = (uint8_t*)heap_alloc_psram(capacity);
+    if (list == nullptr) { list = (uint8_t*)heap_alloc(capacity); }
+    if (list == nullptr) { return false; }
+    if (_list)
+    {
+      memcpy(list, _list, _list_size);
+      heap_free(_list);
+    }
+    _list = list;
+    _list_capacity = capacity;
+    return true;
+  }
+
+  Panel_DisplayList::command_t* Panel_DisplayList::_add_command(command_type_t type, uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t value, size_t data_len)
+  {
+    size_t size = sizeof(command_t) + ((data_len + 3) & ~3u);
+    if (!_reserve(size))
+    {
+      ++_dropped_count;
+      return nullptr;
+    }
+    uint32_t offset = _list_size;
+    auto cmd = _command(offset);
+    cmd->size = size;
+    cmd->value = value;
+    cmd->x = x;
+    cmd->y = y;
+    cmd->w = w;
+    cmd->h = h;
+    cmd->type = type;
+    _list_size += size;
+    ++_command_count;
+
+    if (_recent_count == merge_depth)
+    {
+      memmove(_recent, &_recent[1], sizeof(_recent[0]) * (merge_depth - 1));
+      --_recent_count;
+    }
+    _recent[_recent_count++] = offset;
+    return cmd;
+  }
+
+  /// Extends a previous fill of the same color instead of adding the new one, when both make a rectangle
+  /// and none of the commands in between covers the new fill.
+  bool Panel_DisplayList::_merge_fill(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
+  {
+    int_fast16_t r = x + w;
+    int_fast16_t b = y + h;
+    for (int i = _recent_count - 1; i >= 0; --i)
+    {
+      auto cmd = _command(_recent[i]);
+      if (cmd->type == cmd_copy || cmd->type == cmd_fill_alpha) { break; } // these read the destination.
+
+      int_fast16_t cx = cmd->x;
+      int_fast16_t cy = cmd->y;
+      int_fast16_t cr = cx + cmd->w;
+      int_fast16_t cb = cy + cmd->h;
+      if (cmd->type == cmd_fill && cmd->value == rawcolor)
+      {
+        if (cx <= (int_fast16_t)x && r <= cr && cy <= (int_fast16_t)y && b <= cb)
+        { // already covered
+          ++_merged_count;
+          return true;
+        }
+        if (cy == (int_fast16_t)y && cb == b && cx <= r && (int_fast16_t)x <= cr)
+        {
+          cmd->x = std::min<int_fast16_t>(cx, x);
+          cmd->w = std::max<int_fast16_t>(cr, r) - cmd->x;
+          ++_merged_count;
+          return true;
+        }
+        if (cx == (int_fast16_t)x && cr == r && cy <= b && (int_fast16_t)y <= cb)
+        {
+          cmd->y = std::min<int_fast16_t>(cy, y);
+          cmd->h = std::max<int_fast16_t>(cb, b) - cmd->y;
+          ++_merged_count;
+          return true;
+        }
+      }
+      // an overlapping command must stay drawn before the new fill.
+      if (cx < r && (int_fast16_t)x < cr && cy < b && (int_fast16_t)y < cb) { break; }
+    }
+    return false;
+  }
+
+  void Panel_DisplayList::_add_image_row(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, const uint8_t* data)
+  {
+    size_t bytes = _write_bits >> 3;
+    size_t len = w * bytes;
+    if (_recent_count)
+    { // the row just below the last image is appended to it.
+      uint32_t offset = _recent[_recent_count - 1];
+      auto cmd = _command(offset);
+      size_t used = cmd->w * cmd->h * bytes;
+      if (cmd->type == cmd_image && cmd->x == x && cmd->w == w && cmd->y + cmd->h == y)
+      {
+        size_t size = sizeof(command_t) + ((used + len + 3) & ~3u);
+        if (_reserve(size - cmd->size))
+        {
+          cmd = _command(offset);
+          memcpy(&_list[offset + sizeof(command_t) + used], data, len);
+          _list_size += size - cmd->size;
+          cmd->size = size;
+          cmd->h++;
+          ++_merged_count;
+          return;
+        }
+      }
+    }
+    auto cmd = _add_command(cmd_image, x, y, w, 1, 0, len);
+    if (cmd) { memcpy(&cmd[1], data, len); }
+  }
+
+  void Panel_DisplayList::setWindow(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye)
+  {
+    xs = std::min<uint_fast16_t>(_width  - 1, xs);
+    xe = std::min<uint_fast16_t>(_width  - 1, xe);
+    ys = std::min<uint_fast16_t>(_height - 1, ys);
+    ye = std::min<uint_fast16_t>(_height - 1, ye);
+    _xpos = xs;
+    _xs = xs;
+    _xe = xe;
+    _ypos = ys;
+    _ys = ys;
+    _ye = ye;
+  }
+
+  void Panel_DisplayList::drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor)
+  {
+    writeFillRectPreclipped(x, y, 1, 1, rawcolor);
+  }
+
+  void Panel_DisplayList::writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
+  {
+    if (_merge_fill(x, y, w, h, rawcolor)) { return; }
+    _add_command(cmd_fill, x, y, w, h, rawcolor, 0);
+  }
+
+  void Panel_DisplayList::writeFillRectAlphaPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t argb8888)
+  {
+    _add_command(cmd_fill_alpha, x, y, w, h, argb8888, 0);
+  }
+
+  void Panel_DisplayList::writeBlock(uint32_t rawcolor, uint32_t length)
+  {
+    do
+    {
+      uint32_t h = 1;
+      auto w = std::min<uint32_t>(length, _xe + 1 - _xpos);
+      if (length >= (w << 1) && _xpos == _xs)
+      {
+        h = std::min<uint32_t>(length / w, _ye + 1 - _ypos);
+      }
+      writeFillRectPreclipped(_xpos, _ypos, w, h, rawcolor);
+      if ((_xpos += w) <= _xe) return;
+      _xpos = _xs;
+      if (_ye < (_ypos += h)) { _ypos = _ys; }
+      length -= w * h;
+    } while (length);
+  }
+
+  void Panel_DisplayList::writePixels(pixelcopy_t* param, uint32_t length, bool)
+  {
+    auto buf = (uint8_t*)alloca((_xe - _xs + 1) * (_write_bits >> 3));
+    uint32_t linelength;
+    do
+    {
+      linelength = std::min<uint32_t>(_xe + 1 - _xpos, length);
+      param->fp_copy(buf, 0, linelength, param);
+      _add_image_row(_xpos, _ypos, linelength, buf);
+      if ((_xpos += linelength) > _xe)
+      {
+        _xpos = _xs;
+        _ypos = (_ypos != _ye) ? (_ypos + 1) : _ys;
+      }
+    } while (length -= linelength);
+  }
+
+  void Panel_DisplayList::writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool)
+  {
+    auto buf = (uint8_t*)alloca(w * (_write_bits >> 3));
+    size_t bytes = _write_bits >> 3;
+    uint32_t sy32 = param->src_y32;
+    uint32_t sx32 = param->src_x32;
+    do
+    { // transparent pixels split the row in several images.
+      uint32_t pos = 0;
+      do
+      {
+        uint32_t start = pos;
+        pos = param->fp_copy(buf, pos, w, param);
+        if (start < pos) { _add_image_row(x + start, y, pos - start, &buf[start * bytes]); }
+      } while (w != pos && w != (pos = param->fp_skip(pos, w, param)));
+      param->src_x32 = sx32;
+      param->src_y32 = (sy32 += 1 << pixelcopy_t::FP_SCALE);
+      ++y;
+    } while (--h);
+  }
+
+  void Panel_DisplayList::writeImageARGB(uint_fast16_t, uint_fast16_t, uint_fast16_t, uint_fast16_t, pixelcopy_t*)
+  { // blending needs the destination pixels.
+    ++_dropped_count;
+  }
+
+  void Panel_DisplayList::readRect(uint_fast16_t, uint_fast16_t, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param)
+  {
+    ++_dropped_count;
+    memset(dst, 0, (w * h * param->dst_bits + 7) >> 3);
+  }
+
+  void Panel_DisplayList::copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y)
+  {
+    _add_command(cmd_copy, dst_x, dst_y, w, h, src_x | src_y << 16, 0);
+  }
+
+//----------------------------------------------------------------------------
+
+  bool LGFX_DisplayList::createList(int32_t w, int32_t h, color_depth_t depth)
+  {
+    if (w <= 0 || h <= 0 || (depth & color_depth_t::bit_mask) < 8 || (depth & color_depth_t::has_palette)) { return false; }
+    setColorDepth(depth);
+    _panel_list.setSize(w, h);
+    setRotation(0);
+    return true;
+  }
+
+  bool LGFX_DisplayList::replay(LovyanGFX* dst, int32_t x, int32_t y) const
+  {
+    if (dst == nullptr || dst->getColorDepth() != _panel_list.getWriteDepth()) { return false; }
+    auto data = _panel_list.getListData();
+    auto end = data + _panel_list.getListSize();
+
+    dst->startWrite();
+    while (data < end)
+    {
+      auto cmd = (const command_t*)data;
+      data += cmd->size;
+      replayCommand(dst, cmd, x, y);
+    }
+    dst->endWrite();
+    return true;
+  }
+
+  void LGFX_DisplayList::replayCommand(LovyanGFX* dst, const command_t* cmd, int32_t x, int32_t y) const
+  {
+    switch (cmd->type)
+    {
+    case Panel_DisplayList::cmd_fill:
+      dst->setRawColor(cmd->value);
+      dst->writeFillRect(x + cmd->x, y + cmd->y, cmd->w, cmd->h);
+      break;
+
+    case Panel_DisplayList::cmd_image:
+      {
+        auto depth = _panel_list.getWriteDepth();
+        pixelcopy_t p(&cmd[1], depth, depth);
+        dst->pushImage(x + cmd->x, y + cmd->y, cmd->w, cmd->h, &p);
+      }
+      break;
+
+    case Panel_DisplayList::cmd_copy:
+      dst->copyRect(x + cmd->x, y + cmd->y, cmd->w, cmd->h, x + (cmd->value & 0xFFFF), y + (cmd->value >> 16));
+      break;
+
+    case Panel_DisplayList::cmd_fill_alpha:
+      dst->fillRectAlpha(x + cmd->x, y + cmd->y, cmd->w, cmd->h, cmd->value >> 24, cmd->value & 0xFFFFFF);
+      break;
+
+    default:
+      break;
+    }
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
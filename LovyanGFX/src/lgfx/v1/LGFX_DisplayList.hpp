@@ -0,0 +1,185 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "LGFXBase.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  class LGFX_DisplayList;
+
+  /// @brief Panel that records the drawing commands instead of drawing them.
+  /// Fills of the same color are merged while recording when they make a rectangle,
+  /// and consecutive image rows are merged into one image.
+  struct Panel_DisplayList : public IPanel
+  {
+    friend LGFX_DisplayList;
+
+    /// number of previous commands searched to merge a new fill
+    static constexpr uint8_t merge_depth = 8;
+
+    enum command_type_t : uint8_t
+    {
+      cmd_fill,        // value = raw color
+      cmd_image,       // raw pixels follow the command, w * h * bytes (rounded up to 4 bytes)
+      cmd_copy,        // value = src_x | src_y << 16
+      cmd_fill_alpha,  // value = argb8888
+    };
+
+    struct command_t
+    {
+      uint32_t size;   // bytes of the command and its data
+      uint32_t value;
+      uint16_t x;
+      uint16_t y;
+      uint16_t w;
+      uint16_t h;
+      uint8_t type;
+      uint8_t reserved[3];
+    };
+
+    Panel_DisplayList(void) { _start_count = INT32_MAX; }
+    virtual ~Panel_DisplayList(void) { deleteList(); }
+
+    void beginTransaction(void) override {}
+    void endTransaction(void) override {}
+    void setInvert(bool) override {}
+    void setSleep(bool) override {}
+    void setPowerSave(bool) override {}
+    void writeCommand(uint32_t, uint_fast8_t) override {}
+    void writeData(uint32_t, uint_fast8_t) override {}
+    void initDMA(void) override {}
+    void waitDMA(void) override {}
+    bool dmaBusy(void) override { return false; }
+    void waitDisplay(void) override {}
+    bool displayBusy(void) override { return false; }
+    void display(uint_fast16_t, uint_fast16_t, uint_fast16_t, uint_fast16_t) override {}
+    bool isReadable(void) const override { return false; }
+    bool isBusShared(void) const override { return false; }
+
+    uint32_t readCommand(uint_fast16_t, uint_fast8_t, uint_fast8_t) override { return 0; }
+    uint32_t readData(uint_fast8_t, uint_fast8_t) override { return 0; }
+
+    color_depth_t setColorDepth(color_depth_t depth) override;
+    void setRotation(uint_fast8_t r) override;
+
+    void setWindow(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye) override;
+    void drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor) override;
+    void writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor) override;
+    void writeFillRectAlphaPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t argb8888) override;
+    void writeBlock(uint32_t rawcolor, uint32_t len) override;
+    void writePixels(pixelcopy_t* param, uint32_t len, bool use_dma) override;
+    void writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool use_dma) override;
+    void writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param) override;
+
+    void readRect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param) override;
+    void copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y) override;
+
+    void setSize(uint_fast16_t w, uint_fast16_t h);
+    void clearList(void);
+    void deleteList(void);
+
+    const uint8_t* getListData(void) const { return _list; }
+    size_t getListSize(void) const { return _list_size; }
+    uint32_t getCommandCount(void) const { return _command_count; }
+    uint32_t getMergedCount(void) const { return _merged_count; }
+    uint32_t getDroppedCount(void) const { return _dropped_count; }
+
+  protected:
+    command_t* _add_command(command_type_t type, uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t value, size_t data_len);
+    bool _merge_fill(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor);
+    void _add_image_row(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, const uint8_t* data);
+    bool _reserve(size_t len);
+    command_t* _command(uint32_t offset) const { return (command_t*)&_list[offset]; }
+
+    uint8_t* _list = nullptr;
+    size_t _list_size = 0;
+    size_t _list_capacity = 0;
+
+    uint32_t _recent[merge_depth];  // offsets of the last commands, oldest first
+    uint8_t _recent_count = 0;
+
+    uint32_t _command_count = 0;
+    uint32_t _merged_count = 0;
+    uint32_t _dropped_count = 0;
+
+    uint_fast16_t _xpos = 0;
+    uint_fast16_t _ypos = 0;
+    uint_fast16_t _list_width = 0;
+    uint_fast16_t _list_height = 0;
+  };
+
+  /// @brief Records the drawings done on it into a display list, which can be drawn
+  /// on another LovyanGFX afterwards, any number of times.
+  /// The replay runs in a single transaction with the merged commands, so the static
+  /// parts of a screen can be recorded once and redrawn cheaply after each clear.
+  /// The list keeps raw colors, so it is replayed on a destination of the same color depth (8 bits or more).
+  /// Drawings that read the destination (alpha images, effects) are not recorded and counted in getDroppedCount().
+  class LGFX_DisplayList : public LovyanGFX
+  {
+  public:
+
+    LGFX_DisplayList(void)
+    : LovyanGFX()
+    {
+      _panel = &_panel_list;
+      setColorDepth(_write_conv.depth);
+    }
+
+    virtual ~LGFX_DisplayList(void) { deleteList(); }
+
+    /// @brief Prepares an empty list for drawings of w x h pixels.
+    bool createList(int32_t w, int32_t h, color_depth_t depth);
+
+    /// @brief Prepares an empty list with the size and the color depth of dst.
+    bool createList(LovyanGFX* dst) { return dst && createList(dst->width(), dst->height(), dst->getColorDepth()); }
+
+    /// @brief Removes the recorded commands, the memory is kept for the next recording.
+    void clearList(void) { _panel_list.clearList(); }
+
+    void deleteList(void) { _panel_list.deleteList(); }
+
+    typedef Panel_DisplayList::command_t command_t;
+
+    /// @brief Draws the recorded commands on dst, shifted by (x, y), within the clip rect of dst.
+    bool replay(LovyanGFX* dst, int32_t x = 0, int32_t y = 0) const;
+
+    /// @brief Draws one command of the list. dst must have the color depth of the list and be in startWrite.
+    void replayCommand(LovyanGFX* dst, const command_t* cmd, int32_t x = 0, int32_t y = 0) const;
+
+    /// The commands are stored one after the other, each one command_t::size bytes long.
+    const uint8_t* getListData(void) const { return _panel_list.getListData(); }
+
+    uint32_t getCommandCount(void) const { return _panel_list.getCommandCount(); }
+    size_t getListSize(void) const { return _panel_list.getListSize(); }
+    uint32_t getMergedCount(void) const { return _panel_list.getMergedCount(); }
+    uint32_t getDroppedCount(void) const { return _panel_list.getDroppedCount(); }
+
+  protected:
+    Panel_DisplayList _panel_list;
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
+
+using LGFX_DisplayList = lgfx::LGFX_DisplayList;
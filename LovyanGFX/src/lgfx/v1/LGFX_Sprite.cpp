@@ -46,11 +46,13 @@ namespace lgfx
     _ye = h - 1;
 
     setRotation(_rotation);
+    markDirtyAll();
   }
 
   void Panel_Sprite::deleteSprite(void)
   {
     _bitwidth = _panel_width = _panel_height = _width = _height = 0;
+    _dirty_count = 0;
     setRotation(_rotation);
     _img.release();
   }
@@ -81,6 +83,7 @@ namespace lgfx
     memset(_img, 0, (_bitwidth * _write_bits >> 3) * _panel_height);
 
     setRotation(_rotation);
+    markDirtyAll();
 
     return _img;
   }
@@ -133,6 +136,7 @@ namespace lgfx
       if (r & 2)                  { x = _width  - (x + 1); }
       if (r & 1) { std::swap(x, y); }
     }
+    if (_dirty_tracking) { _add_dirty_rect(x, y, x, y); }
     auto bits = _write_bits;
     uint32_t index = x + y * _bitwidth;
     if (bits >= 8)
@@ -168,6 +172,7 @@ namespace lgfx
       if (r & 2)                  { x = _width  - (x + w); }
       if (r & 1) { std::swap(x, y);  std::swap(w, h); }
     }
+    if (_dirty_tracking) { _add_dirty_rect(x, y, x + w - 1, y + h - 1); }
 
     uint_fast8_t bits = _write_bits;
     if (bits >= 8)
@@ -325,6 +330,11 @@ namespace lgfx
   void Panel_Sprite::writePixels(pixelcopy_t* param, uint32_t length, bool use_dma)
   {
     (void)use_dma;
+    if (_dirty_tracking)
+    {
+      if (length <= _xe + 1u - _xpos) { markDirty(_xpos, _ypos, length, 1); }
+      else                            { markDirty(_xs, _ys, _xe - _xs + 1, _ye - _ys + 1); }
+    }
     uint_fast16_t xs = _xs;
     uint_fast16_t xe = _xe;
     uint_fast16_t ys = _ys;
@@ -428,6 +438,7 @@ namespace lgfx
 
   void Panel_Sprite::writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool)
   {
+    if (_dirty_tracking) { markDirty(x, y, w, h); }
     uint_fast8_t r = _rotation;
     if (r == 0 && param->transp == pixelcopy_t::NON_TRANSP && param->no_convert && _img.use_memcpy())
     {
@@ -488,6 +499,7 @@ namespace lgfx
 
   void Panel_Sprite::writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param)
   {
+    if (_dirty_tracking) { markDirty(x, y, w, h); }
     uint32_t nextx = 0;
     uint32_t nexty = 1 << pixelcopy_t::FP_SCALE;
     if (_rotation)
@@ -607,6 +619,7 @@ namespace lgfx
 
   void Panel_Sprite::copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y)
   {
+    if (_dirty_tracking) { markDirty(dst_x, dst_y, w, h); }
     uint_fast8_t r = _rotation;
     if (r)
     {
@@ -680,6 +693,140 @@ namespace lgfx
     }
   }
 
+  void Panel_Sprite::setDirtyTracking(bool enabled)
+  {
+    _dirty_tracking = enabled;
+    _dirty_count = 0;
+    markDirtyAll();
+  }
+
+  void Panel_Sprite::markDirty(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h)
+  {
+    if (!_dirty_tracking || !w || !h) return;
+    uint_fast8_t r = _rotation;
+    if (r)
+    {
+      if ((1u << r) & 0b10010110) { y = _height - (y + h); }
+      if (r & 2)                  { x = _width  - (x + w); }
+      if (r & 1) { std::swap(x, y);  std::swap(w, h); }
+    }
+    _add_dirty_rect(x, y, x + w - 1, y + h - 1);
+  }
+
+  void Panel_Sprite::markDirtyAll(void)
+  {
+    _dirty_count = 0;
+    if (!_dirty_tracking || !_panel_width || !_panel_height) return;
+    _add_dirty_rect(0, 0, _panel_width - 1, _panel_height - 1);
+  }
+
+  void Panel_Sprite::_add_dirty_rect(int_fast16_t l, int_fast16_t t, int_fast16_t r, int_fast16_t b)
+  {
+    auto rects = _dirty_rects;
+    uint_fast8_t count = _dirty_count;
+    for (;;)
+    {
+      int32_t area = (int32_t)(r - l + 1) * (b - t + 1);
+      uint_fast8_t best = count;
+      int32_t best_waste = INT32_MAX;
+      for (uint_fast8_t i = 0; i < count; ++i)
+      {
+        int_fast16_t rl = rects[i].l;
+        int_fast16_t rt = rects[i].t;
+        int_fast16_t rr = rects[i].r;
+        int_fast16_t rb = rects[i].b;
+        int32_t uw = std::max(r, rr) - std::min(l, rl) + 1;
+        int32_t uh = std::max(b, rb) - std::min(t, rt) + 1;
+        int32_t iw = std::min(r, rr) - std::max(l, rl) + 1;
+        int32_t ih = std::min(b, rb) - std::max(t, rt) + 1;
+        int32_t inter = (iw > 0 && ih > 0) ? iw * ih : 0;
+        /// Pixels that the union would send in excess of the two rectangles.
+        int32_t waste = uw * uh - (area + (int32_t)(rr - rl + 1) * (rb - rt + 1) - inter);
+        if (waste < best_waste)
+        {
+          best_waste = waste;
+          best = i;
+          if (waste <= 0) break;
+        }
+      }
+      /// Keep a separate rectangle unless the union costs nothing or the list is full.
+      if (best == count || (best_waste > 0 && count < dirty_rect_max)) break;
+
+      int_fast16_t rl = rects[best].l;
+      int_fast16_t rt = rects[best].t;
+      int_fast16_t rr = rects[best].r;
+      int_fast16_t rb = rects[best].b;
+      l = std::min(l, rl);
+      t = std::min(t, rt);
+      r = std::max(r, rr);
+      b = std::max(b, rb);
+      rects[best] = rects[--count];
+    }
+    auto& rc = rects[count];
+    rc.l = l;
+    rc.t = t;
+    rc.r = r;
+    rc.b = b;
+    _dirty_count = count + 1;
+  }
+
+//----------------------------------------------------------------------------
+
+  void LGFX_Sprite::markDirty(int32_t x, int32_t y, int32_t w, int32_t h)
+  {
+    if (_adjust_abs(x, w) || _adjust_abs(y, h)) return;
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (w > width()  - x) { w = width()  - x; }
+    if (h > height() - y) { h = height() - y; }
+    if (w <= 0 || h <= 0) return;
+    _panel_sprite.markDirty(x, y, w, h);
+  }
+
+  void LGFX_Sprite::push_sprite_dirty(LovyanGFX* dst, int32_t x, int32_t y, uint32_t transp)
+  {
+    int32_t w = _panel_sprite._panel_width;
+    int32_t h = _panel_sprite._panel_height;
+    bool use_dma = _panel_sprite.getSpriteBuffer()->use_dma();
+
+    /// The dirty areas are only meaningful where the previous frame was pushed.
+    bool same_place = (dst == _dirty_dst && x == _dirty_x && y == _dirty_y);
+    _dirty_dst = dst;
+    _dirty_x = x;
+    _dirty_y = y;
+
+    auto count = _panel_sprite.getDirtyRectCount();
+    if (!same_place || (count == 1 && _panel_sprite.getDirtyRects()[0].width() == w && _panel_sprite.getDirtyRects()[0].height() == h))
+    {
+      pixelcopy_t p(_img, dst->getColorDepth(), getColorDepth(), dst->hasPalette(), _palette, transp);
+      dst->pushImage(x, y, w, h, &p, use_dma);
+      _panel_sprite.clearDirtyRects();
+      return;
+    }
+    if (!count) return;
+
+    /// Each area is sent by clipping the destination to it, so that the panel receives
+    /// one window per area.
+    int32_t cx, cy, cw, ch;
+    dst->getClipRect(&cx, &cy, &cw, &ch);
+    auto rects = _panel_sprite.getDirtyRects();
+    dst->startWrite();
+    for (uint_fast8_t i = 0; i < count; ++i)
+    {
+      int32_t l = std::max<int32_t>(cx, x + rects[i].l);
+      int32_t t = std::max<int32_t>(cy, y + rects[i].t);
+      int32_t r = std::min<int32_t>(cx + cw - 1, x + rects[i].r);
+      int32_t b = std::min<int32_t>(cy + ch - 1, y + rects[i].b);
+      if (l > r || t > b) continue;
+      dst->setClipRect(l, t, r - l + 1, b - t + 1);
+      pixelcopy_t p(_img, dst->getColorDepth(), getColorDepth(), dst->hasPalette(), _palette, transp);
+      dst->pushImage(x, y, w, h, &p, use_dma);
+    }
+    dst->setClipRect(cx, cy, cw, ch);
+    dst->endWrite();
+    _panel_sprite.clearDirtyRects();
+  }
+
 //----------------------------------------------------------------------------
 
   bool LGFX_Sprite::create_from_bmp_file(DataWrapper* data, const char *path) {
@@ -22,6 +22,7 @@ Contributors:
 #include "LGFXBase.hpp"
 #include "misc/SpriteBuffer.hpp"
 #include "misc/bitmap.hpp"
+#include "misc/range.hpp"
 #include "Panel.hpp"
 
 namespace lgfx
@@ -89,8 +90,21 @@ namespace lgfx
 
     uint32_t readPixelValue(uint_fast16_t x, uint_fast16_t y);
 
+    /// Dirty-region tracking. The rectangles are kept in buffer coordinates (without rotation),
+    /// and the nearby ones are coalesced so that the list never exceeds dirty_rect_max entries.
+    static constexpr uint_fast8_t dirty_rect_max = 8;
+
+    void setDirtyTracking(bool enabled);
+    LGFX_INLINE bool getDirtyTracking(void) const { return _dirty_tracking; }
+    LGFX_INLINE uint_fast8_t getDirtyRectCount(void) const { return _dirty_count; }
+    LGFX_INLINE const range_rect_t* getDirtyRects(void) const { return _dirty_rects; }
+    LGFX_INLINE void clearDirtyRects(void) { _dirty_count = 0; }
+    void markDirty(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h);
+    void markDirtyAll(void);
+
   protected:
     void _rotate_pixelcopy(uint_fast16_t& x, uint_fast16_t& y, uint_fast16_t& w, uint_fast16_t& h, pixelcopy_t* param, uint32_t& nextx, uint32_t& nexty);
+    void _add_dirty_rect(int_fast16_t l, int_fast16_t t, int_fast16_t r, int_fast16_t b);
 
     SpriteBuffer _img;
 
@@ -99,6 +113,10 @@ namespace lgfx
     uint_fast16_t _panel_width;   // rotationしていない状態の幅;
     uint_fast16_t _panel_height;  // rotationしていない状態の高さ;
     uint_fast16_t _bitwidth;
+
+    range_rect_t _dirty_rects[dirty_rect_max];
+    uint_fast8_t _dirty_count = 0;
+    bool _dirty_tracking = false;
   };
 
   class LGFX_Sprite : public LovyanGFX
@@ -330,6 +348,20 @@ namespace lgfx
     template<typename T>
     LGFX_INLINE void fillSprite (const T& color) { fillScreen(color); }
 
+    /// When enabled, the drawing functions record the changed areas of the sprite,
+    /// and pushSprite sends only those areas if the sprite is pushed again to the same place.
+    /// Use markDirty after writing directly into the buffer returned by getBuffer.
+    void setDirtyTracking(bool enabled)
+    {
+      _panel_sprite.setDirtyTracking(enabled);
+      _dirty_dst = nullptr;
+    }
+    LGFX_INLINE bool getDirtyTracking(void) const { return _panel_sprite.getDirtyTracking(); }
+    LGFX_INLINE uint_fast8_t getDirtyRectCount(void) const { return _panel_sprite.getDirtyRectCount(); }
+    LGFX_INLINE void clearDirty(void) { _panel_sprite.clearDirtyRects(); }
+    LGFX_INLINE void markDirty(void) { _panel_sprite.markDirtyAll(); }
+    void markDirty(int32_t x, int32_t y, int32_t w, int32_t h);
+
     template<typename T>
     LGFX_INLINE void pushSprite(                int32_t x, int32_t y, const T& transp) { push_sprite(_parent, x, y, _write_conv.convert(transp) & _write_conv.colormask); }
     template<typename T>
@@ -395,6 +427,11 @@ namespace lgfx
 
     bool _psram = false;
 
+    // Where the sprite was last pushed; the dirty areas are relative to this content.
+    LovyanGFX* _dirty_dst = nullptr;
+    int32_t _dirty_x = 0;
+    int32_t _dirty_y = 0;
+
     bool create_palette(void)
     {
       if (_write_conv.bits > 8) return false;
@@ -420,10 +457,17 @@ namespace lgfx
 
     void push_sprite(LovyanGFX* dst, int32_t x, int32_t y, uint32_t transp = pixelcopy_t::NON_TRANSP)
     {
+      if (_panel_sprite.getDirtyTracking())
+      {
+        push_sprite_dirty(dst, x, y, transp);
+        return;
+      }
       pixelcopy_t p(_img, dst->getColorDepth(), getColorDepth(), dst->hasPalette(), _palette, transp);
       dst->pushImage(x, y, _panel_sprite._panel_width, _panel_sprite._panel_height, &p, _panel_sprite.getSpriteBuffer()->use_dma()); // DMA disable with use SPIRAM
     }
 
+    void push_sprite_dirty(LovyanGFX* dst, int32_t x, int32_t y, uint32_t transp);
+
     void push_rotate_zoom(LovyanGFX* dst, float x, float y, float angle, float zoom_x, float zoom_y, uint32_t transp = pixelcopy_t::NON_TRANSP)
     {
       dst->pushImageRotateZoom(x, y, _xpivot, _ypivot, angle, zoom_x, zoom_y, _panel_sprite._panel_width, _panel_sprite._panel_height, _img, transp, getColorDepth(), _palette.img24());
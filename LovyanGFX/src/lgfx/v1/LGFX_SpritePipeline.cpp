@@ -0,0 +1,304 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+
+#include "LGFX_SpritePipeline.hpp"
+
+#if defined (ESP_PLATFORM)
+ #include <freertos/FreeRTOS.h>
+ #include <freertos/task.h>
+ #include <freertos/queue.h>
+ #define LGFX_PIPELINE_USE_TASK
+#endif
+
+#ifdef min
+#undef min
+#endif
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  bool LGFX_SpritePipeline::begin(LovyanGFX* dst)
+  {
+    end();
+    if (dst == nullptr) { return false; }
+
+    uint_fast8_t count = _cfg.band_count;
+    if (count < 1) { count = 1; }
+    if (count > band_max) { count = band_max; }
+    int32_t h = std::min<int32_t>(_cfg.band_height, dst->height());
+    if (h < 1) { return false; }
+
+    for (uint_fast8_t i = 0; i < count; ++i)
+    {
+      _bands[i].setPsram(false);
+      _bands[i].setColorDepth(dst->getColorDepth());
+      if (!_bands[i].createSprite(dst->width(), h))
+      {
+        do { _bands[i].deleteSprite(); } while (i--);
+        return false;
+      }
+    }
+    _dst = dst;
+    _band_count = count;
+    _next_band = 0;
+    _pushed = false;
+    resetCounters();
+
+    if (_cfg.use_task) { _start_task(); }
+    return true;
+  }
+
+  void LGFX_SpritePipeline::end(void)
+  {
+    if (_dst == nullptr) { return; }
+    waitIdle();
+    _stop_task();
+    for (uint_fast8_t i = 0; i < _band_count; ++i)
+    {
+      _bands[i].deleteSprite();
+    }
+    _band_count = 0;
+    _dst = nullptr;
+  }
+
+  void LGFX_SpritePipeline::resetCounters(void)
+  {
+    _fps = 0.0f;
+    _frame_count = 0;
+    _fps_frames = 0;
+    _fps_time = millis();
+    _render_stall = 0;
+    _transfer_stall = 0;
+  }
+
+  void LGFX_SpritePipeline::_update_fps(void)
+  {
+    ++_frame_count;
+    ++_fps_frames;
+    auto now = millis();
+    auto elapsed = now - _fps_time;
+    if (elapsed >= 1000)
+    {
+      _fps = _fps_frames * 1000.0f / elapsed;
+      _fps_frames = 0;
+      _fps_time = now;
+    }
+  }
+
+  void LGFX_SpritePipeline::drawFrame(render_cb_t render, void* user)
+  {
+    if (_dst == nullptr || render == nullptr) { return; }
+    int32_t band_h = _bands[0].height();
+    int32_t height = _dst->height();
+
+#if defined (LGFX_PIPELINE_USE_TASK)
+    if (_task_handle)
+    {
+      auto free_queue = (QueueHandle_t)_free_queue;
+      auto send_queue = (QueueHandle_t)_send_queue;
+      for (int32_t y = 0; y < height; y += band_h)
+      {
+        item_t item;
+        if (pdTRUE != xQueueReceive(free_queue, &item, 0))
+        {
+          ++_render_stall;
+          xQueueReceive(free_queue, &item, portMAX_DELAY);
+        }
+        render(&_bands[item.index], y, user);
+        item.y = y;
+        item.flags = (y == 0 ? item_first : 0)
+                   | (y + band_h >= height ? item_last : 0);
+        xQueueSend(send_queue, &item, portMAX_DELAY);
+      }
+      _update_fps();
+      return;
+    }
+#endif
+
+    _dst->startWrite();
+    _pushed = false;
+    for (int32_t y = 0; y < height; y += band_h)
+    {
+      uint_fast8_t index = _next_band;
+      _next_band = (index + 1) % _band_count;
+      if (_pushed && index == _last_pushed)
+      { // only one band : its DMA must end before it is drawn again.
+        if (_dst->dmaBusy()) { ++_render_stall; }
+        _dst->waitDMA();
+      }
+      render(&_bands[index], y, user);
+      _push_band(index, y);
+    }
+    _dst->endWrite();
+    _update_fps();
+  }
+
+  void LGFX_SpritePipeline::_push_band(uint_fast8_t index, int32_t y)
+  {
+    if (_pushed)
+    { // the bus is still sending the previous band if the rendering was faster.
+      if (_dst->dmaBusy()) { ++_render_stall; }
+      else                 { ++_transfer_stall; }
+    }
+    _bands[index].pushSprite(_dst, 0, y);
+    _last_pushed = index;
+    _pushed = true;
+  }
+
+  void LGFX_SpritePipeline::waitIdle(void)
+  {
+#if defined (LGFX_PIPELINE_USE_TASK)
+    if (_task_handle)
+    {
+      auto free_queue = (QueueHandle_t)_free_queue;
+      item_t items[band_max];
+      for (uint_fast8_t i = 0; i < _band_count; ++i)
+      {
+        xQueueReceive(free_queue, &items[i], portMAX_DELAY);
+      }
+      for (uint_fast8_t i = 0; i < _band_count; ++i)
+      {
+        xQueueSend(free_queue, &items[i], 0);
+      }
+      return;
+    }
+#endif
+    if (_dst) { _dst->waitDMA(); }
+  }
+
+#if defined (LGFX_PIPELINE_USE_TASK)
+
+  bool LGFX_SpritePipeline::_start_task(void)
+  {
+    auto free_queue = xQueueCreate(band_max, sizeof(item_t));
+    auto send_queue = xQueueCreate(band_max + 1, sizeof(item_t));
+    if (free_queue == nullptr || send_queue == nullptr)
+    {
+      if (free_queue) { vQueueDelete(free_queue); }
+      if (send_queue) { vQueueDelete(send_queue); }
+      return false;
+    }
+    for (uint_fast8_t i = 0; i < _band_count; ++i)
+    {
+      item_t item = { 0, (uint8_t)i, 0 };
+      xQueueSend(free_queue, &item, 0);
+    }
+    _free_queue = free_queue;
+    _send_queue = send_queue;
+
+    BaseType_t core = _cfg.task_pinned_core;
+    if (core < 0 || core >= portNUM_PROCESSORS)
+    {
+      core = (xPortGetCoreID() + 1) % portNUM_PROCESSORS;
+    }
+    TaskHandle_t handle = nullptr;
+    if (pdPASS != xTaskCreatePinnedToCore(_task_main, "lgfx_pipeline", 4096, this, _cfg.task_priority, &handle, core))
+    {
+      vQueueDelete(free_queue);
+      vQueueDelete(send_queue);
+      _free_queue = nullptr;
+      _send_queue = nullptr;
+      return false;
+    }
+    _task_handle = handle;
+    return true;
+  }
+
+  void LGFX_SpritePipeline::_stop_task(void)
+  {
+    if (_task_handle == nullptr) { return; }
+    _caller_handle = xTaskGetCurrentTaskHandle();
+    item_t item = { 0, 0, item_stop };
+    xQueueSend((QueueHandle_t)_send_queue, &item, portMAX_DELAY);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    vQueueDelete((QueueHandle_t)_free_queue);
+    vQueueDelete((QueueHandle_t)_send_queue);
+    _free_queue = nullptr;
+    _send_queue = nullptr;
+    _task_handle = nullptr;
+  }
+
+  void LGFX_SpritePipeline::_task_main(void* arg)
+  {
+    auto me = (LGFX_SpritePipeline*)arg;
+    auto dst = me->_dst;
+    auto free_queue = (QueueHandle_t)me->_free_queue;
+    auto send_queue = (QueueHandle_t)me->_send_queue;
+    int_fast16_t inflight = -1;
+    bool in_frame = false;
+    item_t item;
+    for (;;)
+    {
+      if (pdTRUE != xQueueReceive(send_queue, &item, 0))
+      {
+        if (inflight >= 0)
+        {
+          dst->waitDMA();
+          item_t done = { 0, (uint8_t)inflight, 0 };
+          xQueueSend(free_queue, &done, portMAX_DELAY);
+          inflight = -1;
+        }
+        if (in_frame) { ++me->_transfer_stall; }
+        xQueueReceive(send_queue, &item, portMAX_DELAY);
+      }
+      if (item.flags & item_stop) { break; }
+
+      if (item.flags & item_first)
+      {
+        dst->startWrite();
+        in_frame = true;
+      }
+      me->_bands[item.index].pushSprite(dst, 0, item.y);
+
+      // The bus waits for the previous DMA before starting a new one,
+      // so the previous band can be drawn again.
+      if (inflight >= 0)
+      {
+        item_t done = { 0, (uint8_t)inflight, 0 };
+        xQueueSend(free_queue, &done, portMAX_DELAY);
+      }
+      inflight = item.index;
+
+      if (item.flags & item_last)
+      {
+        dst->waitDMA();
+        dst->endWrite();
+        in_frame = false;
+        item_t done = { 0, (uint8_t)inflight, 0 };
+        xQueueSend(free_queue, &done, portMAX_DELAY);
+        inflight = -1;
+      }
+    }
+    xTaskNotifyGive((TaskHandle_t)me->_caller_handle);
+    vTaskDelete(nullptr);
+  }
+
+#else
+
+  bool LGFX_SpritePipeline::_start_task(void) { return false; }
+  void LGFX_SpritePipeline::_stop_task(void) {}
+  void LGFX_SpritePipeline::_task_main(void*) {}
+
+#endif
+
+//----------------------------------------------------------------------------
+ }
+}
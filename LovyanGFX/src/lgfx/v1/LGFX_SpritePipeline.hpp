@@ -0,0 +1,140 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "LGFX_Sprite.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// @brief Renders a screen in horizontal bands while the previous band is being sent.
+  /// On FreeRTOS targets, the transfer runs in a task (on the other core by default),
+  /// so the caller only renders. Elsewhere the bands are pushed by DMA from the caller,
+  /// and the next band is rendered while the DMA is running.
+  /// The destination must not be used by anyone else between begin() and end().
+  class LGFX_SpritePipeline
+  {
+  public:
+    static constexpr uint8_t band_max = 4;
+
+    /// @brief Draws one band. The band covers the lines y to y + band->height() - 1 of the destination.
+    typedef void (*render_cb_t)(LGFX_Sprite* band, int32_t y, void* user);
+
+    struct config_t
+    {
+      /// number of lines of each band
+      uint16_t band_height = 40;
+
+      /// number of bands (2 to band_max)
+      uint8_t band_count = 2;
+
+      /// run the transfer in a FreeRTOS task (ignored where FreeRTOS is unavailable)
+      bool use_task = true;
+
+      /// transfer task priority
+      uint8_t task_priority = 2;
+
+      /// transfer task pinned core. (-1 = the core not running begin())
+      int8_t task_pinned_core = -1;
+    };
+
+    LGFX_SpritePipeline(void) = default;
+    LGFX_SpritePipeline(const LGFX_SpritePipeline&) = delete;
+    LGFX_SpritePipeline& operator=(const LGFX_SpritePipeline&) = delete;
+    virtual ~LGFX_SpritePipeline(void) { end(); }
+
+    const config_t& config(void) const { return _cfg; }
+    void config(const config_t& cfg) { _cfg = cfg; }
+
+    /// @brief Allocates the bands in DMA capable memory, with the color depth of dst.
+    bool begin(LovyanGFX* dst);
+
+    /// @brief Waits for the last band, then releases the bands and the task.
+    void end(void);
+
+    /// @brief Renders and sends every band of one frame.
+    /// Returns once the last band is rendered; its transfer may still be running.
+    void drawFrame(render_cb_t render, void* user = nullptr);
+
+    /// @brief Waits until every band has been sent.
+    void waitIdle(void);
+
+    LovyanGFX* getTarget(void) const { return _dst; }
+
+    /// frames per second, updated about once per second
+    float getFps(void) const { return _fps; }
+    uint32_t getFrameCount(void) const { return _frame_count; }
+
+    /// number of times the renderer waited for a band that was still being sent
+    uint32_t getRenderStallCount(void) const { return _render_stall; }
+
+    /// number of times the transfer waited for a band that was still being rendered
+    uint32_t getTransferStallCount(void) const { return _transfer_stall; }
+
+    void resetCounters(void);
+
+  protected:
+    struct item_t
+    {
+      int16_t y;
+      uint8_t index;
+      uint8_t flags;
+    };
+    enum item_flag_t : uint8_t
+    {
+      item_first = 1,
+      item_last  = 2,
+      item_stop  = 4,
+    };
+
+    config_t _cfg;
+    LovyanGFX* _dst = nullptr;
+    LGFX_Sprite _bands[band_max];
+    uint8_t _band_count = 0;
+    uint8_t _next_band = 0;
+    uint8_t _last_pushed = 0;
+    bool _pushed = false;
+
+    float _fps = 0.0f;
+    uint32_t _frame_count = 0;
+    uint32_t _fps_frames = 0;
+    unsigned long _fps_time = 0;
+    volatile uint32_t _render_stall = 0;
+    volatile uint32_t _transfer_stall = 0;
+
+    // FreeRTOS handles, kept opaque so that this header stays platform independent.
+    void* _task_handle = nullptr;
+    void* _free_queue = nullptr;
+    void* _send_queue = nullptr;
+    void* _caller_handle = nullptr;
+
+    void _push_band(uint_fast8_t index, int32_t y);
+    void _update_fps(void);
+    bool _start_task(void);
+    void _stop_task(void);
+    static void _task_main(void* arg);
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
+
+using LGFX_SpritePipeline = lgfx::LGFX_SpritePipeline;
@@ -0,0 +1,242 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+
+#include "LGFX_TiledRenderer.hpp"
+
+#include "misc/pixelcopy.hpp"
+#include "platforms/common.hpp"
+
+#include <string.h>
+
+#ifdef min
+#undef min
+#endif
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  bool LGFX_TiledRenderer::begin(LovyanGFX* dst)
+  {
+    end();
+    if (dst == nullptr || !_begin(dst->width(), dst->height(), dst->getColorDepth())) { return false; }
+    _dst = dst;
+    return true;
+  }
+
+  bool LGFX_TiledRenderer::begin(DividedFrameBuffer* fb, int32_t width, color_depth_t depth)
+  {
+    end();
+    if (fb == nullptr || !fb->isInitialized()
+     || (int32_t)fb->getLineSize() < width * ((depth & color_depth_t::bit_mask) >> 3)
+     || !_begin(width, fb->getTotalLines(), depth)) { return false; }
+    _fb = fb;
+    return true;
+  }
+
+  bool LGFX_TiledRenderer::_begin(int32_t width, int32_t height, color_depth_t depth)
+  {
+    int32_t tw = std::min<int32_t>(_cfg.tile_width , width);
+    int32_t th = std::min<int32_t>(_cfg.tile_height, height);
+    if (tw < 1 || th < 1 || !_canvas.createList(width, height, depth)) { return false; }
+
+    for (size_t i = 0; i < 2; ++i)
+    { // the tiles are in internal RAM, so that they can be sent by DMA.
+      _tile[i].setPsram(false);
+      _tile[i].setColorDepth(depth);
+      if (!_tile[i].createSprite(tw, th))
+      {
+        end();
+        return false;
+      }
+    }
+
+    _width = width;
+    _height = height;
+    _tiles_x = (width  + tw - 1) / tw;
+    _tiles_y = (height + th - 1) / th;
+    _bin_start = (uint32_t*)heap_alloc((_tiles_x * _tiles_y + 1) * sizeof(uint32_t));
+    if (_bin_start == nullptr)
+    {
+      end();
+      return false;
+    }
+    return true;
+  }
+
+  void LGFX_TiledRenderer::end(void)
+  {
+    if (_dst) { _dst->waitDMA(); }
+    _tile[0].deleteSprite();
+    _tile[1].deleteSprite();
+    _canvas.deleteList();
+    if (_bins) { heap_free(_bins); }
+    if (_bin_start) { heap_free(_bin_start); }
+    _bins = nullptr;
+    _bin_start = nullptr;
+    _bins_capacity = 0;
+    _tiles_x = 0;
+    _tiles_y = 0;
+    _dst = nullptr;
+    _fb = nullptr;
+  }
+
+  /// Makes the list of the commands that touch each tile, in the recorded order.
+  bool LGFX_TiledRenderer::_sort_commands(void)
+  {
+    size_t tiles = _tiles_x * _tiles_y;
+    int32_t tw = _tile[0].width();
+    int32_t th = _tile[0].height();
+    auto data = _canvas.getListData();
+    auto end = data + _canvas.getListSize();
+
+    memset(_bin_start, 0, (tiles + 1) * sizeof(uint32_t));
+    size_t total = 0;
+    for (auto p = data; p < end; p += ((const LGFX_DisplayList::command_t*)p)->size)
+    {
+      auto cmd = (const LGFX_DisplayList::command_t*)p;
+      if (!cmd->w || !cmd->h) { continue; }
+      int32_t tx1 = std::min<int32_t>(_tiles_x - 1, (cmd->x + cmd->w - 1) / tw);
+      int32_t ty1 = std::min<int32_t>(_tiles_y - 1, (cmd->y + cmd->h - 1) / th);
+      for (int32_t ty = cmd->y / th; ty <= ty1; ++ty)
+      {
+        for (int32_t tx = cmd->x / tw; tx <= tx1; ++tx)
+        {
+          ++_bin_start[ty * _tiles_x + tx + 1];
+          ++total;
+        }
+      }
+    }
+    _binned_count = total;
+
+    if (_bins_capacity < total)
+    {
+      if (_bins) { heap_free(_bins); }
+      _bins_capacity = 0;
+      _bins = (uint32_t*)heap_alloc_psram(total * sizeof(uint32_t));
+      if (_bins == nullptr) { _bins = (uint32_t*)heap_alloc(total * sizeof(uint32_t)); }
+      if (_bins == nullptr) { return false; }
+      _bins_capacity = total;
+    }
+
+    // _bin_start[t] becomes the start of the tile t, and is used as its write position,
+    // so that it ends at the end of the tile t.
+    for (size_t t = 1; t < tiles; ++t) { _bin_start[t + 1] += _bin_start[t]; }
+    for (auto p = data; p < end; p += ((const LGFX_DisplayList::command_t*)p)->size)
+    {
+      auto cmd = (const LGFX_DisplayList::command_t*)p;
+      if (!cmd->w || !cmd->h) { continue; }
+      int32_t tx1 = std::min<int32_t>(_tiles_x - 1, (cmd->x + cmd->w - 1) / tw);
+      int32_t ty1 = std::min<int32_t>(_tiles_y - 1, (cmd->y + cmd->h - 1) / th);
+      for (int32_t ty = cmd->y / th; ty <= ty1; ++ty)
+      {
+        for (int32_t tx = cmd->x / tw; tx <= tx1; ++tx)
+        {
+          _bins[_bin_start[ty * _tiles_x + tx]++] = p - data;
+        }
+      }
+    }
+    return true;
+  }
+
+  void LGFX_TiledRenderer::_load_tile(LGFX_Sprite* tile, int32_t x, int32_t y)
+  {
+    if (!_cfg.preserve || _fb == nullptr)
+    {
+      tile->fillScreen(_cfg.clear_color);
+      return;
+    }
+    size_t bytes = tile->getColorConverter()->bytes;
+    size_t len = std::min<int32_t>(tile->width(), _width - x) * bytes;
+    int32_t h = std::min<int32_t>(tile->height(), _height - y);
+    auto dst = (uint8_t*)tile->getBuffer();
+    for (int32_t i = 0; i < h; ++i)
+    {
+      memcpy(&dst[i * tile->width() * bytes], &_fb->getLineBuffer(y + i)[x * bytes], len);
+    }
+  }
+
+  void LGFX_TiledRenderer::_store_tile(LGFX_Sprite* tile, int32_t x, int32_t y)
+  {
+    if (_dst)
+    { // the previous tile must be sent before the DMA of this one starts.
+      _dst->waitDMA();
+      auto depth = tile->getColorDepth();
+      pixelcopy_t p(tile->getBuffer(), depth, depth);
+      _dst->pushImage(x, y, tile->width(), tile->height(), &p, true);
+      return;
+    }
+    size_t bytes = tile->getColorConverter()->bytes;
+    size_t len = std::min<int32_t>(tile->width(), _width - x) * bytes;
+    int32_t h = std::min<int32_t>(tile->height(), _height - y);
+    auto src = (const uint8_t*)tile->getBuffer();
+    for (int32_t i = 0; i < h; ++i)
+    {
+      memcpy(&_fb->getLineBuffer(y + i)[x * bytes], &src[i * tile->width() * bytes], len);
+    }
+  }
+
+  void LGFX_TiledRenderer::render(bool clear_canvas)
+  {
+    if (_tiles_x == 0) { return; }
+    int32_t tw = _tile[0].width();
+    int32_t th = _tile[0].height();
+    auto data = _canvas.getListData();
+    auto end = data + _canvas.getListSize();
+    bool sorted = _sort_commands();
+
+    if (_dst) { _dst->startWrite(); }
+    size_t t = 0;
+    for (int32_t ty = 0; ty < _tiles_y; ++ty)
+    {
+      for (int32_t tx = 0; tx < _tiles_x; ++tx, ++t)
+      {
+        auto tile = &_tile[t & 1];
+        int32_t x = tx * tw;
+        int32_t y = ty * th;
+        _load_tile(tile, x, y);
+        if (sorted)
+        {
+          for (size_t i = (t ? _bin_start[t - 1] : 0); i < _bin_start[t]; ++i)
+          {
+            _canvas.replayCommand(tile, (const LGFX_DisplayList::command_t*)&data[_bins[i]], -x, -y);
+          }
+        }
+        else
+        { // not enough memory for the lists : every command is clipped by the tile.
+          for (auto p = data; p < end; p += ((const LGFX_DisplayList::command_t*)p)->size)
+          {
+            _canvas.replayCommand(tile, (const LGFX_DisplayList::command_t*)p, -x, -y);
+          }
+        }
+        _store_tile(tile, x, y);
+      }
+    }
+    if (_dst)
+    {
+      _dst->waitDMA();
+      _dst->endWrite();
+    }
+    if (clear_canvas) { _canvas.clearList(); }
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -0,0 +1,106 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "LGFX_Sprite.hpp"
+#include "LGFX_DisplayList.hpp"
+#include "misc/DividedFrameBuffer.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// @brief Draws a frame tile by tile in a small buffer in internal RAM.
+  /// The frame is first recorded on canvas(). render() sorts the recorded commands
+  /// into per-tile lists, draws each tile in the tile buffer, then copies it into a
+  /// DividedFrameBuffer, or sends it to a LovyanGFX by DMA while the next tile is drawn.
+  /// The overdraw stays in the tile buffer, and the frame buffer (which may be in PSRAM)
+  /// is written once per pixel.
+  /// copyRect is drawn within each tile, so its source must be in the same tile as its destination.
+  class LGFX_TiledRenderer
+  {
+  public:
+    struct config_t
+    {
+      uint16_t tile_width = 64;
+      uint16_t tile_height = 32;
+
+      /// color (rgb888) of the tiles before the commands are drawn
+      uint32_t clear_color = 0;
+
+      /// true: the tiles start with the content of the frame buffer instead of clear_color.
+      /// (only when the output is a DividedFrameBuffer)
+      bool preserve = false;
+    };
+
+    LGFX_TiledRenderer(void) = default;
+    LGFX_TiledRenderer(const LGFX_TiledRenderer&) = delete;
+    LGFX_TiledRenderer& operator=(const LGFX_TiledRenderer&) = delete;
+    virtual ~LGFX_TiledRenderer(void) { end(); }
+
+    const config_t& config(void) const { return _cfg; }
+    void config(const config_t& cfg) { _cfg = cfg; }
+
+    /// @brief Renders to dst (a panel or a sprite), with its size and color depth.
+    bool begin(LovyanGFX* dst);
+
+    /// @brief Renders to the lines of fb. Each line holds width pixels of the depth.
+    bool begin(DividedFrameBuffer* fb, int32_t width, color_depth_t depth);
+
+    void end(void);
+
+    /// @brief The frame is drawn here before render().
+    LGFX_DisplayList& canvas(void) { return _canvas; }
+
+    /// @brief Draws the recorded frame, then clears the canvas if clear_canvas is true.
+    void render(bool clear_canvas = true);
+
+    size_t getTileCount(void) const { return _tiles_x * _tiles_y; }
+
+    /// number of commands drawn in the last render(), counted once per tile
+    uint32_t getBinnedCount(void) const { return _binned_count; }
+
+  protected:
+    config_t _cfg;
+    LGFX_DisplayList _canvas;
+    LGFX_Sprite _tile[2];
+    LovyanGFX* _dst = nullptr;
+    DividedFrameBuffer* _fb = nullptr;
+
+    uint32_t* _bins = nullptr;         // command offsets, sorted by tile
+    uint32_t* _bin_start = nullptr;    // end index in _bins of each tile
+    size_t _bins_capacity = 0;
+    uint32_t _binned_count = 0;
+    uint16_t _width = 0;
+    uint16_t _height = 0;
+    uint16_t _tiles_x = 0;
+    uint16_t _tiles_y = 0;
+
+    bool _begin(int32_t width, int32_t height, color_depth_t depth);
+    bool _sort_commands(void);
+    void _load_tile(LGFX_Sprite* tile, int32_t x, int32_t y);
+    void _store_tile(LGFX_Sprite* tile, int32_t x, int32_t y);
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
+
+using LGFX_TiledRenderer = lgfx::LGFX_TiledRenderer;
@@ -737,6 +737,7 @@ label_nextbyte: /// 次のデータを取得する;
   bool VLWfont::unloadFont(void)
   {
     _fontLoaded = false;
+    clearCache();
     if (gUnicode)  { heap_free(gUnicode);  gUnicode  = nullptr; }
     if (gWidth)    { heap_free(gWidth);    gWidth    = nullptr; }
     if (gxAdvance) { heap_free(gxAdvance); gxAdvance = nullptr; }
@@ -874,6 +875,129 @@ label_nextbyte: /// 次のデータを取得する;
     return true;
   }
 
+//----------------------------------------------------------------------------
+
+  struct VLWfont::glyph_cache_t
+  {
+    glyph_cache_t* next;
+    uint32_t size;       // bytes allocated for this entry
+    uint32_t header[6];  // glyph metrics, as stored in the file
+    uint32_t fore;
+    uint32_t back;
+    color_depth_t depth; // format of image(), 0 if there is only the alpha bitmap
+    uint16_t gnum;
+
+    int32_t height(void) const { return getSwap32(header[0]); }
+    int32_t width(void) const { return getSwap32(header[1]); }
+    uint8_t* alpha(void) { return (uint8_t*)&this[1]; }
+    uint8_t* image(void) { return alpha() + width() * height(); }
+  };
+
+  void VLWfont::setCacheSize(size_t bytes)
+  {
+    _cache_limit = bytes;
+    cache_trim(bytes);
+  }
+
+  void VLWfont::clearCache(void) const
+  {
+    cache_trim(0);
+  }
+
+  void VLWfont::cache_trim(size_t limit) const
+  {
+    while (_cache_used > limit)
+    { // release the least recently used entry, at the end of the list.
+      auto prev = &_cache_head;
+      while ((*prev)->next) { prev = &(*prev)->next; }
+      _cache_used -= (*prev)->size;
+      heap_free(*prev);
+      *prev = nullptr;
+    }
+  }
+
+  /// depth 0 matches any entry of this glyph. The entry found becomes the most recently used.
+  VLWfont::glyph_cache_t* VLWfont::cache_find(uint16_t gnum, uint32_t fore, uint32_t back, color_depth_t depth) const
+  {
+    for (auto prev = &_cache_head; *prev; prev = &(*prev)->next)
+    {
+      auto entry = *prev;
+      if (entry->gnum != gnum) continue;
+      if (depth && (entry->depth != depth || entry->fore != fore || entry->back != back)) continue;
+      *prev = entry->next;
+      entry->next = _cache_head;
+      _cache_head = entry;
+      return entry;
+    }
+    return nullptr;
+  }
+
+  /// conv == nullptr keeps only the alpha bitmap. `replace` is an entry of the same glyph that becomes useless.
+  VLWfont::glyph_cache_t* VLWfont::cache_add(uint16_t gnum, const uint32_t* header, const uint8_t* alpha, uint32_t fore, uint32_t back, color_conv_t* conv, glyph_cache_t* replace) const
+  {
+    int32_t h = getSwap32(header[0]);
+    int32_t w = getSwap32(header[1]);
+    size_t len = w * h;
+    size_t size = sizeof(glyph_cache_t) + len * (conv ? 1 + conv->bytes : 1);
+    if (size > _cache_limit) { return nullptr; }
+
+    auto entry = (glyph_cache_t*)heap_alloc_psram(size);
+    if (entry == nullptr) { entry = (glyph_cache_t*)heap_alloc(size); }
+    if (entry == nullptr) { return nullptr; }
+
+    entry->size = size;
+    memcpy(entry->header, header, sizeof(entry->header));
+    entry->fore = fore;
+    entry->back = back;
+    entry->depth = conv ? conv->depth : (color_depth_t)0;
+    entry->gnum = gnum;
+    memcpy(entry->alpha(), alpha, len);
+
+    if (conv)
+    {
+      uint32_t raw_back = conv->convert(back);
+      uint32_t raw_fore = conv->convert(fore);
+      int32_t fore_r = (fore >> 16) & 0xFF;
+      int32_t fore_g = (fore >>  8) & 0xFF;
+      int32_t fore_b =  fore        & 0xFF;
+      int32_t back_r = (back >> 16) & 0xFF;
+      int32_t back_g = (back >>  8) & 0xFF;
+      int32_t back_b =  back        & 0xFF;
+      size_t bytes = conv->bytes;
+      auto dst = entry->image();
+      for (size_t i = 0; i < len; ++i, dst += bytes)
+      { // same blending as the pixel by pixel drawing.
+        uint32_t raw = raw_back;
+        if (alpha[i] == 0xFF) { raw = raw_fore; }
+        else if (alpha[i])
+        {
+          int32_t p = 1 + (uint32_t)alpha[i];
+          raw = conv->convert(color888( ( fore_r * p + back_r * (257 - p)) >> 8
+                                      , ( fore_g * p + back_g * (257 - p)) >> 8
+                                      , ( fore_b * p + back_b * (257 - p)) >> 8 ));
+        }
+        memcpy(dst, &raw, bytes);
+      }
+    }
+
+    if (replace)
+    {
+      for (auto prev = &_cache_head; *prev; prev = &(*prev)->next)
+      {
+        if (*prev != replace) continue;
+        *prev = replace->next;
+        _cache_used -= replace->size;
+        heap_free(replace);
+        break;
+      }
+    }
+    cache_trim(_cache_limit - size);
+    entry->next = _cache_head;
+    _cache_head = entry;
+    _cache_used += size;
+    return entry;
+  }
+
 //----------------------------------------------------------------------------
 
   size_t VLWfont::drawChar(LGFXBase* gfx, int32_t x, int32_t y, uint16_t code, const TextStyle* style, FontMetrics* metrics, int32_t& filled_x) const
@@ -882,6 +1006,7 @@ label_nextbyte: /// 次のデータを取得する;
 
     uint32_t buffer[6] = {0};
     uint16_t gNum = 0;
+    glyph_cache_t* glyph = nullptr;
 
     int32_t sy = 65536 * style->size_y;
     y += (metrics->y_offset * sy) >> 16;
@@ -891,6 +1016,8 @@ label_nextbyte: /// 次のデータを取得する;
       buffer[2] = getSwap32(this->spaceWidth);
     } else if (!this->getUnicodeIndex(code, &gNum)) {
       return drawCharDummy(gfx, x, y, this->spaceWidth, metrics->height, style, filled_x);
+    } else if (_cache_limit && nullptr != (glyph = cache_find(gNum, 0, 0, (color_depth_t)0))) {
+      memcpy(buffer, glyph->header, sizeof(buffer));
     } else {
       file->preRead();
       file->seek(28 + gNum * 28);
@@ -908,10 +1035,16 @@ label_nextbyte: /// 次のデータを取得する;
     int32_t yoffset  = (this->maxAscent - dY);
 //      int32_t yoffset = (gfx->_font_metrics.y_offset) - dY;
 
-    auto pixel = (uint8_t*)alloca(w * h);
-    if (gNum != 0xFFFF) {
-      file->read(pixel, w * h);
-      file->postRead();
+    uint8_t* pixel;
+    if (glyph) {
+      pixel = glyph->alpha();
+    } else {
+      pixel = (uint8_t*)alloca(w * h);
+      if (gNum != 0xFFFF) {
+        file->read(pixel, w * h);
+        file->postRead();
+        if (_cache_limit) { glyph = cache_add(gNum, buffer, pixel, 0, 0, nullptr, nullptr); }
+      }
     }
 
     gfx->startWrite();
@@ -948,6 +1081,46 @@ label_nextbyte: /// 次のデータを取得する;
       int32_t fore_g = ((style->fore_rgb888>> 8)&0xFF);
       int32_t fore_b = ((style->fore_rgb888)    &0xFF);
 
+      auto conv = gfx->getColorConverter();
+      if (glyph && fillbg && 0 < w && left <= x
+       && sx == 65536 && sy == 65536
+       && !gfx->hasPalette() && conv->bits >= 8 && conv->bits <= 24)
+      { // cached glyph, already blended with the background in the destination format.
+        if (glyph->depth != conv->depth || glyph->fore != style->fore_rgb888 || glyph->back != style->back_rgb888)
+        {
+          auto blended = cache_find(gNum, style->fore_rgb888, style->back_rgb888, conv->depth);
+          if (blended == nullptr)
+          {
+            blended = cache_add(gNum, buffer, glyph->alpha(), style->fore_rgb888, style->back_rgb888, conv, glyph->depth ? nullptr : glyph);
+          }
+          glyph = blended;
+        }
+      }
+      else
+      {
+        glyph = nullptr;
+      }
+
+      if (glyph)
+      {
+        gfx->setRawColor(colortbl[0]);
+        if (yoffset > 0) {
+          gfx->writeFillRect(left, y, right - left, yoffset);
+        }
+        int32_t y0 = yoffset + h;
+        if (y0 < metrics->height) {
+          gfx->writeFillRect(left, y + y0, right - left, metrics->height - y0);
+        }
+        if (left < x) {
+          gfx->writeFillRect(left, y + yoffset, x - left, h);
+        }
+        if (x + w < right) {
+          gfx->writeFillRect(x + w, y + yoffset, right - x - w, h);
+        }
+        pixelcopy_t p(glyph->image(), conv->depth, conv->depth);
+        gfx->pushImage(x, y + yoffset, w, h, &p);
+      }
+      else
       if (fillbg || !gfx->isReadable() || gfx->hasPalette())
       { // fill background mode  or unreadable panel  or palette sprite mode
         if (left < right && fillbg) {
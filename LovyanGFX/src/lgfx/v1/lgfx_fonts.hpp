@@ -15,6 +15,7 @@ namespace lgfx
   struct IFont;
   struct FontMetrics;
   struct TextStyle;
+  struct color_conv_t;
 
   struct IFont
   {
@@ -256,6 +257,28 @@ namespace lgfx
     bool updateFontMetric(FontMetrics *metrics, uint16_t uniCode) const override;
 
     bool getUnicodeIndex(uint16_t unicode, uint16_t *index) const;
+
+    /// @brief Keeps recently drawn glyphs in RAM, up to `bytes` in total (0 = disabled).
+    /// Each glyph keeps its alpha bitmap, so it is not read from the file again.
+    /// When text is drawn unscaled with a background color, the glyph is also kept
+    /// blended and converted to the destination color format for this (fg, bg) pair,
+    /// and is drawn with a single pushImage.
+    /// The least recently used glyphs are released first.
+    void setCacheSize(size_t bytes);
+    size_t getCacheSize(void) const { return _cache_limit; }
+    size_t getCacheUsed(void) const { return _cache_used; }
+    void clearCache(void) const;
+
+  protected:
+    struct glyph_cache_t;
+
+    size_t _cache_limit = 0;
+    mutable size_t _cache_used = 0;
+    mutable glyph_cache_t* _cache_head = nullptr;  // most recently used first
+
+    glyph_cache_t* cache_find(uint16_t gnum, uint32_t fore, uint32_t back, color_depth_t depth) const;
+    glyph_cache_t* cache_add(uint16_t gnum, const uint32_t* header, const uint8_t* alpha, uint32_t fore, uint32_t back, color_conv_t* conv, glyph_cache_t* replace) const;
+    void cache_trim(size_t limit) const;
   };
 
 //----------------------------------------------------------------------------
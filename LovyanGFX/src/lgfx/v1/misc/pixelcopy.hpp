@@ -138,6 +138,51 @@ namespace lgfx
            : nullptr;
     }
 
+    /// true when the source is read one pixel at a time along a row (no scaling nor rotation).
+    static inline bool is_row_copy(const pixelcopy_t* param)
+    {
+      return param->src_x32_add == (1u << FP_SCALE) && param->src_y32_add == 0;
+    }
+
+    /// Palette row without scaling. For palettes of up to 16 colors, the palette is first
+    /// converted to the destination format, so that each pixel is a table lookup.
+    template <typename TDst, typename TPalette>
+    static uint32_t copy_palette_row(TDst* __restrict d, uint32_t index, uint32_t last, pixelcopy_t* __restrict param)
+    {
+      auto s = static_cast<const uint8_t*>(param->src_data);
+      auto pal = static_cast<const TPalette*>(param->palette);
+      auto transp   = param->transp;
+      auto src_bits = param->src_bits;
+      auto src_mask = param->src_mask;
+      uint32_t i = (param->src_x + param->src_y * param->src_bitwidth) * src_bits;
+      uint32_t start = index;
+      if (src_bits <= 4 && last - index >= 32u)
+      {
+        TDst lut[16];
+        for (uint32_t k = 0; k <= src_mask; ++k)
+        {
+          lut[k].set(color_convert<TDst, TPalette>(pal[k].get()));
+        }
+        do {
+          uint32_t raw = (pgm_read_byte(&s[i >> 3]) >> (-(int32_t)(i + src_bits) & 7)) & src_mask;
+          if (raw == transp) break;
+          d[index] = lut[raw];
+          i += src_bits;
+        } while (++index != last);
+      }
+      else
+      {
+        do {
+          uint32_t raw = (pgm_read_byte(&s[i >> 3]) >> (-(int32_t)(i + src_bits) & 7)) & src_mask;
+          if (raw == transp) break;
+          d[index].set(color_convert<TDst, TPalette>(pal[raw].get()));
+          i += src_bits;
+        } while (++index != last);
+      }
+      param->src_x32 += (index - start) << FP_SCALE;
+      return index;
+    }
+
     template <typename TDst, typename TPalette>
     static uint32_t copy_palette_fast(void* __restrict dst, uint32_t index, uint32_t last, pixelcopy_t* __restrict param)
     {
@@ -181,6 +226,10 @@ namespace lgfx
       auto d = static_cast<TDst*>(dst);
       auto pal = static_cast<const TPalette*>(param->palette);
       auto transp     = param->transp;
+      if (is_row_copy(param))
+      {
+        return copy_palette_row<TDst, TPalette>(d, index, last, param);
+      }
       do {
         uint32_t i = (param->src_x + param->src_y * param->src_bitwidth) * param->src_bits;
         uint32_t raw = (pgm_read_byte(&s[i >> 3]) >> (-(int32_t)(i + param->src_bits) & 7)) & param->src_mask;
@@ -202,6 +251,66 @@ namespace lgfx
       auto src_y32_add = param->src_y32_add;
       auto src_x32 = param->src_x32;
       auto src_y32 = param->src_y32;
+      if (src_x32_add == (1u << FP_SCALE) && src_y32_add == 0)
+      { /// Contiguous source row : the index is computed once.
+        auto sp = &s[(src_x32 >> FP_SCALE) + (src_y32 >> FP_SCALE) * src_bitwidth];
+        auto transp = param->transp;
+        uint32_t i = index;
+        if (transp == NON_TRANSP)
+        {
+          do
+          {
+            d[i].set(color_convert<TDst, TSrc>(sp[i - index].get()));
+          } while (++i != last);
+        }
+        else
+        {
+          do
+          {
+            uint32_t raw = sp[i - index].get();
+            if (raw == transp) break;
+            d[i].set(color_convert<TDst, TSrc>(raw));
+          } while (++i != last);
+        }
+        param->src_x32 = src_x32 + ((i - index) << FP_SCALE);
+        return i;
+      }
+      if (((src_x32_add | src_y32_add) & ((1u << FP_SCALE) - 1)) == 0)
+      { /// Rotation by 90/180/270 degrees, mirroring or integer reduction : the source index moves by a constant step.
+        int32_t step = ((int32_t)src_x32_add >> FP_SCALE) + ((int32_t)src_y32_add >> FP_SCALE) * (int32_t)src_bitwidth;
+        int32_t pos = (src_x32 >> FP_SCALE) + (src_y32 >> FP_SCALE) * src_bitwidth;
+        auto transp = param->transp;
+        uint32_t i = index;
+        do
+        {
+          uint32_t raw = s[pos].get();
+          if (raw == transp) break;
+          d[i].set(color_convert<TDst, TSrc>(raw));
+          pos += step;
+        } while (++i != last);
+        param->src_x32 = src_x32 + (i - index) * src_x32_add;
+        param->src_y32 = src_y32 + (i - index) * src_y32_add;
+        return i;
+      }
+      if (src_y32_add == 0 && src_x32_add < (1u << FP_SCALE))
+      { /// Horizontal enlargement : each source pixel is converted once for its whole run.
+        auto sp = &s[(src_y32 >> FP_SCALE) * src_bitwidth];
+        auto transp = param->transp;
+        do
+        {
+          uint32_t x = src_x32 >> FP_SCALE;
+          uint32_t raw = sp[x].get();
+          if (raw == transp) break;
+          auto color = color_convert<TDst, TSrc>(raw);
+          do
+          {
+            d[index].set(color);
+            src_x32 += src_x32_add;
+          } while (++index != last && (src_x32 >> FP_SCALE) == x);
+        } while (index != last);
+        param->src_x32 = src_x32;
+        return index;
+      }
       do {
         uint32_t i = (src_x32 >> FP_SCALE) + (src_y32 >> FP_SCALE) * src_bitwidth;
         uint32_t raw = s[i].get();
@@ -456,6 +565,30 @@ namespace lgfx
       auto src_x32_add = param->src_x32_add;
       auto src_y32_add = param->src_y32_add;
       auto s = static_cast<const TSrc*>(param->src_data);
+      if (src_x32_add == (1u << FP_SCALE) && src_y32_add == 0)
+      { /// Contiguous source row : the index is computed once.
+        auto sp = &s[param->src_x + param->src_y * param->src_bitwidth];
+        param->src_x32 += (last - index) << FP_SCALE;
+        do
+        {
+          uint_fast16_t a = sp->a;
+          if (a == 255)
+          {
+            d[index].set(sp->R8(), sp->G8(), sp->B8());
+          }
+          else if (a)
+          {
+            uint_fast16_t inv = 256 - a;
+            ++a;
+            d[index].set( (d[index].R8() * inv + sp->R8() * a) >> 8
+                        , (d[index].G8() * inv + sp->G8() * a) >> 8
+                        , (d[index].B8() * inv + sp->B8() * a) >> 8
+                        );
+          }
+          ++sp;
+        } while (++index != last);
+        return last;
+      }
       for (;;) {
         uint32_t i = param->src_x + param->src_y * param->src_bitwidth;
         uint_fast16_t a = s[i].a;
@@ -493,6 +626,14 @@ namespace lgfx
       auto src_y32_add = param->src_y32_add;
       auto src_bitwidth= param->src_bitwidth;
       auto transp      = param->transp;
+      if (src_x32_add == (1u << FP_SCALE) && src_y32_add == 0)
+      {
+        auto sp = &s[(src_x32 >> FP_SCALE) + (src_y32 >> FP_SCALE) * src_bitwidth];
+        uint32_t i = index;
+        while (sp[i - index].get() == transp && ++i != last) {}
+        param->src_x32 = src_x32 + ((i - index) << FP_SCALE);
+        return i;
+      }
       do {
         uint32_t i = (src_x32 >> FP_SCALE) + (src_y32 >> FP_SCALE) * src_bitwidth;
         if (!(s[i].get() == transp)) break;
@@ -154,6 +154,19 @@ namespace lgfx
     void writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param) override;
     void copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y) override;
 
+    /// Counters of the drawing requests to the panel. Updated only when LGFX_PERF_COUNTERS is defined.
+    /// (see Bus_Counter for the bytes sent on the bus)
+    struct counter_t
+    {
+      uint32_t set_window = 0;
+      uint32_t pixels = 0;        // pixels sent by fills and images
+      uint32_t transactions = 0;
+    };
+
+    const counter_t& getCounter(void) const { return _counter; }
+    void resetCounter(void) { _counter = counter_t(); }
+    counter_t takeCounter(void) { auto res = _counter; _counter = counter_t(); return res; }
+
   protected:
 
     static constexpr uint8_t CMD_INIT_DELAY = 0x80;
@@ -162,6 +175,7 @@ namespace lgfx
 
     IBus* _bus = nullptr;
     ILight* _light = nullptr;
+    counter_t _counter;
     ITouch* _touch = nullptr;
     bool _has_align_data = false;
     uint8_t _internal_rotation = 0;
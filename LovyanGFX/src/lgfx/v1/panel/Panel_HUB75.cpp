@@ -28,7 +28,7 @@ namespace lgfx
 
   Panel_HUB75::~Panel_HUB75(void)
   {
-    _frame_buffer.release();
+    _release_frame_buffer();
   }
 
   Panel_HUB75_Multi::~Panel_HUB75_Multi(void)
@@ -98,7 +98,7 @@ namespace lgfx
       if (_initialized)
       {
         _bus->endTransaction();
-        if (_init_frame_buffer(_frame_buffer.getLineSize() / prev_bytes, _frame_buffer.getTotalLines()))
+        if (_init_frame_buffer(_draw_buffer->getLineSize() / prev_bytes, _draw_buffer->getTotalLines()))
         {
           _bus->beginTransaction();
         }
@@ -112,9 +112,22 @@ namespace lgfx
     ((Bus_ImagePush*)_bus)->setBrightness(brightness);
   }
 
-  bool Panel_HUB75::_init_frame_buffer(uint_fast16_t total_width, uint_fast16_t single_height)
+  void Panel_HUB75::_release_frame_buffer(void)
   {
     _frame_buffer.release();
+    _back_buffer.release();
+    if (_dirty_lines)
+    {
+      heap_free(_dirty_lines);
+      _dirty_lines = nullptr;
+    }
+    _draw_buffer = &_frame_buffer;
+    _pending_copy = false;
+  }
+
+  bool Panel_HUB75::_init_frame_buffer(uint_fast16_t total_width, uint_fast16_t single_height)
+  {
+    _release_frame_buffer();
 
     uint_fast8_t bytes = _write_bits >> 3;
 
@@ -123,18 +136,90 @@ namespace lgfx
       return false;
     }
 
+    if (_double_buffer)
+    {
+      size_t dirty_bytes = ((single_height + 31) >> 5) * sizeof(uint32_t);
+      _dirty_lines = (uint32_t*)heap_alloc(dirty_bytes);
+      if (_dirty_lines == nullptr
+       || _back_buffer.create(total_width * bytes, single_height, single_height >> 1) == nullptr)
+      {
+        _release_frame_buffer();
+        return false;
+      }
+      memset(_dirty_lines, 0, dirty_bytes);
+      for (size_t y = 0; y < single_height; ++y)
+      {
+        memset(_frame_buffer.getLineBuffer(y), 0, _frame_buffer.getLineSize());
+        memset(_back_buffer.getLineBuffer(y), 0, _back_buffer.getLineSize());
+      }
+      _draw_buffer = &_back_buffer;
+    }
+
     ((Bus_ImagePush*)_bus)->setImageBuffer((void*)&_frame_buffer, _write_depth);
 
     return true;
   }
 
+  void Panel_HUB75::display(uint_fast16_t, uint_fast16_t, uint_fast16_t, uint_fast16_t)
+  {
+    if (_dirty_lines == nullptr) { return; }
+
+    auto bus = (Bus_ImagePush*)_bus;
+    waitDisplay();
+    bus->setNextImageBuffer((void*)_draw_buffer, _write_depth);
+    _draw_buffer = (_draw_buffer == &_back_buffer) ? &_frame_buffer : &_back_buffer;
+    _pending_copy = true;
+  }
+
+  bool Panel_HUB75::displayBusy(void)
+  {
+    return _pending_copy && ((Bus_ImagePush*)_bus)->isImageBufferPending();
+  }
+
+  void Panel_HUB75::waitDisplay(void)
+  {
+    if (!_pending_copy) { return; }
+    auto bus = (Bus_ImagePush*)_bus;
+    while (bus->isImageBufferPending()) { delay(1); }
+    _copy_dirty_lines();
+  }
+
+  /// The new draw buffer is the previous frame : the lines drawn since then are copied from the shown frame.
+  void Panel_HUB75::_copy_dirty_lines(void)
+  {
+    _pending_copy = false;
+    auto src = (_draw_buffer == &_back_buffer) ? &_frame_buffer : &_back_buffer;
+    size_t lines = _draw_buffer->getTotalLines();
+    size_t line_size = _draw_buffer->getLineSize();
+    for (size_t i = 0; i < lines; i += 32)
+    {
+      uint32_t bits = _dirty_lines[i >> 5];
+      if (!bits) { continue; }
+      _dirty_lines[i >> 5] = 0;
+      size_t y = i;
+      do
+      {
+        if (bits & 1)
+        {
+          memcpy(_draw_buffer->getLineBuffer(y), src->getLineBuffer(y), line_size);
+        }
+        ++y;
+      } while (bits >>= 1);
+    }
+  }
+
   void Panel_HUB75::_draw_pixel_inner(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor)
   {
     if (convertCoordinate)
     {
       convertCoordinate(x, y);
     }
-    auto buf = _frame_buffer.getLineBuffer(y);
+    if (_dirty_lines)
+    {
+      if (_pending_copy) { waitDisplay(); }
+      _dirty_lines[y >> 5] |= 1u << (y & 31);
+    }
+    auto buf = _draw_buffer->getLineBuffer(y);
     switch (_write_bits >> 3)
     {
       default:
@@ -158,7 +243,8 @@ namespace lgfx
     {
       convertCoordinate(x, y);
     }
-    auto buf = _frame_buffer.getLineBuffer(y);
+    if (_pending_copy) { waitDisplay(); }
+    auto buf = _draw_buffer->getLineBuffer(y);
     switch (_read_bits >> 3)
     {
       default:
@@ -47,14 +47,36 @@ namespace lgfx
 
     void (*convertCoordinate)(uint_fast16_t &x, uint_fast16_t &y) = nullptr;
 
+    /// ダブルバッファを使用する。描画は裏バッファに行われ、display() で次のリフレッシュの先頭から表示が切り替わる。
+    /// Drawing goes to a back buffer, display() swaps it in at the start of the next refresh (no tearing).
+    /// Only the lines drawn since the previous display() are copied to the new back buffer.
+    /// Set it before init(). The frame buffer memory is doubled.
+    void setDoubleBuffer(bool enable) { _double_buffer = enable; }
+    bool getDoubleBuffer(void) const { return _double_buffer; }
+
+    void display(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h) override;
+    bool displayBusy(void) override;
+    void waitDisplay(void) override;
+
   protected:
     DividedFrameBuffer _frame_buffer;
+    DividedFrameBuffer _back_buffer;
+
+    /// the buffer that is drawn into (the back buffer in double buffer mode)
+    DividedFrameBuffer* _draw_buffer = &_frame_buffer;
+
+    /// one bit per line drawn since the last swap
+    uint32_t* _dirty_lines = nullptr;
+    bool _double_buffer = false;
+    bool _pending_copy = false;
 
     bool _initialized = false;
 
     bool _init_impl(uint_fast16_t width, uint_fast16_t height);
 
     bool _init_frame_buffer(uint_fast16_t total_width, uint_fast16_t single_height);
+    void _release_frame_buffer(void);
+    void _copy_dirty_lines(void);
 
     uint32_t _read_pixel_inner(uint_fast16_t x, uint_fast16_t y) override;
     void _draw_pixel_inner(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor) override;
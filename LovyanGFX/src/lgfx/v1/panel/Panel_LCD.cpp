@@ -61,6 +61,7 @@ namespace lgfx
   {
     if (_in_transaction) return;
     _in_transaction = true;
+    LGFX_PERF_COUNT(++_counter.transactions);
     _bus->beginTransaction();
     cs_control(false);
   }
@@ -225,6 +226,7 @@ namespace lgfx
 
   void Panel_LCD::setWindow(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye)
   {
+    LGFX_PERF_COUNT(++_counter.set_window);
     if (!_cfg.dlen_16bit)
     {
       set_window_8(xs, ys, xe, ye, CMD_RAMWR);
@@ -241,6 +243,7 @@ namespace lgfx
     if (!tr) begin_transaction();
 
     setWindow(x,y,x,y);
+    LGFX_PERF_COUNT(++_counter.pixels);
     if (_cfg.dlen_16bit) { _has_align_data = (_write_bits & 15); }
     _bus->writeData(rawcolor, _write_bits);
 
@@ -254,12 +257,14 @@ namespace lgfx
     uint_fast16_t ye = y + h - 1;
 
     setWindow(x,y,xe,ye);
+    LGFX_PERF_COUNT(_counter.pixels += len);
     if (_cfg.dlen_16bit) { _has_align_data = (_write_bits & 15) && (len & 1); }
     _bus->writeDataRepeat(rawcolor, _write_bits, len);
   }
 
   void Panel_LCD::writeBlock(uint32_t rawcolor, uint32_t len)
   {
+    LGFX_PERF_COUNT(_counter.pixels += len);
     _bus->writeDataRepeat(rawcolor, _write_bits, len);
     if (_cfg.dlen_16bit && (_write_bits & 15) && (len & 1))
     {
@@ -269,6 +274,7 @@ namespace lgfx
 
   void Panel_LCD::writePixels(pixelcopy_t* param, uint32_t len, bool use_dma)
   {
+    LGFX_PERF_COUNT(_counter.pixels += len);
     if (param->no_convert)
     {
       _bus->writeBytes(reinterpret_cast<const uint8_t*>(param->src_data), len * _write_bits >> 3, true, use_dma);
@@ -296,6 +302,7 @@ namespace lgfx
         uint32_t i = (src_x + param->src_y * param->src_bitwidth) * bytes;
         auto src = &((const uint8_t*)param->src_data)[i];
         setWindow(x, y, x + w - 1, y + h - 1);
+        LGFX_PERF_COUNT(_counter.pixels += w * h);
         if (param->src_bitwidth == w || h == 1)
         {
           write_bytes(src, wb * h, use_dma);
@@ -362,6 +369,7 @@ namespace lgfx
           auto buf = _bus->getDMABuffer(wb);
           param->fp_copy(buf, 0, w, param);
           setWindow(x, y, x + w - 1, y + h - 1);
+          LGFX_PERF_COUNT(_counter.pixels += w * h);
           write_bytes(buf, wb, true);
           _has_align_data = (_cfg.dlen_16bit && (_write_bits & 15) && (w & h & 1));
           while (--h)
@@ -387,6 +395,7 @@ namespace lgfx
           auto buf = _bus->getDMABuffer(wb);
           int32_t len = param->fp_copy(buf, 0, w - i, param);
           setWindow(x + i, y, x + i + len - 1, y);
+          LGFX_PERF_COUNT(_counter.pixels += len);
           write_bytes(buf, len * bytes, true);
           if (w == (i += len)) break;
         }
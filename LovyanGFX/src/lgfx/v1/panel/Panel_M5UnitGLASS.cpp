@@ -27,6 +27,33 @@ namespace lgfx
  {
 //----------------------------------------------------------------------------
 
+  Panel_M5UnitGlass::~Panel_M5UnitGlass(void)
+  {
+    setDeltaTransfer(false);
+  }
+
+  void Panel_M5UnitGlass::setDeltaTransfer(bool enable)
+  {
+    if (_sent_buf) { heap_free(_sent_buf); }
+    _sent_buf = nullptr;
+    if (!enable) { return; }
+    _sent_buf = static_cast<uint8_t*>(heap_alloc(_get_buffer_length()));
+    _reset_sent_buf();
+  }
+
+  void Panel_M5UnitGlass::_reset_sent_buf(void)
+  {
+    if (_sent_buf == nullptr || _buf == nullptr) { return; }
+    // 送信済みの内容は不明なので、全ての値を _buf と異なる値にしておき、次の display で全体を送る;
+    size_t len = _get_buffer_length();
+    for (size_t i = 0; i < len; ++i) { _sent_buf[i] = ~_buf[i]; }
+    for (auto& flags : _modified_flags) { flags = 0xFFFF; }
+    _range_mod.left   = 0;
+    _range_mod.top    = 0;
+    _range_mod.right  = _cfg.panel_width - 1;
+    _range_mod.bottom = _cfg.panel_height - 1;
+  }
+
   bool Panel_M5UnitGlass::init(bool use_reset)
   {
     if (!Panel_HasBuffer::init(use_reset))
@@ -58,6 +85,7 @@ namespace lgfx
 
     setInvert(_invert);
     setRotation(_rotation);
+    _reset_sent_buf();
 
     return true;
   }
@@ -113,6 +141,7 @@ namespace lgfx
       uint_fast8_t x_start = x;
       int index = 0;
       auto buf = &_buf[y * _cfg.panel_width];
+      auto sent = _sent_buf ? &_sent_buf[y * _cfg.panel_width] : nullptr;
       do
       {
         if (index == 0) {
@@ -121,12 +150,17 @@ namespace lgfx
             x = 8 + (x & ~7u);
             if (x > xe) { break; }
           }
+          if (sent) { // 前回送信した値と同じバイトは送らない;
+            while (x <= xe && buf[x] == sent[x] && (_modified_flags[y] & 0x8000 >> (x >> 3))) { ++x; }
+            if (x <= xe && 0 == (_modified_flags[y] & 0x8000 >> (x >> 3))) { continue; }
+          }
           x_start = x;
         }
         if (x <= xe) {
           _bus->beginTransaction();
           _bus->writeCommand(REG_INDEX_PICTURE_BUFFER | index << 8 | buf[x] << 24 , 32);
           _bus->endTransaction();
+          if (sent) { sent[x] = buf[x]; }
 
           ++index;
           ++x;
@@ -135,6 +169,13 @@ namespace lgfx
           if (!flg_draw_picture && 0 == (x & 7)) {
             flg_draw_picture = (0 == (_modified_flags[y] & 0x8000 >> (x >> 3)));
           }
+          if (!flg_draw_picture && sent) {
+            // 変化のないバイトが3つ以上続く所で区切る (短い区間は区切るより続けて送る方が速い);
+            flg_draw_picture = true;
+            for (uint_fast8_t i = x; i <= xe && i < x + 3; ++i) {
+              if (buf[i] != sent[i]) { flg_draw_picture = false; break; }
+            }
+          }
           if (flg_draw_picture) {
             _bus->beginTransaction();
             _bus->writeCommand(REG_INDEX_DRAW_PICTURE | x_start << 8 | y << (3 + 16), 24);
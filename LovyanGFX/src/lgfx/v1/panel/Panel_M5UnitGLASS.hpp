@@ -55,6 +55,8 @@ namespace lgfx
       _cfg.memory_height = 64;
     }
 
+    virtual ~Panel_M5UnitGlass(void);
+
     void beginTransaction(void) override {}
     void endTransaction(void) override {}
 
@@ -68,6 +70,11 @@ namespace lgfx
     void setBuzzer(uint16_t freq, uint8_t duty);
     void setBuzzerEnable(bool enable);
 
+    /// @brief Keeps a copy of the picture sent to the unit, and display() sends only the bytes that differ from it.
+    /// (The unit takes one transaction per byte, so the unchanged bytes of the modified 8x8 blocks are worth skipping.)
+    void setDeltaTransfer(bool enable);
+    bool getDeltaTransfer(void) const { return _sent_buf != nullptr; }
+
   protected:
 
     // UnitGLASS側が応答可能になるまでの待機終了予定時間(Showの後、数msec応答できなくなるため)
@@ -81,6 +88,11 @@ namespace lgfx
 
     bool _enable_buzzer_flg = false;
 
+    // setDeltaTransfer(true) の時、UnitGLASSへ送信済みの画像。(_buf と同じ並び)
+    uint8_t* _sent_buf = nullptr;
+
+    void _reset_sent_buf(void);
+
     void _update_transferred_rect(uint_fast16_t &xs, uint_fast16_t &ys, uint_fast16_t &xe, uint_fast16_t &ye) override;
 
     void waitBusy(void);
@@ -27,6 +27,58 @@ namespace lgfx
  {
 //----------------------------------------------------------------------------
 
+  Panel_M5UnitLCD::~Panel_M5UnitLCD(void)
+  {
+    setDeltaTransfer(false);
+  }
+
+  void Panel_M5UnitLCD::setDeltaTransfer(bool enable)
+  {
+    if (_shadow) { heap_free(_shadow); }
+    _shadow = nullptr;
+    _shadow_valid = nullptr;
+    if (!enable) { return; }
+
+    size_t lines = std::max(_cfg.panel_width, _cfg.panel_height);
+    size_t len = _cfg.panel_width * _cfg.panel_height * (_write_bits >> 3);
+    _shadow = static_cast<uint8_t*>(heap_alloc_psram(len + lines));
+    if (_shadow == nullptr) { _shadow = static_cast<uint8_t*>(heap_alloc(len + lines)); }
+    if (_shadow == nullptr) { return; }
+    // the content of the unit is unknown until each line is drawn over.
+    _shadow_valid = &_shadow[len];
+    memset(_shadow_valid, 0, lines);
+  }
+
+  void Panel_M5UnitLCD::_invalidate_shadow(uint_fast16_t ys, uint_fast16_t ye)
+  {
+    if (_shadow == nullptr) { return; }
+    ye = std::min<uint_fast16_t>(ye + 1, _height);
+    if (ys < ye) { memset(&_shadow_valid[ys], 0, ye - ys); }
+  }
+
+  /// Stores a fill in the shadow. Returns true when the unit already shows it.
+  bool Panel_M5UnitLCD::_fill_shadow(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
+  {
+    size_t bytes = _write_bits >> 3;
+    uint8_t color[4];
+    for (size_t i = 0; i < bytes; ++i) { color[i] = rawcolor >> (i << 3); }
+
+    bool same = true;
+    bool full_line = (x == 0 && w == _width);
+    for (size_t j = y; j < y + h; ++j)
+    {
+      auto line = &_shadow[(j * _width + x) * bytes];
+      same &= (bool)_shadow_valid[j];
+      for (size_t i = 0; i < w; ++i, line += bytes)
+      {
+        if (same && memcmp(line, color, bytes)) { same = false; }
+        memcpy(line, color, bytes);
+      }
+      if (full_line) { _shadow_valid[j] = true; }
+    }
+    return same;
+  }
+
   bool Panel_M5UnitLCD::init(bool use_reset)
   {
     /// I2C接続のためGPIOによるRESET制御は不要なのでfalseで呼出す;
@@ -62,6 +114,8 @@ namespace lgfx
 
     endWrite();
 
+    _invalidate_shadow(0, INT16_MAX);
+
     return res;
   }
 
@@ -148,7 +202,9 @@ namespace lgfx
     else if (bits < 16) { depth = color_depth_t::rgb332_1Byte; }
     else                { depth = color_depth_t::rgb565_2Byte; }
 
+    bool realloc = (_shadow && _write_depth != depth);
     _read_depth = _write_depth = depth;
+    if (realloc) { setDeltaTransfer(true); }
 
 //    _update_colmod();
     return depth;
@@ -171,6 +227,8 @@ namespace lgfx
 
     _xs = _xe = _ys = _ye = INT16_MAX;
 
+    _invalidate_shadow(0, INT16_MAX);
+
     if (_bus == nullptr) return;
 
     startWrite();
@@ -231,6 +289,7 @@ namespace lgfx
       length -= w * h;
     } while (length);
 /*/
+    _invalidate_shadow(_ys, _ye);
     _raw_color = rawcolor;
     size_t bytes = (rawcolor == 0) ? 1 : (_write_bits >> 3);
     auto buf = (uint8_t*)alloca((length >> 8) * (bytes + 1) + 2);
@@ -294,6 +353,7 @@ namespace lgfx
 
   void Panel_M5UnitLCD::writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
   {
+    if (_shadow && _fill_shadow(x, y, w, h, rawcolor)) { return; }
     size_t bytes = 0;
     if (_raw_color != rawcolor)
     {
@@ -305,6 +365,7 @@ namespace lgfx
 
   void Panel_M5UnitLCD::writeFillRectAlphaPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t argb8888)
   {
+    _invalidate_shadow(y, y + h - 1);
     _raw_color = getSwap32(argb8888);
     _fill_rect(x, y, w, h, 4);
     _raw_color = ~0u;
@@ -469,10 +530,57 @@ if (bytelen != rleDecode(dest, res, bytes)*bytes) {
 //*/
     return pdest - dest;
   }
+  /// Sends a line of len pixels at (x, y), skipping the pixels that the unit already shows.
+  void Panel_M5UnitLCD::_write_delta(uint_fast16_t x, uint_fast16_t y, uint32_t len, const uint8_t* data)
+  {
+    auto bytes = _write_bits >> 3;
+    uint32_t cmd = CMD_WRITE_RLE | bytes;
+    auto shadow = &_shadow[(y * _width + x) * bytes];
+    bool known = _shadow_valid[y];
+
+    // an unchanged gap shorter than this is sent with the changed pixels around it,
+    // as a new window (CASET, the end of the transaction and RLE command) costs about 8 bytes.
+    uint32_t gap_limit = 8 / bytes;
+
+    uint32_t i = 0;
+    while (i < len)
+    {
+      uint32_t end = len;
+      if (known)
+      {
+        while (i < len && 0 == memcmp(&shadow[i * bytes], &data[i * bytes], bytes)) { ++i; }
+        if (i == len) { break; }
+        end = i + 1;
+        for (uint32_t j = end, gap = 0; j < len && gap <= gap_limit; ++j)
+        {
+          if (memcmp(&shadow[j * bytes], &data[j * bytes], bytes)) { end = j + 1; gap = 0; }
+          else { ++gap; }
+        }
+      }
+      uint32_t n = end - i;
+      auto sub = n >> 2;
+      _buff_free_count = (_buff_free_count > sub)
+                       ? (_buff_free_count - sub)
+                       : 0;
+      _set_window(x + i, y, x + end - 1, y);
+      auto dmabuf = _bus->getDMABuffer(n * (bytes + 1));
+      if (!_check_repeat(cmd))
+      {
+        _bus->writeCommand(cmd, 8);
+      }
+      size_t writelen = rleEncode(dmabuf, &data[i * bytes], n * bytes, bytes);
+      _bus->writeBytes(dmabuf, writelen, false, true);
+      i = end;
+    }
+    memcpy(shadow, data, len * bytes);
+    if (x == 0 && len == _width) { _shadow_valid[y] = true; }
+  }
+
 //*
   void Panel_M5UnitLCD::writePixels(pixelcopy_t* param, uint32_t length, bool use_dma)
   {
     (void)use_dma;
+    _invalidate_shadow(_ys, _ye);
     auto bytes = _write_bits >> 3;
     uint32_t wb = length * bytes;
     auto dmabuf = _bus->getDMABuffer(wb + (wb >> 7) + 128);
@@ -541,16 +649,24 @@ if (bytelen != rleDecode(dest, res, bytes)*bytes) {
     uint32_t y_add = 1;
     uint32_t cmd = CMD_WRITE_RLE | bytes;
     bool transp = (param->transp != pixelcopy_t::NON_TRANSP);
-    if (!transp)
+    if (!transp && !_shadow)
     {
       _set_window(x, y, x+w-1, y+h-1);
     }
     uint32_t wb = w * bytes;
+    auto line = _shadow ? (uint8_t*)alloca(wb) : nullptr;
     do
     {
       uint32_t i = 0;
       while (w != (i = param->fp_skip(i, w, param)))
       {
+        if (line)
+        {
+          int32_t len = param->fp_copy(line, 0, w - i, param);
+          _write_delta(x + i, y, len, line);
+          if (w == (i += len)) break;
+          continue;
+        }
         auto sub = (w - i) >> 2;
         _buff_free_count = (_buff_free_count > sub)
                          ? (_buff_free_count - sub)
@@ -581,6 +697,7 @@ if (bytelen != rleDecode(dest, res, bytes)*bytes) {
 
   void Panel_M5UnitLCD::writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param)
   {
+    _invalidate_shadow(y, y);
     _set_window(x, y, x + w - 1, y);
     auto buf = (uint32_t*)param->src_data;
     if (!_check_repeat(CMD_WRITE_RAW_32))
@@ -650,6 +767,19 @@ if (bytelen != rleDecode(dest, res, bytes)*bytes) {
     _check_repeat();
     _bus->writeBytes(buf, idx, false, true);
     endWrite();
+
+    if (_shadow)
+    {
+      size_t bytes = _write_bits >> 3;
+      int_fast16_t y_add = (dst_y > src_y) ? -1 : 1;
+      int_fast16_t j = (dst_y > src_y) ? h - 1 : 0;
+      for (size_t k = 0; k < h; ++k, j += y_add)
+      {
+        memmove(&_shadow[((dst_y + j) * _width + dst_x) * bytes]
+               , &_shadow[((src_y + j) * _width + src_x) * bytes], w * bytes);
+        _shadow_valid[dst_y + j] &= _shadow_valid[src_y + j];
+      }
+    }
   }
 
 //----------------------------------------------------------------------------
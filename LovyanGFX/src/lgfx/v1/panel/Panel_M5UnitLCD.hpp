@@ -34,6 +34,8 @@ namespace lgfx
       _cfg.memory_height = _cfg.panel_height = 240;
     }
 
+    virtual ~Panel_M5UnitLCD(void);
+
     bool init(bool use_reset) override;
     void beginTransaction(void) override;
     void endTransaction(void) override;
@@ -64,6 +66,12 @@ namespace lgfx
     uint32_t readData(uint_fast8_t, uint_fast8_t) override { return 0; }
     void readRect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param) override;
 
+    /// @brief Keeps a copy of the unit's screen on the host (width x height x color bytes, in PSRAM if any),
+    /// and sends only the pixel runs of the images and fills that differ from it.
+    /// The lines that have not been drawn over their full width since init() or setRotation() are sent as they are.
+    void setDeltaTransfer(bool enable);
+    bool getDeltaTransfer(void) const { return _shadow != nullptr; }
+
     static constexpr uint8_t CMD_NOP          = 0x00; // 1Byte 何もしない;
     static constexpr uint8_t CMD_READ_ID      = 0x04; // 1Byte ID読出し  スレーブからの回答は4Byte (0x77 0x89 0x00 0x?? (最後の1バイトはファームウェアバージョン));
     static constexpr uint8_t CMD_READ_BUFCOUNT= 0x09; // 1Byte コマンドバッファの空き取得。回答は1Byte、受信可能なコマンド数が返される。数字が小さいほどバッファの余裕がない。;
@@ -140,9 +148,15 @@ namespace lgfx
     uint32_t _buff_free_count;
     bool _in_transaction = false;
 
+    uint8_t* _shadow = nullptr;       // pixels sent to the unit, in the write color depth
+    uint8_t* _shadow_valid = nullptr; // one per line, true when the line of _shadow matches the unit
+
     void _set_window(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye);
     void _fill_rect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint_fast8_t bytes);
     bool _check_repeat(uint32_t cmd = 0, uint_fast8_t limit = 64);
+    void _write_delta(uint_fast16_t x, uint_fast16_t y, uint32_t len, const uint8_t* data);
+    bool _fill_shadow(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor);
+    void _invalidate_shadow(uint_fast16_t ys, uint_fast16_t ye);
 
   };
 
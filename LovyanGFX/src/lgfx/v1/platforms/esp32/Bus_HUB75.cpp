@@ -113,6 +113,20 @@ namespace lgfx
     _panel_height = fb->getTotalLines();
   }
 
+  void Bus_HUB75::setNextImageBuffer(void* buffer, color_depth_t depth)
+  {
+    auto fb = (DividedFrameBuffer*)buffer;
+    if (_dmatask_handle == nullptr || _frame_buffer == nullptr || depth != _depth
+     || fb->getLineSize() != _frame_buffer->getLineSize()
+     || fb->getTotalLines() != _frame_buffer->getTotalLines())
+    { /// not refreshing, or the layout changes : no frame to finish.
+      _next_frame_buffer = nullptr;
+      setImageBuffer(buffer, depth);
+      return;
+    }
+    _next_frame_buffer = fb;
+  }
+
   __attribute__((always_inline))
   static inline uint32_t _gcd(uint32_t a, uint32_t b)
   {
@@ -1259,6 +1273,11 @@ namespace lgfx
       auto d32 = &dst[len32 * (transfer_period_count + 1)];
 
       y = (y + 1) & ((panel_height>>1) - 1);
+      if (y == 0 && _next_frame_buffer)
+      { // the whole previous frame has been shown, so the new one starts here.
+        _frame_buffer = _next_frame_buffer;
+        _next_frame_buffer = nullptr;
+      }
 
       {
       // SHIFTREG_ABCのY座標情報をセット;
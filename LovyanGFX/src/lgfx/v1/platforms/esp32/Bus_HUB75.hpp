@@ -141,6 +141,8 @@ namespace lgfx
     uint8_t getBrightness(void) const { return _brightness; }
 
     void setImageBuffer(void* buffer, color_depth_t depth) override;
+    void setNextImageBuffer(void* buffer, color_depth_t depth) override;
+    bool isImageBufferPending(void) const override { return _next_frame_buffer != nullptr; }
 
     // 1秒間の表示更新回数 (この値に基づいて送信クロックが自動計算される)
     void setRefreshRate(uint16_t refresh_rate);
@@ -184,7 +186,10 @@ namespace lgfx
 
     uint16_t _brightness_period[TRANSFER_PERIOD_COUNT_565 + 1];
 
-    DividedFrameBuffer* _frame_buffer;
+    DividedFrameBuffer* _frame_buffer = nullptr;
+
+    /// swapped in by the DMA task when the refresh goes back to the first line.
+    DividedFrameBuffer* volatile _next_frame_buffer = nullptr;
 
     volatile void *_dev;
     TaskHandle_t _dmatask_handle = nullptr;
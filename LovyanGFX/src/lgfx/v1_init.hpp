@@ -25,7 +25,11 @@ Contributors:
 #include "v1/LGFXBase.hpp"
 #include "v1/LGFX_Sprite.hpp"
 #include "v1/LGFX_Button.hpp"
+#include "v1/LGFX_SpritePipeline.hpp"
+#include "v1/LGFX_DisplayList.hpp"
+#include "v1/LGFX_TiledRenderer.hpp"
 #include "v1/Light.hpp"
+#include "v1/Bus_Counter.hpp"
 
 // LCD / OLED
 #include "v1/panel/Panel_GC9A01.hpp"
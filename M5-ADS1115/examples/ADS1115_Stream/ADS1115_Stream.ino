@@ -0,0 +1,53 @@
+/**
+ * @file ADS1115_Stream.ino
+ * @brief ADS1115 ALERT/RDY Streaming Example
+ * @version 0.1
+ * @date 2026-10-15
+ *
+ * Scans AIN0..AIN2 against GND round robin at 860 SPS. ALERT/RDY marks the
+ * end of each conversion, update() reads it into the sample queue.
+ *
+ * The Unit Ameter and Vmeter do not bring ALERT/RDY out to the Grove port,
+ * this needs an ADS1115 board with the pin wired to RDY_PIN.
+ *
+ * @Hardwares: M5Core + ADS1115 breakout
+ * @Platform Version: Arduino M5Stack Board Manager v2.1.0
+ * @Dependent Library:
+ * M5_ADS1115: https://github.com/m5stack/M5-ADS1115
+ */
+
+#include "M5_ADS1115.h"
+
+#define RDY_PIN 36
+
+ADS1115 ads;
+
+const ads1115_mux_t inputs[] = {ADS1115_MUX_AIN0_GND, ADS1115_MUX_AIN1_GND,
+                                ADS1115_MUX_AIN2_GND};
+
+void setup() {
+    Serial.begin(115200);
+    while (!ads.begin(&Wire, ADS1115_I2C_ADDR_0, 21, 22, 400000U)) {
+        Serial.println("ADS1115 Init Fail");
+        delay(1000);
+    }
+    ads.setRate(ADS1115_RATE_860);
+    ads.setGain(ADS1115_PGA_4096);
+
+    if (!ads.beginStream(RDY_PIN, inputs, 3)) {
+        Serial.println("ADS1115 Stream Fail");
+    }
+}
+
+void loop() {
+    // must run at least once per conversion, see getOverruns()
+    ads.update();
+
+    ads1115_sample_t sample;
+    while (ads.readSample(&sample)) {
+        Serial.printf("%lu us AIN%d: %.3f mV (overruns %u)\n",
+                      (unsigned long)sample.time, sample.mux - ADS1115_MUX_AIN0_GND,
+                      sample.raw * ads.getCoefficient() * MEASURING_DIRECTION,
+                      ads.getOverruns());
+    }
+}
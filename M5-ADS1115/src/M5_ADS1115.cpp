@@ -105,6 +105,25 @@ void ADS1115::setMode(ads1115_mode_t mode) {
     return;
 }
 
+/*! @brief Select the input multiplexer */
+void ADS1115::setMux(ads1115_mux_t mux) {
+    uint16_t reg_value = 0;
+    bool result        = _i2c.readU16(_addr, ADS1115_REG_CONFIG, &reg_value);
+    if (result == false) {
+        return;
+    }
+
+    reg_value &= ~(0b0111 << 12);
+    reg_value |= mux << 12;
+
+    result = _i2c.writeU16(_addr, ADS1115_REG_CONFIG, reg_value);
+    if (result) {
+        _mux = mux;
+    }
+
+    return;
+}
+
 /*! @brief Determine if data is being converted
     @return Data being converted returns 1, otherwise 0.. */
 bool ADS1115::isInConversion() {
@@ -148,6 +167,177 @@ int16_t ADS1115::getSingleConversion(uint16_t timeout) {
     return getAdcRaw() * MEASURING_DIRECTION;
 }
 
+/*! @brief Stream conversions into the sample queue, paced by ALERT/RDY
+    @param rdy_pin GPIO wired to ALERT/RDY (open drain, active low)
+    @param channels Inputs to scan round robin, NULL keeps the current one
+    @param count Number of entries in channels, at most ADS1115_SCAN_MAX
+    @return true if the converter accepted the configuration
+
+    One channel runs in continuous mode. Several channels chain single
+    conversions instead, update() switching the mux and starting the next
+    one, so no result is ever taken half way through a mux change. The
+    comparator is turned into a conversion ready output by the threshold
+    registers, it can not be used as a comparator while streaming. */
+bool ADS1115::beginStream(int8_t rdy_pin, const ads1115_mux_t* channels,
+                          uint8_t count) {
+    if (rdy_pin < 0) {
+        return false;
+    }
+    stopStream();
+
+    uint16_t reg_value = 0;
+    if (_i2c.readU16(_addr, ADS1115_REG_CONFIG, &reg_value) == false) {
+        return false;
+    }
+
+    if (count > ADS1115_SCAN_MAX) {
+        count = ADS1115_SCAN_MAX;
+    }
+    _scan_count = channels == NULL ? 0 : count;
+    for (uint8_t i = 0; i < _scan_count; i++) {
+        _scan[i] = channels[i];
+    }
+    _scan_index = 0;
+    _mux        = _scan_count > 0 ? _scan[0]
+                                  : (ads1115_mux_t)((reg_value >> 12) & 0x07);
+
+    // Hi_thresh MSB set and Lo_thresh MSB clear make ALERT/RDY pulse low
+    // at the end of every conversion, COMP_QUE must not be 0b11
+    if (_i2c.writeU16(_addr, ADS1115_REG_LO_THRESH, 0x0000) == false ||
+        _i2c.writeU16(_addr, ADS1115_REG_HI_THRESH, 0x8000) == false) {
+        return false;
+    }
+
+    // keep PGA and data rate, clear OS, MUX, MODE and the comparator bits
+    reg_value &= (0b0111 << 9) | (0b0111 << 5);
+    // the mux is added per conversion when scanning
+    if (_scan_count > 1) {
+        reg_value |= ADS1115_MODE_SINGLESHOT << 8;
+    } else {
+        reg_value |= _mux << 12;
+    }
+    _stream_config = reg_value;
+
+    _head = _tail = 0;
+    _overruns     = 0;
+    _ready_count  = 0;
+    _ready_seen   = 0;
+    _restart      = false;
+    _rdy_pin      = rdy_pin;
+
+    pinMode(_rdy_pin, INPUT_PULLUP);
+    attachInterruptArg(digitalPinToInterrupt(_rdy_pin), onReady, this,
+                       FALLING);
+
+    if (_scan_count > 1) {
+        _mode = ADS1115_MODE_SINGLESHOT;
+        return startScanConversion();
+    }
+    _mode = ADS1115_MODE_CONTINUOUS;
+    return _i2c.writeU16(_addr, ADS1115_REG_CONFIG, _stream_config);
+}
+
+/*! @brief Stop streaming and return to single shot mode */
+void ADS1115::stopStream() {
+    if (_rdy_pin < 0) {
+        return;
+    }
+    detachInterrupt(digitalPinToInterrupt(_rdy_pin));
+    _rdy_pin = -1;
+    setMode(ADS1115_MODE_SINGLESHOT);
+}
+
+void IRAM_ATTR ADS1115::onReady(void* arg) {
+    ADS1115* self     = (ADS1115*)arg;
+    self->_ready_time = micros();
+    self->_ready_count++;
+}
+
+bool ADS1115::startScanConversion() {
+    _restart = !_i2c.writeU16(
+        _addr, ADS1115_REG_CONFIG,
+        _stream_config | (_scan[_scan_index] << 12) | (0x01 << 15));
+    return !_restart;
+}
+
+/*! @brief Read a signalled conversion into the sample queue
+    @return true if a sample was queued
+
+    Call from loop() at least as often as the data rate. The read is not
+    done in the interrupt because Wire can not be used there. Conversions
+    signalled more than once between two calls count as overruns. */
+bool ADS1115::update() {
+    if (_rdy_pin < 0) {
+        return false;
+    }
+    if (_restart) {
+        startScanConversion();
+        return false;
+    }
+
+    uint32_t count;
+    uint32_t time;
+    do {
+        count = _ready_count;
+        time  = _ready_time;
+    } while (count != _ready_count);
+
+    if (count == _ready_seen) {
+        return false;
+    }
+    _overruns += count - _ready_seen - 1;
+    _ready_seen = count;
+
+    uint16_t value = 0x00;
+    bool result    = _i2c.readU16(_addr, ADS1115_REG_CONVERSION, &value);
+
+    ads1115_mux_t mux = _mux;
+    if (_scan_count > 1) {
+        mux         = _scan[_scan_index];
+        _scan_index = _scan_index + 1 < _scan_count ? _scan_index + 1 : 0;
+        _mux        = _scan[_scan_index];
+        startScanConversion();
+    }
+    if (result == false) {
+        return false;
+    }
+
+    adc_raw = value;
+    if ((uint16_t)(_head - _tail) >= ADS1115_QUEUE_SIZE) {
+        _overruns++;
+        return false;
+    }
+    ads1115_sample_t* sample =
+        &_queue[_head & (ADS1115_QUEUE_SIZE - 1)];
+    sample->time = time;
+    sample->raw  = adc_raw * MEASURING_DIRECTION;
+    sample->mux  = mux;
+    _head++;
+    return true;
+}
+
+/*! @brief Number of samples waiting in the queue */
+uint16_t ADS1115::available() {
+    return _head - _tail;
+}
+
+/*! @brief Take the oldest sample from the queue
+    @return false if the queue is empty */
+bool ADS1115::readSample(ads1115_sample_t* sample) {
+    if (_head == _tail) {
+        return false;
+    }
+    *sample = _queue[_tail & (ADS1115_QUEUE_SIZE - 1)];
+    _tail++;
+    return true;
+}
+
+/*! @brief Conversions lost since beginStream(), either missed by update()
+    or dropped because the queue was full */
+uint16_t ADS1115::getOverruns() {
+    return _overruns;
+}
+
 bool ADS1115::saveCalibration(ads1115_gain_t gain, int16_t hope,
                               int16_t actual) {
     if (hope == 0 || actual == 0) {
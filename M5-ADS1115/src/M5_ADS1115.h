@@ -7,6 +7,8 @@
 
 #define ADS1115_REG_CONVERSION 0x00
 #define ADS1115_REG_CONFIG     0x01
+#define ADS1115_REG_LO_THRESH  0x02
+#define ADS1115_REG_HI_THRESH  0x03
 #define ADS1115_I2C_ADDR_0     0x48
 #define ADS1115_I2C_ADDR_1     0x49
 
@@ -19,6 +21,18 @@
 
 #define MEASURING_DIRECTION -1
 
+// number of samples in the stream queue, must be a power of 2
+#ifndef ADS1115_QUEUE_SIZE
+#define ADS1115_QUEUE_SIZE 64
+#endif
+
+// most channels beginStream() can scan
+#define ADS1115_SCAN_MAX 8
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
 typedef enum {
     ADS1115_PGA_6144 = 0,
     ADS1115_PGA_4096,
@@ -44,6 +58,23 @@ typedef enum {
     ADS1115_MODE_SINGLESHOT,  // default
 } ads1115_mode_t;
 
+typedef enum {
+    ADS1115_MUX_AIN0_AIN1 = 0,  // default
+    ADS1115_MUX_AIN0_AIN3,
+    ADS1115_MUX_AIN1_AIN3,
+    ADS1115_MUX_AIN2_AIN3,
+    ADS1115_MUX_AIN0_GND,
+    ADS1115_MUX_AIN1_GND,
+    ADS1115_MUX_AIN2_GND,
+    ADS1115_MUX_AIN3_GND,
+} ads1115_mux_t;
+
+typedef struct {
+    uint32_t time;  // micros() when ALERT/RDY signalled the conversion
+    int16_t raw;    // same sign convention as getSingleConversion()
+    ads1115_mux_t mux;
+} ads1115_sample_t;
+
 class ADS1115 {
    private:
     I2C_Class _i2c;
@@ -51,10 +82,32 @@ class ADS1115 {
     uint8_t _epprom_addr;
     float _coefficient;
 
+    int8_t _rdy_pin = -1;
+    uint16_t _stream_config;
+    ads1115_mux_t _scan[ADS1115_SCAN_MAX];
+    uint8_t _scan_count;
+    uint8_t _scan_index;
+    bool _restart;
+
+    // written by onReady(), the count is free running
+    volatile uint32_t _ready_count;
+    volatile uint32_t _ready_time;
+    uint32_t _ready_seen;
+
+    // the indexes are free running, the queue size divides their range
+    ads1115_sample_t _queue[ADS1115_QUEUE_SIZE];
+    uint16_t _head;
+    uint16_t _tail;
+    uint16_t _overruns;
+
+    static void IRAM_ATTR onReady(void* arg);
+    bool startScanConversion();
+
    public:
     ads1115_gain_t _gain;
     ads1115_rate_t _rate;
     ads1115_mode_t _mode;
+    ads1115_mux_t _mux;
 
     uint16_t cover_time;
     int16_t adc_raw;
@@ -67,6 +120,7 @@ class ADS1115 {
     void setGain(ads1115_gain_t gain);
     void setRate(ads1115_rate_t rate);
     void setMode(ads1115_mode_t mode);
+    void setMux(ads1115_mux_t mux);
 
     float getCoefficient();
 
@@ -78,6 +132,14 @@ class ADS1115 {
     bool isInConversion();
     void startSingleConversion();
 
+    bool beginStream(int8_t rdy_pin, const ads1115_mux_t* channels = NULL,
+                     uint8_t count = 0);
+    void stopStream();
+    bool update();
+    uint16_t available();
+    bool readSample(ads1115_sample_t* sample);
+    uint16_t getOverruns();
+
     void setEEPROMAddr(uint8_t addr);
 
     void setCalibration(int8_t voltage, uint16_t actual);
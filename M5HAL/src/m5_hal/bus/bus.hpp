@@ -5,9 +5,23 @@
 #include "../interface/gpio.hpp"
 #include "../interface/io.hpp"
 #include "../error.hpp"
+#include "../framework_checker.hpp"
 
 #include <memory>
 
+#if M5HAL_FRAMEWORK_HAS_FREERTOS
+#if __has_include(<freertos/FreeRTOS.h>)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#else
+#include <FreeRTOS.h>
+#include <semphr.h>
+#endif
+#else
+#include <mutex>
+#include <chrono>
+#endif
+
 /*!
   @namespace m5
   @brief Toplevel namespace of M5
@@ -21,6 +35,83 @@ struct Bus;
 struct AccessConfig;
 struct Accessor;
 
+//-------------------------------------------------------------------------
+// バスの排他制御に用いる再帰ミューテックス
+// FreeRTOS環境ではタスク間で、それ以外の環境ではスレッド間で排他制御を行う。
+// 割込みハンドラからは使用できない。
+class BusMutex {
+public:
+    static constexpr uint32_t wait_forever = UINT32_MAX;
+
+    BusMutex(const BusMutex&)            = delete;
+    BusMutex& operator=(const BusMutex&) = delete;
+#if M5HAL_FRAMEWORK_HAS_FREERTOS
+    BusMutex(void) : _handle{xSemaphoreCreateRecursiveMutex()}
+    {
+    }
+    ~BusMutex(void)
+    {
+        if (_handle) {
+            vSemaphoreDelete(_handle);
+        }
+    }
+    // @param timeout_msec ロック獲得までの待ち時間 (wait_foreverなら無限待ち)
+    // @return ロックを獲得できた場合 true
+    bool lock(uint32_t timeout_msec = wait_forever)
+    {
+        if (_handle == nullptr) {
+            return false;
+        }
+        return xSemaphoreTakeRecursive(
+                   _handle, timeout_msec == wait_forever ? portMAX_DELAY : pdMS_TO_TICKS(timeout_msec)) == pdTRUE;
+    }
+    void unlock(void)
+    {
+        if (_handle) {
+            xSemaphoreGiveRecursive(_handle);
+        }
+    }
+
+private:
+    SemaphoreHandle_t _handle = nullptr;
+#else
+    BusMutex(void) = default;
+    bool lock(uint32_t timeout_msec = wait_forever)
+    {
+        if (timeout_msec == wait_forever) {
+            _mutex.lock();
+            return true;
+        }
+        return _mutex.try_lock_for(std::chrono::milliseconds(timeout_msec));
+    }
+    void unlock(void)
+    {
+        _mutex.unlock();
+    }
+
+private:
+    std::recursive_timed_mutex _mutex;
+#endif
+};
+
+//-------------------------------------------------------------------------
+// 非同期トランザクション (送信後に受信を行う一連の通信)
+// 投入から完了(コールバックの呼出し)までの間、Transaction および送受信バッファを保持しておくこと。
+struct Transaction {
+    // 完了時に呼び出すコールバック関数
+    typedef void (*callback_t)(Accessor* accessor, Transaction* transaction);
+
+    const uint8_t* tx_data = nullptr;  // 送信データ (DMA転送を行う実装ではDMA転送可能なメモリを推奨)
+    size_t tx_len          = 0;        // 送信データの長さ (0なら送信しない)
+    uint8_t* rx_data       = nullptr;  // 受信データの格納先 (DMA転送を行う実装ではDMA転送可能なメモリを推奨)
+    size_t rx_len          = 0;        // 受信データの長さ (0なら受信しない)
+    callback_t callback    = nullptr;
+    void* user_data        = nullptr;  // コールバック関数で利用する任意のデータ
+
+    // 処理の結果 (ASYNC_RUNNINGの場合はまだ処理中)
+    volatile error::error_t result = error::error_t::OK;
+};
+
 //-------------------------------------------------------------------------
 // 通信バスの初期化に必要な条件を記述するため基底インターフェイス
 struct BusConfig {
@@ -76,6 +167,22 @@ struct Accessor : public interface::io::Output, public interface::io::Input {
         return read(data, len);
     }
 
+    // 非同期トランザクションを投入する。
+    // 完了したトランザクションのコールバックは poll / waitTransaction を呼んだタスクから呼び出される。
+    // 非同期処理に対応しない実装では同期的に処理し、その場でコールバックを呼び出す。
+    virtual m5::stl::expected<void, m5::hal::error::error_t> transaction(Transaction* transaction);
+    // 完了したトランザクションのコールバックを呼び出す
+    // @return 未完了のトランザクションの数
+    virtual m5::stl::expected<size_t, m5::hal::error::error_t> poll(void)
+    {
+        return 0;
+    }
+    // 全てのトランザクションが完了するまで待機し、コールバックを呼び出す
+    virtual m5::stl::expected<void, m5::hal::error::error_t> waitTransaction(uint32_t timeout_msec = 1000)
+    {
+        return {};
+    }
+
 protected:
     Bus& _bus;
 };
@@ -166,27 +273,42 @@ public:
     /// @note  expectedは参照をサポートしていないのでポインタを含める形とした。
     virtual m5::stl::expected<Accessor*, m5::hal::error::error_t> beginAccess(const AccessConfig& access_config) = 0;
 
+    // beginAccessで獲得したロックはここで解放される
     virtual error::error_t endAccess(Accessor* Accessor)
     {
         if (Accessor && _Accessor.get() == Accessor) {
+            // 未完了の非同期トランザクションを完了させてから解放する
+            Accessor->waitTransaction(UINT32_MAX);
             _Accessor.reset(nullptr);
+            _mutex.unlock();
             return error::error_t::OK;
         }
         return error::error_t::INVALID_ARGUMENT;
     }
 
-    // 無条件でバスをロックしたい場合に使用する
+    // 無条件でバスをロックしたい場合に使用する (再帰ロック可能)
     virtual m5::stl::expected<void, error::error_t> lock(void)
     {
-        return m5::stl::make_unexpected(error::error_t::NOT_IMPLEMENTED);
+        return lock(BusMutex::wait_forever);
     }
     virtual m5::stl::expected<void, error::error_t> unlock(void)
     {
-        return m5::stl::make_unexpected(error::error_t::NOT_IMPLEMENTED);
+        _mutex.unlock();
+        return {};
+    }
+    // タイムアウト付きのロック
+    m5::stl::expected<void, error::error_t> lock(uint32_t timeout_msec)
+    {
+        if (!_mutex.lock(timeout_msec)) {
+            return m5::stl::make_unexpected(error::error_t::TIMEOUT_ERROR);
+        }
+        return {};
     }
 
 protected:
     std::unique_ptr<Accessor> _Accessor;
+    // beginAccess 〜 endAccess の間、および lock 〜 unlock の間保持されるロック
+    BusMutex _mutex;
 };
 
 //-------------------------------------------------------------------------
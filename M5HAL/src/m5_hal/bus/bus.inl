@@ -10,6 +10,35 @@ const BusConfig& Accessor::getBusConfig(void) const
     return _bus.getConfig();
 }
 
+m5::stl::expected<void, m5::hal::error::error_t> Accessor::transaction(Transaction* transaction)
+{
+    if (transaction == nullptr) {
+        return m5::stl::make_unexpected(error::error_t::INVALID_ARGUMENT);
+    }
+    // 非同期処理に対応しない実装では、送信・受信を順に同期的に行う
+    auto result = error::error_t::OK;
+    if (transaction->tx_len) {
+        auto res = write(transaction->tx_data, transaction->tx_len);
+        if (!res) {
+            result = res.error();
+        }
+    }
+    if (error::isOk(result) && transaction->rx_len) {
+        auto res = read(transaction->rx_data, transaction->rx_len);
+        if (!res) {
+            result = res.error();
+        }
+    }
+    transaction->result = result;
+    if (transaction->callback) {
+        transaction->callback(this, transaction);
+    }
+    if (error::isError(result)) {
+        return m5::stl::make_unexpected(result);
+    }
+    return {};
+}
+
 }  // namespace bus
 }  // namespace hal
 }  // namespace m5
@@ -52,6 +52,9 @@ struct I2CMasterAccessor : public Accessor {
         return readWithLastNackFlag(data, len, false);
     };
 
+    // 送信(start+write) → 受信(repeated start+read) → stop の一連の処理を同期的に行う
+    m5::stl::expected<void, m5::hal::error::error_t> transaction(Transaction* transaction) override;
+
     // virtual m5::stl::expected<size_t, m5::hal::error::error_t> readLastNack(uint8_t* data, size_t len) { return
     // readWithLastNackFlag(data, len, true); } virtual m5::stl::expected<size_t, m5::hal::error::error_t>
     // readWithLastNackFlag(uint8_t* data, size_t len, bool last_nack = false) = 0;
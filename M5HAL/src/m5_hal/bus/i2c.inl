@@ -52,12 +52,18 @@ error::error_t SoftwareI2CBus::init(const BusConfig& config)
 m5::stl::expected<m5::hal::bus::Accessor*, m5::hal::error::error_t> SoftwareI2CBus::beginAccess(
     const m5::hal::bus::AccessConfig& access_config)
 {
-    /// @TODO ここで排他制御＆ロック処理を行うこと。
-    if (_Accessor.get() != nullptr) {
+    if (access_config.getBusType() != getBusType()) {
         M5_LIB_LOGE("SoftwareI2C::beginAccess: error %s", __PRETTY_FUNCTION__);
         return m5::stl::make_unexpected(m5::hal::error::error_t::INVALID_ARGUMENT);
     }
-    if (access_config.getBusType() != getBusType()) {
+    // 他のタスクがアクセス中の場合はendAccessされるまで待機する
+    if (!_mutex.lock(static_cast<const I2CMasterAccessConfig&>(access_config).timeout_msec)) {
+        M5_LIB_LOGE("SoftwareI2C::beginAccess: timeout %s", __PRETTY_FUNCTION__);
+        return m5::stl::make_unexpected(m5::hal::error::error_t::TIMEOUT_ERROR);
+    }
+    // 同一タスク内での多重アクセスは不可
+    if (_Accessor.get() != nullptr) {
+        _mutex.unlock();
         M5_LIB_LOGE("SoftwareI2C::beginAccess: error %s", __PRETTY_FUNCTION__);
         return m5::stl::make_unexpected(m5::hal::error::error_t::INVALID_ARGUMENT);
     }
@@ -176,6 +182,45 @@ m5::stl::expected<void, m5::hal::error::error_t> I2CMasterAccessor::stop(void)
     return sendStopCondition();
 }
 
+m5::stl::expected<void, m5::hal::error::error_t> I2CMasterAccessor::transaction(Transaction* transaction)
+{
+    if (transaction == nullptr) {
+        return m5::stl::make_unexpected(error::error_t::INVALID_ARGUMENT);
+    }
+    auto result = error::error_t::OK;
+    if (transaction->tx_len) {
+        auto res = startWrite();
+        if (res) {
+            auto wres = write(transaction->tx_data, transaction->tx_len);
+            if (!wres) {
+                result = wres.error();
+            }
+        } else {
+            result = res.error();
+        }
+    }
+    if (error::isOk(result) && transaction->rx_len) {
+        auto res = startRead();
+        if (res) {
+            auto rres = readLastNack(transaction->rx_data, transaction->rx_len);
+            if (!rres) {
+                result = rres.error();
+            }
+        } else {
+            result = res.error();
+        }
+    }
+    stop();
+    transaction->result = result;
+    if (transaction->callback) {
+        transaction->callback(this, transaction);
+    }
+    if (error::isError(result)) {
+        return m5::stl::make_unexpected(result);
+    }
+    return {};
+}
+
 m5::stl::expected<size_t, m5::hal::error::error_t> SoftwareI2CMasterAccessor::write(const uint8_t* data, size_t len)
 {
     auto bc = static_cast<const I2CBusConfig&>(getBusConfig());
@@ -39,14 +39,17 @@ error::error_t SoftwareSPIBus::init(const BusConfig& config)
 
 m5::stl::expected<Accessor*, m5::hal::error::error_t> SoftwareSPIBus::beginAccess(const AccessConfig& access_config)
 {
-    /// @TODO ここで排他制御＆ロック処理を行うこと。
-    if (_Accessor.get() != nullptr) {
+    if (access_config.getBusType() != getBusType()) {
         M5_LIB_LOGE("SoftwareSPI::beginAccess: error %s", __PRETTY_FUNCTION__);
-        return nullptr;
+        return m5::stl::make_unexpected(m5::hal::error::error_t::INVALID_ARGUMENT);
     }
-    if (access_config.getBusType() != getBusType()) {
+    // 他のタスクがアクセス中の場合はendAccessされるまで待機する
+    _mutex.lock();
+    // 同一タスク内での多重アクセスは不可
+    if (_Accessor.get() != nullptr) {
+        _mutex.unlock();
         M5_LIB_LOGE("SoftwareSPI::beginAccess: error %s", __PRETTY_FUNCTION__);
-        return nullptr;
+        return m5::stl::make_unexpected(m5::hal::error::error_t::INVALID_ARGUMENT);
     }
     auto result = new SoftwareSPIMasterAccessor(*this, (const SPIMasterAccessConfig&)access_config);
     _Accessor.reset(result);
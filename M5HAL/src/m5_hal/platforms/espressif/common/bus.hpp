@@ -0,0 +1,194 @@
+#ifndef M5_HAL_PLATFORMS_ESPRESSIF_COMMON_BUS_HPP
+#define M5_HAL_PLATFORMS_ESPRESSIF_COMMON_BUS_HPP
+
+#include "../../../bus/i2c.hpp"
+#include "../../../bus/spi.hpp"
+
+#if defined(ESP_PLATFORM)
+
+#include <soc/soc_caps.h>
+#include <driver/spi_master.h>
+#include <driver/i2c.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+// SPIの非同期トランザクションを同時に投入できる数 (1つのTransactionは送信・受信で最大2つ消費する)
+#ifndef M5HAL_ESP32_SPI_QUEUE_SIZE
+#define M5HAL_ESP32_SPI_QUEUE_SIZE 8
+#endif
+
+// SPIの1回のDMA転送の最大長 (byte)
+#ifndef M5HAL_ESP32_SPI_MAX_TRANSFER_SIZE
+#define M5HAL_ESP32_SPI_MAX_TRANSFER_SIZE 4092
+#endif
+
+// I2Cの非同期トランザクションを同時に投入できる数
+#ifndef M5HAL_ESP32_I2C_QUEUE_SIZE
+#define M5HAL_ESP32_I2C_QUEUE_SIZE 8
+#endif
+
+// I2Cの非同期トランザクションを処理するタスクの設定
+#ifndef M5HAL_ESP32_I2C_TASK_STACK_SIZE
+#define M5HAL_ESP32_I2C_TASK_STACK_SIZE 2048
+#endif
+#ifndef M5HAL_ESP32_I2C_TASK_PRIORITY
+#define M5HAL_ESP32_I2C_TASK_PRIORITY (configMAX_PRIORITIES - 2)
+#endif
+
+namespace m5 {
+namespace hal {
+namespace platforms {
+namespace esp32 {
+namespace bus {
+namespace spi {
+
+// ESP-IDF の spi_master ドライバを用いた DMA 転送によるSPIアクセサ
+// CSピンは SoftwareSPI と同様に cs_control で制御する。
+// 非同期トランザクションの完了は poll / waitTransaction を呼んだタスクでコールバックされる。
+class DMASPIMasterAccessor : public hal::bus::spi::SPIMasterAccessor {
+public:
+    DMASPIMasterAccessor(hal::bus::Bus& bus, const hal::bus::SPIMasterAccessConfig& access_config,
+                         spi_device_handle_t device)
+        : SPIMasterAccessor{bus, access_config}, _device{device}
+    {
+    }
+    ~DMASPIMasterAccessor(void)
+    {
+        waitTransaction(UINT32_MAX);
+    }
+
+    m5::stl::expected<size_t, m5::hal::error::error_t> read(uint8_t* data, size_t len) override;
+    m5::stl::expected<size_t, m5::hal::error::error_t> write(const uint8_t* data, size_t len) override;
+
+    m5::stl::expected<void, m5::hal::error::error_t> transaction(hal::bus::Transaction* transaction) override;
+    m5::stl::expected<size_t, m5::hal::error::error_t> poll(void) override;
+    m5::stl::expected<void, m5::hal::error::error_t> waitTransaction(uint32_t timeout_msec = 1000) override;
+
+protected:
+    m5::stl::expected<size_t, m5::hal::error::error_t> transfer(const uint8_t* tx_data, uint8_t* rx_data, size_t len);
+    bool collect(TickType_t ticks);
+    spi_transaction_t* allocTransaction(void);
+    bool isHalfDuplex(void) const;
+
+    spi_device_handle_t _device;
+    spi_transaction_t _trans[M5HAL_ESP32_SPI_QUEUE_SIZE];
+    uint8_t _trans_head    = 0;  // 最も古い未完了トランザクションの位置
+    uint8_t _trans_pending = 0;  // 未完了トランザクションの数
+};
+
+class DMASPIBus : public hal::bus::spi::SPIBus {
+public:
+    ~DMASPIBus(void)
+    {
+        release();
+    }
+    error::error_t init(const hal::bus::BusConfig& config) override;
+    error::error_t release(void) override;
+    m5::stl::expected<hal::bus::Accessor*, m5::hal::error::error_t> beginAccess(
+        const hal::bus::AccessConfig& access_config) override;
+    error::error_t endAccess(hal::bus::Accessor* Accessor) override;
+
+protected:
+    bool setupDevice(const hal::bus::SPIMasterAccessConfig& access_config);
+    void releaseDevice(void);
+
+    spi_host_device_t _host     = SPI2_HOST;
+    spi_device_handle_t _device = nullptr;
+    bool _initialized           = false;
+    // 現在の _device の設定 (同じ設定でのアクセスではデバイスを再利用する)
+    uint32_t _device_freq = 0;
+    uint8_t _device_mode  = 0;
+    uint8_t _device_order = 0;
+    bool _device_half     = false;
+};
+
+// periph に spi2 / spi3 を指定したバスを取得する
+m5::stl::expected<hal::bus::spi::SPIBus*, m5::hal::error::error_t> getBus(const hal::bus::SPIBusConfig& config);
+
+}  // namespace spi
+
+namespace i2c {
+
+class HardwareI2CBus;
+
+// ESP-IDF の i2c ドライバを用いたI2Cアクセサ
+// 同期処理ではコマンドを蓄積し、read または stop の時点でまとめて実行する。
+// 非同期トランザクションはバスのタスクで処理され、完了は poll / waitTransaction を呼んだタスクでコールバックされる。
+class HardwareI2CMasterAccessor : public hal::bus::i2c::I2CMasterAccessor {
+public:
+    HardwareI2CMasterAccessor(HardwareI2CBus& bus, const hal::bus::I2CMasterAccessConfig& access_config);
+    ~HardwareI2CMasterAccessor(void);
+
+    m5::stl::expected<void, m5::hal::error::error_t> startWrite(void) override;
+    m5::stl::expected<void, m5::hal::error::error_t> startRead(void) override;
+    m5::stl::expected<void, m5::hal::error::error_t> stop(void) override;
+    m5::stl::expected<size_t, m5::hal::error::error_t> write(const uint8_t* data, size_t len) override;
+    m5::stl::expected<size_t, m5::hal::error::error_t> readWithLastNackFlag(uint8_t* data, size_t len,
+                                                                            bool last_nack = false) override;
+
+    m5::stl::expected<void, m5::hal::error::error_t> transaction(hal::bus::Transaction* transaction) override;
+    m5::stl::expected<size_t, m5::hal::error::error_t> poll(void) override;
+    m5::stl::expected<void, m5::hal::error::error_t> waitTransaction(uint32_t timeout_msec = 1000) override;
+
+protected:
+    m5::stl::expected<void, m5::hal::error::error_t> prepare(void);
+    m5::stl::expected<void, m5::hal::error::error_t> execute(void);
+    bool collect(TickType_t ticks);
+
+    HardwareI2CBus& _i2c_bus;
+    i2c_cmd_handle_t _cmd = nullptr;
+    size_t _pending       = 0;
+};
+
+class HardwareI2CBus : public hal::bus::i2c::I2CBus {
+    friend class HardwareI2CMasterAccessor;
+
+public:
+    ~HardwareI2CBus(void)
+    {
+        release();
+    }
+    error::error_t init(const hal::bus::BusConfig& config) override;
+    error::error_t release(void) override;
+    m5::stl::expected<hal::bus::Accessor*, m5::hal::error::error_t> beginAccess(
+        const hal::bus::AccessConfig& access_config) override;
+
+    i2c_port_t getPort(void) const
+    {
+        return _port;
+    }
+
+protected:
+    struct request_t {
+        hal::bus::Transaction* transaction;
+        uint16_t i2c_addr;
+        uint32_t timeout_msec;
+    };
+    static void task(void* arg);
+    static error::error_t toError(esp_err_t err);
+    bool startTask(void);
+    void stopTask(void);
+
+    i2c_port_t _port            = I2C_NUM_0;
+    bool _initialized           = false;
+    uint32_t _freq              = 0;
+    QueueHandle_t _request      = nullptr;  // 投入されたトランザクション
+    QueueHandle_t _complete     = nullptr;  // 完了したトランザクション
+    TaskHandle_t _task          = nullptr;
+    volatile bool _task_running = false;
+};
+
+// periph に i2c0 / i2c1 を指定したバスを取得する
+m5::stl::expected<hal::bus::i2c::I2CBus*, m5::hal::error::error_t> getBus(const hal::bus::I2CBusConfig& config);
+
+}  // namespace i2c
+}  // namespace bus
+}  // namespace esp32
+}  // namespace platforms
+}  // namespace hal
+}  // namespace m5
+
+#endif
+
+#endif
@@ -0,0 +1,723 @@
+
+#include "bus.hpp"
+
+#if defined(ESP_PLATFORM)
+
+#include <algorithm>
+#include <cstring>
+
+namespace m5 {
+namespace hal {
+namespace platforms {
+namespace esp32 {
+namespace bus {
+
+static inline TickType_t toTicks(uint32_t msec)
+{
+    return (msec == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(msec);
+}
+
+namespace spi {
+
+static inline int toGpio(const interface::gpio::Pin* pin)
+{
+    return pin ? pin->getGpioNumber() : -1;
+}
+
+//-------------------------------------------------------------------------
+
+bool DMASPIMasterAccessor::isHalfDuplex(void) const
+{
+    switch (_access_config.spi_data_mode) {
+        case hal::bus::spi_data_mode_t::spi_halfduplex:
+        case hal::bus::spi_data_mode_t::spi_halfduplex_with_dc_pin:
+        case hal::bus::spi_data_mode_t::spi_halfduplex_with_dc_bit:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// 完了したトランザクションを1つ回収してコールバックを呼び出す
+bool DMASPIMasterAccessor::collect(TickType_t ticks)
+{
+    if (_trans_pending == 0) {
+        return false;
+    }
+    spi_transaction_t* t = nullptr;
+    if (spi_device_get_trans_result(_device, &t, ticks) != ESP_OK) {
+        return false;
+    }
+    // 完了は投入順に通知される
+    _trans_head = (_trans_head + 1) % M5HAL_ESP32_SPI_QUEUE_SIZE;
+    --_trans_pending;
+
+    auto transaction = static_cast<hal::bus::Transaction*>(t->user);
+    if (transaction) {
+        transaction->result = error::error_t::OK;
+        if (transaction->callback) {
+            transaction->callback(this, transaction);
+        }
+    }
+    return true;
+}
+
+spi_transaction_t* DMASPIMasterAccessor::allocTransaction(void)
+{
+    if (_trans_pending >= M5HAL_ESP32_SPI_QUEUE_SIZE) {
+        return nullptr;
+    }
+    auto t = &_trans[(_trans_head + _trans_pending) % M5HAL_ESP32_SPI_QUEUE_SIZE];
+    memset(t, 0, sizeof(spi_transaction_t));
+    return t;
+}
+
+m5::stl::expected<size_t, m5::hal::error::error_t> DMASPIMasterAccessor::poll(void)
+{
+    while (collect(0)) {
+    }
+    return _trans_pending;
+}
+
+m5::stl::expected<void, m5::hal::error::error_t> DMASPIMasterAccessor::waitTransaction(uint32_t timeout_msec)
+{
+    auto ticks = toTicks(timeout_msec);
+    while (_trans_pending) {
+        if (!collect(ticks)) {
+            return m5::stl::make_unexpected(error::error_t::TIMEOUT_ERROR);
+        }
+    }
+    return {};
+}
+
+m5::stl::expected<void, m5::hal::error::error_t> DMASPIMasterAccessor::transaction(
+    hal::bus::Transaction* transaction)
+{
+    if (transaction == nullptr || transaction->tx_len > M5HAL_ESP32_SPI_MAX_TRANSFER_SIZE ||
+        transaction->rx_len > M5HAL_ESP32_SPI_MAX_TRANSFER_SIZE) {
+        return m5::stl::make_unexpected(error::error_t::INVALID_ARGUMENT);
+    }
+    // 送信と受信はそれぞれ個別のDMA転送として投入する
+    // (ESP32 の半二重通信では送信・受信の両方を1回のDMA転送で行えないため)
+    size_t need = (transaction->tx_len ? 1 : 0) + (transaction->rx_len ? 1 : 0);
+    if (need == 0) {
+        return m5::stl::make_unexpected(error::error_t::INVALID_ARGUMENT);
+    }
+    // 空きが無ければ完了済みのものを回収する
+    poll();
+    if (_trans_pending + need > M5HAL_ESP32_SPI_QUEUE_SIZE) {
+        return m5::stl::make_unexpected(error::error_t::TIMEOUT_ERROR);
+    }
+
+    transaction->result = error::error_t::ASYNC_RUNNING;
+    if (transaction->tx_len) {
+        auto t       = allocTransaction();
+        t->length    = transaction->tx_len << 3;
+        t->tx_buffer = transaction->tx_data;
+        t->user      = (--need) ? nullptr : transaction;  // 最後の転送の完了でコールバックする
+        if (spi_device_queue_trans(_device, t, 0) != ESP_OK) {
+            transaction->result = error::error_t::UNKNOWN_ERROR;
+            return m5::stl::make_unexpected(transaction->result);
+        }
+        ++_trans_pending;
+    }
+    if (transaction->rx_len) {
+        auto t       = allocTransaction();
+        t->length    = isHalfDuplex() ? 0 : transaction->rx_len << 3;
+        t->rxlength  = transaction->rx_len << 3;
+        t->rx_buffer = transaction->rx_data;
+        t->user      = transaction;
+        if (spi_device_queue_trans(_device, t, 0) != ESP_OK) {
+            transaction->result = error::error_t::UNKNOWN_ERROR;
+            return m5::stl::make_unexpected(transaction->result);
+        }
+        ++_trans_pending;
+    }
+    return {};
+}
+
+// 同期転送 (未完了の非同期トランザクションの完了を待ってから行う)
+m5::stl::expected<size_t, m5::hal::error::error_t> DMASPIMasterAccessor::transfer(const uint8_t* tx_data,
+                                                                                 uint8_t* rx_data, size_t len)
+{
+    auto res = waitTransaction(UINT32_MAX);
+    if (!res) {
+        return m5::stl::make_unexpected(res.error());
+    }
+    size_t result = 0;
+    while (result < len) {
+        size_t l = std::min<size_t>(len - result, M5HAL_ESP32_SPI_MAX_TRANSFER_SIZE);
+        spi_transaction_t t{};
+        if (tx_data) {
+            t.length    = l << 3;
+            t.tx_buffer = tx_data + result;
+        }
+        if (rx_data) {
+            t.length    = isHalfDuplex() ? 0 : l << 3;
+            t.rxlength  = l << 3;
+            t.rx_buffer = rx_data + result;
+        }
+        if (spi_device_polling_transmit(_device, &t) != ESP_OK) {
+            return m5::stl::make_unexpected(error::error_t::UNKNOWN_ERROR);
+        }
+        result += l;
+    }
+    return result;
+}
+
+m5::stl::expected<size_t, m5::hal::error::error_t> DMASPIMasterAccessor::read(uint8_t* data, size_t len)
+{
+    return transfer(nullptr, data, len);
+}
+
+m5::stl::expected<size_t, m5::hal::error::error_t> DMASPIMasterAccessor::write(const uint8_t* data, size_t len)
+{
+    return transfer(data, nullptr, len);
+}
+
+//-------------------------------------------------------------------------
+
+error::error_t DMASPIBus::init(const hal::bus::BusConfig& config)
+{
+    if (config.getBusType() != hal::types::bus_type_t::SPI) {
+        M5_LIB_LOGE("DMASPIBus::init: error %s", __PRETTY_FUNCTION__);
+        return error::error_t::INVALID_ARGUMENT;
+    }
+    release();
+    _config = static_cast<const hal::bus::SPIBusConfig&>(config);
+
+    switch (static_cast<types::periph_t>(_config.periph)) {
+        case types::periph_t::spi2:
+            _host = SPI2_HOST;
+            break;
+#if SOC_SPI_PERIPH_NUM > 2
+        case types::periph_t::spi3:
+            _host = SPI3_HOST;
+            break;
+#endif
+        default:
+            M5_LIB_LOGE("DMASPIBus::init: invalid periph %s", __PRETTY_FUNCTION__);
+            return error::error_t::INVALID_ARGUMENT;
+    }
+
+    spi_bus_config_t buscfg{};
+    buscfg.sclk_io_num     = toGpio(_config.pin_clk);
+    buscfg.mosi_io_num     = toGpio(_config.pin_mosi);
+    buscfg.miso_io_num     = toGpio(_config.pin_miso);
+    buscfg.quadwp_io_num   = toGpio(_config.pin_d2);
+    buscfg.quadhd_io_num   = toGpio(_config.pin_d3);
+    buscfg.max_transfer_sz = M5HAL_ESP32_SPI_MAX_TRANSFER_SIZE;
+    auto err               = spi_bus_initialize(_host, &buscfg, SPI_DMA_CH_AUTO);
+    if (err != ESP_OK) {
+        M5_LIB_LOGE("DMASPIBus::init: spi_bus_initialize failed %d", err);
+        return error::error_t::UNKNOWN_ERROR;
+    }
+    if (_config.pin_dc) {
+        _config.pin_dc->setMode(m5::hal::types::gpio_mode_t::Output);
+    }
+    _initialized = true;
+    M5_LIB_LOGV("DMASPIBus::init: ok %s", __PRETTY_FUNCTION__);
+    return error::error_t::OK;
+}
+
+error::error_t DMASPIBus::release(void)
+{
+    if (!_initialized) {
+        return error::error_t::OK;
+    }
+    _mutex.lock();
+    releaseDevice();
+    spi_bus_free(_host);
+    _initialized = false;
+    _mutex.unlock();
+    return error::error_t::OK;
+}
+
+void DMASPIBus::releaseDevice(void)
+{
+    if (_device) {
+        spi_bus_remove_device(_device);
+        _device = nullptr;
+    }
+}
+
+bool DMASPIBus::setupDevice(const hal::bus::SPIMasterAccessConfig& access_config)
+{
+    bool half = false;
+    switch (access_config.spi_data_mode) {
+        case hal::bus::spi_data_mode_t::spi_halfduplex:
+        case hal::bus::spi_data_mode_t::spi_halfduplex_with_dc_pin:
+        case hal::bus::spi_data_mode_t::spi_halfduplex_with_dc_bit:
+            half = true;
+            break;
+        default:
+            break;
+    }
+    if (_device && _device_freq == access_config.freq && _device_mode == access_config.spi_mode &&
+        _device_order == access_config.spi_order && _device_half == half) {
+        return true;
+    }
+    releaseDevice();
+
+    spi_device_interface_config_t devcfg{};
+    devcfg.mode           = access_config.spi_mode;
+    devcfg.clock_speed_hz = access_config.freq;
+    devcfg.spics_io_num   = -1;  // CSは cs_control で制御する
+    devcfg.queue_size     = M5HAL_ESP32_SPI_QUEUE_SIZE;
+    devcfg.flags          = (access_config.spi_order ? SPI_DEVICE_BIT_LSBFIRST : 0) | (half ? SPI_DEVICE_HALFDUPLEX : 0);
+    auto err              = spi_bus_add_device(_host, &devcfg, &_device);
+    if (err != ESP_OK) {
+        M5_LIB_LOGE("DMASPIBus::setupDevice: spi_bus_add_device failed %d", err);
+        _device = nullptr;
+        return false;
+    }
+    _device_freq  = access_config.freq;
+    _device_mode  = access_config.spi_mode;
+    _device_order = access_config.spi_order;
+    _device_half  = half;
+    return true;
+}
+
+m5::stl::expected<hal::bus::Accessor*, m5::hal::error::error_t> DMASPIBus::beginAccess(
+    const hal::bus::AccessConfig& access_config)
+{
+    if (access_config.getBusType() != getBusType() || !_initialized) {
+        M5_LIB_LOGE("DMASPIBus::beginAccess: error %s", __PRETTY_FUNCTION__);
+        return m5::stl::make_unexpected(m5::hal::error::error_t::INVALID_ARGUMENT);
+    }
+    // 他のタスクがアクセス中の場合はendAccessされるまで待機する
+    _mutex.lock();
+    if (_Accessor.get() != nullptr) {
+        _mutex.unlock();
+        M5_LIB_LOGE("DMASPIBus::beginAccess: error %s", __PRETTY_FUNCTION__);
+        return m5::stl::make_unexpected(m5::hal::error::error_t::INVALID_ARGUMENT);
+    }
+    auto& ac = static_cast<const hal::bus::SPIMasterAccessConfig&>(access_config);
+    if (!setupDevice(ac)) {
+        _mutex.unlock();
+        return m5::stl::make_unexpected(m5::hal::error::error_t::UNKNOWN_ERROR);
+    }
+    // 同じSPIホストを共有する他のドライバ(ESP-IDF)からも保護する
+    spi_device_acquire_bus(_device, portMAX_DELAY);
+    auto result = new DMASPIMasterAccessor(*this, ac, _device);
+    _Accessor.reset(result);
+    M5_LIB_LOGV("DMASPIBus::beginAccess: ok %s", __PRETTY_FUNCTION__);
+    return result;
+}
+
+error::error_t DMASPIBus::endAccess(hal::bus::Accessor* Accessor)
+{
+    if (Accessor && _Accessor.get() == Accessor) {
+        Accessor->waitTransaction(UINT32_MAX);
+        spi_device_release_bus(_device);
+    }
+    return SPIBus::endAccess(Accessor);
+}
+
+m5::stl::expected<hal::bus::spi::SPIBus*, m5::hal::error::error_t> getBus(const hal::bus::SPIBusConfig& config)
+{
+#if SOC_SPI_PERIPH_NUM > 2
+    static DMASPIBus buses[2];
+    auto& bus = buses[static_cast<types::periph_t>(config.periph) == types::periph_t::spi3 ? 1 : 0];
+#else
+    static DMASPIBus buses[1];
+    auto& bus = buses[0];
+#endif
+    auto err = bus.init(config);
+    if (error::isError(err)) {
+        return m5::stl::make_unexpected(err);
+    }
+    return &bus;
+}
+
+}  // namespace spi
+
+namespace i2c {
+
+//-------------------------------------------------------------------------
+
+HardwareI2CMasterAccessor::HardwareI2CMasterAccessor(HardwareI2CBus& bus,
+                                                     const hal::bus::I2CMasterAccessConfig& access_config)
+    : I2CMasterAccessor{bus, access_config}, _i2c_bus{bus}
+{
+}
+
+HardwareI2CMasterAccessor::~HardwareI2CMasterAccessor(void)
+{
+    waitTransaction(UINT32_MAX);
+    if (_cmd) {
+        i2c_cmd_link_delete(_cmd);
+    }
+}
+
+// 同期処理用のコマンドリンクを用意する (未完了の非同期トランザクションの完了を待ってから行う)
+m5::stl::expected<void, m5::hal::error::error_t> HardwareI2CMasterAccessor::prepare(void)
+{
+    if (_cmd) {
+        return {};
+    }
+    auto res = waitTransaction(UINT32_MAX);
+    if (!res) {
+        return res;
+    }
+    _cmd = i2c_cmd_link_create();
+    if (_cmd == nullptr) {
+        return m5::stl::make_unexpected(error::error_t::UNKNOWN_ERROR);
+    }
+    return {};
+}
+
+// 蓄積したコマンドを実行する (stopを含まない場合、バスは保持されたままとなる)
+m5::stl::expected<void, m5::hal::error::error_t> HardwareI2CMasterAccessor::execute(void)
+{
+    if (_cmd == nullptr) {
+        return {};
+    }
+    auto err = i2c_master_cmd_begin(_i2c_bus.getPort(), _cmd, toTicks(_access_config.timeout_msec));
+    i2c_cmd_link_delete(_cmd);
+    _cmd = nullptr;
+    auto result = HardwareI2CBus::toError(err);
+    if (error::isError(result)) {
+        return m5::stl::make_unexpected(result);
+    }
+    return {};
+}
+
+m5::stl::expected<void, m5::hal::error::error_t> HardwareI2CMasterAccessor::startWrite(void)
+{
+    auto res = prepare();
+    if (!res) {
+        return res;
+    }
+    i2c_master_start(_cmd);
+    i2c_master_write_byte(_cmd, (uint8_t)(_access_config.i2c_addr << 1) | I2C_MASTER_WRITE, true);
+    return {};
+}
+
+m5::stl::expected<void, m5::hal::error::error_t> HardwareI2CMasterAccessor::startRead(void)
+{
+    auto res = prepare();
+    if (!res) {
+        return res;
+    }
+    i2c_master_start(_cmd);
+    i2c_master_write_byte(_cmd, (uint8_t)(_access_config.i2c_addr << 1) | I2C_MASTER_READ, true);
+    return {};
+}
+
+m5::stl::expected<void, m5::hal::error::error_t> HardwareI2CMasterAccessor::stop(void)
+{
+    auto res = prepare();
+    if (!res) {
+        return res;
+    }
+    i2c_master_stop(_cmd);
+    return execute();
+}
+
+m5::stl::expected<size_t, m5::hal::error::error_t> HardwareI2CMasterAccessor::write(const uint8_t* data, size_t len)
+{
+    auto res = prepare();
+    if (!res) {
+        return m5::stl::make_unexpected(res.error());
+    }
+    if (len) {
+        i2c_master_write(_cmd, data, len, true);
+    }
+    return len;
+}
+
+m5::stl::expected<size_t, m5::hal::error::error_t> HardwareI2CMasterAccessor::readWithLastNackFlag(uint8_t* data,
+                                                                                                  size_t len,
+                                                                                                  bool last_nack)
+{
+    auto res = prepare();
+    if (!res) {
+        return m5::stl::make_unexpected(res.error());
+    }
+    if (len) {
+        i2c_master_read(_cmd, data, len, last_nack ? I2C_MASTER_LAST_NACK : I2C_MASTER_ACK);
+    }
+    // 戻った時点でデータが有効となるよう、ここで実行する
+    res = execute();
+    if (!res) {
+        return m5::stl::make_unexpected(res.error());
+    }
+    return len;
+}
+
+// 完了したトランザクションを1つ回収してコールバックを呼び出す
+bool HardwareI2CMasterAccessor::collect(TickType_t ticks)
+{
+    hal::bus::Transaction* transaction = nullptr;
+    if (_pending == 0 || xQueueReceive(_i2c_bus._complete, &transaction, ticks) != pdTRUE) {
+        return false;
+    }
+    --_pending;
+    if (transaction->callback) {
+        transaction->callback(this, transaction);
+    }
+    return true;
+}
+
+m5::stl::expected<size_t, m5::hal::error::error_t> HardwareI2CMasterAccessor::poll(void)
+{
+    while (collect(0)) {
+    }
+    return _pending;
+}
+
+m5::stl::expected<void, m5::hal::error::error_t> HardwareI2CMasterAccessor::waitTransaction(uint32_t timeout_msec)
+{
+    auto ticks = toTicks(timeout_msec);
+    while (_pending) {
+        if (!collect(ticks)) {
+            return m5::stl::make_unexpected(error::error_t::TIMEOUT_ERROR);
+        }
+    }
+    return {};
+}
+
+m5::stl::expected<void, m5::hal::error::error_t> HardwareI2CMasterAccessor::transaction(
+    hal::bus::Transaction* transaction)
+{
+    if (transaction == nullptr || (transaction->tx_len == 0 && transaction->rx_len == 0)) {
+        return m5::stl::make_unexpected(error::error_t::INVALID_ARGUMENT);
+    }
+    // 同期処理の途中では投入できない
+    if (_cmd) {
+        return m5::stl::make_unexpected(error::error_t::INVALID_ARGUMENT);
+    }
+    if (!_i2c_bus.startTask()) {
+        return m5::stl::make_unexpected(error::error_t::UNKNOWN_ERROR);
+    }
+    poll();
+    HardwareI2CBus::request_t req{transaction, _access_config.i2c_addr, _access_config.timeout_msec};
+    transaction->result = error::error_t::ASYNC_RUNNING;
+    if (xQueueSend(_i2c_bus._request, &req, 0) != pdTRUE) {
+        transaction->result = error::error_t::TIMEOUT_ERROR;
+        return m5::stl::make_unexpected(error::error_t::TIMEOUT_ERROR);
+    }
+    ++_pending;
+    return {};
+}
+
+//-------------------------------------------------------------------------
+
+error::error_t HardwareI2CBus::toError(esp_err_t err)
+{
+    switch (err) {
+        case ESP_OK:
+            return error::error_t::OK;
+        case ESP_FAIL:  // NACK
+            return error::error_t::I2C_NO_ACK;
+        case ESP_ERR_TIMEOUT:
+            return error::error_t::TIMEOUT_ERROR;
+        case ESP_ERR_INVALID_ARG:
+            return error::error_t::INVALID_ARGUMENT;
+        default:
+            return error::error_t::I2C_BUS_ERROR;
+    }
+}
+
+// 非同期トランザクションを1つずつ処理するタスク
+void HardwareI2CBus::task(void* arg)
+{
+    auto self = static_cast<HardwareI2CBus*>(arg);
+    request_t req;
+    while (xQueueReceive(self->_request, &req, portMAX_DELAY) == pdTRUE) {
+        auto transaction = req.transaction;
+        if (transaction == nullptr) {  // stopTask からの要求
+            break;
+        }
+        auto cmd = i2c_cmd_link_create();
+        if (cmd == nullptr) {
+            transaction->result = error::error_t::UNKNOWN_ERROR;
+        } else {
+            if (transaction->tx_len) {
+                i2c_master_start(cmd);
+                i2c_master_write_byte(cmd, (uint8_t)(req.i2c_addr << 1) | I2C_MASTER_WRITE, true);
+                i2c_master_write(cmd, transaction->tx_data, transaction->tx_len, true);
+            }
+            if (transaction->rx_len) {
+                i2c_master_start(cmd);
+                i2c_master_write_byte(cmd, (uint8_t)(req.i2c_addr << 1) | I2C_MASTER_READ, true);
+                i2c_master_read(cmd, transaction->rx_data, transaction->rx_len, I2C_MASTER_LAST_NACK);
+            }
+            i2c_master_stop(cmd);
+            transaction->result = toError(i2c_master_cmd_begin(self->_port, cmd, toTicks(req.timeout_msec)));
+            i2c_cmd_link_delete(cmd);
+        }
+        xQueueSend(self->_complete, &transaction, portMAX_DELAY);
+    }
+    self->_task_running = false;
+    vTaskDelete(nullptr);
+}
+
+bool HardwareI2CBus::startTask(void)
+{
+    if (_task_running) {
+        return true;
+    }
+    if (!_request) {
+        _request = xQueueCreate(M5HAL_ESP32_I2C_QUEUE_SIZE, sizeof(request_t));
+    }
+    if (!_complete) {
+        // 停止要求の分も含めて、完了通知の送信で待たされないようにする
+        _complete = xQueueCreate(M5HAL_ESP32_I2C_QUEUE_SIZE + 1, sizeof(hal::bus::Transaction*));
+    }
+    if (!_request || !_complete) {
+        M5_LIB_LOGE("HardwareI2CBus: Failed to allocate");
+        return false;
+    }
+    _task_running = true;
+    if (xTaskCreate(task, "m5hal_i2c", M5HAL_ESP32_I2C_TASK_STACK_SIZE, this, M5HAL_ESP32_I2C_TASK_PRIORITY,
+                    &_task) != pdPASS) {
+        M5_LIB_LOGE("HardwareI2CBus: Failed to create task");
+        _task_running = false;
+        _task         = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void HardwareI2CBus::stopTask(void)
+{
+    if (_task_running) {
+        request_t stop{};
+        xQueueSend(_request, &stop, portMAX_DELAY);
+        while (_task_running) {
+            vTaskDelay(1);
+        }
+        _task = nullptr;
+    }
+    if (_request) {
+        vQueueDelete(_request);
+        _request = nullptr;
+    }
+    if (_complete) {
+        vQueueDelete(_complete);
+        _complete = nullptr;
+    }
+}
+
+error::error_t HardwareI2CBus::init(const hal::bus::BusConfig& config)
+{
+    if (config.getBusType() != hal::types::bus_type_t::I2C) {
+        M5_LIB_LOGE("HardwareI2CBus::init: error %s", __PRETTY_FUNCTION__);
+        return error::error_t::INVALID_ARGUMENT;
+    }
+    release();
+    _config = static_cast<const hal::bus::I2CBusConfig&>(config);
+    if (_config.pin_scl == nullptr || _config.pin_sda == nullptr) {
+        M5_LIB_LOGE("HardwareI2CBus::init: error %s", __PRETTY_FUNCTION__);
+        return error::error_t::INVALID_ARGUMENT;
+    }
+
+    switch (static_cast<types::periph_t>(_config.periph)) {
+        case types::periph_t::i2c0:
+            _port = I2C_NUM_0;
+            break;
+#if SOC_I2C_NUM > 1
+        case types::periph_t::i2c1:
+            _port = I2C_NUM_1;
+            break;
+#endif
+        default:
+            M5_LIB_LOGE("HardwareI2CBus::init: invalid periph %s", __PRETTY_FUNCTION__);
+            return error::error_t::INVALID_ARGUMENT;
+    }
+
+    i2c_config_t conf{};
+    conf.mode             = I2C_MODE_MASTER;
+    conf.sda_io_num       = _config.pin_sda->getGpioNumber();
+    conf.scl_io_num       = _config.pin_scl->getGpioNumber();
+    conf.sda_pullup_en    = GPIO_PULLUP_ENABLE;
+    conf.scl_pullup_en    = GPIO_PULLUP_ENABLE;
+    conf.master.clk_speed = _freq = 100000;
+    auto err                      = i2c_param_config(_port, &conf);
+    if (err == ESP_OK) {
+        err = i2c_driver_install(_port, I2C_MODE_MASTER, 0, 0, 0);
+    }
+    if (err != ESP_OK) {
+        M5_LIB_LOGE("HardwareI2CBus::init: failed %d", err);
+        return error::error_t::UNKNOWN_ERROR;
+    }
+    _initialized = true;
+    M5_LIB_LOGV("HardwareI2CBus::init: ok %s", __PRETTY_FUNCTION__);
+    return error::error_t::OK;
+}
+
+error::error_t HardwareI2CBus::release(void)
+{
+    if (!_initialized) {
+        return error::error_t::OK;
+    }
+    _mutex.lock();
+    stopTask();
+    i2c_driver_delete(_port);
+    _initialized = false;
+    _mutex.unlock();
+    return error::error_t::OK;
+}
+
+m5::stl::expected<hal::bus::Accessor*, m5::hal::error::error_t> HardwareI2CBus::beginAccess(
+    const hal::bus::AccessConfig& access_config)
+{
+    if (access_config.getBusType() != getBusType() || !_initialized) {
+        M5_LIB_LOGE("HardwareI2CBus::beginAccess: error %s", __PRETTY_FUNCTION__);
+        return m5::stl::make_unexpected(m5::hal::error::error_t::INVALID_ARGUMENT);
+    }
+    auto& ac = static_cast<const hal::bus::I2CMasterAccessConfig&>(access_config);
+    // 他のタスクがアクセス中の場合はendAccessされるまで待機する
+    if (!_mutex.lock(ac.timeout_msec)) {
+        M5_LIB_LOGE("HardwareI2CBus::beginAccess: timeout %s", __PRETTY_FUNCTION__);
+        return m5::stl::make_unexpected(m5::hal::error::error_t::TIMEOUT_ERROR);
+    }
+    if (_Accessor.get() != nullptr) {
+        _mutex.unlock();
+        M5_LIB_LOGE("HardwareI2CBus::beginAccess: error %s", __PRETTY_FUNCTION__);
+        return m5::stl::make_unexpected(m5::hal::error::error_t::INVALID_ARGUMENT);
+    }
+    if (_freq != ac.freq) {
+        i2c_config_t conf{};
+        conf.mode             = I2C_MODE_MASTER;
+        conf.sda_io_num       = _config.pin_sda->getGpioNumber();
+        conf.scl_io_num       = _config.pin_scl->getGpioNumber();
+        conf.sda_pullup_en    = GPIO_PULLUP_ENABLE;
+        conf.scl_pullup_en    = GPIO_PULLUP_ENABLE;
+        conf.master.clk_speed = ac.freq;
+        if (i2c_param_config(_port, &conf) == ESP_OK) {
+            _freq = ac.freq;
+        }
+    }
+    auto result = new HardwareI2CMasterAccessor(*this, ac);
+    _Accessor.reset(result);
+    M5_LIB_LOGV("HardwareI2CBus::beginAccess: ok %s", __PRETTY_FUNCTION__);
+    return result;
+}
+
+m5::stl::expected<hal::bus::i2c::I2CBus*, m5::hal::error::error_t> getBus(const hal::bus::I2CBusConfig& config)
+{
+#if SOC_I2C_NUM > 1
+    static HardwareI2CBus buses[2];
+    auto& bus = buses[static_cast<types::periph_t>(config.periph) == types::periph_t::i2c1 ? 1 : 0];
+#else
+    static HardwareI2CBus buses[1];
+    auto& bus = buses[0];
+#endif
+    auto err = bus.init(config);
+    if (error::isError(err)) {
+        return m5::stl::make_unexpected(err);
+    }
+    return &bus;
+}
+
+}  // namespace i2c
+}  // namespace bus
+}  // namespace esp32
+}  // namespace platforms
+}  // namespace hal
+}  // namespace m5
+
+#endif
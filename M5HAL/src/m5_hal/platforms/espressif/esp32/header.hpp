@@ -36,4 +36,6 @@ interface::gpio::GPIO* getGPIO(void);
 }  // namespace hal
 }  // namespace m5
 
+#include "../common/bus.hpp"
+
 #endif
@@ -1 +1 @@
-
+#include "../common/bus.inl"
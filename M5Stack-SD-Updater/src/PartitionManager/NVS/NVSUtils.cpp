@@ -202,6 +202,68 @@ namespace SDUpdaterNS
     }
 
 
+    // read the whole digest cache, returns the number of entries
+    static size_t getDigestCache( DigestCacheEntry_t *entries, size_t max_entries )
+    {
+      size_t blob_size = sizeof(DigestCacheEntry_t)*max_entries;
+      if( nvs_open(PARTITION_NS, NVS_READONLY, &handle) != ESP_OK ) {
+        log_i("NVS Namespace %s not created yet", PARTITION_NS );
+        return 0;
+      }
+      if( nvs_get_blob(handle, DIGEST_CACHE_KEY, entries, &blob_size) != ESP_OK ) {
+        log_i("NVS key %s::%s not created yet", PARTITION_NS, DIGEST_CACHE_KEY);
+        blob_size = 0;
+      }
+      nvs_close( handle );
+      return blob_size / sizeof(DigestCacheEntry_t);
+    }
+
+
+    bool findCachedDigest( const uint8_t digest[32], size_t bin_size, uint8_t *ota_num )
+    {
+      DigestCacheEntry_t entries[ESP_PARTITION_SUBTYPE_APP_OTA_MAX-ESP_PARTITION_SUBTYPE_APP_OTA_MIN];
+      size_t count = getDigestCache( entries, sizeof(entries)/sizeof(entries[0]) );
+      Flash::digest_t digests = Flash::digest_t();
+      for( int i=0; i<count; i++ ) {
+        if( entries[i].bin_size == bin_size && digests.match( entries[i].digest, digest ) ) {
+          log_d("Digest %s found in OTA%d", digests.toString( digest ), entries[i].ota_num );
+          *ota_num = entries[i].ota_num;
+          return true;
+        }
+      }
+      return false;
+    }
+
+
+    bool saveCachedDigest( uint8_t ota_num, size_t bin_size, const uint8_t digest[32] )
+    {
+      DigestCacheEntry_t entries[ESP_PARTITION_SUBTYPE_APP_OTA_MAX-ESP_PARTITION_SUBTYPE_APP_OTA_MIN];
+      size_t count = getDigestCache( entries, sizeof(entries)/sizeof(entries[0]) );
+      size_t idx = 0;
+      while( idx<count && entries[idx].ota_num != ota_num ) idx++; // one entry per partition
+      if( idx == count ) {
+        if( count == sizeof(entries)/sizeof(entries[0]) ) return false;
+        count++;
+      }
+      entries[idx].ota_num  = ota_num;
+      entries[idx].bin_size = bin_size;
+      memcpy( entries[idx].digest, digest, 32 );
+
+      if( nvs_open(PARTITION_NS, NVS_READWRITE, &handle) != ESP_OK ) {
+        log_e("Cannot open NVS Namespace %s for writing", PARTITION_NS);
+        return false;
+      }
+      bool ret = nvs_set_blob(handle, DIGEST_CACHE_KEY, entries, sizeof(DigestCacheEntry_t)*count) == ESP_OK;
+      if( ret ) {
+        nvs_commit( handle );
+      } else {
+        log_e("NVS failed to save %s::%s", PARTITION_NS, DIGEST_CACHE_KEY);
+      }
+      nvs_close( handle );
+      return ret;
+    }
+
+
     // Rollback helper: save menu.bin meta info in NVS
     bool saveMenuPrefs()
     {
@@ -25,6 +25,8 @@ namespace SDUpdaterNS
     // NVS namespace/key for virtual partitions array (may hold fw-menu partition)
     constexpr const char* PARTITION_NS  = "sdu";
     constexpr const char* PARTITION_KEY = "partitions";
+    // NVS key for the digest cache (which binary is flashed in which OTA partition)
+    constexpr const char* DIGEST_CACHE_KEY = "digests";
     // NVS namespace/keys for sd-menu partition (blob digest + size)
     constexpr const char* MENU_PREF_NS  = "sd-menu";
     constexpr const char* DIGEST_KEY    = "digest";
@@ -41,6 +43,14 @@ namespace SDUpdaterNS
       //char    desc[40]{0};   // firmware desc
     };
 
+    // NVS representation of a digest cache entry
+    struct __attribute__((__packed__)) DigestCacheEntry_t
+    {
+      uint8_t  ota_num{0};    // OTA partition number
+      uint32_t bin_size{0};   // firmware size
+      uint8_t  digest[32]{0}; // firmware digest (SHA256 appended to the image)
+    };
+
     struct blob_partition_t
     {
       char* blob{nullptr};
@@ -75,6 +85,10 @@ namespace SDUpdaterNS
     bool savePartitions();
     bool parsePartitions( const char* blob, size_t size );
 
+    // digest cache, lets a binary that is already flashed be booted without copying it again
+    bool findCachedDigest( const uint8_t digest[32], size_t bin_size, uint8_t *ota_num );
+    bool saveCachedDigest( uint8_t ota_num, size_t bin_size, const uint8_t digest[32] );
+
     // save menu.bin meta info in NVS
     bool saveMenuPrefs();
     bool getMenuPrefs( uint32_t *menuSize, uint8_t *image_digest );
@@ -553,6 +553,32 @@ namespace SDUpdaterNS
     }
 
 
+    bool getImageDigest( fs::File* file, uint8_t digest[32] )
+    {
+      esp_image_header_t header;
+      size_t size = file->size();
+      bool ret = false;
+      if( size > sizeof(header)+32 && file->read( (uint8_t*)&header, sizeof(header) ) == sizeof(header) ) {
+        // gzipped or hashless images don't end with the image digest
+        if( header.magic == ESP_IMAGE_HEADER_MAGIC && header.hash_appended == 1 ) {
+          ret = file->seek( size-32 ) && file->read( digest, 32 ) == 32;
+        }
+      }
+      file->seek( 0 );
+      return ret;
+    }
+
+
+    bool partitionHasImage( const esp_partition_t* part, size_t bin_size, const uint8_t digest[32] )
+    {
+      uint8_t flashed[32];
+      if( !part || bin_size < 32 || bin_size > part->size ) return false;
+      if( esp_partition_read( part, bin_size-32, flashed, 32 ) != ESP_OK ) return false;
+      digest_t digests = digest_t();
+      return digests.match( flashed, digest );
+    }
+
+
     bool isEmpty( Partition_t* sdu_partition )
     {
       return partitionIsApp( &sdu_partition->part ) && !partitionIsFactory( &sdu_partition->part ) && !metadataHasDigest( &sdu_partition->meta );
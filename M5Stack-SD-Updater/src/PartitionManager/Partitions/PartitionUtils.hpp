@@ -68,6 +68,8 @@ namespace SDUpdaterNS
     bool partitionIsOTA( const esp_partition_t *part );
     bool partitionIsFactory( const esp_partition_t *part );
     bool metadataHasDigest( const esp_image_metadata_t *meta );
+    bool getImageDigest( fs::File* file, uint8_t digest[32] ); // read the SHA256 appended to an app image file, without hashing it
+    bool partitionHasImage( const esp_partition_t* part, size_t bin_size, const uint8_t digest[32] ); // check the appended SHA256 of a flashed image
     bool isEmpty( Flash::Partition_t* sdu_partition );
 
     const esp_partition_t* getPartition( uint8_t ota_num );
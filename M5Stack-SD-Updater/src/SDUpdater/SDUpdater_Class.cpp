@@ -78,6 +78,101 @@ namespace SDUpdaterNS
   }
 
 
+  // state shared by bufferedWrite() and the reader task
+  struct copyJob_t
+  {
+    Stream *source;
+    size_t remaining;          // bytes left to read
+    uint8_t *buf[2];
+    size_t len[2];             // bytes read into each buffer
+    QueueHandle_t empty;       // buffer indexes ready to be read into
+    QueueHandle_t filled;      // buffer indexes ready to be written
+    SemaphoreHandle_t done;    // given when the reader task has exited
+  };
+
+  static const uint8_t copyStop = 0xff; // sent as a buffer index to stop the reader
+
+
+  // fill buffers from the filesystem while the other one is being written to flash
+  static void copyReaderTask( void* param )
+  {
+    copyJob_t *job = (copyJob_t*)param;
+    uint8_t idx;
+    while( xQueueReceive( job->empty, &idx, portMAX_DELAY ) == pdTRUE && idx != copyStop ) {
+      size_t want = job->remaining < (size_t)SDU_COPY_BUFFER_SIZE ? job->remaining : (size_t)SDU_COPY_BUFFER_SIZE;
+      size_t got = want > 0 ? job->source->readBytes( (char*)job->buf[idx], want ) : 0;
+      job->remaining -= got;
+      job->len[idx] = got;
+      xQueueSend( job->filled, &idx, portMAX_DELAY );
+      if( got == 0 ) break; // end of file or read error
+    }
+    xSemaphoreGive( job->done );
+    vTaskDelete( NULL );
+  }
+
+
+  // double buffered copy, returns false if it couldn't start (nothing was read from the stream)
+  bool SDUpdater::bufferedWrite( Stream &updateSource, size_t updateSize, size_t &written )
+  {
+    written = 0;
+    if( SDU_COPY_BUFFER_SIZE == 0 || !UpdateIface->canWrite() ) return false;
+
+    copyJob_t job = { &updateSource, updateSize, { nullptr, nullptr }, { 0, 0 }, nullptr, nullptr, nullptr };
+    job.buf[0] = (uint8_t*)malloc( SDU_COPY_BUFFER_SIZE );
+    job.buf[1] = (uint8_t*)malloc( SDU_COPY_BUFFER_SIZE );
+    job.empty  = xQueueCreate( 3, sizeof(uint8_t) ); // both buffers + copyStop
+    job.filled = xQueueCreate( 2, sizeof(uint8_t) );
+    job.done   = xSemaphoreCreateBinary();
+
+    bool started = job.buf[0] && job.buf[1] && job.empty && job.filled && job.done;
+    if( started ) {
+      // read on the other core when there is one
+      BaseType_t core = portNUM_PROCESSORS > 1 ? 1 - xPortGetCoreID() : 0;
+      started = xTaskCreatePinnedToCore( copyReaderTask, "sdu_reader", 4096, &job, uxTaskPriorityGet(NULL), NULL, core ) == pdPASS;
+    }
+
+    if( started ) {
+      for( uint8_t idx=0; idx<2; idx++ ) xQueueSend( job.empty, &idx, 0 );
+      uint8_t idx;
+      while( written < updateSize && xQueueReceive( job.filled, &idx, portMAX_DELAY ) == pdTRUE ) {
+        if( job.len[idx] == 0 ) break;
+        size_t chunk = UpdateIface->write( job.buf[idx], job.len[idx] );
+        written += chunk;
+        if( chunk != job.len[idx] ) break;
+        if( cfg->onProgress ) cfg->onProgress( written, updateSize );
+        xQueueSend( job.empty, &idx, 0 );
+      }
+      xQueueSend( job.empty, &copyStop, 0 );
+      xSemaphoreTake( job.done, portMAX_DELAY );
+    } else {
+      log_w("Not enough memory for a buffered copy, using stream copy");
+    }
+
+    if( job.done )   vSemaphoreDelete( job.done );
+    if( job.filled ) vQueueDelete( job.filled );
+    if( job.empty )  vQueueDelete( job.empty );
+    free( job.buf[1] );
+    free( job.buf[0] );
+    return started;
+  }
+
+
+  // boot the OTA partition already holding this binary, if any
+  void SDUpdater::bootCachedImage( const uint8_t digest[32], size_t updateSize )
+  {
+    uint8_t ota_num;
+    if( !NVS::findCachedDigest( digest, updateSize, &ota_num ) ) return;
+    // the partition may have been overwritten since (e.g. by another OTA method)
+    if( !Flash::partitionHasImage( Flash::getPartition( ota_num ), updateSize, digest ) ) {
+      log_w("OTA%d no longer holds this binary", ota_num );
+      return;
+    }
+    _message( "Binary found in OTA" + String( ota_num ) );
+    if( cfg->onProgress ) cfg->onProgress( 100, 100 );
+    Flash::bootPartition( ota_num ); // restarts on success
+  }
+
+
   // perform the actual update from a given stream
   void SDUpdater::performUpdate( Stream &updateSource, size_t updateSize, String fileName )
   {
@@ -88,7 +183,10 @@ namespace SDUpdaterNS
     log_d( "Binary size: %d bytes", updateSize );
     if( cfg->onProgress ) UpdateIface->onProgress( cfg->onProgress );
     if (UpdateIface->begin( updateSize )) {
-      size_t written = UpdateIface->writeStream( updateSource, updateSize );
+      size_t written;
+      if( !bufferedWrite( updateSource, updateSize, written ) ) { // gzipped or low on memory
+        written = UpdateIface->writeStream( updateSource, updateSize );
+      }
       if ( written == updateSize ) {
         SDU_SERIAL.println( "Written : " + String(written) + " successfully" );
       } else {
@@ -262,8 +360,18 @@ namespace SDUpdaterNS
 
     File updateBin = cfg->fs->open( fileName );
     if ( updateBin ) {
-      updateFromStream( updateBin, updateBin.size(), fileName );
+      uint8_t digest[32];
+      size_t updateSize = updateBin.size();
+      bool hasDigest = Flash::getImageDigest( &updateBin, digest );
+      if( hasDigest ) {
+        bootCachedImage( digest, updateSize ); // only returns if no partition holds this binary
+      }
+      updateFromStream( updateBin, updateSize, fileName );
       updateBin.close();
+      const esp_partition_t* boot = esp_ota_get_boot_partition();
+      if( hasDigest && boot != esp_ota_get_running_partition() && Flash::partitionIsOTA( boot ) && Flash::partitionHasImage( boot, updateSize, digest ) ) {
+        NVS::saveCachedDigest( boot->subtype - ESP_PARTITION_SUBTYPE_APP_OTA_MIN, updateSize, digest );
+      }
     } else {
       const char* msg[] = {"Could not reach", fileName.c_str(), "Can't load firmware."};
       _error( msg, 3 );
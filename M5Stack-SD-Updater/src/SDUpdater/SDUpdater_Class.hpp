@@ -99,6 +99,8 @@ namespace SDUpdaterNS
       const char* MenuBin = MENU_BIN;
       bool checkUpdaterCommon( String fileName );
       void performUpdate( Stream &updateSource, size_t updateSize, String fileName );
+      bool bufferedWrite( Stream &updateSource, size_t updateSize, size_t &written );
+      void bootCachedImage( const uint8_t digest[32], size_t updateSize );
       void tryRollback( String fileName );
 
       #if defined _M5Core2_H_ || defined _M5CORES3_H_
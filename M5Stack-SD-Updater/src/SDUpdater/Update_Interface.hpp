@@ -29,7 +29,9 @@
           .rollBack    = []()->bool{ return GzUpdate.rollBack(); },
           .onProgress  = [](UpdateClass::THandlerFunction_Progress fn){ GzUpdate.onProgress(fn); },
           .getError    = []()->uint8_t{ return GzUpdate.getError(); },
-          .setBinName  = []( String& fileName, Stream* stream ) { mode_z=fileName.endsWith(".gz")?(stream->peek()==0x1f):false; log_d("Compression %s", mode_z?"enabled":"disabled"); }
+          .setBinName  = []( String& fileName, Stream* stream ) { mode_z=fileName.endsWith(".gz")?(stream->peek()==0x1f):false; log_d("Compression %s", mode_z?"enabled":"disabled"); },
+          .write       = [](uint8_t *data, size_t len)->size_t{ return GzUpdate.write(data, len); },
+          .canWrite    = []()->bool{ return !mode_z; }
         };
         return &Iface;
       }
@@ -57,7 +59,9 @@
           .rollBack    = []()->bool{ return Update.rollBack(); },
           .onProgress  = [](UpdateClass::THandlerFunction_Progress fn){ Update.onProgress(fn); },
           .getError    = []()->uint8_t{ return Update.getError(); },
-          .setBinName  = [](String&fileName, Stream* stream) { if(fileName.endsWith(".gz")) log_e("Gz file detected but gz support is disabled!"); }
+          .setBinName  = [](String&fileName, Stream* stream) { if(fileName.endsWith(".gz")) log_e("Gz file detected but gz support is disabled!"); },
+          .write       = [](uint8_t *data, size_t len)->size_t{ return Update.write(data, len); },
+          .canWrite    = []()->bool{ return true; }
         };
         return &Iface;
       }
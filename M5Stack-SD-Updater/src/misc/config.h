@@ -22,6 +22,12 @@
   #define MENU_BIN "/menu.bin"
 #endif
 
+// size of each of the two buffers used to copy the binary from the filesystem to flash,
+// reading one while the other is written (set to 0 to disable)
+#ifndef SDU_COPY_BUFFER_SIZE
+  #define SDU_COPY_BUFFER_SIZE 32768
+#endif
+
 
 // Fancy names for detected boards
 #if defined ARDUINO_M5Stick_C || defined ARDUINO_M5STICK_C
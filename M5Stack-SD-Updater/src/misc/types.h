@@ -30,6 +30,8 @@ namespace SDUpdaterNS
       typedef void    (*onProgress_t)(THandlerFunction_Progress fn);
       typedef uint8_t (*getError_t)();
       typedef void    (*setBinName_t)(String& fileName, Stream* stream);
+      typedef size_t  (*write_t)(uint8_t *data, size_t len);
+      typedef bool    (*canWrite_t)(); // false when write() can't take the binary as is (e.g. gzipped)
       public:
         begin_t begin;
         writeStream_t writeStream;
@@ -41,6 +43,8 @@ namespace SDUpdaterNS
         onProgress_t onProgress;
         getError_t getError;
         setBinName_t setBinName;
+        write_t write;
+        canWrite_t canWrite;
     };
   };
 
@@ -15,6 +15,16 @@
 
 #include "In_eSPI.h"
 
+#if defined(ESP32_DMA)
+#include "esp_heap_caps.h"
+#include "soc/soc_memory_layout.h"
+#ifdef USE_HSPI_PORT
+#define DMA_SPI_HOST HSPI_HOST
+#else
+#define DMA_SPI_HOST VSPI_HOST
+#endif
+#endif
+
 #if defined(ESP32)
 #if !defined(ESP32_PARALLEL)
 #ifdef USE_HSPI_PORT
@@ -51,6 +61,10 @@ void busDir(uint32_t mask, uint8_t mode);
 void gpioMode(uint8_t gpio, uint8_t mode);
 
 inline void TFT_eSPI::spi_begin(void) {
+#if defined(ESP32_DMA)
+    // SPI registers must not be touched while a DMA transfer is running
+    if (spiBusyCheck) dmaWait();
+#endif
 #if defined(SPI_HAS_TRANSACTION) && defined(SUPPORT_TRANSACTIONS) && \
     !defined(ESP32_PARALLEL)
     if (locked) {
@@ -71,6 +85,9 @@ inline void TFT_eSPI::spi_end(void) {
 #if defined(SPI_HAS_TRANSACTION) && defined(SUPPORT_TRANSACTIONS) && \
     !defined(ESP32_PARALLEL)
     if (!inTransaction) {
+#if defined(ESP32_DMA)
+        if (spiBusyCheck) dmaWait();  // Keep CS low until DMA has finished
+#endif
         if (!locked) {
             locked = true;
             CS_H;
@@ -88,6 +105,9 @@ inline void TFT_eSPI::spi_end(void) {
 }
 
 inline void TFT_eSPI::spi_begin_read(void) {
+#if defined(ESP32_DMA)
+    if (spiBusyCheck) dmaWait();
+#endif
 #if defined(SPI_HAS_TRANSACTION) && defined(SUPPORT_TRANSACTIONS) && \
     !defined(ESP32_PARALLEL)
     if (locked) {
@@ -5554,6 +5574,304 @@ SPIClass &TFT_eSPI::getSPIinstance(void) {
 }
 #endif
 
+#if defined(ESP32_DMA)
+// The spi_master driver shares the SPI peripheral with the register level
+// writes: save the registers they rely on and restore them after DMA
+static const uint32_t dmaRegAddr[6] = {
+    SPI_USER_REG(SPI_PORT),  SPI_USER1_REG(SPI_PORT), SPI_CTRL_REG(SPI_PORT),
+    SPI_CTRL2_REG(SPI_PORT), SPI_CLOCK_REG(SPI_PORT), SPI_PIN_REG(SPI_PORT)};
+
+/***************************************************************************************
+** Function name:           initDMA
+** Description:             Attach the spi_master DMA driver to the TFT SPI port
+***************************************************************************************/
+bool TFT_eSPI::initDMA(void) {
+    if (DMA_Enabled) return true;
+
+    dmaBandLen = DMA_BAND_LINES * max(_init_width, _init_height);
+    dmaBand[0] = (uint16_t *)heap_caps_malloc(dmaBandLen * 2, MALLOC_CAP_DMA);
+    dmaBand[1] = (uint16_t *)heap_caps_malloc(dmaBandLen * 2, MALLOC_CAP_DMA);
+    if (!dmaBand[0] || !dmaBand[1]) {
+        deInitDMA();
+        return false;
+    }
+
+    // Pins are left as routed by the SPI class (-1), so they are not
+    // detached from the display when the bus is freed
+    spi_bus_config_t buscfg;
+    memset(&buscfg, 0, sizeof(buscfg));
+    buscfg.mosi_io_num     = -1;
+    buscfg.miso_io_num     = -1;
+    buscfg.sclk_io_num     = -1;
+    buscfg.quadwp_io_num   = -1;
+    buscfg.quadhd_io_num   = -1;
+    buscfg.max_transfer_sz = TFT_WIDTH * TFT_HEIGHT * 2 + 8;
+
+    // CS is driven by spi_begin() / spi_end() as for the other writes
+    spi_device_interface_config_t devcfg;
+    memset(&devcfg, 0, sizeof(devcfg));
+    devcfg.mode           = TFT_SPI_MODE;
+    devcfg.clock_speed_hz = SPI_FREQUENCY;
+    devcfg.spics_io_num   = -1;
+    devcfg.flags          = SPI_DEVICE_NO_DUMMY;
+    devcfg.queue_size     = 2;
+
+    spi_begin();
+    for (int i = 0; i < 6; i++) dmaRegs[i] = READ_PERI_REG(dmaRegAddr[i]);
+    bool ok = spi_bus_initialize(DMA_SPI_HOST, &buscfg, TFT_DMA_CHANNEL) ==
+              ESP_OK;
+    if (ok && spi_bus_add_device(DMA_SPI_HOST, &devcfg, &dmaHAL) != ESP_OK) {
+        spi_bus_free(DMA_SPI_HOST);
+        ok = false;
+    }
+    for (int i = 0; i < 6; i++) WRITE_PERI_REG(dmaRegAddr[i], dmaRegs[i]);
+    spi_end();
+
+    if (!ok) {
+        dmaHAL = nullptr;
+        deInitDMA();
+        return false;
+    }
+    dmaSlot      = 0;
+    spiBusyCheck = 0;
+    DMA_Enabled  = true;
+    return true;
+}
+
+/***************************************************************************************
+** Function name:           deInitDMA
+** Description:             Release the DMA driver and the band buffers
+***************************************************************************************/
+void TFT_eSPI::deInitDMA(void) {
+    if (DMA_Enabled) {
+        dmaWait();
+        spi_bus_remove_device(dmaHAL);
+        spi_bus_free(DMA_SPI_HOST);
+        dmaHAL      = nullptr;
+        DMA_Enabled = false;
+    }
+    for (int i = 0; i < 2; i++) {
+        if (dmaBand[i]) heap_caps_free(dmaBand[i]);
+        dmaBand[i] = nullptr;
+    }
+}
+
+/***************************************************************************************
+** Function name:           dmaBusy
+** Description:             Check if a DMA transfer is still running
+***************************************************************************************/
+bool TFT_eSPI::dmaBusy(void) {
+    if (!DMA_Enabled || !spiBusyCheck) return false;
+
+    // Collect the finished transactions without blocking
+    spi_transaction_t *rtrans;
+    while (spiBusyCheck &&
+           spi_device_get_trans_result(dmaHAL, &rtrans, 0) == ESP_OK)
+        dmaDone();
+    return spiBusyCheck != 0;
+}
+
+/***************************************************************************************
+** Function name:           dmaWait
+** Description:             Wait for the queued DMA transfers to finish
+***************************************************************************************/
+void TFT_eSPI::dmaWait(void) {
+    if (!DMA_Enabled || !spiBusyCheck) return;
+
+    while (spiBusyCheck) dmaWaitOne();
+}
+
+/***************************************************************************************
+** Function name:           dmaWaitOne
+** Description:             Wait for the oldest queued DMA transfer
+***************************************************************************************/
+void TFT_eSPI::dmaWaitOne(void) {
+    spi_transaction_t *rtrans;
+    spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY);
+    dmaDone();
+}
+
+/***************************************************************************************
+** Function name:           dmaDone
+** Description:             Count a finished DMA transfer, give the registers
+*back to the register level writes after the last one
+***************************************************************************************/
+void TFT_eSPI::dmaDone(void) {
+    if (--spiBusyCheck == 0) {
+        for (int i = 0; i < 6; i++) WRITE_PERI_REG(dmaRegAddr[i], dmaRegs[i]);
+    }
+}
+
+/***************************************************************************************
+** Function name:           dmaQueue
+** Description:             Queue len pixels for a DMA transfer, the data must
+*stay valid until the transfer has finished
+***************************************************************************************/
+void TFT_eSPI::dmaQueue(const uint16_t *data, uint32_t len) {
+    if (spiBusyCheck == 0) {
+        for (int i = 0; i < 6; i++) dmaRegs[i] = READ_PERI_REG(dmaRegAddr[i]);
+    } else if (spiBusyCheck == 2) {
+        dmaWaitOne();  // Frees dmaTrans[dmaSlot] and dmaBand[dmaSlot]
+    }
+
+    spi_transaction_t *trans = &dmaTrans[dmaSlot];
+    memset(trans, 0, sizeof(spi_transaction_t));
+    trans->tx_buffer = data;
+    trans->length    = len * 16;
+    spi_device_queue_trans(dmaHAL, trans, portMAX_DELAY);
+    spiBusyCheck++;
+    dmaSlot ^= 1;
+}
+
+/***************************************************************************************
+** Function name:           pushPixelsDMA
+** Description:             Push pixels to the window set by setAddrWindow()
+***************************************************************************************/
+void TFT_eSPI::pushPixelsDMA(uint16_t *image, uint32_t len) {
+    if (!DMA_Enabled) {
+        pushColors(image, len, _swapBytes);
+        return;
+    }
+    if (len == 0) return;
+
+    bool endTransaction = !inTransaction;
+    if (endTransaction) startWrite();
+
+    if (!_swapBytes && esp_ptr_dma_capable(image)) {
+        dmaQueue(image, len);
+    } else {
+        while (len) {
+            uint32_t n = min(len, dmaBandLen);
+            if (spiBusyCheck == 2) dmaWaitOne();
+            uint16_t *band = dmaBand[dmaSlot];
+            if (_swapBytes) {
+                for (uint32_t i = 0; i < n; i++)
+                    band[i] = image[i] << 8 | image[i] >> 8;
+            } else {
+                memcpy(band, image, n << 1);
+            }
+            dmaQueue(band, n);
+            image += n;
+            len -= n;
+        }
+    }
+
+    if (endTransaction) endWrite();
+}
+
+/***************************************************************************************
+** Function name:           pushImageDMA
+** Description:             plot 16 bit colour sprite or image onto TFT using
+*DMA
+***************************************************************************************/
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h,
+                            uint16_t *image, uint16_t *buffer) {
+    if (!DMA_Enabled) {
+        pushImage(x, y, w, h, image);
+        return;
+    }
+    if ((x >= _width) || (y >= _height)) return;
+
+    int32_t dx = 0;
+    int32_t dy = 0;
+    int32_t dw = w;
+    int32_t dh = h;
+
+    if (x < 0) {
+        dw += x;
+        dx = -x;
+        x  = 0;
+    }
+    if (y < 0) {
+        dh += y;
+        dy = -y;
+        y  = 0;
+    }
+
+    if ((x + dw) > _width) dw = _width - x;
+    if ((y + dh) > _height) dh = _height - y;
+
+    if (dw < 1 || dh < 1) return;
+
+    image += dx + dy * w;
+
+    bool endTransaction = !inTransaction;
+    if (endTransaction) startWrite();
+
+    if (buffer) {
+        // Copy into the user buffer, the image is free as soon as we return
+        for (int32_t yb = 0; yb < dh; yb++) {
+            uint16_t *src = image + yb * w;
+            uint16_t *dst = buffer + yb * dw;
+            if (_swapBytes) {
+                for (int32_t xb = 0; xb < dw; xb++)
+                    dst[xb] = src[xb] << 8 | src[xb] >> 8;
+            } else {
+                memcpy(dst, src, dw << 1);
+            }
+        }
+        dmaWait();
+        setWindow(x, y, x + dw - 1, y + dh - 1);
+        dmaQueue(buffer, dw * dh);
+    } else if (dw == w && !_swapBytes && esp_ptr_dma_capable(image)) {
+        // Sent in place
+        dmaWait();
+        setWindow(x, y, x + dw - 1, y + dh - 1);
+        dmaQueue(image, dw * dh);
+    } else {
+        // Fill a band while the other one is sent
+        dmaWait();
+        setWindow(x, y, x + dw - 1, y + dh - 1);
+        int32_t lines = dmaBandLen / dw;
+        while (dh > 0) {
+            int32_t n = min(lines, dh);
+            if (spiBusyCheck == 2) dmaWaitOne();
+            uint16_t *band = dmaBand[dmaSlot];
+            for (int32_t yb = 0; yb < n; yb++) {
+                uint16_t *src = image + yb * w;
+                uint16_t *dst = band + yb * dw;
+                if (_swapBytes) {
+                    for (int32_t xb = 0; xb < dw; xb++)
+                        dst[xb] = src[xb] << 8 | src[xb] >> 8;
+                } else {
+                    memcpy(dst, src, dw << 1);
+                }
+            }
+            dmaQueue(band, n * dw);
+            image += n * w;
+            dh -= n;
+        }
+    }
+
+    if (endTransaction) endWrite();
+}
+
+#else  // No DMA, plain blocking writes
+
+bool TFT_eSPI::initDMA(void) {
+    return false;
+}
+
+void TFT_eSPI::deInitDMA(void) {
+}
+
+bool TFT_eSPI::dmaBusy(void) {
+    return false;
+}
+
+void TFT_eSPI::dmaWait(void) {
+}
+
+void TFT_eSPI::pushPixelsDMA(uint16_t *image, uint32_t len) {
+    pushColors(image, len, _swapBytes);
+}
+
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h,
+                            uint16_t *image, uint16_t *buffer) {
+    pushImage(x, y, w, h, image);
+}
+#endif
+
 /***************************************************************************************
 ** Function name:           getSetup
 ** Description:             Get the setup details for diagnostic and sketch
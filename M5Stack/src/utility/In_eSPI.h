@@ -114,6 +114,25 @@
 #endif
 #endif
 
+// DMA pixel transfers are only available for ESP32 SPI displays with 16 bit
+// colours
+#if defined(ESP32) && !defined(ESP32_PARALLEL) && \
+    !defined(ILI9488_DRIVER) && !defined(RPI_ILI9486_DRIVER)
+#define ESP32_DMA
+#include "driver/spi_master.h"
+
+// DMA channel used for the TFT SPI port
+#ifndef TFT_DMA_CHANNEL
+#define TFT_DMA_CHANNEL 1
+#endif
+
+// Number of display lines in each of the two DMA band buffers, these are
+// allocated in internal RAM by initDMA() (2 x 16 x 320 x 2 = 20 kbytes)
+#ifndef DMA_BAND_LINES
+#define DMA_BAND_LINES 16
+#endif
+#endif
+
 #ifdef SMOOTH_FONT
 // Call up the SPIFFS FLASH filing system for the anti-aliased fonts
 #define FS_NO_GLOBALS
@@ -919,6 +938,25 @@ class TFT_eSPI : public Print {
         uint32_t len);    // Write colours without transaction overhead
     void endWrite(void);  // End SPI transaction
 
+    // DMA transfers (ESP32 SPI only, plain blocking writes elsewhere). Call
+    // initDMA() once after init(). pushImageDMA() returns as soon as the last
+    // band is queued when called between startWrite() and endWrite(), so the
+    // next frame can be drawn while the previous one is sent. Images in
+    // internal RAM that don't need byte swapping or clipping are sent in
+    // place: don't modify them before dmaWait(). Other images are converted
+    // into two internal band buffers, one is filled while the other is sent.
+    bool initDMA(void);
+    void deInitDMA(void);
+    bool dmaEnabled(void) { return DMA_Enabled; }
+    bool dmaBusy(void);  // A DMA transfer is running
+    void dmaWait(void);  // Wait for the queued DMA transfers to finish
+    // Push pixels into the window set by setAddrWindow()
+    void pushPixelsDMA(uint16_t *image, uint32_t len);
+    // buffer (optional, at least w * h pixels in internal RAM) receives a copy
+    // of the image so it can be modified as soon as the function returns
+    void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h,
+                      uint16_t *image, uint16_t *buffer = nullptr);
+
     uint16_t decodeUTF8(uint8_t *buf, uint16_t *index, uint16_t remaining);
     uint16_t decodeUTF8(uint8_t c);
     size_t write(uint8_t);
@@ -983,6 +1021,21 @@ class TFT_eSPI : public Print {
 
     getColorCallback getColor = nullptr;
 
+#if defined(ESP32_DMA)
+    void dmaQueue(const uint16_t *data, uint32_t len);
+    void dmaWaitOne(void);
+    void dmaDone(void);
+
+    spi_device_handle_t dmaHAL = nullptr;
+    spi_transaction_t dmaTrans[2];       // Queued transactions, used in turn
+    uint16_t *dmaBand[2] = {nullptr, nullptr};  // Double buffered line bands
+    uint32_t dmaBandLen  = 0;            // Pixels in each band buffer
+    uint32_t dmaRegs[6];                 // SPI registers used by the writes
+    uint8_t dmaSlot      = 0;            // Next dmaTrans[] and dmaBand[]
+    uint8_t spiBusyCheck = 0;            // Number of queued DMA transactions
+#endif
+    bool DMA_Enabled = false;
+
    protected:
     int32_t win_xe, win_ye;
 
@@ -459,7 +459,12 @@ void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
     if (_bpp == 16) {
         bool oldSwapBytes = _tft->getSwapBytes();
         _tft->setSwapBytes(false);
-        _tft->pushImage(x, y, _iwidth, _iheight, _img);
+        // With DMA the sprite is sent through the double buffered bands (or
+        // in place from internal RAM), see TFT_eSPI::pushImageDMA()
+        if (_tft->dmaEnabled())
+            _tft->pushImageDMA(x, y, _iwidth, _iheight, _img);
+        else
+            _tft->pushImage(x, y, _iwidth, _iheight, _img);
         _tft->setSwapBytes(oldSwapBytes);
     }
 
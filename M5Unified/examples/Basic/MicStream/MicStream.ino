@@ -0,0 +1,49 @@
+#include <M5Unified.h>
+
+static constexpr const size_t block_length = 256;
+static constexpr const size_t block_count = 16;
+static constexpr const size_t record_samplerate = 16000;
+static int16_t block[block_length];
+
+void setup(void)
+{
+  auto cfg = M5.config();
+  M5.begin(cfg);
+
+  M5.Display.setTextSize(2);
+
+  /// Since the microphone and speaker cannot be used at the same time, turn off the speaker here.
+  M5.Speaker.end();
+
+  M5.Mic.setSampleRate(record_samplerate);
+  /// Samples are captured continuously into a ring of block_count blocks;
+  /// they are kept until read() takes them out, so nothing is lost as long as loop() keeps up.
+  if (!M5.Mic.beginStream(block_length, block_count))
+  {
+    M5.Display.print("stream failed");
+  }
+}
+
+void loop(void)
+{
+  M5.update();
+
+  if (!M5.Mic.isStreaming()) { return; }
+
+  /// Waits until a whole block has arrived.
+  if (M5.Mic.read(block, block_length, 100) != block_length) { return; }
+
+  int32_t peak = 0;
+  for (size_t i = 0; i < block_length; ++i)
+  {
+    int32_t v = abs(block[i]);
+    if (peak < v) { peak = v; }
+  }
+
+  int32_t w = M5.Display.width() * peak / INT16_MAX;
+  int32_t h = M5.Display.height() >> 2;
+  M5.Display.fillRect(0, h, w, h, TFT_GREEN);
+  M5.Display.fillRect(w, h, M5.Display.width() - w, h, TFT_BLACK);
+  M5.Display.setCursor(0, 0);
+  M5.Display.printf("overrun:%lu  ", (unsigned long)M5.Mic.getOverrunCount());
+}
@@ -1565,6 +1565,7 @@ for (int i = 0; i < 0x50; ++i)
     if (use_rawstate_bits) {
       for (int i = 0; i < 5; ++i) {
         if (use_rawstate_bits & (1 << i)) {
+          if (!(btn_rawstate_bits & (1 << i)) && !_buttons[i].isUpdateRequired()) { continue; }
           _buttons[i].setRawState(ms, btn_rawstate_bits & (1 << i));
         }
       }
@@ -1589,6 +1590,143 @@ for (int i = 0; i < 0x50; ++i)
 #endif
   }
 
+  bool M5Unified::setUpdateByInterrupt(bool enable)
+  {
+    bool res = false;
+    if (!enable)
+    {
+      Touch.disableInterrupt();
+      for (auto& btn : _buttons) { btn.detachInterrupt(); }
+      return res;
+    }
+
+    if (Touch.isEnabled())
+    {
+      res = Touch.enableInterrupt();
+    }
+
+    // GPIO of BtnA / BtnB / BtnC / BtnEXT / BtnPWR, all of them active low.
+    int8_t pins[5] = { -1, -1, -1, -1, -1 };
+#if defined (M5UNIFIED_PC_BUILD)
+#elif !defined (CONFIG_IDF_TARGET) || defined (CONFIG_IDF_TARGET_ESP32)
+    switch (_board)
+    {
+    case board_t::board_M5StackCoreInk:
+      pins[3] = CoreInk_BUTTON_EXT_PIN;
+      pins[4] = CoreInk_BUTTON_PWR_PIN;
+      NON_BREAK; /// don't break;
+
+    case board_t::board_M5Paper:
+    case board_t::board_M5Station:
+      pins[0] = GPIO_NUM_37;
+      pins[1] = GPIO_NUM_38;
+      pins[2] = GPIO_NUM_39;
+      break;
+
+    case board_t::board_M5Stack:
+      pins[1] = GPIO_NUM_38;
+      pins[2] = GPIO_NUM_37;
+      NON_BREAK; /// don't break;
+
+    case board_t::board_M5AtomLite:
+    case board_t::board_M5AtomMatrix:
+    case board_t::board_M5AtomEcho:
+    case board_t::board_M5AtomPsram:
+    case board_t::board_M5AtomU:
+    case board_t::board_M5StampPico:
+      pins[0] = GPIO_NUM_39;
+      break;
+
+    case board_t::board_M5StickCPlus2:
+      pins[4] = GPIO_NUM_35;
+      NON_BREAK; /// don't break;
+
+    case board_t::board_M5StickC:
+    case board_t::board_M5StickCPlus:
+      pins[0] = GPIO_NUM_37;
+      pins[1] = GPIO_NUM_39;
+      break;
+
+    default:
+      break;
+    }
+
+#elif defined (CONFIG_IDF_TARGET_ESP32S3)
+
+    switch (_board)
+    {
+    case board_t::board_M5AirQ:
+      pins[0] = GPIO_NUM_0;
+      pins[1] = GPIO_NUM_8;
+      break;
+
+    case board_t::board_M5VAMeter:
+      pins[0] = GPIO_NUM_2;
+      pins[1] = GPIO_NUM_0;
+      break;
+
+    case board_t::board_M5StampS3:
+    case board_t::board_M5Cardputer:
+      pins[0] = GPIO_NUM_0;
+      break;
+
+    case board_t::board_M5AtomS3:
+    case board_t::board_M5AtomS3Lite:
+    case board_t::board_M5AtomS3U:
+    case board_t::board_M5AtomS3R:
+      pins[0] = GPIO_NUM_41;
+      break;
+
+    case board_t::board_M5Capsule:
+    case board_t::board_M5Dial:
+    case board_t::board_M5DinMeter:
+      pins[0] = GPIO_NUM_42;
+      break;
+
+    default:
+      break;
+    }
+
+#elif defined (CONFIG_IDF_TARGET_ESP32C3)
+
+    switch (_board)
+    {
+    case board_t::board_M5StampC3:
+      pins[0] = GPIO_NUM_3;
+      break;
+
+    case board_t::board_M5StampC3U:
+      pins[0] = GPIO_NUM_9;
+      break;
+
+    default:
+      break;
+    }
+
+#elif defined (CONFIG_IDF_TARGET_ESP32C6)
+
+    switch (_board)
+    {
+    case board_t::board_M5NanoC6:
+      pins[0] = GPIO_NUM_9;
+      break;
+
+    default:
+      break;
+    }
+
+#endif
+
+    for (int i = 0; i < 5; ++i)
+    {
+      if (pins[i] >= 0 && _buttons[i].attachInterrupt(pins[i], true))
+      {
+        res = true;
+      }
+    }
+    return res;
+  }
+
   M5GFX& M5Unified::getDisplay(size_t index)
   {
     return index != _primary_display_index && index < this->_displays.size() ? this->_displays[index] : Display;
@@ -301,6 +301,12 @@ namespace m5
     /// To call this function in a loop function.
     virtual void update(void);
 
+    /// Use GPIO interrupts for the touch panel INT pin and the GPIO buttons where available.
+    /// update() then skips reading the touch controller and processing idle buttons until something happens,
+    /// and a button press shorter than the update interval is not lost.
+    /// @return true=at least one interrupt is in use.
+    bool setUpdateByInterrupt(bool enable);
+
     /// Perform initialization process at startup.
     void begin(void)
     {
@@ -3,8 +3,63 @@
 
 #include "Button_Class.hpp"
 
+#if defined ( ESP_PLATFORM )
+#include <driver/gpio.h>
+#include <esp_timer.h>
+#endif
+
 namespace m5
 {
+  void Button_Class::_isr(void* arg)
+  {
+#if defined ( ESP_PLATFORM )
+    auto self = static_cast<Button_Class*>(arg);
+    std::uint32_t msec = esp_timer_get_time() / 1000;
+    bool press = gpio_get_level((gpio_num_t)self->_isrPin) != self->_isrActiveLow;
+    // Accept a press only when the line was stable before this edge, so that the bounce of a release is ignored.
+    if (press && (msec - self->_isrLastEdge) >= self->_msecDebounce)
+    {
+      self->_isrPressed = true;
+    }
+    self->_isrLastEdge = msec;
+#else
+    (void)arg;
+#endif
+  }
+
+  bool Button_Class::attachInterrupt(int gpio_num, bool active_low)
+  {
+#if defined ( ESP_PLATFORM )
+    if (_isrPin >= 0) { detachInterrupt(); }
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) { return false; }
+
+    auto err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) { return false; } // INVALID_STATE: already installed.
+    _isrActiveLow = active_low;
+    _isrPressed = false;
+    gpio_set_intr_type((gpio_num_t)gpio_num, GPIO_INTR_ANYEDGE);
+    if (ESP_OK != gpio_isr_handler_add((gpio_num_t)gpio_num, _isr, this)) { return false; }
+    _isrPin = gpio_num;
+    gpio_intr_enable((gpio_num_t)gpio_num);
+    return true;
+#else
+    (void)gpio_num;
+    (void)active_low;
+    return false;
+#endif
+  }
+
+  void Button_Class::detachInterrupt(void)
+  {
+    if (_isrPin < 0) { return; }
+#if defined ( ESP_PLATFORM )
+    gpio_intr_disable((gpio_num_t)_isrPin);
+    gpio_isr_handler_remove((gpio_num_t)_isrPin);
+#endif
+    _isrPin = -1;
+    _isrPressed = false;
+  }
+
   void Button_Class::setState(std::uint32_t msec, button_state_t state)
   {
     if (_currentState == state_decide_click_count)
@@ -40,6 +95,12 @@ namespace m5
 
   void Button_Class::setRawState(std::uint32_t msec, bool press)
   {
+    if (_isrPressed)
+    { // A press caught by the interrupt, which may have been released before this update.
+      _isrPressed = false;
+      if (!_press) { press = true; }
+    }
+
     button_state_t state = button_state_t::state_nochange;
     bool disable_db = (msec - _lastMsec) > _msecDebounce;
     auto oldPress = _press;
@@ -66,7 +66,29 @@ namespace m5
     std::uint32_t getHoldThresh(void) const { return _msecHold; }
 
     std::uint32_t getUpdateMsec(void) const { return _lastMsec; }
+
+    /// Catch the button edges with a GPIO interrupt.
+    /// A press shorter than the update interval is not lost, and isUpdateRequired() tells when updating can be skipped.
+    /// @param gpio_num GPIO of the button.
+    /// @param active_low true=the GPIO goes low while pressed.
+    /// @return true=success / false=failure or not supported.
+    bool attachInterrupt(int gpio_num, bool active_low = true);
+
+    /// Stop using the GPIO interrupt.
+    void detachInterrupt(void);
+
+    /// Get whether the GPIO interrupt is used.
+    bool isInterruptAttached(void) const { return _isrPin >= 0; }
+
+    /// Returns false while the button is idle and nothing has been caught by the interrupt.
+    /// @attention Always true when the GPIO interrupt is not used.
+    bool isUpdateRequired(void) const
+    {
+      return _isrPin < 0 || _isrPressed || _raw_press || _press || _oldPress || _clickCount || _currentState != state_nochange;
+    }
+
   private:
+    static void _isr(void* arg);
     std::uint32_t _lastMsec = 0;
     std::uint32_t _lastChange = 0;
     std::uint32_t _lastRawChange = 0;
@@ -79,6 +101,10 @@ namespace m5
     std::uint8_t _press = 0;     // 0:release  1:click  2:holding
     std::uint8_t _oldPress = 0;
     std::uint8_t _clickCount = 0;
+    std::int8_t _isrPin = -1;
+    bool _isrActiveLow = true;
+    volatile bool _isrPressed = false;
+    volatile std::uint32_t _isrLastEdge = 0;
   };
 
 }
@@ -5,6 +5,12 @@
 
 #include <M5GFX.h>
 
+#if defined ( ESP_PLATFORM )
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#endif
+
 namespace m5
 {
   I2C_Class In_I2C;
@@ -113,13 +119,128 @@ namespace m5
 
   bool I2C_Device::writeRegister8Array(const std::uint8_t* reg_data_array, std::size_t length) const
   {
-    for (size_t i = 0; i < length; i+=2)
+    if (length < 2) { return true; }
+    bool res = _i2c->start(_addr, false, _freq);
+    for (size_t i = 0; res && i + 1 < length; i += 2)
+    {
+      res = (i == 0 || _i2c->restart(_addr, false, _freq))
+         && _i2c->write(&reg_data_array[i], 2);
+    }
+    bool last = _i2c->stop();
+    return res && last;
+  }
+
+  bool I2C_Transaction::add(op_type_t type, std::uint8_t address, std::uint8_t reg, std::uint8_t* data, std::size_t length, std::uint8_t value, std::uint32_t freq)
+  {
+    if (_busy || _count >= MAX_OPERATIONS || length == 0 || length > UINT16_MAX) { return false; }
+    auto op = &_ops[_count++];
+    op->data = data;
+    op->freq = freq;
+    op->length = length;
+    op->type = type;
+    op->address = address;
+    op->reg = reg;
+    op->value = value;
+    return true;
+  }
+
+  bool I2C_Transaction::execute(void)
+  {
+    _error_index = -1;
+    if (_count == 0) { return true; }
+
+    bool res = true;
+    for (size_t i = 0; i < _count; ++i)
     {
-      if (!_i2c->writeRegister8(_addr, reg_data_array[i], reg_data_array[i+1], _freq))
+      auto op = &_ops[i];
+      res = (i == 0 ? _i2c->start(op->address, false, op->freq)
+                    : _i2c->restart(op->address, false, op->freq));
+      switch (op->type)
       {
-        return false;
+      case op_write:
+        res = res
+           && _i2c->write(op->reg)
+           && _i2c->write(op->data ? op->data : &op->value, op->length);
+        break;
+
+      case op_read:
+        res = res
+           && _i2c->write(op->reg)
+           && _i2c->restart(op->address, true, op->freq)
+           && _i2c->read(op->data, op->length, true);
+        break;
+
+      default: // op_bit_on, op_bit_off
+        {
+          std::uint8_t buf[2] = { op->reg, 0 };
+          res = res
+             && _i2c->write(op->reg)
+             && _i2c->restart(op->address, true, op->freq)
+             && _i2c->read(&buf[1], 1, true);
+          if (res)
+          {
+            buf[1] = (op->type == op_bit_on) ? (buf[1] | op->value) : (buf[1] & ~op->value);
+            res = _i2c->restart(op->address, false, op->freq)
+               && _i2c->write(buf, 2);
+          }
+        }
+        break;
+      }
+      if (!res)
+      {
+        _error_index = i;
+        break;
       }
     }
+    bool last = _i2c->stop();
+    return res && last;
+  }
+
+#if defined ( ESP_PLATFORM )
+  static QueueHandle_t i2c_async_queue = nullptr;
+
+  void I2C_Transaction::async_task(void*)
+  {
+    I2C_Transaction* transaction;
+    for (;;)
+    {
+      if (pdTRUE != xQueueReceive(i2c_async_queue, &transaction, portMAX_DELAY)) { continue; }
+      bool res = transaction->execute();
+      auto callback = transaction->_callback;
+      auto args = transaction->_callback_args;
+      transaction->_busy = false;
+      if (callback) { callback(transaction, res, args); }
+    }
+  }
+#else
+  void I2C_Transaction::async_task(void*) {}
+#endif
+
+  bool I2C_Transaction::executeAsync(callback_t callback, void* args)
+  {
+    if (_busy) { return false; }
+#if defined ( ESP_PLATFORM )
+    if (i2c_async_queue == nullptr)
+    {
+      auto queue = xQueueCreate(8, sizeof(I2C_Transaction*));
+      if (queue == nullptr) { return false; }
+      i2c_async_queue = queue;
+      xTaskCreate(async_task, "i2c_async", 3072, nullptr, 2, nullptr);
+    }
+    _callback = callback;
+    _callback_args = args;
+    _busy = true;
+    auto self = this;
+    if (pdTRUE != xQueueSend(i2c_async_queue, &self, 0))
+    {
+      _busy = false;
+      return false;
+    }
+    return true;
+#else
+    bool res = execute();
+    if (callback) { callback(this, res, args); }
     return true;
+#endif
   }
 }
@@ -165,6 +165,10 @@ namespace m5
 
     std::uint8_t getAddress(void) const { return _addr; }
 
+    std::uint32_t getClock(void) const { return _freq; }
+
+    I2C_Class* getPort(void) const { return _i2c; }
+
     bool writeRegister8(std::uint8_t reg, std::uint8_t data) const
     {
       return _i2c->writeRegister8(_addr, reg, data, _freq);
@@ -175,6 +179,9 @@ namespace m5
       return _i2c->readRegister8(_addr, reg, _freq);
     }
 
+    /// Write pairs of register and value in one transaction. (separated by repeated START)
+    /// @param reg_data_array { reg, value, reg, value, ... }
+    /// @param length array length.
     bool writeRegister8Array(const std::uint8_t* reg_data_array, std::size_t length) const;
 
     bool writeRegister(std::uint8_t reg, const std::uint8_t* data, std::size_t length) const
@@ -206,6 +213,99 @@ namespace m5
     bool _init;
   };
 
+  /// A list of register operations executed in one bus transaction.
+  /// The bus is acquired once, each operation begins with a repeated START, and a single STOP ends the list.
+  /// The operations may address different devices on the same bus.
+  class I2C_Transaction
+  {
+  public:
+    static constexpr std::size_t MAX_OPERATIONS = 16;
+
+    /// @param transaction the executed transaction.
+    /// @param success true=all operations succeeded.
+    /// @param args the pointer given to executeAsync.
+    typedef void (*callback_t)(I2C_Transaction* transaction, bool success, void* args);
+
+    I2C_Transaction(I2C_Class* i2c = &In_I2C) : _i2c { i2c } {}
+
+    void setPort(I2C_Class* i2c) { _i2c = i2c; }
+
+    /// Remove all recorded operations.
+    void clear(void) { _count = 0; _error_index = -1; }
+
+    /// Get the number of recorded operations.
+    std::size_t size(void) const { return _count; }
+
+    /// Record a 1-byte register write.
+    /// @return false=the list is full.
+    bool writeRegister8(std::uint8_t address, std::uint8_t reg, std::uint8_t data, std::uint32_t freq) { return add(op_write, address, reg, nullptr, 1, data, freq); }
+
+    /// Record a multiple bytes register write.
+    /// @attention data is not copied, keep it valid until the transaction is executed.
+    bool writeRegister(std::uint8_t address, std::uint8_t reg, const std::uint8_t* data, std::size_t length, std::uint32_t freq) { return add(op_write, address, reg, const_cast<std::uint8_t*>(data), length, 0, freq); }
+
+    /// Record a register read. result is filled when the transaction is executed.
+    bool readRegister(std::uint8_t address, std::uint8_t reg, std::uint8_t* result, std::size_t length, std::uint32_t freq) { return add(op_read, address, reg, result, length, 0, freq); }
+
+    /// Record a read-modify-write which sets the bits. (not interrupted by other tasks)
+    bool bitOn(std::uint8_t address, std::uint8_t reg, std::uint8_t data, std::uint32_t freq) { return add(op_bit_on, address, reg, nullptr, 1, data, freq); }
+
+    /// Record a read-modify-write which clears the bits. (not interrupted by other tasks)
+    bool bitOff(std::uint8_t address, std::uint8_t reg, std::uint8_t data, std::uint32_t freq) { return add(op_bit_off, address, reg, nullptr, 1, data, freq); }
+
+    bool writeRegister8(const I2C_Device& dev, std::uint8_t reg, std::uint8_t data) { return writeRegister8(dev.getAddress(), reg, data, dev.getClock()); }
+    bool writeRegister(const I2C_Device& dev, std::uint8_t reg, const std::uint8_t* data, std::size_t length) { return writeRegister(dev.getAddress(), reg, data, length, dev.getClock()); }
+    bool readRegister(const I2C_Device& dev, std::uint8_t reg, std::uint8_t* result, std::size_t length) { return readRegister(dev.getAddress(), reg, result, length, dev.getClock()); }
+    bool bitOn(const I2C_Device& dev, std::uint8_t reg, std::uint8_t data) { return bitOn(dev.getAddress(), reg, data, dev.getClock()); }
+    bool bitOff(const I2C_Device& dev, std::uint8_t reg, std::uint8_t data) { return bitOff(dev.getAddress(), reg, data, dev.getClock()); }
+
+    /// Execute the recorded operations. The list is kept and can be executed again.
+    /// @return true=all operations succeeded. / false=stopped at getErrorIndex().
+    bool execute(void);
+
+    /// Execute the recorded operations in a background task and call the callback when finished.
+    /// @return true=accepted. / false=still busy with the previous execution.
+    /// @attention Do not modify the list or the buffers until isBusy() returns false.
+    /// @attention Runs synchronously on platforms without FreeRTOS.
+    bool executeAsync(callback_t callback = nullptr, void* args = nullptr);
+
+    /// Get whether the asynchronous execution is in progress.
+    bool isBusy(void) const { return _busy; }
+
+    /// Get the index of the operation which failed in the last execution. -1=none.
+    int getErrorIndex(void) const { return _error_index; }
+
+  private:
+    enum op_type_t : std::uint8_t
+    { op_write
+    , op_read
+    , op_bit_on
+    , op_bit_off
+    };
+
+    struct operation_t
+    {
+      std::uint8_t* data;
+      std::uint32_t freq;
+      std::uint16_t length;
+      op_type_t type;
+      std::uint8_t address;
+      std::uint8_t reg;
+      std::uint8_t value;
+    };
+
+    bool add(op_type_t type, std::uint8_t address, std::uint8_t reg, std::uint8_t* data, std::size_t length, std::uint8_t value, std::uint32_t freq);
+    static void async_task(void* args);
+
+    operation_t _ops[MAX_OPERATIONS];
+    I2C_Class* _i2c;
+    callback_t _callback = nullptr;
+    void* _callback_args = nullptr;
+    std::uint8_t _count = 0;
+    std::int8_t _error_index = -1;
+    volatile bool _busy = false;
+  };
+
 }
 
 #endif
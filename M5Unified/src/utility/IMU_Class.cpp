@@ -6,6 +6,8 @@
 
 #include "m5unified_common.h"
 
+#include <math.h>
+
 #if defined(ESP_PLATFORM)
 
 #include <sdkconfig.h>
@@ -46,6 +48,7 @@ namespace m5
       else
       {
         _imu_instance[0].reset(mpu6886);
+        _has_sensor_mask = (sensor_mask_t)(_has_sensor_mask | res);
         switch (mpu6886->whoAmI())
         {
         case MPU6886_Class::DEV_ID_MPU6050:
@@ -74,9 +77,11 @@ namespace m5
     if (_imu == imu_t::imu_none)
     {
       auto bmi2 = new BMI270_Class();
-      if (!bmi2->begin(i2c)) {
+      auto res = bmi2->begin(i2c);
+      if (!res) {
         bmi2->setAddress(bmi2->getAddress() == 0x68 ? 0x69 : 0x68);
-        if (!bmi2->begin(i2c)) {
+        res = bmi2->begin(i2c);
+        if (!res) {
           delete bmi2;
           bmi2 = nullptr;
         }
@@ -84,6 +89,7 @@ namespace m5
       if (bmi2 != nullptr)
       {
         _imu_instance[0].reset(bmi2);
+        _has_sensor_mask = (sensor_mask_t)(_has_sensor_mask | res);
         _imu = imu_t::imu_bmi270;
 
 #if defined ( CONFIG_IDF_TARGET_ESP32S3 )
@@ -105,10 +111,12 @@ namespace m5
     if (_imu == imu_t::imu_none)
     {
       auto sh200q = new SH200Q_Class();
-      if (!sh200q->begin(i2c)) { delete sh200q; }
+      auto res = sh200q->begin(i2c);
+      if (!res) { delete sh200q; }
       else
       {
         _imu_instance[0].reset(sh200q);
+        _has_sensor_mask = (sensor_mask_t)(_has_sensor_mask | res);
         _imu = imu_t::imu_sh200q;
       }
     }
@@ -121,6 +129,7 @@ namespace m5
       else
       {
         _imu_instance[1].reset(bmm150);
+        _has_sensor_mask = (sensor_mask_t)(_has_sensor_mask | sensor_mask_mag);
         if (board == m5::board_t::board_M5Stack)
         { // M5Stack MPU6886 + BMM150構成では、地磁気のX軸とZ軸をそれぞれ反転する
           // M5Stack SH200Q + BMM150構成での動作は未確認。(過去に一時期製造されている)
@@ -137,6 +146,7 @@ namespace m5
       else
       {
         _imu_instance[1].reset(ak8963);
+        _has_sensor_mask = (sensor_mask_t)(_has_sensor_mask | sensor_mask_mag);
         if (_imu == imu_t::imu_mpu9250)
         { // MPU9250内蔵AK8963は地磁気のX軸とY軸を取り換え、Z軸の向きを反転する
           _internal_axisorder_fixed[sensor_index_mag ] = (internal_axisorder_t)(axis_order_yxz | axis_invert_z); // Y軸X軸を入替, Z軸反転
@@ -411,27 +421,216 @@ namespace m5
     }
     if (res)
     {
-      std::uint_fast8_t mask_flg = _calibration_flg & res;
-      // キャリブレーション処理
-      for (size_t i = 0; mask_flg && i < 3; ++i, mask_flg >>= 1)
+      _proc_calibration(res);
+      if (_fusion_enabled && (res & (sensor_mask_accel | sensor_mask_gyro)))
+      {
+        imu_data_t data;
+        getImuData(&data);
+        _update_fusion(data, (_latest_micros - _fusion_micros) * (1.0f / 1000000.0f));
+        _fusion_micros = _latest_micros;
+      }
+    }
+    return res;
+  }
+
+  void IMU_Class::_proc_calibration(sensor_mask_t mask)
+  {
+    std::uint_fast8_t mask_flg = _calibration_flg & mask;
+    // キャリブレーション処理
+    for (size_t i = 0; mask_flg && i < 3; ++i, mask_flg >>= 1)
+    {
+      // if ((mask_flg & 1) && (16 < _offset_data.sensor[i].updateStillness(_raw_data.sensor[i])))
+      if (mask_flg & 1)
       {
-        // if ((mask_flg & 1) && (16 < _offset_data.sensor[i].updateStillness(_raw_data.sensor[i])))
-        if (mask_flg & 1)
+        auto st = _offset_data.sensor[i].updateStillness(_raw_data.sensor[i]);
+        if (16 < st)
         {
-          auto st = _offset_data.sensor[i].updateStillness(_raw_data.sensor[i]);
-          if (16 < st)
-          {
-            _offset_data.sensor[i].calibration();
-// if (i == 1) { printf("Ok  %d\n" ,st); }
-          }
-//           else
-//           {
-// if (i == 1) { printf(" NG %d\n", st); }
-//           }
+          _offset_data.sensor[i].calibration();
         }
       }
     }
-    return res;
+  }
+
+  uint32_t IMU_Class::enableFifo(uint32_t odr_hz)
+  {
+    _fifo_odr = _imu_instance[0] ? _imu_instance[0]->enableFifo(odr_hz) : 0;
+    _fifo_micros = m5gfx::micros();
+    return _fifo_odr;
+  }
+
+  void IMU_Class::disableFifo(void)
+  {
+    if (_fifo_odr && _imu_instance[0]) { _imu_instance[0]->disableFifo(); }
+    _fifo_odr = 0;
+  }
+
+  size_t IMU_Class::readFifo(imu_data_t* data, size_t max_count)
+  {
+    if (_fifo_odr == 0) { return 0; }
+
+    // 地磁気はFIFOに入らないため、最新の値を使用する
+    if (_imu_instance[1])
+    {
+      if (_imu_instance[1]->getImuRawData(&_raw_data)) { _proc_calibration(sensor_mask_mag); }
+    }
+    else if (_has_sensor_mask & sensor_mask_mag)
+    {
+      auto tmp = _raw_data;
+      if (_imu_instance[0]->getImuRawData(&tmp) & IMU_Base::imu_spec_mag)
+      {
+        _raw_data.mag = tmp.mag;
+        _proc_calibration(sensor_mask_mag);
+      }
+    }
+
+    static constexpr size_t batch = 16;
+    IMU_Base::imu_raw_data_t raw[batch];
+    const float dt = 1.0f / _fifo_odr;
+    const uint32_t period = 1000000u / _fifo_odr;
+    uint32_t usec = _fifo_micros;
+    size_t count = 0;
+    bool drained = false;
+    while (count < max_count)
+    {
+      size_t len = max_count - count;
+      if (len > batch) { len = batch; }
+      size_t n = _imu_instance[0]->getImuRawDataFifo(raw, len);
+      for (size_t i = 0; i < n; ++i, ++count)
+      {
+        _raw_data.accel = raw[i].accel;
+        _raw_data.gyro = raw[i].gyro;
+        _proc_calibration((sensor_mask_t)(sensor_mask_accel | sensor_mask_gyro));
+        getImuData(&data[count]);
+        data[count].usec = (usec += period);
+        if (_fusion_enabled) { _update_fusion(data[count], dt); }
+      }
+      if (n < len) { drained = true; break; }
+    }
+    if (count == 0) { return 0; }
+
+    if (drained)
+    { // FIFOが空になったので、最後のサンプルを現在時刻とみなして時刻を合わせなおす
+      uint32_t now = m5gfx::micros();
+      uint32_t diff = now - usec;
+      for (size_t i = 0; i < count; ++i) { data[i].usec += diff; }
+      usec = now;
+    }
+    _fifo_micros = usec;
+    _latest_micros = usec;
+    _fusion_micros = usec;
+    return count;
+  }
+
+  void IMU_Class::enableFusion(float kp, float ki)
+  {
+    _fusion_kp = kp;
+    _fusion_ki = ki;
+    _fusion_reset = true;
+    _fusion_enabled = true;
+  }
+
+  void IMU_Class::_update_fusion(const imu_data_t& data, float dt)
+  {
+    auto q = _fusion_q;
+    float ax = data.accel.x, ay = data.accel.y, az = data.accel.z;
+    float norm = ax * ax + ay * ay + az * az;
+
+    if (_fusion_reset || dt <= 0.0f || dt > 0.5f)
+    { // 加速度から傾きを求めて初期姿勢とする (ヨー角は0)
+      if (norm == 0.0f) { return; }
+      float roll = atan2f(ay, az) * 0.5f;
+      float pitch = atan2f(-ax, sqrtf(ay * ay + az * az)) * 0.5f;
+      float cr = cosf(roll), sr = sinf(roll), cp = cosf(pitch), sp = sinf(pitch);
+      q[0] = cr * cp;
+      q[1] = sr * cp;
+      q[2] = cr * sp;
+      q[3] = -sr * sp;
+      _fusion_integral[0] = _fusion_integral[1] = _fusion_integral[2] = 0.0f;
+      _fusion_reset = false;
+      return;
+    }
+
+    static constexpr const float deg_to_rad = 3.14159265f / 180.0f;
+    float gx = data.gyro.x * deg_to_rad;
+    float gy = data.gyro.y * deg_to_rad;
+    float gz = data.gyro.z * deg_to_rad;
+    float q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+
+    if (norm > 0.0f)
+    {
+      norm = 1.0f / sqrtf(norm);
+      ax *= norm; ay *= norm; az *= norm;
+
+      // 推定した姿勢での重力の向き
+      float vx = q1 * q3 - q0 * q2;
+      float vy = q0 * q1 + q2 * q3;
+      float vz = q0 * q0 - 0.5f + q3 * q3;
+      float ex = ay * vz - az * vy;
+      float ey = az * vx - ax * vz;
+      float ez = ax * vy - ay * vx;
+
+      float mx = data.mag.x, my = data.mag.y, mz = data.mag.z;
+      float mnorm = mx * mx + my * my + mz * mz;
+      if (mnorm > 0.0f)
+      { // 推定した姿勢での地磁気の向き
+        mnorm = 1.0f / sqrtf(mnorm);
+        mx *= mnorm; my *= mnorm; mz *= mnorm;
+        float hx = 2.0f * (mx * (0.5f - q2 * q2 - q3 * q3) + my * (q1 * q2 - q0 * q3) + mz * (q1 * q3 + q0 * q2));
+        float hy = 2.0f * (mx * (q1 * q2 + q0 * q3) + my * (0.5f - q1 * q1 - q3 * q3) + mz * (q2 * q3 - q0 * q1));
+        float bx = sqrtf(hx * hx + hy * hy);
+        float bz = 2.0f * (mx * (q1 * q3 - q0 * q2) + my * (q2 * q3 + q0 * q1) + mz * (0.5f - q1 * q1 - q2 * q2));
+        float wx = bx * (0.5f - q2 * q2 - q3 * q3) + bz * (q1 * q3 - q0 * q2);
+        float wy = bx * (q1 * q2 - q0 * q3) + bz * (q0 * q1 + q2 * q3);
+        float wz = bx * (q0 * q2 + q1 * q3) + bz * (0.5f - q1 * q1 - q2 * q2);
+        ex += my * wz - mz * wy;
+        ey += mz * wx - mx * wz;
+        ez += mx * wy - my * wx;
+      }
+
+      if (_fusion_ki > 0.0f)
+      {
+        float k = 2.0f * _fusion_ki * dt;
+        _fusion_integral[0] += k * ex;
+        _fusion_integral[1] += k * ey;
+        _fusion_integral[2] += k * ez;
+        gx += _fusion_integral[0];
+        gy += _fusion_integral[1];
+        gz += _fusion_integral[2];
+      }
+      float kp = 2.0f * _fusion_kp;
+      gx += kp * ex;
+      gy += kp * ey;
+      gz += kp * ez;
+    }
+
+    // クォータニオンの積分
+    dt *= 0.5f;
+    gx *= dt; gy *= dt; gz *= dt;
+    q[0] = q0 + (-q1 * gx - q2 * gy - q3 * gz);
+    q[1] = q1 + ( q0 * gx + q2 * gz - q3 * gy);
+    q[2] = q2 + ( q0 * gy - q1 * gz + q3 * gx);
+    q[3] = q3 + ( q0 * gz + q1 * gy - q2 * gx);
+    norm = 1.0f / sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (int i = 0; i < 4; ++i) { q[i] *= norm; }
+  }
+
+  void IMU_Class::getQuaternion(float* w, float* x, float* y, float* z) const
+  {
+    *w = _fusion_q[0];
+    *x = _fusion_q[1];
+    *y = _fusion_q[2];
+    *z = _fusion_q[3];
+  }
+
+  void IMU_Class::getAhrsData(float *pitch, float *roll, float *yaw) const
+  {
+    static constexpr const float rad_to_deg = 180.0f / 3.14159265f;
+    auto q = _fusion_q;
+    float sinp = 2.0f * (q[0] * q[2] - q[1] * q[3]);
+    if (sinp > 1.0f) { sinp = 1.0f; } else if (sinp < -1.0f) { sinp = -1.0f; }
+    *pitch = asinf(sinp) * rad_to_deg;
+    *roll  = atan2f(q[0] * q[1] + q[2] * q[3], 0.5f - q[1] * q[1] - q[2] * q[2]) * rad_to_deg;
+    *yaw   = atan2f(q[1] * q[2] + q[0] * q[3], 0.5f - q[2] * q[2] - q[3] * q[3]) * rad_to_deg;
   }
 
   void IMU_Class::getImuData(imu_data_t* data)
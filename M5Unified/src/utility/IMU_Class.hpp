@@ -91,6 +91,16 @@ namespace m5
 
     const imu_data_t& getImuData(void) { getImuData(&_last_data); return _last_data; }
 
+    // 加速度とジャイロをセンサ内蔵FIFOに蓄積させる。戻り値は実際の出力データレート(Hz)、0=非対応
+    // 有効な間はupdateの代わりにreadFifoを使用する
+    uint32_t enableFifo(uint32_t odr_hz = 200);
+
+    void disableFifo(void);
+
+    // FIFOに蓄積されたサンプルを古い順に最大max_count個取り出し、変換済みの値として格納する。
+    // 各サンプルのusecは出力データレートから求めた時刻。地磁気は最新の値。戻り値は格納した数
+    size_t readFifo(imu_data_t* data, size_t max_count);
+
     // 軸の順序を指定する。デフォルトはX+,Y+,Z+
     bool setAxisOrder(axis_t axis0, axis_t axis1, axis_t axis2);
 
@@ -112,8 +122,20 @@ namespace m5
 
     imu_t getType(void) const { return _imu; }
 
-    // 実装予定
-    // void getAhrsData(float *pitch, float *roll, float *yaw);
+    // センサフュージョン(Mahonyフィルタ)を有効にする。update/readFifoで得た全サンプルで姿勢を更新する
+    // kp=加速度/地磁気による補正の強さ ki=ジャイロのドリフト補正の強さ
+    void enableFusion(float kp = 1.0f, float ki = 0.0f);
+
+    void disableFusion(void) { _fusion_enabled = false; }
+
+    // 姿勢を次のサンプルの加速度から初期化しなおす
+    void resetFusion(void) { _fusion_reset = true; }
+
+    // 姿勢をクォータニオンで得る
+    void getQuaternion(float* w, float* x, float* y, float* z) const;
+
+    // 姿勢をオイラー角(度)で得る
+    void getAhrsData(float *pitch, float *roll, float *yaw) const;
 
     // 廃止
     // void setRotation(uint_fast8_t rotation) { _rotation = rotation & 3; };
@@ -204,7 +226,8 @@ namespace m5
 
     void _update_convert_param(void);
     void _update_axis_order(void);
-    void _proc_calibration(void);
+    void _proc_calibration(sensor_mask_t mask);
+    void _update_fusion(const imu_data_t& data, float dt);
 
     // update成功時のマイクロ秒情報
     uint32_t _latest_micros;
@@ -227,6 +250,19 @@ namespace m5
     // 最後に動きがあった時のusec
     uint32_t _moving_micros;
 
+    // FIFOの出力データレート(0=FIFO無効)と、最後に取り出したサンプルのusec
+    uint32_t _fifo_odr = 0;
+    uint32_t _fifo_micros = 0;
+
+    // センサフュージョンの姿勢(クォータニオン)とジャイロ積分誤差
+    float _fusion_q[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+    float _fusion_integral[3] = { 0.0f, 0.0f, 0.0f };
+    float _fusion_kp = 1.0f;
+    float _fusion_ki = 0.0f;
+    uint32_t _fusion_micros = 0;
+    bool _fusion_enabled = false;
+    bool _fusion_reset = true;
+
     // ユーザ側で任意の軸割当を行うための設定項目
     uint8_t _assign_axis_x;
     uint8_t _assign_axis_y;
@@ -4,6 +4,8 @@
 #include "Log_Class.hpp"
 
 #include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
 
 #if defined ( M5UNIFIED_PC_BUILD )
 #include <iostream>
@@ -17,6 +19,16 @@ namespace m5
 {
   constexpr const char Log_Class::str_crlf[3];
 
+  struct log_record_t
+  {
+    uint16_t size;   // record size including this header, multiple of 4
+    uint8_t level;
+    uint8_t state;   // written last. 0 = free or being written
+  };
+  static constexpr const uint8_t record_ready = 1;
+  static constexpr const uint8_t record_ready_suffix = 2;
+  static constexpr const uint8_t record_padding = 3;
+
   const char* Log_Class::pathToFileName(const char* path)
   {
     size_t i = 0;
@@ -73,8 +85,22 @@ namespace m5
         str = tmp;
         len = vsnprintf(str, len+1, format, arg);
       }
+      else
+      {
+        len = sizeof(loc_buf) - 1;
+      }
+    }
+
+    if (_async)
+    {
+      push_record(level, suffix, str, len);
+      return;
     }
+    write_targets(level, suffix, str);
+  }
 
+  void Log_Class::write_targets(esp_log_level_t level, bool suffix, const char* str)
+  {
     if (_log_level[log_target_serial] >= level)
     {
       const char* suf = (suffix && _suffix[log_target_serial]) ? _suffix[log_target_serial] : "";
@@ -123,6 +149,166 @@ namespace m5
     }
   }
 
+  bool Log_Class::push_record(esp_log_level_t level, bool suffix, const char* str, size_t len)
+  {
+    const uint32_t ring_size = _ring_mask + 1;
+    const uint32_t need = (sizeof(log_record_t) + len + 1 + 3) & ~3u;
+    if (need > (ring_size >> 1) || need > UINT16_MAX)
+    {
+      _drop_count.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    uint32_t head = _ring_head.load(std::memory_order_relaxed);
+    uint32_t pos;
+    uint32_t total;
+    do
+    {
+      uint32_t tail = _ring_tail.load(std::memory_order_acquire);
+      pos = head & _ring_mask;
+      // records never wrap around; skip the rest of the buffer with a padding record instead.
+      total = (pos + need > ring_size) ? (ring_size - pos) + need : need;
+      if (head + total - tail > ring_size)
+      {
+        _drop_count.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    } while (!_ring_head.compare_exchange_weak(head, head + total, std::memory_order_acquire, std::memory_order_relaxed));
+
+    if (total != need)
+    {
+      auto pad = (log_record_t*)&_ring[pos];
+      pad->size = ring_size - pos;
+      __atomic_store_n(&pad->state, record_padding, __ATOMIC_RELEASE);
+      pos = 0;
+    }
+    auto rec = (log_record_t*)&_ring[pos];
+    memcpy(&rec[1], str, len);
+    rec->size = need;
+    rec->level = level;
+    __atomic_store_n(&rec->state, suffix ? record_ready_suffix : record_ready, __ATOMIC_RELEASE);
+
+#if defined ( ESP_PLATFORM )
+    if (_task_handle) { xTaskNotifyGive(_task_handle); }
+#endif
+    return true;
+  }
+
+  size_t Log_Class::drain(void)
+  {
+    size_t count = 0;
+    bool display_started = false;
+    uint32_t tail = _ring_tail.load(std::memory_order_relaxed);
+    uint32_t head = _ring_head.load(std::memory_order_acquire);
+    while (tail != head)
+    {
+      auto rec = (log_record_t*)&_ring[tail & _ring_mask];
+      auto state = __atomic_load_n(&rec->state, __ATOMIC_ACQUIRE);
+      if (state == 0) { break; } // the writer has not finished yet.
+
+      uint32_t size = rec->size;
+      if (state != record_padding)
+      {
+        if (_display && !display_started)
+        { // hold the display bus for the whole batch.
+          display_started = true;
+          _display->startWrite();
+        }
+        write_targets((esp_log_level_t)rec->level, state == record_ready_suffix, (const char*)&rec[1]);
+        ++count;
+      }
+      memset(rec, 0, size);
+      tail += size;
+      _ring_tail.store(tail, std::memory_order_release);
+      if (tail == head) { head = _ring_head.load(std::memory_order_acquire); }
+    }
+    if (display_started) { _display->endWrite(); }
+    return count;
+  }
+
+#if defined ( ESP_PLATFORM )
+  void Log_Class::log_task(void* args)
+  {
+    auto self = (Log_Class*)args;
+    while (self->_task_running)
+    {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      self->drain();
+    }
+    self->drain();
+    self->_task_handle = nullptr;
+    vTaskDelete(nullptr);
+  }
+#endif
+
+  bool Log_Class::beginAsync(size_t buffer_size, uint8_t task_priority, uint8_t task_pinned_core)
+  {
+#if defined ( ESP_PLATFORM )
+    if (_async) { return true; }
+
+    uint32_t ring_size = 64;
+    while (ring_size < buffer_size && ring_size < (1u << 16)) { ring_size <<= 1; }
+    _ring = (uint8_t*)calloc(ring_size, 1);
+    if (_ring == nullptr) { return false; }
+    _ring_mask = ring_size - 1;
+    _ring_head.store(0, std::memory_order_relaxed);
+    _ring_tail.store(0, std::memory_order_relaxed);
+
+    _task_running = true;
+    static constexpr const size_t stack_size = 4096;
+    if (task_pinned_core < portNUM_PROCESSORS)
+    {
+      xTaskCreatePinnedToCore(log_task, "log_task", stack_size, this, task_priority, &_task_handle, task_pinned_core);
+    }
+    else
+    {
+      xTaskCreate(log_task, "log_task", stack_size, this, task_priority, &_task_handle);
+    }
+    if (_task_handle == nullptr)
+    {
+      _task_running = false;
+      free(_ring);
+      _ring = nullptr;
+      return false;
+    }
+    _async = true;
+    return true;
+#else
+    (void)buffer_size;
+    (void)task_priority;
+    (void)task_pinned_core;
+    return false;
+#endif
+  }
+
+  void Log_Class::endAsync(void)
+  {
+#if defined ( ESP_PLATFORM )
+    if (!_async) { return; }
+    _async = false;
+    _task_running = false;
+    if (_task_handle)
+    {
+      xTaskNotifyGive(_task_handle);
+      do { vTaskDelay(1); } while (_task_handle);
+    }
+    free(_ring);
+    _ring = nullptr;
+#endif
+  }
+
+  void Log_Class::flush(void)
+  {
+#if defined ( ESP_PLATFORM )
+    if (!_async) { return; }
+    if (xTaskGetCurrentTaskHandle() == _task_handle) { return; }
+    while (_ring_tail.load(std::memory_order_acquire) != _ring_head.load(std::memory_order_acquire))
+    {
+      vTaskDelay(1);
+    }
+#endif
+  }
+
   void Log_Class::setDisplay(M5GFX* target)
   {
     _display = target;
@@ -10,7 +10,13 @@
 #include <esp_log.h>
 #endif
 
+#if defined ( ESP_PLATFORM )
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 #include <stdarg.h>
+#include <atomic>
 #include <functional>
 
 #include <M5GFX.h>
@@ -97,6 +103,32 @@ namespace m5
 
     void dump(const void* addr, uint32_t len, esp_log_level_t level = esp_log_level_t::ESP_LOG_NONE);
 
+    /// Start asynchronous output.
+    /// Logs are formatted into a ring buffer by the caller and written to the targets by a low priority task,
+    /// so the logging task never waits for the serial or the display.
+    /// @param buffer_size ring buffer size in bytes. (rounded up to a power of two, max 65536)
+    /// @param task_priority priority of the output task.
+    /// @param task_pinned_core core to run the output task on. (out of range = no affinity)
+    /// @return true=success / false=failure or not supported on this platform.
+    /// @attention When the ring buffer is full, the log is discarded and counted. see getDropCount()
+    bool beginAsync(size_t buffer_size = 4096, uint8_t task_priority = 1, uint8_t task_pinned_core = -1);
+
+    /// Write out all pending logs and return to synchronous output.
+    /// @attention Do not call while other tasks are logging.
+    void endAsync(void);
+
+    /// Get whether asynchronous output is running.
+    bool isAsync(void) const { return _async; }
+
+    /// Wait until all pending logs have been written.
+    void flush(void);
+
+    /// Get the number of logs discarded because the ring buffer was full.
+    uint32_t getDropCount(void) const { return _drop_count.load(std::memory_order_relaxed); }
+
+    /// Reset the number of discarded logs.
+    void resetDropCount(void) { _drop_count.store(0, std::memory_order_relaxed); }
+
     /// not for use.
     static const char* pathToFileName(const char * path);
 
@@ -107,6 +139,9 @@ namespace m5
     static constexpr const char *str_lf = &str_crlf[1];
 
     void output(esp_log_level_t level, bool suffix, const char* __restrict format, va_list arg);
+    void write_targets(esp_log_level_t level, bool suffix, const char* str);
+    bool push_record(esp_log_level_t level, bool suffix, const char* str, size_t len);
+    size_t drain(void);
     void update_level(void);
 
     std::function<void(esp_log_level_t log_level, bool use_color, const char* log_text)> _callback;
@@ -123,6 +158,20 @@ namespace m5
     const char* _suffix[log_target_max] = { str_lf, str_lf, str_crlf };
 
     bool _use_color[log_target_max] = { true, true, true };
+
+    // Asynchronous output: variable length records in a ring buffer, reserved by CAS on _ring_head.
+    // Unused space is always zero filled, so a record becomes visible only when its state byte is set.
+    uint8_t* _ring = nullptr;
+    uint32_t _ring_mask = 0;
+    std::atomic<uint32_t> _ring_head { 0 };
+    std::atomic<uint32_t> _ring_tail { 0 };
+    std::atomic<uint32_t> _drop_count { 0 };
+    volatile bool _async = false;
+    volatile bool _task_running = false;
+#if defined ( ESP_PLATFORM )
+    TaskHandle_t _task_handle = nullptr;
+    static void log_task(void* args);
+#endif
   };
 }
 #endif
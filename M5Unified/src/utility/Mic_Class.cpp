@@ -529,29 +529,42 @@ printf("i2s_channel_init_std_mode 2:%d\n", err);
     _i2s_read(self->_cfg.i2s_port, src_buf, dma_buf_len, &src_len, portTICK_PERIOD_MS);
     _i2s_read(self->_cfg.i2s_port, src_buf, dma_buf_len, &src_len, portTICK_PERIOD_MS);
 
+    recording_info_t stream_rec;
+
     while (self->_task_running)
     {
-      bool rec_flip = self->_rec_flip;
-      recording_info_t* current_rec = &(self->_rec_info[!rec_flip]);
-      recording_info_t* next_rec    = &(self->_rec_info[ rec_flip]);
-
-      size_t dst_remain = current_rec->length;
-      if (dst_remain == 0)
+      recording_info_t* current_rec;
+      size_t dst_remain;
+      if (self->_stream_buf)
+      { // streaming: the blocks of the ring buffer take the place of the record() arrays.
+        if (stream_rec.length == 0) { self->_stream_block_done(&stream_rec); }
+        current_rec = &stream_rec;
+        dst_remain = current_rec->length;
+      }
+      else
       {
-        rec_flip = !rec_flip;
-        self->_rec_flip = rec_flip;
-        xSemaphoreGive(self->_task_semaphore);
-        std::swap(current_rec, next_rec);
+        bool rec_flip = self->_rec_flip;
+        current_rec = &(self->_rec_info[!rec_flip]);
+        recording_info_t* next_rec    = &(self->_rec_info[ rec_flip]);
+
         dst_remain = current_rec->length;
         if (dst_remain == 0)
         {
-          self->_is_recording = false;
-          ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
-          src_idx = ~0u;
-          src_len = 0;
-          sum_value[0] = 0;
-          sum_value[1] = 0;
-          continue;
+          rec_flip = !rec_flip;
+          self->_rec_flip = rec_flip;
+          xSemaphoreGive(self->_task_semaphore);
+          std::swap(current_rec, next_rec);
+          dst_remain = current_rec->length;
+          if (dst_remain == 0)
+          {
+            self->_is_recording = false;
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            src_idx = ~0u;
+            src_len = 0;
+            sum_value[0] = 0;
+            sum_value[1] = 0;
+            continue;
+          }
         }
       }
       self->_is_recording = true;
@@ -722,8 +735,138 @@ printf("i2s_channel_init_std_mode 2:%d\n", err);
     _i2s_driver_uninstall(_cfg.i2s_port);
   }
 
+  bool Mic_Class::beginStream(size_t block_len, size_t block_count, bool stereo)
+  {
+    if (_stream_buf) { endStream(); }
+    if (block_len == 0 || block_count < 2) { return false; }
+    // a mono microphone delivers stereo output two frames at a time.
+    if (stereo) { block_len = (block_len + 3) & ~3u; }
+
+    // one spare block at the end receives the samples that do not fit when the reader is behind.
+    size_t capacity = block_len * block_count;
+    auto buf = (int16_t*)malloc((capacity + block_len) * sizeof(int16_t));
+    if (buf == nullptr) { return false; }
+
+    if (_stream_semaphore == nullptr) { _stream_semaphore = xSemaphoreCreateBinary(); }
+    if (_stream_semaphore == nullptr)
+    {
+      free(buf);
+      return false;
+    }
+
+    if (_task_running) { do { vTaskDelay(1); } while (isRecording()); }
+
+    _stream_block_len = block_len;
+    _stream_capacity = capacity;
+    _stream_stereo = stereo;
+    _stream_head = 0;
+    _stream_tail = 0;
+    _stream_overruns = 0;
+    _stream_dropping = false;
+    _stream_buf = buf;
+
+    if (!begin())
+    {
+      endStream();
+      return false;
+    }
+    if (_task_handle) { xTaskNotifyGive(_task_handle); }
+    return true;
+  }
+
+  void Mic_Class::endStream(void)
+  {
+    if (_stream_buf == nullptr) { return; }
+    end();
+    auto buf = _stream_buf;
+    _stream_buf = nullptr;
+    free(buf);
+  }
+
+  size_t Mic_Class::available(void) const
+  {
+    if (_stream_buf == nullptr) { return 0; }
+    size_t span = _stream_capacity << 1;
+    return (_stream_head + span - _stream_tail) % span;
+  }
+
+  size_t Mic_Class::read(int16_t* buf, size_t len, uint32_t timeout_ms)
+  {
+    if (_stream_buf == nullptr) { return 0; }
+
+    TickType_t wait = (timeout_ms == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    TickType_t start = xTaskGetTickCount();
+    size_t capacity = _stream_capacity;
+    size_t done = 0;
+    for (;;)
+    {
+      size_t n = available();
+      if (n > len - done) { n = len - done; }
+      if (n)
+      {
+        __sync_synchronize(); // see the samples before the head that published them.
+        size_t tail = _stream_tail;
+        size_t pos = (tail < capacity) ? tail : tail - capacity;
+        size_t first = capacity - pos;
+        if (first > n) { first = n; }
+        memcpy(&buf[done], &_stream_buf[pos], first * sizeof(int16_t));
+        memcpy(&buf[done + first], _stream_buf, (n - first) * sizeof(int16_t));
+        tail += n;
+        if (tail >= (capacity << 1)) { tail -= capacity << 1; }
+        __sync_synchronize(); // finish copying before the task may refill the space.
+        _stream_tail = tail;
+        done += n;
+      }
+      if (done == len) { break; }
+
+      TickType_t elapsed = xTaskGetTickCount() - start;
+      if (wait != portMAX_DELAY && elapsed >= wait) { break; }
+      xSemaphoreTake(_stream_semaphore, (wait == portMAX_DELAY) ? portMAX_DELAY : wait - elapsed);
+    }
+    return done;
+  }
+
+  void Mic_Class::_stream_block_done(recording_info_t* rec)
+  {
+    size_t capacity = _stream_capacity;
+    size_t block_len = _stream_block_len;
+    size_t head = _stream_head;
+    size_t pos = (head < capacity) ? head : head - capacity;
+
+    if (rec->index)
+    { // a block has been completed.
+      if (_stream_cb)
+      {
+        _stream_cb(_stream_cb_args, &_stream_buf[pos], block_len);
+      }
+      else if (_stream_dropping)
+      {
+        ++_stream_overruns;
+      }
+      else
+      {
+        head += block_len;
+        if (head >= (capacity << 1)) { head -= capacity << 1; }
+        __sync_synchronize(); // write the samples before publishing them.
+        _stream_head = head;
+        pos = (head < capacity) ? head : head - capacity;
+        xSemaphoreGive(_stream_semaphore);
+      }
+    }
+
+    // with a callback the same block is reused, otherwise the next free block or the spare one.
+    _stream_dropping = (_stream_cb == nullptr) && (available() > capacity - block_len);
+    rec->data = &_stream_buf[_stream_dropping ? capacity : pos];
+    rec->length = block_len;
+    rec->index = 1;
+    rec->is_16bit = true;
+    rec->is_stereo = _stream_stereo;
+  }
+
   bool Mic_Class::_rec_raw(void* recdata, size_t array_len, bool flg_16bit, uint32_t sample_rate, bool flg_stereo)
   {
+    if (_stream_buf) { return false; }
+
     recording_info_t info;
     info.data = recdata;
     info.length = array_len;
@@ -156,6 +156,33 @@ namespace m5
       return _rec_raw(rec_data, array_len,  true, _cfg.sample_rate, false);
     }
 
+    /// start gapless 16bit capture into a ring buffer of block_len * block_count samples.
+    /// While streaming, record() is not available.
+    /// @param block_len Number of samples the task writes at a time. (rounded up to a multiple of 4 in stereo)
+    /// @param block_count Number of blocks in the ring buffer. (2 or more)
+    /// @param stereo true=data is stereo / false=data is monaural.
+    bool beginStream(size_t block_len = 256, size_t block_count = 8, bool stereo = false);
+
+    /// stop capturing and release the ring buffer.
+    void endStream(void);
+
+    bool isStreaming(void) const { return _stream_buf != nullptr; }
+
+    /// @return Number of samples waiting to be read.
+    size_t available(void) const;
+
+    /// take samples out of the ring buffer, waiting until len samples have arrived.
+    /// @param timeout_ms Longest wait in milliseconds. (UINT32_MAX=forever, 0=no wait)
+    /// @return Number of samples copied.
+    size_t read(int16_t* buf, size_t len, uint32_t timeout_ms = UINT32_MAX);
+
+    /// hand each completed block to func from the mic task instead of queueing it for read().
+    /// func must return quickly; data is valid only during the call.
+    void setStreamCallback(void(*func)(void* args, const int16_t* data, size_t len), void* args = nullptr) { _stream_cb_args = args; _stream_cb = func; }
+
+    /// @return Number of blocks discarded because the ring buffer was full.
+    uint32_t getOverrunCount(void) const { return _stream_overruns; }
+
   protected:
 
     void setCallback(void* args, bool(*func)(void*, bool)) { _cb_set_enabled = func; _cb_set_enabled_args = args; }
@@ -177,6 +204,7 @@ namespace m5
     uint32_t _calc_rec_rate(void) const;
     esp_err_t _setup_i2s(void);
     bool _rec_raw(void* recdata, size_t array_len, bool flg_16bit, uint32_t sample_rate, bool stereo);
+    void _stream_block_done(recording_info_t* rec);
 
     mic_config_t _cfg;
     uint32_t _rec_sample_rate = 0;
@@ -187,11 +215,25 @@ namespace m5
     int32_t _offset = 0;
     volatile bool _task_running = false;
     volatile bool _is_recording = false;
+
+    // streaming ring buffer. the task writes _stream_head and the reader _stream_tail,
+    // both count samples modulo twice the capacity so that full and empty differ.
+    int16_t* volatile _stream_buf = nullptr;
+    size_t _stream_block_len = 0;
+    size_t _stream_capacity = 0;
+    volatile size_t _stream_head = 0;
+    volatile size_t _stream_tail = 0;
+    volatile uint32_t _stream_overruns = 0;
+    bool _stream_stereo = false;
+    bool _stream_dropping = false;
+    void (* volatile _stream_cb)(void* args, const int16_t* data, size_t len) = nullptr;
+    void* volatile _stream_cb_args = nullptr;
 #if defined (SDL_h_)
     SDL_Thread* _task_handle = nullptr;
 #else
     TaskHandle_t _task_handle = nullptr;
     volatile SemaphoreHandle_t _task_semaphore = nullptr;
+    SemaphoreHandle_t _stream_semaphore = nullptr;
 #endif
   };
 }
@@ -949,8 +949,120 @@ namespace m5
 #endif
   }
 
+  std::int8_t Power_Class::_mvToLevel(float mv)
+  {
+    int level = (mv - 3300) * 100 / (float)(4150 - 3350);
+
+    return (level < 0) ? 0
+         : (level >= 100) ? 100
+         : level;
+  }
+
+  bool Power_Class::updateSnapshot(void)
+  {
+    snapshot_t s;
+    bool res = true;
+#if defined (M5UNIFIED_PC_BUILD)
+    s.battery_level = 100;
+#else
+    switch (_pmic)
+    {
+#if defined (CONFIG_IDF_TARGET_ESP32C3) || defined (CONFIG_IDF_TARGET_ESP32C6)
+#else
+#if !defined (CONFIG_IDF_TARGET) || defined (CONFIG_IDF_TARGET_ESP32)
+
+    case pmic_t::pmic_ip5306:
+      s.battery_level = Ip5306.getBatteryLevel();
+      s.charging = Ip5306.isCharging() ? is_charging_t::is_charging : is_charging_t::is_discharging;
+      res = (s.battery_level >= 0);
+      break;
+
+    case pmic_t::pmic_axp192:
+      {
+        // 0x00 power status / 0x5A~0x7D ADC data (VBUS ~ battery discharge current)
+        std::uint8_t status;
+        std::uint8_t adc[0x7E - 0x5A];
+        I2C_Transaction transaction(Axp192.getPort());
+        transaction.readRegister(Axp192, 0x00, &status, 1);
+        transaction.readRegister(Axp192, 0x5A, adc, sizeof(adc));
+        res = transaction.execute();
+        if (!res) { break; }
+        auto reg12 = [&adc](std::uint8_t reg) { return adc[reg - 0x5A] << 4 | adc[reg - 0x5A + 1]; };
+        auto reg13 = [&adc](std::uint8_t reg) { return adc[reg - 0x5A] << 5 | adc[reg - 0x5A + 1]; };
+
+        s.charging = (status & 0x04) ? is_charging_t::is_charging : is_charging_t::is_discharging;
+        s.vbus_mv = reg12(0x5A) * 1.7f;
+        s.battery_mv = reg12(0x78) * 1.1f;
+        s.battery_level = _mvToLevel(s.battery_mv);
+        std::int32_t chg = reg13(0x7A) * 0.5f;
+        std::int32_t dsc = reg13(0x7C) * 0.5f;
+        s.battery_ma = (chg < dsc) ? -dsc : chg;
+      }
+      break;
+
+#endif
+
+    case pmic_t::pmic_axp2101:
+      {
+        // 0x00~0x01 status / 0x34~0x39 battery, TS and VBUS voltage / 0xA4 battery level
+        std::uint8_t status[2];
+        std::uint8_t adc[6];
+        std::uint8_t level;
+        I2C_Transaction transaction(Axp2101.getPort());
+        transaction.readRegister(Axp2101, 0x00, status, 2);
+        transaction.readRegister(Axp2101, 0x34, adc, sizeof(adc));
+        transaction.readRegister(Axp2101, 0xA4, &level, 1);
+        res = transaction.execute();
+        if (!res) { break; }
+
+        s.charging = ((status[1] & 0b01100000) == 0b00100000) ? is_charging_t::is_charging : is_charging_t::is_discharging;
+        s.battery_mv = (adc[0] & 0x3F) << 8 | adc[1];
+        std::int_fast16_t vbus = (adc[4] & 0x3F) << 8 | adc[5];
+        s.vbus_mv = ((status[0] & 0x20) && vbus < 16375) ? vbus : 0;
+        s.battery_level = level;
+#if !defined (CONFIG_IDF_TARGET_ESP32S3)
+        // for Core2 v1.1
+        s.battery_ma = 1000.0f * Ina3221[0].getCurrent(0); // 0=CH1. CH1=BAT Current.
+#endif
+      }
+      break;
+
+#endif
+
+    case pmic_t::pmic_adc:
+      s.battery_mv = _getBatteryAdcRaw() * _adc_ratio;
+      s.battery_level = _mvToLevel(s.battery_mv);
+      break;
+
+    default:
+      break;
+    }
+#endif
+    if (!res) { return false; }
+    s.msec = m5gfx::millis();
+    _snapshot = s;
+    _snapshot_valid = true;
+    return true;
+  }
+
+  const Power_Class::snapshot_t& Power_Class::getSnapshot(void)
+  {
+    if (!_snapshot_valid || getSnapshotAge() >= _snapshot_interval)
+    {
+      updateSnapshot();
+    }
+    return _snapshot;
+  }
+
+  std::uint32_t Power_Class::getSnapshotAge(void) const
+  {
+    return m5gfx::millis() - _snapshot.msec;
+  }
+
   int16_t Power_Class::getVBUSVoltage(void)
   {
+    if (_snapshot_interval) { return getSnapshot().vbus_mv; }
+
     float f = NAN;
 #if !defined (M5UNIFIED_PC_BUILD)
     switch (_pmic)
@@ -985,6 +1097,8 @@ namespace m5
 
   int16_t Power_Class::getBatteryVoltage(void)
   {
+    if (_snapshot_interval) { return getSnapshot().battery_mv; }
+
 #if !defined (M5UNIFIED_PC_BUILD)
     switch (_pmic)
     {
@@ -1017,6 +1131,8 @@ namespace m5
 
   std::int32_t Power_Class::getBatteryLevel(void)
   {
+    if (_snapshot_interval) { return getSnapshot().battery_level; }
+
 #if defined (M5UNIFIED_PC_BUILD)
     return 100;
 #else
@@ -1050,11 +1166,7 @@ namespace m5
       return -2;
     }
 
-    int level = (mv - 3300) * 100 / (float)(4150 - 3350);
-
-    return (level < 0) ? 0
-         : (level >= 100) ? 100
-         : level;
+    return _mvToLevel(mv);
 #endif
   }
 
@@ -1116,6 +1228,8 @@ namespace m5
 
   int32_t Power_Class::getBatteryCurrent(void)
   {
+    if (_snapshot_interval) { return getSnapshot().battery_ma; }
+
     switch (_pmic)
     {
 #if defined (CONFIG_IDF_TARGET_ESP32C3) || defined (CONFIG_IDF_TARGET_ESP32C6)
@@ -1182,6 +1296,8 @@ namespace m5
 
   Power_Class::is_charging_t Power_Class::isCharging(void)
   {
+    if (_snapshot_interval) { return getSnapshot().charging; }
+
     switch (_pmic)
     {
 #if defined (CONFIG_IDF_TARGET_ESP32C3) || defined (CONFIG_IDF_TARGET_ESP32C6)
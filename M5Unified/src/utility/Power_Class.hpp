@@ -164,6 +164,35 @@ namespace m5
 
     pmic_t getType(void) const { return _pmic; }
 
+    /// Values read from the PMIC at once.
+    struct snapshot_t
+    {
+      std::uint32_t msec = 0;       // millis() at the time of reading.
+      std::int32_t battery_ma = 0;  // same as getBatteryCurrent()
+      std::int16_t battery_mv = 0;  // same as getBatteryVoltage()
+      std::int16_t vbus_mv = -1;    // same as getVBUSVoltage()
+      std::int8_t battery_level = -2; // same as getBatteryLevel()
+      is_charging_t charging = is_charging_t::charge_unknown; // same as isCharging()
+    };
+
+    /// Set the lifetime of the snapshot.
+    /// When non-zero, getBatteryLevel, isCharging, getBatteryVoltage, getVBUSVoltage and getBatteryCurrent return the snapshot,
+    /// which is read again in one I2C transaction once it is older than msec.
+    /// @param msec lifetime of the snapshot. 0=disable (every getter reads the PMIC, default)
+    void setSnapshotInterval(std::uint32_t msec) { _snapshot_interval = msec; _snapshot_valid = false; }
+
+    std::uint32_t getSnapshotInterval(void) const { return _snapshot_interval; }
+
+    /// Read the snapshot from the PMIC now.
+    /// @return true=success / false=communication failed. (the previous snapshot is kept)
+    bool updateSnapshot(void);
+
+    /// Get the snapshot, read again if it is older than the snapshot interval.
+    const snapshot_t& getSnapshot(void);
+
+    /// Get the milliseconds elapsed since the snapshot was read.
+    std::uint32_t getSnapshotAge(void) const;
+
 #if defined (CONFIG_IDF_TARGET_ESP32S3)
 
     AXP2101_Class Axp2101;
@@ -182,6 +211,7 @@ namespace m5
 
   private:
     std::int32_t _getBatteryAdcRaw(void);
+    static std::int8_t _mvToLevel(float mv);
     void _powerOff(bool withTimer);
     void _timerSleep(void);
 
@@ -189,6 +219,9 @@ namespace m5
     std::uint8_t _wakeupPin = 255;
     std::uint8_t _rtcIntPin = 255;
     pmic_t _pmic = pmic_t::pmic_unknown;
+    snapshot_t _snapshot;
+    std::uint32_t _snapshot_interval = 0;
+    bool _snapshot_valid = false;
 #if !defined (M5UNIFIED_PC_BUILD)
     uint8_t _batAdcCh;
     uint8_t _batAdcUnit;
@@ -337,6 +337,63 @@ namespace m5
 /// レート変換係数 (実際に設定されるレートが浮動小数になる場合があるため、入力と出力の両方のサンプリングレートに係数を掛け、誤差を減らす);
   #define SAMPLERATE_MUL 256
 
+  /// read one frame as signed 16bit values. (8bit data is scaled up)
+  static inline void read_frame(const void* data, size_t& index, bool is_16bit, bool is_signed, bool is_stereo, int32_t& l, int32_t& r)
+  {
+    if (is_16bit)
+    {
+      auto wav = (const int16_t*)data;
+      l = wav[index];
+      r = wav[index += is_stereo];
+      index++;
+      if (!is_signed)
+      {
+        l = (l & 0xFFFF) + INT16_MIN;
+        r = (r & 0xFFFF) + INT16_MIN;
+      }
+    }
+    else
+    {
+      auto wav = (const uint8_t*)data;
+      l = wav[index];
+      r = wav[index += is_stereo];
+      index++;
+      if (is_signed)
+      {
+        l = (int8_t)l;
+        r = (int8_t)r;
+      }
+      else
+      {
+        l += INT8_MIN;
+        r += INT8_MIN;
+      }
+      l <<= 8;
+      r <<= 8;
+    }
+  }
+
+  void Speaker_Class::_fill_stream(stream_info_t* stream, bool stereo)
+  {
+    size_t space = stream->capacity - (stream->written - stream->consumed);
+    while (space > (size_t)stereo)
+    {
+      size_t pos = stream->write_pos;
+      size_t len = stream->capacity - pos;
+      if (len > space) { len = space; }
+      if (stereo) { len &= ~1u; }
+      size_t res = stream->func(stream->args, &stream->buf[pos], len);
+      if (stereo) { res &= ~1u; }
+      if (res == 0) { break; }
+      if (res > len) { res = len; }
+      pos += res;
+      stream->write_pos = (pos < stream->capacity) ? pos : 0;
+      stream->written = stream->written + res;
+      space -= res;
+      if (res < len) { break; }
+    }
+  }
+
   void Speaker_Class::spk_task(void* args)
   {
     auto self = (Speaker_Class*)args;
@@ -463,7 +520,11 @@ namespace m5
     spk_i2s_state flg_i2s_started = spk_i2s_stop;
 #endif
     // ステレオ出力の場合は倍率を2倍する
-    const float magnification = (float)(self->_cfg.magnification << out_stereo) / spk_sample_rate_x256 / (1 << 28);
+    // (16.16 fixed point gain per squared volume)
+    const float magnification = (float)(self->_cfg.magnification << out_stereo) / (1 << 12);
+    static constexpr const int32_t gain_limit = 1 << 28;
+    // reciprocal of the output rate, for the interpolation position. (46 fraction bits)
+    const int32_t inv_spk_rate = (1LL << 46) / spk_sample_rate_x256;
 
     int32_t dac_offset = std::min(INT16_MAX-255, self->_cfg.dac_zero_level << 8);
 
@@ -630,17 +691,34 @@ label_next_wav:
         }
         auto data = (const uint8_t*)current_wav->data;
         const bool in_stereo = current_wav->is_stereo;
+        const bool in_16bit = current_wav->is_16bit;
+        const bool in_signed = current_wav->is_signed;
         const int32_t in_rate = current_wav->sample_rate_x256;
-        int32_t tmp = ch_info->volume;
-        tmp *= tmp;
-        // 8bitのデータの場合は倍率を256倍する
-        if (!current_wav->is_16bit) { tmp <<= 8; }
-        const float ch_v = volume * tmp;
+        float ch_v = ch_info->volume;
+        ch_v *= ch_v * volume;
+        // 16.16 fixed point gain. limited so that all channels together cannot overflow the int32 buffer.
+        const int32_t gain = (ch_v < gain_limit) ? (int32_t)ch_v : gain_limit;
+        auto mul = [gain](int32_t v) { return (int32_t)(((int64_t)v * gain) >> 16); };
+
+        // Rates within 0.1% are played one input frame per output frame, without interpolation.
+        const bool direct = abs(in_rate - spk_sample_rate_x256) <= (spk_sample_rate_x256 >> 10);
+        const int32_t rate_ratio = ((int64_t)in_rate << 16) / spk_sample_rate_x256;
+
+        // A stream may only be read up to what has been written into its ring buffer.
+        stream_info_t* stream = current_wav->is_stream ? &(self->_stream_info[ch]) : nullptr;
+        size_t stream_remain = SIZE_MAX;
+        if (stream)
+        {
+          if (stream->func) { _fill_stream(stream, in_stereo); }
+          stream_remain = stream->written - stream->consumed;
+          __sync_synchronize(); // read the samples only after seeing how many there are.
+        }
+        const size_t stream_avail = stream_remain;
 
         auto liner_base = ch_info->liner_buf[0];
         auto liner_prev = ch_info->liner_buf[1];
 
-        if (ch_diff < 0) { goto label_continue_sample; }
+        if (ch_diff < 0 && !direct) { goto label_continue_sample; }
 
         if (ch_index >= current_wav->length)
         {
@@ -659,54 +737,120 @@ label_wav_end:
 
         do
         {
-          do
+          if (direct)
           {
             if (ch_index >= current_wav->length)
             {
               goto label_wav_end;
             }
-
+            size_t frames = (current_wav->length - ch_index) >> in_stereo;
+            size_t out_frames = (dma_buf_len - idx) >> out_stereo;
+            if (frames > out_frames) { frames = out_frames; }
+            if (frames > (stream_remain >> in_stereo)) { frames = stream_remain >> in_stereo; }
+            if (frames == 0) { goto label_channel_end; }
+            if (stream) { stream_remain -= frames << in_stereo; }
+
+            auto dst = &sound_buf32[idx];
+            idx += frames << out_stereo;
             int32_t l, r;
-            if (current_wav->is_16bit)
+            if (in_16bit && in_signed)
             {
-              auto wav = (const int16_t*)data;
-              l = wav[ch_index];
-              r = wav[ch_index += in_stereo];
-              ch_index++;
-              if (!current_wav->is_signed)
+              auto wav = &((const int16_t*)data)[ch_index];
+              ch_index += frames << in_stereo;
+              if (in_stereo)
+              {
+                if (out_stereo)
+                {
+                  do
+                  {
+                    dst[0] += mul(wav[0]);
+                    dst[1] += mul(wav[1]);
+                    dst += 2;
+                    wav += 2;
+                  } while (--frames);
+                }
+                else
+                {
+                  do
+                  {
+                    *dst++ += mul(wav[0] + wav[1]);
+                    wav += 2;
+                  } while (--frames);
+                }
+                l = wav[-2];
+                r = wav[-1];
+              }
+              else
               {
-                l = (l & 0xFFFF) + INT16_MIN;
-                r = (r & 0xFFFF) + INT16_MIN;
+                if (out_stereo)
+                {
+                  do
+                  {
+                    int32_t v = mul(*wav++);
+                    dst[0] += v;
+                    dst[1] += v;
+                    dst += 2;
+                  } while (--frames);
+                }
+                else
+                {
+                  do
+                  {
+                    *dst++ += mul(*wav++ << 1);
+                  } while (--frames);
+                }
+                l = r = wav[-1];
               }
             }
             else
             {
-              l = data[ch_index];
-              r = data[ch_index += in_stereo];
-              ch_index++;
-              if (current_wav->is_signed)
+              do
               {
-                l = (int8_t)l;
-                r = (int8_t)r;
-              }
-              else
-              {
-                l += INT8_MIN;
-                r += INT8_MIN;
-              }
+                read_frame(data, ch_index, in_16bit, in_signed, in_stereo, l, r);
+                if (out_stereo)
+                {
+                  dst[0] += mul(l);
+                  dst[1] += mul(r);
+                  dst += 2;
+                }
+                else
+                {
+                  *dst++ += mul(l + r);
+                }
+              } while (--frames);
             }
+            // keep the last frame, in case the next sound needs interpolating.
+            liner_prev[0] = liner_base[0];
+            liner_prev[1] = liner_base[1];
+            liner_base[0] = mul(out_stereo ? l : l + r);
+            liner_base[1] = mul(r);
+            if (data_length < idx) { data_length = idx; }
+            continue;
+          }
+
+          do
+          {
+            if (ch_index >= current_wav->length)
+            {
+              goto label_wav_end;
+            }
+            if (stream_remain <= (size_t)in_stereo) { goto label_channel_end; }
+            if (stream) { stream_remain -= 1 + in_stereo; }
+
+            int32_t l, r;
+            read_frame(data, ch_index, in_16bit, in_signed, in_stereo, l, r);
 
             liner_prev[0] = liner_base[0];
             if (out_stereo)
             {
               liner_prev[1] = liner_base[1];
-              liner_base[1] = r * ch_v;
+              liner_base[1] = mul(r);
             }
             else
             {
               l += r;
             }
-            liner_base[0] = l * ch_v;
+            liner_base[0] = mul(l);
 
             ch_diff -= spk_sample_rate_x256;
           } while (ch_diff >= 0);
@@ -714,42 +858,49 @@ label_wav_end:
 label_continue_sample:
 
 /// liner_prevからliner_baseへの２サンプル間の線形補間;
-          float base_l = liner_base[0];
-          float step_l = base_l - liner_prev[0];
-          base_l *= spk_sample_rate_x256;
-          base_l += step_l * ch_diff;
-          step_l *= in_rate;
-          int32_t b_l = base_l;
-          int32_t s_l = step_l;
-          if (out_stereo)
           {
-            float base_r = liner_base[1];
-            float step_r = base_r - liner_prev[1];
-            base_r *= spk_sample_rate_x256;
-            base_r += step_r * ch_diff;
-            step_r *= in_rate;
-            int32_t b_r = base_r;
-            int32_t s_r = step_r;
-            do
+            // position between the two samples, -1.0 ~ 0 in 16.16 fixed point.
+            const int32_t frac = ((int64_t)ch_diff * inv_spk_rate) >> 30;
+            int32_t step_l = liner_base[0] - liner_prev[0];
+            int32_t b_l = liner_base[0] + (int32_t)(((int64_t)step_l * frac) >> 16);
+            int32_t s_l = ((int64_t)step_l * rate_ratio) >> 16;
+            if (out_stereo)
             {
-              sound_buf32[  idx] += b_l;
-              sound_buf32[++idx] += b_r;
-              b_l += s_l;
-              b_r += s_r;
-              ch_diff += in_rate;
-            } while (++idx < dma_buf_len && ch_diff < 0);
-          }
-          else
-          {
-            do
+              int32_t step_r = liner_base[1] - liner_prev[1];
+              int32_t b_r = liner_base[1] + (int32_t)(((int64_t)step_r * frac) >> 16);
+              int32_t s_r = ((int64_t)step_r * rate_ratio) >> 16;
+              do
+              {
+                sound_buf32[  idx] += b_l;
+                sound_buf32[++idx] += b_r;
+                b_l += s_l;
+                b_r += s_r;
+                ch_diff += in_rate;
+              } while (++idx < dma_buf_len && ch_diff < 0);
+            }
+            else
             {
-              sound_buf32[idx] += b_l;
-              b_l += s_l;
-              ch_diff += in_rate;
-            } while (++idx < dma_buf_len && ch_diff < 0);
+              do
+              {
+                sound_buf32[idx] += b_l;
+                b_l += s_l;
+                ch_diff += in_rate;
+              } while (++idx < dma_buf_len && ch_diff < 0);
+            }
           }
           if (data_length < idx) { data_length = idx; }
         } while (idx < dma_buf_len);
+
+label_channel_end:
+        if (stream)
+        {
+          if (idx < dma_buf_len)
+          { // the ring buffer ran dry, the rest of this channel stays silent.
+            if (stream->ending) { current_wav->repeat = 0; }
+            else { stream->underruns = stream->underruns + 1; }
+          }
+          stream->consumed = stream->consumed + (stream_avail - stream_remain);
+        }
         ch_info->diff = ch_diff;
         ch_info->index = ch_index;
       }
@@ -934,6 +1085,9 @@ label_continue_sample:
       auto chinfo = &_ch_info[ch];
       chinfo->wavinfo[0].clear();
       chinfo->wavinfo[1].clear();
+      free(_stream_info[ch].buf);
+      _stream_info[ch].buf = nullptr;
+      _stream_info[ch].capacity = 0;
     }
   }
 
@@ -1004,11 +1158,7 @@ label_continue_sample:
     size_t ch = (size_t)channel;
     if (ch >= sound_channel_max)
     {
-      size_t bits = _play_channel_bits.load();
-      for (ch = sound_channel_max - 1; ch < sound_channel_max; --ch)
-      {
-        if (0 == ((bits >> ch) & 1)) { break; }
-      }
+      ch = _get_free_channel();
       if (ch >= sound_channel_max) { return false; }
     }
     wav_info_t info;
@@ -1025,6 +1175,119 @@ label_continue_sample:
     return _set_next_wav(ch, info);
   }
 
+  size_t Speaker_Class::_get_free_channel(void) const
+  {
+    size_t bits = _play_channel_bits.load();
+    size_t ch;
+    for (ch = sound_channel_max - 1; ch < sound_channel_max; --ch)
+    {
+      if (0 == ((bits >> ch) & 1)) { break; }
+    }
+    return ch;
+  }
+
+  int Speaker_Class::_play_stream(size_t(*func)(void*, int16_t*, size_t), void* args, size_t ring_len, uint32_t sample_rate, bool flg_stereo, int channel)
+  {
+    if (!begin() || (_task_handle == nullptr)) { return -1; }
+    if (flg_stereo) { ring_len &= ~1u; }
+    if (ring_len < 2 || sample_rate == 0) { return -1; }
+    size_t ch = (size_t)channel;
+    if (ch >= sound_channel_max)
+    {
+      ch = _get_free_channel();
+      if (ch >= sound_channel_max) { return -1; }
+    }
+
+    // the ring buffer may be replaced only after the task has left the channel.
+    uint8_t chmask = 1 << ch;
+    if (_play_channel_bits.load() & chmask)
+    {
+      stop(ch);
+#if !defined (SDL_h_)
+      xTaskNotifyGive(_task_handle);
+      do { vTaskDelay(1); } while (_play_channel_bits.load() & chmask);
+#else
+      do { SDL_Delay(1); } while (_play_channel_bits.load() & chmask);
+#endif
+    }
+
+    auto stream = &_stream_info[ch];
+    if (stream->capacity != ring_len)
+    {
+      free(stream->buf);
+      stream->capacity = 0;
+      stream->buf = (int16_t*)malloc(ring_len * sizeof(int16_t));
+      if (stream->buf == nullptr) { return -1; }
+      stream->capacity = ring_len;
+    }
+    stream->write_pos = 0;
+    stream->written = 0;
+    stream->consumed = 0;
+    stream->func = func;
+    stream->args = args;
+    stream->ending = false;
+    stream->underruns = 0;
+
+    wav_info_t info;
+    info.data = stream->buf;
+    info.length = ring_len;
+    info.repeat = ~0u;
+    info.sample_rate_x256 = sample_rate * SAMPLERATE_MUL;
+    info.is_stereo = flg_stereo;
+    info.is_16bit = true;
+    info.is_signed = true;
+    info.is_stream = true;
+    info.stop_current = true;
+
+    return _set_next_wav(ch, info) ? (int)ch : -1;
+  }
+
+  size_t Speaker_Class::availableForWriteStream(uint8_t channel) const
+  {
+    if (channel >= sound_channel_max) { return 0; }
+    auto stream = &_stream_info[channel];
+    if (stream->buf == nullptr || stream->func) { return 0; }
+    return stream->capacity - (stream->written - stream->consumed);
+  }
+
+  size_t Speaker_Class::writeStream(uint8_t channel, const int16_t* data, size_t len, uint32_t timeout_ms)
+  {
+    if (channel >= sound_channel_max) { return 0; }
+    auto stream = &_stream_info[channel];
+    if (stream->buf == nullptr || stream->func) { return 0; }
+
+    uint32_t waited = 0;
+    size_t done = 0;
+    for (;;)
+    {
+      size_t n = availableForWriteStream(channel);
+      if (n > len - done) { n = len - done; }
+      if (n)
+      {
+        size_t pos = stream->write_pos;
+        size_t first = stream->capacity - pos;
+        if (first > n) { first = n; }
+        memcpy(&stream->buf[pos], &data[done], first * sizeof(int16_t));
+        memcpy(stream->buf, &data[done + first], (n - first) * sizeof(int16_t));
+        pos += n;
+        if (pos >= stream->capacity) { pos -= stream->capacity; }
+        stream->write_pos = pos;
+        __sync_synchronize(); // store the samples before the task can see them.
+        stream->written = stream->written + n;
+        done += n;
+      }
+      if (done == len || waited >= timeout_ms || !(_play_channel_bits.load() & (1 << channel))) { break; }
+#if !defined (SDL_h_)
+      vTaskDelay(1);
+      waited += portTICK_PERIOD_MS;
+#else
+      SDL_Delay(1);
+      ++waited;
+#endif
+    }
+    return done;
+  }
+
   bool Speaker_Class::playWav(const uint8_t* wav_data, size_t data_len, uint32_t repeat, int channel, bool stop_current_sound)
   {
     struct __attribute__((packed)) wav_header_t
@@ -169,7 +169,7 @@ namespace m5
     /// @param repeat number of times played repeatedly. (default = 1)
     /// @param channel virtual channel number (If omitted, use an available channel.)
     /// @param stop_current_sound true=start a new output without waiting for the current one to finish.
-    /// @attention If you want to use the data generated at runtime, you can either have three buffers and use them in sequence, or have two buffers and use them alternately, then split them in half and call playRaw twice.
+    /// @attention For data generated at runtime, playStream() is simpler. Otherwise you can either have three buffers and use them in sequence, or have two buffers and use them alternately, then split them in half and call playRaw twice.
     /// @attention If noise is present in the output sounds, consider increasing the priority of the task that generates the data.
     bool playRaw(const int8_t* raw_data, size_t array_len, uint32_t sample_rate = 44100, bool stereo = false, uint32_t repeat = 1, int channel = -1, bool stop_current_sound = false)
     {
@@ -189,7 +189,7 @@ namespace m5
     /// @param repeat number of times played repeatedly. (default = 1)
     /// @param channel virtual channel number (If omitted, use an available channel.)
     /// @param stop_current_sound true=start a new output without waiting for the current one to finish.
-    /// @attention If you want to use the data generated at runtime, you can either have three buffers and use them in sequence, or have two buffers and use them alternately, then split them in half and call playRaw twice.
+    /// @attention For data generated at runtime, playStream() is simpler. Otherwise you can either have three buffers and use them in sequence, or have two buffers and use them alternately, then split them in half and call playRaw twice.
     /// @attention If noise is present in the output sounds, consider increasing the priority of the task that generates the data.
     bool playRaw(const uint8_t* raw_data, size_t array_len, uint32_t sample_rate = 44100, bool stereo = false, uint32_t repeat = 1, int channel = -1, bool stop_current_sound = false)
     {
@@ -209,7 +209,7 @@ namespace m5
     /// @param repeat number of times played repeatedly. (default = 1)
     /// @param channel virtual channel number (If omitted, use an available channel.)
     /// @param stop_current_sound true=start a new output without waiting for the current one to finish.
-    /// @attention If you want to use the data generated at runtime, you can either have three buffers and use them in sequence, or have two buffers and use them alternately, then split them in half and call playRaw twice.
+    /// @attention For data generated at runtime, playStream() is simpler. Otherwise you can either have three buffers and use them in sequence, or have two buffers and use them alternately, then split them in half and call playRaw twice.
     /// @attention If noise is present in the output sounds, consider increasing the priority of the task that generates the data.
     bool playRaw(const int16_t* raw_data, size_t array_len, uint32_t sample_rate = 44100, bool stereo = false, uint32_t repeat = 1, int channel = -1, bool stop_current_sound = false)
     {
@@ -230,6 +230,47 @@ namespace m5
     /// @param stop_current_sound true=start a new output without waiting for the current one to finish.
     bool playWav(const uint8_t* wav_data, size_t data_len = ~0u, uint32_t repeat = 1, int channel = -1, bool stop_current_sound = false);
 
+    /// play signed 16bit sound supplied while it plays, through a ring buffer filled with writeStream().
+    /// @param ring_len Number of int16_t elements of the ring buffer. (rounded down to even in stereo)
+    /// @param sample_rate the sampling rate (Hz) (default = 44100)
+    /// @param stereo true=data is stereo / false=data is monaural.
+    /// @param channel virtual channel number (If omitted, use an available channel.)
+    /// @return virtual channel number used, or -1 on failure.
+    int playStream(size_t ring_len, uint32_t sample_rate = 44100, bool stereo = false, int channel = -1)
+    {
+      return _play_stream(nullptr, nullptr, ring_len, sample_rate, stereo, channel);
+    }
+
+    /// play signed 16bit sound pulled from a callback, through a ring buffer.
+    /// @param func called from the speaker task whenever the ring has room; it stores up to len elements into buf and returns how many it stored. (whole frames; must not block)
+    /// @param args argument passed to func.
+    /// @param ring_len Number of int16_t elements of the ring buffer. (rounded down to even in stereo)
+    /// @param sample_rate the sampling rate (Hz) (default = 44100)
+    /// @param stereo true=data is stereo / false=data is monaural.
+    /// @param channel virtual channel number (If omitted, use an available channel.)
+    /// @return virtual channel number used, or -1 on failure.
+    int playStream(size_t(*func)(void* args, int16_t* buf, size_t len), void* args, size_t ring_len, uint32_t sample_rate = 44100, bool stereo = false, int channel = -1)
+    {
+      return (func == nullptr) ? -1 : _play_stream(func, args, ring_len, sample_rate, stereo, channel);
+    }
+
+    /// copy data into the ring buffer of a channel started with playStream(ring_len, ...).
+    /// @param channel virtual channel number. (0~7)
+    /// @param data wave data. (whole frames)
+    /// @param len Number of data array elements.
+    /// @param timeout_ms Longest wait for room in milliseconds. (UINT32_MAX=forever, 0=no wait)
+    /// @return Number of elements copied.
+    size_t writeStream(uint8_t channel, const int16_t* data, size_t len, uint32_t timeout_ms = UINT32_MAX);
+
+    /// @return Number of elements writeStream() can copy without waiting.
+    size_t availableForWriteStream(uint8_t channel) const;
+
+    /// let the stream channel stop once the data already in the ring buffer has been played.
+    void endStream(uint8_t channel) { if (channel < sound_channel_max) { _stream_info[channel].ending = true; } }
+
+    /// @return Number of output buffers in which the ring buffer of the channel ran dry.
+    uint32_t getStreamUnderruns(uint8_t channel) const { return (channel < sound_channel_max) ? _stream_info[channel].underruns : 0; }
+
   protected:
 
     static constexpr const size_t sound_channel_max = 8;
@@ -254,6 +295,7 @@ namespace m5
           uint8_t is_signed      : 1;
           uint8_t stop_current   : 1;
           uint8_t no_clear_index : 1;
+          uint8_t is_stream      : 1;
         };
       };
       void clear(void);
@@ -267,16 +309,34 @@ namespace m5
       volatile uint8_t volume = 255; // channel volume (not master volume)
       volatile bool flip = false;
 
-      float liner_buf[2][2] = { { 0, 0 }, { 0, 0 } };
+      int32_t liner_buf[2][2] = { { 0, 0 }, { 0, 0 } };
     };
 
     channel_info_t _ch_info[sound_channel_max];
 
+    struct stream_info_t
+    {
+      int16_t* buf = nullptr;
+      size_t capacity = 0;
+      size_t write_pos = 0;           // ring position of the writer. (the reader's is channel_info_t::index)
+      volatile size_t written = 0;    // total elements written, counted by the writer
+      volatile size_t consumed = 0;   // total elements played, counted by the task
+      size_t (*func)(void* args, int16_t* buf, size_t len) = nullptr;
+      void* args = nullptr;
+      volatile bool ending = false;
+      volatile uint32_t underruns = 0;
+    };
+
+    stream_info_t _stream_info[sound_channel_max];
+
     static void spk_task(void* args);
 
     esp_err_t _setup_i2s(void);
     bool _play_raw(const void* wav, size_t array_len, bool flg_16bit, bool flg_signed, float sample_rate, bool flg_stereo, uint32_t repeat_count, int channel, bool stop_current_sound, bool no_clear_index);
     bool _set_next_wav(size_t ch, const wav_info_t& wav);
+    int _play_stream(size_t(*func)(void*, int16_t*, size_t), void* args, size_t ring_len, uint32_t sample_rate, bool flg_stereo, int channel);
+    size_t _get_free_channel(void) const;
+    static void _fill_stream(stream_info_t* stream, bool stereo);
 
     speaker_config_t _cfg;
     volatile uint8_t _master_volume = 64;
@@ -3,8 +3,48 @@
 
 #include "Touch_Class.hpp"
 
+#if defined ( ESP_PLATFORM )
+#include <driver/gpio.h>
+#endif
+
 namespace m5
 {
+  void Touch_Class::int_isr(void* arg)
+  {
+    static_cast<Touch_Class*>(arg)->_int_pending = true;
+  }
+
+  bool Touch_Class::enableInterrupt(void)
+  {
+#if defined ( ESP_PLATFORM )
+    if (_gfx == nullptr || _gfx->touch() == nullptr) { return false; }
+    if (_int_pin >= 0) { return true; }
+    int pin = _gfx->touch()->config().pin_int;
+    if (pin < 0 || pin >= GPIO_NUM_MAX) { return false; }
+
+    auto err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) { return false; } // INVALID_STATE: already installed.
+    gpio_set_intr_type((gpio_num_t)pin, GPIO_INTR_NEGEDGE);
+    if (ESP_OK != gpio_isr_handler_add((gpio_num_t)pin, int_isr, this)) { return false; }
+    _int_pin = pin;
+    _int_pending = true;
+    gpio_intr_enable((gpio_num_t)pin);
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void Touch_Class::disableInterrupt(void)
+  {
+    if (_int_pin < 0) { return; }
+#if defined ( ESP_PLATFORM )
+    gpio_intr_disable((gpio_num_t)_int_pin);
+    gpio_isr_handler_remove((gpio_num_t)_int_pin);
+#endif
+    _int_pin = -1;
+  }
+
   void Touch_Class::update(std::uint32_t msec)
   {
     if (msec - _last_msec <= TOUCH_MIN_UPDATE_MSEC)  /// Avoid high frequency updates
@@ -19,6 +59,12 @@ namespace m5
       return;
     }
 
+    if (_int_pin >= 0)
+    { // Without a new INT signal, the controller only needs to be read until the touch is released.
+      if (!_int_pending && _detail_count == 0) { return; }
+      _int_pending = false;
+    }
+
     _last_msec = msec;
     std::size_t count = _gfx->getTouchRaw(_touch_raw, TOUCH_MAX_POINTS);
     if (!(count || _detail_count)) { return; }
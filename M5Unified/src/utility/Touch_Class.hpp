@@ -109,7 +109,21 @@ namespace m5
 
     void begin(m5gfx::LGFX_Device* gfx) { _gfx = gfx; }
     void update(std::uint32_t msec);
-    void end(void) { _gfx = nullptr; }
+    void end(void) { disableInterrupt(); _gfx = nullptr; }
+
+    /// Use the INT pin of the touch controller.
+    /// While nothing is touched, update() skips reading the controller until the INT pin signals a new touch.
+    /// @return true=success / false=the touch controller has no INT pin or not supported.
+    bool enableInterrupt(void);
+
+    /// Stop using the INT pin and read the controller on every update.
+    void disableInterrupt(void);
+
+    /// Get whether the INT pin is used.
+    bool isInterruptEnabled(void) const { return _int_pin >= 0; }
+
+    /// Returns true when the next update() will read the controller.
+    bool isUpdateRequired(void) const { return _int_pin < 0 || _int_pending || _detail_count; }
 
   protected:
     std::uint32_t _last_msec = 0;
@@ -118,8 +132,11 @@ namespace m5
     m5gfx::LGFX_Device* _gfx = nullptr;
     touch_detail_t _touch_detail[TOUCH_MAX_POINTS];
     m5gfx::touch_point_t _touch_raw[TOUCH_MAX_POINTS];
-    std::uint8_t _detail_count;
+    std::uint8_t _detail_count = 0;
+    std::int8_t _int_pin = -1;
+    volatile bool _int_pending = false;
 
+    static void int_isr(void* arg);
     bool update_detail(touch_detail_t* dt, std::uint32_t msec, bool pressed, m5gfx::touch_point_t* tp);
     bool update_detail(touch_detail_t* dt, std::uint32_t msec);
   };
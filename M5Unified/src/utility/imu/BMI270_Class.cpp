@@ -113,6 +113,58 @@ namespace m5
     return readRegister8(AUX_X_LSB_ADDR);
   }
 
+  std::uint32_t BMI270_Class::enableFifo(std::uint32_t odr_hz)
+  {
+    if (odr_hz == 0) { return 0; }
+    // ODR code 6=25Hz ... 12=1600Hz, common to accel and gyro.
+    std::uint_fast8_t code = 6;
+    while (code < 12 && (25u << (code - 6)) < odr_hz) { ++code; }
+
+    writeRegister8(ACC_CONF_ADDR, 0xA0 | code);   // filter_perf | normal bandwidth
+    writeRegister8(GYR_CONF_ADDR, 0xA0 | code);   // filter_perf | normal bandwidth
+    writeRegister8(FIFO_DOWNS_ADDR, 0x88);        // filtered data, no downsampling
+    writeRegister8(FIFO_CONFIG_0_ADDR, 0x00);     // keep the newest data when full
+    writeRegister8(FIFO_CONFIG_1_ADDR, 0xC0);     // gyro + accel, headerless frames
+    writeRegister8(CMD_REG_ADDR, FIFO_FLUSH_CMD);
+    return 25u << (code - 6);
+  }
+
+  void BMI270_Class::disableFifo(void)
+  {
+    writeRegister8(FIFO_CONFIG_1_ADDR, 0x10);     // reset value
+    writeRegister8(CMD_REG_ADDR, FIFO_FLUSH_CMD);
+  }
+
+  std::size_t BMI270_Class::getImuRawDataFifo(imu_raw_data_t* data, std::size_t max_count) const
+  {
+    static constexpr std::size_t frame_size = 12; // gyro 6 + accel 6
+    static constexpr std::size_t chunk = 8;
+
+    std::uint8_t len[2];
+    if (!readRegister(FIFO_LENGTH_0_ADDR, len, 2)) { return 0; }
+    std::size_t count = ((len[1] & 0x3F) << 8 | len[0]) / frame_size;
+    if (count > max_count) { count = max_count; }
+
+    std::int16_t buf[frame_size / 2 * chunk];
+    for (std::size_t i = 0; i < count;)
+    {
+      std::size_t n = count - i;
+      if (n > chunk) { n = chunk; }
+      if (!readRegister(FIFO_DATA_ADDR, (std::uint8_t*)buf, n * frame_size)) { return i; }
+      for (std::size_t j = 0; j < n; ++j, ++i)
+      {
+        auto b = &buf[j * frame_size / 2];
+        data[i].gyro.x  = b[0];
+        data[i].gyro.y  = b[1];
+        data[i].gyro.z  = b[2];
+        data[i].accel.x = b[3];
+        data[i].accel.y = b[4];
+        data[i].accel.z = b[5];
+      }
+    }
+    return count;
+  }
+
   std::uint8_t BMI270_Class::WhoAmI(void)
   {
     return readRegister8(CHIP_ID_ADDR);
@@ -87,6 +87,10 @@ namespace m5
     void getConvertParam(imu_convert_param_t* param) const override;
     bool getTempAdc(int16_t* adc) const override;
 
+    std::uint32_t enableFifo(std::uint32_t odr_hz) override;
+    void disableFifo(void) override;
+    std::size_t getImuRawDataFifo(imu_raw_data_t* data, std::size_t max_count) const override;
+
     std::uint8_t WhoAmI(void);
 /*
     bool getAccelAdc(std::int16_t* ax, std::int16_t* ay, std::int16_t* az) const override;
@@ -81,6 +81,13 @@ namespace m5
 //*/
 
     virtual bool setINTPinActiveLogic(bool level) { (void)level; return false; }
+
+    // 加速度とジャイロをセンサ内蔵FIFOに蓄積させる。 戻り値は実際の出力データレート(Hz)、0=非対応
+    virtual std::uint32_t enableFifo(std::uint32_t odr_hz) { (void)odr_hz; return 0; }
+    virtual void disableFifo(void) {}
+
+    // FIFOに蓄積されたサンプルを古い順に最大max_count個取り出す。(加速度とジャイロのみ更新) 戻り値は取り出した数
+    virtual std::size_t getImuRawDataFifo(imu_raw_data_t* data, std::size_t max_count) const { (void)data; (void)max_count; return 0; }
   };
 }
 
@@ -122,28 +122,72 @@ namespace m5
 
     _fifo_en = true;
   }
-/*
+
   void MPU6886_Class::disableFIFO(void)
   {
     _fifo_en = false;
-    unsigned char regdata;
-    regdata = 0x00;  // Clear GYRO_FIFO_EN and ACCEL_FIFO_EN bits to zero in
-                     // FIFO Enable register
-    writeRegister8(REG_FIFO_EN, regdata);
+    writeRegister8(REG_FIFO_EN, 0x00);  // Clear GYRO_FIFO_EN and ACCEL_FIFO_EN bits
     vTaskDelay(10);
 
-    writeRegister8(REG_INT_ENABLE, regdata);
-    regdata &=
-        0xEF;  // Clear bit 4 to turn off interrupts on FIFO overflow events
+    auto regdata = readRegister8(REG_INT_ENABLE);
+    regdata &= 0xEF;  // Clear bit 4 to turn off interrupts on FIFO overflow events
     writeRegister8(REG_INT_ENABLE, regdata);
     vTaskDelay(10);
 
-    regdata = 0x00;  // Set FIFO_EN bit to zero in User Control register to
-                     // dsiable FIFO mode
-    writeRegister8(REG_USER_CTRL, regdata);
+    writeRegister8(REG_USER_CTRL, 0x04);  // Reset the FIFO and leave FIFO mode
     vTaskDelay(10);
   }
-//*/
+
+  std::uint32_t MPU6886_Class::enableFifo(std::uint32_t odr_hz)
+  {
+    if (odr_hz == 0) { return 0; }
+    // the sample rate divider counts from the 1kHz internal rate (DLPF enabled)
+    std::uint32_t div = 1000 / odr_hz;
+    if (div) { --div; }
+    if (div > 255) { div = 255; }
+    enableFIFO((Fodr)div);
+    return 1000 / (div + 1);
+  }
+
+  std::size_t MPU6886_Class::getImuRawDataFifo(imu_raw_data_t* data, std::size_t max_count) const
+  {
+    static constexpr std::size_t packet_size = 14; // accel 6 + temp 2 + gyro 6
+    static constexpr std::size_t chunk = 8;
+
+    if (!_fifo_en) { return 0; }
+
+    std::uint8_t buf[packet_size * chunk];
+    if (!readRegister(REG_INT_STATUS, buf, 1)) { return 0; }
+    bool overflow = buf[0] & 0x10;
+    if (!readRegister(REG_FIFO_COUNTH, buf, 2)) { return 0; }
+    std::size_t bytes = (buf[0] & 0x1F) << 8 | buf[1];
+    if (overflow || (bytes % packet_size))
+    { // the oldest data has been overwritten and the packets are no longer aligned. start over.
+      writeRegister8(REG_USER_CTRL, 0x44);
+      return 0;
+    }
+
+    std::size_t count = bytes / packet_size;
+    if (count > max_count) { count = max_count; }
+    for (std::size_t i = 0; i < count;)
+    {
+      std::size_t n = count - i;
+      if (n > chunk) { n = chunk; }
+      if (!readRegister(REG_FIFO_R_W, buf, n * packet_size)) { return i; }
+      for (std::size_t j = 0; j < n; ++j, ++i)
+      {
+        auto b = &buf[j * packet_size];
+        data[i].accel.x = (std::int16_t)((b[ 0] << 8) + b[ 1]);
+        data[i].accel.y = (std::int16_t)((b[ 2] << 8) + b[ 3]);
+        data[i].accel.z = (std::int16_t)((b[ 4] << 8) + b[ 5]);
+        data[i].gyro.x  = (std::int16_t)((b[ 8] << 8) + b[ 9]);
+        data[i].gyro.y  = (std::int16_t)((b[10] << 8) + b[11]);
+        data[i].gyro.z  = (std::int16_t)((b[12] << 8) + b[13]);
+      }
+    }
+    return count;
+  }
+
   void MPU6886_Class::setGyroFsr(Gscale scale)
   {
     scale = (Gscale)(scale & 3);
@@ -20,6 +20,7 @@ namespace m5
     static constexpr const std::uint8_t REG_SMPLRT_DIV       = 0x19;
     static constexpr const std::uint8_t REG_INT_PIN_CFG      = 0x37;
     static constexpr const std::uint8_t REG_INT_ENABLE       = 0x38;
+    static constexpr const std::uint8_t REG_INT_STATUS       = 0x3A;
     static constexpr const std::uint8_t REG_ACCEL_XOUT_H     = 0x3B;
     static constexpr const std::uint8_t REG_ACCEL_XOUT_L     = 0x3C;
     static constexpr const std::uint8_t REG_ACCEL_YOUT_H     = 0x3D;
@@ -97,7 +98,11 @@ namespace m5
     bool getTemp(float* t) const override;
 //*/
     void enableFIFO(Fodr output_data_rate);
-    // void disableFIFO(void);
+    void disableFIFO(void);
+
+    std::uint32_t enableFifo(std::uint32_t odr_hz) override;
+    void disableFifo(void) override { disableFIFO(); }
+    std::size_t getImuRawDataFifo(imu_raw_data_t* data, std::size_t max_count) const override;
 
     bool setGyroAdcOffset(std::int16_t gx, std::int16_t gy, std::int16_t gz);
     bool setINTPinActiveLogic(bool level) override;
@@ -5,6 +5,8 @@ const uint8_t HARDWARE_VERSION_CMD[] = {0xBB, 0x00, 0x03, 0x00, 0x01, 0x00, 0x04
 const uint8_t POLLING_ONCE_CMD[] = {0xBB, 0x00, 0x22, 0x00, 0x00, 0x22, 0x7E};
 // Multiple polling instructions 多次轮询指令
 const uint8_t POLLING_MULTIPLE_CMD[] = {0xBB, 0x00, 0x27, 0x00, 0x03, 0x22, 0x27, 0x10, 0x83, 0x7E};
+// Stop multiple polling instruction 停止多次轮询指令
+const uint8_t STOP_POLLING_MULTIPLE_CMD[] = {0xBB, 0x00, 0x28, 0x00, 0x00, 0x28, 0x7E};
 // Set the SELECT mode 设置Select模式
 const uint8_t SET_SELECT_MODE_CMD[] = {0xBB, 0x00, 0x12, 0x00, 0x01, 0x01, 0x14, 0x7E};
 // Set the SELECT parameter instruction 设置Select参数指令
@@ -389,3 +389,198 @@ bool Unit_UHF_RFID::setTxPower(uint16_t db) {
         return false;
     }
 }
+
+/*! @brief Start a multiple polling inventory and parse its frames as they
+    arrive. On cores that support it the parser runs from the serial receive
+    event, otherwise call pollInventory() from loop().
+*/
+void Unit_UHF_RFID::startInventory(uint16_t polling_count) {
+    clearTags();
+    memcpy(buffer, POLLING_MULTIPLE_CMD, sizeof(POLLING_MULTIPLE_CMD));
+    buffer[6] = (polling_count >> 8) & 0xff;
+    buffer[7] = (polling_count) & 0xff;
+
+    uint8_t check = 0;
+    for (uint8_t i = 1; i < 8; i++) {
+        check += buffer[i];
+    }
+    buffer[8] = check & 0xff;
+
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 2
+    _serial->onReceive([this]() { pollInventory(); });
+#endif
+    sendCMD(buffer, sizeof(POLLING_MULTIPLE_CMD));
+}
+
+/*! @brief Stop the inventory started by startInventory(). The collected tags
+    are kept until the next startInventory() or clearTags().*/
+void Unit_UHF_RFID::stopInventory() {
+    sendCMD((uint8_t *)STOP_POLLING_MULTIPLE_CMD, sizeof(STOP_POLLING_MULTIPLE_CMD));
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 2
+    _serial->onReceive(NULL);
+#endif
+    delay(20);
+    pollInventory();
+    while (_serial->available()) {  // stop response
+        _serial->read();
+    }
+    _frame_len = 0;
+}
+
+/*! @brief Parse whatever the serial port has received so far.*/
+void Unit_UHF_RFID::pollInventory() {
+    uint8_t data[64];
+    size_t n;
+    while ((n = _serial->available()) > 0) {
+        n = _serial->readBytes(data, n < sizeof(data) ? n : sizeof(data));
+        feed(data, n);
+    }
+}
+
+/*! @brief Incremental frame parser, can be fed with any split of the byte
+    stream (e.g. from a custom UART interrupt or DMA handler).*/
+void Unit_UHF_RFID::feed(const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        uint8_t b = data[i];
+        if (_frame_len == 0 && b != 0xbb) {
+            continue;  // resync on the next header
+        }
+        _frame[_frame_len++] = b;
+        if (_frame_len == 5) {
+            _frame_size = ((_frame[3] << 8) | _frame[4]) + 7;
+            if (_frame_size > UHF_FRAME_MAX_SIZE) {
+                _stats.bad_frames++;
+                _frame_len = 0;
+            }
+        } else if (_frame_len > 5 && _frame_len == _frame_size) {
+            uint8_t check = 0;
+            for (uint16_t j = 1; j < _frame_size - 2; j++) {
+                check += _frame[j];
+            }
+            if (_frame[_frame_size - 1] == 0x7e && _frame[_frame_size - 2] == check) {
+                _stats.frames++;
+                parseFrame();
+            } else {
+                _stats.bad_frames++;
+            }
+            _frame_len = 0;
+        }
+    }
+}
+
+/*! @brief Handle a complete, verified frame.*/
+void Unit_UHF_RFID::parseFrame() {
+    uint16_t pl = _frame_size - 7;
+    // notification: BB 02 22 PL(2) RSSI PC(2) EPC(n) CRC(2) checksum 7E
+    if (_frame[1] != 0x02 || _frame[2] != 0x22 || pl < 5) {
+        return;
+    }
+    uint8_t len = pl - 5;
+    if (len > UHF_TAG_EPC_SIZE) {
+        len = UHF_TAG_EPC_SIZE;
+    }
+    _stats.reads++;
+    addTag(&_frame[8], len, &_frame[6], (int8_t)_frame[5]);
+}
+
+/*! @brief First slot to probe for an EPC (FNV-1a hash).*/
+static uint16_t tagSlot(const uint8_t *epc, uint8_t len) {
+    uint32_t hash = 2166136261u;
+    for (uint8_t i = 0; i < len; i++) {
+        hash = (hash ^ epc[i]) * 16777619u;
+    }
+    return hash & (UHF_TAG_TABLE_SIZE - 1);
+}
+
+/*! @brief Insert or update a tag in the hash set.*/
+void Unit_UHF_RFID::addTag(const uint8_t *epc, uint8_t len, const uint8_t *pc, int8_t rssi) {
+    uint16_t slot = tagSlot(epc, len);
+    uint32_t now  = millis();
+
+    portENTER_CRITICAL(&_tag_lock);
+    while (_tags[slot].count) {
+        UHF_TAG *tag = &_tags[slot];
+        if (tag->epc_len == len && memcmp(tag->epc, epc, len) == 0) {
+            tag->count++;
+            tag->rssi      = rssi;
+            tag->last_seen = now;
+            if (rssi > tag->rssi_max) {
+                tag->rssi_max = rssi;
+            }
+            portEXIT_CRITICAL(&_tag_lock);
+            return;
+        }
+        slot = (slot + 1) & (UHF_TAG_TABLE_SIZE - 1);
+    }
+    if (_tag_count >= UHF_TAG_TABLE_SIZE * 3 / 4) {
+        _stats.dropped++;
+    } else {
+        UHF_TAG *tag = &_tags[slot];
+        memcpy(tag->epc, epc, len);
+        tag->epc_len    = len;
+        tag->pc[0]      = pc[0];
+        tag->pc[1]      = pc[1];
+        tag->rssi       = rssi;
+        tag->rssi_max   = rssi;
+        tag->count      = 1;
+        tag->first_seen = now;
+        tag->last_seen  = now;
+        _tag_order[_tag_count++] = slot;
+    }
+    portEXIT_CRITICAL(&_tag_lock);
+}
+
+/*! @brief Forget all inventoried tags and reset the statistics.*/
+void Unit_UHF_RFID::clearTags() {
+    portENTER_CRITICAL(&_tag_lock);
+    for (uint16_t i = 0; i < _tag_count; i++) {
+        _tags[_tag_order[i]].count = 0;
+    }
+    _tag_count = 0;
+    _stats     = {};
+    portEXIT_CRITICAL(&_tag_lock);
+}
+
+/*! @brief Number of distinct tags seen.*/
+uint16_t Unit_UHF_RFID::tagCount() {
+    return _tag_count;
+}
+
+/*! @brief Copy the index-th tag, in order of first read.
+    @return False if index is out of range.*/
+bool Unit_UHF_RFID::getTag(uint16_t index, UHF_TAG *tag) {
+    bool found = false;
+    portENTER_CRITICAL(&_tag_lock);
+    if (index < _tag_count) {
+        *tag  = _tags[_tag_order[index]];
+        found = true;
+    }
+    portEXIT_CRITICAL(&_tag_lock);
+    return found;
+}
+
+/*! @brief Look a tag up by EPC.
+    @return False if the tag has not been seen.*/
+bool Unit_UHF_RFID::findTag(const uint8_t *epc, uint8_t len, UHF_TAG *tag) {
+    uint16_t slot = tagSlot(epc, len);
+    bool found    = false;
+    portENTER_CRITICAL(&_tag_lock);
+    while (_tags[slot].count) {
+        if (_tags[slot].epc_len == len && memcmp(_tags[slot].epc, epc, len) == 0) {
+            *tag  = _tags[slot];
+            found = true;
+            break;
+        }
+        slot = (slot + 1) & (UHF_TAG_TABLE_SIZE - 1);
+    }
+    portEXIT_CRITICAL(&_tag_lock);
+    return found;
+}
+
+/*! @brief Parser and table statistics since the last clearTags().*/
+UHF_INVENTORY_STATS Unit_UHF_RFID::inventoryStats() {
+    portENTER_CRITICAL(&_tag_lock);
+    UHF_INVENTORY_STATS stats = _stats;
+    portEXIT_CRITICAL(&_tag_lock);
+    return stats;
+}
@@ -17,6 +17,39 @@ Header Type Command PL(MSB) PL(LSB) Parameter Checksum End
 
 */
 
+// Inventory tag table, an open-addressing hash set keyed by EPC. The size
+// must be a power of two; new tags are dropped once it is 3/4 full.
+#ifndef UHF_TAG_TABLE_SIZE
+#define UHF_TAG_TABLE_SIZE 512
+#endif
+
+#ifndef UHF_TAG_EPC_SIZE
+#define UHF_TAG_EPC_SIZE 12
+#endif
+
+// largest frame the inventory parser accepts
+#ifndef UHF_FRAME_MAX_SIZE
+#define UHF_FRAME_MAX_SIZE 64
+#endif
+
+struct UHF_TAG {
+    uint8_t epc[UHF_TAG_EPC_SIZE];
+    uint8_t epc_len;
+    uint8_t pc[2];
+    int8_t rssi;      // last read, dBm
+    int8_t rssi_max;  // strongest read, dBm
+    uint32_t count;   // number of reads
+    uint32_t first_seen;  // millis()
+    uint32_t last_seen;   // millis()
+};
+
+struct UHF_INVENTORY_STATS {
+    uint32_t frames;      // valid frames parsed
+    uint32_t reads;       // tag notifications
+    uint32_t bad_frames;  // checksum, end marker or length errors
+    uint32_t dropped;     // new tags not stored because the table is full
+};
+
 struct CARD {
     uint8_t rssi;
     uint8_t pc[2];
@@ -36,6 +69,17 @@ class Unit_UHF_RFID {
     bool saveCardInfo(CARD *card);
     bool filterCardInfo(String epc);
 
+    void parseFrame();
+    void addTag(const uint8_t *epc, uint8_t len, const uint8_t *pc, int8_t rssi);
+    uint8_t _frame[UHF_FRAME_MAX_SIZE];
+    uint16_t _frame_len  = 0;
+    uint16_t _frame_size = 0;
+    UHF_TAG _tags[UHF_TAG_TABLE_SIZE] = {};
+    uint16_t _tag_order[UHF_TAG_TABLE_SIZE];  // table slots in order of first read
+    uint16_t _tag_count = 0;
+    UHF_INVENTORY_STATS _stats = {};
+    portMUX_TYPE _tag_lock = portMUX_INITIALIZER_UNLOCKED;
+
    public:
     bool _debug;
     uint8_t buffer[256] = {0};
@@ -52,6 +96,19 @@ class Unit_UHF_RFID {
     bool setTxPower(uint16_t db);
     bool writeCard(uint8_t *data, size_t size, uint8_t membank, uint16_t sa, uint32_t access_password = 0);
     bool readCard(uint8_t *data, size_t size, uint8_t membank, uint16_t sa, uint32_t access_password = 0);
+
+    // Streaming inventory: frames are parsed as they arrive and every tag is
+    // kept once with its read statistics. Stop the inventory before using
+    // the other commands, they read the same serial port.
+    void startInventory(uint16_t polling_count = 0xffff);
+    void stopInventory();
+    void pollInventory();
+    void feed(const uint8_t *data, size_t size);
+    void clearTags();
+    uint16_t tagCount();
+    bool getTag(uint16_t index, UHF_TAG *tag);
+    bool findTag(const uint8_t *epc, uint8_t len, UHF_TAG *tag);
+    UHF_INVENTORY_STATS inventoryStats();
 };
 
 #endif
\ No newline at end of file
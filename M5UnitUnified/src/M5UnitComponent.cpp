@@ -138,6 +138,7 @@ bool Component::selectChannel(const uint8_t ch)
 
 m5::hal::error::error_t Component::readWithTransaction(uint8_t* data, const size_t len)
 {
+    AsyncBus::Guard guard(asyncBus());
     selectChannel(channel());
     auto r = _adapter->readWithTransaction(data, len);
     return r;
@@ -145,6 +146,7 @@ m5::hal::error::error_t Component::readWithTransaction(uint8_t* data, const size
 
 m5::hal::error::error_t Component::writeWithTransaction(const uint8_t* data, const size_t len, const bool stop)
 {
+    AsyncBus::Guard guard(asyncBus());
     selectChannel(channel());
     return _adapter->writeWithTransaction(data, len, stop);
 }
@@ -155,6 +157,7 @@ template <typename Reg,
 m5::hal::error::error_t Component::writeWithTransaction(const Reg reg, const uint8_t* data, const size_t len,
                                                         const bool stop)
 {
+    AsyncBus::Guard guard(asyncBus());
     selectChannel(channel());
     return _adapter->writeWithTransaction(reg, data, len, stop);
 }
@@ -225,9 +228,90 @@ bool Component::writeRegister16(const Reg reg, const uint16_t value, const bool
 
 bool Component::generalCall(const uint8_t* data, const size_t len)
 {
+    AsyncBus::Guard guard(asyncBus());
     return _adapter->generalCall(data, len) == m5::hal::error::error_t::OK;
 }
 
+void Component::setAsyncBus(AsyncBus* bus)
+{
+    _adapter->setAsyncBus(bus);
+    auto it = childBegin();
+    while (it != childEnd()) {
+        it->setAsyncBus(bus);
+        ++it;
+    }
+}
+
+m5::hal::error::error_t Component::submit_async(const AsyncBus::request_t& req)
+{
+    auto bus = asyncBus();
+    return bus ? bus->submit(req) : AsyncBus::run(req);
+}
+
+m5::hal::error::error_t Component::readWithTransactionAsync(uint8_t* data, const size_t len,
+                                                            AsyncBus::callback_t callback, void* arg)
+{
+    AsyncBus::request_t req{};
+    req.unit     = this;
+    req.op       = AsyncBus::Operation::Read;
+    req.rbuf     = data;
+    req.len      = len;
+    req.callback = callback;
+    req.arg      = arg;
+    return submit_async(req);
+}
+
+m5::hal::error::error_t Component::writeWithTransactionAsync(const uint8_t* data, const size_t len,
+                                                             AsyncBus::callback_t callback, void* arg)
+{
+    AsyncBus::request_t req{};
+    req.unit     = this;
+    req.op       = AsyncBus::Operation::Write;
+    req.wbuf     = data;
+    req.len      = len;
+    req.callback = callback;
+    req.arg      = arg;
+    return submit_async(req);
+}
+
+template <typename Reg,
+          typename std::enable_if<std::is_integral<Reg>::value && std::is_unsigned<Reg>::value && sizeof(Reg) <= 2,
+                                  std::nullptr_t>::type>
+m5::hal::error::error_t Component::writeRegisterAsync(const Reg reg, const uint8_t* buf, const size_t len,
+                                                      AsyncBus::callback_t callback, void* arg)
+{
+    AsyncBus::request_t req{};
+    req.unit     = this;
+    req.op       = AsyncBus::Operation::WriteRegister;
+    req.reg16    = (sizeof(Reg) == 2);
+    req.reg      = reg;
+    req.wbuf     = buf;
+    req.len      = len;
+    req.callback = callback;
+    req.arg      = arg;
+    return submit_async(req);
+}
+
+template <typename Reg,
+          typename std::enable_if<std::is_integral<Reg>::value && std::is_unsigned<Reg>::value && sizeof(Reg) <= 2,
+                                  std::nullptr_t>::type>
+m5::hal::error::error_t Component::readRegisterAsync(const Reg reg, uint8_t* rbuf, const size_t len,
+                                                     const uint32_t delayMillis, AsyncBus::callback_t callback,
+                                                     void* arg)
+{
+    AsyncBus::request_t req{};
+    req.unit     = this;
+    req.op       = AsyncBus::Operation::ReadRegister;
+    req.reg16    = (sizeof(Reg) == 2);
+    req.reg      = reg;
+    req.rbuf     = rbuf;
+    req.len      = len;
+    req.delay    = delayMillis;
+    req.callback = callback;
+    req.arg      = arg;
+    return submit_async(req);
+}
+
 bool Component::changeAddress(const uint8_t addr)
 {
     if (m5::utility::isValidI2CAddress(addr)) {
@@ -266,5 +350,14 @@ template m5::hal::error::error_t Component::writeWithTransaction<uint8_t>(const
 template m5::hal::error::error_t Component::writeWithTransaction<uint16_t>(const uint16_t reg, const uint8_t* data,
                                                                            const size_t len, const bool stop);
 
+template m5::hal::error::error_t Component::writeRegisterAsync<uint8_t>(const uint8_t, const uint8_t*, const size_t,
+                                                                        AsyncBus::callback_t, void*);
+template m5::hal::error::error_t Component::writeRegisterAsync<uint16_t>(const uint16_t, const uint8_t*,
+                                                                         const size_t, AsyncBus::callback_t, void*);
+template m5::hal::error::error_t Component::readRegisterAsync<uint8_t>(const uint8_t, uint8_t*, const size_t,
+                                                                       const uint32_t, AsyncBus::callback_t, void*);
+template m5::hal::error::error_t Component::readRegisterAsync<uint16_t>(const uint16_t, uint8_t*, const size_t,
+                                                                        const uint32_t, AsyncBus::callback_t, void*);
+
 }  // namespace unit
 }  // namespace m5
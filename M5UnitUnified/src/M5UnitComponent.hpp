@@ -12,6 +12,7 @@
 
 #include "m5_unit_component/types.hpp"
 #include "m5_unit_component/adapter.hpp"
+#include "m5_unit_component/async_bus.hpp"
 #include <cstdint>
 #include <vector>
 #include <algorithm>
@@ -340,6 +341,40 @@ public:
     bool writeRegister16(const Reg reg, const uint16_t value, const bool stop = true);
     ///@}
 
+    /*!
+      @name Asynchronous Read/Write
+      @brief Queue the transaction to the attached AsyncBus
+      @retval ASYNC_RUNNING Queued, the callback will be called from the bus task
+      @retval TIMEOUT_ERROR The queue is full
+      @retval Other Executed synchronously (AsyncBus not attached or not running)
+      @warning The buffers and arg must stay valid until the callback is called
+     */
+    ///@{
+    //! @brief Attach the bus task to this unit and its children (nullptr to detach)
+    void setAsyncBus(AsyncBus* bus);
+    //! @brief Gets the attached bus task
+    inline AsyncBus* asyncBus() const
+    {
+        return _adapter->asyncBus();
+    }
+    m5::hal::error::error_t readWithTransactionAsync(uint8_t* data, const size_t len,
+                                                     AsyncBus::callback_t callback = nullptr, void* arg = nullptr);
+    m5::hal::error::error_t writeWithTransactionAsync(const uint8_t* data, const size_t len,
+                                                      AsyncBus::callback_t callback = nullptr, void* arg = nullptr);
+    template <typename Reg,
+              typename std::enable_if<std::is_integral<Reg>::value && std::is_unsigned<Reg>::value && sizeof(Reg) <= 2,
+                                      std::nullptr_t>::type = nullptr>
+    m5::hal::error::error_t writeRegisterAsync(const Reg reg, const uint8_t* buf, const size_t len,
+                                               AsyncBus::callback_t callback = nullptr, void* arg = nullptr);
+    //! @note Including the delay between the write and the read, which no longer blocks the caller
+    template <typename Reg,
+              typename std::enable_if<std::is_integral<Reg>::value && std::is_unsigned<Reg>::value && sizeof(Reg) <= 2,
+                                      std::nullptr_t>::type = nullptr>
+    m5::hal::error::error_t readRegisterAsync(const Reg reg, uint8_t* rbuf, const size_t len,
+                                              const uint32_t delayMillis, AsyncBus::callback_t callback = nullptr,
+                                              void* arg = nullptr);
+    ///@}
+
 protected:
     // Proper implementation in derived classes is required
     virtual const char* unit_device_name() const = 0;
@@ -367,6 +402,7 @@ protected:
         return _component_cfg.stored_size;
     }
     bool add_child(Component* c);
+    m5::hal::error::error_t submit_async(const AsyncBus::request_t& req);
     bool changeAddress(const uint8_t addr);  // Functions for dynamically addressable devices
 
 protected:
@@ -9,6 +9,33 @@
 */
 #include "M5UnitUnified.hpp"
 #include <M5Utility.hpp>
+#include <algorithm>
+
+namespace {
+using m5::unit::Component;
+using m5::unit::types::elapsed_time_t;
+
+// a is after b (wrap around safe)
+inline bool is_after(const elapsed_time_t a, const elapsed_time_t b)
+{
+    return (long)(a - b) > 0;
+}
+
+elapsed_time_t next_deadline(const Component* u, const elapsed_time_t now)
+{
+    auto itv = u->interval();
+    if (!itv) {
+        return now;
+    }
+    auto next = u->updatedMillis() + itv;
+    if (!u->updatedMillis() || !is_after(next, now)) {
+        // Data is not ready yet, retry at a fraction of the interval
+        next = now + std::max<elapsed_time_t>(1, itv >> 4);
+    }
+    return next;
+}
+
+}  // namespace
 
 namespace m5 {
 namespace unit {
@@ -101,6 +128,7 @@ bool UnitUnified::add_children(Component& u)
 
 bool UnitUnified::begin()
 {
+    _schedule_dirty = true;
     return !std::any_of(_units.begin(), _units.end(), [](Component* c) {
         M5_LIB_LOGV("Try begin:%s", c->deviceName());
         bool ret = c->_begun = c->begin();
@@ -114,12 +142,117 @@ bool UnitUnified::begin()
 
 void UnitUnified::update(const bool force)
 {
+    if (_scheduler && !force) {
+        update_scheduled();
+        return;
+    }
     // Order of registration
     for (auto&& u : _units) {
         if (!u->_component_cfg.self_update && u->_begun) {
             u->update(force);
         }
     }
+    if (_scheduler && !_schedule_dirty) {
+        auto now = m5::utility::millis();
+        for (auto&& s : _schedule) {
+            s.stats.next = next_deadline(s.unit, now);
+        }
+        build_schedule();
+        _schedule_due = _schedule_heap;  // All of them were called
+    }
+}
+
+void UnitUnified::setScheduler(const bool enable)
+{
+    _scheduler      = enable;
+    _schedule_dirty = true;
+}
+
+const UnitUnified::schedule_stats_t* UnitUnified::scheduleStats(const Component& u) const
+{
+    auto it = std::find_if(_schedule.begin(), _schedule.end(), [&u](const schedule_t& s) { return s.unit == &u; });
+    return it != _schedule.end() ? &it->stats : nullptr;
+}
+
+void UnitUnified::build_schedule()
+{
+    _schedule_heap.resize(_schedule.size());
+    for (uint16_t i = 0; i < _schedule_heap.size(); ++i) {
+        _schedule_heap[i] = i;
+    }
+    std::make_heap(_schedule_heap.begin(), _schedule_heap.end(), [this](const uint16_t a, const uint16_t b) {
+        return is_after(_schedule[a].stats.next, _schedule[b].stats.next);
+    });
+    _schedule_due.clear();
+}
+
+void UnitUnified::update_scheduled()
+{
+    auto later = [this](const uint16_t a, const uint16_t b) {
+        return is_after(_schedule[a].stats.next, _schedule[b].stats.next);
+    };
+
+    if (_schedule_dirty) {
+        _schedule_dirty = false;
+        _schedule.clear();
+        auto now = m5::utility::millis();
+        for (auto&& u : _units) {
+            if (!u->_component_cfg.self_update && u->_begun) {
+                _schedule.push_back({u, {}});
+                _schedule.back().stats.next = now;
+            }
+        }
+        build_schedule();
+    }
+
+    // Units called in the last update are no longer updated unless called again
+    for (auto&& idx : _schedule_due) {
+        _schedule[idx].unit->_updated = false;
+    }
+    _schedule_due.clear();
+
+    auto now = m5::utility::millis();
+    while (!_schedule_heap.empty() && !is_after(_schedule[_schedule_heap.front()].stats.next, now)) {
+        std::pop_heap(_schedule_heap.begin(), _schedule_heap.end(), later);
+        _schedule_due.push_back(_schedule_heap.back());
+        _schedule_heap.pop_back();
+    }
+    if (_schedule_due.empty()) {
+        return;
+    }
+
+    // Group by parent and channel to reduce hub channel switching, otherwise by order of registration
+    std::sort(_schedule_due.begin(), _schedule_due.end(), [this](const uint16_t a, const uint16_t b) {
+        auto ua = _schedule[a].unit;
+        auto ub = _schedule[b].unit;
+        auto pa = ua->_parent ? ua->_parent->order() : 0;
+        auto pb = ub->_parent ? ub->_parent->order() : 0;
+        if (pa != pb) {
+            return pa < pb;
+        }
+        if (ua->channel() != ub->channel()) {
+            return ua->channel() < ub->channel();
+        }
+        return ua->order() < ub->order();
+    });
+
+    for (auto&& idx : _schedule_due) {
+        auto& s  = _schedule[idx];
+        auto& st = s.stats;
+
+        st.lateness     = now - st.next;
+        st.max_lateness = std::max(st.max_lateness, st.lateness);
+
+        auto start = m5::utility::micros();
+        s.unit->update(false);
+        st.duration     = m5::utility::micros() - start;
+        st.max_duration = std::max(st.max_duration, st.duration);
+        ++st.calls;
+
+        st.next = next_deadline(s.unit, m5::utility::millis());
+        _schedule_heap.push_back(idx);
+        std::push_heap(_schedule_heap.begin(), _schedule_heap.end(), later);
+    }
 }
 
 std::string UnitUnified::debugInfo() const
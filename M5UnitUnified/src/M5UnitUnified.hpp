@@ -43,6 +43,19 @@ class UnitUnified {
 public:
     using container_type = std::vector<Component*>;
 
+    /*!
+      @struct schedule_stats_t
+      @brief Statistics of the scheduled update of a unit
+     */
+    struct schedule_stats_t {
+        types::elapsed_time_t next{};          //!< Next deadline (ms)
+        types::elapsed_time_t lateness{};      //!< Delay of the last call from the deadline (ms)
+        types::elapsed_time_t max_lateness{};  //!< Maximum of lateness (ms)
+        uint32_t duration{};                   //!< Time spent in the last update() (us)
+        uint32_t max_duration{};               //!< Maximum of duration (us)
+        uint32_t calls{};                      //!< Number of calls by the scheduler
+    };
+
     ///@warning COPY PROHIBITED
     ///@name Constructor
     ///@{
@@ -73,6 +86,28 @@ public:
     //! @brief Update of all units under management
     void update(const bool force = false);
 
+    ///@name Scheduler
+    ///@{
+    /*!
+      @brief Enable/disable the deadline-based update scheduler
+      @details When enabled, update() only calls the units whose next measurement is due
+      (updatedMillis() + interval()), and calls them grouped by parent unit and channel to reduce hub channel switching
+      @note Units with zero interval are called on every update()
+      @note updated() of a unit that was not called in the last update() is false
+     */
+    void setScheduler(const bool enable);
+    //! @brief Is the scheduler enabled?
+    inline bool isSchedulerEnabled() const
+    {
+        return _scheduler;
+    }
+    /*!
+      @brief Gets the scheduling statistics of the unit
+      @return Pointer to the statistics, nullptr if the unit is not scheduled
+     */
+    const schedule_stats_t* scheduleStats(const Component& u) const;
+    ///@}
+
     //! @brief Output information for debug
     std::string debugInfo() const;
 
@@ -82,9 +117,21 @@ protected:
 
     std::string make_unit_info(const Component* u, const uint8_t indent = 0) const;
 
+    void build_schedule();
+    void update_scheduled();
+
 protected:
     container_type _units{};
 
+    struct schedule_t {
+        Component* unit{};
+        schedule_stats_t stats{};
+    };
+    std::vector<schedule_t> _schedule{};
+    std::vector<uint16_t> _schedule_heap{};  // Min-heap of index of _schedule by next deadline
+    std::vector<uint16_t> _schedule_due{};   // Called in the last update
+    bool _scheduler{}, _schedule_dirty{true};
+
 private:
     static uint32_t _registerCount;
 };
@@ -0,0 +1,251 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file test_benchmark.hpp
+  @brief Benchmark for UnitComponent
+  @note Depends on GoogleTest
+*/
+#ifndef M5_UNIT_COMPONENT_GOOGLETEST_BENCHMARK_HPP
+#define M5_UNIT_COMPONENT_GOOGLETEST_BENCHMARK_HPP
+
+#include "../M5UnitComponent.hpp"
+#include <M5Utility.hpp>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <cmath>
+#include <thread>
+
+namespace m5 {
+namespace unit {
+namespace googletest {
+
+/*!
+  @struct benchmark_stats_t
+  @brief Statistics of the measured durations (Unit: us)
+ */
+struct benchmark_stats_t {
+    uint32_t count{};  //!< Number of samples
+    uint32_t min{};    //!< Minimum
+    uint32_t max{};    //!< Maximum
+    uint32_t p50{};    //!< Median
+    uint32_t p90{};    //!< 90th percentile
+    uint32_t p99{};    //!< 99th percentile
+    float mean{};      //!< Mean
+    float stddev{};    //!< Standard deviation
+
+    std::string toString() const
+    {
+        return m5::utility::formatString("n:%u min:%u max:%u mean:%.1f sd:%.1f p50:%u p90:%u p99:%u", count, min,
+                                         max, mean, stddev, p50, p90, p99);
+    }
+};
+
+/*!
+  @struct benchmark_throughput_t
+  @brief Result of periodic data throughput
+ */
+struct benchmark_throughput_t {
+    uint32_t updated{};           //!< Number of times updated() was true
+    uint32_t elapsed{};           //!< Measurement time (Unit: ms)
+    float per_second{};           //!< Measured data per second
+    float expected_per_second{};  //!< Data per second expected from interval() (0 if no interval)
+    benchmark_stats_t gap{};      //!< Intervals between the updated data (Unit: us)
+
+    std::string toString() const
+    {
+        return m5::utility::formatString("updated:%u elapsed:%u rate:%.2f/s (expected:%.2f/s) gap:{%s}", updated,
+                                         elapsed, per_second, expected_per_second, gap.toString().c_str());
+    }
+};
+
+/*!
+  @brief Calculate statistics
+  @param samples Durations (Unit: us), sorted in this function
+ */
+inline benchmark_stats_t calculate_stats(std::vector<uint32_t>& samples)
+{
+    benchmark_stats_t st{};
+    if (samples.empty()) {
+        return st;
+    }
+    std::sort(samples.begin(), samples.end());
+    st.count = samples.size();
+    st.min   = samples.front();
+    st.max   = samples.back();
+
+    auto percentile = [&samples](const uint32_t p) { return samples[(samples.size() - 1) * p / 100]; };
+    st.p50          = percentile(50);
+    st.p90          = percentile(90);
+    st.p99          = percentile(99);
+
+    double sum{};
+    for (auto&& s : samples) {
+        sum += s;
+    }
+    double mean = sum / st.count;
+    double var{};
+    for (auto&& s : samples) {
+        var += (s - mean) * (s - mean);
+    }
+    st.mean   = mean;
+    st.stddev = std::sqrt(var / st.count);
+    return st;
+}
+
+/*!
+  @brief Measure the function
+  @param func Function to be measured, returns true if the sample is to be counted
+  @param iterations Number of measurements
+  @param warmup Number of calls before the measurement (not counted)
+ */
+template <typename F>
+benchmark_stats_t benchmark(F&& func, const uint32_t iterations, const uint32_t warmup = 8)
+{
+    for (uint32_t i = 0; i < warmup; ++i) {
+        func();
+    }
+    std::vector<uint32_t> samples{};
+    samples.reserve(iterations);
+    for (uint32_t i = 0; i < iterations; ++i) {
+        auto start = m5::utility::micros();
+        bool count = func();
+        auto end   = m5::utility::micros();
+        if (count) {
+            samples.push_back(end - start);
+        }
+    }
+    return calculate_stats(samples);
+}
+
+/*!
+  @brief Cost of update()
+  @param unit Unit to be measured
+  @param[out] updated Calls that updated the data (Nothing if nullptr)
+  @param[out] idle Calls that did not update the data (Nothing if nullptr)
+  @param duration Measurement time (Unit: ms)
+  @param warmup Number of calls before the measurement (not counted)
+ */
+template <class U>
+void benchmark_update(U* unit, benchmark_stats_t* updated, benchmark_stats_t* idle, const uint32_t duration,
+                      const uint32_t warmup = 8)
+{
+    static_assert(std::is_base_of<m5::unit::Component, U>::value, "U must be derived from Component");
+
+    for (uint32_t i = 0; i < warmup; ++i) {
+        unit->update();
+    }
+    std::vector<uint32_t> us{}, ui{};
+    auto timeout_at = m5::utility::millis() + duration;
+    while (m5::utility::millis() <= timeout_at) {
+        auto start = m5::utility::micros();
+        unit->update();
+        auto end = m5::utility::micros();
+        (unit->updated() ? us : ui).push_back(end - start);
+        std::this_thread::yield();
+    }
+    if (updated) {
+        *updated = calculate_stats(us);
+    }
+    if (idle) {
+        *idle = calculate_stats(ui);
+    }
+}
+
+/*!
+  @brief Bus transaction time of readRegister
+  @param unit Unit to be measured
+  @param reg Register to be read
+  @param len Length to be read
+  @param iterations Number of measurements
+  @param warmup Number of calls before the measurement (not counted)
+  @note Only successful transactions are counted
+ */
+template <class U, typename Reg>
+benchmark_stats_t benchmark_transaction(U* unit, const Reg reg, const size_t len, const uint32_t iterations = 100,
+                                        const uint32_t warmup = 8)
+{
+    static_assert(std::is_base_of<m5::unit::Component, U>::value, "U must be derived from Component");
+
+    std::vector<uint8_t> buf(len);
+    return benchmark([&unit, &reg, &buf]() { return unit->readRegister(reg, buf.data(), buf.size(), 0); },
+                     iterations, warmup);
+}
+
+/*!
+  @brief Periodic measurement data throughput
+  @param unit Unit to be measured (in periodic measurement)
+  @param duration Measurement time (Unit: ms)
+  @param warmup Number of updated data to skip before the measurement
+  @param timeout Maximum time waiting for the warmup (Unit: ms)
+ */
+template <class U>
+benchmark_throughput_t benchmark_periodic_throughput(U* unit, const uint32_t duration, const uint32_t warmup = 1,
+                                                     const uint32_t timeout = 10 * 1000)
+{
+    static_assert(std::is_base_of<m5::unit::Component, U>::value, "U must be derived from Component");
+
+    benchmark_throughput_t tp{};
+    auto itv               = unit->interval();
+    tp.expected_per_second = itv ? 1000.0f / itv : 0.0f;
+
+    uint32_t cnt{warmup};
+    auto timeout_at = m5::utility::millis() + timeout;
+    while (cnt && m5::utility::millis() <= timeout_at) {
+        unit->update();
+        if (unit->updated()) {
+            --cnt;
+        }
+        std::this_thread::yield();
+    }
+
+    std::vector<uint32_t> gaps{};
+    auto start  = m5::utility::millis();
+    auto prev   = m5::utility::micros();
+    auto end_at = start + duration;
+    while (m5::utility::millis() <= end_at) {
+        unit->update();
+        if (unit->updated()) {
+            auto now = m5::utility::micros();
+            gaps.push_back(now - prev);
+            prev = now;
+            ++tp.updated;
+        }
+        std::this_thread::yield();
+    }
+    tp.elapsed    = m5::utility::millis() - start;
+    tp.per_second = tp.elapsed ? tp.updated * 1000.0f / tp.elapsed : 0.0f;
+    if (!gaps.empty()) {
+        gaps.erase(gaps.begin());  // From the start, not between data
+    }
+    tp.gap = calculate_stats(gaps);
+    return tp;
+}
+
+/*!
+  @brief Record the statistics to the test result (XML/JSON output) and log
+  @param name Key prefix
+ */
+inline void record_benchmark(const char* name, const benchmark_stats_t& st)
+{
+    ::testing::Test::RecordProperty(std::string(name) + ".mean", (int)st.mean);
+    ::testing::Test::RecordProperty(std::string(name) + ".p99", (int)st.p99);
+    ::testing::Test::RecordProperty(std::string(name) + ".max", (int)st.max);
+    M5_LIB_LOGI("%s: %s", name, st.toString().c_str());
+}
+
+//! @brief Record the throughput to the test result (XML/JSON output) and log
+inline void record_benchmark(const char* name, const benchmark_throughput_t& tp)
+{
+    ::testing::Test::RecordProperty(std::string(name) + ".per_second_x100", (int)(tp.per_second * 100));
+    ::testing::Test::RecordProperty(std::string(name) + ".gap_max", (int)tp.gap.max);
+    M5_LIB_LOGI("%s: %s", name, tp.toString().c_str());
+}
+
+}  // namespace googletest
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -302,6 +302,7 @@ Adapter* Adapter::duplicate(const uint8_t addr)
     auto ptr = new Adapter(addr);
     if (ptr) {
         ptr->_impl.reset(_impl->duplicate(addr));
+        ptr->_async = _async;
         if (ptr->_impl) {
             return ptr;
         }
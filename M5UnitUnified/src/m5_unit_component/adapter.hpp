@@ -21,6 +21,9 @@ class TwoWire;
 
 namespace m5 {
 namespace unit {
+
+class AsyncBus;
+
 /*!
   @class Adapter
   @brief Adapters to treat M5HAL and TwoWire in the same way
@@ -61,6 +64,20 @@ public:
     //! @brief Dupicate adapter
     Adapter* duplicate(const uint8_t addr);
 
+    ///@name Asynchronous execution
+    ///@{
+    //! @brief Gets the attached bus task (nullptr if not attached)
+    inline AsyncBus* asyncBus() const
+    {
+        return _async;
+    }
+    //! @brief Attach the bus task (nullptr to detach)
+    inline void setAsyncBus(AsyncBus* bus)
+    {
+        _async = bus;
+    }
+    ///@}
+
     //! @brief write to address zero (general call)
     m5::hal::error::error_t generalCall(const uint8_t* data, const size_t len);
 
@@ -151,6 +168,7 @@ public:
 
 protected:
     std::unique_ptr<Impl> _impl{};
+    AsyncBus* _async{};
     //    Adapter* _parent{};
 };
 
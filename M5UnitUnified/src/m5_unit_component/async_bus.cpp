@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file async_bus.cpp
+  @brief Task-based asynchronous transaction execution for a bus
+*/
+#include "async_bus.hpp"
+#include "../M5UnitComponent.hpp"
+#include <M5Utility.hpp>
+
+namespace m5 {
+namespace unit {
+
+AsyncBus::~AsyncBus()
+{
+    end();
+#if defined(ESP_PLATFORM)
+    if (_mutex) {
+        vSemaphoreDelete(_mutex);
+        _mutex = nullptr;
+    }
+#endif
+}
+
+m5::hal::error::error_t AsyncBus::execute(const request_t& req)
+{
+    auto u = req.unit;
+    switch (req.op) {
+        case Operation::Read:
+            return u->readWithTransaction(req.rbuf, req.len);
+        case Operation::Write:
+            return u->writeWithTransaction(req.wbuf, req.len, req.stop);
+        case Operation::WriteRegister:
+            return req.reg16 ? u->writeWithTransaction(req.reg, req.wbuf, req.len, req.stop)
+                             : u->writeWithTransaction((uint8_t)req.reg, req.wbuf, req.len, req.stop);
+        case Operation::ReadRegister:
+            return (req.reg16 ? u->readRegister(req.reg, req.rbuf, req.len, req.delay, req.stop)
+                              : u->readRegister((uint8_t)req.reg, req.rbuf, req.len, req.delay, req.stop))
+                       ? m5::hal::error::error_t::OK
+                       : m5::hal::error::error_t::I2C_BUS_ERROR;
+        default:
+            break;
+    }
+    return m5::hal::error::error_t::INVALID_ARGUMENT;
+}
+
+m5::hal::error::error_t AsyncBus::run(const request_t& req)
+{
+    if (!req.unit) {
+        return m5::hal::error::error_t::INVALID_ARGUMENT;
+    }
+    auto ret = execute(req);
+    if (req.callback) {
+        req.callback(req.unit, ret, req.arg);
+    }
+    return ret;
+}
+
+#if defined(ESP_PLATFORM)
+
+void AsyncBus::task(void* arg)
+{
+    auto self = static_cast<AsyncBus*>(arg);
+    request_t req{};
+    while (xQueueReceive(self->_queue, &req, portMAX_DELAY) == pdTRUE) {
+        if (!req.unit) {  // Request from end()
+            break;
+        }
+        run(req);
+        --self->_pending;
+    }
+    self->_task_running = false;
+    vTaskDelete(nullptr);
+}
+
+bool AsyncBus::begin(const uint32_t queue_size, const uint32_t stack_size, const uint32_t priority,
+                     const int32_t core)
+{
+    if (_task_running) {
+        return true;
+    }
+    if (!_mutex) {
+        _mutex = xSemaphoreCreateRecursiveMutex();
+    }
+    if (!_queue) {
+        _queue = xQueueCreate(queue_size ? queue_size : 1, sizeof(request_t));
+    }
+    if (!_mutex || !_queue) {
+        M5_LIB_LOGE("Failed to allocate");
+        return false;
+    }
+
+    _task_running = true;
+    BaseType_t ret{};
+#if portNUM_PROCESSORS > 1
+    if (core >= 0 && core < portNUM_PROCESSORS) {
+        ret = xTaskCreatePinnedToCore(task, "unit_bus", stack_size, this, priority, &_task, core);
+    } else
+#endif
+    {
+        (void)core;
+        ret = xTaskCreate(task, "unit_bus", stack_size, this, priority, &_task);
+    }
+    if (ret != pdPASS) {
+        M5_LIB_LOGE("Failed to create task");
+        _task_running = false;
+        _task         = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void AsyncBus::end()
+{
+    if (!_task_running) {
+        return;
+    }
+    request_t stop{};
+    xQueueSend(_queue, &stop, portMAX_DELAY);
+    while (_task_running) {
+        vTaskDelay(1);
+    }
+    _task = nullptr;
+    vQueueDelete(_queue);
+    _queue = nullptr;
+}
+
+bool AsyncBus::isRunning() const
+{
+    return _task_running;
+}
+
+m5::hal::error::error_t AsyncBus::submit(const request_t& req, const uint32_t wait_ms)
+{
+    if (!req.unit) {
+        return m5::hal::error::error_t::INVALID_ARGUMENT;
+    }
+    // Execute synchronously if not running, or called from the callback
+    if (!_task_running || xTaskGetCurrentTaskHandle() == _task) {
+        return run(req);
+    }
+
+    ++_pending;
+    if (xQueueSend(_queue, &req, pdMS_TO_TICKS(wait_ms)) != pdTRUE) {
+        --_pending;
+        return m5::hal::error::error_t::TIMEOUT_ERROR;
+    }
+    return m5::hal::error::error_t::ASYNC_RUNNING;
+}
+
+bool AsyncBus::wait(const uint32_t timeout_ms)
+{
+    if (_task_running && xTaskGetCurrentTaskHandle() == _task) {
+        return pending() == 0;
+    }
+    auto timeout_at = m5::utility::millis() + timeout_ms;
+    while (pending() && m5::utility::millis() <= timeout_at) {
+        vTaskDelay(1);
+    }
+    return pending() == 0;
+}
+
+void AsyncBus::lock()
+{
+    if (_mutex) {
+        xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+    }
+}
+
+void AsyncBus::unlock()
+{
+    if (_mutex) {
+        xSemaphoreGiveRecursive(_mutex);
+    }
+}
+
+#else
+
+bool AsyncBus::begin(const uint32_t, const uint32_t, const uint32_t, const int32_t)
+{
+    M5_LIB_LOGW("Not supported, requests are executed synchronously");
+    return false;
+}
+
+void AsyncBus::end()
+{
+}
+
+bool AsyncBus::isRunning() const
+{
+    return false;
+}
+
+m5::hal::error::error_t AsyncBus::submit(const request_t& req, const uint32_t)
+{
+    return run(req);
+}
+
+bool AsyncBus::wait(const uint32_t)
+{
+    return true;
+}
+
+void AsyncBus::lock()
+{
+}
+
+void AsyncBus::unlock()
+{
+}
+
+#endif
+
+size_t AsyncBus::pending() const
+{
+    return _pending;
+}
+
+}  // namespace unit
+}  // namespace m5
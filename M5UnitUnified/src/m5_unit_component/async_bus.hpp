@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file async_bus.hpp
+  @brief Task-based asynchronous transaction execution for a bus
+*/
+#ifndef M5_UNIT_COMPONENT_ASYNC_BUS_HPP
+#define M5_UNIT_COMPONENT_ASYNC_BUS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <M5HAL.hpp>
+
+#if defined(ESP_PLATFORM)
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+namespace m5 {
+namespace unit {
+
+class Component;
+
+/*!
+  @class AsyncBus
+  @brief Executes queued transactions of the units on one bus (TwoWire or m5::hal::bus) in a dedicated task
+  @details Create one per physical bus and attach it with Component::setAsyncBus.
+  Component::xxxAsync requests are executed in order by the bus task and the callback is called from that task.
+  Synchronous accesses of the attached units are serialized with the bus task by the bus lock.
+  @note Without begin() (or on platforms without FreeRTOS), requests are executed synchronously by the caller
+  @warning The unit, the buffers and the arg of a request must stay valid until the callback is called
+ */
+class AsyncBus {
+public:
+    /*!
+      @brief Completion callback
+      @param unit Requesting unit
+      @param result Result of the transaction
+      @param arg Argument given at request
+     */
+    using callback_t = void (*)(Component* unit, const m5::hal::error::error_t result, void* arg);
+
+    ///@cond
+    enum class Operation : uint8_t {
+        Read,           // readWithTransaction
+        Write,          // writeWithTransaction
+        WriteRegister,  // writeWithTransaction(reg)
+        ReadRegister,   // readRegister
+    };
+    struct request_t {
+        Component* unit{};
+        Operation op{};
+        bool reg16{};
+        bool stop{true};
+        uint16_t reg{};
+        const uint8_t* wbuf{};
+        uint8_t* rbuf{};
+        size_t len{};
+        uint32_t delay{};
+        callback_t callback{};
+        void* arg{};
+    };
+    ///@endcond
+
+    AsyncBus() = default;
+    AsyncBus(const AsyncBus&)            = delete;
+    AsyncBus& operator=(const AsyncBus&) = delete;
+    ~AsyncBus();
+
+    /*!
+      @brief Start the bus task
+      @param queue_size Maximum number of pending requests
+      @param stack_size Stack size of the task
+      @param priority Priority of the task
+      @param core Core to run the task (-1: no affinity)
+      @return True if successful
+     */
+    bool begin(const uint32_t queue_size = 8, const uint32_t stack_size = 4096, const uint32_t priority = 1,
+               const int32_t core = -1);
+    //! @brief Stop the bus task after the pending requests are processed
+    void end();
+    //! @brief Is the bus task running?
+    bool isRunning() const;
+    //! @brief Number of requests queued or in progress
+    size_t pending() const;
+    //! @brief Wait until all requests are processed
+    bool wait(const uint32_t timeout_ms = 1000);
+
+    /*!
+      @brief Queue the request
+      @param req Request
+      @param wait_ms Time to wait for a free queue slot
+      @retval ASYNC_RUNNING Queued, the callback will be called from the bus task
+      @retval TIMEOUT_ERROR The queue is full
+      @retval Other Executed synchronously (not running), the callback has been called
+     */
+    m5::hal::error::error_t submit(const request_t& req, const uint32_t wait_ms = 0);
+    //! @brief Execute the request in the caller and call the callback
+    static m5::hal::error::error_t run(const request_t& req);
+
+    ///@name Bus lock (recursive)
+    ///@{
+    void lock();
+    void unlock();
+    ///@}
+
+    ///@cond
+    // Scoped bus lock, does nothing if bus is nullptr
+    class Guard {
+    public:
+        explicit Guard(AsyncBus* bus) : _bus(bus)
+        {
+            if (_bus) {
+                _bus->lock();
+            }
+        }
+        ~Guard()
+        {
+            if (_bus) {
+                _bus->unlock();
+            }
+        }
+        Guard(const Guard&)            = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        AsyncBus* _bus{};
+    };
+    ///@endcond
+
+protected:
+    static m5::hal::error::error_t execute(const request_t& req);
+
+private:
+#if defined(ESP_PLATFORM)
+    static void task(void* arg);
+
+    QueueHandle_t _queue{};
+    SemaphoreHandle_t _mutex{};
+    TaskHandle_t _task{};
+    volatile bool _task_running{};
+#endif
+    std::atomic<uint32_t> _pending{};
+};
+
+}  // namespace unit
+}  // namespace m5
+#endif
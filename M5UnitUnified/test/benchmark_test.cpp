@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for benchmark helper
+*/
+#include <gtest/gtest.h>
+#include <M5UnitComponent.hpp>
+#include <googletest/test_benchmark.hpp>
+#include "unit_dummy.hpp"
+
+using namespace m5::unit::googletest;
+
+TEST(Benchmark, Stats)
+{
+    std::vector<uint32_t> v{};
+    auto st = calculate_stats(v);
+    EXPECT_EQ(st.count, 0U);
+
+    for (uint32_t i = 100; i > 0; --i) {
+        v.push_back(i);
+    }
+    st = calculate_stats(v);
+    EXPECT_EQ(st.count, 100U);
+    EXPECT_EQ(st.min, 1U);
+    EXPECT_EQ(st.max, 100U);
+    EXPECT_EQ(st.p50, 50U);
+    EXPECT_EQ(st.p90, 90U);
+    EXPECT_EQ(st.p99, 99U);
+    EXPECT_FLOAT_EQ(st.mean, 50.5f);
+    EXPECT_NEAR(st.stddev, 28.866f, 0.01f);
+}
+
+TEST(Benchmark, Function)
+{
+    uint32_t calls{};
+    auto st = benchmark(
+        [&calls]() {
+            ++calls;
+            return (calls & 1) == 0;  // Count the even calls
+        },
+        20, 4);
+    EXPECT_EQ(calls, 24U);
+    EXPECT_EQ(st.count, 10U);
+    EXPECT_LE(st.min, st.p50);
+    EXPECT_LE(st.p50, st.max);
+}
+
+TEST(Benchmark, Update)
+{
+    m5::unit::UnitDummy u;
+    benchmark_stats_t updated{}, idle{};
+    benchmark_update(&u, &updated, &idle, 20, 4);
+    EXPECT_EQ(updated.count, 0U);  // Dummy never updates the data
+    EXPECT_GT(idle.count, 0U);
+    EXPECT_EQ(u.count, idle.count + 4);
+
+    auto tp = benchmark_periodic_throughput(&u, 10, 0);
+    EXPECT_EQ(tp.updated, 0U);
+    EXPECT_FLOAT_EQ(tp.expected_per_second, 0.0f);
+}
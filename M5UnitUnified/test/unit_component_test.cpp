@@ -78,3 +78,60 @@ TEST(Component, Children)
     }
     EXPECT_EQ(i, u0.childrenSize());
 }
+
+namespace {
+struct async_result_t {
+    m5::unit::Component* unit{};
+    m5::hal::error::error_t result{m5::hal::error::error_t::OK};
+    uint32_t count{};
+};
+void async_callback(m5::unit::Component* unit, const m5::hal::error::error_t result, void* arg)
+{
+    auto r    = static_cast<async_result_t*>(arg);
+    r->unit   = unit;
+    r->result = result;
+    ++r->count;
+}
+}  // namespace
+
+TEST(Component, Async)
+{
+    m5::unit::UnitDummy u0, u1;
+    auto cfg         = u0.component_config();
+    cfg.max_children = 1;
+    u0.component_config(cfg);
+    EXPECT_TRUE(u0.add(u1, 0));
+
+    // Not attached (executed synchronously)
+    uint8_t buf[2]{};
+    async_result_t res{};
+    EXPECT_EQ(u0.asyncBus(), nullptr);
+    auto ret = u0.readWithTransactionAsync(buf, sizeof(buf), async_callback, &res);
+    EXPECT_NE(ret, m5::hal::error::error_t::ASYNC_RUNNING);
+    EXPECT_EQ(res.count, 1U);
+    EXPECT_EQ(res.unit, &u0);
+    EXPECT_EQ(res.result, ret);
+
+    // Attached to the parent and children
+    m5::unit::AsyncBus bus;
+    u0.setAsyncBus(&bus);
+    EXPECT_EQ(u0.asyncBus(), &bus);
+    EXPECT_EQ(u1.asyncBus(), &bus);
+
+    bool running = bus.begin();
+    EXPECT_EQ(running, bus.isRunning());
+
+    res = async_result_t{};
+    ret = u1.readRegisterAsync((uint8_t)0x12, buf, sizeof(buf), 1, async_callback, &res);
+    EXPECT_EQ(ret == m5::hal::error::error_t::ASYNC_RUNNING, running);
+    EXPECT_TRUE(bus.wait());
+    EXPECT_EQ(bus.pending(), 0U);
+    EXPECT_EQ(res.count, 1U);
+    EXPECT_EQ(res.unit, &u1);
+    EXPECT_FALSE(m5::hal::error::isOk(res.result));  // Dummy adapter has no bus
+
+    bus.end();
+    EXPECT_FALSE(bus.isRunning());
+    u0.setAsyncBus(nullptr);
+    EXPECT_EQ(u1.asyncBus(), nullptr);
+}
@@ -121,3 +121,80 @@ TEST(UnitUnified, EachUnit)
     }
     vec.clear();
 }
+
+using namespace m5::utility::mmh3;
+
+namespace m5 {
+namespace unit {
+// Measures every interval like a periodic unit
+class UnitPeriodicDummy : public Component {
+    M5_UNIT_COMPONENT_HPP_BUILDER(UnitPeriodicDummy, 0x00);
+
+public:
+    explicit UnitPeriodicDummy(const types::elapsed_time_t itv) : Component(0x00)
+    {
+        _interval = itv;
+    }
+    virtual bool begin() override
+    {
+        return true;
+    }
+    virtual void update(const bool force = false) override
+    {
+        _updated = false;
+        ++calls;
+        auto at = m5::utility::millis();
+        if (force || !_latest || at >= _latest + _interval) {
+            _latest  = at;
+            _updated = true;
+        }
+    }
+    uint32_t calls{};
+};
+const char UnitPeriodicDummy::name[] = "UnitPeriodicDummy";
+const types::uid_t UnitPeriodicDummy::uid{"UnitPeriodicDummy"_mmh3};
+const types::attr_t UnitPeriodicDummy::attr{0};
+}  // namespace unit
+}  // namespace m5
+
+namespace {
+struct TestUnitUnified : public m5::unit::UnitUnified {
+    bool add(m5::unit::Component& u)
+    {
+        return UnitUnified::add(u, new m5::unit::Adapter(u.address()));
+    }
+};
+}  // namespace
+
+TEST(UnitUnified, Scheduler)
+{
+    TestUnitUnified units;
+    m5::unit::UnitPeriodicDummy u50(50), u200(200), u0(0);
+    EXPECT_TRUE(units.add(u50));
+    EXPECT_TRUE(units.add(u200));
+    EXPECT_TRUE(units.add(u0));
+    EXPECT_TRUE(units.begin());
+
+    units.setScheduler(true);
+    EXPECT_TRUE(units.isSchedulerEnabled());
+
+    uint32_t loops{}, updated200{};
+    auto start = m5::utility::millis();
+    while (m5::utility::millis() - start < 1000) {
+        units.update();
+        updated200 += u200.updated();
+        ++loops;
+        m5::utility::delay(1);
+    }
+
+    // Zero interval is called every update, others only when due
+    EXPECT_EQ(u0.calls, loops);
+    EXPECT_LE(u50.calls, 1000U / 50 + 2);
+    EXPECT_LE(u200.calls, 1000U / 200 + 2);
+    EXPECT_EQ(updated200, u200.calls);
+
+    auto st = units.scheduleStats(u200);
+    ASSERT_NE(st, nullptr);
+    EXPECT_EQ(st->calls, u200.calls);
+    EXPECT_EQ(units.scheduleStats(u0)->calls, loops);
+}
@@ -21,6 +21,7 @@
 #include "m5_utility/log/library_log.hpp"
 
 #include "m5_utility/container/circular_buffer.hpp"
+#include "m5_utility/container/lockfree_circular_buffer.hpp"
 
 #include "m5_utility/bit_segment.hpp"
 #include "m5_utility/compatibility_feature.hpp"
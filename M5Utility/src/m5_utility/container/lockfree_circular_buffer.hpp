@@ -0,0 +1,485 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file lockfree_circular_buffer.hpp
+  @brief Lock-free circular buffers with STL-like interface
+*/
+#ifndef M5_UTILITY_CONTAINER_LOCKFREE_CIRCULAR_BUFFER_HPP
+#define M5_UTILITY_CONTAINER_LOCKFREE_CIRCULAR_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include <iterator>
+#include <algorithm>
+#include <cassert>
+#if __cplusplus >= 201703L
+#include <optional>
+#else
+#include "../stl/optional.hpp"
+#endif
+
+#ifndef M5_UTILITY_CACHE_LINE_SIZE
+/*!
+  @def M5_UTILITY_CACHE_LINE_SIZE
+  @brief Size used to separate the indices written by the producer and the consumer
+ */
+#define M5_UTILITY_CACHE_LINE_SIZE (64)
+#endif
+
+namespace m5 {
+namespace container {
+
+///@cond
+namespace detail {
+
+// Round up to the power of 2
+inline size_t ceil_pow2(size_t n)
+{
+    size_t v{1};
+    while (v < n) {
+        v <<= 1;
+    }
+    return v;
+}
+
+// Atomic index that occupies a cache line by itself
+struct padded_index {
+    std::atomic<size_t> value{0};
+    uint8_t pad[M5_UTILITY_CACHE_LINE_SIZE > sizeof(std::atomic<size_t>)
+                    ? M5_UTILITY_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)
+                    : 1]{};
+};
+
+/*
+  Consumer side of the lock-free buffers (CRTP)
+  Derived must have:
+  - std::vector<T> _buf;
+  - size_t _mask;
+  - padded_index _tail;
+  - size_type size() const;
+ */
+template <class Derived, typename T>
+class LockFreeCircularBufferBase {
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using reference       = T&;
+    using const_reference = const T&;
+#if __cplusplus >= 201703L
+    using return_type = std::optional<value_type>;
+#else
+    using return_type = m5::stl::optional<value_type>;
+#endif
+
+    template <typename BT, typename VT>
+    class iterator_base {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = VT;
+        using pointer           = VT*;
+        using reference         = VT&;
+
+        iterator_base() : _buffer(nullptr), _pos(0)
+        {
+        }
+        iterator_base(BT* buf, size_t pos) : _buffer(buf), _pos(pos)
+        {
+        }
+
+        inline reference operator*() const
+        {
+            return element(_buffer, _pos);
+        }
+        inline pointer operator->() const
+        {
+            return &element(_buffer, _pos);
+        }
+        inline iterator_base& operator++()
+        {
+            ++_pos;
+            return *this;
+        }
+        inline iterator_base& operator--()
+        {
+            --_pos;
+            return *this;
+        }
+        inline iterator_base operator++(int)
+        {
+            iterator_base tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        inline iterator_base operator--(int)
+        {
+            iterator_base tmp = *this;
+            --(*this);
+            return tmp;
+        }
+        friend inline bool operator==(const iterator_base& a, const iterator_base& b)
+        {
+            return a._buffer == b._buffer && a._pos == b._pos;
+        }
+        friend inline bool operator!=(const iterator_base& a, const iterator_base& b)
+        {
+            return !(a == b);
+        }
+
+    private:
+        BT* _buffer;
+        size_t _pos;
+    };
+    using iterator               = iterator_base<Derived, T>;
+    using const_iterator         = iterator_base<const Derived, const T>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    ///@name Element access (consumer)
+    inline return_type front() const
+    {
+#if __cplusplus >= 201703L
+        return !empty() ? std::make_optional(slot(0)) : std::nullopt;
+#else
+        return !empty() ? m5::stl::make_optional(slot(0)) : m5::stl::nullopt;
+#endif
+    }
+    inline return_type back() const
+    {
+        auto sz = derived().size();
+#if __cplusplus >= 201703L
+        return sz ? std::make_optional(slot(sz - 1)) : std::nullopt;
+#else
+        return sz ? m5::stl::make_optional(slot(sz - 1)) : m5::stl::nullopt;
+#endif
+    }
+    inline const_reference operator[](size_type i) const&
+    {
+        assert(i < derived().size() && "index overflow");
+        return slot(i);
+    }
+    inline return_type at(size_type i) const
+    {
+#if __cplusplus >= 201703L
+        return (i < derived().size()) ? std::make_optional(slot(i)) : std::nullopt;
+#else
+        return (i < derived().size()) ? m5::stl::make_optional(slot(i)) : m5::stl::nullopt;
+#endif
+    }
+    size_t read(value_type* outbuf, const size_t num) const
+    {
+        size_t sz = std::min(num, derived().size());
+        for (size_t i = 0; i < sz; ++i) {
+            outbuf[i] = slot(i);
+        }
+        return sz;
+    }
+
+    ///@name Capacity
+    inline bool empty() const
+    {
+        return derived().size() == 0;
+    }
+    inline bool full() const
+    {
+        return derived().size() == capacity();
+    }
+    inline size_type capacity() const
+    {
+        return derived()._mask + 1;
+    }
+
+    ///@name Iterator (consumer)
+    inline iterator begin() noexcept
+    {
+        return iterator(&derived(), tail());
+    }
+    inline iterator end() noexcept
+    {
+        return iterator(&derived(), tail() + derived().size());
+    }
+    inline const_iterator cbegin() const noexcept
+    {
+        return const_iterator(&derived(), tail());
+    }
+    inline const_iterator cend() const noexcept
+    {
+        return const_iterator(&derived(), tail() + derived().size());
+    }
+    inline reverse_iterator rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+    inline reverse_iterator rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+    inline const_reverse_iterator crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+    inline const_reverse_iterator crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+protected:
+    inline Derived& derived()
+    {
+        return *static_cast<Derived*>(this);
+    }
+    inline const Derived& derived() const
+    {
+        return *static_cast<const Derived*>(this);
+    }
+    inline size_t tail() const
+    {
+        return derived()._tail.value.load(std::memory_order_relaxed);
+    }
+    inline const_reference slot(const size_t i) const
+    {
+        return element(&derived(), tail() + i);
+    }
+    template <class B>
+    static inline auto element(B* b, const size_t pos) -> decltype(b->_buf[pos])
+    {
+        return b->_buf[pos & b->_mask];
+    }
+};
+
+}  // namespace detail
+///@endcond
+
+/*!
+  @class SPSCCircularBuffer
+  @brief Lock-free circular buffer for single producer and single consumer
+  @details The producer (e.g. ISR or bus task) and the consumer (e.g. loop) can run concurrently on any core
+  without locks. Producer side: push_back. Consumer side: everything else.
+  @tparam T Type of the element (Should be trivially copyable)
+  @note Capacity is rounded up to the power of 2
+  @warning Unlike CircularBuffer, push_back fails if full instead of overwriting the oldest element
+  (the producer cannot discard what the consumer may be reading). The consumer should discard it if needed.
+ */
+template <typename T>
+class SPSCCircularBuffer : public detail::LockFreeCircularBufferBase<SPSCCircularBuffer<T>, T> {
+    using base_type = detail::LockFreeCircularBufferBase<SPSCCircularBuffer<T>, T>;
+
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using const_reference = const T&;
+
+    ///@name Constructor
+    ///@{
+    SPSCCircularBuffer() = delete;
+    explicit SPSCCircularBuffer(const size_t n)
+    {
+        assert(n != 0 && "Illegal size");
+        auto cap = detail::ceil_pow2(n);
+        _mask    = cap - 1;
+        _buf.resize(cap);
+    }
+    SPSCCircularBuffer(const SPSCCircularBuffer&)            = delete;
+    SPSCCircularBuffer& operator=(const SPSCCircularBuffer&) = delete;
+    ///@}
+
+    /*!
+      @brief returns the number of elements
+      @note Exact in the consumer, may be smaller than actual in the producer
+    */
+    inline size_type size() const
+    {
+        return _head.value.load(std::memory_order_acquire) - _tail.value.load(std::memory_order_acquire);
+    }
+
+    ///@name Modifiers
+    ///@{
+    /*!
+      @brief Adds an element to the end (producer)
+      @return True if successful, false if full
+    */
+    bool push_back(const value_type& v)
+    {
+        auto head = _head.value.load(std::memory_order_relaxed);
+        if (head - _tail.value.load(std::memory_order_acquire) > _mask) {
+            return false;
+        }
+        _buf[head & _mask] = v;
+        _head.value.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    //! @brief removes the top element (consumer)
+    inline void pop_front()
+    {
+        auto tail = _tail.value.load(std::memory_order_relaxed);
+        if (_head.value.load(std::memory_order_acquire) != tail) {
+            _tail.value.store(tail + 1, std::memory_order_release);
+        }
+    }
+    /*!
+      @brief Retrieve and remove the top element (consumer)
+      @return True if successful
+    */
+    bool pop_front(value_type& v)
+    {
+        auto tail = _tail.value.load(std::memory_order_relaxed);
+        if (_head.value.load(std::memory_order_acquire) == tail) {
+            return false;
+        }
+        v = _buf[tail & _mask];
+        _tail.value.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    //! @brief Clears the contents (consumer)
+    inline void clear()
+    {
+        _tail.value.store(_head.value.load(std::memory_order_acquire), std::memory_order_release);
+    }
+    ///@}
+
+private:
+    friend base_type;
+
+    std::vector<T> _buf{};
+    size_t _mask{};
+    detail::padded_index _head{};  // Written by producer
+    detail::padded_index _tail{};  // Written by consumer
+};
+
+/*!
+  @class MPSCCircularBuffer
+  @brief Lock-free circular buffer for multiple producers and single consumer
+  @details Producers (ISR, tasks on any core) reserve a slot with CAS and publish it with a per-slot sequence,
+  so a producer never waits for another one (safe even if an ISR interrupts a producing task).
+  Producer side: push_back. Consumer side: everything else.
+  @tparam T Type of the element (Should be trivially copyable)
+  @note Capacity is rounded up to the power of 2
+  @note size() counts only the elements published in order; an element whose producer is still writing stops
+  the count there until published
+  @warning Like SPSCCircularBuffer, push_back fails if full
+ */
+template <typename T>
+class MPSCCircularBuffer : public detail::LockFreeCircularBufferBase<MPSCCircularBuffer<T>, T> {
+    using base_type = detail::LockFreeCircularBufferBase<MPSCCircularBuffer<T>, T>;
+
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using const_reference = const T&;
+
+    ///@name Constructor
+    ///@{
+    MPSCCircularBuffer() = delete;
+    explicit MPSCCircularBuffer(const size_t n)
+    {
+        assert(n != 0 && "Illegal size");
+        auto cap = detail::ceil_pow2(n);
+        _mask    = cap - 1;
+        _buf.resize(cap);
+        _seq = std::vector<std::atomic<size_t>>(cap);
+        for (size_t i = 0; i < cap; ++i) {
+            _seq[i].store(i, std::memory_order_relaxed);
+        }
+    }
+    MPSCCircularBuffer(const MPSCCircularBuffer&)            = delete;
+    MPSCCircularBuffer& operator=(const MPSCCircularBuffer&) = delete;
+    ///@}
+
+    /*!
+      @brief returns the number of published elements
+      @note Valid in the consumer
+    */
+    size_type size() const
+    {
+        auto tail = _tail.value.load(std::memory_order_relaxed);
+        auto head = _head.value.load(std::memory_order_acquire);
+        size_t n{};
+        while (tail + n != head && _seq[(tail + n) & _mask].load(std::memory_order_acquire) == tail + n + 1) {
+            ++n;
+        }
+        return n;
+    }
+
+    ///@name Modifiers
+    ///@{
+    /*!
+      @brief Adds an element to the end (producer)
+      @return True if successful, false if full
+    */
+    bool push_back(const value_type& v)
+    {
+        auto head = _head.value.load(std::memory_order_relaxed);
+        for (;;) {
+            auto seq = _seq[head & _mask].load(std::memory_order_acquire);
+            auto dif = (intptr_t)seq - (intptr_t)head;
+            if (dif == 0) {
+                if (_head.value.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false;  // Full
+            } else {
+                head = _head.value.load(std::memory_order_relaxed);
+            }
+        }
+        _buf[head & _mask] = v;
+        _seq[head & _mask].store(head + 1, std::memory_order_release);
+        return true;
+    }
+    //! @brief removes the top element (consumer)
+    inline void pop_front()
+    {
+        auto tail = _tail.value.load(std::memory_order_relaxed);
+        if (_seq[tail & _mask].load(std::memory_order_acquire) == tail + 1) {
+            release(tail);
+        }
+    }
+    /*!
+      @brief Retrieve and remove the top element (consumer)
+      @return True if successful
+    */
+    bool pop_front(value_type& v)
+    {
+        auto tail = _tail.value.load(std::memory_order_relaxed);
+        if (_seq[tail & _mask].load(std::memory_order_acquire) != tail + 1) {
+            return false;
+        }
+        v = _buf[tail & _mask];
+        release(tail);
+        return true;
+    }
+    //! @brief Clears the published contents (consumer)
+    inline void clear()
+    {
+        auto n = size();
+        while (n--) {
+            pop_front();
+        }
+    }
+    ///@}
+
+private:
+    friend base_type;
+
+    inline void release(const size_t tail)
+    {
+        // Make the slot available for the producer of the next round
+        _seq[tail & _mask].store(tail + _mask + 1, std::memory_order_release);
+        _tail.value.store(tail + 1, std::memory_order_relaxed);
+    }
+
+    std::vector<T> _buf{};
+    std::vector<std::atomic<size_t>> _seq{};
+    size_t _mask{};
+    detail::padded_index _head{};  // Reserved by producers
+    detail::padded_index _tail{};  // Written by consumer
+};
+
+}  // namespace container
+}  // namespace m5
+#endif
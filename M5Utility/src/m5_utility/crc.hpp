@@ -17,6 +17,67 @@
 namespace m5 {
 namespace utility {
 
+///@cond
+namespace crc_detail {
+template <size_t... I>
+struct index_seq {};
+template <size_t N, size_t... I>
+struct make_index_seq : make_index_seq<N - 1, N - 1, I...> {};
+template <size_t... I>
+struct make_index_seq<0, I...> {
+    using type = index_seq<I...>;
+};
+
+constexpr uint8_t crc8_entry(const uint8_t crc, const uint8_t polynomial, const uint8_t bits = 8)
+{
+    return bits ? crc8_entry((crc & 0x80) ? (uint8_t)((crc << 1) ^ polynomial) : (uint8_t)(crc << 1), polynomial,
+                             bits - 1)
+                : crc;
+}
+
+constexpr uint16_t crc16_entry(const uint16_t crc, const uint16_t polynomial, const uint8_t bits = 8)
+{
+    return bits ? crc16_entry((crc & 0x8000) ? (uint16_t)((crc << 1) ^ polynomial) : (uint16_t)(crc << 1),
+                              polynomial, bits - 1)
+                : crc;
+}
+
+template <uint8_t Polynomial, typename Seq>
+struct crc8_table_impl;
+template <uint8_t Polynomial, size_t... I>
+struct crc8_table_impl<Polynomial, index_seq<I...>> {
+    static constexpr uint8_t table[sizeof...(I)] = {crc8_entry((uint8_t)I, Polynomial)...};
+};
+template <uint8_t Polynomial, size_t... I>
+constexpr uint8_t crc8_table_impl<Polynomial, index_seq<I...>>::table[sizeof...(I)];
+
+template <uint16_t Polynomial, typename Seq>
+struct crc16_table_impl;
+template <uint16_t Polynomial, size_t... I>
+struct crc16_table_impl<Polynomial, index_seq<I...>> {
+    static constexpr uint16_t table[sizeof...(I)] = {crc16_entry((uint16_t)(I << 8), Polynomial)...};
+};
+template <uint16_t Polynomial, size_t... I>
+constexpr uint16_t crc16_table_impl<Polynomial, index_seq<I...>>::table[sizeof...(I)];
+}  // namespace crc_detail
+///@endcond
+
+/*!
+  @struct CRC8Table
+  @brief Lookup table for CRC8 generated at compile-time
+  @tparam Polynomial Generated polynomial
+ */
+template <uint8_t Polynomial>
+struct CRC8Table : crc_detail::crc8_table_impl<Polynomial, typename crc_detail::make_index_seq<256>::type> {};
+
+/*!
+  @struct CRC16Table
+  @brief Lookup table for CRC16 generated at compile-time
+  @tparam Polynomial Generated polynomial
+ */
+template <uint16_t Polynomial>
+struct CRC16Table : crc_detail::crc16_table_impl<Polynomial, typename crc_detail::make_index_seq<256>::type> {};
+
 /*!
   @class CRC8
   @brief Base class of the CRC8 calculator
@@ -32,7 +93,20 @@ public:
       @param xorout Exclusive OR output
      */
     CRC8(const uint8_t init, const uint8_t polynomial, const bool refIn, const bool refOut, const uint8_t xorout)
-        : _crc{init}, _init(init), _polynomial{polynomial}, _xorout{xorout}, _refIn{refIn}, _refOut{refOut}
+        : CRC8(init, polynomial, refIn, refOut, xorout, table(polynomial))
+    {
+    }
+    /*!
+      @param init Initial value
+      @param polynormal Generated polynomial
+      @param refIn Inverted input?
+      @param refOut Inverted output?
+      @param xorout Exclusive OR output
+      @param tbl Lookup table for polynomial (e.g. CRC8Table<0x9B>::table), bitwise calculation if nullptr
+     */
+    CRC8(const uint8_t init, const uint8_t polynomial, const bool refIn, const bool refOut, const uint8_t xorout,
+         const uint8_t* tbl)
+        : _table{tbl}, _crc{init}, _init(init), _polynomial{polynomial}, _xorout{xorout}, _refIn{refIn}, _refOut{refOut}
     {
     }
     /*!
@@ -43,7 +117,8 @@ public:
      */
     inline uint8_t range(const uint8_t* data, size_t len)
     {
-        auto crc = calculate(data, len, _init, _polynomial, _refIn, _refOut, _xorout, false);
+        auto crc = _table ? calculate(data, len, _init, _table, _refIn, _refOut, _xorout, false)
+                          : calculate(data, len, _init, _polynomial, _refIn, _refOut, _xorout, false);
         return finalize(crc, _refOut, _xorout);
     }
     /*!
@@ -57,7 +132,8 @@ public:
     */
     inline uint8_t update(const uint8_t* data, size_t len)
     {
-        _crc = calculate(data, len, _crc, _polynomial, _refIn, _refOut, _xorout, false);
+        _crc = _table ? calculate(data, len, _crc, _table, _refIn, _refOut, _xorout, false)
+                      : calculate(data, len, _crc, _polynomial, _refIn, _refOut, _xorout, false);
         return finalize(_crc, _refOut, _xorout);
     }
     /*!
@@ -98,6 +174,48 @@ public:
         }
         return do_finalize ? finalize(crc, refOut, xorout) : crc;
     }
+    /*!
+      @brief Calculate CRC8 using the lookup table
+      @param data Pointer of the array
+      @param len Length of the array
+      @param tbl Lookup table for polynomial (CRC8Table<polynomial>::table)
+      @param refIn Inverted input?
+      @param refOut Inverted output?
+      @param xorout Exclusive OR output
+      @param do_finalize Apply processing to output values?(true as defaut)
+      @return CRC value
+    */
+    static uint8_t calculate(const uint8_t* data, size_t len, const uint8_t init, const uint8_t* tbl,
+                             const bool refIn, const bool refOut, const uint8_t xorout, bool do_finalize = true)
+    {
+        uint8_t crc{init};
+        if (refIn) {
+            while (len--) {
+                crc = tbl[crc ^ reverseBitOrder(*data++)];
+            }
+        } else {
+            while (len--) {
+                crc = tbl[crc ^ *data++];
+            }
+        }
+        return do_finalize ? finalize(crc, refOut, xorout) : crc;
+    }
+    /*!
+      @brief Gets the built-in lookup table
+      @return Lookup table if exists, nullptr otherwise
+      @note Tables are built in for the polynomials 0x31 (Sensirion etc.) and 0x07 (SMBus PEC)
+     */
+    static const uint8_t* table(const uint8_t polynomial)
+    {
+        switch (polynomial) {
+            case 0x31:
+                return CRC8Table<0x31>::table;
+            case 0x07:
+                return CRC8Table<0x07>::table;
+            default:
+                return nullptr;
+        }
+    }
 
 protected:
     static inline uint8_t finalize(const uint8_t value, const bool refOut, const uint8_t xorout)
@@ -106,6 +224,7 @@ protected:
     }
 
 private:
+    const uint8_t* _table{};
     uint8_t _crc{}, _init{}, _polynomial{}, _xorout{};
     bool _refIn{}, _refOut{};
 };
@@ -125,7 +244,26 @@ public:
       @param xorout Exclusive OR output
     */
     CRC16(const uint16_t init, const uint16_t polynomial, const bool refIn, const bool refOut, const uint16_t xorout)
-        : _crc{init}, _init{init}, _polynomial{polynomial}, _xorout{xorout}, _refIn{refIn}, _refOut{refOut}
+        : CRC16(init, polynomial, refIn, refOut, xorout, table(polynomial))
+    {
+    }
+    /*!
+      @param init Initial value
+      @param polynormal Generated polynomial
+      @param refIn Inverted input?
+      @param refOut Inverted output?
+      @param xorout Exclusive OR output
+      @param tbl Lookup table for polynomial (e.g. CRC16Table<0x8BB7>::table), bitwise calculation if nullptr
+    */
+    CRC16(const uint16_t init, const uint16_t polynomial, const bool refIn, const bool refOut, const uint16_t xorout,
+          const uint16_t* tbl)
+        : _table{tbl},
+          _crc{init},
+          _init{init},
+          _polynomial{polynomial},
+          _xorout{xorout},
+          _refIn{refIn},
+          _refOut{refOut}
     {
     }
     /*!
@@ -136,7 +274,8 @@ public:
      */
     inline uint16_t range(const uint8_t* data, size_t len)
     {
-        auto crc = calculate(data, len, _init, _polynomial, _refIn, _refOut, _xorout, false);
+        auto crc = _table ? calculate(data, len, _init, _table, _refIn, _refOut, _xorout, false)
+                          : calculate(data, len, _init, _polynomial, _refIn, _refOut, _xorout, false);
         return finalize(crc, _refOut, _xorout);
     }
     /*!
@@ -150,7 +289,8 @@ public:
     */
     inline uint16_t update(const uint8_t* data, size_t len)
     {
-        _crc = calculate(data, len, _crc, _polynomial, _refIn, _refOut, _xorout, false);
+        _crc = _table ? calculate(data, len, _crc, _table, _refIn, _refOut, _xorout, false)
+                      : calculate(data, len, _crc, _polynomial, _refIn, _refOut, _xorout, false);
         return finalize(_crc, _refOut, _xorout);
     }
     /*!
@@ -191,6 +331,44 @@ public:
         }
         return do_finalize ? finalize(crc, refOut, xorout) : crc;
     }
+    /*!
+      @brief Calculate CRC16 using the lookup table
+      @param data Pointer of the array
+      @param len Length of the array
+      @param tbl Lookup table for polynomial (CRC16Table<polynomial>::table)
+      @param refIn Inverted input?
+      @param refOut Inverted output?
+      @param xorout Exclusive OR output
+      @param do_finalize Apply processing to output values?(true as defaut)
+      @return CRC value
+    */
+    static uint16_t calculate(const uint8_t* data, size_t len, const uint16_t init, const uint16_t* tbl,
+                              const bool refIn, const bool refOut, const uint16_t xorout, bool do_finalize = true)
+    {
+        uint16_t crc{init};
+        while (len--) {
+            uint8_t e{refIn ? reverseBitOrder(*data) : *data};
+            ++data;
+            crc = (uint16_t)(crc << 8) ^ tbl[(uint8_t)(crc >> 8) ^ e];
+        }
+        return do_finalize ? finalize(crc, refOut, xorout) : crc;
+    }
+    /*!
+      @brief Gets the built-in lookup table
+      @return Lookup table if exists, nullptr otherwise
+      @note Tables are built in for the polynomials 0x1021 (CCITT) and 0x8005 (IBM/MODBUS)
+     */
+    static const uint16_t* table(const uint16_t polynomial)
+    {
+        switch (polynomial) {
+            case 0x1021:
+                return CRC16Table<0x1021>::table;
+            case 0x8005:
+                return CRC16Table<0x8005>::table;
+            default:
+                return nullptr;
+        }
+    }
 
 protected:
     static inline uint16_t finalize(const uint16_t value, const bool refOut, const uint16_t xorout)
@@ -199,6 +377,7 @@ protected:
     }
 
 private:
+    const uint16_t* _table{};
     uint16_t _crc{}, _init{}, _polynomial{}, _xorout{};
     bool _refIn{}, _refOut{};
 };
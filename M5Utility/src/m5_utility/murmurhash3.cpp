@@ -16,7 +16,24 @@ namespace mmh3 {
 uint32_t calculate(const char* str)
 {
     auto len = strlen(str);
-    return finalize(rest(str + ((len >> 2) * sizeof(uint32_t)), (len & 3), group_of_4(str, len >> 2)), len);
+
+    // Iterative block processing instead of the recursion for compile-time
+    uint32_t h{};
+    auto p = str;
+    for (size_t blocks = len >> 2; blocks; --blocks, p += sizeof(uint32_t)) {
+        uint32_t k;
+        memcpy(&k, p, sizeof(k));  // Unaligned safe load
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        // Bytes over 0x7F are sign-extended in str2uint32 when char is signed, keep the same result as _mmh3
+        if (std::is_signed<char>::value && (k & 0x80808080U)) {
+            k = str2uint32<m5::endian::little>(p);
+        }
+#else
+        k = str2uint32<m5::endian::little>(p);
+#endif
+        h = group_of_4_sub_1(k, h);
+    }
+    return finalize(rest(p, (len & 3), h), len);
 }
 
 }  // namespace mmh3
@@ -9,6 +9,8 @@
 #include <gtest/gtest.h>
 #include <M5Utility.hpp>
 #include <M5Unified.hpp>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -462,6 +464,126 @@ void cb_iterator_test()
     }
 }
 
+template <class LB>
+void lf_basic_test()
+{
+    LB rb(3);  // Rounded up to 4
+    EXPECT_EQ(rb.capacity(), 4U);
+    EXPECT_TRUE(rb.empty());
+    EXPECT_FALSE(rb.full());
+    EXPECT_FALSE(rb.front());
+    EXPECT_FALSE(rb.back());
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(rb.push_back(i));
+    }
+    EXPECT_TRUE(rb.full());
+    EXPECT_FALSE(rb.push_back(4));  // Not overwritten
+    EXPECT_EQ(rb.size(), 4U);
+    EXPECT_EQ(rb.front().value(), 0);
+    EXPECT_EQ(rb.back().value(), 3);
+    EXPECT_EQ(rb[2], 2);
+    EXPECT_FALSE(rb.at(4));
+
+    int v{};
+    EXPECT_TRUE(rb.pop_front(v));
+    EXPECT_EQ(v, 0);
+    rb.pop_front();
+    EXPECT_EQ(rb.size(), 2U);
+
+    // Wrap around
+    EXPECT_TRUE(rb.push_back(4));
+    EXPECT_TRUE(rb.push_back(5));
+    EXPECT_FALSE(rb.push_back(6));
+
+    int c{2};
+    for (auto&& e : rb) {
+        EXPECT_EQ(e, c++);
+    }
+    c = 5;
+    for (auto it = rb.crbegin(); it != rb.crend(); ++it) {
+        EXPECT_EQ(*it, c--);
+    }
+
+    int out[8]{};
+    EXPECT_EQ(rb.read(out, 8), 4U);
+    EXPECT_EQ(out[0], 2);
+    EXPECT_EQ(out[3], 5);
+    EXPECT_EQ(rb.size(), 4U);  // read does not remove
+
+    rb.clear();
+    EXPECT_TRUE(rb.empty());
+    EXPECT_TRUE(rb.push_back(6));
+    EXPECT_EQ(rb.front().value(), 6);
+}
+
+void lf_spsc_thread_test()
+{
+    SCOPED_TRACE("SPSC thread");
+    constexpr uint32_t count{20000};
+    SPSCCircularBuffer<uint32_t> rb(16);
+
+    std::thread producer([&rb]() {
+        for (uint32_t i = 0; i < count; /**/) {
+            if (rb.push_back(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t expected{}, v{};
+    while (expected < count) {
+        if (rb.pop_front(v)) {
+            EXPECT_EQ(v, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(rb.empty());
+}
+
+void lf_mpsc_thread_test()
+{
+    SCOPED_TRACE("MPSC thread");
+    constexpr uint32_t count{10000};
+    constexpr uint32_t producers{3};
+    MPSCCircularBuffer<uint32_t> rb(16);
+
+    std::vector<std::thread> th;
+    for (uint32_t p = 0; p < producers; ++p) {
+        th.emplace_back([&rb, p]() {
+            for (uint32_t i = 0; i < count; /**/) {
+                if (rb.push_back((p << 24) | i)) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    // Order is preserved for each producer
+    uint32_t next[producers]{};
+    uint32_t received{}, v{};
+    while (received < count * producers) {
+        if (rb.pop_front(v)) {
+            auto p = v >> 24;
+            ASSERT_LT(p, producers);
+            EXPECT_EQ(v & 0xFFFFFF, next[p]);
+            ++next[p];
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto&& t : th) {
+        t.join();
+    }
+    EXPECT_TRUE(rb.empty());
+}
+
 }  // namespace
 
 TEST(Utility, CircularBuffer)
@@ -471,3 +593,17 @@ TEST(Utility, CircularBuffer)
     cb_read();
     cb_iterator_test();
 }
+
+TEST(Utility, LockFreeCircularBuffer)
+{
+    {
+        SCOPED_TRACE("SPSC");
+        lf_basic_test<SPSCCircularBuffer<int>>();
+    }
+    {
+        SCOPED_TRACE("MPSC");
+        lf_basic_test<MPSCCircularBuffer<int>>();
+    }
+    lf_spsc_thread_test();
+    lf_mpsc_thread_test();
+}
@@ -145,3 +145,38 @@ TEST(Utility, Chunk)
         EXPECT_EQ(crc_all, crc_chunk);
     }
 }
+
+// Table-driven calculation is equivalent to bitwise calculation
+TEST(Utility, CRCTable)
+{
+    constexpr uint8_t d8[16] = {0x04, 0x67, 0xfc, 0x4d, 0xf4, 0xe7, 0x9c, 0x3b,
+                                0x05, 0xb8, 0xad, 0x31, 0x97, 0xb1, 0x21, 0x72};
+    static_assert(CRC8Table<0x31>::table[1] == 0x31, "Invalid table");
+    static_assert(CRC16Table<0x1021>::table[1] == 0x1021, "Invalid table");
+
+    for (auto&& e : crc8_table) {
+        SCOPED_TRACE(e.name);
+        // Explicit table (not built in)
+        const uint8_t* tbl = (e.poly == 0x9B) ? CRC8Table<0x9B>::table
+                             : (e.poly == 0x1D) ? CRC8Table<0x1D>::table
+                                                : nullptr;
+        if (tbl) {
+            EXPECT_EQ(CRC8::calculate(d8, m5::stl::size(d8), e.init, tbl, e.refIn, e.refOut, e.xorout),
+                      CRC8::calculate(d8, m5::stl::size(d8), e.init, e.poly, e.refIn, e.refOut, e.xorout));
+            CRC8 crc(e.init, e.poly, e.refIn, e.refOut, e.xorout, tbl);
+            EXPECT_EQ(crc.range(tdata.data(), tdata.size()), e.result);
+        }
+    }
+    for (auto&& e : crc16_table) {
+        SCOPED_TRACE(e.name);
+        const uint16_t* tbl = (e.poly == 0x3D65) ? CRC16Table<0x3D65>::table
+                              : (e.poly == 0x8BB7) ? CRC16Table<0x8BB7>::table
+                                                   : nullptr;
+        if (tbl) {
+            EXPECT_EQ(CRC16::calculate(d8, m5::stl::size(d8), e.init, tbl, e.refIn, e.refOut, e.xorout),
+                      CRC16::calculate(d8, m5::stl::size(d8), e.init, e.poly, e.refIn, e.refOut, e.xorout));
+            CRC16 crc(e.init, e.poly, e.refIn, e.refOut, e.xorout, tbl);
+            EXPECT_EQ(crc.range(tdata.data(), tdata.size()), e.result);
+        }
+    }
+}
@@ -73,6 +73,11 @@ TEST(MurmurHash3, user_defined_literals)
     EXPECT_EQ(h0, 0U);
     EXPECT_EQ(h1, 0x8c97d1e0U);
     EXPECT_EQ(h2, 0x1a1eca6dU);
+
+    // Runtime calculation is the same as literals, including bytes over 0x7F
+    EXPECT_EQ(m5::utility::mmh3::calculate("M5Stack is a leading provider of IoT solutions."), h2);
+    constexpr auto h3 = "\xC0\xFF\x80\x81M5\xE3\x81\x82Stack"_mmh3;
+    EXPECT_EQ(m5::utility::mmh3::calculate("\xC0\xFF\x80\x81M5\xE3\x81\x82Stack"), h3);
 }
 
 // Verification of value correctness
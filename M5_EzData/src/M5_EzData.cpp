@@ -156,3 +156,106 @@ int getData(const char *token, const char *topic, int &result) {
         return 0;
     }
 }
+
+EzDataSession::EzDataSession(const char *token) : _token(token) {
+    _client.setInsecure();
+    _http.setReuse(true);
+}
+
+EzDataSession::~EzDataSession() {
+    end();
+}
+
+void EzDataSession::setCACert(const char *cert) {
+    _client.setCACert(cert);
+}
+
+void EzDataSession::end() {
+    _http.setReuse(false);
+    _http.end();
+    _client.stop();
+    _http.setReuse(true);
+}
+
+// begin() on the same client keeps the connection left open by the last
+// request, HTTPClient only reconnects if the server closed it.
+bool EzDataSession::request(const String &path) {
+    if (_http.begin(_client, (String)host + '/' + _token + path)) {
+        return true;
+    }
+    Serial.println("HTTP client setup error!");
+    return false;
+}
+
+int EzDataSession::post(const String &path, const char *key, int val) {
+    if (!request(path)) {
+        return 0;
+    }
+    char payload[40];
+    int len = snprintf(payload, sizeof(payload), "{\"%s\":%d}", key, val);
+    _http.addHeader("Content-Type", "application/json");
+    int httpResponseCode = _http.POST((uint8_t *)payload, len);
+    if (httpResponseCode > 0) {
+        _http.getString();  // read the whole response so the connection can be reused
+    }
+    _http.end();
+    if (httpResponseCode == HTTP_CODE_OK) {
+        return 1;
+    }
+    Serial.printf("Fail to save data,response code:%d\n", httpResponseCode);
+    return 0;
+}
+
+int EzDataSession::setData(const char *topic, int val) {
+    return post((String)'/' + topic, "value", val);
+}
+
+int EzDataSession::addToList(const char *list, int val) {
+    return post((String) "/list/" + list, "payload", val);
+}
+
+int EzDataSession::send(const EzDataItem *items, int count) {
+    int i;
+    for (i = 0; i < count; i++) {
+        int ok = items[i].list ? addToList(items[i].topic, items[i].value)
+                               : setData(items[i].topic, items[i].value);
+        if (!ok) {
+            break;
+        }
+    }
+    return i;
+}
+
+int EzDataSession::getData(const char *topic, int &result) {
+    if (!request((String)'/' + topic + "?offset=0&count=1")) {
+        return 0;
+    }
+    int httpResponseCode = _http.GET();
+    if (httpResponseCode == HTTP_CODE_OK) {
+        DynamicJsonDocument doc(1024);
+        deserializeJson(doc, _http.getString());
+        result = doc["data"].as<int>();
+        _http.end();
+        return 1;
+    }
+    Serial.printf("Fail to get data,response code:%d\n", httpResponseCode);
+    _http.end();
+    return 0;
+}
+
+int EzDataSession::removeData(const char *field) {
+    if (!request((String) "/delete/" + field)) {
+        return 0;
+    }
+    _http.addHeader("Content-Type", "application/json");
+    int httpResponseCode = _http.POST("");
+    if (httpResponseCode > 0) {
+        _http.getString();
+    }
+    _http.end();
+    if (httpResponseCode == HTTP_CODE_OK) {
+        return 1;
+    }
+    Serial.printf("Fail to remove data,response code:%d\n", httpResponseCode);
+    return 0;
+}
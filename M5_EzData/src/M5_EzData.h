@@ -7,6 +7,7 @@ date: 2021/10/15
 #define M5_EzData_h
 
 #include <WiFi.h>
+#include <WiFiClientSecure.h>
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
 
@@ -39,4 +40,48 @@ int *getData(const char *token, const char *list, int *Array, int offset,
 // 删除指定topic或list，并清空数据
 int removeData(const char *token, const char *field);
 
+// One update of a batch: value is saved to the top of the topic queue, or of
+// the data list when list is true.  批量上传中的一项
+struct EzDataItem {
+    const char *topic;
+    int value;
+    bool list;
+};
+
+/*
+Keep-alive session: the TLS connection to the EzData server is opened once
+and reused by every request, instead of one handshake per value like the
+functions above.  保持连接的会话,所有请求复用同一个TLS连接
+*/
+class EzDataSession {
+   public:
+    EzDataSession(const char *token);
+    ~EzDataSession();
+
+    // Verify the server with this root certificate (default: not verified,
+    // like the functions above).  设置服务器根证书
+    void setCACert(const char *cert);
+
+    int setData(const char *topic, int val);
+    int addToList(const char *list, int val);
+    int getData(const char *topic, int &result);
+    int removeData(const char *field);
+
+    // Send several updates back to back on the open connection, stops at the
+    // first failure. Returns the number of updates saved.
+    // 连续发送多个数据,返回成功保存的个数
+    int send(const EzDataItem *items, int count);
+
+    // Close the connection, the next request opens a new one.  关闭连接
+    void end();
+
+   private:
+    int post(const String &path, const char *key, int val);
+    bool request(const String &path);
+
+    String _token;
+    WiFiClientSecure _client;
+    HTTPClient _http;
+};
+
 #endif
@@ -20,6 +20,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "MAX30100.h"
 
+// Samples per FIFO burst, the Wire buffer of AVR boards only fits 8
+#if defined(BUFFER_LENGTH) && BUFFER_LENGTH < MAX30100_FIFO_DEPTH * 4
+#define FIFO_BURST_SAMPLES          (BUFFER_LENGTH / 4)
+#else
+#define FIFO_BURST_SAMPLES          MAX30100_FIFO_DEPTH
+#endif
+
 MAX30100::MAX30100()
 {
 }
@@ -134,12 +141,24 @@ void MAX30100::burstRead(uint8_t baseAddress, uint8_t *buffer, uint8_t length)
 void MAX30100::readFifoData()
 {
     uint8_t buffer[MAX30100_FIFO_DEPTH*4];
+    uint8_t pointers[3];
     uint8_t toRead;
 
-    toRead = (readRegister(MAX30100_REG_FIFO_WRITE_POINTER) - readRegister(MAX30100_REG_FIFO_READ_POINTER)) & (MAX30100_FIFO_DEPTH-1);
+    // Write pointer, overflow counter and read pointer
+    burstRead(MAX30100_REG_FIFO_WRITE_POINTER, pointers, 3);
+    toRead = (pointers[0] - pointers[2]) & (MAX30100_FIFO_DEPTH-1);
+
+    // The pointers are also equal when the FIFO is full, which is the case once it overflows
+    if (pointers[1]) {
+        toRead = MAX30100_FIFO_DEPTH;
+    }
 
     if (toRead) {
-        burstRead(MAX30100_REG_FIFO_DATA, buffer, 4 * toRead);
+        // The data register does not autoincrement, each burst pops the next samples
+        for (uint8_t i=0 ; i < toRead ; i += FIFO_BURST_SAMPLES) {
+            uint8_t samples = toRead - i < FIFO_BURST_SAMPLES ? toRead - i : FIFO_BURST_SAMPLES;
+            burstRead(MAX30100_REG_FIFO_DATA, buffer + i*4, 4 * samples);
+        }
 
         for (uint8_t i=0 ; i < toRead ; ++i) {
             // Warning: the values are always left-aligned
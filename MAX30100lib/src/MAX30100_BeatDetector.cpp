@@ -32,12 +32,15 @@ BeatDetector::BeatDetector() :
     threshold(BEATDETECTOR_MIN_THRESHOLD),
     beatPeriod(0),
     lastMaxValue(0),
+    tsSample(0),
     tsLastBeat(0)
 {
 }
 
 bool BeatDetector::addSample(float sample)
 {
+    tsSample += BEATDETECTOR_SAMPLES_PERIOD;
+
     return checkForBeat(sample);
 }
 
@@ -61,7 +64,7 @@ bool BeatDetector::checkForBeat(float sample)
 
     switch (state) {
         case BEATDETECTOR_STATE_INIT:
-            if (millis() > BEATDETECTOR_INIT_HOLDOFF) {
+            if (tsSample > BEATDETECTOR_INIT_HOLDOFF) {
                 state = BEATDETECTOR_STATE_WAITING;
             }
             break;
@@ -73,7 +76,7 @@ bool BeatDetector::checkForBeat(float sample)
             }
 
             // Tracking lost, resetting
-            if (millis() - tsLastBeat > BEATDETECTOR_INVALID_READOUT_DELAY) {
+            if (tsSample - tsLastBeat > BEATDETECTOR_INVALID_READOUT_DELAY) {
                 beatPeriod = 0;
                 lastMaxValue = 0;
             }
@@ -95,20 +98,20 @@ bool BeatDetector::checkForBeat(float sample)
                 beatDetected = true;
                 lastMaxValue = sample;
                 state = BEATDETECTOR_STATE_MASKING;
-                float delta = millis() - tsLastBeat;
+                float delta = tsSample - tsLastBeat;
                 if (delta) {
                     beatPeriod = BEATDETECTOR_BPFILTER_ALPHA * delta +
                             (1 - BEATDETECTOR_BPFILTER_ALPHA) * beatPeriod;
                 }
 
-                tsLastBeat = millis();
+                tsLastBeat = tsSample;
             } else {
                 state = BEATDETECTOR_STATE_FOLLOWING_SLOPE;
             }
             break;
 
         case BEATDETECTOR_STATE_MASKING:
-            if (millis() - tsLastBeat > BEATDETECTOR_MASKING_HOLDOFF) {
+            if (tsSample - tsLastBeat > BEATDETECTOR_MASKING_HOLDOFF) {
                 state = BEATDETECTOR_STATE_WAITING;
             }
             decreaseThreshold();
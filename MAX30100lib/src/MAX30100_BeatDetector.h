@@ -58,6 +58,9 @@ private:
     float threshold;
     float beatPeriod;
     float lastMaxValue;
+    // Timestamps are counted in samples, so that a block of samples read late from the FIFO
+    // still yields the right beat period
+    uint32_t tsSample;
     uint32_t tsLastBeat;
 };
 
@@ -105,7 +105,8 @@ void PulseOximeter::checkSample()
 {
     uint16_t rawIRValue, rawRedValue;
 
-    // Dequeue all available samples, they're properly timed by the HRM
+    // Dequeue all available samples, they're properly timed by the HRM and the beat
+    // detector counts time in samples, so a late update() processes them as a block
     while (hrm.getRawValues(&rawIRValue, &rawRedValue)) {
         float irACValue = irDCRemover.step(rawIRValue);
         float redACValue = redDCRemover.step(rawRedValue);
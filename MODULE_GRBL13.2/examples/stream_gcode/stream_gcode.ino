@@ -0,0 +1,45 @@
+/*
+    Description: GRBL 13.2 Module streaming example.
+    Sends a circle made of many short segments without waiting for "ok"
+    after each line, GRBL's RX buffer is kept full by character counting.
+*/
+#include <M5Stack.h>
+#include "MODULE_GRBL13.2.h"
+
+#define STEPMOTOR_I2C_ADDR 0x70
+
+GRBL _GRBL = GRBL(STEPMOTOR_I2C_ADDR);
+
+void setup() {
+  M5.begin();
+  M5.Power.begin();
+  Wire.begin(21, 22);
+  _GRBL.Init(&Wire);
+  Serial.begin(115200);
+  m5.Lcd.setTextColor(WHITE, BLACK);
+  m5.Lcd.setTextSize(2);
+  M5.Lcd.setCursor(40, 40);
+  M5.Lcd.println("Press Btn A to stream");
+  _GRBL.setMode("absolute");
+}
+
+void loop() {
+  if (M5.BtnA.wasPressed()) {
+    char code[64];
+    _GRBL.resetStreamStats();
+    for (int i = 0; i <= 360; i += 2) {
+      float a = i * PI / 180;
+      sprintf(code, "G1 X%.3fY%.3f F600", 5 * cos(a), 5 * sin(a));
+      _GRBL.streamGcode(code);
+    }
+    _GRBL.waitStreamDone();
+
+    const GRBLStreamStats &s = _GRBL.streamStats();
+    M5.Lcd.setCursor(40, 100);
+    M5.Lcd.printf("lines %d errors %d\n", s.sent, s.errors);
+    M5.Lcd.setCursor(40, 130);
+    M5.Lcd.printf("buffer fill %d%%\n", (int)(s.fill() * 100));
+  }
+  _GRBL.poll();
+  M5.update();
+}
@@ -152,4 +152,112 @@ bool GRBL::readIdle() {
 
 bool GRBL::inLock() {
     return this->readStatus()[0] == 'A';
-}
\ No newline at end of file
+}
+
+//character-counting streamer
+
+// sends the line if GRBL has room for it, returns false if not (call poll() and retry)
+bool GRBL::queueGcode(const char *c) {
+    size_t len = strlen(c);
+    while (len && (c[len - 1] == '\n' || c[len - 1] == '\r')) {
+        len--;
+    }
+    if (len + 1 > GRBL_RX_BUFFER_SIZE || _lineCount >= GRBL_STREAM_MAX_LINES) {
+        return false;
+    }
+    if (_stats.inFlight + len + 1 > GRBL_RX_BUFFER_SIZE) {
+        return false;
+    }
+
+    _Wire->beginTransmission(addr);
+    _Wire->write((const uint8_t *)c, len);
+    _Wire->write('\n');
+    _Wire->endTransmission();
+
+    _lineLen[(_lineHead + _lineCount) % GRBL_STREAM_MAX_LINES] = len + 1;
+    _lineCount++;
+    _stats.inFlight += len + 1;
+    if (_stats.inFlight > _stats.peak) {
+        _stats.peak = _stats.inFlight;
+    }
+    _stats.sent++;
+    return true;
+}
+
+// blocks only until the line fits in GRBL's RX buffer, not until it is executed
+void GRBL::streamGcode(const char *c) {
+    while (!this->queueGcode(c)) {
+        this->poll();
+    }
+}
+
+// reads whatever GRBL has sent so far and acknowledges the matching lines
+void GRBL::poll() {
+    if (_lineCount) {
+        _stats.fillSum += _stats.inFlight;
+        _stats.samples++;
+    }
+    while (1) {
+        uint8_t i = 0;
+        uint8_t data[10];
+        _Wire->requestFrom(addr, 10);
+        while (_Wire->available() > 0 && i < 10) {
+            data[i++] = _Wire->read();
+        }
+        for (uint8_t j = 0; j < i; j++) {
+            char ch = data[j];
+            if (data[j] == 0xff || ch == '\r') {
+                continue;
+            }
+            if (ch == '\n') {
+                _response[_responseLen] = 0;
+                this->parseResponse();
+                _responseLen = 0;
+            } else if (_responseLen < GRBL_RESPONSE_SIZE - 1) {
+                _response[_responseLen++] = ch;
+            }
+        }
+        if (i < 10 || data[9] == 0xff) {
+            break;
+        }
+    }
+}
+
+void GRBL::parseResponse() {
+    bool ok = strcmp(_response, "ok") == 0;
+    bool error = strncmp(_response, "error:", 6) == 0;
+    if ((!ok && !error) || !_lineCount) {
+        return;  // startup banner, [MSG:], ALARM: ... don't acknowledge a line
+    }
+    if (ok) {
+        _stats.acked++;
+    } else {
+        _stats.errors++;
+        _stats.lastError = atoi(_response + 6);
+    }
+    _stats.inFlight -= _lineLen[_lineHead];
+    _lineHead = (_lineHead + 1) % GRBL_STREAM_MAX_LINES;
+    _lineCount--;
+    if (!_lineCount) {
+        _stats.starved++;
+    }
+}
+
+// true once every streamed line has been acknowledged
+bool GRBL::streamDone() {
+    this->poll();
+    return _lineCount == 0;
+}
+
+void GRBL::waitStreamDone() {
+    while (!this->streamDone()) {
+        delay(1);
+    }
+}
+
+void GRBL::resetStreamStats() {
+    uint16_t inFlight = _stats.inFlight;
+    _stats = {};
+    _stats.inFlight = inFlight;
+    _stats.peak = inFlight;
+}
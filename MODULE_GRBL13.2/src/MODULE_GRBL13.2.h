@@ -4,13 +4,51 @@
 
 #include <Arduino.h>
 
+// size of GRBL's serial RX buffer, the character-counting streamer keeps at
+// most this many bytes of unacknowledged lines in flight
+#ifndef GRBL_RX_BUFFER_SIZE
+#define GRBL_RX_BUFFER_SIZE 128
+#endif
+
+// max lines in flight (each one takes at least 2 bytes of the RX buffer)
+#ifndef GRBL_STREAM_MAX_LINES
+#define GRBL_STREAM_MAX_LINES 32
+#endif
+
+#ifndef GRBL_RESPONSE_SIZE
+#define GRBL_RESPONSE_SIZE 80
+#endif
+
+struct GRBLStreamStats
+{
+    uint32_t sent;        // lines written to GRBL
+    uint32_t acked;       // "ok" responses
+    uint32_t errors;      // "error:" responses
+    int lastError;        // code of the last "error:N" response
+    uint16_t inFlight;    // bytes sent but not acknowledged yet
+    uint16_t peak;        // highest inFlight seen
+    uint32_t fillSum;     // sum of inFlight over the poll() calls, see fill()
+    uint32_t samples;     // poll() calls while streaming
+    uint32_t starved;     // acks that left GRBL with no buffered line
+
+    // average RX buffer fill while streaming, 0.0 - 1.0
+    float fill() const { return samples ? (float)fillSum / samples / GRBL_RX_BUFFER_SIZE : 0; }
+};
+
 class GRBL
 {
     private:
         void sendByte(byte b);
         void sendBytes(uint8_t *data, size_t size);
+        void parseResponse();
         TwoWire *_Wire;
         uint8_t _addr;
+        uint8_t _lineLen[GRBL_STREAM_MAX_LINES];  // lengths of the unacknowledged lines, oldest first
+        uint8_t _lineHead = 0;
+        uint8_t _lineCount = 0;
+        char _response[GRBL_RESPONSE_SIZE];
+        uint8_t _responseLen = 0;
+        GRBLStreamStats _stats = {};
     public:
         GRBL(uint8_t addr=0x70);
         void Init();
@@ -28,6 +66,19 @@ class GRBL
         String readStatus();
         bool readIdle();
         bool inLock();
+
+        // Streaming with character-counting flow control: lines are sent as
+        // long as they fit in GRBL's RX buffer, without waiting for "ok", so the
+        // planner never runs dry between short segments. Call poll() from
+        // loop() to collect responses. Don't mix with readStatus()/readLine()
+        // while streaming, they discard pending responses.
+        bool queueGcode(const char *c);
+        void streamGcode(const char *c);
+        void poll();
+        bool streamDone();
+        void waitStreamDone();
+        const GRBLStreamStats &streamStats() { return _stats; }
+        void resetStreamStats();
 };
 
 #endif
\ No newline at end of file
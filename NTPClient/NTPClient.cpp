@@ -59,6 +59,7 @@ NTPClient::NTPClient(UDP& udp, const char* poolServerName, long timeOffset, unsi
   this->_timeOffset     = timeOffset;
   this->_poolServerName = poolServerName;
   this->_updateInterval = updateInterval;
+  this->_currentInterval = updateInterval;
 }
 
 NTPClient::NTPClient(UDP& udp, IPAddress poolServerIP, long timeOffset, unsigned long updateInterval) {
@@ -67,6 +68,7 @@ NTPClient::NTPClient(UDP& udp, IPAddress poolServerIP, long timeOffset, unsigned
   this->_poolServerIP   = poolServerIP;
   this->_poolServerName = NULL;
   this->_updateInterval = updateInterval;
+  this->_currentInterval = updateInterval;
 }
 
 void NTPClient::begin() {
@@ -86,54 +88,153 @@ bool NTPClient::forceUpdate() {
     Serial.println("Update from NTP Server");
   #endif
 
-  // flush any existing packets
-  while(this->_udp->parsePacket() != 0)
-    this->_udp->flush();
-
   this->sendNTPPacket();
 
   // Wait till data is there or timeout...
-  byte timeout = 0;
-  int cb = 0;
-  do {
+  while (!this->receiveNTPPacket()) {
+    if (millis() - this->_requestMillis >= NTP_RESPONSE_TIMEOUT) {
+      this->_waiting = false;
+      return false;
+    }
     delay ( 10 );
-    cb = this->_udp->parsePacket();
-    if (timeout > 100) return false; // timeout after 1000 ms
-    timeout++;
-  } while (cb == 0);
-
-  this->_lastUpdate = millis() - (10 * (timeout + 1)); // Account for delay in reading the time
-
-  this->_udp->read(this->_packetBuffer, NTP_PACKET_SIZE);
-
-  unsigned long highWord = word(this->_packetBuffer[40], this->_packetBuffer[41]);
-  unsigned long lowWord = word(this->_packetBuffer[42], this->_packetBuffer[43]);
-  // combine the four bytes (two words) into a long integer
-  // this is NTP time (seconds since Jan 1 1900):
-  unsigned long secsSince1900 = highWord << 16 | lowWord;
-
-  this->_currentEpoc = secsSince1900 - SEVENZYYEARS;
-
+  }
   return true;  // return true after successful update
 }
 
 bool NTPClient::update() {
-  if ((millis() - this->_lastUpdate >= this->_updateInterval)     // Update after _updateInterval
-    || this->_lastUpdate == 0) {                                // Update if there was no update yet.
+  if (this->_waiting) {
+    // Pick up the response to the request that is out
+    if (this->receiveNTPPacket()) return true;
+    if (millis() - this->_requestMillis >= NTP_RESPONSE_TIMEOUT) this->_waiting = false;
+    return false;
+  }
+  if ((millis() - this->_syncMillis >= this->_currentInterval)     // Update after _currentInterval
+    || !this->isTimeSet()) {                                      // Update if there was no update yet.
     if (!this->_udpSetup || this->_port != NTP_DEFAULT_LOCAL_PORT) this->begin(this->_port); // setup the UDP client if needed
-    return this->forceUpdate();
+    #ifdef DEBUG_NTPClient
+      Serial.println("Update from NTP Server");
+    #endif
+    this->sendNTPPacket();
   }
   return false;   // return false if update does not occur
 }
 
+bool NTPClient::receiveNTPPacket() {
+  int cb;
+  while ((cb = this->_udp->parsePacket()) > 0) {
+    unsigned long now = millis();
+    if (cb < NTP_PACKET_SIZE) {
+      this->_udp->flush();
+      continue;
+    }
+    this->_udp->read(this->_packetBuffer, NTP_PACKET_SIZE);
+    this->_udp->flush();
+
+    // The server copies our transmit timestamp into the originate timestamp,
+    // anything else is a late reply to an earlier request. Stratum 0 is a
+    // "kiss of death" message without a usable time
+    unsigned long originate = word(this->_packetBuffer[24], this->_packetBuffer[25]);
+    originate = originate << 16 | word(this->_packetBuffer[26], this->_packetBuffer[27]);
+    if (originate != this->_requestId || (this->_packetBuffer[0] & 0x07) != 4 || this->_packetBuffer[1] == 0) continue;
+
+    // receive and transmit timestamps: seconds since Jan 1 1900, and a 32 bit fraction
+    unsigned long highWord = word(this->_packetBuffer[32], this->_packetBuffer[33]);
+    unsigned long lowWord = word(this->_packetBuffer[34], this->_packetBuffer[35]);
+    unsigned long receiveSecs = highWord << 16 | lowWord;
+    unsigned int receiveMs = (word(this->_packetBuffer[36], this->_packetBuffer[37]) * 1000UL) >> 16;
+
+    highWord = word(this->_packetBuffer[40], this->_packetBuffer[41]);
+    lowWord = word(this->_packetBuffer[42], this->_packetBuffer[43]);
+    unsigned long secsSince1900 = highWord << 16 | lowWord;
+    unsigned int transmitMs = (word(this->_packetBuffer[44], this->_packetBuffer[45]) * 1000UL) >> 16;
+
+    // The reply took half the round trip, less the time the server held on to it
+    long serverMs = (long)(secsSince1900 - receiveSecs) * 1000 + (long)transmitMs - (long)receiveMs;
+    long delayMs = (long)(now - this->_requestMillis) - serverMs;
+    if (delayMs < 0) delayMs = 0;
+
+    unsigned long epoc = secsSince1900 - SEVENZYYEARS;
+    unsigned long ms = transmitMs + delayMs / 2;
+    epoc += ms / 1000;
+    ms %= 1000;
+
+    this->_waiting = false;
+    this->addSample(epoc, ms, now);
+    return true;
+  }
+  return false;
+}
+
+void NTPClient::addSample(unsigned long epoc, unsigned int ms, unsigned long now) {
+  if (this->isTimeSet()) {
+    // How far the local clock is from the server
+    long offset = (long)(epoc - this->_currentEpoc) * 1000 + (long)ms - (long)this->localElapsed(now);
+    this->_lastOffset = offset;
+
+    unsigned long localMs = now - this->_syncMillis;
+    if (localMs >= NTP_MIN_DRIFT_INTERVAL) {
+      long serverMs = (long)(epoc - this->_syncEpoc) * 1000 + (long)ms - (long)this->_syncMs;
+      float drift = (float)(serverMs - (long)localMs) * 1000000.0f / localMs;
+      if (this->_samples == 0) {
+        this->_drift = drift;
+      } else {
+        this->_drift += (drift - this->_drift) / 4;
+      }
+      if (this->_drift > NTP_MAX_DRIFT_PPM) this->_drift = NTP_MAX_DRIFT_PPM;
+      if (this->_drift < -NTP_MAX_DRIFT_PPM) this->_drift = -NTP_MAX_DRIFT_PPM;
+      if (this->_samples < 255) this->_samples++;
+    }
+
+    if (offset > -NTP_STEP_THRESHOLD && offset < NTP_STEP_THRESHOLD) {
+      // Carry on from where the local clock is, and slew the offset in
+      unsigned long elapsed = this->localElapsed(now);
+      this->_currentEpoc += elapsed / 1000;
+      this->_lastUpdate = now - (elapsed % 1000);
+      this->_slew = offset;
+
+      // Keeping in step, so the next update can wait longer
+      unsigned long maxInterval = max(this->_updateInterval, this->_maxUpdateInterval);
+      if (offset > -NTP_STABLE_OFFSET && offset < NTP_STABLE_OFFSET) {
+        this->_currentInterval = min(this->_currentInterval * 2, maxInterval);
+      } else {
+        this->_currentInterval = max(this->_currentInterval / 2, this->_updateInterval);
+      }
+    } else {
+      this->_currentEpoc = epoc;
+      this->_lastUpdate = now - ms;
+      this->_slew = 0;
+      this->_currentInterval = this->_updateInterval;
+    }
+  } else {
+    this->_currentEpoc = epoc;
+    this->_lastUpdate = now - ms;
+    this->_slew = 0;
+    this->_lastOffset = 0;
+  }
+
+  this->_syncMillis = now;
+  this->_syncEpoc = epoc;
+  this->_syncMs = ms;
+}
+
+// Time since _currentEpoc started in ms, with millis() corrected for drift and slew
+unsigned long NTPClient::localElapsed(unsigned long now) const {
+  unsigned long elapsed = now - this->_lastUpdate;
+  long slew = this->_slew;
+  long slewed = elapsed / (1000000UL / NTP_SLEW_RATE_PPM);
+  if (slew > slewed) slew = slewed;
+  if (slew < -slewed) slew = -slewed;
+  return elapsed + (long)(elapsed * this->_drift / 1000000.0f) + slew;
+}
+
 bool NTPClient::isTimeSet() const {
-  return (this->_lastUpdate != 0); // returns true if the time has been set, else false
+  return (this->_currentEpoc != 0); // returns true if the time has been set, else false
 }
 
 unsigned long NTPClient::getEpochTime() const {
   return this->_timeOffset + // User offset
          this->_currentEpoc + // Epoch returned by the NTP server
-         ((millis() - this->_lastUpdate) / 1000); // Time since last update
+         (this->localElapsed(millis()) / 1000); // Time since last update
 }
 
 int NTPClient::getDay() const {
@@ -175,6 +276,19 @@ void NTPClient::setTimeOffset(int timeOffset) {
 
 void NTPClient::setUpdateInterval(unsigned long updateInterval) {
   this->_updateInterval = updateInterval;
+  this->_currentInterval = updateInterval;
+}
+
+void NTPClient::setMaxUpdateInterval(unsigned long maxUpdateInterval) {
+  this->_maxUpdateInterval = maxUpdateInterval;
+}
+
+long NTPClient::getOffset() const {
+  return this->_lastOffset;
+}
+
+float NTPClient::getDrift() const {
+  return this->_drift;
 }
 
 void NTPClient::setPoolServerName(const char* poolServerName) {
@@ -182,6 +296,10 @@ void NTPClient::setPoolServerName(const char* poolServerName) {
 }
 
 void NTPClient::sendNTPPacket() {
+  // flush any existing packets
+  while(this->_udp->parsePacket() != 0)
+    this->_udp->flush();
+
   // set all bytes in the buffer to 0
   memset(this->_packetBuffer, 0, NTP_PACKET_SIZE);
   // Initialize values needed to form NTP request
@@ -194,6 +312,13 @@ void NTPClient::sendNTPPacket() {
   this->_packetBuffer[13]  = 0x4E;
   this->_packetBuffer[14]  = 49;
   this->_packetBuffer[15]  = 52;
+  // Transmit Timestamp, the server echoes it back so the response can be matched
+  this->_requestMillis = millis();
+  this->_requestId = this->_requestMillis ^ 0x5A5A5A5AUL;
+  this->_packetBuffer[40]  = this->_requestId >> 24;
+  this->_packetBuffer[41]  = this->_requestId >> 16;
+  this->_packetBuffer[42]  = this->_requestId >> 8;
+  this->_packetBuffer[43]  = this->_requestId;
 
   // all NTP fields have been given values, now
   // you can send a packet requesting a timestamp:
@@ -204,6 +329,7 @@ void NTPClient::sendNTPPacket() {
   }
   this->_udp->write(this->_packetBuffer, NTP_PACKET_SIZE);
   this->_udp->endPacket();
+  this->_waiting = true;
 }
 
 void NTPClient::setRandomPort(unsigned int minValue, unsigned int maxValue) {
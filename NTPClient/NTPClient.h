@@ -8,6 +8,18 @@
 #define NTP_PACKET_SIZE 48
 #define NTP_DEFAULT_LOCAL_PORT 1337
 
+#define NTP_RESPONSE_TIMEOUT    1000 // In ms
+// Offsets up to this are slewed in gradually, larger ones set the clock at once
+#define NTP_STEP_THRESHOLD      128  // In ms
+// How fast an offset is slewed in, 500 ppm is 0.5 ms per second
+#define NTP_SLEW_RATE_PPM       500
+// Limit for the drift estimate; ceramic resonators can be off by 0.5%
+#define NTP_MAX_DRIFT_PPM       5000
+// Samples closer together than this are too noisy for the drift estimate
+#define NTP_MIN_DRIFT_INTERVAL  15000 // In ms
+// The update interval is stretched while the offsets stay below this
+#define NTP_STABLE_OFFSET       32   // In ms
+
 class NTPClient {
   private:
     UDP*          _udp;
@@ -19,13 +31,33 @@ class NTPClient {
     long          _timeOffset     = 0;
 
     unsigned long _updateInterval = 60000;  // In ms
+    unsigned long _maxUpdateInterval = 0;   // In ms, 0 to never stretch the interval
+    unsigned long _currentInterval = 60000; // In ms
 
     unsigned long _currentEpoc    = 0;      // In s
-    unsigned long _lastUpdate     = 0;      // In ms
+    unsigned long _lastUpdate     = 0;      // millis() at which _currentEpoc started
+
+    // Local clock model, see localElapsed()
+    float         _drift          = 0;      // In ppm, positive when millis() runs slow
+    long          _slew           = 0;      // Correction still being slewed in, in ms
+    long          _lastOffset     = 0;      // In ms
+    byte          _samples        = 0;
+
+    // Last sample, for the drift estimate
+    unsigned long _syncMillis     = 0;      // millis() when it was received
+    unsigned long _syncEpoc       = 0;      // Server time then, in s
+    unsigned int  _syncMs         = 0;      // and ms
+
+    bool          _waiting        = false;  // A request is out
+    unsigned long _requestMillis  = 0;
+    unsigned long _requestId      = 0;
 
     byte          _packetBuffer[NTP_PACKET_SIZE];
 
     void          sendNTPPacket();
+    bool          receiveNTPPacket();
+    void          addSample(unsigned long epoc, unsigned int ms, unsigned long now);
+    unsigned long localElapsed(unsigned long now) const;
 
   public:
     NTPClient(UDP& udp);
@@ -63,12 +95,14 @@ class NTPClient {
      * This should be called in the main loop of your application. By default an update from the NTP Server is only
      * made every 60 seconds. This can be configured in the NTPClient constructor.
      *
-     * @return true on success, false on failure
+     * It never waits for the server: one call sends the request, and a later call picks up the response.
+     *
+     * @return true when a response was received and the time updated, else false
      */
     bool update();
 
     /**
-     * This will force the update from the NTP Server.
+     * This will force the update from the NTP Server, waiting up to NTP_RESPONSE_TIMEOUT ms for the response.
      *
      * @return true on success, false on failure
      */
@@ -97,6 +131,22 @@ class NTPClient {
      */
     void setUpdateInterval(unsigned long updateInterval);
 
+    /**
+     * Let the update interval grow up to this while the clock keeps in step with the server, as the drift
+     * estimate makes up for the time between updates. 0 (the default) keeps it at the update interval.
+     */
+    void setMaxUpdateInterval(unsigned long maxUpdateInterval);
+
+    /**
+     * @return difference between the server and the local clock at the last update, in ms
+     */
+    long getOffset() const;
+
+    /**
+     * @return estimated error of millis() in ppm, positive when it runs slow
+     */
+    float getDrift() const;
+
     /**
      * @return time formatted like `hh:mm:ss`
      */
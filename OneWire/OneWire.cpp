@@ -345,6 +345,7 @@ void OneWire::reset_search()
   LastDiscrepancy = 0;
   LastDeviceFlag = false;
   LastFamilyDiscrepancy = 0;
+  SearchPrefixBits = 0;
   for(int i = 7; ; i--) {
     ROM_NO[i] = 0;
     if ( i == 0) break;
@@ -363,6 +364,21 @@ void OneWire::target_search(uint8_t family_code)
    LastDiscrepancy = 64;
    LastFamilyDiscrepancy = 0;
    LastDeviceFlag = false;
+   SearchPrefixBits = 0;
+}
+
+// Setup the search to only find devices whose ROM starts with the
+// first 'bits' bits of 'prefix' on the next calls to search(*newAddr).
+//
+void OneWire::target_search(const uint8_t *prefix, uint8_t bits)
+{
+   if (bits > 64) bits = 64;
+   for (uint8_t i = 0; i < 8; i++)
+      ROM_NO[i] = (i < (bits + 7) / 8) ? prefix[i] : 0;
+   LastDiscrepancy = 0;
+   LastFamilyDiscrepancy = 0;
+   LastDeviceFlag = false;
+   SearchPrefixBits = bits;
 }
 
 //
@@ -426,8 +442,13 @@ bool OneWire::search(uint8_t *newAddr, bool search_mode /* = true */)
          if ((id_bit == 1) && (cmp_id_bit == 1)) {
             break;
          } else {
+            // within the target prefix, take its bit if any device has it
+            if (id_bit_number <= SearchPrefixBits) {
+               search_direction = ((ROM_NO[rom_byte_number] & rom_byte_mask) > 0);
+               if ((id_bit != cmp_id_bit) && (id_bit != search_direction))
+                  break;
             // all devices coupled have 0 or 1
-            if (id_bit != cmp_id_bit) {
+            } else if (id_bit != cmp_id_bit) {
                search_direction = id_bit;  // bit write value for search
             } else {
                // if this discrepancy if before the Last Discrepancy
@@ -497,6 +518,163 @@ bool OneWire::search(uint8_t *newAddr, bool search_mode /* = true */)
    return search_result;
   }
 
+//
+// Check that a device is on the bus, by searching with its whole ROM
+// as the prefix.
+//
+bool OneWire::verify(const uint8_t rom[8])
+{
+   uint8_t addr[8];
+   bool found;
+
+   target_search(rom, 64);
+   found = search(addr);
+   reset_search();
+   return found;
+}
+
+//
+// Do one search pass that follows 'rom'.  Each bit of 'other' is set
+// where some device took the other branch of the tree.  Returns true
+// if the device with 'rom' answered all the way.
+//
+bool OneWire::follow_rom(const uint8_t rom[8], uint8_t other[8])
+{
+   uint8_t i, id_bit, cmp_id_bit, search_direction;
+
+   for (i = 0; i < 8; i++) other[i] = 0;
+   if (!reset()) return false;
+   write(0xF0);   // NORMAL SEARCH
+
+   for (i = 0; i < 64; i++) {
+      uint8_t mask = 1 << (i & 7);
+      search_direction = (rom[i >> 3] & mask) ? 1 : 0;
+      // a 0 in id_bit means a device has a 0, in cmp_id_bit a 1
+      id_bit = read_bit();
+      cmp_id_bit = read_bit();
+      if (search_direction ? !id_bit : !cmp_id_bit) other[i >> 3] |= mask;
+      if (search_direction ? cmp_id_bit : id_bit) return false;
+      write_bit(search_direction);
+   }
+   return true;
+}
+
+uint8_t OneWire::enumerate(uint8_t (*roms)[8], uint8_t max)
+{
+   uint8_t addr[8];
+   uint8_t count = 0;
+
+   reset_search();
+   while (count < max && search(addr)) {
+#if ONEWIRE_CRC
+      if (crc8(addr, 7) != addr[7]) continue;
+#endif
+      memcpy(roms[count++], addr, 8);
+   }
+   reset_search();
+   return count;
+}
+
+// Returns the number of leading bits (bit 0 of byte 0 first) that two
+// ROMs have in common
+static uint8_t common_bits(const uint8_t *a, const uint8_t *b)
+{
+   uint8_t i, bit;
+
+   for (i = 0; i < 8 && a[i] == b[i]; i++) ;
+   if (i == 8) return 64;
+   for (bit = 0; !((a[i] ^ b[i]) & (1 << bit)); bit++) ;
+   return i * 8 + bit;
+}
+
+uint8_t OneWire::update_enumeration(uint8_t (*roms)[8], uint8_t count, uint8_t max, bool *changed)
+{
+   uint8_t branch[ONEWIRE_MAX_BRANCHES][8];
+   uint8_t branch_bits[ONEWIRE_MAX_BRANCHES];
+   uint8_t branches = 0;
+   uint8_t absent[32];
+   uint8_t other[8];
+   uint8_t addr[8];
+   bool modified = false;
+   uint8_t i, j, k;
+
+   if (count > max) count = max;
+
+#if ONEWIRE_CRC
+   // drop ROMs that were damaged while stored
+   for (i = 0, j = 0; i < count; i++) {
+      if (crc8(roms[i], 7) != roms[i][7]) {
+         modified = true;
+         continue;
+      }
+      if (j != i) memcpy(roms[j], roms[i], 8);
+      j++;
+   }
+   count = j;
+#endif
+
+   memset(absent, 0, sizeof(absent));
+   for (i = 0; i < count && branches <= ONEWIRE_MAX_BRANCHES; i++) {
+      // try twice, so one bad bit doesn't drop a device
+      if (!follow_rom(roms[i], other) && !follow_rom(roms[i], other))
+         absent[i >> 3] |= 1 << (i & 7);
+
+      // Look for devices branching off this ROM where the list has
+      // none.  Absent ROMs count too, so that each new device is seen
+      // from the passes of the ROMs nearest to it.
+      for (k = 0; k < 64; k++) {
+         if (!(other[k >> 3] & (1 << (k & 7)))) continue;
+         for (j = 0; j < count; j++)
+            if (j != i && common_bits(roms[i], roms[j]) == k) break;
+         if (j < count) continue;
+         for (j = 0; j < branches; j++)
+            if (branch_bits[j] == k + 1 && common_bits(branch[j], roms[i]) == k) break;
+         if (j < branches) continue;
+         if (branches == ONEWIRE_MAX_BRANCHES) {
+            // too many changes, search the whole bus instead
+            branches++;
+            break;
+         }
+         memcpy(branch[branches], roms[i], 8);
+         branch[branches][k >> 3] ^= 1 << (k & 7);
+         branch_bits[branches++] = k + 1;
+      }
+   }
+
+   if (branches > ONEWIRE_MAX_BRANCHES) {
+      if (changed) *changed = true;
+      return enumerate(roms, max);
+   }
+
+   for (i = 0, j = 0; i < count; i++) {
+      if (absent[i >> 3] & (1 << (i & 7))) {
+         modified = true;
+         continue;
+      }
+      if (j != i) memcpy(roms[j], roms[i], 8);
+      j++;
+   }
+   count = j;
+
+   // search only the new branches
+   for (i = 0; i < branches && count < max; i++) {
+      target_search(branch[i], branch_bits[i]);
+      while (count < max && search(addr)) {
+#if ONEWIRE_CRC
+         if (crc8(addr, 7) != addr[7]) continue;
+#endif
+         for (j = 0; j < count && memcmp(roms[j], addr, 8); j++) ;
+         if (j < count) continue;
+         memcpy(roms[count++], addr, 8);
+         modified = true;
+      }
+   }
+   reset_search();
+
+   if (changed) *changed = modified;
+   return count;
+}
+
 #endif
 
 #if ONEWIRE_CRC
@@ -31,6 +31,12 @@
 #define ONEWIRE_SEARCH 1
 #endif
 
+// The number of new branches of the ROM tree that update_enumeration()
+// will search.  If it finds more, it searches the whole bus instead.
+#ifndef ONEWIRE_MAX_BRANCHES
+#define ONEWIRE_MAX_BRANCHES 8
+#endif
+
 // You can exclude CRC checks altogether by defining this to 0
 #ifndef ONEWIRE_CRC
 #define ONEWIRE_CRC 1
@@ -66,6 +72,9 @@ class OneWire
     uint8_t LastDiscrepancy;
     uint8_t LastFamilyDiscrepancy;
     bool LastDeviceFlag;
+    uint8_t SearchPrefixBits;
+
+    bool follow_rom(const uint8_t rom[8], uint8_t other[8]);
 #endif
 
   public:
@@ -126,6 +135,29 @@ class OneWire
     // get garbage.  The order is deterministic. You will always get
     // the same devices in the same order.
     bool search(uint8_t *newAddr, bool search_mode = true);
+
+    // Setup the search so that the next calls to search(*newAddr) only
+    // return devices whose ROM starts with the first 'bits' bits of
+    // 'prefix' (bit 0 of prefix[0] first).  With 8 bits this finds one
+    // family, and unlike target_search(family_code) never returns others.
+    void target_search(const uint8_t *prefix, uint8_t bits);
+
+    // Check that the device with this ROM is on the bus, with a single
+    // search pass that follows its ROM.  This resets the search state.
+    bool verify(const uint8_t rom[8]);
+
+    // Search the whole bus and store up to 'max' ROMs in 'roms', in search
+    // order, skipping any with a bad CRC.  Returns the number stored.
+    uint8_t enumerate(uint8_t (*roms)[8], uint8_t max);
+
+    // Bring a list of 'count' ROMs from enumerate() up to date without a
+    // full search.  Each device in the list is checked with a verify pass,
+    // and ROMs that are not answering (or have a bad CRC, if the list was
+    // loaded from EEPROM) are removed.  Branches of the ROM tree where
+    // those passes saw devices not in the list are then searched, and the
+    // new devices are added at the end.  Returns the new count, and sets
+    // 'changed' if the list changed.
+    uint8_t update_enumeration(uint8_t (*roms)[8], uint8_t count, uint8_t max, bool *changed = NULL);
 #endif
 
 #if ONEWIRE_CRC
@@ -14,9 +14,24 @@ PubSubClient::PubSubClient() {
     this->stream = NULL;
     setCallback(NULL);
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 
 PubSubClient::PubSubClient(Client& client) {
@@ -24,9 +39,24 @@ PubSubClient::PubSubClient(Client& client) {
     setClient(client);
     this->stream = NULL;
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client) {
@@ -35,9 +65,24 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client) {
     setClient(client);
     this->stream = NULL;
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
@@ -45,9 +90,24 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client, Stream
     setClient(client);
     setStream(stream);
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
@@ -56,9 +116,24 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATUR
     setClient(client);
     this->stream = NULL;
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
@@ -67,9 +142,24 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATUR
     setClient(client);
     setStream(stream);
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client) {
@@ -78,9 +168,24 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client) {
     setClient(client);
     this->stream = NULL;
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
@@ -88,9 +193,24 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client, Stream& s
     setClient(client);
     setStream(stream);
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
@@ -99,9 +219,24 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE,
     setClient(client);
     this->stream = NULL;
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
@@ -110,9 +245,24 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE,
     setClient(client);
     setStream(stream);
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 
 PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client) {
@@ -121,9 +271,24 @@ PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client) {
     setClient(client);
     this->stream = NULL;
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
@@ -131,9 +296,24 @@ PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client, St
     setClient(client);
     setStream(stream);
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
@@ -142,9 +322,24 @@ PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGN
     setClient(client);
     this->stream = NULL;
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
@@ -153,13 +348,33 @@ PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGN
     setClient(client);
     setStream(stream);
     this->bufferSize = 0;
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    this->linkState = MQTT_LINK_IDLE;
+    this->subscriptions = NULL;
+    this->subscriptionCount = 0;
+    this->topicNodes = NULL;
+    this->topicNodeCount = 0;
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeLength = 0;
+    this->writeDelay = MQTT_WRITE_DELAY;
     setBufferSize(MQTT_MAX_PACKET_SIZE);
     setKeepAlive(MQTT_KEEPALIVE);
     setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+    setPubAckTimeout(MQTT_PUBACK_TIMEOUT);
+    setBackoff(MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX);
 }
 
 PubSubClient::~PubSubClient() {
   free(this->buffer);
+  free(this->inflight);
+  free(this->inflightStore);
+  free(this->subscriptions);
+  free(this->topicNodes);
+  free(this->writeBuffer);
 }
 
 boolean PubSubClient::connect(const char *id) {
@@ -194,94 +409,378 @@ boolean PubSubClient::connect(const char *id, const char *user, const char *pass
         }
 
         if (result == 1) {
-            nextMsgId = 1;
-            // Leave room in the buffer for header and variable length field
-            uint16_t length = MQTT_MAX_HEADER_SIZE;
-            unsigned int j;
+            if (!writeConnect(id,user,pass,willTopic,willQos,willRetain,willMessage,cleanSession)) {
+                return false;
+            }
+
+            while (!_client->available()) {
+                unsigned long t = millis();
+                if (t-lastInActivity >= ((int32_t) this->socketTimeout*1000UL)) {
+                    _state = MQTT_CONNECTION_TIMEOUT;
+                    _client->stop();
+                    return false;
+                }
+            }
+            return readConnack(cleanSession);
+        } else {
+            _state = MQTT_CONNECT_FAILED;
+        }
+        return false;
+    }
+    return true;
+}
+
+// Build and send the CONNECT packet, on a connected client
+boolean PubSubClient::writeConnect(const char *id, const char *user, const char *pass, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage, boolean cleanSession) {
+    nextMsgId = 1;
+    // Nothing buffered for the previous connection can be sent on this one
+    this->writeLength = 0;
+    // Leave room in the buffer for header and variable length field
+    uint16_t length = MQTT_MAX_HEADER_SIZE;
+    unsigned int j;
 
 #if MQTT_VERSION == MQTT_VERSION_3_1
-            uint8_t d[9] = {0x00,0x06,'M','Q','I','s','d','p', MQTT_VERSION};
+    uint8_t d[9] = {0x00,0x06,'M','Q','I','s','d','p', MQTT_VERSION};
 #define MQTT_HEADER_VERSION_LENGTH 9
 #elif MQTT_VERSION == MQTT_VERSION_3_1_1
-            uint8_t d[7] = {0x00,0x04,'M','Q','T','T',MQTT_VERSION};
+    uint8_t d[7] = {0x00,0x04,'M','Q','T','T',MQTT_VERSION};
 #define MQTT_HEADER_VERSION_LENGTH 7
 #endif
-            for (j = 0;j<MQTT_HEADER_VERSION_LENGTH;j++) {
-                this->buffer[length++] = d[j];
-            }
+    for (j = 0;j<MQTT_HEADER_VERSION_LENGTH;j++) {
+        this->buffer[length++] = d[j];
+    }
 
-            uint8_t v;
-            if (willTopic) {
-                v = 0x04|(willQos<<3)|(willRetain<<5);
-            } else {
-                v = 0x00;
-            }
+    uint8_t v;
+    if (willTopic) {
+        v = 0x04|(willQos<<3)|(willRetain<<5);
+    } else {
+        v = 0x00;
+    }
+    if (cleanSession) {
+        v = v|0x02;
+    }
+
+    if(user != NULL) {
+        v = v|0x80;
+
+        if(pass != NULL) {
+            v = v|(0x80>>1);
+        }
+    }
+    this->buffer[length++] = v;
+
+    this->buffer[length++] = ((this->keepAlive) >> 8);
+    this->buffer[length++] = ((this->keepAlive) & 0xFF);
+
+    CHECK_STRING_LENGTH(length,id)
+    length = writeString(id,this->buffer,length);
+    if (willTopic) {
+        CHECK_STRING_LENGTH(length,willTopic)
+        length = writeString(willTopic,this->buffer,length);
+        CHECK_STRING_LENGTH(length,willMessage)
+        length = writeString(willMessage,this->buffer,length);
+    }
+
+    if(user != NULL) {
+        CHECK_STRING_LENGTH(length,user)
+        length = writeString(user,this->buffer,length);
+        if(pass != NULL) {
+            CHECK_STRING_LENGTH(length,pass)
+            length = writeString(pass,this->buffer,length);
+        }
+    }
+
+    write(MQTTCONNECT,this->buffer,length-MQTT_MAX_HEADER_SIZE);
+
+    lastInActivity = lastOutActivity = millis();
+    return true;
+}
+
+// Read the CONNACK, once data is available; closes the client if it is refused
+boolean PubSubClient::readConnack(boolean cleanSession) {
+    uint8_t llen;
+    uint32_t len = readPacket(&llen);
+
+    if (len == 4) {
+        if (buffer[3] == 0) {
+            lastInActivity = millis();
+            pingOutstanding = false;
+            _state = MQTT_CONNECTED;
             if (cleanSession) {
-                v = v|0x02;
+                // The server has no session, the messages in flight are dropped
+                for (uint8_t i = 0; i < this->inflightWindow; i++) {
+                    this->inflight[i].msgId = 0;
+                }
+            } else {
+                retryInflight(true);
             }
+            return true;
+        } else {
+            _state = buffer[3];
+        }
+    }
+    _client->stop();
+    return false;
+}
 
-            if(user != NULL) {
-                v = v|0x80;
+boolean PubSubClient::beginConnect(const char *id) {
+    return beginConnect(id,NULL,NULL,0,0,0,0,1);
+}
 
-                if(pass != NULL) {
-                    v = v|(0x80>>1);
-                }
+boolean PubSubClient::beginConnect(const char *id, const char *user, const char *pass) {
+    return beginConnect(id,user,pass,0,0,0,0,1);
+}
+
+boolean PubSubClient::beginConnect(const char *id, const char *user, const char *pass, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage, boolean cleanSession) {
+    this->connectId = id;
+    this->connectUser = user;
+    this->connectPass = pass;
+    this->connectWillTopic = willTopic;
+    this->connectWillQos = willQos;
+    this->connectWillRetain = willRetain;
+    this->connectWillMessage = willMessage;
+    this->connectCleanSession = cleanSession;
+    this->linkAttempts = 0;
+    if (connected()) {
+        this->linkState = MQTT_LINK_CONNECTED;
+        return true;
+    }
+    this->linkState = MQTT_LINK_TCP_CONNECT;
+    return false;
+}
+
+// Wait before the next connection attempt, twice as long after each failure
+void PubSubClient::backoff(unsigned long t) {
+    if (this->linkAttempts == 0) {
+        this->linkDelay = this->backoffMin;
+    } else if (this->linkDelay < this->backoffMax / 2) {
+        this->linkDelay *= 2;
+    } else {
+        this->linkDelay = this->backoffMax;
+    }
+    if (this->linkAttempts < 255) {
+        this->linkAttempts++;
+    }
+    this->linkTime = t;
+    this->linkState = MQTT_LINK_BACKOFF;
+}
+
+// One step of the connection started with beginConnect(), returns true when connected
+boolean PubSubClient::runLink(unsigned long t) {
+    switch (this->linkState) {
+    case MQTT_LINK_BACKOFF:
+        if (t - this->linkTime < this->linkDelay) {
+            return false;
+        }
+        this->linkState = MQTT_LINK_TCP_CONNECT;
+        // fall through
+    case MQTT_LINK_TCP_CONNECT: {
+        // Client::connect() has no asynchronous form, a single attempt takes the client's own timeout
+        int result = 1;
+        if (!_client->connected()) {
+            if (domain != NULL) {
+                result = _client->connect(this->domain, this->port);
+            } else {
+                result = _client->connect(this->ip, this->port);
             }
-            this->buffer[length++] = v;
-
-            this->buffer[length++] = ((this->keepAlive) >> 8);
-            this->buffer[length++] = ((this->keepAlive) & 0xFF);
-
-            CHECK_STRING_LENGTH(length,id)
-            length = writeString(id,this->buffer,length);
-            if (willTopic) {
-                CHECK_STRING_LENGTH(length,willTopic)
-                length = writeString(willTopic,this->buffer,length);
-                CHECK_STRING_LENGTH(length,willMessage)
-                length = writeString(willMessage,this->buffer,length);
+        }
+        if (result != 1) {
+            _state = MQTT_CONNECT_FAILED;
+            backoff(t);
+            return false;
+        }
+        if (!writeConnect(this->connectId,this->connectUser,this->connectPass,this->connectWillTopic,this->connectWillQos,this->connectWillRetain,this->connectWillMessage,this->connectCleanSession)) {
+            _state = MQTT_CONNECT_FAILED;
+            backoff(t);
+            return false;
+        }
+        this->linkTime = t;
+        this->linkState = MQTT_LINK_CONNACK_WAIT;
+        return false;
+    }
+    case MQTT_LINK_CONNACK_WAIT:
+        if (!_client->available()) {
+            if (t - this->linkTime >= this->socketTimeout*1000UL) {
+                _state = MQTT_CONNECTION_TIMEOUT;
+                _client->stop();
+                backoff(t);
             }
+            return false;
+        }
+        if (!readConnack(this->connectCleanSession)) {
+            backoff(t);
+            return false;
+        }
+        this->linkIndex = 0;
+        this->linkState = MQTT_LINK_RESUBSCRIBE;
+        // fall through
+    case MQTT_LINK_RESUBSCRIBE:
+        // One SUBSCRIBE per call, incoming messages are handled in between
+        if (this->linkIndex < this->subscriptionCount) {
+            MQTTSubscription* sub = &this->subscriptions[this->linkIndex++];
+            subscribe(sub->topic, sub->qos);
+            return connected();
+        }
+        this->linkAttempts = 0;
+        this->linkState = MQTT_LINK_CONNECTED;
+        // fall through
+    case MQTT_LINK_CONNECTED:
+        if (!connected()) {
+            backoff(t);
+            return false;
+        }
+        return true;
+    }
+    return connected();
+}
 
-            if(user != NULL) {
-                CHECK_STRING_LENGTH(length,user)
-                length = writeString(user,this->buffer,length);
-                if(pass != NULL) {
-                    CHECK_STRING_LENGTH(length,pass)
-                    length = writeString(pass,this->buffer,length);
-                }
-            }
+boolean PubSubClient::addSubscription(const char* topic, uint8_t qos) {
+    if (topic == 0 || qos > 1) {
+        return false;
+    }
+    MQTTSubscription* subs = (MQTTSubscription*)realloc(this->subscriptions, (this->subscriptionCount + 1) * sizeof(MQTTSubscription));
+    if (subs == NULL) {
+        return false;
+    }
+    subs[this->subscriptionCount].topic = topic;
+    subs[this->subscriptionCount].qos = qos;
+    this->subscriptions = subs;
+    this->subscriptionCount++;
+    if (connected() && this->linkState != MQTT_LINK_RESUBSCRIBE) {
+        return subscribe(topic, qos);
+    }
+    return true;
+}
 
-            write(MQTTCONNECT,this->buffer,length-MQTT_MAX_HEADER_SIZE);
+uint8_t PubSubClient::getLinkState() {
+    return this->linkState;
+}
 
-            lastInActivity = lastOutActivity = millis();
+boolean PubSubClient::addHandler(const char* filter, MQTTHandler handler) {
+    if (filter == 0 || *filter == 0) {
+        return false;
+    }
+    // + and # must fill their level, # must be the last one
+    for (const char* p = filter; *p; p++) {
+        if ((*p == '+' || *p == '#') && ((p != filter && p[-1] != '/') || (p[1] != 0 && p[1] != '/'))) {
+            return false;
+        }
+        if (*p == '#' && p[1] != 0) {
+            return false;
+        }
+    }
+    if (this->topicNodeCount == 0) {
+        // the root node, for the level before the topic
+        this->topicNodes = (MQTTTopicNode*)malloc(sizeof(MQTTTopicNode));
+        if (this->topicNodes == NULL) {
+            return false;
+        }
+        memset(this->topicNodes,0,sizeof(MQTTTopicNode));
+        this->topicNodeCount = 1;
+    }
+    uint16_t node = 0;
+    const char* level = filter;
+    while (true) {
+        const char* end = strchr(level,'/');
+        size_t length = end ? end-level : strlen(level);
+        if (length > 255) {
+            return false;
+        }
+        uint16_t child = this->topicNodes[node].child;
+        while (child && (this->topicNodes[child].length != length || memcmp(this->topicNodes[child].level,level,length))) {
+            child = this->topicNodes[child].next;
+        }
+        if (!child) {
+            if (handler == NULL) {
+                return true; // nothing to remove
+            }
+            if (this->topicNodeCount == 0xFFFF) {
+                return false;
+            }
+            MQTTTopicNode* nodes = (MQTTTopicNode*)realloc(this->topicNodes, (this->topicNodeCount + 1) * sizeof(MQTTTopicNode));
+            if (nodes == NULL) {
+                return false;
+            }
+            this->topicNodes = nodes;
+            child = this->topicNodeCount++;
+            nodes[child].level = level;
+            nodes[child].length = length;
+            nodes[child].child = 0;
+            nodes[child].next = nodes[node].child;
+            nodes[child].handler = NULL;
+            nodes[node].child = child;
+        }
+        node = child;
+        if (!end) {
+            break;
+        }
+        level = end+1;
+    }
+    this->topicNodes[node].handler = handler;
+    return true;
+}
 
-            while (!_client->available()) {
-                unsigned long t = millis();
-                if (t-lastInActivity >= ((int32_t) this->socketTimeout*1000UL)) {
-                    _state = MQTT_CONNECTION_TIMEOUT;
-                    _client->stop();
-                    return false;
+// Walk the topic levels once, following all the filters that match so far
+void PubSubClient::dispatch(char* topic, uint8_t* payload, unsigned int length) {
+    MQTTHandler handlers[MQTT_MAX_TOPIC_MATCH];
+    uint8_t handlerCount = 0;
+    if (this->topicNodeCount) {
+        MQTTTopicNode* nodes = this->topicNodes;
+        uint16_t active[2][MQTT_MAX_TOPIC_MATCH];
+        uint8_t activeCount = 1;
+        uint8_t current = 0;
+        active[0][0] = 0;
+        // wildcards don't match the first level of $SYS topics
+        boolean system = (topic[0] == '$');
+        const char* level = topic;
+        while (activeCount) {
+            const char* end = strchr(level,'/');
+            size_t levelLength = end ? end-level : strlen(level);
+            uint8_t nextCount = 0;
+            for (uint8_t i = 0; i < activeCount; i++) {
+                boolean wild = !(system && active[current][i] == 0);
+                for (uint16_t c = nodes[active[current][i]].child; c; c = nodes[c].next) {
+                    MQTTTopicNode* n = &nodes[c];
+                    if (n->length == 1 && n->level[0] == '#') {
+                        if (wild && n->handler && handlerCount < MQTT_MAX_TOPIC_MATCH) {
+                            handlers[handlerCount++] = n->handler;
+                        }
+                    } else if ((n->length == 1 && n->level[0] == '+') ? wild : (n->length == levelLength && !memcmp(n->level,level,levelLength))) {
+                        if (nextCount < MQTT_MAX_TOPIC_MATCH) {
+                            active[current^1][nextCount++] = c;
+                        }
+                    }
                 }
             }
-            uint8_t llen;
-            uint32_t len = readPacket(&llen);
-
-            if (len == 4) {
-                if (buffer[3] == 0) {
-                    lastInActivity = millis();
-                    pingOutstanding = false;
-                    _state = MQTT_CONNECTED;
-                    return true;
-                } else {
-                    _state = buffer[3];
+            current ^= 1;
+            activeCount = nextCount;
+            if (!end) {
+                break;
+            }
+            level = end+1;
+        }
+        for (uint8_t i = 0; i < activeCount; i++) {
+            MQTTTopicNode* n = &nodes[active[current][i]];
+            if (n->handler && handlerCount < MQTT_MAX_TOPIC_MATCH) {
+                handlers[handlerCount++] = n->handler;
+            }
+            // "a/#" also matches "a"
+            for (uint16_t c = n->child; c; c = nodes[c].next) {
+                if (nodes[c].length == 1 && nodes[c].level[0] == '#' && nodes[c].handler && handlerCount < MQTT_MAX_TOPIC_MATCH) {
+                    handlers[handlerCount++] = nodes[c].handler;
                 }
             }
-            _client->stop();
-        } else {
-            _state = MQTT_CONNECT_FAILED;
         }
-        return false;
     }
-    return true;
+    if (handlerCount == 0) {
+        if (callback) {
+            callback(topic,payload,length);
+        }
+        return;
+    }
+    for (uint8_t i = 0; i < handlerCount; i++) {
+        handlers[i](topic,payload,length);
+    }
 }
 
 // reads a byte into result
@@ -368,6 +867,9 @@ uint32_t PubSubClient::readPacket(uint8_t* lengthLength) {
 }
 
 boolean PubSubClient::loop() {
+    if (this->linkState != MQTT_LINK_IDLE && !runLink(millis())) {
+        return false;
+    }
     if (connected()) {
         unsigned long t = millis();
         if ((t - lastInActivity > this->keepAlive*1000UL) || (t - lastOutActivity > this->keepAlive*1000UL)) {
@@ -376,6 +878,7 @@ boolean PubSubClient::loop() {
                 _client->stop();
                 return false;
             } else {
+                flushWrites();
                 this->buffer[0] = MQTTPINGREQ;
                 this->buffer[1] = 0;
                 _client->write(this->buffer,2);
@@ -393,7 +896,7 @@ boolean PubSubClient::loop() {
                 lastInActivity = t;
                 uint8_t type = this->buffer[0]&0xF0;
                 if (type == MQTTPUBLISH) {
-                    if (callback) {
+                    if (callback || this->topicNodeCount) {
                         uint16_t tl = (this->buffer[llen+1]<<8)+this->buffer[llen+2]; /* topic length in bytes */
                         memmove(this->buffer+llen+2,this->buffer+llen+3,tl); /* move topic inside buffer 1 byte to front */
                         this->buffer[llen+2+tl] = 0; /* end the topic as a 'C' string with \x00 */
@@ -402,8 +905,9 @@ boolean PubSubClient::loop() {
                         if ((this->buffer[0]&0x06) == MQTTQOS1) {
                             msgId = (this->buffer[llen+3+tl]<<8)+this->buffer[llen+3+tl+1];
                             payload = this->buffer+llen+3+tl+2;
-                            callback(topic,payload,len-llen-3-tl-2);
+                            dispatch(topic,payload,len-llen-3-tl-2);
 
+                            flushWrites();
                             this->buffer[0] = MQTTPUBACK;
                             this->buffer[1] = 2;
                             this->buffer[2] = (msgId >> 8);
@@ -413,10 +917,21 @@ boolean PubSubClient::loop() {
 
                         } else {
                             payload = this->buffer+llen+3+tl;
-                            callback(topic,payload,len-llen-3-tl);
+                            dispatch(topic,payload,len-llen-3-tl);
+                        }
+                    }
+                } else if (type == MQTTPUBACK) {
+                    if (len == 4) {
+                        msgId = (this->buffer[2]<<8)+this->buffer[3];
+                        for (uint8_t i = 0; i < this->inflightWindow; i++) {
+                            if (this->inflight[i].msgId == msgId) {
+                                this->inflight[i].msgId = 0;
+                                break;
+                            }
                         }
                     }
                 } else if (type == MQTTPINGREQ) {
+                    flushWrites();
                     this->buffer[0] = MQTTPINGRESP;
                     this->buffer[1] = 0;
                     _client->write(this->buffer,2);
@@ -428,6 +943,10 @@ boolean PubSubClient::loop() {
                 return false;
             }
         }
+        retryInflight(false);
+        if (this->writeLength && millis() - this->writeTime >= this->writeDelay) {
+            return flushWrites();
+        }
         return true;
     }
     return false;
@@ -471,6 +990,89 @@ boolean PubSubClient::publish(const char* topic, const uint8_t* payload, unsigne
     return false;
 }
 
+boolean PubSubClient::publish(const char* topic, const char* payload, boolean retained, uint8_t qos) {
+    return publish(topic,(const uint8_t*)payload, payload ? strnlen(payload, this->bufferSize) : 0,retained,qos);
+}
+
+boolean PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int plength, boolean retained, uint8_t qos) {
+    if (qos == 0) {
+        return publish(topic, payload, plength, retained);
+    }
+    if (qos > 1) {
+        return false;
+    }
+    if (connected()) {
+        if (this->inflightSize < MQTT_MAX_HEADER_SIZE + 2+strnlen(topic, this->inflightSize) + 2 + plength) {
+            // Too long, or no retry store
+            return false;
+        }
+        uint8_t i;
+        for (i = 0; i < this->inflightWindow; i++) {
+            if (this->inflight[i].msgId == 0) {
+                break;
+            }
+        }
+        if (i == this->inflightWindow) {
+            // Window full, loop() frees slots as the PUBACKs arrive
+            return false;
+        }
+        // The packet is built in its slot, with room for header and variable length field
+        uint8_t* buf = this->inflightStore + (uint32_t)i * this->inflightSize;
+        uint16_t length = MQTT_MAX_HEADER_SIZE;
+        length = writeString(topic,buf,length);
+        uint16_t msgId = nextPublishId();
+        buf[length++] = (msgId >> 8);
+        buf[length++] = (msgId & 0xFF);
+        memcpy(buf+length,payload,plength);
+        length += plength;
+
+        uint8_t header = MQTTPUBLISH | MQTTQOS1;
+        if (retained) {
+            header |= 1;
+        }
+        if (!write(header,buf,length-MQTT_MAX_HEADER_SIZE)) {
+            return false;
+        }
+        this->inflight[i].msgId = msgId;
+        this->inflight[i].length = length-MQTT_MAX_HEADER_SIZE;
+        this->inflight[i].header = header;
+        this->inflight[i].sentAt = millis();
+        return true;
+    }
+    return false;
+}
+
+// The next message id that is not waiting for a PUBACK
+uint16_t PubSubClient::nextPublishId() {
+    boolean used;
+    do {
+        nextMsgId++;
+        if (nextMsgId == 0) {
+            nextMsgId = 1;
+        }
+        used = false;
+        for (uint8_t i = 0; i < this->inflightWindow; i++) {
+            if (this->inflight[i].msgId == nextMsgId) {
+                used = true;
+            }
+        }
+    } while (used);
+    return nextMsgId;
+}
+
+// Send the QoS 1 publishes again whose PUBACK timed out, or all of them after a reconnect
+void PubSubClient::retryInflight(boolean all) {
+    unsigned long t = millis();
+    for (uint8_t i = 0; i < this->inflightWindow; i++) {
+        MQTTInflight* m = &this->inflight[i];
+        if (m->msgId != 0 && (all || (t - m->sentAt >= this->pubAckTimeout))) {
+            m->header |= MQTTDUP;
+            write(m->header,this->inflightStore + (uint32_t)i * this->inflightSize,m->length);
+            m->sentAt = t;
+        }
+    }
+}
+
 boolean PubSubClient::publish_P(const char* topic, const char* payload, boolean retained) {
     return publish_P(topic, (const uint8_t*)payload, payload ? strnlen(payload, this->bufferSize) : 0, retained);
 }
@@ -510,10 +1112,11 @@ boolean PubSubClient::publish_P(const char* topic, const uint8_t* payload, unsig
 
     pos = writeString(topic,this->buffer,pos);
 
-    rc += _client->write(this->buffer,pos);
+    rc += clientWrite(this->buffer,pos);
 
     for (i=0;i<plength;i++) {
-        rc += _client->write((char)pgm_read_byte_near(payload + i));
+        uint8_t c = pgm_read_byte_near(payload + i);
+        rc += clientWrite(&c,1);
     }
 
     lastOutActivity = millis();
@@ -533,7 +1136,7 @@ boolean PubSubClient::beginPublish(const char* topic, unsigned int plength, bool
             header |= 1;
         }
         size_t hlen = buildHeader(header, this->buffer, plength+length-MQTT_MAX_HEADER_SIZE);
-        uint16_t rc = _client->write(this->buffer+(MQTT_MAX_HEADER_SIZE-hlen),length-(MQTT_MAX_HEADER_SIZE-hlen));
+        uint16_t rc = clientWrite(this->buffer+(MQTT_MAX_HEADER_SIZE-hlen),length-(MQTT_MAX_HEADER_SIZE-hlen));
         lastOutActivity = millis();
         return (rc == (length-(MQTT_MAX_HEADER_SIZE-hlen)));
     }
@@ -544,22 +1147,135 @@ int PubSubClient::endPublish() {
  return 1;
 }
 
+boolean PubSubClient::publish(const char* topic, const MQTTSegment* segments, uint8_t count, boolean retained) {
+    unsigned int plength = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        plength += segments[i].length;
+    }
+    if (this->bufferSize < MQTT_MAX_HEADER_SIZE + 2+strnlen(topic, this->bufferSize)) {
+        // Too long
+        return false;
+    }
+    if (!beginPublish(topic, plength, retained)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (segments[i].length > 0 && !writeSegment(segments[i].data, segments[i].length)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+boolean PubSubClient::publish(const char* topic, Stream& stream, unsigned int plength, boolean retained) {
+    if (this->bufferSize < MQTT_MAX_HEADER_SIZE + 2+strnlen(topic, this->bufferSize)) {
+        // Too long
+        return false;
+    }
+    if (!beginPublish(topic, plength, retained)) {
+        return false;
+    }
+    while (plength > 0) {
+        size_t n = (plength > this->bufferSize) ? this->bufferSize : plength;
+        n = stream.readBytes((char*)this->buffer, n);
+        if (n == 0) {
+            // The packet length is already sent, the connection can't be used any more
+            _client->stop();
+            return false;
+        }
+        if (!writeSegment(this->buffer, n)) {
+            return false;
+        }
+        plength -= n;
+    }
+    return true;
+}
+
+boolean PubSubClient::writeSegment(const uint8_t* data, size_t length) {
+    size_t rc;
+#ifdef MQTT_MAX_TRANSFER_SIZE
+    while (length > 0) {
+        size_t bytesToWrite = (length > MQTT_MAX_TRANSFER_SIZE)?MQTT_MAX_TRANSFER_SIZE:length;
+        rc = clientWrite(data,bytesToWrite);
+        if (rc != bytesToWrite) {
+            return false;
+        }
+        length -= rc;
+        data += rc;
+    }
+    lastOutActivity = millis();
+    return true;
+#else
+    rc = clientWrite(data,length);
+    lastOutActivity = millis();
+    return (rc == length);
+#endif
+}
+
 size_t PubSubClient::write(uint8_t data) {
     lastOutActivity = millis();
-    return _client->write(data);
+    return clientWrite(&data,1);
 }
 
 size_t PubSubClient::write(const uint8_t *buffer, size_t size) {
     lastOutActivity = millis();
-    return _client->write(buffer,size);
+    return clientWrite(buffer,size);
+}
+
+// Pass data on to the Client, through the write buffer if there is one
+size_t PubSubClient::clientWrite(const uint8_t* data, size_t length) {
+    if (this->writeBufferSize == 0) {
+        return _client->write(data,length);
+    }
+    if (this->writeLength && (this->writeLength + length > this->writeBufferSize || millis() - this->writeTime >= this->writeDelay)) {
+        if (!flushWrites()) {
+            return 0;
+        }
+    }
+    if (length >= this->writeBufferSize) {
+        return _client->write(data,length);
+    }
+    if (this->writeLength == 0) {
+        this->writeTime = millis();
+    }
+    memcpy(this->writeBuffer + this->writeLength, data, length);
+    this->writeLength += length;
+    return length;
+}
+
+boolean PubSubClient::flushWrites() {
+    if (this->writeLength == 0) {
+        return true;
+    }
+    uint16_t length = this->writeLength;
+    this->writeLength = 0;
+    size_t rc = 0;
+#ifdef MQTT_MAX_TRANSFER_SIZE
+    while (rc < length) {
+        size_t bytesToWrite = (length - rc > MQTT_MAX_TRANSFER_SIZE)?MQTT_MAX_TRANSFER_SIZE:length - rc;
+        size_t n = _client->write(this->writeBuffer + rc,bytesToWrite);
+        rc += n;
+        if (n != bytesToWrite) {
+            break;
+        }
+    }
+#else
+    rc = _client->write(this->writeBuffer,length);
+#endif
+    if (rc != length) {
+        // Part of a packet is lost, the connection can't be used any more
+        _client->stop();
+        return false;
+    }
+    return true;
 }
 
-size_t PubSubClient::buildHeader(uint8_t header, uint8_t* buf, uint16_t length) {
+size_t PubSubClient::buildHeader(uint8_t header, uint8_t* buf, uint32_t length) {
     uint8_t lenBuf[4];
     uint8_t llen = 0;
     uint8_t digit;
     uint8_t pos = 0;
-    uint16_t len = length;
+    uint32_t len = length;
     do {
 
         digit = len  & 127; //digit = len %128
@@ -589,17 +1305,21 @@ boolean PubSubClient::write(uint8_t header, uint8_t* buf, uint16_t length) {
     boolean result = true;
     while((bytesRemaining > 0) && result) {
         bytesToWrite = (bytesRemaining > MQTT_MAX_TRANSFER_SIZE)?MQTT_MAX_TRANSFER_SIZE:bytesRemaining;
-        rc = _client->write(writeBuf,bytesToWrite);
+        rc = clientWrite(writeBuf,bytesToWrite);
         result = (rc == bytesToWrite);
         bytesRemaining -= rc;
         writeBuf += rc;
     }
-    return result;
 #else
-    rc = _client->write(buf+(MQTT_MAX_HEADER_SIZE-hlen),length+hlen);
+    rc = clientWrite(buf+(MQTT_MAX_HEADER_SIZE-hlen),length+hlen);
     lastOutActivity = millis();
-    return (rc == hlen+length);
+    boolean result = (rc == hlen+length);
 #endif
+    if ((header & 0xF0) != MQTTPUBLISH) {
+        // Only PUBLISH packets wait in the write buffer
+        result = flushWrites() && result;
+    }
+    return result;
 }
 
 boolean PubSubClient::subscribe(const char* topic) {
@@ -658,6 +1378,8 @@ boolean PubSubClient::unsubscribe(const char* topic) {
 }
 
 void PubSubClient::disconnect() {
+    this->linkState = MQTT_LINK_IDLE;
+    flushWrites();
     this->buffer[0] = MQTTDISCONNECT;
     this->buffer[1] = 0;
     _client->write(this->buffer,2);
@@ -759,6 +1481,61 @@ boolean PubSubClient::setBufferSize(uint16_t size) {
 uint16_t PubSubClient::getBufferSize() {
     return this->bufferSize;
 }
+
+boolean PubSubClient::setWriteBuffer(uint16_t size) {
+    return setWriteBuffer(size, MQTT_WRITE_DELAY);
+}
+
+boolean PubSubClient::setWriteBuffer(uint16_t size, uint16_t delay) {
+    flushWrites();
+    free(this->writeBuffer);
+    this->writeBuffer = NULL;
+    this->writeBufferSize = 0;
+    this->writeDelay = delay;
+    if (size == 0) {
+        return true;
+    }
+    this->writeBuffer = (uint8_t*)malloc(size);
+    if (this->writeBuffer == NULL) {
+        return false;
+    }
+    this->writeBufferSize = size;
+    return true;
+}
+
+boolean PubSubClient::setPublishWindow(uint8_t window, uint16_t packetSize) {
+    free(this->inflight);
+    free(this->inflightStore);
+    this->inflight = NULL;
+    this->inflightStore = NULL;
+    this->inflightWindow = 0;
+    this->inflightSize = 0;
+    if (window == 0) {
+        return true;
+    }
+    this->inflight = (MQTTInflight*)calloc(window, sizeof(MQTTInflight));
+    this->inflightStore = (uint8_t*)malloc((uint32_t)window * packetSize);
+    if (this->inflight == NULL || this->inflightStore == NULL) {
+        free(this->inflight);
+        free(this->inflightStore);
+        this->inflight = NULL;
+        this->inflightStore = NULL;
+        return false;
+    }
+    this->inflightWindow = window;
+    this->inflightSize = packetSize;
+    return true;
+}
+
+uint8_t PubSubClient::getInflightCount() {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < this->inflightWindow; i++) {
+        if (this->inflight[i].msgId != 0) {
+            count++;
+        }
+    }
+    return count;
+}
 PubSubClient& PubSubClient::setKeepAlive(uint16_t keepAlive) {
     this->keepAlive = keepAlive;
     return *this;
@@ -767,3 +1544,12 @@ PubSubClient& PubSubClient::setSocketTimeout(uint16_t timeout) {
     this->socketTimeout = timeout;
     return *this;
 }
+PubSubClient& PubSubClient::setPubAckTimeout(uint16_t timeout) {
+    this->pubAckTimeout = timeout;
+    return *this;
+}
+PubSubClient& PubSubClient::setBackoff(unsigned long minDelay, unsigned long maxDelay) {
+    this->backoffMin = minDelay;
+    this->backoffMax = maxDelay;
+    return *this;
+}
@@ -36,6 +36,35 @@
 #define MQTT_SOCKET_TIMEOUT 15
 #endif
 
+// MQTT_PUBACK_TIMEOUT: time in milliseconds to wait for the PUBACK of a QoS 1 publish
+//  before it is sent again. Override with setPubAckTimeout()
+#ifndef MQTT_PUBACK_TIMEOUT
+#define MQTT_PUBACK_TIMEOUT 2000
+#endif
+
+// MQTT_BACKOFF_MIN, MQTT_BACKOFF_MAX: delay in milliseconds before the first retry
+//  of a connection started with beginConnect(), doubled after each failure up to
+//  the maximum. Override with setBackoff()
+#ifndef MQTT_BACKOFF_MIN
+#define MQTT_BACKOFF_MIN 500
+#endif
+#ifndef MQTT_BACKOFF_MAX
+#define MQTT_BACKOFF_MAX 30000
+#endif
+
+// MQTT_WRITE_DELAY: time in milliseconds a PUBLISH may wait in the write buffer of
+//  setWriteBuffer() for more packets to share its client write. Override with
+//  setWriteBuffer(size, delay)
+#ifndef MQTT_WRITE_DELAY
+#define MQTT_WRITE_DELAY 10
+#endif
+
+// MQTT_MAX_TOPIC_MATCH : number of handlers of addHandler() called for one message,
+//  and of partial matches followed at once through the topic filters
+#ifndef MQTT_MAX_TOPIC_MATCH
+#define MQTT_MAX_TOPIC_MATCH 8
+#endif
+
 // MQTT_MAX_TRANSFER_SIZE : limit how much data is passed to the network client
 //  in each write call. Needed for the Arduino Wifi Shield. Leave undefined to
 //  pass the entire MQTT packet in each write call.
@@ -53,6 +82,14 @@
 #define MQTT_CONNECT_BAD_CREDENTIALS 4
 #define MQTT_CONNECT_UNAUTHORIZED    5
 
+// Possible values for client.getLinkState(), the connection driven by loop()
+#define MQTT_LINK_IDLE          0 // not started with beginConnect(), or disconnect() called
+#define MQTT_LINK_TCP_CONNECT   1
+#define MQTT_LINK_CONNACK_WAIT  2
+#define MQTT_LINK_RESUBSCRIBE   3
+#define MQTT_LINK_CONNECTED     4
+#define MQTT_LINK_BACKOFF       5 // waiting for the next attempt
+
 #define MQTTCONNECT     1 << 4  // Client request to connect to Server
 #define MQTTCONNACK     2 << 4  // Connect Acknowledgment
 #define MQTTPUBLISH     3 << 4  // Publish message
@@ -72,6 +109,7 @@
 #define MQTTQOS0        (0 << 1)
 #define MQTTQOS1        (1 << 1)
 #define MQTTQOS2        (2 << 1)
+#define MQTTDUP         (1 << 3)
 
 // Maximum size of fixed header and variable length size header
 #define MQTT_MAX_HEADER_SIZE 5
@@ -83,8 +121,40 @@
 #define MQTT_CALLBACK_SIGNATURE void (*callback)(char*, uint8_t*, unsigned int)
 #endif
 
+typedef void (*MQTTHandler)(char*, uint8_t*, unsigned int);
+
 #define CHECK_STRING_LENGTH(l,s) if (l+2+strnlen(s, this->bufferSize) > this->bufferSize) {_client->stop();return false;}
 
+// A QoS 1 publish waiting for its PUBACK; the packet is kept in the retry store
+struct MQTTInflight {
+   uint16_t msgId;        // 0 if the slot is free
+   uint16_t length;       // remaining length of the packet
+   uint8_t header;
+   unsigned long sentAt;
+};
+
+// One piece of a payload sent with publish(topic, segments, count, retained)
+struct MQTTSegment {
+   const uint8_t* data;
+   size_t length;
+};
+
+// A topic subscribed again after each connection made by loop()
+struct MQTTSubscription {
+   const char* topic;
+   uint8_t qos;
+};
+
+// One level of a topic filter of addHandler(), the filters are kept as a trie:
+// child is the first node of the next level, next the following node of this one
+struct MQTTTopicNode {
+   const char* level;
+   uint8_t length;
+   uint16_t child;
+   uint16_t next;
+   MQTTHandler handler;
+};
+
 class PubSubClient : public Print {
 private:
    Client* _client;
@@ -106,7 +176,48 @@ private:
    // Returns the size of the header
    // Note: the header is built at the end of the first MQTT_MAX_HEADER_SIZE bytes, so will start
    //       (MQTT_MAX_HEADER_SIZE - <returned size>) bytes into the buffer
-   size_t buildHeader(uint8_t header, uint8_t* buf, uint16_t length);
+   size_t buildHeader(uint8_t header, uint8_t* buf, uint32_t length);
+   boolean writeSegment(const uint8_t* data, size_t length);
+   // In-flight window of QoS 1 publishes, each slot of the retry store holds
+   // one packet (with room for the header) of up to inflightSize bytes
+   MQTTInflight* inflight;
+   uint8_t* inflightStore;
+   uint8_t inflightWindow;
+   uint16_t inflightSize;
+   uint16_t pubAckTimeout;
+   uint16_t nextPublishId();
+   void retryInflight(boolean all);
+   boolean writeConnect(const char* id, const char* user, const char* pass, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage, boolean cleanSession);
+   boolean readConnack(boolean cleanSession);
+   // Connection state machine of beginConnect(), the strings are not copied
+   uint8_t linkState;
+   uint8_t linkAttempts;
+   uint16_t linkIndex;
+   unsigned long linkTime;
+   unsigned long linkDelay;
+   unsigned long backoffMin;
+   unsigned long backoffMax;
+   const char* connectId;
+   const char* connectUser;
+   const char* connectPass;
+   const char* connectWillTopic;
+   uint8_t connectWillQos;
+   boolean connectWillRetain;
+   const char* connectWillMessage;
+   boolean connectCleanSession;
+   MQTTSubscription* subscriptions;
+   uint16_t subscriptionCount;
+   void backoff(unsigned long t);
+   MQTTTopicNode* topicNodes;
+   uint16_t topicNodeCount;
+   void dispatch(char* topic, uint8_t* payload, unsigned int length);
+   uint8_t* writeBuffer;
+   uint16_t writeBufferSize;
+   uint16_t writeLength;
+   uint16_t writeDelay;
+   unsigned long writeTime;
+   size_t clientWrite(const uint8_t* data, size_t length);
+   boolean runLink(unsigned long t);
    IPAddress ip;
    const char* domain;
    uint16_t port;
@@ -138,9 +249,28 @@ public:
    PubSubClient& setStream(Stream& stream);
    PubSubClient& setKeepAlive(uint16_t keepAlive);
    PubSubClient& setSocketTimeout(uint16_t timeout);
+   PubSubClient& setPubAckTimeout(uint16_t timeout);
+   PubSubClient& setBackoff(unsigned long minDelay, unsigned long maxDelay);
 
    boolean setBufferSize(uint16_t size);
    uint16_t getBufferSize();
+   // Allocate the retry store for QoS 1 publishing: up to window messages can
+   // wait for their PUBACK at once, each packet of up to packetSize bytes.
+   // A window of 0 frees the store. Returns false if the allocation failed
+   boolean setPublishWindow(uint8_t window, uint16_t packetSize);
+   // Allocate a buffer of size bytes in which PUBLISH packets are collected, to
+   // reach the Client in fewer, larger writes. It is written out when full, by
+   // flushWrites(), by loop() once the first packet has waited delay ms, and
+   // before any other packet. publish() then returns true for a packet that is
+   // still buffered. A size of 0 frees the buffer. Returns false if the
+   // allocation failed
+   boolean setWriteBuffer(uint16_t size);
+   boolean setWriteBuffer(uint16_t size, uint16_t delay);
+   // Write out the buffered packets; returns false, and closes the connection,
+   // if the Client didn't take them all
+   boolean flushWrites();
+   // Number of QoS 1 publishes waiting for their PUBACK
+   uint8_t getInflightCount();
 
    boolean connect(const char* id);
    boolean connect(const char* id, const char* user, const char* pass);
@@ -148,10 +278,32 @@ public:
    boolean connect(const char* id, const char* user, const char* pass, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage);
    boolean connect(const char* id, const char* user, const char* pass, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage, boolean cleanSession);
    void disconnect();
+   // Connect without blocking: loop() makes the TCP connection, sends CONNECT,
+   // waits for CONNACK and subscribes to the topics of addSubscription(), one step
+   // per call, and connects again with backoff whenever the connection is lost.
+   // The strings must stay valid. Returns true if already connected
+   boolean beginConnect(const char* id);
+   boolean beginConnect(const char* id, const char* user, const char* pass);
+   boolean beginConnect(const char* id, const char* user, const char* pass, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage, boolean cleanSession);
+   // Subscribe now if connected, and again after each connection made by loop();
+   // the topic string is not copied
+   boolean addSubscription(const char* topic, uint8_t qos);
+   uint8_t getLinkState();
+   // Call handler for the messages on topics matching filter, which may contain
+   // the + and # wildcards; a NULL handler removes it. The callback only gets
+   // the messages that match no filter. Handlers are called in turn with the
+   // same topic and payload, publishing from one overwrites both for the next.
+   // The filter string is not copied
+   boolean addHandler(const char* filter, MQTTHandler handler);
    boolean publish(const char* topic, const char* payload);
    boolean publish(const char* topic, const char* payload, boolean retained);
    boolean publish(const char* topic, const uint8_t * payload, unsigned int plength);
    boolean publish(const char* topic, const uint8_t * payload, unsigned int plength, boolean retained);
+   // Publish with QoS 0 or 1. A QoS 1 message is kept until its PUBACK arrives in
+   // loop(), and sent again after the PUBACK timeout. Returns false if the packet
+   // is larger than the slots set with setPublishWindow(), or all slots are in use
+   boolean publish(const char* topic, const char* payload, boolean retained, uint8_t qos);
+   boolean publish(const char* topic, const uint8_t * payload, unsigned int plength, boolean retained, uint8_t qos);
    boolean publish_P(const char* topic, const char* payload, boolean retained);
    boolean publish_P(const char* topic, const uint8_t * payload, unsigned int plength, boolean retained);
    // Start to publish a message.
@@ -166,6 +318,13 @@ public:
    // Finish off this publish message (started with beginPublish)
    // Returns 1 if the packet was sent successfully, 0 if there was an error
    int endPublish();
+   // Publish a payload made of count segments, each written straight to the
+   // Client, without copying it into the buffer
+   boolean publish(const char* topic, const MQTTSegment* segments, uint8_t count, boolean retained);
+   // Publish plength bytes read from stream; the buffer is used to pass the
+   // payload on to the Client in pieces of getBufferSize() bytes. If stream ends
+   // early the connection is closed, as the packet can't be completed
+   boolean publish(const char* topic, Stream& stream, unsigned int plength, boolean retained);
    // Write a single byte of payload (only to be used with beginPublish/endPublish)
    virtual size_t write(uint8_t);
    // Write size bytes from buffer into the payload (only to be used with beginPublish/endPublish)
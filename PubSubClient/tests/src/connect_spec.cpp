@@ -312,6 +312,104 @@ int test_connect_custom_keepalive() {
 }
 
 
+int test_begin_connect_steps() {
+    IT("connects and resubscribes over successive loop calls");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connect[] = {0x10,0x18,0x0,0x4,0x4d,0x51,0x54,0x54,0x4,0x2,0x0,0xf,0x0,0xc,0x63,0x6c,0x69,0x65,0x6e,0x74,0x5f,0x74,0x65,0x73,0x74,0x31};
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.expect(connect,26);
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    IS_TRUE(client.addSubscription("topic",0));
+    int rc = client.beginConnect((char*)"client_test1");
+    IS_FALSE(rc);
+    IS_TRUE(client.getLinkState() == MQTT_LINK_TCP_CONNECT);
+
+    rc = client.loop();
+    IS_FALSE(rc);
+    IS_TRUE(client.getLinkState() == MQTT_LINK_CONNACK_WAIT);
+    IS_FALSE(shimClient.error());
+
+    byte subscribe[] = { 0x82,0xa,0x0,0x2,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0 };
+    shimClient.expect(subscribe,12);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.connected());
+    IS_TRUE(client.getLinkState() == MQTT_LINK_RESUBSCRIBE);
+    IS_FALSE(shimClient.error());
+
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.getLinkState() == MQTT_LINK_CONNECTED);
+
+    client.disconnect();
+    IS_TRUE(client.getLinkState() == MQTT_LINK_IDLE);
+
+    END_IT
+}
+
+int test_begin_connect_backoff() {
+    IT("retries a failed connection after the backoff delay");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(false);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setBackoff(0,0);
+    client.beginConnect((char*)"client_test1");
+
+    int rc = client.loop();
+    IS_FALSE(rc);
+    IS_TRUE(client.state() == MQTT_CONNECT_FAILED);
+    IS_TRUE(client.getLinkState() == MQTT_LINK_BACKOFF);
+
+    shimClient.setAllowConnect(true);
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    rc = client.loop();
+    IS_FALSE(rc);
+    IS_TRUE(client.getLinkState() == MQTT_LINK_CONNACK_WAIT);
+
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.getLinkState() == MQTT_LINK_CONNECTED);
+
+    END_IT
+}
+
+int test_begin_connect_reconnects() {
+    IT("connects again when the connection is lost");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setBackoff(0,0);
+    client.beginConnect((char*)"client_test1");
+    client.loop();
+    int rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.getLinkState() == MQTT_LINK_CONNECTED);
+
+    shimClient.setConnected(false);
+    rc = client.loop();
+    IS_FALSE(rc);
+    IS_TRUE(client.getLinkState() == MQTT_LINK_BACKOFF);
+
+    shimClient.respond(connack,4);
+    client.loop();
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.connected());
+
+    END_IT
+}
+
 int main()
 {
     SUITE("Connect");
@@ -332,5 +430,9 @@ int main()
     test_connect_disconnect_connect();
 
     test_connect_custom_keepalive();
+
+    test_begin_connect_steps();
+    test_begin_connect_backoff();
+    test_begin_connect_reconnects();
     FINISH
 }
@@ -5,6 +5,7 @@
 
 Stream::Stream() {
     this->expectBuffer = new Buffer();
+    this->readBuffer = new Buffer();
     this->_error = false;
     this->_written = 0;
 }
@@ -25,6 +26,13 @@ size_t Stream::write(uint8_t b)  {
     return 1;
 }
 
+size_t Stream::readBytes(char *buffer, size_t length) {
+    size_t count = 0;
+    while (count < length && this->readBuffer->available()) {
+        buffer[count++] = this->readBuffer->next();
+    }
+    return count;
+}
 
 bool Stream::error() {
     return this->_error;
@@ -34,6 +42,10 @@ void Stream::expect(uint8_t *buf, size_t size) {
     this->expectBuffer->add(buf,size);
 }
 
+void Stream::respond(uint8_t *buf, size_t size) {
+    this->readBuffer->add(buf,size);
+}
+
 uint16_t Stream::length() {
     return this->_written;
 }
@@ -7,15 +7,18 @@
 class Stream {
 private:
     Buffer* expectBuffer;
+    Buffer* readBuffer;
     bool _error;
     uint16_t _written;
 
 public:
     Stream();
     virtual size_t write(uint8_t);
+    virtual size_t readBytes(char *buffer, size_t length);
     
     virtual bool error();
     virtual void expect(uint8_t *buf, size_t size);
+    virtual void respond(uint8_t *buf, size_t size);
     virtual uint16_t length();
 };
 
@@ -173,8 +173,280 @@ int test_publish_P() {
     END_IT
 }
 
+int test_publish_qos1() {
+    IT("publishes qos1 with a message id");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    rc = client.publish((char*)"topic",(char*)"payload",false,1);
+    IS_FALSE(rc);
+
+    rc = client.setPublishWindow(2,64);
+    IS_TRUE(rc);
+
+    byte publish[] = {0x32,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,18);
+
+    rc = client.publish((char*)"topic",(char*)"payload",false,1);
+    IS_TRUE(rc);
+    IS_TRUE(client.getInflightCount() == 1);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publish_qos1_window() {
+    IT("publishes qos1 up to the in-flight window and frees it on puback");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    client.setPublishWindow(2,64);
+
+    rc = client.publish((char*)"topic",(char*)"payload",false,1);
+    IS_TRUE(rc);
+    rc = client.publish((char*)"topic",(char*)"payload",true,1);
+    IS_TRUE(rc);
+    rc = client.publish((char*)"topic",(char*)"payload",false,1);
+    IS_FALSE(rc);
+    IS_TRUE(client.getInflightCount() == 2);
+
+    byte puback[] = {0x40,0x2,0x0,0x3};
+    shimClient.respond(puback,4);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.getInflightCount() == 1);
+
+    byte publish[] = {0x32,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x4,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,18);
+    rc = client.publish((char*)"topic",(char*)"payload",false,1);
+    IS_TRUE(rc);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publish_qos1_retry() {
+    IT("publishes qos1 again with dup after the puback timeout");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
 
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    client.setPublishWindow(1,64);
+    client.setPubAckTimeout(0);
+
+    rc = client.publish((char*)"topic",(char*)"payload",false,1);
+    IS_TRUE(rc);
+
+    byte publish[] = {0x3a,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,18);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_FALSE(shimClient.error());
+
+    byte puback[] = {0x40,0x2,0x0,0x2};
+    shimClient.respond(puback,4);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.getInflightCount() == 0);
+
+    END_IT
+}
+
+int test_publish_qos1_too_long() {
+    IT("publish qos1 fails when the packet does not fit in a slot");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
 
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    client.setPublishWindow(1,20);
+
+    rc = client.publish((char*)"topic",(char*)"payload-too-long",false,1);
+    IS_FALSE(rc);
+    IS_TRUE(client.getInflightCount() == 0);
+
+    END_IT
+}
+
+int test_publish_segments() {
+    IT("publishes a payload from segments");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    MQTTSegment segments[] = { {(const uint8_t*)"pay",3}, {NULL,0}, {(const uint8_t*)"load",4} };
+
+    byte publish[] = {0x31,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,16);
+
+    rc = client.publish((char*)"topic",segments,3,true);
+    IS_TRUE(rc);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publish_stream() {
+    IT("publishes a payload from a stream larger than the buffer");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    client.setBufferSize(16);
+
+    byte payload[40];
+    for (int i = 0; i < 40; i++) {
+        payload[i] = i;
+    }
+    Stream stream;
+    stream.respond(payload,40);
+
+    byte header[] = {0x30,0x2f,0x0,0x5,0x74,0x6f,0x70,0x69,0x63};
+    shimClient.expect(header,9);
+    shimClient.expect(payload,40);
+
+    rc = client.publish((char*)"topic",stream,40,false);
+    IS_TRUE(rc);
+
+    IS_FALSE(shimClient.error());
+    IS_TRUE(client.connected());
+
+    END_IT
+}
+
+int test_publish_stream_short() {
+    IT("publish from a stream that ends early closes the connection");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte payload[] = { 0x01,0x02,0x03 };
+    Stream stream;
+    stream.respond(payload,3);
+
+    rc = client.publish((char*)"topic",stream,10,false);
+    IS_FALSE(rc);
+    IS_FALSE(client.connected());
+
+    END_IT
+}
+
+
+int test_publish_write_buffer() {
+    IT("collects publishes in the write buffer until flushed");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    IS_TRUE(client.setWriteBuffer(64,10000));
+    uint16_t sent = shimClient.received();
+
+    byte publish[] = {0x30,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,16);
+    shimClient.expect(publish,16);
+
+    rc = client.publish((char*)"topic",(char*)"payload");
+    IS_TRUE(rc);
+    rc = client.publish((char*)"topic",(char*)"payload");
+    IS_TRUE(rc);
+    IS_TRUE(shimClient.received() == sent);
+
+    rc = client.flushWrites();
+    IS_TRUE(rc);
+    IS_TRUE(shimClient.received() == sent + 32);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publish_write_buffer_order() {
+    IT("writes buffered publishes before other packets and large ones");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    IS_TRUE(client.setWriteBuffer(20,10000));
+    uint16_t sent = shimClient.received();
+
+    byte publish[] = {0x30,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    byte subscribe[] = { 0x82,0xa,0x0,0x2,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0 };
+    shimClient.expect(publish,16);
+    shimClient.expect(subscribe,12);
+
+    rc = client.publish((char*)"topic",(char*)"payload");
+    IS_TRUE(rc);
+    IS_TRUE(shimClient.received() == sent);
+    rc = client.subscribe((char*)"topic");
+    IS_TRUE(rc);
+    IS_TRUE(shimClient.received() == sent + 28);
+    IS_FALSE(shimClient.error());
+
+    byte publishLong[] = {0x30,0x17,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64,0x32,0x32};
+    shimClient.expect(publish,16);
+    shimClient.expect(publishLong,25);
+    rc = client.publish((char*)"topic",(char*)"payload");
+    IS_TRUE(rc);
+    rc = client.publish((char*)"topic",(char*)"payloadpayload22");
+    IS_TRUE(rc);
+    IS_TRUE(shimClient.received() == sent + 28 + 41);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
 
 int main()
 {
@@ -186,6 +458,15 @@ int main()
     test_publish_not_connected();
     test_publish_too_long();
     test_publish_P();
+    test_publish_qos1();
+    test_publish_qos1_window();
+    test_publish_qos1_retry();
+    test_publish_qos1_too_long();
+    test_publish_segments();
+    test_publish_stream();
+    test_publish_stream_short();
+    test_publish_write_buffer();
+    test_publish_write_buffer_order();
 
     FINISH
 }
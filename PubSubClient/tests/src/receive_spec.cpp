@@ -324,6 +324,106 @@ int test_receive_qos1() {
     END_IT
 }
 
+int handler_calls[3];
+
+void handler_0(char* topic, byte* payload, unsigned int length) { handler_calls[0]++; }
+void handler_1(char* topic, byte* payload, unsigned int length) { handler_calls[1]++; }
+void handler_2(char* topic, byte* payload, unsigned int length) { handler_calls[2]++; }
+
+// Receive a qos 0 message with an empty payload on topic
+void receive_on(ShimClient& shimClient, PubSubClient& client, const char* topic) {
+    byte publish[64];
+    size_t tl = strlen(topic);
+    publish[0] = 0x30;
+    publish[1] = tl+2;
+    publish[2] = 0;
+    publish[3] = tl;
+    memcpy(publish+4,topic,tl);
+    shimClient.respond(publish,tl+4);
+    reset_callback();
+    memset(handler_calls,0,sizeof(handler_calls));
+    client.loop();
+}
+
+int test_receive_handlers() {
+    IT("calls the handlers of the matching topic filters");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    IS_TRUE(client.addHandler("a/+/c",handler_0));
+    IS_TRUE(client.addHandler("a/#",handler_1));
+    IS_TRUE(client.addHandler("a/b",handler_2));
+
+    receive_on(shimClient,client,"a/b/c");
+    IS_TRUE(handler_calls[0] == 1);
+    IS_TRUE(handler_calls[1] == 1);
+    IS_TRUE(handler_calls[2] == 0);
+    IS_FALSE(callback_called);
+
+    receive_on(shimClient,client,"a/b");
+    IS_TRUE(handler_calls[0] == 0);
+    IS_TRUE(handler_calls[1] == 1);
+    IS_TRUE(handler_calls[2] == 1);
+
+    receive_on(shimClient,client,"a");
+    IS_TRUE(handler_calls[1] == 1);
+
+    receive_on(shimClient,client,"b/b/c");
+    IS_TRUE(handler_calls[0] == 0);
+    IS_TRUE(handler_calls[1] == 0);
+    IS_TRUE(callback_called);
+    IS_TRUE(strcmp(lastTopic,"b/b/c")==0);
+
+    IS_TRUE(client.addHandler("a/#",NULL));
+    receive_on(shimClient,client,"a/x");
+    IS_TRUE(handler_calls[1] == 0);
+    IS_TRUE(callback_called);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_receive_handler_filters() {
+    IT("rejects invalid topic filters and keeps $ topics from wildcards");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    IS_FALSE(client.addHandler("a/#/b",handler_0));
+    IS_FALSE(client.addHandler("a/b#",handler_0));
+    IS_FALSE(client.addHandler("a+/b",handler_0));
+    IS_FALSE(client.addHandler("",handler_0));
+
+    IS_TRUE(client.addHandler("#",handler_0));
+    IS_TRUE(client.addHandler("$SYS/+",handler_1));
+
+    receive_on(shimClient,client,"$SYS/uptime");
+    IS_TRUE(handler_calls[0] == 0);
+    IS_TRUE(handler_calls[1] == 1);
+
+    receive_on(shimClient,client,"x/y/z");
+    IS_TRUE(handler_calls[0] == 1);
+    IS_FALSE(callback_called);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
 int main()
 {
     SUITE("Receive");
@@ -335,6 +435,8 @@ int main()
     test_resize_buffer();
     test_receive_oversized_stream_message();
     test_receive_qos1();
+    test_receive_handlers();
+    test_receive_handler_filters();
 
     FINISH
 }
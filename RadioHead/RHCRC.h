@@ -16,4 +16,7 @@ extern uint16_t RHcrc_xmodem_update (uint16_t crc, uint8_t data);
 extern uint16_t RHcrc_ccitt_update (uint16_t crc, uint8_t data);
 extern uint8_t  RHcrc_ibutton_update(uint8_t crc, uint8_t data);
 
+// RHcrc_ccitt_update() over a whole buffer
+extern uint16_t RHcrc_ccitt(uint16_t crc, const uint8_t* data, uint16_t len);
+
 #endif
@@ -69,6 +69,11 @@ bool RHDatagram::waitPacketSent(uint16_t timeout)
     return _driver.waitPacketSent(timeout);
 }
 
+uint8_t RHDatagram::maxMessageLength()
+{
+    return _driver.maxMessageLength();
+}
+
 bool RHDatagram::waitAvailableTimeout(uint16_t timeout, uint16_t polldelay)
 {
     return _driver.waitAvailableTimeout(timeout, polldelay);
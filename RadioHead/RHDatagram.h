@@ -106,6 +106,10 @@ public:
     /// is no longer transmitting.
     bool            waitPacketSent();
 
+    /// Returns the maximum message length of the Driver
+    /// \return The maximum legal message length that can be sent by sendto()
+    uint8_t         maxMessageLength();
+
     /// Blocks until the transmitter is no longer transmitting.
     /// or until the timeout occuers, whichever happens first
     /// \param[in] timeout Maximum time to wait in milliseconds.
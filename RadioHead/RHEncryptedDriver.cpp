@@ -10,13 +10,21 @@
 
 RHEncryptedDriver::RHEncryptedDriver(RHGenericDriver& driver, BlockCipher& blockcipher)
     : _driver(driver),
-      _blockcipher(blockcipher)
+      _blockcipher(blockcipher),
+      _cipherMode(ModeBlock),
+      _nonceCounter(0)
 {
     _buffer = (uint8_t *)calloc(_driver.maxMessageLength(), sizeof(uint8_t));
+#if (RH_PLATFORM == RH_PLATFORM_ESP32)
+    _nonceCounter = esp_random();
+#endif
 }
 
 bool RHEncryptedDriver::recv(uint8_t* buf, uint8_t* len)
 {
+    if (_cipherMode != ModeBlock)
+	return recvCtr(buf, len);
+
     int h = 0; // Index of output _buffer
 
     bool status = _driver.recv(_buffer, len);
@@ -51,6 +59,9 @@ bool RHEncryptedDriver::recv(uint8_t* buf, uint8_t* len)
 
 bool RHEncryptedDriver::send(const uint8_t* data, uint8_t len)
 {
+    if (_cipherMode != ModeBlock)
+	return sendCtr(data, len);
+
     if (len > maxMessageLength())
 	return false;
     
@@ -143,6 +154,11 @@ uint8_t RHEncryptedDriver::maxMessageLength()
 {
     int driver_len = _driver.maxMessageLength();
     
+    if (_cipherMode == ModeCTR)
+	return driver_len - RH_ENCRYPTED_NONCE_LEN;
+    if (_cipherMode == ModeCCM)
+	return driver_len - RH_ENCRYPTED_NONCE_LEN - RH_ENCRYPTED_CCM_TAG_LEN;
+
 #ifndef ALLOW_MULTIPLE_MSG
     driver_len = ((int)(driver_len/_blockcipher.blockSize()) ) * _blockcipher.blockSize();
 #endif
@@ -153,4 +169,111 @@ uint8_t RHEncryptedDriver::maxMessageLength()
     return driver_len;
 }
 
+// The counter block (A_i) and first CBC-MAC block (B0) of AES-CCM, with a 13 octet nonce made of 
+// the FROM header and the message counter
+void RHEncryptedDriver::counterBlock(uint8_t* block, uint8_t flags, uint8_t from, uint32_t nonce, uint16_t i)
+{
+    memset(block, 0, 16);
+    block[0] = flags;
+    block[1] = from;
+    block[2] = nonce >> 24;
+    block[3] = nonce >> 16;
+    block[4] = nonce >> 8;
+    block[5] = nonce;
+    block[14] = i >> 8;
+    block[15] = i;
+}
+
+void RHEncryptedDriver::ctrCrypt(const uint8_t* in, uint8_t* out, uint8_t len, uint8_t from, uint32_t nonce, uint8_t* tag, bool encrypt)
+{
+    uint8_t a[16]; // Counter block, then scratch
+    uint8_t s[16]; // Keystream block
+    uint8_t x[16]; // CBC-MAC state
+    uint16_t i = 1;
+    uint8_t offset, j;
+
+    if (tag)
+    {
+	// Flags: no associated data, tag length, 2 octet length field
+	counterBlock(a, (((RH_ENCRYPTED_CCM_TAG_LEN - 2) / 2) << 3) | 1, from, nonce, len);
+	_blockcipher.encryptBlock(x, a);
+    }
+    for (offset = 0; offset < len; offset += j, i++)
+    {
+	uint8_t n = (len - offset > 16) ? 16 : len - offset;
+	counterBlock(a, 1, from, nonce, i);
+	_blockcipher.encryptBlock(s, a);
+	for (j = 0; j < n; j++)
+	{
+	    uint8_t plain = encrypt ? in[offset + j] : in[offset + j] ^ s[j];
+	    out[offset + j] = in[offset + j] ^ s[j];
+	    if (tag)
+		x[j] ^= plain;
+	}
+	if (tag)
+	{
+	    _blockcipher.encryptBlock(a, x);
+	    memcpy(x, a, 16);
+	}
+    }
+    if (tag)
+    {
+	counterBlock(a, 1, from, nonce, 0);
+	_blockcipher.encryptBlock(s, a);
+	for (j = 0; j < RH_ENCRYPTED_CCM_TAG_LEN; j++)
+	    tag[j] = x[j] ^ s[j];
+    }
+}
+
+bool RHEncryptedDriver::sendCtr(const uint8_t* data, uint8_t len)
+{
+    if (len > maxMessageLength() || _blockcipher.blockSize() != 16)
+	return false;
+
+    uint32_t nonce = _nonceCounter++;
+    _buffer[0] = nonce >> 24;
+    _buffer[1] = nonce >> 16;
+    _buffer[2] = nonce >> 8;
+    _buffer[3] = nonce;
+    uint8_t* tag = (_cipherMode == ModeCCM) ? &_buffer[RH_ENCRYPTED_NONCE_LEN + len] : NULL;
+    // Encrypt straight into the send buffer, no padding
+    ctrCrypt(data, &_buffer[RH_ENCRYPTED_NONCE_LEN], len, _txHeaderFrom, nonce, tag, true);
+    return _driver.send(_buffer, RH_ENCRYPTED_NONCE_LEN + len + (tag ? RH_ENCRYPTED_CCM_TAG_LEN : 0));
+}
+
+bool RHEncryptedDriver::recvCtr(uint8_t* buf, uint8_t* len)
+{
+    uint8_t rxlen = _driver.maxMessageLength();
+    if (!_driver.recv(_buffer, &rxlen))
+	return false;
+
+    uint8_t overhead = RH_ENCRYPTED_NONCE_LEN + ((_cipherMode == ModeCCM) ? RH_ENCRYPTED_CCM_TAG_LEN : 0);
+    if (rxlen < overhead || _blockcipher.blockSize() != 16)
+	return false;
+    uint8_t msglen = rxlen - overhead;
+    uint32_t nonce = ((uint32_t)_buffer[0] << 24) | ((uint32_t)_buffer[1] << 16) | ((uint32_t)_buffer[2] << 8) | _buffer[3];
+
+    // Decrypt in place
+    uint8_t tag[RH_ENCRYPTED_CCM_TAG_LEN];
+    ctrCrypt(&_buffer[RH_ENCRYPTED_NONCE_LEN], &_buffer[RH_ENCRYPTED_NONCE_LEN], msglen, _driver.headerFrom(), nonce,
+	     (_cipherMode == ModeCCM) ? tag : NULL, false);
+    if (_cipherMode == ModeCCM)
+    {
+	uint8_t diff = 0;
+	uint8_t j;
+	for (j = 0; j < RH_ENCRYPTED_CCM_TAG_LEN; j++)
+	    diff |= tag[j] ^ _buffer[RH_ENCRYPTED_NONCE_LEN + msglen + j];
+	if (diff)
+	    return false; // Wrong key or tampered
+    }
+
+    if (buf && len)
+    {
+	if (*len > msglen)
+	    *len = msglen;
+	memcpy(buf, &_buffer[RH_ENCRYPTED_NONCE_LEN], *len);
+    }
+    return true;
+}
+
 #endif
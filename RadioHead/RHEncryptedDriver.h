@@ -26,6 +26,14 @@
 // With STRICT_CONTENT_LEN, receiver will try to extract length from every message !!!!
 //#define ALLOW_MULTIPLE_MSG  
 
+// Octets of message counter sent at the start of each message in CTR and CCM modes
+#define RH_ENCRYPTED_NONCE_LEN 4
+
+// Octets of authentication tag added to each message in CCM mode. 4, 6, 8, 10, 12, 14 or 16
+#ifndef RH_ENCRYPTED_CCM_TAG_LEN
+#define RH_ENCRYPTED_CCM_TAG_LEN 4
+#endif
+
 /////////////////////////////////////////////////////////////////////
 /// \class RHEncryptedDriver RHEncryptedDriver <RHEncryptedDriver.h>
 /// \brief Virtual Driver to encrypt/decrypt data. Can be used with any other RadioHead driver.
@@ -40,6 +48,24 @@
 /// In order to enable this module you must uncomment #define RH_ENABLE_ENCRYPTION_MODULE at the bottom of RadioHead.h
 /// But ensure you have installed the Crypto directory from arduinolibs first:
 /// http://rweather.github.io/arduinolibs/index.html
+///
+/// \par CTR and CCM modes
+///
+/// By default each message is padded to a whole number of cipher blocks and each block is encrypted on its own.
+/// With setCipherMode(ModeCTR) the message is instead XORed with an AES counter mode keystream, so it is 
+/// not padded: it grows only by the RH_ENCRYPTED_NONCE_LEN (4) octet message counter sent in front of it.
+/// ModeCCM is CTR plus a RH_ENCRYPTED_CCM_TAG_LEN octet authentication tag (AES-CCM, RFC 3610), and messages 
+/// that were not encrypted with the same key, or were changed on the way, are silently dropped.
+/// Both modes only ever use the cipher's encryptBlock(), need a cipher with a 16 octet block size (eg AES128)
+/// and must be used by all nodes.
+///
+/// The counter block for each message includes the FROM header and the message counter, and the same 
+/// counter must never be used twice by a node with the same key. The counter starts from 
+/// a hardware random number on ESP32, otherwise from 0: on other platforms call setNonceCounter() in setup() 
+/// with a random number or a counter saved in EEPROM.
+///
+/// RHHardwareAES is an AES128 BlockCipher that uses the AES hardware on ESP32 and nRF52, and is the best
+/// choice for CTR and CCM modes on those processors.
 
 class RHEncryptedDriver : public RHGenericDriver
 {
@@ -51,6 +77,26 @@ public:
     /// the blockcipher has had its key set before sending or receiving messages.
     RHEncryptedDriver(RHGenericDriver& driver, BlockCipher& blockcipher);
 
+    /// Ways of encrypting messages, see setCipherMode()
+    typedef enum
+    {
+	ModeBlock = 0,          ///< Pad the message to whole blocks and encrypt each block. The default
+	ModeCTR,                ///< AES counter mode, no padding
+	ModeCCM                 ///< AES counter mode with authentication tag
+    } CipherMode;
+
+    /// Sets the way messages are encrypted. All nodes must use the same mode.
+    /// \param[in] mode The new mode, one of CipherMode
+    void setCipherMode(CipherMode mode) { _cipherMode = mode;};
+
+    /// Sets the counter that is sent with, and makes unique, each message in CTR and CCM modes. 
+    /// \param[in] counter The counter for the next message
+    void setNonceCounter(uint32_t counter) { _nonceCounter = counter;};
+
+    /// Returns the counter for the next message sent in CTR and CCM modes
+    /// \return The counter
+    uint32_t nonceCounter() { return _nonceCounter;};
+
     /// Calls the real driver's init()
     /// \return The value returned from the driver init() method;
     virtual bool init() { return _driver.init();};
@@ -141,7 +187,7 @@ public:
 
     /// Sets the FROM header to be sent in all subsequent messages
     /// \param[in] from The new FROM header value
-    virtual void           setHeaderFrom(uint8_t from){ _driver.setHeaderFrom(from);};
+    virtual void           setHeaderFrom(uint8_t from){ _txHeaderFrom = from; _driver.setHeaderFrom(from);};
 
     /// Sets the ID header to be sent in all subsequent messages
     /// \param[in] id The new ID header value
@@ -234,6 +280,25 @@ private:
     
     /// Buffer to store encrypted/decrypted message
     uint8_t*                _buffer;
+
+    /// How messages are encrypted
+    CipherMode              _cipherMode;
+
+    /// Counter for the next message sent in CTR and CCM modes
+    uint32_t                _nonceCounter;
+
+    /// Fills in a CCM counter or B0 block
+    void counterBlock(uint8_t* block, uint8_t flags, uint8_t from, uint32_t nonce, uint16_t i);
+
+    /// Encrypts or decrypts a message in CTR mode, and computes the CCM tag if tag is not NULL.
+    /// out may be the same as in.
+    void ctrCrypt(const uint8_t* in, uint8_t* out, uint8_t len, uint8_t from, uint32_t nonce, uint8_t* tag, bool encrypt);
+
+    /// send() for CTR and CCM modes
+    bool sendCtr(const uint8_t* data, uint8_t len);
+
+    /// recv() for CTR and CCM modes
+    bool recvCtr(uint8_t* buf, uint8_t* len);
 };
 
 /// @example nrf24_encrypted_client.pde
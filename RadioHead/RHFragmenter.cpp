@@ -0,0 +1,260 @@
+// RHFragmenter.cpp
+//
+// Fragmentation and reassembly of messages larger than the radio can send,
+// over RHReliableDatagram or RHMesh
+//
+// Part of the Arduino RH library for operating with HopeRF RH compatible transceivers
+// (see http://www.hoperf.com)
+
+#include <RHFragmenter.h>
+
+////////////////////////////////////////////////////////////////////
+// Constructors
+RHFragmenter::RHFragmenter(RHReliableDatagram& manager)
+    : _manager(manager),
+      _mesh(NULL),
+      _lastMessageId(0),
+      _dropped(0)
+{
+    uint8_t i;
+    for (i = 0; i < RH_FRAGMENT_NUM_SOURCES; i++)
+	_buffers[i].inUse = false;
+}
+
+RHFragmenter::RHFragmenter(RHMesh& mesh)
+    : _manager(mesh),
+      _mesh(&mesh),
+      _lastMessageId(0),
+      _dropped(0)
+{
+    uint8_t i;
+    for (i = 0; i < RH_FRAGMENT_NUM_SOURCES; i++)
+	_buffers[i].inUse = false;
+}
+
+////////////////////////////////////////////////////////////////////
+// Public methods
+bool RHFragmenter::init()
+{
+    uint8_t i;
+    for (i = 0; i < RH_FRAGMENT_NUM_SOURCES; i++)
+	_buffers[i].inUse = false;
+    // RHRouter::init() is not virtual
+    if (_mesh)
+	return _mesh->init();
+    return _manager.init();
+}
+
+////////////////////////////////////////////////////////////////////
+uint16_t RHFragmenter::maxMessageLength()
+{
+    return RH_FRAGMENT_MAX_MESSAGE_LEN;
+}
+
+////////////////////////////////////////////////////////////////////
+uint8_t RHFragmenter::fragmentLength()
+{
+    uint16_t len = _manager.maxMessageLength();
+    if (_mesh)
+    {
+	// RHRouter and RHMesh headers go in the payload
+	uint16_t overhead = sizeof(RHRouter::RoutedMessageHeader) + sizeof(RHMesh::MeshMessageHeader);
+	len = (len > overhead) ? len - overhead : 0;
+	if (len > RH_MESH_MAX_MESSAGE_LEN)
+	    len = RH_MESH_MAX_MESSAGE_LEN;
+    }
+#if RH_RELIABLE_WINDOW_SIZE
+    else if (len > RH_RELIABLE_WINDOW_MAX_MESSAGE_LEN)
+	len = RH_RELIABLE_WINDOW_MAX_MESSAGE_LEN;
+#endif
+    return (len > RH_FRAGMENT_HEADER_LEN) ? len - RH_FRAGMENT_HEADER_LEN : 0;
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHFragmenter::sendtoWait(uint8_t* buf, uint16_t len, uint8_t address)
+{
+    uint8_t fraglen = fragmentLength();
+    if (len > RH_FRAGMENT_MAX_MESSAGE_LEN || fraglen == 0)
+	return false;
+    uint16_t count = len ? (len + fraglen - 1) / fraglen : 1;
+    if (count > 255)
+	return false;
+
+    uint8_t id = ++_lastMessageId;
+    uint16_t offset = 0;
+    uint8_t index;
+    for (index = 0; index < count; index++)
+    {
+	uint8_t thislen = (len - offset > fraglen) ? fraglen : len - offset;
+	_fragment[0] = id;
+	_fragment[1] = index;
+	_fragment[2] = count;
+	_fragment[3] = offset & 0xff;
+	_fragment[4] = offset >> 8;
+	memcpy(_fragment + RH_FRAGMENT_HEADER_LEN, buf + offset, thislen);
+	if (!sendFragment(_fragment, RH_FRAGMENT_HEADER_LEN + thislen, address))
+	    return false;
+	offset += thislen;
+    }
+    return waitSent();
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHFragmenter::recvfromAck(uint8_t* buf, uint16_t* len, uint8_t* from)
+{
+    expireBuffers();
+
+    uint8_t fraglen = sizeof(_fragment);
+    uint8_t _from;
+    bool got;
+    if (_mesh)
+	got = _mesh->recvfromAck(_fragment, &fraglen, &_from);
+    else
+	got = _manager.recvfromAck(_fragment, &fraglen, &_from);
+    if (!got || fraglen < RH_FRAGMENT_HEADER_LEN)
+	return false;
+
+    uint8_t id = _fragment[0];
+    uint8_t index = _fragment[1];
+    uint8_t count = _fragment[2];
+    uint16_t offset = _fragment[3] | (_fragment[4] << 8);
+    uint8_t datalen = fraglen - RH_FRAGMENT_HEADER_LEN;
+    if (   index >= count
+	|| (uint32_t)offset + datalen > RH_FRAGMENT_MAX_MESSAGE_LEN)
+	return false; // Bad header or too big for us
+
+    if (count == 1)
+    {
+	// Not fragmented, no need for a buffer
+	if (*len > datalen)
+	    *len = datalen;
+	memcpy(buf, _fragment + RH_FRAGMENT_HEADER_LEN, *len);
+	if (from) *from = _from;
+	return true;
+    }
+
+    ReassemblyBuffer* b = bufferFor(_from, id, count);
+    if (b->have[index >> 3] & (1 << (index & 7)))
+	return false; // Duplicate
+    b->have[index >> 3] |= (1 << (index & 7));
+    b->received++;
+    b->lastHeard = millis();
+    memcpy(b->data + offset, _fragment + RH_FRAGMENT_HEADER_LEN, datalen);
+    if (index == count - 1)
+	b->len = offset + datalen;
+    if (b->received < count)
+	return false;
+
+    // Complete
+    b->inUse = false;
+    if (*len > b->len)
+	*len = b->len;
+    memcpy(buf, b->data, *len);
+    if (from) *from = _from;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHFragmenter::recvfromAckTimeout(uint8_t* buf, uint16_t* len, uint16_t timeout, uint8_t* from)
+{
+    unsigned long starttime = millis();
+    int32_t timeLeft;
+    while ((timeLeft = timeout - (millis() - starttime)) > 0)
+    {
+	if (_manager.waitAvailableTimeout(timeLeft))
+	{
+	    if (recvfromAck(buf, len, from))
+		return true;
+	}
+	YIELD;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////
+uint16_t RHFragmenter::droppedMessages()
+{
+    return _dropped;
+}
+
+////////////////////////////////////////////////////////////////////
+// Protected methods
+bool RHFragmenter::sendFragment(uint8_t* buf, uint8_t len, uint8_t address)
+{
+    if (_mesh)
+	return _mesh->sendtoWait(buf, len, address) == RH_ROUTER_ERROR_NONE;
+#if RH_RELIABLE_WINDOW_SIZE
+    return _manager.sendtoWindow(buf, len, address);
+#else
+    return _manager.sendtoWait(buf, len, address);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHFragmenter::waitSent()
+{
+#if RH_RELIABLE_WINDOW_SIZE
+    if (!_mesh)
+	return _manager.waitWindowSent();
+#endif
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////
+RHFragmenter::ReassemblyBuffer* RHFragmenter::bufferFor(uint8_t from, uint8_t id, uint8_t count)
+{
+    ReassemblyBuffer* b = NULL;
+    unsigned long now = millis();
+    uint8_t i;
+    for (i = 0; i < RH_FRAGMENT_NUM_SOURCES; i++)
+    {
+	if (_buffers[i].inUse && _buffers[i].from == from)
+	{
+	    if (_buffers[i].id == id && _buffers[i].count == count)
+		return &_buffers[i];
+	    // A new message from the same source: the old one will never be completed
+	    b = &_buffers[i];
+	    break;
+	}
+    }
+    if (!b)
+    {
+	for (i = 0; i < RH_FRAGMENT_NUM_SOURCES; i++)
+	{
+	    if (!_buffers[i].inUse)
+	    {
+		b = &_buffers[i];
+		break;
+	    }
+	    if (!b || (now - _buffers[i].lastHeard) > (now - b->lastHeard))
+		b = &_buffers[i];
+	}
+    }
+    if (b->inUse)
+	_dropped++;
+
+    b->inUse = true;
+    b->from = from;
+    b->id = id;
+    b->count = count;
+    b->received = 0;
+    b->len = 0;
+    b->lastHeard = now;
+    memset(b->have, 0, sizeof(b->have));
+    return b;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHFragmenter::expireBuffers()
+{
+    unsigned long now = millis();
+    uint8_t i;
+    for (i = 0; i < RH_FRAGMENT_NUM_SOURCES; i++)
+    {
+	if (_buffers[i].inUse && (now - _buffers[i].lastHeard) > RH_FRAGMENT_TIMEOUT)
+	{
+	    _buffers[i].inUse = false;
+	    _dropped++;
+	}
+    }
+}
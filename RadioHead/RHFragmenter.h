@@ -0,0 +1,169 @@
+// RHFragmenter.h
+//
+// Fragmentation and reassembly of messages larger than the radio can send,
+// over RHReliableDatagram or RHMesh
+//
+// Part of the Arduino RH library for operating with HopeRF RH compatible transceivers
+// (see http://www.hoperf.com)
+
+#ifndef RHFragmenter_h
+#define RHFragmenter_h
+
+#include <RHReliableDatagram.h>
+#include <RHMesh.h>
+
+// The largest message that can be sent or received, in octets.
+// RAM for RH_FRAGMENT_NUM_SOURCES buffers of this size is reserved in each RHFragmenter
+#ifndef RH_FRAGMENT_MAX_MESSAGE_LEN
+#define RH_FRAGMENT_MAX_MESSAGE_LEN 512
+#endif
+
+// The number of messages that can be reassembled at the same time, ie from different sources
+#ifndef RH_FRAGMENT_NUM_SOURCES
+#define RH_FRAGMENT_NUM_SOURCES 2
+#endif
+
+// A partly received message is discarded if no fragment of it has been received for this long (ms)
+#ifndef RH_FRAGMENT_TIMEOUT
+#define RH_FRAGMENT_TIMEOUT 5000
+#endif
+
+// Octets of fragment header at the start of each message sent by the manager
+#define RH_FRAGMENT_HEADER_LEN 5
+
+/////////////////////////////////////////////////////////////////////
+/// \class RHFragmenter RHFragmenter.h <RHFragmenter.h>
+/// \brief Sends and receives messages larger than the radio maximum message length,
+/// by fragmenting them over RHReliableDatagram or RHMesh
+///
+/// RHFragmenter is used on top of an RHReliableDatagram or RHMesh manager. sendtoWait() splits a message of up
+/// to RH_FRAGMENT_MAX_MESSAGE_LEN octets into fragments that fit in the radio's maximum message length, and sends
+/// them reliably with the manager. recvfromAck() collects the fragments and returns the message when
+/// all of them have arrived. Fragments may arrive in any order. Up to RH_FRAGMENT_NUM_SOURCES messages from
+/// different sources can be reassembled at once. A partly received message is discarded after RH_FRAGMENT_TIMEOUT
+/// milliseconds without a new fragment, or when its buffer is needed for a message from another source.
+///
+/// If RH_RELIABLE_WINDOW_SIZE is enabled, the fragments are sent with RHReliableDatagram::sendtoWindow(), so a
+/// long message needs only a few ACKs instead of one per fragment. Over RHMesh, each fragment is routed
+/// with RHMesh::sendtoWait().
+///
+/// All nodes that exchange messages through an RHFragmenter must use RHFragmenter, since each fragment
+/// starts with a header:
+/// - 1 octet ID, incremented for each message sent by this node
+/// - 1 octet INDEX, the number of this fragment, starting at 0
+/// - 1 octet COUNT, the number of fragments in the message
+/// - 2 octets OFFSET, the position of this fragment in the message, least significant octet first
+///
+/// Call the manager's init() (or RHFragmenter::init()) before use, and do not call the manager's own
+/// receive functions while using RHFragmenter, since they would take fragments away from it.
+class RHFragmenter
+{
+public:
+    /// Constructor.
+    /// \param[in] manager The RHReliableDatagram to send and receive fragments with
+    RHFragmenter(RHReliableDatagram& manager);
+
+    /// Constructor.
+    /// \param[in] mesh The RHMesh to send and receive fragments with
+    RHFragmenter(RHMesh& mesh);
+
+    /// Initialises the manager and discards any partly received messages.
+    /// \return true if the manager was initialised
+    bool init();
+
+    /// Returns the maximum message length that can be sent with sendtoWait()
+    /// \return RH_FRAGMENT_MAX_MESSAGE_LEN
+    uint16_t maxMessageLength();
+
+    /// Returns the number of message octets carried in each fragment, which depends on the driver
+    /// \return The fragment payload length
+    uint8_t fragmentLength();
+
+    /// Sends a message in as many fragments as needed, and waits until all of them have been acknowledged
+    /// (over RHMesh: by the next hop).
+    /// \param[in] buf Pointer to the message to send
+    /// \param[in] len Number of octets to send, at most RH_FRAGMENT_MAX_MESSAGE_LEN
+    /// \param[in] address The address to send the message to. RH_BROADCAST_ADDRESS is permitted, but
+    /// broadcast fragments are not acknowledged
+    /// \return true if all fragments were delivered
+    bool sendtoWait(uint8_t* buf, uint16_t len, uint8_t address);
+
+    /// Receives and acknowledges any available fragment. If it completes a message, copies the message
+    /// to buf and returns true.
+    /// \param[in] buf Location to copy the received message
+    /// \param[in,out] len Pointer to the number of octets available in buf. Set to the actual number of octets copied.
+    /// \param[in] from If present and not NULL, the referenced uint8_t will be set to the address of the sender
+    /// (the SOURCE address over RHMesh)
+    /// \return true if a complete message was copied to buf
+    bool recvfromAck(uint8_t* buf, uint16_t* len, uint8_t* from = NULL);
+
+    /// Similar to recvfromAck(), but blocks until a complete message has been received or the timeout expires.
+    /// \param[in] buf Location to copy the received message
+    /// \param[in,out] len Pointer to the number of octets available in buf. Set to the actual number of octets copied.
+    /// \param[in] timeout Maximum time to wait in milliseconds
+    /// \param[in] from If present and not NULL, the referenced uint8_t will be set to the address of the sender
+    /// \return true if a complete message was copied to buf
+    bool recvfromAckTimeout(uint8_t* buf, uint16_t* len, uint16_t timeout, uint8_t* from = NULL);
+
+    /// Returns the number of partly received messages that have been discarded,
+    /// because they timed out or their buffer was needed for another message
+    /// \return The number of discarded messages
+    uint16_t droppedMessages();
+
+protected:
+    /// Reassembly state for a message from one source
+    typedef struct
+    {
+	bool          inUse;      ///< true if a message is being reassembled in this buffer
+	uint8_t       from;       ///< Sender of the message
+	uint8_t       id;         ///< ID of the message
+	uint8_t       count;      ///< Number of fragments in the message
+	uint8_t       received;   ///< Number of different fragments received so far
+	uint16_t      len;        ///< Length of the message, known when the last fragment arrives
+	unsigned long lastHeard;  ///< millis() when the last fragment arrived
+	uint8_t       have[32];   ///< Bitmap of the fragments received so far
+	uint8_t       data[RH_FRAGMENT_MAX_MESSAGE_LEN]; ///< The message being reassembled
+    } ReassemblyBuffer;
+
+    /// Sends one fragment with the manager
+    /// \param[in] buf The fragment, including its header
+    /// \param[in] len Length of the fragment
+    /// \param[in] address The address to send the fragment to
+    /// \return true if the fragment was delivered or queued
+    bool sendFragment(uint8_t* buf, uint8_t len, uint8_t address);
+
+    /// Waits until queued fragments have been delivered
+    /// \return true if they were all delivered
+    bool waitSent();
+
+    /// Finds the buffer for a message, or starts one, discarding the least recently heard message if need be
+    /// \param[in] from Sender of the message
+    /// \param[in] id ID of the message
+    /// \param[in] count Number of fragments in the message
+    /// \return The buffer to use
+    ReassemblyBuffer* bufferFor(uint8_t from, uint8_t id, uint8_t count);
+
+    /// Discards partly received messages that have timed out
+    void expireBuffers();
+
+private:
+    /// The manager used to send and receive fragments
+    RHReliableDatagram&  _manager;
+
+    /// The same manager if it is an RHMesh, else NULL
+    RHMesh*              _mesh;
+
+    /// ID of the last message sent
+    uint8_t              _lastMessageId;
+
+    /// Number of discarded partly received messages
+    uint16_t             _dropped;
+
+    /// Fragment being sent or received
+    uint8_t              _fragment[RH_MAX_MESSAGE_LEN];
+
+    /// Messages being reassembled
+    ReassemblyBuffer     _buffers[RH_FRAGMENT_NUM_SOURCES];
+};
+
+#endif
@@ -17,6 +17,12 @@ RHGenericDriver::RHGenericDriver()
     _rxGood(0),
     _txGood(0),
     _cad_timeout(0)
+#if RH_RX_QUEUE_LEN
+    ,
+    _rxQueueHead(0),
+    _rxQueueCount(0),
+    _rxQueueOverflows(0)
+#endif
 {
 }
 
@@ -212,6 +218,75 @@ uint16_t RHGenericDriver::txGood()
     return _txGood;
 }
 
+uint8_t RHGenericDriver::rxQueued()
+{
+#if RH_RX_QUEUE_LEN
+    return _rxQueueCount;
+#else
+    return 0;
+#endif
+}
+
+uint16_t RHGenericDriver::rxQueueOverflows()
+{
+#if RH_RX_QUEUE_LEN
+    return _rxQueueOverflows;
+#else
+    return 0;
+#endif
+}
+
+#if RH_RX_QUEUE_LEN
+// Called by the driver, usually from its interrupt handler
+bool RHGenericDriver::rxQueuePut(const uint8_t* payload, uint8_t len, int8_t snr)
+{
+    if (_rxQueueCount >= RH_RX_QUEUE_LEN || len > RH_RX_QUEUE_MAX_MESSAGE_LEN)
+    {
+	_rxQueueOverflows++;
+	return false;
+    }
+    // The reader only touches the slot at _rxQueueHead, so this one can be filled
+    // without blocking interrupts
+    RxQueueEntry* entry = &_rxQueue[(_rxQueueHead + _rxQueueCount) % RH_RX_QUEUE_LEN];
+    entry->headerTo    = _rxHeaderTo;
+    entry->headerFrom  = _rxHeaderFrom;
+    entry->headerId    = _rxHeaderId;
+    entry->headerFlags = _rxHeaderFlags;
+    entry->rssi        = _lastRssi;
+    entry->snr         = snr;
+    entry->len         = len;
+    memcpy(entry->payload, payload, len);
+    _rxQueueCount++;
+    return true;
+}
+
+bool RHGenericDriver::rxQueueGet(uint8_t* buf, uint8_t* len, int8_t* snr)
+{
+    if (!_rxQueueCount)
+	return false;
+    RxQueueEntry* entry = &_rxQueue[_rxQueueHead];
+    if (buf && len)
+    {
+	if (*len > entry->len)
+	    *len = entry->len;
+	memcpy(buf, entry->payload, *len);
+    }
+    if (snr)
+	*snr = entry->snr;
+    ATOMIC_BLOCK_START;
+    // Headers and RSSI now describe the message being returned
+    _rxHeaderTo    = entry->headerTo;
+    _rxHeaderFrom  = entry->headerFrom;
+    _rxHeaderId    = entry->headerId;
+    _rxHeaderFlags = entry->headerFlags;
+    _lastRssi      = entry->rssi;
+    _rxQueueHead = (_rxQueueHead + 1) % RH_RX_QUEUE_LEN;
+    _rxQueueCount--;
+    ATOMIC_BLOCK_END;
+    return true;
+}
+#endif
+
 void RHGenericDriver::setCADTimeout(unsigned long cad_timeout)
 {
     _cad_timeout = cad_timeout;
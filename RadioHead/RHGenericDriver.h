@@ -17,6 +17,19 @@
 // Default timeout for waitCAD() in ms
 #define RH_CAD_DEFAULT_TIMEOUT            10000
 
+// Number of received messages that drivers supporting it (RH_RF95, RH_RF69, RH_RF22, RH_NRF24)
+// can hold before they are collected by recv(). 0 keeps the single receive buffer.
+// Can be set in RadioHead.h
+#ifndef RH_RX_QUEUE_LEN
+#define RH_RX_QUEUE_LEN                   0
+#endif
+
+// Largest message (not counting the 4 headers) that can be held in the receive queue.
+// Longer messages are dropped. Reduce this to save memory with small packet radios.
+#ifndef RH_RX_QUEUE_MAX_MESSAGE_LEN
+#define RH_RX_QUEUE_MAX_MESSAGE_LEN       255
+#endif
+
 /////////////////////////////////////////////////////////////////////
 /// \class RHGenericDriver RHGenericDriver.h <RHGenericDriver.h>
 /// \brief Abstract base class for a RadioHead driver.
@@ -38,6 +51,16 @@
 /// -ID A message ID, distinct (over short time scales) for each message sent by a particilar node
 /// -FLAGS A bitmask of flags. The most significant 4 bits are reserved for use by RadioHead. The least
 /// significant 4 bits are reserved for applications.
+///
+/// \par Receive queue
+///
+/// Normally a driver holds only one received message, and the receiver is turned off until it is 
+/// collected with recv(), so messages that arrive in a burst are lost. If RH_RX_QUEUE_LEN is
+/// defined to be greater than 0 (see RadioHead.h), drivers that support it (RH_RF95, RH_RF69, RH_RF22, RH_NRF24)
+/// instead queue up to RH_RX_QUEUE_LEN good messages, together with their headers and RSSI, and keep
+/// the receiver on. recv() returns the oldest queued message, and headerFrom(), lastRssi() etc 
+/// then refer to that message. Messages received while the queue is full are counted by rxQueueOverflows().
+/// Each queued message takes RH_RX_QUEUE_MAX_MESSAGE_LEN + 8 octets of RAM.
 class RHGenericDriver
 {
 public:
@@ -258,6 +281,16 @@ public:
     /// \return The number of packets successfully transmitted
     virtual uint16_t       txGood();
 
+    /// Returns the number of received messages waiting to be collected by recv()
+    /// when the receive queue is enabled with RH_RX_QUEUE_LEN.
+    /// \return The number of queued messages, always 0 if the queue is not enabled
+    uint8_t                rxQueued();
+
+    /// Returns the count of the number of good received messages that were dropped 
+    /// because the receive queue was full (or the message was longer than RH_RX_QUEUE_MAX_MESSAGE_LEN)
+    /// \return The number of dropped messages, always 0 if the queue is not enabled
+    uint16_t               rxQueueOverflows();
+
 protected:
 
     /// The current transport operating mode
@@ -311,6 +344,46 @@ protected:
     /// Channel activity timeout in ms
     unsigned int        _cad_timeout;
 
+#if RH_RX_QUEUE_LEN
+    /// Adds a good received message to the receive queue. Called by drivers, usually from the
+    /// interrupt handler. The headers are taken from _rxHeaderTo etc and the RSSI from _lastRssi.
+    /// \param[in] payload The message, not including the headers
+    /// \param[in] len Length of the message
+    /// \param[in] snr Signal to noise ratio of the message, if the driver has one
+    /// \return true if the message was queued, false if it was dropped
+    bool                rxQueuePut(const uint8_t* payload, uint8_t len, int8_t snr = 0);
+
+    /// Takes the oldest message from the receive queue, and sets _rxHeaderTo etc and _lastRssi
+    /// from that message.
+    /// \param[in] buf Location to copy the message, may be NULL
+    /// \param[in,out] len Pointer to available space in buf. Set to the actual number of octets copied.
+    /// \param[out] snr If not NULL, set to the signal to noise ratio of the message
+    /// \return true if a message was taken
+    bool                rxQueueGet(uint8_t* buf, uint8_t* len, int8_t* snr = NULL);
+
+    /// A message in the receive queue
+    typedef struct
+    {
+	uint8_t         headerTo;
+	uint8_t         headerFrom;
+	uint8_t         headerId;
+	uint8_t         headerFlags;
+	int16_t         rssi;
+	int8_t          snr;
+	uint8_t         len;
+	uint8_t         payload[RH_RX_QUEUE_MAX_MESSAGE_LEN];
+    } RxQueueEntry;
+
+    /// The receive queue
+    RxQueueEntry        _rxQueue[RH_RX_QUEUE_LEN];
+    /// Index of the oldest message in _rxQueue
+    volatile uint8_t    _rxQueueHead;
+    /// Number of messages in _rxQueue
+    volatile uint8_t    _rxQueueCount;
+    /// Count of the number of messages dropped because the queue was full
+    volatile uint16_t   _rxQueueOverflows;
+#endif
+
 private:
 
 };
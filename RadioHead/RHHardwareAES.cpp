@@ -0,0 +1,112 @@
+// RHHardwareAES.cpp
+//
+// AES128 BlockCipher using the AES hardware of the processor, for RHEncryptedDriver
+//
+// Part of the Arduino RH library for operating with HopeRF RH compatible transceivers
+// (see http://www.hoperf.com)
+
+#include <RadioHead.h>
+#ifdef RH_ENABLE_ENCRYPTION_MODULE
+#include <RHHardwareAES.h>
+#ifdef RH_HAVE_HARDWARE_AES
+
+#if defined(NRF52) && defined(SOFTDEVICE_PRESENT)
+ #include <nrf_soc.h>
+ #include <nrf_sdm.h>
+#endif
+
+RHHardwareAES::RHHardwareAES()
+{
+#if (RH_PLATFORM == RH_PLATFORM_ESP32)
+    mbedtls_aes_init(&_enc);
+    mbedtls_aes_init(&_dec);
+#else
+    memset(_ecb, 0, sizeof(_ecb));
+#endif
+}
+
+RHHardwareAES::~RHHardwareAES()
+{
+    clear();
+#if (RH_PLATFORM == RH_PLATFORM_ESP32)
+    mbedtls_aes_free(&_enc);
+    mbedtls_aes_free(&_dec);
+#endif
+}
+
+size_t RHHardwareAES::blockSize() const
+{
+    return 16;
+}
+
+size_t RHHardwareAES::keySize() const
+{
+    return 16;
+}
+
+bool RHHardwareAES::setKey(const uint8_t *key, size_t len)
+{
+    if (len != 16)
+	return false;
+#if (RH_PLATFORM == RH_PLATFORM_ESP32)
+    return    mbedtls_aes_setkey_enc(&_enc, key, 128) == 0
+	   && mbedtls_aes_setkey_dec(&_dec, key, 128) == 0;
+#else
+    memcpy(_ecb, key, 16);
+    return true;
+#endif
+}
+
+void RHHardwareAES::encryptBlock(uint8_t *output, const uint8_t *input)
+{
+#if (RH_PLATFORM == RH_PLATFORM_ESP32)
+    mbedtls_aes_crypt_ecb(&_enc, MBEDTLS_AES_ENCRYPT, input, output);
+#else
+    memcpy(&_ecb[16], input, 16);
+ #ifdef SOFTDEVICE_PRESENT
+    // The SoftDevice owns the ECB peripheral while it is enabled
+    uint8_t sd_enabled = 0;
+    sd_softdevice_is_enabled(&sd_enabled);
+    if (sd_enabled)
+    {
+	sd_ecb_block_encrypt((nrf_ecb_hal_data_t*)_ecb);
+	memcpy(output, &_ecb[32], 16);
+	return;
+    }
+ #endif
+    NRF_ECB->ECBDATAPTR = (uint32_t)_ecb;
+    NRF_ECB->EVENTS_ENDECB = 0;
+    NRF_ECB->EVENTS_ERRORECB = 0;
+    NRF_ECB->TASKS_STARTECB = 1;
+    while (!NRF_ECB->EVENTS_ENDECB && !NRF_ECB->EVENTS_ERRORECB)
+	;
+    NRF_ECB->EVENTS_ENDECB = 0;
+    memcpy(output, &_ecb[32], 16);
+#endif
+}
+
+void RHHardwareAES::decryptBlock(uint8_t *output, const uint8_t *input)
+{
+#if (RH_PLATFORM == RH_PLATFORM_ESP32)
+    mbedtls_aes_crypt_ecb(&_dec, MBEDTLS_AES_DECRYPT, input, output);
+#else
+    // The ECB peripheral can't decrypt
+    (void)input;
+    memset(output, 0, 16);
+#endif
+}
+
+void RHHardwareAES::clear()
+{
+#if (RH_PLATFORM == RH_PLATFORM_ESP32)
+    mbedtls_aes_free(&_enc);
+    mbedtls_aes_free(&_dec);
+    mbedtls_aes_init(&_enc);
+    mbedtls_aes_init(&_dec);
+#else
+    memset(_ecb, 0, sizeof(_ecb));
+#endif
+}
+
+#endif // RH_HAVE_HARDWARE_AES
+#endif // RH_ENABLE_ENCRYPTION_MODULE
@@ -0,0 +1,92 @@
+// RHHardwareAES.h
+//
+// AES128 BlockCipher using the AES hardware of the processor, for RHEncryptedDriver
+//
+// Part of the Arduino RH library for operating with HopeRF RH compatible transceivers
+// (see http://www.hoperf.com)
+
+#ifndef RHHardwareAES_h
+#define RHHardwareAES_h
+
+#include <RadioHead.h>
+#if defined(RH_ENABLE_ENCRYPTION_MODULE) || defined(DOXYGEN)
+#include <BlockCipher.h>
+
+#if (RH_PLATFORM == RH_PLATFORM_ESP32)
+ #include "mbedtls/aes.h"
+ #define RH_HAVE_HARDWARE_AES
+#elif defined(NRF52)
+ #define RH_HAVE_HARDWARE_AES
+#endif
+
+#if defined(RH_HAVE_HARDWARE_AES) || defined(DOXYGEN)
+
+/////////////////////////////////////////////////////////////////////
+/// \class RHHardwareAES RHHardwareAES.h <RHHardwareAES.h>
+/// \brief AES128 BlockCipher that uses the AES hardware of ESP32 and nRF52 processors.
+///
+/// This is a drop-in replacement for the AES128 class of arduinolibs, for use with RHEncryptedDriver.
+/// It encrypts a block in a few microseconds, instead of the tens to hundreds of microseconds of AES in
+/// software.
+///
+/// - On ESP32 it uses the mbedtls AES functions of the ESP32 core, which use the AES accelerator.
+/// - On nRF52 it uses the ECB peripheral (through the SoftDevice if one is present). The ECB peripheral
+///   can only encrypt, so decryptBlock() is not supported: use RHEncryptedDriver in ModeCTR or ModeCCM,
+///   which only encrypt.
+///
+/// Other processors (including STM32, whose AES hardware varies from part to part and is not
+/// exposed by the Arduino cores) should use AES128 from arduinolibs.
+class RHHardwareAES : public BlockCipher
+{
+public:
+    /// Constructor
+    RHHardwareAES();
+
+    /// Destructor. Clears the key
+    virtual ~RHHardwareAES();
+
+    /// \return 16, the AES block size
+    size_t blockSize() const;
+
+    /// \return 16, the AES128 key size
+    size_t keySize() const;
+
+    /// Sets the key
+    /// \param[in] key The 16 octet key
+    /// \param[in] len Length of the key, must be 16
+    /// \return true if the key was set
+    bool setKey(const uint8_t *key, size_t len);
+
+    /// Encrypts a block with the hardware
+    /// \param[out] output 16 octets of ciphertext. May be the same as input
+    /// \param[in] input 16 octets of plaintext
+    void encryptBlock(uint8_t *output, const uint8_t *input);
+
+    /// Decrypts a block with the hardware. Not supported on nRF52, where output is zeroed
+    /// \param[out] output 16 octets of plaintext. May be the same as input
+    /// \param[in] input 16 octets of ciphertext
+    void decryptBlock(uint8_t *output, const uint8_t *input);
+
+    /// Clears the key
+    void clear();
+
+private:
+#if (RH_PLATFORM == RH_PLATFORM_ESP32)
+    /// Context for encryption
+    mbedtls_aes_context _enc;
+
+    /// Context for decryption
+    mbedtls_aes_context _dec;
+#else
+    /// ECB peripheral data: key, cleartext, ciphertext
+    uint8_t             _ecb[48];
+#endif
+};
+
+#endif // RH_HAVE_HARDWARE_AES
+
+#else // RH_ENABLE_ENCRYPTION_MODULE
+#error "You have included RHHardwareAES.h, but not enabled RH_ENABLE_ENCRYPTION_MODULE in RadioHead.h"
+#endif
+
+#endif
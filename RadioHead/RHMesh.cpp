@@ -63,7 +63,6 @@ bool RHMesh::doArp(uint8_t address)
     // Wait for a reply, which will be unicast back to us
     // It will contain the complete route to the destination
     uint8_t messageLen = sizeof(_tmpMessage);
-    // FIXME: timeout should be configurable
     unsigned long starttime = millis();
     int32_t timeLeft;
     while ((timeLeft = RH_MESH_ARP_TIMEOUT - (millis() - starttime)) > 0)
@@ -77,7 +76,8 @@ bool RHMesh::doArp(uint8_t address)
 		{
 		    // Got a reply, now add the next hop to the dest to the routing table
 		    // The first hop taken is the first octet
-		    addRouteTo(address, headerFrom());
+		    uint8_t numRoutes = messageLen - sizeof(MeshMessageHeader) - 2;
+		    addRouteTo(address, headerFrom(), Valid, numRoutes + 1, _driver.lastRssi());
 		    return true;
 		}
 	    }
@@ -99,16 +99,18 @@ void RHMesh::peekAtMessage(RoutedMessage* message, uint8_t messageLen)
 	// being routed back to the originator here. Want to scrape some routing data out of the response
 	// We can find the routes to all the nodes between here and the responding node
 	MeshRouteDiscoveryMessage* d = (MeshRouteDiscoveryMessage*)message->data;
-	addRouteTo(d->dest, headerFrom());
 	uint8_t numRoutes = messageLen - sizeof(RoutedMessageHeader) - sizeof(MeshMessageHeader) - 2;
+	int16_t rssi = _driver.lastRssi();
 	uint8_t i;
 	// Find us in the list of nodes that were traversed to get to the responding node
+	// If we are not in it, we are the originator
 	for (i = 0; i < numRoutes; i++)
 	    if (d->route[i] == _thisAddress)
 		break;
-	i++;
-	while (i < numRoutes)
-	    addRouteTo(d->route[i++], headerFrom());
+	uint8_t first = (i < numRoutes) ? i + 1 : 0;
+	addRouteTo(d->dest, headerFrom(), Valid, numRoutes - first + 1, rssi);
+	for (i = first; i < numRoutes; i++)
+	    addRouteTo(d->route[i], headerFrom(), Valid, i - first + 1, rssi);
     }
     else if (   messageLen > 1 
 	     && m->msgType == RH_MESH_MESSAGE_TYPE_ROUTE_FAILURE)
@@ -136,7 +138,7 @@ uint8_t RHMesh::route(RoutedMessage* message, uint8_t messageLen)
 	    p->header.msgType = RH_MESH_MESSAGE_TYPE_ROUTE_FAILURE;
 	    p->dest = message->header.dest; // Who you were trying to deliver to
 	    // Make sure there is a route back towards whoever sent the original message
-	    addRouteTo(message->header.source, from);
+	    addRouteTo(message->header.source, from, Valid, message->header.hops);
 	    ret = RHRouter::sendtoWait((uint8_t*)p, sizeof(RHMesh::MeshMessageHeader) + 1, message->header.source);
 	}
     }
@@ -200,14 +202,17 @@ bool RHMesh::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* source, uint8_t* d
 		    return false; // Already been through us. Discard
 	    
 	        
-            addRouteTo(_source, headerFrom()); // The originator needs to be added regardless of node type
+	    // Copies of the request arrive by several paths, so keep the best route back rather than the latest
+	    int16_t rssi = _driver.lastRssi();
+            if (!learnRouteTo(_source, headerFrom(), numRoutes + 1, rssi) && !getRouteTo(_source))
+		addRouteTo(_source, headerFrom(), Valid, numRoutes + 1, rssi); // The originator needs to be added regardless of node type
 
 	    // Hasnt been past us yet, record routes back to the earlier nodes
             // No need to waste memory if we are not participating in routing
             if (_isa_router)
             {
 	        for (i = 0; i < numRoutes; i++)
-		    addRouteTo(d->route[i], headerFrom());
+		    learnRouteTo(d->route[i], headerFrom(), numRoutes - i, rssi);
             }
 
 	    if (isPhysicalAddress(&d->dest, d->destlen))
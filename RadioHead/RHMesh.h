@@ -16,7 +16,9 @@
 #define RH_MESH_MESSAGE_TYPE_ROUTE_FAILURE                  3
 
 // Timeout for address resolution in milliecs
+#ifndef RH_MESH_ARP_TIMEOUT
 #define RH_MESH_ARP_TIMEOUT 4000
+#endif
 
 /////////////////////////////////////////////////////////////////////
 /// \class RHMesh RHMesh.h <RHMesh.h>
@@ -65,6 +67,12 @@
 /// RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_RESPONSE together ensure the original requester and all 
 /// the intermediate nodes know how to route to the source and destination nodes and every node along the path.
 ///
+/// Routes are also learned from ordinary traffic (see Learned Routes in RHRouter), and routes deduced from 
+/// a request only replace an existing route if they have fewer hops, so the shortest 
+/// copy of a request wins. In a busy network most nodes already know a route to the nodes they talk to 
+/// and need no Route Discovery. For large networks, define RH_ROUTING_TABLE_SIZE big enough 
+/// to hold a route to every node.
+///
 /// Note that there is a race condition here that can effect routing on multipath routes. For example, 
 /// if the route to the destination can traverse several paths, last reply from the destination 
 /// will be the one used.
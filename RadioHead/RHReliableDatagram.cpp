@@ -23,6 +23,15 @@ RHReliableDatagram::RHReliableDatagram(RHGenericDriver& driver, uint8_t thisAddr
     _timeout = RH_DEFAULT_TIMEOUT;
     _retries = RH_DEFAULT_RETRIES;
     memset(_seenIds, 0, sizeof(_seenIds));
+#if RH_RELIABLE_WINDOW_SIZE
+    memset(_seenBits, 0, sizeof(_seenBits));
+    _windowCount = 0;
+    _windowAddress = RH_BROADCAST_ADDRESS;
+    _windowMisses = 0;
+    _srtt = 0;
+    _rttvar = 0;
+    _rto = _timeout;
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -30,6 +39,10 @@ RHReliableDatagram::RHReliableDatagram(RHGenericDriver& driver, uint8_t thisAddr
 void RHReliableDatagram::setTimeout(uint16_t timeout)
 {
     _timeout = timeout;
+#if RH_RELIABLE_WINDOW_SIZE
+    if (!_srtt)
+	_rto = timeout; // Until a round trip time has been measured
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -105,8 +118,13 @@ bool RHReliableDatagram::sendtoWait(uint8_t* buf, uint8_t len, uint8_t address)
 			// Its the ACK we are waiting for
 			return true;
 		    }
+#if RH_RELIABLE_WINDOW_SIZE
+		    else if (   !(flags & (RH_FLAGS_ACK | RH_FLAGS_DEFER_ACK))
+				&& !isNewId(from, id, false))
+#else
 		    else if (   !(flags & RH_FLAGS_ACK)
 				&& (id == _seenIds[from]))
+#endif
 		    {
 			// This is a request we have already received. ACK it again
 			acknowledge(id, from);
@@ -137,8 +155,15 @@ bool RHReliableDatagram::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* from,
 	// Never ACK an ACK
 	if (!(_flags & RH_FLAGS_ACK))
 	{
+#if RH_RELIABLE_WINDOW_SIZE
+	    // Remember it before the ACK, which reports the IDs we have seen
+	    bool isNew = isNewId(_from, _id, true);
+	    // Its a normal message not an ACK. In a burst only the last message is ACKed
+	    if (_to ==_thisAddress && !(_flags & RH_FLAGS_DEFER_ACK))
+#else
 	    // Its a normal message not an ACK
 	    if (_to ==_thisAddress)
+#endif
 	    {
 		// In some networks with mixed processor speeds, may need to delay
 		// the ack with a define in say platformio.ini:
@@ -160,6 +185,16 @@ bool RHReliableDatagram::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* from,
             // shuts down between transmissions. Devices that do this will report the
             // the same ID each time since their internal sequence number will reset
             // to zero each time the device starts up.
+#if RH_RELIABLE_WINDOW_SIZE
+	    if ((RH_ENABLE_EXPLICIT_RETRY_DEDUP && !(_flags & RH_FLAGS_RETRY)) || isNew)
+	    {
+		if (from)  *from =  _from;
+		if (to)    *to =    _to;
+		if (id)    *id =    _id;
+		if (flags) *flags = _flags;
+		return true;
+	    }
+#else
 	    if ((RH_ENABLE_EXPLICIT_RETRY_DEDUP && !(_flags & RH_FLAGS_RETRY)) || _id != _seenIds[_from])
 	    {
 		if (from)  *from =  _from;
@@ -169,6 +204,7 @@ bool RHReliableDatagram::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* from,
 		_seenIds[_from] = _id;
 		return true;
 	    }
+#endif
 	    // Else just re-ack it and wait for a new one
 	}
     }
@@ -211,8 +247,256 @@ void RHReliableDatagram::acknowledge(uint8_t id, uint8_t from)
     // a 0 length message again, until its reset, which makes everything hang :-(
     // So we send an ACK of 1 octet
     // REVISIT: should we send the RSSI for the information of the sender?
+#if RH_RELIABLE_WINDOW_SIZE
+    // Also report the newest ID seen from the sender and which of the 8 before it were seen,
+    // so a sender in windowed mode knows which messages of a burst were lost. Older versions ignore these
+    uint8_t ack[3] = { '!', _seenIds[from], _seenBits[from] };
+    sendto(ack, sizeof(ack), from); 
+#else
     uint8_t ack = '!';
     sendto(&ack, sizeof(ack), from); 
+#endif
     waitPacketSent();
 }
 
+#if RH_RELIABLE_WINDOW_SIZE
+////////////////////////////////////////////////////////////////////
+// Windowed mode
+bool RHReliableDatagram::sendtoWindow(uint8_t* buf, uint8_t len, uint8_t address)
+{
+    if (len > RH_RELIABLE_WINDOW_MAX_MESSAGE_LEN)
+	return false;
+    // Broadcasts are never ACKed
+    if (address == RH_BROADCAST_ADDRESS)
+	return sendtoWait(buf, len, address);
+    // The window only holds messages for one address
+    if (_windowCount && address != _windowAddress && !waitWindowSent())
+	return false;
+    // Make room. The IDs in the window must also stay within the 8 that an ACK can report
+    while (   _windowCount >= RH_RELIABLE_WINDOW_SIZE
+	   || (_windowCount && (uint8_t)(_lastSequenceNumber + 1 - _window[0].id) > 8))
+    {
+	if (!sendWindowBurst())
+	    return false;
+    }
+
+    WindowSlot* slot = &_window[_windowCount++];
+    slot->id = ++_lastSequenceNumber;
+    slot->len = len;
+    slot->tries = 0;
+    slot->lost = 0;
+    slot->acked = false;
+    memcpy(slot->buf, buf, len);
+    _windowAddress = address;
+    return true;
+}
+
+bool RHReliableDatagram::waitWindowSent()
+{
+    while (_windowCount)
+    {
+	if (!sendWindowBurst())
+	    return false;
+    }
+    return true;
+}
+
+uint8_t RHReliableDatagram::windowQueued()
+{
+    return _windowCount;
+}
+
+uint16_t RHReliableDatagram::roundTripTime()
+{
+    return _srtt;
+}
+
+bool RHReliableDatagram::sendWindowBurst()
+{
+    uint8_t i;
+    // A burst that gets no ACK at all may only have lost the ACK, so messages are only 
+    // counted as lost when an ACK shows they were not received
+    bool failed = (_windowMisses > _retries);
+    for (i = 0; i < _windowCount; i++)
+	failed |= (_window[i].lost > _retries);
+    if (failed)
+    {
+	// Retries exhausted
+	_windowCount = 0;
+	_windowMisses = 0;
+	return false;
+    }
+
+    // Send the whole window back to back. Only the last one asks for an ACK, 
+    // so that ACKs dont collide with the rest of the burst
+    for (i = 0; i < _windowCount; i++)
+    {
+	WindowSlot* slot = &_window[i];
+	uint8_t headerFlagsToSet = (i + 1 < _windowCount) ? RH_FLAGS_DEFER_ACK : RH_FLAGS_NONE;
+	if (slot->tries)
+	{
+	    headerFlagsToSet |= RH_FLAGS_RETRY;
+	    _retransmissions++;
+	}
+	setHeaderId(slot->id);
+	setHeaderFlags(headerFlagsToSet, RH_FLAGS_ACK | RH_FLAGS_RETRY | RH_FLAGS_DEFER_ACK);
+	sendto(slot->buf, slot->len, _windowAddress);
+	waitPacketSent();
+	if (slot->tries < 255)
+	    slot->tries++;
+    }
+    unsigned long thisSendTime = millis(); // Timeout does not include transmit time
+    // The ACK is triggered by the last message. Karn: dont time it if it was a retransmission
+    bool timeable = (_window[_windowCount - 1].tries == 1);
+
+    // Randomise the timeout a little to prevent collisions on every retransmit
+#if (RH_PLATFORM == RH_PLATFORM_RASPI) // use standard library random(), bugs in random(min, max)
+    uint16_t timeout = _rto + (_rto * (random() & 0xFF) / 1024);
+#else
+    uint16_t timeout = _rto + (_rto * random(0, 256) / 1024);
+#endif
+    bool acked = false;
+    int32_t timeLeft;
+    while ((timeLeft = timeout - (millis() - thisSendTime)) > 0)
+    {
+	if (waitAvailableTimeout(timeLeft))
+	{
+	    uint8_t ack[3];
+	    uint8_t len = sizeof(ack);
+	    uint8_t from, to, id, flags;
+	    if (recvfrom(ack, &len, &from, &to, &id, &flags))
+	    {
+		if (   from == _windowAddress 
+		    && to == _thisAddress 
+		    && (flags & RH_FLAGS_ACK))
+		{
+		    if (windowAcked(id, ack, len) && !acked)
+		    {
+			if (timeable)
+			    updateRoundTripTime(millis() - thisSendTime);
+			else
+			    updateRoundTripTime(0); // Just undo any back off
+			acked = true;
+		    }
+		    for (i = 0; i < _windowCount && _window[i].acked; i++)
+			;
+		    if (i == _windowCount)
+			break; // Everything has been ACKed
+		}
+		else if (   !(flags & (RH_FLAGS_ACK | RH_FLAGS_DEFER_ACK))
+			 && !isNewId(from, id, false))
+		{
+		    // This is a request we have already received. ACK it again
+		    acknowledge(id, from);
+		}
+		// Else discard it
+	    }
+	}
+	YIELD;
+    }
+    if (!acked)
+    {
+	// Back off
+	_rto = (_rto > RH_RELIABLE_MAX_TIMEOUT / 2) ? RH_RELIABLE_MAX_TIMEOUT : _rto * 2;
+	_windowMisses++;
+    }
+    else
+	_windowMisses = 0;
+
+    // Drop the ACKed messages, keeping the order of the rest
+    uint8_t kept = 0;
+    for (i = 0; i < _windowCount; i++)
+    {
+	if (!_window[i].acked)
+	{
+	    if (acked)
+		_window[i].lost++;
+	    if (kept != i)
+		_window[kept] = _window[i];
+	    kept++;
+	}
+    }
+    _windowCount = kept;
+    return true;
+}
+
+bool RHReliableDatagram::windowAcked(uint8_t id, const uint8_t* ack, uint8_t len)
+{
+    bool found = false;
+    for (uint8_t i = 0; i < _windowCount; i++)
+    {
+	WindowSlot* slot = &_window[i];
+	bool acked = (slot->id == id);
+	if (!acked && len >= 3 && ack[0] == '!')
+	{
+	    // ack[1] is the newest ID the receiver has seen, ack[2] which of the 8 before it
+	    uint8_t age = ack[1] - slot->id;
+	    acked = (age == 0) || (age <= 8 && (ack[2] & (1 << (age - 1))));
+	}
+	if (acked && !slot->acked)
+	{
+	    slot->acked = true;
+	    found = true;
+	}
+    }
+    return found;
+}
+
+void RHReliableDatagram::updateRoundTripTime(uint16_t rtt)
+{
+    // As in TCP (RFC 6298). 0 recalculates the timeout without a new measurement
+    if (!_srtt)
+    {
+	if (!rtt)
+	{
+	    _rto = _timeout;
+	    return;
+	}
+	_srtt = rtt;
+	_rttvar = rtt / 2;
+    }
+    else if (rtt)
+    {
+	uint16_t err = (rtt > _srtt) ? rtt - _srtt : _srtt - rtt;
+	_rttvar = ((uint32_t)_rttvar * 3 + err) / 4;
+	_srtt = ((uint32_t)_srtt * 7 + rtt) / 8;
+    }
+    // Allow some margin even when the round trip time has been very steady
+    uint32_t margin = 4 * (uint32_t)_rttvar;
+    if (margin < _srtt / 4)
+	margin = _srtt / 4;
+    if (margin < RH_RELIABLE_MIN_TIMEOUT)
+	margin = RH_RELIABLE_MIN_TIMEOUT;
+    uint32_t rto = _srtt + margin;
+    if (rto > RH_RELIABLE_MAX_TIMEOUT)
+	rto = RH_RELIABLE_MAX_TIMEOUT;
+    _rto = rto;
+}
+
+bool RHReliableDatagram::isNewId(uint8_t from, uint8_t id, bool mark)
+{
+    int8_t diff = id - _seenIds[from];
+    if (diff == 0)
+	return false;
+    if (diff < 0 && diff >= -8)
+    {
+	// One of the 8 before the newest
+	uint8_t bit = 1 << (-diff - 1);
+	if (_seenBits[from] & bit)
+	    return false;
+	if (mark)
+	    _seenBits[from] |= bit;
+	return true;
+    }
+    if (mark)
+    {
+	if (diff > 0 && diff <= 8)
+	    _seenBits[from] = (_seenBits[from] << diff) | (1 << (diff - 1));
+	else
+	    _seenBits[from] = 0; // Far ahead, or the sender has restarted
+	_seenIds[from] = id;
+    }
+    return true;
+}
+#endif
+
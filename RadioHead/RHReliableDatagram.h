@@ -15,6 +15,9 @@
 /// The retry bit in the header FLAGS. This indicates that the payload is a retry for a
 /// previously sent message.
 #define RH_FLAGS_RETRY 0x40
+/// The deferred ack bit in the header FLAGS. Used in windowed mode for all but the last message
+/// of a burst: the receiver records the message but only acknowledges the last one of the burst.
+#define RH_FLAGS_DEFER_ACK 0x20
 
 /// This macro enables enhanced message deduplication behavior. This currently defaults
 /// to 0 (off), but this may change to default to 1 (on) in future releases. Consumers who
@@ -37,6 +40,28 @@
 /// The default number of retries
 #define RH_DEFAULT_RETRIES 3
 
+/// Number of messages that can be outstanding in windowed mode (see sendtoWindow()).
+/// 0 (the default) disables windowed mode. At most 8. Must be enabled on both the sending and the
+/// receiving nodes. Each message in the window takes RH_RELIABLE_WINDOW_MAX_MESSAGE_LEN + 4 octets,
+/// and receiving nodes use another 256 octets for duplicate detection.
+#ifndef RH_RELIABLE_WINDOW_SIZE
+ #define RH_RELIABLE_WINDOW_SIZE 0
+#endif
+
+/// Largest message that can be sent with sendtoWindow()
+#ifndef RH_RELIABLE_WINDOW_MAX_MESSAGE_LEN
+ #define RH_RELIABLE_WINDOW_MAX_MESSAGE_LEN 251
+#endif
+
+/// Minimum margin above the round trip time, and maximum, of the adaptive retransmit timeout
+/// used in windowed mode, in milliseconds
+#define RH_RELIABLE_MIN_TIMEOUT 20
+#define RH_RELIABLE_MAX_TIMEOUT 10000
+
+#if RH_RELIABLE_WINDOW_SIZE > 8
+ #error RH_RELIABLE_WINDOW_SIZE can be at most 8
+#endif
+
 /////////////////////////////////////////////////////////////////////
 /// \class RHReliableDatagram RHReliableDatagram.h <RHReliableDatagram.h>
 /// \brief RHDatagram subclass for sending addressed, acknowledged, retransmitted datagrams.
@@ -92,6 +117,19 @@
 /// to process the acknowledgement. Best practice is to use the same processors (and
 /// radios) throughout your network.
 ///
+/// \par Windowed mode
+///
+/// sendtoWait() can only send one message per round trip, which is slow on links with long 
+/// round trip times such as LoRa. If RH_RELIABLE_WINDOW_SIZE is defined to be greater than 0
+/// (on all nodes), sendtoWindow() queues up to RH_RELIABLE_WINDOW_SIZE messages to one node and sends them
+/// as one burst. Only the last message of the burst is acknowledged, and since the radios are half duplex
+/// this avoids acknowledgements colliding with the rest of the burst. In windowed mode the ACK payload
+/// also carries the newest ID received from the sender and a bitmap of which of the 8 IDs before it were received, so
+/// one ACK acknowledges the whole burst, and only the messages that were lost are sent again in the next burst.
+/// The retransmit timeout adapts to the measured round trip time (see roundTripTime()) instead of
+/// using the fixed timeout.
+/// Caution: after a loss, messages sent with sendtoWindow() may be delivered out of order.
+///
 class RHReliableDatagram : public RHDatagram
 {
 public:
@@ -183,6 +221,34 @@ public:
     /// to 0. 
     void resetRetransmissions(); 
 
+#if RH_RELIABLE_WINDOW_SIZE
+    /// Queues a message for reliable delivery in windowed mode. The message is copied, and sent with the 
+    /// other queued messages when the window is full or when waitWindowSent() is called.
+    /// All messages in the window go to the same address: queueing a message for another address first
+    /// waits until the window has been sent. Broadcasts are sent immediately with sendtoWait().
+    /// \param[in] buf Pointer to the binary message to send
+    /// \param[in] len Number of octets to send (at most RH_RELIABLE_WINDOW_MAX_MESSAGE_LEN)
+    /// \param[in] address The address to send the message to.
+    /// \return true if the message was queued. false if it is too long, or if an earlier message in the window
+    /// could not be delivered after all retries. The window is then emptied.
+    bool sendtoWindow(uint8_t* buf, uint8_t len, uint8_t address);
+
+    /// Sends the queued messages and blocks until they are all acknowledged, or they could not be
+    /// delivered: retries+1 bursts in a row got no ACK, or a message was missing from retries+1 ACKs.
+    /// Any received message other than the expected ACK is discarded.
+    /// \return true if all queued messages were acknowledged. Otherwise the window is emptied
+    /// and false is returned.
+    bool waitWindowSent();
+
+    /// Returns the number of messages queued by sendtoWindow() that have not been acknowledged yet
+    /// \return The number of messages in the window
+    uint8_t windowQueued();
+
+    /// Returns the smoothed round trip time measured in windowed mode, from the end of a burst to its ACK. 
+    /// \return The round trip time in milliseconds, 0 if none has been measured yet
+    uint16_t roundTripTime();
+#endif
+
 protected:
     /// Send an ACK for the message id to the given from address
     /// Blocks until the ACK has been sent
@@ -193,6 +259,27 @@ protected:
     /// \return true if there is a message received and it is a new message
     bool haveNewMessage();
 
+#if RH_RELIABLE_WINDOW_SIZE
+    /// Checks whether a message ID from the given node has been received before.
+    /// \param[in] from The node that sent the message
+    /// \param[in] id The message ID
+    /// \param[in] mark Remember the ID as received
+    /// \return true if the ID has not been received before
+    bool isNewId(uint8_t from, uint8_t id, bool mark);
+
+    /// Sends every unacknowledged message in the window as one burst and waits for the ACK. 
+    /// Acknowledged messages are then removed from the window.
+    /// \return false if a message in the window ran out of retries
+    bool sendWindowBurst();
+
+    /// Marks the messages acknowledged by an ACK as acknowledged
+    /// \return true if the ACK acknowledged any message in the window
+    bool windowAcked(uint8_t id, const uint8_t* ack, uint8_t len);
+
+    /// Updates the round trip time estimate and the retransmit timeout
+    void updateRoundTripTime(uint16_t rtt);
+#endif
+
 private:
     /// Count of retransmissions we have had to send
     uint32_t _retransmissions;
@@ -214,6 +301,42 @@ private:
     /// (this is generally due to lost ACKs, causing the sender to retransmit, even though we have already
     /// received that message)
     uint8_t _seenIds[256];
+
+#if RH_RELIABLE_WINDOW_SIZE
+    /// Array of bitmaps indexed by node address, of which of the 8 IDs before the
+    /// one in _seenIds have been received
+    uint8_t _seenBits[256];
+
+    /// A message in the window
+    typedef struct
+    {
+	uint8_t id;
+	uint8_t len;
+	uint8_t tries;  // Number of times sent
+	uint8_t lost;   // Number of ACKs received that did not acknowledge it
+	bool    acked;
+	uint8_t buf[RH_RELIABLE_WINDOW_MAX_MESSAGE_LEN];
+    } WindowSlot;
+
+    /// Messages queued by sendtoWindow(), oldest first
+    WindowSlot _window[RH_RELIABLE_WINDOW_SIZE];
+
+    /// Number of messages in _window
+    uint8_t _windowCount;
+
+    /// Address the messages in _window are sent to
+    uint8_t _windowAddress;
+
+    /// Number of bursts in a row that were not ACKed at all
+    uint8_t _windowMisses;
+
+    /// Smoothed round trip time and its mean deviation, in milliseconds
+    uint16_t _srtt;
+    uint16_t _rttvar;
+
+    /// Current retransmit timeout in windowed mode, in milliseconds
+    uint16_t _rto;
+#endif
 };
 
 /// @example rf22_reliable_datagram_client.pde
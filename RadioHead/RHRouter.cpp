@@ -47,55 +47,133 @@ void RHRouter::setIsaRouter(bool isa_router)
     _isa_router = isa_router;
 }
 ////////////////////////////////////////////////////////////////////
-void RHRouter::addRouteTo(uint8_t dest, uint8_t next_hop, uint8_t state)
-{
-    uint8_t i;
+// The routing table is a hash table with linear probing: the route to dest lives in
+// the first slot at or after its home slot, and Invalid slots end the search
+#define RH_ROUTE_HOME(dest) ((dest) % RH_ROUTING_TABLE_SIZE)
 
+void RHRouter::addRouteTo(uint8_t dest, uint8_t next_hop, uint8_t state, uint8_t hops, int16_t rssi)
+{
     // First look for an existing entry we can update
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
+    uint8_t i = routeIndex(dest);
+    if (i < RH_ROUTING_TABLE_SIZE)
     {
-	if (_routes[i].dest == dest)
-	{
-	    _routes[i].dest = dest;
-	    _routes[i].next_hop = next_hop;
-	    _routes[i].state = state;
-	    return;
-	}
+	_routes[i].next_hop = next_hop;
+	_routes[i].state = state;
+	_routes[i].hops = hops;
+	_routes[i].rssi = rssi;
+	_routes[i].lastUsed = millis();
+	return;
     }
 
-    // Look for an invalid entry we can use
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
+    if (!insertRoute(dest, next_hop, state, hops, rssi))
     {
-	if (_routes[i].state == Invalid)
-	{
-	    _routes[i].dest = dest;
-	    _routes[i].next_hop = next_hop;
-	    _routes[i].state = state;
-	    return;
-	}
+	// Need to make room for a new one
+	retireOldestRoute();
+	insertRoute(dest, next_hop, state, hops, rssi);
     }
+}
 
-    // Need to make room for a new one
-    retireOldestRoute();
-    // Should be an invalid slot now
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
+////////////////////////////////////////////////////////////////////
+bool RHRouter::learnRouteTo(uint8_t dest, uint8_t next_hop, uint8_t hops, int16_t rssi)
+{
+    if (dest == _thisAddress || dest == RH_BROADCAST_ADDRESS || hops == 0)
+	return false;
+
+    uint8_t i = routeIndex(dest);
+    if (i < RH_ROUTING_TABLE_SIZE)
+    {
+	RoutingTableEntry* route = &_routes[i];
+	if (route->hops == 0)
+	    return false; // Hardwired, leave it alone
+	if (   route->state == Valid
+	    && route->next_hop != next_hop
+	    && hops > route->hops)
+	    return false;
+	if (   route->state == Valid
+	    && route->next_hop != next_hop
+	    && hops == route->hops
+	    && rssi < route->rssi + RH_ROUTER_RSSI_HYSTERESIS)
+	    return false;
+	// Better route, or fresh news about the current one
+	route->next_hop = next_hop;
+	route->state = Valid;
+	route->hops = hops;
+	route->rssi = rssi;
+	route->lastUsed = millis();
+	return true;
+    }
+
+    if (insertRoute(dest, next_hop, Valid, hops, rssi))
+	return true;
+    // Table is full: only ever push out another learned route
+    i = leastRecentlyUsedRoute(true);
+    if (i == RH_ROUTING_TABLE_SIZE)
+	return false;
+    deleteRoute(i);
+    return insertRoute(dest, next_hop, Valid, hops, rssi);
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHRouter::insertRoute(uint8_t dest, uint8_t next_hop, uint8_t state, uint8_t hops, int16_t rssi)
+{
+    uint8_t i = RH_ROUTE_HOME(dest);
+    uint8_t n;
+    for (n = 0; n < RH_ROUTING_TABLE_SIZE; n++)
     {
 	if (_routes[i].state == Invalid)
 	{
 	    _routes[i].dest = dest;
 	    _routes[i].next_hop = next_hop;
 	    _routes[i].state = state;
+	    _routes[i].hops = hops;
+	    _routes[i].rssi = rssi;
+	    _routes[i].lastUsed = millis();
+	    return true;
 	}
+	if (++i >= RH_ROUTING_TABLE_SIZE)
+	    i = 0;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////
+uint8_t RHRouter::routeIndex(uint8_t dest)
+{
+    uint8_t i = RH_ROUTE_HOME(dest);
+    uint8_t n;
+    for (n = 0; n < RH_ROUTING_TABLE_SIZE && _routes[i].state != Invalid; n++)
+    {
+	if (_routes[i].dest == dest)
+	    return i;
+	if (++i >= RH_ROUTING_TABLE_SIZE)
+	    i = 0;
     }
+    return RH_ROUTING_TABLE_SIZE;
 }
 
 ////////////////////////////////////////////////////////////////////
-RHRouter::RoutingTableEntry* RHRouter::getRouteTo(uint8_t dest)
+uint8_t RHRouter::leastRecentlyUsedRoute(bool learned_only)
 {
+    unsigned long now = millis();
+    uint8_t oldest = RH_ROUTING_TABLE_SIZE;
     uint8_t i;
     for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
-	if (_routes[i].dest == dest && _routes[i].state != Invalid)
-	    return &_routes[i];
+    {
+	if (_routes[i].state == Invalid || (learned_only && _routes[i].hops == 0))
+	    continue;
+	if (   oldest == RH_ROUTING_TABLE_SIZE
+	    || (now - _routes[i].lastUsed) > (now - _routes[oldest].lastUsed))
+	    oldest = i;
+    }
+    return oldest;
+}
+
+////////////////////////////////////////////////////////////////////
+RHRouter::RoutingTableEntry* RHRouter::getRouteTo(uint8_t dest)
+{
+    uint8_t i = routeIndex(dest);
+    if (i < RH_ROUTING_TABLE_SIZE)
+	return &_routes[i];
     return NULL;
 }
 
@@ -143,10 +221,27 @@ bool RHRouter::getNextValidRoutingTableEntry(RoutingTableEntry *RTE_p, int *last
 ////////////////////////////////////////////////////////////////////
 void RHRouter::deleteRoute(uint8_t index)
 {
-    // Delete a route by copying following routes on top of it
-    memcpy(&_routes[index], &_routes[index+1], 
-	   sizeof(RoutingTableEntry) * (RH_ROUTING_TABLE_SIZE - index - 1));
-    _routes[RH_ROUTING_TABLE_SIZE - 1].state = Invalid;
+    // Free the slot, then move back any later routes in the same probe run that
+    // would otherwise become unreachable behind the hole
+    uint8_t hole = index;
+    uint8_t i = index;
+    _routes[hole].state = Invalid;
+    while (true)
+    {
+	if (++i >= RH_ROUTING_TABLE_SIZE)
+	    i = 0;
+	if (_routes[i].state == Invalid)
+	    break;
+	uint8_t home = RH_ROUTE_HOME(_routes[i].dest);
+	// The route at i can move to the hole unless its home is cyclically in (hole, i]
+	bool homeBetween = (hole <= i) ? (home > hole && home <= i) : (home > hole || home <= i);
+	if (!homeBetween)
+	{
+	    _routes[hole] = _routes[i];
+	    _routes[i].state = Invalid;
+	    hole = i;
+	}
+    }
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -162,7 +257,11 @@ void RHRouter::printRoutingTable()
 	Serial.print(" Next Hop: ");
 	Serial.print(_routes[i].next_hop, DEC);
 	Serial.print(" State: ");
-	Serial.println(_routes[i].state, DEC);
+	Serial.print(_routes[i].state, DEC);
+	Serial.print(" Hops: ");
+	Serial.print(_routes[i].hops, DEC);
+	Serial.print(" RSSI: ");
+	Serial.println(_routes[i].rssi, DEC);
     }
 #endif
 }
@@ -170,23 +269,21 @@ void RHRouter::printRoutingTable()
 ////////////////////////////////////////////////////////////////////
 bool RHRouter::deleteRouteTo(uint8_t dest)
 {
-    uint8_t i;
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
-    {
-	if (_routes[i].dest == dest)
-	{
-	    deleteRoute(i);
-	    return true;
-	}
-    }
-    return false;
+    uint8_t i = routeIndex(dest);
+    if (i == RH_ROUTING_TABLE_SIZE)
+	return false;
+    deleteRoute(i);
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////
 void RHRouter::retireOldestRoute()
 {
-    // We just obliterate the first in the table and clear the last
-    deleteRoute(0);
+    uint8_t i = leastRecentlyUsedRoute(true);
+    if (i == RH_ROUTING_TABLE_SIZE)
+	i = leastRecentlyUsedRoute(false);
+    if (i < RH_ROUTING_TABLE_SIZE)
+	deleteRoute(i);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -232,6 +329,7 @@ uint8_t RHRouter::route(RoutedMessage* message, uint8_t messageLen)
 	if (!route)
 	    return RH_ROUTER_ERROR_NO_ROUTE;
 	next_hop = route->next_hop;
+	route->lastUsed = millis();
     }
 
     if (!RHReliableDatagram::sendtoWait((uint8_t*)message, messageLen, next_hop))
@@ -308,6 +406,16 @@ bool RHRouter::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* source, uint8_t*
 	}
 #endif
 
+#if RH_ROUTER_LEARN_ROUTES
+	// The last hop is a neighbour. Unicast messages also tell us how far away their
+	// source is; broadcasts may have been resent with a spoofed source and HOPS of 0
+	int16_t rssi = _driver.lastRssi();
+	learnRouteTo(_from, _from, 1, rssi);
+	if (   _tmpMessage.header.dest != RH_BROADCAST_ADDRESS
+	    && _tmpMessage.header.source != _from)
+	    learnRouteTo(_tmpMessage.header.source, _from, _tmpMessage.header.hops + 1, rssi);
+#endif
+
 	peekAtMessage(&_tmpMessage, tmpMessageLen);
 	// See if its for us or has to be routed
 	if (_tmpMessage.header.dest == _thisAddress || _tmpMessage.header.dest == RH_BROADCAST_ADDRESS)
@@ -13,7 +13,23 @@
 #define RH_DEFAULT_MAX_HOPS 30
 
 // The default size of the routing table we keep
+#ifndef RH_ROUTING_TABLE_SIZE
 #define RH_ROUTING_TABLE_SIZE 10
+#endif
+#if RH_ROUTING_TABLE_SIZE > 255
+#error RH_ROUTING_TABLE_SIZE must be 255 or less
+#endif
+
+// Whether RHRouter learns routes from the messages it receives and forwards
+#ifndef RH_ROUTER_LEARN_ROUTES
+#define RH_ROUTER_LEARN_ROUTES 1
+#endif
+
+// A learned route with the same number of hops replaces the current one only if its
+// next hop is heard this much stronger (in units of lastRssi())
+#ifndef RH_ROUTER_RSSI_HYSTERESIS
+#define RH_ROUTER_RSSI_HYSTERESIS 6
+#endif
 
 // Error codes
 #define RH_ROUTER_ERROR_NONE              0
@@ -91,9 +107,20 @@
 /// You can also use addRouteTo() to change a route and 
 /// deleteRouteTo() to delete a route at run time. Youcan also clear the entire routing table
 ///
-/// The Routing Table has limited capacity for entries (defined by RH_ROUTING_TABLE_SIZE, which is 10)
-/// if more than RH_ROUTING_TABLE_SIZE are added, the oldest (first) one will be removed by calling 
-/// retireOldestRoute()
+/// The Routing Table has limited capacity for entries (defined by RH_ROUTING_TABLE_SIZE, which defaults to 10
+/// and may be up to 255). It is a hash table keyed on the destination address, so lookups stay fast in large
+/// tables. If more than RH_ROUTING_TABLE_SIZE are added, the least recently used one will be removed by calling 
+/// retireOldestRoute(). Learned routes (see below) are retired before routes added with a hop count of 0.
+///
+/// \par Learned Routes
+///
+/// Unless RH_ROUTER_LEARN_ROUTES is defined to 0, recvfromAck() also learns routes from the messages
+/// it receives or forwards: the last hop node is a neighbour, and the SOURCE of a unicast message can be 
+/// reached through the last hop in HOPS+1 hops. Each entry remembers its hop count and the RSSI of the next hop, 
+/// and a learned route replaces an existing one only if it has fewer hops, or the same number of hops and a
+/// next hop that is heard at least RH_ROUTER_RSSI_HYSTERESIS stronger. Learned routes never replace or evict
+/// routes added by addRouteTo() with a hop count of 0, so hardwired routes are left as they are.
+/// In RHMesh this means busy nodes seldom need route discovery.
 ///
 /// \par Message Format
 ///
@@ -166,6 +193,9 @@ public:
 	uint8_t      dest;      ///< Destination node address
 	uint8_t      next_hop;  ///< Send via this next hop address
 	uint8_t      state;     ///< State of this route, one of RouteState
+	uint8_t      hops;      ///< Number of hops to dest, 0 if not known (hardwired)
+	int16_t      rssi;      ///< RSSI of the next hop when the route was learned
+	unsigned long lastUsed; ///< millis() when the route was last added, learned or used
     } RoutingTableEntry;
 
     /// Constructor. 
@@ -194,11 +224,25 @@ public:
     void setMaxHops(uint8_t max_hops);
 
     /// Adds a route to the local routing table, or updates it if already present.
-    /// If there is not enough room the oldest (first) route will be deleted by calling retireOldestRoute().
+    /// If there is not enough room the least recently used route will be deleted by calling retireOldestRoute().
     /// \param [in] dest The destination node address. RH_BROADCAST_ADDRESS is permitted.
     /// \param [in] next_hop The address of the next hop to send messages destined for dest
     /// \param [in] state The satte of the route. Defaults to Valid
-    void addRouteTo(uint8_t dest, uint8_t next_hop, uint8_t state = Valid);
+    /// \param [in] hops The number of hops to dest. 0 (the default) means not known, and 
+    /// the route will not be replaced by learned routes
+    /// \param [in] rssi The RSSI of next_hop, if known
+    void addRouteTo(uint8_t dest, uint8_t next_hop, uint8_t state = Valid, uint8_t hops = 0, int16_t rssi = 0);
+
+    /// Adds a route learned from network traffic to the local routing table.
+    /// The route is only used if there is no route to dest yet, or if it is better than the current
+    /// learned one (see Learned Routes above). Never replaces or evicts a route with a hop count of 0.
+    /// Called by recvfromAck() if RH_ROUTER_LEARN_ROUTES is enabled.
+    /// \param [in] dest The destination node address
+    /// \param [in] next_hop The address of the next hop to send messages destined for dest
+    /// \param [in] hops The number of hops to dest through next_hop, at least 1
+    /// \param [in] rssi The RSSI of next_hop
+    /// \return true if the route was added or updated
+    bool learnRouteTo(uint8_t dest, uint8_t next_hop, uint8_t hops, int16_t rssi);
 
     /// Finds and returns a RoutingTableEntry for the given destination node
     /// \param [in] dest The desired destination node address.
@@ -210,8 +254,8 @@ public:
     /// \return true if the route was present
     bool deleteRouteTo(uint8_t dest);
 
-    /// Deletes the oldest (first) route from the 
-    /// local routing table
+    /// Deletes the least recently used route from the 
+    /// local routing table, preferring learned routes to ones with a hop count of 0
     void retireOldestRoute();
 
     /// Clears all entries from the 
@@ -323,6 +367,20 @@ protected:
     /// \param [in] index The 0 based index of the routing table entry to delete
     void deleteRoute(uint8_t index);
 
+    /// Returns the index in the routing table of the route to dest
+    /// \param [in] dest The destination node address
+    /// \return The 0 based index, or RH_ROUTING_TABLE_SIZE if there is no route to dest
+    uint8_t routeIndex(uint8_t dest);
+
+    /// Returns the index of the least recently used route
+    /// \param [in] learned_only If true, only consider routes with a known hop count
+    /// \return The 0 based index, or RH_ROUTING_TABLE_SIZE if there is no such route
+    uint8_t leastRecentlyUsedRoute(bool learned_only);
+
+    /// Stores a new route in the first free slot after the home slot for dest
+    /// \return false if the routing table is full
+    bool insertRoute(uint8_t dest, uint8_t next_hop, uint8_t state, uint8_t hops, int16_t rssi);
+
     /// The last end-to-end sequence number to be used
     /// Defaults to 0
     uint8_t _lastE2ESequenceNumber;
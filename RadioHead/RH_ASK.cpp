@@ -883,10 +883,8 @@ uint8_t RH_INTERRUPT_ATTR RH_ASK::symbol_6to4(uint8_t symbol)
 // since it is slow
 void RH_ASK::validateRxBuf()
 {
-    uint16_t crc = 0xffff;
     // The CRC covers the byte count, headers and user data
-    for (uint8_t i = 0; i < _rxBufLen; i++)
-	crc = RHcrc_ccitt_update(crc, _rxBuf[i]);
+    uint16_t crc = RHcrc_ccitt(0xffff, _rxBuf, _rxBufLen);
     if (crc != 0xf0b8) // CRC when buffer and expected CRC are CRC'd
     {
 	// Reject and drop the message
@@ -293,6 +293,32 @@ void RH_NRF24::validateRxBuf()
 
 bool RH_NRF24::available()
 {
+#if RH_RX_QUEUE_LEN
+    // There is no interrupt handler: move whatever the radio has received into the queue,
+    // leaving the rest in the radio's own FIFO if the queue is full, and keep receiving
+    if (_mode == RHModeTx)
+	return rxQueued() > 0;
+    setModeRx();
+    while (rxQueued() < RH_RX_QUEUE_LEN
+	   && !(spiReadRegister(RH_NRF24_REG_17_FIFO_STATUS) & RH_NRF24_RX_EMPTY))
+    {
+	// Manual says that messages > 32 octets should be discarded
+	uint8_t len = spiRead(RH_NRF24_COMMAND_R_RX_PL_WID);
+	if (len > 32)
+	{
+	    flushRx();
+	    break;
+	}
+	spiWriteRegister(RH_NRF24_REG_07_STATUS, RH_NRF24_RX_DR);
+	spiBurstRead(RH_NRF24_COMMAND_R_RX_PAYLOAD, _buf, len);
+	_bufLen = len;
+	validateRxBuf(); 
+	if (_rxBufValid)
+	    rxQueuePut(_buf + RH_NRF24_HEADER_LEN, _bufLen - RH_NRF24_HEADER_LEN);
+	clearRxBuf();
+    }
+    return rxQueued() > 0;
+#else
     if (!_rxBufValid)
     {
 	if (_mode == RHModeTx)
@@ -320,6 +346,7 @@ bool RH_NRF24::available()
 	    setModeIdle(); // Got one
     }
     return _rxBufValid;
+#endif
 }
 
 void RH_NRF24::clearRxBuf()
@@ -332,6 +359,9 @@ bool RH_NRF24::recv(uint8_t* buf, uint8_t* len)
 {
     if (!available())
 	return false;
+#if RH_RX_QUEUE_LEN
+    rxQueueGet(buf, len);
+#else
     if (buf && len)
     {
 	// Skip the 4 headers that are at the beginning of the rxBuf
@@ -340,6 +370,7 @@ bool RH_NRF24::recv(uint8_t* buf, uint8_t* len)
 	memcpy(buf, _buf+RH_NRF24_HEADER_LEN, *len);
     }
     clearRxBuf(); // This message accepted and cleared
+#endif
     return true;
 }
 
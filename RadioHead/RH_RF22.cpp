@@ -298,6 +298,13 @@ void RH_RF22::handleInterrupt()
 	_bufLen = len;
 	_mode = RHModeIdle;
 	_rxBufValid = true;
+#if RH_RX_QUEUE_LEN
+	// Queue it and go straight back to receiving
+	rxQueuePut(_buf, _bufLen);
+	clearRxBuf();
+	resetRxFifo();
+	setModeRx();
+#endif
     }
     if (_lastInterruptFlags[0] & RH_RF22_ICRCERROR)
     {
@@ -591,7 +598,11 @@ void RH_RF22::clearRxBuf()
 
 bool RH_RF22::available()
 {
+#if RH_RX_QUEUE_LEN
+    if (!rxQueued())
+#else
     if (!_rxBufValid)
+#endif
     {
 #if RH_PLATFORM == RH_PLATFORM_ESP8266
 	loopIsr();
@@ -601,7 +612,11 @@ bool RH_RF22::available()
 	setModeRx(); // Make sure we are receiving
 	YIELD; // Wait for any previous transmit to finish
     }
+#if RH_RX_QUEUE_LEN
+    return rxQueued() > 0;
+#else
     return _rxBufValid;
+#endif
 }
 
 #if RH_PLATFORM == RH_PLATFORM_ESP8266
@@ -621,6 +636,9 @@ bool RH_RF22::recv(uint8_t* buf, uint8_t* len)
     if (!available())
 	return false;
 
+#if RH_RX_QUEUE_LEN
+    rxQueueGet(buf, len);
+#else
     if (buf && len)
     {
 	ATOMIC_BLOCK_START;
@@ -630,6 +648,7 @@ bool RH_RF22::recv(uint8_t* buf, uint8_t* len)
 	ATOMIC_BLOCK_END;
     }
     clearRxBuf();
+#endif
 //    printBuffer("recv:", buf, *len);
     return true;
 }
@@ -220,6 +220,13 @@ void RH_RF69::handleInterrupt()
 	setModeIdle();
 	// Save it in our buffer
 	readFifo();
+#if RH_RX_QUEUE_LEN
+	// Queue it and go straight back to receiving
+	if (_rxBufValid)
+	    rxQueuePut(_buf, _bufLen);
+	_rxBufValid = false;
+	setModeRx();
+#endif
 //	Serial.println("PAYLOADREADY");
     }
 }
@@ -490,7 +497,11 @@ bool RH_RF69::available()
     if (_mode == RHModeTx)
 	return false;
     setModeRx(); // Make sure we are receiving
+#if RH_RX_QUEUE_LEN
+    return rxQueued() > 0;
+#else
     return _rxBufValid;
+#endif
 }
 
 bool RH_RF69::recv(uint8_t* buf, uint8_t* len)
@@ -498,6 +509,9 @@ bool RH_RF69::recv(uint8_t* buf, uint8_t* len)
     if (!available())
 	return false;
 
+#if RH_RX_QUEUE_LEN
+    rxQueueGet(buf, len);
+#else
     if (buf && len)
     {
 	ATOMIC_BLOCK_START;
@@ -507,6 +521,7 @@ bool RH_RF69::recv(uint8_t* buf, uint8_t* len)
 	ATOMIC_BLOCK_END;
     }
     _rxBufValid = false; // Got the most recent message
+#endif
 //    printBuffer("recv:", buf, *len);
     return true;
 }
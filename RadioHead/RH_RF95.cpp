@@ -38,6 +38,18 @@ RH_RF95::RH_RF95(uint8_t slaveSelectPin, uint8_t interruptPin, RHGenericSPI& spi
     _myInterruptIndex = 0xff; // Not allocated yet
     _enableCRC = true;
     _useRFO = false;
+    _frequencyKHz = 0;
+    _txStartTime = 0;
+    _numDutyCycleBands = 0;
+#if RH_RF95_TX_QUEUE_LEN
+    _txQueueHead = 0;
+    _txQueueCount = 0;
+    _txDropped = 0;
+    _txBackoffs = 0;
+    _txHeadSince = 0;
+    _txBackoffStart = 0;
+    _txBackoffTime = 0;
+#endif
 }
 
 bool RH_RF95::init()
@@ -221,20 +233,64 @@ void RH_RF95::handleInterrupt()
 	    
 	// We have received a message.
 	validateRxBuf(); 
+#if RH_RX_QUEUE_LEN
+	// Queue it and stay in continuous receive mode for the next one
+	if (_rxBufValid)
+	    rxQueuePut(_buf + RH_RF95_HEADER_LEN, _bufLen - RH_RF95_HEADER_LEN, _lastSNR);
+	clearRxBuf();
+#else
 	if (_rxBufValid)
 	    setModeIdle(); // Got one 
+#endif
     }
     else if (_mode == RHModeTx && irq_flags & RH_RF95_TX_DONE)
     {
 //	Serial.println("T");
 	_txGood++;
 	setModeIdle();
+	endTx();
+#if RH_RF95_TX_QUEUE_LEN
+	// Go on with the next queued message
+	if (_txQueueCount)
+	{
+	    txQueuePop();
+	    txQueueService();
+	}
+#endif
     }
     else if (_mode == RHModeCad && irq_flags & RH_RF95_CAD_DONE)
     {
 //	Serial.println("C");
         _cad = irq_flags & RH_RF95_CAD_DETECTED;
         setModeIdle();
+#if RH_RF95_TX_QUEUE_LEN
+	if (_txQueueCount)
+	{
+	    if (!_cad)
+	    {
+		txQueueStart(); // Clear channel, talk
+	    }
+	    else if (millis() - _txHeadSince > _cad_timeout)
+	    {
+		// Busy for too long
+		txQueuePop();
+		_txDropped++;
+		txQueueService();
+	    }
+	    else
+	    {
+		// Busy, back off for a random number of slots, up to twice as many as last time
+		uint8_t n = (_txBackoffs < 4) ? _txBackoffs : 4;
+		_txBackoffs++;
+		_txBackoffStart = millis();
+#if (RH_PLATFORM == RH_PLATFORM_STM32) // stdlib on STMF103 gets confused if random is redefined
+		_txBackoffTime = _random(1, (2 << n) + 1) * RH_RF95_TX_BACKOFF_SLOT;
+#else
+		_txBackoffTime = random(1, (2 << n) + 1) * RH_RF95_TX_BACKOFF_SLOT;
+#endif
+	    }
+	}
+#endif
     }
     else
     {
@@ -289,14 +345,23 @@ void RH_RF95::validateRxBuf()
 bool RH_RF95::available()
 {
     RH_MUTEX_LOCK(lock); // Multithreading support
+#if RH_RF95_TX_QUEUE_LEN
+    txQueueService();
+    if (_mode == RHModeTx || _mode == RHModeCad)
+#else
     if (_mode == RHModeTx)
+#endif
     {
     	RH_MUTEX_UNLOCK(lock);
 	return false;
     }
     setModeRx();
     RH_MUTEX_UNLOCK(lock);
+#if RH_RX_QUEUE_LEN
+    return rxQueued() > 0; // Filled by the interrupt handler
+#else
     return _rxBufValid; // Will be set by the interrupt handler when a good message is received
+#endif
 }
 
 void RH_RF95::clearRxBuf()
@@ -312,6 +377,9 @@ bool RH_RF95::recv(uint8_t* buf, uint8_t* len)
     if (!available())
 	return false;
     RH_MUTEX_LOCK(lock); // Multithread support
+#if RH_RX_QUEUE_LEN
+    rxQueueGet(buf, len, &_lastSNR);
+#else
     if (buf && len)
     {
 	ATOMIC_BLOCK_START;
@@ -322,6 +390,7 @@ bool RH_RF95::recv(uint8_t* buf, uint8_t* len)
 	ATOMIC_BLOCK_END;
     }
     clearRxBuf(); // This message accepted and cleared
+#endif
     RH_MUTEX_UNLOCK(lock);
     return true;
 }
@@ -331,9 +400,38 @@ bool RH_RF95::send(const uint8_t* data, uint8_t len)
     if (len > RH_RF95_MAX_MESSAGE_LEN)
 	return false;
 
+#if RH_RF95_TX_QUEUE_LEN
+    if (_txQueueCount >= RH_RF95_TX_QUEUE_LEN)
+	return false;
+    // The interrupt handler only touches the slot at the head of the queue
+    TxQueueEntry* e = &_txQueue[(_txQueueHead + _txQueueCount) % RH_RF95_TX_QUEUE_LEN];
+    e->buf[0] = _txHeaderTo;
+    e->buf[1] = _txHeaderFrom;
+    e->buf[2] = _txHeaderId;
+    e->buf[3] = _txHeaderFlags;
+    memcpy(e->buf + RH_RF95_HEADER_LEN, data, len);
+    e->len = len + RH_RF95_HEADER_LEN;
+    ATOMIC_BLOCK_START;
+    if (_txQueueCount == 0)
+    {
+	_txHeadSince = millis();
+	_txBackoffs = 0;
+	_txBackoffTime = 0;
+    }
+    _txQueueCount++;
+    ATOMIC_BLOCK_END;
+
+    RH_MUTEX_LOCK(lock); // Multithreading support
+    txQueueService();
+    RH_MUTEX_UNLOCK(lock);
+    return true;
+#else
     waitPacketSent(); // Make sure we dont interrupt an outgoing message
     setModeIdle();
 
+    if (dutyCycleWait())
+	return false;  // Sub-band is closed
+
     if (!waitCAD()) 
 	return false;  // Check channel activity
 
@@ -349,13 +447,153 @@ bool RH_RF95::send(const uint8_t* data, uint8_t len)
     spiWrite(RH_RF95_REG_22_PAYLOAD_LENGTH, len + RH_RF95_HEADER_LEN);
     
     RH_MUTEX_LOCK(lock); // Multithreading support
-    setModeTx(); // Start the transmitter
+    startTx(); // Start the transmitter
     RH_MUTEX_UNLOCK(lock);
     
     // when Tx is done, interruptHandler will fire and radio mode will return to STANDBY
     return true;
+#endif
+}
+
+void RH_RF95::startTx()
+{
+    _txStartTime = millis();
+    setModeTx();
+}
+
+void RH_RF95::endTx()
+{
+    unsigned long now = millis();
+    unsigned long airtime = now - _txStartTime;
+    uint8_t i;
+    for (i = 0; i < _numDutyCycleBands; i++)
+    {
+	DutyCycleBand* b = &_dutyCycleBands[i];
+	if (_frequencyKHz >= b->lowKHz && _frequencyKHz <= b->highKHz)
+	{
+	    b->offStart = now;
+	    b->offTime = airtime * (1000 - b->perMille) / b->perMille;
+	}
+    }
+}
+
+bool RH_RF95::setDutyCycle(float low, float high, uint16_t perMille)
+{
+    if (_numDutyCycleBands >= RH_RF95_DUTY_CYCLE_BANDS || perMille == 0)
+	return false;
+    DutyCycleBand* b = &_dutyCycleBands[_numDutyCycleBands];
+    b->lowKHz = low * 1000.0;
+    b->highKHz = high * 1000.0;
+    b->perMille = (perMille > 1000) ? 1000 : perMille;
+    b->offStart = 0;
+    b->offTime = 0;
+    _numDutyCycleBands++;
+    return true;
+}
+
+void RH_RF95::clearDutyCycles()
+{
+    _numDutyCycleBands = 0;
 }
 
+unsigned long RH_RF95::dutyCycleWait()
+{
+    unsigned long now = millis();
+    unsigned long wait = 0;
+    uint8_t i;
+    for (i = 0; i < _numDutyCycleBands; i++)
+    {
+	DutyCycleBand* b = &_dutyCycleBands[i];
+	if (_frequencyKHz >= b->lowKHz && _frequencyKHz <= b->highKHz)
+	{
+	    unsigned long elapsed = now - b->offStart;
+	    if (elapsed < b->offTime && b->offTime - elapsed > wait)
+		wait = b->offTime - elapsed;
+	}
+    }
+    return wait;
+}
+
+#if RH_RF95_TX_QUEUE_LEN
+bool RH_RF95::waitPacketSent()
+{
+    while (_txQueueCount || _mode == RHModeTx || _mode == RHModeCad)
+    {
+	RH_MUTEX_LOCK(lock); // Multithreading support
+	txQueueService();
+	RH_MUTEX_UNLOCK(lock);
+	YIELD;
+    }
+    return true;
+}
+
+bool RH_RF95::waitPacketSent(uint16_t timeout)
+{
+    unsigned long starttime = millis();
+    while ((millis() - starttime) < timeout)
+    {
+	if (!_txQueueCount && _mode != RHModeTx && _mode != RHModeCad)
+	    return true;
+	RH_MUTEX_LOCK(lock); // Multithreading support
+	txQueueService();
+	RH_MUTEX_UNLOCK(lock);
+	YIELD;
+    }
+    return false;
+}
+
+uint8_t RH_RF95::txQueued()
+{
+    return _txQueueCount;
+}
+
+uint16_t RH_RF95::txDropped()
+{
+    return _txDropped;
+}
+
+void RH_RF95::txQueueService()
+{
+    if (!_txQueueCount || _mode == RHModeTx || _mode == RHModeCad)
+	return;
+    if (millis() - _txBackoffStart < _txBackoffTime)
+	return; // Still backing off
+    if (dutyCycleWait())
+	return; // Sub-band is closed
+
+    if (_cad_timeout)
+    {
+	// Listen before talk. The interrupt handler carries on when CAD is done
+	modeWillChange(RHModeCad);
+	spiWrite(RH_RF95_REG_01_OP_MODE, RH_RF95_MODE_CAD);
+	spiWrite(RH_RF95_REG_40_DIO_MAPPING1, 0x80); // Interrupt on CadDone
+	_mode = RHModeCad;
+    }
+    else
+	txQueueStart();
+}
+
+void RH_RF95::txQueueStart()
+{
+    TxQueueEntry* e = &_txQueue[_txQueueHead];
+    setModeIdle();
+    // Position at the beginning of the FIFO
+    spiWrite(RH_RF95_REG_0D_FIFO_ADDR_PTR, 0);
+    spiBurstWrite(RH_RF95_REG_00_FIFO, e->buf, e->len);
+    spiWrite(RH_RF95_REG_22_PAYLOAD_LENGTH, e->len);
+    startTx();
+}
+
+void RH_RF95::txQueuePop()
+{
+    _txQueueHead = (_txQueueHead + 1) % RH_RF95_TX_QUEUE_LEN;
+    _txQueueCount--;
+    _txBackoffs = 0;
+    _txBackoffTime = 0;
+    _txHeadSince = millis();
+}
+#endif
+
 bool RH_RF95::printRegisters()
 {
 #ifdef RH_HAVE_SERIAL
@@ -385,6 +623,7 @@ bool RH_RF95::setFrequency(float centre)
     spiWrite(RH_RF95_REG_07_FRF_MID, (frf >> 8) & 0xff);
     spiWrite(RH_RF95_REG_08_FRF_LSB, frf & 0xff);
     _usingHFport = (centre >= 779.0);
+    _frequencyKHz = centre * 1000.0;
 
     return true;
 }
@@ -36,6 +36,22 @@
  #define RH_RF95_MAX_MESSAGE_LEN (RH_RF95_MAX_PAYLOAD_LEN - RH_RF95_HEADER_LEN)
 #endif
 
+// Number of outgoing messages send() can queue for the listen-before-talk transmit scheduler.
+// 0 (the default) disables the queue and send() transmits at once
+#ifndef RH_RF95_TX_QUEUE_LEN
+ #define RH_RF95_TX_QUEUE_LEN 0
+#endif
+
+// Backoff slot in ms for the transmit scheduler when CAD finds the channel busy
+#ifndef RH_RF95_TX_BACKOFF_SLOT
+ #define RH_RF95_TX_BACKOFF_SLOT 50
+#endif
+
+// Number of duty cycle sub-bands that can be set with setDutyCycle()
+#ifndef RH_RF95_DUTY_CYCLE_BANDS
+ #define RH_RF95_DUTY_CYCLE_BANDS 4
+#endif
+
 // The crystal oscillator frequency of the module
 #define RH_RF95_FXOSC 32000000.0
 
@@ -468,6 +484,22 @@
 /// and from that other device.  Use cli() to disable interrupts and sei() to
 /// reenable them.
 ///
+/// \par Transmit queue and duty cycle
+///
+/// If RH_RF95_TX_QUEUE_LEN is defined to more than 0, send() only queues the message and returns at once.
+/// The interrupt handler then sends the queued messages one after the other, listening before talking:
+/// if a CAD timeout has been set with setCADTimeout(), CAD is run before each message, and if the channel is
+/// busy the message waits a random backoff of 1 to 2, 4, ... 32 slots of RH_RF95_TX_BACKOFF_SLOT ms, growing
+/// with each busy CAD. A message that has not found a clear channel within the CAD timeout is dropped and counted 
+/// by txDropped(). Backoffs are timed by polling: available(), waitPacketSent() and send() move the queue along,
+/// and the receiver listens between transmissions. waitPacketSent() waits until the queue is empty.
+/// Each queued message takes RH_RF95_MAX_PAYLOAD_LEN + 1 octets of RAM.
+///
+/// setDutyCycle() limits the airtime in a frequency sub-band to a fraction of the time, as required in eg the 
+/// EU 868MHz bands: after each transmission taking t ms in a sub-band limited to d per mille, the sub-band is closed
+/// for t * (1000 - d) / d ms. With the queue, messages wait for the sub-band to open. Without it, send() returns
+/// false while the sub-band is closed.
+///
 /// \par Memory
 ///
 /// The RH_RF95 driver requires non-trivial amounts of memory. The sample
@@ -687,6 +719,42 @@ public:
     /// if CAD was requested and the CAD timeout timed out before clear channel was detected.
     virtual bool    send(const uint8_t* data, uint8_t len);
 
+#if RH_RF95_TX_QUEUE_LEN
+    /// Blocks until all queued messages have been transmitted or dropped
+    /// \return true
+    virtual bool    waitPacketSent();
+
+    /// Blocks until all queued messages have been transmitted or dropped, or until the timeout
+    /// \param[in] timeout Maximum time to wait in milliseconds.
+    /// \return true if the queue was emptied within the timeout period
+    virtual bool    waitPacketSent(uint16_t timeout);
+
+    /// Returns the number of messages queued by send() that have not been transmitted yet
+    /// \return The number of queued messages
+    uint8_t         txQueued();
+
+    /// Returns the number of queued messages that were dropped because the channel
+    /// was busy for longer than the CAD timeout
+    /// \return The number of dropped messages
+    uint16_t        txDropped();
+#endif
+
+    /// Limits the fraction of time the transmitter may be on in a frequency sub-band. 
+    /// Messages sent with a centre frequency from low to high are counted against the sub-band.
+    /// Eg for EU868: setDutyCycle(863.0, 868.6, 10); setDutyCycle(868.7, 869.2, 1); setDutyCycle(869.4, 869.65, 100)
+    /// \param[in] low Lowest frequency in the sub-band in MHz
+    /// \param[in] high Highest frequency in the sub-band in MHz
+    /// \param[in] perMille Permitted duty cycle, in parts per thousand (10 is 1%)
+    /// \return true if the sub-band was added, false if RH_RF95_DUTY_CYCLE_BANDS sub-bands have been set already
+    bool            setDutyCycle(float low, float high, uint16_t perMille);
+
+    /// Removes all the sub-bands set with setDutyCycle()
+    void            clearDutyCycles();
+
+    /// Returns how long until the sub-band of the current frequency may be used again
+    /// \return The time in ms, 0 if it may be used now
+    unsigned long   dutyCycleWait();
+
     /// Sets the length of the preamble
     /// in bytes. 
     /// Caution: this should be set to the same 
@@ -867,6 +935,26 @@ protected:
     /// \return true if the subclasses changes successful
     virtual bool modeWillChange(RHMode) {return true;}
     
+    /// Starts the transmitter with the message loaded in the FIFO, 
+    /// and notes the time for the duty cycle
+    void           startTx();
+
+    /// Called when a transmission has finished, to close the sub-band for its duty cycle off time
+    void           endTx();
+
+#if RH_RF95_TX_QUEUE_LEN
+    /// Starts CAD or the transmission of the next queued message if the radio is free and 
+    /// any backoff or duty cycle off time is over.
+    /// Called from send(), available(), waitPacketSent() and the interrupt handler
+    void           txQueueService();
+
+    /// Loads the next queued message into the FIFO and starts the transmitter
+    void           txQueueStart();
+
+    /// Removes the next queued message from the queue
+    void           txQueuePop();
+#endif
+
     /// False if the PA_BOOST transmitter output pin is to be used.
     /// True if the RFO transmitter output pin is to be used.
     bool                _useRFO;
@@ -914,7 +1002,61 @@ private:
 
     /// device ID
     uint8_t		_deviceVersion = 0x00;
-    
+
+    /// The current centre frequency in kHz
+    uint32_t            _frequencyKHz;
+
+    /// millis() when the current transmission started
+    volatile unsigned long _txStartTime;
+
+    /// A duty cycle limited sub-band
+    typedef struct
+    {
+	uint32_t      lowKHz;    ///< Lowest frequency in kHz
+	uint32_t      highKHz;   ///< Highest frequency in kHz
+	uint16_t      perMille;  ///< Permitted duty cycle in parts per thousand
+	unsigned long offStart;  ///< millis() when the last transmission ended
+	unsigned long offTime;   ///< How long the sub-band is closed after offStart
+    } DutyCycleBand;
+
+    /// The duty cycle limited sub-bands
+    DutyCycleBand       _dutyCycleBands[RH_RF95_DUTY_CYCLE_BANDS];
+
+    /// Number of entries in _dutyCycleBands
+    uint8_t             _numDutyCycleBands;
+
+#if RH_RF95_TX_QUEUE_LEN
+    /// A queued outgoing message, including the 4 headers
+    typedef struct
+    {
+	uint8_t       len;
+	uint8_t       buf[RH_RF95_MAX_PAYLOAD_LEN];
+    } TxQueueEntry;
+
+    /// Queued outgoing messages
+    TxQueueEntry        _txQueue[RH_RF95_TX_QUEUE_LEN];
+
+    /// Index of the next message to send
+    volatile uint8_t    _txQueueHead;
+
+    /// Number of queued messages
+    volatile uint8_t    _txQueueCount;
+
+    /// Number of dropped messages
+    volatile uint16_t   _txDropped;
+
+    /// Number of busy CADs in a row for the next message
+    volatile uint8_t    _txBackoffs;
+
+    /// millis() when the next message became the next to send
+    volatile unsigned long _txHeadSince;
+
+    /// millis() when the current backoff started
+    volatile unsigned long _txBackoffStart;
+
+    /// Length of the current backoff in ms
+    volatile unsigned long _txBackoffTime;
+#endif
 };
 
 /// @example rf95_client.pde
@@ -204,7 +204,7 @@ bool RH_TCP::available()
 {
     if (_socket < 0)
 	return false;
-    if (checkForEvents())
+    if (!checkForEvents())
 	return false;        // Som sort of IO failre
     if (_rxBufFull)
     {
@@ -58,6 +58,20 @@
 /// The simulated sketches send messages out to the 'ether' over the TCP connection to the etherServer.
 /// etherServer manages the delivery of each message to any other RH_TCP sketches that are running.
 ///
+/// \par Benchmarks
+///
+/// tools/simBenchmark.pl measures the goodput, round trip latency and frame overheads of
+/// RHReliableDatagram, RHRouter and RHMesh over chain, grid or fully connected topologies of simulated nodes,
+/// with configurable loss and latency on each link (see the latency: lines in tools/chain.conf).
+/// It runs one examples/simulator/simulator_benchmark process per node:
+/// \code
+/// cd whatever/RadioHead
+/// tools/simBenchmark.pl -n 5 -T chain -m mesh -L 0.1 -c 100
+/// 5 nodes, chain, mesh, loss 0.10, latency 0ms, 10000 bps, 20 octet messages
+///   1 -> 5   sent 100, acked ...
+/// \endcode
+/// tools/simBenchmark.pl -h shows the other options.
+///
 /// \par Prerequisites
 ///
 /// g++ compiler installed and in your $PATH
@@ -190,5 +204,6 @@ private:
 
 /// @example simulator_reliable_datagram_client.pde
 /// @example simulator_reliable_datagram_server.pde
+/// @example simulator_benchmark.pde
 
 #endif
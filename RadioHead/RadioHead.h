@@ -182,6 +182,9 @@ Addressed, unreliable variable length messages, with optional broadcast faciliti
 - RHMesh
   Multi-hop delivery of RHReliableDatagrams with automatic route discovery and rediscovery.
 
+- RHFragmenter
+  Messages larger than the radio can send, fragmented and reassembled over RHReliableDatagram or RHMesh.
+
 Any Manager may be used with any Driver.
 
 \par Platforms
@@ -1927,9 +1930,34 @@ these examples and explanations and extend them to suit your needs.
 // STM32:
 // #define  RH_HW_TIMER TIM21`
 
+// Uncomment this to queue several received messages in drivers that support it
+// (RH_RF95, RH_RF69, RH_RF22, RH_NRF24) instead of dropping messages that arrive
+// before recv() is called. See RHGenericDriver
+// #define RH_RX_QUEUE_LEN 4
+// #define RH_RX_QUEUE_MAX_MESSAGE_LEN 251
+
+// Uncomment this to make RH_RF95::send() queue messages for its listen-before-talk
+// transmit scheduler instead of transmitting at once. See RH_RF95
+// #define RH_RF95_TX_QUEUE_LEN 4
+
+// Uncomment this to enable windowed mode in RHReliableDatagram (sendtoWindow()),
+// on all nodes. See RHReliableDatagram
+// #define RH_RELIABLE_WINDOW_SIZE 8
+
+// Uncomment this to change the size of the RHRouter / RHMesh routing table (up to 255 routes),
+// or to stop RHRouter learning routes from the messages it hears. See RHRouter
+// #define RH_ROUTING_TABLE_SIZE 64
+// #define RH_ROUTER_LEARN_ROUTES 0
+
+// Uncomment this to change the largest message RHFragmenter can send and receive, and the number
+// of messages from different sources it can reassemble at once. See RHFragmenter
+// #define RH_FRAGMENT_MAX_MESSAGE_LEN 1024
+// #define RH_FRAGMENT_NUM_SOURCES 4
+
 // Uncomment this is to enable Encryption (see RHEncryptedDriver):
 // But ensure you have installed the Crypto directory from arduinolibs first:
 // http://rweather.github.io/arduinolibs/index.html
+// On ESP32 and nRF52, RHHardwareAES can be used instead of AES128 for hardware AES
 //#define RH_ENABLE_ENCRYPTION_MODULE
 
 // Some platforms like RocketScream need this to see debug Serial output from within RH
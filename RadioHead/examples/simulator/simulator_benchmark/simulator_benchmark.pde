@@ -0,0 +1,293 @@
+// simulator_benchmark.pde
+// -*- mode: C++ -*-
+// Benchmark node for measuring RHReliableDatagram, RHRouter and RHMesh throughput and latency
+// with the RH_TCP driver on the Linux simulator.
+// One or more nodes send numbered requests to a destination node, which echoes each one back.
+// Senders report goodput and round trip latency percentiles, and every node reports
+// the frames it transmitted, so the overhead of ACKs and route discovery can be totalled.
+// Normally run several at once by tools/simBenchmark.pl, which sets up the topology in
+// tools/etherSimulator.pl and summarises the results.
+// Build with
+// cd whatever/RadioHead
+// tools/simBuild examples/simulator/simulator_benchmark/simulator_benchmark.pde
+// Run with
+// ./simulator_benchmark -a address [-m datagram|router|mesh] [-d destination] [-n count] [-l length]
+//     [-i interval_ms] [-w reply_timeout_ms] [-t seconds] [-r destination:next_hop ...] [-s server:port]
+// -d makes this node a sender. The node exits after sending count requests, after the run time,
+// or on SIGTERM/SIGINT, printing a STATS line, and for senders a RESULT line.
+
+#include <RHMesh.h>
+#include <RH_TCP.h>
+#include <unistd.h>
+#include <signal.h>
+
+// Request and reply payloads start with one of these, then a 4 octet sequence number
+#define BENCH_REQUEST 'Q'
+#define BENCH_REPLY   'R'
+#define BENCH_HEADER_LEN 5
+
+#define BENCH_MAX_SAMPLES 10000
+
+// RH_TCP that counts the frames it sends, by kind
+class BenchDriver : public RH_TCP
+{
+public:
+  BenchDriver(const char* server) : RH_TCP(server), frames(0), acks(0), discovery(0) {}
+
+  bool send(const uint8_t* data, uint8_t len)
+  {
+    frames++;
+    if (_txHeaderFlags & RH_FLAGS_ACK)
+      acks++;
+    // RHRouter header then RHMesh message type
+    else if (   len > sizeof(RHRouter::RoutedMessageHeader)
+	     && (   data[sizeof(RHRouter::RoutedMessageHeader)] == RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_REQUEST
+		 || data[sizeof(RHRouter::RoutedMessageHeader)] == RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_RESPONSE
+		 || data[sizeof(RHRouter::RoutedMessageHeader)] == RH_MESH_MESSAGE_TYPE_ROUTE_FAILURE))
+      discovery++; // Only meaningful in mesh mode
+    return RH_TCP::send(data, len);
+  }
+
+  uint32_t frames;
+  uint32_t acks;
+  uint32_t discovery;
+};
+
+enum { MODE_DATAGRAM, MODE_ROUTER, MODE_MESH } mode = MODE_DATAGRAM;
+uint8_t  thisAddress = 0;
+int      destination = -1;    // -1 if not a sender
+uint32_t count = 100;
+uint8_t  length = 20;
+uint32_t interval = 0;
+uint32_t replyTimeout = 5000;
+uint32_t runTime = 60;
+const char* server = "localhost:4000";
+
+BenchDriver*        driver;
+RHReliableDatagram* datagram;
+RHRouter*           router;   // Also set in mesh mode
+RHMesh*             mesh;
+
+volatile sig_atomic_t stopRequested = 0;
+
+uint32_t sequence = 0;        // Of the next request to send
+uint32_t sent = 0;            // Requests sent
+uint32_t acked = 0;           // Requests acknowledged by the next hop
+uint32_t replies = 0;         // Replies received
+uint32_t samples[BENCH_MAX_SAMPLES]; // Round trip times, ms
+unsigned long startTime;
+unsigned long lastSendTime;
+
+// Dont put these on the stack:
+uint8_t buf[RH_TCP_MAX_MESSAGE_LEN];
+uint8_t request[RH_TCP_MAX_MESSAGE_LEN];
+
+void onSignal(int)
+{
+  stopRequested = 1;
+}
+
+void usage()
+{
+  fprintf(stderr, "usage: %s -a address [-m datagram|router|mesh] [-d destination] [-n count] [-l length] "
+	  "[-i interval_ms] [-w reply_timeout_ms] [-t seconds] [-r destination:next_hop ...] [-s server:port]\n",
+	  _simulator_argv[0]);
+  exit(1);
+}
+
+// Unicasts a message with whichever manager is in use
+bool sendMessage(uint8_t* msg, uint8_t len, uint8_t to)
+{
+  if (mesh)
+    return mesh->sendtoWait(msg, len, to) == RH_ROUTER_ERROR_NONE;
+  if (router)
+    return router->sendtoWait(msg, len, to) == RH_ROUTER_ERROR_NONE;
+  return datagram->sendtoWait(msg, len, to);
+}
+
+// Receives a message for this node with whichever manager is in use, relaying others as needed
+bool receiveMessage(uint8_t* msg, uint8_t* len, uint16_t timeout, uint8_t* from)
+{
+  if (mesh)
+    return mesh->recvfromAckTimeout(msg, len, timeout, from);
+  if (router)
+    return router->recvfromAckTimeout(msg, len, timeout, from);
+  return datagram->recvfromAckTimeout(msg, len, timeout, from);
+}
+
+uint32_t getSequence(const uint8_t* msg)
+{
+  return msg[1] | (msg[2] << 8) | ((uint32_t)msg[3] << 16) | ((uint32_t)msg[4] << 24);
+}
+
+int compareSamples(const void* a, const void* b)
+{
+  uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+  return (x > y) - (x < y);
+}
+
+// Nearest rank percentile of the sorted samples
+uint32_t percentile(uint32_t p)
+{
+  uint32_t n = replies < BENCH_MAX_SAMPLES ? replies : BENCH_MAX_SAMPLES;
+  if (!n)
+    return 0;
+  uint32_t rank = (p * n + 99) / 100;
+  return samples[rank ? rank - 1 : 0];
+}
+
+void finish()
+{
+  printf("STATS address=%d frames=%u acks=%u discovery=%u retransmissions=%u rxgood=%u rxbad=%u\n",
+	 thisAddress, driver->frames, driver->acks, driver->discovery,
+	 datagram->retransmissions(), driver->rxGood(), driver->rxBad());
+  if (destination >= 0)
+  {
+    unsigned long elapsed = millis() - startTime;
+    uint32_t n = replies < BENCH_MAX_SAMPLES ? replies : BENCH_MAX_SAMPLES;
+    qsort(samples, n, sizeof(samples[0]), compareSamples);
+    printf("RESULT address=%d destination=%d sent=%u acked=%u replies=%u elapsed_ms=%lu goodput_bps=%.1f "
+	   "rtt_p50=%u rtt_p90=%u rtt_p99=%u rtt_max=%u\n",
+	   thisAddress, destination, sent, acked, replies, elapsed,
+	   elapsed ? replies * (length - BENCH_HEADER_LEN) * 8 * 1000.0 / elapsed : 0.0,
+	   percentile(50), percentile(90), percentile(99), n ? samples[n - 1] : 0);
+  }
+  fflush(stdout);
+  exit(0);
+}
+
+// Waits for the reply to the request just sent, echoing any requests from other senders meanwhile
+void waitReply(uint32_t seq, unsigned long sentAt)
+{
+  while (!stopRequested && millis() - sentAt < replyTimeout)
+  {
+    uint8_t len = sizeof(buf);
+    uint8_t from;
+    if (!receiveMessage(buf, &len, 100, &from) || len < BENCH_HEADER_LEN)
+      continue;
+    if (buf[0] == BENCH_REQUEST)
+    {
+      buf[0] = BENCH_REPLY;
+      sendMessage(buf, len, from);
+    }
+    else if (buf[0] == BENCH_REPLY && from == destination && getSequence(buf) == seq)
+    {
+      if (replies < BENCH_MAX_SAMPLES)
+	samples[replies] = millis() - sentAt;
+      replies++;
+      return;
+    }
+    // else a late reply to an earlier request
+  }
+}
+
+void setup()
+{
+  int opt;
+  while ((opt = getopt(_simulator_argc, _simulator_argv, "a:m:d:n:l:i:w:t:r:s:")) != -1)
+  {
+    switch (opt)
+    {
+      case 'a': thisAddress = atoi(optarg); break;
+      case 'd': destination = atoi(optarg); break;
+      case 'n': count = atoi(optarg); break;
+      case 'l': length = atoi(optarg); break;
+      case 'i': interval = atoi(optarg); break;
+      case 'w': replyTimeout = atoi(optarg); break;
+      case 't': runTime = atoi(optarg); break;
+      case 's': server = optarg; break;
+      case 'm':
+	if (!strcmp(optarg, "datagram"))
+	  mode = MODE_DATAGRAM;
+	else if (!strcmp(optarg, "router"))
+	  mode = MODE_ROUTER;
+	else if (!strcmp(optarg, "mesh"))
+	  mode = MODE_MESH;
+	else
+	  usage();
+	break;
+      case 'r':
+	break; // Routes are added once the manager exists
+      default:
+	usage();
+    }
+  }
+  if (!thisAddress)
+    usage();
+  if (length < BENCH_HEADER_LEN)
+    length = BENCH_HEADER_LEN;
+  // The routed headers go in the driver payload
+  uint8_t maxLength = RH_TCP_MAX_MESSAGE_LEN;
+  if (mode != MODE_DATAGRAM)
+    maxLength -= sizeof(RHRouter::RoutedMessageHeader);
+  if (mode == MODE_MESH)
+    maxLength -= sizeof(RHMesh::MeshMessageHeader);
+  if (length > maxLength)
+    length = maxLength;
+
+  driver = new BenchDriver(server);
+  if (mode == MODE_MESH)
+    datagram = router = mesh = new RHMesh(*driver, thisAddress);
+  else if (mode == MODE_ROUTER)
+    datagram = router = new RHRouter(*driver, thisAddress);
+  else
+    datagram = new RHReliableDatagram(*driver, thisAddress);
+  // RHRouter::init() is not virtual
+  if (!(router ? router->init() : datagram->init()))
+  {
+    fprintf(stderr, "init failed, is tools/etherSimulator.pl running?\n");
+    exit(1);
+  }
+
+  if (router)
+  {
+    optind = 1;
+    while ((opt = getopt(_simulator_argc, _simulator_argv, "a:m:d:n:l:i:w:t:r:s:")) != -1)
+    {
+      int dest, nextHop;
+      if (opt == 'r' && sscanf(optarg, "%d:%d", &dest, &nextHop) == 2)
+	router->addRouteTo(dest, nextHop);
+    }
+  }
+
+  signal(SIGTERM, onSignal);
+  signal(SIGINT, onSignal);
+  startTime = lastSendTime = millis();
+}
+
+void loop()
+{
+  if (stopRequested || millis() - startTime > runTime * 1000)
+    finish();
+
+  if (destination >= 0 && millis() - lastSendTime >= interval)
+  {
+    if (sent >= count)
+      finish();
+    request[0] = BENCH_REQUEST;
+    request[1] = sequence;
+    request[2] = sequence >> 8;
+    request[3] = sequence >> 16;
+    request[4] = sequence >> 24;
+    for (uint8_t i = BENCH_HEADER_LEN; i < length; i++)
+      request[i] = i;
+    lastSendTime = millis();
+    sent++;
+    if (sendMessage(request, length, destination))
+    {
+      acked++;
+      waitReply(sequence, lastSendTime);
+    }
+    sequence++;
+    return;
+  }
+
+  // Echo requests, and relay for others
+  uint8_t len = sizeof(buf);
+  uint8_t from;
+  if (receiveMessage(buf, &len, 100, &from) && len >= BENCH_HEADER_LEN && buf[0] == BENCH_REQUEST)
+  {
+    buf[0] = BENCH_REPLY;
+    sendMessage(buf, len, from);
+  }
+}
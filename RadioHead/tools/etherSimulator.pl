@@ -17,10 +17,14 @@ $port = $main::opt_p
 my $bps = 10000;
 $bps = $main::opt_b
     if $main::opt_b;
+# Probability of delivery between nodes not in the config file
+my $defaultProbability = 1.0;
 
 # Config that shows probability of successful transmission between nodes
 # Read from config file
 my %netconfig;
+# Config that shows the extra delay in milliseconds between nodes, on top of the transmission time
+my %netlatency;
 
 use warnings;
 use POE qw(Component::Server::TCP Filter::Block);
@@ -31,6 +35,7 @@ my @options =
      'h'     => \$help,                # Help, show usage
      'c=s'   => \$config,              # Config file
      'b=n'   => \$bps,                 # Bits per second simulated baud rate
+     'd=f'   => \$defaultProbability,  # Probability of delivery between nodes not in the config file
      'p=n'   => \$port,                # port number
     );
 
@@ -41,7 +46,7 @@ readConfig($config) if defined $config;
 
 sub usage
 {
-    print "usage: $0 [-h] [-c configfile] [-b bitspersec] [-p portnumber]\n";
+    print "usage: $0 [-h] [-c configfile] [-b bitspersec] [-d defaultprobability] [-p portnumber]\n";
     exit;
 }
 
@@ -53,6 +58,9 @@ sub usage
 # In this example, the probability of successful transmission
 # between nodes 10 and 2 (and vice versa) is given as 0.5 (ie 50% chance)
 # probability:10:2:0.5
+# Optionally specify an extra delay in milliseconds before a message from nodea reaches nodeb
+# (bidirectional), on top of the transmission time at the simulated baud rate
+# latency:nodea:nodeb:milliseconds
 sub readConfig
 {
     my ($config) = @_;
@@ -66,6 +74,11 @@ sub readConfig
 		$netconfig{$1}{$2} = $3;
 		$netconfig{$2}{$1} = $3; # Bidirectional
 	    }
+	    elsif (/^latency:(\d{1,3}):(\d{1,3}):(\d+(\.\d+)?)/)
+	    {
+		$netlatency{$1}{$2} = $3;
+		$netlatency{$2}{$1} = $3; # Bidirectional
+	    }
 	}
 	close(CONFIG);
     }
@@ -113,8 +126,18 @@ sub probabilityOfSuccessfulDelivery
 
     return $netconfig{$from}{$to}
         if exists $netconfig{$from}{$to};
-    # If no explicit probability, use 1.0 (certainty)
-    return 1.0;
+    # If no explicit probability, use the default (normally 1.0, certainty)
+    return $defaultProbability;
+}
+
+# Look up the source and dest nodes in the netconfig and return the extra delivery delay in seconds
+sub latencyFromTo
+{
+    my ($from, $to) = @_;
+
+    return $netlatency{$from}{$to} / 1000.0
+        if exists $netlatency{$from}{$to};
+    return 0;
 }
 
 # Return true if the message is simulted to have been received successfully
@@ -140,7 +163,7 @@ sub deliverMessages
 	# We are waiting here for the transmission time of the message to elapse
 	# given the message length and the bits per second
 	my $elapsed = Time::HiRes::tv_interval([$$value{'packetreceived'}], [Time::HiRes::gettimeofday]);
-	if ($elapsed > length($$value{'packet'}) * 8 / $bps)
+	if ($elapsed > length($$value{'packet'}) * 8 / $bps + $$value{'latency'})
 	{
 	    $$value{'client'}->put(pack('Ca*', $RH_TCP_MESSAGE_TYPE_PACKET, $$value{'packet'}));
 	    delete $$value{'packet'}; # Delivered, forget it
@@ -208,6 +231,7 @@ POE::Component::Server::TCP->new(
 		    # nominal transmission time is complete
 		    $$value{'packet'} = $packet;
 		    $$value{'packetreceived'} = Time::HiRes::gettimeofday();
+		    $$value{'latency'} = latencyFromTo($clients{$client}{'thisaddress'}, $$value{thisaddress});
 		}
 	    }
 	}
@@ -0,0 +1,233 @@
+#!/usr/bin/perl
+#
+# simBenchmark.pl
+# Measures RHReliableDatagram, RHRouter and RHMesh throughput and latency on the Linux simulator.
+# Builds examples/simulator/simulator_benchmark, creates an N node topology with the given
+# loss and latency in etherSimulator.pl, runs a simulator_benchmark process for each node,
+# and summarises the goodput, round trip latency percentiles and frame overheads they report.
+#
+# Run from the RadioHead directory:
+# tools/simBenchmark.pl [-n nodes] [-T chain|grid|full] [-m datagram|router|mesh] [-s source:destination ...]
+#     [-L loss] [-D latency_ms] [-c count] [-l length] [-i interval_ms] [-w reply_timeout_ms]
+#     [-b bitspersec] [-t seconds] [-p portnumber] [-e] [-v]
+# eg, 100 echoed messages along a 5 node chain with 10% loss on each link, using RHMesh:
+# tools/simBenchmark.pl -n 5 -T chain -m mesh -L 0.1
+#
+# Nodes are numbered 1 to nodes. By default node 1 sends to the last node.
+# In a chain, node i can only hear nodes i-1 and i+1. In a grid, nodes are laid out in rows
+# of ceil(sqrt(nodes)) and can hear their horizontal and vertical neighbours.
+# In router mode, each node is given static routes along the shortest paths.
+# Requires the POE perl module, like etherSimulator.pl, unless -e is used with an
+# etherSimulator.pl that is already running.
+
+use Getopt::Long;
+use File::Temp qw(tempdir);
+use POSIX qw(ceil :sys_wait_h);
+use strict;
+use warnings;
+
+my $help;
+my $nodes = 5;
+my $topology = 'chain';
+my $mode = 'mesh';
+my @senders;
+my $loss = 0.0;
+my $latency = 0;
+my $count = 100;
+my $length = 20;
+my $interval = 0;
+my $replyTimeout = 5000;
+my $bps = 10000;
+my $seconds = 300;
+my $port = 4000;
+my $externalEther;
+my $verbose;
+
+my @options =
+    (
+     'h'     => \$help,                # Help, show usage
+     'n=i'   => \$nodes,               # Number of nodes
+     'T=s'   => \$topology,            # chain, grid or full
+     'm=s'   => \$mode,                # datagram, router or mesh
+     's=s'   => \@senders,             # source:destination, may be repeated
+     'L=f'   => \$loss,                # Probability of losing a message on each link
+     'D=f'   => \$latency,             # Extra delay on each link in milliseconds
+     'c=i'   => \$count,               # Messages sent by each source
+     'l=i'   => \$length,              # Message length in octets
+     'i=i'   => \$interval,            # Minimum interval between messages in milliseconds
+     'w=i'   => \$replyTimeout,        # How long a source waits for each reply in milliseconds
+     'b=i'   => \$bps,                 # Bits per second simulated baud rate
+     't=i'   => \$seconds,             # Maximum run time
+     'p=i'   => \$port,                # etherSimulator.pl port number
+     'e'     => \$externalEther,       # Use an etherSimulator.pl that is already running
+     'v'     => \$verbose,             # Show the output of each node
+    );
+
+&GetOptions(@options) || &usage;
+&usage if $help;
+&usage unless $nodes >= 2 && $nodes <= 254 && $mode =~ /^(datagram|router|mesh)$/;
+@senders = ("1:$nodes") unless @senders;
+
+sub usage
+{
+    print "usage: $0 [-h] [-n nodes] [-T chain|grid|full] [-m datagram|router|mesh] [-s source:destination ...]\n"
+	. "    [-L loss] [-D latency_ms] [-c count] [-l length] [-i interval_ms] [-w reply_timeout_ms]\n"
+	. "    [-b bitspersec] [-t seconds] [-p portnumber] [-e] [-v]\n";
+    exit;
+}
+
+# Returns true if nodes a and b can hear each other
+sub adjacent
+{
+    my ($a, $b) = @_;
+
+    return 1 if $topology eq 'full';
+    return abs($a - $b) == 1 if $topology eq 'chain';
+    if ($topology eq 'grid')
+    {
+	my $width = ceil(sqrt($nodes));
+	my ($ra, $ca) = (int(($a - 1) / $width), ($a - 1) % $width);
+	my ($rb, $cb) = (int(($b - 1) / $width), ($b - 1) % $width);
+	return abs($ra - $rb) + abs($ca - $cb) == 1;
+    }
+    die "Unknown topology $topology\n";
+}
+
+# Returns the next hop from each node to dest along a shortest path, by breadth first search from dest
+sub nextHopsTo
+{
+    my ($dest) = @_;
+    my %nextHop = ($dest => $dest);
+    my @queue = ($dest);
+    while (@queue)
+    {
+	my $node = shift @queue;
+	foreach my $neighbour (1 .. $nodes)
+	{
+	    next if exists $nextHop{$neighbour} || !adjacent($node, $neighbour);
+	    $nextHop{$neighbour} = $node;
+	    push(@queue, $neighbour);
+	}
+    }
+    return \%nextHop;
+}
+
+system('bash', 'tools/simBuild', 'examples/simulator/simulator_benchmark/simulator_benchmark.pde') == 0
+    or die "Could not build simulator_benchmark, run from the RadioHead directory\n";
+
+my $dir = tempdir(CLEANUP => 1);
+my $etherPid;
+unless ($externalEther)
+{
+    # Links that are not listed can never deliver
+    open(CONFIG, ">$dir/benchmark.conf") or die "Could not create config file: $!\n";
+    foreach my $a (1 .. $nodes)
+    {
+	foreach my $b ($a + 1 .. $nodes)
+	{
+	    next unless adjacent($a, $b);
+	    print CONFIG "probability:$a:$b:" . (1.0 - $loss) . "\n";
+	    print CONFIG "latency:$a:$b:$latency\n" if $latency;
+	}
+    }
+    close(CONFIG);
+    $etherPid = start("$dir/ether.out", 'perl', 'tools/etherSimulator.pl', '-c', "$dir/benchmark.conf",
+		      '-b', $bps, '-d', 0, '-p', $port);
+    sleep(2); # Let it start listening
+}
+
+my %routes;
+if ($mode eq 'router')
+{
+    foreach my $dest (1 .. $nodes)
+    {
+	my $nextHop = nextHopsTo($dest);
+	foreach my $node (keys %$nextHop)
+	{
+	    push(@{$routes{$node}}, '-r', "$dest:$$nextHop{$node}") unless $node == $dest;
+	}
+    }
+}
+
+my %destinationOf;
+foreach (@senders)
+{
+    /^(\d+):(\d+)$/ or &usage;
+    $destinationOf{$1} = $2;
+}
+
+# Start the nodes that only echo and relay first, so they are listening when the sources start
+my (%pids, @sourcePids);
+foreach my $node (grep { !exists $destinationOf{$_} } 1 .. $nodes)
+{
+    $pids{startNode($node)} = $node;
+}
+sleep(1);
+foreach my $node (keys %destinationOf)
+{
+    my $pid = startNode($node, '-d', $destinationOf{$node}, '-n', $count, '-l', $length,
+			'-i', $interval, '-w', $replyTimeout);
+    $pids{$pid} = $node;
+    push(@sourcePids, $pid);
+}
+
+# Wait for the sources to finish, then stop the others
+waitpid($_, 0) foreach @sourcePids;
+kill('TERM', grep { waitpid($_, WNOHANG) == 0 } keys %pids);
+waitpid($_, 0) foreach keys %pids;
+kill('TERM', $etherPid) if $etherPid;
+
+# Summarise
+my (%total, $replies);
+printf("%d nodes, %s, %s, loss %.2f, latency %gms, %d bps, %d octet messages\n",
+       $nodes, $topology, $mode, $loss, $latency, $bps, $length);
+foreach my $node (1 .. $nodes)
+{
+    open(OUT, "$dir/node$node.out") or next;
+    while (<OUT>)
+    {
+	print "node $node: $_" if $verbose;
+	if (/^RESULT (.*)/)
+	{
+	    my %r = map { split /=/ } split(' ', $1);
+	    printf("%3d -> %-3d sent %d, acked %d, replies %d in %.1fs, goodput %.1f bps, rtt ms p50 %d p90 %d p99 %d max %d\n",
+		   $r{address}, $r{destination}, $r{sent}, $r{acked}, $r{replies}, $r{elapsed_ms} / 1000,
+		   $r{goodput_bps}, $r{rtt_p50}, $r{rtt_p90}, $r{rtt_p99}, $r{rtt_max});
+	    $replies += $r{replies};
+	}
+	elsif (/^STATS (.*)/)
+	{
+	    my %s = map { split /=/ } split(' ', $1);
+	    $total{$_} += $s{$_} foreach qw(frames acks discovery retransmissions);
+	}
+    }
+    close(OUT);
+}
+printf("frames %d: acks %d, route discovery %d, retransmissions %d",
+       $total{frames} || 0, $total{acks} || 0, $total{discovery} || 0, $total{retransmissions} || 0);
+printf(", %.1f frames per round trip", $total{frames} / $replies) if $replies;
+print "\n";
+exit;
+
+# Starts simulator_benchmark for a node and returns its pid
+sub startNode
+{
+    my ($node, @args) = @_;
+
+    push(@args, @{$routes{$node}}) if $routes{$node};
+    return start("$dir/node$node.out", './simulator_benchmark', '-a', $node, '-m', $mode,
+		 '-t', $seconds, '-s', "localhost:$port", @args);
+}
+
+# Starts a process with its output in a file and returns its pid
+sub start
+{
+    my ($output, @command) = @_;
+
+    my $pid = fork();
+    die "Could not fork: $!\n" unless defined $pid;
+    return $pid if $pid;
+    open(STDOUT, ">$output") or die "Could not create $output: $!\n";
+    open(STDERR, '>&STDOUT');
+    exec(@command) or die "Could not run $command[0]: $!\n";
+}
@@ -145,6 +145,15 @@ uint32_t File::size() {
   return _file->fileSize();
 }
 
+// Reserve contiguous space for a new, empty file, so appending up to size
+// bytes never has to update the FAT
+bool File::preallocate(uint32_t size) {
+  if (! _file) {
+    return false;
+  }
+  return _file->preAllocate(size);
+}
+
 void File::close() {
   if (_file) {
     _file->close();
@@ -118,6 +118,119 @@ namespace SDLib {
   }
 
 
+  /*
+
+    Directory entry cache.
+
+    Opening a path scans each directory on the way for the name of the
+    next component, so opening the same files again and again (e.g. a web
+    server) spends most of its time reading directory blocks.
+
+    The cache remembers where in its parent directory a name was last found,
+    keyed by the first cluster of the parent and a hash of the name. A hit
+    opens the entry at that index directly, and the name found there is
+    checked, so a stale or colliding entry only costs one directory block
+    read before falling back to the scan. The cache is cleared when
+    directories change, by `remove`, `rmdir` and `mkdir`.
+
+  */
+
+#ifndef SD_DIR_CACHE_SIZE
+#if defined(RAMEND) && RAMEND < 0x1000
+#define SD_DIR_CACHE_SIZE 4
+#else
+#define SD_DIR_CACHE_SIZE 16
+#endif
+#endif
+
+#if SD_DIR_CACHE_SIZE
+  struct DirCacheEntry {
+    uint32_t dirCluster; // first cluster of the parent directory, 0 for a FAT16 root
+    uint16_t nameHash;   // 0 if the entry is unused
+    uint16_t index;      // index of the directory entry in the parent
+  };
+
+  static DirCacheEntry dirCache[SD_DIR_CACHE_SIZE];
+  static uint8_t dirCacheNext; // next entry to replace
+
+  static void dirCacheClear() {
+    memset(dirCache, 0, sizeof(dirCache));
+    dirCacheNext = 0;
+  }
+
+  static uint16_t dirCacheHash(const char *name) {
+    // FAT short names are not case sensitive
+    uint16_t hash = 0x811C;
+    while (*name) {
+      hash = (hash ^ (uint8_t)toupper(*name++)) * 0x0101;
+    }
+    return hash ? hash : 1;
+  }
+#else
+  static void dirCacheClear() {
+  }
+#endif
+
+  bool openDirEntry(SdFile& parentDir, SdFile& file, const char *name,
+                    uint8_t mode) {
+    /*
+
+      Open `name` in `parentDir` with `mode`, like `SdFile::open`, using
+      the directory entry cache to avoid scanning the directory.
+
+    */
+#if SD_DIR_CACHE_SIZE
+    // an exclusive create has to scan to find out the name is not used
+    if ((mode & (O_CREAT | O_EXCL)) == (O_CREAT | O_EXCL)) {
+      return file.open(parentDir, name, mode);
+    }
+
+    uint32_t dirCluster = parentDir.firstCluster();
+    uint16_t hash = dirCacheHash(name);
+    DirCacheEntry *entry = NULL;
+
+    for (uint8_t i = 0; i < SD_DIR_CACHE_SIZE; i++) {
+      if (dirCache[i].nameHash == hash && dirCache[i].dirCluster == dirCluster) {
+        entry = &dirCache[i];
+        break;
+      }
+    }
+
+    if (entry) {
+      // check the name before opening, as the mode may truncate the file
+      uint32_t position = 32UL * entry->index;
+      dir_t d;
+      if (parentDir.seekSet(position) && parentDir.readDir(&d) > 0 &&
+          parentDir.curPosition() == position + 32) {
+        char found[13];
+        SdFile::dirName(d, found);
+        if (!strcasecmp(found, name)) {
+          return file.open(parentDir, entry->index, mode);
+        }
+      }
+      // not the same file any more
+      entry->nameHash = 0;
+    }
+
+    // find an existing file first, so the scan stops just after its entry
+    if (!file.open(parentDir, name, mode & ~O_CREAT)) {
+      return (mode & O_CREAT) && file.open(parentDir, name, mode);
+    }
+
+    if (!entry) {
+      entry = &dirCache[dirCacheNext];
+      dirCacheNext = (dirCacheNext + 1) % SD_DIR_CACHE_SIZE;
+    }
+    entry->dirCluster = dirCluster;
+    entry->nameHash = hash;
+    entry->index = parentDir.curPosition() / 32 - 1;
+    return true;
+#else
+    return file.open(parentDir, name, mode);
+#endif
+  }
+
+
 
   bool walkPath(const char *filepath, SdFile& parentDir,
                 bool(*callback)(SdFile& parentDir,
@@ -190,7 +303,7 @@ namespace SDLib {
         break;
       }
 
-      bool exists = (*p_child).open(*p_parent, buffer, O_RDONLY);
+      bool exists = openDirEntry(*p_parent, *p_child, buffer, O_RDONLY);
 
       // If it's one we've created then we
       // don't need the parent handle anymore.
@@ -246,7 +359,7 @@ namespace SDLib {
     */
     SdFile child;
 
-    bool exists = child.open(parentDir, filePathComponent, O_RDONLY);
+    bool exists = openDirEntry(parentDir, child, filePathComponent, O_RDONLY);
 
     if (exists) {
       child.close();
@@ -272,6 +385,7 @@ namespace SDLib {
 
     result = callback_pathExists(parentDir, filePathComponent, isLastComponent, object);
     if (!result) {
+      dirCacheClear();
       result = child.makeDir(parentDir, filePathComponent);
     }
 
@@ -315,6 +429,7 @@ namespace SDLib {
   bool callback_remove(SdFile& parentDir, const char *filePathComponent,
                        bool isLastComponent, void * /* object */) {
     if (isLastComponent) {
+      dirCacheClear();
       return SdFile::remove(parentDir, filePathComponent);
     }
     return true;
@@ -327,6 +442,7 @@ namespace SDLib {
       if (!f.open(parentDir, filePathComponent, O_READ)) {
         return false;
       }
+      dirCacheClear();
       return f.rmDir();
     }
     return true;
@@ -342,6 +458,7 @@ namespace SDLib {
     if (root.isOpen()) {
       root.close();
     }
+    dirCacheClear();
 
     /*
 
@@ -359,6 +476,7 @@ namespace SDLib {
     if (root.isOpen()) {
       root.close();
     }
+    dirCacheClear();
 
     return card.init(SPI_HALF_SPEED, csPin) &&
            card.setSpiClock(clock) &&
@@ -369,6 +487,7 @@ namespace SDLib {
   //call this when a card is removed. It will allow you to insert and initialise a new card.
   void SDClass::end() {
     root.close();
+    dirCacheClear();
   }
 
   // this little helper is used to traverse paths
@@ -409,7 +528,7 @@ namespace SDLib {
 
       // close the subdir (we reuse them) if open
       subdir->close();
-      if (! subdir->open(parent, subdirname, O_READ)) {
+      if (! openDirEntry(*parent, *subdir, subdirname, O_READ)) {
         // failed to open one of the subdirectories
         return SdFile();
       }
@@ -476,7 +595,7 @@ namespace SDLib {
       return File();
     }
 
-    if (! file.open(parentdir, filepath, mode)) {
+    if (! openDirEntry(parentdir, file, filepath, mode)) {
       return File();
     }
     // close the parent
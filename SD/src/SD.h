@@ -44,6 +44,7 @@ namespace SDLib {
       bool seek(uint32_t pos);
       uint32_t position();
       uint32_t size();
+      bool preallocate(uint32_t size);
       void close();
       operator bool();
       char * name();
@@ -138,6 +138,11 @@ uint8_t Sd2Card::cardCommand(uint8_t cmd, uint32_t arg) {
   }
   spiSend(crc);
 
+  // skip stuff byte for stop read
+  if (cmd == CMD12) {
+    spiRec();
+  }
+
   // wait for response
   for (uint8_t i = 0; ((status_ = spiRec()) & 0X80) && i != 0XFF; i++)
     ;
@@ -471,6 +476,78 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
+/** Read one data block in a multiple block read sequence
+
+   \param[out] dst Pointer to the location for the 512 byte block.
+
+   \return The value one, true, is returned for success and
+   the value zero, false, is returned for failure.
+*/
+uint8_t Sd2Card::readData(uint8_t* dst) {
+  if (!waitStartBlock()) {
+    return false;
+  }
+  #ifdef OPTIMIZE_HARDWARE_SPI
+  // start first spi transfer
+  SPDR = 0XFF;
+  for (uint16_t i = 0; i < 511; i++) {
+    while (!(SPSR & (1 << SPIF)))
+      ;
+    dst[i] = SPDR;
+    SPDR = 0XFF;
+  }
+  // wait for last byte
+  while (!(SPSR & (1 << SPIF)))
+    ;
+  dst[511] = SPDR;
+  #else  // OPTIMIZE_HARDWARE_SPI
+  for (uint16_t i = 0; i < 512; i++) {
+    dst[i] = spiRec();
+  }
+  #endif  // OPTIMIZE_HARDWARE_SPI
+  spiRec();  // get first crc byte
+  spiRec();  // get second crc byte
+  return true;
+}
+//------------------------------------------------------------------------------
+/** Start a read multiple blocks sequence.
+
+   \param[in] blockNumber Address of first block in sequence.
+
+   \note This function is used with readData() and readStop()
+   for optimized multiple block reads.
+
+   \return The value one, true, is returned for success and
+   the value zero, false, is returned for failure.
+*/
+uint8_t Sd2Card::readStart(uint32_t blockNumber) {
+  // use address if not SDHC card
+  if (type() != SD_CARD_TYPE_SDHC) {
+    blockNumber <<= 9;
+  }
+  if (cardCommand(CMD18, blockNumber)) {
+    error(SD_CARD_ERROR_CMD18);
+    chipSelectHigh();
+    return false;
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+/** End a read multiple blocks sequence.
+
+  \return The value one, true, is returned for success and
+   the value zero, false, is returned for failure.
+*/
+uint8_t Sd2Card::readStop(void) {
+  if (cardCommand(CMD12, 0)) {
+    error(SD_CARD_ERROR_CMD12);
+    chipSelectHigh();
+    return false;
+  }
+  chipSelectHigh();
+  return true;
+}
+//------------------------------------------------------------------------------
 /** Skip remaining data in a block when in partial block read mode. */
 void Sd2Card::readEnd(void) {
   if (inBlock_) {
@@ -160,6 +160,10 @@ uint8_t const SD_CARD_ERROR_WRITE_PROGRAMMING = 0X14;
 uint8_t const SD_CARD_ERROR_WRITE_TIMEOUT = 0X15;
 /** incorrect rate selected */
 uint8_t const SD_CARD_ERROR_SCK_RATE = 0X16;
+/** card returned an error response for CMD18 (read multiple blocks) */
+uint8_t const SD_CARD_ERROR_CMD18 = 0X17;
+/** card returned an error response for CMD12 (stop multiple block read) */
+uint8_t const SD_CARD_ERROR_CMD12 = 0X18;
 //------------------------------------------------------------------------------
 // card types
 /** Standard capacity V1 SD card */
@@ -227,6 +231,9 @@ class Sd2Card {
     uint8_t readCSD(csd_t* csd) {
       return readRegister(CMD9, csd);
     }
+    uint8_t readData(uint8_t* dst);
+    uint8_t readStart(uint32_t blockNumber);
+    uint8_t readStop(void);
     void readEnd(void);
     uint8_t setSckRate(uint8_t sckRateID);
     #ifdef USE_SPI_LIB
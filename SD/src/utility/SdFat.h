@@ -35,6 +35,19 @@
 */
 #define ALLOW_DEPRECATED_FUNCTIONS 1
 //------------------------------------------------------------------------------
+/**
+   SD_FAT_CACHE: if non-zero, FAT blocks are kept in a second 512 byte cache
+   so following and extending cluster chains does not evict the data block
+   in the main cache. Off by default on AVRs with 2.5 KB of RAM or less.
+*/
+#ifndef SD_FAT_CACHE
+  #if defined(RAMEND) && RAMEND < 0X1000
+    #define SD_FAT_CACHE 0
+  #else
+    #define SD_FAT_CACHE 1
+  #endif
+#endif
+//------------------------------------------------------------------------------
 // forward declaration since SdVolume is used in SdFile
 class SdVolume;
 //==============================================================================
@@ -169,6 +182,7 @@ class SdFile : public Print {
     uint8_t contiguousRange(uint32_t* bgnBlock, uint32_t* endBlock);
     uint8_t createContiguous(SdFile* dirFile,
                              const char* fileName, uint32_t size);
+    uint8_t preAllocate(uint32_t length);
     /** \return The current cluster number for a file or directory. */
     uint32_t curCluster(void) const {
       return curCluster_;
@@ -444,6 +458,7 @@ class SdFile : public Print {
     uint8_t   dirIndex_;      // index of entry in dirBlock 0 <= dirIndex_ <= 0XF
     uint32_t  fileSize_;      // file size in bytes
     uint32_t  firstCluster_;  // first cluster of file
+    uint32_t  contiguousEnd_; // last cluster of a contiguous chain, zero if unknown
     SdVolume* vol_;           // volume where file is located
 
     // private functions
@@ -581,6 +596,12 @@ class SdVolume {
     static Sd2Card* sdCard_;            // Sd2Card object for cache
     static uint8_t cacheDirty_;         // cacheFlush() will write block if true
     static uint32_t cacheMirrorBlock_;  // block number for mirror FAT
+    #if SD_FAT_CACHE
+    static cache_t fatCacheBuffer_;        // 512 byte cache for FAT blocks
+    static uint32_t fatCacheBlockNumber_;  // Logical number of FAT block in the cache
+    static uint8_t fatCacheDirty_;         // fatCacheFlush() will write block if true
+    static uint32_t fatCacheMirrorBlock_;  // block number for mirror FAT
+    #endif  // SD_FAT_CACHE
     //
     uint32_t allocSearchStart_;   // start cluster for alloc search
     uint8_t blocksPerCluster_;    // cluster size in blocks
@@ -611,6 +632,10 @@ class SdVolume {
       cacheDirty_ |= CACHE_FOR_WRITE;
     }
     static uint8_t cacheZeroBlock(uint32_t blockNumber);
+    #if SD_FAT_CACHE
+    static uint8_t fatCacheFlush(uint8_t blocking = 1);
+    static uint8_t fatCacheRead(uint32_t blockNumber);
+    #endif  // SD_FAT_CACHE
     uint8_t chainSize(uint32_t beginCluster, uint32_t* size) const;
     uint8_t fatGet(uint32_t cluster, uint32_t* value) const;
     uint8_t fatPut(uint32_t cluster, uint32_t value);
@@ -624,6 +649,7 @@ class SdVolume {
     uint8_t readBlock(uint32_t block, uint8_t* dst) {
       return sdCard_->readBlock(block, dst);
     }
+    uint8_t readBlocks(uint32_t block, uint8_t count, uint8_t* dst);
     uint8_t readData(uint32_t block, uint16_t offset,
                      uint16_t count, uint8_t* dst) {
       return sdCard_->readData(block, offset, count, dst);
@@ -631,10 +657,16 @@ class SdVolume {
     uint8_t writeBlock(uint32_t block, const uint8_t* dst, uint8_t blocking = 1) {
       return sdCard_->writeBlock(block, dst, blocking);
     }
+    uint8_t writeBlocks(uint32_t block, uint8_t count, const uint8_t* src);
     uint8_t isBusy(void) {
       return sdCard_->isBusy();
     }
     uint8_t isCacheMirrorBlockDirty(void) {
+      #if SD_FAT_CACHE
+      if (fatCacheDirty_ || fatCacheMirrorBlock_) {
+        return true;
+      }
+      #endif  // SD_FAT_CACHE
       return (cacheMirrorBlock_ != 0);
     }
 };
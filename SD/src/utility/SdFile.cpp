@@ -36,6 +36,8 @@ uint8_t SdFile::addCluster() {
   if (!vol_->allocContiguous(1, &curCluster_)) {
     return false;
   }
+  // the new cluster may not follow the contiguous chain
+  contiguousEnd_ = 0;
 
   // if first cluster of file link to directory entry
   if (firstCluster_ == 0) {
@@ -119,6 +121,7 @@ uint8_t SdFile::contiguousRange(uint32_t* bgnBlock, uint32_t* endBlock) {
       if (!vol_->isEOC(next)) {
         return false;
       }
+      contiguousEnd_ = c;
       *bgnBlock = vol_->clusterStartBlock(firstCluster_);
       *endBlock = vol_->clusterStartBlock(c)
                   + vol_->blocksPerCluster_ - 1;
@@ -163,6 +166,7 @@ uint8_t SdFile::createContiguous(SdFile* dirFile,
     remove();
     return false;
   }
+  contiguousEnd_ = firstCluster_ + count - 1;
   fileSize_ = size;
 
   // insure sync() will update dir entry
@@ -170,6 +174,42 @@ uint8_t SdFile::createContiguous(SdFile* dirFile,
   return sync();
 }
 //------------------------------------------------------------------------------
+/**
+   Allocate contiguous clusters to an empty file, for a data logger.
+
+   The file size stays zero, so the file is written as usual, but writes
+   within \a length never access the FAT, so there is no extra latency
+   when they cross a cluster boundary. Clusters that are not used stay
+   allocated to the file until it is truncated or removed.
+
+   \param[in] length The number of bytes to allocate.
+
+   \return The value one, true, is returned for success and
+   the value zero, false, is returned for failure.
+   Reasons for failure include the file is not open for write, the file
+   already has clusters, \a length is zero, there is not enough
+   contiguous free space or an I/O error.
+*/
+uint8_t SdFile::preAllocate(uint32_t length) {
+  // only an empty file that is open for write
+  if (!isFile() || !(flags_ & O_WRITE) || firstCluster_ != 0 || length == 0) {
+    return false;
+  }
+
+  // calculate number of clusters needed
+  uint32_t count = ((length - 1) >> (vol_->clusterSizeShift_ + 9)) + 1;
+
+  // allocate clusters
+  if (!vol_->allocContiguous(count, &firstCluster_)) {
+    return false;
+  }
+  contiguousEnd_ = firstCluster_ + count - 1;
+
+  // insure sync() will update dir entry
+  flags_ |= F_FILE_DIR_DIRTY;
+  return sync();
+}
+//------------------------------------------------------------------------------
 /**
    Return a files directory entry
 
@@ -632,6 +672,7 @@ uint8_t SdFile::openCachedEntry(uint8_t dirIndex, uint8_t oflag) {
   // set to start of file
   curCluster_ = 0;
   curPosition_ = 0;
+  contiguousEnd_ = 0;
 
   // truncate file to zero length if requested
   if (oflag & O_TRUNC) {
@@ -677,6 +718,7 @@ uint8_t SdFile::openRoot(SdVolume* vol) {
   // set to start of file
   curCluster_ = 0;
   curPosition_ = 0;
+  contiguousEnd_ = 0;
 
   // root has no directory entry
   dirBlock_ = 0;
@@ -793,6 +835,9 @@ int16_t SdFile::read(void* buf, uint16_t nbyte) {
         if (curPosition_ == 0) {
           // use first cluster in file
           curCluster_ = firstCluster_;
+        } else if (curCluster_ < contiguousEnd_) {
+          // next cluster of a contiguous chain
+          curCluster_++;
         } else {
           // get next cluster from FAT
           if (!vol_->fatGet(curCluster_, &curCluster_)) {
@@ -809,9 +854,25 @@ int16_t SdFile::read(void* buf, uint16_t nbyte) {
       n = 512 - offset;
     }
 
-    // no buffering needed if n == 512 or user requests no buffering
-    if ((unbufferedRead() || n == 512) &&
-        block != SdVolume::cacheBlockNumber_) {
+    // number of whole blocks left in the cluster that can be read at once
+    uint8_t nb = 0;
+    if (offset == 0 && type_ != FAT_FILE_TYPE_ROOT16) {
+      nb = vol_->blocksPerCluster() - vol_->blockOfCluster(curPosition_);
+      if (nb > (toRead >> 9)) {
+        nb = toRead >> 9;
+      }
+    }
+
+    if (nb > 1) {
+      // read contiguous blocks with a multiple block read, bypassing the cache
+      if (!vol_->readBlocks(block, nb, dst)) {
+        return -1;
+      }
+      n = 512 * nb;
+      dst += n;
+    } else if ((unbufferedRead() || n == 512) &&
+               block != SdVolume::cacheBlockNumber_) {
+      // no buffering needed if n == 512 or user requests no buffering
       if (!vol_->readData(block, offset, n, dst)) {
         return -1;
       }
@@ -1102,6 +1163,12 @@ uint8_t SdFile::seekSet(uint32_t pos) {
   uint32_t nCur = (curPosition_ - 1) >> (vol_->clusterSizeShift_ + 9);
   uint32_t nNew = (pos - 1) >> (vol_->clusterSizeShift_ + 9);
 
+  if (contiguousEnd_) {
+    // the whole file is in the contiguous chain
+    curCluster_ = firstCluster_ + nNew;
+    curPosition_ = pos;
+    return true;
+  }
   if (nNew < nCur || curPosition_ == 0) {
     // must follow chain from first cluster
     curCluster_ = firstCluster_;
@@ -1261,8 +1328,8 @@ uint8_t SdFile::truncate(uint32_t length) {
     return false;
   }
 
-  // fileSize and length are zero - nothing to do
-  if (fileSize_ == 0) {
+  // fileSize and length are zero and no clusters are preallocated - nothing to do
+  if (fileSize_ == 0 && firstCluster_ == 0) {
     return true;
   }
 
@@ -1298,6 +1365,12 @@ uint8_t SdFile::truncate(uint32_t length) {
       }
     }
   }
+  // what is left of a contiguous chain is still contiguous
+  if (length == 0) {
+    contiguousEnd_ = 0;
+  } else if (contiguousEnd_) {
+    contiguousEnd_ = curCluster_;
+  }
   fileSize_ = length;
 
   // need to update directory entry
@@ -1362,6 +1435,9 @@ size_t SdFile::write(const void* buf, uint16_t nbyte) {
         } else {
           curCluster_ = firstCluster_;
         }
+      } else if (curCluster_ < contiguousEnd_) {
+        // next cluster of a contiguous chain, no FAT access needed
+        curCluster_++;
       } else {
         uint32_t next;
         if (!vol_->fatGet(curCluster_, &next)) {
@@ -1385,9 +1461,25 @@ size_t SdFile::write(const void* buf, uint16_t nbyte) {
       n = nToWrite;
     }
 
+    // number of whole blocks left in the cluster that can be written at once
+    uint8_t nb = 0;
+    if (blockOffset == 0 && blocking) {
+      nb = vol_->blocksPerCluster() - blockOfCluster;
+      if (nb > (nToWrite >> 9)) {
+        nb = nToWrite >> 9;
+      }
+    }
+
     // block for data write
     uint32_t block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
-    if (n == 512) {
+    if (nb > 1) {
+      // write contiguous blocks with a multiple block write, bypassing the cache
+      if (!vol_->writeBlocks(block, nb, src)) {
+        goto writeErrorReturn;
+      }
+      n = 512 * nb;
+      src += n;
+    } else if (n == 512) {
       // full block - don't need to use cache
       // invalidate cache if block is in cache
       if (SdVolume::cacheBlockNumber_ == block) {
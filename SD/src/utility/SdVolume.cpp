@@ -26,6 +26,13 @@ cache_t  SdVolume::cacheBuffer_;     // 512 byte cache for Sd2Card
 Sd2Card* SdVolume::sdCard_;          // pointer to SD card object
 uint8_t  SdVolume::cacheDirty_ = 0;  // cacheFlush() will write block if true
 uint32_t SdVolume::cacheMirrorBlock_ = 0;  // mirror  block for second FAT
+#if SD_FAT_CACHE
+// FAT block cache
+uint32_t SdVolume::fatCacheBlockNumber_ = 0XFFFFFFFF;
+cache_t  SdVolume::fatCacheBuffer_;     // 512 byte cache for FAT blocks
+uint8_t  SdVolume::fatCacheDirty_ = 0;  // fatCacheFlush() will write block if true
+uint32_t SdVolume::fatCacheMirrorBlock_ = 0;  // mirror block for second FAT
+#endif  // SD_FAT_CACHE
 //------------------------------------------------------------------------------
 // find a contiguous group of clusters
 uint8_t SdVolume::allocContiguous(uint32_t count, uint32_t* curCluster) {
@@ -109,6 +116,12 @@ uint8_t SdVolume::allocContiguous(uint32_t count, uint32_t* curCluster) {
 }
 //------------------------------------------------------------------------------
 uint8_t SdVolume::cacheFlush(uint8_t blocking) {
+  #if SD_FAT_CACHE
+  // a non-blocking flush leaves the FAT to cacheMirrorBlockFlush()
+  if (blocking && !fatCacheFlush()) {
+    return false;
+  }
+  #endif  // SD_FAT_CACHE
   if (cacheDirty_) {
     if (!sdCard_->writeBlock(cacheBlockNumber_, cacheBuffer_.data, blocking)) {
       return false;
@@ -133,8 +146,13 @@ uint8_t SdVolume::cacheMirrorBlockFlush(uint8_t blocking) {
       return false;
     }
     cacheMirrorBlock_ = 0;
+    return true;
   }
+  #if SD_FAT_CACHE
+  return fatCacheFlush(blocking);
+  #else  // SD_FAT_CACHE
   return true;
+  #endif  // SD_FAT_CACHE
 }
 //------------------------------------------------------------------------------
 uint8_t SdVolume::cacheRawBlock(uint32_t blockNumber, uint8_t action) {
@@ -151,6 +169,44 @@ uint8_t SdVolume::cacheRawBlock(uint32_t blockNumber, uint8_t action) {
   return true;
 }
 //------------------------------------------------------------------------------
+#if SD_FAT_CACHE
+// write the FAT cache, a non-blocking flush leaves the mirror for the next call
+uint8_t SdVolume::fatCacheFlush(uint8_t blocking) {
+  if (fatCacheDirty_) {
+    if (!sdCard_->writeBlock(fatCacheBlockNumber_, fatCacheBuffer_.data, blocking)) {
+      return false;
+    }
+    fatCacheDirty_ = 0;
+    if (!blocking) {
+      return true;
+    }
+  }
+  if (fatCacheMirrorBlock_) {
+    if (!sdCard_->writeBlock(fatCacheMirrorBlock_, fatCacheBuffer_.data, blocking)) {
+      return false;
+    }
+    fatCacheMirrorBlock_ = 0;
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+// read a FAT block into the FAT cache
+uint8_t SdVolume::fatCacheRead(uint32_t blockNumber) {
+  if (fatCacheBlockNumber_ != blockNumber) {
+    if (!fatCacheFlush()) {
+      return false;
+    }
+    // invalid until the read succeeds
+    fatCacheBlockNumber_ = 0XFFFFFFFF;
+    if (!sdCard_->readBlock(blockNumber, fatCacheBuffer_.data)) {
+      return false;
+    }
+    fatCacheBlockNumber_ = blockNumber;
+  }
+  return true;
+}
+#endif  // SD_FAT_CACHE
+//------------------------------------------------------------------------------
 // cache a zero block for blockNumber
 uint8_t SdVolume::cacheZeroBlock(uint32_t blockNumber) {
   if (!cacheFlush()) {
@@ -166,6 +222,41 @@ uint8_t SdVolume::cacheZeroBlock(uint32_t blockNumber) {
   return true;
 }
 //------------------------------------------------------------------------------
+// read contiguous blocks with one multiple block read command
+uint8_t SdVolume::readBlocks(uint32_t block, uint8_t count, uint8_t* dst) {
+  // the card must have the latest data of a cached block
+  if (cacheBlockNumber_ - block < count && !cacheFlush()) {
+    return false;
+  }
+  if (!sdCard_->readStart(block)) {
+    return false;
+  }
+  for (uint8_t i = 0; i < count; i++, dst += 512) {
+    if (!sdCard_->readData(dst)) {
+      return false;
+    }
+  }
+  return sdCard_->readStop();
+}
+//------------------------------------------------------------------------------
+// write contiguous blocks with one multiple block write command
+uint8_t SdVolume::writeBlocks(uint32_t block, uint8_t count, const uint8_t* src) {
+  // a cached block in the range is overwritten, so drop it
+  if (cacheBlockNumber_ - block < count) {
+    cacheBlockNumber_ = 0XFFFFFFFF;
+    cacheDirty_ = 0;
+  }
+  if (!sdCard_->writeStart(block, count)) {
+    return false;
+  }
+  for (uint8_t i = 0; i < count; i++, src += 512) {
+    if (!sdCard_->writeData(src)) {
+      return false;
+    }
+  }
+  return sdCard_->writeStop();
+}
+//------------------------------------------------------------------------------
 // return the size in bytes of a cluster chain
 uint8_t SdVolume::chainSize(uint32_t cluster, uint32_t* size) const {
   uint32_t s = 0;
@@ -186,15 +277,23 @@ uint8_t SdVolume::fatGet(uint32_t cluster, uint32_t* value) const {
   }
   uint32_t lba = fatStartBlock_;
   lba += fatType_ == 16 ? cluster >> 8 : cluster >> 7;
+  #if SD_FAT_CACHE
+  if (!fatCacheRead(lba)) {
+    return false;
+  }
+  cache_t* fat = &fatCacheBuffer_;
+  #else  // SD_FAT_CACHE
   if (lba != cacheBlockNumber_) {
     if (!cacheRawBlock(lba, CACHE_FOR_READ)) {
       return false;
     }
   }
+  cache_t* fat = &cacheBuffer_;
+  #endif  // SD_FAT_CACHE
   if (fatType_ == 16) {
-    *value = cacheBuffer_.fat16[cluster & 0XFF];
+    *value = fat->fat16[cluster & 0XFF];
   } else {
-    *value = cacheBuffer_.fat32[cluster & 0X7F] & FAT32MASK;
+    *value = fat->fat32[cluster & 0X7F] & FAT32MASK;
   }
   return true;
 }
@@ -215,23 +314,40 @@ uint8_t SdVolume::fatPut(uint32_t cluster, uint32_t value) {
   uint32_t lba = fatStartBlock_;
   lba += fatType_ == 16 ? cluster >> 8 : cluster >> 7;
 
+  #if SD_FAT_CACHE
+  if (!fatCacheRead(lba)) {
+    return false;
+  }
+  cache_t* fat = &fatCacheBuffer_;
+  #else  // SD_FAT_CACHE
   if (lba != cacheBlockNumber_) {
     if (!cacheRawBlock(lba, CACHE_FOR_READ)) {
       return false;
     }
   }
+  cache_t* fat = &cacheBuffer_;
+  #endif  // SD_FAT_CACHE
   // store entry
   if (fatType_ == 16) {
-    cacheBuffer_.fat16[cluster & 0XFF] = value;
+    fat->fat16[cluster & 0XFF] = value;
   } else {
-    cacheBuffer_.fat32[cluster & 0X7F] = value;
+    fat->fat32[cluster & 0X7F] = value;
+  }
+  #if SD_FAT_CACHE
+  fatCacheDirty_ = 1;
+
+  // mirror second FAT
+  if (fatCount_ > 1) {
+    fatCacheMirrorBlock_ = lba + blocksPerFat_;
   }
+  #else  // SD_FAT_CACHE
   cacheSetDirty();
 
   // mirror second FAT
   if (fatCount_ > 1) {
     cacheMirrorBlock_ = lba + blocksPerFat_;
   }
+  #endif  // SD_FAT_CACHE
   return true;
 }
 //------------------------------------------------------------------------------
@@ -275,6 +391,12 @@ uint8_t SdVolume::freeChain(uint32_t cluster) {
 uint8_t SdVolume::init(Sd2Card* dev, uint8_t part) {
   uint32_t volumeStartBlock = 0;
   sdCard_ = dev;
+  #if SD_FAT_CACHE
+  // FAT blocks of a previous card are not valid
+  fatCacheBlockNumber_ = 0XFFFFFFFF;
+  fatCacheDirty_ = 0;
+  fatCacheMirrorBlock_ = 0;
+  #endif  // SD_FAT_CACHE
   // if part == 0 assume super floppy with FAT boot sector in block zero
   // if part > 0 assume mbr volume with partition table
   if (part) {
@@ -43,12 +43,18 @@
     readMicroseconds()   - Gets the last written servo pulse width in microseconds. (was read_us() in first release)
     attached()  - Returns true if there is a servo attached.
     detach()    - Stops an attached servos from pulsing its I/O pin.
+    setSpeed(speed, accel) - Moves to written targets at most speed microseconds per second, accelerating at
+                  most accel microseconds per second squared (0 = unlimited), interpolated in the timer interrupt.
+                  setSpeed(0) returns to jumping straight to the written value. read() and readMicroseconds()
+                  then return the current position of the move.
+    moving()    - Returns true while the servo is still moving toward the last written value.
  */
 
 #ifndef Servo_h
 #define Servo_h
 
 #include <inttypes.h>
+#include "ServoMotion.h"
 
 /*
  * Defines for 16 bit timers used with Servo library
@@ -103,6 +109,7 @@ typedef struct  {
 typedef struct {
   ServoPin_t Pin;
   volatile unsigned int ticks;
+  servo_motion_t motion;              // trajectory toward the last written value, see setSpeed()
 } servo_t;
 
 class Servo
@@ -117,6 +124,8 @@ public:
   int read();                        // returns current pulse width as an angle between 0 and 180 degrees
   int readMicroseconds();            // returns current pulse width in microseconds for this servo (was read_us() in first release)
   bool attached();                   // return true if this servo is attached, otherwise false
+  void setSpeed(unsigned int speed, unsigned int accel = 0); // limit moves to speed us/s and accel us/s^2, 0 speed jumps to written values
+  bool moving();                     // return true while moving toward the last written value
 private:
    uint8_t servoIndex;               // index into the channel data for this servo
    int8_t min;                       // minimum is this value times 4 added to MIN_PULSE_WIDTH
@@ -0,0 +1,104 @@
+/*
+  ServoMotion.h - Velocity and acceleration limited servo motion, stepped from the servo timer interrupt
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*
+  Each architecture keeps a servo_motion_t next to the pulse width it sends and
+  calls servoMotionStep() once per refresh frame from its timer interrupt, while
+  no pulse is being timed. Positions are in the backend's own units (timer ticks
+  or microseconds) with 4 extra fraction bits, so slow moves still advance every
+  frame. The profile is trapezoidal: accelerate by 'accel' per frame up to
+  'speed', and brake once the remaining distance is within the stopping distance
+  v^2 / (2 * accel). A new target can be written at any time, the move continues
+  from the current position and velocity.
+
+  With speed == 0 (the default) the backend writes the pulse width directly and
+  the servo jumps to its target as before.
+ */
+
+#ifndef ServoMotion_h
+#define ServoMotion_h
+
+#include <inttypes.h>
+
+#define SERVO_MOTION_FRAC_BITS  4     // fraction bits of the position, speed and accel
+
+typedef struct {
+  volatile unsigned int target;       // pulse width the servo is heading for
+  uint16_t speed;                     // max change per frame, in 1/16 units (0 = jump to target)
+  uint16_t accel;                     // max speed change per frame, in 1/16 units (0 = full speed at once)
+  int16_t velocity;                   // current change per frame, in 1/16 units
+  uint8_t frac;                       // fraction of the current position, in 1/16 units
+} servo_motion_t;
+
+// converts a rate in units per second (order 1) or per second squared (order 2)
+// to 1/16 units per frame, clamped to the servo_motion_t range
+static inline uint16_t servoMotionPerFrame(uint32_t perSecond, uint16_t framesPerSecond, uint8_t order)
+{
+  if (perSecond == 0)
+    return 0;
+  uint32_t value = (perSecond << SERVO_MOTION_FRAC_BITS) / framesPerSecond;
+  if (order == 2)
+    value /= framesPerSecond;
+  if (value == 0)
+    value = 1;
+  else if (value > 0x7FFF)
+    value = 0x7FFF;
+  return value;
+}
+
+// advances one frame toward m->target and returns the new pulse width
+static inline unsigned int servoMotionStep(servo_motion_t *m, unsigned int position)
+{
+  unsigned int target = m->target;
+  int32_t error = (((int32_t)target - (int32_t)position) << SERVO_MOTION_FRAC_BITS) - m->frac;
+  if (m->speed == 0 || error == 0) {
+    m->velocity = 0;
+    return position;
+  }
+
+  uint32_t distance = error < 0 ? -error : error;
+  int16_t v = error < 0 ? -m->velocity : m->velocity;   // velocity toward the target
+  if (m->accel == 0) {
+    v = m->speed;
+  }
+  else {
+    uint32_t braking = distance > 0xFFFF ? 0xFFFF : distance;
+    if (v > 0 && (uint32_t)((int32_t)v * v) >= 2UL * m->accel * braking) {
+      v -= m->accel;                                    // within stopping distance, slow down
+      if (v <= 0)
+        v = m->accel;                                   // but keep creeping until arrived
+    }
+    else {
+      v += m->accel;
+    }
+    if (v > (int16_t)m->speed)
+      v = m->speed;
+  }
+  if (v > 0 && (uint32_t)v >= distance) {               // arrives this frame, never overshoot
+    m->frac = 0;
+    m->velocity = 0;
+    return target;
+  }
+
+  int32_t next = ((int32_t)position << SERVO_MOTION_FRAC_BITS) + m->frac + (error < 0 ? -v : v);
+  m->velocity = error < 0 ? -v : v;
+  m->frac = next & ((1 << SERVO_MOTION_FRAC_BITS) - 1);
+  return next >> SERVO_MOTION_FRAC_BITS;
+}
+
+#endif
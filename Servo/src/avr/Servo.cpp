@@ -49,6 +49,15 @@ uint8_t ServoCount = 0;                                     // the total number
 
 /************ static functions common to all instances ***********************/
 
+static inline void update_motion(timer16_Sequence_t timer)
+{
+  // step the trajectories of this timer's servos, once per refresh interval
+  for(uint8_t channel=0; channel < SERVOS_PER_TIMER && SERVO_INDEX(timer,channel) < ServoCount; channel++) {
+    if(SERVO(timer,channel).motion.speed)
+      SERVO(timer,channel).ticks = servoMotionStep(&SERVO(timer,channel).motion, SERVO(timer,channel).ticks);
+  }
+}
+
 static inline void handle_interrupts(timer16_Sequence_t timer, volatile uint16_t *TCNTn, volatile uint16_t* OCRnA)
 {
   if( Channel[timer] < 0 )
@@ -66,6 +75,7 @@ static inline void handle_interrupts(timer16_Sequence_t timer, volatile uint16_t
   }
   else {
     // finished all channels so wait for the refresh period to expire before starting over
+    update_motion(timer);  // before reading the counter, so the time spent here is accounted for
     if( ((unsigned)*TCNTn) + 4 < usToTicks(REFRESH_INTERVAL) )  // allow a few ticks to ensure the next OCR1A not missed
       *OCRnA = (unsigned int)usToTicks(REFRESH_INTERVAL);
     else
@@ -225,6 +235,7 @@ Servo::Servo()
   if( ServoCount < MAX_SERVOS) {
     this->servoIndex = ServoCount++;                    // assign a servo index to this instance
 	servos[this->servoIndex].ticks = usToTicks(DEFAULT_PULSE_WIDTH);   // store default values  - 12 Aug 2009
+    servos[this->servoIndex].motion.target = servos[this->servoIndex].ticks;
   }
   else
     this->servoIndex = INVALID_SERVO ;  // too many servos
@@ -288,11 +299,46 @@ void Servo::writeMicroseconds(int value)
 
     uint8_t oldSREG = SREG;
     cli();
-    servos[channel].ticks = value;
+    servos[channel].motion.target = value;
+    if( servos[channel].motion.speed == 0 )   // no motion profile, jump to the new value
+      servos[channel].ticks = value;
+    SREG = oldSREG;
+  }
+}
+
+void Servo::setSpeed(unsigned int speed, unsigned int accel)
+{
+  byte channel = this->servoIndex;
+  if( (channel < MAX_SERVOS) )   // ensure channel is valid
+  {
+    uint16_t frameSpeed = servoMotionPerFrame(usToTicks((uint32_t)speed), 1000000L / REFRESH_INTERVAL, 1);
+    uint16_t frameAccel = servoMotionPerFrame(usToTicks((uint32_t)accel), 1000000L / REFRESH_INTERVAL, 2);
+
+    uint8_t oldSREG = SREG;
+    cli();
+    servos[channel].motion.speed = frameSpeed;
+    servos[channel].motion.accel = frameAccel;
+    if( frameSpeed == 0 ) {   // profile off, finish any move at once
+      servos[channel].ticks = servos[channel].motion.target;
+      servos[channel].motion.velocity = 0;
+      servos[channel].motion.frac = 0;
+    }
     SREG = oldSREG;
   }
 }
 
+bool Servo::moving()
+{
+  bool isMoving = false;
+  if( this->servoIndex < MAX_SERVOS ) {
+    uint8_t oldSREG = SREG;
+    cli();
+    isMoving = servos[this->servoIndex].ticks != servos[this->servoIndex].motion.target || servos[this->servoIndex].motion.frac != 0;
+    SREG = oldSREG;
+  }
+  return isMoving;
+}
+
 int Servo::read() // return the value as degrees
 {
   return  map( this->readMicroseconds()+1, SERVO_MIN(), SERVO_MAX(), 0, 180);
@@ -301,8 +347,13 @@ int Servo::read() // return the value as degrees
 int Servo::readMicroseconds()
 {
   unsigned int pulsewidth;
-  if( this->servoIndex != INVALID_SERVO )
-    pulsewidth = ticksToUs(servos[this->servoIndex].ticks)  + TRIM_DURATION ;   // 12 aug 2009
+  if( this->servoIndex != INVALID_SERVO ) {
+    uint8_t oldSREG = SREG;
+    cli();
+    unsigned int ticks = servos[this->servoIndex].ticks;   // may be changing in the interrupt if a motion profile is set
+    SREG = oldSREG;
+    pulsewidth = ticksToUs(ticks)  + TRIM_DURATION ;   // 12 aug 2009
+  }
   else
     pulsewidth  = 0;
 
@@ -32,6 +32,9 @@ public:
     }
 
     void call() {
+        if (motion.speed) {
+          duration = servoMotionStep(&motion, duration);   // step the trajectory once per period
+        }
         timeout.attach(mbed::callback(this, &ServoImpl::toggle), duration / 1e6);
         toggle();
     }
@@ -41,6 +44,7 @@ public:
     }
 
     int32_t           duration = -1;
+    servo_motion_t    motion = {};   // in microseconds, see Servo::setSpeed()
 };
 
 static ServoImpl* servos[MAX_SERVOS];                      // static array of servo structures
@@ -111,11 +115,41 @@ void Servo::writeMicroseconds(int value)
       value = SERVO_MAX();
 
     value = value - TRIM_DURATION;
+    servos[this->servoIndex]->motion.target = value;
     if (servos[this->servoIndex]->duration == -1) {
       servos[this->servoIndex]->start(value);
     }
-    servos[this->servoIndex]->duration = value;
+    if (servos[this->servoIndex]->motion.speed == 0) {   // no motion profile, jump to the new value
+      servos[this->servoIndex]->duration = value;
+    }
+  }
+}
+
+void Servo::setSpeed(unsigned int speed, unsigned int accel)
+{
+  // the profile lives with the pin, so this needs to be called after attach()
+  if (!servos[this->servoIndex]) {
+    return;
+  }
+  ServoImpl *servo = servos[this->servoIndex];
+  core_util_critical_section_enter();
+  servo->motion.speed = servoMotionPerFrame(speed, 1000000L / REFRESH_INTERVAL, 1);
+  servo->motion.accel = servoMotionPerFrame(accel, 1000000L / REFRESH_INTERVAL, 2);
+  if (servo->motion.speed == 0 && servo->duration != -1) {   // profile off, finish any move at once
+    servo->duration = servo->motion.target;
+    servo->motion.velocity = 0;
+    servo->motion.frac = 0;
+  }
+  core_util_critical_section_exit();
+}
+
+bool Servo::moving()
+{
+  if (!servos[this->servoIndex]) {
+    return false;
   }
+  ServoImpl *servo = servos[this->servoIndex];
+  return servo->duration != -1 && ((unsigned int)servo->duration != servo->motion.target || servo->motion.frac != 0);
 }
 
 int Servo::read() // return the value as degrees
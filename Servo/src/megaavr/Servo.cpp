@@ -26,6 +26,16 @@ static volatile int8_t currentServoIndex[_Nbr_16timers];   // index for the serv
 #undef REFRESH_INTERVAL
 #define REFRESH_INTERVAL 16000
 
+static inline void updateMotion(int timer)
+{
+    // step the trajectories of this timer's servos, once per refresh interval
+    for (uint8_t channel = 0; channel < SERVOS_PER_TIMER && SERVO_INDEX(timer, channel) < ServoCount; channel++) {
+        if (SERVO(timer, channel).motion.speed) {
+            SERVO(timer, channel).ticks = servoMotionStep(&SERVO(timer, channel).motion, SERVO(timer, channel).ticks);
+        }
+    }
+}
+
 void ServoHandler(int timer)
 {
     if (currentServoIndex[timer] < 0) {
@@ -51,6 +61,7 @@ void ServoHandler(int timer)
     }
     else {
         // finished all channels so wait for the refresh period to expire before starting over
+        updateMotion(timer);
 
         // Get the counter value
         uint16_t tcCounterValue = _timer->CCMP;
@@ -117,6 +128,7 @@ Servo::Servo()
   if (ServoCount < MAX_SERVOS) {
     this->servoIndex = ServoCount++;                    // assign a servo index to this instance
     servos[this->servoIndex].ticks = usToTicks(DEFAULT_PULSE_WIDTH);   // store default values
+    servos[this->servoIndex].motion.target = servos[this->servoIndex].ticks;
   } else {
     this->servoIndex = INVALID_SERVO;  // too many servos
   }
@@ -186,10 +198,48 @@ void Servo::writeMicroseconds(int value)
 
     value = value - TRIM_DURATION;
     value = usToTicks(value);  // convert to ticks after compensating for interrupt overhead
-    servos[channel].ticks = value;
+    uint8_t oldSREG = SREG;
+    cli();
+    servos[channel].motion.target = value;
+    if (servos[channel].motion.speed == 0)   // no motion profile, jump to the new value
+      servos[channel].ticks = value;
+    SREG = oldSREG;
   }
 }
 
+void Servo::setSpeed(unsigned int speed, unsigned int accel)
+{
+  byte channel = this->servoIndex;
+  if( (channel < MAX_SERVOS) )   // ensure channel is valid
+  {
+    uint16_t frameSpeed = servoMotionPerFrame(usToTicks((uint32_t)speed), 1000000L / REFRESH_INTERVAL, 1);
+    uint16_t frameAccel = servoMotionPerFrame(usToTicks((uint32_t)accel), 1000000L / REFRESH_INTERVAL, 2);
+
+    uint8_t oldSREG = SREG;
+    cli();
+    servos[channel].motion.speed = frameSpeed;
+    servos[channel].motion.accel = frameAccel;
+    if (frameSpeed == 0) {   // profile off, finish any move at once
+      servos[channel].ticks = servos[channel].motion.target;
+      servos[channel].motion.velocity = 0;
+      servos[channel].motion.frac = 0;
+    }
+    SREG = oldSREG;
+  }
+}
+
+bool Servo::moving()
+{
+  bool isMoving = false;
+  if (this->servoIndex < MAX_SERVOS) {
+    uint8_t oldSREG = SREG;
+    cli();
+    isMoving = servos[this->servoIndex].ticks != servos[this->servoIndex].motion.target || servos[this->servoIndex].motion.frac != 0;
+    SREG = oldSREG;
+  }
+  return isMoving;
+}
+
 int Servo::read() // return the value as degrees
 {
   return map(readMicroseconds()+1, SERVO_MIN(), SERVO_MAX(), 0, 180);
@@ -198,8 +248,13 @@ int Servo::read() // return the value as degrees
 int Servo::readMicroseconds()
 {
   unsigned int pulsewidth;
-  if (this->servoIndex != INVALID_SERVO)
-    pulsewidth = ticksToUs(servos[this->servoIndex].ticks)  + TRIM_DURATION;
+  if (this->servoIndex != INVALID_SERVO) {
+    uint8_t oldSREG = SREG;
+    cli();
+    unsigned int ticks = servos[this->servoIndex].ticks;   // may be changing in the interrupt if a motion profile is set
+    SREG = oldSREG;
+    pulsewidth = ticksToUs(ticks)  + TRIM_DURATION;
+  }
   else
     pulsewidth  = 0;
 
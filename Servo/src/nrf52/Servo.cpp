@@ -131,4 +131,17 @@ bool Servo::attached()
   return servos[this->servoIndex].Pin.isActive;
 }
 
+void Servo::setSpeed(unsigned int speed, unsigned int accel)
+{
+	// the PWM peripheral generates the pulses on its own, there is no interrupt to step
+	// a trajectory in: writes always jump to the new value on this architecture
+	(void)speed;
+	(void)accel;
+}
+
+bool Servo::moving()
+{
+	return false;
+}
+
 #endif // ARDUINO_ARCH_NRF52
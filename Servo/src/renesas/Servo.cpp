@@ -48,6 +48,8 @@ typedef struct {
     // Internal FSP GPIO port/pin control bits.
     volatile uint32_t *io_port;
     uint32_t io_mask;
+    // Trajectory toward the last written period, in microseconds.
+    servo_motion_t motion;
 } ra_servo_t;
 
 // Keep track of the total number of servos attached.
@@ -143,7 +145,16 @@ void servo_timer_callback(timer_callback_args_t *args)
         }
         active_servos_mask_refresh &= ~(1 << channel);
     }
-    // Finished processing all servos, now delay to start of next pass.
+    // Finished processing all servos, step the motion profiles once per pass.
+    for (uint32_t mask = active_servos_mask; mask; mask &= mask - 1) {
+        ra_servo_t *servo = &ra_servos[__builtin_ctz(mask)];
+        if (servo->motion.speed && servo->period_us) {
+            servo->period_us = servoMotionStep(&servo->motion, servo->period_us);
+            servo->period_ticks = us_to_ticks(servo->period_us);
+        }
+    }
+
+    // Now delay to start of next pass.
     ticks_accum += min_servo_cycle_low;
     uint32_t time_to_next_cycle;
     if (servo_ticks_per_cycle > ticks_accum) {
@@ -196,6 +207,7 @@ uint8_t Servo::attach(int pin, int min, int max)
             servo->period_max = max;
             servo->io_mask = (1U << (io_pin & 0xFF));
             servo->io_port = SERVO_IO_PORT_ADDR(((io_pin >> 8U) & 0xFF));
+            servo->motion = {};
             active_servos_mask |= (1 << i);  // update mask of servos that are active.
             writeMicroseconds(DEFAULT_PULSE_WIDTH);
             break;
@@ -254,9 +266,42 @@ void Servo::writeMicroseconds(int us)
 {
     if (servoIndex != SERVO_INVALID_INDEX) {
         ra_servo_t *servo = &ra_servos[servoIndex];
-        servo->period_us = constrain(us, servo->period_min, servo->period_max);
-        servo->period_ticks = us_to_ticks(servo->period_us);
+        servo->motion.target = constrain(us, servo->period_min, servo->period_max);
+        if (servo->motion.speed == 0 || servo->period_us == 0) {
+            // No motion profile (or first write after attach), jump to the new value.
+            servo->period_us = servo->motion.target;
+            servo->period_ticks = us_to_ticks(servo->period_us);
+        }
+    }
+}
+
+void Servo::setSpeed(unsigned int speed, unsigned int accel)
+{
+    if (servoIndex != SERVO_INVALID_INDEX) {
+        ra_servo_t *servo = &ra_servos[servoIndex];
+        uint16_t frame_speed = servoMotionPerFrame(speed, 1000000UL / SERVO_US_PER_CYCLE, 1);
+        uint16_t frame_accel = servoMotionPerFrame(accel, 1000000UL / SERVO_US_PER_CYCLE, 2);
+        noInterrupts();
+        servo->motion.speed = frame_speed;
+        servo->motion.accel = frame_accel;
+        if (frame_speed == 0) {
+            // Profile off, finish any move at once.
+            servo->period_us = servo->motion.target;
+            servo->period_ticks = us_to_ticks(servo->period_us);
+            servo->motion.velocity = 0;
+            servo->motion.frac = 0;
+        }
+        interrupts();
+    }
+}
+
+bool Servo::moving()
+{
+    if (servoIndex != SERVO_INVALID_INDEX) {
+        ra_servo_t *servo = &ra_servos[servoIndex];
+        return servo->period_us != servo->motion.target || servo->motion.frac != 0;
     }
+    return false;
 }
 
 int Servo::readMicroseconds()
@@ -43,6 +43,16 @@ static volatile int8_t Channel[_Nbr_16timers ];             // counter for the s
 
 /************ static functions common to all instances ***********************/
 
+static inline void updateMotion(timer16_Sequence_t timer)
+{
+    // step the trajectories of this timer's servos, once per refresh interval
+    for (uint8_t channel = 0; channel < SERVOS_PER_TIMER && SERVO_INDEX(timer, channel) < ServoCount; channel++) {
+        if (SERVO(timer, channel).motion.speed) {
+            SERVO(timer, channel).ticks = servoMotionStep(&SERVO(timer, channel).motion, SERVO(timer, channel).ticks);
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Interrupt handler for the TC0 channel 1.
 //------------------------------------------------------------------------------
@@ -94,6 +104,7 @@ void Servo_Handler(timer16_Sequence_t timer, Tc *tc, uint8_t channel)
     }
     else {
         // finished all channels so wait for the refresh period to expire before starting over
+        updateMotion(timer);  // before reading the counter, so the time spent here is accounted for
         if( (tc->TC_CHANNEL[channel].TC_CV) + 4 < usToTicks(REFRESH_INTERVAL) ) { // allow a few ticks to ensure the next OCR1A not missed
             tc->TC_CHANNEL[channel].TC_RA = (unsigned int)usToTicks(REFRESH_INTERVAL);
         }
@@ -185,6 +196,7 @@ Servo::Servo()
   if (ServoCount < MAX_SERVOS) {
     this->servoIndex = ServoCount++;                    // assign a servo index to this instance
     servos[this->servoIndex].ticks = usToTicks(DEFAULT_PULSE_WIDTH);   // store default values
+    servos[this->servoIndex].motion.target = servos[this->servoIndex].ticks;
   } else {
     this->servoIndex = INVALID_SERVO;  // too many servos
   }
@@ -254,8 +266,43 @@ void Servo::writeMicroseconds(int value)
 
     value = value - TRIM_DURATION;
     value = usToTicks(value);  // convert to ticks after compensating for interrupt overhead
-    servos[channel].ticks = value;
+    noInterrupts();
+    servos[channel].motion.target = value;
+    if (servos[channel].motion.speed == 0)   // no motion profile, jump to the new value
+      servos[channel].ticks = value;
+    interrupts();
+  }
+}
+
+void Servo::setSpeed(unsigned int speed, unsigned int accel)
+{
+  byte channel = this->servoIndex;
+  if( (channel < MAX_SERVOS) )   // ensure channel is valid
+  {
+    uint16_t frameSpeed = servoMotionPerFrame(usToTicks((uint32_t)speed), 1000000L / REFRESH_INTERVAL, 1);
+    uint16_t frameAccel = servoMotionPerFrame(usToTicks((uint32_t)accel), 1000000L / REFRESH_INTERVAL, 2);
+
+    noInterrupts();
+    servos[channel].motion.speed = frameSpeed;
+    servos[channel].motion.accel = frameAccel;
+    if (frameSpeed == 0) {   // profile off, finish any move at once
+      servos[channel].ticks = servos[channel].motion.target;
+      servos[channel].motion.velocity = 0;
+      servos[channel].motion.frac = 0;
+    }
+    interrupts();
+  }
+}
+
+bool Servo::moving()
+{
+  bool isMoving = false;
+  if (this->servoIndex < MAX_SERVOS) {
+    noInterrupts();
+    isMoving = servos[this->servoIndex].ticks != servos[this->servoIndex].motion.target || servos[this->servoIndex].motion.frac != 0;
+    interrupts();
   }
+  return isMoving;
 }
 
 int Servo::read() // return the value as degrees
@@ -0,0 +1,75 @@
+/*
+  Using the Qwiic PT100
+  Date: October 15th, 2026
+
+  This example streams conversions from the ADS122C04 using the DRDY pin.
+  The DRDY interrupt records when each conversion finished, update reads it into a queue
+  and readSample takes the samples out of the queue, each with its timestamp and input.
+
+  Three single-ended inputs (AIN0, AIN1 and AIN2 against AVSS) are scanned round robin.
+  Pass only one input (or none) to beginStream to use continuous conversion mode instead.
+
+  update must be called at least as often as the data rate. If it is not,
+  getOverruns counts the conversions which were lost.
+
+  Hardware Connections:
+  Plug a Qwiic cable into the PT100 and a BlackBoard
+  Connect the DRDY pad to pin 2 (it needs to be a pin which supports interrupts)
+  Open the serial monitor at 115200 baud to see the output
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_ADS122C04_ADC_Arduino_Library.h> // Click here to get the library: http://librarymanager/All#SparkFun_ADS122C0
+
+SFE_ADS122C04 mySensor;
+
+const uint8_t drdyPin = 2;
+
+const uint8_t inputs[] = { ADS122C04_MUX_AIN0_AVSS, ADS122C04_MUX_AIN1_AVSS, ADS122C04_MUX_AIN2_AVSS };
+
+void setup(void)
+{
+  Serial.begin(115200);
+  while (!Serial)
+    ; //Wait for user to open terminal
+  Serial.println(F("Qwiic PT100 Example"));
+
+  Wire.begin();
+  Wire.setClock(400000); // Leave time on the bus for the other transfers
+
+  if (mySensor.begin() == false) //Connect to the PT100 using the defaults: Address 0x45 and the Wire port
+  {
+    Serial.println(F("Qwiic PT100 not detected at default I2C address. Please check wiring. Freezing."));
+    while (1)
+      ;
+  }
+
+  // Raw mode: internal 2.048V reference, gain 1, IDAC disabled
+  mySensor.configureADCmode(ADS122C04_RAW_MODE, ADS122C04_DATA_RATE_175SPS);
+
+  if (mySensor.beginStream(drdyPin, inputs, sizeof(inputs)) == false)
+  {
+    Serial.println(F("beginStream failed. Freezing."));
+    while (1)
+      ;
+  }
+}
+
+void loop()
+{
+  mySensor.update(); // Read a finished conversion into the queue
+
+  ADS122C04_sample_t sample;
+  while (mySensor.readSample(&sample))
+  {
+    // The LSB is 2.048 / 2^23 = 0.24414 uV
+    Serial.print(sample.time);
+    Serial.print(F(" us  input 0x"));
+    Serial.print(sample.inputMux, HEX);
+    Serial.print(F(": "));
+    Serial.print((float)sample.raw * 244.140625 / 1.0e6, 6);
+    Serial.print(F(" mV  overruns "));
+    Serial.println(mySensor.getOverruns());
+  }
+}
@@ -39,6 +39,16 @@
 
 #include "SparkFun_ADS122C04_ADC_Arduino_Library.h"
 
+// Interrupt handlers have to live in RAM on the ESP platforms
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+#define ADS122C04_ISR_ATTR IRAM_ATTR
+#else
+#define ADS122C04_ISR_ATTR
+#endif
+
+volatile uint32_t SFE_ADS122C04::_readyCount = 0;
+volatile uint32_t SFE_ADS122C04::_readyTime = 0;
+
 SFE_ADS122C04::SFE_ADS122C04(void)
 {
   // Constructor
@@ -715,6 +725,175 @@ bool SFE_ADS122C04::checkDataReady(void)
   return(ADS122C04_Reg.reg2.bit.DRDY > 0);
 }
 
+// Stream conversions into the sample queue, paced by the DRDY pin (open-drain, active low)
+// muxList is a list of ADS122C04_MUX_ settings to scan. NULL keeps the current setting.
+// The gain, rate, reference and IDAC settings are used as they are, so call configureADCmode
+// (or the individual set functions) first.
+bool SFE_ADS122C04::beginStream(uint8_t drdyPin, const uint8_t *muxList, uint8_t count)
+{
+  stopStream();
+
+  if (count > ADS122C04_SCAN_MAX)
+    count = ADS122C04_SCAN_MAX;
+  _scanCount = (muxList == NULL) ? 0 : count;
+  for (uint8_t i = 0; i < _scanCount; i++)
+    _scanMux[i] = muxList[i];
+  _scanIndex = 0;
+
+  if (((ADS122C04_readReg(ADS122C04_CONFIG_0_REG, &ADS122C04_Reg.reg0.all)) == false)
+    || ((ADS122C04_readReg(ADS122C04_CONFIG_1_REG, &ADS122C04_Reg.reg1.all)) == false))
+  {
+    if (_printDebug == true)
+    {
+      _debugPort->println(F("beginStream: ADS122C04_readReg failed"));
+    }
+    return(false);
+  }
+
+  _head = 0;
+  _tail = 0;
+  _overruns = 0;
+  _restart = false;
+  noInterrupts();
+  _readyCount = 0;
+  interrupts();
+  _readySeen = 0;
+  _drdyPin = drdyPin;
+
+  pinMode(_drdyPin, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(_drdyPin), drdyISR, FALLING);
+
+  if (_scanCount > 1)
+  {
+    // Chain single-shot conversions so every result belongs to one input
+    ADS122C04_Reg.reg1.bit.CMBIT = ADS122C04_CONVERSION_MODE_SINGLE_SHOT;
+    if ((ADS122C04_writeReg(ADS122C04_CONFIG_1_REG, ADS122C04_Reg.reg1.all)) == false)
+      return(false);
+    return(startScanConversion());
+  }
+
+  if (_scanCount == 1)
+  {
+    ADS122C04_Reg.reg0.bit.MUX = _scanMux[0];
+    if ((ADS122C04_writeReg(ADS122C04_CONFIG_0_REG, ADS122C04_Reg.reg0.all)) == false)
+      return(false);
+  }
+  ADS122C04_Reg.reg1.bit.CMBIT = ADS122C04_CONVERSION_MODE_CONTINUOUS;
+  if ((ADS122C04_writeReg(ADS122C04_CONFIG_1_REG, ADS122C04_Reg.reg1.all)) == false)
+    return(false);
+  return(start());
+}
+
+// Stop streaming and return to single-shot mode
+void SFE_ADS122C04::stopStream(void)
+{
+  if (_drdyPin < 0)
+    return;
+  detachInterrupt(digitalPinToInterrupt(_drdyPin));
+  _drdyPin = -1;
+  setConversionMode(ADS122C04_CONVERSION_MODE_SINGLE_SHOT);
+}
+
+// Only count and timestamp the conversion here. Wire can not be used inside an interrupt.
+void ADS122C04_ISR_ATTR SFE_ADS122C04::drdyISR(void)
+{
+  _readyTime = micros();
+  _readyCount++;
+}
+
+bool SFE_ADS122C04::startScanConversion(void)
+{
+  ADS122C04_Reg.reg0.bit.MUX = _scanMux[_scanIndex];
+  _restart = (ADS122C04_writeReg(ADS122C04_CONFIG_0_REG, ADS122C04_Reg.reg0.all) == false)
+    || (start() == false);
+  return(_restart == false);
+}
+
+// Read a conversion signalled by DRDY into the sample queue.
+// Call this from loop at least as often as the data rate.
+// Returns true if a sample was queued
+bool SFE_ADS122C04::update(void)
+{
+  if (_drdyPin < 0)
+    return(false);
+
+  if (_restart)
+  {
+    startScanConversion(); // Try again to start the conversion which failed last time
+    return(false);
+  }
+
+  noInterrupts();
+  uint32_t count = _readyCount;
+  uint32_t time = _readyTime;
+  interrupts();
+
+  if (count == _readySeen)
+    return(false);
+  _overruns += count - _readySeen - 1; // DRDY went low more than once since the last update
+  _readySeen = count;
+
+  raw_voltage_union raw_v; // union to convert uint32_t to int32_t
+  bool result = ADS122C04_getConversionData(&raw_v.UINT32);
+
+  uint8_t inputMux = ADS122C04_Reg.reg0.bit.MUX;
+  if (_scanCount > 1)
+  {
+    _scanIndex = (_scanIndex + 1 < _scanCount) ? _scanIndex + 1 : 0;
+    startScanConversion();
+  }
+
+  if (result == false)
+  {
+    if (_printDebug == true)
+    {
+      _debugPort->println(F("update: ADS122C04_getConversionData failed"));
+    }
+    return(false);
+  }
+
+  if ((uint16_t)(_head - _tail) >= ADS122C04_QUEUE_SIZE)
+  {
+    _overruns++; // The queue is full, drop the new sample
+    return(false);
+  }
+
+  // Pad out the MSB with the MS bit of the 24 bits to preserve the two's complement
+  if ((raw_v.UINT32 & 0x00800000) == 0x00800000)
+    raw_v.UINT32 |= 0xFF000000;
+
+  ADS122C04_sample_t *sample = &_queue[_head & (ADS122C04_QUEUE_SIZE - 1)];
+  sample->time = time;
+  sample->raw = raw_v.INT32;
+  sample->inputMux = inputMux;
+  _head++;
+  return(true);
+}
+
+// Get the number of samples waiting in the queue
+uint16_t SFE_ADS122C04::available(void)
+{
+  return(_head - _tail);
+}
+
+// Take the oldest sample from the queue
+// Returns false if the queue is empty
+bool SFE_ADS122C04::readSample(ADS122C04_sample_t *sample)
+{
+  if (_head == _tail)
+    return(false);
+  *sample = _queue[_tail & (ADS122C04_QUEUE_SIZE - 1)];
+  _tail++;
+  return(true);
+}
+
+// Get the number of conversions lost since beginStream
+// Either missed because update was not called in time, or dropped because the queue was full
+uint16_t SFE_ADS122C04::getOverruns(void)
+{
+  return(_overruns);
+}
+
 // Get the input multiplexer configuration
 uint8_t SFE_ADS122C04::getInputMultiplexer(void)
 {
@@ -68,6 +68,18 @@
 // The maximum time we will wait for DRDY to go valid for a single conversion
 #define ADS122C04_CONVERSION_TIMEOUT 75
 
+// Number of samples in the stream queue (must be a power of 2)
+#ifndef ADS122C04_QUEUE_SIZE
+#if defined(__AVR__)
+#define ADS122C04_QUEUE_SIZE 16
+#else
+#define ADS122C04_QUEUE_SIZE 64
+#endif
+#endif
+
+// The most input multiplexer settings beginStream can scan
+#define ADS122C04_SCAN_MAX 8
+
 // Define 2/3/4-Wire, Temperature and Raw modes
 #define ADS122C04_4WIRE_MODE         0x0
 #define ADS122C04_3WIRE_MODE         0x1
@@ -304,6 +316,13 @@ typedef struct{
   uint8_t routeIDAC2;
 } ADS122C04_initParam;
 
+// One streamed conversion result
+typedef struct{
+  uint32_t time; // micros() when DRDY went low
+  int32_t raw; // Signed 24-bit ADC value
+  uint8_t inputMux; // The input multiplexer setting it was converted with
+} ADS122C04_sample_t;
+
 class SFE_ADS122C04
 {
 public:
@@ -358,6 +377,17 @@ public:
 
   bool checkDataReady(void); // Check the status of the DRDY bit in Config Register 2
 
+  // Stream conversions into a queue, paced by the DRDY pin
+  // A single input runs in continuous conversion mode. With a list of inputs, update
+  // switches the multiplexer and starts the next single-shot conversion round robin.
+  // Only one ADS122C04 can stream at a time as the interrupt handler is shared.
+  bool beginStream(uint8_t drdyPin, const uint8_t *muxList = NULL, uint8_t count = 0);
+  void stopStream(void); // Stop streaming and return to single-shot mode
+  bool update(void); // Call from loop: read a conversion signalled by DRDY into the queue. Returns true if a sample was queued
+  uint16_t available(void); // Get the number of samples in the queue
+  bool readSample(ADS122C04_sample_t *sample); // Take the oldest sample from the queue. Returns false if it is empty
+  uint16_t getOverruns(void); // Get the number of conversions missed by update or dropped because the queue was full
+
   uint8_t getInputMultiplexer(void); // Get the input multiplexer configuration
   uint8_t getGain(void); // Get the gain setting
   uint8_t getPGAstatus(void); // Get the Programmable Gain Amplifier status
@@ -405,6 +435,25 @@ private:
 
   ADS122C04Reg_t ADS122C04_Reg; // Global to hold copies of all four configuration registers
 
+  // Streaming
+  int _drdyPin = -1; // -1 when not streaming
+  uint8_t _scanMux[ADS122C04_SCAN_MAX]; // The input multiplexer settings to scan
+  uint8_t _scanCount = 0;
+  uint8_t _scanIndex = 0;
+  bool _restart = false; // The next single-shot conversion could not be started
+  uint32_t _readySeen = 0; // The DRDY count at the last update
+  ADS122C04_sample_t _queue[ADS122C04_QUEUE_SIZE];
+  uint16_t _head = 0; // Free running, the queue size divides its range
+  uint16_t _tail = 0;
+  uint16_t _overruns = 0;
+
+  // Written by the DRDY interrupt
+  static volatile uint32_t _readyCount;
+  static volatile uint32_t _readyTime;
+  static void drdyISR(void);
+
+  bool startScanConversion(void); // Select the next input and start a single-shot conversion
+
   void debugPrint(char *message); // print a debug message
   void debugPrintln(char *message); // print a debug message with line feed
 
@@ -27,6 +27,7 @@ void TFTTerminal::setGeometry(uint16_t x, uint16_t y, uint16_t w, uint16_t h )
 
     _line_x_limit = _win_w / _font_x_size;
     _line_y_limit = _win_h / _font_y_size;
+    setScrollArea();
 }
 
 void TFTTerminal::setFontsize(uint8_t size)
@@ -38,10 +39,125 @@ void TFTTerminal::setFontsize(uint8_t size)
 
     _line_x_limit = _win_w / _font_x_size;
     _line_y_limit = _win_h / _font_y_size;
+    setScrollArea();
+}
+
+bool TFTTerminal::setHardwareScroll(TFT_eSPI *lcd)
+{
+    if (_lcd_ptr != NULL)
+    {
+        // back to no scrolling, the whole panel in the scroll area
+        _lcd_ptr->writecommand(ILI9341_VSCRDEF);
+        _lcd_ptr->writedata(0);
+        _lcd_ptr->writedata(0);
+        _lcd_ptr->writedata(_lcd_ptr->height() >> 8);
+        _lcd_ptr->writedata(_lcd_ptr->height());
+        _lcd_ptr->writedata(0);
+        _lcd_ptr->writedata(0);
+        _lcd_ptr->writecommand(ILI9341_VSCRSADD);
+        _lcd_ptr->writedata(0);
+        _lcd_ptr->writedata(0);
+        _lcd_ptr = NULL;
+    }
+    if (lcd == NULL)
+    {
+        return true;
+    }
+    // panel rows run along y only in rotation 1, the scroll area spans full rows
+    if ((lcd->getRotation() != 1) || (_line_y_limit == 0) || (_win_x_pos != 0) || (_win_w != lcd->width()) ||
+        (_win_y_pos + _win_h > lcd->height()))
+    {
+        return false;
+    }
+    _lcd_ptr = lcd;
+    setScrollArea();
+    return true;
+}
+
+void TFTTerminal::setScrollArea()
+{
+    if ((_lcd_ptr == NULL) || (_line_y_limit == 0))
+    {
+        return;
+    }
+    uint16_t top = _win_y_pos, area = _line_y_limit * _font_y_size;
+    uint16_t bottom = _lcd_ptr->height() - top - area;
+
+    _lcd_ptr->writecommand(ILI9341_VSCRDEF);
+    _lcd_ptr->writedata(top >> 8);
+    _lcd_ptr->writedata(top);
+    _lcd_ptr->writedata(area >> 8);
+    _lcd_ptr->writedata(area);
+    _lcd_ptr->writedata(bottom >> 8);
+    _lcd_ptr->writedata(bottom);
+
+    _scroll_top = 0;
+    _scroll_row = 0;
+    _lcd_ptr->writecommand(ILI9341_VSCRSADD);
+    _lcd_ptr->writedata(top >> 8);
+    _lcd_ptr->writedata(top);
+    _lcd_ptr->fillRect(0, top, _lcd_ptr->width(), area, _bkcolor);
+}
+
+// panel y of a terminal row, counted from the logical top line
+uint16_t TFTTerminal::scrollRowY(uint16_t row)
+{
+    return _win_y_pos + ((_scroll_top + row) % _line_y_limit) * _font_y_size;
+}
+
+// one command moves the logical top line, only the new bottom line is cleared
+void TFTTerminal::scrollLine()
+{
+    _scroll_top = (_scroll_top + 1) % _line_y_limit;
+    uint16_t start = _win_y_pos + _scroll_top * _font_y_size;
+
+    _lcd_ptr->writecommand(ILI9341_VSCRSADD);
+    _lcd_ptr->writedata(start >> 8);
+    _lcd_ptr->writedata(start);
+    _lcd_ptr->fillRect(0, scrollRowY(_line_y_limit - 1), _lcd_ptr->width(), _font_y_size, _bkcolor);
+}
+
+void TFTTerminal::newLine()
+{
+    xpos = 0;
+    ypos++;
+    ypos = ypos % 60;
+    memset(discharbuff[ypos % 60], 0, 55);
+
+    if (_lcd_ptr != NULL)
+    {
+        if (_scroll_row + 1 < _line_y_limit)
+        {
+            _scroll_row++;
+        }
+        else
+        {
+            scrollLine();
+        }
+    }
 }
 
 size_t TFTTerminal::write(uint8_t chardata)
 {
+    if (_lcd_ptr != NULL)
+    {
+        if ((chardata == '\r') || (chardata == '\n'))
+        {
+            newLine();
+            return 1;
+        }
+        else if (xpos >= _line_x_limit)
+        {
+            newLine();
+        }
+        discharbuff[ypos][xpos] = chardata;
+        xpos++;
+
+        _lcd_ptr->setTextColor(_color);
+        _lcd_ptr->setTextSize(_fontSize);
+        _lcd_ptr->drawChar(chardata, (xpos - 1) * _font_x_size, scrollRowY(_scroll_row));
+        return 1;
+    }
     
     bool flush_page_flag = false;
     uint8_t dis_y_pos = 0;
@@ -112,6 +228,15 @@ size_t TFTTerminal::write(uint8_t chardata)
 
 size_t TFTTerminal::write(const uint8_t *buffer, size_t size)
 {
+    if (_lcd_ptr != NULL)
+    {
+        while ((size != 0) && (*buffer != '\0'))
+        {
+            write(*buffer++);
+            size--;
+        }
+        return 1;
+    }
 
     while ((size != 0) && (*buffer != '\0'))
     {
@@ -4,6 +4,14 @@
 #include <M5Stack.h>
 #include <Print.h>
 
+// vertical scrolling commands of the ILI9341 / ILI9342C panel
+#ifndef ILI9341_VSCRDEF
+#define ILI9341_VSCRDEF  0x33
+#endif
+#ifndef ILI9341_VSCRSADD
+#define ILI9341_VSCRSADD 0x37
+#endif
+
 class TFTTerminal : public Print
 {
 private:
@@ -19,6 +27,17 @@ private:
     uint8_t  _fontSize = 0;
     uint16_t _line_x_limit = 53,_line_y_limit = 30;
 
+    // hardware scroll mode: lines are drawn on the panel directly and the
+    // scroll start address makes the physical row _scroll_top the top line
+    TFT_eSPI* _lcd_ptr = NULL;
+    uint16_t _scroll_top = 0;
+    uint16_t _scroll_row = 0;
+
+    void newLine();
+    void scrollLine();
+    void setScrollArea();
+    uint16_t scrollRowY(uint16_t row);
+
 public:
     TFTTerminal(TFT_eSprite *dis_buff_ptr);
     ~TFTTerminal();
@@ -26,6 +45,9 @@ public:
     void setcolor( uint16_t color, uint16_t bk_color );
     void setGeometry(uint16_t x, uint16_t y, uint16_t w, uint16_t h );
     void setFontsize(uint8_t size);
+    // scroll with the panel's vertical scroll area instead of redrawing the sprite;
+    // the window must span the full width, M5Stack rotation 1 only; NULL to stop
+    bool setHardwareScroll(TFT_eSPI *lcd);
 
     size_t write(uint8_t) ;
     size_t write(const uint8_t *buffer, size_t size);
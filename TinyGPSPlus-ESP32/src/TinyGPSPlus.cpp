@@ -32,19 +32,28 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #define _GNRMCterm   "GNRMC"
 #define _GNGGAterm   "GNGGA"
 
+static constexpr uint16_t hashSentence(const char *name, uint16_t h = _GPS_HASH_SEED)
+{
+  return *name ? hashSentence(name + 1, _GPS_HASH_STEP(h, *name)) : h;
+}
+
 TinyGPSPlus::TinyGPSPlus()
   :  parity(0)
   ,  isChecksumTerm(false)
+  ,  sentenceHash(_GPS_HASH_SEED)
   ,  curSentenceType(GPS_SENTENCE_OTHER)
   ,  curTermNumber(0)
   ,  curTermOffset(0)
   ,  sentenceHasFix(false)
   ,  customElts(0)
   ,  customCandidates(0)
+  ,  customCursor(0)
+  ,  ubxState(UBX_IDLE)
   ,  encodedCharCount(0)
   ,  sentencesWithFixCount(0)
   ,  failedChecksumCount(0)
   ,  passedChecksumCount(0)
+  ,  ubxFrameCount(0)
 {
   term[0] = '\0';
 }
@@ -56,6 +65,14 @@ bool TinyGPSPlus::encode(char c)
 {
   ++encodedCharCount;
 
+  // UBX frames start with a byte that never appears in NMEA
+  if (ubxState != UBX_IDLE || (uint8_t)c == _GPS_UBX_SYNC1)
+  {
+    if (ubxState != UBX_SYNC2 || (uint8_t)c == _GPS_UBX_SYNC2)
+      return ubxEncode((uint8_t)c);
+    ubxState = UBX_IDLE; // not a UBX frame after all, parse the byte as NMEA
+  }
+
   switch(c)
   {
   case ',': // term terminators
@@ -80,6 +97,7 @@ bool TinyGPSPlus::encode(char c)
   case '$': // sentence begin
     curTermNumber = curTermOffset = 0;
     parity = 0;
+    sentenceHash = _GPS_HASH_SEED;
     curSentenceType = GPS_SENTENCE_OTHER;
     isChecksumTerm = false;
     sentenceHasFix = false;
@@ -88,6 +106,8 @@ bool TinyGPSPlus::encode(char c)
   default: // ordinary characters
     if (curTermOffset < sizeof(term) - 1)
       term[curTermOffset++] = c;
+    if (curTermNumber == 0)
+      sentenceHash = _GPS_HASH_STEP(sentenceHash, c);
     if (!isChecksumTerm)
       parity ^= c;
     return false;
@@ -96,6 +116,126 @@ bool TinyGPSPlus::encode(char c)
   return false;
 }
 
+// Runs the UBX frame state machine on one byte, returning true when a valid frame ends
+bool TinyGPSPlus::ubxEncode(uint8_t c)
+{
+  // The Fletcher checksum covers everything from the class to the end of the payload
+  if (ubxState >= UBX_CLASS && ubxState <= UBX_PAYLOAD)
+  {
+    ubxCkA += c;
+    ubxCkB += ubxCkA;
+  }
+
+  switch(ubxState)
+  {
+  case UBX_IDLE:
+    ubxState = UBX_SYNC2;
+    break;
+  case UBX_SYNC2:
+    ubxCkA = ubxCkB = 0;
+    ubxState = UBX_CLASS;
+    break;
+  case UBX_CLASS:
+    ubxClass = c;
+    ubxState = UBX_ID;
+    break;
+  case UBX_ID:
+    ubxId = c;
+    ubxState = UBX_LENGTH1;
+    break;
+  case UBX_LENGTH1:
+    ubxLength = c;
+    ubxState = UBX_LENGTH2;
+    break;
+  case UBX_LENGTH2:
+    ubxLength |= (uint16_t)c << 8;
+    ubxOffset = 0;
+    ubxState = ubxLength == 0 ? UBX_CK_A : ubxLength <= _GPS_UBX_MAX_LEN ? UBX_PAYLOAD : UBX_IDLE;
+    break;
+  case UBX_PAYLOAD:
+    // Only the payload of NAV-PVT is kept, the rest is just checksummed
+    if (ubxOffset < sizeof(ubxPayload))
+      ubxPayload[ubxOffset] = c;
+    if (++ubxOffset == ubxLength)
+      ubxState = UBX_CK_A;
+    break;
+  case UBX_CK_A:
+    ubxState = c == ubxCkA ? UBX_CK_B : UBX_IDLE;
+    if (ubxState == UBX_IDLE)
+      ++failedChecksumCount;
+    break;
+  case UBX_CK_B:
+    ubxState = UBX_IDLE;
+    if (c != ubxCkB)
+    {
+      ++failedChecksumCount;
+      return false;
+    }
+    ++passedChecksumCount;
+    ++ubxFrameCount;
+    if (ubxClass == _GPS_UBX_CLASS_NAV && ubxId == _GPS_UBX_ID_NAV_PVT && ubxLength == _GPS_UBX_NAV_PVT_LEN)
+      ubxNavPvt();
+    return true;
+  }
+
+  return false;
+}
+
+// Little endian fields of the UBX payload
+static uint16_t ubxU2(const uint8_t *p)
+{
+  return p[0] | (uint16_t)p[1] << 8;
+}
+
+static int32_t ubxI4(const uint8_t *p)
+{
+  return (int32_t)(p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+}
+
+static void ubxDegrees(int32_t e7, RawDegrees &deg)
+{
+  uint32_t mag = e7 < 0 ? -(uint32_t)e7 : e7;
+  deg.deg = mag / 10000000UL;
+  deg.billionths = (mag % 10000000UL) * 100;
+  deg.negative = e7 < 0;
+}
+
+// Commits a NAV-PVT solution to the same objects as RMC and GGA, in the same units.
+// NAV-PVT has no HDOP, so hdop is only updated by GGA.
+void TinyGPSPlus::ubxNavPvt()
+{
+  const uint8_t *p = ubxPayload;
+  uint8_t valid = p[11];
+  bool hasFix = (p[21] & 0x01) != 0; // gnssFixOK
+
+  if (valid & 0x01) // validDate
+  {
+    date.newDate = p[7] * 10000UL + p[6] * 100UL + ubxU2(&p[4]) % 100;
+    date.commit();
+  }
+  if (valid & 0x02) // validTime
+  {
+    int32_t nano = ubxI4(&p[16]);
+    time.newTime = p[8] * 1000000UL + p[9] * 10000UL + p[10] * 100UL + (nano > 0 ? nano / 10000000L : 0);
+    time.commit();
+  }
+  if (hasFix)
+  {
+    ++sentencesWithFixCount;
+    ubxDegrees(ubxI4(&p[28]), location.rawNewLatData);
+    ubxDegrees(ubxI4(&p[24]), location.rawNewLngData);
+    location.commit();
+    altitude.newval = ubxI4(&p[36]) / 10;                       // mm to cm
+    altitude.commit();
+    speed.newval = ubxI4(&p[60]) * 90 / 463;                    // mm/s to 1/100 knot
+    speed.commit();
+    course.newval = ubxI4(&p[64]) / 1000;                       // 1e-5 to 1/100 degree
+    course.commit();
+  }
+  satellites.newval = p[23];
+  satellites.commit();
+}
+
 //
 // internal utilities
 //
@@ -115,8 +255,10 @@ int32_t TinyGPSPlus::parseDecimal(const char *term)
 {
   bool negative = *term == '-';
   if (negative) ++term;
-  int32_t ret = 100 * (int32_t)atol(term);
-  while (isdigit(*term)) ++term;
+  int32_t ret = 0;
+  while (isdigit(*term))
+    ret = 10 * ret + (*term++ - '0');
+  ret *= 100;
   if (*term == '.' && isdigit(term[1]))
   {
     ret += 10 * (term[1] - '0');
@@ -130,22 +272,21 @@ int32_t TinyGPSPlus::parseDecimal(const char *term)
 // Parse degrees in that funny NMEA format DDMM.MMMM
 void TinyGPSPlus::parseDegrees(const char *term, RawDegrees &deg)
 {
-  uint32_t leftOfDecimal = (uint32_t)atol(term);
+  // Place values of the decimals of the minutes, in ten millionths
+  static const uint32_t multipliers[] = {1000000UL, 100000UL, 10000UL, 1000UL, 100UL, 10UL, 1UL};
+  uint32_t leftOfDecimal = 0;
+
+  while (isdigit(*term))
+    leftOfDecimal = 10 * leftOfDecimal + (*term++ - '0');
+
   uint16_t minutes = (uint16_t)(leftOfDecimal % 100);
-  uint32_t multiplier = 10000000UL;
-  uint32_t tenMillionthsOfMinutes = minutes * multiplier;
+  uint32_t tenMillionthsOfMinutes = minutes * 10000000UL;
 
   deg.deg = (int16_t)(leftOfDecimal / 100);
 
-  while (isdigit(*term))
-    ++term;
-
   if (*term == '.')
-    while (isdigit(*++term))
-    {
-      multiplier /= 10;
-      tenMillionthsOfMinutes += (*term - '0') * multiplier;
-    }
+    for (uint8_t i = 0; isdigit(*++term) && i < sizeof(multipliers) / sizeof(multipliers[0]); ++i)
+      tenMillionthsOfMinutes += (*term - '0') * multipliers[i];
 
   deg.billionths = (5 * tenMillionthsOfMinutes + 1) / 3;
   deg.negative = false;
@@ -192,7 +333,7 @@ bool TinyGPSPlus::endOfTermHandler()
       }
 
       // Commit all custom listeners of this sentence type
-      for (TinyGPSCustom *p = customCandidates; p != NULL && strcmp(p->sentenceName, customCandidates->sentenceName) == 0; p = p->next)
+      for (TinyGPSCustom *p = customCandidates; p != NULL; p = nextCandidate(p))
          p->commit();
       return true;
     }
@@ -205,20 +346,31 @@ bool TinyGPSPlus::endOfTermHandler()
     return false;
   }
 
-  // the first term determines the sentence type
+  // the first term determines the sentence type, the name is only compared when its hash matches
   if (curTermNumber == 0)
   {
-    if (!strcmp(term, _GPRMCterm) || !strcmp(term, _GNRMCterm))
-      curSentenceType = GPS_SENTENCE_GPRMC;
-    else if (!strcmp(term, _GPGGAterm) || !strcmp(term, _GNGGAterm))
-      curSentenceType = GPS_SENTENCE_GPGGA;
-    else
+    switch (sentenceHash)
+    {
+    case hashSentence(_GPRMCterm):
+    case hashSentence(_GNRMCterm):
+      curSentenceType = !strcmp(term, _GPRMCterm) || !strcmp(term, _GNRMCterm) ? GPS_SENTENCE_GPRMC : GPS_SENTENCE_OTHER;
+      break;
+    case hashSentence(_GPGGAterm):
+    case hashSentence(_GNGGAterm):
+      curSentenceType = !strcmp(term, _GPGGAterm) || !strcmp(term, _GNGGAterm) ? GPS_SENTENCE_GPGGA : GPS_SENTENCE_OTHER;
+      break;
+    default:
       curSentenceType = GPS_SENTENCE_OTHER;
+      break;
+    }
 
-    // Any custom candidates of this sentence type?
-    for (customCandidates = customElts; customCandidates != NULL && strcmp(customCandidates->sentenceName, term) < 0; customCandidates = customCandidates->next);
-    if (customCandidates != NULL && strcmp(customCandidates->sentenceName, term) > 0)
+    // Any custom candidates of this sentence type? They are sorted by hash, then name
+    for (customCandidates = customElts; customCandidates != NULL && customCandidates->sentenceHash < sentenceHash; customCandidates = customCandidates->next);
+    while (customCandidates != NULL && customCandidates->sentenceHash == sentenceHash && strcmp(customCandidates->sentenceName, term) < 0)
+       customCandidates = customCandidates->next;
+    if (customCandidates != NULL && (customCandidates->sentenceHash != sentenceHash || strcmp(customCandidates->sentenceName, term) != 0))
        customCandidates = NULL;
+    customCursor = customCandidates;
 
     return false;
   }
@@ -272,14 +424,26 @@ bool TinyGPSPlus::endOfTermHandler()
       break;
   }
 
-  // Set custom values as needed
-  for (TinyGPSCustom *p = customCandidates; p != NULL && strcmp(p->sentenceName, customCandidates->sentenceName) == 0 && p->termNumber <= curTermNumber; p = p->next)
-    if (p->termNumber == curTermNumber)
-         p->set(term);
+  // Set custom values as needed. Terms arrive in order, so the cursor only moves forward
+  while (customCursor != NULL && customCursor->termNumber < curTermNumber)
+    customCursor = nextCandidate(customCursor);
+  for (TinyGPSCustom *p = customCursor; p != NULL && p->termNumber == curTermNumber; p = nextCandidate(p))
+    p->set(term);
 
   return false;
 }
 
+// Returns the custom element after p if it belongs to the same sentence as the candidates, else NULL
+TinyGPSCustom *TinyGPSPlus::nextCandidate(TinyGPSCustom *p)
+{
+  p = p->next;
+  if (p == NULL || p->sentenceHash != customCandidates->sentenceHash)
+    return NULL;
+  if (p->sentenceName != customCandidates->sentenceName && strcmp(p->sentenceName, customCandidates->sentenceName) != 0)
+    return NULL;
+  return p;
+}
+
 /* static */
 double TinyGPSPlus::distanceBetween(double lat1, double long1, double lat2, double long2)
 {
@@ -466,6 +630,7 @@ void TinyGPSCustom::begin(TinyGPSPlus &gps, const char *_sentenceName, int _term
    lastCommitTime = 0;
    updated = valid = false;
    sentenceName = _sentenceName;
+   sentenceHash = hashSentence(_sentenceName);
    termNumber = _termNumber;
    memset(stagingBuffer, '\0', sizeof(stagingBuffer));
    memset(buffer, '\0', sizeof(buffer));
@@ -490,8 +655,15 @@ void TinyGPSPlus::insertCustom(TinyGPSCustom *pElt, const char *sentenceName, in
 {
    TinyGPSCustom **ppelt;
 
+   // Sorted by sentence hash, then name, then term number
    for (ppelt = &this->customElts; *ppelt != NULL; ppelt = &(*ppelt)->next)
    {
+      if (pElt->sentenceHash != (*ppelt)->sentenceHash)
+      {
+         if (pElt->sentenceHash < (*ppelt)->sentenceHash)
+            break;
+         continue;
+      }
       int cmp = strcmp(sentenceName, (*ppelt)->sentenceName);
       if (cmp < 0 || (cmp == 0 && termNumber < (*ppelt)->termNumber))
          break;
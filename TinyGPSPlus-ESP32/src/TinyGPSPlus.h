@@ -40,6 +40,18 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #define _GPS_FEET_PER_METER 3.2808399
 #define _GPS_MAX_FIELD_SIZE 15
 
+// Hash of a sentence name, accumulated as the name is received
+#define _GPS_HASH_SEED 5381
+#define _GPS_HASH_STEP(h, c) ((uint16_t)(((h) << 5) + (h) + (uint8_t)(c)))
+
+// u-blox UBX binary protocol, decoded alongside NMEA
+#define _GPS_UBX_SYNC1 0xB5
+#define _GPS_UBX_SYNC2 0x62
+#define _GPS_UBX_CLASS_NAV 0x01
+#define _GPS_UBX_ID_NAV_PVT 0x07
+#define _GPS_UBX_NAV_PVT_LEN 92
+#define _GPS_UBX_MAX_LEN 1024 // longer frames are taken to be noise
+
 struct RawDegrees
 {
    uint16_t deg;
@@ -211,6 +223,7 @@ private:
    unsigned long lastCommitTime;
    bool valid, updated;
    const char *sentenceName;
+   uint16_t sentenceHash;
    int termNumber;
    friend class TinyGPSPlus;
    TinyGPSCustom *next;
@@ -245,6 +258,7 @@ public:
   uint32_t sentencesWithFix() const { return sentencesWithFixCount; }
   uint32_t failedChecksum()   const { return failedChecksumCount; }
   uint32_t passedChecksum()   const { return passedChecksumCount; }
+  uint32_t ubxFrames()        const { return ubxFrameCount; }
 
 private:
   enum {GPS_SENTENCE_GPGGA, GPS_SENTENCE_GPRMC, GPS_SENTENCE_OTHER};
@@ -253,6 +267,7 @@ private:
   uint8_t parity;
   bool isChecksumTerm;
   char term[_GPS_MAX_FIELD_SIZE];
+  uint16_t sentenceHash;
   uint8_t curSentenceType;
   uint8_t curTermNumber;
   uint8_t curTermOffset;
@@ -262,13 +277,28 @@ private:
   friend class TinyGPSCustom;
   TinyGPSCustom *customElts;
   TinyGPSCustom *customCandidates;
+  TinyGPSCustom *customCursor;
   void insertCustom(TinyGPSCustom *pElt, const char *sentenceName, int index);
+  TinyGPSCustom *nextCandidate(TinyGPSCustom *p);
+
+  // UBX parsing state
+  enum {UBX_IDLE, UBX_SYNC2, UBX_CLASS, UBX_ID, UBX_LENGTH1, UBX_LENGTH2, UBX_PAYLOAD, UBX_CK_A, UBX_CK_B};
+  uint8_t ubxState;
+  uint8_t ubxClass;
+  uint8_t ubxId;
+  uint16_t ubxLength;
+  uint16_t ubxOffset;
+  uint8_t ubxCkA, ubxCkB;
+  uint8_t ubxPayload[_GPS_UBX_NAV_PVT_LEN];
+  bool ubxEncode(uint8_t c);
+  void ubxNavPvt();
 
   // statistics
   uint32_t encodedCharCount;
   uint32_t sentencesWithFixCount;
   uint32_t failedChecksumCount;
   uint32_t passedChecksumCount;
+  uint32_t ubxFrameCount;
 
   // internal utilities
   int fromHex(char a);
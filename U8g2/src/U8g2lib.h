@@ -211,6 +211,13 @@ class U8G2
       { u8g2_UpdateDisplay(&u8g2); }
     void refreshDisplay(void)
       { u8x8_RefreshDisplay(u8g2_GetU8x8(&u8g2)); }
+
+#ifdef U8G2_WITH_DIRTY_TILES
+    /* buf: getDirtyTileBufferSize() bytes, sendBuffer() will only send the changed tiles */
+    void setDirtyTileBuffer(uint8_t *buf) { u8g2_SetDirtyTileBuffer(&u8g2, buf); }
+    uint16_t getDirtyTileBufferSize(void) { return u8g2_GetDirtyTileBufferSize(&u8g2); }
+    void setAllTilesDirty(void) { u8g2_SetAllTilesDirty(&u8g2); }
+#endif /* U8G2_WITH_DIRTY_TILES */
     
 
 
@@ -268,6 +275,10 @@ class U8G2
 
     void setFont(const uint8_t  *font) {u8g2_SetFont(&u8g2, font); }
     void setFontMode(uint8_t  is_transparent) {u8g2_SetFontMode(&u8g2, is_transparent); }
+#ifdef U8G2_WITH_GLYPH_CACHE
+    void setGlyphCache(uint8_t *buf, uint16_t size) { u8g2_SetGlyphCache(&u8g2, buf, size); }
+    void clearGlyphCache(void) { u8g2_ClearGlyphCache(&u8g2); }
+#endif /* U8G2_WITH_GLYPH_CACHE */
     void setFontDirection(uint8_t dir) {u8g2_SetFontDirection(&u8g2, dir); }
 
     int8_t getAscent(void) { return u8g2_GetAscent(&u8g2); }
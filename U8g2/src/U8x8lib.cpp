@@ -882,7 +882,7 @@ extern "C" uint8_t u8x8_byte_arduino_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t a
 {
 #ifdef U8X8_HAVE_HW_SPI
 	
-#if !defined(ESP_PLATFORM)
+#if !defined(ESP_PLATFORM) && !(defined(ARDUINO_ARCH_RP2040) && !defined(ARDUINO_ARCH_MBED)) && !defined(ARDUINO_SAMD_ADAFRUIT)
   uint8_t *data;
 #endif
 
@@ -897,6 +897,12 @@ extern "C" uint8_t u8x8_byte_arduino_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t a
 #if defined(ESP_PLATFORM)
       //T.M.L 2023-02-28: use the block transfer function on ESP, which does not overwrite the buffer.
       SPI.writeBytes((uint8_t*)arg_ptr, arg_int);  
+#elif defined(ARDUINO_ARCH_RP2040) && !defined(ARDUINO_ARCH_MBED)
+      /* arduino-pico: block transfer without receive buffer, the data is not overwritten */
+      SPI.transfer((const void *)arg_ptr, (void *)NULL, arg_int);
+#elif defined(ARDUINO_SAMD_ADAFRUIT)
+      /* Adafruit SAMD core: block transfer without receive buffer, the data is not overwritten */
+      SPI.transfer((const void *)arg_ptr, (void *)NULL, arg_int, true);
 #else    
       // 1.6.5 offers a block transfer, but the problem is, that the
       // buffer is overwritten with the incoming data
@@ -1007,6 +1013,63 @@ extern "C" uint8_t u8x8_byte_arduino_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t a
   return 1;
 }
 
+/*=============================================*/
+/*=== 4 WIRE HARDWARE SPI WITH DMA ===*/
+
+/*
+  Same as u8x8_byte_arduino_hw_spi, but U8X8_MSG_BYTE_SEND returns while the data is still sent by DMA.
+  The data is copied to one of two buffers, so that the next block (e.g. the next part of a tile row)
+  is prepared while the previous block is on the bus. The transfer is completed before DC or CS are changed,
+  so the CPU is free while the data of each tile row is sent.
+  Without U8X8_HAVE_HW_SPI_DMA this is identical to u8x8_byte_arduino_hw_spi.
+*/
+#ifdef U8X8_HAVE_HW_SPI_DMA
+static uint8_t u8x8_hw_spi_dma_buf[2][256];
+static uint8_t u8x8_hw_spi_dma_idx = 0;
+static uint8_t u8x8_hw_spi_dma_busy = 0;
+
+static void u8x8_hw_spi_dma_wait(void)
+{
+  if ( u8x8_hw_spi_dma_busy == 0 )
+    return;
+#if defined(ARDUINO_ARCH_RP2040)
+  while( !SPI.finishedAsync() )
+    ;
+#else
+  SPI.waitForTransfer();
+#endif
+  u8x8_hw_spi_dma_busy = 0;
+}
+#endif /* U8X8_HAVE_HW_SPI_DMA */
+
+extern "C" uint8_t u8x8_byte_arduino_hw_spi_dma(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+#ifdef U8X8_HAVE_HW_SPI_DMA
+  uint8_t *buf;
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      /* arg_ptr may point to a local variable of the caller, so the data is copied */
+      buf = u8x8_hw_spi_dma_buf[u8x8_hw_spi_dma_idx];
+      memcpy(buf, arg_ptr, arg_int);
+      u8x8_hw_spi_dma_wait();
+#if defined(ARDUINO_ARCH_RP2040)
+      SPI.transferAsync((const void *)buf, (void *)NULL, arg_int);
+#else
+      SPI.transfer((const void *)buf, (void *)NULL, arg_int, false);
+#endif
+      u8x8_hw_spi_dma_busy = 1;
+      u8x8_hw_spi_dma_idx ^= 1;
+      return 1;
+    case U8X8_MSG_BYTE_SET_DC:
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      u8x8_hw_spi_dma_wait();
+      break;
+  }
+#endif /* U8X8_HAVE_HW_SPI_DMA */
+  return u8x8_byte_arduino_hw_spi(u8x8, msg, arg_int, arg_ptr);
+}
+
 
 /* issue #244 */
 extern "C" uint8_t u8x8_byte_arduino_2nd_hw_spi(U8X8_UNUSED u8x8_t *u8x8, U8X8_UNUSED uint8_t msg, U8X8_UNUSED uint8_t arg_int, U8X8_UNUSED void *arg_ptr)
@@ -153,6 +153,26 @@
 #endif
 #endif
 
+/* 
+  define U8X8_HAVE_HW_SPI_DMA if the SPI library can send a block in the background:
+    RP2040 with the arduino-pico core: SPI.transferAsync()
+    SAMD with the Adafruit core: SPI.transfer(txbuf, rxbuf, count, false)
+  The DMA is used by u8x8_byte_arduino_hw_spi_dma(), which can replace u8x8_byte_arduino_hw_spi()
+  before calling begin():
+    u8g2.getU8x8()->byte_cb = u8x8_byte_arduino_hw_spi_dma;
+  Define U8X8_NO_HW_SPI_DMA to send the data with SPI.transfer() only.
+*/
+#ifdef U8X8_HAVE_HW_SPI
+#ifndef U8X8_NO_HW_SPI_DMA
+#if defined(ARDUINO_ARCH_RP2040) && !defined(ARDUINO_ARCH_MBED)
+#define U8X8_HAVE_HW_SPI_DMA
+#endif
+#if defined(ARDUINO_SAMD_ADAFRUIT)
+#define U8X8_HAVE_HW_SPI_DMA
+#endif
+#endif
+#endif /* U8X8_HAVE_HW_SPI */
+
 
 extern "C" uint8_t u8x8_gpio_and_delay_arduino(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 extern "C" uint8_t u8x8_byte_arduino_8bit_8080mode(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
@@ -161,6 +181,7 @@ extern "C" uint8_t u8x8_byte_arduino_3wire_sw_spi(u8x8_t *u8x8, uint8_t msg, uin
 extern "C" uint8_t u8x8_byte_arduino_3wire_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 extern "C" uint8_t u8x8_byte_arduino_hw_spi(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 extern "C" uint8_t u8x8_byte_arduino_2nd_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr); /* #244 */
+extern "C" uint8_t u8x8_byte_arduino_hw_spi_dma(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 extern "C" uint8_t u8x8_byte_arduino_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 extern "C" uint8_t u8x8_byte_arduino_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 extern "C" uint8_t u8x8_byte_arduino_2nd_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
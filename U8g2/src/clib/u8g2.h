@@ -120,6 +120,30 @@
 #define U8G2_WITH_CLIP_WINDOW_SUPPORT
 #endif
 
+/*
+  Enable dirty tile tracking for the full buffer mode:
+    void u8g2_SetDirtyTileBuffer(u8g2_t *u8g2, uint8_t *buf)
+    void u8g2_SetAllTilesDirty(u8g2_t *u8g2)
+  With a dirty tile buffer assigned, the draw procedures mark the 8x8 tiles they touch
+  and u8g2_SendBuffer() will only send the changed tiles.
+  Dirty tile tracking requires about 250 bytes flash memory on AVR systems
+*/
+#ifndef U8G2_WITHOUT_DIRTY_TILES
+#define U8G2_WITH_DIRTY_TILES
+#endif
+
+/*
+  Enable the cache for decoded glyphs:
+    void u8g2_SetGlyphCache(u8g2_t *u8g2, uint8_t *buf, uint16_t size)
+    void u8g2_ClearGlyphCache(u8g2_t *u8g2)
+  With a cache memory assigned, u8g2_DrawGlyph() and the string procedures decode each glyph once 
+  into a bitmap and draw it from there, until the cache is full and cleared.
+  Without cache memory, glyphs are decoded from the compressed font data each time.
+*/
+#ifndef U8G2_WITHOUT_GLYPH_CACHE
+#define U8G2_WITH_GLYPH_CACHE
+#endif
+
 /*
   The following macro enables all four drawing directions for glyphs and strings.
   If this macro is not defined, than a string can be drawn only in horizontal direction.
@@ -289,6 +313,22 @@ struct _u8g2_font_decode_t
 };
 typedef struct _u8g2_font_decode_t u8g2_font_decode_t;
 
+#ifdef U8G2_WITH_GLYPH_CACHE
+/* header of a decoded glyph inside the glyph cache, followed by the bitmap (rows of (glyph_width+7)/8 bytes, MSB first) */
+struct _u8g2_glyph_cache_entry_t
+{
+  const uint8_t *font;
+  uint16_t encoding;
+  uint16_t size;			/* size of the entry including the bitmap, multiple of the size of a pointer */
+  int8_t glyph_width;
+  int8_t glyph_height;
+  int8_t x;				/* glyph offset, same as in the font data */
+  int8_t y;
+  int8_t delta_x;
+};
+typedef struct _u8g2_glyph_cache_entry_t u8g2_glyph_cache_entry_t;
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
 struct _u8g2_kerning_t
 {
   uint16_t first_table_cnt;
@@ -383,6 +423,16 @@ struct u8g2_struct
 	// the following variable should be renamed to is_buffer_auto_clear
   uint8_t is_auto_page_clear; 		/* set to 0 to disable automatic clear of the buffer in firstPage() and nextPage() */
   
+#ifdef U8G2_WITH_DIRTY_TILES
+  uint8_t *dirty_tile_ptr;	/* one bit per tile of the full buffer, NULL if dirty tile tracking is not used */
+#endif /* U8G2_WITH_DIRTY_TILES */
+
+#ifdef U8G2_WITH_GLYPH_CACHE
+  uint8_t *glyph_cache_ptr;	/* memory for decoded glyphs, NULL if the glyph cache is not used */
+  uint16_t glyph_cache_size;
+  uint16_t glyph_cache_used;
+#endif /* U8G2_WITH_GLYPH_CACHE */
+  
 };
 
 #define u8g2_GetU8x8(u8g2) ((u8x8_t *)(u8g2))
@@ -1731,6 +1781,14 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2);
 void u8g2_UpdateDisplayArea(u8g2_t *u8g2, uint8_t  tx, uint8_t ty, uint8_t tw, uint8_t th);
 void u8g2_UpdateDisplay(u8g2_t *u8g2);
 
+#ifdef U8G2_WITH_DIRTY_TILES
+/* size of the dirty tile buffer in bytes: one bit per tile */
+#define u8g2_GetDirtyTileBufferSize(u8g2) ((u8g2_GetU8x8(u8g2)->display_info->tile_width * u8g2_GetU8x8(u8g2)->display_info->tile_height + 7) / 8)
+void u8g2_SetDirtyTileBuffer(u8g2_t *u8g2, uint8_t *buf);
+void u8g2_SetAllTilesDirty(u8g2_t *u8g2);
+void u8g2_MarkDirtyTiles(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+#endif /* U8G2_WITH_DIRTY_TILES */
+
 void u8g2_WriteBufferPBM(u8g2_t *u8g2, void (*out)(const char *s));
 void u8g2_WriteBufferXBM(u8g2_t *u8g2, void (*out)(const char *s));
 /* SH1122, LD7032, ST7920, ST7986, LC7981, T6963, SED1330, RA8835, MAX7219, LS0 */ 
@@ -1878,6 +1936,11 @@ size_t u8g2_GetFontSize(const uint8_t *font_arg);
 void u8g2_SetFont(u8g2_t *u8g2, const uint8_t  *font);
 void u8g2_SetFontMode(u8g2_t *u8g2, uint8_t is_transparent);
 
+#ifdef U8G2_WITH_GLYPH_CACHE
+void u8g2_SetGlyphCache(u8g2_t *u8g2, uint8_t *buf, uint16_t size);
+void u8g2_ClearGlyphCache(u8g2_t *u8g2);
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
 uint8_t u8g2_IsGlyph(u8g2_t *u8g2, uint16_t requested_encoding);
 int8_t u8g2_GetGlyphWidth(u8g2_t *u8g2, uint16_t requested_encoding);
 
@@ -37,9 +37,173 @@
 #include <string.h>
 
 /*============================================*/
+#ifdef U8G2_WITH_DIRTY_TILES
+/*============================================*/
+/*
+  Dirty tile tracking for the full buffer mode.
+  The dirty tile buffer has one bit per tile (tile_width * tile_height bits, see u8g2_GetDirtyTileBufferSize),
+  bit (tx & 7) of byte (ty*tile_width+tx)/8 is set if tile tx/ty differs from the display.
+  u8g2_draw_hv_line_2dir() marks all tiles touched by a line, u8g2_ClearBuffer() marks all tiles which are not empty.
+  u8g2_SendBuffer() sends the dirty tiles of each tile row as runs of adjacent tiles and clears the dirty tile buffer.
+
+  Limitations (same as u8g2_UpdateDisplayArea):
+    - Only available in full buffer mode (the buffer is not assigned in page mode)
+    - Only used for displays with the SSD13xx memory layout (u8g2_ll_hvline_vertical_top_lsb),
+      otherwise u8g2_SendBuffer() sends the complete buffer
+    - Direct changes to the buffer (u8g2_GetBufferPtr) require u8g2_SetAllTilesDirty()
+*/
+
+static uint8_t u8g2_is_dirty_tile_mode(u8g2_t *u8g2)
+{
+  if ( u8g2->dirty_tile_ptr == NULL )
+    return 0;
+  if ( u8g2->tile_buf_height != u8g2_GetU8x8(u8g2)->display_info->tile_height )
+    return 0;
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+    return 0;
+  return 1;
+}
+
+static void u8g2_set_dirty_tile(u8g2_t *u8g2, uint8_t tx, uint8_t ty)
+{
+  uint16_t idx;
+  idx = ty;
+  idx *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  idx += tx;
+  u8g2->dirty_tile_ptr[idx >> 3] |= 1 << (idx & 7);
+}
+
+static uint8_t u8g2_is_dirty_tile(u8g2_t *u8g2, uint8_t tx, uint8_t ty)
+{
+  uint16_t idx;
+  idx = ty;
+  idx *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  idx += tx;
+  return (u8g2->dirty_tile_ptr[idx >> 3] >> (idx & 7)) & 1;
+}
+
+/*
+  buf: memory area with u8g2_GetDirtyTileBufferSize(u8g2) bytes or NULL to disable dirty tile tracking
+  All tiles are marked as dirty, so that the next u8g2_SendBuffer() will send the complete buffer.
+  Will not do anything in page mode or for other memory layouts.
+*/
+void u8g2_SetDirtyTileBuffer(u8g2_t *u8g2, uint8_t *buf)
+{
+  u8g2->dirty_tile_ptr = buf;
+  if ( u8g2_is_dirty_tile_mode(u8g2) == 0 )
+    u8g2->dirty_tile_ptr = NULL;
+  u8g2_SetAllTilesDirty(u8g2);
+}
+
+void u8g2_SetAllTilesDirty(u8g2_t *u8g2)
+{
+  if ( u8g2->dirty_tile_ptr != NULL )
+    memset(u8g2->dirty_tile_ptr, 0xff, u8g2_GetDirtyTileBufferSize(u8g2));
+}
+
+/*
+  x,y		Upper left position of the line within the buffer, all clipping done
+  len		length of the line in pixel, len must not be 0
+  dir		0: horizontal line (left to right)
+		1: vertical line (top to bottom)
+*/
+void u8g2_MarkDirtyTiles(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  uint8_t tx, ty, tx1, ty1;
+  
+  tx = x >> 3;
+  ty = y >> 3;
+  tx1 = tx;
+  ty1 = ty;
+  if ( dir == 0 )
+    tx1 = (x+len-1) >> 3;
+  else
+    ty1 = (y+len-1) >> 3;
+  
+  if ( ty1 >= u8g2->tile_buf_height )
+    ty1 = u8g2->tile_buf_height-1;
+  if ( tx1 >= u8g2_GetU8x8(u8g2)->display_info->tile_width )
+    tx1 = u8g2_GetU8x8(u8g2)->display_info->tile_width-1;
+  
+  for(;;)
+  {
+    uint8_t i = tx;
+    for(;;)
+    {
+      u8g2_set_dirty_tile(u8g2, i, ty);
+      if ( i >= tx1 )
+        break;
+      i++;
+    }
+    if ( ty >= ty1 )
+      break;
+    ty++;
+  }
+}
+
+/* a tile which is not empty will change with u8g2_ClearBuffer() */
+static void u8g2_mark_nonempty_tiles(u8g2_t *u8g2)
+{
+  uint8_t *ptr = u8g2->tile_buf_ptr;
+  uint8_t w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  uint8_t tx, ty, i;
+  
+  for( ty = 0; ty < u8g2->tile_buf_height; ty++ )
+  {
+    for( tx = 0; tx < w; tx++ )
+    {
+      for( i = 0; i < 8; i++ )
+      {
+        if ( ptr[i] != 0 )
+        {
+          u8g2_set_dirty_tile(u8g2, tx, ty);
+          break;
+        }
+      }
+      ptr += 8;
+    }
+  }
+}
+
+/* send the dirty tiles, adjacent dirty tiles in a tile row are sent with one u8x8_DrawTile() */
+static void u8g2_send_dirty_tiles(u8g2_t *u8g2)
+{
+  uint8_t *ptr;
+  uint8_t w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  uint8_t tx, ty, start;
+  
+  ptr = u8g2->tile_buf_ptr;
+  for( ty = 0; ty < u8g2->tile_buf_height; ty++ )
+  {
+    tx = 0;
+    while( tx < w )
+    {
+      if ( u8g2_is_dirty_tile(u8g2, tx, ty) )
+      {
+        start = tx;
+        while( tx < w && u8g2_is_dirty_tile(u8g2, tx, ty) )
+          tx++;
+        u8x8_DrawTile(u8g2_GetU8x8(u8g2), start, ty, tx-start, ptr+start*8);
+      }
+      else
+      {
+        tx++;
+      }
+    }
+    ptr += u8g2->pixel_buf_width;
+  }
+  memset(u8g2->dirty_tile_ptr, 0, u8g2_GetDirtyTileBufferSize(u8g2));
+}
+
+#endif /* U8G2_WITH_DIRTY_TILES */
+
 void u8g2_ClearBuffer(u8g2_t *u8g2)
 {
   size_t cnt;
+#ifdef U8G2_WITH_DIRTY_TILES
+  if ( u8g2->dirty_tile_ptr != NULL )
+    u8g2_mark_nonempty_tiles(u8g2);
+#endif /* U8G2_WITH_DIRTY_TILES */
   cnt = u8g2_GetU8x8(u8g2)->display_info->tile_width;
   cnt *= u8g2->tile_buf_height;
   cnt *= 8;
@@ -92,6 +256,11 @@ static void u8g2_send_buffer(u8g2_t *u8g2)
 /* same as u8g2_send_buffer but also send the DISPLAY_REFRESH message (used by SSD1606) */
 void u8g2_SendBuffer(u8g2_t *u8g2)
 {
+#ifdef U8G2_WITH_DIRTY_TILES
+  if ( u8g2_is_dirty_tile_mode(u8g2) )
+    u8g2_send_dirty_tiles(u8g2);
+  else
+#endif /* U8G2_WITH_DIRTY_TILES */
   u8g2_send_buffer(u8g2);
   u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );  
 }
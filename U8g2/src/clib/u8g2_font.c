@@ -34,6 +34,7 @@
 */
 
 #include "u8g2.h"
+#include <string.h>
 
 /* size of the font data structure, there is no struct or class... */
 /* this is the size for the new font format */
@@ -597,58 +598,42 @@ static void u8g2_font_setup_decode(u8g2_t *u8g2, const uint8_t *glyph_data)
 
 /*
   Description:
-    Decode and draw a glyph.
+    Move the target position to the upper left corner of the glyph
+    and check whether the glyph intersects with the current page.
   Args:
-    glyph_data: 					Pointer to the compressed glyph data of the font
+    x, y, h: 					glyph offset and height from the font data
     u8g2->font_decode.target_x		X position
     u8g2->font_decode.target_y		Y position
-    u8g2->font_decode.is_transparent	Transparent mode
   Return:
-    Width (delta x advance) of the glyph.
-  Calls:
-    u8g2_font_decode_len()
+    0 if the glyph is not visible
 */
-/* optimized */
-int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
+static uint8_t u8g2_font_place_glyph(u8g2_t *u8g2, int8_t x, int8_t y, int8_t h)
 {
-  uint8_t a, b;
-  int8_t x, y;
-  int8_t d;
-  int8_t h;
   u8g2_font_decode_t *decode = &(u8g2->font_decode);
-    
-  u8g2_font_setup_decode(u8g2, glyph_data);     /* set values in u8g2->font_decode data structure */
-  h = u8g2->font_decode.glyph_height;
   
-  x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
-  y = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
-  d = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
-  
-  if ( decode->glyph_width > 0 )
-  {
 #ifdef U8G2_WITH_FONT_ROTATION
-    decode->target_x = u8g2_add_vector_x(decode->target_x, x, -(h+y), decode->dir);
-    decode->target_y = u8g2_add_vector_y(decode->target_y, x, -(h+y), decode->dir);
-    
-    //u8g2_add_vector(&(decode->target_x), &(decode->target_y), x, -(h+y), decode->dir);
+  decode->target_x = u8g2_add_vector_x(decode->target_x, x, -(h+y), decode->dir);
+  decode->target_y = u8g2_add_vector_y(decode->target_y, x, -(h+y), decode->dir);
+  
+  //u8g2_add_vector(&(decode->target_x), &(decode->target_y), x, -(h+y), decode->dir);
 
 #else
-    decode->target_x += x;
-    decode->target_y -= h+y;
+  decode->target_x += x;
+  decode->target_y -= h+y;
 #endif
-    //u8g2_add_vector(&(decode->target_x), &(decode->target_y), x, -(h+y), decode->dir);
+  //u8g2_add_vector(&(decode->target_x), &(decode->target_y), x, -(h+y), decode->dir);
 
 #ifdef U8G2_WITH_INTERSECTION
-    {
-      u8g2_uint_t x0, x1, y0, y1;
-      x0 = decode->target_x;
-      y0 = decode->target_y;
-      x1 = x0;
-      y1 = y0;
-      
+  {
+    u8g2_uint_t x0, x1, y0, y1;
+    x0 = decode->target_x;
+    y0 = decode->target_y;
+    x1 = x0;
+    y1 = y0;
+    
 #ifdef U8G2_WITH_FONT_ROTATION
-      switch(decode->dir)
-      {
+    switch(decode->dir)
+    {
 	case 0:
 	    x1 += decode->glyph_width;
 	    y1 += h;
@@ -673,16 +658,52 @@ int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
 	    y0++;	/* shift down, because of assymetric boundaries for the interseciton test */
 	    y1++;
 	    break;	  
-      }
+    }
 #else /* U8G2_WITH_FONT_ROTATION */
-      x1 += decode->glyph_width;
-      y1 += h;      
+    x1 += decode->glyph_width;
+    y1 += h;      
 #endif
-      
-      if ( u8g2_IsIntersection(u8g2, x0, y0, x1, y1) == 0 ) 
-	return d;
-    }
+    
+    if ( u8g2_IsIntersection(u8g2, x0, y0, x1, y1) == 0 ) 
+	return 0;
+  }
 #endif /* U8G2_WITH_INTERSECTION */
+  return 1;
+}
+
+/*
+  Description:
+    Decode and draw a glyph.
+  Args:
+    glyph_data: 					Pointer to the compressed glyph data of the font
+    u8g2->font_decode.target_x		X position
+    u8g2->font_decode.target_y		Y position
+    u8g2->font_decode.is_transparent	Transparent mode
+  Return:
+    Width (delta x advance) of the glyph.
+  Calls:
+    u8g2_font_decode_len()
+*/
+/* optimized */
+int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
+{
+  uint8_t a, b;
+  int8_t x, y;
+  int8_t d;
+  int8_t h;
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+    
+  u8g2_font_setup_decode(u8g2, glyph_data);     /* set values in u8g2->font_decode data structure */
+  h = u8g2->font_decode.glyph_height;
+  
+  x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
+  y = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
+  d = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
+  
+  if ( decode->glyph_width > 0 )
+  {
+    if ( u8g2_font_place_glyph(u8g2, x, y, h) == 0 )
+      return d;
    
     /* reset local x/y position */
     decode->x = 0;
@@ -710,6 +731,232 @@ int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
 }
 
 
+#ifdef U8G2_WITH_GLYPH_CACHE
+/*========================================================================*/
+/* glyph cache */
+
+/*
+  The glyph cache is a memory area provided by the user. It contains a sequence of 
+  u8g2_glyph_cache_entry_t, each followed by the decoded bitmap of the glyph.
+  A glyph is decoded into the cache when it is drawn for the first time.
+  If there is not enough space for a new glyph, the complete cache is cleared.
+  Glyphs which do not fit into the empty cache are decoded directly.
+  The cache is only used for u8g2_DrawGlyph() and the string procedures, not for the X2 procedures.
+*/
+
+void u8g2_SetGlyphCache(u8g2_t *u8g2, uint8_t *buf, uint16_t size)
+{
+  /* the entries contain a pointer, so the cache must start at a suitable address */
+  while( buf != NULL && size > 0 && ((size_t)buf % sizeof(const uint8_t *)) != 0 )
+  {
+    buf++;
+    size--;
+  }
+  u8g2->glyph_cache_ptr = buf;
+  u8g2->glyph_cache_size = size;
+  u8g2->glyph_cache_used = 0;
+}
+
+void u8g2_ClearGlyphCache(u8g2_t *u8g2)
+{
+  u8g2->glyph_cache_used = 0;
+}
+
+static const u8g2_glyph_cache_entry_t *u8g2_font_find_cached_glyph(u8g2_t *u8g2, uint16_t encoding)
+{
+  const u8g2_glyph_cache_entry_t *entry;
+  uint16_t pos = 0;
+  
+  while( pos < u8g2->glyph_cache_used )
+  {
+    entry = (const u8g2_glyph_cache_entry_t *)(u8g2->glyph_cache_ptr + pos);
+    if ( entry->encoding == encoding && entry->font == u8g2->font )
+      return entry;
+    pos += entry->size;
+  }
+  return NULL;
+}
+
+/* same as u8g2_font_decode_len(), but sets the foreground pixel in the bitmap */
+static void u8g2_font_decode_bitmap_len(u8g2_t *u8g2, uint8_t *bitmap, uint8_t len, uint8_t is_foreground)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  uint8_t bytes_per_row = ((uint8_t)decode->glyph_width+7) >> 3;
+  uint8_t lx = decode->x;
+  uint8_t ly = decode->y;
+  
+  while( len > 0 )
+  {
+    if ( is_foreground && ly < (uint8_t)decode->glyph_height )
+      bitmap[ly*bytes_per_row + (lx >> 3)] |= 0x80 >> (lx & 7);
+    lx++;
+    if ( lx >= (uint8_t)decode->glyph_width )
+    {
+      lx = 0;
+      ly++;
+    }
+    len--;
+  }
+  decode->x = lx;
+  decode->y = ly;
+}
+
+static const u8g2_glyph_cache_entry_t *u8g2_font_add_cached_glyph(u8g2_t *u8g2, uint16_t encoding, const uint8_t *glyph_data)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  u8g2_glyph_cache_entry_t *entry;
+  uint8_t *bitmap;
+  uint16_t size;
+  uint8_t a, b;
+  
+  u8g2_font_setup_decode(u8g2, glyph_data);
+  
+  size = ((uint8_t)decode->glyph_width+7) >> 3;
+  size *= (uint8_t)decode->glyph_height;
+  size += sizeof(u8g2_glyph_cache_entry_t);
+  size += sizeof(const uint8_t *)-1;
+  size -= size % sizeof(const uint8_t *);
+  
+  if ( size > u8g2->glyph_cache_size )
+    return NULL;	/* does not fit into the cache */
+  if ( size > u8g2->glyph_cache_size - u8g2->glyph_cache_used )
+    u8g2->glyph_cache_used = 0;	/* cache is full, start again */
+  
+  entry = (u8g2_glyph_cache_entry_t *)(u8g2->glyph_cache_ptr + u8g2->glyph_cache_used);
+  bitmap = (uint8_t *)(entry+1);
+  memset(bitmap, 0, size - sizeof(u8g2_glyph_cache_entry_t));
+  
+  entry->font = u8g2->font;
+  entry->encoding = encoding;
+  entry->size = size;
+  entry->glyph_width = decode->glyph_width;
+  entry->glyph_height = decode->glyph_height;
+  entry->x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
+  entry->y = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
+  entry->delta_x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
+  
+  if ( decode->glyph_width > 0 )
+  {
+    decode->x = 0;
+    decode->y = 0;
+    for(;;)
+    {
+      a = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_0);
+      b = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_1);
+      do
+      {
+	u8g2_font_decode_bitmap_len(u8g2, bitmap, a, 0);
+	u8g2_font_decode_bitmap_len(u8g2, bitmap, b, 1);
+      } while( u8g2_font_decode_get_unsigned_bits(decode, 1) != 0 );
+
+      if ( decode->y >= decode->glyph_height )
+	break;
+    }
+  }
+  
+  u8g2->glyph_cache_used += size;
+  return entry;
+}
+
+/* draw a horizontal run of a cached glyph, see u8g2_font_decode_len() */
+static void u8g2_font_draw_cached_len(u8g2_t *u8g2, uint8_t lx, uint8_t ly, uint8_t len, uint8_t is_foreground)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  u8g2_uint_t x, y;
+  
+  if ( is_foreground )
+    u8g2->draw_color = decode->fg_color;			/* draw_color will be restored later */
+  else if ( decode->is_transparent == 0 )
+    u8g2->draw_color = decode->bg_color;			/* draw_color will be restored later */
+  else
+    return;
+  
+  x = decode->target_x;
+  y = decode->target_y;
+#ifdef U8G2_WITH_FONT_ROTATION
+  x = u8g2_add_vector_x(x, lx, ly, decode->dir);
+  y = u8g2_add_vector_y(y, lx, ly, decode->dir);
+  u8g2_DrawHVLine(u8g2, x, y, len, decode->dir);
+#else
+  x += lx;
+  y += ly;
+  u8g2_DrawHVLine(u8g2, x, y, len, 0);
+#endif
+}
+
+/* returns the end of the run of pixels with the value is_foreground, which starts at lx; checks up to 8 pixels at once */
+static uint8_t u8g2_font_cached_run_end(const uint8_t *row, uint8_t lx, uint8_t w, uint8_t is_foreground)
+{
+  uint8_t bits, full;
+  
+  while( lx < w )
+  {
+    bits = row[lx >> 3];
+    if ( is_foreground == 0 )
+      bits = ~bits;
+    bits <<= lx & 7;
+    full = 0x0ff << (lx & 7);
+    if ( bits == full )
+    {
+      lx += 8 - (lx & 7);	/* all remaining pixels of this byte belong to the run */
+      continue;
+    }
+    while( bits & 0x080 )
+    {
+      bits <<= 1;
+      lx++;
+    }
+    break;
+  }
+  if ( lx > w )
+    lx = w;
+  return lx;
+}
+
+/* same as u8g2_font_decode_glyph(), but for a glyph from the cache */
+static int8_t u8g2_font_draw_cached_glyph(u8g2_t *u8g2, const u8g2_glyph_cache_entry_t *entry)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  const uint8_t *row;
+  uint8_t w, h, bytes_per_row;
+  uint8_t lx, ly, start, is_foreground;
+  
+  decode->glyph_width = entry->glyph_width;
+  decode->glyph_height = entry->glyph_height;
+  decode->fg_color = u8g2->draw_color;
+  decode->bg_color = (decode->fg_color == 0 ? 1 : 0);
+  
+  if ( entry->glyph_width > 0 )
+  {
+    if ( u8g2_font_place_glyph(u8g2, entry->x, entry->y, entry->glyph_height) == 0 )
+      return entry->delta_x;
+    
+    w = entry->glyph_width;
+    h = entry->glyph_height;
+    bytes_per_row = (w+7) >> 3;
+    row = (const uint8_t *)(entry+1);
+    for( ly = 0; ly < h; ly++ )
+    {
+      lx = 0;
+      while( lx < w )
+      {
+	start = lx;
+	is_foreground = (row[lx >> 3] & (0x80 >> (lx & 7))) != 0 ? 1 : 0;
+	lx = u8g2_font_cached_run_end(row, lx, w, is_foreground);
+	u8g2_font_draw_cached_len(u8g2, start, ly, lx - start, is_foreground);
+      }
+      row += bytes_per_row;
+    }
+    
+    /* restore the u8g2 draw color, because this is modified by the draw procedure */
+    u8g2->draw_color = decode->fg_color;
+  }
+  return entry->delta_x;
+}
+
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
+
 int8_t u8g2_font_2x_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
 {
   uint8_t a, b;
@@ -873,6 +1120,22 @@ static u8g2_uint_t u8g2_font_draw_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t
   u8g2->font_decode.target_y = y;
   //u8g2->font_decode.is_transparent = is_transparent; this is already set
   //u8g2->font_decode.dir = dir;
+#ifdef U8G2_WITH_GLYPH_CACHE
+  if ( u8g2->glyph_cache_ptr != NULL )
+  {
+    const u8g2_glyph_cache_entry_t *entry = u8g2_font_find_cached_glyph(u8g2, encoding);
+    if ( entry == NULL )
+    {
+      const uint8_t *glyph_data = u8g2_font_get_glyph_data(u8g2, encoding);
+      if ( glyph_data == NULL )
+	return 0;
+      entry = u8g2_font_add_cached_glyph(u8g2, encoding, glyph_data);
+      if ( entry == NULL )
+	return u8g2_font_decode_glyph(u8g2, glyph_data);	/* too large for the cache */
+    }
+    return u8g2_font_draw_cached_glyph(u8g2, entry);
+  }
+#endif /* U8G2_WITH_GLYPH_CACHE */
   const uint8_t *glyph_data = u8g2_font_get_glyph_data(u8g2, encoding);
   if ( glyph_data != NULL )
   {
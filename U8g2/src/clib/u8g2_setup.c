@@ -88,6 +88,14 @@ void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_
   u8g2->font_height_mode = 0; /* issue 2046 */
   u8g2->draw_color = 1;
   u8g2->is_auto_page_clear = 1;
+#ifdef U8G2_WITH_DIRTY_TILES
+  u8g2->dirty_tile_ptr = NULL;
+#endif /* U8G2_WITH_DIRTY_TILES */
+#ifdef U8G2_WITH_GLYPH_CACHE
+  u8g2->glyph_cache_ptr = NULL;
+  u8g2->glyph_cache_size = 0;
+  u8g2->glyph_cache_used = 0;
+#endif /* U8G2_WITH_GLYPH_CACHE */
   
   u8g2->cb = u8g2_cb;
   u8g2->cb->update_dimension(u8g2);
@@ -106,6 +106,22 @@
 /* 26 May 2016: Obsolete */
 //#define U8X8_DEFAULT_FLIP_MODE 0
 
+/* 
+  Maximum number of data bytes in one I2C transfer of the cad procedures.
+  The AVR Wire library has a 32 byte buffer, which also includes the control byte.
+  ESP32 (128 bytes) and RP2040 (256 bytes, arduino-pico) have larger buffers, 
+  so that a complete tile row is sent with less I2C start/stop conditions.
+*/
+#ifndef U8X8_I2C_DATA_CHUNK_SIZE
+#if defined(ESP32) || defined(ARDUINO_ARCH_ESP32)
+#define U8X8_I2C_DATA_CHUNK_SIZE 120
+#elif defined(ARDUINO_ARCH_RP2040) && !defined(ARDUINO_ARCH_MBED)
+#define U8X8_I2C_DATA_CHUNK_SIZE 248
+#else
+#define U8X8_I2C_DATA_CHUNK_SIZE 24
+#endif
+#endif
+
 /*==========================================*/
 /* Includes */
 
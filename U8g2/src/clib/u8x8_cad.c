@@ -503,14 +503,14 @@ uint8_t u8x8_cad_ssd13xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
       /* smaller streams, 32 seems to be the limit... */
       /* I guess this is related to the size of the Wire buffers in Arduino */
       /* Unfortunately, this can not be handled in the byte level drivers, */
-      /* so this is done here. Even further, only 24 bytes will be sent, */
+      /* so this is done here. Even further, only 24 bytes will be sent (U8X8_I2C_DATA_CHUNK_SIZE), */
       /* because there will be another byte (DC) required during the transfer */
       p = arg_ptr;
-       while( arg_int > 24 )
+       while( arg_int > U8X8_I2C_DATA_CHUNK_SIZE )
       {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8_i2c_data_transfer(u8x8, U8X8_I2C_DATA_CHUNK_SIZE, p);
+	arg_int-=U8X8_I2C_DATA_CHUNK_SIZE;
+	p+=U8X8_I2C_DATA_CHUNK_SIZE;
       }
       u8x8_i2c_data_transfer(u8x8, arg_int, p);
       break;
@@ -573,14 +573,14 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
       /* smaller streams, 32 seems to be the limit... */
       /* I guess this is related to the size of the Wire buffers in Arduino */
       /* Unfortunately, this can not be handled in the byte level drivers, */
-      /* so this is done here. Even further, only 24 bytes will be sent, */
+      /* so this is done here. Even further, only 24 bytes will be sent (U8X8_I2C_DATA_CHUNK_SIZE), */
       /* because there will be another byte (DC) required during the transfer */
       p = arg_ptr;
-       while( arg_int > 24 )
+       while( arg_int > U8X8_I2C_DATA_CHUNK_SIZE )
       {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8_i2c_data_transfer(u8x8, U8X8_I2C_DATA_CHUNK_SIZE, p);
+	arg_int-=U8X8_I2C_DATA_CHUNK_SIZE;
+	p+=U8X8_I2C_DATA_CHUNK_SIZE;
       }
       u8x8_i2c_data_transfer(u8x8, arg_int, p);
       in_transfer = 0;
@@ -628,11 +628,11 @@ uint8_t u8x8_cad_st75256_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
     case U8X8_MSG_CAD_SEND_DATA:
       /* see ssd13xx driver */
       p = arg_ptr;
-       while( arg_int > 24 )
+       while( arg_int > U8X8_I2C_DATA_CHUNK_SIZE )
       {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8_i2c_data_transfer(u8x8, U8X8_I2C_DATA_CHUNK_SIZE, p);
+	arg_int-=U8X8_I2C_DATA_CHUNK_SIZE;
+	p+=U8X8_I2C_DATA_CHUNK_SIZE;
       }
       u8x8_i2c_data_transfer(u8x8, arg_int, p);
       break;
@@ -678,14 +678,14 @@ uint8_t u8x8_cad_ld7032_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
       /* smaller streams, 32 seems to be the limit... */
       /* I guess this is related to the size of the Wire buffers in Arduino */
       /* Unfortunately, this can not be handled in the byte level drivers, */
-      /* so this is done here. Even further, only 24 bytes will be sent, */
+      /* so this is done here. Even further, only 24 bytes will be sent (U8X8_I2C_DATA_CHUNK_SIZE), */
       /* because there will be another byte (DC) required during the transfer */
       p = arg_ptr;
-       while( arg_int > 24 )
+       while( arg_int > U8X8_I2C_DATA_CHUNK_SIZE )
       {
-	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, U8X8_I2C_DATA_CHUNK_SIZE, p);
+	arg_int-=U8X8_I2C_DATA_CHUNK_SIZE;
+	p+=U8X8_I2C_DATA_CHUNK_SIZE;
 	u8x8_byte_EndTransfer(u8x8); 
 	u8x8_byte_StartTransfer(u8x8);
 	u8x8_byte_SendByte(u8x8, 0x08);	/* data write for LD7032 */
@@ -765,11 +765,11 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
       // is_data = 1;  // 20 Jun 2021: I assume that this is missing here
       
       p = arg_ptr;
-      while( arg_int > 24 )
+      while( arg_int > U8X8_I2C_DATA_CHUNK_SIZE )
       {
-	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, U8X8_I2C_DATA_CHUNK_SIZE, p);
+	arg_int-=U8X8_I2C_DATA_CHUNK_SIZE;
+	p+=U8X8_I2C_DATA_CHUNK_SIZE;
 	u8x8_byte_EndTransfer(u8x8); 
 	u8x8_byte_StartTransfer(u8x8);
       }
@@ -872,11 +872,11 @@ uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
       is_data = 1;
       
       p = arg_ptr;
-      while( arg_int > 24 )
+      while( arg_int > U8X8_I2C_DATA_CHUNK_SIZE )
       {
-	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, U8X8_I2C_DATA_CHUNK_SIZE, p);
+	arg_int-=U8X8_I2C_DATA_CHUNK_SIZE;
+	p+=U8X8_I2C_DATA_CHUNK_SIZE;
 	u8x8_byte_EndTransfer(u8x8); 
 	u8x8_byte_StartTransfer(u8x8);
       }
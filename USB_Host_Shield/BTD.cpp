@@ -308,6 +308,7 @@ void BTD::Initialize() {
         qNextPollTime = 0; // Reset next poll time
         pollInterval = 0;
         bPollEnable = false; // Don't start polling before dongle is connected
+        ACL_reset();
 }
 
 /* Extracts interrupt-IN, bulk-IN, bulk-OUT endpoint information from config descriptor */
@@ -373,6 +374,7 @@ uint8_t BTD::Poll() {
                 return 0;
         if((long)(millis() - qNextPollTime) >= 0L) { // Don't poll if shorter than polling interval
                 qNextPollTime = millis() + pollInterval; // Set new poll time
+                ACL_flush(); // Send any ACL packets that are waiting for a free buffer in the dongle
                 HCI_event_task(); // Poll the HCI event pipe
                 HCI_task(); // HCI state machine
                 ACL_event_task(); // Poll the ACL input pipe too
@@ -402,8 +404,13 @@ void BTD::HCI_event_task() {
                                                 for(uint8_t i = 0; i < 6; i++)
                                                         my_bdaddr[i] = hcibuf[6 + i];
                                                 hci_set_flag(HCI_FLAG_READ_BDADDR);
+                                        } else if((hcibuf[3] == 0x05) && (hcibuf[4] == 0x10) && !rcode) { // Parameters from read buffer size, only taken once as the credits are counted from here
+                                                uint16_t buffers = hcibuf[9] | (hcibuf[10] << 8); // Total number of ACL data packets
+                                                hci_acl_buffers = hci_acl_credits = buffers > 0xFF ? 0xFF : buffers;
                                         }
                                 }
+                                if((hcibuf[3] == 0x05) && (hcibuf[4] == 0x10)) // Continue without flow control if the dongle does not support it
+                                        hci_set_flag(HCI_FLAG_READ_BUFFER_SIZE);
                                 break;
 
                         case EV_COMMAND_STATUS:
@@ -507,6 +514,18 @@ void BTD::HCI_event_task() {
                                 if(!hcibuf[2]) { // Check if disconnected OK
                                         hci_set_flag(HCI_FLAG_DISCONNECT_COMPLETE); // Set disconnect command complete flag
                                         hci_clear_flag(HCI_FLAG_CONNECT_COMPLETE); // Clear connection complete flag
+                                        if(!rcode) // The dongle drops the packets it has not sent yet
+                                                ACL_completed(hcibuf[3] | ((hcibuf[4] & 0x0F) << 8), 0, true);
+                                }
+                                break;
+
+                        case EV_NUM_COMPLETE_PKT:
+                                if(!rcode) { // Only count each event once
+                                        for(uint8_t i = 0; i < hcibuf[2] && 6 + 4 * i < sizeof (hcibuf); i++) {
+                                                uint16_t handle = hcibuf[3 + 4 * i] | ((hcibuf[4 + 4 * i] & 0x0F) << 8);
+                                                uint16_t count = hcibuf[5 + 4 * i] | (hcibuf[6 + 4 * i] << 8);
+                                                ACL_completed(handle, count, false);
+                                        }
                                 }
                                 break;
 
@@ -593,7 +612,6 @@ void BTD::HCI_event_task() {
                                 }
                                 break;
                                 /* We will just ignore the following events */
-                        case EV_NUM_COMPLETE_PKT:
                         case EV_ROLE_CHANGED:
                         case EV_PAGE_SCAN_REP_MODE:
                         case EV_LOOPBACK_COMMAND:
@@ -683,6 +701,17 @@ void BTD::HCI_task() {
 
                 case HCI_LOCAL_VERSION_STATE: // The local version is used by the PS3BT class
                         if(hci_check_flag(HCI_FLAG_READ_VERSION)) {
+                                hci_read_buffer_size();
+                                hci_state = HCI_BUFFER_SIZE_STATE;
+                        }
+                        break;
+
+                case HCI_BUFFER_SIZE_STATE:
+                        if(hci_check_flag(HCI_FLAG_READ_BUFFER_SIZE)) {
+#ifdef EXTRADEBUG
+                                Notify(PSTR("\r\nACL buffers: "), 0x80);
+                                D_PrintHex<uint8_t > (hci_acl_buffers, 0x80);
+#endif
                                 if(btdName != NULL) {
                                         hci_set_local_name(btdName);
                                         hci_state = HCI_SET_NAME_STATE;
@@ -898,15 +927,15 @@ void BTD::HCI_task() {
 }
 
 void BTD::ACL_event_task() {
-        uint16_t length = BULK_MAXPKTSIZE;
-        uint8_t rcode = pUsb->inTransfer(bAddress, epInfo[ BTD_DATAIN_PIPE ].epAddr, &length, l2capinbuf); // Input on endpoint 2
-
-        if(!rcode) { // Check for errors
-                if(length > 0) { // Check if any data was read
-                        for(uint8_t i = 0; i < BTD_NUM_SERVICES; i++) {
-                                if(btService[i])
-                                        btService[i]->ACLData(l2capinbuf);
-                        }
+        uint8_t rcode = 0;
+        for(uint8_t n = 0; n < BTD_ACL_PACKETS_PER_POLL; n++) { // Read the packets that arrived since the last poll, so they don't wait for the next one
+                uint16_t length = BULK_MAXPKTSIZE;
+                rcode = pUsb->inTransfer(bAddress, epInfo[ BTD_DATAIN_PIPE ].epAddr, &length, l2capinbuf); // Input on endpoint 2
+                if(rcode || !length) // Check for errors or no data
+                        break;
+                for(uint8_t i = 0; i < BTD_NUM_SERVICES; i++) {
+                        if(btService[i])
+                                btService[i]->ACLData(l2capinbuf);
                 }
         }
 #ifdef EXTRADEBUG
@@ -931,6 +960,7 @@ void BTD::HCI_Command(uint8_t* data, uint16_t nbytes) {
 
 void BTD::hci_reset() {
         hci_event_flag = 0; // Clear all the flags
+        ACL_reset(); // The dongle drops its ACL buffers too
         hcibuf[0] = 0x03; // HCI OCF = 3
         hcibuf[1] = 0x03 << 2; // HCI OGF = 3
         hcibuf[2] = 0x00;
@@ -978,6 +1008,15 @@ void BTD::hci_read_local_version_information() {
         HCI_Command(hcibuf, 3);
 }
 
+void BTD::hci_read_buffer_size() {
+        hci_clear_flag(HCI_FLAG_READ_BUFFER_SIZE);
+        hcibuf[0] = 0x05; // HCI OCF = 5
+        hcibuf[1] = 0x04 << 2; // HCI OGF = 4
+        hcibuf[2] = 0x00;
+
+        HCI_Command(hcibuf, 3);
+}
+
 void BTD::hci_accept_connection() {
         hci_clear_flag(HCI_FLAG_CONNECT_COMPLETE);
         hcibuf[0] = 0x09; // HCI OCF = 9
@@ -1209,20 +1248,125 @@ void BTD::L2CAP_Command(uint16_t handle, uint8_t* data, uint8_t nbytes, uint8_t
         for(uint16_t i = 0; i < nbytes; i++) // L2CAP C-frame
                 buf[8 + i] = data[i];
 
-        uint8_t rcode = pUsb->outTransfer(bAddress, epInfo[ BTD_DATAOUT_PIPE ].epAddr, (8 + nbytes), buf);
+        ACL_Send(buf, 8 + nbytes);
+}
+
+/************************************************************/
+/*                    ACL output                            */
+
+/************************************************************/
+void BTD::ACL_Send(uint8_t* data, uint16_t nbytes) {
+#if BTD_ACL_QUEUE_SIZE
+        if(aclQueueCount || (hci_acl_buffers && !hci_acl_credits)) { // Keep the packets in order, and don't overrun the dongle
+                if(ACL_enqueue(data, nbytes))
+                        return;
+        }
+#endif
+        uint8_t rcode = ACL_transfer(data, nbytes);
+#if BTD_ACL_QUEUE_SIZE
+        if(rcode == hrNAK && ACL_enqueue(data, nbytes)) // The dongle is busy, so try again on the next poll
+                return;
+#endif
         if(rcode) {
                 delay(100); // This small delay prevents it from overflowing if it fails
 #ifdef DEBUG_USB_HOST
                 Notify(PSTR("\r\nError sending L2CAP message: 0x"), 0x80);
                 D_PrintHex<uint8_t > (rcode, 0x80);
                 Notify(PSTR(" - Channel ID: "), 0x80);
-                D_PrintHex<uint8_t > (channelHigh, 0x80);
+                D_PrintHex<uint8_t > (data[7], 0x80);
                 Notify(PSTR(" "), 0x80);
-                D_PrintHex<uint8_t > (channelLow, 0x80);
+                D_PrintHex<uint8_t > (data[6], 0x80);
 #endif
         }
 }
 
+uint8_t BTD::ACL_transfer(uint8_t* data, uint16_t nbytes) {
+        uint8_t rcode = pUsb->outTransfer(bAddress, epInfo[ BTD_DATAOUT_PIPE ].epAddr, nbytes, data);
+        if(rcode || !hci_acl_buffers) // Flow control is only used if the dongle reported its number of buffers
+                return rcode;
+
+        if(hci_acl_credits)
+                hci_acl_credits--;
+        uint16_t handle = data[0] | ((data[1] & 0x0F) << 8);
+        AclHandle *pFree = NULL;
+        for(uint8_t i = 0; i < BTD_MAX_ACL_HANDLES; i++) {
+                if(aclHandles[i].inFlight && aclHandles[i].handle == handle) {
+                        aclHandles[i].inFlight++;
+                        return rcode;
+                }
+                if(!aclHandles[i].inFlight && !pFree)
+                        pFree = &aclHandles[i];
+        }
+        if(pFree) { // If there is no free entry, the credit is still returned by the Number Of Completed Packets event
+                pFree->handle = handle;
+                pFree->inFlight = 1;
+        }
+        return rcode;
+}
+
+void BTD::ACL_completed(uint16_t handle, uint16_t count, bool disconnected) {
+        for(uint8_t i = 0; i < BTD_MAX_ACL_HANDLES; i++) {
+                if(aclHandles[i].inFlight && aclHandles[i].handle == handle) {
+                        if(disconnected || count > aclHandles[i].inFlight)
+                                count = aclHandles[i].inFlight; // All the packets of a closed connection are freed
+                        aclHandles[i].inFlight -= count;
+                        break;
+                }
+        }
+        if(count > (uint16_t)(hci_acl_buffers - hci_acl_credits))
+                count = hci_acl_buffers - hci_acl_credits;
+        hci_acl_credits += count;
+}
+
+void BTD::ACL_reset() {
+        hci_acl_buffers = 0;
+        hci_acl_credits = 0;
+        for(uint8_t i = 0; i < BTD_MAX_ACL_HANDLES; i++) {
+                aclHandles[i].handle = 0;
+                aclHandles[i].inFlight = 0;
+        }
+#if BTD_ACL_QUEUE_SIZE
+        aclQueueHead = 0;
+        aclQueueCount = 0;
+#endif
+}
+
+void BTD::ACL_flush() {
+#if BTD_ACL_QUEUE_SIZE
+        while(aclQueueCount && (!hci_acl_buffers || hci_acl_credits)) {
+                uint16_t tail = (aclQueueHead + BTD_ACL_QUEUE_SIZE - aclQueueCount) % BTD_ACL_QUEUE_SIZE;
+                uint16_t nbytes = aclQueue[tail] | (aclQueue[(tail + 1) % BTD_ACL_QUEUE_SIZE] << 8);
+                uint8_t buf[nbytes];
+                for(uint16_t i = 0; i < nbytes; i++)
+                        buf[i] = aclQueue[(tail + 2 + i) % BTD_ACL_QUEUE_SIZE];
+                uint8_t rcode = ACL_transfer(buf, nbytes);
+                if(rcode == hrNAK) // Still busy, try again on the next poll
+                        break;
+                aclQueueCount -= nbytes + 2; // Any other error drops the packet, just like when it is sent directly
+#ifdef DEBUG_USB_HOST
+                if(rcode) {
+                        Notify(PSTR("\r\nError sending queued L2CAP message: 0x"), 0x80);
+                        D_PrintHex<uint8_t > (rcode, 0x80);
+                }
+#endif
+        }
+#endif
+}
+
+#if BTD_ACL_QUEUE_SIZE
+bool BTD::ACL_enqueue(uint8_t* data, uint16_t nbytes) {
+        if(aclQueueCount + nbytes + 2 > BTD_ACL_QUEUE_SIZE)
+                return false;
+        aclQueue[aclQueueHead] = (uint8_t)(nbytes & 0xff);
+        aclQueue[(aclQueueHead + 1) % BTD_ACL_QUEUE_SIZE] = (uint8_t)(nbytes >> 8);
+        for(uint16_t i = 0; i < nbytes; i++)
+                aclQueue[(aclQueueHead + 2 + i) % BTD_ACL_QUEUE_SIZE] = data[i];
+        aclQueueHead = (aclQueueHead + nbytes + 2) % BTD_ACL_QUEUE_SIZE;
+        aclQueueCount += nbytes + 2;
+        return true;
+}
+#endif
+
 void BTD::l2cap_connection_request(uint16_t handle, uint8_t rxid, uint8_t* scid, uint16_t psm) {
         l2capoutbuf[0] = L2CAP_CMD_CONNECTION_REQUEST; // Code
         l2capoutbuf[1] = rxid; // Identifier
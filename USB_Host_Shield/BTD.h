@@ -56,6 +56,7 @@
 #define HCI_DISABLE_SCAN_STATE          14
 #define HCI_DONE_STATE                  15
 #define HCI_DISCONNECT_STATE            16
+#define HCI_BUFFER_SIZE_STATE           17
 
 /* HCI event flags*/
 #define HCI_FLAG_CMD_COMPLETE           (1UL << 0)
@@ -67,6 +68,7 @@
 #define HCI_FLAG_READ_VERSION           (1UL << 6)
 #define HCI_FLAG_DEVICE_FOUND           (1UL << 7)
 #define HCI_FLAG_CONNECT_EVENT          (1UL << 8)
+#define HCI_FLAG_READ_BUFFER_SIZE       (1UL << 9)
 
 /* Macros for HCI event flag tests */
 #define hci_check_flag(flag) (hci_event_flag & (flag))
@@ -187,6 +189,17 @@
 #define BTD_MAX_ENDPOINTS   4
 #define BTD_NUM_SERVICES    4 // Max number of Bluetooth services - if you need more than 4 simply increase this number
 
+// Outgoing ACL packets wait in this queue while the dongle has no free ACL buffers. Set to 0 to disable the queue
+#ifndef BTD_ACL_QUEUE_SIZE
+#if defined(RAMEND) && RAMEND < 0x1000
+#define BTD_ACL_QUEUE_SIZE  0 // Not enough RAM on an Uno or Leonardo
+#else
+#define BTD_ACL_QUEUE_SIZE  256
+#endif
+#endif
+#define BTD_ACL_PACKETS_PER_POLL    4 // Max number of incoming ACL packets handled in one call to Poll()
+#define BTD_MAX_ACL_HANDLES         BTD_NUM_SERVICES // Connections that have ACL packets in flight
+
 #define PAIR    1
 
 class BluetoothService;
@@ -317,6 +330,8 @@ public:
         void hci_read_bdaddr();
         /** Read the HCI Version of the Bluetooth dongle. */
         void hci_read_local_version_information();
+        /** Read the number of ACL buffers of the Bluetooth dongle, used for ACL flow control. */
+        void hci_read_buffer_size();
         /**
          * Set the local name of the Bluetooth dongle.
          * @param name Desired name.
@@ -549,11 +564,35 @@ private:
         uint8_t l2capinbuf[BULK_MAXPKTSIZE]; // General purpose buffer for L2CAP in data
         uint8_t l2capoutbuf[14]; // General purpose buffer for L2CAP out data
 
+        /* ACL flow control. The dongle reports how many ACL buffers it has, and when it has sent packets */
+        uint8_t hci_acl_buffers; // Number of ACL buffers in the dongle, 0 if unknown
+        uint8_t hci_acl_credits; // Number of free ACL buffers in the dongle
+
+        struct AclHandle {
+                uint16_t handle;
+                uint8_t inFlight; // ACL packets not yet reported sent by the dongle
+        } aclHandles[BTD_MAX_ACL_HANDLES];
+
+#if BTD_ACL_QUEUE_SIZE
+        uint8_t aclQueue[BTD_ACL_QUEUE_SIZE]; // Outgoing ACL packets, each preceded by its length (two bytes)
+        uint16_t aclQueueHead, aclQueueCount;
+#endif
+
         /* State machines */
         void HCI_event_task(); // Poll the HCI event pipe
         void HCI_task(); // HCI state machine
         void ACL_event_task(); // ACL input pipe
 
+        /* ACL output */
+        void ACL_Send(uint8_t* data, uint16_t nbytes); // Sends or queues an ACL packet
+        void ACL_flush(); // Sends queued ACL packets while the dongle has free buffers
+        uint8_t ACL_transfer(uint8_t* data, uint16_t nbytes);
+        void ACL_completed(uint16_t handle, uint16_t count, bool disconnected);
+        void ACL_reset();
+#if BTD_ACL_QUEUE_SIZE
+        bool ACL_enqueue(uint8_t* data, uint16_t nbytes);
+#endif
+
         /* Used to set the Bluetooth Address internally to the PS3 Controllers */
         void setBdaddr(uint8_t* BDADDR);
         void setMoveBdaddr(uint8_t* BDADDR);
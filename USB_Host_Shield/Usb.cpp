@@ -22,7 +22,7 @@ static uint8_t usb_error = 0;
 static uint8_t usb_task_state;
 
 /* constructor */
-USB::USB() : bmHubPre(0) {
+USB::USB() : bmHubPre(0), pollIndex(0) {
         usb_task_state = USB_DETACHED_SUBSTATE_INITIALIZE; //set up state machine
         init();
 }
@@ -215,7 +215,13 @@ uint8_t USB::inTransfer(uint8_t addr, uint8_t ep, uint16_t *nbytesptr, uint8_t*
                 USBTRACE3("(USB::InTransfer) ep requested ", ep, 0x81);
                 return rcode;
         }
-        return InTransfer(pep, nak_limit, nbytesptr, data);
+        if(NakBackoff(pep)) {
+                *nbytesptr = 0;
+                return hrNAK;
+        }
+        rcode = InTransfer(pep, nak_limit, nbytesptr, data);
+        UpdateNakBackoff(pep, rcode);
+        return rcode;
 }
 
 uint8_t USB::InTransfer(EpInfo *pep, uint16_t nak_limit, uint16_t *nbytesptr, uint8_t* data) {
@@ -229,13 +235,15 @@ uint8_t USB::InTransfer(EpInfo *pep, uint16_t nak_limit, uint16_t *nbytesptr, ui
         *nbytesptr = 0;
         regWr(rHCTL, (pep->bmRcvToggle) ? bmRCVTOG1 : bmRCVTOG0); //set toggle value
 
+        rcode = dispatchPkt(tokIN, pep->epAddr, nak_limit); //IN packet to EP-'endpoint'. Function takes care of NAKS.
+
         // use a 'break' to exit this loop
         while(1) {
-                rcode = dispatchPkt(tokIN, pep->epAddr, nak_limit); //IN packet to EP-'endpoint'. Function takes care of NAKS.
                 if(rcode == hrTOGERR) {
                         // yes, we flip it wrong here so that next time it is actually correct!
                         pep->bmRcvToggle = (regRd(rHRSL) & bmSNDTOGRD) ? 0 : 1;
                         regWr(rHCTL, (pep->bmRcvToggle) ? bmRCVTOG1 : bmRCVTOG0); //set toggle value
+                        rcode = dispatchPkt(tokIN, pep->epAddr, nak_limit);
                         continue;
                 }
                 if(rcode) {
@@ -265,15 +273,22 @@ uint8_t USB::InTransfer(EpInfo *pep, uint16_t nak_limit, uint16_t *nbytesptr, ui
                 if(mem_left < 0)
                         mem_left = 0;
 
+                /* The transfer is complete under two conditions:           */
+                /* 1. The device sent a short packet (L.T. maxPacketSize)   */
+                /* 2. 'nbytes' have been transferred.                       */
+                bool last = (pktsize < maxpktsize) || (*nbytesptr + pktsize >= nbytes);
+
+                /* The RCVFIFO is double buffered: ask for the next packet now, so the device sends it into the other */
+                /* buffer while this one is read over SPI                                                              */
+                if(!last)
+                        regWr(rHXFR, (tokIN | pep->epAddr));
+
                 data = bytesRd(rRCVFIFO, ((pktsize > mem_left) ? mem_left : pktsize), data);
 
                 regWr(rHIRQ, bmRCVDAVIRQ); // Clear the IRQ & free the buffer
                 *nbytesptr += pktsize; // add this packet's byte count to total transfer length
 
-                /* The transfer is complete under two conditions:           */
-                /* 1. The device sent a short packet (L.T. maxPacketSize)   */
-                /* 2. 'nbytes' have been transferred.                       */
-                if((pktsize < maxpktsize) || (*nbytesptr >= nbytes)) // have we transferred 'nbytes' bytes?
+                if(last) // have we transferred 'nbytes' bytes?
                 {
                         // Save toggle value
                         pep->bmRcvToggle = ((regRd(rHRSL) & bmRCVTOGRD)) ? 1 : 0;
@@ -281,6 +296,7 @@ uint8_t USB::InTransfer(EpInfo *pep, uint16_t nak_limit, uint16_t *nbytesptr, ui
                         rcode = 0;
                         break;
                 } // if
+                rcode = completePkt(tokIN, pep->epAddr, nak_limit); // wait for the packet that is already on its way
         } //while( 1 )
         return ( rcode);
 }
@@ -301,6 +317,36 @@ uint8_t USB::outTransfer(uint8_t addr, uint8_t ep, uint16_t nbytes, uint8_t* dat
         return OutTransfer(pep, nak_limit, nbytes, data);
 }
 
+/* Per endpoint NAK backoff. An IN endpoint that is polled with a single NAK (USB_NAK_NOWAIT), such as an interrupt      */
+/* endpoint or the bulk endpoint of a serial converter, usually NAKs because it has nothing to send. Instead of spending  */
+/* a bus transaction on it on every poll, it is left alone for a while after each NAK, so that the other endpoints and    */
+/* devices get the time. OUT transfers are not backed off, since a NAKed OUT would be lost rather than just delayed.      */
+/* Returns true while the endpoint is backing off; inTransfer() then reports hrNAK without a transfer.                    */
+bool USB::NakBackoff(EpInfo *pep) {
+        if(!pep->bmNakBackoff)
+                return false;
+        if((int8_t)(pep->nakBackoffUntil - (uint8_t)millis()) > 0)
+                return true;
+        return false;
+}
+
+void USB::UpdateNakBackoff(EpInfo *pep, uint8_t rcode) {
+#if USB_NAK_BACKOFF_LIMIT
+        if(pep->bmNakPower != USB_NAK_NOWAIT)
+                return;
+        if(rcode != hrNAK) {
+                pep->bmNakBackoff = 0;
+                return;
+        }
+        if(pep->bmNakBackoff < USB_NAK_BACKOFF_LEVELS)
+                pep->bmNakBackoff++;
+        uint8_t wait = 1 << (2 * (pep->bmNakBackoff - 1)); // 1, 4, 16 ms
+        if(wait > USB_NAK_BACKOFF_LIMIT)
+                wait = USB_NAK_BACKOFF_LIMIT;
+        pep->nakBackoffUntil = (uint8_t)millis() + wait;
+#endif
+}
+
 uint8_t USB::OutTransfer(EpInfo *pep, uint16_t nak_limit, uint16_t nbytes, uint8_t *data) {
         uint8_t rcode = hrSUCCESS, retry_count;
         uint8_t *data_p = data; //local copy of the data pointer
@@ -374,14 +420,23 @@ breakout:
 
 /* return codes 0x00-0x0f are HRSLT( 0x00 being success ), 0xff means timeout                       */
 uint8_t USB::dispatchPkt(uint8_t token, uint8_t ep, uint16_t nak_limit) {
+        regWr(rHXFR, (token | ep)); //launch the transfer
+        return completePkt(token, ep, nak_limit);
+}
+
+/* wait for a packet launched by writing HXFR to complete, re-sending it on NAK and bus timeout like dispatchPkt() */
+uint8_t USB::completePkt(uint8_t token, uint8_t ep, uint16_t nak_limit) {
         unsigned long timeout = millis() + USB_XFER_TIMEOUT;
         uint8_t tmpdata;
         uint8_t rcode = hrSUCCESS;
         uint8_t retry_count = 0;
         uint16_t nak_count = 0;
+        bool launched = true;
 
         while((long)(millis() - timeout) < 0L) {
-                regWr(rHXFR, (token | ep)); //launch the transfer
+                if(!launched)
+                        regWr(rHXFR, (token | ep)); //launch the transfer again
+                launched = false;
                 rcode = USB_ERROR_TRANSFER_TIMEOUT;
 
                 while((long)(millis() - timeout) < 0L) //wait for transfer completion
@@ -456,9 +511,20 @@ void USB::Task(void) //USB state machine
                         break;
         }// switch( tmpdata
 
-        for(uint8_t i = 0; i < USB_NUMDEVICES; i++)
-                if(devConfig[i])
-                        rcode = devConfig[i]->Poll();
+        // Poll the devices round robin. When a poll takes long (e.g. a device behind a hub, or one that NAKs), the
+        // rest of the devices are polled on the next call, starting from where this one stopped
+        unsigned long pollStart = micros();
+        for(uint8_t n = 0; n < USB_NUMDEVICES; n++) {
+                uint8_t i = pollIndex;
+                pollIndex = (pollIndex + 1 < USB_NUMDEVICES) ? pollIndex + 1 : 0;
+                if(!devConfig[i])
+                        continue;
+                rcode = devConfig[i]->Poll();
+#if USB_TASK_POLL_BUDGET
+                if(micros() - pollStart >= USB_TASK_POLL_BUDGET)
+                        break;
+#endif
+        }
 
         switch(usb_task_state) {
                 case USB_DETACHED_SUBSTATE_INITIALIZE:
@@ -94,6 +94,13 @@ typedef MAX3421e<P10, P9> MAX3421E; // Official Arduinos (UNO, Duemilanove, Mega
 #define USB_RETRY_LIMIT         3       // 3 retry limit for a transfer
 #define USB_SETTLE_DELAY        200     // settle delay in milliseconds
 
+#ifndef USB_NAK_BACKOFF_LIMIT
+#define USB_NAK_BACKOFF_LIMIT   8       // longest NAK backoff of a USB_NAK_NOWAIT endpoint in milliseconds, 0 disables backoff
+#endif
+#ifndef USB_TASK_POLL_BUDGET
+#define USB_TASK_POLL_BUDGET    2000    // time in microseconds after which Task() stops polling devices, 0 polls all devices on every call
+#endif
+
 #define USB_NUMDEVICES          16      //number of USB devices
 //#define HUB_MAX_HUBS          7       // maximum number of hubs that can be attached to the host controller
 #define HUB_PORT_RESET_DELAY    20      // hub port reset delay 10 ms recomended, can be up to 20 ms
@@ -196,6 +203,7 @@ class USB : public MAX3421E {
         AddressPoolImpl<USB_NUMDEVICES> addrPool;
         USBDeviceConfig* devConfig[USB_NUMDEVICES];
         uint8_t bmHubPre;
+        uint8_t pollIndex; // next device to poll, so every device gets its turn when the poll budget runs out
 
 public:
         USB(void);
@@ -246,6 +254,7 @@ public:
         uint8_t inTransfer(uint8_t addr, uint8_t ep, uint16_t *nbytesptr, uint8_t* data);
         uint8_t outTransfer(uint8_t addr, uint8_t ep, uint16_t nbytes, uint8_t* data);
         uint8_t dispatchPkt(uint8_t token, uint8_t ep, uint16_t nak_limit);
+        uint8_t completePkt(uint8_t token, uint8_t ep, uint16_t nak_limit);
 
         void Task(void);
 
@@ -261,6 +270,8 @@ private:
         uint8_t SetAddress(uint8_t addr, uint8_t ep, EpInfo **ppep, uint16_t *nak_limit);
         uint8_t OutTransfer(EpInfo *pep, uint16_t nak_limit, uint16_t nbytes, uint8_t *data);
         uint8_t InTransfer(EpInfo *pep, uint16_t nak_limit, uint16_t *nbytesptr, uint8_t *data);
+        bool NakBackoff(EpInfo *pep);
+        void UpdateNakBackoff(EpInfo *pep, uint8_t rcode);
         uint8_t AttemptConfig(uint8_t driver, uint8_t parent, uint8_t port, bool lowspeed);
 };
 
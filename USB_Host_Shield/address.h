@@ -29,6 +29,10 @@ e-mail   :  support@circuitsathome.com
 #define USB_NAK_NOWAIT                  1               //Single NAK stops transfer
 #define USB_NAK_NONAK                   0               //Do not count NAKs, stop retrying after USB Timeout
 
+/* NAK backoff levels of USB_NAK_NOWAIT endpoints. After a NAK, the endpoint is not polled again for 1, 4, then 16 ms */
+/* (limited by USB_NAK_BACKOFF_LIMIT); a transfer that is not NAKed clears the backoff                                */
+#define USB_NAK_BACKOFF_LEVELS          3
+
 struct EpInfo {
         uint8_t epAddr; // Endpoint address
         uint8_t maxPktSize; // Maximum packet size
@@ -39,9 +43,11 @@ struct EpInfo {
                 struct {
                         uint8_t bmSndToggle : 1; // Send toggle, when zero bmSNDTOG0, bmSNDTOG1 otherwise
                         uint8_t bmRcvToggle : 1; // Send toggle, when zero bmRCVTOG0, bmRCVTOG1 otherwise
-                        uint8_t bmNakPower : 6; // Binary order for NAK_LIMIT value
+                        uint8_t bmNakPower : 4; // Binary order for NAK_LIMIT value
+                        uint8_t bmNakBackoff : 2; // NAK backoff level, zero when not backing off
                 } __attribute__((packed));
         };
+        uint8_t nakBackoffUntil; // Low byte of millis() when a backing off endpoint may be polled again
 } __attribute__((packed));
 
 //        7   6   5   4   3   2   1   0
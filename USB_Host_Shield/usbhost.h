@@ -124,6 +124,11 @@ public:
         uint8_t GpxHandler();
         uint8_t IntHandler();
         uint8_t Task();
+
+        /* true when the INT pin is asserted, i.e. Task() has an attach or detach to handle */
+        bool IntPending() {
+                return !INTR::IsSet();
+        };
 };
 
 template< typename SPI_SS, typename INTR >
@@ -174,6 +179,17 @@ uint8_t* MAX3421e< SPI_SS, INTR >::bytesWr(uint8_t reg, uint8_t nbytes, uint8_t*
         spi4teensy3::send(reg | 0x02);
         spi4teensy3::send(data_p, nbytes);
         data_p += nbytes;
+#elif !defined(SPDR) && defined(SPI_HAS_TRANSACTION)
+        // block transfers are much faster than a SPI.transfer() call per byte, but overwrite the buffer
+        uint8_t buf[64];
+        SPI.transfer(reg | 0x02);
+        while(nbytes) {
+                uint8_t n = (nbytes > sizeof(buf)) ? sizeof(buf) : nbytes;
+                memcpy(buf, data_p, n);
+                SPI.transfer(buf, n);
+                nbytes -= n;
+                data_p += n;
+        }
 #elif !defined(SPDR)
         SPI.transfer(reg | 0x02);
         while(nbytes) {
@@ -242,6 +258,11 @@ uint8_t* MAX3421e< SPI_SS, INTR >::bytesRd(uint8_t reg, uint8_t nbytes, uint8_t*
         spi4teensy3::send(reg);
         spi4teensy3::receive(data_p, nbytes);
         data_p += nbytes;
+#elif !defined(SPDR) && defined(SPI_HAS_TRANSACTION)
+        SPI.transfer(reg);
+        memset(data_p, 0, nbytes);
+        SPI.transfer(data_p, nbytes);
+        data_p += nbytes;
 #elif !defined(SPDR)
         SPI.transfer(reg);
         while(nbytes) {
@@ -322,7 +343,9 @@ int8_t MAX3421e< SPI_SS, INTR >::Init() {
 
         regWr(rMODE, bmDPPULLDN | bmDMPULLDN | bmHOST); // set pull-downs, Host
 
-        regWr(rHIEN, bmCONDETIE | bmFRAMEIE); //connection detection
+        // Connection detection only. FRAMEIRQ is never cleared, so enabling it would hold the INT pin low
+        // and make Task() read the IRQ register over SPI on every call
+        regWr(rHIEN, bmCONDETIE);
 
         /* check if device is connected */
         regWr(rHCTL, bmSAMPLEBUS); // sample USB bus
@@ -363,7 +386,7 @@ int8_t MAX3421e< SPI_SS, INTR >::Init(int mseconds) {
 
         regWr(rMODE, bmDPPULLDN | bmDMPULLDN | bmHOST); // set pull-downs, Host
 
-        regWr(rHIEN, bmCONDETIE | bmFRAMEIE); //connection detection
+        regWr(rHIEN, bmCONDETIE); //connection detection, see Init()
 
         /* check if device is connected */
         regWr(rHCTL, bmSAMPLEBUS); // sample USB bus
@@ -58,6 +58,18 @@ bool SHTI2cSensor::readFromI2c(TwoWire & wire,
                                uint8_t commandLength, uint8_t *data,
                                uint8_t dataLength,
                                uint8_t duration)
+{
+  if (!writeToI2c(wire, i2cAddress, i2cCommand, commandLength)) {
+    return false;
+  }
+
+  delay(duration);
+
+  return readDataFromI2c(wire, i2cAddress, data, dataLength);
+}
+
+bool SHTI2cSensor::writeToI2c(TwoWire & wire, uint8_t i2cAddress,
+                              const uint8_t *i2cCommand, uint8_t commandLength)
 {
   wire.beginTransmission(i2cAddress);
   for (int i = 0; i < commandLength; ++i) {
@@ -66,12 +78,12 @@ bool SHTI2cSensor::readFromI2c(TwoWire & wire,
     }
   }
 
-  if (wire.endTransmission() != 0) {
-    return false;
-  }
-
-  delay(duration);
+  return wire.endTransmission() == 0;
+}
 
+bool SHTI2cSensor::readDataFromI2c(TwoWire & wire, uint8_t i2cAddress,
+                                   uint8_t *data, uint8_t dataLength)
+{
   wire.requestFrom(i2cAddress, dataLength);
 
   // check if the same number of bytes are received that are requested.
@@ -108,35 +120,75 @@ uint8_t SHTI2cSensor::crc8(const uint8_t *data, uint8_t len, uint8_t crcInit)
 
 bool SHTI2cSensor::readSample()
 {
-  uint8_t data[EXPECTED_DATA_SIZE];
-  uint8_t cmd[mCmd_Size];
+  if (!startSample()) {
+    return false;
+  }
+
+  delay(mDuration);
+
+  SHTSensor::SHTSampleState state;
+  while ((state = pollSample()) == SHTSensor::SHT_SAMPLE_BUSY) {
+    delay(1);
+  }
+  return state == SHTSensor::SHT_SAMPLE_READY;
+}
+
+bool SHTI2cSensor::sendCommand(const uint8_t *i2cCommand, uint8_t commandLength)
+{
+  mBusy = writeToI2c(mWire, mI2cAddress, i2cCommand, commandLength);
+  mStartTime = millis();
+  return mBusy;
+}
+
+bool SHTI2cSensor::startSample()
+{
+  uint8_t cmd[2];
 
   cmd[0] = mI2cCommand >> 8;
   //is omitted for SHT4x Sensors
   cmd[1] = mI2cCommand & 0xff;
 
-  if (!readFromI2c(mWire, mI2cAddress, cmd, mCmd_Size, data,
-                   EXPECTED_DATA_SIZE, mDuration)) {
-    return false;
+  return sendCommand(cmd, mCmd_Size);
+}
+
+SHTSensor::SHTSampleState SHTI2cSensor::pollSample()
+{
+  if (!mBusy) {
+    return SHTSensor::SHT_SAMPLE_IDLE;
+  }
+  if (!isSampleDue()) {
+    return SHTSensor::SHT_SAMPLE_BUSY;
+  }
+  mBusy = false;
+
+  uint8_t data[EXPECTED_DATA_SIZE];
+  if (!readDataFromI2c(mWire, mI2cAddress, data, EXPECTED_DATA_SIZE) ||
+      !convert(data, 0xff, 0)) {
+    return SHTSensor::SHT_SAMPLE_ERROR;
   }
+  return SHTSensor::SHT_SAMPLE_READY;
+}
 
+bool SHTI2cSensor::convert(const uint8_t *data, uint8_t crcInit,
+                           uint16_t statusMask)
+{
   // -- Important: assuming each 2 byte of data is followed by 1 byte of CRC
 
   // check CRC for both RH and T
-  if (crc8(&data[0], 2) != data[2] || crc8(&data[3], 2) != data[5]) {
+  if (crc8(&data[0], 2, crcInit) != data[2] ||
+      crc8(&data[3], 2, crcInit) != data[5]) {
     return false;
   }
 
-  // convert to Temperature/Humidity
+  // convert to Temperature/Humidity, without the status bits if there are any
   uint16_t val;
-  val = (data[0] << 8) + data[1];
+  val = ((data[0] << 8) + data[1]) & ~statusMask;
   mTemperature = mA + mB * (val / mC);
 
-  val = (data[3] << 8) + data[4];
+  val = ((data[3] << 8) + data[4]) & ~statusMask;
   mHumidity = mX + mY * (val / mZ);
 
   return true;
-
 }
 
 //
@@ -176,58 +228,70 @@ public:
   {
   }
 
-  bool readSample() override
-  {
-    uint8_t data[EXPECTED_DATA_SIZE];
-    uint8_t cmd[mCmd_Size];
+  // SHT2x sends T and RH in two separate commands (different to other sensors)
+  // so we have to spit the command into two bytes and
+  // have to read from I2C two times with EXPECTED_DATA_SIZE / 2
 
-    // SHT2x sends T and RH in two separate commands (different to other sensors)
-    // so we have to spit the command into two bytes and
-    // have to read from I2C two times with EXPECTED_DATA_SIZE / 2
-
-    // read T from SHT2x Sensor
+  bool startSample() override
+  {
     // Upper byte of 'mI2cCommand' is T for SHT2x Sensors
-    cmd[0] = mI2cCommand >> 8;
-    if (!readFromI2c(mWire, mI2cAddress, cmd, mCmd_Size, data,
-                     EXPECTED_DATA_SIZE / 2, mDuration)) {
-      DEBUG_SHT("SHT2x readFromI2c(T) false\n");
-      return false;
+    uint8_t cmd = mI2cCommand >> 8;
+    mHumidityPhase = false;
+    return sendCommand(&cmd, mCmd_Size);
+  }
+
+  SHTSensor::SHTSampleState pollSample() override
+  {
+    if (!mBusy) {
+      return SHTSensor::SHT_SAMPLE_IDLE;
     }
-    
-    // read RH from SHT2x Sensor
-    // Lower byte of 'mI2cCommand' is RH for SHT2x Sensors
-    cmd[0] = mI2cCommand & 0xff;
-    if (!readFromI2c(mWire, mI2cAddress, cmd, mCmd_Size, &data[3],
-                     EXPECTED_DATA_SIZE / 2, mDuration)) {
-      DEBUG_SHT("SHT2x readFromI2c(RH) false\n");
-      return false;
+    if (!isSampleDue()) {
+      return SHTSensor::SHT_SAMPLE_BUSY;
     }
+    mBusy = false;
 
-    // -- Important: assuming each 2 byte of data is followed by 1 byte of CRC
+    if (!mHumidityPhase) {
+      // read T from SHT2x Sensor, then start RH
+      if (!readDataFromI2c(mWire, mI2cAddress, mData, EXPECTED_DATA_SIZE / 2)) {
+        DEBUG_SHT("SHT2x readFromI2c(T) false\n");
+        return SHTSensor::SHT_SAMPLE_ERROR;
+      }
+      // Lower byte of 'mI2cCommand' is RH for SHT2x Sensors
+      uint8_t cmd = mI2cCommand & 0xff;
+      mHumidityPhase = true;
+      if (!sendCommand(&cmd, mCmd_Size)) {
+        return SHTSensor::SHT_SAMPLE_ERROR;
+      }
+      return SHTSensor::SHT_SAMPLE_BUSY;
+    }
 
-    // check CRC for both RH and T with a crc init value of 0
-    if (crc8(&data[0], 2, 0) != data[2] || crc8(&data[3], 2, 0) != data[5]) {
-      DEBUG_SHT("SHT2x crc8 false\n");
-      return false;
+    // read RH from SHT2x Sensor
+    if (!readDataFromI2c(mWire, mI2cAddress, &mData[3], EXPECTED_DATA_SIZE / 2)) {
+      DEBUG_SHT("SHT2x readFromI2c(RH) false\n");
+      return SHTSensor::SHT_SAMPLE_ERROR;
     }
 
     // check status bits [1..0] (see datasheet)
     // bit 0: not used, bit 1: measurement type (0: temperature, 1 humidity)
-    if (((data[1] & 0x02) != 0x00) || ((data[4] & 0x02) != 0x02)) {
+    if (((mData[1] & 0x02) != 0x00) || ((mData[4] & 0x02) != 0x02)) {
       DEBUG_SHT("SHT2x status bits false\n");
-      return false;
+      return SHTSensor::SHT_SAMPLE_ERROR;
     }
 
-    // convert to Temperature/Humidity
-    uint16_t val;
-    val = (data[0] << 8) + (data[1] & ~0x03); // get value and clear status bits [1..0]
-    mTemperature = mA + mB * (val / mC);
-
-    val = (data[3] << 8) + (data[4] & ~0x03); // get value and clear status bits [1..0]
-    mHumidity = mX + mY * (val / mZ);
-
-    return true;
+    // check CRC for both RH and T with a crc init value of 0, then convert
+    // with the status bits [1..0] cleared
+    if (!convert(mData, 0, 0x03)) {
+      DEBUG_SHT("SHT2x crc8 false\n");
+      return SHTSensor::SHT_SAMPLE_ERROR;
+    }
+    return SHTSensor::SHT_SAMPLE_READY;
   }
+
+private:
+  /** T is read, RH is being measured */
+  bool mHumidityPhase;
+  /** T and RH with their CRC, kept between the two measurements */
+  uint8_t mData[EXPECTED_DATA_SIZE];
 };
 
 //
@@ -426,6 +490,28 @@ bool SHTSensor::readSample()
   return true;
 }
 
+bool SHTSensor::startSample()
+{
+  return mSensor && mSensor->startSample();
+}
+
+SHTSensor::SHTSampleState SHTSensor::pollSample()
+{
+  if (!mSensor)
+    return SHT_SAMPLE_IDLE;
+  SHTSampleState state = mSensor->pollSample();
+  if (state == SHT_SAMPLE_READY) {
+    mTemperature = mSensor->mTemperature;
+    mHumidity = mSensor->mHumidity;
+  }
+  return state;
+}
+
+bool SHTSensor::isSampleDue() const
+{
+  return mSensor && mSensor->isSampleDue();
+}
+
 bool SHTSensor::setAccuracy(SHTAccuracy newAccuracy)
 {
   if (!mSensor)
@@ -440,3 +526,81 @@ void SHTSensor::cleanup()
     mSensor = NULL;
   }
 }
+
+
+//
+// class SHTSensorGroup
+//
+
+bool SHTSensorGroup::add(SHTSensor & sensor, int8_t channel)
+{
+  if (mCount >= MAX_SENSORS) {
+    return false;
+  }
+  mEntries[mCount].sensor = &sensor;
+  mEntries[mCount].channel = channel;
+  mEntries[mCount].state = SHTSensor::SHT_SAMPLE_IDLE;
+  ++mCount;
+  return true;
+}
+
+bool SHTSensorGroup::selectChannel(int8_t channel)
+{
+  if (channel == mChannel || channel == NO_CHANNEL) {
+    return true;
+  }
+  mWire.beginTransmission(mMuxAddress);
+  mWire.write((uint8_t)(1 << channel));
+  if (mWire.endTransmission() != 0) {
+    mChannel = NO_CHANNEL - 1; // unknown
+    return false;
+  }
+  mChannel = channel;
+  return true;
+}
+
+bool SHTSensorGroup::init()
+{
+  bool ok = true;
+  for (uint8_t i = 0; i < mCount; ++i) {
+    if (!selectChannel(mEntries[i].channel) || !mEntries[i].sensor->init(mWire)) {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+uint8_t SHTSensorGroup::startAll()
+{
+  uint8_t started = 0;
+  for (uint8_t i = 0; i < mCount; ++i) {
+    Entry & e = mEntries[i];
+    if (selectChannel(e.channel) && e.sensor->startSample()) {
+      e.state = SHTSensor::SHT_SAMPLE_BUSY;
+      ++started;
+    } else {
+      e.state = SHTSensor::SHT_SAMPLE_ERROR;
+    }
+  }
+  return started;
+}
+
+bool SHTSensorGroup::update()
+{
+  bool done = true;
+  for (uint8_t i = 0; i < mCount; ++i) {
+    Entry & e = mEntries[i];
+    if (e.state != SHTSensor::SHT_SAMPLE_BUSY) {
+      continue;
+    }
+    // only switch the multiplexer for sensors that have finished converting
+    if (e.sensor->isSampleDue()) {
+      e.state = selectChannel(e.channel) ? e.sensor->pollSample()
+                                         : SHTSensor::SHT_SAMPLE_ERROR;
+    }
+    if (e.state == SHTSensor::SHT_SAMPLE_BUSY) {
+      done = false;
+    }
+  }
+  return done;
+}
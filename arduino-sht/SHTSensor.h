@@ -30,6 +30,7 @@
 #define SHTSENSOR_H
 
 #include <inttypes.h>
+#include <Arduino.h>
 #include <Wire.h>
 
 //#define DEBUG_SHT_SENSOR
@@ -89,6 +90,20 @@ public:
     SHT_ACCURACY_LOW
   };
 
+  /**
+   * State of a non-blocking measurement, see startSample() and pollSample()
+   */
+  enum SHTSampleState {
+    /** No measurement was started */
+    SHT_SAMPLE_IDLE,
+    /** The sensor is still converting */
+    SHT_SAMPLE_BUSY,
+    /** The sample was read and the values are cached */
+    SHT_SAMPLE_READY,
+    /** Communication with the sensor failed, or the CRC did not match */
+    SHT_SAMPLE_ERROR
+  };
+
   /** Value reported by getHumidity() when the sensor is not initialized */
   static const float HUMIDITY_INVALID;
   /** Value reported by getTemperature() when the sensor is not initialized */
@@ -141,6 +156,27 @@ public:
    */
   bool readSample();
 
+  /**
+   * Start a measurement and return without waiting for it.
+   * Call pollSample() from loop() until it is no longer SHT_SAMPLE_BUSY,
+   * then use getTemperature() and getHumidity()
+   * Returns true if the measurement was started
+   */
+  bool startSample();
+
+  /**
+   * Check on the measurement started by startSample(), without blocking.
+   * The bus is only accessed once the conversion time has passed.
+   * Returns SHT_SAMPLE_READY once, when the values were read and cached
+   */
+  SHTSampleState pollSample();
+
+  /**
+   * Returns true if a measurement is in progress and its conversion time has
+   * passed, so pollSample() would access the bus
+   */
+  bool isSampleDue() const;
+
   /**
    * Get the relative humidity in percent read from the last sample
    * Use readSample() to trigger a new sensor reading
@@ -192,6 +228,21 @@ public:
   /** Returns true if the next sample was read and the values are cached */
   virtual bool readSample();
 
+  /** Starts a measurement, returns false if not supported or on error */
+  virtual bool startSample() {
+    return false;
+  }
+
+  /** Reads the measurement once its conversion time has passed */
+  virtual SHTSensor::SHTSampleState pollSample() {
+    return SHTSensor::SHT_SAMPLE_IDLE;
+  }
+
+  /** Returns true if pollSample() would access the bus */
+  virtual bool isSampleDue() const {
+    return false;
+  }
+
   /**
    * Get the relative humidity in percent read from the last sample
    * Use readSample() to trigger a new sensor reading
@@ -238,7 +289,7 @@ public:
                TwoWire & wire = Wire)
       : mI2cAddress(i2cAddress), mI2cCommand(i2cCommand), mDuration(duration),
         mA(a), mB(b), mC(c), mX(x), mY(y), mZ(z), mCmd_Size(cmd_Size),
-        mWire(wire)
+        mWire(wire), mBusy(false), mStartTime(0)
   {
   }
 
@@ -247,6 +298,11 @@ public:
   }
 
   virtual bool readSample();
+  virtual bool startSample();
+  virtual SHTSensor::SHTSampleState pollSample();
+  virtual bool isSampleDue() const {
+    return mBusy && (unsigned long)(millis() - mStartTime) >= mDuration;
+  }
 
   uint8_t mI2cAddress;
   uint16_t mI2cCommand;
@@ -263,7 +319,21 @@ public:
 private:
 
 protected:
+  /** A measurement was started and has not been read yet */
+  bool mBusy;
+  /** millis() when the measurement command was sent */
+  unsigned long mStartTime;
+
+  /** Sends the measurement command and starts the conversion timer */
+  bool sendCommand(const uint8_t *i2cCommand, uint8_t commandLength);
+  /** Converts the 6 bytes of T and RH, after checking their CRC */
+  bool convert(const uint8_t *data, uint8_t crcInit, uint16_t statusMask);
+
   static uint8_t crc8(const uint8_t *data, uint8_t len, uint8_t crcInit = 0xff);
+  static bool writeToI2c(TwoWire & wire, uint8_t i2cAddress,
+                         const uint8_t *i2cCommand, uint8_t commandLength);
+  static bool readDataFromI2c(TwoWire & wire, uint8_t i2cAddress,
+                              uint8_t *data, uint8_t dataLength);
   static bool readFromI2c(TwoWire & wire,
                           uint8_t i2cAddress,
                           const uint8_t *i2cCommand,
@@ -271,6 +341,96 @@ protected:
                           uint8_t dataLength, uint8_t duration);
 };
 
+/**
+ * Runs the measurements of several SHTSensors side by side, optionally behind
+ * a TCA9548A i2c multiplexer, so that their conversions overlap instead of
+ * adding up. Call startAll(), then update() from loop() until it returns true.
+ *
+ * Example usage:
+ * SHTSensorGroup group;
+ * group.add(sht1, 0); // on multiplexer channel 0
+ * group.add(sht2, 1);
+ * group.init();
+ * group.startAll();
+ * if (group.update()) ... group.getState(0) == SHTSensor::SHT_SAMPLE_READY
+ *
+ * Note that the TCA9548A default address 0x70 is also the address of the
+ * SHTC1/SHTC3/SHTW2: set the multiplexer address pins when using those.
+ */
+class SHTSensorGroup
+{
+public:
+  /** Default i2c address of the TCA9548A, with A0..A2 low */
+  static const uint8_t TCA9548A_ADDRESS = 0x70;
+  /** Channel for sensors that are directly on the bus */
+  static const int8_t NO_CHANNEL = -1;
+#ifndef SHT_GROUP_MAX_SENSORS
+  static const uint8_t MAX_SENSORS = 16;
+#else
+  static const uint8_t MAX_SENSORS = SHT_GROUP_MAX_SENSORS;
+#endif
+
+  SHTSensorGroup(TwoWire & wire = Wire, uint8_t muxAddress = TCA9548A_ADDRESS)
+      : mWire(wire), mMuxAddress(muxAddress), mCount(0),
+        mChannel(NO_CHANNEL - 1)
+  {
+  }
+
+  /**
+   * Add a sensor, on a multiplexer channel (0..7) or NO_CHANNEL
+   * Returns false if the group is full
+   */
+  bool add(SHTSensor & sensor, int8_t channel = NO_CHANNEL);
+
+  /**
+   * Initialize every sensor on its channel, blocking
+   * Returns true if all of them responded
+   */
+  bool init();
+
+  /**
+   * Start a measurement on every sensor, returns the number started
+   */
+  uint8_t startAll();
+
+  /**
+   * Read the sensors whose conversion time has passed, without blocking
+   * Returns true once no sensor is busy any more
+   */
+  bool update();
+
+  /** Number of sensors in the group */
+  uint8_t size() const {
+    return mCount;
+  }
+
+  /** Sensor number `index', in the order they were added */
+  SHTSensor & get(uint8_t index) {
+    return *mEntries[index].sensor;
+  }
+
+  /** State of the last measurement of sensor number `index' */
+  SHTSensor::SHTSampleState getState(uint8_t index) const {
+    return mEntries[index].state;
+  }
+
+private:
+  struct Entry {
+    SHTSensor *sensor;
+    int8_t channel;
+    SHTSensor::SHTSampleState state;
+  };
+
+  bool selectChannel(int8_t channel);
+
+  TwoWire & mWire;
+  uint8_t mMuxAddress;
+  uint8_t mCount;
+  /** Channel the multiplexer is switched to, to skip redundant writes */
+  int8_t mChannel;
+  Entry mEntries[MAX_SENSORS];
+};
+
 class SHT3xAnalogSensor
 {
 public:
@@ -0,0 +1,67 @@
+#include <Wire.h>
+#include "SHTSensor.h"
+
+// Sensors that share an i2c address, each on its own channel of a TCA9548A
+// multiplexer. The group starts all measurements at once and reads each sensor
+// when its conversion is done, so a cycle takes as long as one measurement
+// instead of one per sensor, and loop() never waits.
+// Note that SHTC1/SHTC3 sensors use address 0x70, like the multiplexer with
+// its address pins low: use another multiplexer address with those.
+
+#define SENSOR_COUNT 8
+
+SHTSensor sht[SENSOR_COUNT] = {
+  SHTSensor(SHTSensor::SHT3X), SHTSensor(SHTSensor::SHT3X),
+  SHTSensor(SHTSensor::SHT3X), SHTSensor(SHTSensor::SHT3X),
+  SHTSensor(SHTSensor::SHT3X), SHTSensor(SHTSensor::SHT3X),
+  SHTSensor(SHTSensor::SHT3X), SHTSensor(SHTSensor::SHT3X)
+};
+
+// multiplexer at its default address 0x70
+SHTSensorGroup group;
+
+unsigned long lastCycle = 0;
+bool measuring = false;
+
+void setup() {
+  // put your setup code here, to run once:
+  Wire.begin();
+  Serial.begin(9600);
+  delay(1000); // let serial console settle
+
+  for (uint8_t i = 0; i < SENSOR_COUNT; ++i) {
+    group.add(sht[i], i); // sensor i on multiplexer channel i
+  }
+  if (!group.init()) {
+    Serial.print("group.init(): not all sensors responded\n");
+  }
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  // start a cycle every second
+  if (!measuring && millis() - lastCycle >= 1000) {
+    lastCycle = millis();
+    group.startAll();
+    measuring = true;
+  }
+
+  if (measuring && group.update()) {
+    measuring = false;
+    for (uint8_t i = 0; i < group.size(); ++i) {
+      Serial.print("Sensor ");
+      Serial.print(i);
+      if (group.getState(i) == SHTSensor::SHT_SAMPLE_READY) {
+        Serial.print("  RH: ");
+        Serial.print(group.get(i).getHumidity(), 2);
+        Serial.print("  T: ");
+        Serial.print(group.get(i).getTemperature(), 2);
+        Serial.print("\n");
+      } else {
+        Serial.print(": Error\n");
+      }
+    }
+  }
+
+  // do other things here
+}
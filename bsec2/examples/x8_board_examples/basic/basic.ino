@@ -52,7 +52,9 @@ void newDataCallback(const bme68xData data, const bsecOutputs outputs, Bsec2 bse
 Bsec2 envSensor[NUM_OF_SENS];
 comm_mux communicationSetup[NUM_OF_SENS];
 uint8_t bsecMemBlock[NUM_OF_SENS][BSEC_INSTANCE_SIZE];
-uint8_t sensor = 0;
+
+/* Services the sensors in the order of their deadlines */
+Bsec2Scheduler scheduler(envSensor, NUM_OF_SENS);
 
 /* Entry point for the example */
 void setup(void)
@@ -130,16 +132,14 @@ void setup(void)
 /* Function that is looped forever */
 void loop(void)
 {
-  /* Call the run function often so that the library can
-     check if it is time to read new data from the sensor
-     and process it.
+  /* Call the run function often so that the scheduler can
+     start the measurements of the sensors that are due, and
+     read and process those that have finished, without waiting
+     for any of them.
   */
-  for (sensor = 0; sensor < NUM_OF_SENS; sensor++)
+  if (!scheduler.run())
   {
-    if (!envSensor[sensor].run())
-    {
-      checkBsecStatus(envSensor[sensor]);
-    }
+    checkBsecStatus(envSensor[scheduler.getCurrent()]);
   }
 }
 
@@ -161,7 +161,7 @@ void newDataCallback(const bme68xData data, const bsecOutputs outputs, Bsec2 bse
     return;
   }
 
-  Serial.println("BSEC outputs:\n\tSensor num = " + String(sensor));
+  Serial.println("BSEC outputs:\n\tSensor num = " + String(scheduler.getCurrent()));
   Serial.println("\tTime stamp = " + String((int) (outputs.output[0].time_stamp / INT64_C(1000000))));
   for (uint8_t i = 0; i < outputs.nOutputs; i++)
   {
@@ -52,6 +52,9 @@ Bsec2::Bsec2(void)
     opMode = BME68X_SLEEP_MODE;
     newDataCallback = nullptr;
     bsecInstance = nullptr;
+    measuring = false;
+    measTimeNs = 0;
+    measReadyMs = 0;
 
     memset(&version, 0, sizeof(version));
     memset(&bmeConf, 0, sizeof(bmeConf));
@@ -125,67 +128,65 @@ bool Bsec2::updateSubscription(bsecSensor sensorList[], uint8_t nSensors, float
  */
 bool Bsec2::run(void)
 {
-    uint8_t nFieldsLeft = 0;
-    bme68xData data;
     int64_t currTimeNs = getTimeMs() * INT64_C(1000000);
-    opMode = bmeConf.op_mode;
 
     if (currTimeNs >= bmeConf.next_call)
     {
-        /* Provides the information about the current sensor configuration that is
-           necessary to fulfill the input requirements, eg: operation mode, timestamp
-           at which the sensor data shall be fetched etc */
-        status = bsec_sensor_control_m(bsecInstance ,currTimeNs, &bmeConf);
-        if (status != BSEC_OK)
+        if (!configureSensor(currTimeNs))
             return false;
 
-        switch (bmeConf.op_mode)
-        {
-        case BME68X_FORCED_MODE:
-            setBme68xConfigForced();
-            break;
-        case BME68X_PARALLEL_MODE:
-            if (opMode != bmeConf.op_mode)
-            {
-                setBme68xConfigParallel();
-            }
-            break;
+        if (bmeConf.trigger_measurement && bmeConf.op_mode != BME68X_SLEEP_MODE)
+            return readAndProcess(currTimeNs);
+    }
+    return true;
+}
 
-        case BME68X_SLEEP_MODE:
-            if (opMode != bmeConf.op_mode)
-            {
-                sensor.setOpMode(BME68X_SLEEP_MODE);
-                opMode = BME68X_SLEEP_MODE;
-            }
-            break;
-        }
+/**
+ * @brief Function to get the time at which the instance next needs service()
+ */
+int64_t Bsec2::getNextCallMs(void)
+{
+    if (measuring)
+        return measReadyMs;
+
+    return bmeConf.next_call / INT64_C(1000000);
+}
+
+/**
+ * @brief Function to do whatever the instance has due, without waiting for a forced mode measurement
+ */
+bool Bsec2::service(void)
+{
+    int64_t currTimeMs = getTimeMs();
+
+    if (measuring)
+    {
+        if (currTimeMs < measReadyMs)
+            return true;
 
-        if (sensor.checkStatus() == BME68X_ERROR)
+        measuring = false;
+        return readAndProcess(measTimeNs);
+    }
+
+    int64_t currTimeNs = currTimeMs * INT64_C(1000000);
+
+    if (currTimeNs >= bmeConf.next_call)
+    {
+        if (!configureSensor(currTimeNs))
             return false;
 
-        if (bmeConf.trigger_measurement && bmeConf.op_mode != BME68X_SLEEP_MODE)
+        if (bmeConf.trigger_measurement && bmeConf.op_mode == BME68X_FORCED_MODE)
         {
-            if (sensor.fetchData())
-            {
-                do
-                {
-                    nFieldsLeft = sensor.getData(data);
-                    /* check for valid gas data */
-                    if (data.status & BME68X_GASM_VALID_MSK)
-                    {
-						/* Convert sensor raw pressure unit from pascal to hecto pascal */
-						data.pressure *= 0.01f;
-
-                        if (!processData(currTimeNs, data))
-                        {
-                            return false;
-                        }
-                    }
-                } while (nFieldsLeft);
-            }
-
+            /* Come back once the measurement and its heater duration are over */
+            measuring = true;
+            measTimeNs = currTimeNs;
+            measReadyMs = currTimeMs + (sensor.getMeasDur(BME68X_FORCED_MODE) / INT64_C(1000)) +
+                    bmeConf.heater_duration + 1;
+        }
+        else if (bmeConf.trigger_measurement && bmeConf.op_mode != BME68X_SLEEP_MODE)
+        {
+            return readAndProcess(currTimeNs);
         }
-
     }
     return true;
 }
@@ -282,6 +283,76 @@ void Bsec2::clearMemory(void)
 
 /* Private functions */
 
+/**
+ * @brief Gets the sensor configuration from BSEC and applies it
+ */
+bool Bsec2::configureSensor(int64_t currTimeNs)
+{
+    opMode = bmeConf.op_mode;
+
+    /* Provides the information about the current sensor configuration that is
+       necessary to fulfill the input requirements, eg: operation mode, timestamp
+       at which the sensor data shall be fetched etc */
+    status = bsec_sensor_control_m(bsecInstance ,currTimeNs, &bmeConf);
+    if (status != BSEC_OK)
+        return false;
+
+    switch (bmeConf.op_mode)
+    {
+    case BME68X_FORCED_MODE:
+        setBme68xConfigForced();
+        break;
+    case BME68X_PARALLEL_MODE:
+        if (opMode != bmeConf.op_mode)
+        {
+            setBme68xConfigParallel();
+        }
+        break;
+
+    case BME68X_SLEEP_MODE:
+        if (opMode != bmeConf.op_mode)
+        {
+            sensor.setOpMode(BME68X_SLEEP_MODE);
+            opMode = BME68X_SLEEP_MODE;
+        }
+        break;
+    }
+
+    if (sensor.checkStatus() == BME68X_ERROR)
+        return false;
+
+    return true;
+}
+
+/**
+ * @brief Fetches the measured data from the sensor and processes it
+ */
+bool Bsec2::readAndProcess(int64_t currTimeNs)
+{
+    uint8_t nFieldsLeft = 0;
+    bme68xData data;
+
+    if (sensor.fetchData())
+    {
+        do
+        {
+            nFieldsLeft = sensor.getData(data);
+            /* check for valid gas data */
+            if (data.status & BME68X_GASM_VALID_MSK)
+            {
+				/* Convert sensor raw pressure unit from pascal to hecto pascal */
+				data.pressure *= 0.01f;
+
+                if (!processData(currTimeNs, data))
+                {
+                    return false;
+                }
+            }
+        } while (nFieldsLeft);
+    }
+    return true;
+}
+
 /**
  * @brief Reads data from the BME68X sensor and process it
  */
@@ -387,6 +458,7 @@ bool Bsec2::beginCommon()
 
     memset(&bmeConf, 0, sizeof(bmeConf));
     memset(&outputs, 0, sizeof(outputs));
+    measuring = false;
 
     return true;
 }
@@ -442,3 +514,67 @@ void Bsec2::setBme68xConfigParallel(void)
 
     opMode = BME68X_PARALLEL_MODE;
 }
+
+/**
+ * @brief Constructor of Bsec2Scheduler class
+ */
+Bsec2Scheduler::Bsec2Scheduler(Bsec2 *instances, uint8_t nInstances)
+{
+    this->instances = instances;
+    this->nInstances = (nInstances > 32) ? 32 : nInstances;
+    current = 0;
+    idleTask = nullptr;
+}
+
+/**
+ * @brief Services the instances that are due, earliest deadline first
+ */
+bool Bsec2Scheduler::run(void)
+{
+    uint32_t serviced = 0;
+
+    /* Each instance is serviced at most once per call, so none can hold up the others */
+    for (uint8_t n = 0; n < nInstances; n++)
+    {
+        int64_t nextMs = 0;
+        int8_t next = -1;
+
+        for (uint8_t i = 0; i < nInstances; i++)
+        {
+            if (serviced & (UINT32_C(1) << i))
+                continue;
+
+            int64_t callMs = instances[i].getNextCallMs();
+            if ((next < 0) || (callMs < nextMs))
+            {
+                next = i;
+                nextMs = callMs;
+            }
+        }
+
+        if ((next < 0) || (nextMs > instances[next].getTimeMs()))
+            break;
+
+        serviced |= UINT32_C(1) << next;
+        current = next;
+        if (!instances[next].service())
+            return false;
+    }
+
+    if (idleTask && nInstances)
+    {
+        int64_t nowMs = instances[0].getTimeMs();
+        int64_t nextMs = instances[0].getNextCallMs();
+
+        for (uint8_t i = 1; i < nInstances; i++)
+        {
+            int64_t callMs = instances[i].getNextCallMs();
+            if (callMs < nextMs)
+                nextMs = callMs;
+        }
+
+        if (nextMs > nowMs)
+            idleTask((uint32_t)(nextMs - nowMs));
+    }
+    return true;
+}
@@ -134,6 +134,19 @@ public:
      */
     bool run(void);
 
+    /**
+     * @brief Function to get the time at which the instance next needs service()
+     * @return	Time in milliseconds, on the timeline of getTimeMs()
+     */
+    int64_t getNextCallMs(void);
+
+    /**
+     * @brief Does the same as run(), except that a forced mode measurement is only started here,
+     * and read by a later call once it is over, instead of waiting for it. Call it at getNextCallMs()
+     * @return	true for success, false otherwise
+     */
+    bool service(void);
+
     void attachCallback(bsecCallback callback)
     {
         newDataCallback = callback;
@@ -237,6 +250,25 @@ private:
     /* Pointer to hold the address of the instance */
     uint8_t *bsecInstance;
 
+    /* Forced mode measurement started by service(), and when its data will be ready */
+    bool measuring;
+    int64_t measTimeNs;
+    int64_t measReadyMs;
+
+    /**
+     * @brief Gets the sensor configuration from BSEC and applies it
+     * @param currTimeNs: Current time in ns
+     * @return true for success, false otherwise
+     */
+    bool configureSensor(int64_t currTimeNs);
+
+    /**
+     * @brief Fetches the measured data from the sensor and processes it
+     * @param currTimeNs: Time in ns the measurement was started at
+     * @return true for success, false otherwise
+     */
+    bool readAndProcess(int64_t currTimeNs);
+
     /**
      * @brief Reads the data from the BME68x sensor and process it
      * @param currTimeNs: Current time in ns
@@ -260,4 +292,46 @@ private:
     void setBme68xConfigParallel(void);
 };
 
+/* Runs several BSEC2 instances, e.g. the sensors of a commMux board, earliest deadline first */
+class Bsec2Scheduler
+{
+public:
+    /**
+     * @brief Constructor
+     * @param instances  : Array of initialized and subscribed instances, at most 32
+     * @param nInstances : Number of instances
+     */
+    Bsec2Scheduler(Bsec2 *instances, uint8_t nInstances);
+
+    /**
+     * @brief Function to set what to do between deadlines, eg: a light sleep
+     * @param idleTask : Called with the time in ms until the next deadline
+     */
+    void setIdleTask(void (*idleTask)(uint32_t periodMs))
+    {
+        this->idleTask = idleTask;
+    }
+
+    /**
+     * @brief Calls service() on every instance that is due, earliest deadline first, then
+     * idles until the next deadline if an idle task is set
+     * @return	true for success, false if an instance failed, see getCurrent()
+     */
+    bool run(void);
+
+    /**
+     * @brief Function to get the index of the instance being serviced, eg: from the callback
+     */
+    uint8_t getCurrent(void)
+    {
+        return current;
+    }
+
+private:
+    Bsec2 *instances;
+    uint8_t nInstances;
+    uint8_t current;
+    void (*idleTask)(uint32_t periodMs);
+};
+
 #endif /* BSEC2_CLASS_H */
@@ -83,3 +83,168 @@ String jsonExtract(String json, String name){
   return json.substring(start, stop);
 }
 
+
+
+// Span based versions: they work on a char buffer in place and return
+// pointers into it, so a lookup costs no heap and no copy of the document.
+
+static const char *skipSpace(const char *p, const char *end){
+  while(p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')){
+    p++;
+  }
+  return p;
+}
+
+// p at the opening quote, returns the position after the closing quote
+static const char *skipString(const char *p, const char *end){
+  p++;
+  while(p < end && *p != '"'){
+    if(*p == '\\'){
+      p++;
+    }
+    p++;
+  }
+  return p < end ? p + 1 : end;
+}
+
+// p at the first char of a value, returns the position after it
+static const char *skipValue(const char *p, const char *end){
+  if(p >= end){
+    return end;
+  }
+  if(*p == '"'){
+    return skipString(p, end);
+  }
+  if(*p == '{' || *p == '['){
+    int count = 0;
+    while(p < end){
+      if(*p == '"'){
+	p = skipString(p, end);
+	continue;
+      }
+      if(*p == '{' || *p == '['){
+	count++;
+      }
+      else if(*p == '}' || *p == ']'){
+	if(--count == 0){
+	  return p + 1;
+	}
+      }
+      p++;
+    }
+    return end;
+  }
+  // number, true, false, null
+  while(p < end && *p != ',' && *p != '}' && *p != ']' &&
+	*p != ' ' && *p != '\t' && *p != '\r' && *p != '\n'){
+    p++;
+  }
+  return p;
+}
+
+// value starting at p, strings without their quotes like jsonExtract()
+static JsonSpan valueSpan(const char *p, const char *end){
+  JsonSpan span = {NULL, 0};
+  const char *stop = skipValue(p, end);
+  if(stop > p){
+    if(*p == '"'){
+      span.ptr = p + 1;
+      span.len = stop - p - 2;
+    }
+    else{
+      span.ptr = p;
+      span.len = stop - p;
+    }
+  }
+  return span;
+}
+
+// key at p (on its opening quote) matching name, as raw bytes
+static bool keyEquals(const char *p, const char *stop, const char *name){
+  size_t n = stop - p - 2;
+  return strncmp(p + 1, name, n) == 0 && name[n] == 0;
+}
+
+// return the indexed item of a list, as is (strings keep their quotes)
+JsonSpan jsonIndexListSpan(const char *json, size_t len, int idx){
+  JsonSpan span = {NULL, 0};
+  const char *end = json + len;
+  const char *p = skipSpace(json, end);
+  if(p == end || *p != '['){
+    return span;
+  }
+  p = skipSpace(p + 1, end);
+  for(int i = 0; p < end && *p != ']'; i++){
+    const char *stop = skipValue(p, end);
+    if(i == idx){
+      span.ptr = p;
+      span.len = stop - p;
+      return span;
+    }
+    p = skipSpace(stop, end);
+    if(p == end || *p != ','){
+      break;
+    }
+    p = skipSpace(p + 1, end);
+  }
+  return span;
+}
+
+// return the value of the first "name" key, at any depth like jsonExtract()
+JsonSpan jsonExtractSpan(const char *json, size_t len, const char *name){
+  JsonSpan span = {NULL, 0};
+  jsonExtractSpans(json, len, &name, &span, 1);
+  return span;
+}
+
+// look up several keys in a single pass over the document, values[i] gets
+// the first value of names[i]. Returns the number of keys found.
+int jsonExtractSpans(const char *json, size_t len, const char *const *names, JsonSpan *values, int count){
+  const char *end = json + len;
+  const char *p = json;
+  int found = 0;
+
+  for(int i = 0; i < count; i++){
+    values[i].ptr = NULL;
+    values[i].len = 0;
+  }
+  while(p < end && found < count){
+    if(*p != '"'){
+      p++;
+      continue;
+    }
+    const char *stop = skipString(p, end);
+    const char *colon = skipSpace(stop, end);
+    if(colon < end && *colon == ':'){
+      for(int i = 0; i < count; i++){
+	if(values[i].ptr == NULL && keyEquals(p, stop, names[i])){
+	  values[i] = valueSpan(skipSpace(colon + 1, end), end);
+	  if(values[i].ptr != NULL){
+	    found++;
+	  }
+	  break;
+	}
+      }
+    }
+    p = stop; // values are scanned too, so nested keys are found
+  }
+  return found;
+}
+
+bool jsonSpanEquals(JsonSpan span, const char *str){
+  return span.ptr != NULL && strncmp(span.ptr, str, span.len) == 0 && str[span.len] == 0;
+}
+
+// copy a span to a NUL terminated buffer, e.g. for atof() or printing.
+// Returns the number of chars copied, truncated to size - 1.
+size_t jsonSpanCopy(JsonSpan span, char *buf, size_t size){
+  if(size == 0){
+    return 0;
+  }
+  size_t n = span.len < size - 1 ? span.len : size - 1;
+  if(n > 0){
+    memcpy(buf, span.ptr, n);
+  }
+  buf[n] = 0;
+  return n;
+}
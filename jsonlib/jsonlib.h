@@ -6,4 +6,17 @@
 String jsonIndexList(String json, int idx);
 String jsonExtract(String json, String name);
 
+// A value inside the caller's json buffer, nothing is copied.
+// ptr is NULL when the value was not found.
+struct JsonSpan {
+  const char *ptr;
+  size_t len;
+};
+
+JsonSpan jsonIndexListSpan(const char *json, size_t len, int idx);
+JsonSpan jsonExtractSpan(const char *json, size_t len, const char *name);
+int jsonExtractSpans(const char *json, size_t len, const char *const *names, JsonSpan *values, int count);
+bool jsonSpanEquals(JsonSpan span, const char *str);
+size_t jsonSpanCopy(JsonSpan span, char *buf, size_t size);
+
 #endif
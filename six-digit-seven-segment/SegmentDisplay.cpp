@@ -30,6 +30,14 @@ SegmentDisplay::SegmentDisplay (int latchPin,
   this->digit6  = digit6;
 
   this->punkt  = punkt;
+
+  for (int i = 0; i < 6; i++) {
+    frame[i] = B0;
+  }
+  dots = 0;
+  brightness = 255;
+  current = 5;
+  step = 0;
 	
   pinMode(latchPin, OUTPUT);
   pinMode(dataPin, OUTPUT);
@@ -89,8 +97,12 @@ void SegmentDisplay::showString (String string){
 }
 
 bool SegmentDisplay::isLegal (char check){
+	return charToSegments(check) != B0 || check == 'X'; 
+}
+
+byte SegmentDisplay::charToSegments (char c){
 	byte numberToShift = B0;
-	switch (check) {
+	switch (c) {
         case '1':
            numberToShift = B0110000;
           break;
@@ -194,7 +206,7 @@ bool SegmentDisplay::isLegal (char check){
            numberToShift = B1110110;
           break;
       }
-      return numberToShift != B0 || check == 'X'; 
+      return numberToShift;
 }
 
 void SegmentDisplay::showChar (char displayResorce[6][2], int delayTime) {
@@ -202,110 +214,7 @@ void SegmentDisplay::showChar (char displayResorce[6][2], int delayTime) {
     byte numberToShift = B0 ;
 
     for (int i = 0; i < 6; i++) {
-      switch (displayResorce[i][0]) {
-        case '1':
-           numberToShift = B0110000;
-          break;
-        case '2':
-           numberToShift = B1011101;
-          break;
-        case '3':
-           numberToShift = B1111100;
-          break;
-        case '4':
-           numberToShift = B0110110;
-          break;
-        case '5':
-           numberToShift = B1101110;
-          break;
-        case '6':
-           numberToShift = B1101111;
-          break;
-        case '7':
-           numberToShift = B0111000;
-          break;
-        case '8':
-           numberToShift = B11111111;
-          break;
-        case '9':
-           numberToShift = B1111110;
-          break;
-        case '0':
-           numberToShift = B1111011;
-          break;
-        case 'o':
-           numberToShift = B0011110;
-          break;
-        case 'C':
-           numberToShift = B1001011;
-          break;
-        case 'F':
-           numberToShift = B0001111;
-          break;
-        case '-':
-           numberToShift = B0000100;
-          break;
-        case 'X':
-           numberToShift = B0;
-          break;
-        case 'A':
-           numberToShift = B0111111;
-          break;
-        case 'b':
-           numberToShift = B1100111;
-          break;
-        case 'd':
-           numberToShift = B1110101;
-          break;
-        case 'E':
-           numberToShift = B1001111;
-          break;
-        case 'G':
-           numberToShift = B1101011;
-          break;
-        case 'H':
-           numberToShift = B0110111;
-          break;
-        case 'I':
-           numberToShift = B0000011;
-          break;
-        case 'J':
-           numberToShift = B1110000;
-          break;
-        case 'L':
-           numberToShift = B1000011;
-          break;
-        case 'U':
-           numberToShift = B1110011;
-          break;
-        case 'c':
-           numberToShift = B1000101;
-          break;
-        case 'h':
-           numberToShift = B0100111;
-          break;
-        case 'n':
-           numberToShift = B0100101;
-          break;
-        case 'O':
-           numberToShift = B1100101;
-          break;
-        case 'r':
-           numberToShift = B0000101;
-          break;
-        case 't':
-           numberToShift = B1000111;
-          break;
-        case 'u':
-           numberToShift = B1100001;
-          break;
-        case 'p':
-           numberToShift = B0011111;
-          break;
-        case 'y':
-           numberToShift = B1110110;
-          break;
-      }
+      numberToShift = charToSegments(displayResorce[i][0]);
 
       updateShiftRegister(numberToShift) ;
 
@@ -314,28 +223,7 @@ void SegmentDisplay::showChar (char displayResorce[6][2], int delayTime) {
       }
 
       // "activate" Kathode - turn digit on
-      int kathode = -1;
-
-      switch (i) {
-        case 0:
-          kathode = digit1;
-          break;
-        case 1:
-          kathode = digit2;
-          break;
-        case 2:
-          kathode = digit3;
-          break;
-        case 3:
-          kathode = digit4;
-          break;
-        case 4:
-          kathode = digit5;
-          break;
-        case 5:
-          kathode = digit6;
-          break;
-      }
+      int kathode = digitPin(i);
 
       digitalWrite(kathode, LOW);
 
@@ -359,3 +247,104 @@ void SegmentDisplay::updateShiftRegister(byte b)
   shiftOut(dataPin, clockPin, LSBFIRST, b);
   digitalWrite(latchPin, HIGH);
 }
+
+int SegmentDisplay::digitPin (int i)
+{
+  switch (i) {
+    case 0:
+      return digit1;
+    case 1:
+      return digit2;
+    case 2:
+      return digit3;
+    case 3:
+      return digit4;
+    case 4:
+      return digit5;
+    case 5:
+      return digit6;
+  }
+  return -1;
+}
+
+void SegmentDisplay::setChar (char displayResorce[6][2])
+{
+  byte newDots = 0;
+  for (int i = 0; i < 6; i++) {
+    frame[i] = charToSegments(displayResorce[i][0]);
+    if (displayResorce[i][1] == '.') {
+      newDots |= 1 << i;
+    }
+  }
+  dots = newDots;
+}
+
+void SegmentDisplay::setString (String string)
+{
+  byte newFrame[6] = {B0, B0, B0, B0, B0, B0};
+  byte newDots = 0;
+  int i = -1;
+  for (unsigned int n = 0; n < string.length(); n++) {
+    char c = string.charAt(n);
+    if (c == '.' && i >= 0 && !(newDots & (1 << i))) {
+      newDots |= 1 << i; // point of the charakter before
+      continue;
+    }
+    if (++i == 6) {
+      break;
+    }
+    if (c == '.') {
+      newDots |= 1 << i;
+    } else {
+      newFrame[i] = charToSegments(c);
+    }
+  }
+  for (i = 0; i < 6; i++) {
+    frame[i] = newFrame[i];
+  }
+  dots = newDots;
+}
+
+void SegmentDisplay::setBrightness (byte level)
+{
+  brightness = level;
+}
+
+byte SegmentDisplay::getBrightness ()
+{
+  return brightness;
+}
+
+void SegmentDisplay::nextDigit ()
+{
+  digitalWrite(digitPin(current), HIGH);
+  if (++current == 6) {
+    current = 0;
+  }
+  updateShiftRegister(frame[current]);
+  digitalWrite(punkt, (dots & (1 << current)) ? HIGH : LOW);
+  digitalWrite(digitPin(current), LOW);
+}
+
+void SegmentDisplay::blank ()
+{
+  digitalWrite(digitPin(current), HIGH);
+}
+
+void SegmentDisplay::refresh ()
+{
+  // lit for the first 'on' steps of each digit, shifted only once per digit
+  byte on = ((unsigned int)brightness * SEGMENT_DISPLAY_PWM_STEPS + 254) / 255;
+  if (step == 0) {
+    if (on > 0) {
+      nextDigit();
+    } else {
+      blank();
+    }
+  } else if (step == on) {
+    blank();
+  }
+  if (++step == SEGMENT_DISPLAY_PWM_STEPS) {
+    step = 0;
+  }
+}
@@ -3,6 +3,11 @@
 
 #include <Arduino.h>
 
+//! refresh() calls per digit in background mode, i.e. the number of brightness steps
+#ifndef SEGMENT_DISPLAY_PWM_STEPS
+#define SEGMENT_DISPLAY_PWM_STEPS 8
+#endif
+
 
 /*!
     \brief     6-digit-7-Segment-Arduino-Library
@@ -26,6 +31,14 @@ class SegmentDisplay {
     int digit6;
     int punkt;
 
+    volatile byte frame[6];   // segments of each digit, precomputed for refresh()
+    volatile byte dots;       // bit i: decimal point after digit i
+    volatile byte brightness;
+    byte current;             // digit lit by refresh()
+    byte step;
+
+    int digitPin (int i);
+
   public:
 
     // --------------------------------------------
@@ -89,6 +102,60 @@ class SegmentDisplay {
       \param b this byte contains the information: state of the pins
     */
     void updateShiftRegister(byte b);
+
+    // --------------------------------------------
+
+    //! get the segments of a charakter
+    /*!
+      \param c charakter to convert
+      \return byte - segment pattern, B0 if the charakter is not legal
+    */
+    byte charToSegments (char c);
+
+    // --------------------------------------------
+
+    //! set what the background refresh shows, same format as showChar()
+    /*!
+      \param displayResorce[6][2] the char array contains the numbers showing on the Display
+    */
+    void setChar (char displayResorce[6][2]);
+
+    // --------------------------------------------
+
+    //! set what the background refresh shows from a String, e.g. "12.34.56"
+    /*!
+      \param string up to 6 charakters, a '.' lights the point of the charakter before
+    */
+    void setString (String string);
+
+    // --------------------------------------------
+
+    //! set the brightness of the background refresh
+    /*!
+      \param level 0 (off) to 255 (full)
+    */
+    void setBrightness (byte level);
+
+    //! brightness set with setBrightness()
+    byte getBrightness ();
+
+    // --------------------------------------------
+
+    //! background refresh step, call it from a timer interrupt
+    /*!
+      Every SEGMENT_DISPLAY_PWM_STEPS calls the next digit is shifted out
+      from the framebuffer and turned on, and it is turned off again
+      according to the brightness. Call it at 6 * SEGMENT_DISPLAY_PWM_STEPS
+      times the refresh rate, e.g. 5 kHz for about 100 Hz.
+      On AVR, SegmentDisplayTimer0.h drives the display without it.
+    */
+    void refresh ();
+
+    //! shift out the next digit and turn it on
+    void nextDigit ();
+
+    //! turn the current digit off
+    void blank ();
 };
 
 #endif
@@ -0,0 +1,64 @@
+#ifndef __SegmentDisplayTimer0__
+#define __SegmentDisplayTimer0__
+
+#include "SegmentDisplay.h"
+
+/*!
+    \brief     Background refresh of a SegmentDisplay from Timer0 (AVR)
+    \details   Include this file in one file of the sketch only, it defines the
+               TIMER0_COMPA and TIMER0_COMPB interrupts. Timer0 keeps running
+               millis(), its two compare interrupts are used on top of it:
+               COMPA (once per millis tick, about 1 kHz) shifts out the next
+               digit and COMPB turns it off again after brightness / 256 of
+               the tick. The display refreshes at about 160 Hz without any
+               delay() in the sketch. analogWrite() can't be used on the two
+               Timer0 PWM pins (5 and 6 on an Uno) meanwhile.
+*/
+
+#if !defined(__AVR__) || !defined(TIMSK0) || !defined(OCIE0A) || !defined(OCIE0B)
+#error "SegmentDisplayTimer0.h needs an AVR with Timer0 compare A/B, call SegmentDisplay::refresh() from a timer instead"
+#endif
+
+SegmentDisplay *segmentDisplayTimer0 = 0;
+
+ISR(TIMER0_COMPA_vect)
+{
+  byte level = segmentDisplayTimer0->getBrightness();
+  OCR0B = level;  // takes effect from the next tick
+  if (level > 0) {
+    segmentDisplayTimer0->nextDigit();
+  } else {
+    segmentDisplayTimer0->blank();
+  }
+}
+
+ISR(TIMER0_COMPB_vect)
+{
+  if (segmentDisplayTimer0->getBrightness() < 255) {
+    segmentDisplayTimer0->blank();
+  }
+}
+
+//! start the background refresh of display
+inline void segmentDisplayBegin(SegmentDisplay &display)
+{
+  uint8_t oldSREG = SREG;
+  cli();
+  segmentDisplayTimer0 = &display;
+  OCR0A = 0;
+  OCR0B = display.getBrightness();
+  TIFR0 = _BV(OCF0A) | _BV(OCF0B);
+  TIMSK0 |= _BV(OCIE0A) | _BV(OCIE0B);
+  SREG = oldSREG;
+}
+
+//! stop the background refresh and turn the display off
+inline void segmentDisplayEnd()
+{
+  TIMSK0 &= ~(_BV(OCIE0A) | _BV(OCIE0B));
+  if (segmentDisplayTimer0) {
+    segmentDisplayTimer0->blank();
+  }
+}
+
+#endif
@@ -0,0 +1,42 @@
+/* 
+ * Background refresh example for the "six-digit-seven-segment" Library
+ * The display is multiplexed from the Timer0 compare interrupts (AVR),
+ * so loop() is free to do other work and may even block.
+ * for more information see https://6-digit-7-segment-arduino.readthedocs.org
+*/
+
+#include <SegmentDisplay.h>
+#include <SegmentDisplayTimer0.h>
+int latchPin = 10; // Shiftregister
+int clockPin = 11;
+int dataPin = 9;
+
+int digit1 = 7; // cathode of the digits
+int digit2 = 2;
+int digit3 = 3;
+int digit4 = 4;
+int digit5 = 5;
+int digit6 = 6;
+int punkt = 8; // anode of the DP
+
+SegmentDisplay segmentDisplay(latchPin, // tell the library the pins -> pinMode will be called
+                              clockPin,
+                              dataPin,
+                              digit1,
+                              digit2,
+                              digit3,
+                              digit4,
+                              digit5,
+                              digit6,
+                              punkt);
+
+void setup() {
+  segmentDisplay.setBrightness(128); // half brightness
+  segmentDisplayBegin(segmentDisplay);
+}
+
+void loop() {
+  unsigned long seconds = millis() / 1000;
+  segmentDisplay.setString(String(seconds / 60) + "." + String(seconds % 60));
+  delay(1000); // the display stays lit while the sketch is busy
+}